@@ -0,0 +1,98 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace benchmark {
+
+namespace {
+
+std::atomic<bool> counting{false};
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> bytes_allocated{0};
+
+void* counted_malloc(std::size_t size) noexcept {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* counted_new(std::size_t size) {
+    for (;;) {
+        if (auto ptr = counted_malloc(size)) {
+            return ptr;
+        }
+
+        auto handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+}  // namespace
+
+void enable_allocation_counting(bool enabled) {
+    counting.store(enabled, std::memory_order_relaxed);
+}
+
+bool allocation_counting_enabled() {
+    return counting.load(std::memory_order_relaxed);
+}
+
+allocation_counts current_allocation_counts() {
+    return {allocations.load(std::memory_order_relaxed),
+            bytes_allocated.load(std::memory_order_relaxed)};
+}
+}  // namespace benchmark
+
+void* operator new(std::size_t size) {
+    return benchmark::counted_new(size);
+}
+
+void* operator new[](std::size_t size) {
+    return benchmark::counted_new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return benchmark::counted_malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return benchmark::counted_malloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
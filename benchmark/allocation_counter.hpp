@@ -0,0 +1,47 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace benchmark {
+
+// The number and total size of the allocations made through operator new.
+struct allocation_counts {
+    std::uint64_t allocations;
+    std::uint64_t bytes;
+};
+
+//
+// Starts or stops counting allocations. The benchmark binary replaces the global operator new
+// and operator delete, which only count while counting is enabled, so that timings taken
+// without it are not skewed.
+//
+// @note
+//   Only C++ allocations are counted. libbson and libmongoc allocate with malloc, so their
+//   allocations are not.
+//
+void enable_allocation_counting(bool enabled);
+
+//
+// Returns whether allocations are being counted.
+//
+bool allocation_counting_enabled();
+
+//
+// Returns the allocations counted so far, by all threads.
+//
+allocation_counts current_allocation_counts();
+}  // namespace benchmark
@@ -14,25 +14,50 @@
 
 #include "benchmark_runner.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/json.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
 
+#include "bson/bson_decoding.hpp"
 #include "bson/bson_encoding.hpp"
+#include "bson/bson_iteration.hpp"
+#include "bson/bson_validation.hpp"
+#include "bson/builder_encoding.hpp"
+#include "multi_doc/aggregate.hpp"
 #include "multi_doc/bulk_insert.hpp"
+#include "multi_doc/change_stream_events.hpp"
 #include "multi_doc/find_many.hpp"
 #include "multi_doc/gridfs_download.hpp"
+#include "multi_doc/gridfs_matrix.hpp"
 #include "multi_doc/gridfs_upload.hpp"
 #include "parallel/gridfs_multi_export.hpp"
 #include "parallel/gridfs_multi_import.hpp"
 #include "parallel/json_multi_export.hpp"
 #include "parallel/json_multi_import.hpp"
+#include "parallel/thread_scaling.hpp"
+#include "single_doc/find_one_and_update.hpp"
 #include "single_doc/find_one_by_id.hpp"
 #include "single_doc/insert_one.hpp"
 #include "single_doc/run_command.hpp"
+#include "single_doc/with_transaction.hpp"
 
 namespace benchmark {
 
 // The task sizes and iteration numbers come from the Driver Perfomance Benchmarking Reference Doc.
-benchmark_runner::benchmark_runner(std::set<benchmark_type> types) : _types{types} {
+benchmark_runner::benchmark_runner(std::set<benchmark_type> types,
+                                   std::vector<std::string> name_filters,
+                                   run_limits limits)
+    : _types{types}, _name_filters{std::move(name_filters)}, _limits{limits} {
     using bsoncxx::stdx::make_unique;
 
     // Bson microbenchmarks
@@ -42,7 +67,50 @@ benchmark_runner::benchmark_runner(std::set<benchmark_type> types) : _types{type
         make_unique<bson_encoding>("TestDeepEncoding", 19.64, "extended_bson/deep_bson.json"));
     _microbenches.push_back(
         make_unique<bson_encoding>("TestFullEncoding", 57.34, "extended_bson/full_bson.json"));
-    // TODO CXX-1241: Add bson_decoding equivalents.
+    _microbenches.push_back(
+        make_unique<bson_decoding>("TestFlatDecoding", 75.31, "extended_bson/flat_bson.json"));
+    _microbenches.push_back(
+        make_unique<bson_decoding>("TestDeepDecoding", 19.64, "extended_bson/deep_bson.json"));
+    _microbenches.push_back(
+        make_unique<bson_decoding>("TestFullDecoding", 57.34, "extended_bson/full_bson.json"));
+
+    // bsoncxx-specific microbenchmarks, not part of the BSONBench composite
+    _microbenches.push_back(
+        make_unique<bson_iteration>("TestFlatIteration", 75.31, "extended_bson/flat_bson.json"));
+    _microbenches.push_back(
+        make_unique<bson_iteration>("TestDeepIteration", 19.64, "extended_bson/deep_bson.json"));
+    _microbenches.push_back(
+        make_unique<bson_validation>("TestFlatValidation", 75.31, "extended_bson/flat_bson.json"));
+    _microbenches.push_back(
+        make_unique<bson_validation>("TestFullValidation", 57.34, "extended_bson/full_bson.json"));
+    _microbenches.push_back(make_unique<bson_validation>(
+        "TestTweetValidation", 16.22, "single_and_multi_document/tweet.json"));
+
+    // Builder API comparisons, also not part of the BSONBench composite
+    const struct {
+        const char* name;
+        double task_size;
+        const char* json_file;
+    } builder_corpora[] = {{"Flat", 75.31, "extended_bson/flat_bson.json"},
+                           {"Deep", 19.64, "extended_bson/deep_bson.json"},
+                           {"Full", 57.34, "extended_bson/full_bson.json"}};
+    for (auto&& corpus : builder_corpora) {
+        const std::string base = std::string{"Test"} + corpus.name + "Builder";
+        _microbenches.push_back(make_unique<builder_encoding>(
+            base + "Core", corpus.task_size, corpus.json_file, builder_flavor::k_core));
+        _microbenches.push_back(make_unique<builder_encoding>(
+            base + "Basic", corpus.task_size, corpus.json_file, builder_flavor::k_basic));
+        _microbenches.push_back(make_unique<builder_encoding>(
+            base + "Stream", corpus.task_size, corpus.json_file, builder_flavor::k_stream));
+    }
+    _microbenches.push_back(
+        make_unique<builder_literal>("TestLiteralBuilderCore", literal_flavor::k_core));
+    _microbenches.push_back(
+        make_unique<builder_literal>("TestLiteralBuilderBasic", literal_flavor::k_basic));
+    _microbenches.push_back(
+        make_unique<builder_literal>("TestLiteralBuilderStream", literal_flavor::k_stream));
+    _microbenches.push_back(make_unique<builder_literal>("TestLiteralMakeDocument",
+                                                         literal_flavor::k_make_document));
 
     // Single doc microbenchmarks
     _microbenches.push_back(make_unique<run_command>());
@@ -69,9 +137,49 @@ benchmark_runner::benchmark_runner(std::set<benchmark_type> types) : _types{type
     _microbenches.push_back(make_unique<gridfs_multi_import>("parallel/gridfs_multi"));
     _microbenches.push_back(make_unique<gridfs_multi_export>("parallel/gridfs_multi"));
 
+    // Driver microbenchmarks of paths the spec does not cover
+    _microbenches.push_back(make_unique<aggregate>("single_and_multi_document/tweet.json"));
+    _microbenches.push_back(
+        make_unique<find_one_and_update>("single_and_multi_document/tweet.json"));
+
+    // The GridFS matrix and the thread scaling sweep have a benchmark per cell, so they only run
+    // when asked for by type or by a filter naming them.
+    auto requested = [this](benchmark_type type, const std::string& fragment) {
+        return _types.find(type) != _types.end() ||
+               std::any_of(_name_filters.begin(),
+                           _name_filters.end(),
+                           [&](const std::string& filter) {
+                               return filter.find(fragment) != std::string::npos;
+                           });
+    };
+    if (requested(benchmark_type::gridfs_matrix_bench, "Matrix")) {
+        for (auto&& cell : gridfs_matrix_cells()) {
+            _microbenches.push_back(make_unique<gridfs_matrix_upload>(cell));
+            _microbenches.push_back(make_unique<gridfs_matrix_download>(cell));
+        }
+    }
+    if (requested(benchmark_type::thread_scaling_bench, "ThreadScaling")) {
+        for (auto&& cell : thread_scaling_cells()) {
+            _microbenches.push_back(
+                make_unique<thread_scaling>(cell, "single_and_multi_document/tweet.json"));
+        }
+    }
+
+    // Change streams and transactions need a replica set, so they only run when asked for too.
+    if (requested(benchmark_type::driver_micro_bench, "ChangeStream")) {
+        _microbenches.push_back(
+            make_unique<change_stream_events>("single_and_multi_document/small_doc.json"));
+    }
+    if (requested(benchmark_type::driver_micro_bench, "Transaction")) {
+        _microbenches.push_back(
+            make_unique<with_transaction>("single_and_multi_document/small_doc.json"));
+    }
+
     // Need to remove some
-    if (!_types.empty()) {
-        for (auto&& it = _microbenches.begin(); it != _microbenches.end();) {
+    for (auto it = _microbenches.begin(); it != _microbenches.end();) {
+        bool selected = true;
+
+        if (!_types.empty()) {
             const std::set<benchmark_type>& tags = (*it)->get_tags();
             std::set<benchmark_type> intersect;
             std::set_intersection(tags.begin(),
@@ -79,30 +187,91 @@ benchmark_runner::benchmark_runner(std::set<benchmark_type> types) : _types{type
                                   _types.begin(),
                                   _types.end(),
                                   std::inserter(intersect, intersect.begin()));
+            selected = !intersect.empty();
+        }
 
-            if (intersect.empty()) {
-                _microbenches.erase(it);
-            } else {
-                ++it;
-            }
+        if (selected && !_name_filters.empty()) {
+            const auto name = (*it)->get_name();
+            selected = std::any_of(
+                _name_filters.begin(), _name_filters.end(), [&](const std::string& filter) {
+                    return name.find(filter) != std::string::npos;
+                });
+        }
+
+        if (selected) {
+            ++it;
+        } else {
+            it = _microbenches.erase(it);
         }
     }
 }
 
 void benchmark_runner::run_microbenches() {
-    mongocxx::instance instance{};
+    // Shared by the runners of each connection configuration.
+    mongocxx::instance::current();
 
     for (std::unique_ptr<microbench>& bench : _microbenches) {
         std::cout << "Starting " << bench->get_name() << "..." << std::endl;
 
-        bench->run();
+        bench->run(_limits);
+
+        print_score(bench->get_name(), bench->get_results());
+        std::cout << std::endl;
+    }
+}
+
+namespace {
+
+double seconds(std::chrono::nanoseconds duration) {
+    return static_cast<double>(duration.count()) * 1e-9;
+}
+
+double microseconds(std::chrono::nanoseconds duration) {
+    return static_cast<double>(duration.count()) * 1e-3;
+}
+
+// Names a percentile for a JSON key or CSV metric, e.g. "p50", "p99.9" or "max" for 100.
+std::string percentile_name(double n) {
+    if (n >= 100) {
+        return "max";
+    }
+    std::ostringstream name;
+    name << "p" << n;
+    return name.str();
+}
+
+}  // namespace
+
+void benchmark_runner::print_score(const std::string& name, score_recorder& score) {
+    std::cout << name << ": " << seconds(score.get_percentile(50)) << " second(s) | "
+              << score.get_score() << " MB/s | " << score.get_operations_per_second() << " ops/s"
+              << std::endl;
+
+    // The tail of the task times, and of the operation times for benchmarks that time them.
+    std::cout << "    task p50/p90/p99/p99.9/max: " << seconds(score.get_percentile(50)) << " / "
+              << seconds(score.get_percentile(90)) << " / " << seconds(score.get_percentile(99))
+              << " / " << seconds(score.get_percentile(99.9)) << " / "
+              << seconds(score.get_percentile(100)) << " second(s)" << std::endl;
+
+    if (score.has_operations()) {
+        std::cout << "    operation p50/p90/p99/p99.9/max: "
+                  << microseconds(score.get_operation_percentile(50)) << " / "
+                  << microseconds(score.get_operation_percentile(90)) << " / "
+                  << microseconds(score.get_operation_percentile(99)) << " / "
+                  << microseconds(score.get_operation_percentile(99.9)) << " / "
+                  << microseconds(score.get_operation_percentile(100)) << " us" << std::endl;
+    }
 
-        auto score = bench->get_results();
+    // The CPU time may exceed the wall time for benchmarks that run several threads.
+    auto wall_time = seconds(score.get_execution_time()) /
+                     static_cast<double>(score.get_samples().size());
+    auto cpu_time = seconds(score.get_cpu_time_per_task());
+    std::cout << "    cpu time per task: " << cpu_time << " second(s) ("
+              << 100.0 * cpu_time / wall_time << "% of the wall time)" << std::endl;
 
-        std::cout << bench->get_name() << ": "
-                  << static_cast<double>(score.get_percentile(50).count()) / 1000.0
-                  << " second(s) | " << score.get_score() << " MB/s" << std::endl
-                  << std::endl;
+    if (score.has_allocation_counts()) {
+        std::cout << "    allocations per task: " << score.get_allocations_per_task() << " ("
+                  << score.get_bytes_allocated_per_task() << " bytes)" << std::endl;
     }
 }
 
@@ -146,22 +315,12 @@ double benchmark_runner::calculate_driver_bench_score() {
     return (calculate_read_bench_score() + calculate_write_bench_score()) / 2.0;
 }
 
-void benchmark_runner::print_scores() {
+std::vector<std::pair<std::string, double>> benchmark_runner::composite_scores() {
+    std::vector<std::pair<std::string, double>> scores;
     double read = -1;
     double write = -1;
 
-    std::cout << "Individual microbenchmark scores:" << std::endl << "===========" << std::endl;
-    for (auto&& bench : _microbenches) {
-        auto& score = bench->get_results();
-
-        std::cout << bench->get_name() << ": "
-                  << static_cast<double>(score.get_percentile(50).count()) / 1000.0
-                  << " second(s) | " << score.get_score() << " MB/s" << std::endl;
-    }
-
-    std::cout << std::endl << "Composite benchmarks:" << std::endl << "===========" << std::endl;
-
-    auto print_comp = [this, &read, &write](benchmark_type type) {
+    auto add_composite = [&](benchmark_type type) {
         double avg = calculate_average(type);
 
         if (read < 0 && type == benchmark_type::read_bench) {
@@ -170,21 +329,136 @@ void benchmark_runner::print_scores() {
             write = avg;
         }
 
-        std::cout << type_names[type] << " " << avg << " MB/s" << std::endl;
+        scores.emplace_back(type_names[type], avg);
     };
 
     if (!_types.empty()) {
         for (auto&& type : _types) {
-            print_comp(type);
+            add_composite(type);
         }
     } else {
         for (auto&& pair : names_types) {
-            print_comp(pair.second);
+            if (pair.second != benchmark_type::gridfs_matrix_bench &&
+                pair.second != benchmark_type::thread_scaling_bench) {
+                add_composite(pair.second);
+            }
         }
     }
 
     if (read > 0 && write > 0) {
-        std::cout << "DriverBench: " << (read + write) / 2.0 << " MB/s" << std::endl;
+        scores.emplace_back("DriverBench", (read + write) / 2.0);
+    }
+
+    return scores;
+}
+
+void benchmark_runner::print_scores() {
+    std::cout << "Individual microbenchmark scores:" << std::endl << "===========" << std::endl;
+    for (auto&& bench : _microbenches) {
+        print_score(bench->get_name(), bench->get_results());
+    }
+
+    std::cout << std::endl << "Composite benchmarks:" << std::endl << "===========" << std::endl;
+    for (auto&& composite : composite_scores()) {
+        std::cout << composite.first << " " << composite.second << " MB/s" << std::endl;
+    }
+}
+
+void benchmark_runner::write_json(std::ostream& out) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::sub_array;
+    using bsoncxx::builder::basic::sub_document;
+
+    bsoncxx::builder::basic::document results;
+    results.append(kvp("benchmarks", [this](sub_array benchmarks) {
+        for (auto&& bench : _microbenches) {
+            auto& score = bench->get_results();
+            benchmarks.append([&](sub_document doc) {
+                doc.append(kvp("name", bench->get_name()),
+                           kvp("task_size_mb", score.get_task_size()),
+                           kvp("score_mb_s", score.get_score()),
+                           kvp("ops_per_second", score.get_operations_per_second()),
+                           kvp("cpu_time_per_task_ns",
+                               static_cast<std::int64_t>(score.get_cpu_time_per_task().count())));
+
+                const double percentiles[] = {50, 90, 99, 99.9, 100};
+                doc.append(kvp("task_percentiles_ns", [&](sub_document task) {
+                    for (auto n : percentiles) {
+                        auto time = score.get_percentile(n).count();
+                        task.append(kvp(percentile_name(n), static_cast<std::int64_t>(time)));
+                    }
+                }));
+                if (score.has_operations()) {
+                    doc.append(kvp("operation_percentiles_ns", [&](sub_document operation) {
+                        for (auto n : percentiles) {
+                            auto latency = score.get_operation_percentile(n).count();
+                            operation.append(
+                                kvp(percentile_name(n), static_cast<std::int64_t>(latency)));
+                        }
+                    }));
+                }
+
+                if (score.has_allocation_counts()) {
+                    doc.append(kvp("allocations_per_task", score.get_allocations_per_task()),
+                               kvp("bytes_allocated_per_task",
+                                   score.get_bytes_allocated_per_task()));
+                }
+
+                doc.append(kvp("samples_ns", [&](sub_array samples) {
+                    for (auto&& sample : score.get_samples()) {
+                        samples.append(static_cast<std::int64_t>(sample.count()));
+                    }
+                }));
+            });
+        }
+    }));
+
+    results.append(kvp("composites", [this](sub_array composites) {
+        for (auto&& composite : composite_scores()) {
+            composites.append([&](sub_document doc) {
+                doc.append(kvp("name", composite.first), kvp("score_mb_s", composite.second));
+            });
+        }
+    }));
+
+    out << bsoncxx::to_json(results.view()) << std::endl;
+}
+
+void benchmark_runner::write_csv(std::ostream& out) {
+    out << "name,metric,value" << std::endl;
+
+    const double percentiles[] = {50, 90, 99, 99.9, 100};
+    for (auto&& bench : _microbenches) {
+        auto& score = bench->get_results();
+        const auto name = bench->get_name();
+
+        out << name << ",score_mb_s," << score.get_score() << std::endl;
+        out << name << ",ops_per_second," << score.get_operations_per_second() << std::endl;
+        out << name << ",cpu_time_per_task_ns," << score.get_cpu_time_per_task().count()
+            << std::endl;
+        for (auto n : percentiles) {
+            out << name << ",task_" << percentile_name(n) << "_ns,"
+                << score.get_percentile(n).count() << std::endl;
+        }
+        if (score.has_operations()) {
+            for (auto n : percentiles) {
+                out << name << ",operation_" << percentile_name(n) << "_ns,"
+                    << score.get_operation_percentile(n).count() << std::endl;
+            }
+        }
+        if (score.has_allocation_counts()) {
+            out << name << ",allocations_per_task," << score.get_allocations_per_task()
+                << std::endl;
+            out << name << ",bytes_allocated_per_task," << score.get_bytes_allocated_per_task()
+                << std::endl;
+        }
+        for (auto&& sample : score.get_samples()) {
+            out << name << ",sample_ns," << sample.count() << std::endl;
+        }
+    }
+
+    for (auto&& composite : composite_scores()) {
+        out << composite.first << ",score_mb_s," << composite.second << std::endl;
     }
 }
-}  // namespace benchmark
\ No newline at end of file
+}  // namespace benchmark
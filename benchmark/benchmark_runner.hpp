@@ -14,6 +14,11 @@
 
 #pragma once
 
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/instance.hpp>
 
@@ -23,12 +28,37 @@ namespace benchmark {
 
 class benchmark_runner {
    public:
-    benchmark_runner(std::set<benchmark_type> types = {});
+    //
+    // Runs the benchmarks tagged with any of `types`, or all but the GridFS matrix and the thread
+    // scaling sweep if none are given. If `name_filters` are given, only the benchmarks whose
+    // names contain one of them are run; a filter mentioning "Matrix" or "ThreadScaling" also
+    // selects the GridFS matrix or the thread scaling cells.
+    //
+    benchmark_runner(std::set<benchmark_type> types = {},
+                     std::vector<std::string> name_filters = {},
+                     run_limits limits = {});
 
     void run_microbenches();
 
     void print_scores();
 
+    //
+    // Writes every benchmark's samples, percentiles and score, and the composite scores, as a
+    // JSON document that compare_results() can read.
+    //
+    void write_json(std::ostream& out);
+
+    //
+    // Writes the same results as write_json() as CSV rows of "name,metric,value", with one
+    // "sample_ns" row per sample.
+    //
+    void write_csv(std::ostream& out);
+
+    //
+    // Returns the composite scores of the benchmarks that were run, in MB/s, by composite name.
+    //
+    std::vector<std::pair<std::string, double>> composite_scores();
+
     double calculate_bson_bench_score();
 
     double calculate_single_bench_score();
@@ -46,7 +76,11 @@ class benchmark_runner {
    private:
     double calculate_average(benchmark_type);
 
+    static void print_score(const std::string& name, score_recorder& score);
+
     std::vector<std::unique_ptr<microbench>> _microbenches;
     std::set<benchmark_type> _types;
+    std::vector<std::string> _name_filters;
+    run_limits _limits;
 };
 }  // namespace benchmark
\ No newline at end of file
@@ -14,6 +14,12 @@
 
 #pragma once
 
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/json.hpp>
+#include <bsoncxx/types.hpp>
+#include <bsoncxx/types/value.hpp>
+
 #include "../microbench.hpp"
 
 namespace benchmark {
@@ -34,16 +40,52 @@ class bson_decoding : public microbench {
 
    private:
     std::string _file_name;
-    std::string _json;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _doc;
+    std::size_t _decoded = 0;
 };
 
+inline std::size_t decode_array(bsoncxx::array::view arr);
+
+// Materializes a types::value for every element, recursing into subdocuments and arrays.
+inline std::size_t decode_document(bsoncxx::document::view doc) {
+    std::size_t count = 0;
+    for (auto&& elem : doc) {
+        bsoncxx::types::value value = elem.get_value();
+        ++count;
+        if (value.type() == bsoncxx::type::k_document) {
+            count += decode_document(value.get_document().value);
+        } else if (value.type() == bsoncxx::type::k_array) {
+            count += decode_array(value.get_array().value);
+        }
+    }
+    return count;
+}
+
+inline std::size_t decode_array(bsoncxx::array::view arr) {
+    std::size_t count = 0;
+    for (auto&& elem : arr) {
+        bsoncxx::types::value value = elem.get_value();
+        ++count;
+        if (value.type() == bsoncxx::type::k_document) {
+            count += decode_document(value.get_document().value);
+        } else if (value.type() == bsoncxx::type::k_array) {
+            count += decode_array(value.get_array().value);
+        }
+    }
+    return count;
+}
+
 void bson_decoding::setup() {
-    _json = parse_json_file_to_strings(_file_name)[0];
+    _doc = parse_json_file_to_documents(_file_name)[0];
 }
 
+// Mirroring mongo-c-driver's interpretation of the spec: the BSON is decoded to extended JSON.
+// Every element is also decoded into a types::value, which is how applications read documents.
 void bson_decoding::task() {
     for (std::uint32_t i = 0; i < 10000; i++) {
-        // TODO CXX-1241: call bson_as_extended json on _json.
+        auto json = bsoncxx::to_json(_doc->view(), bsoncxx::ExtendedJsonMode::k_canonical);
+        _decoded += json.size();
+        _decoded += decode_document(_doc->view());
     }
 }
-}  // namespace benchmark
\ No newline at end of file
+}  // namespace benchmark
@@ -0,0 +1,84 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include "../microbench.hpp"
+
+namespace benchmark {
+
+// Measures the cost of walking every element of a document (recursing into subdocuments and
+// arrays) with document::view and array::view iterators, without decoding any values.
+class bson_iteration : public microbench {
+   public:
+    bson_iteration() = delete;
+
+    bson_iteration(std::string name, double task_size, std::string json_file)
+        : microbench{std::move(name),
+                     task_size,
+                     std::set<benchmark_type>{benchmark_type::bson_micro_bench}},
+          _json_file{std::move(json_file)} {}
+
+   protected:
+    void setup();
+    void task();
+
+   private:
+    std::string _json_file;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _doc;
+    std::size_t _elements = 0;
+};
+
+inline std::size_t count_elements(bsoncxx::array::view arr);
+
+inline std::size_t count_elements(bsoncxx::document::view doc) {
+    std::size_t count = 0;
+    for (auto&& elem : doc) {
+        ++count;
+        if (elem.type() == bsoncxx::type::k_document) {
+            count += count_elements(elem.get_document().value);
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            count += count_elements(elem.get_array().value);
+        }
+    }
+    return count;
+}
+
+inline std::size_t count_elements(bsoncxx::array::view arr) {
+    std::size_t count = 0;
+    for (auto&& elem : arr) {
+        ++count;
+        if (elem.type() == bsoncxx::type::k_document) {
+            count += count_elements(elem.get_document().value);
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            count += count_elements(elem.get_array().value);
+        }
+    }
+    return count;
+}
+
+void bson_iteration::setup() {
+    _doc = parse_json_file_to_documents(_json_file)[0];
+}
+
+void bson_iteration::task() {
+    for (std::uint32_t i = 0; i < 10000; i++) {
+        _elements += count_elements(_doc->view());
+    }
+}
+}  // namespace benchmark
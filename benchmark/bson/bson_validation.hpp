@@ -0,0 +1,60 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bsoncxx/validate.hpp>
+
+#include "../microbench.hpp"
+
+namespace benchmark {
+
+// Measures bsoncxx::validate with UTF-8 checking enabled, which is dominated by the scan of
+// string values for text-heavy documents.
+class bson_validation : public microbench {
+   public:
+    bson_validation() = delete;
+
+    bson_validation(std::string name, double task_size, std::string json_file)
+        : microbench{std::move(name),
+                     task_size,
+                     std::set<benchmark_type>{benchmark_type::bson_micro_bench}},
+          _json_file{std::move(json_file)} {
+        _validator.check_utf8(true);
+    }
+
+   protected:
+    void setup();
+    void task();
+
+   private:
+    std::string _json_file;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _doc;
+    bsoncxx::validator _validator;
+    std::size_t _valid = 0;
+};
+
+void bson_validation::setup() {
+    _doc = parse_json_file_to_documents(_json_file)[0];
+}
+
+void bson_validation::task() {
+    auto view = _doc->view();
+    for (std::uint32_t i = 0; i < 10000; i++) {
+        if (bsoncxx::validate(view.data(), view.length(), _validator)) {
+            _valid++;
+        }
+    }
+}
+}  // namespace benchmark
@@ -0,0 +1,351 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/basic/sub_array.hpp>
+#include <bsoncxx/builder/basic/sub_document.hpp>
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/builder/stream/array_context.hpp>
+#include <bsoncxx/builder/stream/document.hpp>
+#include <bsoncxx/builder/stream/helpers.hpp>
+#include <bsoncxx/builder/stream/key_context.hpp>
+#include <bsoncxx/builder/stream/single_context.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include "../microbench.hpp"
+
+namespace benchmark {
+
+// The builder APIs compared by the builder encoding benchmarks.
+enum class builder_flavor { k_core, k_basic, k_stream };
+
+// Measures re-encoding a corpus document element by element with one of the builder APIs. The
+// basic and stream builders open subdocuments and subarrays through callbacks, the way code that
+// builds documents of a runtime shape has to.
+class builder_encoding : public microbench {
+   public:
+    builder_encoding() = delete;
+
+    builder_encoding(std::string name,
+                     double task_size,
+                     std::string json_file,
+                     builder_flavor flavor)
+        : microbench{std::move(name),
+                     task_size,
+                     std::set<benchmark_type>{benchmark_type::bson_micro_bench}},
+          _json_file{std::move(json_file)},
+          _flavor{flavor} {}
+
+   protected:
+    void setup();
+    void task();
+
+   private:
+    std::string _json_file;
+    builder_flavor _flavor;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _doc;
+    std::size_t _bytes = 0;
+};
+
+inline void core_encode(bsoncxx::builder::core& builder, bsoncxx::array::view arr);
+
+inline void core_encode(bsoncxx::builder::core& builder, bsoncxx::document::view doc) {
+    for (auto&& elem : doc) {
+        builder.key_view(elem.key());
+        if (elem.type() == bsoncxx::type::k_document) {
+            builder.open_document();
+            core_encode(builder, elem.get_document().value);
+            builder.close_document();
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            builder.open_array();
+            core_encode(builder, elem.get_array().value);
+            builder.close_array();
+        } else {
+            builder.append(elem.get_value());
+        }
+    }
+}
+
+inline void core_encode(bsoncxx::builder::core& builder, bsoncxx::array::view arr) {
+    for (auto&& elem : arr) {
+        if (elem.type() == bsoncxx::type::k_document) {
+            builder.open_document();
+            core_encode(builder, elem.get_document().value);
+            builder.close_document();
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            builder.open_array();
+            core_encode(builder, elem.get_array().value);
+            builder.close_array();
+        } else {
+            builder.append(elem.get_value());
+        }
+    }
+}
+
+inline void basic_encode(bsoncxx::builder::basic::sub_array builder, bsoncxx::array::view arr);
+
+inline void basic_encode(bsoncxx::builder::basic::sub_document builder,
+                         bsoncxx::document::view doc) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::sub_array;
+    using bsoncxx::builder::basic::sub_document;
+
+    for (auto&& elem : doc) {
+        if (elem.type() == bsoncxx::type::k_document) {
+            builder.append(kvp(elem.key(), [&](sub_document sub) {
+                basic_encode(sub, elem.get_document().value);
+            }));
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            builder.append(
+                kvp(elem.key(), [&](sub_array sub) { basic_encode(sub, elem.get_array().value); }));
+        } else {
+            builder.append(kvp(elem.key(), elem.get_value()));
+        }
+    }
+}
+
+inline void basic_encode(bsoncxx::builder::basic::sub_array builder, bsoncxx::array::view arr) {
+    using bsoncxx::builder::basic::sub_array;
+    using bsoncxx::builder::basic::sub_document;
+
+    for (auto&& elem : arr) {
+        if (elem.type() == bsoncxx::type::k_document) {
+            builder.append(
+                [&](sub_document sub) { basic_encode(sub, elem.get_document().value); });
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            builder.append([&](sub_array sub) { basic_encode(sub, elem.get_array().value); });
+        } else {
+            builder.append(elem.get_value());
+        }
+    }
+}
+
+inline void stream_encode(bsoncxx::builder::stream::array_context<> builder,
+                          bsoncxx::array::view arr);
+
+inline void stream_encode(bsoncxx::builder::stream::key_context<> builder,
+                          bsoncxx::document::view doc) {
+    using namespace bsoncxx::builder::stream;
+
+    for (auto&& elem : doc) {
+        if (elem.type() == bsoncxx::type::k_document) {
+            builder << elem.key() << [&](single_context sub) {
+                auto sub_doc = sub << open_document;
+                stream_encode(sub_doc, elem.get_document().value);
+                sub_doc << close_document;
+            };
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            builder << elem.key() << [&](single_context sub) {
+                auto sub_array = sub << open_array;
+                stream_encode(sub_array, elem.get_array().value);
+                sub_array << close_array;
+            };
+        } else {
+            builder << elem.key() << elem.get_value();
+        }
+    }
+}
+
+inline void stream_encode(bsoncxx::builder::stream::array_context<> builder,
+                          bsoncxx::array::view arr) {
+    using namespace bsoncxx::builder::stream;
+
+    for (auto&& elem : arr) {
+        if (elem.type() == bsoncxx::type::k_document) {
+            builder << [&](single_context sub) {
+                auto sub_doc = sub << open_document;
+                stream_encode(sub_doc, elem.get_document().value);
+                sub_doc << close_document;
+            };
+        } else if (elem.type() == bsoncxx::type::k_array) {
+            builder << [&](single_context sub) {
+                auto sub_array = sub << open_array;
+                stream_encode(sub_array, elem.get_array().value);
+                sub_array << close_array;
+            };
+        } else {
+            builder << elem.get_value();
+        }
+    }
+}
+
+void builder_encoding::setup() {
+    _doc = parse_json_file_to_documents(_json_file)[0];
+}
+
+void builder_encoding::task() {
+    for (std::uint32_t i = 0; i < 10000; i++) {
+        switch (_flavor) {
+            case builder_flavor::k_core: {
+                bsoncxx::builder::core builder{false};
+                core_encode(builder, _doc->view());
+                _bytes += builder.view_document().length();
+                break;
+            }
+            case builder_flavor::k_basic: {
+                bsoncxx::builder::basic::document builder;
+                basic_encode(builder, _doc->view());
+                _bytes += builder.view().length();
+                break;
+            }
+            case builder_flavor::k_stream: {
+                bsoncxx::builder::stream::document builder;
+                stream_encode(builder, _doc->view());
+                _bytes += builder.view().length();
+                break;
+            }
+        }
+    }
+}
+
+// The builder APIs compared by the builder literal benchmarks. make_document only builds
+// documents whose shape is known at compile time, so it has no corpus benchmark.
+enum class literal_flavor { k_core, k_basic, k_stream, k_make_document };
+
+// Measures building the same small document with nested subdocuments and arrays, written out in
+// the code, with each builder API.
+class builder_literal : public microbench {
+   public:
+    builder_literal() = delete;
+
+    builder_literal(std::string name, literal_flavor flavor);
+
+   protected:
+    void task();
+
+   private:
+    literal_flavor _flavor;
+    std::size_t _bytes = 0;
+};
+
+inline bsoncxx::document::value build_literal(literal_flavor flavor) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_array;
+    using bsoncxx::builder::basic::make_document;
+    using bsoncxx::builder::basic::sub_array;
+    using bsoncxx::builder::basic::sub_document;
+
+    switch (flavor) {
+        case literal_flavor::k_core: {
+            bsoncxx::builder::core builder{false};
+            builder.key_view("_id").append(std::int32_t{1});
+            builder.key_view("name").append("Benchmark User");
+            builder.key_view("active").append(true);
+            builder.key_view("score").append(std::int64_t{123456789});
+            builder.key_view("balance").append(1234.5);
+            builder.key_view("tags").open_array().append("a").append("b").append("c").close_array();
+            builder.key_view("address").open_document();
+            builder.key_view("street").append("1 Main Street");
+            builder.key_view("city").append("Springfield");
+            builder.key_view("geo").open_document();
+            builder.key_view("lat").append(40.7).key_view("lng").append(-74.0);
+            builder.close_document().close_document();
+            builder.key_view("orders").open_array();
+            builder.open_document().key_view("sku").append("A1").key_view("qty").append(2);
+            builder.close_document();
+            builder.open_document().key_view("sku").append("B2").key_view("qty").append(1);
+            builder.close_document().close_array();
+            return builder.extract_document();
+        }
+        case literal_flavor::k_basic: {
+            bsoncxx::builder::basic::document builder;
+            builder.append(
+                kvp("_id", 1),
+                kvp("name", "Benchmark User"),
+                kvp("active", true),
+                kvp("score", std::int64_t{123456789}),
+                kvp("balance", 1234.5),
+                kvp("tags",
+                    [](sub_array tags) {
+                        tags.append("a", "b", "c");
+                    }),
+                kvp("address",
+                    [](sub_document address) {
+                        address.append(kvp("street", "1 Main Street"),
+                                       kvp("city", "Springfield"),
+                                       kvp("geo", [](sub_document geo) {
+                                           geo.append(kvp("lat", 40.7), kvp("lng", -74.0));
+                                       }));
+                    }),
+                kvp("orders", [](sub_array orders) {
+                    orders.append([](sub_document order) {
+                        order.append(kvp("sku", "A1"), kvp("qty", 2));
+                    });
+                    orders.append([](sub_document order) {
+                        order.append(kvp("sku", "B2"), kvp("qty", 1));
+                    });
+                }));
+            return builder.extract();
+        }
+        case literal_flavor::k_stream: {
+            using namespace bsoncxx::builder::stream;
+            return document{} << "_id" << 1 << "name"
+                              << "Benchmark User"
+                              << "active" << true << "score" << std::int64_t{123456789}
+                              << "balance" << 1234.5 << "tags" << open_array << "a"
+                              << "b"
+                              << "c" << close_array << "address" << open_document << "street"
+                              << "1 Main Street"
+                              << "city"
+                              << "Springfield"
+                              << "geo" << open_document << "lat" << 40.7 << "lng" << -74.0
+                              << close_document << close_document << "orders" << open_array
+                              << open_document << "sku"
+                              << "A1"
+                              << "qty" << 2 << close_document << open_document << "sku"
+                              << "B2"
+                              << "qty" << 1 << close_document << close_array << finalize;
+        }
+        case literal_flavor::k_make_document:
+            break;
+    }
+
+    return make_document(
+        kvp("_id", 1),
+        kvp("name", "Benchmark User"),
+        kvp("active", true),
+        kvp("score", std::int64_t{123456789}),
+        kvp("balance", 1234.5),
+        kvp("tags", make_array("a", "b", "c")),
+        kvp("address",
+            make_document(kvp("street", "1 Main Street"),
+                          kvp("city", "Springfield"),
+                          kvp("geo", make_document(kvp("lat", 40.7), kvp("lng", -74.0))))),
+        kvp("orders",
+            make_array(make_document(kvp("sku", "A1"), kvp("qty", 2)),
+                       make_document(kvp("sku", "B2"), kvp("qty", 1)))));
+}
+
+// The task builds the document 10000 times, so its size in MB is the document's length / 100.
+inline builder_literal::builder_literal(std::string name, literal_flavor flavor)
+    : microbench{std::move(name),
+                 static_cast<double>(build_literal(flavor).view().length()) / 100.0,
+                 std::set<benchmark_type>{benchmark_type::bson_micro_bench}},
+      _flavor{flavor} {}
+
+void builder_literal::task() {
+    for (std::uint32_t i = 0; i < 10000; i++) {
+        _bytes += build_literal(_flavor).view().length();
+    }
+}
+}  // namespace benchmark
@@ -0,0 +1,134 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace benchmark {
+
+// A histogram of nanosecond latencies in the layout of HdrHistogram: values below 2048 are
+// counted exactly, and above that every power of two is split into 1024 equal sub-buckets, so
+// that each recorded value is kept to within 0.1%. Values above the highest trackable one, about
+// 18 minutes, are counted as that value. Recording is a few shifts and an increment, with no
+// allocation, so that it does not perturb the latencies it measures.
+class hdr_histogram {
+   public:
+    static constexpr int k_sub_bucket_bits = 11;
+    static constexpr std::int64_t k_sub_bucket_count = std::int64_t{1} << k_sub_bucket_bits;
+    static constexpr std::int64_t k_sub_bucket_half_count = k_sub_bucket_count / 2;
+    static constexpr int k_highest_bit = 40;
+    static constexpr std::int64_t k_highest_trackable = (std::int64_t{1} << k_highest_bit) - 1;
+
+    hdr_histogram() : _counts(static_cast<std::size_t>(index_of(k_highest_trackable) + 1)) {}
+
+    void record(std::int64_t value) {
+        value = std::max<std::int64_t>(0, std::min(value, k_highest_trackable));
+        _counts[static_cast<std::size_t>(index_of(value))]++;
+        _total++;
+        _sum += static_cast<double>(value);
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    void merge(const hdr_histogram& other) {
+        for (std::size_t i = 0; i < _counts.size(); i++) {
+            _counts[i] += other._counts[i];
+        }
+        _total += other._total;
+        _sum += other._sum;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+
+    std::uint64_t count() const {
+        return _total;
+    }
+
+    std::int64_t min() const {
+        return _total == 0 ? 0 : _min;
+    }
+
+    std::int64_t max() const {
+        return _max;
+    }
+
+    double mean() const {
+        return _total == 0 ? 0 : _sum / static_cast<double>(_total);
+    }
+
+    // The smallest recorded value that `percentile` percent of the values are at or below, to the
+    // precision of its sub-bucket, reported as the highest value the sub-bucket holds.
+    std::int64_t value_at_percentile(double percentile) const {
+        if (_total == 0) {
+            return 0;
+        }
+
+        auto target = static_cast<std::uint64_t>(
+            std::ceil(std::min(percentile, 100.0) / 100.0 * static_cast<double>(_total)));
+        target = std::max<std::uint64_t>(target, 1);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < _counts.size(); i++) {
+            seen += _counts[i];
+            if (seen >= target) {
+                return std::min(highest_equivalent(static_cast<std::int64_t>(i)), _max);
+            }
+        }
+        return _max;
+    }
+
+   private:
+    static int highest_set_bit(std::int64_t value) {
+        int bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+
+    static std::int64_t index_of(std::int64_t value) {
+        if (value < k_sub_bucket_count) {
+            return value;
+        }
+        // Keep the top k_sub_bucket_bits bits of the value.
+        auto shift = highest_set_bit(value) - (k_sub_bucket_bits - 1);
+        auto sub_bucket = value >> shift;
+        return k_sub_bucket_count + (shift - 1) * k_sub_bucket_half_count +
+               (sub_bucket - k_sub_bucket_half_count);
+    }
+
+    static std::int64_t highest_equivalent(std::int64_t index) {
+        if (index < k_sub_bucket_count) {
+            return index;
+        }
+        auto offset = index - k_sub_bucket_count;
+        auto shift = offset / k_sub_bucket_half_count + 1;
+        auto sub_bucket = offset % k_sub_bucket_half_count + k_sub_bucket_half_count;
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _total = 0;
+    double _sum = 0;
+    std::int64_t _min = std::numeric_limits<std::int64_t>::max();
+    std::int64_t _max = 0;
+};
+
+}  // namespace benchmark
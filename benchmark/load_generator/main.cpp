@@ -0,0 +1,105 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "open_loop.hpp"
+
+#include <mongocxx/instance.hpp>
+
+using namespace benchmark;
+
+namespace {
+
+double parse_number(const std::string& option, const char* value) {
+    try {
+        std::size_t parsed = 0;
+        auto number = std::stod(value, &parsed);
+        if (parsed == std::string{value}.size() && number > 0) {
+            return number;
+        }
+    } catch (const std::logic_error&) {
+    }
+    throw std::invalid_argument("Invalid value for " + option + ": " + value);
+}
+
+load_workload parse_workload(const char* value) {
+    std::string name{value};
+    if (name == "FindOneById") {
+        return load_workload::k_find_one_by_id;
+    }
+    if (name == "InsertOne") {
+        return load_workload::k_insert_one;
+    }
+    if (name == "Mixed") {
+        return load_workload::k_mixed;
+    }
+    throw std::invalid_argument("Invalid workload: " + name);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    load_config config;
+
+    try {
+        for (int x = 1; x < argc; ++x) {
+            std::string option{argv[x]};
+            if (++x == argc) {
+                std::cerr << "Missing value after " << option << std::endl;
+                return 1;
+            }
+
+            if (option == "--uri") {
+                config.uri = argv[x];
+            } else if (option == "--workload") {
+                config.workload = parse_workload(argv[x]);
+            } else if (option == "--rate") {
+                config.rate = parse_number(option, argv[x]);
+            } else if (option == "--duration") {
+                config.duration =
+                    std::chrono::seconds{static_cast<std::int64_t>(parse_number(option, argv[x]))};
+            } else if (option == "--warmup") {
+                config.warmup =
+                    std::chrono::seconds{static_cast<std::int64_t>(parse_number(option, argv[x]))};
+            } else if (option == "--threads") {
+                config.threads = static_cast<std::uint32_t>(parse_number(option, argv[x]));
+            } else {
+                std::cerr << "Invalid option: " << option << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (config.threads == 0) {
+        std::cerr << "--threads must be at least 1" << std::endl;
+        return 1;
+    }
+
+    mongocxx::instance instance{};
+    open_loop_generator generator{config};
+
+    generator.setup();
+    auto result = generator.run();
+    generator.teardown();
+
+    print_load_result(generator.config(), result, std::cout);
+}
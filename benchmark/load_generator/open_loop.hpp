@@ -0,0 +1,231 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "hdr_histogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/exception.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+// The operations issued by the load generator. Mixed issues one insert_one for every four
+// find_one by _id.
+enum class load_workload { k_find_one_by_id, k_insert_one, k_mixed };
+
+struct load_config {
+    std::string uri = mongocxx::uri::k_default_uri;
+    load_workload workload = load_workload::k_find_one_by_id;
+
+    // The operations started per second, whatever the latency of the deployment.
+    double rate = 1000;
+
+    // How long operations are issued and recorded, after `warmup` of unrecorded ones.
+    std::chrono::seconds duration{30};
+    std::chrono::seconds warmup{5};
+
+    // The threads issuing operations, each acquiring a client of the pool per operation. When
+    // they are all busy, operations start late, and the delay counts against them.
+    std::uint32_t threads = 16;
+};
+
+// The latencies of one run. response_time is measured from when each operation was meant to
+// start, so it includes the time spent waiting for a free thread or client: this is the latency
+// a caller issuing requests at the target rate would see, corrected for coordinated omission.
+// service_time is measured from when the operation actually started, as a closed-loop benchmark
+// would measure it.
+struct load_result {
+    hdr_histogram response_time;
+    hdr_histogram service_time;
+    hdr_histogram start_delay;
+    std::uint64_t failures = 0;
+    std::chrono::nanoseconds elapsed{0};
+};
+
+class open_loop_generator {
+   public:
+    static const std::int32_t k_corpus_size{10000};
+
+    explicit open_loop_generator(load_config config)
+        : _config{std::move(config)}, _pool{mongocxx::uri{_config.uri}} {}
+
+    void setup() {
+        using bsoncxx::builder::basic::kvp;
+        using bsoncxx::builder::basic::make_document;
+
+        auto conn = _pool.acquire();
+        auto db = (*conn)["perftest"];
+        db.drop();
+
+        std::vector<bsoncxx::document::value> docs;
+        for (std::int32_t i = 0; i < k_corpus_size; i++) {
+            docs.push_back(make_document(kvp("_id", bsoncxx::types::b_int32{i}),
+                                         kvp("name", "load generator document"),
+                                         kvp("value", i)));
+        }
+        db["corpus"].insert_many(docs);
+        db.create_collection("inserts");
+    }
+
+    void teardown() {
+        auto conn = _pool.acquire();
+        (*conn)["perftest"].drop();
+    }
+
+    load_result run() {
+        using clock = std::chrono::steady_clock;
+
+        // Operation i is meant to start at start + i * interval. Each thread claims the next
+        // operation, sleeps until its intended start if it is early, and runs it.
+        auto interval = std::chrono::duration<double, std::nano>{1e9 / _config.rate};
+        auto warmup_ops = static_cast<std::uint64_t>(_config.rate * _config.warmup.count());
+        auto total_ops =
+            warmup_ops + static_cast<std::uint64_t>(_config.rate * _config.duration.count());
+
+        std::atomic<std::uint64_t> next{0};
+        std::vector<load_result> results(_config.threads);
+        auto start = clock::now();
+
+        std::vector<std::thread> workers;
+        for (std::uint32_t t = 0; t < _config.threads; t++) {
+            auto result = &results[t];
+            workers.push_back(std::thread{[&, result] {
+                for (auto op = next.fetch_add(1); op < total_ops; op = next.fetch_add(1)) {
+                    auto intended =
+                        start + std::chrono::duration_cast<clock::duration>(
+                                    interval * static_cast<double>(op));
+                    std::this_thread::sleep_until(intended);
+
+                    auto actual = clock::now();
+                    bool succeeded = run_operation(static_cast<std::int64_t>(op));
+                    auto end = clock::now();
+
+                    if (op < warmup_ops) {
+                        continue;
+                    }
+                    if (!succeeded) {
+                        result->failures++;
+                    }
+                    result->response_time.record(nanoseconds(end - intended));
+                    result->service_time.record(nanoseconds(end - actual));
+                    result->start_delay.record(nanoseconds(actual - intended));
+                }
+            }});
+        }
+        for (auto&& worker : workers) {
+            worker.join();
+        }
+
+        load_result merged;
+        for (auto&& result : results) {
+            merged.response_time.merge(result.response_time);
+            merged.service_time.merge(result.service_time);
+            merged.start_delay.merge(result.start_delay);
+            merged.failures += result.failures;
+        }
+        // The recorded operations were meant to span the duration after the warmup, and ran for
+        // as long as it took the last of them to finish.
+        merged.elapsed = clock::now() - start -
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(_config.warmup);
+        return merged;
+    }
+
+    const load_config& config() const {
+        return _config;
+    }
+
+   private:
+    template <typename duration>
+    static std::int64_t nanoseconds(duration d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+
+    bool run_operation(std::int64_t op) {
+        using bsoncxx::builder::basic::kvp;
+        using bsoncxx::builder::basic::make_document;
+
+        bool write = _config.workload == load_workload::k_insert_one ||
+                     (_config.workload == load_workload::k_mixed && op % 5 == 0);
+        try {
+            auto client = _pool.acquire();
+            if (write) {
+                (*client)["perftest"]["inserts"].insert_one(
+                    make_document(kvp("op", op), kvp("name", "load generator document")));
+            } else {
+                auto id = static_cast<std::int32_t>(op % k_corpus_size);
+                (*client)["perftest"]["corpus"].find_one(
+                    make_document(kvp("_id", bsoncxx::types::b_int32{id})));
+            }
+            return true;
+        } catch (const mongocxx::exception&) {
+            return false;
+        }
+    }
+
+    load_config _config;
+    mongocxx::pool _pool;
+};
+
+// Prints the achieved rate and the percentiles of each latency, in microseconds.
+inline void print_load_result(const load_config& config,
+                              const load_result& result,
+                              std::ostream& out) {
+    auto seconds = std::chrono::duration<double>{result.elapsed}.count();
+    auto completed = result.response_time.count();
+
+    out << "Target rate: " << config.rate << " ops/s, " << config.threads << " threads\n";
+    out << "Achieved rate: " << std::fixed << std::setprecision(1)
+        << (seconds > 0 ? static_cast<double>(completed) / seconds : 0) << " ops/s ("
+        << completed << " operations, " << result.failures << " failed)\n";
+
+    const double percentiles[] = {50, 90, 99, 99.9, 99.99, 100};
+    const char* labels[] = {"p50", "p90", "p99", "p99.9", "p99.99", "max"};
+    out << std::setw(26) << std::left << "latency (us)" << std::right;
+    for (auto label : labels) {
+        out << std::setw(12) << label;
+    }
+    out << std::setw(12) << "mean"
+        << "\n";
+
+    auto row = [&](const char* name, const hdr_histogram& histogram) {
+        out << std::setw(26) << std::left << name << std::right << std::setprecision(1);
+        for (auto percentile : percentiles) {
+            out << std::setw(12)
+                << static_cast<double>(histogram.value_at_percentile(percentile)) / 1000.0;
+        }
+        out << std::setw(12) << histogram.mean() / 1000.0 << "\n";
+    };
+    row("response time (corrected)", result.response_time);
+    row("service time", result.service_time);
+    row("start delay", result.start_delay);
+}
+
+}  // namespace benchmark
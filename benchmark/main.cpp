@@ -12,18 +12,197 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include <mongocxx/uri.hpp>
+
+#include "allocation_counter.hpp"
 #include "benchmark_runner.hpp"
+#include "results_comparison.hpp"
 
 using namespace benchmark;
 
+namespace {
+
+std::uint32_t parse_count(const std::string& option, const char* value) {
+    try {
+        std::size_t parsed = 0;
+        auto count = std::stoul(value, &parsed);
+        if (parsed == std::string{value}.size() && count <= UINT32_MAX) {
+            return static_cast<std::uint32_t>(count);
+        }
+    } catch (const std::logic_error&) {
+    }
+    throw std::invalid_argument("Invalid value for " + option + ": " + value);
+}
+
+// The connection configurations run by "--connection all": plaintext, TLS, and each compressor
+// with and without TLS.
+const char* const all_connections[] = {
+    "plain", "tls", "zstd", "zlib", "snappy", "tls+zstd", "tls+zlib", "tls+snappy"};
+
+std::vector<std::string> split(const std::string& list, char separator) {
+    std::vector<std::string> parts;
+    std::string::size_type start = 0;
+    while (true) {
+        auto end = list.find(separator, start);
+        parts.push_back(list.substr(start, end - start));
+        if (end == std::string::npos) {
+            return parts;
+        }
+        start = end + 1;
+    }
+}
+
+// Returns `uri` with the options of a connection configuration such as "tls+zstd" appended: "tls"
+// for TLS, and "zstd", "zlib" or "snappy" for a wire compressor. "plain" adds no options.
+std::string connection_config_uri(std::string uri, const std::string& config) {
+    if (config == "plain") {
+        return uri;
+    }
+
+    std::vector<std::string> compressors;
+    bool tls = false;
+    for (auto&& layer : split(config, '+')) {
+        if (layer == "tls") {
+            tls = true;
+        } else if (layer == "zstd" || layer == "zlib" || layer == "snappy") {
+            compressors.push_back(layer);
+        } else {
+            throw std::invalid_argument("Invalid connection configuration: " + config);
+        }
+    }
+
+    auto append_option = [&](const std::string& option) {
+        if (uri.find('?') != std::string::npos) {
+            uri += "&";
+        } else {
+            // Options follow the path, which a URI such as "mongodb://localhost" may not have.
+            auto hosts = uri.find("://");
+            if (uri.find('/', hosts == std::string::npos ? 0 : hosts + 3) == std::string::npos) {
+                uri += "/";
+            }
+            uri += "?";
+        }
+        uri += option;
+    };
+
+    if (tls) {
+        append_option("tls=true");
+    }
+    if (!compressors.empty()) {
+        std::string list;
+        for (auto&& compressor : compressors) {
+            list += (list.empty() ? "" : ",") + compressor;
+        }
+        append_option("compressors=" + list);
+    }
+    return uri;
+}
+
+// Names the results file of one connection configuration when several are run, e.g.
+// "results-tls+zstd.json" for "results.json".
+std::string connection_file(const std::string& file, const std::string& config, bool several) {
+    if (!several) {
+        return file;
+    }
+    auto dot = file.rfind('.');
+    if (dot == std::string::npos || file.find('/', dot) != std::string::npos) {
+        return file + "-" + config;
+    }
+    return file.substr(0, dot) + "-" + config + file.substr(dot);
+}
+
+}  // namespace
+
 int main(int argc, char* argv[]) {
     std::set<benchmark_type> types;
+    std::vector<std::string> name_filters;
+    run_limits limits;
+    std::string json_file;
+    std::string csv_file;
+    std::string uri{mongocxx::uri::k_default_uri};
+    std::vector<std::string> connections{"plain"};
+    bool names_given = false;
 
-    if (argc > 1) {
+    try {
         for (int x = 1; x < argc; ++x) {
             std::string type{argv[x]};
+
+            if (type == "--compare") {
+                if (argc - x != 3) {
+                    std::cerr << "Usage: " << argv[0] << " --compare BASELINE.json CANDIDATE.json"
+                              << std::endl;
+                    return 1;
+                }
+                return compare_results(argv[x + 1], argv[x + 2], std::cout) > 0 ? 2 : 0;
+            }
+
+            if (type == "--count-allocations") {
+                enable_allocation_counting(true);
+                continue;
+            }
+
+            if (type == "--smoke") {
+                // A quick pass over each benchmark, e.g. on every build.
+                limits.min_time = std::chrono::milliseconds{0};
+                limits.max_time = std::chrono::milliseconds{5000};
+                limits.min_iterations = 1;
+                limits.max_iterations = 10;
+                limits.warmup_iterations = 1;
+                continue;
+            }
+
+            if (type.compare(0, 2, "--") == 0) {
+                if (++x == argc) {
+                    std::cerr << "Missing value after " << type << std::endl;
+                    return 1;
+                }
+
+                if (type == "--json") {
+                    json_file = argv[x];
+                } else if (type == "--csv") {
+                    csv_file = argv[x];
+                } else if (type == "--uri") {
+                    uri = argv[x];
+                } else if (type == "--connection") {
+                    connections.clear();
+                    for (auto&& config : split(argv[x], ',')) {
+                        if (config == "all") {
+                            connections.insert(connections.end(),
+                                               std::begin(all_connections),
+                                               std::end(all_connections));
+                        } else {
+                            connections.push_back(config);
+                        }
+                    }
+                } else if (type == "--filter") {
+                    name_filters.emplace_back(argv[x]);
+                } else if (type == "--min-time") {
+                    limits.min_time = std::chrono::milliseconds{parse_count(type, argv[x])};
+                } else if (type == "--max-time") {
+                    limits.max_time = std::chrono::milliseconds{parse_count(type, argv[x])};
+                } else if (type == "--min-iterations") {
+                    limits.min_iterations = parse_count(type, argv[x]);
+                } else if (type == "--max-iterations") {
+                    limits.max_iterations = parse_count(type, argv[x]);
+                } else if (type == "--warmup") {
+                    limits.warmup_iterations = parse_count(type, argv[x]);
+                } else {
+                    std::cerr << "Invalid option: " << type << std::endl;
+                    return 1;
+                }
+                continue;
+            }
+
+            names_given = true;
             auto it = names_types.find(type);
 
             if (it != names_types.end()) {
@@ -32,14 +211,51 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Invalid benchmark: " << type << std::endl;
             }
         }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (names_given && types.empty()) {
+        std::cerr << "No valid benchmarks specified. Exiting." << std::endl;
+        return 1;
+    }
 
-        if (types.empty()) {
-            std::cerr << "No valid benchmarks specified. Exiting." << std::endl;
-            return 1;
+    std::vector<std::string> connection_uris;
+    try {
+        for (auto&& config : connections) {
+            connection_uris.push_back(connection_config_uri(uri, config));
         }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
     }
 
-    benchmark_runner runner{types};
-    runner.run_microbenches();
-    runner.print_scores();
+    const bool several = connections.size() > 1;
+    for (std::size_t i = 0; i < connections.size(); i++) {
+        if (several) {
+            std::cout << "Connection " << connections[i] << ": " << connection_uris[i]
+                      << std::endl
+                      << "===========" << std::endl;
+        }
+
+        // The benchmarks connect when they are constructed, so the URI is set first.
+        set_connection_uri(connection_uris[i]);
+        benchmark_runner runner{types, name_filters, limits};
+        runner.run_microbenches();
+        runner.print_scores();
+
+        if (!json_file.empty()) {
+            std::ofstream out{connection_file(json_file, connections[i], several)};
+            runner.write_json(out);
+        }
+        if (!csv_file.empty()) {
+            std::ofstream out{connection_file(csv_file, connections[i], several)};
+            runner.write_csv(out);
+        }
+
+        if (several) {
+            std::cout << std::endl;
+        }
+    }
 }
@@ -16,29 +16,86 @@
 
 #include <fstream>
 #include <iostream>
+#include <utility>
 
 #include <bsoncxx/json.hpp>
+#include <mongocxx/uri.hpp>
+
+#include "profiler_markers.hpp"
 
 namespace benchmark {
 
-bool finished_running(const std::chrono::duration<std::uint32_t, std::milli>& curr_time,
-                      std::uint32_t iter) {
-    return (curr_time > maxtime || (curr_time > mintime && iter > MAX_ITER));
+namespace {
+
+std::string& configured_uri() {
+    static std::string uri{mongocxx::uri::k_default_uri};
+    return uri;
 }
 
-void microbench::run() {
-    setup();
+}  // namespace
 
-    std::uint32_t iteration = 0;
-    for (iteration = 0; !finished_running(_score.get_execution_time(), iteration); iteration++) {
-        before_task();
+void set_connection_uri(std::string uri) {
+    configured_uri() = std::move(uri);
+}
 
-        _score.start_sample();
-        task();
-        _score.end_sample();
+const std::string& connection_uri() {
+    return configured_uri();
+}
+
+bool finished_running(const std::chrono::nanoseconds& curr_time,
+                      std::uint32_t iter,
+                      const run_limits& limits) {
+    if (limits.max_iterations > 0 && iter >= limits.max_iterations) {
+        return true;
+    }
+    return (curr_time > limits.max_time ||
+            (curr_time >= limits.min_time && iter >= limits.min_iterations));
+}
+
+void microbench::run(const run_limits& limits) {
+    // Profiles of the run attribute time to each step of each benchmark, e.g.
+    // "TestFindOneById/task", when built with MONGOCXX_PROFILER_MARKERS.
+    const auto& setup_region = profiler_region_named(_name + "/setup");
+    const auto& warmup_region = profiler_region_named(_name + "/warmup");
+    const auto& before_task_region = profiler_region_named(_name + "/before_task");
+    const auto& task_region = profiler_region_named(_name + "/task");
+    const auto& after_task_region = profiler_region_named(_name + "/after_task");
+    const auto& teardown_region = profiler_region_named(_name + "/teardown");
+
+    {
+        profiler_region region{setup_region};
+        setup();
+    }
 
+    for (std::uint32_t warmup = 0; warmup < limits.warmup_iterations; warmup++) {
+        profiler_region region{warmup_region};
+        before_task();
+        task();
         after_task();
     }
+
+    std::uint32_t iteration = 0;
+    for (iteration = 0; !finished_running(_score.get_execution_time(), iteration, limits);
+         iteration++) {
+        {
+            profiler_region region{before_task_region};
+            before_task();
+        }
+
+        {
+            profiler_region region{task_region};
+            _score.start_sample();
+            task();
+            _score.end_sample();
+        }
+
+        {
+            profiler_region region{after_task_region};
+            after_task();
+        }
+    }
+
+    profiler_region region{teardown_region};
     teardown();
 }
 
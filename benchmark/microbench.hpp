@@ -17,6 +17,8 @@
 #include "score_recorder.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -35,6 +37,10 @@ enum benchmark_type {
     read_bench,
     write_bench,
     run_command_bench,
+    bson_micro_bench,
+    gridfs_matrix_bench,
+    thread_scaling_bench,
+    driver_micro_bench,
 };
 
 const std::string type_names[] = {"BSONBench",
@@ -43,7 +49,11 @@ const std::string type_names[] = {"BSONBench",
                                   "ParallelBench",
                                   "ReadBench",
                                   "WriteBench",
-                                  "RunCommandBench"};
+                                  "RunCommandBench",
+                                  "BSONMicroBench",
+                                  "GridFSMatrixBench",
+                                  "ThreadScalingBench",
+                                  "DriverMicroBench"};
 
 const std::unordered_map<std::string, benchmark_type> names_types = {
     {"BSONBench", bson_bench},
@@ -52,13 +62,31 @@ const std::unordered_map<std::string, benchmark_type> names_types = {
     {"ParallelBench", parallel_bench},
     {"ReadBench", read_bench},
     {"WriteBench", write_bench},
-    {"RunCommandBench", run_command_bench}};
+    {"RunCommandBench", run_command_bench},
+    {"BSONMicroBench", bson_micro_bench},
+    {"GridFSMatrixBench", gridfs_matrix_bench},
+    {"ThreadScalingBench", thread_scaling_bench},
+    {"DriverMicroBench", driver_micro_bench}};
 
 const std::chrono::milliseconds mintime{60000};
 const std::chrono::milliseconds maxtime{300000};
 
 const std::int32_t MAX_ITER = 100;
 
+// How long each benchmark runs. The defaults are the spec's: at least a minute and MAX_ITER
+// iterations, and at most five minutes.
+struct run_limits {
+    std::chrono::milliseconds min_time{mintime};
+    std::chrono::milliseconds max_time{maxtime};
+    std::uint32_t min_iterations{MAX_ITER};
+
+    // A hard cap on the timed iterations, or 0 for none.
+    std::uint32_t max_iterations{0};
+
+    // Untimed iterations run before the timed ones, e.g. to warm up caches and connection pools.
+    std::uint32_t warmup_iterations{0};
+};
+
 class microbench {
    public:
     microbench() : _score{0} {}
@@ -66,7 +94,7 @@ class microbench {
     microbench(std::string&& name, double task_size, std::set<benchmark_type> tags = {})
         : _score{task_size}, _tags{tags}, _name{std::move(name)} {}
 
-    void run();
+    void run(const run_limits& limits = {});
 
     std::string get_name() {
         return _name;
@@ -100,6 +128,15 @@ class microbench {
     std::string _name;
 };
 
+//
+// Sets the URI that the benchmarks connect with, e.g. one with TLS or compression enabled. It
+// must be set before the benchmarks are constructed. The default is the default URI of
+// mongocxx::uri.
+//
+void set_connection_uri(std::string uri);
+
+const std::string& connection_uri();
+
 std::vector<std::string> parse_json_file_to_strings(const std::string& json_file);
 
 std::vector<bsoncxx::document::value> parse_json_file_to_documents(const std::string& json_file);
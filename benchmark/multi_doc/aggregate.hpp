@@ -0,0 +1,79 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "../microbench.hpp"
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+// Runs a pipeline over the same 10000 tweet documents as TestFindManyAndEmptyCursor and iterates
+// its results, so that the two scores compare the aggregate and find paths for the same data.
+class aggregate : public microbench {
+   public:
+    aggregate(std::string json_file)
+        : microbench{"TestAggregateAndEmptyCursor",
+                     16.22,
+                     std::set<benchmark_type>{benchmark_type::driver_micro_bench}},
+          _conn{mongocxx::uri{connection_uri()}},
+          _json_file{std::move(json_file)} {}
+
+    void setup();
+
+    void teardown();
+
+   protected:
+    void task();
+
+   private:
+    mongocxx::client _conn;
+    std::string _json_file;
+};
+
+void aggregate::setup() {
+    auto doc = parse_json_file_to_documents(_json_file)[0];
+    mongocxx::database db = _conn["perftest"];
+    db.drop();
+    auto coll = db["corpus"];
+    for (std::int32_t i = 0; i < 10000; i++) {
+        coll.insert_one(doc.view());
+    }
+}
+
+void aggregate::teardown() {
+    _conn["perftest"].drop();
+}
+
+void aggregate::task() {
+    mongocxx::pipeline pipeline;
+    pipeline.match(make_document());
+    pipeline.add_fields(make_document(kvp("benchmark", true)));
+
+    auto cursor = _conn["perftest"]["corpus"].aggregate(pipeline);
+
+    // Iterate over the cursor.
+    for (auto&& doc : cursor) {
+    }
+}
+}  // namespace benchmark
@@ -39,7 +39,7 @@ class bulk_insert : public microbench {
                      task_size,
                      std::set<benchmark_type>{benchmark_type::multi_bench,
                                               benchmark_type::write_bench}},
-          _conn{mongocxx::uri{}},
+          _conn{mongocxx::uri{connection_uri()}},
           _doc_num{doc_num},
           _file_name{std::move(json_file)} {}
 
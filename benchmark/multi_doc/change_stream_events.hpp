@@ -0,0 +1,103 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "../microbench.hpp"
+
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/change_stream.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+using bsoncxx::builder::basic::make_document;
+
+// Opens a change stream, inserts 10000 small documents, and times reading their 10000 insert
+// events from the stream. Change streams need a replica set or a sharded cluster.
+class change_stream_events : public microbench {
+   public:
+    static const std::int32_t TOTAL_EVENTS{10000};
+
+    change_stream_events(std::string json_file)
+        : microbench{"TestChangeStreamEvents",
+                     2.75,
+                     std::set<benchmark_type>{benchmark_type::driver_micro_bench}},
+          _conn{mongocxx::uri{connection_uri()}},
+          _json_file{std::move(json_file)} {}
+
+    void setup();
+
+    void before_task();
+
+    void after_task();
+
+    void teardown();
+
+   protected:
+    void task();
+
+   private:
+    mongocxx::client _conn;
+    std::string _json_file;
+    std::vector<bsoncxx::document::value> _docs;
+    bsoncxx::stdx::optional<mongocxx::change_stream> _stream;
+};
+
+void change_stream_events::setup() {
+    auto doc = parse_json_file_to_documents(_json_file)[0];
+    for (std::int32_t i = 0; i < TOTAL_EVENTS; i++) {
+        _docs.push_back(doc);
+    }
+
+    mongocxx::database db = _conn["perftest"];
+    db.drop();
+    db.create_collection("corpus");
+}
+
+void change_stream_events::before_task() {
+    auto coll = _conn["perftest"]["corpus"];
+    _stream = coll.watch(mongocxx::options::change_stream{}.batch_size(1000));
+
+    // The stream only sees the changes made after it was opened.
+    coll.insert_many(_docs);
+}
+
+void change_stream_events::task() {
+    std::int32_t events = 0;
+    while (events < TOTAL_EVENTS) {
+        for (auto&& event : *_stream) {
+            (void)event;
+            if (++events == TOTAL_EVENTS) {
+                break;
+            }
+        }
+    }
+}
+
+void change_stream_events::after_task() {
+    _stream = bsoncxx::stdx::nullopt;
+    _conn["perftest"]["corpus"].delete_many(make_document());
+}
+
+void change_stream_events::teardown() {
+    _conn["perftest"].drop();
+}
+}  // namespace benchmark
@@ -36,7 +36,7 @@ class find_many : public microbench {
                      16.22,
                      std::set<benchmark_type>{benchmark_type::multi_bench,
                                               benchmark_type::read_bench}},
-          _conn{mongocxx::uri{}},
+          _conn{mongocxx::uri{connection_uri()}},
           _json_file{std::move(json_file)} {}
 
     void setup();
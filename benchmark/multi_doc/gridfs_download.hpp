@@ -40,7 +40,7 @@ class gridfs_download : public microbench {
                      52.43,
                      std::set<benchmark_type>{benchmark_type::multi_bench,
                                               benchmark_type::read_bench}},
-          _conn{mongocxx::uri{}},
+          _conn{mongocxx::uri{connection_uri()}},
           _file_name{std::move(file_name)} {}
 
     void setup();
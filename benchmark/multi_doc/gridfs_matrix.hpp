@@ -0,0 +1,214 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "../microbench.hpp"
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <mongocxx/gridfs/bucket.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/gridfs/bucket.hpp>
+#include <mongocxx/options/gridfs/upload.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+// One cell of the GridFS matrix: a file of `file_size` bytes stored in chunks of `chunk_size`
+// bytes and transferred over `parallelism` connections.
+struct gridfs_matrix_cell {
+    std::int32_t chunk_size;
+    std::int64_t file_size;
+    std::uint32_t parallelism;
+};
+
+// The cells run by the GridFSMatrixBench benchmarks. The chunk sizes bracket the default of
+// 255 KiB, and a parallelism of 1 measures the plain streaming uploader and downloader.
+inline std::vector<gridfs_matrix_cell> gridfs_matrix_cells() {
+    const std::int32_t chunk_sizes[] = {64 * 1024, 255 * 1024, 1024 * 1024, 4 * 1024 * 1024};
+    const std::int64_t file_sizes[] = {1024 * 1024, 16 * 1024 * 1024, 128 * 1024 * 1024};
+    const std::uint32_t parallelisms[] = {1, 4, 16};
+
+    std::vector<gridfs_matrix_cell> cells;
+    for (auto chunk_size : chunk_sizes) {
+        for (auto file_size : file_sizes) {
+            for (auto parallelism : parallelisms) {
+                cells.push_back({chunk_size, file_size, parallelism});
+            }
+        }
+    }
+    return cells;
+}
+
+// Names a cell after the benchmark's base name, e.g. "TestGridFsMatrixUpload/255KiB/16MiB/x4".
+inline std::string gridfs_matrix_name(const std::string& base, const gridfs_matrix_cell& cell) {
+    auto size_name = [](std::int64_t bytes) {
+        std::stringstream ss;
+        if (bytes % (1024 * 1024) == 0) {
+            ss << bytes / (1024 * 1024) << "MiB";
+        } else {
+            ss << bytes / 1024 << "KiB";
+        }
+        return ss.str();
+    };
+
+    std::stringstream ss;
+    ss << base << "/" << size_name(cell.chunk_size) << "/" << size_name(cell.file_size) << "/x"
+       << cell.parallelism;
+    return ss.str();
+}
+
+// Random contents, so that no layer of the deployment can compress the file away.
+inline std::vector<std::uint8_t> gridfs_matrix_file(std::int64_t file_size) {
+    std::vector<std::uint8_t> file(static_cast<std::size_t>(file_size));
+    std::mt19937 generator{42};
+    for (auto&& byte : file) {
+        byte = static_cast<std::uint8_t>(generator());
+    }
+    return file;
+}
+
+class gridfs_matrix_upload : public microbench {
+   public:
+    gridfs_matrix_upload(gridfs_matrix_cell cell)
+        : microbench{gridfs_matrix_name("TestGridFsMatrixUpload", cell),
+                     static_cast<double>(cell.file_size) / 1000000.0,
+                     std::set<benchmark_type>{benchmark_type::gridfs_matrix_bench}},
+          _cell{cell},
+          _pool{mongocxx::uri{connection_uri()}} {}
+
+    void setup();
+
+    void before_task();
+
+    void teardown();
+
+   protected:
+    void task();
+
+   private:
+    gridfs_matrix_cell _cell;
+    mongocxx::pool _pool;
+    std::vector<std::uint8_t> _gridfs_file;
+};
+
+void gridfs_matrix_upload::setup() {
+    _gridfs_file = gridfs_matrix_file(_cell.file_size);
+
+    auto conn = _pool.acquire();
+    (*conn)["perftest"].drop();
+}
+
+void gridfs_matrix_upload::before_task() {
+    auto conn = _pool.acquire();
+    auto db = (*conn)["perftest"];
+    auto bucket = db.gridfs_bucket();
+    db[bsoncxx::string::to_string(bucket.bucket_name()) + ".chunks"].drop();
+    db[bsoncxx::string::to_string(bucket.bucket_name()) + ".files"].drop();
+
+    // Create the indexes ahead of the timed upload.
+    auto uploader = bucket.open_upload_stream("one_byte_gridfs_file");
+    std::uint8_t byte[1] = {72};
+    uploader.write(byte, 1);
+    uploader.close();
+}
+
+void gridfs_matrix_upload::teardown() {
+    auto conn = _pool.acquire();
+    (*conn)["perftest"].drop();
+}
+
+void gridfs_matrix_upload::task() {
+    auto conn = _pool.acquire();
+    auto bucket = (*conn)["perftest"].gridfs_bucket(
+        mongocxx::options::gridfs::bucket{}.chunk_size_bytes(_cell.chunk_size));
+
+    mongocxx::options::gridfs::upload options;
+    if (_cell.parallelism > 1) {
+        options.parallelism(_cell.parallelism, _pool);
+    }
+
+    auto uploader = bucket.open_upload_stream("matrix_file", options);
+    uploader.write(_gridfs_file.data(), _gridfs_file.size());
+    uploader.close();
+}
+
+class gridfs_matrix_download : public microbench {
+   public:
+    gridfs_matrix_download(gridfs_matrix_cell cell)
+        : microbench{gridfs_matrix_name("TestGridFsMatrixDownload", cell),
+                     static_cast<double>(cell.file_size) / 1000000.0,
+                     std::set<benchmark_type>{benchmark_type::gridfs_matrix_bench}},
+          _cell{cell},
+          _pool{mongocxx::uri{connection_uri()}} {}
+
+    void setup();
+
+    void teardown();
+
+   protected:
+    void task();
+
+   private:
+    gridfs_matrix_cell _cell;
+    mongocxx::pool _pool;
+    bsoncxx::stdx::optional<bsoncxx::types::value> _id;
+    std::vector<std::uint8_t> _buffer;
+};
+
+void gridfs_matrix_download::setup() {
+    auto conn = _pool.acquire();
+    auto db = (*conn)["perftest"];
+    db.drop();
+
+    auto bucket =
+        db.gridfs_bucket(mongocxx::options::gridfs::bucket{}.chunk_size_bytes(_cell.chunk_size));
+    auto file = gridfs_matrix_file(_cell.file_size);
+    auto uploader = bucket.open_upload_stream("matrix_file");
+    uploader.write(file.data(), file.size());
+    _id = uploader.close().id();
+
+    _buffer.resize(file.size());
+}
+
+void gridfs_matrix_download::teardown() {
+    auto conn = _pool.acquire();
+    (*conn)["perftest"].drop();
+}
+
+void gridfs_matrix_download::task() {
+    auto conn = _pool.acquire();
+    auto bucket = (*conn)["perftest"].gridfs_bucket();
+
+    if (_cell.parallelism > 1) {
+        bucket.download_to_buffer_parallel(
+            _id.value(), _buffer.data(), _buffer.size(), _cell.parallelism, _pool);
+        return;
+    }
+
+    auto downloader = bucket.open_download_stream(_id.value());
+    std::size_t offset = 0;
+    while (auto length_read = downloader.read(_buffer.data() + offset, _buffer.size() - offset)) {
+        offset += length_read;
+    }
+}
+}  // namespace benchmark
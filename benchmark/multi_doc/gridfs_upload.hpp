@@ -37,7 +37,7 @@ class gridfs_upload : public microbench {
                      52.43,
                      std::set<benchmark_type>{benchmark_type::multi_bench,
                                               benchmark_type::write_bench}},
-          _conn{mongocxx::uri{}},
+          _conn{mongocxx::uri{connection_uri()}},
           _file_name{file_name} {}
 
     void setup();
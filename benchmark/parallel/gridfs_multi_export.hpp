@@ -45,7 +45,7 @@ class gridfs_multi_export : public microbench {
                      std::set<benchmark_type>{benchmark_type::parallel_bench,
                                               benchmark_type::read_bench}},
           _directory{std::move(dir)},
-          _pool{mongocxx::uri{}},
+          _pool{mongocxx::uri{connection_uri()}},
           _thread_num{thread_num} {}
 
     void setup();
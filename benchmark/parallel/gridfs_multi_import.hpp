@@ -46,7 +46,7 @@ class gridfs_multi_import : public microbench {
                      std::set<benchmark_type>{benchmark_type::parallel_bench,
                                               benchmark_type::write_bench}},
           _directory{std::move(dir)},
-          _pool{mongocxx::uri{}},
+          _pool{mongocxx::uri{connection_uri()}},
           _thread_num{thread_num} {}
 
     void setup();
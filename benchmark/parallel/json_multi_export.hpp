@@ -50,7 +50,7 @@ class json_multi_export : public microbench {
                      std::set<benchmark_type>{benchmark_type::parallel_bench,
                                               benchmark_type::read_bench}},
           _directory{std::move(dir)},
-          _pool{mongocxx::uri{}},
+          _pool{mongocxx::uri{connection_uri()}},
           _thread_num{thread_num} {}
 
     void setup();
@@ -134,7 +134,7 @@ void json_multi_export::concurrency_task(std::uint32_t start_file, std::uint32_t
         auto cursor = (*conn)["perftest"]["corpus"].find(
             make_document(kvp("file", bsoncxx::types::b_int32{static_cast<std::int32_t>(i)})));
         for (auto&& doc : cursor) {
-            stream << bsoncxx::to_json(doc);
+            bsoncxx::to_json(doc, stream);
             if (++j < DOCS_PER_FILE) {
                 stream << "\n";
             } else {
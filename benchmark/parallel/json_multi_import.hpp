@@ -49,7 +49,7 @@ class json_multi_import : public microbench {
                      std::set<benchmark_type>{benchmark_type::parallel_bench,
                                               benchmark_type::write_bench}},
           _directory{std::move(dir)},
-          _pool{mongocxx::uri{}},
+          _pool{mongocxx::uri{connection_uri()}},
           _thread_num{thread_num} {}
 
     void setup();
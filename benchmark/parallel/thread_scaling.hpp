@@ -0,0 +1,193 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include "../microbench.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+// The workloads run by the ThreadScalingBench benchmarks. Mixed runs one insert_one for every
+// four find_one by _id.
+enum class thread_scaling_workload { k_find_one_by_id, k_insert_one, k_mixed };
+
+// One benchmark of the thread scaling sweep: a workload run by `threads` threads sharing a pool.
+struct thread_scaling_cell {
+    thread_scaling_workload workload;
+    std::uint32_t threads;
+};
+
+// The cells of the sweep: every workload at 1, 2, 4, ... 256 threads.
+inline std::vector<thread_scaling_cell> thread_scaling_cells() {
+    const thread_scaling_workload workloads[] = {thread_scaling_workload::k_find_one_by_id,
+                                                 thread_scaling_workload::k_insert_one,
+                                                 thread_scaling_workload::k_mixed};
+
+    std::vector<thread_scaling_cell> cells;
+    for (auto workload : workloads) {
+        for (std::uint32_t threads = 1; threads <= 256; threads *= 2) {
+            cells.push_back({workload, threads});
+        }
+    }
+    return cells;
+}
+
+// Names a cell, e.g. "TestThreadScaling/FindOneById/x16".
+inline std::string thread_scaling_name(const thread_scaling_cell& cell) {
+    std::stringstream ss;
+    ss << "TestThreadScaling/";
+    switch (cell.workload) {
+        case thread_scaling_workload::k_find_one_by_id:
+            ss << "FindOneById";
+            break;
+        case thread_scaling_workload::k_insert_one:
+            ss << "InsertOne";
+            break;
+        case thread_scaling_workload::k_mixed:
+            ss << "Mixed";
+            break;
+    }
+    ss << "/x" << cell.threads;
+    return ss.str();
+}
+
+// Every cell runs the same number of operations on the tweet document, split between its threads,
+// so that the scores of a workload are comparable across thread counts. Each operation acquires
+// its own client from the pool, as a server handling requests would, so that pool contention
+// shows up in the results.
+class thread_scaling : public microbench {
+   public:
+    static const std::int32_t TOTAL_OPERATIONS{10000};
+
+    thread_scaling() = delete;
+
+    // The task size is that of TestFindOneById, which transfers the same documents.
+    thread_scaling(thread_scaling_cell cell, std::string json_file)
+        : microbench{thread_scaling_name(cell),
+                     16.22,
+                     std::set<benchmark_type>{benchmark_type::thread_scaling_bench}},
+          _cell{cell},
+          _pool{mongocxx::uri{connection_uri()}},
+          _json_file{std::move(json_file)} {}
+
+    void setup();
+
+    void before_task();
+
+    void teardown();
+
+   protected:
+    void task();
+
+   private:
+    void concurrency_task(std::int32_t first_op,
+                          std::int32_t num_ops,
+                          std::vector<std::chrono::nanoseconds>* latencies);
+
+    thread_scaling_cell _cell;
+    mongocxx::pool _pool;
+    std::string _json_file;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _doc;
+};
+
+void thread_scaling::setup() {
+    using bsoncxx::builder::basic::concatenate;
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    _doc = parse_json_file_to_documents(_json_file)[0];
+
+    auto conn = _pool.acquire();
+    auto db = (*conn)["perftest"];
+    db.drop();
+
+    if (_cell.workload != thread_scaling_workload::k_insert_one) {
+        auto coll = db["corpus"];
+        for (std::int32_t i = 1; i <= TOTAL_OPERATIONS; i++) {
+            coll.insert_one(make_document(kvp("_id", bsoncxx::types::b_int32{i}),
+                                          concatenate(_doc->view())));
+        }
+    }
+}
+
+void thread_scaling::before_task() {
+    auto conn = _pool.acquire();
+    (*conn)["perftest"]["inserts"].drop();
+    (*conn)["perftest"].create_collection("inserts");
+}
+
+void thread_scaling::teardown() {
+    auto conn = _pool.acquire();
+    (*conn)["perftest"].drop();
+}
+
+void thread_scaling::task() {
+    auto threads = static_cast<std::int32_t>(_cell.threads);
+    std::vector<std::vector<std::chrono::nanoseconds>> latencies(_cell.threads);
+
+    std::vector<std::thread> workers;
+    for (std::int32_t i = 0; i < threads; i++) {
+        auto first_op = TOTAL_OPERATIONS * i / threads;
+        auto num_ops = TOTAL_OPERATIONS * (i + 1) / threads - first_op;
+        auto thread_latencies = &latencies[static_cast<std::size_t>(i)];
+        workers.push_back(std::thread{[first_op, num_ops, thread_latencies, this] {
+            concurrency_task(first_op, num_ops, thread_latencies);
+        }});
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+
+    for (auto&& thread_latencies : latencies) {
+        _score.add_operations(thread_latencies);
+    }
+}
+
+void thread_scaling::concurrency_task(std::int32_t first_op,
+                                      std::int32_t num_ops,
+                                      std::vector<std::chrono::nanoseconds>* latencies) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    latencies->reserve(static_cast<std::size_t>(num_ops));
+    for (std::int32_t op = first_op; op < first_op + num_ops; op++) {
+        bool write = _cell.workload == thread_scaling_workload::k_insert_one ||
+                     (_cell.workload == thread_scaling_workload::k_mixed && op % 5 == 0);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto client = _pool.acquire();
+        if (write) {
+            (*client)["perftest"]["inserts"].insert_one(_doc->view());
+        } else {
+            auto filter = make_document(kvp("_id", bsoncxx::types::b_int32{op + 1}));
+            (*client)["perftest"]["corpus"].find_one(filter.view());
+        }
+        latencies->push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start));
+    }
+}
+}  // namespace benchmark
@@ -0,0 +1,113 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+#include <ittnotify.h>
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+#include <TracyC.h>
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+#include <sys/sdt.h>
+#endif
+
+namespace benchmark {
+
+//
+// A named region of a benchmark run, such as the tasks of one benchmark, marked for the profiler
+// selected by the MONGOCXX_PROFILER_MARKERS build option with the same markers as the driver's
+// phases: ITT tasks in the "benchmark" domain, Tracy zones, or the SDT probes
+// sdt_benchmark:region_begin and sdt_benchmark:region_end. Without the option, marking a region
+// does nothing.
+//
+struct profiler_region_name {
+    explicit profiler_region_name(std::string name) : name{std::move(name)} {
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+        handle = __itt_string_handle_create(this->name.c_str());
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+        location = {this->name.c_str(), this->name.c_str(), __FILE__, __LINE__, 0};
+#endif
+    }
+
+    std::string name;
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+    __itt_string_handle* handle;
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+    ___tracy_source_location_data location;
+#endif
+};
+
+//
+// Returns the region named `name`. The profilers may read a region's name up to the end of the
+// program, so regions are never freed.
+//
+inline const profiler_region_name& profiler_region_named(std::string name) {
+    static std::mutex mutex;
+    static std::deque<profiler_region_name>* regions = new std::deque<profiler_region_name>;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    regions->emplace_back(std::move(name));
+    return regions->back();
+}
+
+//
+// Marks a region on the calling thread from its construction to its destruction.
+//
+class profiler_region {
+   public:
+    explicit profiler_region(const profiler_region_name& region) {
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+        __itt_task_begin(domain(), __itt_null, __itt_null, region.handle);
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+        _zone = ___tracy_emit_zone_begin(&region.location, 1);
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+        _name = region.name.c_str();
+        DTRACE_PROBE1(benchmark, region_begin, _name);
+#else
+        (void)region;
+#endif
+    }
+
+    ~profiler_region() {
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+        __itt_task_end(domain());
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+        ___tracy_emit_zone_end(_zone);
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+        DTRACE_PROBE1(benchmark, region_end, _name);
+#endif
+    }
+
+    profiler_region(const profiler_region&) = delete;
+    profiler_region& operator=(const profiler_region&) = delete;
+
+   private:
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+    static __itt_domain* domain() {
+        static __itt_domain* const benchmark_domain = __itt_domain_create("benchmark");
+        return benchmark_domain;
+    }
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+    TracyCZoneCtx _zone;
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+    const char* _name;
+#endif
+};
+
+}  // namespace benchmark
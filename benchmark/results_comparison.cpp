@@ -0,0 +1,177 @@
+// Copyright 2017 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "results_comparison.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/json.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <bsoncxx/types.hpp>
+
+namespace benchmark {
+
+namespace {
+
+bsoncxx::document::value read_results(const std::string& file) {
+    std::ifstream stream{file};
+    if (!stream) {
+        throw std::runtime_error("Failed to open " + file);
+    }
+
+    std::stringstream json;
+    json << stream.rdbuf();
+    return bsoncxx::from_json(json.str());
+}
+
+double median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    auto middle = samples.size() / 2;
+    if (samples.size() % 2 == 1) {
+        return samples[middle];
+    }
+    return (samples[middle - 1] + samples[middle]) / 2.0;
+}
+
+std::map<std::string, std::vector<double>> benchmark_samples(bsoncxx::document::view results) {
+    std::map<std::string, std::vector<double>> samples;
+    for (auto&& benchmark : results["benchmarks"].get_array().value) {
+        auto& bench_samples =
+            samples[bsoncxx::string::to_string(benchmark["name"].get_utf8().value)];
+        for (auto&& sample : benchmark["samples_ns"].get_array().value) {
+            bench_samples.push_back(static_cast<double>(sample.get_int64().value));
+        }
+    }
+    return samples;
+}
+
+std::map<std::string, double> composite_scores(bsoncxx::document::view results) {
+    std::map<std::string, double> scores;
+    for (auto&& composite : results["composites"].get_array().value) {
+        scores[bsoncxx::string::to_string(composite["name"].get_utf8().value)] =
+            composite["score_mb_s"].get_double().value;
+    }
+    return scores;
+}
+
+}  // namespace
+
+double mann_whitney_p_value(const std::vector<double>& baseline,
+                            const std::vector<double>& candidate) {
+    const auto n_baseline = static_cast<double>(baseline.size());
+    const auto n_candidate = static_cast<double>(candidate.size());
+    if (baseline.empty() || candidate.empty()) {
+        return 1.0;
+    }
+
+    // Rank the pooled samples, giving tied samples the average of their ranks.
+    std::vector<std::pair<double, bool>> pooled;
+    for (auto sample : baseline) {
+        pooled.emplace_back(sample, false);
+    }
+    for (auto sample : candidate) {
+        pooled.emplace_back(sample, true);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double candidate_rank_sum = 0.0;
+    double tie_correction = 0.0;
+    for (std::size_t i = 0; i < pooled.size();) {
+        auto j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+            j++;
+        }
+
+        const auto rank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2.0;
+        for (auto k = i; k < j; k++) {
+            if (pooled[k].second) {
+                candidate_rank_sum += rank;
+            }
+        }
+
+        const auto ties = static_cast<double>(j - i);
+        tie_correction += ties * ties * ties - ties;
+        i = j;
+    }
+
+    const auto n = n_baseline + n_candidate;
+    const auto u = candidate_rank_sum - n_candidate * (n_candidate + 1.0) / 2.0;
+    const auto mean = n_baseline * n_candidate / 2.0;
+    const auto variance =
+        n_baseline * n_candidate / 12.0 * ((n + 1.0) - tie_correction / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+
+    // With a continuity correction.
+    const auto z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+std::size_t compare_results(const std::string& baseline_file,
+                            const std::string& candidate_file,
+                            std::ostream& out) {
+    auto baseline = read_results(baseline_file);
+    auto candidate = read_results(candidate_file);
+    std::size_t regressions = 0;
+
+    out << "Microbenchmarks (median task time):" << std::endl << "===========" << std::endl;
+    auto baseline_samples = benchmark_samples(baseline.view());
+    for (auto&& bench : benchmark_samples(candidate.view())) {
+        auto found = baseline_samples.find(bench.first);
+        if (found == baseline_samples.end() || found->second.empty() || bench.second.empty()) {
+            out << bench.first << ": not in the baseline" << std::endl;
+            continue;
+        }
+
+        const auto before = median(found->second);
+        const auto after = median(bench.second);
+        const auto change = (after - before) / before;
+        const auto p_value = mann_whitney_p_value(found->second, bench.second);
+        const bool regressed = change > regression_threshold && p_value < regression_significance;
+        regressions += regressed ? 1 : 0;
+
+        out << bench.first << ": " << before * 1e-9 << " s -> " << after * 1e-9 << " s ("
+            << (change >= 0 ? "+" : "") << change * 100.0 << "%, p = " << p_value << ")"
+            << (regressed ? " REGRESSION" : "") << std::endl;
+    }
+
+    out << std::endl << "Composite benchmarks (MB/s):" << std::endl << "===========" << std::endl;
+    auto baseline_scores = composite_scores(baseline.view());
+    for (auto&& composite : composite_scores(candidate.view())) {
+        auto found = baseline_scores.find(composite.first);
+        if (found == baseline_scores.end() || found->second <= 0.0) {
+            out << composite.first << ": not in the baseline" << std::endl;
+            continue;
+        }
+
+        const auto change = (composite.second - found->second) / found->second;
+        const bool regressed = change < -regression_threshold;
+        regressions += regressed ? 1 : 0;
+
+        out << composite.first << ": " << found->second << " -> " << composite.second << " ("
+            << (change >= 0 ? "+" : "") << change * 100.0 << "%)"
+            << (regressed ? " REGRESSION" : "") << std::endl;
+    }
+
+    out << std::endl << regressions << " regression(s)" << std::endl;
+    return regressions;
+}
+}  // namespace benchmark
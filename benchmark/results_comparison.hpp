@@ -0,0 +1,59 @@
+// Copyright 2017 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+//
+// The smallest slowdown of a benchmark's median task time, or drop of a composite score, that is
+// reported as a regression.
+//
+constexpr double regression_threshold = 0.05;
+
+//
+// The significance level a slowdown must reach to be reported as a regression.
+//
+constexpr double regression_significance = 0.01;
+
+//
+// Returns the one-sided p-value of the Mann-Whitney U test of whether the `candidate` samples tend
+// to be greater than the `baseline` samples, using the normal approximation with a tie
+// correction.
+//
+double mann_whitney_p_value(const std::vector<double>& baseline,
+                            const std::vector<double>& candidate);
+
+//
+// Compares two result files written by benchmark_runner::write_json() and prints the change of
+// every benchmark and composite to `out`.
+//
+// A benchmark regressed if its median task time grew by more than regression_threshold and the
+// Mann-Whitney test of its samples is significant at regression_significance. Composites have no
+// samples, so a composite regressed if its score dropped by more than regression_threshold.
+//
+// @return
+//   The number of regressions.
+//
+// @exception
+//   A runtime error is thrown if a file cannot be read.
+//
+std::size_t compare_results(const std::string& baseline_file,
+                            const std::string& candidate_file,
+                            std::ostream& out);
+}  // namespace benchmark
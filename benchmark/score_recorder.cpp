@@ -15,50 +15,154 @@
 #include "score_recorder.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <stdexcept>
 
 namespace benchmark {
 
+namespace {
+
+// Returns the nearest-rank nth percentile of `samples`, sorting them first if needed.
+const std::chrono::nanoseconds& percentile(std::vector<std::chrono::nanoseconds>& samples,
+                                           bool& sorted,
+                                           double n) {
+    if (!sorted) {
+        std::sort(samples.begin(), samples.end());
+        sorted = true;
+    }
+
+    auto rank =
+        static_cast<std::size_t>(std::ceil(n / 100.0 * static_cast<double>(samples.size())));
+    return samples[std::min(std::max<std::size_t>(rank, 1), samples.size()) - 1];
+}
+
+}  // namespace
+
 score_recorder::score_recorder(double task_size)
-    : _execution_time{0}, _sorted{false}, _task_size{task_size} {}
+    : _execution_time{0},
+      _last_start_cpu{0},
+      _cpu_time{0},
+      _last_start_allocations{0, 0},
+      _allocations{0, 0},
+      _counted_samples{0},
+      _sorted{false},
+      _operations_sorted{false},
+      _task_size{task_size} {}
 
-const std::chrono::milliseconds& score_recorder::get_execution_time() const {
+const std::chrono::nanoseconds& score_recorder::get_execution_time() const {
     return _execution_time;
 }
 
+std::chrono::nanoseconds score_recorder::get_cpu_time_per_task() const {
+    if (_samples.empty()) {
+        return std::chrono::nanoseconds{0};
+    }
+    return _cpu_time / static_cast<std::int64_t>(_samples.size());
+}
+
 void benchmark::score_recorder::start_sample() {
+    _last_start_allocations = current_allocation_counts();
+    _last_start_cpu = std::clock();
     _last_start = std::chrono::high_resolution_clock::now();
 }
 
 void score_recorder::end_sample() {
     std::chrono::time_point<std::chrono::high_resolution_clock> end =
         std::chrono::high_resolution_clock::now();
-    std::chrono::milliseconds duration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(end - _last_start);
+    std::clock_t end_cpu = std::clock();
+
+    // Read the counts before recording the sample, which may allocate.
+    if (allocation_counting_enabled()) {
+        auto counts = current_allocation_counts();
+        _allocations.allocations += counts.allocations - _last_start_allocations.allocations;
+        _allocations.bytes += counts.bytes - _last_start_allocations.bytes;
+        _counted_samples++;
+    }
+    std::chrono::nanoseconds duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - _last_start);
 
     _samples.push_back(duration);
     _sorted = false;
     _execution_time += duration;
+    _cpu_time += std::chrono::nanoseconds{static_cast<std::int64_t>(
+        static_cast<double>(end_cpu - _last_start_cpu) * 1e9 / CLOCKS_PER_SEC)};
+}
+
+void score_recorder::start_operation() {
+    _last_operation_start = std::chrono::high_resolution_clock::now();
+}
+
+void score_recorder::end_operation() {
+    std::chrono::time_point<std::chrono::high_resolution_clock> end =
+        std::chrono::high_resolution_clock::now();
+
+    _operations.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - _last_operation_start));
+    _operations_sorted = false;
 }
 
-const std::chrono::milliseconds& score_recorder::get_percentile(unsigned long n) {
+void score_recorder::add_operations(const std::vector<std::chrono::nanoseconds>& operations) {
+    _operations.insert(_operations.end(), operations.begin(), operations.end());
+    _operations_sorted = false;
+}
+
+const std::chrono::nanoseconds& score_recorder::get_percentile(double n) {
     if (_samples.empty()) {
         throw std::runtime_error("No samples recorded yet");
     }
 
-    if (!_sorted) {
-        std::sort(_samples.begin(), _samples.end());
-        _sorted = true;
+    return percentile(_samples, _sorted, n);
+}
+
+const std::chrono::nanoseconds& score_recorder::get_operation_percentile(double n) {
+    if (_operations.empty()) {
+        throw std::runtime_error("No operations recorded yet");
     }
 
-    if (_samples.size() == 1) {
-        return _samples[0];
+    return percentile(_operations, _operations_sorted, n);
+}
+
+bool score_recorder::has_operations() const {
+    return !_operations.empty();
+}
+
+double score_recorder::get_operations_per_second() const {
+    if (_execution_time.count() == 0) {
+        return 0.0;
     }
 
-    return _samples[(_samples.size() * n / 100) - 1];
+    auto count = has_operations() ? _operations.size() : _samples.size();
+    return static_cast<double>(count) / (static_cast<double>(_execution_time.count()) * 1e-9);
+}
+
+const std::vector<std::chrono::nanoseconds>& score_recorder::get_samples() const {
+    return _samples;
+}
+
+bool score_recorder::has_allocation_counts() const {
+    return _counted_samples > 0;
+}
+
+double score_recorder::get_allocations_per_task() const {
+    if (_counted_samples == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(_allocations.allocations) / static_cast<double>(_counted_samples);
+}
+
+double score_recorder::get_bytes_allocated_per_task() const {
+    if (_counted_samples == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(_allocations.bytes) / static_cast<double>(_counted_samples);
+}
+
+double score_recorder::get_task_size() const {
+    return _task_size;
 }
 
 double score_recorder::get_score() {
-    return _task_size / (static_cast<double>(get_percentile(50).count()) * .001);
+    return _task_size / (static_cast<double>(get_percentile(50).count()) * 1e-9);
 }
 }  // namespace benchmark
@@ -15,9 +15,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <ctime>
 #include <vector>
 
+#include "allocation_counter.hpp"
+
 namespace benchmark {
 class score_recorder {
    public:
@@ -38,16 +41,43 @@ class score_recorder {
     //
     void end_sample();
 
+    //
+    // Starts the timer for a single operation within a sample, such as one insert_one of a task
+    // that inserts many documents.
+    //
+    void start_operation();
+
+    //
+    // Stops the operation timer and stores the time of the operation.
+    //
+    // @note
+    //   This method should only be run once after a call to start_operation().
+    //
+    void end_operation();
+
+    //
+    // Stores operation times that were measured elsewhere, e.g. by the threads of a parallel
+    // task, which cannot share the operation timer.
+    //
+    void add_operations(const std::vector<std::chrono::nanoseconds>& operations);
+
     //
     // Returns the cumulative wall clock execution time of all samples that have been run.
     //
     // @return
     //  The cumulative execution time.
     //
-    const std::chrono::milliseconds& get_execution_time() const;
+    const std::chrono::nanoseconds& get_execution_time() const;
+
+    //
+    // Returns the mean CPU time used by the process during a sample, across all of its threads.
+    // Unlike the wall clock time, this includes none of the time spent waiting on the server, so
+    // it shows the client-side cost of layers such as TLS and wire compression.
+    //
+    std::chrono::nanoseconds get_cpu_time_per_task() const;
 
     //
-    // Gets the nth percentile sample runtime.
+    // Gets the nth percentile sample runtime, e.g. get_percentile(99.9).
     //
     // @return
     //   The "nth" percentile recorded sample time.
@@ -58,7 +88,62 @@ class score_recorder {
     // @note
     //   This method should only be called after all samples are completed.
     //
-    const std::chrono::milliseconds& get_percentile(unsigned long n);
+    const std::chrono::nanoseconds& get_percentile(double n);
+
+    //
+    // Gets the nth percentile operation runtime.
+    //
+    // @return
+    //   The "nth" percentile recorded operation time.
+    //
+    // @exception
+    //   A runtime error is thrown if this method is called before any operations have been
+    //   recorded.
+    //
+    // @note
+    //   This method should only be called after all samples are completed.
+    //
+    const std::chrono::nanoseconds& get_operation_percentile(double n);
+
+    //
+    // Returns whether the benchmark timed its individual operations.
+    //
+    bool has_operations() const;
+
+    //
+    // Gets the throughput of this benchmark.
+    //
+    // @return
+    //   The operations completed per second of execution time, or the samples per second if the
+    //   benchmark did not time its individual operations.
+    //
+    double get_operations_per_second() const;
+
+    //
+    // Returns the recorded sample times, in the order they were recorded unless a percentile has
+    // been computed since.
+    //
+    const std::vector<std::chrono::nanoseconds>& get_samples() const;
+
+    //
+    // Returns whether allocations were counted while the samples ran.
+    //
+    bool has_allocation_counts() const;
+
+    //
+    // Returns the mean number of allocations made by a task, or 0 if none were counted.
+    //
+    double get_allocations_per_task() const;
+
+    //
+    // Returns the mean number of bytes allocated by a task, or 0 if none were counted.
+    //
+    double get_bytes_allocated_per_task() const;
+
+    //
+    // Returns the size of the benchmark's task in MB.
+    //
+    double get_task_size() const;
 
     //
     // Gets the score for this benchmark.
@@ -77,12 +162,28 @@ class score_recorder {
    private:
     std::chrono::time_point<std::chrono::high_resolution_clock> _last_start;
 
-    std::chrono::milliseconds _execution_time;
+    std::chrono::time_point<std::chrono::high_resolution_clock> _last_operation_start;
+
+    std::chrono::nanoseconds _execution_time;
+
+    std::clock_t _last_start_cpu;
+
+    std::chrono::nanoseconds _cpu_time;
+
+    allocation_counts _last_start_allocations;
+
+    allocation_counts _allocations;
+
+    std::size_t _counted_samples;
 
     bool _sorted;
 
+    bool _operations_sorted;
+
     double _task_size;
 
-    std::vector<std::chrono::milliseconds> _samples;
+    std::vector<std::chrono::nanoseconds> _samples;
+
+    std::vector<std::chrono::nanoseconds> _operations;
 };
 }  // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,84 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "../microbench.hpp"
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/find_one_and_update.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+using bsoncxx::builder::basic::concatenate;
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+// Increments a counter in each of 10000 tweet documents by _id, returning the updated document,
+// so that the score compares findAndModify with TestFindOneById for the same data.
+class find_one_and_update : public microbench {
+   public:
+    find_one_and_update(std::string json_file)
+        : microbench{"TestFindOneAndUpdateById",
+                     16.22,
+                     std::set<benchmark_type>{benchmark_type::driver_micro_bench}},
+          _conn{mongocxx::uri{connection_uri()}},
+          _json_file{std::move(json_file)} {}
+
+   protected:
+    void setup();
+
+    void teardown();
+
+    void task();
+
+   private:
+    mongocxx::client _conn;
+    std::string _json_file;
+};
+
+void find_one_and_update::setup() {
+    auto doc = parse_json_file_to_documents(_json_file)[0];
+    mongocxx::database db = _conn["perftest"];
+    db.drop();
+    auto coll = db["corpus"];
+    for (std::int32_t i = 1; i <= 10000; i++) {
+        coll.insert_one(make_document(kvp("_id", bsoncxx::types::b_int32{i}),
+                                      kvp("counter", 0),
+                                      concatenate(doc.view())));
+    }
+}
+
+void find_one_and_update::task() {
+    auto coll = _conn["perftest"]["corpus"];
+    auto update = make_document(kvp("$inc", make_document(kvp("counter", 1))));
+    mongocxx::options::find_one_and_update options;
+    options.return_document(mongocxx::options::return_document::k_after);
+
+    for (std::int32_t i = 1; i <= 10000; i++) {
+        _score.start_operation();
+        coll.find_one_and_update(
+            make_document(kvp("_id", bsoncxx::types::b_int32{i})), update.view(), options);
+        _score.end_operation();
+    }
+}
+
+void find_one_and_update::teardown() {
+    _conn["perftest"].drop();
+}
+}  // namespace benchmark
@@ -36,7 +36,7 @@ class find_one_by_id : public microbench {
                      16.22,
                      std::set<benchmark_type>{benchmark_type::single_bench,
                                               benchmark_type::read_bench}},
-          _conn{mongocxx::uri{}},
+          _conn{mongocxx::uri{connection_uri()}},
           _json_file{std::move(json_file)} {}
 
    protected:
@@ -66,11 +66,13 @@ void find_one_by_id::setup() {
 void find_one_by_id::task() {
     auto coll = _conn["perftest"]["corpus"];
     for (std::int32_t i = 1; i <= 10000; i++) {
+        _score.start_operation();
         auto cursor = coll.find(make_document(kvp("_id", bsoncxx::types::b_int32{i})));
 
         // Iterate over the cursor.
         for (auto&& doc : cursor) {
         }
+        _score.end_operation();
     }
 }
 
@@ -37,7 +37,7 @@ class insert_one : public microbench {
                      task_size,
                      std::set<benchmark_type>{benchmark_type::single_bench,
                                               benchmark_type::write_bench}},
-          _conn{mongocxx::uri{}},
+          _conn{mongocxx::uri{connection_uri()}},
           _iter{iter},
           _file_name{std::move(json_file)} {}
 
@@ -73,7 +73,9 @@ void insert_one::before_task() {
 
 void insert_one::task() {
     for (std::int32_t i = 0; i < _iter; i++) {
+        _score.start_operation();
         _coll.insert_one(_doc->view());
+        _score.end_operation();
     }
 }
 
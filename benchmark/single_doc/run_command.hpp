@@ -33,7 +33,7 @@ class run_command : public microbench {
         : microbench{"TestRunCommand",
                      0.16,
                      std::set<benchmark_type>{benchmark_type::run_command_bench}},
-          _conn{mongocxx::uri{}} {
+          _conn{mongocxx::uri{connection_uri()}} {
         _db = _conn["perftest"];
     }
 
@@ -47,7 +47,9 @@ class run_command : public microbench {
 void run_command::task() {
     auto command = make_document(kvp("ismaster", true));
     for (std::int32_t i = 0; i < 10000; i++) {
+        _score.start_operation();
         _db.run_command(command.view());
+        _score.end_operation();
     }
 }
 }  // namespace benchmark
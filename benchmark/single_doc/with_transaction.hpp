@@ -0,0 +1,96 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "../microbench.hpp"
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/client_session.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace benchmark {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+// Runs 1000 transactions through client_session::with_transaction, each inserting a small
+// document and incrementing a counter, as an application recording an event would. Each
+// transaction is timed as one operation. Transactions need a replica set or a sharded cluster.
+class with_transaction : public microbench {
+   public:
+    static const std::int32_t TOTAL_TRANSACTIONS{1000};
+
+    with_transaction(std::string json_file)
+        : microbench{"TestWithTransaction",
+                     0.275,
+                     std::set<benchmark_type>{benchmark_type::driver_micro_bench}},
+          _conn{mongocxx::uri{connection_uri()}},
+          _json_file{std::move(json_file)} {}
+
+   protected:
+    void setup();
+
+    void before_task();
+
+    void task();
+
+    void teardown();
+
+   private:
+    mongocxx::client _conn;
+    std::string _json_file;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _doc;
+};
+
+void with_transaction::setup() {
+    _doc = parse_json_file_to_documents(_json_file)[0];
+    mongocxx::database db = _conn["perftest"];
+    db.drop();
+}
+
+void with_transaction::before_task() {
+    // Collections cannot be created inside a transaction on servers before 4.4.
+    auto db = _conn["perftest"];
+    db["corpus"].drop();
+    db["counters"].drop();
+    db.create_collection("corpus");
+    db["counters"].insert_one(make_document(kvp("_id", "events"), kvp("count", 0)));
+}
+
+void with_transaction::task() {
+    auto session = _conn.start_session();
+    auto corpus = _conn["perftest"]["corpus"];
+    auto counters = _conn["perftest"]["counters"];
+    auto counter = make_document(kvp("_id", "events"));
+    auto increment = make_document(kvp("$inc", make_document(kvp("count", 1))));
+
+    for (std::int32_t i = 0; i < TOTAL_TRANSACTIONS; i++) {
+        _score.start_operation();
+        session.with_transaction([&](mongocxx::client_session* s) {
+            corpus.insert_one(*s, _doc->view());
+            counters.update_one(*s, counter.view(), increment.view());
+        });
+        _score.end_operation();
+    }
+}
+
+void with_transaction::teardown() {
+    _conn["perftest"].drop();
+}
+}  // namespace benchmark
@@ -0,0 +1,124 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the startup cost of processes using the driver, such as command line tools and
+// serverless functions, by timing child processes that run one step of startup each and exit.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mongocxx/client.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/logger.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace {
+
+// The steps run by a child process. "none" measures the cost of starting a process at all.
+const char* const k_modes[] = {"none", "eager", "lazy", "lazy-client"};
+
+int run_child(const std::string& mode, const std::string& uri) {
+    if (mode == "none") {
+        return 0;
+    }
+    if (mode == "eager") {
+        mongocxx::instance instance{};
+        return 0;
+    }
+    if (mode == "lazy") {
+        mongocxx::instance instance{
+            nullptr, nullptr, mongocxx::instance::initialization::k_lazy};
+        return 0;
+    }
+    if (mode == "lazy-client") {
+        // The client initializes libmongoc; no connection is made until an operation runs.
+        mongocxx::instance instance{
+            nullptr, nullptr, mongocxx::instance::initialization::k_lazy};
+        mongocxx::client client{mongocxx::uri{uri}};
+        return 0;
+    }
+
+    std::cerr << "Invalid mode: " << mode << std::endl;
+    return 1;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    auto index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+    return samples[index];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::int64_t runs = 200;
+    std::string uri = mongocxx::uri::k_default_uri;
+
+    for (int x = 1; x < argc; ++x) {
+        std::string option{argv[x]};
+        if (++x == argc) {
+            std::cerr << "Missing value after " << option << std::endl;
+            return 1;
+        }
+
+        if (option == "--child") {
+            return run_child(argv[x], uri);
+        } else if (option == "--uri") {
+            uri = argv[x];
+        } else if (option == "--runs") {
+            try {
+                runs = std::stoll(argv[x]);
+            } catch (const std::logic_error&) {
+                runs = 0;
+            }
+            if (runs <= 0) {
+                std::cerr << "Invalid value for --runs: " << argv[x] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Invalid option: " << option << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Mode          p50 (ms)  p90 (ms)" << std::endl;
+    for (auto mode : k_modes) {
+        // std::system() goes through the shell, whose cost is included in the "none" baseline.
+        const std::string command = std::string{"\""} + argv[0] + "\" --uri \"" + uri +
+                                    "\" --child " + mode;
+
+        std::vector<double> samples;
+        for (std::int64_t run = 0; run < runs; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            if (std::system(command.c_str()) != 0) {
+                std::cerr << "Child process failed: " << command << std::endl;
+                return 1;
+            }
+            samples.push_back(std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count());
+        }
+
+        std::cout << std::left << std::setw(14) << mode << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(8) << percentile(samples, 0.5)
+                  << std::setw(10) << percentile(samples, 0.9) << std::endl;
+    }
+}
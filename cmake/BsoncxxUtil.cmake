@@ -5,6 +5,8 @@
 # - libbson_target
 # - libbson_definitions
 # - libbson_include_directories
+#
+# It also requires that find_package(Threads) has been called.
 function(bsoncxx_add_library TARGET OUTPUT_NAME LINK_TYPE)
     add_library(${TARGET} ${LINK_TYPE}
         ${bsoncxx_sources}
@@ -40,7 +42,7 @@ function(bsoncxx_add_library TARGET OUTPUT_NAME LINK_TYPE)
 	endif()
     endif()
 
-    target_link_libraries(${TARGET} PRIVATE ${libbson_target})
+    target_link_libraries(${TARGET} PRIVATE ${libbson_target} Threads::Threads)
     target_include_directories(${TARGET} PRIVATE ${libbson_include_directories})
     target_compile_definitions(${TARGET} PRIVATE ${libbson_definitions})
 
@@ -5,6 +5,11 @@
 # - libmongoc_target
 # - libmongoc_definitions
 # - libmongoc_definitions
+# - profiler_markers_include_directories, profiler_markers_libraries and
+#   profiler_markers_definitions, from ProfilerMarkers.cmake
+# - zstd_include_directories and zstd_libraries, from Zstd.cmake
+#
+# It also requires that find_package(Threads) has been called.
 function(mongocxx_add_library TARGET OUTPUT_NAME LINK_TYPE)
     add_library(${TARGET} ${LINK_TYPE}
         ${mongocxx_sources}
@@ -28,9 +33,14 @@ function(mongocxx_add_library TARGET OUTPUT_NAME LINK_TYPE)
         target_compile_definitions(${TARGET} PUBLIC MONGOCXX_STATIC)
     endif()
 
-    target_link_libraries(${TARGET} PRIVATE ${libmongoc_target})
+    target_link_libraries(${TARGET} PRIVATE ${libmongoc_target} Threads::Threads)
     target_include_directories(${TARGET} PRIVATE ${libmongoc_include_directories})
     target_compile_definitions(${TARGET} PRIVATE ${libmongoc_definitions})
+    target_link_libraries(${TARGET} PRIVATE ${profiler_markers_libraries})
+    target_include_directories(${TARGET} PRIVATE ${profiler_markers_include_directories})
+    target_compile_definitions(${TARGET} PRIVATE ${profiler_markers_definitions})
+    target_link_libraries(${TARGET} PRIVATE ${zstd_libraries})
+    target_include_directories(${TARGET} PRIVATE ${zstd_include_directories})
 
     generate_export_header(${TARGET}
         BASE_NAME MONGOCXX
@@ -0,0 +1,51 @@
+# Find the profiler selected by MONGOCXX_PROFILER_MARKERS, whose markers are emitted around the
+# phases of driver operations and around benchmark tasks.
+#
+# This sets the following variables:
+# - MONGOCXX_PROFILER_MARKERS_ITT, MONGOCXX_PROFILER_MARKERS_TRACY or MONGOCXX_PROFILER_MARKERS_SDT
+# - profiler_markers_include_directories
+# - profiler_markers_libraries
+# - profiler_markers_definitions, for the definitions that the profiler's headers need
+set(MONGOCXX_PROFILER_MARKERS "none" CACHE STRING
+    "Emit profiler markers around driver phases and benchmark tasks: none, itt, tracy or sdt")
+set_property(CACHE MONGOCXX_PROFILER_MARKERS PROPERTY STRINGS none itt tracy sdt)
+
+set(profiler_markers_include_directories "")
+set(profiler_markers_libraries "")
+set(profiler_markers_definitions "")
+
+if(MONGOCXX_PROFILER_MARKERS STREQUAL "itt")
+    # The ITT API ships with VTune and with the ittapi repository.
+    find_path(ITTNOTIFY_INCLUDE_DIR ittnotify.h
+        HINTS $ENV{VTUNE_PROFILER_DIR}/include $ENV{ITTAPI_DIR}/include
+    )
+    find_library(ITTNOTIFY_LIBRARY ittnotify
+        HINTS $ENV{VTUNE_PROFILER_DIR}/lib64 $ENV{ITTAPI_DIR}/lib
+    )
+    if(NOT ITTNOTIFY_INCLUDE_DIR OR NOT ITTNOTIFY_LIBRARY)
+        message(FATAL_ERROR "MONGOCXX_PROFILER_MARKERS=itt requires ittnotify.h and libittnotify")
+    endif()
+    set(MONGOCXX_PROFILER_MARKERS_ITT ON)
+    set(profiler_markers_include_directories ${ITTNOTIFY_INCLUDE_DIR})
+    set(profiler_markers_libraries ${ITTNOTIFY_LIBRARY} ${CMAKE_DL_LIBS})
+elseif(MONGOCXX_PROFILER_MARKERS STREQUAL "tracy")
+    find_path(TRACY_INCLUDE_DIR TracyC.h PATH_SUFFIXES tracy)
+    find_library(TRACY_LIBRARY TracyClient)
+    if(NOT TRACY_INCLUDE_DIR OR NOT TRACY_LIBRARY)
+        message(FATAL_ERROR "MONGOCXX_PROFILER_MARKERS=tracy requires TracyC.h and libTracyClient")
+    endif()
+    set(MONGOCXX_PROFILER_MARKERS_TRACY ON)
+    set(profiler_markers_include_directories ${TRACY_INCLUDE_DIR})
+    set(profiler_markers_libraries ${TRACY_LIBRARY})
+    set(profiler_markers_definitions TRACY_ENABLE)
+elseif(MONGOCXX_PROFILER_MARKERS STREQUAL "sdt")
+    # SDT probes are header-only; perf finds them in the library with "perf buildid-cache".
+    find_path(SDT_INCLUDE_DIR sys/sdt.h)
+    if(NOT SDT_INCLUDE_DIR)
+        message(FATAL_ERROR "MONGOCXX_PROFILER_MARKERS=sdt requires sys/sdt.h")
+    endif()
+    set(MONGOCXX_PROFILER_MARKERS_SDT ON)
+    set(profiler_markers_include_directories ${SDT_INCLUDE_DIR})
+elseif(NOT MONGOCXX_PROFILER_MARKERS STREQUAL "none")
+    message(FATAL_ERROR "Invalid MONGOCXX_PROFILER_MARKERS: ${MONGOCXX_PROFILER_MARKERS}")
+endif()
@@ -0,0 +1,31 @@
+# Find libzstd, with which GridFS chunks can be compressed; see
+# options::gridfs::upload::compression().
+#
+# MONGOCXX_ENABLE_ZSTD is AUTO by default, which uses zstd if it is found.
+#
+# This sets the following variables:
+# - MONGOCXX_HAVE_ZSTD, a definition of the private config
+# - zstd_include_directories
+# - zstd_libraries
+set(MONGOCXX_ENABLE_ZSTD "AUTO" CACHE STRING
+    "Compress GridFS chunks with zstd when requested: AUTO, ON or OFF")
+set_property(CACHE MONGOCXX_ENABLE_ZSTD PROPERTY STRINGS AUTO ON OFF)
+
+set(MONGOCXX_HAVE_ZSTD OFF)
+set(zstd_include_directories "")
+set(zstd_libraries "")
+
+if(NOT MONGOCXX_ENABLE_ZSTD STREQUAL "OFF")
+    find_path(ZSTD_INCLUDE_DIR zstd.h)
+    find_library(ZSTD_LIBRARY zstd)
+    if(ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+        message(STATUS "GridFS chunk compression with zstd enabled")
+        set(MONGOCXX_HAVE_ZSTD ON)
+        set(zstd_include_directories ${ZSTD_INCLUDE_DIR})
+        set(zstd_libraries ${ZSTD_LIBRARY})
+    elseif(MONGOCXX_ENABLE_ZSTD STREQUAL "ON")
+        message(FATAL_ERROR "MONGOCXX_ENABLE_ZSTD=ON requires zstd.h and libzstd")
+    elseif(NOT MONGOCXX_ENABLE_ZSTD STREQUAL "AUTO")
+        message(FATAL_ERROR "Invalid MONGOCXX_ENABLE_ZSTD: ${MONGOCXX_ENABLE_ZSTD}")
+    endif()
+endif()
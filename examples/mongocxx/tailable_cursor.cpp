@@ -80,7 +80,9 @@ int main(int, char**) {
     // Create the capped collection.
     init_capped_collection(&conn, name);
 
-    // Construct a tailable cursor.
+    // Construct a tailable cursor. Each pass over it below ends at the first empty batch. To have
+    // documents delivered as soon as they are inserted, with a getMore always outstanding, use a
+    // mongocxx::tailer instead.
     auto coll = conn["test"][name];
     mongocxx::options::find opts{};
     opts.cursor_type(mongocxx::cursor::type::k_tailable);
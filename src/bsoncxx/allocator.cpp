@@ -0,0 +1,102 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/allocator.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <bsoncxx/private/allocator.hh>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+allocator::~allocator() = default;
+
+namespace helpers {
+
+namespace {
+
+struct block_header {
+    allocator* alloc;
+    std::size_t size;
+};
+
+// Pad the header so the payload keeps the alignment the allocator gave the block.
+constexpr std::size_t k_header_size = 2 * sizeof(long double) > sizeof(block_header)
+                                          ? 2 * sizeof(long double)
+                                          : sizeof(block_header);
+
+std::uint8_t* header_of(std::uint8_t* ptr) {
+    return ptr - k_header_size;
+}
+
+block_header read_header(std::uint8_t* ptr) {
+    block_header header;
+    std::memcpy(&header, header_of(ptr), sizeof(header));
+    return header;
+}
+
+}  // namespace
+
+std::uint8_t* allocate_with(allocator& alloc, std::size_t size) {
+    auto block = static_cast<std::uint8_t*>(alloc.allocate(size + k_header_size));
+
+    if (!block) {
+        throw std::bad_alloc{};
+    }
+
+    block_header header{&alloc, size};
+    std::memcpy(block, &header, sizeof(header));
+
+    return block + k_header_size;
+}
+
+void allocator_deleter(std::uint8_t* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    block_header header = read_header(ptr);
+    header.alloc->deallocate(header_of(ptr), header.size + k_header_size);
+}
+
+void* allocator_realloc(void* mem, std::size_t num_bytes, void* ctx) {
+    auto& alloc = *static_cast<allocator*>(ctx);
+    auto old_ptr = static_cast<std::uint8_t*>(mem);
+
+    std::uint8_t* new_ptr;
+
+    try {
+        new_ptr = allocate_with(alloc, num_bytes);
+    } catch (...) {
+        std::abort();
+    }
+
+    if (old_ptr) {
+        std::memcpy(new_ptr, old_ptr, std::min(read_header(old_ptr).size, num_bytes));
+        allocator_deleter(old_ptr);
+    }
+
+    return new_ptr;
+}
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
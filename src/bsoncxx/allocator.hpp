@@ -0,0 +1,70 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// An interface for supplying the memory that bsoncxx uses for BSON buffers.
+///
+/// Implementations can be passed to builder::core (and to the basic and stream document builders)
+/// so that the document buffer and the builder's internal bookkeeping are carved out of a
+/// user-managed arena or pool rather than the global heap. Buffers handed out by such a builder
+/// (e.g. via extract()) return their memory to the same allocator when they are destroyed.
+///
+/// @warning
+///   The allocator must outlive every builder constructed with it and every document::value or
+///   array::value obtained from those builders.
+///
+/// @note
+///   libbson has no way to report allocation failure, so if allocate() throws or returns nullptr
+///   while libbson is growing a buffer the process is aborted, exactly as libbson itself does when
+///   malloc fails.
+///
+class BSONCXX_API allocator {
+   public:
+    virtual ~allocator();
+
+    ///
+    /// Allocates a block of memory.
+    ///
+    /// @param size
+    ///   The number of bytes requested.
+    ///
+    /// @return
+    ///   A pointer to at least `size` bytes, suitably aligned for any fundamental type.
+    ///
+    virtual void* allocate(std::size_t size) = 0;
+
+    ///
+    /// Returns a block of memory to the allocator.
+    ///
+    /// @param ptr
+    ///   A pointer previously returned by allocate().
+    /// @param size
+    ///   The size that was passed to the allocate() call that returned `ptr`.
+    ///
+    virtual void deallocate(void* ptr, std::size_t size) noexcept = 0;
+};
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
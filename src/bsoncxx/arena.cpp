@@ -0,0 +1,126 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/arena.hpp>
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// Every allocation starts at a multiple of this, as allocator::allocate() requires.
+constexpr std::size_t k_alignment = alignof(long double);
+
+std::size_t aligned_size(std::size_t size) {
+    if (size > std::numeric_limits<std::size_t>::max() - k_alignment) {
+        throw std::bad_alloc{};
+    }
+    return (size + k_alignment - 1) / k_alignment * k_alignment;
+}
+
+std::uint8_t* allocate_block(std::size_t size) {
+    auto block = static_cast<std::uint8_t*>(std::malloc(size));
+    if (!block) {
+        throw std::bad_alloc{};
+    }
+    return block;
+}
+
+}  // namespace
+
+constexpr std::size_t arena::k_default_block_size;
+
+arena::arena(std::size_t block_size)
+    : _block_size{aligned_size(block_size == 0 ? k_default_block_size : block_size)} {}
+
+arena::~arena() {
+    clear();
+    for (auto block : _blocks) {
+        std::free(block);
+    }
+}
+
+void* arena::allocate(std::size_t size) {
+    size = aligned_size(size == 0 ? 1 : size);
+
+    if (size > _block_size) {
+        auto block = allocate_block(size);
+        try {
+            _large_blocks.push_back(large_block{block, size});
+        } catch (...) {
+            std::free(block);
+            throw;
+        }
+        _used += size;
+        return block;
+    }
+
+    if (size > _remaining) {
+        // Until the first allocation since construction or clear(), no block is being carved.
+        const std::size_t current = _next ? _current + 1 : _current;
+        if (current == _blocks.size()) {
+            auto block = allocate_block(_block_size);
+            try {
+                _blocks.push_back(block);
+            } catch (...) {
+                std::free(block);
+                throw;
+            }
+        }
+        _current = current;
+        _next = _blocks[_current];
+        _remaining = _block_size;
+    }
+
+    auto ptr = _next;
+    _next += size;
+    _remaining -= size;
+    _used += size;
+    return ptr;
+}
+
+void arena::deallocate(void*, std::size_t) noexcept {}
+
+void arena::clear() noexcept {
+    for (auto&& block : _large_blocks) {
+        std::free(block.data);
+    }
+    _large_blocks.clear();
+
+    _current = 0;
+    _next = nullptr;
+    _remaining = 0;
+    _used = 0;
+}
+
+std::size_t arena::bytes_used() const noexcept {
+    return _used;
+}
+
+std::size_t arena::bytes_reserved() const noexcept {
+    std::size_t reserved = _blocks.size() * _block_size;
+    for (auto&& block : _large_blocks) {
+        reserved += block.size;
+    }
+    return reserved;
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
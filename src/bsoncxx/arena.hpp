@@ -0,0 +1,114 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <bsoncxx/allocator.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// An allocator that carves memory out of large blocks and frees all of it at once, when the arena
+/// is cleared or destroyed. deallocate() does nothing, so that releasing a buffer costs nothing.
+///
+/// An arena suits documents sharing a lifetime, such as the replies copied while handling one
+/// request: see document::value::copy_into(). It can also be given to the document builders.
+///
+/// @warning
+///   Every buffer allocated from the arena, and every document::value or array::value holding one,
+///   must be destroyed before the arena is cleared or destroyed.
+///
+/// @note
+///   An arena is not thread-safe.
+///
+class BSONCXX_API arena final : public allocator {
+   public:
+    ///
+    /// The default size of the blocks that arenas allocate.
+    ///
+    static constexpr std::size_t k_default_block_size = 64 * 1024;
+
+    ///
+    /// Constructs an arena that allocates its memory in blocks of `block_size` bytes. A larger
+    /// request gets a block of its own.
+    ///
+    /// @param block_size
+    ///   The size of the blocks to allocate.
+    ///
+    explicit arena(std::size_t block_size = k_default_block_size);
+
+    // Buffers allocated by builders record the address of their allocator.
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() override;
+
+    ///
+    /// Allocates `size` bytes from the current block, moving to a new block if they do not fit.
+    ///
+    /// @throws std::bad_alloc if a block cannot be allocated.
+    ///
+    void* allocate(std::size_t size) final;
+
+    ///
+    /// Does nothing: the memory is only freed by clear() or by the destructor.
+    ///
+    void deallocate(void* ptr, std::size_t size) noexcept final;
+
+    ///
+    /// Frees everything allocated from the arena at once. The blocks of the default size are kept
+    /// for the next allocations, and the blocks of larger requests are returned to the heap.
+    ///
+    void clear() noexcept;
+
+    ///
+    /// Returns the number of bytes allocated from the arena since it was created or cleared,
+    /// including the padding that keeps each allocation aligned.
+    ///
+    std::size_t bytes_used() const noexcept;
+
+    ///
+    /// Returns the number of bytes the arena holds from the heap.
+    ///
+    std::size_t bytes_reserved() const noexcept;
+
+   private:
+    struct BSONCXX_PRIVATE large_block {
+        std::uint8_t* data;
+        std::size_t size;
+    };
+
+    std::size_t _block_size;
+    std::vector<std::uint8_t*> _blocks;
+    std::vector<large_block> _large_blocks;
+
+    // The block being carved, as an index into _blocks, and the unused bytes at its end.
+    std::size_t _current{0};
+    std::uint8_t* _next{nullptr};
+    std::size_t _remaining{0};
+
+    std::size_t _used{0};
+};
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
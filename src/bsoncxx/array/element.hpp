@@ -64,6 +64,8 @@ class BSONCXX_API element : private document::element {
     using document::element::get_maxkey;
 
     using document::element::get_value;
+    using document::element::get_value_view;
+    using document::element::try_get;
 
     using document::element::operator[];
 
@@ -74,6 +76,7 @@ class BSONCXX_API element : private document::element {
     using document::element::key;
 
    private:
+    friend class indexed_view;
     friend class view;
 
     BSONCXX_PRIVATE explicit element(const std::uint8_t* raw,
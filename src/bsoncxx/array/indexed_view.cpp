@@ -0,0 +1,86 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/array/indexed_view.hpp>
+
+#include <vector>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace array {
+
+class indexed_view::impl {
+   public:
+    struct entry {
+        std::uint32_t offset;
+        std::uint32_t keylen;
+    };
+
+    explicit impl(array::view view) : _view(view) {
+        for (auto&& e : _view) {
+            _entries.push_back({e.offset(), e.keylen()});
+        }
+    }
+
+    element make_element(const entry& e) const {
+        return element{
+            _view.data(), static_cast<std::uint32_t>(_view.length()), e.offset, e.keylen};
+    }
+
+    array::view _view;
+    std::vector<entry> _entries;
+};
+
+indexed_view::indexed_view(array::view view) : _impl(stdx::make_unique<impl>(view)) {}
+
+indexed_view::indexed_view(const indexed_view& other)
+    : _impl(stdx::make_unique<impl>(*other._impl)) {}
+
+indexed_view& indexed_view::operator=(const indexed_view& other) {
+    _impl = stdx::make_unique<impl>(*other._impl);
+    return *this;
+}
+
+indexed_view::indexed_view(indexed_view&&) noexcept = default;
+indexed_view& indexed_view::operator=(indexed_view&&) noexcept = default;
+
+indexed_view::~indexed_view() = default;
+
+array::view::const_iterator indexed_view::find(std::uint32_t i) const {
+    if (i >= _impl->_entries.size()) {
+        return array::view::const_iterator{};
+    }
+
+    return array::view::const_iterator{_impl->make_element(_impl->_entries[i])};
+}
+
+element indexed_view::operator[](std::uint32_t i) const {
+    return *(this->find(i));
+}
+
+std::size_t indexed_view::size() const {
+    return _impl->_entries.size();
+}
+
+array::view indexed_view::view() const {
+    return _impl->_view;
+}
+
+}  // namespace array
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
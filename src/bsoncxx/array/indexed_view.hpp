@@ -0,0 +1,100 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/array/element.hpp>
+#include <bsoncxx/array/view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace array {
+
+///
+/// A read-only, non-owning view of a BSON array that supports constant-time access by position.
+///
+/// Constructing an indexed_view walks the array once and records the position of every element.
+/// Subsequent calls to find(), operator[] and size() consult that table instead of scanning the
+/// array, so indexing through a large array in a loop takes linear rather than quadratic time.
+///
+/// @remark Elements are indexed by their position in the array. For arrays built by the
+/// bsoncxx builders, or any array with the keys "0", "1", ... in order, this is the same element
+/// that array::view::find returns for the index.
+///
+class BSONCXX_API indexed_view {
+   public:
+    ///
+    /// Builds an index over the elements of an array. The caller is responsible for ensuring
+    /// that the lifetime of the indexed_view is a subset of the viewed buffer's.
+    ///
+    /// @param view
+    ///   The array to index.
+    ///
+    explicit indexed_view(array::view view);
+
+    indexed_view(const indexed_view&);
+    indexed_view& operator=(const indexed_view&);
+
+    indexed_view(indexed_view&&) noexcept;
+    indexed_view& operator=(indexed_view&&) noexcept;
+
+    ~indexed_view();
+
+    ///
+    /// Finds the element at a position of the array.
+    ///
+    /// @param i
+    ///   The position of the element.
+    ///
+    /// @return An iterator to the element if it exists, or the past-the-end iterator.
+    ///
+    array::view::const_iterator find(std::uint32_t i) const;
+
+    ///
+    /// Finds the element at a position of the array.
+    ///
+    /// @param i
+    ///   The position of the element.
+    ///
+    /// @return The element if it exists, or the invalid element.
+    ///
+    element operator[](std::uint32_t i) const;
+
+    ///
+    /// @return The number of elements in the array.
+    ///
+    std::size_t size() const;
+
+    ///
+    /// @return The indexed array.
+    ///
+    array::view view() const;
+
+   private:
+    class BSONCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace array
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
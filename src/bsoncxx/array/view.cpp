@@ -18,6 +18,7 @@
 #include <cstring>
 #include <tuple>
 
+#include <bsoncxx/private/element_walk.hh>
 #include <bsoncxx/private/itoa.hh>
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/types.hpp>
@@ -28,14 +29,6 @@ namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
 namespace array {
 
-namespace {
-bson_iter_t to_bson_iter_t(element e) {
-    bson_iter_t iter{};
-    bson_iter_init_from_data_at_offset(&iter, e.raw(), e.length(), e.offset(), e.keylen());
-    return iter;
-}
-}  // namespace
-
 view::const_iterator::const_iterator() {}
 
 view::const_iterator::const_iterator(const element& element) : _element(element) {}
@@ -57,12 +50,15 @@ view::const_iterator& view::const_iterator::operator++() {
     auto raw = _element.raw();
     auto len = _element.length();
 
-    bson_iter_t iter = to_bson_iter_t(_element);
+    // Step directly over the encoded element rather than rebuilding and re-validating a
+    // bson_iter_t from (raw, len, offset, keylen) on every increment.
+    std::uint32_t offset;
+    std::uint32_t keylen;
 
-    if (!bson_iter_next(&iter)) {
+    if (!helpers::next_element(raw, len, _element.offset(), _element.keylen(), &offset, &keylen)) {
         _element = element{};
     } else {
-        _element = element{raw, len, bson_iter_offset(&iter), bson_iter_key_len(&iter)};
+        _element = element{raw, len, offset, keylen};
     }
 
     return *this;
@@ -140,6 +136,14 @@ element view::operator[](std::uint32_t i) const {
     return *(this->find(i));
 }
 
+std::size_t view::size() const {
+    std::size_t count = 0;
+    for (auto it = cbegin(); it != cend(); ++it) {
+        ++count;
+    }
+    return count;
+}
+
 view::view(const std::uint8_t* data, std::size_t length) : _view(data, length) {}
 
 view::view() : _view() {}
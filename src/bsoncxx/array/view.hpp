@@ -79,6 +79,15 @@ class BSONCXX_API view {
     ///
     element operator[](std::uint32_t i) const;
 
+    ///
+    /// Counts the elements of this BSON array, by stepping over each one without decoding it.
+    /// The runtime is linear in the length of the array; array::indexed_view keeps the count
+    /// for arrays that are measured or indexed repeatedly.
+    ///
+    /// @return The number of elements in the array.
+    ///
+    std::size_t size() const;
+
     ///
     /// Default constructs a view. The resulting view will be initialized to point at
     /// an empty BSON array.
@@ -107,7 +116,7 @@ class BSONCXX_API view {
     /// Gets the length of the underlying buffer.
     ///
     /// @remark This is not the number of elements in the array.
-    /// To compute the number of elements, use std::distance.
+    /// To compute the number of elements, use size().
     ///
     /// @return The length of the array, in bytes.
     ///
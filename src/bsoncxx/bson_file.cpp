@@ -0,0 +1,376 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/bson_file.hpp>
+
+#include <climits>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/encoded_value.hh>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/validate.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// The smallest document: a length and the terminating null byte.
+constexpr std::size_t k_min_document_length = 5;
+
+}  // namespace
+
+class bson_file_reader::impl {
+   public:
+    explicit impl(const std::string& path) : _data(nullptr), _size(0) {
+        map(path);
+    }
+
+    impl(const std::string& path, const validator& settings) : impl(path) {
+        _validator = stdx::make_unique<validator>();
+        _validator->check_utf8(settings.check_utf8());
+        _validator->check_utf8_allow_null(settings.check_utf8_allow_null());
+        _validator->check_dollar_keys(settings.check_dollar_keys());
+        _validator->check_dot_keys(settings.check_dot_keys());
+    }
+
+    ~impl() {
+        unmap();
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    const std::uint8_t* data() const {
+        return _data;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    // Returns the document starting at `offset`, after checking that it fits in the file and, if
+    // the reader validates, that it is valid BSON.
+    document::view document_at(std::size_t offset) const {
+        const auto remaining = _size - offset;
+        if (remaining < k_min_document_length) {
+            throw bsoncxx::exception{error_code::k_invalid_document_in_file,
+                                     "truncated length at offset " + std::to_string(offset)};
+        }
+
+        const auto length = helpers::read_uint32_le(_data + offset);
+        if (length < k_min_document_length || length > remaining ||
+            _data[offset + length - 1] != 0) {
+            throw bsoncxx::exception{error_code::k_invalid_document_in_file,
+                                     "truncated document at offset " + std::to_string(offset)};
+        }
+
+        if (_validator) {
+            std::size_t invalid_offset = 0;
+            if (!validate(_data + offset, length, *_validator, &invalid_offset)) {
+                throw bsoncxx::exception{
+                    error_code::k_invalid_document_in_file,
+                    "invalid document at offset " + std::to_string(offset) + ", byte " +
+                        std::to_string(invalid_offset)};
+            }
+        }
+
+        return document::view{_data + offset, length};
+    }
+
+   private:
+#if defined(_WIN32)
+    void map(const std::string& path) {
+        const auto file = ::CreateFileA(path.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_FLAG_SEQUENTIAL_SCAN,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot open " + path};
+        }
+
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file, &size) ||
+            static_cast<std::uint64_t>(size.QuadPart) > SIZE_MAX) {
+            ::CloseHandle(file);
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot size " + path};
+        }
+        _size = static_cast<std::size_t>(size.QuadPart);
+
+        // Empty files cannot be mapped, and have no documents to read anyway.
+        if (_size == 0) {
+            ::CloseHandle(file);
+            return;
+        }
+
+        const auto mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        if (!mapping) {
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot map " + path};
+        }
+
+        // The view keeps the mapping alive once it is created.
+        _data = static_cast<const std::uint8_t*>(
+            ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        ::CloseHandle(mapping);
+        if (!_data) {
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot map " + path};
+        }
+    }
+
+    void unmap() {
+        if (_data) {
+            ::UnmapViewOfFile(_data);
+        }
+    }
+#else
+    void map(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot open " + path};
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) > SIZE_MAX) {
+            ::close(fd);
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot size " + path};
+        }
+        _size = static_cast<std::size_t>(info.st_size);
+
+        // Empty files cannot be mapped, and have no documents to read anyway.
+        if (_size == 0) {
+            ::close(fd);
+            return;
+        }
+
+        // The mapping outlives the descriptor.
+        void* mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot map " + path};
+        }
+
+        // Dumps are read front to back, so ask for aggressive read-ahead. This is only a hint.
+        ::madvise(mapped, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const std::uint8_t*>(mapped);
+    }
+
+    void unmap() {
+        if (_data) {
+            ::munmap(const_cast<std::uint8_t*>(_data), _size);
+        }
+    }
+#endif
+
+    const std::uint8_t* _data;
+    std::size_t _size;
+    std::unique_ptr<validator> _validator;
+};
+
+bson_file_reader::bson_file_reader(const std::string& path)
+    : _impl(stdx::make_unique<impl>(path)) {}
+
+bson_file_reader::bson_file_reader(const std::string& path, const validator& validator)
+    : _impl(stdx::make_unique<impl>(path, validator)) {}
+
+bson_file_reader::bson_file_reader(bson_file_reader&&) noexcept = default;
+bson_file_reader& bson_file_reader::operator=(bson_file_reader&&) noexcept = default;
+
+bson_file_reader::~bson_file_reader() = default;
+
+bson_file_reader::const_iterator bson_file_reader::begin() const {
+    return const_iterator{_impl.get(), 0};
+}
+
+bson_file_reader::const_iterator bson_file_reader::end() const {
+    return const_iterator{_impl.get(), _impl->size()};
+}
+
+const std::uint8_t* bson_file_reader::data() const {
+    return _impl->data();
+}
+
+std::size_t bson_file_reader::size() const {
+    return _impl->size();
+}
+
+bson_file_reader::const_iterator::const_iterator() : _reader(nullptr), _offset(0) {}
+
+bson_file_reader::const_iterator::const_iterator(const bson_file_reader::impl* reader,
+                                                 std::size_t offset)
+    : _reader(reader), _offset(offset) {
+    load();
+}
+
+void bson_file_reader::const_iterator::load() {
+    if (_offset < _reader->size()) {
+        _current = _reader->document_at(_offset);
+    } else {
+        _current = document::view{};
+    }
+}
+
+bson_file_reader::const_iterator::reference bson_file_reader::const_iterator::operator*() const {
+    return _current;
+}
+
+bson_file_reader::const_iterator::pointer bson_file_reader::const_iterator::operator->() const {
+    return &_current;
+}
+
+bson_file_reader::const_iterator& bson_file_reader::const_iterator::operator++() {
+    _offset += _current.length();
+    load();
+    return *this;
+}
+
+bson_file_reader::const_iterator bson_file_reader::const_iterator::operator++(int) {
+    const_iterator before{*this};
+    operator++();
+    return before;
+}
+
+std::size_t bson_file_reader::const_iterator::offset() const {
+    return _offset;
+}
+
+bool BSONCXX_CALL operator==(const bson_file_reader::const_iterator& lhs,
+                             const bson_file_reader::const_iterator& rhs) {
+    return lhs._reader == rhs._reader && lhs._offset == rhs._offset;
+}
+
+bool BSONCXX_CALL operator!=(const bson_file_reader::const_iterator& lhs,
+                             const bson_file_reader::const_iterator& rhs) {
+    return !(lhs == rhs);
+}
+
+constexpr std::size_t bson_file_writer::k_default_buffer_size;
+
+bson_file_writer::bson_file_writer(const std::string& path, std::size_t buffer_size)
+    : _file(std::fopen(path.c_str(), "wb")), _size(0) {
+    if (!_file) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file, "cannot open " + path};
+    }
+    if (buffer_size > 0) {
+        std::setvbuf(_file, nullptr, _IOFBF, buffer_size);
+    }
+}
+
+bson_file_writer::bson_file_writer(bson_file_writer&& rhs) noexcept
+    : _file(rhs._file), _size(rhs._size) {
+    rhs._file = nullptr;
+}
+
+bson_file_writer& bson_file_writer::operator=(bson_file_writer&& rhs) noexcept {
+    std::swap(_file, rhs._file);
+    std::swap(_size, rhs._size);
+    return *this;
+}
+
+bson_file_writer::~bson_file_writer() {
+    if (_file) {
+        std::fclose(_file);
+    }
+}
+
+void bson_file_writer::write(document::view document) {
+    write(document.data(), document.length());
+}
+
+void bson_file_writer::write(const std::uint8_t* bytes, std::size_t length) {
+    check_open();
+    if (std::fwrite(bytes, 1, length, _file) != length) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file};
+    }
+    _size += length;
+}
+
+void bson_file_writer::patch(std::uint64_t position,
+                             const std::uint8_t* bytes,
+                             std::size_t length) {
+    check_open();
+    if (position + length > _size) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file};
+    }
+
+#if defined(_WIN32)
+    const auto seek = [this](std::uint64_t offset) {
+        return _fseeki64(_file, static_cast<__int64>(offset), SEEK_SET) == 0;
+    };
+#else
+    const auto seek = [this](std::uint64_t offset) {
+        return fseeko(_file, static_cast<off_t>(offset), SEEK_SET) == 0;
+    };
+#endif
+
+    // Seeking flushes the buffer, so only the patched bytes are written out of order.
+    if (!seek(position) || std::fwrite(bytes, 1, length, _file) != length || !seek(_size)) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file};
+    }
+}
+
+void bson_file_writer::flush() {
+    check_open();
+    if (std::fflush(_file) != 0) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file};
+    }
+}
+
+void bson_file_writer::close() {
+    if (!_file) {
+        return;
+    }
+    const auto file = _file;
+    _file = nullptr;
+    if (std::fclose(file) != 0) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file};
+    }
+}
+
+std::uint64_t bson_file_writer::size() const {
+    return _size;
+}
+
+void bson_file_writer::check_open() const {
+    if (!_file) {
+        throw bsoncxx::exception{error_code::k_cannot_access_file, "the file is closed"};
+    }
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
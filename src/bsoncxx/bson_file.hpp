@@ -0,0 +1,225 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include <bsoncxx/builder/streaming.hpp>
+#include <bsoncxx/document/view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+class validator;
+
+///
+/// Reads a file of concatenated BSON documents, such as the .bson files written by mongodump,
+/// by mapping it into memory. The documents are yielded as views over the mapping, so reading
+/// them copies nothing and only touches the pages that are used.
+///
+/// The views stay valid as long as the reader that yielded them.
+///
+class BSONCXX_API bson_file_reader {
+   public:
+    class const_iterator;
+
+    ///
+    /// Maps a file for reading. Each document is checked to have a consistent length when it is
+    /// reached, but its contents are not validated.
+    ///
+    /// @throws bsoncxx::exception if the file cannot be opened or mapped.
+    ///
+    explicit bson_file_reader(const std::string& path);
+
+    ///
+    /// Maps a file for reading, and validates each document with the settings of `validator`
+    /// when it is reached.
+    ///
+    /// @throws bsoncxx::exception if the file cannot be opened or mapped.
+    ///
+    bson_file_reader(const std::string& path, const validator& validator);
+
+    bson_file_reader(bson_file_reader&& rhs) noexcept;
+    bson_file_reader& operator=(bson_file_reader&& rhs) noexcept;
+
+    ///
+    /// Unmaps the file.
+    ///
+    ~bson_file_reader();
+
+    ///
+    /// @return An iterator to the first document of the file.
+    ///
+    /// @throws bsoncxx::exception if the first document is truncated or fails validation.
+    ///
+    const_iterator begin() const;
+
+    ///
+    /// @return An iterator past the last document of the file.
+    ///
+    const_iterator end() const;
+
+    ///
+    /// @return The mapped bytes of the file.
+    ///
+    const std::uint8_t* data() const;
+
+    ///
+    /// @return The size of the file in bytes.
+    ///
+    std::size_t size() const;
+
+   private:
+    class BSONCXX_PRIVATE impl;
+    std::unique_ptr<impl> _impl;
+};
+
+///
+/// An iterator over the documents of a bson_file_reader.
+///
+/// Incrementing the iterator checks the next document, and throws a bsoncxx::exception with
+/// error_code::k_invalid_document_in_file if it is truncated or fails validation. offset() tells
+/// where the bad document starts, so that a tool can report or skip it.
+///
+class BSONCXX_API bson_file_reader::const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = document::view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const document::view*;
+    using reference = const document::view&;
+
+    const_iterator();
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    ///
+    /// @return The position of the current document in the file, in bytes.
+    ///
+    std::size_t offset() const;
+
+    friend BSONCXX_API bool BSONCXX_CALL operator==(const const_iterator&, const const_iterator&);
+    friend BSONCXX_API bool BSONCXX_CALL operator!=(const const_iterator&, const const_iterator&);
+
+   private:
+    friend class bson_file_reader;
+
+    const_iterator(const bson_file_reader::impl* reader, std::size_t offset);
+
+    void load();
+
+    const bson_file_reader::impl* _reader;
+    std::size_t _offset;
+    document::view _current;
+};
+
+///
+/// Writes concatenated BSON documents to a file, in the format read by bson_file_reader and
+/// mongorestore.
+///
+/// Writes are buffered. The writer is also a builder::streaming::sink, so large documents can be
+/// built straight into the file without being held in memory.
+///
+class BSONCXX_API bson_file_writer : public builder::streaming::sink {
+   public:
+    ///
+    /// The default size of the write buffer.
+    ///
+    static constexpr std::size_t k_default_buffer_size = 1024 * 1024;
+
+    ///
+    /// Creates or truncates a file for writing.
+    ///
+    /// @param path
+    ///   The file to write.
+    /// @param buffer_size
+    ///   The number of bytes gathered before they are written to the file.
+    ///
+    /// @throws bsoncxx::exception if the file cannot be opened.
+    ///
+    explicit bson_file_writer(const std::string& path,
+                              std::size_t buffer_size = k_default_buffer_size);
+
+    bson_file_writer(bson_file_writer&& rhs) noexcept;
+    bson_file_writer& operator=(bson_file_writer&& rhs) noexcept;
+
+    ///
+    /// Closes the file, ignoring any error, since a destructor cannot throw. Call close() first
+    /// to know whether the documents reached the file.
+    ///
+    ~bson_file_writer() override;
+
+    ///
+    /// Appends a document to the file.
+    ///
+    /// @throws bsoncxx::exception if the file is closed or cannot be written.
+    ///
+    void write(document::view document);
+
+    ///
+    /// Appends encoded bytes to the file.
+    ///
+    /// @throws bsoncxx::exception if the file is closed or cannot be written.
+    ///
+    void write(const std::uint8_t* bytes, std::size_t length) override;
+
+    ///
+    /// Overwrites bytes already written, `position` bytes from the beginning of the file.
+    ///
+    /// @throws bsoncxx::exception if the file is closed or cannot be written.
+    ///
+    void patch(std::uint64_t position, const std::uint8_t* bytes, std::size_t length) override;
+
+    ///
+    /// Writes buffered bytes to the file.
+    ///
+    /// @throws bsoncxx::exception if the file is closed or cannot be written.
+    ///
+    void flush();
+
+    ///
+    /// Flushes and closes the file. Does nothing if it is already closed.
+    ///
+    /// @throws bsoncxx::exception if the buffered bytes cannot be written.
+    ///
+    void close();
+
+    ///
+    /// @return The number of bytes written so far, including buffered bytes.
+    ///
+    std::uint64_t size() const;
+
+   private:
+    void check_open() const;
+
+    std::FILE* _file;
+    std::uint64_t _size;
+};
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
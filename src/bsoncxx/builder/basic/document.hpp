@@ -41,6 +41,15 @@ class document : public sub_document {
     ///
     BSONCXX_INLINE document() : sub_document(&_core), _core(false) {}
 
+    ///
+    /// Constructs a builder that draws its memory from a user-supplied allocator.
+    ///
+    /// @param alloc
+    ///   The allocator to use. It must outlive this builder and every value extracted from it.
+    ///
+    BSONCXX_INLINE explicit document(allocator& alloc)
+        : sub_document(&_core), _core(false, alloc) {}
+
     ///
     /// Move constructor
     ///
@@ -92,6 +101,24 @@ class document : public sub_document {
         _core.clear();
     }
 
+    ///
+    /// Grow the underlying buffer so the document can reach `size` bytes without reallocating.
+    ///
+    /// @see bsoncxx::builder::core::reserve
+    ///
+    BSONCXX_INLINE void reserve(std::size_t size) {
+        _core.reserve(size);
+    }
+
+    ///
+    /// Keep the underlying buffer across calls to extract(), copying out only the used bytes.
+    ///
+    /// @see bsoncxx::builder::core::retain_capacity
+    ///
+    BSONCXX_INLINE void retain_capacity(bool retain) {
+        _core.retain_capacity(retain);
+    }
+
    private:
     core _core;
 };
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <bsoncxx/builder/basic/helpers.hpp>
 #include <bsoncxx/builder/concatenate.hpp>
 #include <bsoncxx/builder/core.hpp>
@@ -58,6 +60,15 @@ class sub_array {
     BSONCXX_INLINE
     void append() {}
 
+    ///
+    /// Appends `count` values, as if by calling append() with each, with the keys and elements
+    /// encoded in a single pass. T must be double, std::int32_t or std::int64_t.
+    ///
+    template <typename T>
+    BSONCXX_INLINE void append_range(const T* values, std::size_t count) {
+        _core->append_range(values, count);
+    }
+
    private:
     //
     // Appends a BSON value.
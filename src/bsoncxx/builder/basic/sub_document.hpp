@@ -90,7 +90,7 @@ class sub_document {
     // Concatenates another bson document directly.
     //
     BSONCXX_INLINE
-    void append_(concatenate_doc doc) {
+    void append_(const concatenate_doc& doc) {
         _core->concatenate(doc);
     }
 
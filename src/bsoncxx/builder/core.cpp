@@ -14,10 +14,17 @@
 
 #include <bsoncxx/builder/core.hpp>
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <cstring>
+#include <vector>
 
+#include <bsoncxx/allocator.hpp>
 #include <bsoncxx/exception/error_code.hpp>
 #include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/allocator.hh>
+#include <bsoncxx/private/encoded_value.hh>
 #include <bsoncxx/private/itoa.hh>
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/private/stack.hh>
@@ -39,13 +46,107 @@ void bson_free_deleter(std::uint8_t* ptr) {
     bson_free(ptr);
 }
 
+//
+// The decimal key of an array element, incremented in place rather than converted from the index
+// for every element.
+//
+class array_key {
+   public:
+    explicit array_key(std::uint32_t index) : _begin(sizeof(_digits)) {
+        do {
+            _digits[--_begin] = static_cast<char>('0' + index % 10);
+            index /= 10;
+        } while (index != 0);
+    }
+
+    // Writes the key and its terminating null byte.
+    std::uint8_t* write(std::uint8_t* out) const {
+        const std::size_t length = sizeof(_digits) - _begin;
+        std::memcpy(out, _digits + _begin, length);
+        out[length] = '\0';
+        return out + length + 1;
+    }
+
+    void increment() {
+        for (std::size_t i = sizeof(_digits); i > _begin; --i) {
+            if (_digits[i - 1] != '9') {
+                ++_digits[i - 1];
+                return;
+            }
+            _digits[i - 1] = '0';
+        }
+        _digits[--_begin] = '1';
+    }
+
+   private:
+    // Room for one more digit than the largest index, which the last increment may produce.
+    char _digits[11];
+    std::size_t _begin;
+};
+
+// Returns the total number of digits in the keys of the array indexes [first, first + count).
+std::uint64_t key_digits(std::uint64_t first, std::uint64_t count) {
+    const std::uint64_t last = first + count;
+    std::uint64_t digits = 0;
+    std::uint64_t width = 1;
+    for (std::uint64_t low = 0, high = 10; low < last; low = high, high *= 10, width++) {
+        const auto begin = std::max(first, low);
+        const auto end = std::min(last, high);
+        if (begin < end) {
+            digits += (end - begin) * width;
+        }
+    }
+    return digits;
+}
+
+// The error reported when a value of type t fails to append.
+error_code append_error(type t) {
+    switch (t) {
+#define BSONCXX_ENUM(name, val) \
+    case type::k_##name:        \
+        return error_code::k_cannot_append_##name;
+#include <bsoncxx/enums/type.hpp>
+#undef BSONCXX_ENUM
+    }
+    return error_code::k_internal_error;
+}
+
+std::uint8_t* encode_range_value(std::uint8_t* out, double value) {
+    value = BSON_DOUBLE_TO_LE(value);
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+}
+
+std::uint8_t* encode_range_value(std::uint8_t* out, std::int32_t value) {
+    const auto le = BSON_UINT32_TO_LE(static_cast<std::uint32_t>(value));
+    std::memcpy(out, &le, sizeof(le));
+    return out + sizeof(le);
+}
+
+std::uint8_t* encode_range_value(std::uint8_t* out, std::int64_t value) {
+    const auto le = BSON_UINT64_TO_LE(static_cast<std::uint64_t>(value));
+    std::memcpy(out, &le, sizeof(le));
+    return out + sizeof(le);
+}
+
 //
 // Class providing RAII semantics for bson_t.
 //
+// By default the bson_t is initialized inline and grows on the libbson heap. If an allocator is
+// supplied, the buffer is instead owned by this class and grown through helpers::allocator_realloc,
+// so that stolen buffers can be released with helpers::allocator_deleter.
+//
 class managed_bson_t {
    public:
-    managed_bson_t() {
-        bson_init(&bson);
+    managed_bson_t()
+        : _bson(&_inline), _alloc(nullptr), _buf(nullptr), _buf_len(0), _retain_capacity(false) {
+        bson_init(&_inline);
+    }
+
+    explicit managed_bson_t(allocator& alloc)
+        : _alloc(&alloc), _buf(nullptr), _buf_len(0), _retain_capacity(false) {
+        _reset_buffer();
+        _bson = bson_new_from_buffer(&_buf, &_buf_len, helpers::allocator_realloc, _alloc);
     }
 
     managed_bson_t(managed_bson_t&&) = delete;
@@ -55,15 +156,99 @@ class managed_bson_t {
     managed_bson_t& operator=(const managed_bson_t&) = delete;
 
     ~managed_bson_t() {
-        bson_destroy(&bson);
+        bson_destroy(_bson);
+
+        if (_alloc) {
+            // bson_new_from_buffer never frees the buffer it was given.
+            helpers::allocator_deleter(_buf);
+        }
     }
 
     bson_t* get() {
-        return &bson;
+        return _bson;
+    }
+
+    // Grows the buffer so that it can hold at least `size` bytes. Returns false if libbson refuses,
+    // which happens while a subdocument or subarray is open.
+    bool reserve(std::size_t size) {
+        if (size > static_cast<std::size_t>(INT32_MAX)) {
+            return false;
+        }
+
+        // bson_reserve_buffer() also sets the length to `size`; put the real length back.
+        std::uint32_t len = _bson->len;
+        if (!bson_reserve_buffer(_bson, static_cast<std::uint32_t>(size))) {
+            return false;
+        }
+        _bson->len = len;
+
+        return true;
+    }
+
+    void retain_capacity(bool retain) {
+        _retain_capacity = retain;
+    }
+
+    // Transfers ownership of the current document to the caller and leaves this object holding an
+    // empty document. In retain-capacity mode only the used bytes are copied out and the buffer is
+    // kept for the next document.
+    std::uint8_t* steal(std::uint32_t* len, document::value::deleter_type* dtor) {
+        if (_retain_capacity) {
+            *len = _bson->len;
+
+            std::uint8_t* buf_ptr;
+            if (_alloc) {
+                buf_ptr = helpers::allocate_with(*_alloc, *len);
+                *dtor = helpers::allocator_deleter;
+            } else {
+                buf_ptr = static_cast<std::uint8_t*>(bson_malloc(*len));
+                *dtor = bson_free_deleter;
+            }
+
+            std::memcpy(buf_ptr, bson_get_data(_bson), *len);
+            bson_reinit(_bson);
+
+            return buf_ptr;
+        }
+
+        if (!_alloc) {
+            std::uint8_t* buf_ptr = bson_destroy_with_steal(&_inline, true, len);
+            bson_init(&_inline);
+            *dtor = bson_free_deleter;
+            return buf_ptr;
+        }
+
+        std::uint8_t* buf_ptr = _buf;
+        *len = _bson->len;
+        *dtor = helpers::allocator_deleter;
+
+        // libbson reads the buffer through &_buf on every access, so swapping in a fresh buffer
+        // and reinitializing leaves _bson a valid empty document.
+        _reset_buffer();
+        bson_reinit(_bson);
+
+        return buf_ptr;
     }
 
    private:
-    bson_t bson;
+    // Enough that small documents never regrow, comparable to the inline storage of a bson_t.
+    static constexpr std::size_t k_initial_buffer_size = 128;
+
+    void _reset_buffer() {
+        _buf = helpers::allocate_with(*_alloc, k_initial_buffer_size);
+        _buf_len = k_initial_buffer_size;
+
+        // An empty document: a little-endian length of 5 followed by the terminating null.
+        const std::uint8_t empty[] = {5, 0, 0, 0, 0};
+        std::memcpy(_buf, empty, sizeof(empty));
+    }
+
+    bson_t _inline;
+    bson_t* _bson;
+    allocator* _alloc;
+    std::uint8_t* _buf;
+    std::size_t _buf_len;
+    bool _retain_capacity;
 };
 
 }  // namespace
@@ -72,6 +257,14 @@ class core::impl {
    public:
     impl(bool is_array) : _depth(0), _root_is_array(is_array), _n(0), _has_user_key(false) {}
 
+    impl(bool is_array, allocator& alloc)
+        : _depth(0),
+          _root_is_array(is_array),
+          _n(0),
+          _root(alloc),
+          _stack(&alloc),
+          _has_user_key(false) {}
+
     void reinit() {
         while (!_stack.empty()) {
             _stack.pop_back();
@@ -93,10 +286,10 @@ class core::impl {
         }
 
         uint32_t buf_len;
-        uint8_t* buf_ptr = bson_destroy_with_steal(_root.get(), true, &buf_len);
-        bson_init(_root.get());
+        document::value::deleter_type dtor;
+        uint8_t* buf_ptr = _root.steal(&buf_len, &dtor);
 
-        return bsoncxx::document::value{buf_ptr, buf_len, bson_free_deleter};
+        return bsoncxx::document::value{buf_ptr, buf_len, dtor};
     }
 
     // Throws bsoncxx::exception if the top-level BSON datum is a document.
@@ -106,10 +299,10 @@ class core::impl {
         }
 
         uint32_t buf_len;
-        uint8_t* buf_ptr = bson_destroy_with_steal(_root.get(), true, &buf_len);
-        bson_init(_root.get());
+        array::value::deleter_type dtor;
+        uint8_t* buf_ptr = _root.steal(&buf_len, &dtor);
 
-        return bsoncxx::array::value{buf_ptr, buf_len, bson_free_deleter};
+        return bsoncxx::array::value{buf_ptr, buf_len, dtor};
     }
 
     bson_t* back() {
@@ -188,10 +381,98 @@ class core::impl {
         return _root.get();
     }
 
+    // Throws bsoncxx::exception if a subdocument or subarray is open.
+    void reserve(std::size_t size) {
+        if (_depth != 0 || !_root.reserve(size)) {
+            throw bsoncxx::exception{error_code::k_cannot_reserve_buffer};
+        }
+    }
+
+    void retain_capacity(bool retain) {
+        _root.retain_capacity(retain);
+    }
+
     bool is_array() {
         return _stack.empty() ? _root_is_array : _stack.back().is_array;
     }
 
+    // Encodes the elements for `values` with the keys that follow the current array's last one,
+    // as the body of a scratch document, and concatenates them onto the array in one copy.
+    //
+    // Throws bsoncxx::exception if the current BSON datum is a document.
+    template <typename T>
+    void append_range(bson_type_t type, const T* values, std::size_t count, error_code on_error) {
+        if (!is_array()) {
+            throw bsoncxx::exception{error_code::k_cannot_perform_array_operation_on_document};
+        }
+        if (count == 0) {
+            return;
+        }
+
+        std::size_t& n = _stack.empty() ? _n : _stack.back().n;
+        const std::uint64_t length =
+            4 + count * (1 + 1 + sizeof(T)) + key_digits(n, count) + 1;
+        if (n + count > UINT32_MAX || length > INT32_MAX) {
+            throw bsoncxx::exception{on_error};
+        }
+
+        _range_buffer.resize(static_cast<std::size_t>(length));
+        std::uint8_t* out = _range_buffer.data();
+        const auto le_length = BSON_UINT32_TO_LE(static_cast<std::uint32_t>(length));
+        std::memcpy(out, &le_length, sizeof(le_length));
+        out += sizeof(le_length);
+
+        array_key key{static_cast<std::uint32_t>(n)};
+        for (std::size_t i = 0; i < count; i++) {
+            *out++ = static_cast<std::uint8_t>(type);
+            out = key.write(out);
+            key.increment();
+            out = encode_range_value(out, values[i]);
+        }
+        *out = '\0';
+
+        bson_t elements;
+        if (!bson_init_static(&elements, _range_buffer.data(), _range_buffer.size()) ||
+            !bson_concat(back(), &elements)) {
+            throw bsoncxx::exception{on_error};
+        }
+        n += count;
+    }
+
+    // Appends a value that is already encoded, under the next key, as the body of a scratch
+    // document concatenated onto the current one.
+    void append_encoded(type value_type, const std::uint8_t* value, std::size_t length) {
+        const error_code on_error = append_error(value_type);
+        const stdx::string_view key = next_key();
+        if (std::memchr(key.data(), '\0', key.size())) {
+            throw bsoncxx::exception{on_error};
+        }
+
+        const std::uint64_t size = 4 + 1 + key.size() + 1 + std::uint64_t{length} + 1;
+        if (size > INT32_MAX) {
+            throw bsoncxx::exception{on_error};
+        }
+
+        _range_buffer.resize(static_cast<std::size_t>(size));
+        std::uint8_t* out = _range_buffer.data();
+        const auto le_size = BSON_UINT32_TO_LE(static_cast<std::uint32_t>(size));
+        std::memcpy(out, &le_size, sizeof(le_size));
+        out += sizeof(le_size);
+
+        *out++ = static_cast<std::uint8_t>(value_type);
+        std::memcpy(out, key.data(), key.size());
+        out += key.size();
+        *out++ = '\0';
+        std::memcpy(out, value, length);
+        out[length] = '\0';
+
+        bson_t element;
+        if (!bson_init_static(&element, _range_buffer.data(), _range_buffer.size()) ||
+            !bson_concat(back(), &element)) {
+            throw bsoncxx::exception{on_error};
+        }
+    }
+
     bool is_viewable() {
         return _depth == 0 && !_has_user_key;
     }
@@ -244,6 +525,9 @@ class core::impl {
 
     itoa _itoa_key;
 
+    // Scratch space for append_range() and append_encoded(), kept to be reused by the next call.
+    std::vector<std::uint8_t> _range_buffer;
+
     stdx::string_view _user_key_view;
     std::string _user_key_owned;
 
@@ -254,6 +538,10 @@ core::core(bool is_array) {
     _impl = stdx::make_unique<impl>(is_array);
 }
 
+core::core(bool is_array, allocator& alloc) {
+    _impl = stdx::make_unique<impl>(is_array, alloc);
+}
+
 core::core(core&&) noexcept = default;
 core& core::operator=(core&&) noexcept = default;
 core::~core() = default;
@@ -543,8 +831,8 @@ core& core::append(const types::b_maxkey&) {
     return *this;
 }
 
-core& core::append(std::string str) {
-    append(types::b_utf8{std::move(str)});
+core& core::append(const std::string& str) {
+    append(types::b_utf8{str});
 
     return *this;
 }
@@ -644,6 +932,48 @@ core& core::concatenate(const bsoncxx::document::view& view) {
     return *this;
 }
 
+core& core::append_range(const double* values, std::size_t count) {
+    _impl->append_range(BSON_TYPE_DOUBLE, values, count, error_code::k_cannot_append_double);
+
+    return *this;
+}
+
+core& core::append_range(const std::int32_t* values, std::size_t count) {
+    _impl->append_range(BSON_TYPE_INT32, values, count, error_code::k_cannot_append_int32);
+
+    return *this;
+}
+
+core& core::append_range(const std::int64_t* values, std::size_t count) {
+    _impl->append_range(BSON_TYPE_INT64, values, count, error_code::k_cannot_append_int64);
+
+    return *this;
+}
+
+core& core::append_raw(const document::element& element) {
+    if (!element) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
+
+    const auto value = element.raw() + element.offset() + 2 + element.keylen();
+    _impl->append_encoded(
+        element.type(), value, helpers::encoded_value_size(element.type(), value));
+
+    return *this;
+}
+
+core& core::append_raw(const array::element& element) {
+    if (!element) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
+
+    const auto value = element.raw() + element.offset() + 2 + element.keylen();
+    _impl->append_encoded(
+        element.type(), value, helpers::encoded_value_size(element.type(), value));
+
+    return *this;
+}
+
 core& core::append(const bsoncxx::types::value& value) {
     switch (static_cast<int>(value.type())) {
 #define BSONCXX_ENUM(type, val)     \
@@ -722,6 +1052,14 @@ void core::clear() {
     _impl->reinit();
 }
 
+void core::reserve(std::size_t size) {
+    _impl->reserve(size);
+}
+
+void core::retain_capacity(bool retain) {
+    _impl->retain_capacity(retain);
+}
+
 }  // namespace builder
 BSONCXX_INLINE_NAMESPACE_END
 }  // namespace bsoncxx
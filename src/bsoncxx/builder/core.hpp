@@ -18,6 +18,7 @@
 #include <stdexcept>
 #include <type_traits>
 
+#include <bsoncxx/allocator.hpp>
 #include <bsoncxx/array/value.hpp>
 #include <bsoncxx/array/view.hpp>
 #include <bsoncxx/document/value.hpp>
@@ -51,6 +52,21 @@ class BSONCXX_API core {
     ///
     explicit core(bool is_array);
 
+    ///
+    /// Constructs an empty BSON datum whose buffer and internal bookkeeping are obtained from a
+    /// user-supplied allocator.
+    ///
+    /// @param is_array
+    ///   True if the top-level BSON datum should be an array.
+    /// @param alloc
+    ///   The allocator to draw memory from. Values returned by extract_document() and
+    ///   extract_array() release their buffers back to it.
+    ///
+    /// @warning
+    ///   The allocator must outlive this object and every value extracted from it.
+    ///
+    core(bool is_array, allocator& alloc);
+
     core(core&& rhs) noexcept;
     core& operator=(core&& rhs) noexcept;
 
@@ -478,7 +494,7 @@ class BSONCXX_API core {
     ///   bsoncxx::exception if the current BSON datum is a document that is waiting for a key to be
     ///   appended to start a new key/value pair.
     ///
-    core& append(std::string str);
+    core& append(const std::string& str);
 
     ///
     /// Appends a string view as a BSON UTF-8 string.
@@ -619,6 +635,78 @@ class BSONCXX_API core {
     ///
     core& append(array::view view);
 
+    ///
+    /// Appends `count` doubles to the current array as BSON doubles, as if by calling append()
+    /// for each, but generating the keys incrementally and encoding all of the elements in one
+    /// pass.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws
+    ///   bsoncxx::exception if the current BSON datum is a document, or if the values fail to
+    ///   append.
+    ///
+    core& append_range(const double* values, std::size_t count);
+
+    ///
+    /// Appends `count` int32_t values to the current array as BSON 32-bit signed integers, like
+    /// append_range(const double*, std::size_t).
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws
+    ///   bsoncxx::exception if the current BSON datum is a document, or if the values fail to
+    ///   append.
+    ///
+    core& append_range(const std::int32_t* values, std::size_t count);
+
+    ///
+    /// Appends `count` int64_t values to the current array as BSON 64-bit signed integers, like
+    /// append_range(const double*, std::size_t).
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws
+    ///   bsoncxx::exception if the current BSON datum is a document, or if the values fail to
+    ///   append.
+    ///
+    core& append_range(const std::int64_t* values, std::size_t count);
+
+    ///
+    /// Appends the value of an element of another document under the current key, copying its
+    /// encoded bytes instead of decoding and encoding it again.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws
+    ///   bsoncxx::exception if the element is invalid, if the current BSON datum is a document that
+    ///   is waiting for a key to be appended to start a new key/value pair, or if the value fails
+    ///   to append.
+    ///
+    core& append_raw(const document::element& element);
+
+    ///
+    /// Appends the value of an element of an array, like append_raw(const document::element&).
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws
+    ///   bsoncxx::exception if the element is invalid, if the current BSON datum is a document that
+    ///   is waiting for a key to be appended to start a new key/value pair, or if the value fails
+    ///   to append.
+    ///
+    core& append_raw(const array::element& element);
+
     ///
     /// Gets a view over the document.
     ///
@@ -687,6 +775,33 @@ class BSONCXX_API core {
     ///
     void clear();
 
+    ///
+    /// Grows the underlying buffer so that the top-level BSON datum can reach `size` bytes without
+    /// reallocating.
+    ///
+    /// @param size
+    ///   The number of bytes to reserve.
+    ///
+    /// @throws bsoncxx::exception if a sub-document or sub-array is open, or if `size` exceeds the
+    /// maximum size of a BSON datum.
+    ///
+    void reserve(std::size_t size);
+
+    ///
+    /// Controls what happens to the underlying buffer when the datum is extracted.
+    ///
+    /// By default, extract_document() and extract_array() transfer the buffer itself to the caller
+    /// and the builder starts over with a small buffer. In retain-capacity mode the used bytes are
+    /// instead copied into an exactly-sized buffer for the caller and the builder keeps its
+    /// (possibly large) buffer, which avoids regrowing it when building many similarly-sized
+    /// documents in a loop. Unlike after a normal extraction, the builder may be used again
+    /// immediately after extracting in this mode.
+    ///
+    /// @param retain
+    ///   Whether to retain the buffer capacity across extractions.
+    ///
+    void retain_capacity(bool retain);
+
    private:
     std::unique_ptr<impl> _impl;
 };
@@ -0,0 +1,312 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace builder {
+
+namespace impl {
+
+BSONCXX_INLINE std::uint8_t* store_le32(std::uint8_t* out, std::uint32_t value) {
+    out[0] = static_cast<std::uint8_t>(value);
+    out[1] = static_cast<std::uint8_t>(value >> 8);
+    out[2] = static_cast<std::uint8_t>(value >> 16);
+    out[3] = static_cast<std::uint8_t>(value >> 24);
+    return out + 4;
+}
+
+BSONCXX_INLINE std::uint8_t* store_le64(std::uint8_t* out, std::uint64_t value) {
+    store_le32(out, static_cast<std::uint32_t>(value));
+    return store_le32(out + 4, static_cast<std::uint32_t>(value >> 32));
+}
+
+BSONCXX_INLINE std::uint8_t* store_bytes(std::uint8_t* out, const void* bytes, std::size_t length) {
+    std::memcpy(out, bytes, length);
+    return out + length;
+}
+
+constexpr std::size_t k_oid_length = 12;
+
+// How a field type of builder::fixed is encoded: its BSON type, the size of its encoded value and
+// how to store it.
+template <typename T>
+struct fixed_field;
+
+template <>
+struct fixed_field<std::int32_t> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_int32;
+    }
+    static BSONCXX_INLINE std::size_t size(std::int32_t) {
+        return 4;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, std::int32_t value) {
+        return store_le32(out, static_cast<std::uint32_t>(value));
+    }
+};
+
+template <>
+struct fixed_field<std::int64_t> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_int64;
+    }
+    static BSONCXX_INLINE std::size_t size(std::int64_t) {
+        return 8;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, std::int64_t value) {
+        return store_le64(out, static_cast<std::uint64_t>(value));
+    }
+};
+
+template <>
+struct fixed_field<double> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_double;
+    }
+    static BSONCXX_INLINE std::size_t size(double) {
+        return 8;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return store_le64(out, bits);
+    }
+};
+
+template <>
+struct fixed_field<bool> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_bool;
+    }
+    static BSONCXX_INLINE std::size_t size(bool) {
+        return 1;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, bool value) {
+        *out = value ? 1 : 0;
+        return out + 1;
+    }
+};
+
+template <>
+struct fixed_field<stdx::string_view> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_utf8;
+    }
+    static BSONCXX_INLINE std::size_t size(stdx::string_view value) {
+        return 4 + value.size() + 1;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, stdx::string_view value) {
+        out = store_le32(out, static_cast<std::uint32_t>(value.size() + 1));
+        out = store_bytes(out, value.data(), value.size());
+        *out = 0;
+        return out + 1;
+    }
+};
+
+template <>
+struct fixed_field<oid> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_oid;
+    }
+    static BSONCXX_INLINE std::size_t size(const oid&) {
+        return k_oid_length;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, const oid& value) {
+        return store_bytes(out, value.bytes(), k_oid_length);
+    }
+};
+
+template <>
+struct fixed_field<document::view> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_document;
+    }
+    static BSONCXX_INLINE std::size_t size(document::view value) {
+        return value.length();
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, document::view value) {
+        return store_bytes(out, value.data(), value.length());
+    }
+};
+
+template <>
+struct fixed_field<types::b_date> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_date;
+    }
+    static BSONCXX_INLINE std::size_t size(const types::b_date&) {
+        return 8;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, const types::b_date& value) {
+        return store_le64(out, static_cast<std::uint64_t>(value.value.count()));
+    }
+};
+
+template <>
+struct fixed_field<types::b_timestamp> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_timestamp;
+    }
+    static BSONCXX_INLINE std::size_t size(const types::b_timestamp&) {
+        return 8;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, const types::b_timestamp& value) {
+        out = store_le32(out, value.increment);
+        return store_le32(out, value.timestamp);
+    }
+};
+
+template <>
+struct fixed_field<types::b_binary> {
+    static BSONCXX_INLINE type bson_type() {
+        return type::k_binary;
+    }
+    static BSONCXX_INLINE std::size_t size(const types::b_binary& value) {
+        return 4 + 1 + value.size;
+    }
+    static BSONCXX_INLINE std::uint8_t* write(std::uint8_t* out, const types::b_binary& value) {
+        out = store_le32(out, value.size);
+        *out++ = static_cast<std::uint8_t>(value.sub_type);
+        return store_bytes(out, value.bytes, value.size);
+    }
+};
+
+BSONCXX_INLINE std::size_t values_size() {
+    return 0;
+}
+
+template <typename T, typename... Ts>
+BSONCXX_INLINE std::size_t values_size(const T& value, const Ts&... values) {
+    return fixed_field<T>::size(value) + values_size(values...);
+}
+
+}  // namespace impl
+
+///
+/// A builder for documents whose keys and value types are known up front, such as the records of
+/// a telemetry writer. The element headers (the type bytes and keys) are encoded once, when the
+/// builder is constructed, and build() encodes a document with a single allocation of its exact
+/// size followed by plain stores of each header and value.
+///
+/// The supported field types are std::int32_t, std::int64_t, double, bool, stdx::string_view
+/// (a UTF-8 string), oid, document::view (a subdocument), types::b_date, types::b_timestamp and
+/// types::b_binary.
+///
+/// For example:
+/// @code
+///   builder::fixed<std::int32_t, types::b_date, stdx::string_view> event{"_id", "ts", "user"};
+///   auto doc = event.build(1, types::b_date{std::chrono::system_clock::now()}, "alice");
+/// @endcode
+///
+template <typename... Ts>
+class fixed {
+   public:
+    ///
+    /// Creates a builder for documents with one field per key, in order, of the corresponding
+    /// type in Ts.
+    ///
+    /// @param keys
+    ///   The keys of the fields, as anything that converts to stdx::string_view. The keys must not
+    ///   contain null bytes.
+    ///
+    /// @throws bsoncxx::exception if a key contains a null byte.
+    ///
+    template <typename... Keys>
+    explicit fixed(const Keys&... keys) : _length{4 + 1} {
+        static_assert(sizeof...(Keys) == sizeof...(Ts), "fixed needs one key per field");
+
+        const stdx::string_view key_views[] = {stdx::string_view{}, stdx::string_view{keys}...};
+        const type bson_types[] = {type::k_null, impl::fixed_field<Ts>::bson_type()...};
+        for (std::size_t i = 0; i < sizeof...(Ts); i++) {
+            const auto key = key_views[i + 1];
+            if (key.find('\0') != stdx::string_view::npos) {
+                throw bsoncxx::exception{error_code::k_internal_error,
+                                         "a key of a fixed builder contains a null byte"};
+            }
+
+            _header_offsets[i] = _headers.size();
+            _headers.push_back(static_cast<char>(bson_types[i + 1]));
+            _headers.append(key.data(), key.size());
+            _headers.push_back('\0');
+            _header_lengths[i] = _headers.size() - _header_offsets[i];
+        }
+        _length += _headers.size();
+    }
+
+    ///
+    /// Encodes a document with the builder's keys and the given values.
+    ///
+    /// @throws bsoncxx::exception if the document would be larger than the BSON size limit.
+    ///
+    document::value build(const Ts&... values) const {
+        const auto length = _length + impl::values_size(values...);
+        if (length > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+            throw bsoncxx::exception{error_code::k_internal_error,
+                                     "a document of a fixed builder is too large"};
+        }
+
+        auto data = new std::uint8_t[length];
+        auto out = impl::store_le32(data, static_cast<std::uint32_t>(length));
+        out = write_fields<0>(out, values...);
+        *out = 0;
+
+        return document::value{data, length, [](std::uint8_t* data) { delete[] data; }};
+    }
+
+   private:
+    template <std::size_t I>
+    BSONCXX_INLINE std::uint8_t* write_fields(std::uint8_t* out) const {
+        return out;
+    }
+
+    template <std::size_t I, typename T, typename... Rest>
+    BSONCXX_INLINE std::uint8_t* write_fields(std::uint8_t* out,
+                                              const T& value,
+                                              const Rest&... rest) const {
+        out = impl::store_bytes(out, _headers.data() + _header_offsets[I], _header_lengths[I]);
+        out = impl::fixed_field<T>::write(out, value);
+        return write_fields<I + 1>(out, rest...);
+    }
+
+    std::string _headers;
+    std::array<std::size_t, sizeof...(Ts)> _header_offsets;
+    std::array<std::size_t, sizeof...(Ts)> _header_lengths;
+    std::size_t _length;
+};
+
+}  // namespace builder
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
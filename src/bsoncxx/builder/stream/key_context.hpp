@@ -146,7 +146,7 @@ class key_context {
     /// @param doc
     ///   A document to concatenate
     ///
-    BSONCXX_INLINE key_context operator<<(concatenate_doc doc) {
+    BSONCXX_INLINE key_context operator<<(const concatenate_doc& doc) {
         _core->concatenate(doc);
         return *this;
     }
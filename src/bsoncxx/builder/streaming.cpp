@@ -0,0 +1,418 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/builder/streaming.hpp>
+
+#include <climits>
+#include <cstring>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/builder/fixed.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/itoa.hh>
+#include <bsoncxx/private/stack.hh>
+#include <bsoncxx/stdx/make_unique.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace builder {
+
+streaming::sink::~sink() = default;
+
+streaming::ostream_sink::ostream_sink(std::ostream& stream)
+    : _stream(&stream), _origin(static_cast<std::int64_t>(stream.tellp())) {}
+
+void streaming::ostream_sink::write(const std::uint8_t* bytes, std::size_t length) {
+    _stream->write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(length));
+    if (!*_stream) {
+        throw bsoncxx::exception{error_code::k_cannot_write_to_sink};
+    }
+}
+
+void streaming::ostream_sink::patch(std::uint64_t position,
+                                    const std::uint8_t* bytes,
+                                    std::size_t length) {
+    // tellp() fails on streams that cannot seek.
+    if (_origin < 0) {
+        throw bsoncxx::exception{error_code::k_cannot_write_to_sink};
+    }
+
+    const auto end = _stream->tellp();
+    _stream->seekp(static_cast<std::streamoff>(_origin + static_cast<std::int64_t>(position)));
+    _stream->write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(length));
+    _stream->seekp(end);
+    if (!*_stream) {
+        throw bsoncxx::exception{error_code::k_cannot_write_to_sink};
+    }
+}
+
+constexpr std::size_t streaming::k_default_chunk_size;
+
+class streaming::impl {
+   public:
+    impl(sink& out, std::size_t chunk_size)
+        : _sink(&out),
+          _chunk_size(chunk_size == 0 ? 1 : chunk_size),
+          _flushed(0),
+          _documents(0),
+          _has_key(false),
+          _scratch(false) {
+        _scratch.retain_capacity(true);
+    }
+
+    std::uint64_t position() const {
+        return _flushed + _buffer.size();
+    }
+
+    std::uint64_t documents() const {
+        return _documents;
+    }
+
+    void push_key(stdx::string_view key) {
+        check_key();
+        _key = key;
+        _has_key = true;
+    }
+
+    void push_key(std::string key) {
+        check_key();
+        _owned_key = std::move(key);
+        _key = _owned_key;
+        _has_key = true;
+    }
+
+    void open_document() {
+        if (_stack.empty()) {
+            _top_level_start = position();
+        } else {
+            write_header(type::k_document);
+        }
+        _stack.emplace_back(position(), false);
+        put_le32(0);
+    }
+
+    void close_document() {
+        if (_stack.empty()) {
+            throw bsoncxx::exception{error_code::k_no_document_to_close};
+        }
+        if (_stack.back().is_array) {
+            throw bsoncxx::exception{error_code::k_cannot_close_document_in_sub_array};
+        }
+        close(error_code::k_cannot_end_appending_document);
+
+        if (_stack.empty()) {
+            _documents++;
+            if (_buffer.size() >= _chunk_size) {
+                flush();
+            }
+        }
+    }
+
+    void open_array() {
+        write_header(type::k_array);
+        _stack.emplace_back(position(), true);
+        put_le32(0);
+    }
+
+    void close_array() {
+        if (_stack.empty() || !_stack.back().is_array) {
+            throw bsoncxx::exception{_stack.empty()
+                                         ? error_code::k_no_array_to_close
+                                         : error_code::k_cannot_close_array_in_sub_document};
+        }
+        close(error_code::k_cannot_end_appending_array);
+    }
+
+    void append(const types::value& value) {
+        switch (value.type()) {
+            case type::k_utf8:
+                append_string(type::k_utf8, value.get_utf8().value);
+                return;
+            case type::k_code:
+                append_string(type::k_code, value.get_code().code);
+                return;
+            case type::k_symbol:
+                append_string(type::k_symbol, value.get_symbol().symbol);
+                return;
+            case type::k_document:
+                append_encoded(type::k_document, value.get_document().value);
+                return;
+            case type::k_array: {
+                const auto array = value.get_array().value;
+                append_encoded(type::k_array, document::view{array.data(), array.length()});
+                return;
+            }
+            case type::k_binary: {
+                const auto& binary = value.get_binary();
+                // The deprecated subtype nests a second length, which the scratch builder adds.
+                if (binary.sub_type != binary_sub_type::k_binary_deprecated) {
+                    write_header(type::k_binary);
+                    put_le32(binary.size);
+                    put_byte(static_cast<std::uint8_t>(binary.sub_type));
+                    put(binary.bytes, binary.size);
+                    return;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        // The remaining values are small: encode them with an empty key in the scratch builder
+        // and copy the value from between the key and the trailing null byte.
+        _scratch.clear();
+        _scratch.key_view(stdx::string_view{});
+        _scratch.append(value);
+        const auto encoded = _scratch.view_document();
+
+        write_header(value.type());
+        put(encoded.data() + 6, encoded.length() - 7);
+    }
+
+    void append_string(type string_type, stdx::string_view str) {
+        if (str.size() >= INT32_MAX) {
+            throw bsoncxx::exception{error_code::k_cannot_append_utf8};
+        }
+        write_header(string_type);
+        put_le32(static_cast<std::uint32_t>(str.size() + 1));
+        put(str.data(), str.size());
+        put_byte(0);
+    }
+
+    void append_encoded(type document_type, document::view view) {
+        write_header(document_type);
+        put(view.data(), view.length());
+    }
+
+    void flush() {
+        flush_front(_buffer.size());
+    }
+
+   private:
+    struct frame {
+        frame(std::uint64_t start, bool is_array) : start(start), is_array(is_array), n(0) {}
+
+        // Called by stack::pop_back(); the length has already been filled in by then.
+        void close() {}
+
+        // The position of the length of the document or array.
+        std::uint64_t start;
+        bool is_array;
+        std::uint32_t n;
+    };
+
+    void check_key() {
+        if (_stack.empty()) {
+            throw bsoncxx::exception{error_code::k_no_open_document};
+        }
+        if (_stack.back().is_array) {
+            throw bsoncxx::exception{error_code::k_cannot_append_key_in_sub_array};
+        }
+        if (_has_key) {
+            throw bsoncxx::exception{error_code::k_unmatched_key_in_builder};
+        }
+    }
+
+    stdx::string_view next_key() {
+        if (_stack.empty()) {
+            throw bsoncxx::exception{error_code::k_no_open_document};
+        }
+
+        auto& top = _stack.back();
+        if (top.is_array) {
+            _itoa_key = top.n++;
+            return stdx::string_view{_itoa_key.c_str(), _itoa_key.length()};
+        }
+        if (!_has_key) {
+            throw bsoncxx::exception{error_code::k_need_key};
+        }
+        _has_key = false;
+        return _key;
+    }
+
+    void write_header(type element_type) {
+        const auto key = next_key();
+        put_byte(static_cast<std::uint8_t>(element_type));
+        put(key.data(), key.size());
+        put_byte(0);
+    }
+
+    // Terminates the current document or array and fills in its length.
+    void close(error_code on_error) {
+        put_byte(0);
+
+        const std::uint64_t start = _stack.back().start;
+        const std::uint64_t length = position() - start;
+        if (length > INT32_MAX) {
+            throw bsoncxx::exception{on_error};
+        }
+
+        std::uint8_t le_length[4];
+        builder::impl::store_le32(le_length, static_cast<std::uint32_t>(length));
+        if (start >= _flushed) {
+            std::memcpy(_buffer.data() + (start - _flushed), le_length, sizeof(le_length));
+        } else {
+            _sink->patch(start, le_length, sizeof(le_length));
+        }
+
+        _stack.pop_back();
+    }
+
+    void put(const void* bytes, std::size_t length) {
+        const auto first = static_cast<const std::uint8_t*>(bytes);
+
+        if (length >= _chunk_size) {
+            // Too large to be worth buffering.
+            flush();
+            _sink->write(first, length);
+            _flushed += length;
+            return;
+        }
+
+        if (_buffer.size() + length > _chunk_size) {
+            make_room(length);
+        }
+        _buffer.insert(_buffer.end(), first, first + length);
+    }
+
+    void put_byte(std::uint8_t byte) {
+        put(&byte, 1);
+    }
+
+    void put_le32(std::uint32_t value) {
+        std::uint8_t le[4];
+        builder::impl::store_le32(le, value);
+        put(le, sizeof(le));
+    }
+
+    // Hands buffered bytes to the sink to make room for `length` more. When the open top-level
+    // document would still fit in a chunk, only the bytes before it are written, so that its
+    // length can be filled in without patching the sink.
+    void make_room(std::size_t length) {
+        if (!_stack.empty() && _top_level_start > _flushed &&
+            position() + length - _top_level_start <= _chunk_size) {
+            flush_front(static_cast<std::size_t>(_top_level_start - _flushed));
+            return;
+        }
+        flush();
+    }
+
+    void flush_front(std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+        _sink->write(_buffer.data(), count);
+        _flushed += count;
+        _buffer.erase(_buffer.begin(), _buffer.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    sink* _sink;
+    std::size_t _chunk_size;
+    std::vector<std::uint8_t> _buffer;
+    std::uint64_t _flushed;
+    std::uint64_t _documents;
+    // The position of the open top-level document.
+    std::uint64_t _top_level_start = 0;
+
+    stack<frame, 4> _stack;
+
+    stdx::string_view _key;
+    std::string _owned_key;
+    bool _has_key;
+    itoa _itoa_key;
+
+    // Encodes the small values that are not written directly.
+    core _scratch;
+};
+
+streaming::streaming(sink& out, std::size_t chunk_size)
+    : _impl(stdx::make_unique<impl>(out, chunk_size)) {}
+
+streaming::streaming(streaming&&) noexcept = default;
+
+streaming& streaming::operator=(streaming&&) noexcept = default;
+
+streaming::~streaming() = default;
+
+streaming& streaming::key_owned(std::string key) {
+    _impl->push_key(std::move(key));
+    return *this;
+}
+
+streaming& streaming::key_view(stdx::string_view key) {
+    _impl->push_key(key);
+    return *this;
+}
+
+streaming& streaming::open_document() {
+    _impl->open_document();
+    return *this;
+}
+
+streaming& streaming::close_document() {
+    _impl->close_document();
+    return *this;
+}
+
+streaming& streaming::open_array() {
+    _impl->open_array();
+    return *this;
+}
+
+streaming& streaming::close_array() {
+    _impl->close_array();
+    return *this;
+}
+
+streaming& streaming::append(const types::value& value) {
+    _impl->append(value);
+    return *this;
+}
+
+streaming& streaming::append(stdx::string_view str) {
+    _impl->append_string(type::k_utf8, str);
+    return *this;
+}
+
+streaming& streaming::append(document::view view) {
+    _impl->append_encoded(type::k_document, view);
+    return *this;
+}
+
+streaming& streaming::append(array::view view) {
+    _impl->append_encoded(type::k_array, document::view{view.data(), view.length()});
+    return *this;
+}
+
+void streaming::flush() {
+    _impl->flush();
+}
+
+std::uint64_t streaming::size() const {
+    return _impl->position();
+}
+
+std::uint64_t streaming::documents() const {
+    return _impl->documents();
+}
+
+}  // namespace builder
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,222 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types.hpp>
+#include <bsoncxx/types/value.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace builder {
+
+///
+/// A builder that writes a sequence of BSON documents to a sink as they are built, instead of
+/// holding them in memory, for tools that export many large documents to a file or a socket.
+///
+/// Encoded bytes are gathered in a buffer of `chunk_size` bytes, which is handed to the sink when
+/// it fills up. The length of a document or array is only known when it is closed, so a length
+/// placeholder is written when it is opened and filled in on close: in the buffer if it has not
+/// been handed to the sink yet, and through sink::patch() otherwise. Documents and arrays that
+/// fit in the buffer therefore never need patching, so a sink that cannot seek, such as a
+/// socket, works with a `chunk_size` at least as large as the documents it is given.
+///
+/// Keys and values are appended as with builder::core, except that top-level documents must be
+/// opened and closed explicitly with open_document() and close_document().
+///
+class BSONCXX_API streaming {
+   public:
+    ///
+    /// The destination of the encoded documents.
+    ///
+    class BSONCXX_API sink {
+       public:
+        virtual ~sink();
+
+        ///
+        /// Appends bytes to the stream.
+        ///
+        virtual void write(const std::uint8_t* bytes, std::size_t length) = 0;
+
+        ///
+        /// Overwrites bytes that were already written, `position` bytes from the beginning of the
+        /// stream. Sinks that cannot seek may throw, provided no document exceeds the builder's
+        /// chunk size.
+        ///
+        virtual void patch(std::uint64_t position,
+                           const std::uint8_t* bytes,
+                           std::size_t length) = 0;
+    };
+
+    ///
+    /// A sink writing to a seekable std::ostream, such as a std::ofstream opened in binary mode.
+    /// Positions are relative to the position of the stream when the sink is constructed.
+    ///
+    class BSONCXX_API ostream_sink : public sink {
+       public:
+        explicit ostream_sink(std::ostream& stream);
+
+        void write(const std::uint8_t* bytes, std::size_t length) override;
+
+        void patch(std::uint64_t position, const std::uint8_t* bytes, std::size_t length) override;
+
+       private:
+        std::ostream* _stream;
+        std::int64_t _origin;
+    };
+
+    ///
+    /// The default number of bytes buffered before they are handed to the sink: the maximum size
+    /// of a document stored by the server, so that stored documents never need patching.
+    ///
+    static constexpr std::size_t k_default_chunk_size = 16 * 1024 * 1024;
+
+    ///
+    /// Constructs a builder writing to a sink. The sink must outlive the builder.
+    ///
+    /// @param out
+    ///   The sink to write to.
+    /// @param chunk_size
+    ///   The number of bytes to buffer before writing them to the sink.
+    ///
+    explicit streaming(sink& out, std::size_t chunk_size = k_default_chunk_size);
+
+    streaming(streaming&& rhs) noexcept;
+    streaming& operator=(streaming&& rhs) noexcept;
+
+    ///
+    /// Destroys the builder without flushing it, since flushing may throw. Call flush() first.
+    ///
+    ~streaming();
+
+    ///
+    /// Sets the key of the next value, which is copied until the value is appended.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is an
+    /// array.
+    ///
+    streaming& key_owned(std::string key);
+
+    ///
+    /// Sets the key of the next value. The key must stay valid until the value is appended.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is an
+    /// array.
+    ///
+    streaming& key_view(stdx::string_view key);
+
+    ///
+    /// Opens a document: a new top-level document if none is open, and a subdocument under the
+    /// current key otherwise.
+    ///
+    /// @throws bsoncxx::exception if the current BSON datum is a document that is waiting for a
+    /// key.
+    ///
+    streaming& open_document();
+
+    ///
+    /// Closes the current document. Closing a top-level document completes it in the stream.
+    ///
+    /// @throws bsoncxx::exception if the current BSON datum is not a document, or if it is larger
+    /// than the largest BSON document.
+    ///
+    streaming& close_document();
+
+    ///
+    /// Opens a subarray under the current key.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is a
+    /// document that is waiting for a key.
+    ///
+    streaming& open_array();
+
+    ///
+    /// Closes the current array.
+    ///
+    /// @throws bsoncxx::exception if the current BSON datum is not an array, or if it is larger
+    /// than the largest BSON array.
+    ///
+    streaming& close_array();
+
+    ///
+    /// Appends a BSON value under the current key.
+    ///
+    /// Strings, binary data and documents are written straight from the caller's buffer, which is
+    /// handed to the sink without copying when it is larger than the chunk size.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is a
+    /// document that is waiting for a key.
+    ///
+    streaming& append(const types::value& value);
+
+    ///
+    /// Appends a string view as a BSON UTF-8 string.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is a
+    /// document that is waiting for a key.
+    ///
+    streaming& append(stdx::string_view str);
+
+    ///
+    /// Appends a BSON document.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is a
+    /// document that is waiting for a key.
+    ///
+    streaming& append(document::view view);
+
+    ///
+    /// Appends a BSON array.
+    ///
+    /// @throws bsoncxx::exception if no document is open, or if the current BSON datum is a
+    /// document that is waiting for a key.
+    ///
+    streaming& append(array::view view);
+
+    ///
+    /// Hands the buffered bytes to the sink.
+    ///
+    void flush();
+
+    ///
+    /// @return The number of bytes encoded so far, including those still buffered.
+    ///
+    std::uint64_t size() const;
+
+    ///
+    /// @return The number of top-level documents completed so far.
+    ///
+    std::uint64_t documents() const;
+
+   private:
+    class BSONCXX_PRIVATE impl;
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace builder
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -14,33 +14,223 @@
 
 #include <bsoncxx/decimal128.hpp>
 
+#include <cstring>
+
 #include <bsoncxx/exception/error_code.hpp>
 #include <bsoncxx/exception/exception.hpp>
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/stdx/string_view.hpp>
-#include <bsoncxx/string/to_string.hpp>
 
 #include <bsoncxx/config/private/prelude.hh>
 
 namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
 
+namespace {
+
+static_assert(decimal128::k_max_string_size == BSON_DECIMAL128_STRING,
+              "the to_chars buffer must fit any string libbson can produce");
+
+constexpr std::uint64_t k_sign_bit = 1ULL << 63;
+constexpr int k_exponent_shift = 49;
+constexpr int k_exponent_bias = 6176;
+constexpr int k_exponent_max = 6111;
+constexpr int k_exponent_min = -6176;
+
+// The high word's bits below the biased exponent, which hold the top of the coefficient.
+constexpr std::uint64_t k_coefficient_high_mask = (1ULL << k_exponent_shift) - 1;
+
+// Writes the digits of value and returns how many were written.
+int write_digits(std::uint64_t value, char* out) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (int i = 0; i < count; ++i) {
+        out[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+// Formats a finite value whose coefficient fits in the low word, following the BSON Decimal128
+// specification's rules for choosing between plain and scientific notation.
+std::size_t format_small(bool negative, std::uint64_t coefficient, int exponent, char* out) {
+    char* p = out;
+    if (negative) {
+        *p++ = '-';
+    }
+
+    char digits[20];
+    const int count = write_digits(coefficient, digits);
+    const int adjusted = exponent + count - 1;
+
+    if (exponent > 0 || adjusted < -6) {
+        *p++ = digits[0];
+        if (count > 1) {
+            *p++ = '.';
+            std::memcpy(p, digits + 1, static_cast<std::size_t>(count - 1));
+            p += count - 1;
+        }
+        *p++ = 'E';
+        *p++ = adjusted < 0 ? '-' : '+';
+        p += write_digits(static_cast<std::uint64_t>(adjusted < 0 ? -adjusted : adjusted), p);
+    } else if (exponent == 0) {
+        std::memcpy(p, digits, static_cast<std::size_t>(count));
+        p += count;
+    } else {
+        const int integer_digits = count + exponent;
+        if (integer_digits > 0) {
+            std::memcpy(p, digits, static_cast<std::size_t>(integer_digits));
+            p += integer_digits;
+            *p++ = '.';
+            std::memcpy(p, digits + integer_digits, static_cast<std::size_t>(-exponent));
+            p += -exponent;
+        } else {
+            *p++ = '0';
+            *p++ = '.';
+            std::memset(p, '0', static_cast<std::size_t>(-integer_digits));
+            p += -integer_digits;
+            std::memcpy(p, digits, static_cast<std::size_t>(count));
+            p += count;
+        }
+    }
+
+    *p = '\0';
+    return static_cast<std::size_t>(p - out);
+}
+
+// Parses strings of the form [+-]digits[.digits][(e|E)[+-]digits] with at most 19 significant
+// digits and an exponent that needs no clamping. Returns false for anything else, which the
+// caller hands to libbson.
+bool parse_small(stdx::string_view str, std::uint64_t* high, std::uint64_t* low) {
+    const char* p = str.data();
+    const char* end = p + str.size();
+
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = *p++ == '-';
+    }
+
+    std::uint64_t coefficient = 0;
+    int significant = 0;
+    int fraction_digits = 0;
+    auto read_digits = [&](bool fraction) {
+        const char* start = p;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if (coefficient != 0 || *p != '0') {
+                ++significant;
+            }
+            coefficient = coefficient * 10 + static_cast<std::uint64_t>(*p - '0');
+            if (fraction) {
+                ++fraction_digits;
+            }
+        }
+        return p != start;
+    };
+
+    if (!read_digits(false)) {
+        return false;
+    }
+    if (p != end && *p == '.') {
+        ++p;
+        if (!read_digits(true)) {
+            return false;
+        }
+    }
+    if (significant > 19) {
+        return false;
+    }
+
+    int exponent = 0;
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '+' || *p == '-')) {
+            negative_exponent = *p++ == '-';
+        }
+
+        const char* start = p;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if (p - start == 4) {
+                return false;
+            }
+            exponent = exponent * 10 + (*p - '0');
+        }
+        if (p == start) {
+            return false;
+        }
+        if (negative_exponent) {
+            exponent = -exponent;
+        }
+    }
+    if (p != end) {
+        return false;
+    }
+
+    exponent -= fraction_digits;
+    if (exponent < k_exponent_min || exponent > k_exponent_max) {
+        return false;
+    }
+
+    *high = (negative ? k_sign_bit : 0) |
+            (static_cast<std::uint64_t>(exponent + k_exponent_bias) << k_exponent_shift);
+    *low = coefficient;
+    return true;
+}
+
+}  // namespace
+
 decimal128::decimal128(stdx::string_view str) {
-    bson_decimal128_t d128;
-    if (!bson_decimal128_from_string(string::to_string(str).c_str(), &d128)) {
+    if (!from_chars(str, this)) {
         throw bsoncxx::exception{error_code::k_invalid_decimal128};
     }
-    _high = d128.high;
-    _low = d128.low;
 }
 
 std::string decimal128::to_string() const {
+    char str[k_max_string_size];
+    return std::string(str, to_chars(str));
+}
+
+std::size_t decimal128::to_chars(char (&out)[k_max_string_size]) const noexcept {
+    // Values with the top two combination bits set are infinities, NaNs or non-canonical, and
+    // values with coefficient bits in the high word need 128-bit arithmetic: libbson handles both.
+    const bool special = (_high >> 61 & 0x3) == 0x3;
+    if (!special && (_high & k_coefficient_high_mask) == 0) {
+        const int exponent =
+            static_cast<int>(_high >> k_exponent_shift & 0x3FFF) - k_exponent_bias;
+        return format_small((_high & k_sign_bit) != 0, _low, exponent, out);
+    }
+
     bson_decimal128_t d128;
     d128.high = _high;
     d128.low = _low;
-    char str[BSON_DECIMAL128_STRING];
-    bson_decimal128_to_string(&d128, str);
-    return {str};
+    bson_decimal128_to_string(&d128, out);
+    return std::strlen(out);
+}
+
+bool decimal128::from_chars(stdx::string_view str, decimal128* out) noexcept {
+    if (str.empty()) {
+        return false;
+    }
+
+    std::uint64_t high;
+    std::uint64_t low;
+    if (parse_small(str, &high, &low)) {
+        out->_high = high;
+        out->_low = low;
+        return true;
+    }
+
+    bson_decimal128_t d128;
+    if (!bson_decimal128_from_string_w_len(str.data(), static_cast<int>(str.size()), &d128)) {
+        return false;
+    }
+    out->_high = d128.high;
+    out->_low = d128.low;
+    return true;
 }
 
 bool BSONCXX_CALL operator==(const decimal128& lhs, const decimal128& rhs) {
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -62,6 +63,35 @@ class BSONCXX_API decimal128 {
     ///
     std::string to_string() const;
 
+    ///
+    /// The size of a buffer that can hold any decimal128 value converted by to_chars(), including
+    /// its null terminator.
+    ///
+    static constexpr std::size_t k_max_string_size = 43;
+
+    ///
+    /// Converts this decimal128 value to a string representation in a caller-provided buffer,
+    /// without allocating.
+    ///
+    /// @param out
+    ///     The buffer to receive the null-terminated string.
+    ///
+    /// @return The length of the string, not counting the null terminator.
+    ///
+    std::size_t to_chars(char (&out)[k_max_string_size]) const noexcept;
+
+    ///
+    /// Parses a string representation of a decimal number without allocating or throwing.
+    ///
+    /// @param str
+    ///     A string representation of a decimal number.
+    /// @param out
+    ///     Receives the parsed value. It is left unchanged if the string is invalid.
+    ///
+    /// @return true if the string is a valid BSON Decimal128 representation.
+    ///
+    static bool from_chars(stdx::string_view str, decimal128* out) noexcept;
+
     ///
     /// @{
     ///
@@ -0,0 +1,233 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/document/concat_view.hpp>
+
+#include <cstring>
+#include <limits>
+
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/validate.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+namespace {
+
+// The bytes of a document before its first element and after its last.
+constexpr std::size_t k_header_length = sizeof(std::int32_t);
+constexpr std::size_t k_empty_length = k_header_length + 1;
+
+const std::uint8_t k_terminator = 0;
+
+// The number of bytes of the elements of a document.
+std::size_t elements_length(const view& part) {
+    return part.length() > k_empty_length ? part.length() - k_empty_length : 0;
+}
+
+void uint8_t_deleter(std::uint8_t* ptr) {
+    delete[] ptr;
+}
+
+}  // namespace
+
+concat_view::concat_view() : _length{k_empty_length} {
+    _update_header();
+}
+
+concat_view::concat_view(std::initializer_list<document::view> parts) : concat_view{} {
+    _parts.reserve(parts.size());
+    for (auto&& part : parts) {
+        append(part);
+    }
+}
+
+concat_view& concat_view::append(document::view part) {
+    _parts.push_back(part);
+    _length += elements_length(part);
+    _update_header();
+    return *this;
+}
+
+concat_view::const_iterator concat_view::cbegin() const {
+    if (_parts.empty()) {
+        return cend();
+    }
+
+    const_iterator first{&_parts, 0, _parts.front().begin()};
+    first._skip_exhausted_parts();
+    return first;
+}
+
+concat_view::const_iterator concat_view::cend() const {
+    return const_iterator{&_parts, _parts.size(), view::const_iterator{}};
+}
+
+concat_view::const_iterator concat_view::begin() const {
+    return cbegin();
+}
+
+concat_view::const_iterator concat_view::end() const {
+    return cend();
+}
+
+concat_view::const_iterator concat_view::find(stdx::string_view key) const {
+    for (std::size_t i = 0; i < _parts.size(); i++) {
+        auto found = _parts[i].find(key);
+        if (found != _parts[i].end()) {
+            return const_iterator{&_parts, i, found};
+        }
+    }
+    return cend();
+}
+
+element concat_view::operator[](stdx::string_view key) const {
+    for (auto&& part : _parts) {
+        if (auto found = part[key]) {
+            return found;
+        }
+    }
+    return element{};
+}
+
+std::size_t concat_view::length() const {
+    return _length;
+}
+
+bool concat_view::empty() const {
+    return _length == k_empty_length;
+}
+
+const std::vector<document::view>& concat_view::parts() const {
+    return _parts;
+}
+
+std::vector<concat_view::range> concat_view::ranges() const {
+    std::vector<range> ranges;
+    ranges.reserve(_parts.size() + 2);
+
+    ranges.push_back({_header, k_header_length});
+    for (auto&& part : _parts) {
+        if (auto length = elements_length(part)) {
+            ranges.push_back({part.data() + k_header_length, length});
+        }
+    }
+    ranges.push_back({&k_terminator, 1});
+
+    return ranges;
+}
+
+void concat_view::copy_to(std::uint8_t* out) const {
+    for (auto&& range : ranges()) {
+        std::memcpy(out, range.data, range.length);
+        out += range.length;
+    }
+}
+
+document::value concat_view::value() const {
+    std::unique_ptr<std::uint8_t[], document::value::deleter_type> data{
+        new std::uint8_t[_length], &uint8_t_deleter};
+    copy_to(data.get());
+    return document::value{std::move(data), _length};
+}
+
+bool concat_view::validate_structure(std::size_t* invalid_offset) const {
+    if (_length > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        if (invalid_offset) {
+            *invalid_offset = 0;
+        }
+        return false;
+    }
+
+    // Each element of a part lies in the combined document at the same offset from the start of
+    // the part's elements.
+    std::size_t part_offset = k_header_length;
+    for (auto&& part : _parts) {
+        std::size_t offset;
+        if (!bsoncxx::validate_structure(part.data(), part.length(), &offset)) {
+            if (invalid_offset) {
+                *invalid_offset = part_offset + (offset ? offset - k_header_length : 0);
+            }
+            return false;
+        }
+        part_offset += elements_length(part);
+    }
+
+    return true;
+}
+
+void concat_view::_update_header() {
+    const auto le = BSON_UINT32_TO_LE(static_cast<std::uint32_t>(_length));
+    std::memcpy(_header, &le, sizeof(le));
+}
+
+concat_view::const_iterator::const_iterator() : _parts{nullptr}, _part{0} {}
+
+concat_view::const_iterator::const_iterator(const std::vector<document::view>* parts,
+                                            std::size_t part,
+                                            view::const_iterator element)
+    : _parts{parts}, _part{part}, _element{element} {}
+
+concat_view::const_iterator::reference concat_view::const_iterator::operator*() {
+    return *_element;
+}
+
+concat_view::const_iterator::pointer concat_view::const_iterator::operator->() {
+    return &*_element;
+}
+
+concat_view::const_iterator& concat_view::const_iterator::operator++() {
+    if (!_parts || _part == _parts->size()) {
+        return *this;
+    }
+
+    ++_element;
+    _skip_exhausted_parts();
+    return *this;
+}
+
+concat_view::const_iterator concat_view::const_iterator::operator++(int) {
+    const_iterator before(*this);
+    operator++();
+    return before;
+}
+
+void concat_view::const_iterator::_skip_exhausted_parts() {
+    while (_part < _parts->size() && _element == (*_parts)[_part].end()) {
+        if (++_part < _parts->size()) {
+            _element = (*_parts)[_part].begin();
+        }
+    }
+
+    if (_part == _parts->size()) {
+        _element = view::const_iterator{};
+    }
+}
+
+bool BSONCXX_CALL operator==(const concat_view::const_iterator& lhs,
+                             const concat_view::const_iterator& rhs) {
+    return lhs._part == rhs._part && lhs._element == rhs._element;
+}
+
+bool BSONCXX_CALL operator!=(const concat_view::const_iterator& lhs,
+                             const concat_view::const_iterator& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
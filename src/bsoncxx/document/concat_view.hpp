@@ -0,0 +1,223 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+///
+/// A read-only, non-owning view of the document made of the elements of several documents, one
+/// after the other, without copying any of them.
+///
+/// A concat_view iterates, finds and validates like a document::view of the document that
+/// builder::basic::concatenate would build from its parts, but keeps only a view of each part and
+/// the four bytes of the combined document's length. The combined document is never assembled
+/// unless it is asked for: ranges() gives its bytes as a list of buffers, suited to scatter-gather
+/// writes such as writev(), and copy_to() and value() write it out with a single copy of each
+/// part.
+///
+/// @remark As with builder::basic::concatenate, keys are not deduplicated; find() and operator[]
+/// return the first matching element.
+///
+class BSONCXX_API concat_view {
+   public:
+    class BSONCXX_API const_iterator;
+    using iterator = const_iterator;
+
+    ///
+    /// A buffer of bytes of the combined document.
+    ///
+    struct range {
+        const std::uint8_t* data;
+        std::size_t length;
+    };
+
+    ///
+    /// Constructs a view of the empty document.
+    ///
+    concat_view();
+
+    ///
+    /// Constructs a view of the concatenation of documents. The caller is responsible for ensuring
+    /// that the lifetime of the concat_view is a subset of every part's.
+    ///
+    /// @param parts
+    ///   The documents whose elements make up the view, in order.
+    ///
+    concat_view(std::initializer_list<document::view> parts);
+
+    ///
+    /// Appends the elements of a document to the view.
+    ///
+    /// @param part
+    ///   The document to append. It must outlive the concat_view.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.
+    ///
+    concat_view& append(document::view part);
+
+    ///
+    /// @return An iterator to the first element of the combined document.
+    ///
+    const_iterator cbegin() const;
+
+    ///
+    /// @return An iterator to the past-the-end element of the combined document.
+    ///
+    const_iterator cend() const;
+
+    ///
+    /// @return An iterator to the first element of the combined document.
+    ///
+    const_iterator begin() const;
+
+    ///
+    /// @return An iterator to the past-the-end element of the combined document.
+    ///
+    const_iterator end() const;
+
+    ///
+    /// Finds the first element of the combined document with the provided key.
+    ///
+    /// @param key
+    ///   The key to search for.
+    ///
+    /// @return An iterator to the matching element, if found, or the past-the-end iterator.
+    ///
+    const_iterator find(stdx::string_view key) const;
+
+    ///
+    /// Finds the first element of the combined document with the provided key.
+    ///
+    /// @param key
+    ///   The key to search for.
+    ///
+    /// @return The matching element, if found, or the invalid element.
+    ///
+    element operator[](stdx::string_view key) const;
+
+    ///
+    /// @return The length in bytes of the combined document.
+    ///
+    std::size_t length() const;
+
+    ///
+    /// @return Whether the combined document has no elements.
+    ///
+    bool empty() const;
+
+    ///
+    /// @return The parts of the view, in order.
+    ///
+    const std::vector<document::view>& parts() const;
+
+    ///
+    /// Gets the bytes of the combined document as a list of buffers: its length, the elements of
+    /// each non-empty part, and its terminator. The buffers are valid until the concat_view is
+    /// appended to, moved or destroyed.
+    ///
+    /// @return The buffers, which hold length() bytes in all.
+    ///
+    std::vector<range> ranges() const;
+
+    ///
+    /// Writes the combined document to a buffer.
+    ///
+    /// @param out
+    ///   A buffer of at least length() bytes.
+    ///
+    void copy_to(std::uint8_t* out) const;
+
+    ///
+    /// @return A document::value holding a copy of the combined document.
+    ///
+    document::value value() const;
+
+    ///
+    /// Checks the structure of every part as bsoncxx::validate_structure() does, and that the
+    /// combined document is not too long for BSON.
+    ///
+    /// @param invalid_offset
+    ///   If the combined document is invalid, the offset within it of the element found to be
+    ///   invalid, or of the start of the part whose own length or terminator is wrong, or 0 if the
+    ///   combined document is too long, is stored here (if non-null).
+    ///
+    /// @return Whether the combined document is well-formed.
+    ///
+    bool validate_structure(std::size_t* invalid_offset = nullptr) const;
+
+   private:
+    BSONCXX_PRIVATE void _update_header();
+
+    std::vector<document::view> _parts;
+    std::size_t _length;
+    std::uint8_t _header[4];
+};
+
+///
+/// An iterator over the elements of a concat_view, which visits the elements of each part in turn.
+///
+class BSONCXX_API concat_view::const_iterator : public std::iterator<std::forward_iterator_tag,
+                                                                     element,
+                                                                     std::ptrdiff_t,
+                                                                     const element*,
+                                                                     const element&> {
+   public:
+    const_iterator();
+
+    reference operator*();
+    pointer operator->();
+
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    friend BSONCXX_API bool BSONCXX_CALL operator==(const const_iterator&, const const_iterator&);
+    friend BSONCXX_API bool BSONCXX_CALL operator!=(const const_iterator&, const const_iterator&);
+
+   private:
+    friend class concat_view;
+
+    BSONCXX_PRIVATE const_iterator(const std::vector<document::view>* parts,
+                                   std::size_t part,
+                                   view::const_iterator element);
+
+    // Moves to the first element of the next non-empty part once the current part is exhausted.
+    BSONCXX_PRIVATE void _skip_exhausted_parts();
+
+    const std::vector<document::view>* _parts;
+    std::size_t _part;
+    view::const_iterator _element;
+};
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -23,6 +23,7 @@
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/types.hpp>
 #include <bsoncxx/types/value.hpp>
+#include <bsoncxx/types/value_view.hpp>
 
 #include <bsoncxx/config/private/prelude.hh>
 
@@ -30,12 +31,14 @@
     bson_iter_t iter; \
     bson_iter_init_from_data_at_offset(&iter, _raw, _length, _offset, _keylen);
 
-#define BSONCXX_TYPE_CHECK(name)                                              \
-    do {                                                                      \
-        if (type() != bsoncxx::type::name) {                                  \
-            throw bsoncxx::exception{error_code::k_need_element_type_##name}; \
-        }                                                                     \
-    } while (0)
+#define BSONCXX_CITER_OF_TYPE(name)                                                \
+    if (_raw == nullptr) {                                                         \
+        throw bsoncxx::exception{error_code::k_unset_element};                     \
+    }                                                                              \
+    BSONCXX_CITER;                                                                 \
+    if (bson_iter_type(&iter) != static_cast<bson_type_t>(bsoncxx::type::name)) { \
+        throw bsoncxx::exception{error_code::k_need_element_type_##name};          \
+    }
 
 namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
@@ -85,190 +88,191 @@ stdx::string_view element::key() const {
     return stdx::string_view{key};
 }
 
-types::b_binary element::get_binary() const {
-    BSONCXX_TYPE_CHECK(k_binary);
-
-    BSONCXX_CITER;
-
-    bson_subtype_t type;
-    std::uint32_t len;
-    const std::uint8_t* binary;
+namespace {
 
-    bson_iter_binary(&iter, &type, &len, &binary);
+// Decoders for an iterator already known to point at an element of the decoded type.
+template <typename T>
+T decode(const bson_iter_t* iter);
 
-    return types::b_binary{static_cast<binary_sub_type>(type), len, binary};
+template <>
+types::b_double decode(const bson_iter_t* iter) {
+    return types::b_double{bson_iter_double(iter)};
 }
 
-types::b_utf8 element::get_utf8() const {
-    BSONCXX_TYPE_CHECK(k_utf8);
-
-    BSONCXX_CITER;
-
+template <>
+types::b_utf8 decode(const bson_iter_t* iter) {
     uint32_t len;
-    const char* val = bson_iter_utf8(&iter, &len);
+    const char* val = bson_iter_utf8(iter, &len);
 
     return types::b_utf8{stdx::string_view{val, len}};
 }
 
-types::b_double element::get_double() const {
-    BSONCXX_TYPE_CHECK(k_double);
-    BSONCXX_CITER;
-    return types::b_double{bson_iter_double(&iter)};
+template <>
+types::b_document decode(const bson_iter_t* iter) {
+    const std::uint8_t* buf;
+    std::uint32_t len;
+
+    bson_iter_document(iter, &len, &buf);
+
+    return types::b_document{document::view{buf, len}};
 }
-types::b_int32 element::get_int32() const {
-    BSONCXX_TYPE_CHECK(k_int32);
-    BSONCXX_CITER;
-    return types::b_int32{bson_iter_int32(&iter)};
+
+template <>
+types::b_array decode(const bson_iter_t* iter) {
+    const std::uint8_t* buf;
+    std::uint32_t len;
+
+    bson_iter_array(iter, &len, &buf);
+
+    return types::b_array{array::view{buf, len}};
 }
-types::b_int64 element::get_int64() const {
-    BSONCXX_TYPE_CHECK(k_int64);
-    BSONCXX_CITER;
-    return types::b_int64{bson_iter_int64(&iter)};
+
+template <>
+types::b_binary decode(const bson_iter_t* iter) {
+    bson_subtype_t type;
+    std::uint32_t len;
+    const std::uint8_t* binary;
+
+    bson_iter_binary(iter, &type, &len, &binary);
+
+    return types::b_binary{static_cast<binary_sub_type>(type), len, binary};
 }
-types::b_undefined element::get_undefined() const {
-    BSONCXX_TYPE_CHECK(k_undefined);
+
+template <>
+types::b_undefined decode(const bson_iter_t*) {
     return types::b_undefined{};
 }
-types::b_oid element::get_oid() const {
-    BSONCXX_TYPE_CHECK(k_oid);
-    BSONCXX_CITER;
 
-    const bson_oid_t* boid = bson_iter_oid(&iter);
+template <>
+types::b_oid decode(const bson_iter_t* iter) {
+    const bson_oid_t* boid = bson_iter_oid(iter);
     oid v(reinterpret_cast<const char*>(boid->bytes), sizeof(boid->bytes));
 
     return types::b_oid{v};
 }
-types::b_decimal128 element::get_decimal128() const {
-    BSONCXX_TYPE_CHECK(k_decimal128);
-    BSONCXX_CITER;
-
-    bson_decimal128_t d128;
-    bson_iter_decimal128(&iter, &d128);
 
-    return types::b_decimal128{decimal128{d128.high, d128.low}};
+template <>
+types::b_bool decode(const bson_iter_t* iter) {
+    return types::b_bool{bson_iter_bool(iter)};
 }
 
-types::b_bool element::get_bool() const {
-    BSONCXX_TYPE_CHECK(k_bool);
-    BSONCXX_CITER;
-    return types::b_bool{bson_iter_bool(&iter)};
+template <>
+types::b_date decode(const bson_iter_t* iter) {
+    return types::b_date{std::chrono::milliseconds{bson_iter_date_time(iter)}};
 }
-types::b_date element::get_date() const {
-    BSONCXX_TYPE_CHECK(k_date);
-    BSONCXX_CITER;
-    return types::b_date{std::chrono::milliseconds{bson_iter_date_time(&iter)}};
-}
-types::b_null element::get_null() const {
-    BSONCXX_TYPE_CHECK(k_null);
+
+template <>
+types::b_null decode(const bson_iter_t*) {
     return types::b_null{};
 }
 
-types::b_regex element::get_regex() const {
-    BSONCXX_TYPE_CHECK(k_regex);
-    BSONCXX_CITER;
-
+template <>
+types::b_regex decode(const bson_iter_t* iter) {
     const char* options;
-    const char* regex = bson_iter_regex(&iter, &options);
+    const char* regex = bson_iter_regex(iter, &options);
 
     return types::b_regex{stdx::string_view{regex}, stdx::string_view{options}};
 }
 
-types::b_dbpointer element::get_dbpointer() const {
-    BSONCXX_TYPE_CHECK(k_dbpointer);
-    BSONCXX_CITER;
-
+template <>
+types::b_dbpointer decode(const bson_iter_t* iter) {
     uint32_t collection_len;
     const char* collection;
     const bson_oid_t* boid;
-    bson_iter_dbpointer(&iter, &collection_len, &collection, &boid);
+    bson_iter_dbpointer(iter, &collection_len, &collection, &boid);
 
     oid v{reinterpret_cast<const char*>(boid->bytes), sizeof(boid->bytes)};
 
     return types::b_dbpointer{stdx::string_view{collection, collection_len}, v};
 }
 
-types::b_code element::get_code() const {
-    BSONCXX_TYPE_CHECK(k_code);
-    BSONCXX_CITER;
-
+template <>
+types::b_code decode(const bson_iter_t* iter) {
     uint32_t len;
-    const char* code = bson_iter_code(&iter, &len);
+    const char* code = bson_iter_code(iter, &len);
 
     return types::b_code{stdx::string_view{code, len}};
 }
 
-types::b_symbol element::get_symbol() const {
-    BSONCXX_TYPE_CHECK(k_symbol);
-    BSONCXX_CITER;
-
+template <>
+types::b_symbol decode(const bson_iter_t* iter) {
     uint32_t len;
-    const char* symbol = bson_iter_symbol(&iter, &len);
+    const char* symbol = bson_iter_symbol(iter, &len);
 
     return types::b_symbol{stdx::string_view{symbol, len}};
 }
 
-types::b_codewscope element::get_codewscope() const {
-    BSONCXX_TYPE_CHECK(k_codewscope);
-    BSONCXX_CITER;
-
+template <>
+types::b_codewscope decode(const bson_iter_t* iter) {
     uint32_t code_len;
     const uint8_t* scope_ptr;
     uint32_t scope_len;
-    const char* code = bson_iter_codewscope(&iter, &code_len, &scope_len, &scope_ptr);
+    const char* code = bson_iter_codewscope(iter, &code_len, &scope_len, &scope_ptr);
     document::view view(scope_ptr, scope_len);
 
     return types::b_codewscope{stdx::string_view{code, code_len}, view};
 }
 
-types::b_timestamp element::get_timestamp() const {
-    BSONCXX_TYPE_CHECK(k_timestamp);
-    BSONCXX_CITER;
+template <>
+types::b_int32 decode(const bson_iter_t* iter) {
+    return types::b_int32{bson_iter_int32(iter)};
+}
 
+template <>
+types::b_timestamp decode(const bson_iter_t* iter) {
     uint32_t timestamp;
     uint32_t increment;
-    bson_iter_timestamp(&iter, &timestamp, &increment);
+    bson_iter_timestamp(iter, &timestamp, &increment);
 
     return types::b_timestamp{increment, timestamp};
 }
 
-types::b_minkey element::get_minkey() const {
-    BSONCXX_TYPE_CHECK(k_minkey);
-    return types::b_minkey{};
-}
-types::b_maxkey element::get_maxkey() const {
-    BSONCXX_TYPE_CHECK(k_maxkey);
-    return types::b_maxkey{};
+template <>
+types::b_int64 decode(const bson_iter_t* iter) {
+    return types::b_int64{bson_iter_int64(iter)};
 }
 
-types::b_document element::get_document() const {
-    BSONCXX_TYPE_CHECK(k_document);
-    BSONCXX_CITER;
+template <>
+types::b_decimal128 decode(const bson_iter_t* iter) {
+    bson_decimal128_t d128;
+    bson_iter_decimal128(iter, &d128);
 
-    const std::uint8_t* buf;
-    std::uint32_t len;
+    return types::b_decimal128{decimal128{d128.high, d128.low}};
+}
 
-    bson_iter_document(&iter, &len, &buf);
+template <>
+types::b_minkey decode(const bson_iter_t*) {
+    return types::b_minkey{};
+}
 
-    return types::b_document{document::view{buf, len}};
+template <>
+types::b_maxkey decode(const bson_iter_t*) {
+    return types::b_maxkey{};
 }
 
-types::b_array element::get_array() const {
-    BSONCXX_TYPE_CHECK(k_array);
-    BSONCXX_CITER;
+}  // namespace
 
-    const std::uint8_t* buf;
-    std::uint32_t len;
+// Each getter initializes the iterator once and checks the type through it, rather than going
+// through type() and decoding the element a second time.
+#define BSONCXX_ENUM(name, val)                   \
+    types::b_##name element::get_##name() const { \
+        BSONCXX_CITER_OF_TYPE(k_##name);          \
+        return decode<types::b_##name>(&iter);    \
+    }
+#include <bsoncxx/enums/type.hpp>
+#undef BSONCXX_ENUM
 
-    bson_iter_array(&iter, &len, &buf);
+types::value element::get_value() const {
+    if (_raw == nullptr) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
 
-    return types::b_array{array::view{buf, len}};
-}
+    BSONCXX_CITER;
 
-types::value element::get_value() const {
-    switch (static_cast<int>(type())) {
+    switch (static_cast<int>(bson_iter_type(&iter))) {
 #define BSONCXX_ENUM(type, val) \
     case val:                   \
-        return types::value{get_##type()};
+        return types::value{decode<types::b_##type>(&iter)};
 #include <bsoncxx/enums/type.hpp>
 #undef BSONCXX_ENUM
     }
@@ -276,6 +280,30 @@ types::value element::get_value() const {
     BSONCXX_UNREACHABLE;
 }
 
+types::value_view element::get_value_view() const {
+    return types::value_view{*this};
+}
+
+template <typename T>
+stdx::optional<T> element::try_get() const {
+    if (_raw == nullptr) {
+        return stdx::nullopt;
+    }
+
+    BSONCXX_CITER;
+
+    if (bson_iter_type(&iter) != static_cast<bson_type_t>(T::type_id)) {
+        return stdx::nullopt;
+    }
+
+    return decode<T>(&iter);
+}
+
+#define BSONCXX_ENUM(name, val) \
+    template stdx::optional<types::b_##name> element::try_get<types::b_##name>() const;
+#include <bsoncxx/enums/type.hpp>
+#undef BSONCXX_ENUM
+
 element element::operator[](stdx::string_view key) const {
     if (_raw == nullptr || type() != bsoncxx::type::k_document)
         return element();
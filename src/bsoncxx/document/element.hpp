@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <bsoncxx/stdx/optional.hpp>
 #include <bsoncxx/stdx/string_view.hpp>
 
 #include <bsoncxx/config/prelude.hpp>
@@ -51,6 +52,7 @@ struct b_decimal128;
 struct b_minkey;
 struct b_maxkey;
 class value;
+class value_view;
 }  // namespace types
 
 namespace array {
@@ -64,7 +66,8 @@ namespace document {
 ///
 /// Element functions as a variant type, where the kind of the element can be
 /// interrogated by calling type(), the key can be extracted by calling key() and
-/// a specific value can be extracted through get_X() accessors.
+/// a specific value can be extracted through get_X() accessors, or without
+/// throwing through try_get().
 ///
 /// @relatesalso array::element
 ///
@@ -327,6 +330,28 @@ class BSONCXX_API element {
     ///
     types::value get_value() const;
 
+    ///
+    /// Getter for the value of the element if it has the type T, where T is one
+    /// of the types::b_xxx types. Unlike the get_X() accessors, the element is
+    /// decoded only once and a type mismatch does not throw.
+    ///
+    /// To dispatch on the element's type instead, decode it with get_value() and
+    /// call types::value::visit().
+    ///
+    /// @return the element's value, or an empty optional if this element is
+    ///   invalid or is not a T.
+    ///
+    template <typename T>
+    stdx::optional<T> try_get() const;
+
+    ///
+    /// Getter for a lazy types::value_view of the value portion of the element,
+    /// which is only decoded when one of its accessors is called.
+    ///
+    /// @return a view of the element's value.
+    ///
+    types::value_view get_value_view() const;
+
     ///
     /// If this element is a document, finds the first element of the document
     /// with the provided key. If there is no such element, an invalid
@@ -378,6 +403,7 @@ class BSONCXX_API element {
                                      std::uint32_t keylen);
 
     friend class view;
+    friend class indexed_view;
     friend class array::element;
 
     const std::uint8_t* _raw;
@@ -0,0 +1,177 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+///
+/// Inline counterparts of the element accessors of the most common BSON types.
+///
+/// The members of document::element are exported functions which set up a libbson iterator on
+/// every call. These functions instead read the type byte and the value straight from
+/// `raw() + offset()` in the header, so that in a tight loop the compiler can fold the type
+/// checks and value loads into the caller. They throw the same exceptions as the members they
+/// mirror: error_code::k_unset_element for an invalid element, and
+/// error_code::k_need_element_type_k_<type> for an element of another type.
+///
+/// The element must come from iterating or looking up a document or array view, as usual.
+///
+namespace fast {
+
+namespace detail {
+
+BSONCXX_INLINE std::uint32_t load_uint32_le(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+BSONCXX_INLINE std::uint64_t load_uint64_le(const std::uint8_t* p) {
+    return static_cast<std::uint64_t>(load_uint32_le(p)) |
+           (static_cast<std::uint64_t>(load_uint32_le(p + 4)) << 32);
+}
+
+BSONCXX_INLINE const std::uint8_t* checked_value(const element& e, bsoncxx::type wanted) {
+    if (e.raw() == nullptr) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
+
+    const std::uint8_t* p = e.raw() + e.offset();
+    if (static_cast<bsoncxx::type>(p[0]) != wanted) {
+        switch (wanted) {
+#define BSONCXX_ENUM(name, val)   \
+    case bsoncxx::type::k_##name: \
+        throw bsoncxx::exception{error_code::k_need_element_type_k_##name};
+#include <bsoncxx/enums/type.hpp>
+#undef BSONCXX_ENUM
+        }
+    }
+
+    // The value follows the type byte, the key and the key's terminator.
+    return p + 1 + e.keylen() + 1;
+}
+
+}  // namespace detail
+
+///
+/// Returns the type of the element.
+///
+BSONCXX_INLINE bsoncxx::type type(const element& e) {
+    if (e.raw() == nullptr) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
+    return static_cast<bsoncxx::type>(e.raw()[e.offset()]);
+}
+
+///
+/// Returns the key of the element.
+///
+BSONCXX_INLINE stdx::string_view key(const element& e) {
+    if (e.raw() == nullptr) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
+    return stdx::string_view{reinterpret_cast<const char*>(e.raw() + e.offset() + 1), e.keylen()};
+}
+
+BSONCXX_INLINE types::b_double get_double(const element& e) {
+    const auto bits = detail::load_uint64_le(detail::checked_value(e, bsoncxx::type::k_double));
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return types::b_double{value};
+}
+
+BSONCXX_INLINE types::b_utf8 get_utf8(const element& e) {
+    const std::uint8_t* p = detail::checked_value(e, bsoncxx::type::k_utf8);
+
+    // The length counts the string's terminator.
+    return types::b_utf8{
+        stdx::string_view{reinterpret_cast<const char*>(p + 4), detail::load_uint32_le(p) - 1}};
+}
+
+BSONCXX_INLINE types::b_document get_document(const element& e) {
+    const std::uint8_t* p = detail::checked_value(e, bsoncxx::type::k_document);
+    return types::b_document{document::view{p, detail::load_uint32_le(p)}};
+}
+
+BSONCXX_INLINE types::b_array get_array(const element& e) {
+    const std::uint8_t* p = detail::checked_value(e, bsoncxx::type::k_array);
+    return types::b_array{array::view{p, detail::load_uint32_le(p)}};
+}
+
+BSONCXX_INLINE types::b_binary get_binary(const element& e) {
+    const std::uint8_t* p = detail::checked_value(e, bsoncxx::type::k_binary);
+    auto size = detail::load_uint32_le(p);
+    auto sub_type = static_cast<binary_sub_type>(p[4]);
+    const std::uint8_t* bytes = p + 5;
+
+    // The deprecated sub type repeats the length inside the data, as libbson skips over.
+    if (sub_type == binary_sub_type::k_binary_deprecated) {
+        bytes += 4;
+        size -= 4;
+    }
+    return types::b_binary{sub_type, size, bytes};
+}
+
+BSONCXX_INLINE types::b_oid get_oid(const element& e) {
+    const std::uint8_t* p = detail::checked_value(e, bsoncxx::type::k_oid);
+    return types::b_oid{oid{reinterpret_cast<const char*>(p), 12}};
+}
+
+BSONCXX_INLINE types::b_bool get_bool(const element& e) {
+    return types::b_bool{*detail::checked_value(e, bsoncxx::type::k_bool) != 0};
+}
+
+BSONCXX_INLINE types::b_date get_date(const element& e) {
+    const auto ms = detail::load_uint64_le(detail::checked_value(e, bsoncxx::type::k_date));
+    return types::b_date{std::chrono::milliseconds{static_cast<std::int64_t>(ms)}};
+}
+
+BSONCXX_INLINE types::b_int32 get_int32(const element& e) {
+    const auto bits = detail::load_uint32_le(detail::checked_value(e, bsoncxx::type::k_int32));
+    return types::b_int32{static_cast<std::int32_t>(bits)};
+}
+
+BSONCXX_INLINE types::b_timestamp get_timestamp(const element& e) {
+    const std::uint8_t* p = detail::checked_value(e, bsoncxx::type::k_timestamp);
+
+    // The increment is the low half of the value, and the timestamp the high half.
+    return types::b_timestamp{detail::load_uint32_le(p), detail::load_uint32_le(p + 4)};
+}
+
+BSONCXX_INLINE types::b_int64 get_int64(const element& e) {
+    const auto bits = detail::load_uint64_le(detail::checked_value(e, bsoncxx::type::k_int64));
+    return types::b_int64{static_cast<std::int64_t>(bits)};
+}
+
+}  // namespace fast
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -0,0 +1,217 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/document/indexed_view.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/private/structure.hh>
+#include <bsoncxx/stdx/make_unique.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+namespace {
+
+// Documents with at most this many elements are searched linearly over the compact entry table,
+// which beats hashing for short keys. Larger documents also get an open-addressed hash table.
+constexpr std::size_t k_linear_search_limit = 8;
+
+constexpr std::uint32_t k_empty_slot = UINT32_MAX;
+
+// FNV-1a
+std::uint32_t hash_key(const char* key, std::size_t len) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<std::uint8_t>(key[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+}  // namespace
+
+class indexed_view::impl {
+   public:
+    struct entry {
+        std::uint32_t offset;
+        std::uint32_t keylen;
+        std::uint32_t hash;
+    };
+
+    explicit impl(document::view view) : _view(view) {
+        bson_iter_t iter;
+        if (!bson_iter_init_from_data(&iter, _view.data(), _view.length())) {
+            return;
+        }
+
+        while (bson_iter_next(&iter)) {
+            std::uint32_t keylen = bson_iter_key_len(&iter);
+            _entries.push_back(
+                {bson_iter_offset(&iter), keylen, hash_key(bson_iter_key(&iter), keylen)});
+        }
+
+        if (_entries.size() > k_linear_search_limit) {
+            _build_table();
+        }
+    }
+
+    impl(document::view view, std::vector<entry> entries)
+        : _view(view), _entries(std::move(entries)) {
+        if (_entries.size() > k_linear_search_limit) {
+            _build_table();
+        }
+    }
+
+    const entry* lookup(stdx::string_view key) const {
+        const std::uint32_t hash = hash_key(key.data(), key.size());
+
+        if (_slots.empty()) {
+            for (const auto& e : _entries) {
+                if (_matches(e, hash, key)) {
+                    return &e;
+                }
+            }
+            return nullptr;
+        }
+
+        const std::size_t mask = _slots.size() - 1;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+            std::uint32_t slot = _slots[i];
+            if (slot == k_empty_slot) {
+                return nullptr;
+            }
+            if (_matches(_entries[slot], hash, key)) {
+                return &_entries[slot];
+            }
+        }
+    }
+
+    element make_element(const entry& e) const {
+        return element{
+            _view.data(), static_cast<std::uint32_t>(_view.length()), e.offset, e.keylen};
+    }
+
+    document::view _view;
+    std::vector<entry> _entries;
+    std::vector<std::uint32_t> _slots;
+
+   private:
+    // The key of an element starts one byte (the type tag) past its offset.
+    const char* _key_of(const entry& e) const {
+        return reinterpret_cast<const char*>(_view.data() + e.offset + 1);
+    }
+
+    bool _matches(const entry& e, std::uint32_t hash, stdx::string_view key) const {
+        return e.hash == hash && e.keylen == key.size() &&
+               std::memcmp(_key_of(e), key.data(), key.size()) == 0;
+    }
+
+    void _build_table() {
+        // Keep the load factor at or below one half so probe sequences stay short.
+        std::size_t capacity = 1;
+        while (capacity < _entries.size() * 2) {
+            capacity <<= 1;
+        }
+        _slots.assign(capacity, k_empty_slot);
+
+        const std::size_t mask = capacity - 1;
+        for (std::uint32_t idx = 0; idx < _entries.size(); ++idx) {
+            const entry& e = _entries[idx];
+            std::size_t i = e.hash & mask;
+
+            for (; _slots[i] != k_empty_slot; i = (i + 1) & mask) {
+                // Only the first occurrence of a duplicated key is reachable, as with view::find.
+                if (_matches(_entries[_slots[i]],
+                             e.hash,
+                             stdx::string_view{_key_of(e), e.keylen})) {
+                    break;
+                }
+            }
+
+            if (_slots[i] == k_empty_slot) {
+                _slots[i] = idx;
+            }
+        }
+    }
+};
+
+indexed_view::indexed_view(document::view view) : _impl(stdx::make_unique<impl>(view)) {}
+
+indexed_view::indexed_view(std::unique_ptr<impl> impl) : _impl(std::move(impl)) {}
+
+stdx::optional<indexed_view> indexed_view::validated(const std::uint8_t* data,
+                                                     std::size_t length,
+                                                     std::size_t* invalid_offset) {
+    std::vector<impl::entry> entries;
+    const auto record = [&](std::size_t offset, std::size_t keylen) {
+        entries.push_back({static_cast<std::uint32_t>(offset),
+                           static_cast<std::uint32_t>(keylen),
+                           hash_key(reinterpret_cast<const char*>(data + offset + 1), keylen)});
+    };
+    if (!helpers::check_structure(data, length, record, invalid_offset)) {
+        return stdx::nullopt;
+    }
+    return indexed_view{stdx::make_unique<impl>(document::view{data, length}, std::move(entries))};
+}
+
+indexed_view::indexed_view(const indexed_view& other)
+    : _impl(stdx::make_unique<impl>(*other._impl)) {}
+
+indexed_view& indexed_view::operator=(const indexed_view& other) {
+    _impl = stdx::make_unique<impl>(*other._impl);
+    return *this;
+}
+
+indexed_view::indexed_view(indexed_view&&) noexcept = default;
+indexed_view& indexed_view::operator=(indexed_view&&) noexcept = default;
+
+indexed_view::~indexed_view() = default;
+
+document::view::const_iterator indexed_view::find(stdx::string_view key) const {
+    // See the comment in view::find about default constructed string_views.
+    if (key.data() == nullptr) {
+        key = "";
+    }
+
+    const impl::entry* e = _impl->lookup(key);
+    if (!e) {
+        return document::view::const_iterator{};
+    }
+
+    return document::view::const_iterator{_impl->make_element(*e)};
+}
+
+element indexed_view::operator[](stdx::string_view key) const {
+    return *(this->find(key));
+}
+
+std::size_t indexed_view::size() const {
+    return _impl->_entries.size();
+}
+
+document::view indexed_view::view() const {
+    return _impl->_view;
+}
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,122 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+///
+/// A read-only, non-owning view of a BSON document that supports constant-time lookup by key.
+///
+/// Constructing an indexed_view walks the document once and records the position of every
+/// top-level element. Subsequent calls to find() and operator[] consult that index instead of
+/// scanning the document, which pays off when many fields of a wide document are accessed by key.
+/// For a handful of lookups, document::view::find is cheaper.
+///
+/// @remark As with document::view, if a key occurs more than once the first matching element is
+/// returned.
+///
+class BSONCXX_API indexed_view {
+   public:
+    ///
+    /// Builds an index over the top-level keys of a document. The caller is responsible for
+    /// ensuring that the lifetime of the indexed_view is a subset of the viewed buffer's.
+    ///
+    /// @param view
+    ///   The document to index.
+    ///
+    explicit indexed_view(document::view view);
+
+    ///
+    /// Checks the structure of a document as bsoncxx::validate_structure() does, and indexes its
+    /// top-level keys in the same pass, rather than walking the document once for each.
+    ///
+    /// @param data
+    ///   A buffer containing a BSON document. The buffer must outlive the indexed_view.
+    /// @param length
+    ///   The size of the buffer, which must be the length of the document.
+    /// @param invalid_offset
+    ///   If the document is invalid, the offset at which it was found to be invalid is stored
+    ///   here (if non-null).
+    ///
+    /// @return An index over the document, or an unengaged optional if it is malformed.
+    ///
+    static stdx::optional<indexed_view> validated(const std::uint8_t* data,
+                                                  std::size_t length,
+                                                  std::size_t* invalid_offset = nullptr);
+
+    indexed_view(const indexed_view&);
+    indexed_view& operator=(const indexed_view&);
+
+    indexed_view(indexed_view&&) noexcept;
+    indexed_view& operator=(indexed_view&&) noexcept;
+
+    ~indexed_view();
+
+    ///
+    /// Finds the first element of the document with the provided key.
+    ///
+    /// @param key
+    ///   The key to search for.
+    ///
+    /// @return An iterator to the matching element, if found, or the past-the-end iterator.
+    ///
+    document::view::const_iterator find(stdx::string_view key) const;
+
+    ///
+    /// Finds the first element of the document with the provided key.
+    ///
+    /// @param key
+    ///   The key to search for.
+    ///
+    /// @return The matching element, if found, or the invalid element.
+    ///
+    element operator[](stdx::string_view key) const;
+
+    ///
+    /// @return The number of top-level elements in the document.
+    ///
+    std::size_t size() const;
+
+    ///
+    /// @return The indexed document.
+    ///
+    document::view view() const;
+
+   private:
+    class BSONCXX_PRIVATE impl;
+
+    BSONCXX_PRIVATE explicit indexed_view(std::unique_ptr<impl> impl);
+
+    std::unique_ptr<impl> _impl;
+};
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
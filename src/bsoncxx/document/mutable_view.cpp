@@ -0,0 +1,262 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/document/mutable_view.hpp>
+
+#include <cstring>
+#include <vector>
+
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/encoded_value.hh>
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+namespace {
+
+constexpr std::size_t k_oid_length = 12;
+
+void uint8_t_deleter(std::uint8_t* ptr) {
+    delete[] ptr;
+}
+
+void write_uint32(std::uint8_t* out, std::uint32_t value) {
+    const auto le = BSON_UINT32_TO_LE(value);
+    std::memcpy(out, &le, sizeof(le));
+}
+
+void write_uint64(std::uint8_t* out, std::uint64_t value) {
+    const auto le = BSON_UINT64_TO_LE(value);
+    std::memcpy(out, &le, sizeof(le));
+}
+
+// Overwrites the value at out if it has the fixed width, and therefore the size, of the value it
+// replaces. Returns whether it did.
+bool overwrite_fixed(std::uint8_t* out, type current, const types::value& value) {
+    if (value.type() != current) {
+        return false;
+    }
+
+    switch (value.type()) {
+        case type::k_double: {
+            const double d = BSON_DOUBLE_TO_LE(value.get_double().value);
+            std::memcpy(out, &d, sizeof(d));
+            return true;
+        }
+        case type::k_oid:
+            std::memcpy(out, value.get_oid().value.bytes(), k_oid_length);
+            return true;
+        case type::k_bool:
+            *out = value.get_bool().value ? 1 : 0;
+            return true;
+        case type::k_date:
+            write_uint64(out, static_cast<std::uint64_t>(value.get_date().value.count()));
+            return true;
+        case type::k_int32:
+            write_uint32(out, static_cast<std::uint32_t>(value.get_int32().value));
+            return true;
+        case type::k_timestamp:
+            write_uint32(out, value.get_timestamp().increment);
+            write_uint32(out + 4, value.get_timestamp().timestamp);
+            return true;
+        case type::k_int64:
+            write_uint64(out, static_cast<std::uint64_t>(value.get_int64().value));
+            return true;
+        case type::k_decimal128:
+            write_uint64(out, value.get_decimal128().value.low());
+            write_uint64(out + 8, value.get_decimal128().value.high());
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The offsets of the length fields of the documents enclosing the element at position,
+// outermost first. A code with scope has two: its own and its scope's.
+std::vector<std::size_t> enclosing_lengths(const std::uint8_t* data, std::size_t position) {
+    std::vector<std::size_t> lengths;
+    std::size_t doc = 0;
+
+    for (;;) {
+        lengths.push_back(doc);
+
+        bool descended = false;
+        for (auto&& element : document::view{data + doc, helpers::read_uint32_le(data + doc)}) {
+            const std::size_t begin = doc + element.offset();
+            if (begin >= position) {
+                break;
+            }
+
+            const std::size_t value = begin + 2 + element.keylen();
+            const std::size_t end =
+                value + helpers::encoded_value_size(element.type(), data + value);
+            if (position >= end) {
+                continue;
+            }
+
+            if (element.type() == type::k_codewscope) {
+                lengths.push_back(value);
+                doc = value + 8 + helpers::read_uint32_le(data + value + 4);
+            } else {
+                doc = value;
+            }
+            descended = true;
+            break;
+        }
+
+        if (!descended) {
+            return lengths;
+        }
+    }
+}
+
+}  // namespace
+
+mutable_view::mutable_view(document::value& value) noexcept : _value(&value) {}
+
+document::view mutable_view::view() const noexcept {
+    return _value->view();
+}
+
+element mutable_view::operator[](stdx::string_view key) const {
+    return view()[key];
+}
+
+namespace {
+
+// The position of an element in the buffer of a document.
+template <typename element_type>
+std::size_t element_position(document::view document, const element_type& element) {
+    if (!element) {
+        throw bsoncxx::exception{error_code::k_unset_element};
+    }
+
+    const auto begin = document.data();
+    const auto container = element.raw();
+    if (container < begin || container + element.length() > begin + document.length() ||
+        element.offset() >= element.length()) {
+        throw bsoncxx::exception{error_code::k_element_not_in_document};
+    }
+    return static_cast<std::size_t>(container - begin) + element.offset();
+}
+
+}  // namespace
+
+void mutable_view::assign(const element& element, const types::value& value) {
+    _assign(element, value);
+}
+
+void mutable_view::assign(const array::element& element, const types::value& value) {
+    _assign(element, value);
+}
+
+template <typename element_type>
+void mutable_view::_assign(const element_type& element, const types::value& value) {
+    const std::size_t position = element_position(view(), element);
+    const std::size_t value_position = position + 2 + element.keylen();
+    std::uint8_t* data = _value->_data.get();
+
+    if (overwrite_fixed(data + value_position, element.type(), value)) {
+        return;
+    }
+
+    const std::size_t old_size = 2 + element.keylen() +
+                                 helpers::encoded_value_size(element.type(), data + value_position);
+
+    builder::core encoder{false};
+    encoder.key_view(element.key());
+    encoder.append(value);
+    const auto encoded = encoder.view_document();
+
+    // The encoded element is what lies between the document's length and its trailing null byte.
+    _splice(position, old_size, encoded.data() + 4, encoded.length() - 5);
+}
+
+bool mutable_view::assign(stdx::string_view key, const types::value& value) {
+    const auto element = (*this)[key];
+    if (!element) {
+        return false;
+    }
+    assign(element, value);
+    return true;
+}
+
+void mutable_view::erase(const element& element) {
+    _erase(element);
+}
+
+void mutable_view::erase(const array::element& element) {
+    _erase(element);
+}
+
+template <typename element_type>
+void mutable_view::_erase(const element_type& element) {
+    const std::size_t position = element_position(view(), element);
+    const std::size_t value_position = position + 2 + element.keylen();
+    const std::size_t old_size =
+        2 + element.keylen() +
+        helpers::encoded_value_size(element.type(), _value->_data.get() + value_position);
+
+    _splice(position, old_size, nullptr, 0);
+}
+
+void mutable_view::_splice(std::size_t position,
+                           std::size_t old_size,
+                           const std::uint8_t* bytes,
+                           std::size_t new_size) {
+    std::uint8_t* data = _value->_data.get();
+    const std::size_t length = _value->_length;
+
+    if (new_size == old_size) {
+        std::memcpy(data + position, bytes, new_size);
+        return;
+    }
+
+    const auto lengths = enclosing_lengths(data, position);
+    const std::size_t tail = length - position - old_size;
+    const std::size_t new_length = length - old_size + new_size;
+
+    if (new_size < old_size) {
+        // Shrink in place; the buffer keeps its capacity and its deleter.
+        std::memmove(data + position + new_size, data + position + old_size, tail);
+        if (new_size > 0) {
+            std::memcpy(data + position, bytes, new_size);
+        }
+    } else {
+        value::unique_ptr_type grown{new std::uint8_t[new_length], uint8_t_deleter};
+        std::memcpy(grown.get(), data, position);
+        std::memcpy(grown.get() + position, bytes, new_size);
+        std::memcpy(grown.get() + position + new_size, data + position + old_size, tail);
+        _value->_data = std::move(grown);
+        data = _value->_data.get();
+    }
+    _value->_length = new_length;
+
+    // The length fields all precede the element, so they are at the same offsets as before.
+    for (const auto offset : lengths) {
+        const std::size_t length_field = helpers::read_uint32_le(data + offset);
+        write_uint32(data + offset, static_cast<std::uint32_t>(length_field + new_size - old_size));
+    }
+}
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,134 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bsoncxx/array/element.hpp>
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types/value.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+///
+/// A view of a document::value whose elements can be changed without rebuilding the document.
+///
+/// Assigning a value of the same fixed-width type as the element it replaces (double, oid, bool,
+/// date, int32, timestamp, int64 or decimal128) overwrites the value's bytes and touches nothing
+/// else. Any other assignment that keeps the encoded size of the element is also made in place.
+/// Otherwise only the element is encoded again: the bytes after it are moved once and the lengths
+/// of the documents enclosing it are adjusted.
+///
+/// Elements passed to a mutable_view must have been obtained from its view(), at any depth.
+///
+/// @warning
+///   Changing the size of an element may reallocate the document, which invalidates every view and
+///   element into it, including those obtained from this mutable_view.
+///
+class BSONCXX_API mutable_view {
+   public:
+    ///
+    /// Constructs a mutable view of a document. The caller is responsible for ensuring that the
+    /// lifetime of the mutable_view is a subset of the value's.
+    ///
+    /// @param value
+    ///   The document to modify.
+    ///
+    explicit mutable_view(document::value& value) noexcept;
+
+    ///
+    /// @return A view of the document in its current state.
+    ///
+    document::view view() const noexcept;
+
+    ///
+    /// Finds the first top-level element of the document with the provided key.
+    ///
+    /// @return The matching element, if found, or the invalid element.
+    ///
+    element operator[](stdx::string_view key) const;
+
+    ///
+    /// Replaces the value of an element, keeping its key and position.
+    ///
+    /// @param element
+    ///   An element of the document, at any depth.
+    /// @param value
+    ///   The new value of the element.
+    ///
+    /// @throws bsoncxx::exception if the element is invalid or not part of this document.
+    ///
+    void assign(const element& element, const types::value& value);
+
+    ///
+    /// Replaces the value of an element of an array in the document, keeping its position.
+    ///
+    /// @throws bsoncxx::exception if the element is invalid or not part of this document.
+    ///
+    void assign(const array::element& element, const types::value& value);
+
+    ///
+    /// Replaces the value of the first top-level element with the provided key.
+    ///
+    /// @return Whether an element with the key was found.
+    ///
+    bool assign(stdx::string_view key, const types::value& value);
+
+    ///
+    /// Removes an element from the document. The document is shrunk in place.
+    ///
+    /// @param element
+    ///   An element of the document, at any depth.
+    ///
+    /// @throws bsoncxx::exception if the element is invalid or not part of this document.
+    ///
+    void erase(const element& element);
+
+    ///
+    /// Removes an element of an array in the document. The keys of the elements after it are not
+    /// renumbered, so the caller should only erase the last element of an array.
+    ///
+    /// @throws bsoncxx::exception if the element is invalid or not part of this document.
+    ///
+    void erase(const array::element& element);
+
+   private:
+    template <typename element_type>
+    BSONCXX_PRIVATE void _assign(const element_type& element, const types::value& value);
+
+    template <typename element_type>
+    BSONCXX_PRIVATE void _erase(const element_type& element);
+
+    BSONCXX_PRIVATE void _splice(std::size_t position,
+                                 std::size_t old_size,
+                                 const std::uint8_t* bytes,
+                                 std::size_t new_size);
+
+    document::value* _value;
+};
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
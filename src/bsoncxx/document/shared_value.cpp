@@ -0,0 +1,40 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/document/shared_value.hpp>
+
+#include <utility>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+shared_value::shared_value(document::value&& value) : _length{value.view().length()} {
+    // The length is read before release(), which resets it. The buffer keeps its own deleter.
+    auto data = value.release();
+    auto deleter = data.get_deleter();
+    _data = std::shared_ptr<const std::uint8_t>{data.release(), deleter};
+}
+
+shared_value::shared_value(document::view view) : shared_value{document::value{view}} {}
+
+long shared_value::use_count() const noexcept {
+    return _data.use_count();
+}
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,108 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace document {
+
+///
+/// A read-only BSON document whose underlying buffer is shared by every copy of it. Copying a
+/// shared_value only bumps an atomic reference count, so one document can be handed to many
+/// threads, caches or consumers at once. The buffer is freed along with the last copy.
+///
+class BSONCXX_API shared_value {
+   public:
+    ///
+    /// Constructs a shared_value by taking over the buffer of a document::value, without
+    /// copying it. The value must not be used afterwards, unless it is moved into.
+    ///
+    /// @param value
+    ///   The document to share.
+    ///
+    shared_value(document::value&& value);
+
+    ///
+    /// Constructs a shared_value from a view of a document. The data referenced by the view is
+    /// copied into a new buffer shared by the constructed value.
+    ///
+    /// @param view
+    ///   A view of another document to copy.
+    ///
+    explicit shared_value(document::view view);
+
+    ///
+    /// Get a view over the shared document.
+    ///
+    BSONCXX_INLINE document::view view() const noexcept;
+
+    ///
+    /// Conversion operator that provides a view given a shared_value.
+    ///
+    /// @return A view over the shared document.
+    ///
+    BSONCXX_INLINE operator document::view() const noexcept;
+
+    ///
+    /// Returns the number of shared_value objects sharing the buffer, including this one.
+    ///
+    long use_count() const noexcept;
+
+   private:
+    std::shared_ptr<const std::uint8_t> _data;
+    std::size_t _length{0};
+};
+
+BSONCXX_INLINE document::view shared_value::view() const noexcept {
+    return document::view{_data.get(), _length};
+}
+
+BSONCXX_INLINE shared_value::operator document::view() const noexcept {
+    return view();
+}
+
+///
+/// @{
+///
+/// Compares two shared document values for (in)-equality.
+///
+/// @relates document::shared_value
+///
+BSONCXX_INLINE bool operator==(const shared_value& lhs, const shared_value& rhs) {
+    return (lhs.view() == rhs.view());
+}
+
+BSONCXX_INLINE bool operator!=(const shared_value& lhs, const shared_value& rhs) {
+    return !(lhs == rhs);
+}
+
+///
+/// @}
+///
+
+}  // namespace document
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
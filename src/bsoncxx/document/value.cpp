@@ -18,6 +18,8 @@
 #include <cstring>
 #include <utility>
 
+#include <bsoncxx/arena.hpp>
+
 #include <bsoncxx/config/private/prelude.hh>
 
 namespace bsoncxx {
@@ -35,6 +37,9 @@ void uint8_t_deleter(std::uint8_t* ptr) {
     delete[] ptr;
 }
 
+// The arena frees its memory all at once.
+void arena_deleter(std::uint8_t*) {}
+
 }  // namespace
 
 value::value(document::view view)
@@ -43,6 +48,12 @@ value::value(document::view view)
     std::copy(view.data(), view.data() + view.length(), _data.get());
 }
 
+value::value(document::view view, arena& memory)
+    : _data(static_cast<std::uint8_t*>(memory.allocate(view.length())), arena_deleter),
+      _length(view.length()) {
+    std::copy(view.data(), view.data() + view.length(), _data.get());
+}
+
 value::value(const value& rhs) : value(rhs.view()) {}
 
 value& value::operator=(const value& rhs) {
@@ -61,6 +72,10 @@ void value::reset(document::view view) {
     std::copy(view.data(), view.data() + view.length(), _data.get());
 }
 
+value value::copy_into(arena& memory) const {
+    return value{view(), memory};
+}
+
 }  // namespace document
 BSONCXX_INLINE_NAMESPACE_END
 }  // namespace bsoncxx
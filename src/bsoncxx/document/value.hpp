@@ -23,8 +23,13 @@
 
 namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
+
+class arena;
+
 namespace document {
 
+class mutable_view;
+
 ///
 /// A read-only BSON document that owns its underlying buffer. When a document::value goes
 /// out of scope, the underlying buffer is freed. Generally this class should be used
@@ -70,6 +75,19 @@ class BSONCXX_API value {
     ///
     explicit value(document::view view);
 
+    ///
+    /// Constructs a value from a view of a document, copying the data it references into memory
+    /// taken from an arena. Destroying the value frees nothing; the memory is freed along with the
+    /// rest of the arena.
+    ///
+    /// @param view
+    ///   A view of another document to copy.
+    /// @param memory
+    ///   The arena to copy the document into. It must not be cleared or destroyed before the
+    ///   constructed value is.
+    ///
+    value(document::view view, arena& memory);
+
     value(const value&);
     value& operator=(const value&);
 
@@ -105,7 +123,21 @@ class BSONCXX_API value {
     ///
     void reset(document::view view);
 
+    ///
+    /// Copies the document into memory taken from an arena, which is cheaper than a copy of the
+    /// value when many documents are freed at the same time.
+    ///
+    /// @param memory
+    ///   The arena to copy the document into. It must not be cleared or destroyed before the
+    ///   returned value is.
+    ///
+    /// @return A value over the copy.
+    ///
+    value copy_into(arena& memory) const;
+
    private:
+    friend class mutable_view;
+
     unique_ptr_type _data;
     std::size_t _length{0};
 };
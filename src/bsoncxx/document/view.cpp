@@ -18,6 +18,7 @@
 #include <cstring>
 
 #include <bsoncxx/json.hpp>
+#include <bsoncxx/private/element_walk.hh>
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/types.hpp>
 
@@ -27,14 +28,6 @@ namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
 namespace document {
 
-namespace {
-bson_iter_t to_bson_iter_t(element e) {
-    bson_iter_t iter{};
-    bson_iter_init_from_data_at_offset(&iter, e.raw(), e.length(), e.offset(), e.keylen());
-    return iter;
-}
-}  // namespace
-
 view::const_iterator::const_iterator() {}
 
 view::const_iterator::const_iterator(const element& element) : _element(element) {}
@@ -56,12 +49,15 @@ view::const_iterator& view::const_iterator::operator++() {
     auto raw = _element.raw();
     auto len = _element.length();
 
-    bson_iter_t iter = to_bson_iter_t(_element);
+    // Step directly over the encoded element rather than rebuilding and re-validating a
+    // bson_iter_t from (raw, len, offset, keylen) on every increment.
+    std::uint32_t offset;
+    std::uint32_t keylen;
 
-    if (!bson_iter_next(&iter)) {
+    if (!helpers::next_element(raw, len, _element.offset(), _element.keylen(), &offset, &keylen)) {
         _element = element{};
     } else {
-        _element = element{raw, len, bson_iter_offset(&iter), bson_iter_key_len(&iter)};
+        _element = element{raw, len, offset, keylen};
     }
 
     return *this;
@@ -144,6 +140,38 @@ element view::operator[](stdx::string_view key) const {
     return *(this->find(key));
 }
 
+std::size_t view::extract(const stdx::string_view* keys, std::size_t count, element* out) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = element{};
+    }
+
+    bson_iter_t iter;
+    if (count == 0 || !bson_iter_init_from_data(&iter, _data, _length)) {
+        return 0;
+    }
+
+    std::size_t found = 0;
+
+    while (found < count && bson_iter_next(&iter)) {
+        const char* elem_key = bson_iter_key(&iter);
+        std::uint32_t elem_keylen = bson_iter_key_len(&iter);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            // Keep the first match for each key, as find() does.
+            if (out[i] || keys[i].size() != elem_keylen ||
+                (elem_keylen != 0 && std::memcmp(keys[i].data(), elem_key, elem_keylen) != 0)) {
+                continue;
+            }
+
+            out[i] = element{
+                _data, static_cast<uint32_t>(_length), bson_iter_offset(&iter), elem_keylen};
+            ++found;
+        }
+    }
+
+    return found;
+}
+
 view::view(const std::uint8_t* data, std::size_t length) : _data(data), _length(length) {}
 
 namespace {
@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <iterator>
+#include <utility>
 
 #include <bsoncxx/document/element.hpp>
 #include <bsoncxx/stdx/string_view.hpp>
@@ -101,6 +104,51 @@ class BSONCXX_API view {
     ///
     element operator[](stdx::string_view key) const;
 
+    ///
+    /// Looks up several keys in a single forward pass over the document. This is cheaper than
+    /// calling operator[] once per key, each of which scans the document from the start.
+    ///
+    /// @remark As with find(), only the top-level document is searched and the first matching
+    /// element for each key is returned.
+    ///
+    /// @param keys
+    ///   A pointer to `count` keys to search for.
+    /// @param count
+    ///   The number of keys.
+    /// @param out
+    ///   A pointer to `count` elements. On return, out[i] holds the element matching keys[i], or
+    ///   the invalid element if there is none.
+    ///
+    /// @return The number of keys that were found.
+    ///
+    std::size_t extract(const stdx::string_view* keys, std::size_t count, element* out) const;
+
+    ///
+    /// Looks up several keys in a single forward pass over the document.
+    ///
+    /// @param keys
+    ///   The keys to search for.
+    /// @param out
+    ///   A pointer to keys.size() elements. On return, each holds the element matching the key at
+    ///   the same position, or the invalid element if there is none.
+    ///
+    /// @return The number of keys that were found.
+    ///
+    BSONCXX_INLINE std::size_t extract(std::initializer_list<stdx::string_view> keys,
+                                       element* out) const;
+
+    ///
+    /// Looks up a fixed list of keys in a single forward pass over the document.
+    ///
+    /// @param keys
+    ///   The keys to search for. Each must be convertible to stdx::string_view.
+    ///
+    /// @return An array holding, at each position, the element matching the key at the same
+    /// position, or the invalid element if there is none.
+    ///
+    template <typename... Keys>
+    BSONCXX_INLINE std::array<element, sizeof...(Keys)> extract_keys(Keys&&... keys) const;
+
     ///
     /// Access the raw bytes of the underlying document.
     ///
@@ -144,6 +192,19 @@ class BSONCXX_API view {
     std::size_t _length;
 };
 
+BSONCXX_INLINE std::size_t view::extract(std::initializer_list<stdx::string_view> keys,
+                                         element* out) const {
+    return extract(keys.begin(), keys.size(), out);
+}
+
+template <typename... Keys>
+BSONCXX_INLINE std::array<element, sizeof...(Keys)> view::extract_keys(Keys&&... keys) const {
+    const stdx::string_view key_list[] = {stdx::string_view(std::forward<Keys>(keys))...};
+    std::array<element, sizeof...(Keys)> out;
+    extract(key_list, sizeof...(Keys), out.data());
+    return out;
+}
+
 ///
 /// A const iterator over the contents of a document view.
 ///
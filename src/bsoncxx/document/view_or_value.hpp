@@ -14,14 +14,192 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
 #include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
 #include <bsoncxx/view_or_value.hpp>
 
 #include <bsoncxx/config/prelude.hpp>
 
 namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// A view-or-value variant of BSON documents that owns small documents without allocating.
+///
+/// It behaves as the primary view_or_value template, and additionally keeps an owned copy of a
+/// document of up to k_inline_capacity bytes, such as an {_id: ObjectId} filter, in a buffer
+/// inside the object. Copying an owning view_or_value of a small document, or constructing one with
+/// copy_of(), therefore never allocates.
+///
+/// Still allocating are:
+/// - copies of owned documents larger than k_inline_capacity;
+/// - the document::value it is constructed from, which is taken over rather than copied inline,
+///   but was allocated by whatever built it, such as make_document() or a builder's extract().
+///
+/// The buffer makes each view_or_value, and every options class holding some, k_inline_capacity
+/// bytes larger than the primary template, whether or not it owns its document.
+///
+template <>
+class view_or_value<document::view, document::value> {
+   public:
+    using view_type = document::view;
+    using value_type = document::value;
+
+    ///
+    /// The size of the largest document that is owned without allocating.
+    ///
+    static constexpr std::size_t k_inline_capacity = 32;
+
+    ///
+    /// Default-constructs a view_or_value. This is equivalent to constructing a
+    /// view_or_value with a default-constructed View.
+    ///
+    BSONCXX_INLINE view_or_value() = default;
+
+    ///
+    /// Construct a view_or_value from a View. When constructed with a View,
+    /// this object is non-owning. The Value underneath the given View must outlive this object.
+    ///
+    /// @param view
+    ///   A non-owning View.
+    ///
+    BSONCXX_INLINE view_or_value(document::view view) : _view{view} {}
+
+    ///
+    /// Constructs a view_or_value from a Value type. This object owns the passed-in Value.
+    ///
+    /// @param value
+    ///   A Value type.
+    ///
+    BSONCXX_INLINE view_or_value(document::value&& value)
+        : _value(std::move(value)), _view(*_value) {}
+
+    ///
+    /// Constructs a view_or_value owning a copy of a document, kept inside the object when it is
+    /// no larger than k_inline_capacity.
+    ///
+    /// @param view
+    ///   The document to copy.
+    ///
+    static BSONCXX_INLINE view_or_value copy_of(document::view view) {
+        view_or_value copy;
+        copy._own(view);
+        return copy;
+    }
+
+    ///
+    /// Construct a view_or_value from a copied view_or_value.
+    ///
+    BSONCXX_INLINE view_or_value(const view_or_value& other) : _view(other._view) {
+        if (other.is_owning()) {
+            _own(other._view);
+        }
+    }
+
+    ///
+    /// Assign to this view_or_value from a copied view_or_value.
+    ///
+    BSONCXX_INLINE view_or_value& operator=(const view_or_value& other) {
+        if (this != &other) {
+            _reset();
+            _view = other._view;
+            if (other.is_owning()) {
+                _own(other._view);
+            }
+        }
+        return *this;
+    }
+
+    ///
+    /// Construct a view_or_value from a moved-in view_or_value.
+    ///
+    BSONCXX_INLINE view_or_value(view_or_value&& other) noexcept {
+        _take(other);
+    }
+
+    ///
+    /// Assign to this view_or_value from a moved-in view_or_value.
+    ///
+    BSONCXX_INLINE view_or_value& operator=(view_or_value&& other) noexcept {
+        if (this != &other) {
+            _reset();
+            _take(other);
+        }
+        return *this;
+    }
+
+    ///
+    /// Return whether or not this view_or_value owns an underlying Value.
+    ///
+    /// @return bool Whether we are owning.
+    ///
+    BSONCXX_INLINE bool is_owning() const noexcept {
+        return static_cast<bool>(_value) || _is_inline();
+    }
+
+    ///
+    /// This type may be used as a View.
+    ///
+    /// @return a View into this view_or_value.
+    ///
+    BSONCXX_INLINE operator document::view() const {
+        return _view;
+    }
+
+    ///
+    /// Get a View for the type.
+    ///
+    /// @return a View into this view_or_value.
+    ///
+    BSONCXX_INLINE const document::view& view() const {
+        return _view;
+    }
+
+   private:
+    // Whether the viewed document is the copy in _inline.
+    BSONCXX_INLINE bool _is_inline() const noexcept {
+        return _view.data() == _inline;
+    }
+
+    // Takes a copy of `view`, which becomes the viewed document.
+    BSONCXX_INLINE void _own(document::view view) {
+        if (view.length() <= k_inline_capacity) {
+            std::memcpy(_inline, view.data(), view.length());
+            _view = document::view{_inline, view.length()};
+        } else {
+            _value = document::value{view};
+            _view = _value->view();
+        }
+    }
+
+    // Takes the document of `other`, leaving it viewing the empty document.
+    BSONCXX_INLINE void _take(view_or_value& other) noexcept {
+        if (other._is_inline()) {
+            std::memcpy(_inline, other._inline, other._view.length());
+            _view = document::view{_inline, other._view.length()};
+        } else {
+            _value = std::move(other._value);
+            _view = _value ? _value->view() : other._view;
+        }
+        other._reset();
+    }
+
+    BSONCXX_INLINE void _reset() noexcept {
+        _value = stdx::nullopt;
+        _view = document::view{};
+    }
+
+    stdx::optional<document::value> _value;
+    document::view _view;
+    std::uint8_t _inline[k_inline_capacity];
+};
+
 namespace document {
 
 using view_or_value = bsoncxx::view_or_value<document::view, document::value>;
@@ -77,6 +77,23 @@ class error_category_impl final : public std::error_category {
         return {"unable to append " #name};
 #include <bsoncxx/enums/type.hpp>
 #undef BSONCXX_ENUM
+            case error_code::k_cannot_reserve_buffer:
+                return "unable to reserve builder buffer: a subdocument or subarray is open or the "
+                       "size is too large";
+            case error_code::k_element_not_in_document:
+                return "the element is not part of the document being modified";
+            case error_code::k_no_open_document:
+                return "tried to append a value while no document was open";
+            case error_code::k_cannot_write_to_sink:
+                return "unable to write to the streaming builder's sink";
+            case error_code::k_cannot_access_file:
+                return "unable to open, map or write a BSON file";
+            case error_code::k_invalid_document_in_file:
+                return "a BSON file holds a truncated or invalid document";
+            case error_code::k_invalid_binary_slice:
+                return "a binary slice is outside of the binary value or document holding it";
+            case error_code::k_invalid_sort_specification:
+                return "a sort specification is empty or has a direction other than 1 or -1";
             default:
                 return "unknown bsoncxx error code";
         }
@@ -89,6 +89,31 @@ enum class error_code : std::int32_t {
 #define BSONCXX_ENUM(name, value) k_cannot_append_##name,
 #include <bsoncxx/enums/type.hpp>
 #undef BSONCXX_ENUM
+
+    /// The builder's buffer could not be reserved.
+    k_cannot_reserve_buffer,
+
+    /// An element passed to a document::mutable_view is not part of its document.
+    k_element_not_in_document,
+
+    /// A value was appended to a builder::streaming while no document was open.
+    k_no_open_document,
+
+    /// A builder::streaming sink failed to write.
+    k_cannot_write_to_sink,
+
+    /// A BSON file could not be opened, mapped or written.
+    k_cannot_access_file,
+
+    /// A BSON file holds a truncated or invalid document.
+    k_invalid_document_in_file,
+
+    /// A types::binary_slice was taken outside of the binary value or document holding it.
+    k_invalid_binary_slice,
+
+    /// A sort specification is empty or has a direction other than 1 or -1.
+    k_invalid_sort_specification,
+
     // Add new constant string message to error_code.cpp as well!
 };
 
@@ -0,0 +1,199 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/hash.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/private/hash.hh>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t k_oid_length = 12;
+
+// Seeds keeping the hashes of different kinds of input apart.
+constexpr std::uint64_t k_document_seed = 0x3c6ef372fe94f82bull;
+constexpr std::uint64_t k_key_seed = 0x510e527fade682d1ull;
+
+std::uint64_t hash_string(stdx::string_view str, std::uint64_t seed) {
+    return helpers::hash_bytes(str.data(), str.size(), seed);
+}
+
+std::uint64_t hash_document(document::view view, std::uint64_t seed, bool canonical);
+
+std::uint64_t hash_value(const types::value& value, bool canonical) {
+    const std::uint64_t seed = static_cast<std::uint64_t>(value.type());
+
+    switch (value.type()) {
+        case type::k_double: {
+            // 0.0 == -0.0, so both are hashed as 0.0.
+            double d = value.get_double().value;
+            if (d == 0.0) {
+                d = 0.0;
+            }
+            return helpers::hash_bytes(&d, sizeof d, seed);
+        }
+        case type::k_utf8:
+            return hash_string(value.get_utf8().value, seed);
+        case type::k_document:
+            return hash_document(value.get_document().value, seed, canonical);
+        case type::k_array: {
+            const auto array = value.get_array().value;
+            return hash_document(document::view{array.data(), array.length()}, seed, canonical);
+        }
+        case type::k_binary: {
+            const auto& binary = value.get_binary();
+            return helpers::hash_bytes(
+                binary.bytes,
+                binary.size,
+                helpers::hash_mix(seed, static_cast<std::uint64_t>(binary.sub_type)));
+        }
+        case type::k_oid:
+            return helpers::hash_bytes(value.get_oid().value.bytes(), k_oid_length, seed);
+        case type::k_bool:
+            return helpers::hash_mix(seed, value.get_bool().value ? 1 : 0);
+        case type::k_date:
+            return helpers::hash_mix(seed,
+                                     static_cast<std::uint64_t>(value.get_date().value.count()));
+        case type::k_regex:
+            return hash_string(value.get_regex().options,
+                               hash_string(value.get_regex().regex, seed));
+        case type::k_dbpointer:
+            return hash_string(
+                value.get_dbpointer().collection,
+                helpers::hash_bytes(value.get_dbpointer().value.bytes(), k_oid_length, seed));
+        case type::k_code:
+            return hash_string(value.get_code().code, seed);
+        case type::k_symbol:
+            return hash_string(value.get_symbol().symbol, seed);
+        case type::k_codewscope:
+            return hash_document(value.get_codewscope().scope,
+                                 hash_string(value.get_codewscope().code, seed),
+                                 canonical);
+        case type::k_int32:
+            return helpers::hash_mix(seed, static_cast<std::uint32_t>(value.get_int32().value));
+        case type::k_timestamp:
+            return helpers::hash_mix(
+                helpers::hash_mix(seed, value.get_timestamp().increment),
+                value.get_timestamp().timestamp);
+        case type::k_int64:
+            return helpers::hash_mix(seed, static_cast<std::uint64_t>(value.get_int64().value));
+        case type::k_decimal128:
+            return helpers::hash_mix(helpers::hash_mix(seed, value.get_decimal128().value.high()),
+                                     value.get_decimal128().value.low());
+        case type::k_undefined:
+        case type::k_null:
+        case type::k_maxkey:
+        case type::k_minkey:
+            break;
+    }
+
+    return helpers::hash_mix(seed, 0);
+}
+
+std::uint64_t hash_document(document::view view, std::uint64_t seed, bool canonical) {
+    if (!canonical) {
+        return helpers::hash_bytes(view.data(), view.length(), seed);
+    }
+
+    // Summing the hashes of the fields makes the result independent of their order.
+    std::uint64_t sum = 0;
+    std::uint64_t count = 0;
+    for (auto&& element : view) {
+        const auto key_hash = hash_string(element.key(), k_key_seed);
+        sum += helpers::hash_mix(key_hash, hash_value(element.get_value(), true));
+        ++count;
+    }
+    return helpers::hash_mix(seed ^ sum, count);
+}
+
+bool equal_documents(document::view lhs, document::view rhs);
+
+bool equal_values(const types::value& lhs, const types::value& rhs) {
+    if (lhs.type() != rhs.type()) {
+        return false;
+    }
+
+    switch (lhs.type()) {
+        case type::k_document:
+            return equal_documents(lhs.get_document().value, rhs.get_document().value);
+        case type::k_array: {
+            const auto left = lhs.get_array().value;
+            const auto right = rhs.get_array().value;
+            return equal_documents(document::view{left.data(), left.length()},
+                                   document::view{right.data(), right.length()});
+        }
+        case type::k_codewscope:
+            return lhs.get_codewscope().code == rhs.get_codewscope().code &&
+                   equal_documents(lhs.get_codewscope().scope, rhs.get_codewscope().scope);
+        default:
+            return lhs == rhs;
+    }
+}
+
+bool equal_documents(document::view lhs, document::view rhs) {
+    if (lhs == rhs) {
+        return true;
+    }
+
+    std::vector<document::element> left(lhs.begin(), lhs.end());
+    std::vector<document::element> right(rhs.begin(), rhs.end());
+    if (left.size() != right.size()) {
+        return false;
+    }
+
+    auto by_key = [](const document::element& a, const document::element& b) {
+        return a.key() < b.key();
+    };
+    std::stable_sort(left.begin(), left.end(), by_key);
+    std::stable_sort(right.begin(), right.end(), by_key);
+
+    for (std::size_t i = 0; i < left.size(); ++i) {
+        if (left[i].key() != right[i].key() ||
+            !equal_values(left[i].get_value(), right[i].get_value())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+std::uint64_t BSONCXX_CALL hash(document::view view) noexcept {
+    return helpers::hash_bytes(view.data(), view.length(), k_document_seed);
+}
+
+std::uint64_t BSONCXX_CALL hash(const types::value& value) noexcept {
+    return hash_value(value, false);
+}
+
+std::uint64_t BSONCXX_CALL canonical_hash(document::view view) noexcept {
+    return hash_document(view, k_document_seed, true);
+}
+
+bool BSONCXX_CALL canonical_equal(document::view lhs, document::view rhs) {
+    return equal_documents(lhs, rhs);
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
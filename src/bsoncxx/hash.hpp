@@ -0,0 +1,145 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types/value.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Hashes the bytes of a BSON document.
+///
+/// Documents that compare equal with operator==, that is, that have the same bytes, have the same
+/// hash. Documents of up to 256 bytes are hashed 16 bytes at a time with 128-bit multiplications,
+/// and longer documents are folded 64 bytes at a time with AVX2, SSE2 or NEON where available,
+/// so that hashing costs a fraction of converting the document to JSON.
+///
+/// @note
+///   Hashes are meant for in-memory tables. They may change between releases and differ between
+///   little- and big-endian machines, so they should not be stored.
+///
+/// @param view
+///   The document to hash.
+///
+/// @return The hash of the document.
+///
+BSONCXX_API std::uint64_t BSONCXX_CALL hash(document::view view) noexcept;
+
+///
+/// Hashes a BSON value. Values that compare equal with operator== have the same hash; in
+/// particular, 0.0 and -0.0 have the same hash. Documents and arrays are hashed by their bytes, as
+/// hash(document::view) does.
+///
+/// @param value
+///   The value to hash.
+///
+/// @return The hash of the value.
+///
+BSONCXX_API std::uint64_t BSONCXX_CALL hash(const types::value& value) noexcept;
+
+///
+/// Hashes a BSON document without regard to the order of its fields.
+///
+/// The fields of the document, and of its subdocuments, are hashed separately and combined with
+/// an order-independent sum, so {a: 1, b: 2} and {b: 2, a: 1} have the same hash. Arrays keep
+/// their order, since the key of an array element is its position. Documents for which
+/// canonical_equal() returns true have the same canonical hash.
+///
+/// @param view
+///   The document to hash.
+///
+/// @return The canonical hash of the document.
+///
+BSONCXX_API std::uint64_t BSONCXX_CALL canonical_hash(document::view view) noexcept;
+
+///
+/// Compares two BSON documents without regard to the order of their fields, at any depth.
+///
+/// @note
+///   Fields that appear more than once in a document must appear in the same relative order in
+///   both documents.
+///
+/// @return Whether the documents have the same fields with equal values.
+///
+BSONCXX_API bool BSONCXX_CALL canonical_equal(document::view lhs, document::view rhs);
+
+///
+/// A hash function object using canonical_hash(), for unordered containers of documents that
+/// should treat documents differing only in field order as duplicates. Use it together with
+/// canonical_equal_to.
+///
+struct canonical_hasher {
+    std::size_t operator()(document::view view) const noexcept {
+        return static_cast<std::size_t>(canonical_hash(view));
+    }
+};
+
+///
+/// An equality function object using canonical_equal().
+///
+struct canonical_equal_to {
+    bool operator()(document::view lhs, document::view rhs) const {
+        return canonical_equal(lhs, rhs);
+    }
+};
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+namespace std {
+
+///
+/// Hashes a document::view with bsoncxx::hash(), so that views can be keys of unordered
+/// containers.
+///
+template <>
+struct hash<bsoncxx::document::view> {
+    std::size_t operator()(bsoncxx::document::view view) const noexcept {
+        return static_cast<std::size_t>(bsoncxx::hash(view));
+    }
+};
+
+///
+/// Hashes a document::value with bsoncxx::hash().
+///
+template <>
+struct hash<bsoncxx::document::value> {
+    std::size_t operator()(const bsoncxx::document::value& value) const noexcept {
+        return static_cast<std::size_t>(bsoncxx::hash(value.view()));
+    }
+};
+
+///
+/// Hashes a types::value with bsoncxx::hash().
+///
+template <>
+struct hash<bsoncxx::types::value> {
+    std::size_t operator()(const bsoncxx::types::value& value) const noexcept {
+        return static_cast<std::size_t>(bsoncxx::hash(value));
+    }
+};
+
+}  // namespace std
+
+#include <bsoncxx/config/postlude.hpp>
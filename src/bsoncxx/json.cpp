@@ -14,16 +14,23 @@
 
 #include <bsoncxx/json.hpp>
 
+#include <algorithm>
+#include <exception>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/exception/error_code.hpp>
 #include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/builder/core.hpp>
 #include <bsoncxx/private/b64_ntop.hh>
+#include <bsoncxx/private/json_parser.hh>
+#include <bsoncxx/private/json_writer.hh>
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <bsoncxx/stdx/string_view.hpp>
@@ -41,37 +48,92 @@ void bson_free_deleter(std::uint8_t* ptr) {
     bson_free(ptr);
 }
 
-std::string to_json_helper(document::view view, decltype(bson_as_json) converter) {
-    bson_t bson;
-    bson_init_static(&bson, view.data(), view.length());
+// Below this many documents per thread, the cost of starting a thread outweighs the work it takes
+// off the calling thread. Converting a document takes longer than validating one, so this is lower
+// than the threshold of validate_many.
+constexpr std::size_t k_min_docs_per_thread = 128;
 
-    size_t size;
-    auto result = converter(&bson, &size);
+// How a batch of documents is split into contiguous chunks, one per thread.
+struct chunking {
+    std::size_t size;
+    std::size_t count;
+};
 
-    if (!result)
-        throw exception(error_code::k_failed_converting_bson_to_json);
+chunking plan_chunks(std::size_t count, std::size_t max_threads) {
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::size_t num_threads = std::max<std::size_t>(
+        1, std::min(max_threads, (count + k_min_docs_per_thread - 1) / k_min_docs_per_thread));
+    const std::size_t size = std::max<std::size_t>(1, (count + num_threads - 1) / num_threads);
+    return chunking{size, std::max<std::size_t>(1, (count + size - 1) / size)};
+}
+
+// Calls `convert(chunk, begin, end)` for each chunk of [0, count), the calling thread taking the
+// first. Once all calls have finished, rethrows the exception of the first chunk that threw one.
+template <typename Convert>
+void convert_in_chunks(const chunking& plan, std::size_t count, Convert&& convert) {
+    if (plan.count == 1) {
+        convert(std::size_t{0}, std::size_t{0}, count);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(plan.count);
+    const auto convert_chunk = [&](std::size_t index) {
+        try {
+            convert(index, index * plan.size, std::min((index + 1) * plan.size, count));
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(plan.count - 1);
+
+    for (std::size_t index = 1; index < plan.count; ++index) {
+        try {
+            workers.emplace_back(convert_chunk, index);
+        } catch (const std::system_error&) {
+            // Out of threads: do this chunk here instead.
+            convert_chunk(index);
+        }
+    }
+
+    convert_chunk(0);
 
-    const auto deleter = [](char* result) { bson_free(result); };
-    const std::unique_ptr<char[], decltype(deleter)> cleanup(result, deleter);
+    for (auto&& worker : workers) {
+        worker.join();
+    }
 
-    return {result, size};
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 }
 
 }  // namespace
 
 std::string BSONCXX_CALL to_json(document::view view, ExtendedJsonMode mode) {
-    switch (mode) {
-        case ExtendedJsonMode::k_legacy:
-            return to_json_helper(view, bson_as_json);
-
-        case ExtendedJsonMode::k_relaxed:
-            return to_json_helper(view, bson_as_relaxed_extended_json);
+    std::string out;
+    helpers::write_json(view, mode, &out);
+    return out;
+}
 
-        case ExtendedJsonMode::k_canonical:
-            return to_json_helper(view, bson_as_canonical_extended_json);
+void BSONCXX_CALL to_json(document::view view, std::string& out, ExtendedJsonMode mode) {
+    const auto size = out.size();
+    try {
+        helpers::write_json(view, mode, &out);
+    } catch (...) {
+        out.resize(size);
+        throw;
     }
+}
 
-    BSONCXX_UNREACHABLE;
+void BSONCXX_CALL to_json(document::view view, std::ostream& out, ExtendedJsonMode mode) {
+    const auto json = to_json(view, mode);
+    out.write(json.data(), static_cast<std::streamsize>(json.size()));
 }
 
 document::value BSONCXX_CALL from_json(stdx::string_view json) {
@@ -89,5 +151,72 @@ document::value BSONCXX_CALL from_json(stdx::string_view json) {
     return document::value{buf, length, bson_free_deleter};
 }
 
+document::value BSONCXX_CALL from_json(stdx::string_view json, JsonParser parser) {
+    if (parser == JsonParser::k_libbson) {
+        return from_json(json);
+    }
+
+    builder::core core{false};
+    helpers::parse_json(json, &core);
+    return core.extract_document();
+}
+
+std::string BSONCXX_CALL to_json_batch(const document::view* views,
+                                       std::size_t count,
+                                       ExtendedJsonMode mode,
+                                       std::size_t max_threads) {
+    // Each chunk is written to its own string, which are joined once all are done.
+    const auto plan = plan_chunks(count, max_threads);
+    std::vector<std::string> chunks(plan.count);
+    convert_in_chunks(plan, count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto& out = chunks[chunk];
+        for (std::size_t i = begin; i < end; ++i) {
+            if (i != begin) {
+                out.push_back('\n');
+            }
+            helpers::write_json(views[i], mode, &out);
+        }
+    });
+
+    std::size_t length = plan.count - 1;
+    for (std::size_t i = 0; i < plan.count; ++i) {
+        length += chunks[i].size();
+    }
+
+    std::string out = std::move(chunks[0]);
+    out.reserve(length);
+    for (std::size_t i = 1; i < plan.count; ++i) {
+        out.push_back('\n');
+        out.append(chunks[i]);
+    }
+    return out;
+}
+
+std::vector<document::value> BSONCXX_CALL from_json_batch(const stdx::string_view* json,
+                                                          std::size_t count,
+                                                          JsonParser parser,
+                                                          std::size_t max_threads) {
+    const auto plan = plan_chunks(count, max_threads);
+    std::vector<std::vector<document::value>> chunks(plan.count);
+    convert_in_chunks(plan, count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto& out = chunks[chunk];
+        out.reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i) {
+            out.push_back(from_json(json[i], parser));
+        }
+    });
+
+    if (plan.count == 1) {
+        return std::move(chunks[0]);
+    }
+
+    std::vector<document::value> out;
+    out.reserve(count);
+    for (std::size_t i = 0; i < plan.count; ++i) {
+        std::move(chunks[i].begin(), chunks[i].end(), std::back_inserter(out));
+    }
+    return out;
+}
+
 BSONCXX_INLINE_NAMESPACE_END
 }  // namespace bsoncxx
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <string>
+#include <vector>
 
 #include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
@@ -56,6 +58,41 @@ enum class ExtendedJsonMode : std::uint8_t {
 BSONCXX_API std::string BSONCXX_CALL to_json(document::view view,
                                              ExtendedJsonMode mode = ExtendedJsonMode::k_legacy);
 
+///
+/// Converts a BSON document to a JSON string, in extended format, and appends it to an existing
+/// string. Reusing the same string across documents avoids allocating a new one for each.
+///
+/// @param view
+///   A valid BSON document.
+/// @param out
+///   The string to append the JSON text to.
+/// @param mode
+///   An optional JSON representation mode.
+///
+/// @throws bsoncxx::exception with error details if the conversion failed. `out` is left
+///   unmodified in that case.
+///
+BSONCXX_API void BSONCXX_CALL to_json(document::view view,
+                                      std::string& out,
+                                      ExtendedJsonMode mode = ExtendedJsonMode::k_legacy);
+
+///
+/// Converts a BSON document to a JSON string, in extended format, and writes it to a stream.
+///
+/// @param view
+///   A valid BSON document.
+/// @param out
+///   The stream to write the JSON text to.
+/// @param mode
+///   An optional JSON representation mode.
+///
+/// @throws bsoncxx::exception with error details if the conversion failed. Nothing is written to
+///   `out` in that case.
+///
+BSONCXX_API void BSONCXX_CALL to_json(document::view view,
+                                      std::ostream& out,
+                                      ExtendedJsonMode mode = ExtendedJsonMode::k_legacy);
+
 ///
 /// Constructs a new document::value from the provided JSON text
 ///
@@ -68,6 +105,107 @@ BSONCXX_API std::string BSONCXX_CALL to_json(document::view view,
 ///
 BSONCXX_API document::value BSONCXX_CALL from_json(stdx::string_view json);
 
+///
+/// An enumeration of the JSON parsers that from_json can use.
+///
+enum class JsonParser : std::uint8_t {
+    k_libbson,     ///< libbson's parser, which from_json uses when none is given
+    k_structural,  ///< a parser that indexes the structural characters of the text with SIMD
+};
+
+///
+/// Constructs a new document::value from the provided JSON text, with the given parser.
+///
+/// The structural parser accepts the same Extended JSON wrappers (canonical, relaxed and legacy)
+/// as libbson's, and requires the text to be a single JSON object. It is faster on large
+/// documents, but its error messages differ from libbson's.
+///
+/// @param json
+///   A string_view into a JSON document
+/// @param parser
+///   The parser to use.
+///
+/// @returns A document::value if conversion worked.
+///
+/// @throws bsoncxx::exception with error details if the conversion failed.
+///
+BSONCXX_API document::value BSONCXX_CALL from_json(stdx::string_view json, JsonParser parser);
+
+///
+/// Converts a batch of BSON documents to JSON, spreading the work across multiple threads. Each
+/// document is converted exactly as to_json() would convert it.
+///
+/// @param views
+///   The documents to convert.
+/// @param count
+///   The number of documents in `views`.
+/// @param mode
+///   An optional JSON representation mode.
+/// @param max_threads
+///   The maximum number of threads to use, including the calling thread. If 0, up to
+///   std::thread::hardware_concurrency() threads are used. Small batches are converted on fewer
+///   threads, or on the calling thread alone.
+///
+/// @throws bsoncxx::exception if converting any of the documents failed.
+///
+/// @returns The JSON text of the documents in the same order as `views`, separated by newlines.
+///
+BSONCXX_API std::string BSONCXX_CALL
+to_json_batch(const document::view* views,
+              std::size_t count,
+              ExtendedJsonMode mode = ExtendedJsonMode::k_legacy,
+              std::size_t max_threads = 0);
+
+///
+/// Converts a batch of BSON documents to JSON, spreading the work across multiple threads.
+///
+/// @see to_json_batch(const document::view*, std::size_t, ExtendedJsonMode, std::size_t)
+///
+BSONCXX_INLINE std::string to_json_batch(const std::vector<document::view>& views,
+                                         ExtendedJsonMode mode = ExtendedJsonMode::k_legacy,
+                                         std::size_t max_threads = 0) {
+    return to_json_batch(views.data(), views.size(), mode, max_threads);
+}
+
+///
+/// Constructs a batch of document::values from JSON texts, spreading the work across multiple
+/// threads. Each text is converted exactly as from_json() would convert it.
+///
+/// @param json
+///   The JSON texts to convert.
+/// @param count
+///   The number of texts in `json`.
+/// @param parser
+///   The parser to use.
+/// @param max_threads
+///   The maximum number of threads to use, including the calling thread. If 0, up to
+///   std::thread::hardware_concurrency() threads are used. Small batches are converted on fewer
+///   threads, or on the calling thread alone.
+///
+/// @throws bsoncxx::exception with the error details of the first text, in order, that failed to
+///   convert.
+///
+/// @returns One document per text, in the same order as `json`.
+///
+BSONCXX_API std::vector<document::value> BSONCXX_CALL
+from_json_batch(const stdx::string_view* json,
+                std::size_t count,
+                JsonParser parser = JsonParser::k_libbson,
+                std::size_t max_threads = 0);
+
+///
+/// Constructs a batch of document::values from JSON texts, spreading the work across multiple
+/// threads.
+///
+/// @see from_json_batch(const stdx::string_view*, std::size_t, JsonParser, std::size_t)
+///
+BSONCXX_INLINE std::vector<document::value> from_json_batch(
+    const std::vector<stdx::string_view>& json,
+    JsonParser parser = JsonParser::k_libbson,
+    std::size_t max_threads = 0) {
+    return from_json_batch(json.data(), json.size(), parser, max_threads);
+}
+
 BSONCXX_INLINE_NAMESPACE_END
 }  // namespace bsoncxx
 
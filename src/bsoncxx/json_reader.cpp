@@ -0,0 +1,100 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/json_reader.hpp>
+
+#include <exception>
+#include <istream>
+
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/stdx/make_unique.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+struct json_reader::impl {
+    impl(source_type source, std::size_t buffer_size)
+        : _source{std::move(source)},
+          _reader{bson_json_reader_new(this, &impl::read_cb, nullptr, true, buffer_size)} {
+        bson_init(&_bson);
+    }
+
+    ~impl() {
+        bson_json_reader_destroy(_reader);
+        bson_destroy(&_bson);
+    }
+
+    static ssize_t read_cb(void* handle, std::uint8_t* buf, std::size_t count) {
+        auto self = static_cast<impl*>(handle);
+
+        try {
+            return static_cast<ssize_t>(self->_source(buf, count));
+        } catch (...) {
+            self->_source_error = std::current_exception();
+            return -1;
+        }
+    }
+
+    source_type _source;
+    std::exception_ptr _source_error;
+    bson_json_reader_t* _reader;
+
+    // Reinitialized before every read so that, once grown, its buffer is reused for each document.
+    bson_t _bson;
+};
+
+json_reader::json_reader(std::istream& input, std::size_t buffer_size)
+    : json_reader{[&input](std::uint8_t* buf, std::size_t count) -> std::size_t {
+                      input.read(reinterpret_cast<char*>(buf),
+                                 static_cast<std::streamsize>(count));
+                      return static_cast<std::size_t>(input.gcount());
+                  },
+                  buffer_size} {}
+
+json_reader::json_reader(source_type source, std::size_t buffer_size)
+    : _impl{stdx::make_unique<impl>(std::move(source), buffer_size)} {}
+
+json_reader::json_reader(json_reader&&) noexcept = default;
+json_reader& json_reader::operator=(json_reader&&) noexcept = default;
+json_reader::~json_reader() = default;
+
+stdx::optional<document::view> json_reader::read() {
+    bson_reinit(&_impl->_bson);
+
+    bson_error_t error;
+    const int result = bson_json_reader_read(_impl->_reader, &_impl->_bson, &error);
+
+    if (_impl->_source_error) {
+        std::exception_ptr source_error;
+        std::swap(source_error, _impl->_source_error);
+        std::rethrow_exception(source_error);
+    }
+
+    if (result < 0) {
+        throw exception(error_code::k_json_parse_failure, error.message);
+    }
+
+    if (result == 0) {
+        return stdx::nullopt;
+    }
+
+    return document::view{bson_get_data(&_impl->_bson), _impl->_bson.len};
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,106 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Incrementally parses a stream of JSON documents into BSON.
+///
+/// The input may hold any number of top-level JSON documents separated by whitespace, such as
+/// line-delimited JSON. Input is pulled in fixed-size chunks and every document is decoded into a
+/// single buffer owned by the reader, so parsing a large file does not allocate once per document.
+///
+class BSONCXX_API json_reader {
+   public:
+    ///
+    /// A callback that supplies the next chunk of JSON text.
+    ///
+    /// It is passed a buffer and the buffer's capacity, and must return the number of bytes it
+    /// wrote; returning zero signals the end of the input. Exceptions thrown by the callback are
+    /// rethrown from read().
+    ///
+    using source_type = std::function<std::size_t(std::uint8_t* buffer, std::size_t capacity)>;
+
+    ///
+    /// Constructs a json_reader that reads from a stream.
+    ///
+    /// @param input
+    ///   The stream to read JSON text from. It must outlive the json_reader.
+    /// @param buffer_size
+    ///   The size of the chunks read from the input, or 0 to use the libbson default.
+    ///
+    explicit json_reader(std::istream& input, std::size_t buffer_size = 0);
+
+    ///
+    /// Constructs a json_reader that pulls JSON text from a callback.
+    ///
+    /// @param source
+    ///   The callback supplying the input.
+    /// @param buffer_size
+    ///   The size of the chunks requested from the callback, or 0 to use the libbson default.
+    ///
+    explicit json_reader(source_type source, std::size_t buffer_size = 0);
+
+    ///
+    /// Move constructs a json_reader.
+    ///
+    json_reader(json_reader&&) noexcept;
+
+    ///
+    /// Move assigns a json_reader.
+    ///
+    json_reader& operator=(json_reader&&) noexcept;
+
+    ///
+    /// Destroys a json_reader.
+    ///
+    ~json_reader();
+
+    ///
+    /// Parses the next document from the input.
+    ///
+    /// @return
+    ///   A view of the parsed document, or an unengaged optional once the input is exhausted. The
+    ///   view points into a buffer owned by the reader and is invalidated by the next call to
+    ///   read() or by destruction of the reader; copy it into a document::value to keep it.
+    ///
+    /// @throws bsoncxx::exception with error details if the input is not valid JSON. Any
+    ///   exception raised while reading the input is propagated. The reader must not be used
+    ///   after read() has thrown.
+    ///
+    stdx::optional<document::view> read();
+
+   private:
+    struct BSONCXX_PRIVATE impl;
+    std::unique_ptr<impl> _impl;
+};
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
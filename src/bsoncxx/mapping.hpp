@@ -0,0 +1,434 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/array/element.hpp>
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+///
+/// @file
+/// Generated mappings between C++ structs and BSON documents.
+///
+/// BSONCXX_DEFINE_STRUCT(T, field1, field2, ...) defines an encoder and a decoder for the public
+/// data members of a struct, which bsoncxx::mapping::to_document() and
+/// bsoncxx::mapping::from_document() then use:
+///
+/// @code
+/// namespace shop {
+/// struct item {
+///     std::string name;
+///     std::int32_t quantity;
+///     bsoncxx::stdx::optional<double> price;
+///     std::vector<std::string> tags;
+/// };
+/// BSONCXX_DEFINE_STRUCT(item, name, quantity, price, tags)
+/// }  // namespace shop
+///
+/// auto doc = bsoncxx::mapping::to_document(some_item);
+/// auto copy = bsoncxx::mapping::from_document<shop::item>(doc.view());
+/// @endcode
+///
+/// The macro must be used in the namespace of the struct, at most once per struct, with up to
+/// 32 members. Each member is stored under its own name, and may be a bool, std::int32_t,
+/// std::int64_t, double, std::string, bsoncxx::oid, bsoncxx::types::b_date,
+/// bsoncxx::document::value, another struct with a mapping, or a stdx::optional or std::vector
+/// of any of these. Empty optionals are left out of the encoded document.
+///
+/// The encoder appends each member under a key whose length is known at compile time. The
+/// decoder walks the elements of a document once. It matches each key against the member that
+/// follows the last one matched, which is right for documents encoded by the mapping, and only
+/// compares the key with every member if that fails. The comparisons check lengths before
+/// bytes. Members whose keys are missing from the document are left as they were. Unknown keys
+/// are ignored. A value of the wrong type throws the bsoncxx::exception of the element accessor,
+/// e.g. k_need_element_type_k_int32.
+///
+
+#define BSONCXX_DEFINE_STRUCT(type, ...)                                                         \
+    inline void bsoncxx_encode(::bsoncxx::builder::core& core, const type& value) {             \
+        BSONCXX_MAPPING_FOR_EACH(BSONCXX_MAPPING_ENCODE_MEMBER, __VA_ARGS__)                     \
+    }                                                                                            \
+                                                                                                 \
+    inline void bsoncxx_decode(::bsoncxx::document::view view, type& value) {                   \
+        static const ::bsoncxx::mapping::impl::key keys[] = {                                    \
+            BSONCXX_MAPPING_FOR_EACH(BSONCXX_MAPPING_KEY, __VA_ARGS__)};                         \
+        std::size_t expected = 0;                                                                \
+        for (auto&& element : view) {                                                            \
+            switch (::bsoncxx::mapping::impl::match(                                             \
+                keys, sizeof(keys) / sizeof(keys[0]), element.key(), &expected)) {               \
+                BSONCXX_MAPPING_FOR_EACH(BSONCXX_MAPPING_DECODE_MEMBER, __VA_ARGS__)             \
+                default:                                                                         \
+                    break;                                                                       \
+            }                                                                                    \
+        }                                                                                        \
+    }
+
+//
+// The expansions of BSONCXX_DEFINE_STRUCT for one member, with `index` its position.
+//
+#define BSONCXX_MAPPING_KEY(index, member) {#member, sizeof(#member) - 1},
+
+#define BSONCXX_MAPPING_ENCODE_MEMBER(index, member) \
+    ::bsoncxx::mapping::impl::encode_member(         \
+        core, ::bsoncxx::stdx::string_view{#member, sizeof(#member) - 1}, value.member);
+
+#define BSONCXX_MAPPING_DECODE_MEMBER(index, member)                   \
+    case index:                                                        \
+        ::bsoncxx::mapping::impl::decode_value(element, value.member); \
+        break;
+
+//
+// BSONCXX_MAPPING_FOR_EACH(m, a, b, ...) expands to m(0, a) m(1, b) ... The extra expansions
+// work around the way MSVC forwards __VA_ARGS__.
+//
+#define BSONCXX_MAPPING_EXPAND(x) x
+#define BSONCXX_MAPPING_CAT(a, b) BSONCXX_MAPPING_CAT_(a, b)
+#define BSONCXX_MAPPING_CAT_(a, b) a##b
+
+#define BSONCXX_MAPPING_COUNT(...)                                                        \
+    BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_COUNT_(__VA_ARGS__,                            \
+                                                  32, 31, 30, 29, 28, 27, 26, 25, 24, 23, \
+                                                  22, 21, 20, 19, 18, 17, 16, 15, 14, 13, \
+                                                  12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define BSONCXX_MAPPING_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, \
+                               _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, \
+                               _27, _28, _29, _30, _31, _32, n, ...)                       \
+    n
+
+#define BSONCXX_MAPPING_FOR_EACH(m, ...)                                                \
+    BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_CAT(BSONCXX_MAPPING_FOR_EACH_,               \
+                                               BSONCXX_MAPPING_COUNT(__VA_ARGS__))(     \
+        m, BSONCXX_MAPPING_COUNT(__VA_ARGS__), __VA_ARGS__))
+
+#define BSONCXX_MAPPING_FOR_EACH_1(m, k, a) m(k - 1, a)
+#define BSONCXX_MAPPING_FOR_EACH_2(m, k, a, ...) \
+    m(k - 2, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_1(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_3(m, k, a, ...) \
+    m(k - 3, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_2(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_4(m, k, a, ...) \
+    m(k - 4, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_3(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_5(m, k, a, ...) \
+    m(k - 5, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_4(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_6(m, k, a, ...) \
+    m(k - 6, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_5(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_7(m, k, a, ...) \
+    m(k - 7, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_6(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_8(m, k, a, ...) \
+    m(k - 8, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_7(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_9(m, k, a, ...) \
+    m(k - 9, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_8(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_10(m, k, a, ...) \
+    m(k - 10, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_9(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_11(m, k, a, ...) \
+    m(k - 11, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_10(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_12(m, k, a, ...) \
+    m(k - 12, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_11(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_13(m, k, a, ...) \
+    m(k - 13, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_12(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_14(m, k, a, ...) \
+    m(k - 14, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_13(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_15(m, k, a, ...) \
+    m(k - 15, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_14(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_16(m, k, a, ...) \
+    m(k - 16, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_15(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_17(m, k, a, ...) \
+    m(k - 17, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_16(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_18(m, k, a, ...) \
+    m(k - 18, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_17(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_19(m, k, a, ...) \
+    m(k - 19, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_18(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_20(m, k, a, ...) \
+    m(k - 20, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_19(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_21(m, k, a, ...) \
+    m(k - 21, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_20(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_22(m, k, a, ...) \
+    m(k - 22, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_21(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_23(m, k, a, ...) \
+    m(k - 23, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_22(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_24(m, k, a, ...) \
+    m(k - 24, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_23(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_25(m, k, a, ...) \
+    m(k - 25, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_24(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_26(m, k, a, ...) \
+    m(k - 26, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_25(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_27(m, k, a, ...) \
+    m(k - 27, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_26(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_28(m, k, a, ...) \
+    m(k - 28, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_27(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_29(m, k, a, ...) \
+    m(k - 29, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_28(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_30(m, k, a, ...) \
+    m(k - 30, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_29(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_31(m, k, a, ...) \
+    m(k - 31, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_30(m, k, __VA_ARGS__))
+#define BSONCXX_MAPPING_FOR_EACH_32(m, k, a, ...) \
+    m(k - 32, a) BSONCXX_MAPPING_EXPAND(BSONCXX_MAPPING_FOR_EACH_31(m, k, __VA_ARGS__))
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace mapping {
+namespace impl {
+
+struct key {
+    const char* data;
+    std::size_t length;
+};
+
+// Returns the index of the key equal to `name`, or `count` if there is none. `*expected` is the
+// index tried first, and is left just past the key that matched.
+inline std::size_t match(const key* keys,
+                         std::size_t count,
+                         stdx::string_view name,
+                         std::size_t* expected) {
+    const auto matches = [&](std::size_t i) {
+        return keys[i].length == name.size() &&
+               std::memcmp(keys[i].data, name.data(), name.size()) == 0;
+    };
+
+    if (*expected < count && matches(*expected)) {
+        return (*expected)++;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        if (matches(i)) {
+            *expected = i + 1;
+            return i;
+        }
+    }
+    return count;
+}
+
+inline void encode_value(builder::core& core, bool value) {
+    core.append(value);
+}
+
+inline void encode_value(builder::core& core, std::int32_t value) {
+    core.append(value);
+}
+
+inline void encode_value(builder::core& core, std::int64_t value) {
+    core.append(value);
+}
+
+inline void encode_value(builder::core& core, double value) {
+    core.append(value);
+}
+
+inline void encode_value(builder::core& core, const std::string& value) {
+    core.append(types::b_utf8{value});
+}
+
+inline void encode_value(builder::core& core, const oid& value) {
+    core.append(value);
+}
+
+inline void encode_value(builder::core& core, const types::b_date& value) {
+    core.append(value);
+}
+
+inline void encode_value(builder::core& core, const document::value& value) {
+    core.append(value.view());
+}
+
+template <typename T>
+void encode_value(builder::core& core, const std::vector<T>& values);
+
+template <typename T>
+void encode_value(builder::core& core, const T& value);
+
+template <typename T>
+void encode_member(builder::core& core, stdx::string_view key, const T& value) {
+    core.key_view(key);
+    encode_value(core, value);
+}
+
+template <typename T>
+void encode_member(builder::core& core, stdx::string_view key, const stdx::optional<T>& value) {
+    if (value) {
+        core.key_view(key);
+        encode_value(core, *value);
+    }
+}
+
+template <typename T>
+void encode_value(builder::core& core, const std::vector<T>& values) {
+    core.open_array();
+    for (auto&& value : values) {
+        encode_value(core, value);
+    }
+    core.close_array();
+}
+
+// Structs with a mapping, found through argument-dependent lookup.
+template <typename T>
+void encode_value(builder::core& core, const T& value) {
+    core.open_document();
+    bsoncxx_encode(core, value);
+    core.close_document();
+}
+
+template <typename Element>
+void decode_value(const Element& element, bool& out) {
+    out = element.get_bool().value;
+}
+
+template <typename Element>
+void decode_value(const Element& element, std::int32_t& out) {
+    out = element.get_int32().value;
+}
+
+// Narrower integers are widened when decoded.
+template <typename Element>
+void decode_value(const Element& element, std::int64_t& out) {
+    if (element.type() == type::k_int32) {
+        out = element.get_int32().value;
+    } else {
+        out = element.get_int64().value;
+    }
+}
+
+template <typename Element>
+void decode_value(const Element& element, double& out) {
+    if (element.type() == type::k_int32) {
+        out = element.get_int32().value;
+    } else if (element.type() == type::k_int64) {
+        out = static_cast<double>(element.get_int64().value);
+    } else {
+        out = element.get_double().value;
+    }
+}
+
+template <typename Element>
+void decode_value(const Element& element, std::string& out) {
+    const auto value = element.get_utf8().value;
+    out.assign(value.data(), value.size());
+}
+
+template <typename Element>
+void decode_value(const Element& element, oid& out) {
+    out = element.get_oid().value;
+}
+
+template <typename Element>
+void decode_value(const Element& element, types::b_date& out) {
+    out = element.get_date();
+}
+
+template <typename Element>
+void decode_value(const Element& element, document::value& out) {
+    out = document::value{element.get_document().value};
+}
+
+template <typename Element, typename T>
+void decode_value(const Element& element, stdx::optional<T>& out);
+
+template <typename Element, typename T>
+void decode_value(const Element& element, std::vector<T>& out);
+
+template <typename Element, typename T>
+void decode_value(const Element& element, T& out);
+
+// Nulls decode as empty optionals.
+template <typename Element, typename T>
+void decode_value(const Element& element, stdx::optional<T>& out) {
+    if (element.type() == type::k_null) {
+        out = stdx::nullopt;
+        return;
+    }
+    T value{};
+    decode_value(element, value);
+    out = std::move(value);
+}
+
+template <typename Element, typename T>
+void decode_value(const Element& element, std::vector<T>& out) {
+    out.clear();
+    for (auto&& item : element.get_array().value) {
+        T value{};
+        decode_value(item, value);
+        out.push_back(std::move(value));
+    }
+}
+
+// Structs with a mapping, found through argument-dependent lookup.
+template <typename Element, typename T>
+void decode_value(const Element& element, T& out) {
+    bsoncxx_decode(element.get_document().value, out);
+}
+
+}  // namespace impl
+
+///
+/// Encodes a struct with a mapping defined by BSONCXX_DEFINE_STRUCT into a new document.
+///
+template <typename T>
+document::value to_document(const T& value) {
+    builder::core core{false};
+    bsoncxx_encode(core, value);
+    return core.extract_document();
+}
+
+///
+/// Encodes a struct with a mapping defined by BSONCXX_DEFINE_STRUCT into the open document of a
+/// builder, as its next elements.
+///
+template <typename T>
+void to_document(const T& value, builder::core& core) {
+    bsoncxx_encode(core, value);
+}
+
+///
+/// Decodes a document into a struct with a mapping defined by BSONCXX_DEFINE_STRUCT. Members
+/// whose keys are missing from the document keep their values.
+///
+/// @throws bsoncxx::exception if an element has a type its member cannot hold.
+///
+template <typename T>
+void from_document(document::view view, T& out) {
+    bsoncxx_decode(view, out);
+}
+
+///
+/// Decodes a document into a value-initialized struct with a mapping defined by
+/// BSONCXX_DEFINE_STRUCT.
+///
+/// @throws bsoncxx::exception if an element has a type its member cannot hold.
+///
+template <typename T>
+T from_document(document::view view) {
+    T out{};
+    bsoncxx_decode(view, out);
+    return out;
+}
+
+}  // namespace mapping
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -14,8 +14,14 @@
 
 #include <bsoncxx/oid.hpp>
 
+#include <cstdint>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BSONCXX_OID_SSE2
+#include <emmintrin.h>
+#endif
+
 #include <bsoncxx/exception/error_code.hpp>
 #include <bsoncxx/exception/exception.hpp>
 #include <bsoncxx/private/libbson.hh>
@@ -25,6 +31,117 @@
 namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
 
+namespace {
+
+constexpr std::size_t k_oid_length = 12;
+constexpr std::size_t k_oid_hex_length = 2 * k_oid_length;
+
+#if defined(BSONCXX_OID_SSE2)
+
+// Encodes the 12 bytes as 24 hex digits, 16 nibbles per register.
+void hex_encode(const char* bytes, char* out) {
+    alignas(16) std::uint8_t in[16] = {};
+    std::memcpy(in, bytes, k_oid_length);
+
+    const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(in));
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble);
+    const __m128i lo = _mm_and_si128(v, low_nibble);
+
+    auto to_hex = [](__m128i nibbles) {
+        // '0' + n for digits, and 'a' - 10 + n, which is 39 more, for letters.
+        const __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+                            _mm_and_si128(letters, _mm_set1_epi8(39)));
+    };
+
+    alignas(16) char hex[32];
+    _mm_store_si128(reinterpret_cast<__m128i*>(hex), to_hex(_mm_unpacklo_epi8(hi, lo)));
+    _mm_store_si128(reinterpret_cast<__m128i*>(hex + 16), to_hex(_mm_unpackhi_epi8(hi, lo)));
+    std::memcpy(out, hex, k_oid_hex_length);
+}
+
+// Decodes 24 hex digits of either case into 12 bytes, returning false for any other character.
+bool hex_decode(const char* str, char* bytes) {
+    alignas(16) char in[32];
+    std::memset(in, '0', sizeof(in));
+    std::memcpy(in, str, k_oid_hex_length);
+
+    auto decode = [](__m128i chars, __m128i* nibbles) {
+        // Signed comparisons reject bytes above 0x7F, which compare less than '0' and 'a'.
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                            _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+        const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+        const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                             _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+        *nibbles = _mm_or_si128(
+            _mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+            _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+        return _mm_movemask_epi8(_mm_or_si128(digit, letter));
+    };
+
+    __m128i first;
+    __m128i second;
+    if (decode(_mm_load_si128(reinterpret_cast<const __m128i*>(in)), &first) != 0xFFFF ||
+        decode(_mm_load_si128(reinterpret_cast<const __m128i*>(in + 16)), &second) != 0xFFFF) {
+        return false;
+    }
+
+    // Each 16-bit lane holds a high nibble in its low byte and a low nibble in its high byte.
+    auto combine = [](__m128i nibbles) {
+        return _mm_and_si128(_mm_or_si128(_mm_slli_epi16(nibbles, 4), _mm_srli_epi16(nibbles, 8)),
+                             _mm_set1_epi16(0x00FF));
+    };
+
+    alignas(16) char out[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(out),
+                    _mm_packus_epi16(combine(first), combine(second)));
+    std::memcpy(bytes, out, k_oid_length);
+    return true;
+}
+
+#else
+
+const char k_hex_digits[] = "0123456789abcdef";
+
+void hex_encode(const char* bytes, char* out) {
+    for (std::size_t i = 0; i < k_oid_length; ++i) {
+        const auto byte = static_cast<std::uint8_t>(bytes[i]);
+        out[2 * i] = k_hex_digits[byte >> 4];
+        out[2 * i + 1] = k_hex_digits[byte & 0x0F];
+    }
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool hex_decode(const char* str, char* bytes) {
+    for (std::size_t i = 0; i < k_oid_length; ++i) {
+        const int hi = hex_value(str[2 * i]);
+        const int lo = hex_value(str[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        bytes[i] = static_cast<char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+#endif
+
+}  // namespace
+
 oid::oid() {
     bson_oid_t oid;
     bson_oid_init(&oid, nullptr);
@@ -33,12 +150,9 @@ oid::oid() {
 }
 
 oid::oid(const bsoncxx::stdx::string_view& str) {
-    if (!bson_oid_is_valid(str.data(), str.size())) {
+    if (str.size() != k_oid_hex_length || !hex_decode(str.data(), _bytes.data())) {
         throw bsoncxx::exception{error_code::k_invalid_oid};
     }
-    bson_oid_t oid;
-    bson_oid_init_from_string(&oid, str.data());
-    memcpy(_bytes.data(), oid.bytes, _bytes.size());
 }
 
 oid::oid(const char* bytes, std::size_t len) {
@@ -49,13 +163,14 @@ oid::oid(const char* bytes, std::size_t len) {
 }
 
 std::string oid::to_string() const {
-    bson_oid_t oid;
-    std::memcpy(oid.bytes, _bytes.data(), sizeof(oid.bytes));
-    char str[25];
+    char str[k_oid_hex_length];
+    to_chars(str);
 
-    bson_oid_to_string(&oid, str);
+    return std::string(str, sizeof(str));
+}
 
-    return std::string(str);
+void oid::to_chars(char (&out)[24]) const noexcept {
+    hex_encode(_bytes.data(), out);
 }
 
 std::time_t oid::get_time_t() const {
@@ -72,6 +72,15 @@ class BSONCXX_API oid {
     ///
     std::string to_string() const;
 
+    ///
+    /// Writes the hexadecimal representation of this oid into a caller-provided buffer, without
+    /// allocating.
+    ///
+    /// @param out
+    ///   The buffer to receive the 24 lowercase hexadecimal digits. No null terminator is written.
+    ///
+    void to_chars(char (&out)[24]) const noexcept;
+
     ///
     /// @{
     ///
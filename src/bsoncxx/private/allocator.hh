@@ -0,0 +1,51 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bsoncxx/allocator.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Buffers obtained through these functions are prefixed with a small header recording the
+// allocator and the size of the block, so that they can be released through a plain function
+// pointer (e.g. document::value::deleter_type) and resized through libbson's realloc hook, neither
+// of which carries the block size or any user context of its own.
+
+// Returns a buffer of at least `size` usable bytes carved from `alloc`. Throws whatever
+// alloc.allocate() throws.
+std::uint8_t* allocate_with(allocator& alloc, std::size_t size);
+
+// Releases a buffer returned by allocate_with() (or allocator_realloc()) to its allocator. Null is
+// ignored. Suitable for use as a document::value or array::value deleter.
+void allocator_deleter(std::uint8_t* ptr);
+
+// A bson_realloc_func that routes libbson buffer growth through the allocator passed as `ctx`.
+// Aborts if the allocator fails, matching libbson's handling of malloc failure.
+void* allocator_realloc(void* mem, std::size_t num_bytes, void* ctx);
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
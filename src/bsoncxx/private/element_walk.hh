@@ -0,0 +1,170 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Reads a little-endian int32 at p. The caller guarantees four readable bytes.
+inline std::int32_t read_int32_le(const std::uint8_t* p) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(p[0]) |
+                                     (static_cast<std::uint32_t>(p[1]) << 8) |
+                                     (static_cast<std::uint32_t>(p[2]) << 16) |
+                                     (static_cast<std::uint32_t>(p[3]) << 24));
+}
+
+// Computes the size of the value of an element of type `t` whose value starts at `value`, with
+// `remaining` readable bytes. Returns false if the value would overrun the buffer.
+inline bool element_value_size(bsoncxx::type t,
+                               const std::uint8_t* value,
+                               std::size_t remaining,
+                               std::size_t* size) {
+    switch (t) {
+        case type::k_undefined:
+        case type::k_null:
+        case type::k_minkey:
+        case type::k_maxkey:
+            *size = 0;
+            break;
+        case type::k_bool:
+            *size = 1;
+            break;
+        case type::k_int32:
+            *size = 4;
+            break;
+        case type::k_double:
+        case type::k_date:
+        case type::k_timestamp:
+        case type::k_int64:
+            *size = 8;
+            break;
+        case type::k_oid:
+            *size = 12;
+            break;
+        case type::k_decimal128:
+            *size = 16;
+            break;
+        case type::k_utf8:
+        case type::k_code:
+        case type::k_symbol:
+        case type::k_binary:
+        case type::k_dbpointer: {
+            if (remaining < 4) {
+                return false;
+            }
+            std::int32_t len = read_int32_le(value);
+            if (len < 0) {
+                return false;
+            }
+            *size = 4 + static_cast<std::size_t>(len);
+            if (t == type::k_binary) {
+                *size += 1;  // subtype
+            } else if (t == type::k_dbpointer) {
+                *size += 12;  // oid
+            }
+            break;
+        }
+        case type::k_document:
+        case type::k_array:
+        case type::k_codewscope: {
+            if (remaining < 4) {
+                return false;
+            }
+            std::int32_t len = read_int32_le(value);
+            if (len < 5) {
+                return false;
+            }
+            *size = static_cast<std::size_t>(len);
+            break;
+        }
+        case type::k_regex: {
+            // Two consecutive null-terminated strings: the pattern and the options.
+            auto pattern_end = static_cast<const std::uint8_t*>(std::memchr(value, 0, remaining));
+            if (!pattern_end) {
+                return false;
+            }
+            std::size_t pattern_size = static_cast<std::size_t>(pattern_end - value) + 1;
+            auto options_end = static_cast<const std::uint8_t*>(
+                std::memchr(pattern_end + 1, 0, remaining - pattern_size));
+            if (!options_end) {
+                return false;
+            }
+            *size = static_cast<std::size_t>(options_end - value) + 1;
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return *size <= remaining;
+}
+
+// Given the element at `offset` (with key length `keylen`) in the BSON datum `raw` of `length`
+// bytes, locates the element that follows it by reading the encoded sizes directly, without
+// re-initializing and re-validating a bson_iter_t. Returns false at the end of the datum, or if
+// the data is malformed.
+inline bool next_element(const std::uint8_t* raw,
+                         std::uint32_t length,
+                         std::uint32_t offset,
+                         std::uint32_t keylen,
+                         std::uint32_t* next_offset,
+                         std::uint32_t* next_keylen) {
+    // type byte + key + key terminator
+    std::size_t pos = static_cast<std::size_t>(offset) + keylen + 2;
+    if (pos > length) {
+        return false;
+    }
+
+    std::size_t value_size;
+    if (!element_value_size(
+            static_cast<bsoncxx::type>(raw[offset]), raw + pos, length - pos, &value_size)) {
+        return false;
+    }
+    pos += value_size;
+
+    // The last byte of the datum is its terminating null, so a following element needs a type
+    // byte and a key terminator before it.
+    if (pos + 2 > length || raw[pos] == 0) {
+        return false;
+    }
+
+    auto key = raw + pos + 1;
+    auto key_end = static_cast<const std::uint8_t*>(std::memchr(key, 0, length - pos - 2));
+    if (!key_end) {
+        return false;
+    }
+
+    *next_offset = static_cast<std::uint32_t>(pos);
+    *next_keylen = static_cast<std::uint32_t>(key_end - key);
+
+    return true;
+}
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
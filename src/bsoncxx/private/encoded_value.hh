@@ -0,0 +1,84 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+inline std::uint32_t read_uint32_le(const std::uint8_t* in) {
+    std::uint32_t le;
+    std::memcpy(&le, in, sizeof(le));
+    return BSON_UINT32_FROM_LE(le);
+}
+
+// The size of the encoded value, starting at `in`, of a valid element of type t.
+inline std::size_t encoded_value_size(type t, const std::uint8_t* in) {
+    constexpr std::size_t k_oid_length = 12;
+
+    switch (t) {
+        case type::k_bool:
+            return 1;
+        case type::k_int32:
+            return 4;
+        case type::k_double:
+        case type::k_date:
+        case type::k_timestamp:
+        case type::k_int64:
+            return 8;
+        case type::k_oid:
+            return k_oid_length;
+        case type::k_decimal128:
+            return 16;
+        case type::k_utf8:
+        case type::k_code:
+        case type::k_symbol:
+            return 4 + read_uint32_le(in);
+        case type::k_document:
+        case type::k_array:
+        case type::k_codewscope:
+            return read_uint32_le(in);
+        case type::k_binary:
+            return 5 + read_uint32_le(in);
+        case type::k_regex: {
+            const auto pattern = std::strlen(reinterpret_cast<const char*>(in)) + 1;
+            return pattern + std::strlen(reinterpret_cast<const char*>(in + pattern)) + 1;
+        }
+        case type::k_dbpointer:
+            return 4 + read_uint32_le(in) + k_oid_length;
+        case type::k_undefined:
+        case type::k_null:
+        case type::k_maxkey:
+        case type::k_minkey:
+            break;
+    }
+    return 0;
+}
+
+}  // namespace helpers
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
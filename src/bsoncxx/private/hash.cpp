@@ -0,0 +1,292 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/private/hash.hh>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BSONCXX_HASH_SSE2
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BSONCXX_HASH_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BSONCXX_HASH_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+namespace {
+
+// Arbitrary odd constants with about as many bits set as clear.
+constexpr std::uint64_t k_secret[8] = {0xa0761d6478bd642full,
+                                       0xe7037ed1a0b428dbull,
+                                       0x8ebc6af09c88c6e3ull,
+                                       0x589965cc75374cc3ull,
+                                       0x1d8e4e27c47d124full,
+                                       0xbe4ba423396cfeb9ull,
+                                       0xc5d47e2a6de0c2d1ull,
+                                       0x94d049bb133111ebull};
+
+constexpr std::uint32_t k_scramble_prime = 0x9E3779B1u;
+
+// Inputs longer than this are folded into accumulators first.
+constexpr std::size_t k_short_limit = 256;
+
+// The bytes folded per stripe, and the stripes between two scrambles of the accumulators.
+constexpr std::size_t k_stripe = 64;
+constexpr std::size_t k_stripes_per_block = 16;
+
+std::uint64_t read64(const std::uint8_t* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+std::uint64_t read32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+// The low and high halves of the 128-bit product of a and b, folded together.
+std::uint64_t mum(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    std::uint64_t high;
+    const std::uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    const std::uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    const std::uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    const std::uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+    const std::uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    const std::uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    const std::uint64_t low = (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+    return low ^ high;
+#endif
+}
+
+std::uint64_t hash_short(const std::uint8_t* p, std::size_t len, std::uint64_t seed) {
+    seed ^= mum(seed ^ k_secret[0], k_secret[1]);
+
+    std::uint64_t a;
+    std::uint64_t b;
+    if (len <= 16) {
+        if (len >= 4) {
+            const std::size_t middle = (len >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + middle);
+            b = (read32(p + len - 4) << 32) | read32(p + len - 4 - middle);
+        } else if (len > 0) {
+            a = (static_cast<std::uint64_t>(p[0]) << 16) |
+                (static_cast<std::uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = len;
+        for (; i > 16; i -= 16, p += 16) {
+            seed = mum(read64(p) ^ k_secret[1], read64(p + 8) ^ seed);
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+
+    return mum(k_secret[1] ^ len, mum(a ^ k_secret[1], b ^ seed));
+}
+
+#if !defined(BSONCXX_HASH_SSE2) && !defined(BSONCXX_HASH_NEON)
+// Each stripe adds, to every accumulator, the product of the halves of one of its words mixed
+// with the secret, and to its neighbour, the word itself. The vector versions compute the same.
+void accumulate_scalar(std::uint64_t* acc, const std::uint8_t* p, std::size_t stripes) {
+    for (std::size_t s = 0; s < stripes; ++s, p += k_stripe) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            const std::uint64_t data = read64(p + 8 * i);
+            const std::uint64_t key = data ^ k_secret[i];
+            acc[i ^ 1] += data;
+            acc[i] += (key & 0xFFFFFFFFu) * (key >> 32);
+        }
+    }
+}
+#endif
+
+void scramble_scalar(std::uint64_t* acc) {
+    for (std::size_t i = 0; i < 8; ++i) {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= k_secret[i];
+        acc[i] *= k_scramble_prime;
+    }
+}
+
+#if defined(BSONCXX_HASH_SSE2)
+void accumulate_sse2(std::uint64_t* acc, const std::uint8_t* p, std::size_t stripes) {
+    __m128i lanes[4];
+    __m128i secret[4];
+    for (std::size_t i = 0; i < 4; ++i) {
+        lanes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * i));
+        secret[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k_secret + 2 * i));
+    }
+
+    for (std::size_t s = 0; s < stripes; ++s, p += k_stripe) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            const __m128i key = _mm_xor_si128(data, secret[i]);
+            const __m128i key_high = _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i product = _mm_mul_epu32(key, key_high);
+            const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm_add_epi64(lanes[i], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * i), lanes[i]);
+    }
+}
+#endif
+
+#if defined(BSONCXX_HASH_AVX2)
+__attribute__((target("avx2"))) void accumulate_avx2(std::uint64_t* acc,
+                                                     const std::uint8_t* p,
+                                                     std::size_t stripes) {
+    __m256i lanes[2];
+    __m256i secret[2];
+    for (std::size_t i = 0; i < 2; ++i) {
+        lanes[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * i));
+        secret[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k_secret + 4 * i));
+    }
+
+    for (std::size_t s = 0; s < stripes; ++s, p += k_stripe) {
+        for (std::size_t i = 0; i < 2; ++i) {
+            const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * i));
+            const __m256i key = _mm256_xor_si256(data, secret[i]);
+            const __m256i key_high = _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m256i product = _mm256_mul_epu32(key, key_high);
+            const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm256_add_epi64(lanes[i], _mm256_add_epi64(product, swapped));
+        }
+    }
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * i), lanes[i]);
+    }
+}
+#endif
+
+#if defined(BSONCXX_HASH_NEON)
+void accumulate_neon(std::uint64_t* acc, const std::uint8_t* p, std::size_t stripes) {
+    uint64x2_t lanes[4];
+    uint64x2_t secret[4];
+    for (std::size_t i = 0; i < 4; ++i) {
+        lanes[i] = vld1q_u64(acc + 2 * i);
+        secret[i] = vld1q_u64(k_secret + 2 * i);
+    }
+
+    for (std::size_t s = 0; s < stripes; ++s, p += k_stripe) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(p + 16 * i));
+            const uint64x2_t key = veorq_u64(data, secret[i]);
+            const uint64x2_t product = vmull_u32(vmovn_u64(key), vshrn_n_u64(key, 32));
+            const uint64x2_t swapped = vextq_u64(data, data, 1);
+            lanes[i] = vaddq_u64(lanes[i], vaddq_u64(product, swapped));
+        }
+    }
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        vst1q_u64(acc + 2 * i, lanes[i]);
+    }
+}
+#endif
+
+using accumulate_fn = void (*)(std::uint64_t*, const std::uint8_t*, std::size_t);
+
+accumulate_fn select_accumulate() {
+#if defined(BSONCXX_HASH_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        return accumulate_avx2;
+    }
+#endif
+#if defined(BSONCXX_HASH_SSE2)
+    return accumulate_sse2;
+#elif defined(BSONCXX_HASH_NEON)
+    return accumulate_neon;
+#else
+    return accumulate_scalar;
+#endif
+}
+
+std::uint64_t hash_long(const std::uint8_t* p, std::size_t len, std::uint64_t seed) {
+    static const accumulate_fn accumulate = select_accumulate();
+
+    std::uint64_t acc[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        acc[i] = k_secret[i] ^ seed;
+    }
+
+    const std::size_t stripes = len / k_stripe;
+    std::size_t done = 0;
+    while (done < stripes) {
+        const std::size_t count =
+            stripes - done < k_stripes_per_block ? stripes - done : k_stripes_per_block;
+        accumulate(acc, p + done * k_stripe, count);
+        done += count;
+        if (count == k_stripes_per_block) {
+            scramble_scalar(acc);
+        }
+    }
+
+    std::uint64_t merged = len * k_secret[7];
+    for (std::size_t i = 0; i < 8; i += 2) {
+        merged = mum(merged ^ acc[i], acc[i + 1] ^ k_secret[i]);
+    }
+
+    // The bytes after the last full stripe, or the last 16 bytes if there are fewer.
+    const std::size_t tail = len - stripes * k_stripe;
+    const std::size_t tail_len = tail < 16 ? 16 : tail;
+    return hash_short(p + len - tail_len, tail_len, merged);
+}
+
+}  // namespace
+
+std::uint64_t hash_bytes(const void* data, std::size_t len, std::uint64_t seed) noexcept {
+    const auto p = static_cast<const std::uint8_t*>(data);
+    if (len <= k_short_limit) {
+        return hash_short(p, len, seed);
+    }
+    return hash_long(p, len, seed);
+}
+
+std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept {
+    return mum(a ^ k_secret[2], b ^ k_secret[3]);
+}
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
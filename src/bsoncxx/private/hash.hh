@@ -0,0 +1,44 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Hashes the `len` bytes at `data` into 64 bits, mixing in `seed`.
+//
+// Inputs of up to 256 bytes are hashed 16 bytes at a time with 64x64->128-bit multiplications, in
+// the manner of wyhash. Longer inputs are first folded into eight 64-bit accumulators 64 bytes at
+// a time, in the manner of XXH3, with AVX2 when the CPU supports it, otherwise SSE2 on x86 or
+// NEON on ARM64. Every implementation computes the same value, but values are not guaranteed to
+// be the same across releases or between little- and big-endian machines.
+std::uint64_t hash_bytes(const void* data, std::size_t len, std::uint64_t seed) noexcept;
+
+// Mixes two 64-bit values into one, for combining hashes.
+std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept;
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
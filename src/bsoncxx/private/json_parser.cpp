@@ -0,0 +1,1260 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/private/json_parser.hh>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BSONCXX_JSON_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <bsoncxx/decimal128.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/private/utf8.hh>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+namespace {
+
+// Objects and arrays nested deeper than this are rejected, as by validate_structure().
+constexpr std::size_t k_max_depth = 200;
+
+[[noreturn]] void fail(std::size_t offset, const std::string& what) {
+    std::ostringstream err;
+    err << what << " at offset " << offset;
+    throw bsoncxx::exception{error_code::k_json_parse_failure, err.str()};
+}
+
+//
+// Stage 1: structural indexing.
+//
+
+// The classification of a 64-byte block of input: bit i of each mask describes byte i.
+struct block_masks {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+
+    // { } [ ] : and ,
+    std::uint64_t op;
+
+    // Space, tab, line feed and carriage return.
+    std::uint64_t space;
+};
+
+#if defined(BSONCXX_JSON_SSE2)
+void classify(const std::uint8_t* p, block_masks* m) {
+    std::uint64_t quote = 0;
+    std::uint64_t backslash = 0;
+    std::uint64_t op = 0;
+    std::uint64_t space = 0;
+
+    for (unsigned i = 0; i < 4; ++i) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        const auto eq = [&chunk](char c) { return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)); };
+        const auto bits = [](__m128i v) {
+            return static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(v)));
+        };
+        const unsigned shift = 16 * i;
+
+        quote |= bits(eq('"')) << shift;
+        backslash |= bits(eq('\\')) << shift;
+        op |= bits(_mm_or_si128(_mm_or_si128(_mm_or_si128(eq('{'), eq('}')),
+                                             _mm_or_si128(eq('['), eq(']'))),
+                                _mm_or_si128(eq(':'), eq(','))))
+              << shift;
+        space |= bits(_mm_or_si128(_mm_or_si128(eq(' '), eq('\t')),
+                                   _mm_or_si128(eq('\n'), eq('\r'))))
+                 << shift;
+    }
+
+    *m = block_masks{quote, backslash, op, space};
+}
+#else
+void classify(const std::uint8_t* p, block_masks* m) {
+    *m = block_masks{0, 0, 0, 0};
+
+    for (unsigned i = 0; i < 64; ++i) {
+        const std::uint64_t bit = std::uint64_t{1} << i;
+        switch (p[i]) {
+            case '"':
+                m->quote |= bit;
+                break;
+            case '\\':
+                m->backslash |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                m->op |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                m->space |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+}
+#endif
+
+unsigned trailing_zeros(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    unsigned n = 0;
+    for (; !(bits & 1); bits >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Bit i of the result is the parity of bits 0 through i of `bits`.
+std::uint64_t prefix_xor(std::uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Returns the offsets of the operators, the opening quotes of strings, and the first bytes of
+// scalars (numbers and literals) in the input, in order.
+std::vector<std::uint32_t> index_structurals(const std::uint8_t* json, std::size_t length) {
+    std::vector<std::uint32_t> index;
+    index.reserve(length / 8 + 1);
+
+    // Whether the last byte of the previous block was a backslash escaping the next byte.
+    bool escape_carry = false;
+
+    // All ones if the previous block ended inside a string, zero otherwise.
+    std::uint64_t in_string_carry = 0;
+
+    // One if the previous block ended inside a scalar, zero otherwise.
+    std::uint64_t scalar_carry = 0;
+
+    std::uint8_t tail[64];
+    for (std::size_t base = 0; base < length; base += 64) {
+        const std::uint8_t* block = json + base;
+        if (length - base < 64) {
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, length - base);
+            block = tail;
+        }
+
+        block_masks m;
+        classify(block, &m);
+
+        // A backslash escapes the next byte unless it is itself escaped. Backslashes are rare in
+        // most JSON, so they are visited one at a time rather than with bit tricks.
+        std::uint64_t escaped = escape_carry ? 1 : 0;
+        std::uint64_t backslash = m.backslash & ~escaped;
+        escape_carry = false;
+        while (backslash) {
+            const unsigned i = trailing_zeros(backslash);
+            if (i == 63) {
+                escape_carry = true;
+                break;
+            }
+            const std::uint64_t next = std::uint64_t{1} << (i + 1);
+            escaped |= next;
+            backslash &= ~((std::uint64_t{1} << i) | next);
+        }
+
+        // Inside a string, including its opening quote but not its closing one.
+        const std::uint64_t quote = m.quote & ~escaped;
+        const std::uint64_t in_string = prefix_xor(quote) ^ in_string_carry;
+        in_string_carry = std::uint64_t{0} - (in_string >> 63);
+
+        const std::uint64_t outside = ~(in_string | quote);
+        const std::uint64_t scalar = ~(m.op | m.space) & outside;
+        const std::uint64_t scalar_start = scalar & ~((scalar << 1) | scalar_carry);
+        scalar_carry = scalar >> 63;
+
+        std::uint64_t structural = (m.op & outside) | (quote & in_string) | scalar_start;
+        while (structural) {
+            index.push_back(static_cast<std::uint32_t>(base + trailing_zeros(structural)));
+            structural &= structural - 1;
+        }
+    }
+
+    if (in_string_carry) {
+        fail(length, "unterminated string");
+    }
+
+    return index;
+}
+
+//
+// Stage 2: building BSON.
+//
+
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void append_utf8(std::string* out, std::uint32_t cp) {
+    if (cp < 0x80) {
+        out->push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out->push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out->push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out->push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out->push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+// Checks the grammar of a JSON number, and whether it is written as an integer.
+bool scan_number(stdx::string_view text, bool* integer) {
+    std::size_t i = 0;
+    const std::size_t n = text.size();
+
+    if (i < n && text[i] == '-') {
+        ++i;
+    }
+    if (i == n || !is_digit(text[i])) {
+        return false;
+    }
+    if (text[i] == '0' && i + 1 < n && is_digit(text[i + 1])) {
+        return false;
+    }
+    while (i < n && is_digit(text[i])) {
+        ++i;
+    }
+
+    *integer = true;
+    if (i < n && text[i] == '.') {
+        *integer = false;
+        ++i;
+        if (i == n || !is_digit(text[i])) {
+            return false;
+        }
+        while (i < n && is_digit(text[i])) {
+            ++i;
+        }
+    }
+    if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+        *integer = false;
+        ++i;
+        if (i < n && (text[i] == '+' || text[i] == '-')) {
+            ++i;
+        }
+        if (i == n || !is_digit(text[i])) {
+            return false;
+        }
+        while (i < n && is_digit(text[i])) {
+            ++i;
+        }
+    }
+
+    return i == n;
+}
+
+// Parses an optionally negative decimal integer, failing if it does not fit in an int64.
+bool parse_int64(stdx::string_view text, std::int64_t* out) {
+    std::size_t i = 0;
+    const bool negative = !text.empty() && text[0] == '-';
+    if (negative) {
+        ++i;
+    }
+    if (i == text.size()) {
+        return false;
+    }
+
+    // The magnitude of INT64_MIN is one more than INT64_MAX.
+    const std::uint64_t limit =
+        static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + (negative ? 1 : 0);
+    std::uint64_t magnitude = 0;
+    for (; i < text.size(); ++i) {
+        if (!is_digit(text[i])) {
+            return false;
+        }
+        const auto digit = static_cast<std::uint64_t>(text[i] - '0');
+        if (magnitude > (limit - digit) / 10) {
+            return false;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+
+    if (!negative) {
+        *out = static_cast<std::int64_t>(magnitude);
+    } else if (magnitude == limit) {
+        *out = std::numeric_limits<std::int64_t>::min();
+    } else {
+        *out = -static_cast<std::int64_t>(magnitude);
+    }
+    return true;
+}
+
+double to_double(stdx::string_view text) {
+    // strtod needs a terminated string.
+    const std::string terminated{text.data(), text.size()};
+    return std::strtod(terminated.c_str(), nullptr);
+}
+
+// Reads `count` decimal digits of `text` from `*i` into `*out`.
+bool read_digits(stdx::string_view text, std::size_t* i, std::size_t count, int* out) {
+    if (*i + count > text.size()) {
+        return false;
+    }
+    *out = 0;
+    for (std::size_t end = *i + count; *i < end; ++*i) {
+        if (!is_digit(text[*i])) {
+            return false;
+        }
+        *out = *out * 10 + (text[*i] - '0');
+    }
+    return true;
+}
+
+// Days since 1970-01-01 of a date of the proleptic Gregorian calendar.
+std::int64_t days_from_civil(std::int64_t y, int m, int d) {
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const std::int64_t yoe = y - era * 400;
+    const std::int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const std::int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Parses an ISO-8601 date and time such as 1970-01-01T00:00:00Z or 2020-02-03T04:05:06.789+01:00
+// into milliseconds since the epoch.
+bool parse_iso_date(stdx::string_view text, std::int64_t* ms) {
+    std::size_t i = 0;
+    int year, month, day, hour, minute, second;
+
+    if (!read_digits(text, &i, 4, &year) || i == text.size() || text[i++] != '-' ||
+        !read_digits(text, &i, 2, &month) || i == text.size() || text[i++] != '-' ||
+        !read_digits(text, &i, 2, &day) || i == text.size() || text[i++] != 'T' ||
+        !read_digits(text, &i, 2, &hour) || i == text.size() || text[i++] != ':' ||
+        !read_digits(text, &i, 2, &minute) || i == text.size() || text[i++] != ':' ||
+        !read_digits(text, &i, 2, &second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 ||
+        second > 59) {
+        return false;
+    }
+
+    // Only milliseconds are kept of a fraction of a second.
+    int millis = 0;
+    if (i < text.size() && text[i] == '.') {
+        ++i;
+        if (i == text.size() || !is_digit(text[i])) {
+            return false;
+        }
+        for (int scale = 100; i < text.size() && is_digit(text[i]); ++i, scale /= 10) {
+            millis += (text[i] - '0') * scale;
+        }
+    }
+
+    std::int64_t offset_minutes = 0;
+    if (i < text.size() && text[i] == 'Z') {
+        ++i;
+    } else if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+        const bool negative = text[i++] == '-';
+        int offset_hours, offset_mins;
+        if (!read_digits(text, &i, 2, &offset_hours)) {
+            return false;
+        }
+        if (i < text.size() && text[i] == ':') {
+            ++i;
+        }
+        if (!read_digits(text, &i, 2, &offset_mins)) {
+            return false;
+        }
+        offset_minutes = (offset_hours * 60 + offset_mins) * (negative ? -1 : 1);
+    } else {
+        return false;
+    }
+    if (i != text.size()) {
+        return false;
+    }
+
+    const std::int64_t seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 +
+                                 minute * 60 + second - offset_minutes * 60;
+    *ms = seconds * 1000 + millis;
+    return true;
+}
+
+// Decodes base64 text, padded to a multiple of four characters.
+bool decode_base64(stdx::string_view text, std::vector<std::uint8_t>* out) {
+    const auto value = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') {
+            return c - 'A';
+        }
+        if (c >= 'a' && c <= 'z') {
+            return c - 'a' + 26;
+        }
+        if (c >= '0' && c <= '9') {
+            return c - '0' + 52;
+        }
+        if (c == '+') {
+            return 62;
+        }
+        if (c == '/') {
+            return 63;
+        }
+        return -1;
+    };
+
+    out->clear();
+    if (text.size() % 4 != 0) {
+        return false;
+    }
+    out->reserve(text.size() / 4 * 3);
+
+    for (std::size_t i = 0; i < text.size(); i += 4) {
+        const bool last = i + 4 == text.size();
+        const std::size_t padding =
+            last ? static_cast<std::size_t>(text[i + 3] == '=') +
+                       static_cast<std::size_t>(text[i + 2] == '=' && text[i + 3] == '=')
+                 : 0;
+
+        std::uint32_t group = 0;
+        for (std::size_t j = 0; j < 4; ++j) {
+            int v = j >= 4 - padding ? 0 : value(text[i + j]);
+            if (v < 0) {
+                return false;
+            }
+            group = (group << 6) | static_cast<std::uint32_t>(v);
+        }
+
+        out->push_back(static_cast<std::uint8_t>(group >> 16));
+        if (padding < 2) {
+            out->push_back(static_cast<std::uint8_t>(group >> 8));
+        }
+        if (padding < 1) {
+            out->push_back(static_cast<std::uint8_t>(group));
+        }
+    }
+    return true;
+}
+
+// Parses a binary sub type written as one or two hexadecimal digits.
+bool parse_sub_type(stdx::string_view text, binary_sub_type* out) {
+    if (text.empty() || text.size() > 2) {
+        return false;
+    }
+    int value = 0;
+    for (char c : text) {
+        const int digit = hex_value(c);
+        if (digit < 0) {
+            return false;
+        }
+        value = value * 16 + digit;
+    }
+    *out = static_cast<binary_sub_type>(value);
+    return true;
+}
+
+// The first keys of the objects that may be Extended JSON wrappers.
+bool is_wrapper_key(stdx::string_view key) {
+    static const char* const keys[] = {"$oid",
+                                       "$date",
+                                       "$numberLong",
+                                       "$numberInt",
+                                       "$numberDouble",
+                                       "$numberDecimal",
+                                       "$binary",
+                                       "$type",
+                                       "$regularExpression",
+                                       "$regex",
+                                       "$options",
+                                       "$timestamp",
+                                       "$minKey",
+                                       "$maxKey",
+                                       "$undefined",
+                                       "$symbol",
+                                       "$code",
+                                       "$scope",
+                                       "$dbPointer"};
+    for (const char* candidate : keys) {
+        if (key == candidate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+class parser {
+   public:
+    parser(stdx::string_view json, builder::core* out)
+        : _json{json.data()},
+          _length{json.size()},
+          _index{index_structurals(reinterpret_cast<const std::uint8_t*>(json.data()),
+                                   json.size())},
+          _pos{0},
+          _out{out} {}
+
+    void parse_root() {
+        if (tok(_pos) != '{') {
+            fail(offset(_pos), "expected a JSON object");
+        }
+        parse_members(0);
+        if (_pos != _index.size()) {
+            fail(offset(_pos), "unexpected text after the JSON object");
+        }
+    }
+
+   private:
+    // A member of an object, found without decoding it.
+    struct member {
+        stdx::string_view key;
+
+        // The token of the member's value.
+        std::size_t value;
+    };
+
+    // The first byte of a token, or NUL past the last token.
+    char tok(std::size_t token) const {
+        return token < _index.size() ? _json[_index[token]] : '\0';
+    }
+
+    std::size_t offset(std::size_t token) const {
+        return token < _index.size() ? _index[token] : _length;
+    }
+
+    // Appends the members of the object at the current token to the open document.
+    void parse_members(std::size_t depth) {
+        if (depth >= k_max_depth) {
+            fail(offset(_pos), "JSON nested too deeply");
+        }
+
+        ++_pos;
+        if (tok(_pos) == '}') {
+            ++_pos;
+            return;
+        }
+
+        for (;;) {
+            if (tok(_pos) != '"') {
+                fail(offset(_pos), "expected a string key");
+            }
+
+            bool copied = false;
+            const stdx::string_view key = read_string(_pos, &copied);
+            if (std::memchr(key.data(), '\0', key.size())) {
+                fail(offset(_pos), "key contains a null character");
+            }
+
+            // A key viewed in the input stays valid until its value is appended. A key with
+            // escapes is owned by the builder instead, since the scratch string may be reused
+            // before then, by the scope of a $code wrapper.
+            if (copied) {
+                _out->key_owned(std::string{key.data(), key.size()});
+            } else {
+                _out->key_view(key);
+            }
+
+            ++_pos;
+            if (tok(_pos) != ':') {
+                fail(offset(_pos), "expected ':'");
+            }
+            ++_pos;
+
+            parse_value(depth + 1);
+
+            const char c = tok(_pos++);
+            if (c == '}') {
+                return;
+            }
+            if (c != ',') {
+                fail(offset(_pos - 1), "expected ',' or '}'");
+            }
+        }
+    }
+
+    // Appends the items of the array at the current token to the open array.
+    void parse_items(std::size_t depth) {
+        if (depth >= k_max_depth) {
+            fail(offset(_pos), "JSON nested too deeply");
+        }
+
+        ++_pos;
+        if (tok(_pos) == ']') {
+            ++_pos;
+            return;
+        }
+
+        for (;;) {
+            parse_value(depth + 1);
+
+            const char c = tok(_pos++);
+            if (c == ']') {
+                return;
+            }
+            if (c != ',') {
+                fail(offset(_pos - 1), "expected ',' or ']'");
+            }
+        }
+    }
+
+    void parse_value(std::size_t depth) {
+        switch (tok(_pos)) {
+            case '{':
+                if (!parse_extended(depth)) {
+                    _out->open_document();
+                    parse_members(depth);
+                    _out->close_document();
+                }
+                return;
+            case '[':
+                _out->open_array();
+                parse_items(depth);
+                _out->close_array();
+                return;
+            case '"':
+                _out->append(types::b_utf8{read_string(_pos)});
+                ++_pos;
+                return;
+            case '}':
+            case ']':
+            case ':':
+            case ',':
+            case '\0':
+                fail(offset(_pos), "expected a value");
+            default:
+                parse_scalar(_pos);
+                ++_pos;
+                return;
+        }
+    }
+
+    // The text of the scalar starting at a token.
+    stdx::string_view scalar_text(std::size_t token) const {
+        const std::size_t start = _index[token];
+        std::size_t end = start;
+        while (end < _length) {
+            const char c = _json[end];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':' ||
+                c == '[' || c == ']' || c == '{' || c == '}' || c == '"') {
+                break;
+            }
+            ++end;
+        }
+        return stdx::string_view{_json + start, end - start};
+    }
+
+    void parse_scalar(std::size_t token) {
+        const stdx::string_view text = scalar_text(token);
+
+        if (text == "true") {
+            _out->append(types::b_bool{true});
+        } else if (text == "false") {
+            _out->append(types::b_bool{false});
+        } else if (text == "null") {
+            _out->append(types::b_null{});
+        } else {
+            append_number(text, offset(token));
+        }
+    }
+
+    // Appends an integer that fits as an int32, or else as an int64, and any other number as a
+    // double.
+    void append_number(stdx::string_view text, std::size_t at) {
+        bool integer;
+        if (!scan_number(text, &integer)) {
+            fail(at, "invalid JSON value");
+        }
+
+        std::int64_t value;
+        if (integer && parse_int64(text, &value)) {
+            if (value >= std::numeric_limits<std::int32_t>::min() &&
+                value <= std::numeric_limits<std::int32_t>::max()) {
+                _out->append(types::b_int32{static_cast<std::int32_t>(value)});
+            } else {
+                _out->append(types::b_int64{value});
+            }
+            return;
+        }
+
+        _out->append(types::b_double{to_double(text)});
+    }
+
+    // Decodes the string at a token. A string without escapes is viewed in the input; any other
+    // is decoded into the scratch string, which the next call overwrites.
+    stdx::string_view read_string(std::size_t token, bool* copied = nullptr) {
+        const std::size_t start = _index[token] + 1;
+        std::size_t i = start;
+
+        while (i < _length) {
+            const auto c = static_cast<unsigned char>(_json[i]);
+            if (c == '"' || c == '\\' || c < 0x20) {
+                break;
+            }
+            ++i;
+        }
+
+        if (i < _length && _json[i] == '"') {
+            check_utf8(_json + start, i - start, start);
+            return stdx::string_view{_json + start, i - start};
+        }
+
+        _scratch.assign(_json + start, i - start);
+        for (;;) {
+            if (i >= _length) {
+                fail(start - 1, "unterminated string");
+            }
+
+            const auto c = static_cast<unsigned char>(_json[i]);
+            if (c == '"') {
+                break;
+            }
+            if (c < 0x20) {
+                fail(i, "control character in string");
+            }
+            if (c != '\\') {
+                _scratch.push_back(static_cast<char>(c));
+                ++i;
+                continue;
+            }
+
+            if (i + 1 >= _length) {
+                fail(i, "unterminated string");
+            }
+            const char escape = _json[i + 1];
+            i += 2;
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    _scratch.push_back(escape);
+                    break;
+                case 'b':
+                    _scratch.push_back('\b');
+                    break;
+                case 'f':
+                    _scratch.push_back('\f');
+                    break;
+                case 'n':
+                    _scratch.push_back('\n');
+                    break;
+                case 'r':
+                    _scratch.push_back('\r');
+                    break;
+                case 't':
+                    _scratch.push_back('\t');
+                    break;
+                case 'u': {
+                    std::uint32_t cp = read_hex4(i);
+                    i += 4;
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        if (i + 6 > _length || _json[i] != '\\' || _json[i + 1] != 'u') {
+                            fail(i, "unpaired surrogate in string");
+                        }
+                        const std::uint32_t low = read_hex4(i + 2);
+                        if (low < 0xDC00 || low > 0xDFFF) {
+                            fail(i, "unpaired surrogate in string");
+                        }
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        fail(i - 6, "unpaired surrogate in string");
+                    }
+                    append_utf8(&_scratch, cp);
+                    break;
+                }
+                default:
+                    fail(i - 2, "invalid escape in string");
+            }
+        }
+
+        check_utf8(_scratch.data(), _scratch.size(), start);
+        if (copied) {
+            *copied = true;
+        }
+        return stdx::string_view{_scratch.data(), _scratch.size()};
+    }
+
+    std::uint32_t read_hex4(std::size_t at) const {
+        if (at + 4 > _length) {
+            fail(at, "invalid \\u escape in string");
+        }
+        std::uint32_t cp = 0;
+        for (std::size_t j = at; j < at + 4; ++j) {
+            const int digit = hex_value(_json[j]);
+            if (digit < 0) {
+                fail(at, "invalid \\u escape in string");
+            }
+            cp = (cp << 4) | static_cast<std::uint32_t>(digit);
+        }
+        return cp;
+    }
+
+    void check_utf8(const char* str, std::size_t len, std::size_t at) const {
+        if (!utf8_validate(str, len, true)) {
+            fail(at, "invalid UTF-8 in string");
+        }
+    }
+
+    //
+    // Extended JSON.
+    //
+
+    // The token just past the value at `token`, or npos if its brackets are not closed.
+    std::size_t skip_value(std::size_t token) const {
+        const char c = tok(token);
+        if (c != '{' && c != '[') {
+            return token + 1;
+        }
+
+        std::size_t depth = 0;
+        for (std::size_t t = token; t < _index.size(); ++t) {
+            const char d = tok(t);
+            if (d == '{' || d == '[') {
+                ++depth;
+            } else if ((d == '}' || d == ']') && --depth == 0) {
+                return t + 1;
+            }
+        }
+        return std::string::npos;
+    }
+
+    // The key at a token, viewed in the input, or false if it has escapes.
+    bool raw_key(std::size_t token, stdx::string_view* key) const {
+        const std::size_t start = _index[token] + 1;
+        std::size_t i = start;
+        while (i < _length && _json[i] != '"') {
+            if (_json[i] == '\\') {
+                return false;
+            }
+            ++i;
+        }
+        *key = stdx::string_view{_json + start, i - start};
+        return true;
+    }
+
+    // Finds the members of the object at `token` without appending anything. Returns false if it
+    // has more than `max` members, or is malformed; the regular parse reports the error then.
+    bool collect_members(std::size_t token,
+                         member* members,
+                         std::size_t max,
+                         std::size_t* count,
+                         std::size_t* end) const {
+        std::size_t t = token + 1;
+        *count = 0;
+        if (tok(t) == '}') {
+            *end = t + 1;
+            return true;
+        }
+
+        for (;;) {
+            if (*count == max || tok(t) != '"' || tok(t + 1) != ':') {
+                return false;
+            }
+            if (!raw_key(t, &members[*count].key)) {
+                return false;
+            }
+            members[*count].value = t + 2;
+            ++*count;
+
+            t = skip_value(t + 2);
+            if (t == std::string::npos) {
+                return false;
+            }
+
+            const char c = tok(t);
+            if (c == '}') {
+                *end = t + 1;
+                return true;
+            }
+            if (c != ',') {
+                return false;
+            }
+            ++t;
+        }
+    }
+
+    static const member* find_member(const member* members,
+                                     std::size_t count,
+                                     stdx::string_view key) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (members[i].key == key) {
+                return &members[i];
+            }
+        }
+        return nullptr;
+    }
+
+    stdx::string_view expect_string(std::size_t token, stdx::string_view wrapper) {
+        if (tok(token) != '"') {
+            invalid(token, wrapper);
+        }
+        return read_string(token);
+    }
+
+    stdx::string_view expect_scalar(std::size_t token, stdx::string_view wrapper) const {
+        const char c = tok(token);
+        if (c == '"' || c == '{' || c == '[' || c == '}' || c == ']' || c == ':' || c == ',' ||
+            c == '\0') {
+            invalid(token, wrapper);
+        }
+        return scalar_text(token);
+    }
+
+    // Finds the members of an object nested in a wrapper, such as the one of $binary.
+    void expect_object(std::size_t token,
+                       stdx::string_view wrapper,
+                       member* members,
+                       std::size_t max,
+                       std::size_t* count) const {
+        std::size_t end;
+        if (tok(token) != '{' || !collect_members(token, members, max, count, &end)) {
+            invalid(token, wrapper);
+        }
+    }
+
+    [[noreturn]] void invalid(std::size_t token, stdx::string_view wrapper) const {
+        fail(offset(token), "invalid Extended JSON " + std::string{wrapper.data(), wrapper.size()});
+    }
+
+    // Appends the object at the current token as the BSON type it is the Extended JSON form of,
+    // and returns true, or returns false if it is not such a form.
+    bool parse_extended(std::size_t depth) {
+        const std::size_t first = _pos + 1;
+        stdx::string_view first_key;
+        if (tok(first) != '"' || !raw_key(first, &first_key) || !is_wrapper_key(first_key)) {
+            return false;
+        }
+
+        member members[2];
+        std::size_t count;
+        std::size_t end;
+        if (!collect_members(_pos, members, 2, &count, &end)) {
+            return false;
+        }
+
+        const bool appended =
+            count == 1 ? append_wrapper(members[0]) : append_wrapper_pair(members, depth);
+        if (appended) {
+            _pos = end;
+        }
+        return appended;
+    }
+
+    bool append_wrapper(const member& m) {
+        const stdx::string_view key = m.key;
+        const std::size_t value = m.value;
+
+        if (key == "$oid") {
+            const auto hex = expect_string(value, key);
+            if (hex.size() != 24 || !is_hex(hex)) {
+                invalid(value, key);
+            }
+            _out->append(types::b_oid{oid{hex}});
+        } else if (key == "$date") {
+            _out->append(types::b_date{std::chrono::milliseconds{parse_date(value)}});
+        } else if (key == "$numberLong") {
+            std::int64_t v;
+            if (!parse_int64(expect_string(value, key), &v)) {
+                invalid(value, key);
+            }
+            _out->append(types::b_int64{v});
+        } else if (key == "$numberInt") {
+            std::int64_t v;
+            if (!parse_int64(expect_string(value, key), &v) ||
+                v < std::numeric_limits<std::int32_t>::min() ||
+                v > std::numeric_limits<std::int32_t>::max()) {
+                invalid(value, key);
+            }
+            _out->append(types::b_int32{static_cast<std::int32_t>(v)});
+        } else if (key == "$numberDouble") {
+            _out->append(types::b_double{parse_double(expect_string(value, key), value)});
+        } else if (key == "$numberDecimal") {
+            _out->append(types::b_decimal128{decimal128{expect_string(value, key)}});
+        } else if (key == "$binary") {
+            member fields[2];
+            std::size_t count;
+            expect_object(value, key, fields, 2, &count);
+            const member* base64 = find_member(fields, count, "base64");
+            const member* sub_type = find_member(fields, count, "subType");
+            if (count != 2 || !base64 || !sub_type) {
+                invalid(value, key);
+            }
+            append_binary(base64->value, sub_type->value, key);
+        } else if (key == "$regularExpression") {
+            member fields[2];
+            std::size_t count;
+            expect_object(value, key, fields, 2, &count);
+            const member* pattern = find_member(fields, count, "pattern");
+            const member* options = find_member(fields, count, "options");
+            if (count != 2 || !pattern || !options) {
+                invalid(value, key);
+            }
+            append_regex(pattern->value, options->value, key);
+        } else if (key == "$timestamp") {
+            member fields[2];
+            std::size_t count;
+            expect_object(value, key, fields, 2, &count);
+            const member* t = find_member(fields, count, "t");
+            const member* i = find_member(fields, count, "i");
+            if (count != 2 || !t || !i) {
+                invalid(value, key);
+            }
+            _out->append(
+                types::b_timestamp{parse_uint32(i->value, key), parse_uint32(t->value, key)});
+        } else if (key == "$minKey" || key == "$maxKey") {
+            if (expect_scalar(value, key) != "1") {
+                invalid(value, key);
+            }
+            if (key == "$minKey") {
+                _out->append(types::b_minkey{});
+            } else {
+                _out->append(types::b_maxkey{});
+            }
+        } else if (key == "$undefined") {
+            if (expect_scalar(value, key) != "true") {
+                invalid(value, key);
+            }
+            _out->append(types::b_undefined{});
+        } else if (key == "$symbol") {
+            _out->append(types::b_symbol{expect_string(value, key)});
+        } else if (key == "$code") {
+            _out->append(types::b_code{expect_string(value, key)});
+        } else if (key == "$dbPointer") {
+            member fields[2];
+            std::size_t count;
+            expect_object(value, key, fields, 2, &count);
+            const member* ref = find_member(fields, count, "$ref");
+            const member* id = find_member(fields, count, "$id");
+            member oid_field[1];
+            std::size_t oid_count;
+            if (count != 2 || !ref || !id) {
+                invalid(value, key);
+            }
+            expect_object(id->value, key, oid_field, 1, &oid_count);
+            if (oid_count != 1 || oid_field[0].key != "$oid") {
+                invalid(id->value, key);
+            }
+            const auto hex = expect_string(oid_field[0].value, key);
+            if (hex.size() != 24 || !is_hex(hex)) {
+                invalid(oid_field[0].value, key);
+            }
+            const oid id_value{hex};
+            const auto collection = expect_string(ref->value, key);
+            _out->append(types::b_dbpointer{collection, id_value});
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool append_wrapper_pair(const member* members, std::size_t depth) {
+        const member* binary = find_member(members, 2, "$binary");
+        const member* type = find_member(members, 2, "$type");
+        if (binary && type) {
+            // The legacy form of $binary, with the sub type beside it.
+            if (tok(binary->value) != '"') {
+                return false;
+            }
+            append_binary(binary->value, type->value, "$binary");
+            return true;
+        }
+
+        const member* regex = find_member(members, 2, "$regex");
+        const member* options = find_member(members, 2, "$options");
+        if (regex && options) {
+            // A $regex query operator, whose pattern is not a string, is left as a document.
+            if (tok(regex->value) != '"') {
+                return false;
+            }
+            append_regex(regex->value, options->value, "$regex");
+            return true;
+        }
+
+        const member* code = find_member(members, 2, "$code");
+        const member* scope = find_member(members, 2, "$scope");
+        if (code && scope) {
+            const auto text = expect_string(code->value, "$code");
+            const std::string code_copy{text.data(), text.size()};
+            if (tok(scope->value) != '{') {
+                invalid(scope->value, "$scope");
+            }
+
+            builder::core scope_builder{false};
+            builder::core* const outer = _out;
+            _out = &scope_builder;
+            _pos = scope->value;
+            parse_members(depth + 1);
+            _out = outer;
+
+            _out->append(types::b_codewscope{code_copy, scope_builder.view_document()});
+            return true;
+        }
+
+        return false;
+    }
+
+    void append_binary(std::size_t base64, std::size_t sub_type, stdx::string_view wrapper) {
+        if (!decode_base64(expect_string(base64, wrapper), &_binary)) {
+            invalid(base64, wrapper);
+        }
+        binary_sub_type type;
+        if (!parse_sub_type(expect_string(sub_type, wrapper), &type)) {
+            invalid(sub_type, wrapper);
+        }
+        _out->append(types::b_binary{
+            type, static_cast<std::uint32_t>(_binary.size()), _binary.data()});
+    }
+
+    void append_regex(std::size_t pattern, std::size_t options, stdx::string_view wrapper) {
+        const auto text = expect_string(pattern, wrapper);
+        const std::string pattern_copy{text.data(), text.size()};
+        const auto flags = expect_string(options, wrapper);
+        if (std::memchr(pattern_copy.data(), '\0', pattern_copy.size()) ||
+            std::memchr(flags.data(), '\0', flags.size())) {
+            invalid(pattern, wrapper);
+        }
+        _out->append(types::b_regex{pattern_copy, flags});
+    }
+
+    std::int64_t parse_date(std::size_t value) {
+        std::int64_t ms;
+        const char c = tok(value);
+        if (c == '"') {
+            if (!parse_iso_date(read_string(value), &ms)) {
+                invalid(value, "$date");
+            }
+        } else if (c == '{') {
+            member fields[1];
+            std::size_t count;
+            expect_object(value, "$date", fields, 1, &count);
+            if (count != 1 || fields[0].key != "$numberLong" ||
+                !parse_int64(expect_string(fields[0].value, "$date"), &ms)) {
+                invalid(value, "$date");
+            }
+        } else if (!parse_int64(expect_scalar(value, "$date"), &ms)) {
+            invalid(value, "$date");
+        }
+        return ms;
+    }
+
+    double parse_double(stdx::string_view text, std::size_t token) const {
+        if (text == "Infinity") {
+            return std::numeric_limits<double>::infinity();
+        }
+        if (text == "-Infinity") {
+            return -std::numeric_limits<double>::infinity();
+        }
+        if (text == "NaN") {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        bool integer;
+        if (!scan_number(text, &integer)) {
+            invalid(token, "$numberDouble");
+        }
+        return to_double(text);
+    }
+
+    std::uint32_t parse_uint32(std::size_t token, stdx::string_view wrapper) const {
+        std::int64_t v;
+        if (!parse_int64(expect_scalar(token, wrapper), &v) || v < 0 ||
+            v > std::numeric_limits<std::uint32_t>::max()) {
+            invalid(token, wrapper);
+        }
+        return static_cast<std::uint32_t>(v);
+    }
+
+    static bool is_hex(stdx::string_view text) {
+        for (char c : text) {
+            if (hex_value(c) < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const char* _json;
+    std::size_t _length;
+    std::vector<std::uint32_t> _index;
+
+    // The current token.
+    std::size_t _pos;
+
+    builder::core* _out;
+
+    // Decoded strings with escapes, and decoded binary data.
+    std::string _scratch;
+    std::vector<std::uint8_t> _binary;
+};
+
+}  // namespace
+
+void parse_json(stdx::string_view json, builder::core* out) {
+    if (json.size() > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        fail(0, "JSON text is too large");
+    }
+
+    parser{json, out}.parse_root();
+}
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
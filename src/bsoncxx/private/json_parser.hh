@@ -0,0 +1,50 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Parses a JSON object and appends its members to `out`, which must be a document builder with
+// no pending key.
+//
+// Parsing is done in two stages, after simdjson. The first stage classifies the input 64 bytes
+// at a time into bitmasks of quotes, backslashes, operators and whitespace (with SSE2 when it is
+// available), and from them finds the position of every structural character, string and scalar
+// outside of strings. The second stage walks those positions and appends each value to `out` as
+// it is reached, without building an intermediate tree.
+//
+// The Extended JSON wrappers $oid, $date, $numberLong, $numberInt, $numberDouble, $numberDecimal,
+// $binary, $regularExpression, $regex/$options, $timestamp, $minKey, $maxKey, $undefined,
+// $symbol, $code/$scope and $dbPointer are converted to their BSON types. Other objects,
+// including ones with unknown $-prefixed keys, are appended as documents.
+//
+// Throws bsoncxx::exception with error_code::k_json_parse_failure if the input is not a single
+// valid JSON object.
+void parse_json(stdx::string_view json, builder::core* out);
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
@@ -0,0 +1,596 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/private/json_writer.hh>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BSONCXX_JSON_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <bsoncxx/decimal128.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/b64_ntop.hh>
+#include <bsoncxx/private/itoa.hh>
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/private/utf8.hh>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+namespace {
+
+// libbson writes documents nested deeper than this as "{ ... }".
+constexpr std::size_t k_max_depth = 200;
+
+[[noreturn]] void fail() {
+    throw bsoncxx::exception{error_code::k_failed_converting_bson_to_json};
+}
+
+unsigned trailing_zeros(unsigned bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(bits));
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    unsigned n = 0;
+    for (; !(bits & 1); bits >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+bool is_special(unsigned char c) {
+    // 0xC0 can only start the two-byte form of NUL in validated text, which libbson rejects.
+    return c == '"' || c == '\\' || c < 0x20 || c == 0xC0;
+}
+
+// The offset of the first byte at or after `i` that cannot be copied to the output as is.
+std::size_t find_special(const char* str, std::size_t i, std::size_t len) {
+#if defined(BSONCXX_JSON_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    const __m128i overlong = _mm_set1_epi8(static_cast<char>(0xC0));
+
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const __m128i escaped =
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        const __m128i special =
+            _mm_or_si128(escaped,
+                         _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk),
+                                      _mm_cmpeq_epi8(chunk, overlong)));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+        if (mask) {
+            return i + trailing_zeros(mask);
+        }
+    }
+#endif
+
+    for (; i < len; ++i) {
+        if (is_special(static_cast<unsigned char>(str[i]))) {
+            return i;
+        }
+    }
+    return len;
+}
+
+void append_int64(std::string* out, std::int64_t value) {
+    // Formats the magnitude as unsigned, so that INT64_MIN does not overflow.
+    std::uint64_t magnitude = static_cast<std::uint64_t>(value);
+    if (value < 0) {
+        magnitude = std::uint64_t{0} - magnitude;
+    }
+
+    char buf[20];
+    char* end = buf + sizeof(buf);
+    char* begin = end;
+    do {
+        *--begin = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+
+    if (value < 0) {
+        out->push_back('-');
+    }
+    out->append(begin, end);
+}
+
+void append_uint32(std::string* out, std::uint32_t value) {
+    const itoa digits{value};
+    out->append(digits.c_str(), digits.length());
+}
+
+void append_two_digits(std::string* out, unsigned value) {
+    out->push_back(static_cast<char>('0' + value / 10));
+    out->push_back(static_cast<char>('0' + value % 10));
+}
+
+void append_hex_byte(std::string* out, std::uint8_t value) {
+    static const char digits[] = "0123456789abcdef";
+    out->push_back(digits[value >> 4]);
+    out->push_back(digits[value & 0xF]);
+}
+
+// Matches printf's "%.20g", which libbson uses, followed by the ".0" libbson adds to doubles that
+// would otherwise read as integers.
+void append_double(std::string* out, double value) {
+    // Integers below 2^53 are exact, so "%.20g" writes their digits and nothing else. Negative
+    // zero takes the general path, to keep its sign.
+    if (value == std::trunc(value) && std::fabs(value) < 9007199254740992.0 && value != 0.0) {
+        append_int64(out, static_cast<std::int64_t>(value));
+        out->append(".0");
+        return;
+    }
+
+    char buf[64];
+    const int len = std::snprintf(buf, sizeof(buf), "%.20g", value);
+    out->append(buf, static_cast<std::size_t>(len));
+    if (std::strspn(buf, "0123456789-") == static_cast<std::size_t>(len)) {
+        out->append(".0");
+    }
+}
+
+// Matches strftime's "%Y-%m-%dT%H:%M:%S" of gmtime, followed by milliseconds if there are any.
+void append_iso_date(std::string* out, std::int64_t ms) {
+    const std::int64_t seconds = ms / 1000;
+    const std::int64_t millis = ms % 1000;
+    const std::int64_t days = seconds / 86400;
+    const auto second_of_day = static_cast<unsigned>(seconds % 86400);
+
+    // The inverse of days_from_civil, for days since 1970-01-01.
+    const std::int64_t z = days + 719468;
+    const std::int64_t era = z / 146097;
+    const std::int64_t doe = z - era * 146097;
+    const std::int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const std::int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const std::int64_t mp = (5 * doy + 2) / 153;
+    const auto day = static_cast<unsigned>(doy - (153 * mp + 2) / 5 + 1);
+    const auto month = static_cast<unsigned>(mp < 10 ? mp + 3 : mp - 9);
+    const std::int64_t year = yoe + era * 400 + (month <= 2);
+
+    append_int64(out, year);
+    out->push_back('-');
+    append_two_digits(out, month);
+    out->push_back('-');
+    append_two_digits(out, day);
+    out->push_back('T');
+    append_two_digits(out, second_of_day / 3600);
+    out->push_back(':');
+    append_two_digits(out, second_of_day / 60 % 60);
+    out->push_back(':');
+    append_two_digits(out, second_of_day % 60);
+
+    if (millis) {
+        out->push_back('.');
+        out->push_back(static_cast<char>('0' + millis / 100));
+        append_two_digits(out, static_cast<unsigned>(millis % 100));
+    }
+    out->push_back('Z');
+}
+
+class writer {
+   public:
+    writer(ExtendedJsonMode mode, std::string* out) : _mode{mode}, _out{out} {}
+
+    // Writes a document the way bson_as_json and its siblings write the outermost one.
+    void write_root(const std::uint8_t* data, std::size_t length, std::size_t depth) {
+        bson_iter_t iter;
+        if (!bson_iter_init_from_data(&iter, data, length)) {
+            fail();
+        }
+        if (length == 5) {
+            _out->append("{ }");
+            return;
+        }
+        write_elements(&iter, false, depth);
+    }
+
+   private:
+    bool wrapped() const {
+        return _mode != ExtendedJsonMode::k_legacy;
+    }
+
+    void write_elements(bson_iter_t* iter, bool array, std::size_t depth) {
+        _out->append(array ? "[ " : "{ ");
+
+        bool first = true;
+        while (bson_iter_next(iter)) {
+            if (!first) {
+                _out->append(", ");
+            }
+            first = false;
+
+            if (!array) {
+                const char* key = bson_iter_key(iter);
+                const std::size_t key_length = std::strlen(key);
+                if (!utf8_validate(key, key_length, false)) {
+                    fail();
+                }
+                _out->push_back('"');
+                write_escaped(key, key_length);
+                _out->append("\" : ");
+            }
+
+            write_value(iter, depth);
+        }
+        if (iter->err_off) {
+            fail();
+        }
+
+        _out->append(array ? " ]" : " }");
+    }
+
+    void write_nested(const bson_iter_t* iter, bool array, std::size_t depth) {
+        std::uint32_t length;
+        const std::uint8_t* data;
+        if (array) {
+            bson_iter_array(iter, &length, &data);
+        } else {
+            bson_iter_document(iter, &length, &data);
+        }
+
+        if (depth >= k_max_depth) {
+            _out->append("{ ... }");
+            return;
+        }
+
+        bson_iter_t child;
+        if (!bson_iter_init_from_data(&child, data, length)) {
+            fail();
+        }
+        write_elements(&child, array, depth + 1);
+    }
+
+    void write_value(const bson_iter_t* iter, std::size_t depth) {
+        switch (bson_iter_type(iter)) {
+            case BSON_TYPE_DOUBLE:
+                write_double(bson_iter_double(iter));
+                return;
+            case BSON_TYPE_UTF8: {
+                std::uint32_t length;
+                const char* str = bson_iter_utf8(iter, &length);
+                write_string(str, length);
+                return;
+            }
+            case BSON_TYPE_DOCUMENT:
+                write_nested(iter, false, depth);
+                return;
+            case BSON_TYPE_ARRAY:
+                write_nested(iter, true, depth);
+                return;
+            case BSON_TYPE_BINARY:
+                write_binary(iter);
+                return;
+            case BSON_TYPE_UNDEFINED:
+                _out->append("{ \"$undefined\" : true }");
+                return;
+            case BSON_TYPE_OID:
+                _out->append("{ \"$oid\" : \"");
+                write_oid(bson_iter_oid(iter));
+                _out->append("\" }");
+                return;
+            case BSON_TYPE_BOOL:
+                _out->append(bson_iter_bool(iter) ? "true" : "false");
+                return;
+            case BSON_TYPE_DATE_TIME:
+                write_date(bson_iter_date_time(iter));
+                return;
+            case BSON_TYPE_NULL:
+                _out->append("null");
+                return;
+            case BSON_TYPE_REGEX:
+                write_regex(iter);
+                return;
+            case BSON_TYPE_DBPOINTER:
+                write_dbpointer(iter);
+                return;
+            case BSON_TYPE_CODE: {
+                std::uint32_t length;
+                const char* code = bson_iter_code(iter, &length);
+                _out->append("{ \"$code\" : ");
+                write_string(code, length);
+                _out->append(" }");
+                return;
+            }
+            case BSON_TYPE_SYMBOL: {
+                std::uint32_t length;
+                const char* symbol = bson_iter_symbol(iter, &length);
+                if (wrapped()) {
+                    _out->append("{ \"$symbol\" : ");
+                }
+                write_string(symbol, length);
+                if (wrapped()) {
+                    _out->append(" }");
+                }
+                return;
+            }
+            case BSON_TYPE_CODEWSCOPE: {
+                std::uint32_t length;
+                std::uint32_t scope_length;
+                const std::uint8_t* scope;
+                const char* code = bson_iter_codewscope(iter, &length, &scope_length, &scope);
+                _out->append("{ \"$code\" : ");
+                write_string(code, length);
+                _out->append(", \"$scope\" : ");
+                write_root(scope, scope_length, depth + 1);
+                _out->append(" }");
+                return;
+            }
+            case BSON_TYPE_INT32:
+                write_integer(bson_iter_int32(iter), "{ \"$numberInt\" : \"");
+                return;
+            case BSON_TYPE_TIMESTAMP: {
+                std::uint32_t timestamp;
+                std::uint32_t increment;
+                bson_iter_timestamp(iter, &timestamp, &increment);
+                _out->append("{ \"$timestamp\" : { \"t\" : ");
+                append_uint32(_out, timestamp);
+                _out->append(", \"i\" : ");
+                append_uint32(_out, increment);
+                _out->append(" } }");
+                return;
+            }
+            case BSON_TYPE_INT64:
+                write_integer(bson_iter_int64(iter), "{ \"$numberLong\" : \"");
+                return;
+            case BSON_TYPE_DECIMAL128: {
+                bson_decimal128_t d128;
+                bson_iter_decimal128(iter, &d128);
+                _out->append("{ \"$numberDecimal\" : \"");
+                _out->append(decimal128{d128.high, d128.low}.to_string());
+                _out->append("\" }");
+                return;
+            }
+            case BSON_TYPE_MAXKEY:
+                _out->append("{ \"$maxKey\" : 1 }");
+                return;
+            case BSON_TYPE_MINKEY:
+                _out->append("{ \"$minKey\" : 1 }");
+                return;
+            default:
+                fail();
+        }
+    }
+
+    void write_integer(std::int64_t value, const char* wrapper) {
+        if (_mode == ExtendedJsonMode::k_canonical) {
+            _out->append(wrapper);
+            append_int64(_out, value);
+            _out->append("\" }");
+        } else {
+            append_int64(_out, value);
+        }
+    }
+
+    void write_double(double value) {
+        // Relaxed mode only wraps the values plain JSON has no numbers for.
+        const bool special = std::isnan(value) || std::isinf(value);
+        const bool wrap = _mode == ExtendedJsonMode::k_canonical ||
+                          (_mode == ExtendedJsonMode::k_relaxed && special);
+        if (!wrap) {
+            append_double(_out, value);
+            return;
+        }
+
+        _out->append("{ \"$numberDouble\" : \"");
+        if (std::isnan(value)) {
+            _out->append("NaN");
+        } else if (std::isinf(value)) {
+            _out->append(value > 0 ? "Infinity" : "-Infinity");
+        } else {
+            append_double(_out, value);
+        }
+        _out->append("\" }");
+    }
+
+    void write_date(std::int64_t ms) {
+        if (_mode == ExtendedJsonMode::k_canonical ||
+            (_mode == ExtendedJsonMode::k_relaxed && ms < 0)) {
+            _out->append("{ \"$date\" : { \"$numberLong\" : \"");
+            append_int64(_out, ms);
+            _out->append("\" } }");
+        } else if (_mode == ExtendedJsonMode::k_relaxed) {
+            _out->append("{ \"$date\" : \"");
+            append_iso_date(_out, ms);
+            _out->append("\" }");
+        } else {
+            _out->append("{ \"$date\" : ");
+            append_int64(_out, ms);
+            _out->append(" }");
+        }
+    }
+
+    void write_binary(const bson_iter_t* iter) {
+        bson_subtype_t sub_type;
+        std::uint32_t length;
+        const std::uint8_t* bytes;
+        bson_iter_binary(iter, &sub_type, &length, &bytes);
+
+        const std::size_t offset = _out->size();
+        if (wrapped()) {
+            _out->append("{ \"$binary\" : { \"base64\": \"");
+        } else {
+            _out->append("{ \"$binary\" : \"");
+        }
+
+        // Encodes straight into the output, with room for the terminator b64::ntop writes.
+        const std::size_t start = _out->size();
+        const std::size_t encoded_length = (length + 2) / 3 * 4;
+        _out->resize(start + encoded_length + 1);
+        if (b64::ntop(bytes, length, &(*_out)[start], encoded_length + 1) < 0) {
+            _out->resize(offset);
+            fail();
+        }
+        _out->resize(start + encoded_length);
+
+        if (wrapped()) {
+            _out->append("\", \"subType\" : \"");
+            append_hex_byte(_out, static_cast<std::uint8_t>(sub_type));
+            _out->append("\" } }");
+        } else {
+            _out->append("\", \"$type\" : \"");
+            append_hex_byte(_out, static_cast<std::uint8_t>(sub_type));
+            _out->append("\" }");
+        }
+    }
+
+    void write_regex(const bson_iter_t* iter) {
+        const char* options;
+        const char* pattern = bson_iter_regex(iter, &options);
+
+        if (wrapped()) {
+            _out->append("{ \"$regularExpression\" : { \"pattern\" : ");
+            write_c_string(pattern);
+            _out->append(", \"options\" : \"");
+        } else {
+            _out->append("{ \"$regex\" : ");
+            write_c_string(pattern);
+            _out->append(", \"$options\" : \"");
+        }
+
+        // libbson writes the options it knows about, in alphabetical order.
+        for (const char* option = "ilmsux"; *option; ++option) {
+            if (std::strchr(options, *option)) {
+                _out->push_back(*option);
+            }
+        }
+
+        _out->append(wrapped() ? "\" } }" : "\" }");
+    }
+
+    void write_dbpointer(const bson_iter_t* iter) {
+        std::uint32_t length;
+        const char* collection;
+        const bson_oid_t* oid;
+        bson_iter_dbpointer(iter, &length, &collection, &oid);
+
+        if (wrapped()) {
+            _out->append("{ \"$dbPointer\" : { \"$ref\" : ");
+            write_c_string(collection);
+            _out->append(", \"$id\" : { \"$oid\" : \"");
+            write_oid(oid);
+            _out->append("\" } } }");
+        } else {
+            _out->append("{ \"$ref\" : ");
+            write_c_string(collection);
+            _out->append(", \"$id\" : \"");
+            write_oid(oid);
+            _out->append("\" }");
+        }
+    }
+
+    void write_oid(const bson_oid_t* oid) {
+        for (std::uint8_t byte : oid->bytes) {
+            append_hex_byte(_out, byte);
+        }
+    }
+
+    void write_c_string(const char* str) {
+        const std::size_t length = std::strlen(str);
+        if (!utf8_validate(str, length, false)) {
+            fail();
+        }
+        _out->push_back('"');
+        write_escaped(str, length);
+        _out->push_back('"');
+    }
+
+    // Writes a string that may hold NUL bytes, which are escaped as \u0000.
+    void write_string(const char* str, std::size_t length) {
+        if (!utf8_validate(str, length, true)) {
+            fail();
+        }
+        _out->push_back('"');
+        write_escaped(str, length);
+        _out->push_back('"');
+    }
+
+    // Escapes validated UTF-8 as bson_utf8_escape_for_json does.
+    void write_escaped(const char* str, std::size_t length) {
+        std::size_t i = 0;
+        for (;;) {
+            const std::size_t special = find_special(str, i, length);
+            _out->append(str + i, special - i);
+            if (special == length) {
+                return;
+            }
+
+            const auto c = static_cast<unsigned char>(str[special]);
+            switch (c) {
+                case '"':
+                    _out->append("\\\"");
+                    break;
+                case '\\':
+                    _out->append("\\\\");
+                    break;
+                case '\b':
+                    _out->append("\\b");
+                    break;
+                case '\f':
+                    _out->append("\\f");
+                    break;
+                case '\n':
+                    _out->append("\\n");
+                    break;
+                case '\r':
+                    _out->append("\\r");
+                    break;
+                case '\t':
+                    _out->append("\\t");
+                    break;
+                case 0xC0:
+                    fail();
+                default:
+                    _out->append("\\u00");
+                    append_hex_byte(_out, c);
+                    break;
+            }
+            i = special + 1;
+        }
+    }
+
+    ExtendedJsonMode _mode;
+    std::string* _out;
+};
+
+}  // namespace
+
+void write_json(document::view view, ExtendedJsonMode mode, std::string* out) {
+    out->reserve(out->size() + view.length());
+    writer{mode, out}.write_root(view.data(), view.length(), 0);
+}
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,45 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/json.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Appends the Extended JSON text of `view` to `out`, byte for byte as bson_as_json,
+// bson_as_relaxed_extended_json or bson_as_canonical_extended_json would write it for `mode`.
+//
+// Strings are scanned for characters that need escaping a vector at a time (SSE2 where
+// available), integers are formatted directly, and only doubles with a fractional part go through
+// snprintf, whose "%.20g" output libbson's format is defined by.
+//
+// Throws bsoncxx::exception with k_failed_converting_bson_to_json if the document is corrupt or
+// holds invalid UTF-8, leaving what was appended to `out` in place.
+void write_json(document::view view, ExtendedJsonMode mode, std::string* out);
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
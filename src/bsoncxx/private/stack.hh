@@ -14,21 +14,33 @@
 
 #pragma once
 
-#include <list>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <stdexcept>
 #include <type_traits>
 
+#include <bsoncxx/allocator.hpp>
+
 #include <bsoncxx/config/private/prelude.hh>
 
 namespace bsoncxx {
 BSONCXX_INLINE_NAMESPACE_BEGIN
 
-// Note: This stack is only intended for use with the 'frame' type in
-// builder core.cpp.
+// Note: This stack is only intended for use with the 'frame' types in
+// builder core.cpp and streaming.cpp.
 template <typename T, std::size_t size>
 class stack {
    public:
-    stack() : _bucket_index(0), _bucket_size(size), _is_empty(true) {}
+    // If alloc is non-null, buckets beyond the inline object memory are carved from it rather than
+    // from operator new. The allocator must outlive the stack.
+    explicit stack(allocator* alloc = nullptr)
+        : _alloc(alloc),
+          _bucket_count(0),
+          _bucket(0),
+          _bucket_index(0),
+          _bucket_size(size),
+          _is_empty(true) {}
 
     ~stack() {
         while (!empty()) {
@@ -50,9 +62,8 @@ class stack {
             _dec();
         }
 
-        while (!_buckets.empty()) {
-            operator delete(_buckets.back());
-            _buckets.pop_back();
+        for (int i = 0; i < _bucket_count; i++) {
+            _free_bucket(_buckets[i], _bucket_capacity(i));
         }
     }
 
@@ -81,53 +92,85 @@ class stack {
     }
 
     void unsafe_reset() {
+        _bucket = 0;
         _bucket_index = 0;
-        if (!_buckets.empty()) {
-            _bucket_iter = _buckets.begin();
-        }
+        _bucket_size = size;
         _is_empty = true;
     }
 
    private:
+    // Buckets double in size, so this many hold far more frames than a builder can nest.
+    static constexpr int k_max_buckets = 32;
+
     typename std::aligned_storage<sizeof(T)>::type _object_memory[size];
 
-    std::list<T*> _buckets;
+    allocator* _alloc;
 
-    typename std::list<T*>::iterator _bucket_iter;
+    // Frames hold bson_t children that point at their parents, so they cannot be moved and the
+    // storage grows by adding buckets rather than by reallocating. The i-th bucket holds
+    // size * 2^(i + 1) objects. Buckets are kept until the stack is destroyed, so a builder that
+    // is cleared and reused nests without allocating again.
+    T* _buckets[k_max_buckets];
+    int _bucket_count;
+
+    // The bucket holding back(), when it is not in _object_memory.
+    int _bucket;
 
     int _bucket_index;
     int _bucket_size;
     bool _is_empty;
 
+    static std::size_t _bucket_capacity(int bucket) {
+        return std::size_t{size} << (bucket + 1);
+    }
+
+    T* _allocate_bucket(std::size_t count) {
+        std::size_t bytes = sizeof(T) * count;
+
+        if (!_alloc) {
+            return reinterpret_cast<T*>(operator new(bytes));
+        }
+
+        void* bucket = _alloc->allocate(bytes);
+        if (!bucket) {
+            throw std::bad_alloc{};
+        }
+
+        return reinterpret_cast<T*>(bucket);
+    }
+
+    void _free_bucket(T* bucket, std::size_t count) {
+        if (_alloc) {
+            _alloc->deallocate(bucket, sizeof(T) * count);
+        } else {
+            operator delete(bucket);
+        }
+    }
+
     T* _get_ptr() {
         if (_bucket_size == size) {
             return reinterpret_cast<T*>(_object_memory) + _bucket_index;
         } else {
-            return *(_bucket_iter) + _bucket_index;
+            return _buckets[_bucket] + _bucket_index;
         }
     }
 
     void _inc() {
         if (_bucket_index == _bucket_size - 1) {
-            _bucket_index = 0;
-            _bucket_size *= 2;
-
-            if (_buckets.empty()) {
-                // first pass at needing dynamic memory
-                _buckets.emplace_back(reinterpret_cast<T*>(operator new(
-                    sizeof(T) * static_cast<std::size_t>(_bucket_size))));
-
-                _bucket_iter = _buckets.begin();
-            } else if (_bucket_size != size * 2) {
-                // we're _not_ transitioning from stack to heap
-                auto tmp_iter = _bucket_iter;
+            // The first overflow moves from the object memory to the first bucket.
+            const int next = _bucket_size == size ? 0 : _bucket + 1;
 
-                if (++tmp_iter == _buckets.end()) {
-                    _buckets.emplace_back(reinterpret_cast<T*>(operator new(
-                        sizeof(T) * static_cast<std::size_t>(_bucket_size))));
+            if (next == _bucket_count) {
+                if (_bucket_count == k_max_buckets) {
+                    throw std::length_error{"builder nesting is too deep"};
                 }
-                ++_bucket_iter;
+                _buckets[_bucket_count] = _allocate_bucket(_bucket_capacity(_bucket_count));
+                _bucket_count++;
             }
+
+            _bucket = next;
+            _bucket_index = 0;
+            _bucket_size *= 2;
         } else {
             ++_bucket_index;
         }
@@ -141,12 +184,12 @@ class stack {
                 /* we're already in object memory */
                 _is_empty = true;
             } else {
-                /* we're on the linked list */
+                /* we're in a bucket */
                 _bucket_size /= 2;
                 _bucket_index = _bucket_size - 1;
 
-                if (_bucket_iter != _buckets.begin()) {
-                    --_bucket_iter;
+                if (_bucket != 0) {
+                    --_bucket;
                 }
             }
         } else {
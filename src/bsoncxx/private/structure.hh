@@ -0,0 +1,238 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <bsoncxx/private/element_walk.hh>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Documents nested deeper than this are reported invalid. The server accepts 100 levels.
+constexpr std::size_t k_max_structure_depth = 200;
+
+// Checks the framing of a BSON document, as validate_structure() documents it, in one pass and
+// without allocating. `on_element(offset, key_length)` is called for every top-level element,
+// in order, as it is reached, so a failure may come after some calls.
+template <typename element_fn>
+bool check_structure(const std::uint8_t* data,
+                     std::size_t length,
+                     element_fn&& on_element,
+                     std::size_t* invalid_offset) {
+    constexpr std::size_t k_oid_length = 12;
+
+    // Lengths are read unsigned, so that negative ones fail the bounds checks.
+    const auto read_length = [](const std::uint8_t* p) -> std::size_t {
+        return static_cast<std::uint32_t>(read_int32_le(p));
+    };
+
+    const auto fail = [invalid_offset](std::size_t offset) {
+        if (invalid_offset) {
+            *invalid_offset = offset;
+        }
+        return false;
+    };
+
+    if (!data || length < 5 || read_length(data) != length) {
+        return fail(0);
+    }
+    if (data[length - 1] != 0) {
+        return fail(length - 1);
+    }
+
+    // The offsets of the terminators of the documents being walked, innermost last.
+    std::size_t ends[k_max_structure_depth];
+    std::size_t depth = 0;
+    ends[depth++] = length - 1;
+
+    // Checks a length-prefixed, null-terminated string at `at`, with `available` bytes left.
+    const auto string_size = [=](std::size_t at, std::size_t available) -> std::size_t {
+        if (available < 5) {
+            return 0;
+        }
+        const std::size_t size = read_length(data + at);
+        if (size < 1 || size > available - 4 || data[at + 4 + size - 1] != 0) {
+            return 0;
+        }
+        return 4 + size;
+    };
+
+    std::size_t pos = 4;
+    while (depth > 0) {
+        const auto end = ends[depth - 1];
+        if (pos == end) {
+            depth--;
+            pos++;
+            continue;
+        }
+
+        const auto element = pos;
+        const auto t = static_cast<type>(data[pos++]);
+        const auto key_end =
+            static_cast<const std::uint8_t*>(std::memchr(data + pos, 0, end - pos));
+        if (!key_end) {
+            return fail(element);
+        }
+        const auto key_length = static_cast<std::size_t>(key_end - (data + pos));
+        pos += key_length + 1;
+        if (depth == 1) {
+            on_element(element, key_length);
+        }
+
+        const auto available = end - pos;
+        std::size_t size = 0;
+        switch (t) {
+            case type::k_bool:
+                if (available < 1 || data[pos] > 1) {
+                    return fail(element);
+                }
+                size = 1;
+                break;
+            case type::k_int32:
+                size = 4;
+                break;
+            case type::k_double:
+            case type::k_date:
+            case type::k_timestamp:
+            case type::k_int64:
+                size = 8;
+                break;
+            case type::k_oid:
+                size = k_oid_length;
+                break;
+            case type::k_decimal128:
+                size = 16;
+                break;
+            case type::k_undefined:
+            case type::k_null:
+            case type::k_maxkey:
+            case type::k_minkey:
+                break;
+            case type::k_utf8:
+            case type::k_code:
+            case type::k_symbol:
+                size = string_size(pos, available);
+                if (!size) {
+                    return fail(element);
+                }
+                break;
+            case type::k_dbpointer:
+                size = string_size(pos, available);
+                if (!size) {
+                    return fail(element);
+                }
+                size += k_oid_length;
+                break;
+            case type::k_binary: {
+                if (available < 5) {
+                    return fail(element);
+                }
+                const std::size_t binary_length = read_length(data + pos);
+                if (binary_length > available - 5) {
+                    return fail(element);
+                }
+                // The deprecated subtype nests a second length, which must match.
+                const auto deprecated =
+                    static_cast<std::uint8_t>(binary_sub_type::k_binary_deprecated);
+                if (data[pos + 4] == deprecated &&
+                    (binary_length < 4 || read_length(data + pos + 5) != binary_length - 4)) {
+                    return fail(element);
+                }
+                size = 5 + binary_length;
+                break;
+            }
+            case type::k_regex: {
+                const auto pattern_end =
+                    static_cast<const std::uint8_t*>(std::memchr(data + pos, 0, available));
+                if (!pattern_end) {
+                    return fail(element);
+                }
+                const auto options = static_cast<std::size_t>(pattern_end - data) + 1;
+                if (!std::memchr(data + options, 0, end - options)) {
+                    return fail(element);
+                }
+                size = options - pos +
+                       std::strlen(reinterpret_cast<const char*>(data + options)) + 1;
+                break;
+            }
+            case type::k_document:
+            case type::k_array:
+            case type::k_codewscope: {
+                auto document = pos;
+                auto document_available = available;
+                if (t == type::k_codewscope) {
+                    // A total length, the code string, and the scope document filling the rest.
+                    if (available < 4) {
+                        return fail(element);
+                    }
+                    const std::size_t total = read_length(data + pos);
+                    if (total < 14 || total > available) {
+                        return fail(element);
+                    }
+                    const auto code = string_size(pos + 4, total - 4);
+                    if (!code) {
+                        return fail(element);
+                    }
+                    document = pos + 4 + code;
+                    document_available = total - 4 - code;
+                    if (document_available < 5 ||
+                        read_length(data + document) != document_available) {
+                        return fail(element);
+                    }
+                }
+
+                if (document_available < 5) {
+                    return fail(element);
+                }
+                const std::size_t document_length = read_length(data + document);
+                if (document_length < 5 || document_length > document_available ||
+                    data[document + document_length - 1] != 0) {
+                    return fail(element);
+                }
+                if (depth == k_max_structure_depth) {
+                    return fail(element);
+                }
+
+                // Walk into the document. Its elements are checked before those following it.
+                ends[depth++] = document + document_length - 1;
+                pos = document + 4;
+                continue;
+            }
+            default:
+                return fail(element);
+        }
+
+        if (size > available) {
+            return fail(element);
+        }
+        pos += size;
+    }
+
+    return true;
+}
+
+}  // namespace helpers
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
@@ -0,0 +1,221 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/private/utf8.hh>
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BSONCXX_UTF8_SSE2
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BSONCXX_UTF8_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BSONCXX_UTF8_NEON
+#include <arm_neon.h>
+#endif
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+namespace {
+
+// A byte that can be accepted without decoding: ASCII, and nonzero unless NUL is allowed.
+inline bool is_plain(std::uint8_t c, bool allow_null) {
+    return c < 0x80 && (c != 0 || allow_null);
+}
+
+std::size_t plain_prefix_scalar(const std::uint8_t* p, std::size_t len, bool allow_null) {
+    std::size_t i = 0;
+    while (i < len && is_plain(p[i], allow_null)) {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(BSONCXX_UTF8_SSE2)
+std::size_t plain_prefix_sse2(const std::uint8_t* p, std::size_t len, bool allow_null) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        int stop = _mm_movemask_epi8(chunk);
+        if (!allow_null) {
+            stop |= _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+        }
+        if (stop) {
+            break;
+        }
+    }
+
+    return i + plain_prefix_scalar(p + i, len - i, allow_null);
+}
+#endif
+
+#if defined(BSONCXX_UTF8_AVX2)
+__attribute__((target("avx2"))) std::size_t plain_prefix_avx2(const std::uint8_t* p,
+                                                               std::size_t len,
+                                                               bool allow_null) {
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        int stop = _mm256_movemask_epi8(chunk);
+        if (!allow_null) {
+            stop |= _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, zero));
+        }
+        if (stop) {
+            break;
+        }
+    }
+
+    return i + plain_prefix_sse2(p + i, len - i, allow_null);
+}
+#endif
+
+#if defined(BSONCXX_UTF8_NEON)
+std::size_t plain_prefix_neon(const std::uint8_t* p, std::size_t len, bool allow_null) {
+    std::size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(p + i);
+        if (vmaxvq_u8(chunk) >= 0x80 || (!allow_null && vminvq_u8(chunk) == 0)) {
+            break;
+        }
+    }
+
+    return i + plain_prefix_scalar(p + i, len - i, allow_null);
+}
+#endif
+
+using plain_prefix_fn = std::size_t (*)(const std::uint8_t*, std::size_t, bool);
+
+plain_prefix_fn select_plain_prefix() {
+#if defined(BSONCXX_UTF8_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        return plain_prefix_avx2;
+    }
+#endif
+#if defined(BSONCXX_UTF8_SSE2)
+    return plain_prefix_sse2;
+#elif defined(BSONCXX_UTF8_NEON)
+    return plain_prefix_neon;
+#else
+    return plain_prefix_scalar;
+#endif
+}
+
+// Validates the multi-byte sequence (or disallowed NUL) at p[*pos] and advances past it.
+bool validate_sequence(const std::uint8_t* p, std::size_t len, std::size_t* pos, bool allow_null) {
+    const std::uint8_t lead = p[*pos];
+    std::size_t seq_len;
+    std::uint32_t c;
+
+    if (lead < 0x80) {
+        // is_plain() only rejects a single-byte sequence when it is a disallowed NUL.
+        return false;
+    } else if ((lead & 0xE0) == 0xC0) {
+        seq_len = 2;
+        c = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        seq_len = 3;
+        c = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        seq_len = 4;
+        c = lead & 0x07;
+    } else {
+        return false;
+    }
+
+    if (len - *pos < seq_len) {
+        return false;
+    }
+
+    for (std::size_t i = 1; i < seq_len; ++i) {
+        const std::uint8_t cont = p[*pos + i];
+        if ((cont & 0xC0) != 0x80) {
+            return false;
+        }
+        c = (c << 6) | (cont & 0x3F);
+    }
+
+    if (c > 0x10FFFF || (c & 0xFFFFF800) == 0xD800) {
+        return false;
+    }
+
+    switch (seq_len) {
+        case 2:
+            // 0xC0 0x80 is the two-byte ("modified UTF-8") encoding of NUL.
+            if (c < 0x80 && !(c == 0 && allow_null)) {
+                return false;
+            }
+            break;
+        case 3:
+            if (c < 0x800) {
+                return false;
+            }
+            break;
+        default:
+            if (c < 0x10000) {
+                return false;
+            }
+            break;
+    }
+
+    *pos += seq_len;
+    return true;
+}
+
+}  // namespace
+
+bool utf8_validate(const char* str, std::size_t len, bool allow_null) {
+    static const plain_prefix_fn plain_prefix = select_plain_prefix();
+
+    const auto p = reinterpret_cast<const std::uint8_t*>(str);
+    std::size_t pos = 0;
+
+    while (pos < len) {
+        pos += plain_prefix(p + pos, len - pos, allow_null);
+        if (pos == len) {
+            break;
+        }
+
+        if (!validate_sequence(p, len, &pos, allow_null)) {
+            return false;
+        }
+
+        // Text in non-Latin scripts is mostly multi-byte, so keep decoding sequences directly
+        // rather than re-entering the vector loop after every one of them.
+        while (pos < len && p[pos] >= 0x80) {
+            if (!validate_sequence(p, len, &pos, allow_null)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,40 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace helpers {
+
+// Returns whether the `len` bytes at `str` are valid UTF-8, accepting exactly what libbson's
+// bson_utf8_validate accepts: overlong encodings, surrogates and code points above U+10FFFF are
+// rejected, and NUL (either a zero byte or the two-byte 0xC0 0x80 form) is accepted only if
+// `allow_null` is true.
+//
+// Runs of ASCII are checked a vector at a time (AVX2 when the CPU supports it, otherwise SSE2 on
+// x86 or NEON on ARM64), so only multi-byte sequences are decoded individually.
+bool utf8_validate(const char* str, std::size_t len, bool allow_null);
+
+}  // namespace helpers
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/private/postlude.hh>
@@ -0,0 +1,197 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/projection.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+//
+// Elements copied from other documents, gathered as the body of a document so that they reach the
+// builder in a single concatenate.
+//
+class raw_elements {
+   public:
+    raw_elements() : _buffer(4) {}
+
+    void append(const std::uint8_t* bytes, std::size_t length) {
+        _buffer.insert(_buffer.end(), bytes, bytes + length);
+    }
+
+    void flush(builder::core& builder) {
+        if (_buffer.size() == 4) {
+            return;
+        }
+
+        _buffer.push_back('\0');
+        if (_buffer.size() > INT32_MAX) {
+            throw bsoncxx::exception{error_code::k_cannot_append_document};
+        }
+        const auto le_length = BSON_UINT32_TO_LE(static_cast<std::uint32_t>(_buffer.size()));
+        std::memcpy(_buffer.data(), &le_length, sizeof(le_length));
+
+        builder.concatenate(document::view{_buffer.data(), _buffer.size()});
+        _buffer.resize(4);
+    }
+
+   private:
+    std::vector<std::uint8_t> _buffer;
+};
+
+// Calls fn(element, bytes, length) for every element of a document with its encoded bytes, which
+// end where the next element, or the document's trailing null byte, begins.
+template <typename function>
+void for_each_encoded(document::view view, function fn) {
+    const auto end = view.end();
+    for (auto it = view.begin(); it != end;) {
+        const auto element = *it;
+        ++it;
+        const std::size_t next = it == end ? view.length() - 1 : it->offset();
+        fn(element, view.data() + element.offset(), next - element.offset());
+    }
+}
+
+void project_into(document::view view,
+                  const std::vector<stdx::string_view>& fields,
+                  builder::core& builder) {
+    raw_elements kept;
+    std::vector<stdx::string_view> nested;
+
+    for_each_encoded(
+        view, [&](const document::element& element, const std::uint8_t* bytes, std::size_t length) {
+            const auto key = element.key();
+            bool whole = false;
+            nested.clear();
+
+            for (auto&& field : fields) {
+                if (field == key) {
+                    whole = true;
+                    break;
+                }
+                if (field.size() > key.size() && field[key.size()] == '.' &&
+                    field.substr(0, key.size()) == key) {
+                    nested.push_back(field.substr(key.size() + 1));
+                }
+            }
+
+            if (whole) {
+                kept.append(bytes, length);
+                return;
+            }
+            if (nested.empty() || element.type() != type::k_document) {
+                return;
+            }
+
+            kept.flush(builder);
+            builder.key_view(key);
+            builder.open_document();
+            project_into(element.get_document().value, nested, builder);
+            builder.close_document();
+        });
+
+    kept.flush(builder);
+}
+
+struct encoded_element {
+    stdx::string_view key;
+    const std::uint8_t* bytes;
+    std::size_t length;
+};
+
+// The encoded elements of a document, sorted by key for lookups.
+std::vector<encoded_element> by_key(document::view view) {
+    std::vector<encoded_element> elements;
+    for_each_encoded(
+        view, [&](const document::element& element, const std::uint8_t* bytes, std::size_t length) {
+            elements.push_back({element.key(), bytes, length});
+        });
+
+    std::stable_sort(
+        elements.begin(), elements.end(), [](const encoded_element& a, const encoded_element& b) {
+            return a.key < b.key;
+        });
+    return elements;
+}
+
+// The first element with the key, or nullptr.
+const encoded_element* find(const std::vector<encoded_element>& elements, stdx::string_view key) {
+    const auto found = std::lower_bound(
+        elements.begin(), elements.end(), key, [](const encoded_element& a, stdx::string_view b) {
+            return a.key < b;
+        });
+    return found != elements.end() && found->key == key ? &*found : nullptr;
+}
+
+}  // namespace
+
+void BSONCXX_CALL project(document::view view,
+                          const std::vector<stdx::string_view>& fields,
+                          builder::core& builder) {
+    project_into(view, fields, builder);
+}
+
+document::value BSONCXX_CALL project(document::view view,
+                                     const std::vector<stdx::string_view>& fields) {
+    builder::core builder{false};
+    project_into(view, fields, builder);
+    return builder.extract_document();
+}
+
+void BSONCXX_CALL merge(document::view base, document::view overrides, builder::core& builder) {
+    const auto base_elements = by_key(base);
+    const auto override_elements = by_key(overrides);
+    raw_elements merged;
+
+    for_each_encoded(
+        base, [&](const document::element& element, const std::uint8_t* bytes, std::size_t length) {
+            if (const auto replacement = find(override_elements, element.key())) {
+                merged.append(replacement->bytes, replacement->length);
+            } else {
+                merged.append(bytes, length);
+            }
+        });
+
+    for_each_encoded(
+        overrides,
+        [&](const document::element& element, const std::uint8_t* bytes, std::size_t length) {
+            if (!find(base_elements, element.key())) {
+                merged.append(bytes, length);
+            }
+        });
+
+    merged.flush(builder);
+}
+
+document::value BSONCXX_CALL merge(document::view base, document::view overrides) {
+    builder::core builder{false};
+    merge(base, overrides, builder);
+    return builder.extract_document();
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
@@ -0,0 +1,89 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Appends the selected fields of a document to a builder, in the order in which they appear in
+/// the document.
+///
+/// The selected elements are copied as raw bytes rather than decoded and appended one value at a
+/// time, so trimming a document costs little more than copying the fields that are kept.
+///
+/// @param view
+///   The document to project.
+/// @param fields
+///   The fields to keep. A dotted path such as "a.b" keeps the field "b" of the subdocument "a",
+///   which is rebuilt with only the selected fields; if "a" is selected as well, the whole
+///   subdocument is kept. Paths through values other than documents select nothing.
+/// @param builder
+///   The builder to append the fields to, with an open document.
+///
+/// @throws bsoncxx::exception if the fields cannot be appended.
+///
+BSONCXX_API void BSONCXX_CALL project(document::view view,
+                                      const std::vector<stdx::string_view>& fields,
+                                      builder::core& builder);
+
+///
+/// Returns a document with the selected fields of another.
+///
+/// @see project(document::view, const std::vector<stdx::string_view>&, builder::core&)
+///
+BSONCXX_API document::value BSONCXX_CALL project(document::view view,
+                                                 const std::vector<stdx::string_view>& fields);
+
+///
+/// Appends the fields of two documents to a builder, the fields of the second taking precedence.
+///
+/// The fields of the first document are appended in order, with those that the second document
+/// also has replaced by its version of them; the remaining fields of the second document follow.
+/// Elements are copied as raw bytes. Subdocuments are not merged recursively.
+///
+/// @param base
+///   The document providing the defaults.
+/// @param overrides
+///   The document whose fields take precedence.
+/// @param builder
+///   The builder to append the fields to, with an open document.
+///
+/// @throws bsoncxx::exception if the fields cannot be appended.
+///
+BSONCXX_API void BSONCXX_CALL merge(document::view base,
+                                    document::view overrides,
+                                    builder::core& builder);
+
+///
+/// Returns the merge of two documents.
+///
+/// @see merge(document::view, document::view, builder::core&)
+///
+BSONCXX_API document::value BSONCXX_CALL merge(document::view base, document::view overrides);
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -0,0 +1,703 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/sort.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/decimal128.hpp>
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using types::value_view;
+
+// Below this many documents per thread, starting a thread costs more than it saves.
+constexpr std::size_t k_min_docs_per_thread = 4096;
+
+// The length of an ObjectId in bytes.
+constexpr std::size_t k_oid_length = 12;
+
+// The position of a value's type in the sort order, starting at 1 so that 0 can end the elements
+// of an encoded document or array. Types of the same order are compared by value.
+enum type_order : std::uint8_t {
+    k_order_minkey = 1,
+    k_order_undefined,
+    k_order_null,
+    k_order_number,
+    k_order_string,
+    k_order_document,
+    k_order_array,
+    k_order_binary,
+    k_order_oid,
+    k_order_bool,
+    k_order_date,
+    k_order_timestamp,
+    k_order_regex,
+    k_order_dbpointer,
+    k_order_code,
+    k_order_codewscope,
+    k_order_maxkey,
+};
+
+type_order order_of(const value_view& value) {
+    if (!value) {
+        return k_order_null;
+    }
+
+    switch (value.type()) {
+        case type::k_minkey:
+            return k_order_minkey;
+        case type::k_undefined:
+            return k_order_undefined;
+        case type::k_null:
+            return k_order_null;
+        case type::k_double:
+        case type::k_int32:
+        case type::k_int64:
+        case type::k_decimal128:
+            return k_order_number;
+        case type::k_utf8:
+        case type::k_symbol:
+            return k_order_string;
+        case type::k_document:
+            return k_order_document;
+        case type::k_array:
+            return k_order_array;
+        case type::k_binary:
+            return k_order_binary;
+        case type::k_oid:
+            return k_order_oid;
+        case type::k_bool:
+            return k_order_bool;
+        case type::k_date:
+            return k_order_date;
+        case type::k_timestamp:
+            return k_order_timestamp;
+        case type::k_regex:
+            return k_order_regex;
+        case type::k_dbpointer:
+            return k_order_dbpointer;
+        case type::k_code:
+            return k_order_code;
+        case type::k_codewscope:
+            return k_order_codewscope;
+        case type::k_maxkey:
+            return k_order_maxkey;
+    }
+    return k_order_null;
+}
+
+template <typename T>
+int three_way(const T& lhs, const T& rhs) {
+    return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+
+int compare_bytes(const void* lhs,
+                  std::size_t lhs_length,
+                  const void* rhs,
+                  std::size_t rhs_length) {
+    const auto common = std::min(lhs_length, rhs_length);
+    if (common > 0) {
+        if (const int result = std::memcmp(lhs, rhs, common)) {
+            return result < 0 ? -1 : 1;
+        }
+    }
+    return three_way(lhs_length, rhs_length);
+}
+
+int compare_strings(stdx::string_view lhs, stdx::string_view rhs) {
+    return compare_bytes(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+stdx::string_view string_of(const value_view& value) {
+    if (value.type() == type::k_symbol) {
+        return value.get_symbol().symbol;
+    }
+    return value.get_utf8().value;
+}
+
+//
+// Numbers are ordered as the pair (d, c), where d is the nearest double to the value and c is the
+// difference between an int64 and that double. Values up to 2^53 in magnitude have c == 0, and
+// beyond that every double is an integer, so the pair orders int64s and doubles exactly.
+//
+struct number {
+    bool nan;
+    double rounded;
+    std::int64_t correction;
+};
+
+number to_number(const value_view& value) {
+    number result{false, 0.0, 0};
+
+    switch (value.type()) {
+        case type::k_int32:
+            result.rounded = value.get_int32().value;
+            break;
+        case type::k_int64: {
+            const auto exact = value.get_int64().value;
+            result.rounded = static_cast<double>(exact);
+            if (result.rounded >= 9223372036854775808.0) {
+                // The nearest double to the largest int64s is 2^63, itself out of range.
+                result.correction = -static_cast<std::int64_t>(9223372036854775808ull -
+                                                               static_cast<std::uint64_t>(exact));
+            } else {
+                result.correction = exact - static_cast<std::int64_t>(result.rounded);
+            }
+            break;
+        }
+        case type::k_decimal128: {
+            const auto str = value.get_decimal128().value.to_string();
+            result.rounded = std::strtod(str.c_str(), nullptr);
+            break;
+        }
+        default:
+            result.rounded = value.get_double().value;
+            break;
+    }
+
+    if (std::isnan(result.rounded)) {
+        result.nan = true;
+        result.rounded = 0.0;
+    } else if (result.rounded == 0.0) {
+        // -0.0 and 0.0 compare equal.
+        result.rounded = 0.0;
+    }
+    return result;
+}
+
+int compare_numbers(const value_view& lhs, const value_view& rhs) {
+    const auto left = to_number(lhs);
+    const auto right = to_number(rhs);
+    if (left.nan || right.nan) {
+        return three_way(!left.nan, !right.nan);
+    }
+    if (const int result = three_way(left.rounded, right.rounded)) {
+        return result;
+    }
+    return three_way(left.correction, right.correction);
+}
+
+// Compares the elements of two documents or arrays one by one, by type, key and value.
+template <typename View>
+int compare_elements(const View& lhs, const View& rhs, bool compare_keys) {
+    auto left = lhs.begin();
+    auto right = rhs.begin();
+    for (; left != lhs.end() && right != rhs.end(); ++left, ++right) {
+        const auto left_value = left->get_value_view();
+        const auto right_value = right->get_value_view();
+        if (const int result = three_way(order_of(left_value), order_of(right_value))) {
+            return result;
+        }
+        if (compare_keys) {
+            if (const int result = compare_strings(left->key(), right->key())) {
+                return result;
+            }
+        }
+        if (const int result = compare(left_value, right_value)) {
+            return result;
+        }
+    }
+    return three_way(left != lhs.end(), right != rhs.end());
+}
+
+int compare_binaries(const types::b_binary& lhs, const types::b_binary& rhs) {
+    if (const int result = three_way(lhs.size, rhs.size)) {
+        return result;
+    }
+    const int lhs_sub_type = static_cast<int>(lhs.sub_type);
+    const int rhs_sub_type = static_cast<int>(rhs.sub_type);
+    if (const int result = three_way(lhs_sub_type, rhs_sub_type)) {
+        return result;
+    }
+    return compare_bytes(lhs.bytes, lhs.size, rhs.bytes, rhs.size);
+}
+
+int compare_oids(const oid& lhs, const oid& rhs) {
+    return compare_bytes(lhs.bytes(), k_oid_length, rhs.bytes(), k_oid_length);
+}
+
+//
+// Sort specifications.
+//
+
+struct sort_field {
+    // The first key of the path, and the keys of the embedded documents below it.
+    std::string head;
+    std::vector<std::string> tail;
+    int direction;
+};
+
+std::vector<sort_field> parse_sort(document::view sort) {
+    std::vector<sort_field> fields;
+
+    for (auto&& element : sort) {
+        int direction = 0;
+        switch (element.type()) {
+            case type::k_int32:
+                direction = element.get_int32().value;
+                break;
+            case type::k_int64:
+                direction = static_cast<int>(element.get_int64().value);
+                break;
+            case type::k_double:
+                direction = static_cast<int>(element.get_double().value);
+                break;
+            default:
+                break;
+        }
+        if (direction != 1 && direction != -1) {
+            throw bsoncxx::exception{error_code::k_invalid_sort_specification};
+        }
+
+        sort_field field;
+        field.direction = direction;
+
+        const stdx::string_view path = element.key();
+        std::size_t begin = 0;
+        while (true) {
+            const auto dot = path.find('.', begin);
+            const auto key =
+                path.substr(begin, dot == stdx::string_view::npos ? stdx::string_view::npos
+                                                                  : dot - begin)
+                    .to_string();
+            if (begin == 0) {
+                field.head = key;
+            } else {
+                field.tail.push_back(key);
+            }
+            if (dot == stdx::string_view::npos) {
+                break;
+            }
+            begin = dot + 1;
+        }
+
+        fields.push_back(std::move(field));
+    }
+
+    if (fields.empty()) {
+        throw bsoncxx::exception{error_code::k_invalid_sort_specification};
+    }
+    return fields;
+}
+
+// The value an empty array sorts by: the server keys it as undefined, which sorts between MinKey
+// and null in either direction. It is viewed in the document {"": undefined}.
+value_view empty_array_sort_value() {
+    static const std::uint8_t k_document[] = {7, 0, 0, 0, 0x06, 0, 0};
+    static const document::view undefined{k_document, sizeof(k_document)};
+    return value_view{*undefined.begin()};
+}
+
+// The value an array sorts by: its smallest element in ascending order and its largest in
+// descending order.
+value_view array_sort_value(const value_view& array, int direction) {
+    value_view chosen;
+    bool found = false;
+    for (auto&& element : array.get_array().value) {
+        const auto candidate = element.get_value_view();
+        if (!found || compare(candidate, chosen) * direction < 0) {
+            chosen = candidate;
+            found = true;
+        }
+    }
+    return found ? chosen : empty_array_sort_value();
+}
+
+// The value of a sort field, given the element found for the head of its path.
+value_view field_value(const document::element& head, const sort_field& field) {
+    value_view value;
+    if (head) {
+        value = head.get_value_view();
+    }
+
+    for (auto&& key : field.tail) {
+        if (!value || value.type() != type::k_document) {
+            return value_view{};
+        }
+        const auto next = value.get_document().value[key];
+        value = next ? next.get_value_view() : value_view{};
+    }
+
+    if (value && value.type() == type::k_array) {
+        value = array_sort_value(value, field.direction);
+    }
+    return value;
+}
+
+//
+// Normalized keys. Every encoding below is prefix-free, so that inverting the bytes of a
+// descending field inverts its order.
+//
+
+void append_big_endian(std::uint64_t value, std::size_t bytes, std::string& out) {
+    for (std::size_t i = bytes; i-- > 0;) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void append_int64(std::int64_t value, std::string& out) {
+    append_big_endian(static_cast<std::uint64_t>(value) ^ 0x8000000000000000ull, 8, out);
+}
+
+void append_double(double value, std::string& out) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits = (bits & 0x8000000000000000ull) ? ~bits : bits ^ 0x8000000000000000ull;
+    append_big_endian(bits, 8, out);
+}
+
+// Strings end with two zero bytes, and zero bytes within them are followed by 0xFF.
+void append_string(stdx::string_view value, std::string& out) {
+    for (auto c : value) {
+        out.push_back(c);
+        if (c == '\0') {
+            out.push_back(static_cast<char>(0xFF));
+        }
+    }
+    out.push_back('\0');
+    out.push_back('\0');
+}
+
+void append_body(const value_view& value, std::string& out);
+
+void append_document(document::view doc, std::string& out) {
+    for (auto&& element : doc) {
+        const auto element_value = element.get_value_view();
+        out.push_back(static_cast<char>(order_of(element_value)));
+        append_string(element.key(), out);
+        append_body(element_value, out);
+    }
+    out.push_back('\0');
+}
+
+void append_value(const value_view& value, std::string& out);
+
+// Appends the encoding of a value without its type_order byte.
+void append_body(const value_view& value, std::string& out) {
+    switch (order_of(value)) {
+        case k_order_number: {
+            const auto n = to_number(value);
+            if (n.nan) {
+                out.push_back('\0');
+            } else {
+                out.push_back('\1');
+                append_double(n.rounded, out);
+                append_int64(n.correction, out);
+            }
+            break;
+        }
+        case k_order_string:
+            append_string(string_of(value), out);
+            break;
+        case k_order_document:
+            append_document(value.get_document().value, out);
+            break;
+        case k_order_array:
+            for (auto&& element : value.get_array().value) {
+                append_value(element.get_value_view(), out);
+            }
+            out.push_back('\0');
+            break;
+        case k_order_binary: {
+            const auto binary = value.get_binary();
+            append_big_endian(binary.size, 4, out);
+            out.push_back(static_cast<char>(binary.sub_type));
+            out.append(reinterpret_cast<const char*>(binary.bytes), binary.size);
+            break;
+        }
+        case k_order_oid: {
+            const auto id = value.get_oid().value;
+            out.append(id.bytes(), k_oid_length);
+            break;
+        }
+        case k_order_bool:
+            out.push_back(value.get_bool().value ? '\1' : '\0');
+            break;
+        case k_order_date:
+            append_int64(value.get_date().to_int64(), out);
+            break;
+        case k_order_timestamp: {
+            const auto timestamp = value.get_timestamp();
+            append_big_endian(timestamp.timestamp, 4, out);
+            append_big_endian(timestamp.increment, 4, out);
+            break;
+        }
+        case k_order_regex: {
+            const auto regex = value.get_regex();
+            append_string(regex.regex, out);
+            append_string(regex.options, out);
+            break;
+        }
+        case k_order_dbpointer: {
+            const auto pointer = value.get_dbpointer();
+            append_string(pointer.collection, out);
+            out.append(pointer.value.bytes(), k_oid_length);
+            break;
+        }
+        case k_order_code:
+            append_string(value.get_code().code, out);
+            break;
+        case k_order_codewscope: {
+            const auto code = value.get_codewscope();
+            append_string(code.code, out);
+            append_document(code.scope, out);
+            break;
+        }
+        default:
+            // MinKey, undefined, null and MaxKey each have a single value.
+            break;
+    }
+}
+
+void append_value(const value_view& value, std::string& out) {
+    out.push_back(static_cast<char>(order_of(value)));
+    append_body(value, out);
+}
+
+// Encodes the sort keys of many documents. Not thread-safe: extraction reuses a scratch buffer.
+class key_encoder {
+   public:
+    explicit key_encoder(const std::vector<sort_field>& fields) : _fields(fields) {
+        for (auto&& field : _fields) {
+            _heads.emplace_back(field.head);
+        }
+        _elements.resize(_fields.size());
+    }
+
+    void append(document::view doc, std::string& out) {
+        // Every top-level field is found in a single pass over the document.
+        doc.extract(_heads.data(), _heads.size(), _elements.data());
+
+        for (std::size_t i = 0; i < _fields.size(); i++) {
+            const auto start = out.size();
+            append_value(field_value(_elements[i], _fields[i]), out);
+            if (_fields[i].direction < 0) {
+                for (auto j = start; j < out.size(); j++) {
+                    out[j] = static_cast<char>(~out[j]);
+                }
+            }
+        }
+    }
+
+   private:
+    const std::vector<sort_field>& _fields;
+    std::vector<stdx::string_view> _heads;
+    std::vector<document::element> _elements;
+};
+
+// A document's place in the input and the bytes of its key.
+struct keyed_document {
+    const char* key;
+    std::size_t length;
+    std::size_t index;
+};
+
+bool key_less(const keyed_document& lhs, const keyed_document& rhs) {
+    return compare_bytes(lhs.key, lhs.length, rhs.key, rhs.length) < 0;
+}
+
+// Runs task(0) to task(count - 1), on up to `count` threads including the calling one.
+template <typename Task>
+void run_parallel(std::size_t count, const Task& task) {
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+
+    for (std::size_t i = 1; i < count; i++) {
+        try {
+            workers.emplace_back(task, i);
+        } catch (const std::system_error&) {
+            // Out of threads: run this task here instead.
+            task(i);
+        }
+    }
+
+    if (count > 0) {
+        task(0);
+    }
+
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+}
+
+}  // namespace
+
+int BSONCXX_CALL compare(const types::value_view& lhs, const types::value_view& rhs) {
+    const auto lhs_order = order_of(lhs);
+    const auto rhs_order = order_of(rhs);
+    if (lhs_order != rhs_order) {
+        return three_way(lhs_order, rhs_order);
+    }
+
+    switch (lhs_order) {
+        case k_order_number:
+            return compare_numbers(lhs, rhs);
+        case k_order_string:
+            return compare_strings(string_of(lhs), string_of(rhs));
+        case k_order_document:
+            return compare_elements(lhs.get_document().value, rhs.get_document().value, true);
+        case k_order_array:
+            return compare_elements(lhs.get_array().value, rhs.get_array().value, false);
+        case k_order_binary:
+            return compare_binaries(lhs.get_binary(), rhs.get_binary());
+        case k_order_oid:
+            return compare_oids(lhs.get_oid().value, rhs.get_oid().value);
+        case k_order_bool:
+            return three_way(lhs.get_bool().value, rhs.get_bool().value);
+        case k_order_date:
+            return three_way(lhs.get_date().to_int64(), rhs.get_date().to_int64());
+        case k_order_timestamp: {
+            const auto left = lhs.get_timestamp();
+            const auto right = rhs.get_timestamp();
+            if (const int result = three_way(left.timestamp, right.timestamp)) {
+                return result;
+            }
+            return three_way(left.increment, right.increment);
+        }
+        case k_order_regex: {
+            const auto left = lhs.get_regex();
+            const auto right = rhs.get_regex();
+            if (const int result = compare_strings(left.regex, right.regex)) {
+                return result;
+            }
+            return compare_strings(left.options, right.options);
+        }
+        case k_order_dbpointer: {
+            const auto left = lhs.get_dbpointer();
+            const auto right = rhs.get_dbpointer();
+            if (const int result = compare_strings(left.collection, right.collection)) {
+                return result;
+            }
+            return compare_oids(left.value, right.value);
+        }
+        case k_order_code:
+            return compare_strings(lhs.get_code().code, rhs.get_code().code);
+        case k_order_codewscope: {
+            const auto left = lhs.get_codewscope();
+            const auto right = rhs.get_codewscope();
+            if (const int result = compare_strings(left.code, right.code)) {
+                return result;
+            }
+            return compare_elements(left.scope, right.scope, true);
+        }
+        default:
+            // MinKey, undefined, null and MaxKey each have a single value.
+            return 0;
+    }
+}
+
+int BSONCXX_CALL compare(document::view lhs, document::view rhs, document::view sort) {
+    for (auto&& field : parse_sort(sort)) {
+        const auto left = field_value(lhs[field.head], field);
+        const auto right = field_value(rhs[field.head], field);
+        if (const int result = compare(left, right)) {
+            return result * field.direction;
+        }
+    }
+    return 0;
+}
+
+std::string BSONCXX_CALL sort_key(document::view document, document::view sort) {
+    const auto fields = parse_sort(sort);
+    std::string key;
+    key_encoder{fields}.append(document, key);
+    return key;
+}
+
+void BSONCXX_CALL sort_documents(document::view* views,
+                                 std::size_t count,
+                                 document::view sort,
+                                 std::size_t max_threads) {
+    const auto fields = parse_sort(sort);
+
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::size_t num_threads = std::max<std::size_t>(
+        1, std::min(max_threads, count / k_min_docs_per_thread));
+    const std::size_t chunk = count == 0 ? 0 : (count + num_threads - 1) / num_threads;
+
+    // Each thread encodes the keys of one chunk into a buffer of its own, then sorts the chunk.
+    std::vector<std::string> buffers(num_threads);
+    std::vector<keyed_document> keyed(count);
+
+    run_parallel(num_threads, [&](std::size_t t) {
+        const auto begin = std::min(count, t * chunk);
+        const auto end = std::min(count, begin + chunk);
+
+        key_encoder encoder{fields};
+        auto& buffer = buffers[t];
+        std::vector<std::size_t> offsets;
+        offsets.reserve(end - begin + 1);
+        for (auto i = begin; i < end; i++) {
+            offsets.push_back(buffer.size());
+            encoder.append(views[i], buffer);
+        }
+        offsets.push_back(buffer.size());
+
+        // The buffer no longer grows, so pointers into it stay valid.
+        for (auto i = begin; i < end; i++) {
+            const auto offset = offsets[i - begin];
+            keyed[i] = {buffer.data() + offset, offsets[i - begin + 1] - offset, i};
+        }
+        std::stable_sort(keyed.begin() + static_cast<std::ptrdiff_t>(begin),
+                         keyed.begin() + static_cast<std::ptrdiff_t>(end),
+                         key_less);
+    });
+
+    // Merge pairs of sorted runs, doubling their width each round, until one run is left.
+    for (std::size_t width = chunk; width > 0 && width < count; width *= 2) {
+        const std::size_t merges = (count + 2 * width - 1) / (2 * width);
+        run_parallel(std::min(merges, num_threads), [&](std::size_t t) {
+            for (auto m = t; m < merges; m += num_threads) {
+                const auto begin = m * 2 * width;
+                const auto middle = std::min(count, begin + width);
+                const auto end = std::min(count, begin + 2 * width);
+                std::inplace_merge(keyed.begin() + static_cast<std::ptrdiff_t>(begin),
+                                   keyed.begin() + static_cast<std::ptrdiff_t>(middle),
+                                   keyed.begin() + static_cast<std::ptrdiff_t>(end),
+                                   key_less);
+            }
+        });
+    }
+
+    std::vector<document::view> sorted;
+    sorted.reserve(count);
+    for (auto&& doc : keyed) {
+        sorted.push_back(views[doc.index]);
+    }
+    std::copy(sorted.begin(), sorted.end(), views);
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
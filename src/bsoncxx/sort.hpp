@@ -0,0 +1,132 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types/value_view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Compares two BSON values in the order in which the server sorts them without a collation.
+///
+/// Values are ordered first by type: MinKey, undefined, null, numbers, strings and symbols,
+/// documents, arrays, binary data, ObjectIds, booleans, dates, timestamps, regular expressions,
+/// DBPointers, JavaScript code, code with scope and MaxKey. Numbers of any type compare by value,
+/// with NaN before every other number; decimal128 values are approximated by the nearest double.
+/// Strings compare byte by byte, and documents and arrays element by element.
+///
+/// @param lhs
+///   The first value. An empty value_view stands for a missing field and compares like null.
+/// @param rhs
+///   The second value.
+///
+/// @return A negative number, zero or a positive number as `lhs` sorts before, with or after
+///   `rhs`.
+///
+BSONCXX_API int BSONCXX_CALL compare(const types::value_view& lhs, const types::value_view& rhs);
+
+///
+/// Compares two documents by the fields of a sort specification, as the server would order them.
+///
+/// @param lhs
+///   The first document.
+/// @param rhs
+///   The second document.
+/// @param sort
+///   A sort specification such as {a: 1, "b.c": -1}. A dotted path selects a field of an
+///   embedded document; a path through a value other than a document selects nothing, like a
+///   missing field. An array field sorts by its smallest element in ascending order and by its
+///   largest in descending order; an empty array sorts like undefined, before null.
+///
+/// @return A negative number, zero or a positive number as `lhs` sorts before, with or after
+///   `rhs`.
+///
+/// @throws bsoncxx::exception with error_code::k_invalid_sort_specification if `sort` is empty or
+/// a direction is not 1 or -1.
+///
+BSONCXX_API int BSONCXX_CALL compare(document::view lhs,
+                                     document::view rhs,
+                                     document::view sort);
+
+///
+/// Encodes the sort fields of a document as a normalized key: comparing the keys of two documents
+/// with std::memcmp, shorter keys first on a common prefix, orders them as compare() does.
+///
+/// Keys are meant to be compared in memory, e.g. to sort or index documents repeatedly by the same
+/// fields. Their format may change between releases, so they should not be stored.
+///
+/// @param document
+///   The document to encode the sort fields of.
+/// @param sort
+///   The sort specification, see compare(document::view, document::view, document::view).
+///
+/// @return The key, as bytes.
+///
+/// @throws bsoncxx::exception with error_code::k_invalid_sort_specification if the
+/// specification is invalid.
+///
+BSONCXX_API std::string BSONCXX_CALL sort_key(document::view document, document::view sort);
+
+///
+/// Sorts documents by a sort specification, spreading the work across multiple threads.
+///
+/// The sort fields of each document are first encoded, once, into a normalized key (see
+/// sort_key()) in a flat buffer, so that the sort itself only compares bytes. Contiguous chunks of
+/// the documents are then sorted on separate threads and merged. The sort is stable: documents
+/// that compare equal keep their relative order.
+///
+/// @param views
+///   The documents to sort, in place. Only the views are moved; the documents they point to are
+///   left untouched.
+/// @param count
+///   The number of documents in `views`.
+/// @param sort
+///   The sort specification, see compare(document::view, document::view, document::view).
+/// @param max_threads
+///   The maximum number of threads to use, including the calling thread. If 0, up to
+///   std::thread::hardware_concurrency() threads are used. Small batches are sorted on the calling
+///   thread alone.
+///
+/// @throws bsoncxx::exception with error_code::k_invalid_sort_specification if the
+/// specification is invalid.
+///
+BSONCXX_API void BSONCXX_CALL sort_documents(document::view* views,
+                                             std::size_t count,
+                                             document::view sort,
+                                             std::size_t max_threads = 0);
+
+///
+/// Sorts documents by a sort specification, spreading the work across multiple threads.
+///
+/// @see sort_documents(document::view*, std::size_t, document::view, std::size_t)
+///
+BSONCXX_INLINE void sort_documents(std::vector<document::view>& views,
+                                   document::view sort,
+                                   std::size_t max_threads = 0) {
+    sort_documents(views.data(), views.size(), sort, max_threads);
+}
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -0,0 +1,118 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace string {
+
+///
+/// Class representing a non-owning view of a string that is known to be null-terminated.
+///
+/// The driver passes names such as those of databases, collections and indexes to libmongoc as
+/// null-terminated strings. A string::view_or_value built from a plain string_view cannot tell
+/// whether the character after the view is a terminator, so string::view_or_value::terminated()
+/// copies the view into a new std::string. A view_or_value built from a terminated_view instead
+/// remembers that its view is terminated, and is passed on without a copy.
+///
+/// A terminated_view can be built from a string literal at compile time, and from other
+/// null-terminated strings at run-time:
+///
+/// @code
+///   constexpr bsoncxx::string::terminated_view k_events{"events"};
+///   auto coll = client["app"][k_events];
+/// @endcode
+///
+/// @note
+///   Like any view, a terminated_view must not outlive the string it views.
+///
+class terminated_view {
+   public:
+    ///
+    /// Constructs a view of an empty string.
+    ///
+    constexpr terminated_view() noexcept : _data{""}, _size{0} {}
+
+    ///
+    /// Constructs a view of a string literal, or of another character array holding a string of
+    /// its full length.
+    ///
+    template <std::size_t n>
+    constexpr terminated_view(const char (&literal)[n]) noexcept
+        : _data{literal}, _size{n - 1} {}
+
+    ///
+    /// Constructs a view of a std::string, whose characters are always followed by a terminator.
+    ///
+    terminated_view(const std::string& str) noexcept : _data{str.c_str()}, _size{str.size()} {}
+
+    ///
+    /// Constructs a view of a null-terminated string whose length is computed at run-time.
+    ///
+    /// @param str
+    ///   A null-terminated string.
+    ///
+    /// @return A view of the string.
+    ///
+    static terminated_view from_c_str(const char* str) noexcept {
+        return terminated_view{str, std::strlen(str)};
+    }
+
+    ///
+    /// @return A pointer to the null-terminated characters of the string.
+    ///
+    constexpr const char* c_str() const noexcept {
+        return _data;
+    }
+
+    ///
+    /// @return The length of the string, not counting the terminator.
+    ///
+    constexpr std::size_t size() const noexcept {
+        return _size;
+    }
+
+    ///
+    /// @return A string_view of the string.
+    ///
+    stdx::string_view view() const noexcept {
+        return stdx::string_view{_data, _size};
+    }
+
+    operator stdx::string_view() const noexcept {
+        return view();
+    }
+
+   private:
+    constexpr terminated_view(const char* data, std::size_t size) noexcept
+        : _data{data}, _size{size} {}
+
+    const char* _data;
+    std::size_t _size;
+};
+
+}  // namespace string
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -23,6 +23,12 @@ BSONCXX_INLINE_NAMESPACE_BEGIN
 namespace string {
 
 view_or_value view_or_value::terminated() const {
+    // A view that is known to be terminated can be shared as it is. The view of a moved-from
+    // object may have no characters at all, so it is copied like any other view.
+    if (_terminated && view().data()) {
+        return *this;
+    }
+
     // If we do not own our string, we cannot guarantee that it is null-terminated,
     // so make an owned copy.
     if (!is_owning()) {
@@ -30,7 +36,9 @@ view_or_value view_or_value::terminated() const {
     }
 
     // If we are owning, return a view_or_value viewing our string
-    return {view()};
+    view_or_value result{view()};
+    result._terminated = true;
+    return result;
 }
 
 const char* view_or_value::data() const {
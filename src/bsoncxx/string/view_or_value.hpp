@@ -17,6 +17,7 @@
 #include <string>
 
 #include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/string/terminated_view.hpp>
 #include <bsoncxx/view_or_value.hpp>
 
 #include <bsoncxx/config/prelude.hpp>
@@ -31,6 +32,7 @@ namespace string {
 /// This class adds several string-specific methods to the bsoncxx::view_or_value template:
 /// - a constructor overload for const char*
 /// - a constructor overload for std::string by l-value reference
+/// - a constructor overload for string::terminated_view
 /// - a safe c_str() operation to return null-terminated c-style strings.
 ///
 class BSONCXX_API view_or_value : public bsoncxx::view_or_value<stdx::string_view, std::string> {
@@ -53,7 +55,8 @@ class BSONCXX_API view_or_value : public bsoncxx::view_or_value<stdx::string_vie
     /// @param str A null-terminated string
     ///
     BSONCXX_INLINE view_or_value(const char* str)
-        : bsoncxx::view_or_value<stdx::string_view, std::string>(stdx::string_view(str)) {}
+        : bsoncxx::view_or_value<stdx::string_view, std::string>(stdx::string_view(str)),
+          _terminated{true} {}
 
     ///
     /// Allow construction with an l-value reference to a std::string. The resulting
@@ -68,6 +71,15 @@ class BSONCXX_API view_or_value : public bsoncxx::view_or_value<stdx::string_vie
     BSONCXX_INLINE view_or_value(const std::string& str)
         : bsoncxx::view_or_value<stdx::string_view, std::string>(stdx::string_view(str)) {}
 
+    ///
+    /// Construct a string::view_or_value viewing a terminated_view. The resulting view_or_value
+    /// knows that its string is null-terminated, so terminated() does not copy it.
+    ///
+    /// @param str A terminated_view, whose string must outlive this object.
+    ///
+    BSONCXX_INLINE view_or_value(terminated_view str)
+        : bsoncxx::view_or_value<stdx::string_view, std::string>(str.view()), _terminated{true} {}
+
     ///
     /// Return a string_view_or_value that is guaranteed to hold a null-terminated
     /// string. The lifetime of the returned object must be a subset of this object's
@@ -76,6 +88,10 @@ class BSONCXX_API view_or_value : public bsoncxx::view_or_value<stdx::string_vie
     /// It is recommended that this method be used before calling .data() on a
     /// view_or_value, as that method may return a non-null-terminated string.
     ///
+    /// A view constructed from a const char* or a terminated_view is known to be null-terminated,
+    /// and is returned without copying its string. Other views are copied, so that the returned
+    /// object does not change along with a std::string that it was constructed from.
+    ///
     /// @return A new view_or_value object.
     ///
     view_or_value terminated() const;
@@ -88,6 +104,10 @@ class BSONCXX_API view_or_value : public bsoncxx::view_or_value<stdx::string_vie
     /// @return A const char* of this string.
     ///
     const char* data() const;
+
+   private:
+    // Whether the character after the view is known to be a terminator.
+    bool _terminated = false;
 };
 
 ///
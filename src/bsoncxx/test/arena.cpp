@@ -0,0 +1,101 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <bsoncxx/arena.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/test_util/catch.hh>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_document;
+
+TEST_CASE("arena carves aligned allocations out of shared blocks", "[bsoncxx::arena]") {
+    arena memory{1024};
+    REQUIRE(memory.bytes_reserved() == 0);
+
+    auto first = static_cast<std::uint8_t*>(memory.allocate(3));
+    auto second = static_cast<std::uint8_t*>(memory.allocate(5));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) % alignof(long double) == 0);
+    REQUIRE(second > first);
+    REQUIRE(memory.bytes_reserved() == 1024);
+
+    SECTION("a request larger than a block gets its own") {
+        memory.allocate(4096);
+        REQUIRE(memory.bytes_reserved() == 1024 + 4096);
+
+        memory.clear();
+        REQUIRE(memory.bytes_reserved() == 1024);
+    }
+
+    SECTION("a new block is started when the current one is full") {
+        memory.allocate(1000);
+        REQUIRE(memory.bytes_reserved() == 2048);
+    }
+
+    SECTION("clear frees everything and reuses the blocks") {
+        memory.clear();
+        REQUIRE(memory.bytes_used() == 0);
+        REQUIRE(memory.allocate(3) == first);
+        REQUIRE(memory.bytes_reserved() == 1024);
+    }
+}
+
+TEST_CASE("document::value copies into an arena", "[bsoncxx::document::value]") {
+    arena memory;
+
+    std::vector<document::value> replies;
+    for (std::int32_t i = 0; i < 200; i++) {
+        replies.push_back(make_document(kvp("_id", i), kvp("name", "reply")));
+    }
+
+    std::vector<document::value> copies;
+    for (auto&& reply : replies) {
+        copies.push_back(reply.copy_into(memory));
+    }
+    copies.emplace_back(replies.front().view(), memory);
+
+    REQUIRE(memory.bytes_used() >= 201 * replies.front().view().length());
+    for (std::size_t i = 0; i < replies.size(); i++) {
+        REQUIRE(copies[i] == replies[i]);
+        REQUIRE(copies[i].view().data() != replies[i].view().data());
+    }
+    REQUIRE(copies.back() == replies.front());
+
+    copies.clear();
+    memory.clear();
+    REQUIRE(memory.bytes_used() == 0);
+}
+
+TEST_CASE("builders can draw their memory from an arena", "[bsoncxx::arena]") {
+    arena memory;
+    {
+        builder::basic::document builder{memory};
+        builder.append(kvp("a", 1), kvp("b", "two"));
+        auto doc = builder.extract();
+
+        REQUIRE(doc.view()["b"].get_utf8().value == stdx::string_view{"two"});
+        REQUIRE(memory.bytes_used() > 0);
+    }
+    memory.clear();
+}
+
+}  // namespace
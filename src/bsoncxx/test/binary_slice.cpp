@@ -0,0 +1,95 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types/binary_slice.hpp>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_document;
+
+TEST_CASE("binary_slice shares the buffer of its document", "[bsoncxx::types::binary_slice]") {
+    std::vector<std::uint8_t> payload(1024);
+    for (std::size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<std::uint8_t>(i);
+    }
+    types::b_binary binary{binary_sub_type::k_user, static_cast<std::uint32_t>(payload.size()),
+                           payload.data()};
+
+    auto doc = make_document(kvp("n", 1), kvp("nested", make_document(kvp("data", binary))));
+    const auto bytes = doc.view()["nested"]["data"].get_binary().bytes;
+
+    SECTION("a slice points into the moved document") {
+        auto element = doc.view()["nested"]["data"];
+        types::binary_slice slice{std::move(doc), element};
+
+        REQUIRE(slice.bytes() == bytes);
+        REQUIRE(slice.size() == payload.size());
+        REQUIRE(slice.sub_type() == binary_sub_type::k_user);
+        REQUIRE(slice.view() == binary);
+        REQUIRE(slice.owner().use_count() == 1);
+
+        auto part = slice.slice(100, 200);
+        REQUIRE(part.bytes() == bytes + 100);
+        REQUIRE(part.size() == 200);
+        REQUIRE(part.sub_type() == binary_sub_type::k_user);
+        REQUIRE(slice.owner().use_count() == 2);
+
+        REQUIRE(slice.slice(payload.size(), 0).size() == 0);
+        REQUIRE_THROWS_AS(slice.slice(1000, 25), bsoncxx::exception);
+        REQUIRE_THROWS_AS(slice.slice(1025, 0), bsoncxx::exception);
+    }
+
+    SECTION("a slice outlives its document on another thread") {
+        auto owner = std::make_shared<const document::value>(std::move(doc));
+        types::binary_slice slice{owner, owner->view()["nested"]["data"]};
+        owner.reset();
+
+        bool same = false;
+        std::thread reader{[&same, &payload](types::binary_slice moved) {
+                               same = moved.view() == types::b_binary{binary_sub_type::k_user,
+                                                                      1024,
+                                                                      payload.data()};
+                           },
+                           slice.slice(0, slice.size())};
+        slice = types::binary_slice{};
+        reader.join();
+
+        REQUIRE(same);
+        REQUIRE(slice.bytes() == nullptr);
+        REQUIRE(slice.size() == 0);
+    }
+
+    SECTION("only binary elements of the owner can be sliced") {
+        auto owner = std::make_shared<const document::value>(std::move(doc));
+        REQUIRE_THROWS_AS((types::binary_slice{owner, owner->view()["n"]}), bsoncxx::exception);
+
+        auto other = make_document(kvp("data", binary));
+        REQUIRE_THROWS_AS((types::binary_slice{owner, other.view()["data"]}), bsoncxx::exception);
+        REQUIRE_THROWS_AS((types::binary_slice{nullptr, other.view()["data"]}),
+                          bsoncxx::exception);
+    }
+}
+
+}  // namespace
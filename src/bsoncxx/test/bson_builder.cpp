@@ -12,13 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <cstring>
+#include <sstream>
+#include <vector>
 
+#include <bsoncxx/allocator.hpp>
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/builder/fixed.hpp>
 #include <bsoncxx/builder/stream/array.hpp>
 #include <bsoncxx/builder/stream/document.hpp>
+#include <bsoncxx/builder/streaming.hpp>
 #include <bsoncxx/exception/exception.hpp>
 #include <bsoncxx/json.hpp>
 #include <bsoncxx/private/libbson.hh>
@@ -649,6 +655,23 @@ TEST_CASE("document builder finalizes", "[bsoncxx::builder::stream]") {
     viewable_eq_viewable(expected, value);
 }
 
+TEST_CASE("document builder finalizes without copying", "[bsoncxx::builder::stream]") {
+    // Longer than the inline storage of a bson_t, which libbson copies out when it is stolen.
+    const std::string name(256, 'n');
+    const auto child = builder::stream::document{} << "x" << 1 << builder::stream::finalize;
+    const auto child_doc = builder::concatenate(child.view());
+
+    builder::stream::document stream;
+    stream << "name" << name << child_doc;
+    const std::uint8_t* data = stream.view().data();
+
+    document::value value = stream << builder::stream::finalize;
+
+    REQUIRE(value.view().data() == data);
+    REQUIRE(value.view()["name"].get_utf8().value == stdx::string_view{name});
+    REQUIRE(value.view()["x"].get_int32().value == 1);
+}
+
 TEST_CASE("array builder finalizes", "[bsoncxx::builder::stream]") {
     builder::stream::array expected;
 
@@ -1234,4 +1257,426 @@ TEST_CASE("builder::stream::document throws on consecutive keys", "[bsoncxx::bui
     REQUIRE_NOTHROW(doc << "far");
     REQUIRE_THROWS_AS(doc << "boo", bsoncxx::exception);
 }
+
+class counting_allocator : public bsoncxx::allocator {
+   public:
+    void* allocate(std::size_t size) override {
+        ++allocations;
+        outstanding += size;
+        return operator new(size);
+    }
+
+    void deallocate(void* ptr, std::size_t size) noexcept override {
+        outstanding -= size;
+        operator delete(ptr);
+    }
+
+    std::size_t allocations = 0;
+    std::size_t outstanding = 0;
+};
+
+TEST_CASE("core builder draws memory from a user allocator", "[bsoncxx::builder::core]") {
+    counting_allocator alloc;
+
+    auto build = [](builder::core& b) {
+        b.key_view("a").append(1);
+
+        // Nest deeper than the builder's inline frame storage so that heap buckets are used.
+        for (int i = 0; i < 10; ++i) {
+            b.key_view("nested").open_document();
+        }
+        b.key_view("s").append("a string long enough to force the root buffer to grow once.....");
+        for (int i = 0; i < 10; ++i) {
+            b.close_document();
+        }
+    };
+
+    builder::core expected(false);
+    build(expected);
+
+    {
+        builder::core b(false, alloc);
+        build(b);
+
+        REQUIRE(alloc.allocations > 0);
+        REQUIRE(b.view_document() == expected.view_document());
+
+        auto value = b.extract_document();
+        REQUIRE(value.view() == expected.view_document());
+
+        SECTION("the builder remains usable after extraction") {
+            build(b);
+            auto second = b.extract_document();
+            REQUIRE(second.view() == expected.view_document());
+        }
+    }
+
+    REQUIRE(alloc.outstanding == 0);
+}
+
+TEST_CASE("basic and stream documents accept a user allocator", "[bsoncxx::builder::basic]") {
+    using namespace builder::basic;
+    counting_allocator alloc;
+
+    {
+        builder::basic::document basic{alloc};
+        basic.append(kvp("hello", "world"));
+
+        builder::stream::document stream{alloc};
+        stream << "hello"
+               << "world";
+
+        viewable_eq_viewable(stream, basic);
+
+        auto value = basic.extract();
+        REQUIRE(alloc.outstanding > 0);
+    }
+
+    REQUIRE(alloc.outstanding == 0);
+}
+
+TEST_CASE("core builder reserve and retain_capacity", "[bsoncxx::builder::core]") {
+    auto build = [](builder::core& b) {
+        for (std::int32_t i = 0; i < 100; ++i) {
+            b.key_owned("field" + std::to_string(i)).append(i);
+        }
+    };
+
+    builder::core expected(false);
+    build(expected);
+
+    SECTION("reserve does not change the contents") {
+        builder::core b(false);
+        b.key_view("a").append(1);
+        b.reserve(4096);
+        b.key_view("b").append(2);
+
+        auto doc = b.view_document();
+        REQUIRE(doc["a"].get_int32().value == 1);
+        REQUIRE(doc["b"].get_int32().value == 2);
+    }
+
+    SECTION("reserve throws while a subdocument is open") {
+        builder::core b(false);
+        b.key_view("a").open_document();
+        REQUIRE_THROWS_AS(b.reserve(4096), bsoncxx::exception);
+    }
+
+    SECTION("retained buffers are reused across extractions") {
+        counting_allocator alloc;
+        builder::core b(false, alloc);
+        b.retain_capacity(true);
+        b.reserve(4096);
+
+        build(b);
+        auto first = b.extract_document();
+        std::size_t allocations = alloc.allocations;
+
+        build(b);
+        auto second = b.extract_document();
+
+        // Only the exactly-sized copy handed to the caller was allocated.
+        REQUIRE(alloc.allocations == allocations + 1);
+        REQUIRE(first.view() == expected.view_document());
+        REQUIRE(second.view() == expected.view_document());
+    }
+
+    SECTION("deeply nested frames are reused across extractions") {
+        auto build_nested = [](builder::core& b) {
+            for (int i = 0; i < 40; ++i) {
+                b.key_view("nested").open_document();
+            }
+            b.key_view("x").append(1);
+            for (int i = 0; i < 40; ++i) {
+                b.close_document();
+            }
+        };
+
+        builder::core nested_expected(false);
+        build_nested(nested_expected);
+
+        counting_allocator alloc;
+        builder::core b(false, alloc);
+        b.retain_capacity(true);
+        b.reserve(4096);
+
+        build_nested(b);
+        auto first = b.extract_document();
+        std::size_t allocations = alloc.allocations;
+
+        build_nested(b);
+        auto second = b.extract_document();
+
+        REQUIRE(alloc.allocations == allocations + 1);
+        REQUIRE(first.view() == nested_expected.view_document());
+        REQUIRE(second.view() == nested_expected.view_document());
+    }
+
+    SECTION("retain_capacity works with the default allocator") {
+        builder::basic::document b;
+        b.retain_capacity(true);
+
+        for (int i = 0; i < 3; ++i) {
+            b.append(builder::basic::kvp("i", i));
+            auto value = b.extract();
+            REQUIRE(value.view()["i"].get_int32().value == i);
+        }
+        REQUIRE(b.view().empty());
+    }
+}
+
+TEST_CASE("builder::fixed encodes the same bytes as the basic builder", "[builder::fixed]") {
+    using builder::basic::kvp;
+    using builder::basic::make_document;
+
+    const std::uint8_t bytes[] = {1, 2, 3};
+    const types::b_binary payload{binary_sub_type::k_binary, 3, bytes};
+    const types::b_date ts{std::chrono::milliseconds{1234567890123}};
+    const oid id;
+    auto sub = make_document(kvp("nested", true));
+
+    builder::fixed<oid,
+                   types::b_date,
+                   stdx::string_view,
+                   std::int32_t,
+                   std::int64_t,
+                   double,
+                   bool,
+                   types::b_timestamp,
+                   types::b_binary,
+                   document::view>
+        event{"_id", "ts", "user", "i32", "i64", "d", "b", "t", "payload", "sub"};
+
+    auto expected = make_document(kvp("_id", id),
+                                  kvp("ts", ts),
+                                  kvp("user", "alice"),
+                                  kvp("i32", 7),
+                                  kvp("i64", std::int64_t{-8}),
+                                  kvp("d", 2.5),
+                                  kvp("b", false),
+                                  kvp("t", types::b_timestamp{3, 4}),
+                                  kvp("payload", payload),
+                                  kvp("sub", sub.view()));
+
+    for (int i = 0; i < 2; i++) {
+        auto doc = event.build(id,
+                               ts,
+                               "alice",
+                               7,
+                               -8,
+                               2.5,
+                               false,
+                               types::b_timestamp{3, 4},
+                               payload,
+                               sub.view());
+
+        INFO("expected = " << to_json(expected.view()));
+        INFO("fixed = " << to_json(doc.view()));
+        REQUIRE(doc.view().length() == expected.view().length());
+        REQUIRE(std::memcmp(doc.view().data(), expected.view().data(), doc.view().length()) == 0);
+    }
+
+    SECTION("an empty fixed builder builds an empty document") {
+        builder::fixed<> empty;
+        REQUIRE(empty.build().view() == make_document().view());
+    }
+
+    SECTION("keys with null bytes are rejected") {
+        REQUIRE_THROWS_AS(builder::fixed<std::int32_t>(std::string("a\0b", 3)), exception);
+    }
+}
+
+TEST_CASE("append_range matches appending each value", "[bsoncxx::builder::core]") {
+    using builder::basic::kvp;
+    using builder::basic::sub_array;
+
+    std::vector<double> doubles;
+    std::vector<std::int32_t> int32s;
+    std::vector<std::int64_t> int64s;
+    for (int i = 0; i < 1234; i++) {
+        doubles.push_back(i * 0.5);
+        int32s.push_back(-i);
+        int64s.push_back(std::int64_t{i} << 40);
+    }
+
+    SECTION("in a top-level array, after other values") {
+        builder::basic::array expected;
+        expected.append("first");
+        for (auto value : doubles) {
+            expected.append(value);
+        }
+        for (auto value : int32s) {
+            expected.append(value);
+        }
+        for (auto value : int64s) {
+            expected.append(value);
+        }
+
+        builder::basic::array range;
+        range.append("first");
+        range.append_range(doubles.data(), doubles.size());
+        range.append_range(int32s.data(), int32s.size());
+        range.append_range(int64s.data(), int64s.size());
+        range.append_range(int64s.data(), 0);
+
+        REQUIRE(range.view().length() == expected.view().length());
+        REQUIRE(std::memcmp(range.view().data(), expected.view().data(), range.view().length()) ==
+                0);
+    }
+
+    SECTION("in a subarray") {
+        builder::basic::document expected;
+        expected.append(kvp("values", [&](sub_array values) {
+            for (auto value : doubles) {
+                values.append(value);
+            }
+        }));
+
+        builder::basic::document range;
+        range.append(kvp("values", [&](sub_array values) {
+            values.append_range(doubles.data(), 1000);
+            values.append_range(doubles.data() + 1000, doubles.size() - 1000);
+        }));
+
+        REQUIRE(range.view() == expected.view());
+    }
+
+    SECTION("not in a document") {
+        builder::core b{false};
+        REQUIRE_THROWS_AS(b.append_range(doubles.data(), doubles.size()), bsoncxx::exception);
+    }
+}
+
+TEST_CASE("append_raw copies elements of other documents", "[bsoncxx::builder::core]") {
+    auto source = from_json(R"({
+        "d": 1.5, "s": "str", "sub": {"x": 1}, "arr": [1, "two"], "b": true, "n": null,
+        "r": {"$regex": "^a", "$options": "i"}, "l": {"$numberLong": "5"}
+    })");
+
+    SECTION("under new keys") {
+        builder::core raw{false};
+        builder::core expected{false};
+        for (auto&& element : source.view()) {
+            const std::string key = "copy_" + string::to_string(element.key());
+            raw.key_owned(key);
+            raw.append_raw(element);
+            expected.key_owned(key);
+            expected.append(element.get_value());
+        }
+        REQUIRE(raw.view_document() == expected.view_document());
+    }
+
+    SECTION("into an array") {
+        builder::core raw{true};
+        builder::core expected{true};
+        for (auto&& element : source.view()["arr"].get_array().value) {
+            raw.append_raw(element);
+            expected.append(element.get_value());
+        }
+        raw.append_raw(source.view()["sub"]);
+        expected.append(source.view()["sub"].get_value());
+        REQUIRE(raw.view_array() == expected.view_array());
+    }
+
+    SECTION("invalid elements") {
+        builder::core raw{false};
+        raw.key_view("missing");
+        REQUIRE_THROWS_AS(raw.append_raw(source.view()["missing"]), bsoncxx::exception);
+    }
+}
+
+// Collects a stream in memory and counts the patches it receives.
+class vector_sink : public builder::streaming::sink {
+   public:
+    void write(const std::uint8_t* bytes, std::size_t length) override {
+        data.insert(data.end(), bytes, bytes + length);
+    }
+
+    void patch(std::uint64_t position, const std::uint8_t* bytes, std::size_t length) override {
+        std::memcpy(data.data() + position, bytes, length);
+        patches++;
+    }
+
+    std::vector<std::uint8_t> data;
+    std::size_t patches = 0;
+};
+
+TEST_CASE("streaming builder writes the documents builder::core would", "[builder::streaming]") {
+    using builder::basic::kvp;
+    using builder::basic::make_array;
+    using builder::basic::make_document;
+
+    auto sub = make_document(kvp("x", 1));
+    const std::string long_string(300, 's');
+    auto expected =
+        make_document(kvp("a", 1),
+                      kvp("s", long_string),
+                      kvp("sub", make_document(kvp("y", 2.5), kvp("arr", make_array(1, "two")))),
+                      kvp("d", sub.view()),
+                      kvp("n", types::b_null{}));
+
+    auto write_documents = [&](builder::streaming& out) {
+        for (int i = 0; i < 3; i++) {
+            out.open_document();
+            out.key_view("a").append(types::value{types::b_int32{1}});
+            out.key_view("s").append(long_string);
+            out.key_view("sub").open_document();
+            out.key_view("y").append(types::value{types::b_double{2.5}});
+            out.key_view("arr").open_array();
+            out.append(types::value{types::b_int32{1}});
+            out.append(types::value{types::b_utf8{"two"}});
+            out.close_array();
+            out.close_document();
+            out.key_owned("d").append(sub.view());
+            out.key_view("n").append(types::value{types::b_null{}});
+            out.close_document();
+        }
+        out.flush();
+    };
+
+    auto check = [&](const std::vector<std::uint8_t>& data) {
+        const auto length = expected.view().length();
+        REQUIRE(data.size() == 3 * length);
+        for (std::size_t i = 0; i < 3; i++) {
+            REQUIRE(document::view{data.data() + i * length, length} == expected.view());
+        }
+    };
+
+    SECTION("documents that fit in a chunk are never patched") {
+        vector_sink sink;
+        builder::streaming out{sink, 1024};
+        write_documents(out);
+        REQUIRE(out.documents() == 3);
+        REQUIRE(out.size() == sink.data.size());
+        REQUIRE(sink.patches == 0);
+        check(sink.data);
+    }
+
+    SECTION("larger documents are patched through the sink") {
+        vector_sink sink;
+        builder::streaming out{sink, 64};
+        write_documents(out);
+        REQUIRE(sink.patches > 0);
+        check(sink.data);
+    }
+
+    SECTION("to a std::ostream") {
+        std::stringstream stream;
+        builder::streaming::ostream_sink sink{stream};
+        builder::streaming out{sink, 16};
+        write_documents(out);
+        const std::string str = stream.str();
+        check(std::vector<std::uint8_t>(str.begin(), str.end()));
+    }
+
+    SECTION("values need an open document") {
+        vector_sink sink;
+        builder::streaming out{sink};
+        REQUIRE_THROWS_AS(out.append(types::value{types::b_int32{1}}), bsoncxx::exception);
+        REQUIRE_THROWS_AS(out.close_document(), bsoncxx::exception);
+        out.open_document();
+        REQUIRE_THROWS_AS(out.append(types::value{types::b_int32{1}}), bsoncxx::exception);
+        REQUIRE_THROWS_AS(out.close_array(), bsoncxx::exception);
+    }
+}
 }  // namespace
@@ -0,0 +1,137 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/bson_file.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/streaming.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/validate.hpp>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_document;
+
+const std::string k_path = "bsoncxx_test_bson_file.bson";
+
+TEST_CASE("bson_file_reader reads back what bson_file_writer wrote", "[bsoncxx::bson_file]") {
+    std::vector<document::value> docs;
+    for (std::int32_t i = 0; i < 100; i++) {
+        docs.push_back(make_document(kvp("_id", i), kvp("name", "doc" + std::to_string(i))));
+    }
+
+    {
+        bson_file_writer writer{k_path, 64};
+        for (auto&& doc : docs) {
+            writer.write(doc.view());
+        }
+        writer.close();
+        REQUIRE_THROWS_AS(writer.write(docs[0].view()), bsoncxx::exception);
+    }
+
+    bson_file_reader reader{k_path};
+    REQUIRE(reader.size() > 0);
+
+    std::size_t count = 0;
+    std::size_t offset = 0;
+    for (auto it = reader.begin(); it != reader.end(); ++it) {
+        REQUIRE(*it == docs[count].view());
+        REQUIRE(it.offset() == offset);
+        offset += it->length();
+        count++;
+    }
+    REQUIRE(count == docs.size());
+    REQUIRE(offset == reader.size());
+
+    std::remove(k_path.c_str());
+}
+
+TEST_CASE("bson_file_writer is a sink for the streaming builder", "[bsoncxx::bson_file]") {
+    {
+        bson_file_writer writer{k_path, 8};
+        builder::streaming out{writer, 16};
+        out.open_document();
+        out.key_view("big").append(std::string(100, 'x'));
+        out.close_document();
+        out.flush();
+        writer.close();
+    }
+
+    bson_file_reader reader{k_path};
+    auto it = reader.begin();
+    REQUIRE(*it == make_document(kvp("big", std::string(100, 'x'))).view());
+    REQUIRE(++it == reader.end());
+
+    std::remove(k_path.c_str());
+}
+
+TEST_CASE("bson_file_reader reports bad documents", "[bsoncxx::bson_file]") {
+    auto good = make_document(kvp("a", 1));
+    auto dollar = make_document(kvp("$a", 1));
+
+    SECTION("empty files have no documents") {
+        { bson_file_writer writer{k_path}; }
+        bson_file_reader reader{k_path};
+        REQUIRE(reader.begin() == reader.end());
+    }
+
+    SECTION("a truncated document is reported at its offset") {
+        {
+            bson_file_writer writer{k_path};
+            writer.write(good.view());
+            writer.write(good.view().data(), good.view().length() - 1);
+        }
+        bson_file_reader reader{k_path};
+        auto it = reader.begin();
+        REQUIRE(it.offset() == 0);
+        try {
+            ++it;
+            FAIL("expected a truncated document");
+        } catch (const bsoncxx::exception& e) {
+            REQUIRE(e.code() == error_code::k_invalid_document_in_file);
+        }
+    }
+
+    SECTION("documents are validated when asked") {
+        {
+            bson_file_writer writer{k_path};
+            writer.write(dollar.view());
+        }
+
+        bson_file_reader unchecked{k_path};
+        REQUIRE(*unchecked.begin() == dollar.view());
+
+        validator checks;
+        checks.check_dollar_keys(true);
+        bson_file_reader checked{k_path, checks};
+        REQUIRE_THROWS_AS(checked.begin(), bsoncxx::exception);
+    }
+
+    std::remove(k_path.c_str());
+}
+
+TEST_CASE("bson_file_reader needs a readable file", "[bsoncxx::bson_file]") {
+    REQUIRE_THROWS_AS(bson_file_reader{"no/such/file.bson"}, bsoncxx::exception);
+}
+
+}  // namespace
@@ -12,14 +12,23 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <cstdint>
+#include <string>
 #include <utility>
 
+#include <bsoncxx/array/indexed_view.hpp>
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/sub_array.hpp>
 #include <bsoncxx/builder/basic/sub_document.hpp>
+#include <bsoncxx/document/fast_element.hpp>
+#include <bsoncxx/document/indexed_view.hpp>
+#include <bsoncxx/exception/exception.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types/value.hpp>
+#include <bsoncxx/types/value_view.hpp>
 
 namespace {
 using namespace bsoncxx;
@@ -340,4 +349,282 @@ TEST_CASE("CXX-1880: array element should have key") {
     REQUIRE(val.view()[2].key() == stdx::string_view("2"));
 }
 
+TEST_CASE("document::indexed_view finds the same elements as view", "[bsoncxx]") {
+    auto check_all = [](document::view doc) {
+        document::indexed_view indexed{doc};
+
+        std::size_t count = 0;
+        for (auto&& elem : doc) {
+            ++count;
+            REQUIRE(indexed.find(elem.key()) == doc.find(elem.key()));
+            REQUIRE(indexed[elem.key()].offset() == doc[elem.key()].offset());
+        }
+
+        REQUIRE(indexed.size() == count);
+        REQUIRE(indexed.find("missing") == doc.end());
+        REQUIRE(!indexed["missing"]);
+    };
+
+    SECTION("small documents") {
+        check_all(make_document().view());
+        check_all(make_document(kvp("a", 1), kvp("b", 2)).view());
+    }
+
+    SECTION("wide documents") {
+        builder::basic::document builder;
+        for (std::int32_t i = 0; i < 200; ++i) {
+            builder.append(kvp("field" + std::to_string(i), i));
+        }
+        auto value = builder.extract();
+        check_all(value.view());
+
+        document::indexed_view indexed{value.view()};
+        REQUIRE(indexed["field150"].get_int32() == 150);
+        REQUIRE(!indexed["field"]);
+        REQUIRE(!indexed["field1500"]);
+    }
+
+    SECTION("duplicate keys resolve to the first occurrence") {
+        builder::basic::document builder;
+        for (std::int32_t i = 0; i < 20; ++i) {
+            builder.append(kvp("dup", i));
+        }
+        auto value = builder.extract();
+        document::indexed_view indexed{value.view()};
+
+        REQUIRE(indexed["dup"].get_int32() == 0);
+        REQUIRE(indexed.size() == 20);
+    }
+
+    SECTION("empty key is not ignored") {
+        const auto bson = from_json(R"({ "a" : 1, "" : 2 })");
+        document::indexed_view indexed{bson.view()};
+
+        REQUIRE(indexed[""].get_int32() == 2);
+        REQUIRE(indexed.find(stdx::string_view()) != bson.view().cend());
+    }
+}
+
+TEST_CASE("array::indexed_view finds the same elements as view", "[bsoncxx]") {
+    REQUIRE(array::view{}.size() == 0);
+    REQUIRE(array::indexed_view{array::view{}}.size() == 0);
+
+    builder::basic::array builder;
+    for (std::int32_t i = 0; i < 1000; ++i) {
+        builder.append(i * 2);
+    }
+    auto value = builder.extract();
+    auto arr = value.view();
+    array::indexed_view indexed{arr};
+
+    REQUIRE(arr.size() == 1000);
+    REQUIRE(indexed.size() == 1000);
+    REQUIRE(indexed.view() == arr);
+
+    for (std::uint32_t i = 0; i < 1000; i += 37) {
+        REQUIRE(indexed.find(i) == arr.find(i));
+        REQUIRE(indexed[i].get_int32() == static_cast<std::int32_t>(i * 2));
+        REQUIRE(indexed[i].key() == arr[i].key());
+    }
+
+    REQUIRE(indexed.find(1000) == arr.end());
+    REQUIRE(!indexed[1000]);
+}
+
+TEST_CASE("document::view::extract resolves several keys at once", "[bsoncxx]") {
+    auto value = make_document(kvp("a", 1), kvp("b", 2), kvp("c", 3), kvp("a", 4), kvp("", 5));
+    auto doc = value.view();
+
+    SECTION("with a runtime key list") {
+        document::element out[4];
+        REQUIRE(doc.extract({"c", "missing", "a", ""}, out) == 3);
+
+        REQUIRE(out[0].get_int32() == 3);
+        REQUIRE(!out[1]);
+        REQUIRE(out[2].get_int32() == 1);
+        REQUIRE(out[3].get_int32() == 5);
+    }
+
+    SECTION("with a compile-time key list") {
+        std::string b{"b"};
+        auto out = doc.extract_keys("a", b, stdx::string_view{"c"});
+
+        REQUIRE(out.size() == 3);
+        REQUIRE(out[0].get_int32() == 1);
+        REQUIRE(out[1].get_int32() == 2);
+        REQUIRE(out[2].get_int32() == 3);
+    }
+
+    SECTION("on an empty document") {
+        document::element out[1];
+        REQUIRE(make_document().view().extract({"a"}, out) == 0);
+        REQUIRE(!out[0]);
+    }
+}
+
+TEST_CASE("document and array iterators step over every BSON type", "[bsoncxx]") {
+    using namespace bsoncxx::types;
+
+    const std::uint8_t bytes[] = {1, 2, 3};
+    auto scope = make_document(kvp("x", 1));
+
+    builder::basic::array values;
+    values.append(b_double{1.0},
+                  b_utf8{"string"},
+                  b_document{scope.view()},
+                  b_array{make_array(1, 2).view()},
+                  b_binary{binary_sub_type::k_binary, sizeof(bytes), bytes},
+                  b_undefined{},
+                  b_oid{oid{}},
+                  b_bool{true},
+                  b_date{std::chrono::milliseconds{12345}},
+                  b_null{},
+                  b_regex{"^foo", "i"},
+                  b_dbpointer{"collection", oid{}},
+                  b_code{"function() {}"},
+                  b_symbol{"symbol"},
+                  b_codewscope{"function() {}", scope.view()},
+                  b_int32{1},
+                  b_timestamp{1, 2},
+                  b_int64{1},
+                  b_decimal128{decimal128{"1.5"}},
+                  b_maxkey{},
+                  b_minkey{});
+    auto value = values.extract();
+
+    std::uint32_t i = 0;
+    for (auto&& elem : value.view()) {
+        REQUIRE(elem.key() == stdx::string_view{std::to_string(i)});
+        REQUIRE(elem.offset() == value.view()[i].offset());
+        ++i;
+    }
+    REQUIRE(i == 21);
+
+    builder::basic::document doc;
+    i = 0;
+    for (auto&& elem : value.view()) {
+        doc.append(kvp("k" + std::to_string(i++), elem.get_value()));
+    }
+    auto doc_value = doc.extract();
+
+    i = 0;
+    for (auto&& elem : doc_value.view()) {
+        REQUIRE(elem.type() == value.view()[i].type());
+        ++i;
+    }
+    REQUIRE(i == 21);
+}
+
+TEST_CASE("try_get returns the value only when the type matches", "[bsoncxx]") {
+    auto doc_value = make_document(kvp("i", 5), kvp("s", "str"), kvp("a", make_array(1, 2)));
+    auto doc = doc_value.view();
+
+    auto i = doc["i"].try_get<types::b_int32>();
+    REQUIRE(i);
+    REQUIRE(i->value == 5);
+    REQUIRE(!doc["i"].try_get<types::b_int64>());
+    REQUIRE(!doc["i"].try_get<types::b_utf8>());
+
+    auto s = doc["s"].try_get<types::b_utf8>();
+    REQUIRE(s);
+    REQUIRE(s->value == stdx::string_view{"str"});
+
+    auto second = doc["a"][1].try_get<types::b_int32>();
+    REQUIRE(second);
+    REQUIRE(second->value == 2);
+
+    REQUIRE(!doc["missing"].try_get<types::b_int32>());
+    REQUIRE(!doc["a"][5].try_get<types::b_int32>());
+
+    REQUIRE_THROWS_AS(doc["i"].get_int64(), bsoncxx::exception);
+    REQUIRE_THROWS_AS(doc["missing"].get_int32(), bsoncxx::exception);
+}
+
+struct describe_visitor {
+    std::string operator()(const types::b_int32& v) const {
+        return "int32 " + std::to_string(v.value);
+    }
+
+    std::string operator()(const types::b_utf8& v) const {
+        return "utf8 " + std::string{v.value.data(), v.value.size()};
+    }
+
+    template <typename T>
+    std::string operator()(const T&) const {
+        return "other";
+    }
+};
+
+TEST_CASE("types::value::visit dispatches on the value's type", "[bsoncxx]") {
+    auto doc_value = make_document(kvp("i", 5), kvp("s", "str"), kvp("b", true));
+    auto doc = doc_value.view();
+
+    REQUIRE(doc["i"].get_value().visit(describe_visitor{}) == "int32 5");
+    REQUIRE(doc["s"].get_value().visit(describe_visitor{}) == "utf8 str");
+    REQUIRE(doc["b"].get_value().visit(describe_visitor{}) == "other");
+}
+
+TEST_CASE("value_view decodes values on demand", "[bsoncxx]") {
+    auto doc_value = make_document(kvp("i", 5), kvp("a", make_array("x")));
+    auto doc = doc_value.view();
+
+    auto i = doc["i"].get_value_view();
+    REQUIRE(i);
+    REQUIRE(i.type() == type::k_int32);
+    REQUIRE(i.get_int32() == 5);
+    REQUIRE(i.try_get<types::b_int32>());
+    REQUIRE(!i.try_get<types::b_double>());
+    REQUIRE_THROWS_AS(i.get_double(), bsoncxx::exception);
+    REQUIRE(i.get_value() == doc["i"].get_value());
+
+    auto x = doc["a"][0].get_value_view();
+    REQUIRE(x.get_utf8().value == stdx::string_view{"x"});
+
+    types::value_view invalid;
+    REQUIRE(!invalid);
+    REQUIRE(!invalid.try_get<types::b_int32>());
+    REQUIRE_THROWS_AS(invalid.type(), bsoncxx::exception);
+}
+
+TEST_CASE("document::fast accessors decode the same values as element", "[bsoncxx]") {
+    const std::uint8_t bytes[] = {1, 2, 3, 4, 5};
+    const std::uint8_t deprecated[] = {3, 0, 0, 0, 7, 8, 9};
+    auto build_doc = make_document(
+        kvp("double", 2.5),
+        kvp("utf8", "text"),
+        kvp("document", make_document(kvp("a", 1))),
+        kvp("array", make_array(1, 2)),
+        kvp("binary", types::b_binary{binary_sub_type::k_user, 5, bytes}),
+        kvp("deprecated", types::b_binary{binary_sub_type::k_binary_deprecated, 7, deprecated}),
+        kvp("oid", types::b_oid{oid{}}),
+        kvp("bool", true),
+        kvp("date", types::b_date{std::chrono::milliseconds{-1234567}}),
+        kvp("int32", -7),
+        kvp("timestamp", types::b_timestamp{5, 6}),
+        kvp("int64", -(std::int64_t{1} << 40)));
+    auto doc = build_doc.view();
+
+    for (auto&& e : doc) {
+        REQUIRE(document::fast::type(e) == e.type());
+        REQUIRE(document::fast::key(e) == e.key());
+    }
+
+    REQUIRE(document::fast::get_double(doc["double"]) == doc["double"].get_double());
+    REQUIRE(document::fast::get_utf8(doc["utf8"]) == doc["utf8"].get_utf8());
+    REQUIRE(document::fast::get_document(doc["document"]) == doc["document"].get_document());
+    REQUIRE(document::fast::get_array(doc["array"]) == doc["array"].get_array());
+    REQUIRE(document::fast::get_binary(doc["binary"]) == doc["binary"].get_binary());
+    REQUIRE(document::fast::get_binary(doc["deprecated"]) == doc["deprecated"].get_binary());
+    REQUIRE(document::fast::get_oid(doc["oid"]) == doc["oid"].get_oid());
+    REQUIRE(document::fast::get_bool(doc["bool"]) == doc["bool"].get_bool());
+    REQUIRE(document::fast::get_date(doc["date"]) == doc["date"].get_date());
+    REQUIRE(document::fast::get_int32(doc["int32"]) == doc["int32"].get_int32());
+    REQUIRE(document::fast::get_timestamp(doc["timestamp"]) == doc["timestamp"].get_timestamp());
+    REQUIRE(document::fast::get_int64(doc["int64"]) == doc["int64"].get_int64());
+
+    REQUIRE_THROWS_AS(document::fast::get_int32(doc["int64"]), bsoncxx::exception);
+    REQUIRE_THROWS_AS(document::fast::get_utf8(doc["missing"]), bsoncxx::exception);
+    REQUIRE_THROWS_AS(document::fast::type(doc["missing"]), bsoncxx::exception);
+}
+
 }  // namespace
@@ -13,12 +13,14 @@
 // limitations under the License.
 
 #include <chrono>
+#include <string>
 
 #include <bsoncxx/types.hpp>
 #include <bsoncxx/types/value.hpp>
 
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/exception/exception.hpp>
 #include <bsoncxx/stdx/string_view.hpp>
 #include <bsoncxx/test_util/catch.hh>
 
@@ -97,6 +99,54 @@ TEST_CASE("b_oid", "[bsoncxx::type::b_oid]") {
     REQUIRE(!(a == c));
 }
 
+TEST_CASE("oid hex conversions", "[bsoncxx::oid]") {
+    const char bytes[] = "\x00\x01\x7f\x80\x9a\xbc\xde\xf0\x12\x34\xff\x56";
+    oid id{bytes, 12};
+    REQUIRE(id.to_string() == "00017f809abcdef01234ff56");
+
+    char chars[24];
+    id.to_chars(chars);
+    REQUIRE(std::string(chars, sizeof(chars)) == id.to_string());
+
+    REQUIRE(oid{stdx::string_view{"00017f809abcdef01234ff56"}} == id);
+    REQUIRE(oid{stdx::string_view{"00017F809ABCDEF01234FF56"}} == id);
+
+    REQUIRE_THROWS_AS(oid{stdx::string_view{"00017f809abcdef01234ff5"}}, bsoncxx::exception);
+    REQUIRE_THROWS_AS(oid{stdx::string_view{"00017f809abcdef01234ff5g"}}, bsoncxx::exception);
+    REQUIRE_THROWS_AS(oid{stdx::string_view{"00017f809abcdef0 234ff56"}}, bsoncxx::exception);
+}
+
+TEST_CASE("decimal128 string conversions", "[bsoncxx::decimal128]") {
+    auto round_trip = [](const std::string& str) {
+        decimal128 parsed;
+        REQUIRE(decimal128::from_chars(str, &parsed));
+        REQUIRE(parsed == decimal128{str});
+
+        char chars[decimal128::k_max_string_size];
+        auto length = parsed.to_chars(chars);
+        REQUIRE(parsed.to_string() == std::string(chars, length));
+        return parsed.to_string();
+    };
+
+    REQUIRE(round_trip("0") == "0");
+    REQUIRE(round_trip("-0") == "-0");
+    REQUIRE(round_trip("12345.67") == "12345.67");
+    REQUIRE(round_trip("-0.0001") == "-0.0001");
+    REQUIRE(round_trip("1E+3") == "1E+3");
+    REQUIRE(round_trip("1.5e-10") == "1.5E-10");
+    REQUIRE(round_trip("9223372036854775807") == "9223372036854775807");
+    REQUIRE(round_trip("1234567890123456789012345678901234") ==
+            "1234567890123456789012345678901234");
+    REQUIRE(round_trip("Infinity") == "Infinity");
+    REQUIRE(round_trip("NaN") == "NaN");
+
+    decimal128 untouched{"1"};
+    REQUIRE(!decimal128::from_chars("1.2.3", &untouched));
+    REQUIRE(!decimal128::from_chars("", &untouched));
+    REQUIRE(untouched == decimal128{"1"});
+    REQUIRE_THROWS_AS(decimal128{"abc"}, bsoncxx::exception);
+}
+
 TEST_CASE("b_bool", "[bsoncxx::type::b_undefined]") {
     b_bool a{true};
     b_bool b{a};
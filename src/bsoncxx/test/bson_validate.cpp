@@ -12,13 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/builder/basic/sub_array.hpp>
 #include <bsoncxx/builder/basic/sub_document.hpp>
+#include <bsoncxx/document/indexed_view.hpp>
 #include <bsoncxx/test_util/catch.hh>
 #include <bsoncxx/validate.hpp>
 
@@ -130,4 +136,194 @@ TEST_CASE("configuring optional validations", "[bsoncxx::validate]") {
         REQUIRE(invalid_offset == std::size_t{9});
     }
 }
+
+TEST_CASE("utf8 validation checks every string value", "[bsoncxx::validate]") {
+    validator vtor{};
+    vtor.check_utf8(true);
+
+    // Long enough that the invalid bytes land past the first few vector-sized chunks.
+    const std::string ascii(100, 'a');
+
+    const auto is_valid = [&](const std::string& str) {
+        auto doc = make_document(kvp("x", 1), kvp("str", str));
+        return is_engaged(validate(doc.view().data(), doc.view().length(), vtor));
+    };
+
+    REQUIRE(is_valid(ascii));
+    REQUIRE(is_valid(""));
+    REQUIRE(is_valid(ascii + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" + ascii));
+
+    for (std::size_t pos : {0u, 15u, 16u, 31u, 32u, 63u, 99u}) {
+        std::string str = ascii;
+        str[pos] = '\xFF';
+        REQUIRE(!is_valid(str));
+        str[pos] = '\0';
+        REQUIRE(!is_valid(str));
+    }
+
+    // truncated sequence, overlong encoding, UTF-16 surrogate, beyond U+10FFFF
+    REQUIRE(!is_valid(ascii + "\xE2\x82"));
+    REQUIRE(!is_valid(ascii + "\xC1\xBF"));
+    REQUIRE(!is_valid(ascii + "\xED\xA0\x80"));
+    REQUIRE(!is_valid(ascii + "\xF4\x90\x80\x80"));
+
+    // The two-byte encoding of NUL is only accepted when null bytes are allowed.
+    REQUIRE(!is_valid(ascii + "\xC0\x80"));
+    vtor.check_utf8_allow_null(true);
+    REQUIRE(is_valid(ascii + "\xC0\x80"));
+    REQUIRE(is_valid(ascii + std::string(1, '\0') + ascii));
+}
+
+TEST_CASE("utf8 validation reports the offset of the invalid element", "[bsoncxx::validate]") {
+    validator vtor{};
+    vtor.check_utf8(true);
+
+    std::size_t invalid_offset{0u};
+
+    SECTION("at top level") {
+        auto doc = make_document(kvp("a", 1), kvp("b", "\xFF"));
+        auto view = doc.view();
+
+        REQUIRE(is_disengaged(validate(view.data(), view.length(), vtor, &invalid_offset)));
+        REQUIRE(invalid_offset == static_cast<std::size_t>(view["b"].raw() + view["b"].offset() -
+                                                           view.data()));
+    }
+
+    SECTION("in nested documents and arrays") {
+        auto doc = make_document(kvp("a", make_array(make_document(kvp("b", "\xFF")))));
+        auto view = doc.view();
+
+        REQUIRE(is_disengaged(validate(view.data(), view.length(), vtor, &invalid_offset)));
+
+        auto inner = view["a"][0]["b"];
+        REQUIRE(invalid_offset ==
+                static_cast<std::size_t>(inner.raw() + inner.offset() - view.data()));
+    }
+
+    SECTION("non-string values are not inspected") {
+        // 0xFF bytes in a binary value are not text.
+        const std::uint8_t bytes[] = {0xFF, 0xFF, 0xFF};
+        auto doc = make_document(
+            kvp("bin", types::b_binary{binary_sub_type::k_binary, sizeof(bytes), bytes}));
+        auto view = doc.view();
+
+        REQUIRE(is_engaged(validate(view.data(), view.length(), vtor, &invalid_offset)));
+    }
+}
+
+TEST_CASE("validate_many validates every document of a batch", "[bsoncxx::validate]") {
+    validator vtor{};
+    vtor.check_dollar_keys(true);
+
+    // Every 7th document is invalid. The batch is large enough to be split across threads.
+    std::vector<document::value> docs;
+    for (int i = 0; i < 5000; i++) {
+        docs.push_back(make_document(kvp(i % 7 == 0 ? "$bad" : "good", i)));
+    }
+
+    std::vector<document::view> views;
+    for (auto&& doc : docs) {
+        views.push_back(doc.view());
+    }
+
+    for (std::size_t max_threads : {0u, 1u, 4u}) {
+        auto results = validate_many(views, vtor, max_threads);
+        REQUIRE(results.size() == views.size());
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            std::size_t expected_offset{0u};
+            const bool expected_valid =
+                is_engaged(validate(views[i].data(), views[i].length(), vtor, &expected_offset));
+
+            REQUIRE(results[i].valid == expected_valid);
+            REQUIRE(results[i].valid == (i % 7 != 0));
+            if (!results[i].valid) {
+                REQUIRE(results[i].invalid_offset == expected_offset);
+            }
+        }
+    }
+
+    REQUIRE(validate_many(nullptr, 0, vtor).empty());
+}
+
+TEST_CASE("validate_structure checks lengths, terminators and types", "[bsoncxx::validate]") {
+    auto doc = make_document(
+        kvp("a", 1),
+        kvp("b", "two"),
+        kvp("c", make_document(kvp("d", make_array(1.5, true, types::b_null{})))),
+        kvp("e", types::b_regex{"^x", "i"}),
+        kvp("f", types::b_code{"return 1;"}),
+        kvp("g", types::b_codewscope{"return x;", make_document(kvp("x", 1)).view()}));
+    auto view = doc.view();
+    std::vector<std::uint8_t> bytes(view.data(), view.data() + view.length());
+
+    std::size_t offset = 1;
+    REQUIRE(is_engaged(validate_structure(bytes.data(), bytes.size(), &offset)));
+    REQUIRE(is_engaged(validate(bytes.data(), bytes.size())));
+
+    const auto element_offset = [&](const char* key) {
+        return static_cast<std::size_t>(view[key].offset());
+    };
+
+    SECTION("a wrong document length") {
+        REQUIRE(is_disengaged(validate_structure(bytes.data(), bytes.size() - 1, &offset)));
+        REQUIRE(offset == 0);
+    }
+
+    SECTION("a string overrunning its document") {
+        const auto b = element_offset("b");
+        bytes[b + 3] = 0x7F;
+        REQUIRE(is_disengaged(validate_structure(bytes.data(), bytes.size(), &offset)));
+        REQUIRE(offset == b);
+        REQUIRE(is_disengaged(validate(bytes.data(), bytes.size())));
+    }
+
+    SECTION("an unknown type byte") {
+        const auto e = element_offset("e");
+        bytes[e] = 0x42;
+        REQUIRE(is_disengaged(validate_structure(bytes.data(), bytes.size(), &offset)));
+        REQUIRE(offset == e);
+    }
+
+    SECTION("an invalid boolean deep inside") {
+        // The true in the array: its type, its key "1" and its value.
+        const std::uint8_t element[] = {0x08, '1', 0x00, 0x01};
+        auto at = std::search(bytes.begin(), bytes.end(), std::begin(element), std::end(element));
+        REQUIRE(at != bytes.end());
+        *(at + 3) = 2;
+        REQUIRE(is_disengaged(validate_structure(bytes.data(), bytes.size(), &offset)));
+        REQUIRE(offset == static_cast<std::size_t>(at - bytes.begin()));
+    }
+
+    SECTION("a missing terminator") {
+        bytes.back() = 1;
+        REQUIRE(is_disengaged(validate_structure(bytes.data(), bytes.size(), &offset)));
+        REQUIRE(offset == bytes.size() - 1);
+    }
+
+    REQUIRE(is_disengaged(validate_structure(nullptr, 0)));
+}
+
+TEST_CASE("indexed_view::validated checks and indexes in one pass", "[bsoncxx::validate]") {
+    builder::basic::document builder;
+    for (int i = 0; i < 20; i++) {
+        builder.append(kvp("key" + std::to_string(i), i));
+    }
+    auto doc = builder.extract();
+    auto view = doc.view();
+
+    auto indexed = document::indexed_view::validated(view.data(), view.length());
+    REQUIRE(is_engaged(indexed));
+    REQUIRE(indexed->size() == 20);
+    REQUIRE(indexed->find("key13")->get_int32().value == 13);
+    REQUIRE(indexed->find("missing") == view.end());
+
+    std::vector<std::uint8_t> bytes(view.data(), view.data() + view.length());
+    const auto bad = view["key5"].offset();
+    bytes[bad] = 0x42;
+    std::size_t offset = 0;
+    REQUIRE(is_disengaged(
+        document::indexed_view::validated(bytes.data(), bytes.size(), &offset)));
+    REQUIRE(offset == bad);
+}
 }  // namespace
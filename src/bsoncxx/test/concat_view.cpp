@@ -0,0 +1,100 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/concat_view.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_document;
+
+TEST_CASE("concat_view behaves like the concatenated document",
+          "[bsoncxx::document::concat_view]") {
+    auto id = make_document(kvp("_id", 1));
+    auto empty = make_document();
+    auto body = make_document(kvp("a", "x"), kvp("b", make_document(kvp("c", 2))));
+
+    document::concat_view combined{id.view(), empty.view(), body.view()};
+
+    builder::basic::document expected_builder;
+    expected_builder.append(builder::basic::concatenate(id.view()),
+                            builder::basic::concatenate(body.view()));
+    auto expected = expected_builder.extract();
+
+    REQUIRE(combined.length() == expected.view().length());
+    REQUIRE(!combined.empty());
+    REQUIRE(combined.validate_structure());
+
+    std::vector<std::string> keys;
+    for (auto&& element : combined) {
+        keys.push_back(element.key().to_string());
+    }
+    REQUIRE(keys == std::vector<std::string>{"_id", "a", "b"});
+
+    REQUIRE(combined["_id"].get_int32().value == 1);
+    REQUIRE(combined["b"]["c"].get_int32().value == 2);
+    REQUIRE(!combined["missing"]);
+    REQUIRE(combined.find("a")->get_utf8().value == stdx::string_view{"x"});
+    REQUIRE(combined.find("missing") == combined.end());
+
+    SECTION("the combined document is written out without assembling it first") {
+        std::vector<std::uint8_t> gathered;
+        for (auto&& range : combined.ranges()) {
+            gathered.insert(gathered.end(), range.data, range.data + range.length);
+        }
+        REQUIRE(document::view{gathered.data(), gathered.size()} == expected.view());
+
+        std::vector<std::uint8_t> copied(combined.length());
+        combined.copy_to(copied.data());
+        REQUIRE(copied == gathered);
+
+        REQUIRE(combined.value().view() == expected.view());
+    }
+
+    SECTION("an invalid part is reported at its offset in the combined document") {
+        auto bytes = std::vector<std::uint8_t>(body.view().data(),
+                                               body.view().data() + body.view().length());
+        bytes[4] = 0x20;  // "a" now has no valid type.
+
+        document::concat_view corrupted{id.view(), document::view{bytes.data(), bytes.size()}};
+        std::size_t offset = 0;
+        REQUIRE(!corrupted.validate_structure(&offset));
+        REQUIRE(offset == id.view().length() - 1);
+    }
+}
+
+TEST_CASE("concat_view of no elements is the empty document",
+          "[bsoncxx::document::concat_view]") {
+    auto empty = make_document();
+
+    document::concat_view none;
+    document::concat_view empties{empty.view(), empty.view()};
+
+    for (auto&& view : {none, empties}) {
+        REQUIRE(view.empty());
+        REQUIRE(view.begin() == view.end());
+        REQUIRE(view.value().view() == empty.view());
+    }
+}
+
+}  // namespace
@@ -0,0 +1,103 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/hash.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_array;
+using builder::basic::make_document;
+
+TEST_CASE("equal documents have equal hashes", "[bsoncxx::hash]") {
+    auto a = make_document(kvp("x", 1), kvp("y", "two"));
+    auto b = make_document(kvp("x", 1), kvp("y", "two"));
+    auto c = make_document(kvp("x", 2), kvp("y", "two"));
+
+    REQUIRE(hash(a.view()) == hash(b.view()));
+    REQUIRE(hash(a.view()) != hash(c.view()));
+    REQUIRE(std::hash<document::value>{}(a) == std::hash<document::view>{}(b.view()));
+}
+
+TEST_CASE("long documents are hashed consistently", "[bsoncxx::hash]") {
+    const std::string filler(1000, 'a');
+    auto a = make_document(kvp("s", filler), kvp("n", 1));
+    auto b = make_document(kvp("s", filler), kvp("n", 1));
+    auto c = make_document(kvp("s", filler), kvp("n", 2));
+
+    REQUIRE(a.view().length() > 256);
+    REQUIRE(hash(a.view()) == hash(b.view()));
+    REQUIRE(hash(a.view()) != hash(c.view()));
+}
+
+TEST_CASE("canonical hashing ignores field order", "[bsoncxx::hash]") {
+    auto a = make_document(kvp("x", 1), kvp("sub", make_document(kvp("p", true), kvp("q", 2.5))));
+    auto b = make_document(kvp("sub", make_document(kvp("q", 2.5), kvp("p", true))), kvp("x", 1));
+
+    REQUIRE(hash(a.view()) != hash(b.view()));
+    REQUIRE(canonical_hash(a.view()) == canonical_hash(b.view()));
+    REQUIRE(canonical_equal(a.view(), b.view()));
+
+    SECTION("but not array order") {
+        auto c = make_document(kvp("arr", make_array(1, 2)));
+        auto d = make_document(kvp("arr", make_array(2, 1)));
+        REQUIRE(canonical_hash(c.view()) != canonical_hash(d.view()));
+        REQUIRE_FALSE(canonical_equal(c.view(), d.view()));
+    }
+
+    SECTION("or differing values") {
+        auto c = make_document(kvp("x", 2), kvp("sub", make_document(kvp("p", true))));
+        REQUIRE_FALSE(canonical_equal(a.view(), c.view()));
+    }
+
+    SECTION("in unordered containers") {
+        std::unordered_set<document::view, canonical_hasher, canonical_equal_to> set;
+        set.insert(a.view());
+        set.insert(b.view());
+        REQUIRE(set.size() == 1);
+    }
+}
+
+TEST_CASE("documents can be keys of unordered containers", "[bsoncxx::hash]") {
+    auto a = make_document(kvp("x", 1));
+    auto b = make_document(kvp("x", 1));
+    auto c = make_document(kvp("x", 2));
+
+    std::unordered_set<document::view> set;
+    set.insert(a.view());
+    set.insert(b.view());
+    set.insert(c.view());
+    REQUIRE(set.size() == 2);
+}
+
+TEST_CASE("equal values have equal hashes", "[bsoncxx::hash]") {
+    REQUIRE(hash(types::value{types::b_double{0.0}}) ==
+            hash(types::value{types::b_double{-0.0}}));
+    REQUIRE(hash(types::value{types::b_int32{1}}) == hash(types::value{types::b_int32{1}}));
+    REQUIRE(hash(types::value{types::b_int32{1}}) != hash(types::value{types::b_int64{1}}));
+    REQUIRE(std::hash<types::value>{}(types::value{types::b_utf8{"a"}}) ==
+            std::hash<types::value>{}(types::value{types::b_utf8{"a"}}));
+}
+
+}  // namespace
@@ -12,12 +12,23 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/builder/basic/sub_array.hpp>
 #include <bsoncxx/exception/exception.hpp>
 #include <bsoncxx/json.hpp>
+#include <bsoncxx/json_reader.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/test_util/catch.hh>
 
 namespace {
@@ -112,4 +123,334 @@ TEST_CASE("CXX-1246: Canonical Extended JSON") {
         output ==
         R"({ "number" : { "$numberInt" : "42" }, "bin" : { "$binary" : { "base64": "ZGVhZGJlZWY=", "subType" : "04" } } })");
 }
+
+void require_same_as_libbson(const std::string& json) {
+    using namespace bsoncxx;
+    INFO(json);
+    REQUIRE(from_json(json, JsonParser::k_structural).view() ==
+            from_json(json, JsonParser::k_libbson).view());
+}
+
+TEST_CASE("structural parser matches libbson on plain JSON") {
+    require_same_as_libbson("{}");
+    require_same_as_libbson(k_valid_json);
+    require_same_as_libbson(R"({"a":{"b":[1,[2,{}],[]],"c":null},"d":true,"e":false})");
+    require_same_as_libbson(" \t\r\n{ \"a\" :\n[ 1 , 2 ] }\n ");
+    require_same_as_libbson(R"({"i32":2147483647,"i64":2147483648,"neg":-9223372036854775808})");
+    require_same_as_libbson(R"({"d":1.5,"e":-2e10,"f":0.25E-3})");
+    require_same_as_libbson(R"({"esc":"a\"b\\c\/d\b\f\n\r\t","u":"é中😀"})");
+    require_same_as_libbson(R"({"k\"ey":1,"café":2,"caf√©":"√©"})");
+}
+
+TEST_CASE("structural parser matches libbson across 64-byte blocks") {
+    // Strings, escapes and numbers straddling every offset of a block boundary.
+    for (std::size_t pad = 0; pad < 70; ++pad) {
+        const std::string filler(pad, 'x');
+        require_same_as_libbson(R"({")" + filler + R"(":"a\\\"b","n":)" + "123456" +
+                                R"(,"s":"{[,:]} \" \\")" + filler + R"("})");
+    }
+}
+
+TEST_CASE("structural parser matches libbson on Extended JSON") {
+    require_same_as_libbson(R"({"o":{"$oid":"507f1f77bcf86cd799439011"}})");
+    require_same_as_libbson(R"({"d":{"$date":{"$numberLong":"1356351330500"}}})");
+    require_same_as_libbson(R"({"d":{"$date":"2012-12-24T12:15:30.501Z"}})");
+    require_same_as_libbson(R"({"d":{"$date":1356351330500}})");
+    require_same_as_libbson(R"({"l":{"$numberLong":"42"},"i":{"$numberInt":"-7"}})");
+    require_same_as_libbson(R"({"x":{"$numberDouble":"1.5"},"y":{"$numberDouble":"-Infinity"}})");
+    require_same_as_libbson(R"({"m":{"$numberDecimal":"1.23E+4"}})");
+    require_same_as_libbson(R"({"b":{"$binary":{"base64":"ZGVhZGJlZWY=","subType":"04"}}})");
+    require_same_as_libbson(R"({"b":{"$binary":"ZGVhZA==","$type":"80"}})");
+    require_same_as_libbson(R"({"r":{"$regularExpression":{"pattern":"^a","options":"i"}}})");
+    require_same_as_libbson(R"({"r":{"$options":"m","$regex":"b$"}})");
+    require_same_as_libbson(R"({"t":{"$timestamp":{"t":123,"i":4}}})");
+    require_same_as_libbson(R"({"a":{"$minKey":1},"b":{"$maxKey":1},"c":{"$undefined":true}})");
+    require_same_as_libbson(R"({"s":{"$symbol":"sym"},"c":{"$code":"f();"}})");
+    require_same_as_libbson(R"({"c":{"$code":"f(x);","$scope":{"x":{"$numberLong":"1"}}}})");
+    require_same_as_libbson(
+        R"({"p":{"$dbPointer":{"$ref":"db.c","$id":{"$oid":"507f1f77bcf86cd799439011"}}}})");
+
+    // Objects that merely contain operators remain documents.
+    require_same_as_libbson(R"({"q":{"$gt":1},"r":{"$regex":{"$eq":"x"},"$options":"i"}})");
+}
+
+TEST_CASE("structural parser rejects invalid JSON") {
+    using namespace bsoncxx;
+
+    const char* invalid[] = {"",
+                             "[1]",
+                             "{",
+                             k_invalid_json,
+                             R"({"a":1,})",
+                             R"({"a" 1})",
+                             R"({"a":01})",
+                             R"({"a":1.})",
+                             R"({"a":nul})",
+                             R"({"a":"unterminated})",
+                             R"({"a":"\x"})",
+                             R"({"a":"\ud800"})",
+                             R"({"a\u0000":1})",
+                             R"({"a":1} {})",
+                             R"({"a":{"$oid":"123"}})",
+                             R"({"a":{"$numberInt":"2147483648"}})",
+                             R"({"a":{"$binary":{"base64":"!!!!","subType":"00"}}})"};
+
+    for (const auto json : invalid) {
+        INFO(json);
+        REQUIRE_THROWS_AS(from_json(json, JsonParser::k_structural), bsoncxx::exception);
+    }
+
+    REQUIRE_THROWS_AS(from_json(std::string(300, '[') + "{", JsonParser::k_structural),
+                      bsoncxx::exception);
+    REQUIRE_THROWS_AS(from_json("{\"a\":" + std::string(300, '[') + std::string(300, ']') + "}",
+                                JsonParser::k_structural),
+                      bsoncxx::exception);
+}
+
+std::string libbson_to_json(bsoncxx::document::view view, bsoncxx::ExtendedJsonMode mode) {
+    using bsoncxx::ExtendedJsonMode;
+
+    bson_t bson;
+    bson_init_static(&bson, view.data(), view.length());
+
+    std::size_t size;
+    char* json = mode == ExtendedJsonMode::k_legacy
+                     ? bson_as_json(&bson, &size)
+                     : mode == ExtendedJsonMode::k_relaxed
+                           ? bson_as_relaxed_extended_json(&bson, &size)
+                           : bson_as_canonical_extended_json(&bson, &size);
+    REQUIRE(json);
+
+    std::string out{json, size};
+    bson_free(json);
+    return out;
+}
+
+void require_same_as_libbson(bsoncxx::document::view view) {
+    using namespace bsoncxx;
+
+    for (auto mode :
+         {ExtendedJsonMode::k_legacy, ExtendedJsonMode::k_relaxed, ExtendedJsonMode::k_canonical}) {
+        INFO("mode " << static_cast<int>(mode));
+        REQUIRE(to_json(view, mode) == libbson_to_json(view, mode));
+    }
+}
+
+TEST_CASE("to_json matches libbson for every BSON type") {
+    using namespace bsoncxx;
+
+    const std::uint8_t bytes[] = {0, 1, 2, 250, 251, 252, 253};
+    const auto scope = make_document(kvp("x", 1));
+
+    require_same_as_libbson(make_document().view());
+    require_same_as_libbson(make_document(
+        kvp("double", 1.5),
+        kvp("utf8", "text"),
+        kvp("document", make_document(kvp("a", make_document()), kvp("b", make_array()))),
+        kvp("array", make_array(1, make_array(), make_document(kvp("c", "d")))),
+        kvp("binary", types::b_binary{binary_sub_type::k_uuid, 7, bytes}),
+        kvp("binary_empty", types::b_binary{binary_sub_type::k_user, 0, bytes}),
+        kvp("undefined", types::b_undefined{}),
+        kvp("oid", oid{"507f1f77bcf86cd799439011"}),
+        kvp("true", true),
+        kvp("false", false),
+        kvp("date", types::b_date{std::chrono::milliseconds{1356351330501}}),
+        kvp("date_whole", types::b_date{std::chrono::milliseconds{951782400000}}),
+        kvp("date_negative", types::b_date{std::chrono::milliseconds{-1}}),
+        kvp("null", types::b_null{}),
+        kvp("regex", types::b_regex{"^a\"b\\\\c$", "xusmli"}),
+        kvp("dbpointer", types::b_dbpointer{"db.coll", oid{"507f1f77bcf86cd799439011"}}),
+        kvp("code", types::b_code{"function() { return \"x\"; }"}),
+        kvp("symbol", types::b_symbol{"sym"}),
+        kvp("codewscope", types::b_codewscope{"f(x);", scope.view()}),
+        kvp("codewscope_empty", types::b_codewscope{"f();", make_document().view()}),
+        kvp("int32", std::numeric_limits<std::int32_t>::min()),
+        kvp("timestamp", types::b_timestamp{4, 4294967295u}),
+        kvp("int64", std::numeric_limits<std::int64_t>::min()),
+        kvp("decimal128", types::b_decimal128{"-1234E+999"}),
+        kvp("maxkey", types::b_maxkey{}),
+        kvp("minkey", types::b_minkey{})));
+}
+
+TEST_CASE("to_json matches libbson for doubles") {
+    using namespace bsoncxx;
+
+    const double values[] = {0.0,
+                             -0.0,
+                             1.0,
+                             -42.0,
+                             0.1,
+                             1.0 / 3.0,
+                             1e15,
+                             1e16,
+                             9007199254740993.0,
+                             1e300,
+                             -2.5e-300,
+                             std::numeric_limits<double>::denorm_min(),
+                             std::numeric_limits<double>::max(),
+                             std::numeric_limits<double>::infinity(),
+                             -std::numeric_limits<double>::infinity(),
+                             std::numeric_limits<double>::quiet_NaN()};
+
+    for (double value : values) {
+        INFO(value);
+        require_same_as_libbson(make_document(kvp("d", value)).view());
+    }
+}
+
+TEST_CASE("to_json matches libbson for escaped strings") {
+    using namespace bsoncxx;
+
+    const std::string specials{"\"\\\b\f\n\r\t\x01\x1f\x7f/\0 é中😀", 22};
+    require_same_as_libbson(make_document(kvp(specials.substr(0, 7), specials)).view());
+
+    // Characters to escape at every position of a vector, and across vectors.
+    for (std::size_t pad = 0; pad < 40; ++pad) {
+        const std::string filler(pad, 'x');
+        require_same_as_libbson(
+            make_document(kvp(filler + "\"" + filler, filler + specials + filler + "\n")).view());
+    }
+}
+
+TEST_CASE("to_json throws on invalid UTF-8") {
+    using namespace bsoncxx;
+
+    const auto doc = make_document(kvp("a", "\xff"));
+    REQUIRE_THROWS_AS(to_json(doc.view()), bsoncxx::exception);
+
+    std::string out{"prefix"};
+    REQUIRE_THROWS_AS(to_json(doc.view(), out), bsoncxx::exception);
+    REQUIRE(out == "prefix");
+}
+
+TEST_CASE("to_json_batch joins the documents with newlines") {
+    using namespace bsoncxx;
+
+    std::vector<document::value> docs;
+    std::string expected;
+    for (std::int32_t i = 0; i < 1000; ++i) {
+        docs.push_back(make_document(kvp("i", i), kvp("s", std::string(i % 50, 'x'))));
+        if (i != 0) {
+            expected += '\n';
+        }
+        expected += to_json(docs.back().view(), ExtendedJsonMode::k_canonical);
+    }
+
+    std::vector<document::view> views;
+    for (const auto& doc : docs) {
+        views.push_back(doc.view());
+    }
+
+    REQUIRE(to_json_batch(views, ExtendedJsonMode::k_canonical, 4) == expected);
+    REQUIRE(to_json_batch(views, ExtendedJsonMode::k_canonical, 1) == expected);
+    REQUIRE(to_json_batch(std::vector<document::view>{}).empty());
+}
+
+TEST_CASE("from_json_batch converts each text in order") {
+    using namespace bsoncxx;
+
+    std::vector<std::string> texts;
+    for (std::int32_t i = 0; i < 1000; ++i) {
+        texts.push_back("{ \"i\" : " + std::to_string(i) + " }");
+    }
+    std::vector<stdx::string_view> json{texts.begin(), texts.end()};
+
+    for (auto parser : {JsonParser::k_libbson, JsonParser::k_structural}) {
+        const auto docs = from_json_batch(json, parser, 4);
+        REQUIRE(docs.size() == texts.size());
+        for (std::size_t i = 0; i < docs.size(); ++i) {
+            REQUIRE(docs[i].view()["i"].get_int32().value == static_cast<std::int32_t>(i));
+        }
+    }
+
+    json[700] = k_invalid_json;
+    REQUIRE_THROWS_AS(from_json_batch(json, JsonParser::k_libbson, 4), bsoncxx::exception);
+    REQUIRE(from_json_batch(std::vector<stdx::string_view>{}).empty());
+}
+
+TEST_CASE("to_json appends to an existing string") {
+    using namespace bsoncxx;
+
+    std::string out = "[";
+    to_json(make_document(kvp("a", 1)).view(), out);
+    out += ",";
+    to_json(make_document(kvp("a", 2)).view(), out, ExtendedJsonMode::k_canonical);
+
+    REQUIRE(out == R"([{ "a" : 1 },{ "a" : { "$numberInt" : "2" } })");
+}
+
+TEST_CASE("to_json writes to a stream") {
+    using namespace bsoncxx;
+
+    const auto doc = make_document(kvp("a", 1), kvp("b", make_array(2, 3)));
+
+    std::ostringstream out;
+    to_json(doc.view(), out, ExtendedJsonMode::k_relaxed);
+
+    REQUIRE(out.str() == to_json(doc.view(), ExtendedJsonMode::k_relaxed));
+}
+
+TEST_CASE("json_reader yields each document of line-delimited JSON") {
+    using namespace bsoncxx;
+
+    // A small buffer size forces documents to straddle chunk boundaries.
+    std::istringstream input{"{ \"a\" : 1 }\n{ \"b\" : \"two\" }\n\n  { \"c\" : [ 3 ] }\n"};
+    json_reader reader{input, 8};
+
+    auto first = reader.read();
+    REQUIRE(first);
+    REQUIRE(*first == make_document(kvp("a", 1)).view());
+
+    auto second = reader.read();
+    REQUIRE(second);
+    REQUIRE(*second == make_document(kvp("b", "two")).view());
+
+    auto third = reader.read();
+    REQUIRE(third);
+    REQUIRE(*third == make_document(kvp("c", make_array(3))).view());
+
+    REQUIRE(!reader.read());
+}
+
+TEST_CASE("json_reader pulls input from a callback") {
+    using namespace bsoncxx;
+
+    const std::string json = R"({ "x" : 1 } { "x" : 2 })";
+    std::size_t pos = 0;
+
+    json_reader reader{[&](std::uint8_t* buf, std::size_t count) {
+        // Supply a single byte at a time.
+        if (pos == json.size() || count == 0) {
+            return std::size_t{0};
+        }
+        buf[0] = static_cast<std::uint8_t>(json[pos++]);
+        return std::size_t{1};
+    }};
+
+    std::int32_t expected = 1;
+    while (auto doc = reader.read()) {
+        REQUIRE((*doc)["x"].get_int32() == expected++);
+    }
+    REQUIRE(expected == 3);
+}
+
+TEST_CASE("json_reader throws on invalid input") {
+    using namespace bsoncxx;
+
+    std::istringstream input{std::string{"{ \"a\" : 1 }\n"} + k_invalid_json};
+    json_reader reader{input};
+
+    REQUIRE(reader.read());
+    REQUIRE_THROWS_AS(reader.read(), bsoncxx::exception);
+}
+
+TEST_CASE("json_reader propagates exceptions from the source") {
+    using namespace bsoncxx;
+
+    json_reader reader{[](std::uint8_t*, std::size_t) -> std::size_t {
+        throw std::runtime_error{"source failed"};
+    }};
+
+    REQUIRE_THROWS_AS(reader.read(), std::runtime_error);
+}
 }  // namespace
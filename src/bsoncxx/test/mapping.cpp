@@ -0,0 +1,123 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/mapping.hpp>
+#include <bsoncxx/test_util/catch.hh>
+
+namespace mapping_test {
+
+struct dimensions {
+    double width;
+    double height;
+};
+BSONCXX_DEFINE_STRUCT(dimensions, width, height)
+
+struct item {
+    std::string name;
+    std::int32_t quantity;
+    std::int64_t total;
+    bool available;
+    bsoncxx::stdx::optional<double> price;
+    std::vector<std::string> tags;
+    dimensions size;
+    std::vector<dimensions> parts;
+    bsoncxx::oid id;
+    bsoncxx::types::b_date updated{std::chrono::milliseconds{0}};
+};
+BSONCXX_DEFINE_STRUCT(
+    item, name, quantity, total, available, price, tags, size, parts, id, updated)
+
+}  // namespace mapping_test
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_array;
+using builder::basic::make_document;
+
+TEST_CASE("mapped structs encode their members in order", "[bsoncxx::mapping]") {
+    mapping_test::item in;
+    in.name = "lamp";
+    in.quantity = 3;
+    in.total = 30;
+    in.available = true;
+    in.tags = {"home", "light"};
+    in.size = {1.5, 2.5};
+    in.parts = {{1, 2}};
+    in.updated = types::b_date{std::chrono::milliseconds{1000}};
+
+    auto doc = mapping::to_document(in);
+    auto expected = make_document(
+        kvp("name", "lamp"),
+        kvp("quantity", 3),
+        kvp("total", std::int64_t{30}),
+        kvp("available", true),
+        kvp("tags", make_array("home", "light")),
+        kvp("size", make_document(kvp("width", 1.5), kvp("height", 2.5))),
+        kvp("parts", make_array(make_document(kvp("width", 1.0), kvp("height", 2.0)))),
+        kvp("id", in.id),
+        kvp("updated", in.updated));
+    REQUIRE(doc.view() == expected.view());
+
+    in.price = 9.99;
+    auto with_price = mapping::to_document(in);
+    REQUIRE(with_price.view()["price"].get_double().value == 9.99);
+
+    SECTION("and decode back") {
+        auto out = mapping::from_document<mapping_test::item>(with_price.view());
+        REQUIRE(out.name == "lamp");
+        REQUIRE(out.quantity == 3);
+        REQUIRE(out.total == 30);
+        REQUIRE(out.available);
+        REQUIRE(out.price == 9.99);
+        REQUIRE(out.tags == in.tags);
+        REQUIRE(out.size.height == 2.5);
+        REQUIRE(out.parts.size() == 1);
+        REQUIRE(out.parts[0].width == 1);
+        REQUIRE(out.id == in.id);
+        REQUIRE(out.updated == in.updated);
+    }
+}
+
+TEST_CASE("mapped structs decode keys in any order", "[bsoncxx::mapping]") {
+    mapping_test::dimensions out{7, 8};
+
+    mapping::from_document(make_document(kvp("height", 2), kvp("extra", "x")).view(), out);
+    REQUIRE(out.width == 7);
+    REQUIRE(out.height == 2);
+
+    mapping::from_document(
+        make_document(kvp("height", 4.0), kvp("width", std::int64_t{3})).view(), out);
+    REQUIRE(out.width == 3);
+    REQUIRE(out.height == 4);
+
+    mapping_test::item wrong;
+    REQUIRE_THROWS_AS(mapping::from_document(make_document(kvp("quantity", "three")).view(), wrong),
+                      bsoncxx::exception);
+
+    mapping::from_document(make_document(kvp("price", types::b_null{})).view(), wrong);
+    REQUIRE(!wrong.price);
+}
+
+}  // namespace
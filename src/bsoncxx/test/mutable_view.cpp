@@ -0,0 +1,91 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/mutable_view.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_array;
+using builder::basic::make_document;
+
+TEST_CASE("mutable_view overwrites fixed-width values in place",
+          "[bsoncxx::document::mutable_view]") {
+    auto doc = make_document(kvp("counter", std::int64_t{1}), kvp("name", "a"));
+    const auto data = doc.view().data();
+
+    document::mutable_view patch{doc};
+    REQUIRE(patch.assign("counter", types::value{types::b_int64{42}}));
+    REQUIRE_FALSE(patch.assign("missing", types::value{types::b_int64{42}}));
+
+    REQUIRE(doc.view().data() == data);
+    auto expected = make_document(kvp("counter", std::int64_t{42}), kvp("name", "a"));
+    REQUIRE(doc.view() == expected.view());
+}
+
+TEST_CASE("mutable_view splices values of other sizes", "[bsoncxx::document::mutable_view]") {
+    auto doc = make_document(kvp("a", 1),
+                             kvp("sub", make_document(kvp("s", "short"), kvp("n", 2))),
+                             kvp("arr", make_array(1, 2, 3)),
+                             kvp("z", true));
+    document::mutable_view patch{doc};
+
+    SECTION("growing a nested value") {
+        patch.assign(patch.view()["sub"]["s"], types::value{types::b_utf8{"a much longer string"}});
+        auto expected =
+            make_document(kvp("a", 1),
+                          kvp("sub", make_document(kvp("s", "a much longer string"), kvp("n", 2))),
+                          kvp("arr", make_array(1, 2, 3)),
+                          kvp("z", true));
+        REQUIRE(doc.view() == expected.view());
+    }
+
+    SECTION("changing the type of a value") {
+        patch.assign(patch.view()["arr"][1], types::value{types::b_double{2.5}});
+        patch.assign("a", types::value{types::b_utf8{"one"}});
+        auto expected = make_document(kvp("a", "one"),
+                                      kvp("sub", make_document(kvp("s", "short"), kvp("n", 2))),
+                                      kvp("arr", make_array(1, 2.5, 3)),
+                                      kvp("z", true));
+        REQUIRE(doc.view() == expected.view());
+    }
+
+    SECTION("erasing elements") {
+        patch.erase(patch.view()["sub"]["s"]);
+        patch.erase(patch.view()["a"]);
+        auto expected = make_document(kvp("sub", make_document(kvp("n", 2))),
+                                      kvp("arr", make_array(1, 2, 3)),
+                                      kvp("z", true));
+        REQUIRE(doc.view() == expected.view());
+    }
+
+    SECTION("rejecting elements of other documents") {
+        auto other = make_document(kvp("a", 1));
+        REQUIRE_THROWS_AS(patch.assign(other.view()["a"], types::value{types::b_int32{2}}),
+                          bsoncxx::exception);
+        REQUIRE_THROWS_AS(patch.erase(document::element{}), bsoncxx::exception);
+    }
+}
+
+}  // namespace
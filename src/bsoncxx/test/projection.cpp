@@ -0,0 +1,76 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/projection.hpp>
+#include <bsoncxx/test_util/catch.hh>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_array;
+using builder::basic::make_document;
+
+TEST_CASE("project keeps the selected fields in document order", "[bsoncxx::project]") {
+    auto doc = make_document(kvp("a", 1),
+                             kvp("b", "two"),
+                             kvp("c", make_document(kvp("x", 1), kvp("y", 2))),
+                             kvp("d", make_array(1, 2)),
+                             kvp("e", 5.5));
+
+    SECTION("top-level fields") {
+        auto projected = project(doc.view(), {"e", "a", "d", "missing"});
+        auto expected = make_document(kvp("a", 1), kvp("d", make_array(1, 2)), kvp("e", 5.5));
+        REQUIRE(projected.view() == expected.view());
+    }
+
+    SECTION("dotted paths") {
+        auto projected = project(doc.view(), {"c.y", "b", "b.z", "d.0"});
+        auto expected = make_document(kvp("b", "two"), kvp("c", make_document(kvp("y", 2))));
+        REQUIRE(projected.view() == expected.view());
+    }
+
+    SECTION("a whole subdocument wins over its paths") {
+        auto projected = project(doc.view(), {"c.x", "c"});
+        auto expected = make_document(kvp("c", make_document(kvp("x", 1), kvp("y", 2))));
+        REQUIRE(projected.view() == expected.view());
+    }
+
+    SECTION("into an existing builder") {
+        builder::core builder{false};
+        builder.key_view("first");
+        builder.append(0);
+        project(doc.view(), {"a"}, builder);
+        auto expected = make_document(kvp("first", 0), kvp("a", 1));
+        REQUIRE(builder.view_document() == expected.view());
+    }
+}
+
+TEST_CASE("merge lets the second document take precedence", "[bsoncxx::merge]") {
+    auto base = make_document(kvp("a", 1), kvp("b", 2), kvp("c", 3));
+    auto overrides = make_document(kvp("d", 4), kvp("b", "two"));
+
+    auto merged = merge(base.view(), overrides.view());
+    auto expected = make_document(kvp("a", 1), kvp("b", "two"), kvp("c", 3), kvp("d", 4));
+    REQUIRE(merged.view() == expected.view());
+
+    REQUIRE(merge(base.view(), make_document().view()).view() == base.view());
+    REQUIRE(merge(make_document().view(), overrides.view()).view() == overrides.view());
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/shared_value.hpp>
+#include <bsoncxx/test_util/catch.hh>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_document;
+
+TEST_CASE("shared_value shares one buffer between copies", "[bsoncxx::document::shared_value]") {
+    auto doc = make_document(kvp("a", 1), kvp("b", "two"));
+    const auto data = doc.view().data();
+    const auto length = doc.view().length();
+
+    document::shared_value shared{std::move(doc)};
+    REQUIRE(shared.view().data() == data);
+    REQUIRE(shared.view().length() == length);
+    REQUIRE(shared.view()["b"].get_utf8().value == stdx::string_view{"two"});
+    REQUIRE(shared.use_count() == 1);
+
+    SECTION("copies point at the same bytes") {
+        auto copy = shared;
+        REQUIRE(copy.view().data() == data);
+        REQUIRE(shared.use_count() == 2);
+        REQUIRE(copy == shared);
+    }
+
+    SECTION("copies can be read and dropped from many threads") {
+        std::vector<std::thread> readers;
+        std::vector<std::int32_t> seen(8);
+        for (std::size_t i = 0; i < seen.size(); i++) {
+            readers.emplace_back(
+                [&seen, i](document::shared_value copy) {
+                    seen[i] = copy.view()["a"].get_int32().value;
+                },
+                shared);
+        }
+        for (auto&& reader : readers) {
+            reader.join();
+        }
+
+        REQUIRE(seen == std::vector<std::int32_t>(8, 1));
+        REQUIRE(shared.use_count() == 1);
+    }
+
+    SECTION("constructing from a view copies it") {
+        document::shared_value copy{shared.view()};
+        REQUIRE(copy.view().data() != data);
+        REQUIRE(copy == shared);
+        REQUIRE(copy != document::shared_value{make_document(kvp("a", 2))});
+    }
+}
+
+}  // namespace
@@ -0,0 +1,233 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/json.hpp>
+#include <bsoncxx/sort.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+
+namespace {
+
+using namespace bsoncxx;
+using builder::basic::kvp;
+using builder::basic::make_array;
+using builder::basic::make_document;
+
+int sign(int value) {
+    return value < 0 ? -1 : (value > 0 ? 1 : 0);
+}
+
+int compare_keys(const std::string& lhs, const std::string& rhs) {
+    return sign(lhs.compare(rhs));
+}
+
+TEST_CASE("compare follows the server's sort order", "[bsoncxx::compare]") {
+    auto doc = make_document(kvp("minkey", types::b_minkey{}),
+                             kvp("null", types::b_null{}),
+                             kvp("nan", std::numeric_limits<double>::quiet_NaN()),
+                             kvp("negative", -1.5),
+                             kvp("int", 1),
+                             kvp("double", 1.5),
+                             kvp("long", std::int64_t{2}),
+                             kvp("string", "a"),
+                             kvp("longer_string", "ab"),
+                             kvp("document", make_document(kvp("a", 1))),
+                             kvp("array", make_array(1)),
+                             kvp("false", false),
+                             kvp("true", true),
+                             kvp("date", types::b_date{std::chrono::milliseconds{0}}),
+                             kvp("maxkey", types::b_maxkey{}));
+
+    // Each element sorts strictly after the one before it.
+    types::value_view previous;
+    bool first = true;
+    for (auto&& element : doc.view()) {
+        auto value = element.get_value_view();
+        if (!first) {
+            REQUIRE(compare(previous, value) < 0);
+            REQUIRE(compare(value, previous) > 0);
+        }
+        REQUIRE(compare(value, value) == 0);
+        previous = value;
+        first = false;
+    }
+
+    SECTION("a missing field compares like null") {
+        REQUIRE(compare(types::value_view{}, doc.view()["null"].get_value_view()) == 0);
+    }
+
+    SECTION("numbers compare by value whatever their type") {
+        const std::int64_t big = (std::int64_t{1} << 53) + 1;
+        auto numbers = make_document(kvp("int", 2),
+                                     kvp("long", std::int64_t{2}),
+                                     kvp("double", 2.0),
+                                     kvp("big", big),
+                                     kvp("big_double", static_cast<double>(big)));
+        auto v = numbers.view();
+        REQUIRE(compare(v["int"].get_value_view(), v["long"].get_value_view()) == 0);
+        REQUIRE(compare(v["long"].get_value_view(), v["double"].get_value_view()) == 0);
+
+        // 2^53 + 1 has no double, so it sorts after the nearest one.
+        REQUIRE(compare(v["big"].get_value_view(), v["big_double"].get_value_view()) > 0);
+    }
+}
+
+TEST_CASE("compare orders documents by a sort specification", "[bsoncxx::compare]") {
+    auto sort = make_document(kvp("a", 1), kvp("b.c", -1));
+
+    auto lhs = make_document(kvp("b", make_document(kvp("c", 5))), kvp("a", 1));
+    auto rhs = make_document(kvp("a", 1), kvp("b", make_document(kvp("c", 3))));
+    auto later = make_document(kvp("a", 2));
+
+    REQUIRE(compare(lhs.view(), rhs.view(), sort.view()) < 0);
+    REQUIRE(compare(rhs.view(), later.view(), sort.view()) < 0);
+    REQUIRE(compare(later.view(), lhs.view(), sort.view()) > 0);
+    REQUIRE(compare(lhs.view(), lhs.view(), sort.view()) == 0);
+
+    SECTION("arrays sort by their smallest element ascending and largest descending") {
+        auto array = make_document(kvp("x", make_array(3, 1, 2)));
+        auto two = make_document(kvp("x", 2));
+        REQUIRE(compare(array.view(), two.view(), make_document(kvp("x", 1)).view()) < 0);
+        REQUIRE(compare(array.view(), two.view(), make_document(kvp("x", -1)).view()) < 0);
+    }
+
+    SECTION("an empty array sorts before null and missing fields") {
+        auto empty = make_document(kvp("x", make_array()));
+        auto null = make_document(kvp("x", types::b_null{}));
+        auto missing = make_document();
+        for (auto direction : {1, -1}) {
+            auto sort = make_document(kvp("x", direction));
+            REQUIRE(compare(empty.view(), null.view(), sort.view()) * direction < 0);
+            REQUIRE(compare(empty.view(), missing.view(), sort.view()) * direction < 0);
+            REQUIRE(compare_keys(sort_key(empty.view(), sort.view()),
+                                 sort_key(null.view(), sort.view())) *
+                        direction <
+                    0);
+        }
+
+        std::vector<document::view> views{null.view(), empty.view(), missing.view()};
+        sort_documents(views, make_document(kvp("x", 1)).view());
+        REQUIRE(views[0] == empty.view());
+    }
+
+    SECTION("invalid specifications are rejected") {
+        try {
+            compare(lhs.view(), rhs.view(), make_document().view());
+            FAIL("expected an empty sort specification to be rejected");
+        } catch (const bsoncxx::exception& e) {
+            REQUIRE(e.code() == error_code::k_invalid_sort_specification);
+        }
+        REQUIRE_THROWS_AS(compare(lhs.view(), rhs.view(), make_document(kvp("a", 2)).view()),
+                          bsoncxx::exception);
+        REQUIRE_THROWS_AS(sort_key(lhs.view(), make_document(kvp("a", "up")).view()),
+                          bsoncxx::exception);
+    }
+}
+
+TEST_CASE("sort_key orders documents as compare does", "[bsoncxx::sort_key]") {
+    std::vector<document::value> docs;
+    docs.push_back(make_document());
+    docs.push_back(make_document(kvp("a", types::b_minkey{})));
+    docs.push_back(make_document(kvp("a", types::b_null{})));
+    docs.push_back(make_document(kvp("a", std::numeric_limits<double>::quiet_NaN())));
+    docs.push_back(make_document(kvp("a", -0.0)));
+    docs.push_back(make_document(kvp("a", 0)));
+    docs.push_back(make_document(kvp("a", -7)));
+    docs.push_back(make_document(kvp("a", std::numeric_limits<std::int64_t>::max())));
+    docs.push_back(make_document(kvp("a", std::numeric_limits<std::int64_t>::min())));
+    docs.push_back(make_document(kvp("a", 9223372036854775808.0)));
+    docs.push_back(make_document(kvp("a", "")));
+    docs.push_back(make_document(kvp("a", "a")));
+    docs.push_back(make_document(kvp("a", std::string{"a\0b", 3})));
+    docs.push_back(make_document(kvp("a", "ab")));
+    docs.push_back(make_document(kvp("a", make_document())));
+    docs.push_back(make_document(kvp("a", make_document(kvp("x", 1)))));
+    docs.push_back(make_document(kvp("a", make_document(kvp("x", 1), kvp("y", 1)))));
+    docs.push_back(make_document(kvp("a", make_document(kvp("y", 1)))));
+    docs.push_back(make_document(kvp("a", make_array())));
+    docs.push_back(make_document(kvp("a", make_array(make_array(1, 2)))));
+    docs.push_back(make_document(kvp("a", make_array(make_array(1)))));
+    docs.push_back(make_document(kvp("a", false), kvp("b", 1)));
+    docs.push_back(make_document(kvp("a", false), kvp("b", 2)));
+    docs.push_back(make_document(kvp("a", true)));
+    docs.push_back(make_document(kvp("a", types::b_date{std::chrono::milliseconds{-1}})));
+    docs.push_back(make_document(kvp("a", types::b_timestamp{1, 2})));
+    docs.push_back(make_document(kvp("a", types::b_maxkey{})));
+
+    for (auto&& sort : {make_document(kvp("a", 1), kvp("b", 1)),
+                        make_document(kvp("a", -1), kvp("b", 1)),
+                        make_document(kvp("b", -1), kvp("a", 1))}) {
+        for (auto&& lhs : docs) {
+            const auto lhs_key = sort_key(lhs.view(), sort.view());
+            for (auto&& rhs : docs) {
+                const auto rhs_key = sort_key(rhs.view(), sort.view());
+                INFO(to_json(lhs.view()) << " vs " << to_json(rhs.view()));
+                REQUIRE(compare_keys(lhs_key, rhs_key) ==
+                        sign(compare(lhs.view(), rhs.view(), sort.view())));
+            }
+        }
+    }
+}
+
+TEST_CASE("sort_documents sorts stably across threads", "[bsoncxx::sort_documents]") {
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<std::int32_t> values{0, 99};
+
+    // Mixed types, so that the keys of different types interleave.
+    std::vector<document::value> docs;
+    for (std::int32_t i = 0; i < 20000; i++) {
+        const auto x = values(generator);
+        if (x % 3 == 0) {
+            docs.push_back(make_document(kvp("x", static_cast<double>(x) / 2), kvp("seq", i)));
+        } else if (x % 3 == 1) {
+            docs.push_back(make_document(kvp("x", std::to_string(x)), kvp("seq", i)));
+        } else {
+            docs.push_back(make_document(kvp("x", x), kvp("seq", i)));
+        }
+    }
+
+    std::vector<document::view> views;
+    for (auto&& doc : docs) {
+        views.push_back(doc.view());
+    }
+
+    auto sort = make_document(kvp("x", -1));
+    for (std::size_t threads : {1, 4}) {
+        auto sorted = views;
+        sort_documents(sorted, sort.view(), threads);
+
+        REQUIRE(sorted.size() == views.size());
+        for (std::size_t i = 1; i < sorted.size(); i++) {
+            const int order = compare(sorted[i - 1], sorted[i], sort.view());
+            REQUIRE(order <= 0);
+            if (order == 0) {
+                REQUIRE(sorted[i - 1]["seq"].get_int32() < sorted[i]["seq"].get_int32());
+            }
+        }
+    }
+}
+
+}  // namespace
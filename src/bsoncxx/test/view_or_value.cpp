@@ -12,12 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
+#include <string>
+
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/document/view_or_value.hpp>
 #include <bsoncxx/json.hpp>
+#include <bsoncxx/string/terminated_view.hpp>
 #include <bsoncxx/string/view_or_value.hpp>
 #include <bsoncxx/test_util/catch.hh>
 
@@ -119,6 +123,42 @@ TEST_CASE("document::view_or_value", "[bsoncxx::document::view_or_value]") {
         }
     }
 
+    SECTION("keeps small owned documents inline") {
+        const std::size_t capacity = document::view_or_value::k_inline_capacity;
+        auto within = [](const document::view_or_value& variant) {
+            const auto object = reinterpret_cast<const std::uint8_t*>(&variant);
+            return variant.view().data() >= object &&
+                   variant.view().data() < object + sizeof(variant);
+        };
+
+        auto owned = document::view_or_value::copy_of(doc.view());
+        REQUIRE(owned.is_owning());
+        REQUIRE(within(owned));
+        REQUIRE(owned == doc.view());
+
+        auto temp_doc = doc;
+        document::view_or_value value{std::move(temp_doc)};
+        document::view_or_value copied{value};
+        REQUIRE(copied.is_owning());
+        REQUIRE(within(copied));
+        REQUIRE(copied == doc.view());
+
+        document::view_or_value moved{std::move(copied)};
+        REQUIRE(within(moved));
+        REQUIRE(moved == doc.view());
+        REQUIRE_FALSE(copied.is_owning());
+
+        copied = moved;
+        REQUIRE(within(copied));
+        REQUIRE(copied == doc.view());
+
+        auto large = make_document(kvp("padding", std::string(capacity, 'p')));
+        auto large_copy = document::view_or_value::copy_of(large.view());
+        REQUIRE(large_copy.is_owning());
+        REQUIRE_FALSE(within(large_copy));
+        REQUIRE(large_copy == large.view());
+    }
+
     SECTION("Can be compared to another view_or_value") {
         SECTION("Compares equal with equal views, regardless of ownership") {
             document::value temp{doc};
@@ -260,6 +300,31 @@ TEST_CASE("string::document::view_or_value", "[bsoncxx::string::view_or_value]")
                 REQUIRE(copy.data()[3] == '\0');
             }
         }
+
+        SECTION("when viewing a const char*, copy views the same string") {
+            const char* name = "Tom";
+            string::view_or_value original{name};
+
+            string::view_or_value copy{original.terminated()};
+            REQUIRE(!copy.is_owning());
+            REQUIRE(copy.data() == name);
+        }
+
+        SECTION("when viewing a terminated_view, copy views the same string") {
+            constexpr string::terminated_view name{"Tim"};
+            static_assert(name.size() == 3, "a literal's terminator is not counted");
+
+            string::view_or_value original{name};
+            string::view_or_value copy{original.terminated()};
+            REQUIRE(!copy.is_owning());
+            REQUIRE(copy.data() == name.c_str());
+            REQUIRE(copy == "Tim");
+
+            std::string runtime{"Ann"};
+            string::view_or_value from_string{string::terminated_view{runtime}};
+            REQUIRE(from_string.terminated().data() == runtime.c_str());
+            REQUIRE(string::terminated_view::from_c_str("Jo").size() == 2);
+        }
     }
 }
 }  // namespace
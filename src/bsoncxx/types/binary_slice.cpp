@@ -0,0 +1,89 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/types/binary_slice.hpp>
+
+#include <utility>
+
+#include <bsoncxx/exception/error_code.hpp>
+#include <bsoncxx/exception/exception.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace types {
+
+binary_slice::binary_slice() noexcept
+    : _sub_type{binary_sub_type::k_binary}, _bytes{nullptr}, _size{0} {}
+
+binary_slice::binary_slice(std::shared_ptr<const document::value> owner,
+                           document::element element)
+    : _owner{std::move(owner)} {
+    if (element.type() != type::k_binary) {
+        throw bsoncxx::exception{error_code::k_need_element_type_k_binary};
+    }
+
+    auto binary = element.get_binary();
+    if (!_owner || binary.bytes < _owner->view().data() ||
+        binary.bytes + binary.size > _owner->view().data() + _owner->view().length()) {
+        throw bsoncxx::exception{error_code::k_invalid_binary_slice,
+                                 "the binary element is not part of the owning document"};
+    }
+
+    _sub_type = binary.sub_type;
+    _bytes = binary.bytes;
+    _size = binary.size;
+}
+
+binary_slice::binary_slice(document::value&& owner, document::element element)
+    : binary_slice{std::make_shared<const document::value>(std::move(owner)), element} {}
+
+binary_slice binary_slice::slice(std::size_t offset, std::size_t length) const {
+    if (offset > _size || length > _size - offset) {
+        throw bsoncxx::exception{error_code::k_invalid_binary_slice,
+                                 "the range is not inside the binary slice"};
+    }
+
+    binary_slice result;
+    result._owner = _owner;
+    result._sub_type = _sub_type;
+    result._bytes = _bytes + offset;
+    result._size = length;
+    return result;
+}
+
+binary_sub_type binary_slice::sub_type() const noexcept {
+    return _sub_type;
+}
+
+const std::uint8_t* binary_slice::bytes() const noexcept {
+    return _bytes;
+}
+
+std::size_t binary_slice::size() const noexcept {
+    return _size;
+}
+
+b_binary binary_slice::view() const noexcept {
+    return b_binary{_sub_type, static_cast<std::uint32_t>(_size), _bytes};
+}
+
+const std::shared_ptr<const document::value>& binary_slice::owner() const noexcept {
+    return _owner;
+}
+
+}  // namespace types
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
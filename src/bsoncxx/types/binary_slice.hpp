@@ -0,0 +1,124 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace types {
+
+///
+/// The bytes of a BSON binary value, kept alive by shared ownership of the document::value that
+/// holds them.
+///
+/// A binary_slice points straight into the buffer of its document, so it can be copied, sliced
+/// further and handed to other threads without copying the binary data. The buffer is freed
+/// once the document and every slice of it have been destroyed.
+///
+class BSONCXX_API binary_slice {
+   public:
+    ///
+    /// Constructs an empty slice, with no owner.
+    ///
+    binary_slice() noexcept;
+
+    ///
+    /// Constructs a slice of all the bytes of a binary element of a shared document.
+    ///
+    /// @param owner
+    ///   The document holding the element.
+    /// @param element
+    ///   A binary element of `owner`, at any depth.
+    ///
+    /// @throws bsoncxx::exception
+    ///   with error_code::k_need_element_type_k_binary if `element` is not a binary, or with
+    ///   error_code::k_invalid_binary_slice if its bytes are not inside `owner`.
+    ///
+    binary_slice(std::shared_ptr<const document::value> owner, document::element element);
+
+    ///
+    /// Constructs a slice of all the bytes of a binary element, taking ownership of the document
+    /// holding it. The buffer of the document is moved, not copied, so `element` stays valid.
+    ///
+    /// @param owner
+    ///   The document holding the element.
+    /// @param element
+    ///   A binary element of `owner`, at any depth.
+    ///
+    /// @throws bsoncxx::exception
+    ///   with error_code::k_need_element_type_k_binary if `element` is not a binary, or with
+    ///   error_code::k_invalid_binary_slice if its bytes are not inside `owner`.
+    ///
+    binary_slice(document::value&& owner, document::element element);
+
+    ///
+    /// Returns a slice of a range of the bytes of this one, sharing the same owner.
+    ///
+    /// @param offset
+    ///   The offset of the first byte of the range within this slice.
+    /// @param length
+    ///   The number of bytes in the range.
+    ///
+    /// @throws bsoncxx::exception
+    ///   with error_code::k_invalid_binary_slice if the range is not inside this slice.
+    ///
+    binary_slice slice(std::size_t offset, std::size_t length) const;
+
+    ///
+    /// The binary sub type of the element the slice was taken from.
+    ///
+    binary_sub_type sub_type() const noexcept;
+
+    ///
+    /// The first byte of the slice, or null if the slice is empty and has no owner.
+    ///
+    const std::uint8_t* bytes() const noexcept;
+
+    ///
+    /// The number of bytes in the slice.
+    ///
+    std::size_t size() const noexcept;
+
+    ///
+    /// Returns the slice as a b_binary value, valid for as long as the slice is alive.
+    ///
+    b_binary view() const noexcept;
+
+    ///
+    /// The document holding the bytes of the slice.
+    ///
+    const std::shared_ptr<const document::value>& owner() const noexcept;
+
+   private:
+    std::shared_ptr<const document::value> _owner;
+    binary_sub_type _sub_type;
+    const std::uint8_t* _bytes;
+    std::size_t _size;
+};
+
+}  // namespace types
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -16,7 +16,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <type_traits>
+#include <utility>
 
 #include <bsoncxx/types.hpp>
 
@@ -353,6 +355,27 @@ class BSONCXX_API value {
     ///
     const b_maxkey& get_maxkey() const;
 
+    ///
+    /// Calls the visitor with the underlying BSON value as its b_xxx type, switching on the type
+    /// once. The visitor must accept every b_xxx type, for example through a generic lambda or an
+    /// overload set, and must return the same type for all of them.
+    ///
+    /// @return The visitor's result.
+    ///
+    template <typename Visitor>
+    auto visit(Visitor&& visitor) const
+        -> decltype(std::forward<Visitor>(visitor)(std::declval<const b_double&>())) {
+        switch (_type) {
+#define BSONCXX_ENUM(name, val)  \
+    case bsoncxx::type::k_##name: \
+        return std::forward<Visitor>(visitor)(_b_##name);
+#include <bsoncxx/enums/type.hpp>
+#undef BSONCXX_ENUM
+        }
+
+        BSONCXX_UNREACHABLE;
+    }
+
    private:
     void BSONCXX_PRIVATE destroy() noexcept;
 
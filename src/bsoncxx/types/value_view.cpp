@@ -0,0 +1,48 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/types/value_view.hpp>
+
+#include <bsoncxx/types/value.hpp>
+
+#include <bsoncxx/config/private/prelude.hh>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+namespace types {
+
+value_view::value_view(const document::element& element) noexcept : _element(element) {}
+
+value_view::operator bool() const noexcept {
+    return static_cast<bool>(_element);
+}
+
+bsoncxx::type value_view::type() const {
+    return _element.type();
+}
+
+#define BSONCXX_ENUM(name, val)              \
+    b_##name value_view::get_##name() const { \
+        return _element.get_##name();        \
+    }
+#include <bsoncxx/enums/type.hpp>
+#undef BSONCXX_ENUM
+
+value value_view::get_value() const {
+    return _element.get_value();
+}
+
+}  // namespace types
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
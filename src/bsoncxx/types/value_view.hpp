@@ -0,0 +1,238 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <bsoncxx/config/prelude.hpp>
+
+namespace bsoncxx {
+BSONCXX_INLINE_NAMESPACE_BEGIN
+
+namespace types {
+
+class value;
+
+///
+/// A lazy, non-owning view of a BSON value inside a serialized document or array.
+///
+/// Unlike types::value, which decodes the element into a tagged union up front, a value_view only
+/// records where the value is and decodes it when one of its accessors is called. It is trivially
+/// copyable, and it is only valid for as long as the underlying BSON bytes are.
+///
+class BSONCXX_API value_view {
+   public:
+    ///
+    /// Constructs an invalid value_view.
+    ///
+    value_view() = default;
+
+    ///
+    /// Constructs a view of the value of an element.
+    ///
+    explicit value_view(const document::element& element) noexcept;
+
+    ///
+    /// @return true if the view refers to a value.
+    ///
+    explicit operator bool() const noexcept;
+
+    ///
+    /// @return The type of the viewed value.
+    ///
+    /// @throws bsoncxx::exception if the view is invalid.
+    ///
+    bsoncxx::type type() const;
+
+    ///
+    /// @return The underlying BSON double value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_double.
+    ///
+    b_double get_double() const;
+
+    ///
+    /// @return The underlying BSON utf8 value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_utf8.
+    ///
+    b_utf8 get_utf8() const;
+
+    ///
+    /// @return The underlying BSON document value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_document.
+    ///
+    b_document get_document() const;
+
+    ///
+    /// @return The underlying BSON array value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_array.
+    ///
+    b_array get_array() const;
+
+    ///
+    /// @return The underlying BSON binary value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_binary.
+    ///
+    b_binary get_binary() const;
+
+    ///
+    /// @return The underlying BSON undefined value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_undefined.
+    ///
+    b_undefined get_undefined() const;
+
+    ///
+    /// @return The underlying BSON oid value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_oid.
+    ///
+    b_oid get_oid() const;
+
+    ///
+    /// @return The underlying BSON bool value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_bool.
+    ///
+    b_bool get_bool() const;
+
+    ///
+    /// @return The underlying BSON date value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_date.
+    ///
+    b_date get_date() const;
+
+    ///
+    /// @return The underlying BSON null value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_null.
+    ///
+    b_null get_null() const;
+
+    ///
+    /// @return The underlying BSON regex value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_regex.
+    ///
+    b_regex get_regex() const;
+
+    ///
+    /// @return The underlying BSON dbpointer value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_dbpointer.
+    ///
+    b_dbpointer get_dbpointer() const;
+
+    ///
+    /// @return The underlying BSON code value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_code.
+    ///
+    b_code get_code() const;
+
+    ///
+    /// @return The underlying BSON symbol value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_symbol.
+    ///
+    b_symbol get_symbol() const;
+
+    ///
+    /// @return The underlying BSON codewscope value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_codewscope.
+    ///
+    b_codewscope get_codewscope() const;
+
+    ///
+    /// @return The underlying BSON int32 value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_int32.
+    ///
+    b_int32 get_int32() const;
+
+    ///
+    /// @return The underlying BSON timestamp value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_timestamp.
+    ///
+    b_timestamp get_timestamp() const;
+
+    ///
+    /// @return The underlying BSON int64 value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_int64.
+    ///
+    b_int64 get_int64() const;
+
+    ///
+    /// @return The underlying BSON decimal128 value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_decimal128.
+    ///
+    b_decimal128 get_decimal128() const;
+
+    ///
+    /// @return The underlying BSON minkey value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_minkey.
+    ///
+    b_minkey get_minkey() const;
+
+    ///
+    /// @return The underlying BSON maxkey value.
+    ///
+    /// @throws bsoncxx::exception if the value is not a b_maxkey.
+    ///
+    b_maxkey get_maxkey() const;
+
+    ///
+    /// @return The value if it has the type T, where T is one of the b_xxx types, or an empty
+    ///   optional otherwise.
+    ///
+    template <typename T>
+    stdx::optional<T> try_get() const {
+        return _element.try_get<T>();
+    }
+
+    ///
+    /// Decodes the viewed value into a types::value.
+    ///
+    /// The result does not own its data: strings, binary data, documents and arrays still point
+    /// into the underlying BSON bytes, so it is only valid for as long as they are.
+    ///
+    /// @throws bsoncxx::exception if the view is invalid.
+    ///
+    value get_value() const;
+
+   private:
+    document::element _element;
+};
+
+}  // namespace types
+
+BSONCXX_INLINE_NAMESPACE_END
+}  // namespace bsoncxx
+
+#include <bsoncxx/config/postlude.hpp>
@@ -14,7 +14,15 @@
 
 #include <bsoncxx/validate.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+#include <bsoncxx/private/element_walk.hh>
 #include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/private/structure.hh>
+#include <bsoncxx/private/utf8.hh>
 #include <bsoncxx/stdx/make_unique.hpp>
 
 #include <bsoncxx/config/private/prelude.hh>
@@ -65,6 +73,82 @@ bool validator::check_dot_keys() const {
     return _impl->_check_dot_keys;
 }
 
+namespace {
+
+// Below this many documents per thread, the cost of starting a thread outweighs the work it takes
+// off the calling thread.
+constexpr std::size_t k_min_docs_per_thread = 512;
+
+// Checks that every key and UTF-8 string value in the document at `doc` (including those in
+// nested documents, arrays and code-with-scope scopes) is valid UTF-8. The document must already
+// have passed structural validation. All other values are stepped over by length without being
+// inspected. On failure, the offset of the innermost offending element relative to `base` is
+// stored in `invalid_offset` (if non-null).
+bool validate_utf8_values(const std::uint8_t* base,
+                          const std::uint8_t* doc,
+                          bool allow_null,
+                          std::size_t* invalid_offset) {
+    const std::size_t length = static_cast<std::size_t>(helpers::read_int32_le(doc));
+    std::size_t pos = 4;
+
+    while (pos < length && doc[pos] != 0) {
+        const auto elem = doc + pos;
+        const auto t = static_cast<type>(elem[0]);
+        const auto key = reinterpret_cast<const char*>(elem + 1);
+        const auto keylen = std::strlen(key);
+        const auto value = elem + 1 + keylen + 1;
+        const auto remaining = length - static_cast<std::size_t>(value - doc);
+
+        const auto fail = [&]() {
+            if (invalid_offset) {
+                *invalid_offset = static_cast<std::size_t>(elem - base);
+            }
+            return false;
+        };
+
+        if (!helpers::utf8_validate(key, keylen, false)) {
+            return fail();
+        }
+
+        switch (t) {
+            case type::k_utf8: {
+                // The encoded length includes the string's null terminator.
+                const auto size = static_cast<std::size_t>(helpers::read_int32_le(value)) - 1;
+                if (!helpers::utf8_validate(
+                        reinterpret_cast<const char*>(value + 4), size, allow_null)) {
+                    return fail();
+                }
+                break;
+            }
+            case type::k_document:
+            case type::k_array:
+                if (!validate_utf8_values(base, value, allow_null, invalid_offset)) {
+                    return false;
+                }
+                break;
+            case type::k_codewscope: {
+                // total length, code string length, code string, scope document
+                const auto code_size = static_cast<std::size_t>(helpers::read_int32_le(value + 4));
+                const auto scope = value + 8 + code_size;
+                if (!validate_utf8_values(base, scope, allow_null, invalid_offset)) {
+                    return false;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        std::size_t value_size;
+        helpers::element_value_size(t, value, remaining, &value_size);
+        pos = static_cast<std::size_t>(value - doc) + value_size;
+    }
+
+    return true;
+}
+
+}  // namespace
+
 stdx::optional<document::view> BSONCXX_CALL validate(const std::uint8_t* data, std::size_t length) {
     const validator vtor{};
     return validate(data, length, vtor);
@@ -85,11 +169,11 @@ stdx::optional<document::view> BSONCXX_CALL validate(const std::uint8_t* data,
 
     flip_if(validator.check_dot_keys(), BSON_VALIDATE_DOT_KEYS);
     flip_if(validator.check_dollar_keys(), BSON_VALIDATE_DOLLAR_KEYS);
-    // we enable VALIDATE_UTF8 if the user wants VALIDATE_UTF8_ALLOW_NULL
-    // otherwise validate_utf8_allow_null() would do nothing due to how libbson
-    // interprets the flag.
-    flip_if((validator.check_utf8() || validator.check_utf8_allow_null()), BSON_VALIDATE_UTF8);
-    flip_if(validator.check_utf8_allow_null(), BSON_VALIDATE_UTF8_ALLOW_NULL);
+
+    // UTF-8 checking is not delegated to libbson, whose checker decodes one byte at a time.
+    // libbson still validates the structure; keys and string values are then checked by
+    // validate_utf8_values() below.
+    const bool check_utf8 = validator.check_utf8() || validator.check_utf8_allow_null();
 
     ::bson_t bson;
     if (!::bson_init_static(&bson, data, length)) {
@@ -103,8 +187,74 @@ stdx::optional<document::view> BSONCXX_CALL validate(const std::uint8_t* data,
         return {};
     }
 
+    if (check_utf8 &&
+        !validate_utf8_values(data, data, validator.check_utf8_allow_null(), invalid_offset)) {
+        return {};
+    }
+
     return document::view{data, length};
 }
 
+stdx::optional<document::view> BSONCXX_CALL validate_structure(const std::uint8_t* data,
+                                                               std::size_t length,
+                                                               std::size_t* invalid_offset) {
+    if (!helpers::check_structure(data, length, [](std::size_t, std::size_t) {}, invalid_offset)) {
+        return {};
+    }
+    return document::view{data, length};
+}
+
+std::vector<validation_result> BSONCXX_CALL validate_many(const document::view* views,
+                                                          std::size_t count,
+                                                          const validator& validator,
+                                                          std::size_t max_threads) {
+    std::vector<validation_result> results(count);
+
+    const auto validate_range = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            auto& result = results[i];
+            result.invalid_offset = 0;
+            result.valid = static_cast<bool>(
+                validate(views[i].data(), views[i].length(), validator, &result.invalid_offset));
+        }
+    };
+
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::size_t num_threads =
+        std::min(max_threads, (count + k_min_docs_per_thread - 1) / k_min_docs_per_thread);
+
+    if (num_threads <= 1) {
+        validate_range(0, count);
+        return results;
+    }
+
+    // Split the batch into contiguous chunks; the calling thread takes the first one.
+    const std::size_t chunk = (count + num_threads - 1) / num_threads;
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        const std::size_t end = std::min(begin + chunk, count);
+        try {
+            workers.emplace_back(validate_range, begin, end);
+        } catch (const std::system_error&) {
+            // Out of threads: do this chunk here instead.
+            validate_range(begin, end);
+        }
+    }
+
+    validate_range(0, chunk);
+
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
+
 BSONCXX_INLINE_NAMESPACE_END
 }  // namespace bsoncxx
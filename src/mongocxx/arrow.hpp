@@ -0,0 +1,137 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include <mongocxx/columnar_cursor.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+//
+// Conversions from columnar batches to Apache Arrow.
+//
+// This header is not included by any other, and the driver itself neither builds nor links against
+// Arrow: applications that include it must provide Arrow C++ 1.0 or later themselves.
+//
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// @return The Arrow type of a column type. Strings are large_utf8, since columnar_batch uses
+///   64-bit offsets, and dates are timestamps in milliseconds in UTC.
+///
+inline std::shared_ptr<::arrow::DataType> to_arrow_type(columnar_batch::column_type type) {
+    using column_type = columnar_batch::column_type;
+    switch (type) {
+        case column_type::k_bool:
+            return ::arrow::boolean();
+        case column_type::k_int64:
+            return ::arrow::int64();
+        case column_type::k_double:
+            return ::arrow::float64();
+        case column_type::k_utf8:
+            return ::arrow::large_utf8();
+        case column_type::k_date:
+            return ::arrow::timestamp(::arrow::TimeUnit::MILLI, "UTC");
+    }
+    return nullptr;
+}
+
+///
+/// @return The Arrow schema of the record batches made from columnar batches with these fields,
+///   for example inferred by columnar_batch::infer_fields(). Fields are named after their paths.
+///
+inline std::shared_ptr<::arrow::Schema> to_arrow_schema(
+    const std::vector<columnar_batch::field>& fields) {
+    std::vector<std::shared_ptr<::arrow::Field>> arrow_fields;
+    for (auto&& f : fields) {
+        arrow_fields.push_back(::arrow::field(f.path, to_arrow_type(f.type)));
+    }
+    return ::arrow::schema(std::move(arrow_fields));
+}
+
+///
+/// Converts a columnar batch to an Arrow record batch.
+///
+/// The arrays wrap the memory of the columns instead of copying it, except for booleans, which
+/// Arrow packs into bits. The columnar batch must therefore outlive the record batch, and not be
+/// cleared or appended to while the record batch is in use.
+///
+/// Batches are converted independently, so a cursor's results can be turned into record batches
+/// concurrently by decoding them with columnar_batch::decode() first.
+///
+inline ::arrow::Result<std::shared_ptr<::arrow::RecordBatch>> to_arrow(
+    const columnar_batch& batch) {
+    using column_type = columnar_batch::column_type;
+
+    const auto rows = static_cast<std::int64_t>(batch.rows());
+    std::vector<std::shared_ptr<::arrow::Field>> fields;
+    std::vector<std::shared_ptr<::arrow::Array>> arrays;
+
+    for (std::size_t i = 0; i < batch.columns(); i++) {
+        const auto& column = batch[i];
+        auto type = to_arrow_type(column.type());
+        std::vector<std::shared_ptr<::arrow::Buffer>> buffers{
+            ::arrow::Buffer::Wrap(column.validity())};
+
+        switch (column.type()) {
+            case column_type::k_bool: {
+                ARROW_ASSIGN_OR_RAISE(auto values, ::arrow::AllocateBitmap(rows));
+                auto bits = values->mutable_data();
+                std::fill(bits, bits + values->size(), std::uint8_t{0});
+                const auto& bools = column.bools();
+                for (std::size_t row = 0; row < bools.size(); row++) {
+                    if (bools[row]) {
+                        bits[row / 8] |= static_cast<std::uint8_t>(1u << (row % 8));
+                    }
+                }
+                buffers.push_back(std::move(values));
+                break;
+            }
+            case column_type::k_int64:
+            case column_type::k_date:
+                buffers.push_back(::arrow::Buffer::Wrap(column.int64s()));
+                break;
+            case column_type::k_double:
+                buffers.push_back(::arrow::Buffer::Wrap(column.doubles()));
+                break;
+            case column_type::k_utf8:
+                buffers.push_back(::arrow::Buffer::Wrap(column.string_offsets()));
+                buffers.push_back(::arrow::Buffer::Wrap(column.string_data().data(),
+                                                        column.string_data().size()));
+                break;
+        }
+
+        fields.push_back(::arrow::field(column.path(), type));
+        arrays.push_back(::arrow::MakeArray(::arrow::ArrayData::Make(
+            type, rows, std::move(buffers), static_cast<std::int64_t>(column.null_count()))));
+    }
+
+    return ::arrow::RecordBatch::Make(::arrow::schema(std::move(fields)), rows, std::move(arrays));
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
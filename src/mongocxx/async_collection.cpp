@@ -0,0 +1,232 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/async_collection.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/executor.hpp>
+#include <mongocxx/private/async_collection.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+async_collection::impl::impl(class pool* pool,
+                             std::string database,
+                             std::string collection,
+                             std::size_t workers)
+    : _queue{std::make_shared<queue>()}, _executor{pool->executor()}, _max_drains{workers} {
+    _queue->pool = pool;
+    _queue->database = std::move(database);
+    _queue->collection = std::move(collection);
+
+    if (_max_drains == 0) {
+        _max_drains = std::max<std::size_t>(_executor->concurrency(), 1);
+    }
+}
+
+async_collection::impl::~impl() {
+    std::unique_lock<std::mutex> lock{_queue->mutex};
+
+    // Drains still queued in the executor may be stuck behind this very thread, so the tasks left
+    // are run here rather than waited for.
+    drain(*_queue, lock);
+    _queue->idle.wait(lock, [this] { return _queue->running == 0; });
+}
+
+void async_collection::impl::enqueue(task task) {
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock{_queue->mutex};
+        _queue->tasks.push_back(std::move(task));
+        if (_queue->scheduled < _max_drains) {
+            _queue->scheduled++;
+            schedule = true;
+        }
+    }
+
+    if (!schedule) {
+        return;
+    }
+
+    auto queue = _queue;
+    try {
+        _executor->submit([queue] {
+            std::unique_lock<std::mutex> lock{queue->mutex};
+            queue->running++;
+            drain(*queue, lock);
+            queue->running--;
+            queue->scheduled--;
+            queue->idle.notify_all();
+        });
+    } catch (...) {
+        // Without a drain in the background, the task runs on the calling thread.
+        std::unique_lock<std::mutex> lock{queue->mutex};
+        queue->scheduled--;
+        drain(*queue, lock);
+    }
+}
+
+void async_collection::impl::drain(queue& queue, std::unique_lock<std::mutex>& lock) {
+    while (!queue.tasks.empty()) {
+        lock.unlock();
+
+        // Keep a client for as long as there are tasks queued, returning it to the pool once the
+        // queue runs dry.
+        stdx::optional<pool::entry> entry;
+        try {
+            entry = queue.pool->acquire();
+        } catch (...) {
+            // Fail the next task with the acquire error; the one after tries again.
+            lock.lock();
+            if (!queue.tasks.empty()) {
+                auto failed = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                lock.unlock();
+                failed(nullptr);
+                lock.lock();
+            }
+            continue;
+        }
+
+        auto coll = (**entry)[queue.database][queue.collection];
+
+        lock.lock();
+        while (!queue.tasks.empty()) {
+            auto next = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            lock.unlock();
+            next(&coll);
+            lock.lock();
+        }
+
+        lock.unlock();
+        entry = stdx::nullopt;
+        lock.lock();
+    }
+}
+
+async_collection::async_collection(pool& pool,
+                                   bsoncxx::string::view_or_value database,
+                                   bsoncxx::string::view_or_value collection,
+                                   std::size_t workers)
+    : _impl(stdx::make_unique<impl>(&pool,
+                                    std::string{database.view()},
+                                    std::string{collection.view()},
+                                    workers)) {}
+
+async_collection::async_collection(async_collection&&) noexcept = default;
+async_collection& async_collection::operator=(async_collection&&) noexcept = default;
+
+async_collection::~async_collection() = default;
+
+void async_collection::_enqueue(task task) {
+    _impl->enqueue(std::move(task));
+}
+
+std::future<std::int64_t> async_collection::count_documents(
+    bsoncxx::document::view_or_value filter, const options::count& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    return submit([owned_filter, options](collection& coll) {
+        return coll.count_documents(owned_filter.view(), options);
+    });
+}
+
+std::future<stdx::optional<result::delete_result>> async_collection::delete_one(
+    bsoncxx::document::view_or_value filter, const options::delete_options& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    return submit([owned_filter, options](collection& coll) {
+        return coll.delete_one(owned_filter.view(), options);
+    });
+}
+
+std::future<stdx::optional<result::delete_result>> async_collection::delete_many(
+    bsoncxx::document::view_or_value filter, const options::delete_options& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    return submit([owned_filter, options](collection& coll) {
+        return coll.delete_many(owned_filter.view(), options);
+    });
+}
+
+std::future<std::vector<bsoncxx::document::value>> async_collection::find(
+    bsoncxx::document::view_or_value filter, const options::find& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    return submit([owned_filter, options](collection& coll) {
+        std::vector<bsoncxx::document::value> documents;
+        for (auto&& document : coll.find(owned_filter.view(), options)) {
+            documents.emplace_back(document);
+        }
+        return documents;
+    });
+}
+
+std::future<stdx::optional<bsoncxx::document::value>> async_collection::find_one(
+    bsoncxx::document::view_or_value filter, const options::find& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    return submit([owned_filter, options](collection& coll) {
+        return coll.find_one(owned_filter.view(), options);
+    });
+}
+
+std::future<stdx::optional<result::insert_one>> async_collection::insert_one(
+    bsoncxx::document::view_or_value document, const options::insert& options) {
+    bsoncxx::document::value owned_document{document.view()};
+    return submit([owned_document, options](collection& coll) {
+        return coll.insert_one(owned_document.view(), options);
+    });
+}
+
+std::future<stdx::optional<result::replace_one>> async_collection::replace_one(
+    bsoncxx::document::view_or_value filter,
+    bsoncxx::document::view_or_value replacement,
+    const options::replace& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    bsoncxx::document::value owned_replacement{replacement.view()};
+    return submit([owned_filter, owned_replacement, options](collection& coll) {
+        return coll.replace_one(owned_filter.view(), owned_replacement.view(), options);
+    });
+}
+
+std::future<stdx::optional<result::update>> async_collection::update_many(
+    bsoncxx::document::view_or_value filter,
+    bsoncxx::document::view_or_value update,
+    const options::update& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    bsoncxx::document::value owned_update{update.view()};
+    return submit([owned_filter, owned_update, options](collection& coll) {
+        return coll.update_many(owned_filter.view(), owned_update.view(), options);
+    });
+}
+
+std::future<stdx::optional<result::update>> async_collection::update_one(
+    bsoncxx::document::view_or_value filter,
+    bsoncxx::document::view_or_value update,
+    const options::update& options) {
+    bsoncxx::document::value owned_filter{filter.view()};
+    bsoncxx::document::value owned_update{update.view()};
+    return submit([owned_filter, owned_update, options](collection& coll) {
+        return coll.update_one(owned_filter.view(), owned_update.view(), options);
+    });
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
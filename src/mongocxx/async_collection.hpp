@@ -0,0 +1,275 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/options/count.hpp>
+#include <mongocxx/options/delete.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/options/insert.hpp>
+#include <mongocxx/options/replace.hpp>
+#include <mongocxx/options/update.hpp>
+#include <mongocxx/result/delete.hpp>
+#include <mongocxx/result/insert_one.hpp>
+#include <mongocxx/result/replace_one.hpp>
+#include <mongocxx/result/update.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class collection;
+class pool;
+
+///
+/// A handle on a MongoDB collection whose operations run asynchronously.
+///
+/// Each operation is queued, and returns a std::future for its result immediately. The queue is
+/// drained by up to `workers` tasks on the executor of the pool (see mongocxx::pool::executor),
+/// which check clients out of the pool, keeping one for as long as operations are queued, so any
+/// number of operations can be in flight without adding threads. Errors are reported by the
+/// future, which rethrows the exception the operation would have thrown.
+///
+/// Operations and completion callbacks run on the threads of the executor, so they must not
+/// block on the futures of other operations: with every thread of the executor blocked, the
+/// operations they wait for cannot start.
+///
+/// Arguments are copied when an operation is queued, so they need not outlive the call.
+///
+/// @warning
+///   The pool must outlive the async_collection. Destroying the async_collection waits for every
+///   queued operation to complete.
+///
+class MONGOCXX_API async_collection {
+   public:
+    ///
+    /// Creates an async_collection running operations on a collection of a pool's deployment.
+    ///
+    /// @param pool
+    ///   The pool to check clients out of.
+    /// @param database
+    ///   The name of the database containing the collection.
+    /// @param collection
+    ///   The name of the collection.
+    /// @param workers
+    ///   The most operations running at once. Zero uses the concurrency of the pool's executor.
+    ///   More workers than the pool's maxPoolSize only add tasks waiting for a client.
+    ///
+    async_collection(pool& pool,
+                     bsoncxx::string::view_or_value database,
+                     bsoncxx::string::view_or_value collection,
+                     std::size_t workers = 0);
+
+    async_collection(async_collection&&) noexcept;
+    async_collection& operator=(async_collection&&) noexcept;
+
+    ///
+    /// Waits for the queued operations to complete, running those that have not started on the
+    /// calling thread.
+    ///
+    ~async_collection();
+
+    ///
+    /// The type returned by a function submitted with submit().
+    ///
+    template <typename function_type>
+    using function_result =
+        decltype(std::declval<function_type&>()(std::declval<collection&>()));
+
+    ///
+    /// Queues a function to be run on a worker with a handle on the collection.
+    ///
+    /// This is the extension point for operations without an asynchronous counterpart below. The
+    /// collection handle is only valid for the duration of the call; cursors and other objects
+    /// tied to its client must not escape it.
+    ///
+    /// @param function
+    ///   The function to run.
+    ///
+    /// @return A future for the value returned by the function.
+    ///
+    template <typename function_type>
+    std::future<function_result<function_type>> submit(function_type function);
+
+    ///
+    /// Queues a function to be run on a worker with a handle on the collection, and calls a
+    /// completion callback with its outcome instead of returning a future.
+    ///
+    /// The callback is called on the executor's thread with a ready future holding the function's
+    /// result or exception. It must not throw, and must not block on further operations of this
+    /// async_collection.
+    ///
+    /// @param function
+    ///   The function to run.
+    /// @param on_complete
+    ///   The function to call with the outcome.
+    ///
+    template <typename function_type, typename callback_type>
+    void submit(function_type function, callback_type on_complete);
+
+    ///
+    /// Asynchronously counts the documents matching a filter.
+    ///
+    /// @see mongocxx::collection::count_documents
+    ///
+    std::future<std::int64_t> count_documents(bsoncxx::document::view_or_value filter,
+                                              const options::count& options = options::count());
+
+    ///
+    /// Asynchronously deletes a single matching document.
+    ///
+    /// @see mongocxx::collection::delete_one
+    ///
+    std::future<stdx::optional<result::delete_result>> delete_one(
+        bsoncxx::document::view_or_value filter,
+        const options::delete_options& options = options::delete_options());
+
+    ///
+    /// Asynchronously deletes all matching documents.
+    ///
+    /// @see mongocxx::collection::delete_many
+    ///
+    std::future<stdx::optional<result::delete_result>> delete_many(
+        bsoncxx::document::view_or_value filter,
+        const options::delete_options& options = options::delete_options());
+
+    ///
+    /// Asynchronously finds the documents matching a filter, collecting the whole result.
+    ///
+    /// @see mongocxx::collection::find
+    ///
+    std::future<std::vector<bsoncxx::document::value>> find(
+        bsoncxx::document::view_or_value filter, const options::find& options = options::find());
+
+    ///
+    /// Asynchronously finds a single document matching a filter.
+    ///
+    /// @see mongocxx::collection::find_one
+    ///
+    std::future<stdx::optional<bsoncxx::document::value>> find_one(
+        bsoncxx::document::view_or_value filter, const options::find& options = options::find());
+
+    ///
+    /// Asynchronously inserts a single document.
+    ///
+    /// @see mongocxx::collection::insert_one
+    ///
+    std::future<stdx::optional<result::insert_one>> insert_one(
+        bsoncxx::document::view_or_value document, const options::insert& options = {});
+
+    ///
+    /// Asynchronously replaces a single document matching a filter.
+    ///
+    /// @see mongocxx::collection::replace_one
+    ///
+    std::future<stdx::optional<result::replace_one>> replace_one(
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value replacement,
+        const options::replace& options = options::replace{});
+
+    ///
+    /// Asynchronously updates all documents matching a filter.
+    ///
+    /// @see mongocxx::collection::update_many
+    ///
+    std::future<stdx::optional<result::update>> update_many(
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        const options::update& options = options::update());
+
+    ///
+    /// Asynchronously updates a single document matching a filter.
+    ///
+    /// @see mongocxx::collection::update_one
+    ///
+    std::future<stdx::optional<result::update>> update_one(
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        const options::update& options = options::update());
+
+   private:
+    // A queued operation. Workers call it with the collection to run on, or with null from within
+    // a catch block if no client could be acquired for it.
+    using task = std::function<void(collection*)>;
+
+    template <typename function_type>
+    struct invoker {
+        using result_type = function_result<function_type>;
+
+        result_type operator()(collection* coll) {
+            if (!coll) {
+                std::rethrow_exception(std::current_exception());
+            }
+            return function(*coll);
+        }
+
+        function_type function;
+    };
+
+    MONGOCXX_PRIVATE void _enqueue(task task);
+
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+template <typename function_type>
+std::future<async_collection::function_result<function_type>> async_collection::submit(
+    function_type function) {
+    using result_type = typename invoker<function_type>::result_type;
+
+    // std::function must be copyable, so the packaged task is shared with the queued task rather
+    // than moved into it.
+    auto packaged = std::make_shared<std::packaged_task<result_type(collection*)>>(
+        invoker<function_type>{std::move(function)});
+    auto result = packaged->get_future();
+
+    _enqueue([packaged](collection* coll) { (*packaged)(coll); });
+
+    return result;
+}
+
+template <typename function_type, typename callback_type>
+void async_collection::submit(function_type function, callback_type on_complete) {
+    using result_type = typename invoker<function_type>::result_type;
+
+    auto packaged = std::make_shared<std::packaged_task<result_type(collection*)>>(
+        invoker<function_type>{std::move(function)});
+
+    _enqueue([packaged, on_complete](collection* coll) mutable {
+        (*packaged)(coll);
+        on_complete(packaged->get_future());
+    });
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,177 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/async_logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/private/async_logger.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+constexpr std::size_t async_logger::impl::k_max_domain_length;
+constexpr std::size_t async_logger::impl::k_max_message_length;
+
+async_logger::impl::impl(std::unique_ptr<logger> sink, log_level max_level, std::size_t capacity)
+    : sink{std::move(sink)}, max_level{max_level}, _ring{capacity} {
+    try {
+        _thread = std::thread{[this] { run(); }};
+    } catch (const std::system_error&) {
+        // Without a background thread, push() hands messages to the sink inline.
+    }
+}
+
+async_logger::impl::~impl() {
+    if (!_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping.store(true, std::memory_order_release);
+    }
+    _wakeup.notify_one();
+    _thread.join();
+}
+
+void async_logger::impl::push(log_level level,
+                              stdx::string_view domain,
+                              stdx::string_view message) noexcept {
+    if (!_thread.joinable()) {
+        std::lock_guard<std::mutex> lock{_inline_mutex};
+        (*sink)(level, domain, message);
+        return;
+    }
+
+    std::size_t position;
+    auto target = _ring.try_claim(&position);
+    if (!target) {
+        // The background thread has not yet consumed the cell a full lap ago.
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    target->level = level;
+    target->domain_length = std::min(domain.size(), k_max_domain_length);
+    std::memcpy(target->domain, domain.data(), target->domain_length);
+    target->message_length = std::min(message.size(), k_max_message_length);
+    std::memcpy(target->message, message.data(), target->message_length);
+    _ring.publish(position);
+
+    if (_waiting.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _wakeup.notify_one();
+    }
+}
+
+void async_logger::impl::flush() {
+    if (!_thread.joinable()) {
+        return;
+    }
+
+    const auto target = _ring.claimed();
+    std::unique_lock<std::mutex> lock{_mutex};
+    while (_ring.freed() < target) {
+        _wakeup.notify_one();
+        _drained.wait_for(lock, std::chrono::milliseconds{10});
+    }
+}
+
+bool async_logger::impl::pop() {
+    auto source = _ring.front();
+    if (!source) {
+        return false;
+    }
+
+    (*sink)(source->level,
+            stdx::string_view{source->domain, source->domain_length},
+            stdx::string_view{source->message, source->message_length});
+
+    _ring.pop_front();
+    return true;
+}
+
+void async_logger::impl::report_dropped() {
+    auto total = dropped.load(std::memory_order_relaxed);
+    if (total == _reported_dropped) {
+        return;
+    }
+
+    auto message = "dropped " + std::to_string(total - _reported_dropped) +
+                   " log messages because the buffer was full";
+    _reported_dropped = total;
+    (*sink)(log_level::k_warning, "mongocxx", message);
+}
+
+void async_logger::impl::run() {
+    for (;;) {
+        while (pop()) {
+        }
+        report_dropped();
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _drained.notify_all();
+        if (_stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        // A push racing with this check may not see _waiting set, so the wait is bounded rather
+        // than relying on its notification.
+        _waiting.store(true, std::memory_order_seq_cst);
+        if (!_ring.front()) {
+            _wakeup.wait_for(lock, std::chrono::milliseconds{10});
+        }
+        _waiting.store(false, std::memory_order_relaxed);
+    }
+
+    // Hand over what was logged before the logger was stopped.
+    while (pop()) {
+    }
+    report_dropped();
+}
+
+async_logger::async_logger(std::unique_ptr<logger> sink, log_level max_level, std::size_t capacity)
+    : _impl{stdx::make_unique<impl>(std::move(sink), max_level, capacity)} {}
+
+async_logger::~async_logger() = default;
+
+void async_logger::operator()(log_level level,
+                              stdx::string_view domain,
+                              stdx::string_view message) noexcept {
+    // The levels are ordered from k_error, the least verbose, to k_trace.
+    if (level > _impl->max_level) {
+        return;
+    }
+    _impl->push(level, domain, message);
+}
+
+void async_logger::flush() {
+    _impl->flush();
+}
+
+std::uint64_t async_logger::dropped() const noexcept {
+    return _impl->dropped.load(std::memory_order_relaxed);
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
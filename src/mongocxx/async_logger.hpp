@@ -0,0 +1,94 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <mongocxx/logger.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// A logger that hands messages to another logger on a background thread, so that logging does
+/// not stall the driver. libmongoc calls its log handler synchronously, sometimes while holding
+/// internal locks, so a slow logger, or a verbose level during an incident, otherwise slows down
+/// every operation.
+///
+/// Messages more verbose than the maximum level are discarded before they are copied. The others
+/// are copied into a bounded ring buffer without blocking; a message that finds the buffer full
+/// is dropped and counted, and the background thread reports the count in a warning. Domains
+/// longer than 64 characters and messages longer than 1024 characters are truncated.
+///
+class MONGOCXX_API async_logger : public logger {
+   public:
+    ///
+    /// Constructs an async_logger and starts its background thread. If the thread cannot be
+    /// started, messages are passed to `sink` on the thread that logs them.
+    ///
+    /// @param sink
+    ///   The logger to hand messages to.
+    /// @param max_level
+    ///   The most verbose level to keep, such as log_level::k_debug.
+    /// @param capacity
+    ///   The most messages waiting for the background thread at once. It is rounded up to a power
+    ///   of two.
+    ///
+    explicit async_logger(std::unique_ptr<logger> sink,
+                          log_level max_level = log_level::k_info,
+                          std::size_t capacity = 1024);
+
+    ///
+    /// Hands the messages that are left to the sink, then stops the background thread.
+    ///
+    ~async_logger() override;
+
+    async_logger(const async_logger&) = delete;
+    async_logger& operator=(const async_logger&) = delete;
+
+    ///
+    /// Queues a message for the sink, unless it is more verbose than the maximum level.
+    ///
+    void operator()(log_level level,
+                    stdx::string_view domain,
+                    stdx::string_view message) noexcept override;
+
+    ///
+    /// Blocks until the messages queued so far have been handed to the sink.
+    ///
+    void flush();
+
+    ///
+    /// Returns the number of messages dropped because the buffer was full.
+    ///
+    /// @return The number of dropped messages.
+    ///
+    std::uint64_t dropped() const noexcept;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,319 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/batch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/executor.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/batch.hh>
+#include <mongocxx/private/executor.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+void batch::impl::operation::run(class collection& coll) {
+    try {
+        switch (type) {
+            case kind::k_find_one:
+                found = coll.find_one(document.view(), find_options);
+                break;
+            case kind::k_insert_one:
+                inserted = coll.insert_one(document.view(), insert_options);
+                break;
+            case kind::k_create_indexes:
+                created = coll.indexes().create_many(indexes, index_options);
+                break;
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    executed = true;
+}
+
+std::exception_ptr batch::impl::drain(const std::vector<operation*>& pending,
+                                      std::atomic<std::size_t>* next) {
+    stdx::optional<pool::entry> client;
+    try {
+        client = pool->acquire();
+    } catch (...) {
+        return std::current_exception();
+    }
+
+    // Consecutive operations usually target the same collection, so keep its handle around.
+    stdx::optional<class collection> coll;
+    const operation* previous = nullptr;
+    for (auto index = next->fetch_add(1); index < pending.size(); index = next->fetch_add(1)) {
+        auto op = pending[index];
+        if (!previous || previous->database != op->database ||
+            previous->collection != op->collection) {
+            coll = (**client)[op->database][op->collection];
+        }
+        previous = op;
+
+        op->run(*coll);
+    }
+
+    return nullptr;
+}
+
+namespace {
+
+std::int64_t progress_count(const bsoncxx::document::element& count) {
+    switch (count.type()) {
+        case bsoncxx::type::k_int32:
+            return count.get_int32().value;
+        case bsoncxx::type::k_int64:
+            return count.get_int64().value;
+        case bsoncxx::type::k_double:
+            return static_cast<std::int64_t>(count.get_double().value);
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+void batch::impl::poll_index_progress(const std::vector<operation*>& pending,
+                                      std::mutex* mutex,
+                                      std::condition_variable* changed,
+                                      const bool* finished) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    bsoncxx::builder::basic::array namespaces;
+    for (auto op : pending) {
+        if (op->type == kind::k_create_indexes) {
+            namespaces.append(op->database + "." + op->collection);
+        }
+    }
+
+    // The createIndexes commands and, on MongoDB 4.4 and later, the index builder threads serving
+    // them both report the namespace being indexed.
+    pipeline current_builds;
+    current_builds.current_op(make_document(kvp("allUsers", true)));
+    current_builds.match(make_document(
+        kvp("ns", make_document(kvp("$in", namespaces.extract()))),
+        kvp("$or",
+            bsoncxx::builder::basic::make_array(
+                make_document(kvp("command.createIndexes", make_document(kvp("$exists", true)))),
+                make_document(kvp("msg", bsoncxx::types::b_regex{"^Index Build"}))))));
+
+    try {
+        auto client = pool->acquire();
+        auto admin = (*client)["admin"];
+
+        std::unique_lock<std::mutex> lock(*mutex);
+        while (!changed->wait_for(lock, progress_interval, [finished] { return *finished; })) {
+            lock.unlock();
+
+            std::vector<index_progress> progress;
+            for (auto&& op : admin.aggregate(current_builds)) {
+                index_progress build{};
+                if (op["ns"] && op["ns"].type() == bsoncxx::type::k_utf8) {
+                    build.ns = std::string{op["ns"].get_utf8().value};
+                }
+                if (op["msg"] && op["msg"].type() == bsoncxx::type::k_utf8) {
+                    build.message = std::string{op["msg"].get_utf8().value};
+                }
+                if (op["progress"] && op["progress"].type() == bsoncxx::type::k_document) {
+                    auto counts = op["progress"].get_document().value;
+                    build.done = counts["done"] ? progress_count(counts["done"]) : 0;
+                    build.total = counts["total"] ? progress_count(counts["total"]) : 0;
+                }
+                progress.push_back(std::move(build));
+            }
+            progress_callback(progress);
+
+            lock.lock();
+        }
+    } catch (...) {
+        // Progress is informational: without the privileges or a client to poll with, the
+        // builds go on unreported.
+    }
+}
+
+const batch::impl::operation& batch::impl::executed(std::size_t index, kind type) const {
+    if (index >= operations.size() || operations[index].type != type) {
+        throw logic_error{error_code::k_invalid_parameter, "no such operation in the batch"};
+    }
+
+    const auto& op = operations[index];
+    if (!op.executed) {
+        throw logic_error{error_code::k_invalid_parameter, "the batch has not been executed"};
+    }
+    if (op.error) {
+        std::rethrow_exception(op.error);
+    }
+
+    return op;
+}
+
+batch::batch(pool& pool, std::size_t max_connections)
+    : _impl(stdx::make_unique<impl>(&pool, max_connections)) {}
+
+batch::batch(batch&&) noexcept = default;
+batch& batch::operator=(batch&&) noexcept = default;
+
+batch::~batch() = default;
+
+std::size_t batch::find_one(bsoncxx::string::view_or_value database,
+                            bsoncxx::string::view_or_value collection,
+                            bsoncxx::document::view_or_value filter,
+                            const options::find& options) {
+    _impl->operations.emplace_back(impl::kind::k_find_one,
+                                   std::string{database.view()},
+                                   std::string{collection.view()},
+                                   bsoncxx::document::value{filter.view()});
+    _impl->operations.back().find_options = options;
+    return _impl->operations.size() - 1;
+}
+
+std::size_t batch::insert_one(bsoncxx::string::view_or_value database,
+                              bsoncxx::string::view_or_value collection,
+                              bsoncxx::document::view_or_value document,
+                              const options::insert& options) {
+    _impl->operations.emplace_back(impl::kind::k_insert_one,
+                                   std::string{database.view()},
+                                   std::string{collection.view()},
+                                   bsoncxx::document::value{document.view()});
+    _impl->operations.back().insert_options = options;
+    return _impl->operations.size() - 1;
+}
+
+std::size_t batch::create_indexes(bsoncxx::string::view_or_value database,
+                                  bsoncxx::string::view_or_value collection,
+                                  std::vector<index_model> indexes,
+                                  const options::index_view& options) {
+    _impl->operations.emplace_back(impl::kind::k_create_indexes,
+                                   std::string{database.view()},
+                                   std::string{collection.view()},
+                                   bsoncxx::document::value{bsoncxx::document::view{}});
+    _impl->operations.back().indexes = std::move(indexes);
+    _impl->operations.back().index_options = options;
+    return _impl->operations.size() - 1;
+}
+
+batch& batch::on_index_progress(index_progress_fn callback, std::chrono::milliseconds interval) {
+    if (interval <= std::chrono::milliseconds::zero()) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "the index progress interval must be positive"};
+    }
+    _impl->progress_callback = std::move(callback);
+    _impl->progress_interval = interval;
+    return *this;
+}
+
+std::size_t batch::size() const noexcept {
+    return _impl->operations.size();
+}
+
+void batch::execute() {
+    std::vector<impl::operation*> pending;
+    for (auto&& op : _impl->operations) {
+        if (!op.executed) {
+            pending.push_back(&op);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    auto connections = pending.size();
+    if (_impl->max_connections > 0) {
+        connections = std::min(connections, _impl->max_connections);
+    }
+
+    std::mutex progress_mutex;
+    std::condition_variable progress_changed;
+    bool finished = false;
+    std::thread progress_poller;
+    const bool builds_pending =
+        std::any_of(pending.begin(), pending.end(), [](const impl::operation* op) {
+            return op->type == impl::kind::k_create_indexes;
+        });
+    if (_impl->progress_callback && builds_pending) {
+        try {
+            progress_poller = std::thread{[&] {
+                _impl->poll_index_progress(
+                    pending, &progress_mutex, &progress_changed, &finished);
+            }};
+        } catch (const std::system_error&) {
+            // Run the batch without reporting progress.
+        }
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::vector<std::exception_ptr> errors(connections);
+    run_parallel(*_impl->pool->executor(), connections, connections, [&](std::size_t i) {
+        errors[i] = _impl->drain(pending, &next);
+    });
+
+    if (progress_poller.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            finished = true;
+        }
+        progress_changed.notify_all();
+        progress_poller.join();
+    }
+
+    // Operations are only left over if no client at all could be acquired.
+    for (auto op : pending) {
+        if (!op->executed) {
+            for (auto&& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    }
+}
+
+const stdx::optional<bsoncxx::document::value>& batch::find_one_result(std::size_t index) const {
+    return _impl->executed(index, impl::kind::k_find_one).found;
+}
+
+const stdx::optional<result::insert_one>& batch::insert_one_result(std::size_t index) const {
+    return _impl->executed(index, impl::kind::k_insert_one).inserted;
+}
+
+const bsoncxx::document::value& batch::create_indexes_result(std::size_t index) const {
+    return *_impl->executed(index, impl::kind::k_create_indexes).created;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
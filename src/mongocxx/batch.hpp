@@ -0,0 +1,208 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/index_model.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/options/index_view.hpp>
+#include <mongocxx/options/insert.hpp>
+#include <mongocxx/result/insert_one.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// A set of independent operations dispatched together over several pooled connections.
+///
+/// Operations are collected with find_one(), insert_one() and create_indexes(), each returning the
+/// index of its result, and then run by execute(). Rather than paying one network round trip after
+/// another, execute() spreads the operations over up to max_connections clients of the pool so
+/// that their round trips overlap. This suits request handlers fanning out to many point reads, as
+/// well as schema migrations building indexes on many collections at once.
+///
+/// Operations run in no particular order, so a batch must only contain operations that do not
+/// depend on one another. The failure of one operation does not prevent the others from running;
+/// it is rethrown when that operation's result is retrieved.
+///
+/// @warning
+///   The pool must outlive the batch.
+///
+class MONGOCXX_API batch {
+   public:
+    ///
+    /// The progress of an index build, as reported by $currentOp.
+    ///
+    struct index_progress {
+        /// The namespace of the collection whose indexes are being built.
+        std::string ns;
+
+        /// The stage of the build, e.g. "Index Build: scanning collection".
+        std::string message;
+
+        /// The units of work done and to do in the current stage, such as documents scanned and
+        /// in the collection. Both are zero if the server does not report them for the stage.
+        std::int64_t done;
+        std::int64_t total;
+    };
+
+    using index_progress_fn = std::function<void(const std::vector<index_progress>&)>;
+
+    ///
+    /// Creates an empty batch.
+    ///
+    /// @param pool
+    ///   The pool to check clients out of.
+    /// @param max_connections
+    ///   The most clients execute() checks out at once. Zero means one per operation.
+    ///
+    explicit batch(pool& pool, std::size_t max_connections = 8);
+
+    batch(batch&&) noexcept;
+    batch& operator=(batch&&) noexcept;
+
+    ~batch();
+
+    ///
+    /// Adds a collection::find_one to the batch.
+    ///
+    /// @return The index of the operation, for use with find_one_result().
+    ///
+    std::size_t find_one(bsoncxx::string::view_or_value database,
+                         bsoncxx::string::view_or_value collection,
+                         bsoncxx::document::view_or_value filter,
+                         const options::find& options = options::find());
+
+    ///
+    /// Adds a collection::insert_one to the batch.
+    ///
+    /// @return The index of the operation, for use with insert_one_result().
+    ///
+    std::size_t insert_one(bsoncxx::string::view_or_value database,
+                           bsoncxx::string::view_or_value collection,
+                           bsoncxx::document::view_or_value document,
+                           const options::insert& options = {});
+
+    ///
+    /// Adds a collection::indexes().create_many() to the batch, which creates indexes on one
+    /// collection with a single createIndexes command.
+    ///
+    /// @return The index of the operation, for use with create_indexes_result().
+    ///
+    std::size_t create_indexes(bsoncxx::string::view_or_value database,
+                               bsoncxx::string::view_or_value collection,
+                               std::vector<index_model> indexes,
+                               const options::index_view& options = {});
+
+    ///
+    /// Reports the progress of the index builds of the batch while execute() runs.
+    ///
+    /// Every interval, a thread started by execute() runs $currentOp on a client of its own and
+    /// passes the index builds in progress on the collections of the batch to the callback. The
+    /// user of the pool needs the inprog privilege; polling stops silently otherwise.
+    ///
+    /// @param callback
+    ///   Called on the polling thread, never concurrently with itself.
+    /// @param interval
+    ///   How often to poll.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the interval is not positive.
+    ///
+    batch& on_index_progress(index_progress_fn callback,
+                             std::chrono::milliseconds interval = std::chrono::seconds{1});
+
+    ///
+    /// The number of operations in the batch.
+    ///
+    std::size_t size() const noexcept;
+
+    ///
+    /// Runs every operation of the batch that has not run yet, returning once all have completed.
+    ///
+    /// The calling thread runs operations itself, along with up to max_connections - 1 tasks of
+    /// the pool's executor (see mongocxx::pool::executor). If on_index_progress() was set and
+    /// index builds are pending, a thread of its own polls their progress with a client of its
+    /// own.
+    ///
+    /// @throws mongocxx::exception if no client could be acquired from the pool.
+    ///
+    void execute();
+
+    ///
+    /// Gets the result of a find_one operation.
+    ///
+    /// @param index
+    ///   The index returned by find_one().
+    ///
+    /// @throws mongocxx::logic_error if the index is not that of an executed find_one operation.
+    /// @throws any exception thrown by the operation.
+    ///
+    const stdx::optional<bsoncxx::document::value>& find_one_result(std::size_t index) const;
+
+    ///
+    /// Gets the result of an insert_one operation.
+    ///
+    /// @param index
+    ///   The index returned by insert_one().
+    ///
+    /// @throws mongocxx::logic_error if the index is not that of an executed insert_one operation.
+    /// @throws any exception thrown by the operation.
+    ///
+    const stdx::optional<result::insert_one>& insert_one_result(std::size_t index) const;
+
+    ///
+    /// Gets the result of a create_indexes operation.
+    ///
+    /// @param index
+    ///   The index returned by create_indexes().
+    ///
+    /// @return The reply of the createIndexes command, as returned by index_view::create_many().
+    ///
+    /// @throws mongocxx::logic_error if the index is not that of an executed create_indexes
+    ///   operation.
+    /// @throws any exception thrown by the operation.
+    ///
+    const bsoncxx::document::value& create_indexes_result(std::size_t index) const;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,411 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/buffered_writer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/concatenate.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/bulk_write_exception.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/server_error_code.hpp>
+#include <mongocxx/exception/write_exception.hpp>
+#include <mongocxx/options/bulk_write.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/buffered_writer.hh>
+#include <mongocxx/result/bulk_write.hpp>
+#include <mongocxx/write_concern.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+// Builds the write_exception for the first write error of a failed ordered bulk write, and sets
+// `index` to the position of the write that failed. Returns nullptr if the bulk write failed
+// without a write error, as for a network error or a write concern error.
+std::exception_ptr first_write_error(const bulk_write_exception& e, std::size_t* index) {
+    if (!e.raw_server_error()) {
+        return nullptr;
+    }
+
+    auto write_errors = e.raw_server_error()->view()["writeErrors"];
+    if (!write_errors || write_errors.type() != bsoncxx::type::k_array) {
+        return nullptr;
+    }
+
+    for (auto&& error : write_errors.get_array().value) {
+        auto doc = error.get_document().value;
+        *index = static_cast<std::size_t>(doc["index"].get_int32().value);
+
+        std::string message;
+        if (doc["errmsg"] && doc["errmsg"].type() == bsoncxx::type::k_utf8) {
+            message = doc["errmsg"].get_utf8().value.to_string();
+        }
+        return std::make_exception_ptr(
+            write_exception{std::error_code{doc["code"].get_int32().value, server_error_category()},
+                            bsoncxx::document::value{doc},
+                            message});
+    }
+
+    return nullptr;
+}
+
+}  // namespace
+
+buffered_writer::impl::impl(class pool* pool,
+                            std::string database,
+                            std::string collection,
+                            std::size_t max_batch_size,
+                            std::chrono::milliseconds max_delay,
+                            std::size_t capacity)
+    : _pool{pool},
+      _database{std::move(database)},
+      _collection{std::move(collection)},
+      _max_batch_size{max_batch_size},
+      _max_delay{max_delay},
+      _ring{capacity} {
+    _thread = std::thread{[this] { run(); }};
+}
+
+buffered_writer::impl::~impl() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping.store(true, std::memory_order_release);
+    }
+    _wakeup.notify_one();
+    _thread.join();
+}
+
+void buffered_writer::impl::push(std::unique_ptr<request> queued) {
+    std::size_t position;
+    cell* target;
+    while (!(target = _ring.try_claim(&position))) {
+        // The ring buffer is full. Unlike a log message, a write may not be dropped, so wait for
+        // the background thread to take writes out of it.
+        std::unique_lock<std::mutex> lock{_mutex};
+        _wakeup.notify_one();
+        _space.wait_for(lock, std::chrono::milliseconds{1});
+    }
+
+    target->queued = std::move(queued);
+    _ring.publish(position);
+
+    if (_waiting.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _wakeup.notify_one();
+    }
+}
+
+void buffered_writer::impl::flush() {
+    const auto target = _ring.claimed();
+    auto current = _flush_target.load(std::memory_order_relaxed);
+    while (current < target && !_flush_target.compare_exchange_weak(current, target)) {
+    }
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    while (_completed.load(std::memory_order_acquire) < target) {
+        _wakeup.notify_one();
+        _drained.wait_for(lock, std::chrono::milliseconds{10});
+    }
+}
+
+std::unique_ptr<buffered_writer::impl::request> buffered_writer::impl::pop() {
+    auto source = _ring.front();
+    if (!source) {
+        return nullptr;
+    }
+
+    auto queued = std::move(source->queued);
+    _ring.pop_front();
+    return queued;
+}
+
+void buffered_writer::impl::run() {
+    std::vector<std::unique_ptr<request>> batch;
+    auto oldest = std::chrono::steady_clock::now();
+
+    for (;;) {
+        bool popped = false;
+        while (batch.size() < _max_batch_size) {
+            auto queued = pop();
+            if (!queued) {
+                break;
+            }
+            if (batch.empty()) {
+                oldest = std::chrono::steady_clock::now();
+            }
+            batch.push_back(std::move(queued));
+            popped = true;
+        }
+        if (popped) {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _space.notify_all();
+        }
+
+        const bool stopping = _stopping.load(std::memory_order_acquire);
+        const bool flushing = _completed.load(std::memory_order_acquire) <
+                              _flush_target.load(std::memory_order_acquire);
+        const auto waited = std::chrono::steady_clock::now() - oldest;
+
+        if (!batch.empty() &&
+            (batch.size() >= _max_batch_size || stopping || flushing || waited >= _max_delay)) {
+            // Writes left in the batch after a failed write have waited long enough already, so
+            // `oldest` is kept and they are sent on the next pass.
+            write(&batch);
+            std::lock_guard<std::mutex> lock{_mutex};
+            _drained.notify_all();
+            continue;
+        }
+
+        if (stopping && batch.empty()) {
+            break;
+        }
+
+        // A push racing with this check may not see _waiting set, so the wait is bounded rather
+        // than relying on its notification.
+        std::unique_lock<std::mutex> lock{_mutex};
+        _waiting.store(true, std::memory_order_seq_cst);
+        if (!_ring.front() && !_stopping.load(std::memory_order_acquire)) {
+            std::chrono::steady_clock::duration timeout = std::chrono::milliseconds{10};
+            if (!batch.empty()) {
+                timeout = std::min(timeout, _max_delay - waited);
+            }
+            _wakeup.wait_for(lock, timeout);
+        }
+        _waiting.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    _drained.notify_all();
+}
+
+void buffered_writer::impl::write_posted(std::vector<std::unique_ptr<request>>* batch) {
+    auto posted_begin = std::stable_partition(
+        batch->begin(), batch->end(), [](const std::unique_ptr<request>& queued) {
+            return !queued->posted();
+        });
+    const auto posted_count = static_cast<std::size_t>(batch->end() - posted_begin);
+    if (posted_count == 0) {
+        return;
+    }
+
+    try {
+        write_concern unacknowledged;
+        unacknowledged.acknowledge_level(write_concern::level::k_unacknowledged);
+
+        auto client = _pool->acquire();
+        auto writes = (*client)[_database][_collection].create_bulk_write(
+            options::bulk_write{}.ordered(false).write_concern(std::move(unacknowledged)));
+        for (auto it = posted_begin; it != batch->end(); ++it) {
+            auto document = (*it)->write.get_insert_one().document().view();
+            writes.append_insert_raw(document.data(), document.length());
+        }
+        writes.execute();
+    } catch (...) {
+        // Whoever posted the inserts accepted that they may be lost.
+    }
+
+    batch->erase(posted_begin, batch->end());
+    _completed.fetch_add(posted_count, std::memory_order_release);
+}
+
+void buffered_writer::impl::write(std::vector<std::unique_ptr<request>>* batch) {
+    write_posted(batch);
+    if (batch->empty()) {
+        return;
+    }
+
+    std::vector<std::unique_ptr<request>> sent;
+    std::exception_ptr error;
+
+    try {
+        auto client = _pool->acquire();
+        auto writes = (*client)[_database][_collection].create_bulk_write(
+            options::bulk_write{}.ordered(true));
+
+        for (auto&& queued : *batch) {
+            try {
+                writes.append(queued->write);
+            } catch (const logic_error&) {
+                // The write is malformed, such as an update without update operators. It fails
+                // on its own rather than failing the batch.
+                fail(queued.get(), std::current_exception());
+                continue;
+            }
+            sent.push_back(std::move(queued));
+        }
+        batch->clear();
+
+        if (sent.empty()) {
+            return;
+        }
+
+        try {
+            auto result = writes.execute();
+            for (auto&& written : sent) {
+                succeed(written.get(), static_cast<bool>(result));
+            }
+            return;
+        } catch (const bulk_write_exception& e) {
+            std::size_t failed_index;
+            auto write_error = first_write_error(e, &failed_index);
+            if (!write_error || failed_index >= sent.size()) {
+                throw;
+            }
+
+            // The bulk write is ordered, so the writes before the failed one were written and
+            // those after it were not attempted.
+            for (std::size_t i = 0; i < failed_index; ++i) {
+                succeed(sent[i].get(), true);
+            }
+            fail(sent[failed_index].get(), write_error);
+            for (std::size_t i = failed_index + 1; i < sent.size(); ++i) {
+                batch->push_back(std::move(sent[i]));
+            }
+            return;
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    for (auto&& written : sent) {
+        fail(written.get(), error);
+    }
+    for (auto&& queued : *batch) {
+        if (queued) {
+            fail(queued.get(), error);
+        }
+    }
+    batch->clear();
+}
+
+void buffered_writer::impl::succeed(request* sent, bool acknowledged) {
+    if (sent->write.type() != write_type::k_insert_one) {
+        sent->updated->set_value();
+    } else if (!acknowledged) {
+        sent->inserted->set_value(stdx::nullopt);
+    } else {
+        result::bulk_write reply{make_document(kvp("nInserted", 1),
+                                               kvp("nMatched", 0),
+                                               kvp("nModified", 0),
+                                               kvp("nRemoved", 0),
+                                               kvp("nUpserted", 0))};
+        sent->inserted->set_value(
+            result::insert_one{std::move(reply), sent->id.view()["_id"].get_value()});
+    }
+    _completed.fetch_add(1, std::memory_order_release);
+}
+
+void buffered_writer::impl::fail(request* sent, std::exception_ptr error) {
+    if (sent->write.type() == write_type::k_insert_one) {
+        sent->inserted->set_exception(error);
+    } else {
+        sent->updated->set_exception(error);
+    }
+    _completed.fetch_add(1, std::memory_order_release);
+}
+
+buffered_writer::buffered_writer(class pool& pool,
+                                 bsoncxx::string::view_or_value database,
+                                 bsoncxx::string::view_or_value collection,
+                                 std::size_t max_batch_size,
+                                 std::chrono::milliseconds max_delay,
+                                 std::size_t capacity) {
+    if (max_batch_size == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "max_batch_size must be positive"};
+    }
+    if (max_delay.count() < 0) {
+        throw logic_error{error_code::k_invalid_parameter, "max_delay must not be negative"};
+    }
+
+    _impl = stdx::make_unique<impl>(&pool,
+                                    database.view().to_string(),
+                                    collection.view().to_string(),
+                                    max_batch_size,
+                                    max_delay,
+                                    capacity);
+}
+
+buffered_writer::~buffered_writer() = default;
+
+std::future<stdx::optional<result::insert_one>> buffered_writer::insert_one(
+    bsoncxx::document::view_or_value document) {
+    auto view = document.view();
+    bsoncxx::document::value owned{view};
+    if (!view["_id"]) {
+        bsoncxx::builder::basic::document with_id;
+        with_id.append(kvp("_id", bsoncxx::oid{}), bsoncxx::builder::concatenate(view));
+        owned = with_id.extract();
+    }
+    auto id = make_document(kvp("_id", owned.view()["_id"].get_value()));
+
+    auto queued = stdx::make_unique<impl::request>(model::insert_one{std::move(owned)});
+    queued->id = std::move(id);
+    queued->inserted = stdx::make_unique<std::promise<stdx::optional<result::insert_one>>>();
+    auto future = queued->inserted->get_future();
+    _impl->push(std::move(queued));
+    return future;
+}
+
+std::future<void> buffered_writer::update_one(const model::update_one& update) {
+    model::update_one copy{bsoncxx::document::value{update.filter().view()},
+                           bsoncxx::document::value{update.update().view()}};
+    if (update.collation()) {
+        copy.collation(bsoncxx::document::value{update.collation()->view()});
+    }
+    if (update.upsert()) {
+        copy.upsert(*update.upsert());
+    }
+    if (update.array_filters()) {
+        copy.array_filters(bsoncxx::array::value{update.array_filters()->view()});
+    }
+
+    auto queued = stdx::make_unique<impl::request>(std::move(copy));
+    queued->updated = stdx::make_unique<std::promise<void>>();
+    auto future = queued->updated->get_future();
+    _impl->push(std::move(queued));
+    return future;
+}
+
+void buffered_writer::post_insert_one(bsoncxx::document::view_or_value document) {
+    // libmongoc generates a missing _id while it encodes the insert, so the document is only
+    // copied when it is not already owned.
+    if (!document.is_owning()) {
+        document = bsoncxx::document::value{document.view()};
+    }
+    _impl->push(stdx::make_unique<impl::request>(model::insert_one{std::move(document)}));
+}
+
+void buffered_writer::flush() {
+    _impl->flush();
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,151 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/model/update_one.hpp>
+#include <mongocxx/result/insert_one.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// Coalesces single inserts and updates from many threads into bulk writes.
+///
+/// Calling collection::insert_one() for every event of a high-rate stream costs a round-trip per
+/// event. A buffered_writer instead queues each write and returns a future for it at once. A
+/// background thread gathers the queued writes into an ordered bulk write, which it sends when
+/// it holds `max_batch_size` writes or when its oldest write has waited `max_delay`, and then
+/// resolves the futures of the writes it sent.
+///
+/// The writing threads hand their writes over through a bounded ring buffer, claiming a slot with
+/// a compare-and-swap as async_logger does, so that queueing a write never takes a lock. A write
+/// that finds the ring buffer full waits for the background thread to make room.
+///
+/// Writes are sent in the order they were queued. When a write of a batch fails, because of a
+/// duplicate key for example, its future holds a mongocxx::write_exception, and the writes queued
+/// after it are sent in the next batch. When a whole batch fails, every future of the batch holds
+/// the exception.
+///
+/// A buffered_writer may be used by several threads at once.
+///
+/// @warning
+///   The pool must outlive the buffered_writer.
+///
+class MONGOCXX_API buffered_writer {
+   public:
+    ///
+    /// Creates a buffered_writer for a collection and starts its background thread.
+    ///
+    /// @param pool
+    ///   The pool to check a client out of for every batch.
+    /// @param database
+    ///   The name of the database of the collection.
+    /// @param collection
+    ///   The name of the collection to write to.
+    /// @param max_batch_size
+    ///   The number of queued writes at which a batch is sent. Must be positive.
+    /// @param max_delay
+    ///   How long a write may wait for its batch to fill before the batch is sent anyway. Must not
+    ///   be negative.
+    /// @param capacity
+    ///   The most writes waiting for the background thread at once. It is rounded up to a power of
+    ///   two.
+    ///
+    /// @throws mongocxx::logic_error if max_batch_size is zero or max_delay is negative.
+    ///
+    buffered_writer(pool& pool,
+                    bsoncxx::string::view_or_value database,
+                    bsoncxx::string::view_or_value collection,
+                    std::size_t max_batch_size = 1000,
+                    std::chrono::milliseconds max_delay = std::chrono::milliseconds{10},
+                    std::size_t capacity = 16384);
+
+    ///
+    /// Sends the writes that are still queued, then stops the background thread.
+    ///
+    ~buffered_writer();
+
+    buffered_writer(const buffered_writer&) = delete;
+    buffered_writer& operator=(const buffered_writer&) = delete;
+
+    ///
+    /// Queues the insertion of a document, generating its _id if it has none.
+    ///
+    /// @param document
+    ///   The document to insert. It is copied before this returns.
+    ///
+    /// @return A future for the result of the insert, which is disengaged if the write concern is
+    /// unacknowledged.
+    ///
+    std::future<stdx::optional<result::insert_one>> insert_one(
+        bsoncxx::document::view_or_value document);
+
+    ///
+    /// Queues the insertion of a document without a way to learn its outcome, for streams such as
+    /// metrics where losing a write is acceptable.
+    ///
+    /// No _id is generated, no future is made and the document is not copied if it is owned.
+    /// Posted inserts are taken out of each batch and sent first as their own unordered bulk write
+    /// with an unacknowledged write concern, so they may be written out of order with the other
+    /// writes, and any error, including a network error, is ignored. flush() still waits for
+    /// them to be sent.
+    ///
+    /// @param document
+    ///   The document to insert.
+    ///
+    void post_insert_one(bsoncxx::document::view_or_value document);
+
+    ///
+    /// Queues the update of a document.
+    ///
+    /// The future only tells whether the update succeeded: the server reports the matched and
+    /// modified counts of a bulk write as totals for the whole batch.
+    ///
+    /// @param update
+    ///   The update to apply. Its documents are copied before this returns.
+    ///
+    /// @return A future that is ready once the update was written.
+    ///
+    std::future<void> update_one(const model::update_one& update);
+
+    ///
+    /// Sends the writes queued so far without waiting for their batch to fill, and blocks until
+    /// their futures are ready.
+    ///
+    void flush();
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
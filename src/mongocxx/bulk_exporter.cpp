@@ -0,0 +1,176 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/bulk_exporter.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <bsoncxx/bson_file.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/pool.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class bulk_exporter::impl {
+   public:
+    impl(class pool* pool, std::string database, std::string collection)
+        : pool(pool),
+          database(std::move(database)),
+          collection(std::move(collection)),
+          partitions(static_cast<std::int32_t>(std::max(std::thread::hardware_concurrency(), 1u))),
+          format(file_format::k_bson),
+          json_mode(bsoncxx::ExtendedJsonMode::k_relaxed),
+          buffer_bytes(bsoncxx::bson_file_writer::k_default_buffer_size) {}
+
+    // Writes the documents of one range. The JSON buffer keeps its capacity from one document to
+    // the next, so converting a range allocates only while documents keep getting larger.
+    void write(cursor* range, partition* written) {
+        bsoncxx::bson_file_writer out{written->path, buffer_bytes};
+        std::string json;
+        for (auto&& document : *range) {
+            if (format == file_format::k_bson) {
+                out.write(document);
+            } else {
+                json.clear();
+                bsoncxx::to_json(document, json, json_mode);
+                json.push_back('\n');
+                out.write(reinterpret_cast<const std::uint8_t*>(json.data()), json.size());
+            }
+            written->documents++;
+        }
+        out.close();
+        written->bytes = out.size();
+    }
+
+    class pool* pool;
+    std::string database;
+    std::string collection;
+    std::int32_t partitions;
+    file_format format;
+    bsoncxx::ExtendedJsonMode json_mode;
+    std::size_t buffer_bytes;
+    bsoncxx::document::view_or_value filter;
+    options::find find_options;
+};
+
+bulk_exporter::bulk_exporter(class pool& pool,
+                             bsoncxx::string::view_or_value database,
+                             bsoncxx::string::view_or_value collection)
+    : _impl(stdx::make_unique<impl>(
+          &pool, database.terminated().data(), collection.terminated().data())) {}
+
+bulk_exporter::bulk_exporter(bulk_exporter&&) noexcept = default;
+bulk_exporter& bulk_exporter::operator=(bulk_exporter&&) noexcept = default;
+
+bulk_exporter::~bulk_exporter() = default;
+
+bulk_exporter& bulk_exporter::partitions(std::int32_t count) {
+    if (count <= 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "an export needs at least one partition"};
+    }
+    _impl->partitions = count;
+    return *this;
+}
+
+bulk_exporter& bulk_exporter::format(file_format format) {
+    _impl->format = format;
+    return *this;
+}
+
+bulk_exporter& bulk_exporter::json_mode(bsoncxx::ExtendedJsonMode mode) {
+    _impl->json_mode = mode;
+    return *this;
+}
+
+bulk_exporter& bulk_exporter::filter(bsoncxx::document::view_or_value filter,
+                                     const options::find& options) {
+    _impl->filter = std::move(filter);
+    _impl->find_options = options;
+    return *this;
+}
+
+bulk_exporter& bulk_exporter::buffer_bytes(std::size_t bytes) {
+    _impl->buffer_bytes = bytes;
+    return *this;
+}
+
+std::vector<bulk_exporter::partition> bulk_exporter::export_to(const std::string& path_prefix) {
+    std::vector<cursor> ranges;
+    {
+        auto client = _impl->pool->acquire();
+        auto coll = (*client)[_impl->database][_impl->collection];
+        ranges = coll.parallel_scan(
+            *_impl->pool, _impl->partitions, _impl->filter.view(), _impl->find_options);
+    }
+
+    const auto extension = _impl->format == file_format::k_bson ? ".bson" : ".json";
+    std::vector<partition> written;
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        written.push_back({path_prefix + "." + std::to_string(i) + extension, 0, 0});
+    }
+
+    std::vector<std::exception_ptr> errors(ranges.size());
+    const auto run = [&](std::size_t i) {
+        try {
+            _impl->write(&ranges[i], &written[i]);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    // The calling thread writes the first range, and the ranges of helpers that cannot be
+    // started once the others are done.
+    std::vector<std::thread> helpers;
+    std::size_t started = 1;
+    for (; started < ranges.size(); started++) {
+        try {
+            helpers.emplace_back(run, started);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    if (!ranges.empty()) {
+        run(0);
+    }
+    for (auto i = started; i < ranges.size(); i++) {
+        run(i);
+    }
+    for (auto&& helper : helpers) {
+        helper.join();
+    }
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return written;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,166 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/json.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/options/find.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// Exports a collection to files over several pooled connections, the mirror of bulk_loader.
+///
+/// The collection is split by _id into ranges with collection::parallel_scan(), and a thread per
+/// range writes its documents to a file of its own, either as concatenated BSON, in the format of
+/// mongodump and bsoncxx::bson_file_reader, or as line-delimited Extended JSON. BSON documents are
+/// written straight from the cursor's reply buffers. JSON text is generated by bsoncxx::to_json()
+/// into a buffer that each thread reuses for all of its documents.
+///
+/// The warning of collection::parallel_scan() applies: all _id values must have the same type.
+///
+/// @warning
+///   The pool must outlive the exporter.
+///
+class MONGOCXX_API bulk_exporter {
+   public:
+    enum class file_format {
+        /// Concatenated BSON documents, written to files ending in ".bson".
+        k_bson,
+
+        /// One Extended JSON document per line, written to files ending in ".json".
+        k_ldjson,
+    };
+
+    ///
+    /// What was written to one file.
+    ///
+    struct partition {
+        std::string path;
+        std::uint64_t documents;
+        std::uint64_t bytes;
+    };
+
+    ///
+    /// Creates an exporter of a collection.
+    ///
+    /// @param pool
+    ///   The pool to check clients out of.
+    /// @param database
+    ///   The database of the collection to export.
+    /// @param collection
+    ///   The collection to export.
+    ///
+    bulk_exporter(pool& pool,
+                  bsoncxx::string::view_or_value database,
+                  bsoncxx::string::view_or_value collection);
+
+    bulk_exporter(bulk_exporter&&) noexcept;
+    bulk_exporter& operator=(bulk_exporter&&) noexcept;
+
+    ~bulk_exporter();
+
+    ///
+    /// Sets the number of _id ranges, and so of threads and files. Defaults to
+    /// std::thread::hardware_concurrency(). Fewer files are written if the collection has too
+    /// few documents.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the count is not positive.
+    ///
+    bulk_exporter& partitions(std::int32_t count);
+
+    ///
+    /// Sets the format of the files. Defaults to file_format::k_bson.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_exporter& format(file_format format);
+
+    ///
+    /// Sets the Extended JSON mode of file_format::k_ldjson files. Defaults to relaxed, as written
+    /// by mongoexport.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_exporter& json_mode(bsoncxx::ExtendedJsonMode mode);
+
+    ///
+    /// Sets the filter and the find options of the documents to export. Defaults to all
+    /// documents.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_exporter& filter(bsoncxx::document::view_or_value filter,
+                          const options::find& options = options::find());
+
+    ///
+    /// Sets the write buffer size of each file.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_exporter& buffer_bytes(std::size_t bytes);
+
+    ///
+    /// Exports the collection, returning once every file has been written.
+    ///
+    /// @param path_prefix
+    ///   The beginning of the file paths. The file of the n-th range, starting at zero, is named
+    ///   after the prefix followed by ".<n>" and the extension of the format.
+    ///
+    /// @return The files that were written, in _id order.
+    ///
+    /// @throws mongocxx::operation_exception if the ranges could not be computed.
+    /// @throws mongocxx::query_exception if a range could not be read.
+    /// @throws bsoncxx::exception if a file could not be written, or a document converted to
+    ///   JSON.
+    ///
+    /// If a range fails, the other ranges are still exported and the first failure is rethrown.
+    ///
+    std::vector<partition> export_to(const std::string& path_prefix);
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
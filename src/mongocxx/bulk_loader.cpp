@@ -0,0 +1,293 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/bulk_loader.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <bsoncxx/bson_file.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/pool.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+constexpr std::size_t bulk_loader::k_default_batch_bytes;
+
+double bulk_loader::progress::documents_per_second() const {
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? static_cast<double>(documents) / seconds : 0;
+}
+
+double bulk_loader::progress::megabytes_per_second() const {
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? static_cast<double>(bytes) / 1000000.0 / seconds : 0;
+}
+
+class bulk_loader::impl {
+   public:
+    impl(class pool* pool, std::string database, std::string collection)
+        : pool(pool),
+          database(std::move(database)),
+          collection(std::move(collection)),
+          threads(std::max(std::thread::hardware_concurrency(), 1u)),
+          batch_bytes(k_default_batch_bytes),
+          max_pending_batches(0),
+          progress_interval(0) {
+        insert_options.ordered(false);
+    }
+
+    // Documents of one file, which stay valid as long as its reader.
+    struct batch {
+        std::vector<bsoncxx::document::view> documents;
+        std::uint64_t bytes = 0;
+    };
+
+    // What the producer and the workers of one load share.
+    struct load {
+        std::mutex mutex;
+        std::condition_variable not_full;
+        std::condition_variable not_empty;
+        std::deque<batch> pending;
+        bool done = false;
+        std::exception_ptr error;
+
+        std::atomic<std::uint64_t> documents{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        std::mutex progress_mutex;
+        std::chrono::steady_clock::time_point last_report = start;
+    };
+
+    progress snapshot(const load& state) const {
+        return progress{state.documents.load(),
+                        state.bytes.load(),
+                        std::chrono::steady_clock::now() - state.start};
+    }
+
+    // Waits for room in the queue, and returns false instead if a worker failed.
+    bool push(load* state, batch* next) {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        const auto limit = max_pending_batches ? max_pending_batches : 2 * threads;
+        state->not_full.wait(
+            lock, [&] { return state->pending.size() < limit || state->error; });
+        if (state->error) {
+            return false;
+        }
+        state->pending.push_back(std::move(*next));
+        *next = batch{};
+        lock.unlock();
+        state->not_empty.notify_one();
+        return true;
+    }
+
+    void finish(load* state) {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done = true;
+        }
+        state->not_empty.notify_all();
+    }
+
+    void work(load* state) {
+        try {
+            auto client = pool->acquire();
+            auto coll = (*client)[database][collection];
+            for (;;) {
+                batch next;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->not_empty.wait(lock, [&] {
+                        return !state->pending.empty() || state->done || state->error;
+                    });
+                    if (state->error || state->pending.empty()) {
+                        return;
+                    }
+                    next = std::move(state->pending.front());
+                    state->pending.pop_front();
+                }
+                state->not_full.notify_one();
+
+                coll.insert_many(next.documents.begin(), next.documents.end(), insert_options);
+                state->documents += next.documents.size();
+                state->bytes += next.bytes;
+                report(state);
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            state->not_full.notify_all();
+            state->not_empty.notify_all();
+        }
+    }
+
+    void report(load* state) {
+        if (!progress_callback) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(state->progress_mutex);
+        const auto now = std::chrono::steady_clock::now();
+        if (now - state->last_report < progress_interval) {
+            return;
+        }
+        state->last_report = now;
+        progress_callback(snapshot(*state));
+    }
+
+    // Cuts the files into batches for the workers, stopping early if one of them failed.
+    void produce(const std::vector<std::string>& paths,
+                 std::vector<bsoncxx::bson_file_reader>* readers,
+                 load* state) {
+        for (auto&& path : paths) {
+            readers->emplace_back(path);
+            const auto& reader = readers->back();
+
+            batch next;
+            for (auto&& document : reader) {
+                next.documents.push_back(document);
+                next.bytes += document.length();
+                if (next.bytes >= batch_bytes && !push(state, &next)) {
+                    return;
+                }
+            }
+            if (!next.documents.empty() && !push(state, &next)) {
+                return;
+            }
+        }
+    }
+
+    class pool* pool;
+    std::string database;
+    std::string collection;
+    std::size_t threads;
+    std::size_t batch_bytes;
+    std::size_t max_pending_batches;
+    options::insert insert_options;
+    progress_fn progress_callback;
+    std::chrono::milliseconds progress_interval;
+};
+
+bulk_loader::bulk_loader(class pool& pool,
+                         bsoncxx::string::view_or_value database,
+                         bsoncxx::string::view_or_value collection)
+    : _impl(stdx::make_unique<impl>(
+          &pool, database.terminated().data(), collection.terminated().data())) {}
+
+bulk_loader::bulk_loader(bulk_loader&&) noexcept = default;
+bulk_loader& bulk_loader::operator=(bulk_loader&&) noexcept = default;
+
+bulk_loader::~bulk_loader() = default;
+
+bulk_loader& bulk_loader::threads(std::size_t count) {
+    if (count == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "a bulk load needs at least one thread"};
+    }
+    _impl->threads = count;
+    return *this;
+}
+
+bulk_loader& bulk_loader::batch_bytes(std::size_t bytes) {
+    if (bytes == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "the batch size must be positive"};
+    }
+    _impl->batch_bytes = bytes;
+    return *this;
+}
+
+bulk_loader& bulk_loader::max_pending_batches(std::size_t count) {
+    if (count == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "at least one batch must be able to wait for a worker"};
+    }
+    _impl->max_pending_batches = count;
+    return *this;
+}
+
+bulk_loader& bulk_loader::insert_options(options::insert options) {
+    _impl->insert_options = std::move(options);
+    return *this;
+}
+
+bulk_loader& bulk_loader::on_progress(progress_fn callback, std::chrono::milliseconds interval) {
+    _impl->progress_callback = std::move(callback);
+    _impl->progress_interval = interval;
+    return *this;
+}
+
+bulk_loader::progress bulk_loader::load_file(const std::string& path) {
+    return load_files({path});
+}
+
+bulk_loader::progress bulk_loader::load_files(const std::vector<std::string>& paths) {
+    impl::load state;
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < _impl->threads; i++) {
+        try {
+            workers.emplace_back([&] { _impl->work(&state); });
+        } catch (const std::system_error&) {
+            // Load over the workers that could be started.
+            if (workers.empty()) {
+                throw;
+            }
+            break;
+        }
+    }
+
+    // The views of the batches point into the mappings, so the readers outlive the workers.
+    std::vector<bsoncxx::bson_file_reader> readers;
+    std::exception_ptr read_error;
+    try {
+        _impl->produce(paths, &readers, &state);
+    } catch (...) {
+        read_error = std::current_exception();
+    }
+
+    _impl->finish(&state);
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    if (read_error) {
+        std::rethrow_exception(read_error);
+    }
+    return _impl->snapshot(state);
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
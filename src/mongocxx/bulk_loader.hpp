@@ -0,0 +1,183 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/options/insert.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// Loads files of concatenated BSON documents, such as the .bson files written by mongodump, into
+/// a collection over several pooled connections.
+///
+/// The files are mapped into memory with bsoncxx::bson_file_reader and cut into batches of about
+/// batch_bytes() bytes of documents, which are inserted with collection::insert_many() by worker
+/// threads that each check out a client of their own. The documents are never copied before they
+/// are sent. At most max_pending_batches() batches wait for a worker at any time: when the workers
+/// fall behind, reading the files pauses until one of them takes a batch, so the pages of the
+/// mapping that are touched stay bounded however large the files are.
+///
+/// Batches are inserted in no particular order. Unless insert_options() says otherwise they are
+/// unordered, so a document that fails to insert does not stop the rest of its batch.
+///
+/// @warning
+///   The pool must outlive the loader.
+///
+class MONGOCXX_API bulk_loader {
+   public:
+    ///
+    /// The default number of document bytes in a batch.
+    ///
+    static constexpr std::size_t k_default_batch_bytes = 16 * 1024 * 1024;
+
+    ///
+    /// What a load has done so far.
+    ///
+    struct progress {
+        /// The documents and document bytes that were inserted.
+        std::uint64_t documents;
+        std::uint64_t bytes;
+
+        /// The time since the load started.
+        std::chrono::steady_clock::duration elapsed;
+
+        double documents_per_second() const;
+        double megabytes_per_second() const;
+    };
+
+    using progress_fn = std::function<void(const progress&)>;
+
+    ///
+    /// Creates a loader into a collection.
+    ///
+    /// @param pool
+    ///   The pool to check clients out of.
+    /// @param database
+    ///   The database of the collection to load.
+    /// @param collection
+    ///   The collection to load.
+    ///
+    bulk_loader(pool& pool,
+                bsoncxx::string::view_or_value database,
+                bsoncxx::string::view_or_value collection);
+
+    bulk_loader(bulk_loader&&) noexcept;
+    bulk_loader& operator=(bulk_loader&&) noexcept;
+
+    ~bulk_loader();
+
+    ///
+    /// Sets the number of worker threads, each with a client of its own. Defaults to
+    /// std::thread::hardware_concurrency().
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the count is zero.
+    ///
+    bulk_loader& threads(std::size_t count);
+
+    ///
+    /// Sets the number of document bytes after which a batch is handed to a worker. A document
+    /// larger than this is sent in a batch of its own.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the size is zero.
+    ///
+    bulk_loader& batch_bytes(std::size_t bytes);
+
+    ///
+    /// Sets how many batches may wait for a worker before reading pauses. Defaults to twice the
+    /// number of threads.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the count is zero.
+    ///
+    bulk_loader& max_pending_batches(std::size_t count);
+
+    ///
+    /// Sets the options of the insert_many() calls. Defaults to unordered inserts.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_loader& insert_options(options::insert options);
+
+    ///
+    /// Reports the progress of loads.
+    ///
+    /// @param callback
+    ///   Called by a worker after a batch is inserted, at most once per interval and never
+    ///   concurrently with itself.
+    /// @param interval
+    ///   The least time between calls.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_loader& on_progress(progress_fn callback,
+                             std::chrono::milliseconds interval = std::chrono::seconds{1});
+
+    ///
+    /// Loads one file. See load_files().
+    ///
+    progress load_file(const std::string& path);
+
+    ///
+    /// Loads files into the collection, returning once every batch has been inserted.
+    ///
+    /// @return What the load did, for computing its throughput.
+    ///
+    /// @throws bsoncxx::exception if a file cannot be mapped or holds a truncated document. The
+    ///   batches read before it are still inserted.
+    /// @throws mongocxx::exception if no client could be acquired from the pool, or the first
+    ///   exception thrown by insert_many(). Batches that were not handed to a worker yet are
+    ///   then not inserted.
+    ///
+    progress load_files(const std::vector<std::string>& paths);
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
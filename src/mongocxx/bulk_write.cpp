@@ -14,18 +14,36 @@
 
 #include <mongocxx/bulk_write.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/basic/sub_array.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
 #include <mongocxx/exception/bulk_write_exception.hpp>
+#include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/exception/private/mongoc_error.hh>
+#include <mongocxx/executor.hpp>
 #include <mongocxx/private/bulk_write.hh>
 #include <mongocxx/private/client_session.hh>
 #include <mongocxx/private/collection.hh>
+#include <mongocxx/private/executor.hh>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/operation_accounting.hh>
+#include <mongocxx/private/operation_timer.hh>
+#include <mongocxx/private/profiler_markers.hh>
 #include <mongocxx/private/write_concern.hh>
 
 #include <mongocxx/config/private/prelude.hh>
@@ -36,28 +54,73 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 using namespace libbson;
 using bsoncxx::builder::basic::kvp;
 
+namespace {
+
+// Returns a view of the options in `builder`, or a disengaged optional if there are none, so that
+// libmongoc is passed NULL opts rather than an empty document.
+stdx::optional<bsoncxx::document::view_or_value> non_empty(
+    const bsoncxx::builder::basic::document& builder) {
+    auto view = builder.view();
+    if (view.empty()) {
+        return stdx::nullopt;
+    }
+    return bsoncxx::document::view_or_value{view};
+}
+
+// The document that decides the shard of a write: the document of an insert, or the filter of
+// any other write, in which case `is_filter` is set.
+bsoncxx::document::view routing_target(const model::write& operation, bool* is_filter) {
+    *is_filter = true;
+    switch (operation.type()) {
+        case write_type::k_insert_one:
+            *is_filter = false;
+            return operation.get_insert_one().document().view();
+        case write_type::k_update_one:
+            return operation.get_update_one().filter().view();
+        case write_type::k_update_many:
+            return operation.get_update_many().filter().view();
+        case write_type::k_delete_one:
+            return operation.get_delete_one().filter().view();
+        case write_type::k_delete_many:
+            return operation.get_delete_many().filter().view();
+        case write_type::k_replace_one:
+            return operation.get_replace_one().filter().view();
+    }
+    return bsoncxx::document::view{};
+}
+
+}  // namespace
+
 bulk_write::bulk_write(bulk_write&&) noexcept = default;
 bulk_write& bulk_write::operator=(bulk_write&&) noexcept = default;
 
 bulk_write::~bulk_write() = default;
 
 bulk_write& bulk_write::append(const model::write& operation) {
+    MONGOCXX_PROFILER_PHASE("mongocxx::serialize");
+    operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
+    bool is_filter;
+    const auto target = routing_target(operation, &is_filter);
+    const std::size_t sub_batch = _impl->sub_batch_for(target, is_filter);
+    mongoc_bulk_operation_t* const operation_t = _impl->operation(sub_batch);
+
     switch (operation.type()) {
         case write_type::k_insert_one: {
-            scoped_bson_t doc(operation.get_insert_one().document());
+            scoped_bson_t doc(operation.get_insert_one().document().view());
             bson_error_t error;
             auto result = libmongoc::bulk_operation_insert_with_opts(
-                _impl->operation_t, doc.bson(), nullptr, &error);
+                operation_t, doc.bson(), nullptr, &error);
             if (!result) {
                 throw_exception<logic_error>(error);
             }
             break;
         }
         case write_type::k_update_one: {
-            scoped_bson_t filter(operation.get_update_one().filter());
-            scoped_bson_t update(operation.get_update_one().update());
+            scoped_bson_t filter(operation.get_update_one().filter().view());
+            scoped_bson_t update(operation.get_update_one().update().view());
 
-            bsoncxx::builder::basic::document options_builder;
+            auto& options_builder = _impl->options_scratch;
+            options_builder.clear();
             if (operation.get_update_one().collation()) {
                 options_builder.append(kvp("collation", *operation.get_update_one().collation()));
             }
@@ -68,21 +131,22 @@ bulk_write& bulk_write::append(const model::write& operation) {
                 options_builder.append(
                     kvp("arrayFilters", *operation.get_update_one().array_filters()));
             }
-            scoped_bson_t options(options_builder.extract());
+            scoped_bson_t options(non_empty(options_builder));
 
             bson_error_t error;
             auto result = libmongoc::bulk_operation_update_one_with_opts(
-                _impl->operation_t, filter.bson(), update.bson(), options.bson(), &error);
+                operation_t, filter.bson(), update.bson(), options.bson(), &error);
             if (!result) {
                 throw_exception<logic_error>(error);
             }
             break;
         }
         case write_type::k_update_many: {
-            scoped_bson_t filter(operation.get_update_many().filter());
-            scoped_bson_t update(operation.get_update_many().update());
+            scoped_bson_t filter(operation.get_update_many().filter().view());
+            scoped_bson_t update(operation.get_update_many().update().view());
 
-            bsoncxx::builder::basic::document options_builder;
+            auto& options_builder = _impl->options_scratch;
+            options_builder.clear();
             if (operation.get_update_many().collation()) {
                 options_builder.append(kvp("collation", *operation.get_update_many().collation()));
             }
@@ -93,66 +157,69 @@ bulk_write& bulk_write::append(const model::write& operation) {
                 options_builder.append(
                     kvp("arrayFilters", *operation.get_update_many().array_filters()));
             }
-            scoped_bson_t options(options_builder.extract());
+            scoped_bson_t options(non_empty(options_builder));
 
             bson_error_t error;
             auto result = libmongoc::bulk_operation_update_many_with_opts(
-                _impl->operation_t, filter.bson(), update.bson(), options.bson(), &error);
+                operation_t, filter.bson(), update.bson(), options.bson(), &error);
             if (!result) {
                 throw_exception<logic_error>(error);
             }
             break;
         }
         case write_type::k_delete_one: {
-            scoped_bson_t filter(operation.get_delete_one().filter());
+            scoped_bson_t filter(operation.get_delete_one().filter().view());
 
-            bsoncxx::builder::basic::document options_builder;
+            auto& options_builder = _impl->options_scratch;
+            options_builder.clear();
             if (operation.get_delete_one().collation()) {
                 options_builder.append(kvp("collation", *operation.get_delete_one().collation()));
             }
-            scoped_bson_t options(options_builder.extract());
+            scoped_bson_t options(non_empty(options_builder));
 
             bson_error_t error;
             auto result = libmongoc::bulk_operation_remove_one_with_opts(
-                _impl->operation_t, filter.bson(), options.bson(), &error);
+                operation_t, filter.bson(), options.bson(), &error);
             if (!result) {
                 throw_exception<logic_error>(error);
             }
             break;
         }
         case write_type::k_delete_many: {
-            scoped_bson_t filter(operation.get_delete_many().filter());
+            scoped_bson_t filter(operation.get_delete_many().filter().view());
 
-            bsoncxx::builder::basic::document options_builder;
+            auto& options_builder = _impl->options_scratch;
+            options_builder.clear();
             if (operation.get_delete_many().collation()) {
                 options_builder.append(kvp("collation", *operation.get_delete_many().collation()));
             }
-            scoped_bson_t options(options_builder.extract());
+            scoped_bson_t options(non_empty(options_builder));
 
             bson_error_t error;
             auto result = libmongoc::bulk_operation_remove_many_with_opts(
-                _impl->operation_t, filter.bson(), options.bson(), &error);
+                operation_t, filter.bson(), options.bson(), &error);
             if (!result) {
                 throw_exception<logic_error>(error);
             }
             break;
         }
         case write_type::k_replace_one: {
-            scoped_bson_t filter(operation.get_replace_one().filter());
-            scoped_bson_t replace(operation.get_replace_one().replacement());
+            scoped_bson_t filter(operation.get_replace_one().filter().view());
+            scoped_bson_t replace(operation.get_replace_one().replacement().view());
 
-            bsoncxx::builder::basic::document options_builder;
+            auto& options_builder = _impl->options_scratch;
+            options_builder.clear();
             if (operation.get_replace_one().collation()) {
                 options_builder.append(kvp("collation", *operation.get_replace_one().collation()));
             }
             if (operation.get_replace_one().upsert()) {
                 options_builder.append(kvp("upsert", *operation.get_replace_one().upsert()));
             }
-            scoped_bson_t options(options_builder.extract());
+            scoped_bson_t options(non_empty(options_builder));
 
             bson_error_t error;
             auto result = libmongoc::bulk_operation_replace_one_with_opts(
-                _impl->operation_t, filter.bson(), replace.bson(), options.bson(), &error);
+                operation_t, filter.bson(), replace.bson(), options.bson(), &error);
             if (!result) {
                 throw_exception<logic_error>(error);
             }
@@ -160,32 +227,289 @@ bulk_write& bulk_write::append(const model::write& operation) {
         }
     }
 
+    _impl->appended_to(sub_batch);
+
+    return *this;
+}
+
+bulk_write& bulk_write::append(model::write&& operation) {
+    // Take the contents out of the caller's write, so that its documents are freed on return.
+    const model::write consumed{std::move(operation)};
+    return append(consumed);
+}
+
+bulk_write& bulk_write::append_insert(bsoncxx::document::view_or_value document) {
+    return append_insert_raw(document.view().data(), document.view().length());
+}
+
+bulk_write& bulk_write::append_insert_raw(const std::uint8_t* data, std::size_t length) {
+    bson_t doc;
+    if (!bson_init_static(&doc, data, length)) {
+        throw logic_error{error_code::k_invalid_parameter, "invalid BSON document"};
+    }
+
+    const std::size_t sub_batch =
+        _impl->sub_batch_for(bsoncxx::document::view{data, length}, false);
+
+    bson_error_t error;
+    if (!libmongoc::bulk_operation_insert_with_opts(
+            _impl->operation(sub_batch), &doc, nullptr, &error)) {
+        throw_exception<logic_error>(error);
+    }
+
+    _impl->appended_to(sub_batch);
+
     return *this;
 }
 
 stdx::optional<result::bulk_write> bulk_write::execute() const {
+    return try_execute().value();
+}
+
+write_outcome<result::bulk_write> bulk_write::try_execute() const {
+    operation_timer timer;
+    if (!_impl->shards.empty() && (_impl->appended > 1 || _impl->is_partitioned())) {
+        return _execute_parallel();
+    }
+
     mongoc_bulk_operation_t* b = _impl->operation_t;
     scoped_bson_t reply;
     bson_error_t error;
 
-    if (!libmongoc::bulk_operation_execute(b, reply.bson_for_init(), &error)) {
-        throw_exception<bulk_write_exception>(reply.steal(), error);
+    operation_accounting accounting;
+    bool executed;
+    {
+        MONGOCXX_PROFILER_PHASE("mongocxx::round_trip");
+        operation_timer::libmongoc_call call;
+        executed = libmongoc::bulk_operation_execute(b, reply.bson_for_init(), &error);
+    }
+    if (!executed) {
+        return {make_error_code(error), reply.steal(), error.message};
     }
 
     // Reply is empty for unacknowledged writes, so return disengaged optional.
     if (reply.view().empty()) {
-        return stdx::nullopt;
+        return stdx::optional<result::bulk_write>{};
     }
 
-    result::bulk_write result(reply.steal());
+    operation_timer::scoped_phase construct{operation_timer::phase::k_result};
+    result::bulk_write result(reply.steal(), accounting.stats());
 
     return stdx::optional<result::bulk_write>(std::move(result));
 }
 
+namespace {
+
+// Copies the write error or upsert document `doc`, replacing its "index" field with `index`.
+bsoncxx::document::value reindex(bsoncxx::document::view doc, std::int32_t index) {
+    bsoncxx::builder::basic::document builder;
+    for (auto&& elem : doc) {
+        if (elem.key() == stdx::string_view{"index"}) {
+            builder.append(kvp("index", index));
+        } else {
+            builder.append(kvp(elem.key(), elem.get_value()));
+        }
+    }
+    return builder.extract();
+}
+
+// Combines the replies of the sub-batches of a parallel bulk write into the reply a single bulk
+// write of all of the operations would have produced. `replies[k]` is the reply of sub-batch k,
+// whose i-th operation was appended at position `position(k, i)`.
+bsoncxx::document::value merge_replies(
+    const std::vector<bsoncxx::document::view>& replies,
+    const std::function<std::int32_t(std::size_t, std::int32_t)>& position) {
+
+    const auto sum = [&](stdx::string_view field) {
+        std::int32_t total = 0;
+        for (auto&& reply : replies) {
+            auto count = reply[field];
+            if (count && count.type() == bsoncxx::type::k_int32) {
+                total += count.get_int32();
+            }
+        }
+        return total;
+    };
+
+    // Collects the documents of array `field` from every reply, with their indexes mapped back to
+    // positions in the whole bulk write, in index order.
+    const auto collect_indexed = [&](stdx::string_view field) {
+        std::vector<std::pair<std::int32_t, bsoncxx::document::value>> docs;
+        for (std::size_t k = 0; k < replies.size(); k++) {
+            auto arr = replies[k][field];
+            if (!arr || arr.type() != bsoncxx::type::k_array) {
+                continue;
+            }
+            for (auto&& entry : arr.get_array().value) {
+                auto doc = entry.get_document().value;
+                auto index = position(k, doc["index"].get_int32().value);
+                docs.emplace_back(index, reindex(doc, index));
+            }
+        }
+        std::sort(docs.begin(),
+                  docs.end(),
+                  [](const std::pair<std::int32_t, bsoncxx::document::value>& lhs,
+                     const std::pair<std::int32_t, bsoncxx::document::value>& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+        return docs;
+    };
+
+    bsoncxx::builder::basic::document merged;
+    merged.append(kvp("nInserted", sum("nInserted")),
+                  kvp("nMatched", sum("nMatched")),
+                  kvp("nModified", sum("nModified")),
+                  kvp("nRemoved", sum("nRemoved")),
+                  kvp("nUpserted", sum("nUpserted")));
+
+    auto upserted = collect_indexed("upserted");
+    if (!upserted.empty()) {
+        merged.append(kvp("upserted", [&upserted](bsoncxx::builder::basic::sub_array arr) {
+            for (auto&& doc : upserted) {
+                arr.append(doc.second.view());
+            }
+        }));
+    }
+
+    auto write_errors = collect_indexed("writeErrors");
+    merged.append(kvp("writeErrors", [&write_errors](bsoncxx::builder::basic::sub_array arr) {
+        for (auto&& doc : write_errors) {
+            arr.append(doc.second.view());
+        }
+    }));
+
+    bool has_write_concern_errors = false;
+    bsoncxx::builder::basic::array write_concern_errors;
+    for (auto&& reply : replies) {
+        auto errors = reply["writeConcernErrors"];
+        if (errors && errors.type() == bsoncxx::type::k_array) {
+            for (auto&& error : errors.get_array().value) {
+                write_concern_errors.append(error.get_value());
+                has_write_concern_errors = true;
+            }
+        }
+    }
+    if (has_write_concern_errors) {
+        merged.append(kvp("writeConcernErrors", write_concern_errors.extract()));
+    }
+
+    return merged.extract();
+}
+
+// Whether a server error code means that the routing information of a shard or mongos was stale:
+// StaleShardVersion, StaleEpoch or StaleConfig.
+bool is_stale_routing_code(std::int64_t code) {
+    return code == 63 || code == 150 || code == 13388;
+}
+
+bool reports_stale_routing(bsoncxx::document::view merged, const bson_error_t* first_error) {
+    if (first_error && is_stale_routing_code(first_error->code)) {
+        return true;
+    }
+    for (auto&& error : merged["writeErrors"].get_array().value) {
+        auto code = error.get_document().value["code"];
+        if (code && code.type() == bsoncxx::type::k_int32 &&
+            is_stale_routing_code(code.get_int32().value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+write_outcome<result::bulk_write> bulk_write::_execute_parallel() const {
+    // The sub-batches that received writes: the first ones of a parallel bulk write, and any of a
+    // shard-partitioned one.
+    std::vector<std::size_t> active;
+    for (std::size_t k = 0; k < _impl->num_operations(); k++) {
+        if (_impl->is_partitioned() ? !_impl->positions[k].empty() : k < _impl->appended) {
+            active.push_back(k);
+        }
+    }
+    const std::size_t count = active.size();
+
+    std::unique_ptr<scoped_bson_t[]> replies{new scoped_bson_t[count]};
+    std::vector<bson_error_t> errors(count);
+    std::unique_ptr<bool[]> succeeded{new bool[count]};
+
+    std::vector<operation_stats> stats(count);
+
+    const auto run = [&](std::size_t k) {
+        operation_accounting accounting;
+        MONGOCXX_PROFILER_PHASE("mongocxx::round_trip");
+        operation_timer::libmongoc_call call;
+        succeeded[k] = libmongoc::bulk_operation_execute(
+            _impl->operation(active[k]), replies[k].bson_for_init(), &errors[k]);
+        stats[k] = accounting.stats();
+    };
+
+    // Each sub-batch uses its own client, so they can be executed concurrently.
+    run_parallel(*_impl->executor, count, count, run);
+
+    std::vector<bsoncxx::document::view> views;
+    views.reserve(count);
+    const bson_error_t* first_error = nullptr;
+    bool acknowledged = false;
+
+    for (std::size_t k = 0; k < count; k++) {
+        views.push_back(replies[k].view());
+        acknowledged = acknowledged || !views.back().empty();
+        if (!succeeded[k] && !first_error) {
+            first_error = &errors[k];
+        }
+    }
+
+    const auto position = [&](std::size_t k, std::int32_t i) {
+        if (_impl->is_partitioned()) {
+            return _impl->positions[active[k]][static_cast<std::size_t>(i)];
+        }
+        return i * static_cast<std::int32_t>(count) + static_cast<std::int32_t>(k);
+    };
+    auto merged = merge_replies(views, position);
+
+    if (_impl->is_partitioned() && reports_stale_routing(merged.view(), first_error)) {
+        _impl->router->invalidate();
+    }
+
+    if (first_error) {
+        return {make_error_code(*first_error), std::move(merged), first_error->message};
+    }
+
+    // Replies are empty for unacknowledged writes, so return disengaged optional.
+    if (!acknowledged) {
+        return stdx::optional<result::bulk_write>{};
+    }
+
+    operation_stats total;
+    for (auto&& sub_batch_stats : stats) {
+        add_operation_stats(&total, sub_batch_stats);
+    }
+
+    return stdx::optional<result::bulk_write>(result::bulk_write{std::move(merged), total});
+}
+
 bulk_write::bulk_write(const collection& coll,
                        const options::bulk_write& options,
                        const client_session* session)
     : _created_from_collection{true} {
+    const auto connections = options.parallelism().value_or(1);
+    const auto partition_pool = options.shard_partitioning_pool();
+    if (connections > 1 && partition_pool) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "a bulk write cannot be both parallel and shard-partitioned"};
+    }
+    if (connections > 1 && (options.ordered() || session || !options.parallelism_pool())) {
+        // Ordered writes must run one after the other, and a session is bound to one client.
+        throw logic_error{error_code::k_invalid_parameter,
+                          "parallel bulk writes must be unordered and cannot use a session"};
+    }
+    if (partition_pool && (options.ordered() || session)) {
+        throw logic_error{
+            error_code::k_invalid_parameter,
+            "shard-partitioned bulk writes must be unordered and cannot use a session"};
+    }
+
     bsoncxx::builder::basic::document options_builder;
     if (!options.ordered()) {
         // ordered is true by default. Only append it if set to false.
@@ -199,14 +523,60 @@ bulk_write::bulk_write(const collection& coll,
             bsoncxx::builder::concatenate_doc{session->_get_impl().to_document()});
     }
 
-    scoped_bson_t bson_options(options_builder.extract());
-    _impl =
-        stdx::make_unique<bulk_write::impl>(libmongoc::collection_create_bulk_operation_with_opts(
-            coll._get_impl().collection_t, bson_options.bson()));
+    // Shared with create_sub_batch, which may create sub-batches after this constructor returns.
+    const auto bson_options = std::make_shared<bsoncxx::document::value>(options_builder.extract());
+    const auto bypass_document_validation = options.bypass_document_validation();
+
+    const auto create_operation = [bson_options, bypass_document_validation](
+                                      const collection& target) {
+        scoped_bson_t bson{bson_options->view()};
+        mongoc_bulk_operation_t* operation_t =
+            libmongoc::collection_create_bulk_operation_with_opts(
+                target._get_impl().collection_t, bson.bson());
+
+        if (bypass_document_validation) {
+            libmongoc::bulk_operation_set_bypass_document_validation(
+                operation_t, *bypass_document_validation);
+        }
+
+        return operation_t;
+    };
+
+    _impl = stdx::make_unique<bulk_write::impl>(create_operation(coll));
+
+    auto sub_batch_pool = partition_pool ? partition_pool : options.parallelism_pool();
+    if (connections <= 1 && !partition_pool) {
+        return;
+    }
+
+    const auto database_name = coll._get_impl().database_name;
+    const auto collection_name = bsoncxx::string::to_string(coll.name());
+    const auto write_concern = coll.write_concern();
+    _impl->create_sub_batch = [=]() {
+        auto client = sub_batch_pool->acquire();
+        auto target = (*client)[database_name][collection_name];
+        target.write_concern(write_concern);
+
+        auto operation_t = create_operation(target);
+        return bulk_write::impl::shard{std::move(client), std::move(target), operation_t};
+    };
+
+    if (partition_pool) {
+        // Writes whose shard is unknown stay in sub-batch 0; the others get a sub-batch per shard
+        // as they are appended. Unsharded and hash-sharded collections are written unpartitioned.
+        auto client = partition_pool->acquire();
+        _impl->router = shard_router::load(*client, database_name, collection_name);
+        if (!_impl->router) {
+            return;
+        }
+        _impl->shard_sub_batches.assign(_impl->router->shard_count(), 0);
+        _impl->positions.emplace_back();
+    }
 
-    if (auto validation = options.bypass_document_validation()) {
-        libmongoc::bulk_operation_set_bypass_document_validation(_impl->operation_t, *validation);
+    for (std::uint32_t i = 1; i < connections; i++) {
+        _impl->shards.push_back(_impl->create_sub_batch());
     }
+    _impl->executor = sub_batch_pool->executor();
 }
 
 MONGOCXX_INLINE_NAMESPACE_END
@@ -14,10 +14,16 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
 #include <mongocxx/client_session.hpp>
 #include <mongocxx/model/write.hpp>
 #include <mongocxx/options/bulk_write.hpp>
 #include <mongocxx/result/bulk_write.hpp>
+#include <mongocxx/write_outcome.hpp>
 
 #include <mongocxx/config/prelude.hpp>
 
@@ -81,6 +87,84 @@ class MONGOCXX_API bulk_write {
     ///
     bulk_write& append(const model::write& operation);
 
+    ///
+    /// Appends a single write to the bulk write operation, as with append(const model::write&),
+    /// and then destroys the write's contents. Any documents the write owns are freed as soon as
+    /// they have been copied into the bulk operation, so that building a large bulk write from
+    /// owned documents holds each of them only once.
+    ///
+    /// @param operation
+    ///   The write operation to append. It is left holding no documents.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the given operation is invalid.
+    ///
+    bulk_write& append(model::write&& operation);
+
+    ///
+    /// Appends an insert of a document to the bulk write operation. This is equivalent to
+    /// appending a model::insert_one of the same document, but skips constructing the model. An
+    /// owned document is freed once it has been copied into the bulk operation.
+    ///
+    /// @param document
+    ///   The document to insert.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if libmongoc rejects the insert.
+    ///
+    bulk_write& append_insert(bsoncxx::document::view_or_value document);
+
+    ///
+    /// Appends an insert of an already-serialized BSON document to the bulk write operation. This
+    /// is equivalent to appending a model::insert_one of the same document, but skips
+    /// constructing the model.
+    ///
+    /// The document is copied into the bulk operation, so the buffer need not outlive this call.
+    ///
+    /// @param data
+    ///   A pointer to the first byte of the BSON document.
+    /// @param length
+    ///   The length of the BSON document, in bytes.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if the bytes are not a BSON document of the given length, or
+    ///   if libmongoc rejects the insert.
+    ///
+    bulk_write& append_insert_raw(const std::uint8_t* data, std::size_t length);
+
+    ///
+    /// Appends an insert of each document in the range [begin, end) to the bulk write operation,
+    /// as with append_insert_raw.
+    ///
+    /// @tparam document_view_iterator_type
+    ///   The iterator type. Must meet the requirements for the input iterator concept with a value
+    ///   type convertible to bsoncxx::document::view.
+    ///
+    /// @param begin
+    ///   Iterator pointing to the first document to insert.
+    /// @param end
+    ///   Iterator pointing to the end of the documents to insert.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if libmongoc rejects one of the inserts. The documents before
+    ///   it remain appended.
+    ///
+    template <typename document_view_iterator_type>
+    MONGOCXX_INLINE bulk_write& append_many(document_view_iterator_type begin,
+                                            document_view_iterator_type end);
+
     ///
     /// Executes a bulk write.
     ///
@@ -92,6 +176,16 @@ class MONGOCXX_API bulk_write {
     ///
     stdx::optional<result::bulk_write> execute() const;
 
+    ///
+    /// Executes a bulk write, returning its errors instead of throwing them.
+    ///
+    /// @return The outcome of the bulk operation execution: either the optional result execute()
+    ///   would have returned, or the error it would have thrown.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    write_outcome<result::bulk_write> try_execute() const;
+
    private:
     friend class collection;
 
@@ -101,10 +195,23 @@ class MONGOCXX_API bulk_write {
                                 const options::bulk_write& options,
                                 const client_session* session = nullptr);
 
+    MONGOCXX_PRIVATE write_outcome<result::bulk_write> _execute_parallel() const;
+
     bool _created_from_collection;
     std::unique_ptr<impl> _impl;
 };
 
+template <typename document_view_iterator_type>
+MONGOCXX_INLINE bulk_write& bulk_write::append_many(document_view_iterator_type begin,
+                                                    document_view_iterator_type end) {
+    for (; begin != end; ++begin) {
+        const bsoncxx::document::view view = *begin;
+        append_insert_raw(view.data(), view.length());
+    }
+
+    return *this;
+}
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
 
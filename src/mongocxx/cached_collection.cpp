@@ -0,0 +1,351 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/cached_collection.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/exception.hpp>
+#include <mongocxx/options/change_stream.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/private/cached_collection.hh>
+#include <mongocxx/private/change_stream.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+namespace {
+
+constexpr std::size_t k_default_max_documents = 10000;
+constexpr std::size_t k_default_shards = 16;
+
+// How long the change stream thread waits for events before checking whether the cache is being
+// destroyed, which bounds how long the destructor blocks.
+constexpr std::chrono::milliseconds k_max_await_time{500};
+
+// How long the change stream thread waits before reopening a stream that failed.
+constexpr std::chrono::milliseconds k_retry_interval{1000};
+
+}  // namespace
+
+cached_collection::impl::impl(class pool* pool,
+                              std::string database,
+                              std::string collection,
+                              const options::collection_cache& options)
+    : pool(pool), database(std::move(database)), collection(std::move(collection)) {
+    const auto max_documents = options.max_documents().value_or(k_default_max_documents);
+    const auto shard_count = std::min(options.shards().value_or(k_default_shards), max_documents);
+    max_per_shard = (max_documents + shard_count - 1) / shard_count;
+
+    if (options.ttl()) {
+        ttl = std::chrono::duration_cast<clock::duration>(*options.ttl());
+    }
+    now = options.clock();
+    if (!now) {
+        now = &clock::now;
+    }
+
+    shards.reserve(shard_count);
+    for (std::size_t i = 0; i < shard_count; i++) {
+        shards.push_back(stdx::make_unique<shard>());
+    }
+}
+
+cached_collection::impl::~impl() {
+    {
+        std::lock_guard<std::mutex> lock{stop_mutex};
+        stopping = true;
+    }
+    stop_changed.notify_all();
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+}
+
+std::string cached_collection::impl::key_for(const bsoncxx::types::value& id) {
+    bsoncxx::builder::basic::document key;
+    switch (id.type()) {
+        case bsoncxx::type::k_int32:
+            key.append(kvp("", static_cast<std::int64_t>(id.get_int32().value)));
+            break;
+        case bsoncxx::type::k_int64:
+            key.append(kvp("", id.get_int64().value));
+            break;
+        case bsoncxx::type::k_double: {
+            const double number = id.get_double().value;
+            if (std::trunc(number) == number && number >= -9223372036854775808.0 &&
+                number < 9223372036854775808.0) {
+                key.append(kvp("", static_cast<std::int64_t>(number)));
+            } else {
+                key.append(kvp("", id));
+            }
+            break;
+        }
+        default:
+            key.append(kvp("", id));
+            break;
+    }
+    const auto view = key.view();
+    return std::string{reinterpret_cast<const char*>(view.data()), view.length()};
+}
+
+bool cached_collection::impl::has_canonical_key(const bsoncxx::types::value& id) {
+    return id.type() != bsoncxx::type::k_decimal128;
+}
+
+cached_collection::impl::shard& cached_collection::impl::shard_for(const std::string& key) {
+    return *shards[std::hash<std::string>{}(key) % shards.size()];
+}
+
+stdx::optional<bsoncxx::document::value> cached_collection::impl::find_one_by_id(
+    const bsoncxx::types::value& id) {
+    auto key = key_for(id);
+    auto& shard = shard_for(key);
+
+    std::uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            auto cached = found->second;
+            if (!ttl || now() < cached->expires) {
+                shard.entries.splice(shard.entries.begin(), shard.entries, cached);
+                hits++;
+                if (!cached->document) {
+                    return stdx::nullopt;
+                }
+                return bsoncxx::document::value{cached->document->view()};
+            }
+            shard.index.erase(found);
+            shard.entries.erase(cached);
+        }
+        generation = shard.generation;
+    }
+
+    misses++;
+    stdx::optional<bsoncxx::document::value> document;
+    {
+        auto client = pool->acquire();
+        document = (*client)[database][collection].find_one(make_document(kvp("_id", id)));
+    }
+
+    // Entries are invalidated by the _id in the document key of change events, so one is only
+    // kept under a key that an event for the document would produce too.
+    if (document) {
+        auto own_id = document->view()["_id"];
+        if (!own_id || key_for(own_id.get_value()) != key) {
+            return document;
+        }
+    } else if (!has_canonical_key(id)) {
+        return document;
+    }
+
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    if (shard.generation != generation || shard.index.count(key) > 0) {
+        // The document changed while it was being read, or another lookup cached it first.
+        return document;
+    }
+
+    entry fresh;
+    fresh.key = key;
+    if (document) {
+        fresh.document = bsoncxx::document::value{document->view()};
+    }
+    if (ttl) {
+        fresh.expires = now() + *ttl;
+    }
+    shard.entries.push_front(std::move(fresh));
+    shard.index.emplace(std::move(key), shard.entries.begin());
+
+    while (shard.entries.size() > max_per_shard) {
+        shard.index.erase(shard.entries.back().key);
+        shard.entries.pop_back();
+    }
+
+    return document;
+}
+
+void cached_collection::impl::invalidate(const std::string& key) {
+    auto& shard = shard_for(key);
+
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    shard.generation++;
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        shard.entries.erase(found->second);
+        shard.index.erase(found);
+    }
+}
+
+void cached_collection::impl::clear() {
+    for (auto&& shard : shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        shard->generation++;
+        shard->index.clear();
+        shard->entries.clear();
+    }
+}
+
+void cached_collection::impl::open_stream() {
+    stream = stdx::nullopt;
+    stream_client = stdx::nullopt;
+
+    auto client = pool->acquire();
+
+    // Only the _id and the document key of an event are needed to invalidate its entry.
+    pipeline events;
+    events.project(make_document(kvp("operationType", 1), kvp("documentKey", 1)));
+
+    options::change_stream stream_options;
+    stream_options.max_await_time(k_max_await_time);
+
+    stream = (*client)[database][collection].watch(events, stream_options);
+    stream_client = std::move(client);
+}
+
+void cached_collection::impl::watch() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock{stop_mutex};
+            if (stopping) {
+                return;
+            }
+        }
+
+        try {
+            if (!stream) {
+                open_stream();
+                // Changes may have been missed while no stream was open.
+                clear();
+            }
+
+            bool invalidated = false;
+            for (auto&& event : *stream) {
+                if (!apply(event)) {
+                    invalidated = true;
+                    break;
+                }
+            }
+            if (invalidated) {
+                stream = stdx::nullopt;
+                stream_client = stdx::nullopt;
+            }
+        } catch (const mongocxx::exception&) {
+            clear();
+            stream = stdx::nullopt;
+            stream_client = stdx::nullopt;
+
+            std::unique_lock<std::mutex> lock{stop_mutex};
+            stop_changed.wait_for(lock, k_retry_interval, [this] { return stopping; });
+        }
+    }
+}
+
+bool cached_collection::impl::apply(const bsoncxx::document::view& event) {
+    auto type = event["operationType"];
+    if (type && type.type() == bsoncxx::type::k_utf8) {
+        const auto operation = type.get_utf8().value;
+        if (operation == stdx::string_view{"invalidate"}) {
+            clear();
+            return false;
+        }
+        if (operation == stdx::string_view{"drop"} || operation == stdx::string_view{"rename"} ||
+            operation == stdx::string_view{"dropDatabase"}) {
+            clear();
+            return true;
+        }
+    }
+
+    auto document_key = event["documentKey"];
+    if (document_key && document_key.type() == bsoncxx::type::k_document) {
+        auto id = document_key.get_document().value["_id"];
+        if (id) {
+            invalidate(key_for(id.get_value()));
+        }
+    }
+    return true;
+}
+
+cached_collection::cached_collection(class pool& pool,
+                                     bsoncxx::string::view_or_value database,
+                                     bsoncxx::string::view_or_value collection,
+                                     const options::collection_cache& options)
+    : _impl(stdx::make_unique<impl>(
+          &pool, std::string{database.view()}, std::string{collection.view()}, options)) {
+    if (!options.watch().value_or(true)) {
+        return;
+    }
+
+    // Open the stream before any document is cached, so that no change can be missed, and report
+    // a stream the server rejected to the caller rather than retrying it forever.
+    _impl->open_stream();
+    _impl->stream->_impl->throw_if_failed();
+
+    auto impl = _impl.get();
+    _impl->watcher = std::thread{[impl] { impl->watch(); }};
+}
+
+cached_collection::cached_collection(cached_collection&&) noexcept = default;
+cached_collection& cached_collection::operator=(cached_collection&&) noexcept = default;
+
+cached_collection::~cached_collection() = default;
+
+stdx::optional<bsoncxx::document::value> cached_collection::find_one_by_id(
+    const bsoncxx::types::value& id) {
+    return _impl->find_one_by_id(id);
+}
+
+void cached_collection::invalidate(const bsoncxx::types::value& id) {
+    _impl->invalidate(impl::key_for(id));
+}
+
+void cached_collection::clear() {
+    _impl->clear();
+}
+
+std::size_t cached_collection::size() const {
+    std::size_t size = 0;
+    for (auto&& shard : _impl->shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        size += shard->entries.size();
+    }
+    return size;
+}
+
+std::uint64_t cached_collection::hits() const {
+    return _impl->hits.load();
+}
+
+std::uint64_t cached_collection::misses() const {
+    return _impl->misses.load();
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,134 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/options/collection_cache.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// A read-through cache of the documents of one collection, looked up by _id.
+///
+/// find_one_by_id() answers from the cache when it can, and otherwise runs collection::find_one
+/// on a client checked out of the pool and caches the result, including the absence of a
+/// document. The cache is bounded and evicts its least recently used entries, and is split into
+/// shards with their own locks so that many threads can look documents up at once.
+///
+/// Unless options::collection_cache::watch() is false, a background thread watches a change stream
+/// on the collection and invalidates the entry of every document that changes. If the change
+/// stream fails, the whole cache is cleared before it is reopened, since changes may have been
+/// missed. Entries may still be briefly stale between a write and the arrival of its change event.
+///
+/// @warning
+///   The pool must outlive the cached_collection. While watching, the cached_collection keeps one
+///   of its clients checked out.
+///
+class MONGOCXX_API cached_collection {
+   public:
+    ///
+    /// Creates a cache over a collection and, unless disabled by the options, starts watching the
+    /// collection for changes.
+    ///
+    /// @param pool
+    ///   The pool to check clients out of.
+    /// @param database
+    ///   The name of the database of the collection.
+    /// @param collection
+    ///   The name of the collection.
+    /// @param options
+    ///   Optional arguments, see options::collection_cache.
+    ///
+    /// @throws mongocxx::exception if the change stream could not be opened.
+    ///
+    cached_collection(pool& pool,
+                      bsoncxx::string::view_or_value database,
+                      bsoncxx::string::view_or_value collection,
+                      const options::collection_cache& options = {});
+
+    cached_collection(cached_collection&&) noexcept;
+    cached_collection& operator=(cached_collection&&) noexcept;
+
+    ///
+    /// Destroys the cache, waiting for the change stream thread to return from its current wait
+    /// for events.
+    ///
+    ~cached_collection();
+
+    ///
+    /// Finds the document with the given _id, from the cache if it holds an unexpired entry for it
+    /// and from the server otherwise.
+    ///
+    /// @param id
+    ///   The _id of the document.
+    ///
+    /// @return The document, or an empty optional if the collection has no document with that _id.
+    ///
+    /// @throws mongocxx::query_exception if the document is not cached and the query fails.
+    ///
+    stdx::optional<bsoncxx::document::value> find_one_by_id(const bsoncxx::types::value& id);
+
+    ///
+    /// Drops the cache entry for a document, if any, so that the next lookup reads it from the
+    /// server.
+    ///
+    /// @param id
+    ///   The _id of the document.
+    ///
+    void invalidate(const bsoncxx::types::value& id);
+
+    ///
+    /// Drops every entry of the cache.
+    ///
+    void clear();
+
+    ///
+    /// @return The number of entries in the cache, expired or not.
+    ///
+    std::size_t size() const;
+
+    ///
+    /// @return The number of lookups that were answered from the cache.
+    ///
+    std::uint64_t hits() const;
+
+    ///
+    /// @return The number of lookups that had to query the server.
+    ///
+    std::uint64_t misses() const;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -14,13 +14,19 @@
 
 #include <mongocxx/change_stream.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
 #include <tuple>
+#include <vector>
 
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/exception/private/mongoc_error.hh>
 #include <mongocxx/exception/query_exception.hpp>
 #include <mongocxx/private/change_stream.hh>
@@ -65,6 +71,261 @@ stdx::optional<bsoncxx::document::view> change_stream::get_resume_token() const
     return _impl->get_resume_token();
 }
 
+change_stream::batch change_stream::next_batch(std::size_t max_events,
+                                               std::chrono::milliseconds max_wait) {
+    batch result;
+    if (_impl->is_dead()) {
+        return result;
+    }
+
+    // Events are only valid until the stream advances, so copy each one into the batch's buffer
+    // and create the views once the buffer has stopped growing.
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> lengths;
+    const auto deadline = std::chrono::steady_clock::now() + max_wait;
+    bsoncxx::document::view event;
+    while (offsets.size() < max_events && _impl->next_event(&event)) {
+        offsets.push_back(result._buffer.size());
+        lengths.push_back(event.length());
+        result._buffer.insert(result._buffer.end(), event.data(), event.data() + event.length());
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    result._events.reserve(offsets.size());
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        result._events.emplace_back(result._buffer.data() + offsets[i], lengths[i]);
+    }
+
+    if (auto token = _impl->get_resume_token()) {
+        result._resume_token = bsoncxx::document::value{*token};
+    }
+
+    // Iterators would otherwise still point at an event from before the batch.
+    _impl->mark_nothing_left();
+
+    return result;
+}
+
+namespace {
+
+// The number of events a prefetching stream reads per pass when no batch_size was set. It matches
+// the size of the server's default first batch.
+constexpr std::size_t k_default_prefetch_batch_size = 101;
+
+}  // namespace
+
+constexpr std::size_t change_stream::impl::prefetched_batch::k_no_token;
+
+std::size_t change_stream::impl::prefetched_batch::append(bsoncxx::document::view document) {
+    const auto offset = data.size();
+    data.insert(data.end(), document.data(), document.data() + document.length());
+    return offset;
+}
+
+bsoncxx::document::view change_stream::impl::prefetched_batch::at(std::size_t offset) const {
+    const std::uint8_t* document = data.data() + offset;
+    const std::uint32_t length = static_cast<std::uint32_t>(document[0]) |
+                                 static_cast<std::uint32_t>(document[1]) << 8 |
+                                 static_cast<std::uint32_t>(document[2]) << 16 |
+                                 static_cast<std::uint32_t>(document[3]) << 24;
+    return bsoncxx::document::view{document, length};
+}
+
+void change_stream::impl::start_prefetch(std::int32_t max_batches,
+                                         stdx::optional<std::int32_t> batch_size,
+                                         stdx::optional<std::int64_t> max_bytes,
+                                         std::shared_ptr<reply_budget> budget) {
+    if (max_batches <= 0) {
+        throw logic_error{error_code::k_invalid_parameter};
+    }
+
+    if (max_bytes && *max_bytes <= 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "positive value required for max_prefetched_bytes"};
+    }
+
+    if (is_dead() || is_prefetching()) {
+        return;
+    }
+
+    auto state = stdx::make_unique<prefetch_state>();
+    state->max_batches = static_cast<std::size_t>(max_batches);
+    state->batch_size = batch_size && *batch_size > 0 ? static_cast<std::size_t>(*batch_size)
+                                                      : k_default_prefetch_batch_size;
+    state->max_ready_bytes = static_cast<std::size_t>(max_bytes.value_or(0));
+    state->budget = std::move(budget);
+    if (auto token = libmongoc::change_stream_get_resume_token(change_stream_)) {
+        state->initial_token.emplace(bsoncxx::document::view{bson_get_data(token), token->len});
+        state->token = state->initial_token->view();
+    }
+
+    prefetch_ = std::move(state);
+    try {
+        prefetch_->thread = std::thread{[this] { prefetch_loop(); }};
+    } catch (const std::system_error&) {
+        // Without a thread to read ahead, the stream simply reads synchronously.
+        prefetch_.reset();
+    }
+}
+
+void change_stream::impl::prefetch_loop() {
+    auto& state = *prefetch_;
+    bool done = false;
+
+    while (!done) {
+        prefetched_batch batch;
+        std::exception_ptr error;
+
+        auto append_token = [this, &batch] {
+            auto token = libmongoc::change_stream_get_resume_token(change_stream_);
+            return token ? batch.append(bsoncxx::document::view{bson_get_data(token), token->len})
+                         : prefetched_batch::k_no_token;
+        };
+
+        try {
+            bsoncxx::document::view event;
+            while (batch.events.size() < state.batch_size) {
+                if (read_event(&event)) {
+                    batch.events.push_back(batch.append(event));
+                    batch.tokens.push_back(append_token());
+                    continue;
+                }
+
+                batch.ends_round = true;
+                batch.end_token = append_token();
+                break;
+            }
+        } catch (...) {
+            error = std::current_exception();
+            done = true;
+        }
+
+        // Holding on to the batch until it fits delays the next getMore. A consumer with nothing
+        // left to read gets the batch regardless, so that it never waits on other streams.
+        const auto bytes = batch.data.size();
+        if (state.budget) {
+            state.budget->acquire(bytes, [&state] {
+                std::lock_guard<std::mutex> lock{state.mutex};
+                return state.stopping || state.ready.empty();
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> lock{state.mutex};
+            state.changed.wait(lock, [&state, bytes] {
+                return state.stopping || (state.ready.size() < state.max_batches &&
+                                          (state.max_ready_bytes == 0 || state.ready.empty() ||
+                                           state.ready_bytes + bytes <= state.max_ready_bytes));
+            });
+
+            if (state.stopping) {
+                lock.unlock();
+                if (state.budget) {
+                    state.budget->release(bytes);
+                }
+                return;
+            }
+
+            // An empty batch cut short by an error has nothing for the consumer to see.
+            if (!batch.events.empty() || batch.ends_round) {
+                state.ready.push_back(std::move(batch));
+                state.ready_bytes += bytes;
+            } else if (state.budget) {
+                state.budget->release(bytes);
+            }
+            if (done) {
+                state.finished = true;
+                state.error = error;
+            }
+        }
+
+        state.changed.notify_all();
+    }
+}
+
+bool change_stream::impl::next_prefetched(bsoncxx::document::view* out_event) {
+    auto& state = *prefetch_;
+
+    while (state.position == state.current.events.size()) {
+        if (state.current.ends_round && !state.round_reported) {
+            // Report the end of the pass like a stream read synchronously would, so that loops
+            // over begin() and end() get to run between awaits.
+            state.round_reported = true;
+            state.token = stdx::nullopt;
+            if (state.current.end_token != prefetched_batch::k_no_token) {
+                state.token = state.current.at(state.current.end_token);
+            }
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock{state.mutex};
+        state.changed.wait(lock, [&state] { return state.finished || !state.ready.empty(); });
+
+        if (state.ready.empty()) {
+            if (state.error) {
+                auto error = state.error;
+                state.error = nullptr;
+                lock.unlock();
+
+                mark_dead();
+                std::rethrow_exception(error);
+            }
+            return false;
+        }
+
+        const auto consumed = state.current.data.size();
+        state.current = std::move(state.ready.front());
+        state.ready.pop_front();
+        state.ready_bytes -= state.current.data.size();
+        state.position = 0;
+        state.round_reported = false;
+
+        lock.unlock();
+        state.changed.notify_all();
+
+        // Also wakes the background thread if it waits on the budget, as `ready` may now be empty.
+        if (state.budget) {
+            state.budget->release(consumed);
+        }
+    }
+
+    const auto token = state.current.tokens[state.position];
+    state.token = stdx::nullopt;
+    if (token != prefetched_batch::k_no_token) {
+        state.token = state.current.at(token);
+    }
+
+    *out_event = state.current.at(state.current.events[state.position++]);
+    return true;
+}
+
+void change_stream::impl::stop_prefetch() {
+    if (!prefetch_) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{prefetch_->mutex};
+        prefetch_->stopping = true;
+    }
+    prefetch_->changed.notify_all();
+    if (prefetch_->budget) {
+        prefetch_->budget->wake();
+    }
+
+    // The background thread may be waiting on a getMore for up to max_await_time, which has to
+    // complete before the stream can be destroyed.
+    prefetch_->thread.join();
+
+    if (prefetch_->budget) {
+        prefetch_->budget->release(prefetch_->ready_bytes + prefetch_->current.data.size());
+    }
+    prefetch_.reset();
+}
+
 // void* since we don't leak C driver defs into C++ driver
 change_stream::change_stream(void* change_stream_ptr)
     : _impl(stdx::make_unique<impl>(static_cast<mongoc_change_stream_t*>(change_stream_ptr))) {}
@@ -134,5 +395,30 @@ bool change_stream::iterator::is_exhausted() const {
     return _change_stream->_impl->is_exhausted();
 }
 
+std::size_t change_stream::batch::size() const noexcept {
+    return _events.size();
+}
+
+bool change_stream::batch::empty() const noexcept {
+    return _events.empty();
+}
+
+change_stream::batch::const_iterator change_stream::batch::begin() const noexcept {
+    return _events.begin();
+}
+
+change_stream::batch::const_iterator change_stream::batch::end() const noexcept {
+    return _events.end();
+}
+
+const bsoncxx::document::view& change_stream::batch::operator[](std::size_t index) const {
+    return _events[index];
+}
+
+const stdx::optional<bsoncxx::document::value>& change_stream::batch::resume_token() const
+    noexcept {
+    return _resume_token;
+}
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -14,8 +14,13 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 
@@ -24,6 +29,7 @@
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
+class cached_collection;
 class client;
 class collection;
 class database;
@@ -31,6 +37,7 @@ class database;
 class MONGOCXX_API change_stream {
    public:
     class MONGOCXX_API iterator;
+    class MONGOCXX_API batch;
 
     ///
     /// Move constructs a change_stream.
@@ -103,11 +110,38 @@ class MONGOCXX_API change_stream {
     ///
     bsoncxx::stdx::optional<bsoncxx::document::view> get_resume_token() const;
 
+    ///
+    /// Collects the next events of the stream into a batch that can be processed and
+    /// checkpointed as a unit.
+    ///
+    /// Events are collected until max_events of them have been read, until no event arrives
+    /// within the max_await_time (from the options::change_stream), or until max_wait has
+    /// elapsed, whichever comes first. Events already fetched from the server are returned
+    /// without waiting. max_wait is checked between events, so a call may block for up to one
+    /// max_await_time longer than it.
+    ///
+    /// Events consumed here are not seen by iterators: iterators obtained before this call
+    /// compare equal to end(), and the next call to begin() continues after the batch.
+    ///
+    /// @param max_events
+    ///   The largest number of events to collect.
+    /// @param max_wait
+    ///   How long to keep collecting events.
+    ///
+    /// @return
+    ///   The collected events, which may be empty, and the resume token that follows them.
+    /// @exception
+    ///   Throws mongocxx::query_exception if the query failed.
+    ///
+    batch next_batch(std::size_t max_events, std::chrono::milliseconds max_wait);
+
    private:
+    friend class cached_collection;
     friend class client;
     friend class collection;
     friend class database;
     friend class change_stream::iterator;
+    friend class change_stream::batch;
 
     MONGOCXX_PRIVATE change_stream(void* change_stream_ptr);
 
@@ -195,6 +229,65 @@ class MONGOCXX_API change_stream::iterator {
     const change_stream* _change_stream;
 };
 
+///
+/// Events collected by change_stream::next_batch(). The batch owns copies of its events, so they
+/// remain valid after the stream is iterated further or destroyed.
+///
+class MONGOCXX_API change_stream::batch {
+   public:
+    using const_iterator = std::vector<bsoncxx::document::view>::const_iterator;
+
+    ///
+    /// Constructs an empty batch.
+    ///
+    batch() = default;
+
+    batch(batch&&) noexcept = default;
+    batch& operator=(batch&&) noexcept = default;
+
+    ///
+    /// @return The number of events in the batch.
+    ///
+    std::size_t size() const noexcept;
+
+    ///
+    /// @return true if the batch holds no events.
+    ///
+    bool empty() const noexcept;
+
+    ///
+    /// @return An iterator to the first event of the batch.
+    ///
+    const_iterator begin() const noexcept;
+
+    ///
+    /// @return An iterator past the last event of the batch.
+    ///
+    const_iterator end() const noexcept;
+
+    ///
+    /// @return The event at the given position, which must be less than size().
+    ///
+    const bsoncxx::document::view& operator[](std::size_t index) const;
+
+    ///
+    /// Returns the resume token that follows the last event of the batch: the postBatchResumeToken
+    /// if the server's batch was exhausted, or the _id of the last event otherwise. Resuming the
+    /// stream after it continues with the first event not in this batch, so it can be saved as
+    /// a checkpoint once the whole batch has been processed.
+    ///
+    /// @return The resume token, or no value if the stream had none.
+    ///
+    const bsoncxx::stdx::optional<bsoncxx::document::value>& resume_token() const noexcept;
+
+   private:
+    friend class change_stream;
+
+    std::vector<std::uint8_t> _buffer;
+    std::vector<bsoncxx::document::view> _events;
+    bsoncxx::stdx::optional<bsoncxx::document::value> _resume_token;
+};
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
 
@@ -14,6 +14,7 @@
 
 #include <mongocxx/client.hpp>
 
+#include <bsoncxx/builder/basic/helpers.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <mongocxx/exception/error_code.hpp>
@@ -23,12 +24,16 @@
 #include <mongocxx/options/auto_encryption.hpp>
 #include <mongocxx/options/private/apm.hh>
 #include <mongocxx/options/private/ssl.hh>
+#include <mongocxx/private/change_stream.hh>
 #include <mongocxx/private/client.hh>
 #include <mongocxx/private/client_session.hh>
+#include <mongocxx/private/compression_statistics.hh>
+#include <mongocxx/private/instance.hh>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/pipeline.hh>
 #include <mongocxx/private/read_concern.hh>
 #include <mongocxx/private/read_preference.hh>
+#include <mongocxx/private/topology_snapshot.hh>
 #include <mongocxx/private/uri.hh>
 #include <mongocxx/private/write_concern.hh>
 
@@ -39,6 +44,7 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 using namespace libbson;
 using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
 
 namespace {
 class database_names {
@@ -78,20 +84,30 @@ client::client(const class uri& uri, const options::client& options) {
         throw exception{error_code::k_ssl_not_supported};
     }
 #endif
-    auto new_client = libmongoc::client_new_from_uri(uri._impl->uri_t);
+    ensure_libmongoc_initialized();
+
+    unique_uri overridden{nullptr, libmongoc::uri_destroy};
+    auto new_client = libmongoc::client_new_from_uri(
+        uri_with_overrides(uri._impl->uri_t, options, &overridden));
     if (!new_client) {
         // Shouldn't happen after checks above, but future libmongoc's may change behavior.
         throw exception{error_code::k_invalid_parameter, "could not construct client from URI"};
     }
 
     _impl = stdx::make_unique<impl>(std::move(new_client));
+    _impl->replies = reply_budget::make(options.max_buffered_reply_bytes());
+
+    if (stream_initiator::needed(options)) {
+        _impl->streams = stdx::make_unique<stream_initiator>(options);
+        _impl->streams->attach(_get_impl().client_t);
+    }
 
     if (options.apm_opts()) {
-        _impl->listeners = *options.apm_opts();
-        auto callbacks = options::make_apm_callbacks(_impl->listeners);
-        // We cast the APM class to a void* so we can pass it into libmongoc's context.
-        // It will be cast back to an APM class in the event handlers.
-        auto context = static_cast<void*>(&(_impl->listeners));
+        _impl->apm.init(*options.apm_opts());
+        auto callbacks = options::make_apm_callbacks(_impl->apm.listeners);
+        // We cast the APM context to a void* so we can pass it into libmongoc's context.
+        // It will be cast back to an APM context in the event handlers.
+        auto context = static_cast<void*>(&(_impl->apm));
         libmongoc::client_set_apm_callbacks(_get_impl().client_t, callbacks.get(), context);
     }
 
@@ -118,8 +134,20 @@ client::client(const class uri& uri, const options::client& options) {
         libmongoc::client_set_ssl_opts(_get_impl().client_t, &mongoc_opts.first);
     }
 #endif
+
+    if (options.auto_encryption_opts()) {
+        options.auto_encryption_opts()->warm_up(*this);
+    }
+}
+
+client::impl::~impl() {
+    idle_sessions.clear();
+    clear_handles();
+    libmongoc::client_destroy(client_t);
 }
 
+constexpr std::size_t client::impl::k_max_idle_sessions;
+
 client::client(void* implementation)
     : _impl{stdx::make_unique<impl>(static_cast<::mongoc_client_t*>(implementation))} {}
 
@@ -184,6 +212,45 @@ class database client::database(bsoncxx::string::view_or_value name) const& {
     return mongocxx::database(*this, std::move(name));
 }
 
+class database& client::database_handle(stdx::string_view name) const& {
+    auto& impl = _get_impl();
+    impl.handle_key.assign(name.data(), name.size());
+
+    auto found = impl.database_handles.find(impl.handle_key);
+    if (found != impl.database_handles.end()) {
+        return *found->second;
+    }
+
+    auto handle = stdx::make_unique<class database>(this->database(name));
+    auto& result = *handle;
+    impl.database_handles.emplace(impl.handle_key, std::move(handle));
+    return result;
+}
+
+class collection& client::collection_handle(stdx::string_view database,
+                                            stdx::string_view collection) const& {
+    auto& impl = _get_impl();
+    auto set_key = [&impl, database, collection]() {
+        // Database names cannot contain a '.', so the namespace identifies the collection.
+        impl.handle_key.assign(database.data(), database.size());
+        impl.handle_key.push_back('.');
+        impl.handle_key.append(collection.data(), collection.size());
+    };
+    set_key();
+
+    auto found = impl.collection_handles.find(impl.handle_key);
+    if (found != impl.collection_handles.end()) {
+        return *found->second;
+    }
+
+    auto handle =
+        stdx::make_unique<class collection>(database_handle(database).collection(collection));
+    auto& result = *handle;
+    set_key();
+    impl.collection_handles.emplace(impl.handle_key, std::move(handle));
+    return result;
+}
+
 cursor client::list_databases() const {
     return libmongoc::client_find_databases_with_opts(_get_impl().client_t, nullptr);
 }
@@ -224,14 +291,93 @@ std::vector<std::string> client::list_database_names(
     return _names;
 }
 
+name_cursor client::list_database_names_cursor(const bsoncxx::document::view_or_value filter,
+                                               bool authorized_only) const {
+    bsoncxx::builder::basic::document options_builder;
+    options_builder.append(kvp("filter", filter));
+    options_builder.append(kvp("nameOnly", true));
+    if (authorized_only) {
+        options_builder.append(kvp("authorizedDatabases", true));
+    }
+
+    scoped_bson_t options_bson(options_builder.extract());
+
+    return name_cursor{cursor{libmongoc::client_find_databases_with_opts(_get_impl().client_t,
+                                                                         options_bson.bson())}};
+}
+
 class client_session client::start_session(const mongocxx::options::client_session& options) {
     return client_session(this, options);
 }
 
+bsoncxx::types::b_timestamp client::cluster_time() {
+    auto session = start_session(options::client_session{}.causal_consistency(false));
+    database("admin").run_command(session, make_document(kvp("ping", 1)));
+
+    const auto operation_time = session.operation_time();
+    if (operation_time.timestamp == 0 && operation_time.increment == 0) {
+        throw operation_exception{error_code::k_server_response_malformed,
+                                  "the deployment did not report an operationTime"};
+    }
+    return operation_time;
+}
+
 void client::reset() {
     libmongoc::client_reset(_get_impl().client_t);
 }
 
+std::vector<events::command_latency> client::command_latencies() const {
+    if (!_get_impl().apm.latencies) {
+        return {};
+    }
+
+    return _get_impl().apm.latencies->snapshot();
+}
+
+std::vector<events::slow_command> client::slow_commands() const {
+    if (!_get_impl().apm.slow_commands) {
+        return {};
+    }
+
+    return _get_impl().apm.slow_commands->snapshot();
+}
+
+std::vector<events::namespace_stats> client::namespace_stats() const {
+    if (!_get_impl().apm.namespaces) {
+        return {};
+    }
+
+    return _get_impl().apm.namespaces->snapshot();
+}
+
+std::vector<events::query_shape> client::query_shapes() const {
+    if (!_get_impl().apm.query_shapes) {
+        return {};
+    }
+
+    return _get_impl().apm.query_shapes->snapshot();
+}
+
+class topology_snapshot client::topology_snapshot() const {
+    return make_topology_snapshot(_get_impl().client_t, _get_impl().apm.latencies.get());
+}
+
+class compression_statistics client::compression_statistics() const {
+    return make_compression_statistics(_get_impl().client_t, _get_impl().apm);
+}
+
+std::uint64_t client::dropped_apm_events() const {
+    if (!_get_impl().apm.delivery) {
+        return 0;
+    }
+
+    return _get_impl().apm.delivery->dropped();
+}
+
+std::int64_t client::buffered_reply_bytes() const {
+    return static_cast<std::int64_t>(_get_impl().replies->used());
+}
+
 class change_stream client::watch(const options::change_stream& options) {
     return watch(pipeline{}, options);
 }
@@ -267,8 +413,16 @@ class change_stream client::_watch(const client_session* session,
 
     scoped_bson_t options_bson{options_builder.extract()};
 
-    return change_stream{
+    class change_stream stream{
         libmongoc::client_watch(_get_impl().client_t, pipeline_bson.bson(), options_bson.bson())};
+    if (options.prefetch_batches()) {
+        stream._impl->start_prefetch(*options.prefetch_batches(),
+                                     options.batch_size(),
+                                     options.max_prefetched_bytes(),
+                                     _get_impl().replies);
+    }
+
+    return stream;
 }
 
 const client::impl& client::_get_impl() const {
@@ -14,15 +14,25 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include <bsoncxx/types.hpp>
 #include <mongocxx/client_session.hpp>
+#include <mongocxx/compression_statistics.hpp>
 #include <mongocxx/database.hpp>
+#include <mongocxx/events/command_latency.hpp>
+#include <mongocxx/events/namespace_stats.hpp>
+#include <mongocxx/events/query_shape.hpp>
+#include <mongocxx/events/slow_command.hpp>
+#include <mongocxx/name_cursor.hpp>
 #include <mongocxx/options/client.hpp>
 #include <mongocxx/options/client_session.hpp>
 #include <mongocxx/read_concern.hpp>
 #include <mongocxx/read_preference.hpp>
 #include <mongocxx/stdx.hpp>
+#include <mongocxx/topology_snapshot.hpp>
 #include <mongocxx/uri.hpp>
 #include <mongocxx/write_concern.hpp>
 
@@ -208,6 +218,43 @@ class MONGOCXX_API client {
     MONGOCXX_INLINE class database operator[](bsoncxx::string::view_or_value name) const&;
     MONGOCXX_INLINE class database operator[](bsoncxx::string::view_or_value name) const&& = delete;
 
+    ///
+    /// Gets a database handle cached by the client.
+    ///
+    /// client::database() creates a new database, with its own libmongoc handle and a copy of its
+    /// name, on every call. database_handle() creates one the first time a name is looked up and
+    /// returns the same object for every later lookup, so that code looking up its databases for
+    /// every request allocates nothing once the handles exist.
+    ///
+    /// @note
+    ///   Every lookup of a name shares the handle, so settings changed on it, such as its read
+    ///   preference, apply to all of them. A handle is kept for every name looked up.
+    ///
+    /// @param name
+    ///   The name of the database.
+    ///
+    /// @return A reference to the cached handle. It is valid until the client is destroyed or,
+    /// for a client acquired from a pool, returned to the pool.
+    ///
+    class database& database_handle(stdx::string_view name) const&;
+    class database& database_handle(stdx::string_view name) const&& = delete;
+
+    ///
+    /// Gets a collection handle cached by the client, as database_handle() does for databases.
+    ///
+    /// @param database
+    ///   The name of the database of the collection.
+    /// @param collection
+    ///   The name of the collection.
+    ///
+    /// @return A reference to the cached handle. It is valid until the client is destroyed or,
+    /// for a client acquired from a pool, returned to the pool.
+    ///
+    class collection& collection_handle(stdx::string_view database,
+                                        stdx::string_view collection) const&;
+    class collection& collection_handle(stdx::string_view database,
+                                        stdx::string_view collection) const&& = delete;
+
     ///
     /// @{
     ///
@@ -277,6 +324,27 @@ class MONGOCXX_API client {
     std::vector<std::string> list_database_names(
         const bsoncxx::document::view_or_value filter = {}) const;
 
+    ///
+    /// Streams the names of the databases known to the MongoDB server.
+    ///
+    /// The listDatabases command is run with `nameOnly`, so that the server skips computing
+    /// database sizes, and the names are read lazily from its reply instead of being copied into a
+    /// std::vector.
+    ///
+    /// @param filter
+    ///   An optional query expression to filter the returned database names.
+    /// @param authorized_only
+    ///   Whether to only list the databases the user has privileges on, with
+    ///   `authorizedDatabases`. This lets users without the listDatabases privilege list the
+    ///   databases they can access.
+    ///
+    /// @return mongocxx::name_cursor yielding the database names.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/listDatabases
+    ///
+    name_cursor list_database_names_cursor(const bsoncxx::document::view_or_value filter = {},
+                                           bool authorized_only = false) const;
+
     ///
     /// @}
     ///
@@ -292,6 +360,20 @@ class MONGOCXX_API client {
     ///
     client_session start_session(const options::client_session& options = {});
 
+    ///
+    /// Gets the current cluster time of the deployment, as the operationTime of a ping.
+    ///
+    /// Passing the returned timestamp to collection::parallel_scan_at() on several collections, or
+    /// running snapshot reads at it in several sessions, makes all of them read the same
+    /// point-in-time view of the data, even when they run concurrently on different connections.
+    ///
+    /// @return The operationTime reported by the deployment.
+    ///
+    /// @throws mongocxx::operation_exception if the ping fails or if the deployment reports no
+    /// operationTime, as is the case for standalone servers.
+    ///
+    bsoncxx::types::b_timestamp cluster_time();
+
     ///
     /// @{
     ///
@@ -379,6 +461,97 @@ class MONGOCXX_API client {
     ///
     void reset();
 
+    ///
+    /// Takes a snapshot of the latency histograms recorded for the commands run by this client,
+    /// one per command name and server.
+    ///
+    /// Latencies are only recorded if the client was created with
+    /// options::apm::record_command_latencies(). Commands run by clients acquired from a pool are
+    /// recorded by the pool instead; see pool::command_latencies().
+    ///
+    /// @return The latencies recorded since the client was created, or none if they are not
+    ///   recorded.
+    ///
+    std::vector<events::command_latency> command_latencies() const;
+
+    ///
+    /// Returns the most recent slow commands run by this client, oldest first.
+    ///
+    /// Slow commands are only kept if the client was created with
+    /// options::apm::record_slow_commands(). Commands run by clients acquired from a pool are kept
+    /// by the pool instead; see pool::slow_commands().
+    ///
+    /// @return The slow commands kept, or none if they are not recorded.
+    ///
+    std::vector<events::slow_command> slow_commands() const;
+
+    ///
+    /// Takes a snapshot of the counts of the commands run by this client against each collection.
+    ///
+    /// Commands are only counted if the client was created with
+    /// options::apm::record_namespace_stats(). Commands run by clients acquired from a pool are
+    /// counted by the pool instead; see pool::namespace_stats().
+    ///
+    /// @return The counts since the client was created, sorted by namespace, or none if they are
+    ///   not recorded.
+    ///
+    std::vector<events::namespace_stats> namespace_stats() const;
+
+    ///
+    /// Returns the filter shapes run by this client against each collection, most frequent first.
+    ///
+    /// Shapes are only counted if the client was created with
+    /// options::apm::record_query_shapes(). Commands run by clients acquired from a pool are
+    /// counted by the pool instead; see pool::query_shapes().
+    ///
+    /// @return The shapes counted, or none if they are not recorded.
+    ///
+    /// @see mongocxx::unindexed_query_shapes()
+    ///
+    std::vector<events::query_shape> query_shapes() const;
+
+    ///
+    /// Takes a snapshot of what server selection knows about the deployment: the servers, their
+    /// round trip times, and the width of the latency window.
+    ///
+    /// Each server also reports how many commands succeeded on it, if the client was created with
+    /// options::apm::record_command_latencies(). For a client acquired from a pool, use
+    /// pool::topology_snapshot() instead to get those counts.
+    ///
+    /// @return The current state of the topology of this client.
+    ///
+    class topology_snapshot topology_snapshot() const;
+
+    ///
+    /// Gets the wire compression settings of this client, the compressor each server agreed to,
+    /// and the bytes of the commands and replies that were subject to compression.
+    ///
+    /// Bytes are only counted if the client was created with options::apm::record_command_bytes().
+    /// Commands run by clients acquired from a pool are counted by the pool instead; see
+    /// pool::compression_statistics().
+    ///
+    /// @return The current compression statistics of this client.
+    ///
+    class compression_statistics compression_statistics() const;
+
+    ///
+    /// Gets the number of command timings dropped because the queue of
+    /// options::apm::async_delivery() was full.
+    ///
+    /// @return The number of dropped command timings since the client was created.
+    ///
+    std::uint64_t dropped_apm_events() const;
+
+    ///
+    /// Gets the bytes of replies buffered ahead of the application by the prefetching cursors and
+    /// change streams of this client.
+    ///
+    /// A client acquired from a pool reports the usage of every client of the pool.
+    ///
+    /// @return The bytes counted against options::client::max_buffered_reply_bytes().
+    ///
+    std::int64_t buffered_reply_bytes() const;
+
    private:
     friend class collection;
     friend class database;
@@ -25,14 +25,52 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 // Private constructors.
 client_session::client_session(const class client* client,
-                               const mongocxx::options::client_session& options)
-    : _impl(stdx::make_unique<impl>(client, options)) {}
+                               const mongocxx::options::client_session& options) {
+    auto& idle_sessions = client->_get_impl().idle_sessions;
+    if (idle_sessions.empty()) {
+        _impl = stdx::make_unique<impl>(client, options);
+        return;
+    }
+
+    _impl = std::move(idle_sessions.back());
+    idle_sessions.pop_back();
+    _impl->restart(client, options);
+}
 
 client_session::client_session(client_session&&) noexcept = default;
 
-client_session& client_session::operator=(client_session&&) noexcept = default;
+client_session& client_session::operator=(client_session&& other) noexcept {
+    _release();
+    _impl = std::move(other._impl);
+    return *this;
+}
 
-client_session::~client_session() noexcept = default;
+client_session::~client_session() noexcept {
+    _release();
+}
+
+void client_session::_release() noexcept {
+    if (!_impl) {
+        return;
+    }
+
+    _impl->end();
+
+    // The client may have been moved from since the session was started.
+    const auto& owner = _impl->client();
+    if (owner) {
+        auto& idle_sessions = owner._get_impl().idle_sessions;
+        if (idle_sessions.size() < client::impl::k_max_idle_sessions) {
+            try {
+                idle_sessions.push_back(std::move(_impl));
+            } catch (...) {
+                // The object could not be kept for reuse and is destroyed instead.
+            }
+        }
+    }
+
+    _impl.reset();
+}
 
 const mongocxx::client& client_session::client() const noexcept {
     return _impl->client();
@@ -83,6 +121,11 @@ void client_session::with_transaction(with_transaction_cb cb, options::transacti
     _impl->with_transaction(this, std::move(cb), std::move(opts));
 }
 
+client_session::with_transaction_statistics client_session::with_transaction_stats() const
+    noexcept {
+    return _impl->with_transaction_stats();
+}
+
 const client_session::impl& client_session::_get_impl() const {
     // Never null.
     return *_impl;
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -154,17 +156,45 @@ class MONGOCXX_API client_session {
     /// the user callback should allow those exceptions to propagate up the stack
     /// so they can be caught and processed by the with_transaction helper.
     ///
+    /// Retries follow the backoff and retry budget of `opts`, or of the session's default
+    /// transaction options when `opts` sets none; see options::transaction::retry_backoff and
+    /// options::transaction::max_retries.
+    ///
     /// @param cb
     ///   The callback to run inside of a transaction.
     /// @param opts (optional)
     ///   The options to use to run the transaction.
     ///
     /// @throws mongocxx::operation_exception if there are errors completing the
-    /// transaction.
+    /// transaction, with the error code error_code::k_transaction_retry_budget_exhausted and the
+    /// server error of the last failed attempt if the retry budget ran out.
     ///
     using with_transaction_cb = std::function<void MONGOCXX_CALL(client_session*)>;
     void with_transaction(with_transaction_cb cb, options::transaction opts = {});
 
+    ///
+    /// Counters of the with_transaction calls made on a client session, as returned by
+    /// with_transaction_stats().
+    ///
+    struct with_transaction_statistics {
+        /// The number of with_transaction calls.
+        std::uint64_t transactions;
+
+        /// The number of times a callback was rerun after its first attempt.
+        std::uint64_t retries;
+
+        /// The number of with_transaction calls that ran out of retry budget.
+        std::uint64_t budget_exhausted;
+
+        /// The time spent sleeping between attempts.
+        std::chrono::nanoseconds backoff_time;
+    };
+
+    ///
+    /// Gets the counters of the with_transaction calls made since the session was started.
+    ///
+    with_transaction_statistics with_transaction_stats() const noexcept;
+
    private:
     friend class bulk_write;
     friend class client;
@@ -181,6 +211,9 @@ class MONGOCXX_API client_session {
     MONGOCXX_PRIVATE impl& _get_impl();
     MONGOCXX_PRIVATE const impl& _get_impl() const;
 
+    // Ends the session and hands its impl to the client for reuse.
+    MONGOCXX_PRIVATE void _release() noexcept;
+
     std::unique_ptr<impl> _impl;
 };
 
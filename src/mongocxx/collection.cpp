@@ -14,12 +14,18 @@
 
 #include <mongocxx/collection.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/builder/basic/sub_array.hpp>
@@ -44,15 +50,25 @@
 #include <mongocxx/exception/write_exception.hpp>
 #include <mongocxx/hint.hpp>
 #include <mongocxx/model/write.hpp>
+#include <mongocxx/pool.hpp>
 #include <mongocxx/private/bulk_write.hh>
+#include <mongocxx/private/change_stream.hh>
 #include <mongocxx/private/client.hh>
 #include <mongocxx/private/client_session.hh>
 #include <mongocxx/private/collection.hh>
 #include <mongocxx/private/cursor.hh>
 #include <mongocxx/private/database.hh>
+#include <mongocxx/private/document_deduplicator.hh>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/merged_cursor.hh>
+#include <mongocxx/private/operation_accounting.hh>
+#include <mongocxx/private/operation_timer.hh>
 #include <mongocxx/private/pipeline.hh>
+#include <mongocxx/private/prepared_find.hh>
+#include <mongocxx/private/prepared_find_one_and_update.hh>
+#include <mongocxx/private/prepared_update_one.hh>
+#include <mongocxx/private/profiler_markers.hh>
 #include <mongocxx/private/read_concern.hh>
 #include <mongocxx/private/read_preference.hh>
 #include <mongocxx/private/write_concern.hh>
@@ -80,6 +96,9 @@ namespace {
 using bsoncxx::stdx::make_unique;
 using mongocxx::libbson::scoped_bson_t;
 
+// The number of documents in the first batch of a find when batch_size is not set.
+constexpr std::int32_t k_server_first_batch_size = 101;
+
 const char* get_collection_name(mongoc_collection_t* collection) {
     return mongocxx::libmongoc::collection_get_name(collection);
 }
@@ -88,27 +107,16 @@ void destroy_fam_opts(mongoc_find_and_modify_opts_t* opts) {
     mongocxx::libmongoc::find_and_modify_opts_destroy(opts);
 }
 
+// Builds the fields of a findAndModify that libmongoc takes as a document: the write concern,
+// collation and session, among others.
 template <typename T>
-mongocxx::stdx::optional<bsoncxx::document::value> find_and_modify(
-    mongoc_collection_t* collection_t,
-    const mongoc_client_session_t* session_t,
-    view_or_value filter,
-    view_or_value* update,
-    mongoc_find_and_modify_flags_t flags,
-    bool bypass,
-    mongocxx::stdx::optional<bsoncxx::array::view_or_value> array_filters,
+bsoncxx::document::value find_and_modify_extra(
+    mongocxx::stdx::optional<bsoncxx::document::view> session_document,
+    const mongocxx::stdx::optional<bsoncxx::array::view_or_value>& array_filters,
     const mongocxx::stdx::optional<mongocxx::hint>& hint,
     const T& options) {
-    using unique_opts =
-        std::unique_ptr<mongoc_find_and_modify_opts_t,
-                        std::function<void MONGOCXX_CALL(mongoc_find_and_modify_opts_t*)>>;
-
-    auto opts = unique_opts(mongocxx::libmongoc::find_and_modify_opts_new(), destroy_fam_opts);
-
     bsoncxx::builder::basic::document extra;
-    ::bson_error_t error;
 
-    // Write concern, collation, and session are passed in "extra".
     if (options.write_concern()) {
         if (!options.write_concern()->is_acknowledged() && options.collation()) {
             throw mongocxx::logic_error{mongocxx::error_code::k_invalid_parameter};
@@ -116,16 +124,8 @@ mongocxx::stdx::optional<bsoncxx::document::value> find_and_modify(
         extra.append(concatenate(options.write_concern()->to_document()));
     }
 
-    if (session_t) {
-        bson_t bson = BSON_INITIALIZER;
-        if (!mongocxx::libmongoc::client_session_append(session_t, &bson, &error)) {
-            bson_destroy(&bson);
-            throw mongocxx::logic_error{mongocxx::error_code::k_invalid_session, error.message};
-        }
-
-        // document::value takes ownership of the bson buffer.
-        bsoncxx::document::value session_id{bsoncxx::helpers::value_from_bson_t(&bson)};
-        extra.append(concatenate(session_id.view()));
+    if (session_document) {
+        extra.append(concatenate(*session_document));
     }
 
     if (options.collation()) {
@@ -140,6 +140,56 @@ mongocxx::stdx::optional<bsoncxx::document::value> find_and_modify(
         extra.append(kvp("hint", hint->to_value()));
     }
 
+    return extra.extract();
+}
+
+// Calls mongoc_collection_find_and_modify_with_opts and returns the document it found, if any.
+mongocxx::stdx::optional<bsoncxx::document::value> run_find_and_modify(
+    mongoc_collection_t* collection_t,
+    bsoncxx::document::view filter,
+    const mongoc_find_and_modify_opts_t* opts) {
+    ::bson_error_t error;
+    scoped_bson_t filter_bson{filter};
+    mongocxx::libbson::scoped_bson_t reply;
+
+    bool result = mongocxx::libmongoc::collection_find_and_modify_with_opts(
+        collection_t, filter_bson.bson(), opts, reply.bson_for_init(), &error);
+
+    if (!result) {
+        if (!reply.view().empty()) {
+            mongocxx::throw_exception<mongocxx::write_exception>(reply.steal(), error);
+        }
+        mongocxx::throw_exception<mongocxx::write_exception>(error);
+    }
+
+    bsoncxx::document::view reply_view = reply.view();
+
+    if (reply_view["value"].type() == bsoncxx::type::k_null) {
+        return mongocxx::stdx::optional<bsoncxx::document::value>{};
+    }
+
+    return bsoncxx::document::value{reply_view["value"].get_document().view()};
+}
+
+template <typename T>
+mongocxx::stdx::optional<bsoncxx::document::value> find_and_modify(
+    mongoc_collection_t* collection_t,
+    mongocxx::stdx::optional<bsoncxx::document::view> session_document,
+    const view_or_value& filter,
+    view_or_value* update,
+    mongoc_find_and_modify_flags_t flags,
+    bool bypass,
+    const mongocxx::stdx::optional<bsoncxx::array::view_or_value>& array_filters,
+    const mongocxx::stdx::optional<mongocxx::hint>& hint,
+    const T& options) {
+    using unique_opts =
+        std::unique_ptr<mongoc_find_and_modify_opts_t,
+                        std::function<void MONGOCXX_CALL(mongoc_find_and_modify_opts_t*)>>;
+
+    auto opts = unique_opts(mongocxx::libmongoc::find_and_modify_opts_new(), destroy_fam_opts);
+
+    // Write concern, collation, and session are passed in "extra".
+    auto extra = find_and_modify_extra(session_document, array_filters, hint, options);
     scoped_bson_t extra_bson{extra.view()};
     mongocxx::libmongoc::find_and_modify_opts_append(opts.get(), extra_bson.bson());
 
@@ -153,12 +203,12 @@ mongocxx::stdx::optional<bsoncxx::document::value> find_and_modify(
     }
 
     if (options.sort()) {
-        scoped_bson_t sort_bson{*options.sort()};
+        scoped_bson_t sort_bson{options.sort()->view()};
         mongocxx::libmongoc::find_and_modify_opts_set_sort(opts.get(), sort_bson.bson());
     }
 
     if (options.projection()) {
-        scoped_bson_t projection_bson{*options.projection()};
+        scoped_bson_t projection_bson{options.projection()->view()};
         mongocxx::libmongoc::find_and_modify_opts_set_fields(opts.get(), projection_bson.bson());
     }
 
@@ -170,27 +220,7 @@ mongocxx::stdx::optional<bsoncxx::document::value> find_and_modify(
     // Upsert, remove, and new are passed in flags.
     mongocxx::libmongoc::find_and_modify_opts_set_flags(opts.get(), flags);
 
-    // Call mongoc_collection_find_and_modify_with_opts.
-    scoped_bson_t filter_bson{filter.view()};
-    mongocxx::libbson::scoped_bson_t reply;
-
-    bool result = mongocxx::libmongoc::collection_find_and_modify_with_opts(
-        collection_t, filter_bson.bson(), opts.get(), reply.bson_for_init(), &error);
-
-    if (!result) {
-        if (!reply.view().empty()) {
-            mongocxx::throw_exception<mongocxx::write_exception>(reply.steal(), error);
-        }
-        mongocxx::throw_exception<mongocxx::write_exception>(error);
-    }
-
-    bsoncxx::document::view reply_view = reply.view();
-
-    if (reply_view["value"].type() == bsoncxx::type::k_null) {
-        return mongocxx::stdx::optional<bsoncxx::document::value>{};
-    }
-
-    return bsoncxx::document::value{reply_view["value"].get_document().view()};
+    return run_find_and_modify(collection_t, filter.view(), opts.get());
 }
 
 }  // namespace
@@ -200,6 +230,9 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 using namespace libbson;
 
+constexpr std::size_t collection::k_default_insert_stream_batch_bytes;
+constexpr std::size_t collection::k_insert_many_batch_bytes;
+
 collection::collection() noexcept = default;
 collection::collection(collection&&) noexcept = default;
 collection& collection::operator=(collection&&) noexcept = default;
@@ -230,6 +263,8 @@ void collection::_rename(const client_session* session,
 
     scoped_bson_t opts_bson{opts_doc.view()};
 
+    // A successful rename changes the name of the mongoc_collection_t.
+    _get_impl().detach();
     bool result = libmongoc::collection_rename_with_opts(_get_impl().collection_t,
                                                          _get_impl().database_name.c_str(),
                                                          new_name.terminated().data(),
@@ -305,6 +340,8 @@ bulk_write collection::create_bulk_write(const client_session& session,
 namespace {
 
 bsoncxx::builder::basic::document build_find_options_document(const options::find& options) {
+    MONGOCXX_PROFILER_PHASE("mongocxx::serialize");
+    operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
     bsoncxx::builder::basic::document options_builder;
 
     if (options.allow_disk_use()) {
@@ -339,6 +376,10 @@ bsoncxx::builder::basic::document build_find_options_document(const options::fin
         }
     }
 
+    if (options.exhaust()) {
+        options_builder.append(kvp("exhaust", *options.exhaust()));
+    }
+
     if (options.hint()) {
         options_builder.append(kvp("hint", options.hint()->to_value()));
     }
@@ -388,25 +429,108 @@ bsoncxx::builder::basic::document build_find_options_document(const options::fin
     return options_builder;
 }
 
+// Rebases the reply of a failed insert batch that began at document `offset` onto the whole
+// insert: write errors are numbered from the first document and the documents inserted by earlier
+// batches are counted, as in the reply of a single bulk write. If `input_positions` is not null,
+// the i-th document sent was at position `(*input_positions)[i]` of the input, and write errors are
+// numbered by input position instead.
+void rebase_batch_error(operation_exception& e,
+                        std::size_t offset,
+                        std::int32_t inserted_before,
+                        const std::vector<std::size_t>* input_positions) {
+    auto& raw = e.raw_server_error();
+    if (!raw || (offset == 0 && inserted_before == 0 && !input_positions)) {
+        return;
+    }
+
+    auto rebase = [&](std::int32_t index) {
+        const auto sent = offset + static_cast<std::size_t>(index);
+        if (input_positions && index >= 0 && sent < input_positions->size()) {
+            return static_cast<std::int32_t>((*input_positions)[sent]);
+        }
+        return static_cast<std::int32_t>(sent);
+    };
+    bsoncxx::builder::basic::document reply;
+    for (auto&& elem : raw->view()) {
+        if (elem.key() == stdx::string_view{"nInserted"} &&
+            elem.type() == bsoncxx::type::k_int32) {
+            reply.append(kvp("nInserted", elem.get_int32().value + inserted_before));
+        } else if (elem.key() == stdx::string_view{"writeErrors"} &&
+                   elem.type() == bsoncxx::type::k_array) {
+            reply.append(kvp("writeErrors", [&](sub_array errors) {
+                for (auto&& error : elem.get_array().value) {
+                    errors.append([&](sub_document rebased) {
+                        for (auto&& field : error.get_document().value) {
+                            if (field.key() == stdx::string_view{"index"} &&
+                                field.type() == bsoncxx::type::k_int32) {
+                                rebased.append(kvp("index", rebase(field.get_int32().value)));
+                            } else {
+                                rebased.append(kvp(field.key(), field.get_value()));
+                            }
+                        }
+                    });
+                }
+            }));
+        } else {
+            reply.append(kvp(elem.key(), elem.get_value()));
+        }
+    }
+    raw = reply.extract();
+}
+
+// Whether an insert with these options is acknowledged, falling back on the write concern of the
+// collection when the options have none.
+bool insert_is_acknowledged(const options::insert& options, const mongoc_collection_t* coll) {
+    if (options.write_concern()) {
+        return options.write_concern()->is_acknowledged();
+    }
+    return libmongoc::write_concern_is_acknowledged(libmongoc::collection_get_write_concern(coll));
+}
+
 }  // namespace
 
 cursor collection::_find(const client_session* session,
                          view_or_value filter,
                          const options::find& options) {
-    scoped_bson_t filter_bson{std::move(filter)};
+    operation_timer timer;
+    if (!options.cache_options_document().value_or(false)) {
+        auto options_builder = build_find_options_document(options);
+        return _find_prepared(session, filter.view(), options_builder.view(), options);
+    }
+
+    // Two threads may both build the document the first time; either result can be kept.
+    auto& cache = options._cached_document.value;
+    auto options_document = std::atomic_load(&cache);
+    if (!options_document) {
+        options_document = std::make_shared<const bsoncxx::document::value>(
+            build_find_options_document(options).extract());
+        std::atomic_store(&cache, options_document);
+    }
+    return _find_prepared(session, filter.view(), options_document->view(), options);
+}
+
+cursor collection::_find_prepared(const client_session* session,
+                                  bsoncxx::document::view filter,
+                                  bsoncxx::document::view options_document,
+                                  const options::find& options) {
+    scoped_bson_t filter_bson{filter};
 
     const mongoc_read_prefs_t* rp_ptr = NULL;
     if (options.read_preference()) {
         rp_ptr = options.read_preference()->_impl->read_preference_t;
     }
 
-    bsoncxx::builder::basic::document options_builder{build_find_options_document(options)};
+    stdx::optional<bsoncxx::document::value> with_session;
     if (session) {
+        bsoncxx::builder::basic::document options_builder;
+        options_builder.append(bsoncxx::builder::concatenate_doc{options_document});
         options_builder.append(
             bsoncxx::builder::concatenate_doc{session->_get_impl().to_document()});
+        with_session = options_builder.extract();
+        options_document = with_session->view();
     }
 
-    scoped_bson_t options_bson{options_builder.extract()};
+    scoped_bson_t options_bson{options_document};
 
     cursor query_cursor{
         libmongoc::collection_find_with_opts(
@@ -422,6 +546,23 @@ cursor collection::_find(const client_session* session,
                                                 static_cast<std::uint32_t>(count));
     }
 
+    const bool adaptive = options.adaptive_batch_size().value_or(false);
+    if (options.max_batch_bytes() || adaptive) {
+        const auto max_bytes = options.max_batch_bytes().value_or(0);
+        if (options.max_batch_bytes() && max_bytes <= 0) {
+            throw logic_error{error_code::k_invalid_parameter, "max_batch_bytes must be positive"};
+        }
+        query_cursor._impl->start_batch_sizing(
+            options.batch_size().value_or(k_server_first_batch_size), max_bytes, adaptive);
+    }
+
+    if (options.prefetch_batches()) {
+        query_cursor._impl->start_prefetch(*options.prefetch_batches(),
+                                           options.batch_size(),
+                                           options.max_prefetched_bytes(),
+                                           _get_impl().client_impl->replies);
+    }
+
     return query_cursor;
 }
 
@@ -435,9 +576,192 @@ cursor collection::find(const client_session& session,
     return _find(&session, std::move(filter), options);
 }
 
+prepared_find collection::prepare_find(view_or_value filter, const options::find& options) {
+    return prepared_find{stdx::make_unique<prepared_find::impl>(
+        *this, filter.view(), build_find_options_document(options).extract(), options)};
+}
+
+namespace {
+
+// Splits the documents of `coll` matching `filter` into at most `partitions` ranges of _id, and
+// returns a filter matching the documents of each range, in _id order.
+std::vector<bsoncxx::document::value> partition_filters(collection& coll,
+                                                        std::int32_t partitions,
+                                                        bsoncxx::document::view filter) {
+    if (partitions <= 0) {
+        throw logic_error{error_code::k_invalid_parameter};
+    }
+
+    // $bucketAuto sorts the matching documents by _id and splits them into buckets of roughly
+    // equal size. The lower bound of each bucket after the first is a partition boundary.
+    pipeline buckets;
+    buckets.match(filter);
+    buckets.bucket_auto(make_document(kvp("groupBy", "$_id"), kvp("buckets", partitions)));
+
+    bsoncxx::builder::basic::array boundaries;
+    std::size_t num_buckets = 0;
+    for (auto&& bucket : coll.aggregate(buckets)) {
+        if (num_buckets++ > 0) {
+            boundaries.append(bucket["_id"]["min"].get_value());
+        }
+    }
+
+    const auto boundary_values = boundaries.view();
+    std::vector<bsoncxx::types::value> bounds;
+    for (auto&& boundary : boundary_values) {
+        bounds.push_back(boundary.get_value());
+    }
+
+    std::vector<bsoncxx::document::value> filters;
+    filters.reserve(bounds.size() + 1);
+
+    for (std::size_t i = 0; i <= bounds.size(); i++) {
+        bsoncxx::builder::basic::document range;
+        if (i > 0) {
+            range.append(kvp("$gte", bounds[i - 1]));
+        }
+        if (i < bounds.size()) {
+            range.append(kvp("$lt", bounds[i]));
+        }
+
+        bsoncxx::builder::basic::document partition_filter;
+        if (bounds.empty()) {
+            partition_filter.append(concatenate(filter));
+        } else {
+            partition_filter.append(
+                kvp("$and", make_array(filter, make_document(kvp("_id", range.extract())))));
+        }
+        filters.push_back(partition_filter.extract());
+    }
+
+    return filters;
+}
+
+// Keeps alive what a cursor of collection::parallel_scan_at() reads through. The session is
+// declared last so that it ends before its client returns to the pool.
+struct snapshot_partition {
+    pool::entry client;
+    client_session session;
+};
+
+}  // namespace
+
+std::vector<cursor> collection::parallel_scan(class pool& pool,
+                                              std::int32_t partitions,
+                                              view_or_value filter,
+                                              const options::find& options) {
+    auto filters = partition_filters(*this, partitions, filter.view());
+
+    std::vector<cursor> cursors;
+    cursors.reserve(filters.size());
+
+    for (auto&& partition_filter : filters) {
+        auto client = pool.acquire();
+        auto partition = (*client)[_get_impl().database_name][name()];
+        partition.read_concern(read_concern());
+        partition.read_preference(read_preference());
+
+        auto partition_cursor = partition.find(std::move(partition_filter), options);
+        partition_cursor._impl->owner = std::make_shared<pool::entry>(std::move(client));
+        cursors.push_back(std::move(partition_cursor));
+    }
+
+    return cursors;
+}
+
+std::vector<cursor> collection::parallel_scan_at(class pool& pool,
+                                                 bsoncxx::types::b_timestamp at_cluster_time,
+                                                 std::int32_t partitions,
+                                                 view_or_value filter,
+                                                 const options::find& options) {
+    if (options.cursor_type() && *options.cursor_type() != cursor::type::k_non_tailable) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "snapshot reads do not support tailable cursors"};
+    }
+
+    // The read concern of the options document replaces the one of the collection.
+    bsoncxx::builder::basic::document options_builder;
+    options_builder.append(concatenate(build_find_options_document(options).view()));
+    options_builder.append(kvp("readConcern",
+                               make_document(kvp("level", "snapshot"),
+                                             kvp("atClusterTime", at_cluster_time))));
+    const auto options_document = options_builder.extract();
+
+    auto filters = partition_filters(*this, partitions, filter.view());
+
+    std::vector<cursor> cursors;
+    cursors.reserve(filters.size());
+
+    for (auto&& partition_filter : filters) {
+        auto client = pool.acquire();
+        auto partition = (*client)[_get_impl().database_name][name()];
+        partition.read_preference(read_preference());
+
+        // A session without causal consistency, so that no afterClusterTime is added to the read
+        // concern. Its getMores run in the same session, at the same cluster time.
+        auto session = client->start_session(options::client_session{}.causal_consistency(false));
+        auto owner = std::make_shared<snapshot_partition>(
+            snapshot_partition{std::move(client), std::move(session)});
+
+        auto partition_cursor = partition._find_prepared(
+            &owner->session, partition_filter.view(), options_document.view(), options);
+        partition_cursor._impl->owner = std::move(owner);
+        cursors.push_back(std::move(partition_cursor));
+    }
+
+    return cursors;
+}
+
+merged_cursor collection::find_by_ids(class pool& pool,
+                                      const std::vector<bsoncxx::types::value>& ids,
+                                      const options::find& options,
+                                      std::size_t chunk_size,
+                                      std::size_t max_connections) {
+    if (chunk_size == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "chunk_size must be positive"};
+    }
+    if (options.limit() || options.skip()) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "find_by_ids does not support limit or skip"};
+    }
+
+    // Build each $in array in place so that no id is copied more than once.
+    std::vector<bsoncxx::document::value> filters;
+    filters.reserve((ids.size() + chunk_size - 1) / chunk_size);
+    for (std::size_t begin = 0; begin < ids.size(); begin += chunk_size) {
+        const auto end = std::min(ids.size(), begin + chunk_size);
+
+        bsoncxx::builder::basic::document filter;
+        filter.append(kvp("_id", [&](sub_document in) {
+            in.append(kvp("$in", [&](sub_array values) {
+                for (auto i = begin; i < end; i++) {
+                    values.append(ids[i]);
+                }
+            }));
+        }));
+        filters.push_back(filter.extract());
+    }
+
+    auto connections = filters.size();
+    if (max_connections > 0) {
+        connections = std::min(connections, max_connections);
+    }
+
+    auto impl = stdx::make_unique<merged_cursor::impl>(&pool,
+                                                       _get_impl().database_name,
+                                                       std::string{name()},
+                                                       read_concern(),
+                                                       read_preference(),
+                                                       options,
+                                                       std::move(filters));
+    impl->start(connections);
+    return merged_cursor{std::move(impl)};
+}
+
 stdx::optional<bsoncxx::document::value> collection::_find_one(const client_session* session,
                                                                view_or_value filter,
                                                                const options::find& options) {
+    operation_timer timer;
     options::find copy(options);
     copy.limit(1);
     cursor cursor =
@@ -446,6 +770,23 @@ stdx::optional<bsoncxx::document::value> collection::_find_one(const client_sess
     if (it == cursor.end()) {
         return stdx::nullopt;
     }
+    MONGOCXX_PROFILER_PHASE("mongocxx::deserialize");
+    operation_timer::scoped_phase construct{operation_timer::phase::k_result};
+    return stdx::optional<bsoncxx::document::value>(bsoncxx::document::value{*it});
+}
+
+stdx::optional<bsoncxx::document::value> collection::_find_one_on_server(
+    std::uint32_t server_id, bsoncxx::document::view filter, const options::find& options) {
+    options::find copy(options);
+    copy.limit(1);
+    auto options_builder = build_find_options_document(copy);
+    options_builder.append(kvp("serverId", static_cast<std::int64_t>(server_id)));
+
+    cursor cursor = _find_prepared(nullptr, filter, options_builder.view(), copy);
+    cursor::iterator it = cursor.begin();
+    if (it == cursor.end()) {
+        return stdx::nullopt;
+    }
     return stdx::optional<bsoncxx::document::value>(bsoncxx::document::value{*it});
 }
 
@@ -463,6 +804,10 @@ stdx::optional<bsoncxx::document::value> collection::find_one(const client_sessi
 cursor collection::_aggregate(const client_session* session,
                               const pipeline& pipeline,
                               const options::aggregate& options) {
+    // libmongoc sends the command on the first iteration, so this is all serialization.
+    MONGOCXX_PROFILER_PHASE("mongocxx::serialize");
+    operation_timer timer;
+    operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
     scoped_bson_t stages(bsoncxx::document::view(pipeline._impl->view_array()));
 
     bsoncxx::builder::basic::document b;
@@ -481,11 +826,20 @@ cursor collection::_aggregate(const client_session* session,
         rp_ptr = options.read_preference()->_impl->read_preference_t;
     }
 
-    return cursor(libmongoc::collection_aggregate(_get_impl().collection_t,
-                                                  static_cast<::mongoc_query_flags_t>(0),
-                                                  stages.bson(),
-                                                  options_bson.bson(),
-                                                  rp_ptr));
+    cursor aggregate_cursor{libmongoc::collection_aggregate(_get_impl().collection_t,
+                                                            static_cast<::mongoc_query_flags_t>(0),
+                                                            stages.bson(),
+                                                            options_bson.bson(),
+                                                            rp_ptr)};
+
+    if (options.prefetch_batches()) {
+        aggregate_cursor._impl->start_prefetch(*options.prefetch_batches(),
+                                               options.batch_size(),
+                                               options.max_prefetched_bytes(),
+                                               _get_impl().client_impl->replies);
+    }
+
+    return aggregate_cursor;
 }
 
 cursor collection::aggregate(const pipeline& pipeline, const options::aggregate& options) {
@@ -498,9 +852,16 @@ cursor collection::aggregate(const client_session& session,
     return _aggregate(&session, pipeline, options);
 }
 
-stdx::optional<result::insert_one> collection::_insert_one(const client_session* session,
-                                                           view_or_value document,
-                                                           const options::insert& options) {
+write_outcome<result::insert_one> collection::_insert_one(const client_session* session,
+                                                          view_or_value document,
+                                                          const options::insert& options) {
+    operation_timer timer;
+
+    if (!session && options.group_commit().value_or(false) &&
+        insert_is_acknowledged(options, _get_impl().collection_t)) {
+        return _insert_one_grouped(std::move(document), options);
+    }
+
     // TODO: We should consider making it possible to convert from an options::insert into
     // an options::bulk_write at the type level, removing the need to re-iterate this code
     // many times here and below.
@@ -520,37 +881,122 @@ stdx::optional<result::insert_one> collection::_insert_one(const client_session*
     class bulk_write bulk_op {
         *this, bulk_opts, session
     };
+
+    // An unacknowledged insert has no result to report the _id in, so the document is appended
+    // as it is and libmongoc generates any missing _id while encoding it.
+    if (!insert_is_acknowledged(options, _get_impl().collection_t)) {
+        auto view = document.view();
+        bulk_op.append_insert_raw(view.data(), view.length());
+
+        auto outcome = bulk_op.try_execute();
+        if (outcome.has_error()) {
+            return write_outcome<result::insert_one>{std::move(outcome)};
+        }
+        return stdx::optional<result::insert_one>{};
+    }
+
     bsoncxx::document::element oid{};
     bsoncxx::builder::basic::document new_document;
 
     if (!document.view()["_id"]) {
+        MONGOCXX_PROFILER_PHASE("mongocxx::serialize");
+        operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
         new_document.append(kvp("_id", bsoncxx::oid()));
-        new_document.append(concatenate(document));
+        new_document.append(concatenate(document.view()));
         bulk_op.append(model::insert_one(new_document.view()));
         oid = new_document.view()["_id"];
     } else {
-        bulk_op.append(model::insert_one(document));
+        bulk_op.append(model::insert_one(document.view()));
         oid = document.view()["_id"];
     }
 
-    auto result = bulk_op.execute();
+    auto outcome = bulk_op.try_execute();
+    if (outcome.has_error()) {
+        return write_outcome<result::insert_one>{std::move(outcome)};
+    }
+
+    auto result = std::move(outcome).value();
     if (!result) {
-        return stdx::nullopt;
+        return stdx::optional<result::insert_one>{};
     }
 
+    operation_timer::scoped_phase construct{operation_timer::phase::k_result};
     return stdx::optional<result::insert_one>(
         result::insert_one(std::move(result.value()), std::move(oid.get_value())));
 }
 
+write_outcome<result::insert_one> collection::_insert_one_grouped(view_or_value document,
+                                                                  const options::insert& options) {
+    bsoncxx::builder::basic::document new_document;
+    auto view = document.view();
+    if (!view["_id"]) {
+        MONGOCXX_PROFILER_PHASE("mongocxx::serialize");
+        operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
+        new_document.append(kvp("_id", bsoncxx::oid()));
+        new_document.append(concatenate(view));
+        view = new_document.view();
+    }
+
+    options::bulk_write bulk_opts;
+    bulk_opts.ordered(false);
+    bulk_opts.write_concern(options.write_concern() ? *options.write_concern() : write_concern());
+    if (options.bypass_document_validation()) {
+        bulk_opts.bypass_document_validation(*options.bypass_document_validation());
+    }
+
+    // Only inserts that would be sent as the same bulk write may share a group.
+    const auto write_concern_document = bulk_opts.write_concern()->to_document();
+    std::string key = _get_impl().database_name;
+    key += '.';
+    key.append(name().data(), name().size());
+    key += '\0';
+    key.append(reinterpret_cast<const char*>(write_concern_document.view().data()),
+               write_concern_document.view().length());
+    const auto bypass = bulk_opts.bypass_document_validation();
+    key += static_cast<char>(bypass ? (*bypass ? 2 : 1) : 0);
+
+    auto outcome = _get_impl().client_impl->group_commits->insert(
+        key, view, [&](const std::vector<bsoncxx::document::view>& documents) {
+            class bulk_write group {
+                *this, bulk_opts, nullptr
+            };
+            for (auto&& queued : documents) {
+                group.append_insert_raw(queued.data(), queued.length());
+            }
+            return group.try_execute();
+        });
+    if (outcome.has_error()) {
+        return write_outcome<result::insert_one>{std::move(outcome)};
+    }
+
+    auto result = std::move(outcome).value();
+    if (!result) {
+        return stdx::optional<result::insert_one>{};
+    }
+    return stdx::optional<result::insert_one>(
+        result::insert_one(std::move(result.value()), view["_id"].get_value()));
+}
+
 stdx::optional<result::insert_one> collection::insert_one(view_or_value document,
                                                           const options::insert& options) {
-    return _insert_one(nullptr, document, options);
+    return _insert_one(nullptr, std::move(document), options).value();
 }
 
 stdx::optional<result::insert_one> collection::insert_one(const client_session& session,
                                                           view_or_value document,
                                                           const options::insert& options) {
-    return _insert_one(&session, document, options);
+    return _insert_one(&session, std::move(document), options).value();
+}
+
+write_outcome<result::insert_one> collection::try_insert_one(view_or_value document,
+                                                              const options::insert& options) {
+    return _insert_one(nullptr, std::move(document), options);
+}
+
+write_outcome<result::insert_one> collection::try_insert_one(const client_session& session,
+                                                              view_or_value document,
+                                                              const options::insert& options) {
+    return _insert_one(&session, std::move(document), options);
 }
 
 stdx::optional<result::replace_one> collection::_replace_one(const client_session* session,
@@ -594,14 +1040,14 @@ stdx::optional<result::replace_one> collection::_replace_one(const client_sessio
 stdx::optional<result::replace_one> collection::replace_one(view_or_value filter,
                                                             view_or_value replacement,
                                                             const options::replace& options) {
-    return _replace_one(nullptr, std::move(filter), replacement, options);
+    return _replace_one(nullptr, std::move(filter), std::move(replacement), options);
 }
 
 stdx::optional<result::replace_one> collection::replace_one(const client_session& session,
                                                             view_or_value filter,
                                                             view_or_value replacement,
                                                             const options::replace& options) {
-    return _replace_one(&session, std::move(filter), replacement, options);
+    return _replace_one(&session, std::move(filter), std::move(replacement), options);
 }
 
 stdx::optional<result::update> collection::_update_many(const client_session* session,
@@ -643,7 +1089,7 @@ stdx::optional<result::update> collection::_update_many(const client_session* se
 stdx::optional<result::update> collection::update_many(view_or_value filter,
                                                        view_or_value update,
                                                        const options::update& options) {
-    return _update_many(nullptr, std::move(filter), update, options);
+    return _update_many(nullptr, std::move(filter), std::move(update), options);
 }
 
 stdx::optional<result::update> collection::update_many(view_or_value filter,
@@ -663,7 +1109,7 @@ stdx::optional<result::update> collection::update_many(const client_session& ses
                                                        view_or_value filter,
                                                        view_or_value update,
                                                        const options::update& options) {
-    return _update_many(&session, std::move(filter), update, options);
+    return _update_many(&session, std::move(filter), std::move(update), options);
 }
 
 stdx::optional<result::update> collection::update_many(const client_session& session,
@@ -681,10 +1127,10 @@ stdx::optional<result::update> collection::update_many(const client_session& ses
     return _update_many(&session, std::move(filter), bsoncxx::document::view{}, options);
 }
 
-stdx::optional<result::update> collection::_update_one(const client_session* session,
-                                                       view_or_value filter,
-                                                       view_or_value update,
-                                                       const options::update& options) {
+write_outcome<result::update> collection::_update_one(const client_session* session,
+                                                      view_or_value filter,
+                                                      view_or_value update,
+                                                      const options::update& options) {
     options::bulk_write bulk_opts;
 
     if (options.bypass_document_validation()) {
@@ -709,6 +1155,50 @@ stdx::optional<result::update> collection::_update_one(const client_session* ses
 
     bulk_op.append(update_op);
 
+    auto outcome = bulk_op.try_execute();
+    if (outcome.has_error()) {
+        return write_outcome<result::update>{std::move(outcome)};
+    }
+
+    auto result = std::move(outcome).value();
+    if (!result) {
+        return stdx::optional<result::update>{};
+    }
+
+    return stdx::optional<result::update>(result::update(std::move(result.value())));
+}
+
+stdx::optional<result::update> collection::_update_one_prepared(
+    const client_session* session,
+    bsoncxx::document::view filter,
+    bsoncxx::document::view update,
+    bsoncxx::document::view operation_options,
+    const options::bulk_write& bulk_options) {
+    auto bulk_op =
+        session ? create_bulk_write(*session, bulk_options) : create_bulk_write(bulk_options);
+
+    // Append the frozen documents directly, rather than through a model::update_one whose
+    // options would have to be built again.
+    scoped_bson_t filter_bson{filter};
+    scoped_bson_t update_bson{update};
+    stdx::optional<bsoncxx::document::view_or_value> non_empty_options;
+    if (!operation_options.empty()) {
+        non_empty_options = bsoncxx::document::view_or_value{operation_options};
+    }
+    scoped_bson_t options_bson{std::move(non_empty_options)};
+
+    const auto sub_batch = bulk_op._impl->sub_batch_for(filter, true);
+    bson_error_t error;
+    if (!libmongoc::bulk_operation_update_one_with_opts(
+            bulk_op._impl->operation(sub_batch),
+            filter_bson.bson(),
+            update_bson.bson(),
+            options_bson.bson(),
+            &error)) {
+        throw_exception<logic_error>(error);
+    }
+    bulk_op._impl->appended_to(sub_batch);
+
     auto result = bulk_op.execute();
     if (!result) {
         return stdx::nullopt;
@@ -717,45 +1207,90 @@ stdx::optional<result::update> collection::_update_one(const client_session* ses
     return stdx::optional<result::update>(result::update(std::move(result.value())));
 }
 
+prepared_update_one collection::prepare_update_one(view_or_value filter,
+                                                   view_or_value update,
+                                                   const options::update& options) {
+    options::bulk_write bulk_options;
+    if (options.bypass_document_validation()) {
+        bulk_options.bypass_document_validation(*options.bypass_document_validation());
+    }
+    if (options.write_concern()) {
+        bulk_options.write_concern(*options.write_concern());
+    }
+
+    bsoncxx::builder::basic::document operation_options;
+    if (options.collation()) {
+        operation_options.append(kvp("collation", *options.collation()));
+    }
+    if (options.upsert()) {
+        operation_options.append(kvp("upsert", *options.upsert()));
+    }
+    if (options.array_filters()) {
+        operation_options.append(kvp("arrayFilters", *options.array_filters()));
+    }
+
+    return prepared_update_one{stdx::make_unique<prepared_update_one::impl>(
+        *this, filter.view(), update.view(), operation_options.extract(), bulk_options)};
+}
+
 stdx::optional<result::update> collection::update_one(view_or_value filter,
                                                       view_or_value update,
                                                       const options::update& options) {
-    return _update_one(nullptr, std::move(filter), update, options);
+    return _update_one(nullptr, std::move(filter), std::move(update), options).value();
 }
 
 stdx::optional<result::update> collection::update_one(view_or_value filter,
                                                       const pipeline& update,
                                                       const options::update& options) {
-    return _update_one(
-        nullptr, std::move(filter), bsoncxx::document::view(update.view_array()), options);
+    return _update_one(nullptr,
+                       std::move(filter),
+                       bsoncxx::document::view(update.view_array()),
+                       options)
+        .value();
 }
 
 stdx::optional<result::update> collection::update_one(view_or_value filter,
                                                       std::initializer_list<_empty_doc_tag>,
                                                       const options::update& options) {
-    return _update_one(nullptr, std::move(filter), bsoncxx::document::view{}, options);
+    return _update_one(nullptr, std::move(filter), bsoncxx::document::view{}, options).value();
 }
 
 stdx::optional<result::update> collection::update_one(const client_session& session,
                                                       view_or_value filter,
                                                       view_or_value update,
                                                       const options::update& options) {
-    return _update_one(&session, std::move(filter), update, options);
+    return _update_one(&session, std::move(filter), std::move(update), options).value();
 }
 
 stdx::optional<result::update> collection::update_one(const client_session& session,
                                                       view_or_value filter,
                                                       const pipeline& update,
                                                       const options::update& options) {
-    return _update_one(
-        &session, std::move(filter), bsoncxx::document::view(update.view_array()), options);
+    return _update_one(&session,
+                       std::move(filter),
+                       bsoncxx::document::view(update.view_array()),
+                       options)
+        .value();
 }
 
 stdx::optional<result::update> collection::update_one(const client_session& session,
                                                       view_or_value filter,
                                                       std::initializer_list<_empty_doc_tag>,
                                                       const options::update& options) {
-    return _update_one(&session, std::move(filter), bsoncxx::document::view{}, options);
+    return _update_one(&session, std::move(filter), bsoncxx::document::view{}, options).value();
+}
+
+write_outcome<result::update> collection::try_update_one(view_or_value filter,
+                                                          view_or_value update,
+                                                          const options::update& options) {
+    return _update_one(nullptr, std::move(filter), std::move(update), options);
+}
+
+write_outcome<result::update> collection::try_update_one(const client_session& session,
+                                                          view_or_value filter,
+                                                          view_or_value update,
+                                                          const options::update& options) {
+    return _update_one(&session, std::move(filter), std::move(update), options);
 }
 
 stdx::optional<result::delete_result> collection::_delete_many(
@@ -768,7 +1303,7 @@ stdx::optional<result::delete_result> collection::_delete_many(
 
     auto bulk_op = session ? create_bulk_write(*session, bulk_opts) : create_bulk_write(bulk_opts);
 
-    model::delete_many delete_op(filter);
+    model::delete_many delete_op(std::move(filter));
     if (options.collation()) {
         delete_op.collation(*options.collation());
     }
@@ -802,7 +1337,7 @@ stdx::optional<result::delete_result> collection::_delete_one(
 
     auto bulk_op = session ? create_bulk_write(*session, bulk_opts) : create_bulk_write(bulk_opts);
 
-    model::delete_one delete_op(filter);
+    model::delete_one delete_op(std::move(filter));
     if (options.collation()) {
         delete_op.collation(*options.collation());
     }
@@ -841,7 +1376,8 @@ stdx::optional<bsoncxx::document::value> collection::_find_one_and_replace(
     }
 
     return find_and_modify(_get_impl().collection_t,
-                           session ? session->_get_impl().get_session_t() : nullptr,
+                           session ? session->_get_impl().to_document()
+                                   : stdx::optional<bsoncxx::document::view>{},
                            filter,
                            &replacement,
                            flags,
@@ -853,7 +1389,7 @@ stdx::optional<bsoncxx::document::value> collection::_find_one_and_replace(
 
 stdx::optional<bsoncxx::document::value> collection::find_one_and_replace(
     view_or_value filter, view_or_value replacement, const options::find_one_and_replace& options) {
-    return _find_one_and_replace(nullptr, std::move(filter), replacement, options);
+    return _find_one_and_replace(nullptr, std::move(filter), std::move(replacement), options);
 }
 
 stdx::optional<bsoncxx::document::value> collection::find_one_and_replace(
@@ -861,7 +1397,7 @@ stdx::optional<bsoncxx::document::value> collection::find_one_and_replace(
     view_or_value filter,
     view_or_value replacement,
     const options::find_one_and_replace& options) {
-    return _find_one_and_replace(&session, std::move(filter), replacement, options);
+    return _find_one_and_replace(&session, std::move(filter), std::move(replacement), options);
 }
 
 stdx::optional<bsoncxx::document::value> collection::_find_one_and_update(
@@ -879,7 +1415,8 @@ stdx::optional<bsoncxx::document::value> collection::_find_one_and_update(
     }
 
     return find_and_modify(_get_impl().collection_t,
-                           session ? session->_get_impl().get_session_t() : nullptr,
+                           session ? session->_get_impl().to_document()
+                                   : stdx::optional<bsoncxx::document::view>{},
                            filter,
                            &update,
                            flags,
@@ -889,9 +1426,218 @@ stdx::optional<bsoncxx::document::value> collection::_find_one_and_update(
                            options);
 }
 
+stdx::optional<bsoncxx::document::value> collection::_find_one_and_update_prepared(
+    const client_session* session,
+    prepared_find_one_and_update::impl* prepared,
+    bsoncxx::document::view filter,
+    bsoncxx::document::view update) {
+    auto opts = prepared->opts_for(session ? session->_get_impl().to_document()
+                                           : stdx::optional<bsoncxx::document::view>{});
+
+    // Only the update changes from one execution to the next; libmongoc replaces the previous one.
+    scoped_bson_t update_bson{update};
+    libmongoc::find_and_modify_opts_set_update(opts, update_bson.bson());
+
+    return run_find_and_modify(_get_impl().collection_t, filter, opts);
+}
+
+prepared_find_one_and_update collection::prepare_find_one_and_update(
+    view_or_value filter, view_or_value update, const options::find_one_and_update& options) {
+    prepared_find_one_and_update::impl::command_options command_options;
+
+    command_options.extra =
+        find_and_modify_extra(stdx::nullopt, options.array_filters(), options.hint(), options);
+    if (options.sort()) {
+        command_options.sort = bsoncxx::document::value{options.sort()->view()};
+    }
+    if (options.projection()) {
+        command_options.projection = bsoncxx::document::value{options.projection()->view()};
+    }
+    command_options.max_time = options.max_time();
+
+    if (options.upsert().value_or(false)) {
+        command_options.flags = (mongoc_find_and_modify_flags_t)(command_options.flags |
+                                                                 MONGOC_FIND_AND_MODIFY_UPSERT);
+    }
+    if (options.return_document() == options::return_document::k_after) {
+        command_options.flags = (mongoc_find_and_modify_flags_t)(
+            command_options.flags | MONGOC_FIND_AND_MODIFY_RETURN_NEW);
+    }
+    command_options.bypass_document_validation =
+        options.bypass_document_validation().value_or(false);
+
+    return prepared_find_one_and_update{stdx::make_unique<prepared_find_one_and_update::impl>(
+        *this, filter.view(), update.view(), std::move(command_options))};
+}
+
+std::vector<bsoncxx::document::value> collection::_claim_many(
+    const client_session* session,
+    view_or_value filter,
+    view_or_value update,
+    std::size_t n,
+    const options::find_one_and_update& options) {
+    if (options.upsert().value_or(false)) {
+        throw logic_error{error_code::k_invalid_parameter, "claim_many cannot upsert"};
+    }
+    if (options.write_concern() && !options.write_concern()->is_acknowledged()) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "claim_many requires an acknowledged write concern"};
+    }
+
+    std::vector<bsoncxx::document::value> claimed;
+    if (n == 0) {
+        return claimed;
+    }
+
+    const bool before = options.return_document() != options::return_document::k_after;
+
+    // The reads go to the primary, which the update of the second round-trip has been applied to.
+    options::find read_options;
+    read_options.read_preference(mongocxx::read_preference{});
+    if (options.sort()) {
+        read_options.sort(*options.sort());
+    }
+    if (options.collation()) {
+        read_options.collation(*options.collation());
+    }
+    if (options.max_time()) {
+        read_options.max_time(*options.max_time());
+    }
+
+    const auto id_only = make_document(kvp("_id", 1));
+
+    const auto max_limit = static_cast<std::size_t>(std::numeric_limits<std::int64_t>::max());
+    options::find candidate_options{read_options};
+    candidate_options.limit(static_cast<std::int64_t>(std::min(n, max_limit)));
+    if (options.hint()) {
+        candidate_options.hint(*options.hint());
+    }
+    bsoncxx::builder::basic::document candidate_projection;
+    if (!before) {
+        candidate_options.projection(id_only.view());
+    } else if (options.projection()) {
+        for (auto&& field : options.projection()->view()) {
+            if (field.key() != stdx::string_view{"_id"}) {
+                candidate_projection.append(kvp(field.key(), field.get_value()));
+            }
+        }
+        candidate_projection.append(kvp("_id", 1));
+        candidate_options.projection(candidate_projection.view());
+    }
+
+    std::vector<bsoncxx::document::value> candidates;
+    bsoncxx::builder::basic::array candidate_ids;
+    {
+        auto found = session ? find(*session, filter.view(), candidate_options)
+                             : find(filter.view(), candidate_options);
+        for (auto&& doc : found) {
+            candidate_ids.append(doc["_id"].get_value());
+            candidates.emplace_back(doc);
+        }
+    }
+    if (candidates.empty()) {
+        return claimed;
+    }
+
+    // Documents claimed by another worker since the first round-trip no longer match `filter`, so
+    // the update leaves them alone.
+    const bsoncxx::oid token;
+    bsoncxx::builder::basic::document tagged_update;
+    bool has_set = false;
+    for (auto&& field : update.view()) {
+        if (field.key() == stdx::string_view{"$set"} && field.type() == bsoncxx::type::k_document) {
+            tagged_update.append(kvp("$set", [&](sub_document set) {
+                set.append(concatenate(field.get_document().value));
+                set.append(kvp("_claim", token));
+            }));
+            has_set = true;
+        } else {
+            tagged_update.append(kvp(field.key(), field.get_value()));
+        }
+    }
+    if (!has_set) {
+        tagged_update.append(kvp("$set", make_document(kvp("_claim", token))));
+    }
+
+    options::update update_options;
+    if (options.write_concern()) {
+        update_options.write_concern(*options.write_concern());
+    }
+    if (options.collation()) {
+        update_options.collation(*options.collation());
+    }
+    if (options.array_filters()) {
+        update_options.array_filters(*options.array_filters());
+    }
+    if (options.bypass_document_validation()) {
+        update_options.bypass_document_validation(*options.bypass_document_validation());
+    }
+
+    auto in_candidates =
+        make_document(kvp("_id", make_document(kvp("$in", candidate_ids.extract()))));
+    auto claim_filter = make_document(kvp("$and", make_array(filter.view(), in_candidates.view())));
+    if (session) {
+        update_many(*session, claim_filter.view(), tagged_update.view(), update_options);
+    } else {
+        update_many(claim_filter.view(), tagged_update.view(), update_options);
+    }
+
+    options::find claimed_options{read_options};
+    if (before) {
+        claimed_options.projection(id_only.view());
+    } else if (options.projection()) {
+        claimed_options.projection(*options.projection());
+    }
+
+    auto mine = make_document(kvp("_claim", token));
+    auto found = session ? find(*session, mine.view(), claimed_options)
+                         : find(mine.view(), claimed_options);
+    if (!before) {
+        for (auto&& doc : found) {
+            claimed.emplace_back(doc);
+        }
+        return claimed;
+    }
+
+    // Keep the documents read by the first round-trip that this call claimed, keyed by the bytes
+    // of their _id.
+    auto id_key = [](bsoncxx::document::view doc) {
+        auto id_doc = make_document(kvp("_id", doc["_id"].get_value()));
+        return std::string{reinterpret_cast<const char*>(id_doc.view().data()),
+                           id_doc.view().length()};
+    };
+    std::unordered_set<std::string> claimed_ids;
+    for (auto&& doc : found) {
+        claimed_ids.insert(id_key(doc));
+    }
+    for (auto&& candidate : candidates) {
+        if (claimed_ids.count(id_key(candidate.view()))) {
+            claimed.push_back(std::move(candidate));
+        }
+    }
+    return claimed;
+}
+
+std::vector<bsoncxx::document::value> collection::claim_many(
+    view_or_value filter,
+    view_or_value update,
+    std::size_t n,
+    const options::find_one_and_update& options) {
+    return _claim_many(nullptr, std::move(filter), std::move(update), n, options);
+}
+
+std::vector<bsoncxx::document::value> collection::claim_many(
+    const client_session& session,
+    view_or_value filter,
+    view_or_value update,
+    std::size_t n,
+    const options::find_one_and_update& options) {
+    return _claim_many(&session, std::move(filter), std::move(update), n, options);
+}
+
 stdx::optional<bsoncxx::document::value> collection::find_one_and_update(
     view_or_value filter, view_or_value update, const options::find_one_and_update& options) {
-    return _find_one_and_update(nullptr, std::move(filter), update, options);
+    return _find_one_and_update(nullptr, std::move(filter), std::move(update), options);
 }
 
 stdx::optional<bsoncxx::document::value> collection::find_one_and_update(
@@ -912,7 +1658,7 @@ stdx::optional<bsoncxx::document::value> collection::find_one_and_update(
     view_or_value filter,
     view_or_value update,
     const options::find_one_and_update& options) {
-    return _find_one_and_update(&session, std::move(filter), update, options);
+    return _find_one_and_update(&session, std::move(filter), std::move(update), options);
 }
 
 stdx::optional<bsoncxx::document::value> collection::find_one_and_update(
@@ -937,7 +1683,8 @@ stdx::optional<bsoncxx::document::value> collection::_find_one_and_delete(
     view_or_value filter,
     const options::find_one_and_delete& options) {
     return find_and_modify(_get_impl().collection_t,
-                           session ? session->_get_impl().get_session_t() : nullptr,
+                           session ? session->_get_impl().to_document()
+                                   : stdx::optional<bsoncxx::document::view>{},
                            filter,
                            nullptr,
                            MONGOC_FIND_AND_MODIFY_REMOVE,
@@ -959,9 +1706,88 @@ stdx::optional<bsoncxx::document::value> collection::find_one_and_delete(
     return _find_one_and_delete(&session, std::move(filter), options);
 }
 
+namespace {
+
+// The key of a count in the count cache: the namespace, the filter and every option that changes
+// the result, as the bytes of one document.
+std::string count_cache_key(const std::string& ns,
+                            bsoncxx::document::view filter,
+                            const options::count& options,
+                            const class read_preference& rp) {
+    bsoncxx::builder::basic::document key;
+    key.append(kvp("ns", ns), kvp("filter", filter));
+
+    if (options.collation()) {
+        key.append(kvp("collation", *options.collation()));
+    }
+    if (options.hint()) {
+        key.append(kvp("hint", options.hint()->to_value()));
+    }
+    if (options.skip()) {
+        key.append(kvp("skip", *options.skip()));
+    }
+    if (options.limit()) {
+        key.append(kvp("limit", *options.limit()));
+    }
+    if (options.allow_estimate().value_or(false)) {
+        key.append(kvp("estimate", true));
+    }
+
+    key.append(kvp("mode", static_cast<std::int32_t>(rp.mode())));
+    if (auto tags = rp.tags()) {
+        key.append(kvp("tags", *tags));
+    }
+    if (auto max_staleness = rp.max_staleness()) {
+        key.append(kvp("maxStaleness", static_cast<std::int64_t>(max_staleness->count())));
+    }
+
+    auto view = key.view();
+    return std::string{reinterpret_cast<const char*>(view.data()), view.length()};
+}
+
+}  // namespace
+
 std::int64_t collection::_count_documents(const client_session* session,
                                           view_or_value filter,
                                           const options::count& options) {
+    std::string cache_key;
+    if (options.cache_ttl() && !session) {
+        cache_key = count_cache_key(_get_impl().database_name + "." + std::string{name()},
+                                    filter.view(),
+                                    options,
+                                    options.read_preference() ? *options.read_preference()
+                                                              : read_preference());
+        auto cached = _get_impl().client_impl->counts->find(cache_key);
+        if (cached) {
+            return *cached;
+        }
+    }
+
+    auto result = _count_documents_uncached(session, filter.view(), options);
+
+    if (!cache_key.empty()) {
+        _get_impl().client_impl->counts->insert(
+            std::move(cache_key), result, *options.cache_ttl());
+    }
+    return result;
+}
+
+std::int64_t collection::_count_documents_uncached(const client_session* session,
+                                                   bsoncxx::document::view filter,
+                                                   const options::count& options) {
+    // A count of the whole collection can come from its metadata, without a scan.
+    if (options.allow_estimate().value_or(false) && filter.empty() && !session &&
+        !options.skip() && !options.limit() && !options.hint() && !options.collation()) {
+        options::estimated_document_count estimate_options;
+        if (options.max_time()) {
+            estimate_options.max_time(*options.max_time());
+        }
+        if (options.read_preference()) {
+            estimate_options.read_preference(*options.read_preference());
+        }
+        return estimated_document_count(estimate_options);
+    }
+
     scoped_bson_t bson_filter{filter};
     scoped_bson_t reply;
     bson_error_t error;
@@ -1052,8 +1878,13 @@ bsoncxx::document::value collection::_create_index(const client_session* session
                                                    options::index_view operation_options) {
     using namespace bsoncxx;
 
-    auto name = session ? indexes().create_one(*session, keys, index_opts, operation_options)
-                        : indexes().create_one(keys, index_opts, operation_options);
+    stdx::optional<std::string> name;
+    if (session) {
+        name = indexes().create_one(
+            *session, std::move(keys), std::move(index_opts), operation_options);
+    } else {
+        name = indexes().create_one(std::move(keys), std::move(index_opts), operation_options);
+    }
 
     if (name) {
         return make_document(kvp("name", *name));
@@ -1065,20 +1896,20 @@ bsoncxx::document::value collection::_create_index(const client_session* session
 bsoncxx::document::value collection::create_index(bsoncxx::document::view_or_value keys,
                                                   bsoncxx::document::view_or_value index_opts,
                                                   options::index_view operation_options) {
-    return _create_index(nullptr, keys, index_opts, operation_options);
+    return _create_index(nullptr, std::move(keys), std::move(index_opts), operation_options);
 }
 
 bsoncxx::document::value collection::create_index(const client_session& session,
                                                   bsoncxx::document::view_or_value keys,
                                                   bsoncxx::document::view_or_value index_opts,
                                                   options::index_view operation_options) {
-    return _create_index(&session, keys, index_opts, operation_options);
+    return _create_index(&session, std::move(keys), std::move(index_opts), operation_options);
 }
 
-cursor collection::_distinct(const client_session* session,
-                             bsoncxx::string::view_or_value field_name,
-                             view_or_value query,
-                             const options::distinct& options) {
+bsoncxx::document::value collection::_distinct_reply(const client_session* session,
+                                                    bsoncxx::string::view_or_value field_name,
+                                                    view_or_value query,
+                                                    const options::distinct& options) {
     //
     // Construct the distinct command and options.
     //
@@ -1125,9 +1956,19 @@ cursor collection::_distinct(const client_session* session,
         throw_exception<operation_exception>(reply.steal(), error);
     }
 
+    return reply.steal();
+}
+
+cursor collection::_distinct(const client_session* session,
+                             bsoncxx::string::view_or_value field_name,
+                             view_or_value query,
+                             const options::distinct& options) {
+    auto reply = _distinct_reply(session, std::move(field_name), std::move(query), options);
+
     //
     // Fake a cursor with the reply document as a single result.
     //
+    bson_error_t error;
     auto fake_db_reply = make_document(
         kvp("ok", 1), kvp("cursor", [&reply](sub_document sub_doc) {
             sub_doc.append(
@@ -1154,14 +1995,204 @@ cursor collection::_distinct(const client_session* session,
 cursor collection::distinct(bsoncxx::string::view_or_value field_name,
                             view_or_value query,
                             const options::distinct& options) {
-    return _distinct(nullptr, field_name, query, options);
+    return _distinct(nullptr, std::move(field_name), std::move(query), options);
 }
 
 cursor collection::distinct(const client_session& session,
                             bsoncxx::string::view_or_value field_name,
                             view_or_value query,
                             const options::distinct& options) {
-    return _distinct(&session, field_name, query, options);
+    return _distinct(&session, std::move(field_name), std::move(query), options);
+}
+
+result::distinct collection::distinct_values(bsoncxx::string::view_or_value field_name,
+                                             view_or_value query,
+                                             const options::distinct& options) {
+    return result::distinct{
+        _distinct_reply(nullptr, std::move(field_name), std::move(query), options)};
+}
+
+result::distinct collection::distinct_values(const client_session& session,
+                                             bsoncxx::string::view_or_value field_name,
+                                             view_or_value query,
+                                             const options::distinct& options) {
+    return result::distinct{
+        _distinct_reply(&session, std::move(field_name), std::move(query), options)};
+}
+
+namespace {
+
+const char* explain_verbosity_name(explain_verbosity verbosity) {
+    switch (verbosity) {
+        case explain_verbosity::k_query_planner:
+            return "queryPlanner";
+        case explain_verbosity::k_execution_stats:
+            return "executionStats";
+        case explain_verbosity::k_all_plans_execution:
+            return "allPlansExecution";
+    }
+    throw logic_error{error_code::k_invalid_parameter, "unknown explain verbosity"};
+}
+
+}  // namespace
+
+result::explain collection::_explain(const client_session* session,
+                                     bsoncxx::document::view command,
+                                     const stdx::optional<class read_preference>& rp,
+                                     explain_verbosity verbosity) {
+    bsoncxx::builder::basic::document command_builder;
+    command_builder.append(kvp("explain", command),
+                           kvp("verbosity", explain_verbosity_name(verbosity)));
+
+    bsoncxx::builder::basic::document opts_builder{};
+    if (session) {
+        opts_builder.append(bsoncxx::builder::concatenate_doc{session->_get_impl().to_document()});
+    }
+
+    const mongoc_read_prefs_t* rp_ptr = NULL;
+    if (rp) {
+        rp_ptr = rp->_impl->read_preference_t;
+    }
+
+    scoped_bson_t reply;
+    bson_error_t error;
+    scoped_bson_t command_bson{command_builder.extract()};
+    scoped_bson_t opts_bson{opts_builder.extract()};
+
+    auto result = libmongoc::collection_read_command_with_opts(_get_impl().collection_t,
+                                                               command_bson.bson(),
+                                                               rp_ptr,
+                                                               opts_bson.bson(),
+                                                               reply.bson_for_init(),
+                                                               &error);
+
+    if (!result) {
+        throw_exception<operation_exception>(reply.steal(), error);
+    }
+
+    return result::explain{reply.steal()};
+}
+
+result::explain collection::_explain_find(const client_session* session,
+                                          view_or_value filter,
+                                          const options::find& options,
+                                          explain_verbosity verbosity) {
+    bsoncxx::builder::basic::document command;
+    command.append(kvp("find", name()), kvp("filter", bsoncxx::types::b_document{filter}));
+
+    // The find options are also the fields of the find command, except exhaust, which is a flag
+    // of the wire protocol instead.
+    auto find_options = build_find_options_document(options);
+    for (auto&& option : find_options.view()) {
+        if (option.key() != stdx::string_view{"exhaust"}) {
+            command.append(kvp(option.key(), option.get_value()));
+        }
+    }
+
+    return _explain(session, command.view(), options.read_preference(), verbosity);
+}
+
+result::explain collection::_explain_aggregate(const client_session* session,
+                                               const pipeline& pipeline,
+                                               const options::aggregate& options,
+                                               explain_verbosity verbosity) {
+    bsoncxx::builder::basic::document command;
+    command.append(kvp("aggregate", name()), kvp("pipeline", pipeline._impl->view_array()));
+
+    bsoncxx::builder::basic::document cursor_options;
+    if (options.batch_size()) {
+        cursor_options.append(kvp("batchSize", *options.batch_size()));
+    }
+    command.append(kvp("cursor", cursor_options.extract()));
+
+    if (options.allow_disk_use()) {
+        command.append(kvp("allowDiskUse", *options.allow_disk_use()));
+    }
+
+    if (options.collation()) {
+        command.append(kvp("collation", *options.collation()));
+    }
+
+    if (options.hint()) {
+        command.append(kvp("hint", options.hint()->to_value()));
+    }
+
+    if (options.max_time()) {
+        command.append(kvp("maxTimeMS", bsoncxx::types::b_int64{options.max_time()->count()}));
+    }
+
+    return _explain(session, command.view(), options.read_preference(), verbosity);
+}
+
+result::explain collection::_explain_update(const client_session* session,
+                                            view_or_value filter,
+                                            view_or_value update,
+                                            const options::update& options,
+                                            explain_verbosity verbosity) {
+    bsoncxx::builder::basic::document statement;
+    statement.append(kvp("q", bsoncxx::types::b_document{filter}),
+                     kvp("u", bsoncxx::types::b_document{update}),
+                     kvp("multi", true));
+
+    if (options.upsert()) {
+        statement.append(kvp("upsert", *options.upsert()));
+    }
+
+    if (options.collation()) {
+        statement.append(kvp("collation", *options.collation()));
+    }
+
+    if (options.array_filters()) {
+        statement.append(kvp("arrayFilters", *options.array_filters()));
+    }
+
+    bsoncxx::builder::basic::document command;
+    command.append(kvp("update", name()),
+                   kvp("updates", make_array(statement.extract())));
+
+    // Explaining a write reads the plan from the primary, as the write itself would.
+    return _explain(session, command.view(), stdx::nullopt, verbosity);
+}
+
+result::explain collection::explain_find(view_or_value filter,
+                                         const options::find& options,
+                                         explain_verbosity verbosity) {
+    return _explain_find(nullptr, std::move(filter), options, verbosity);
+}
+
+result::explain collection::explain_find(const client_session& session,
+                                         view_or_value filter,
+                                         const options::find& options,
+                                         explain_verbosity verbosity) {
+    return _explain_find(&session, std::move(filter), options, verbosity);
+}
+
+result::explain collection::explain_aggregate(const pipeline& pipeline,
+                                              const options::aggregate& options,
+                                              explain_verbosity verbosity) {
+    return _explain_aggregate(nullptr, pipeline, options, verbosity);
+}
+
+result::explain collection::explain_aggregate(const client_session& session,
+                                              const pipeline& pipeline,
+                                              const options::aggregate& options,
+                                              explain_verbosity verbosity) {
+    return _explain_aggregate(&session, pipeline, options, verbosity);
+}
+
+result::explain collection::explain_update(view_or_value filter,
+                                           view_or_value update,
+                                           const options::update& options,
+                                           explain_verbosity verbosity) {
+    return _explain_update(nullptr, std::move(filter), std::move(update), options, verbosity);
+}
+
+result::explain collection::explain_update(const client_session& session,
+                                           view_or_value filter,
+                                           view_or_value update,
+                                           const options::update& options,
+                                           explain_verbosity verbosity) {
+    return _explain_update(&session, std::move(filter), std::move(update), options, verbosity);
 }
 
 cursor collection::list_indexes() const {
@@ -1213,6 +2244,7 @@ void collection::drop(const client_session& session,
 }
 
 void collection::read_concern(class read_concern rc) {
+    _get_impl().detach();
     libmongoc::collection_set_read_concern(_get_impl().collection_t, rc._impl->read_concern_t);
 }
 
@@ -1222,6 +2254,7 @@ class read_concern collection::read_concern() const {
 }
 
 void collection::read_preference(class read_preference rp) {
+    _get_impl().detach();
     libmongoc::collection_set_read_prefs(_get_impl().collection_t, rp._impl->read_preference_t);
 }
 
@@ -1232,6 +2265,7 @@ class read_preference collection::read_preference() const {
 }
 
 void collection::write_concern(class write_concern wc) {
+    _get_impl().detach();
     libmongoc::collection_set_write_concern(_get_impl().collection_t, wc._impl->write_concern_t);
 }
 
@@ -1277,12 +2311,20 @@ class change_stream collection::_watch(const client_session* session,
     scoped_bson_t options_bson{options_builder.extract()};
 
     // NOTE: collection_watch copies what it needs so we're safe to destroy our copies.
-    return change_stream{libmongoc::collection_watch(
+    class change_stream stream{libmongoc::collection_watch(
         _get_impl().collection_t, pipeline_bson.bson(), options_bson.bson())};
+    if (options.prefetch_batches()) {
+        stream._impl->start_prefetch(*options.prefetch_batches(),
+                                     options.batch_size(),
+                                     options.max_prefetched_bytes(),
+                                     _get_impl().client_impl->replies);
+    }
+
+    return stream;
 }
 
 class index_view collection::indexes() {
-    return index_view{_get_impl().collection_t};
+    return index_view{_get_impl().shared()};
 }
 
 class bulk_write collection::_init_insert_many(const options::insert& options,
@@ -1295,6 +2337,9 @@ class bulk_write collection::_init_insert_many(const options::insert& options,
     if (options.bypass_document_validation()) {
         bulk_write_options.bypass_document_validation(*options.bypass_document_validation());
     }
+    if (auto pool = options.shard_partitioning_pool()) {
+        bulk_write_options.shard_partitioning(*pool);
+    }
     if (session) {
         return create_bulk_write(*session, bulk_write_options);
     }
@@ -1302,21 +2347,51 @@ class bulk_write collection::_init_insert_many(const options::insert& options,
     return create_bulk_write(bulk_write_options);
 }
 
+bool collection::_skips_inserted_ids(const options::insert& options) const {
+    return options.skip_inserted_ids().value_or(false) ||
+           !insert_is_acknowledged(options, _get_impl().collection_t);
+}
+
 void collection::_insert_many_doc_handler(class bulk_write& writes,
-                                          bsoncxx::builder::basic::array& inserted_ids,
-                                          bsoncxx::document::view doc) const {
-    bsoncxx::builder::basic::document id_doc;
-
-    if (!doc["_id"]) {
-        id_doc.append(kvp("_id", bsoncxx::oid{}));
-        writes.append(
-            model::insert_one{make_document(concatenate(id_doc.view()), concatenate(doc))});
-    } else {
-        id_doc.append(kvp("_id", doc["_id"].get_value()));
+                                          bsoncxx::builder::basic::array* inserted_ids,
+                                          bsoncxx::builder::basic::document& scratch,
+                                          bsoncxx::document::view doc,
+                                          std::int64_t input_position) const {
+    if (!inserted_ids) {
+        // The caller does not want the _ids, so let libmongoc generate any missing ones while it
+        // copies the document into the bulk operation.
         writes.append(model::insert_one{doc});
+        return;
     }
 
-    inserted_ids.append(id_doc.view());
+    // The bulk operation copies each document into its own buffer when it is appended, so a
+    // document that needs a generated _id is assembled in `scratch`, whose buffer is reused for
+    // every document of the batch, and _ids are written straight into `inserted_ids`.
+    auto id = doc["_id"];
+
+    if (!id) {
+        const bsoncxx::oid oid{};
+
+        scratch.clear();
+        scratch.append(kvp("_id", oid), concatenate(doc));
+        writes.append(model::insert_one{scratch.view()});
+
+        inserted_ids->append([&](sub_document id_doc) {
+            id_doc.append(kvp("_id", oid));
+            if (input_position >= 0) {
+                id_doc.append(kvp("index", input_position));
+            }
+        });
+    } else {
+        writes.append(model::insert_one{doc});
+
+        inserted_ids->append([&](sub_document id_doc) {
+            id_doc.append(kvp("_id", id.get_value()));
+            if (input_position >= 0) {
+                id_doc.append(kvp("index", input_position));
+            }
+        });
+    }
 }
 
 stdx::optional<result::insert_many> collection::_exec_insert_many(
@@ -1329,6 +2404,112 @@ stdx::optional<result::insert_many> collection::_exec_insert_many(
     return result::insert_many{std::move(result.value()), inserted_ids.extract()};
 }
 
+stdx::optional<result::insert_many> collection::_exec_insert_stream(
+    const client_session* session,
+    const insert_stream_source& source,
+    const options::insert& options,
+    std::size_t max_batch_bytes) {
+    if (max_batch_bytes == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "max_batch_bytes must be positive"};
+    }
+
+    bsoncxx::builder::basic::array inserted_ids;
+    bsoncxx::builder::basic::document scratch;
+    auto ids = _skips_inserted_ids(options) ? nullptr : &inserted_ids;
+
+    // One table of the documents seen serves every batch, so duplicates are found across them.
+    // Results number the input rather than the documents sent, so once duplicates are dropped,
+    // the input position of each document sent is kept for the write errors and the _ids.
+    std::unique_ptr<document_deduplicator> dedupe;
+    std::vector<std::size_t> input_positions;
+    if (options.dedupe_by()) {
+        dedupe = stdx::make_unique<document_deduplicator>(*options.dedupe_by());
+    }
+    std::size_t input_position = 0;
+
+    std::int32_t inserted_count = 0;
+    std::size_t sent_documents = 0;
+    std::size_t batches = 0;
+    operation_stats stats;
+    bool acknowledged = true;
+    stdx::optional<result::bulk_write> last_result;
+
+    // Sends a batch that began at document `offset` and totals its result. A failure is reported
+    // as if the batches sent so far had been one bulk write.
+    auto send = [&](std::size_t offset, class bulk_write& batch) {
+        try {
+            last_result = batch.execute();
+        } catch (bulk_write_exception& e) {
+            rebase_batch_error(e, offset, inserted_count, dedupe ? &input_positions : nullptr);
+            throw;
+        }
+        ++batches;
+        if (!last_result) {
+            acknowledged = false;
+            return;
+        }
+        inserted_count += last_result->inserted_count();
+        add_operation_stats(&stats, last_result->stats());
+    };
+
+    // Each batch is built and sent on the calling thread: the client, and the session if one was
+    // given, must not be used from two threads at once. Sending a batch before building the next
+    // one keeps ordered inserts in order and buffers one batch at a time.
+    for (bool exhausted = false; !exhausted;) {
+        auto writes = _init_insert_many(options, session);
+        std::size_t batch_bytes = 0;
+        std::size_t batch_documents = 0;
+        while (batch_bytes < max_batch_bytes) {
+            bool kept = true;
+            if (!source([&](bsoncxx::document::view doc) {
+                    const auto position = input_position++;
+                    if (!dedupe) {
+                        _insert_many_doc_handler(writes, ids, scratch, doc);
+                    } else if (dedupe->keep(doc)) {
+                        input_positions.push_back(position);
+                        _insert_many_doc_handler(
+                            writes, ids, scratch, doc, static_cast<std::int64_t>(position));
+                    } else {
+                        kept = false;
+                        return;
+                    }
+                    batch_bytes += doc.length();
+                })) {
+                exhausted = true;
+                break;
+            }
+            if (kept) {
+                ++batch_documents;
+            }
+        }
+
+        if (batch_documents == 0) {
+            break;
+        }
+
+        const std::size_t offset = sent_documents;
+        sent_documents += batch_documents;
+        send(offset, writes);
+    }
+
+    if (!acknowledged) {
+        return stdx::nullopt;
+    }
+
+    // A single batch keeps the server's reply as it is.
+    if (batches == 1) {
+        return result::insert_many{std::move(last_result.value()), inserted_ids.extract()};
+    }
+
+    result::bulk_write total{make_document(kvp("nInserted", inserted_count),
+                                           kvp("nMatched", 0),
+                                           kvp("nModified", 0),
+                                           kvp("nRemoved", 0),
+                                           kvp("nUpserted", 0)),
+                             stats};
+    return result::insert_many{std::move(total), inserted_ids.extract()};
+}
+
 const collection::impl& collection::_get_impl() const {
     if (!_impl) {
         throw logic_error{error_code::k_invalid_collection_object};
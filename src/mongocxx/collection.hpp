@@ -15,9 +15,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
@@ -27,11 +32,14 @@
 #include <bsoncxx/oid.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <bsoncxx/string/view_or_value.hpp>
+#include <bsoncxx/types/value.hpp>
 #include <mongocxx/bulk_write.hpp>
 #include <mongocxx/change_stream.hpp>
 #include <mongocxx/client_session.hpp>
 #include <mongocxx/cursor.hpp>
+#include <mongocxx/explain_verbosity.hpp>
 #include <mongocxx/index_view.hpp>
+#include <mongocxx/merged_cursor.hpp>
 #include <mongocxx/model/insert_one.hpp>
 #include <mongocxx/options/aggregate.hpp>
 #include <mongocxx/options/bulk_write.hpp>
@@ -50,15 +58,21 @@
 #include <mongocxx/options/replace.hpp>
 #include <mongocxx/options/update.hpp>
 #include <mongocxx/pipeline.hpp>
+#include <mongocxx/prepared_find.hpp>
+#include <mongocxx/prepared_find_one_and_update.hpp>
+#include <mongocxx/prepared_update_one.hpp>
 #include <mongocxx/read_concern.hpp>
 #include <mongocxx/read_preference.hpp>
 #include <mongocxx/result/bulk_write.hpp>
 #include <mongocxx/result/delete.hpp>
+#include <mongocxx/result/distinct.hpp>
+#include <mongocxx/result/explain.hpp>
 #include <mongocxx/result/insert_many.hpp>
 #include <mongocxx/result/insert_one.hpp>
 #include <mongocxx/result/replace_one.hpp>
 #include <mongocxx/result/update.hpp>
 #include <mongocxx/write_concern.hpp>
+#include <mongocxx/write_outcome.hpp>
 
 #include <mongocxx/config/prelude.hpp>
 
@@ -67,6 +81,7 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 class client;
 class database;
+class pool;
 
 ///
 /// Class representing server side document groupings within a MongoDB database.
@@ -100,6 +115,17 @@ class MONGOCXX_API collection {
     };
 
    public:
+    ///
+    /// The default number of document bytes after which insert_stream() sends a batch.
+    ///
+    static constexpr std::size_t k_default_insert_stream_batch_bytes = 16 * 1024 * 1024;
+
+    ///
+    /// The number of document bytes after which an ordered insert_many() sends a batch: the
+    /// server's maximum message size, at which libmongoc would split the bulk write anyway.
+    ///
+    static constexpr std::size_t k_insert_many_batch_bytes = 48 * 1000 * 1000;
+
     ///
     /// Default constructs a collection object. The collection is
     /// equivalent to the state of a moved from collection. The only
@@ -401,11 +427,68 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Sends a container of writes to the server as a bulk write operation like bulk_write, but
+    /// returns the error of a failed write instead of throwing it.
+    ///
+    /// @tparam container_type
+    ///   The container type. Must meet the requirements for the container concept with a value
+    ///   type of model::write.
+    ///
+    /// @param writes
+    ///   A container of model::write.
+    /// @param options
+    ///   Optional arguments, see options::bulk_write.
+    ///
+    /// @return Either the optional result bulk_write would have returned, or the error it would
+    ///   have thrown.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    template <typename container_type>
+    MONGOCXX_INLINE write_outcome<result::bulk_write> try_bulk_write(
+        const container_type& writes, const options::bulk_write& options = options::bulk_write());
+
+    ///
+    /// Sends a container of writes to the server as a bulk write operation like bulk_write, but
+    /// returns the error of a failed write instead of throwing it.
+    ///
+    /// @tparam container_type
+    ///   The container type. Must meet the requirements for the container concept with a value
+    ///   type of model::write.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the bulk operation.
+    /// @param writes
+    ///   A container of model::write.
+    /// @param options
+    ///   Optional arguments, see options::bulk_write.
+    ///
+    /// @return Either the optional result bulk_write would have returned, or the error it would
+    ///   have thrown.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    template <typename container_type>
+    MONGOCXX_INLINE write_outcome<result::bulk_write> try_bulk_write(
+        const client_session& session,
+        const container_type& writes,
+        const options::bulk_write& options = options::bulk_write());
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
     /// Counts the number of documents matching the provided filter.
     ///
+    /// With options::count::allow_estimate, a count with an empty filter is answered from the
+    /// collection's metadata. With options::count::cache_ttl, a recent result of the same count is
+    /// returned without running a command.
+    ///
     /// @param filter
     ///   The filter that documents must match in order to be counted.
     /// @param options
@@ -661,6 +744,213 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Finds the distinct values for a specified field across the collection, returning them as
+    /// an array view into the server's reply.
+    ///
+    /// Unlike distinct(), which copies the reply into a document for a mongocxx::cursor to iterate
+    /// over, this keeps the one copy libmongoc received, halving the memory needed for fields with
+    /// many distinct values.
+    ///
+    /// @param name
+    ///   The field for which the distinct values will be found.
+    /// @param filter
+    ///   Document view representing the documents for which the distinct operation will apply.
+    /// @param options
+    ///   Optional arguments, see options::distinct.
+    ///
+    /// @return The reply of the distinct command and a view of its values.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/distinct/
+    ///
+    result::distinct distinct_values(bsoncxx::string::view_or_value name,
+                                     bsoncxx::document::view_or_value filter,
+                                     const options::distinct& options = options::distinct());
+
+    ///
+    /// Finds the distinct values for a specified field across the collection, returning them as
+    /// an array view into the server's reply.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the operation.
+    /// @param name
+    ///   The field for which the distinct values will be found.
+    /// @param filter
+    ///   Document view representing the documents for which the distinct operation will apply.
+    /// @param options
+    ///   Optional arguments, see options::distinct.
+    ///
+    /// @return The reply of the distinct command and a view of its values.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/distinct/
+    ///
+    result::distinct distinct_values(const client_session& session,
+                                     bsoncxx::string::view_or_value name,
+                                     bsoncxx::document::view_or_value filter,
+                                     const options::distinct& options = options::distinct());
+
+    ///
+    /// @}
+    ///
+
+    ///
+    /// @{
+    ///
+    /// Explains how the server would run a find, and summarizes the winning plan.
+    ///
+    /// @param filter
+    ///   Document view representing a document that should match the query.
+    /// @param options
+    ///   Optional arguments, see options::find.
+    /// @param verbosity
+    ///   How much the server reports. Execution statistics require at least
+    ///   explain_verbosity::k_execution_stats, which runs the query.
+    ///
+    /// @return The reply of the explain command and a summary of the plan.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/explain/
+    ///
+    result::explain explain_find(
+        bsoncxx::document::view_or_value filter,
+        const options::find& options = options::find(),
+        explain_verbosity verbosity = explain_verbosity::k_query_planner);
+
+    ///
+    /// Explains how the server would run a find, and summarizes the winning plan.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the operation.
+    /// @param filter
+    ///   Document view representing a document that should match the query.
+    /// @param options
+    ///   Optional arguments, see options::find.
+    /// @param verbosity
+    ///   How much the server reports.
+    ///
+    /// @return The reply of the explain command and a summary of the plan.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/explain/
+    ///
+    result::explain explain_find(
+        const client_session& session,
+        bsoncxx::document::view_or_value filter,
+        const options::find& options = options::find(),
+        explain_verbosity verbosity = explain_verbosity::k_query_planner);
+
+    ///
+    /// Explains how the server would run an aggregation, and summarizes the plan of its first
+    /// stage.
+    ///
+    /// @param pipeline
+    ///   The pipeline of aggregation operations.
+    /// @param options
+    ///   Optional arguments, see options::aggregate.
+    /// @param verbosity
+    ///   How much the server reports. Execution statistics require at least
+    ///   explain_verbosity::k_execution_stats, which runs the aggregation.
+    ///
+    /// @return The reply of the explain command and a summary of the plan.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/explain/
+    ///
+    result::explain explain_aggregate(
+        const pipeline& pipeline,
+        const options::aggregate& options = options::aggregate(),
+        explain_verbosity verbosity = explain_verbosity::k_query_planner);
+
+    ///
+    /// Explains how the server would run an aggregation, and summarizes the plan of its first
+    /// stage.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the operation.
+    /// @param pipeline
+    ///   The pipeline of aggregation operations.
+    /// @param options
+    ///   Optional arguments, see options::aggregate.
+    /// @param verbosity
+    ///   How much the server reports.
+    ///
+    /// @return The reply of the explain command and a summary of the plan.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/explain/
+    ///
+    result::explain explain_aggregate(
+        const client_session& session,
+        const pipeline& pipeline,
+        const options::aggregate& options = options::aggregate(),
+        explain_verbosity verbosity = explain_verbosity::k_query_planner);
+
+    ///
+    /// Explains how the server would run update_many(), and summarizes the winning plan. The
+    /// explain does not modify any document, even with explain_verbosity::k_execution_stats.
+    ///
+    /// @param filter
+    ///   Document view representing the documents to be updated.
+    /// @param update
+    ///   Document view representing the update to apply.
+    /// @param options
+    ///   Optional arguments, see options::update.
+    /// @param verbosity
+    ///   How much the server reports.
+    ///
+    /// @return The reply of the explain command and a summary of the plan.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/explain/
+    ///
+    result::explain explain_update(
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        const options::update& options = options::update(),
+        explain_verbosity verbosity = explain_verbosity::k_query_planner);
+
+    ///
+    /// Explains how the server would run update_many(), and summarizes the winning plan.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the operation.
+    /// @param filter
+    ///   Document view representing the documents to be updated.
+    /// @param update
+    ///   Document view representing the update to apply.
+    /// @param options
+    ///   Optional arguments, see options::update.
+    /// @param verbosity
+    ///   How much the server reports.
+    ///
+    /// @return The reply of the explain command and a summary of the plan.
+    ///
+    /// @throws mongocxx::operation_exception if the operation fails.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/explain/
+    ///
+    result::explain explain_update(
+        const client_session& session,
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        const options::update& options = options::update(),
+        explain_verbosity verbosity = explain_verbosity::k_query_planner);
+
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
@@ -751,6 +1041,142 @@ class MONGOCXX_API collection {
                 bsoncxx::document::view_or_value filter,
                 const options::find& options = options::find());
 
+    ///
+    /// Serializes a find whose filter contains parameters, so that it can be run repeatedly with
+    /// different values without building the filter and options documents again.
+    ///
+    /// @param filter
+    ///   The filter, with each parameter written as pipeline_template::parameter(name).
+    /// @param options
+    ///   Optional arguments, see options::find. They are copied, so they need only live until
+    ///   this returns.
+    ///
+    /// @return A mongocxx::prepared_find to run the find with.
+    ///
+    /// @throws mongocxx::logic_error if the options are invalid.
+    ///
+    prepared_find prepare_find(bsoncxx::document::view_or_value filter,
+                               const options::find& options = options::find());
+
+    ///
+    /// Finds the documents in this collection that match the provided filter, split into
+    /// partitions that can be consumed concurrently.
+    ///
+    /// The documents matching the filter are split by _id into `partitions` ranges holding roughly
+    /// the same number of documents each, computed with a $bucketAuto aggregation on this
+    /// collection. A cursor over each range is then opened on its own client acquired from `pool`,
+    /// so each returned cursor may be iterated on a different thread. Each cursor keeps its client
+    /// out of the pool until the cursor is destroyed.
+    ///
+    /// @warning
+    ///   Ranges are expressed with $gte and $lt on _id, which only match values of the same BSON
+    ///   type as the range bounds. The _id values of the collection must all have the same type
+    ///   (e.g. all ObjectIds) for the partitions to cover every matching document.
+    ///
+    /// @param pool
+    ///   The pool to acquire a client from for each partition. It must be connected to the same
+    ///   deployment as this collection.
+    /// @param partitions
+    ///   The number of partitions requested, which must be positive. Fewer cursors are returned
+    ///   if the collection has too few distinct _id values.
+    /// @param filter
+    ///   Document view representing a document that should match the query.
+    /// @param options
+    ///   Optional arguments applied to the query of every partition, see options::find. A sort
+    ///   applies within each partition only.
+    ///
+    /// @return
+    ///   One mongocxx::cursor per partition, in _id order. If a query fails, its cursor throws
+    ///   mongocxx::query_exception when it is iterated.
+    ///
+    /// @throws mongocxx::logic_error if `partitions` is not positive or the options are invalid.
+    /// @throws mongocxx::operation_exception if the partitions could not be computed.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/operator/aggregation/bucketAuto/
+    ///
+    std::vector<cursor> parallel_scan(class pool& pool,
+                                      std::int32_t partitions,
+                                      bsoncxx::document::view_or_value filter = {},
+                                      const options::find& options = options::find());
+
+    ///
+    /// Finds the documents in this collection that match the provided filter as of the cluster
+    /// time `at_cluster_time`, split into partitions that can be consumed concurrently.
+    ///
+    /// This works like parallel_scan(), except that every partition reads with a "snapshot" read
+    /// concern at `at_cluster_time`, in a session of its own. All the partitions therefore see
+    /// the same point-in-time view of the collection, however long they take to iterate and
+    /// whatever writes happen meanwhile. Scanning several collections at the same timestamp, as
+    /// returned by client::cluster_time(), exports a consistent view of all of them.
+    ///
+    /// The read concern of this collection and of the options is ignored. Snapshot reads with
+    /// atClusterTime require MongoDB 5.0 or later, and the cluster time must still be within the
+    /// history kept by the server (see minSnapshotHistoryWindowInSeconds).
+    ///
+    /// @param pool
+    ///   The pool to acquire a client from for each partition. It must be connected to the same
+    ///   deployment as this collection.
+    /// @param at_cluster_time
+    ///   The cluster time to read at.
+    /// @param partitions
+    ///   The number of partitions requested, which must be positive.
+    /// @param filter
+    ///   Document view representing a document that should match the query.
+    /// @param options
+    ///   Optional arguments applied to the query of every partition, see options::find. Tailable
+    ///   cursors are not supported.
+    ///
+    /// @return
+    ///   One mongocxx::cursor per partition, in _id order. If a query fails, for example because
+    ///   the cluster time is too old, its cursor throws mongocxx::query_exception when iterated.
+    ///
+    /// @throws mongocxx::logic_error if `partitions` is not positive or the options are invalid.
+    /// @throws mongocxx::operation_exception if the partitions could not be computed or a session
+    /// could not be started.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/read-concern-snapshot/
+    ///
+    std::vector<cursor> parallel_scan_at(class pool& pool,
+                                         bsoncxx::types::b_timestamp at_cluster_time,
+                                         std::int32_t partitions,
+                                         bsoncxx::document::view_or_value filter = {},
+                                         const options::find& options = options::find());
+
+    ///
+    /// Finds the documents in this collection whose _id is one of `ids`, splitting the ids into
+    /// chunks that are queried concurrently.
+    ///
+    /// A single {_id: {$in: [...]}} filter over a very large set of ids can exceed the maximum
+    /// BSON document size and is slow to plan. Instead, every `chunk_size` ids get their own $in
+    /// query, and the queries run on up to `max_connections` clients acquired from `pool`. Their
+    /// results are streamed back through a single mongocxx::merged_cursor in no particular order.
+    ///
+    /// @param pool
+    ///   The pool to acquire the clients from. It must be connected to the same deployment as this
+    ///   collection, and must outlive the returned cursor.
+    /// @param ids
+    ///   The _id values to look up. They are copied into the queries, so they only need to stay
+    ///   valid for the duration of the call.
+    /// @param options
+    ///   Optional arguments applied to the query of every chunk, see options::find. A sort applies
+    ///   within each chunk only, and limit and skip are not supported.
+    /// @param chunk_size
+    ///   The most ids per query, which must be positive.
+    /// @param max_connections
+    ///   The most clients checked out at once. Zero means one per chunk.
+    ///
+    /// @return
+    ///   A mongocxx::merged_cursor over the matching documents. If a query fails, the cursor
+    ///   throws mongocxx::query_exception when it is iterated.
+    ///
+    /// @throws mongocxx::logic_error if `chunk_size` is zero or the options set a limit or skip.
+    ///
+    merged_cursor find_by_ids(class pool& pool,
+                              const std::vector<bsoncxx::types::value>& ids,
+                              const options::find& options = options::find(),
+                              std::size_t chunk_size = 10000,
+                              std::size_t max_connections = 8);
+
     ///
     /// @{
     ///
@@ -1070,6 +1496,107 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// Serializes a find_one_and_update whose filter and update may contain parameters, so that it
+    /// can be run repeatedly without building its documents and libmongoc options again.
+    ///
+    /// @param filter
+    ///   The filter, with each parameter written as pipeline_template::parameter(name).
+    /// @param update
+    ///   The update, with each parameter written as pipeline_template::parameter(name).
+    /// @param options
+    ///   Optional arguments, see options::find_one_and_update. They are copied, so they need only
+    ///   live until this returns.
+    ///
+    /// @return A mongocxx::prepared_find_one_and_update to run the operation with.
+    ///
+    /// @exception
+    ///   Throws mongocxx::logic_error if the collation option is specified and an unacknowledged
+    ///   write concern is used.
+    ///
+    prepared_find_one_and_update prepare_find_one_and_update(
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        const options::find_one_and_update& options = options::find_one_and_update());
+
+    ///
+    /// @{
+    ///
+    /// Claims up to `n` documents matching a filter by applying an update to them, as `n` calls to
+    /// find_one_and_update() would, but in three round-trips however large `n` is.
+    ///
+    /// The first round-trip finds the _ids of up to `n` matching documents, in the order of the
+    /// sort option. The second updates those that still match the filter, also setting a @c _claim
+    /// field on them to an ObjectId unique to this call, so that documents claimed by another
+    /// worker in the meantime are left alone. The third reads back the documents that carry the
+    /// ObjectId. Fewer than `n` documents are returned when fewer match or when other workers
+    /// claim some of them first.
+    ///
+    /// @param filter
+    ///   Document view representing the documents that may be claimed.
+    /// @param update
+    ///   Document view representing the update to apply to the claimed documents. It must consist
+    ///   of update operators; a @c _claim field is added to its @c $set.
+    /// @param n
+    ///   The most documents to claim.
+    /// @param options
+    ///   Optional arguments, see options::find_one_and_update. The sort, collation, hint and
+    ///   max_time apply to the reads, and the write concern, collation, array filters and
+    ///   bypass_document_validation to the update. With return_document::k_before the documents
+    ///   are returned as the first round-trip read them, with their _id even if the projection
+    ///   excludes it.
+    ///
+    /// @return The claimed documents, in the order of the sort option.
+    ///
+    /// @exception
+    ///   Throws mongocxx::logic_error if the upsert option is set or the write concern is
+    ///   unacknowledged.
+    ///
+    /// @exception
+    ///   Throws mongocxx::query_exception if a read fails, or mongocxx::bulk_write_exception if
+    ///   the update fails.
+    ///
+    std::vector<bsoncxx::document::value> claim_many(
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        std::size_t n,
+        const options::find_one_and_update& options = options::find_one_and_update());
+
+    ///
+    /// Claims up to `n` documents matching a filter, as claim_many() above, as part of a session.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the claim.
+    /// @param filter
+    ///   Document view representing the documents that may be claimed.
+    /// @param update
+    ///   Document view representing the update to apply to the claimed documents.
+    /// @param n
+    ///   The most documents to claim.
+    /// @param options
+    ///   Optional arguments, see options::find_one_and_update.
+    ///
+    /// @return The claimed documents, in the order of the sort option.
+    ///
+    /// @exception
+    ///   Throws mongocxx::logic_error if the upsert option is set or the write concern is
+    ///   unacknowledged.
+    ///
+    /// @exception
+    ///   Throws mongocxx::query_exception if a read fails, or mongocxx::bulk_write_exception if
+    ///   the update fails.
+    ///
+    std::vector<bsoncxx::document::value> claim_many(
+        const client_session& session,
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        std::size_t n,
+        const options::find_one_and_update& options = options::find_one_and_update());
+
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
@@ -1111,6 +1638,48 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Inserts a single document into the collection like insert_one, but returns the error of a
+    /// failed insert, such as a duplicate key, instead of throwing it.
+    ///
+    /// @param document
+    ///   The document to insert.
+    /// @param options
+    ///   Optional arguments, see options::insert.
+    ///
+    /// @return Either the optional result insert_one would have returned, or the error it would
+    ///   have thrown.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    write_outcome<result::insert_one> try_insert_one(bsoncxx::document::view_or_value document,
+                                                     const options::insert& options = {});
+
+    ///
+    /// Inserts a single document into the collection like insert_one, but returns the error of a
+    /// failed insert, such as a duplicate key, instead of throwing it.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the insert.
+    /// @param document
+    ///   The document to insert.
+    /// @param options
+    ///   Optional arguments, see options::insert.
+    ///
+    /// @return Either the optional result insert_one would have returned, or the error it would
+    ///   have thrown.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    write_outcome<result::insert_one> try_insert_one(const client_session& session,
+                                                     bsoncxx::document::view_or_value document,
+                                                     const options::insert& options = {});
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
@@ -1121,6 +1690,13 @@ class MONGOCXX_API collection {
     /// the legacy OP_INSERT wire protocol message. As a result, using this method to insert many
     /// documents on MongoDB < 2.6 will be slow.
     ///
+    /// @note
+    ///   libmongoc copies every document into the bulk write before sending it. Ordered inserts
+    ///   are therefore sent in batches of about k_insert_many_batch_bytes, the size of one
+    ///   message, so that only one batch is copied at a time however large the container. The
+    ///   batches are built and sent on the calling thread, one after another. Unordered inserts
+    ///   are sent as one bulk write, since they continue past errors.
+    ///
     /// @tparam container_type
     ///   The container type. Must meet the requirements for the container concept with a value
     ///   type of model::write.
@@ -1229,6 +1805,81 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Inserts the documents of a range into the collection in bounded batches, so that ranges too
+    /// large to hold in memory, such as generators reading from a file, can be inserted. If any of
+    /// the documents are missing identifiers the driver will generate them.
+    ///
+    /// The documents are gathered into bulk writes of about `max_batch_bytes` each, which are built
+    /// and sent one after another on the calling thread, so only one batch is buffered at a time.
+    /// Each batch is only sent once the previous one succeeded.
+    ///
+    /// @note
+    ///   The _ids of the inserted documents are still collected for the result, which grows with
+    ///   the range. Set options::insert::skip_inserted_ids() to keep memory constant.
+    ///
+    /// @tparam range_type
+    ///   The range type. Its iterators must meet the requirements for the input iterator concept
+    ///   with a value type convertible to bsoncxx::document::view. Each document only needs to
+    ///   stay valid until the iterator is incremented.
+    ///
+    /// @param range
+    ///   The documents to insert.
+    /// @param options
+    ///   Optional arguments, see options::insert.
+    /// @param max_batch_bytes
+    ///   The number of document bytes after which a batch is sent. Must be positive. A batch may
+    ///   exceed it by up to one document, and libmongoc still splits batches larger than the
+    ///   server's maximum message size.
+    ///
+    /// @return The result of attempting to performing the inserts, which totals the results of
+    /// every batch. If the write concern is unacknowledged, the optional will be disengaged.
+    ///
+    /// @throws mongocxx::logic_error if max_batch_bytes is zero.
+    /// @throws mongocxx::bulk_write_exception when a batch fails. The documents of the batches
+    /// sent before it remain inserted, and the exception's raw_server_error() counts them and
+    /// numbers write errors from the start of the range, as for a single bulk write.
+    ///
+    template <typename range_type>
+    MONGOCXX_INLINE stdx::optional<result::insert_many> insert_stream(
+        range_type&& range,
+        const options::insert& options = options::insert(),
+        std::size_t max_batch_bytes = k_default_insert_stream_batch_bytes);
+
+    ///
+    /// Inserts the documents of a range into the collection in bounded batches.
+    ///
+    /// @tparam range_type
+    ///   The range type. Its iterators must meet the requirements for the input iterator concept
+    ///   with a value type convertible to bsoncxx::document::view.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the inserts.
+    /// @param range
+    ///   The documents to insert.
+    /// @param options
+    ///   Optional arguments, see options::insert.
+    /// @param max_batch_bytes
+    ///   The number of document bytes after which a batch is sent. Must be positive.
+    ///
+    /// @return The result of attempting to performing the inserts, which totals the results of
+    /// every batch. If the write concern is unacknowledged, the optional will be disengaged.
+    ///
+    /// @throws mongocxx::logic_error if max_batch_bytes is zero.
+    /// @throws mongocxx::bulk_write_exception when a batch fails.
+    ///
+    template <typename range_type>
+    MONGOCXX_INLINE stdx::optional<result::insert_many> insert_stream(
+        const client_session& session,
+        range_type&& range,
+        const options::insert& options = options::insert(),
+        std::size_t max_batch_bytes = k_default_insert_stream_batch_bytes);
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
@@ -1576,6 +2227,24 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// Serializes an update_one whose filter and update contain parameters, so that it can be run
+    /// repeatedly with different values without building its documents again.
+    ///
+    /// @param filter
+    ///   The filter, with each parameter written as pipeline_template::parameter(name).
+    /// @param update
+    ///   The update, with each parameter written as pipeline_template::parameter(name).
+    /// @param options
+    ///   Optional arguments, see options::update. They are copied, so they need only live until
+    ///   this returns.
+    ///
+    /// @return A mongocxx::prepared_update_one to run the update with.
+    ///
+    prepared_update_one prepare_update_one(bsoncxx::document::view_or_value filter,
+                                           bsoncxx::document::view_or_value update,
+                                           const options::update& options = options::update());
+
     ///
     /// @{
     ///
@@ -1735,6 +2404,58 @@ class MONGOCXX_API collection {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Updates a single document matching the provided filter like update_one, but returns the
+    /// error of a failed update, such as a duplicate key, instead of throwing it.
+    ///
+    /// @param filter
+    ///   Document representing the match criteria.
+    /// @param update
+    ///   Document representing the update to be applied to a matching document.
+    /// @param options
+    ///   Optional arguments, see options::update.
+    ///
+    /// @return Either the optional result update_one would have returned, or the error it would
+    ///   have thrown as a mongocxx::bulk_write_exception.
+    ///
+    /// @throws mongocxx::logic_error if the update is invalid.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    write_outcome<result::update> try_update_one(bsoncxx::document::view_or_value filter,
+                                                 bsoncxx::document::view_or_value update,
+                                                 const options::update& options = {});
+
+    ///
+    /// Updates a single document matching the provided filter like update_one, but returns the
+    /// error of a failed update, such as a duplicate key, instead of throwing it.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the update.
+    /// @param filter
+    ///   Document representing the match criteria.
+    /// @param update
+    ///   Document representing the update to be applied to a matching document.
+    /// @param options
+    ///   Optional arguments, see options::update.
+    ///
+    /// @return Either the optional result update_one would have returned, or the error it would
+    ///   have thrown as a mongocxx::bulk_write_exception.
+    ///
+    /// @throws mongocxx::logic_error if the update is invalid.
+    ///
+    /// @see mongocxx::write_outcome
+    ///
+    write_outcome<result::update> try_update_one(const client_session& session,
+                                                 bsoncxx::document::view_or_value filter,
+                                                 bsoncxx::document::view_or_value update,
+                                                 const options::update& options = {});
+    ///
+    /// @}
+    ///
+
     ///
     /// Sets the write_concern for this collection. Changes will not have any effect on existing
     /// write operations.
@@ -1828,6 +2549,10 @@ class MONGOCXX_API collection {
    private:
     friend class bulk_write;
     friend class database;
+    friend class hedged_reader;
+    friend class prepared_find;
+    friend class prepared_find_one_and_update;
+    friend class prepared_update_one;
 
     MONGOCXX_PRIVATE collection(const database& database,
                                 bsoncxx::string::view_or_value collection_name);
@@ -1846,6 +2571,10 @@ class MONGOCXX_API collection {
                                                    bsoncxx::document::view_or_value filter,
                                                    const options::count& options);
 
+    MONGOCXX_PRIVATE std::int64_t _count_documents_uncached(const client_session* session,
+                                                            bsoncxx::document::view filter,
+                                                            const options::count& options);
+
     MONGOCXX_PRIVATE bsoncxx::document::value _create_index(
         const client_session* session,
         bsoncxx::document::view_or_value keys,
@@ -1867,6 +2596,33 @@ class MONGOCXX_API collection {
                                       bsoncxx::document::view_or_value filter,
                                       const options::distinct& options);
 
+    MONGOCXX_PRIVATE bsoncxx::document::value _distinct_reply(
+        const client_session* session,
+        bsoncxx::string::view_or_value name,
+        bsoncxx::document::view_or_value filter,
+        const options::distinct& options);
+
+    MONGOCXX_PRIVATE result::explain _explain(const client_session* session,
+                                              bsoncxx::document::view command,
+                                              const stdx::optional<class read_preference>& rp,
+                                              explain_verbosity verbosity);
+
+    MONGOCXX_PRIVATE result::explain _explain_find(const client_session* session,
+                                                   bsoncxx::document::view_or_value filter,
+                                                   const options::find& options,
+                                                   explain_verbosity verbosity);
+
+    MONGOCXX_PRIVATE result::explain _explain_aggregate(const client_session* session,
+                                                        const pipeline& pipeline,
+                                                        const options::aggregate& options,
+                                                        explain_verbosity verbosity);
+
+    MONGOCXX_PRIVATE result::explain _explain_update(const client_session* session,
+                                                     bsoncxx::document::view_or_value filter,
+                                                     bsoncxx::document::view_or_value update,
+                                                     const options::update& options,
+                                                     explain_verbosity verbosity);
+
     MONGOCXX_PRIVATE void _drop(
         const client_session* session,
         const bsoncxx::stdx::optional<mongocxx::write_concern>& write_concern);
@@ -1875,11 +2631,20 @@ class MONGOCXX_API collection {
                                   bsoncxx::document::view_or_value filter,
                                   const options::find& options);
 
+    MONGOCXX_PRIVATE cursor _find_prepared(const client_session* session,
+                                           bsoncxx::document::view filter,
+                                           bsoncxx::document::view options_document,
+                                           const options::find& options);
+
     MONGOCXX_PRIVATE stdx::optional<bsoncxx::document::value> _find_one(
         const client_session* session,
         bsoncxx::document::view_or_value filter,
         const options::find& options);
 
+    // Runs a find_one on the server with the given id, bypassing server selection.
+    MONGOCXX_PRIVATE stdx::optional<bsoncxx::document::value> _find_one_on_server(
+        std::uint32_t server_id, bsoncxx::document::view filter, const options::find& options);
+
     MONGOCXX_PRIVATE stdx::optional<bsoncxx::document::value> _find_one_and_delete(
         const client_session* session,
         bsoncxx::document::view_or_value filter,
@@ -1897,11 +2662,27 @@ class MONGOCXX_API collection {
         bsoncxx::document::view_or_value update,
         const options::find_one_and_update& options);
 
-    MONGOCXX_PRIVATE stdx::optional<result::insert_one> _insert_one(
+    MONGOCXX_PRIVATE std::vector<bsoncxx::document::value> _claim_many(
+        const client_session* session,
+        bsoncxx::document::view_or_value filter,
+        bsoncxx::document::view_or_value update,
+        std::size_t n,
+        const options::find_one_and_update& options);
+
+    MONGOCXX_PRIVATE stdx::optional<bsoncxx::document::value> _find_one_and_update_prepared(
+        const client_session* session,
+        prepared_find_one_and_update::impl* prepared,
+        bsoncxx::document::view filter,
+        bsoncxx::document::view update);
+
+    MONGOCXX_PRIVATE write_outcome<result::insert_one> _insert_one(
         const client_session* session,
         bsoncxx::document::view_or_value document,
         const options::insert& options);
 
+    MONGOCXX_PRIVATE write_outcome<result::insert_one> _insert_one_grouped(
+        bsoncxx::document::view_or_value document, const options::insert& options);
+
     MONGOCXX_PRIVATE void _rename(
         const client_session* session,
         bsoncxx::string::view_or_value new_name,
@@ -1919,12 +2700,19 @@ class MONGOCXX_API collection {
         bsoncxx::document::view_or_value replacement,
         const options::replace& options);
 
-    MONGOCXX_PRIVATE stdx::optional<result::update> _update_one(
+    MONGOCXX_PRIVATE write_outcome<result::update> _update_one(
         const client_session* session,
         bsoncxx::document::view_or_value filter,
         bsoncxx::document::view_or_value update,
         const options::update& options);
 
+    MONGOCXX_PRIVATE stdx::optional<result::update> _update_one_prepared(
+        const client_session* session,
+        bsoncxx::document::view filter,
+        bsoncxx::document::view update,
+        bsoncxx::document::view operation_options,
+        const options::bulk_write& bulk_options);
+
     MONGOCXX_PRIVATE stdx::optional<result::update> _update_many(
         const client_session* session,
         bsoncxx::document::view_or_value filter,
@@ -1939,13 +2727,38 @@ class MONGOCXX_API collection {
     class bulk_write _init_insert_many(const options::insert& options,
                                        const client_session* session);
 
+    // Whether an insert with these options needs no record of its _ids: either the caller asked
+    // to skip them, or the write is unacknowledged and so has no result to put them in.
+    bool _skips_inserted_ids(const options::insert& options) const;
+
+    // Appends `doc` to `writes` and its _id to `inserted_ids`, recording `input_position` with
+    // the _id unless it is negative.
     void _insert_many_doc_handler(class bulk_write& writes,
-                                  bsoncxx::builder::basic::array& inserted_ids,
-                                  bsoncxx::document::view doc) const;
+                                  bsoncxx::builder::basic::array* inserted_ids,
+                                  bsoncxx::builder::basic::document& scratch,
+                                  bsoncxx::document::view doc,
+                                  std::int64_t input_position = -1) const;
 
     stdx::optional<result::insert_many> _exec_insert_many(
         class bulk_write& writes, bsoncxx::builder::basic::array& inserted_ids);
 
+    // Helpers for the insert_stream method templates. A source passes the next document of the
+    // range to its argument and returns true, or returns false once the range is exhausted.
+    using insert_stream_source =
+        std::function<bool(const std::function<void(bsoncxx::document::view)>&)>;
+
+    stdx::optional<result::insert_many> _exec_insert_stream(const client_session* session,
+                                                            const insert_stream_source& source,
+                                                            const options::insert& options,
+                                                            std::size_t max_batch_bytes);
+
+    template <typename range_type>
+    MONGOCXX_PRIVATE stdx::optional<result::insert_many> _insert_stream(
+        const client_session* session,
+        range_type& range,
+        const options::insert& options,
+        std::size_t max_batch_bytes);
+
     template <typename document_view_iterator_type>
     MONGOCXX_PRIVATE stdx::optional<result::insert_many> _insert_many(
         const client_session* session,
@@ -2006,6 +2819,28 @@ MONGOCXX_INLINE stdx::optional<result::bulk_write> collection::bulk_write(
     return writes.execute();
 }
 
+template <typename container_type>
+MONGOCXX_INLINE write_outcome<result::bulk_write> collection::try_bulk_write(
+    const container_type& writes, const options::bulk_write& options) {
+    auto bulk = create_bulk_write(options);
+    for (const model::write& current : writes) {
+        bulk.append(current);
+    }
+    return bulk.try_execute();
+}
+
+template <typename container_type>
+MONGOCXX_INLINE write_outcome<result::bulk_write> collection::try_bulk_write(
+    const client_session& session,
+    const container_type& writes,
+    const options::bulk_write& options) {
+    auto bulk = create_bulk_write(session, options);
+    for (const model::write& current : writes) {
+        bulk.append(current);
+    }
+    return bulk.try_execute();
+}
+
 template <typename container_type>
 MONGOCXX_INLINE stdx::optional<result::insert_many> collection::insert_many(
     const container_type& container, const options::insert& options) {
@@ -2027,10 +2862,30 @@ MONGOCXX_INLINE stdx::optional<result::insert_many> collection::_insert_many(
     document_view_iterator_type begin,
     document_view_iterator_type end,
     const options::insert& options) {
+    // An empty range still goes to libmongoc, which rejects an empty bulk write. Deduplicating
+    // unordered inserts also goes through _exec_insert_stream(), with one unbounded batch.
+    const bool ordered = options.ordered().value_or(true);
+    if ((ordered || options.dedupe_by()) && begin != end) {
+        return _exec_insert_stream(
+            session,
+            [&begin, &end](const std::function<void(bsoncxx::document::view)>& sink) {
+                if (begin == end) {
+                    return false;
+                }
+                sink(*begin);
+                ++begin;
+                return true;
+            },
+            options,
+            ordered ? k_insert_many_batch_bytes : std::numeric_limits<std::size_t>::max());
+    }
+
     bsoncxx::builder::basic::array inserted_ids;
+    bsoncxx::builder::basic::document scratch;
+    auto ids = _skips_inserted_ids(options) ? nullptr : &inserted_ids;
     auto writes = _init_insert_many(options, session);
-    std::for_each(begin, end, [&inserted_ids, &writes, this](bsoncxx::document::view doc) {
-        _insert_many_doc_handler(writes, inserted_ids, doc);
+    std::for_each(begin, end, [ids, &scratch, &writes, this](bsoncxx::document::view doc) {
+        _insert_many_doc_handler(writes, ids, scratch, doc);
     });
     return _exec_insert_many(writes, inserted_ids);
 }
@@ -2052,6 +2907,46 @@ MONGOCXX_INLINE stdx::optional<result::insert_many> collection::insert_many(
     return _insert_many(&session, begin, end, options);
 }
 
+template <typename range_type>
+MONGOCXX_INLINE stdx::optional<result::insert_many> collection::_insert_stream(
+    const client_session* session,
+    range_type& range,
+    const options::insert& options,
+    std::size_t max_batch_bytes) {
+    using std::begin;
+    using std::end;
+
+    auto current = begin(range);
+    auto last = end(range);
+    return _exec_insert_stream(
+        session,
+        [&current, &last](const std::function<void(bsoncxx::document::view)>& sink) {
+            if (current == last) {
+                return false;
+            }
+            sink(*current);
+            ++current;
+            return true;
+        },
+        options,
+        max_batch_bytes);
+}
+
+template <typename range_type>
+MONGOCXX_INLINE stdx::optional<result::insert_many> collection::insert_stream(
+    range_type&& range, const options::insert& options, std::size_t max_batch_bytes) {
+    return _insert_stream(nullptr, range, options, max_batch_bytes);
+}
+
+template <typename range_type>
+MONGOCXX_INLINE stdx::optional<result::insert_many> collection::insert_stream(
+    const client_session& session,
+    range_type&& range,
+    const options::insert& options,
+    std::size_t max_batch_bytes) {
+    return _insert_stream(&session, range, options, max_batch_bytes);
+}
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
 
@@ -0,0 +1,488 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/columnar_cursor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+columnar_batch::column::column(std::string path, column_type type)
+    : _path(std::move(path)), _type(type), _rows(0), _null_count(0) {
+    if (_type == column_type::k_utf8) {
+        _string_offsets.push_back(0);
+    }
+}
+
+const std::string& columnar_batch::column::path() const {
+    return _path;
+}
+
+columnar_batch::column_type columnar_batch::column::type() const {
+    return _type;
+}
+
+std::size_t columnar_batch::column::null_count() const {
+    return _null_count;
+}
+
+bool columnar_batch::column::is_valid(std::size_t row) const {
+    return (_validity[row / 8] >> (row % 8)) & 1;
+}
+
+const std::vector<std::uint8_t>& columnar_batch::column::validity() const {
+    return _validity;
+}
+
+const std::vector<std::uint8_t>& columnar_batch::column::bools() const {
+    return _bools;
+}
+
+const std::vector<std::int64_t>& columnar_batch::column::int64s() const {
+    return _int64s;
+}
+
+const std::vector<double>& columnar_batch::column::doubles() const {
+    return _doubles;
+}
+
+const std::vector<std::int64_t>& columnar_batch::column::string_offsets() const {
+    return _string_offsets;
+}
+
+const std::string& columnar_batch::column::string_data() const {
+    return _string_data;
+}
+
+bsoncxx::stdx::string_view columnar_batch::column::string(std::size_t row) const {
+    const auto begin = static_cast<std::size_t>(_string_offsets[row]);
+    const auto end = static_cast<std::size_t>(_string_offsets[row + 1]);
+    return bsoncxx::stdx::string_view{_string_data.data() + begin, end - begin};
+}
+
+void columnar_batch::column::clear() {
+    _rows = 0;
+    _null_count = 0;
+    _validity.clear();
+    _bools.clear();
+    _int64s.clear();
+    _doubles.clear();
+    _string_offsets.clear();
+    _string_data.clear();
+    if (_type == column_type::k_utf8) {
+        _string_offsets.push_back(0);
+    }
+}
+
+// Every row starts out null, and set_valid() marks it otherwise once its value is decoded.
+void columnar_batch::column::append_row() {
+    if (_rows % 8 == 0) {
+        _validity.push_back(0);
+    }
+    _rows++;
+    _null_count++;
+
+    switch (_type) {
+        case column_type::k_bool:
+            _bools.push_back(0);
+            break;
+        case column_type::k_int64:
+        case column_type::k_date:
+            _int64s.push_back(0);
+            break;
+        case column_type::k_double:
+            _doubles.push_back(0);
+            break;
+        case column_type::k_utf8:
+            _string_offsets.push_back(_string_offsets.back());
+            break;
+    }
+}
+
+void columnar_batch::column::set_valid() {
+    const auto row = _rows - 1;
+    const auto bit = static_cast<std::uint8_t>(1u << (row % 8));
+    if (!(_validity[row / 8] & bit)) {
+        _validity[row / 8] |= bit;
+        _null_count--;
+    }
+}
+
+class columnar_batch::impl {
+   public:
+    // The chosen paths as a tree of keys, so that each level of a document is walked once
+    // whatever the number of fields below it.
+    struct node {
+        std::string key;
+        std::size_t column = k_no_column;
+        std::vector<std::unique_ptr<node>> children;
+
+        node* child(bsoncxx::stdx::string_view child_key) const {
+            for (auto&& candidate : children) {
+                if (child_key == candidate->key) {
+                    return candidate.get();
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    static constexpr std::size_t k_no_column = static_cast<std::size_t>(-1);
+
+    explicit impl(std::vector<field> fields) : rows(0) {
+        for (auto&& f : fields) {
+            node* current = &root;
+            std::size_t begin = 0;
+            for (;;) {
+                const auto dot = f.path.find('.', begin);
+                const auto key = f.path.substr(begin, dot == std::string::npos ? dot : dot - begin);
+                if (key.empty()) {
+                    throw logic_error{error_code::k_invalid_parameter,
+                                      "the path '" + f.path + "' has an empty key"};
+                }
+
+                auto next = current->child(key);
+                if (!next) {
+                    current->children.push_back(stdx::make_unique<node>());
+                    next = current->children.back().get();
+                    next->key = key;
+                }
+                current = next;
+
+                if (dot == std::string::npos) {
+                    break;
+                }
+                begin = dot + 1;
+            }
+
+            if (current->column != k_no_column) {
+                throw logic_error{error_code::k_invalid_parameter,
+                                  "the path '" + f.path + "' is given twice"};
+            }
+            current->column = columns.size();
+            columns.push_back(column{std::move(f.path), f.type});
+        }
+    }
+
+    void decode(bsoncxx::document::view document, const node& level) {
+        for (auto&& element : document) {
+            const auto target = level.child(element.key());
+            if (!target) {
+                continue;
+            }
+            if (target->column != k_no_column) {
+                set(&columns[target->column], element);
+            }
+            if (!target->children.empty() && element.type() == bsoncxx::type::k_document) {
+                decode(element.get_document().value, *target);
+            }
+        }
+    }
+
+    static void set(column* out, const bsoncxx::document::element& element) {
+        const auto type = element.type();
+        switch (out->_type) {
+            case column_type::k_bool:
+                if (type == bsoncxx::type::k_bool) {
+                    out->_bools.back() = element.get_bool().value ? 1 : 0;
+                    out->set_valid();
+                }
+                return;
+            case column_type::k_int64:
+                if (type == bsoncxx::type::k_int32) {
+                    out->_int64s.back() = element.get_int32().value;
+                    out->set_valid();
+                } else if (type == bsoncxx::type::k_int64) {
+                    out->_int64s.back() = element.get_int64().value;
+                    out->set_valid();
+                }
+                return;
+            case column_type::k_date:
+                if (type == bsoncxx::type::k_date) {
+                    out->_int64s.back() = element.get_date().to_int64();
+                    out->set_valid();
+                }
+                return;
+            case column_type::k_double:
+                if (type == bsoncxx::type::k_double) {
+                    out->_doubles.back() = element.get_double().value;
+                    out->set_valid();
+                } else if (type == bsoncxx::type::k_int32) {
+                    out->_doubles.back() = element.get_int32().value;
+                    out->set_valid();
+                } else if (type == bsoncxx::type::k_int64) {
+                    out->_doubles.back() = static_cast<double>(element.get_int64().value);
+                    out->set_valid();
+                }
+                return;
+            case column_type::k_utf8:
+                if (type == bsoncxx::type::k_utf8) {
+                    // A repeated key replaces the value decoded for the row so far.
+                    const auto value = element.get_utf8().value;
+                    const auto row_begin = out->_string_offsets[out->_rows - 1];
+                    out->_string_data.resize(static_cast<std::size_t>(row_begin));
+                    out->_string_data.append(value.data(), value.size());
+                    out->_string_offsets.back() =
+                        static_cast<std::int64_t>(out->_string_data.size());
+                    out->set_valid();
+                }
+                return;
+        }
+    }
+
+    node root;
+    std::vector<column> columns;
+    std::size_t rows;
+};
+
+constexpr std::size_t columnar_batch::impl::k_no_column;
+
+columnar_batch::columnar_batch(std::vector<field> fields)
+    : _impl(stdx::make_unique<impl>(std::move(fields))) {}
+
+columnar_batch::columnar_batch(columnar_batch&&) noexcept = default;
+columnar_batch& columnar_batch::operator=(columnar_batch&&) noexcept = default;
+
+columnar_batch::~columnar_batch() = default;
+
+void columnar_batch::append(bsoncxx::document::view document) {
+    for (auto&& c : _impl->columns) {
+        c.append_row();
+    }
+    _impl->rows++;
+    _impl->decode(document, _impl->root);
+}
+
+void columnar_batch::clear() {
+    for (auto&& c : _impl->columns) {
+        c.clear();
+    }
+    _impl->rows = 0;
+}
+
+std::size_t columnar_batch::rows() const {
+    return _impl->rows;
+}
+
+std::size_t columnar_batch::columns() const {
+    return _impl->columns.size();
+}
+
+const columnar_batch::column& columnar_batch::operator[](std::size_t index) const {
+    return _impl->columns[index];
+}
+
+const columnar_batch::column& columnar_batch::get(bsoncxx::stdx::string_view path) const {
+    for (auto&& c : _impl->columns) {
+        if (path == c.path()) {
+            return c;
+        }
+    }
+    throw logic_error{error_code::k_invalid_parameter,
+                      "no column for the path '" + std::string{path} + "'"};
+}
+
+namespace {
+
+// The column type of a BSON type, if it has one.
+bool column_type_of(bsoncxx::type type, columnar_batch::column_type* out) {
+    switch (type) {
+        case bsoncxx::type::k_bool:
+            *out = columnar_batch::column_type::k_bool;
+            return true;
+        case bsoncxx::type::k_int32:
+        case bsoncxx::type::k_int64:
+            *out = columnar_batch::column_type::k_int64;
+            return true;
+        case bsoncxx::type::k_double:
+            *out = columnar_batch::column_type::k_double;
+            return true;
+        case bsoncxx::type::k_utf8:
+            *out = columnar_batch::column_type::k_utf8;
+            return true;
+        case bsoncxx::type::k_date:
+            *out = columnar_batch::column_type::k_date;
+            return true;
+        default:
+            return false;
+    }
+}
+
+struct inferred_field {
+    columnar_batch::field field;
+    bool conflicting;
+};
+
+void infer(bsoncxx::document::view document,
+           const std::string& prefix,
+           std::vector<inferred_field>* inferred) {
+    for (auto&& element : document) {
+        auto path = prefix;
+        path.append(element.key().data(), element.key().size());
+
+        if (element.type() == bsoncxx::type::k_document) {
+            infer(element.get_document().value, path + ".", inferred);
+            continue;
+        }
+
+        columnar_batch::column_type type;
+        if (!column_type_of(element.type(), &type)) {
+            continue;
+        }
+
+        auto known = std::find_if(inferred->begin(),
+                                  inferred->end(),
+                                  [&](const inferred_field& f) { return f.field.path == path; });
+        if (known == inferred->end()) {
+            inferred->push_back({{std::move(path), type}, false});
+            continue;
+        }
+
+        using column_type = columnar_batch::column_type;
+        const auto numeric = [](column_type t) {
+            return t == column_type::k_int64 || t == column_type::k_double;
+        };
+        if (known->field.type == type) {
+            continue;
+        }
+        if (numeric(known->field.type) && numeric(type)) {
+            known->field.type = column_type::k_double;
+        } else {
+            known->conflicting = true;
+        }
+    }
+}
+
+}  // namespace
+
+std::vector<columnar_batch::field> columnar_batch::infer_fields(const cursor::batch& sample) {
+    std::vector<inferred_field> inferred;
+    for (auto&& document : sample) {
+        infer(document, std::string{}, &inferred);
+    }
+
+    std::vector<field> fields;
+    for (auto&& f : inferred) {
+        if (!f.conflicting) {
+            fields.push_back(std::move(f.field));
+        }
+    }
+    return fields;
+}
+
+std::vector<columnar_batch> columnar_batch::decode(const std::vector<cursor::batch>& batches,
+                                                   const std::vector<field>& fields,
+                                                   std::size_t max_threads) {
+    std::vector<columnar_batch> decoded;
+    decoded.reserve(batches.size());
+    for (std::size_t i = 0; i < batches.size(); i++) {
+        decoded.emplace_back(fields);
+    }
+
+    std::atomic<std::size_t> next{0};
+    const auto drain = [&](std::exception_ptr* error) {
+        try {
+            for (auto i = next.fetch_add(1); i < batches.size(); i = next.fetch_add(1)) {
+                for (auto&& document : batches[i]) {
+                    decoded[i].append(document);
+                }
+            }
+        } catch (...) {
+            *error = std::current_exception();
+        }
+    };
+
+    if (max_threads == 0) {
+        max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    const auto threads = std::max<std::size_t>(std::min(max_threads, batches.size()), 1);
+
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> helpers;
+    for (std::size_t i = 1; i < threads; i++) {
+        try {
+            helpers.emplace_back(drain, &errors[i]);
+        } catch (const std::system_error&) {
+            // Decode on the threads that could be started.
+            break;
+        }
+    }
+    drain(&errors[0]);
+    for (auto&& helper : helpers) {
+        helper.join();
+    }
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return decoded;
+}
+
+class columnar_cursor::impl {
+   public:
+    impl(class cursor&& cursor, std::vector<columnar_batch::field> fields, std::size_t batch_rows)
+        : cursor(std::move(cursor)), batch(std::move(fields)), batch_rows(batch_rows) {}
+
+    class cursor cursor;
+    columnar_batch batch;
+    std::size_t batch_rows;
+};
+
+columnar_cursor::columnar_cursor(class cursor&& cursor,
+                                 std::vector<columnar_batch::field> fields,
+                                 std::size_t batch_rows) {
+    if (batch_rows == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "a batch needs at least one row"};
+    }
+    _impl = stdx::make_unique<impl>(std::move(cursor), std::move(fields), batch_rows);
+}
+
+columnar_cursor::columnar_cursor(columnar_cursor&&) noexcept = default;
+columnar_cursor& columnar_cursor::operator=(columnar_cursor&&) noexcept = default;
+
+columnar_cursor::~columnar_cursor() = default;
+
+bool columnar_cursor::next() {
+    auto& batch = _impl->batch;
+    batch.clear();
+    for (auto iter = _impl->cursor.begin();
+         batch.rows() < _impl->batch_rows && iter != _impl->cursor.end();
+         ++iter) {
+        batch.append(*iter);
+    }
+    return batch.rows() > 0;
+}
+
+const columnar_batch& columnar_cursor::batch() const {
+    return _impl->batch;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,268 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/cursor.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// A set of fields decoded from many documents into one array per field, ready for vectorized
+/// computation or for wrapping in Apache Arrow arrays without copying.
+///
+/// Each document appended with append() is walked once, element by element, and the elements
+/// whose paths were chosen are decoded into their columns. A field that is missing from a
+/// document, null, or of a type its column cannot hold is recorded as null.
+///
+class MONGOCXX_API columnar_batch {
+   public:
+    ///
+    /// The types of columns. Integers and dates are stored as std::int64_t (dates in milliseconds
+    /// since the epoch), doubles as double, booleans as one byte each, and strings as UTF-8 bytes
+    /// in one buffer with a 64-bit offset per row, as in Arrow's large_utf8 layout.
+    ///
+    /// A k_int64 column accepts int32 and int64 values. A k_double column also accepts them,
+    /// converted to double.
+    ///
+    enum class column_type { k_bool, k_int64, k_double, k_utf8, k_date };
+
+    ///
+    /// A field to decode: a path into the documents, with dots separating the keys of embedded
+    /// documents, and the type of its column.
+    ///
+    struct field {
+        std::string path;
+        column_type type;
+    };
+
+    ///
+    /// The values of one field.
+    ///
+    class MONGOCXX_API column {
+       public:
+        const std::string& path() const;
+
+        column_type type() const;
+
+        ///
+        /// @return The number of rows whose value is null.
+        ///
+        std::size_t null_count() const;
+
+        ///
+        /// @return Whether the value of a row is not null.
+        ///
+        bool is_valid(std::size_t row) const;
+
+        ///
+        /// @return One bit per row, least significant bit first, set when the value of the row is
+        ///   not null. This is the layout of Arrow validity bitmaps.
+        ///
+        const std::vector<std::uint8_t>& validity() const;
+
+        ///
+        /// @return The values of a k_bool column, 0 or 1, with 0 for null rows.
+        ///
+        const std::vector<std::uint8_t>& bools() const;
+
+        ///
+        /// @return The values of a k_int64 or k_date column, with 0 for null rows.
+        ///
+        const std::vector<std::int64_t>& int64s() const;
+
+        ///
+        /// @return The values of a k_double column, with 0 for null rows.
+        ///
+        const std::vector<double>& doubles() const;
+
+        ///
+        /// @return For a k_utf8 column, rows() + 1 offsets into string_data(). The value of row i
+        ///   spans offsets[i] to offsets[i + 1], and null rows are empty.
+        ///
+        const std::vector<std::int64_t>& string_offsets() const;
+
+        ///
+        /// @return The bytes of the values of a k_utf8 column, back to back.
+        ///
+        const std::string& string_data() const;
+
+        ///
+        /// @return The value of a row of a k_utf8 column. The view is valid until the batch is
+        ///   cleared or destroyed.
+        ///
+        bsoncxx::stdx::string_view string(std::size_t row) const;
+
+       private:
+        friend class columnar_batch;
+
+        column(std::string path, column_type type);
+
+        void clear();
+        void append_row();
+        void set_valid();
+
+        std::string _path;
+        column_type _type;
+        std::size_t _rows;
+        std::size_t _null_count;
+        std::vector<std::uint8_t> _validity;
+        std::vector<std::uint8_t> _bools;
+        std::vector<std::int64_t> _int64s;
+        std::vector<double> _doubles;
+        std::vector<std::int64_t> _string_offsets;
+        std::string _string_data;
+    };
+
+    ///
+    /// Creates an empty batch decoding the given fields, in that order.
+    ///
+    /// @throws mongocxx::logic_error if a path has an empty key or is given twice.
+    ///
+    explicit columnar_batch(std::vector<field> fields);
+
+    columnar_batch(columnar_batch&&) noexcept;
+    columnar_batch& operator=(columnar_batch&&) noexcept;
+
+    ~columnar_batch();
+
+    ///
+    /// Decodes the chosen fields of a document into a new row.
+    ///
+    void append(bsoncxx::document::view document);
+
+    ///
+    /// Removes every row, keeping the memory of the columns for the rows of the next batch.
+    ///
+    void clear();
+
+    ///
+    /// @return The number of rows.
+    ///
+    std::size_t rows() const;
+
+    ///
+    /// @return The number of columns, which is the number of fields.
+    ///
+    std::size_t columns() const;
+
+    ///
+    /// @return The column of the field given at `index` to the constructor.
+    ///
+    const column& operator[](std::size_t index) const;
+
+    ///
+    /// @return The column of a path.
+    ///
+    /// @throws mongocxx::logic_error if the path is not one of the fields.
+    ///
+    const column& get(bsoncxx::stdx::string_view path) const;
+
+    ///
+    /// Infers the fields of a schema from sample documents, in the order they first appear.
+    ///
+    /// Every path that leads to a boolean, integer, double, string or date in some document
+    /// becomes a field, with embedded documents walked into. Integers and doubles mixed under one
+    /// path make a k_double field. Paths holding values of other incompatible types in different
+    /// documents are left out, as are paths that only hold nulls, arrays or other types.
+    ///
+    static std::vector<field> infer_fields(const cursor::batch& sample);
+
+    ///
+    /// Decodes several batches of documents concurrently, one columnar_batch per batch.
+    ///
+    /// @param batches
+    ///   The batches to decode, e.g. returned by cursor::next_batch().
+    /// @param fields
+    ///   The fields to decode in every batch.
+    /// @param max_threads
+    ///   The most threads to decode on, including the calling thread. Zero means
+    ///   std::thread::hardware_concurrency().
+    ///
+    /// @return The decoded batches, in the order of `batches`.
+    ///
+    /// @throws mongocxx::logic_error if the fields are invalid.
+    ///
+    static std::vector<columnar_batch> decode(const std::vector<cursor::batch>& batches,
+                                              const std::vector<field>& fields,
+                                              std::size_t max_threads = 0);
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+///
+/// Reads the results of a cursor as columnar batches.
+///
+class MONGOCXX_API columnar_cursor {
+   public:
+    ///
+    /// Adapts a cursor.
+    ///
+    /// @param cursor
+    ///   The cursor to read.
+    /// @param fields
+    ///   The fields to decode, see columnar_batch.
+    /// @param batch_rows
+    ///   The most rows of a batch. Passing the batch_size the query was issued with decodes the
+    ///   documents server reply by server reply.
+    ///
+    /// @throws mongocxx::logic_error if batch_rows is zero or the fields are invalid.
+    ///
+    columnar_cursor(cursor&& cursor,
+                    std::vector<columnar_batch::field> fields,
+                    std::size_t batch_rows);
+
+    columnar_cursor(columnar_cursor&&) noexcept;
+    columnar_cursor& operator=(columnar_cursor&&) noexcept;
+
+    ~columnar_cursor();
+
+    ///
+    /// Replaces the contents of batch() with the next documents of the cursor, reusing its memory.
+    ///
+    /// @return Whether any document was decoded. batch() is empty otherwise.
+    ///
+    /// @throws mongocxx::query_exception if the query failed.
+    ///
+    bool next();
+
+    ///
+    /// @return The batch decoded by the last call to next().
+    ///
+    const columnar_batch& batch() const;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// The wire compression settings of a client or pool, the compressor each server agreed to, and
+/// the volume of commands they carried, as returned by client::compression_statistics() and
+/// pool::compression_statistics().
+///
+/// The byte counts are those of the commands and replies before compression. The driver does not
+/// see the size of compressed messages, but the server does: the network section of serverStatus
+/// reports both its logical and physical bytes in and out, and the bytes each compressor took in
+/// and put out, from which the ratio achieved by a compressor can be derived.
+///
+struct MONGOCXX_API compression_statistics {
+    struct MONGOCXX_API server {
+        /// The host name of the server.
+        std::string host;
+
+        /// The port of the server.
+        std::uint16_t port;
+
+        /// The compressor the server agreed to in its last handshake, or none if messages to the
+        /// server are not compressed.
+        stdx::optional<std::string> compressor;
+    };
+
+    /// The compressors offered to servers, in order of preference.
+    std::vector<std::string> compressors;
+
+    /// The compression level of zlib, where -1 is the default level of zlib.
+    std::int32_t zlib_compression_level;
+
+    /// The servers known to the client or pool.
+    std::vector<server> servers;
+
+    /// The number of commands run, if the client or pool was created with
+    /// options::apm::record_command_bytes(), and zero otherwise.
+    std::uint64_t commands;
+
+    /// The bytes of the command documents sent and of the replies received, before compression,
+    /// if the client or pool was created with options::apm::record_command_bytes(), and zero
+    /// otherwise.
+    std::uint64_t command_bytes;
+    std::uint64_t reply_bytes;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -17,5 +17,13 @@
 
 #undef MONGOCXX_ENABLE_SSL
 #pragma pop_macro("MONGOCXX_ENABLE_SSL")
+#undef MONGOCXX_PROFILER_MARKERS_ITT
+#pragma pop_macro("MONGOCXX_PROFILER_MARKERS_ITT")
+#undef MONGOCXX_PROFILER_MARKERS_TRACY
+#pragma pop_macro("MONGOCXX_PROFILER_MARKERS_TRACY")
+#undef MONGOCXX_PROFILER_MARKERS_SDT
+#pragma pop_macro("MONGOCXX_PROFILER_MARKERS_SDT")
+#undef MONGOCXX_HAVE_ZSTD
+#pragma pop_macro("MONGOCXX_HAVE_ZSTD")
 
 #include <mongocxx/config/postlude.hpp>
@@ -19,5 +19,13 @@
 
 #pragma push_macro("MONGOCXX_ENABLE_SSL")
 #undef MONGOCXX_ENABLE_SSL
+#pragma push_macro("MONGOCXX_PROFILER_MARKERS_ITT")
+#undef MONGOCXX_PROFILER_MARKERS_ITT
+#pragma push_macro("MONGOCXX_PROFILER_MARKERS_TRACY")
+#undef MONGOCXX_PROFILER_MARKERS_TRACY
+#pragma push_macro("MONGOCXX_PROFILER_MARKERS_SDT")
+#undef MONGOCXX_PROFILER_MARKERS_SDT
+#pragma push_macro("MONGOCXX_HAVE_ZSTD")
+#undef MONGOCXX_HAVE_ZSTD
 
 #include <mongocxx/config/private/config.hh>
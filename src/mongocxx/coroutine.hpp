@@ -0,0 +1,176 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+//
+// C++20 coroutine support for mongocxx::async_collection.
+//
+// The driver itself is built as C++11, so everything here is header-only and only available when
+// the including translation unit is compiled with coroutine support.
+//
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/async_collection.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/model/write.hpp>
+#include <mongocxx/options/bulk_write.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/options/insert.hpp>
+#include <mongocxx/result/bulk_write.hpp>
+#include <mongocxx/result/insert_many.hpp>
+#include <mongocxx/result/insert_one.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// An awaitable running a function on an async_collection.
+///
+/// Awaiting it queues the function to one of the async_collection's workers and suspends the
+/// awaiting coroutine without blocking a thread. The coroutine is resumed on the worker thread
+/// once the function completes, and the co_await expression yields the function's result or
+/// rethrows its exception.
+///
+/// @warning
+///   A resumed coroutine runs on the worker, so until it next suspends it must not block waiting
+///   for other operations of the same async_collection.
+///
+template <typename function_type>
+class awaitable {
+   public:
+    using result_type = async_collection::function_result<function_type>;
+
+    awaitable(async_collection& collection, function_type function)
+        : _collection(&collection), _function(std::move(function)) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        _collection->submit(std::move(_function),
+                            [this, handle](std::future<result_type> outcome) {
+                                _outcome = std::move(outcome);
+                                handle.resume();
+                            });
+    }
+
+    result_type await_resume() {
+        return _outcome.get();
+    }
+
+   private:
+    async_collection* _collection;
+    function_type _function;
+    std::future<result_type> _outcome;
+};
+
+///
+/// Awaits a function run on a worker of an async_collection.
+///
+/// @see mongocxx::async_collection::submit
+///
+template <typename function_type>
+awaitable<function_type> co_submit(async_collection& collection, function_type function) {
+    return {collection, std::move(function)};
+}
+
+///
+/// Awaits collection::find_one.
+///
+inline auto co_find_one(async_collection& collection,
+                        bsoncxx::document::view_or_value filter,
+                        const options::find& options = options::find()) {
+    return co_submit(
+        collection,
+        [filter = bsoncxx::document::value{filter.view()}, options](class collection& c) {
+            return c.find_one(filter.view(), options);
+        });
+}
+
+///
+/// Awaits collection::find, collecting every matching document.
+///
+/// A cursor is tied to the client of the worker that created it, so results cannot be handed out
+/// one batch at a time across suspensions; use co_submit to process a cursor on the worker.
+///
+inline auto co_find(async_collection& collection,
+                    bsoncxx::document::view_or_value filter,
+                    const options::find& options = options::find()) {
+    return co_submit(
+        collection,
+        [filter = bsoncxx::document::value{filter.view()}, options](class collection& c) {
+            std::vector<bsoncxx::document::value> documents;
+            for (auto&& document : c.find(filter.view(), options)) {
+                documents.emplace_back(document);
+            }
+            return documents;
+        });
+}
+
+///
+/// Awaits collection::insert_one.
+///
+inline auto co_insert_one(async_collection& collection,
+                          bsoncxx::document::view_or_value document,
+                          const options::insert& options = {}) {
+    return co_submit(
+        collection,
+        [document = bsoncxx::document::value{document.view()}, options](class collection& c) {
+            return c.insert_one(document.view(), options);
+        });
+}
+
+///
+/// Awaits collection::insert_many.
+///
+inline auto co_insert_many(async_collection& collection,
+                           std::vector<bsoncxx::document::value> documents,
+                           const options::insert& options = {}) {
+    return co_submit(collection,
+                     [documents = std::move(documents), options](class collection& c) {
+                         return c.insert_many(documents, options);
+                     });
+}
+
+///
+/// Awaits collection::bulk_write.
+///
+inline auto co_bulk_write(async_collection& collection,
+                          std::vector<model::write> writes,
+                          const options::bulk_write& options = options::bulk_write()) {
+    return co_submit(collection,
+                     [writes = std::move(writes), options](class collection& c) {
+                         return c.bulk_write(writes, options);
+                     });
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
+
+#endif  // defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
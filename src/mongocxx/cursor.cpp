@@ -14,18 +14,30 @@
 
 #include <mongocxx/cursor.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include <bsoncxx/private/libbson.hh>
 #include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/exception/private/mongoc_error.hh>
 #include <mongocxx/exception/query_exception.hpp>
 #include <mongocxx/private/cursor.hh>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/operation_timer.hh>
+#include <mongocxx/private/profiler_markers.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -44,23 +56,63 @@ void cursor::iterator::operator++(int) {
     operator++();
 }
 
+namespace {
+
+// The number of documents a prefetching cursor reads per batch when no batch_size was set. It
+// matches the size of the server's default first batch.
+constexpr std::size_t k_default_prefetch_batch_size = 101;
+
+// Throws the query_exception for a cursor that failed with `error`.
+[[noreturn]] void throw_cursor_error(const bson_error_t& error, const bson_t* error_document) {
+    if (error_document) {
+        bsoncxx::document::value error_doc{
+            bsoncxx::document::view{bson_get_data(error_document), error_document->len}};
+        throw_exception<query_exception>(error_doc, error);
+    } else {
+        throw_exception<query_exception>(error);
+    }
+}
+
+}  // namespace
+
 cursor::iterator& cursor::iterator::operator++() {
+    operation_timer timer;
     const bson_t* out;
     const bson_t* error_document;
     bson_error_t error;
 
-    if (libmongoc::cursor_next(_cursor->_impl->cursor_t, &out)) {
+    _cursor->_impl->returned_doc = false;
+
+    if (_cursor->_impl->is_prefetching()) {
+        if (!_cursor->_impl->next_prefetched()) {
+            _cursor->_impl->mark_nothing_left();
+        }
+        return *this;
+    }
+
+    const bool sizing = _cursor->_impl->is_sizing_batches();
+    std::chrono::steady_clock::time_point fetch_started;
+    if (sizing) {
+        fetch_started = _cursor->_impl->begin_fetch();
+    }
+
+    bool advanced;
+    {
+        operation_accounting accounting{&_cursor->_impl->stats};
+        MONGOCXX_PROFILER_PHASE("mongocxx::round_trip");
+        operation_timer::libmongoc_call call;
+        advanced = libmongoc::cursor_next(_cursor->_impl->cursor_t, &out);
+    }
+
+    if (advanced) {
         _cursor->_impl->doc = bsoncxx::document::view{bson_get_data(out), out->len};
+        if (sizing) {
+            _cursor->_impl->end_fetch(fetch_started, out->len);
+        }
     } else if (libmongoc::cursor_error_document(
                    _cursor->_impl->cursor_t, &error, &error_document)) {
         _cursor->_impl->mark_dead();
-        if (error_document) {
-            bsoncxx::document::value error_doc{
-                bsoncxx::document::view{bson_get_data(error_document), error_document->len}};
-            throw_exception<query_exception>(error_doc, error);
-        } else {
-            throw_exception<query_exception>(error);
-        }
+        throw_cursor_error(error, error_document);
     } else {
         _cursor->_impl->mark_nothing_left();
     }
@@ -71,13 +123,359 @@ cursor::iterator cursor::begin() {
     if (_impl->is_dead()) {
         return end();
     }
-    return iterator(this);
+
+    iterator iter(this);
+    if (_impl->returned_doc) {
+        ++iter;
+    }
+    return iter;
 }
 
 cursor::iterator cursor::end() {
     return iterator(nullptr);
 }
 
+operation_stats cursor::stats() const {
+    return _impl->stats.load();
+}
+
+cursor::batch cursor::next_batch(std::size_t max_documents) {
+    batch result;
+
+    // The batch is checked before advancing, since advancing past the last document taken may
+    // block on a getMore, or on a tailable cursor's await, that the caller has not asked for.
+    for (auto iter = begin(); max_documents > 0 && iter != end(); ++iter) {
+        result._append(*iter);
+        if (result._documents.size() == max_documents) {
+            _impl->returned_doc = true;
+            break;
+        }
+    }
+    result._seal();
+
+    return result;
+}
+
+cursor::batch::batch() noexcept = default;
+cursor::batch::batch(batch&&) noexcept = default;
+cursor::batch& cursor::batch::operator=(batch&&) noexcept = default;
+cursor::batch::~batch() = default;
+
+std::size_t cursor::batch::size() const noexcept {
+    return _documents.size();
+}
+
+bool cursor::batch::empty() const noexcept {
+    return _documents.empty();
+}
+
+const bsoncxx::document::view& cursor::batch::operator[](std::size_t i) const {
+    return _documents[i];
+}
+
+cursor::batch::const_iterator cursor::batch::begin() const noexcept {
+    return _documents.begin();
+}
+
+cursor::batch::const_iterator cursor::batch::end() const noexcept {
+    return _documents.end();
+}
+
+void cursor::batch::_append(const bsoncxx::document::view& document) {
+    _data.insert(_data.end(), document.data(), document.data() + document.length());
+
+    // Only the count is meaningful until _seal(), since the buffer may still move.
+    _documents.emplace_back();
+}
+
+void cursor::batch::_seal() {
+    const std::uint8_t* data = _data.data();
+    for (auto&& document : _documents) {
+        const std::uint32_t length = static_cast<std::uint32_t>(data[0]) |
+                                     static_cast<std::uint32_t>(data[1]) << 8 |
+                                     static_cast<std::uint32_t>(data[2]) << 16 |
+                                     static_cast<std::uint32_t>(data[3]) << 24;
+        document = bsoncxx::document::view{data, length};
+        data += length;
+    }
+}
+
+void cursor::impl::start_prefetch(std::int32_t max_batches,
+                                  bsoncxx::stdx::optional<std::int32_t> batch_size,
+                                  bsoncxx::stdx::optional<std::int64_t> max_bytes,
+                                  std::shared_ptr<reply_budget> budget) {
+    if (max_batches <= 0 || tailable) {
+        throw logic_error{error_code::k_invalid_parameter};
+    }
+
+    if (max_bytes && *max_bytes <= 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "positive value required for max_prefetched_bytes"};
+    }
+
+    if (is_dead()) {
+        return;
+    }
+
+    _prefetch = stdx::make_unique<prefetch_state>();
+    _prefetch->max_batches = static_cast<std::size_t>(max_batches);
+    _prefetch->batch_size = batch_size && *batch_size > 0 ? static_cast<std::size_t>(*batch_size)
+                                                          : k_default_prefetch_batch_size;
+    _prefetch->max_ready_bytes = static_cast<std::size_t>(max_bytes.value_or(0));
+    _prefetch->budget = std::move(budget);
+
+    try {
+        _prefetch->thread = std::thread{[this] { prefetch_loop(); }};
+    } catch (const std::system_error&) {
+        // Without a thread to read ahead, the cursor simply reads synchronously.
+        _prefetch.reset();
+    }
+}
+
+void cursor::impl::prefetch_loop() {
+    auto& state = *_prefetch;
+    bool done = false;
+
+    while (!done) {
+        cursor::batch batch;
+        std::exception_ptr error;
+
+        try {
+            const bson_t* out;
+            const bson_t* error_document;
+            bson_error_t bson_error;
+            operation_accounting accounting{&stats};
+
+            while (batch.size() < state.batch_size) {
+                std::chrono::steady_clock::time_point fetch_started;
+                if (_sizer) {
+                    fetch_started = begin_fetch();
+                }
+                if (libmongoc::cursor_next(cursor_t, &out)) {
+                    batch._append(bsoncxx::document::view{bson_get_data(out), out->len});
+                    if (_sizer) {
+                        end_fetch(fetch_started, out->len);
+                    }
+                    continue;
+                }
+
+                done = true;
+                if (libmongoc::cursor_error_document(cursor_t, &bson_error, &error_document)) {
+                    throw_cursor_error(bson_error, error_document);
+                }
+                break;
+            }
+        } catch (...) {
+            error = std::current_exception();
+            done = true;
+        }
+
+        batch._seal();
+
+        // Holding on to the batch until it fits delays the next getMore. A consumer with nothing
+        // left to read gets the batch regardless, so that it never waits on other cursors.
+        const auto bytes = batch._data.size();
+        if (state.budget) {
+            state.budget->acquire(bytes, [&state] {
+                std::lock_guard<std::mutex> lock{state.mutex};
+                return state.stopping || state.ready.empty();
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> lock{state.mutex};
+            state.changed.wait(lock, [&state, bytes] {
+                return state.stopping || (state.ready.size() < state.max_batches &&
+                                          (state.max_ready_bytes == 0 || state.ready.empty() ||
+                                           state.ready_bytes + bytes <= state.max_ready_bytes));
+            });
+
+            if (state.stopping) {
+                lock.unlock();
+                if (state.budget) {
+                    state.budget->release(bytes);
+                }
+                return;
+            }
+
+            if (!batch.empty()) {
+                state.ready.push_back(std::move(batch));
+                state.ready_bytes += bytes;
+            } else if (state.budget) {
+                state.budget->release(bytes);
+            }
+            if (done) {
+                state.finished = true;
+                state.error = error;
+            }
+        }
+
+        state.changed.notify_all();
+    }
+}
+
+bool cursor::impl::next_prefetched() {
+    auto& state = *_prefetch;
+
+    if (state.position == state.current.size()) {
+        std::unique_lock<std::mutex> lock{state.mutex};
+        state.changed.wait(lock, [&state] { return state.finished || !state.ready.empty(); });
+
+        if (state.ready.empty()) {
+            if (state.error) {
+                auto error = state.error;
+                state.error = nullptr;
+                lock.unlock();
+
+                mark_dead();
+                std::rethrow_exception(error);
+            }
+            return false;
+        }
+
+        const auto consumed = state.current._data.size();
+        state.current = std::move(state.ready.front());
+        state.ready.pop_front();
+        state.ready_bytes -= state.current._data.size();
+        state.position = 0;
+
+        lock.unlock();
+        state.changed.notify_all();
+
+        // Also wakes the background thread if it waits on the budget, as `ready` may now be empty.
+        if (state.budget) {
+            state.budget->release(consumed);
+        }
+    }
+
+    doc = state.current[state.position++];
+    return true;
+}
+
+void cursor::impl::stop_prefetch() {
+    if (!_prefetch) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_prefetch->mutex};
+        _prefetch->stopping = true;
+    }
+    _prefetch->changed.notify_all();
+    if (_prefetch->budget) {
+        _prefetch->budget->wake();
+    }
+
+    // The background thread may be in the middle of a getMore, which has to complete before the
+    // cursor can be destroyed.
+    _prefetch->thread.join();
+
+    if (_prefetch->budget) {
+        _prefetch->budget->release(_prefetch->ready_bytes + _prefetch->current._data.size());
+    }
+    _prefetch.reset();
+}
+
+void cursor::impl::start_batch_sizing(std::int32_t initial, std::int32_t max_bytes, bool adaptive) {
+    _sizer = stdx::make_unique<batch_sizer>(initial, max_bytes, adaptive);
+}
+
+std::chrono::steady_clock::time_point cursor::impl::begin_fetch() {
+    const auto now = std::chrono::steady_clock::now();
+
+    // The first document has nothing before it. A prefetching cursor counts the time it waited
+    // for the application to make room for more batches.
+    if (_last_fetch != std::chrono::steady_clock::time_point{}) {
+        _sizer->consumed(now - _last_fetch);
+    }
+    return now;
+}
+
+void cursor::impl::end_fetch(std::chrono::steady_clock::time_point started, std::size_t length) {
+    _last_fetch = std::chrono::steady_clock::now();
+    if (!_sizer->record(length, _last_fetch - started)) {
+        return;
+    }
+
+    // The new size applies from the next getMore on.
+    libmongoc::cursor_set_batch_size(cursor_t, static_cast<std::uint32_t>(_sizer->batch_size()));
+    if (_prefetch) {
+        _prefetch->batch_size = static_cast<std::size_t>(_sizer->batch_size());
+    }
+}
+
+namespace {
+
+// The minimum capacity of a slab, in bytes.
+constexpr std::size_t k_slab_capacity = 256 * 1024;
+
+// Each retained document is preceded by a pointer back to its slab, so that the deleter of a
+// document::value, which only receives the document's address, can find the slab to release.
+constexpr std::size_t k_slab_header = sizeof(void*);
+
+std::size_t align_to_pointer(std::size_t size) {
+    return (size + alignof(void*) - 1) / alignof(void*) * alignof(void*);
+}
+
+}  // namespace
+
+struct cursor::impl::slab {
+    // One reference is held by the cursor while the slab is current, and one by each document
+    // retained in it.
+    std::atomic<std::size_t> references;
+    std::size_t capacity;
+    std::size_t used;
+
+    std::uint8_t* data() {
+        return reinterpret_cast<std::uint8_t*>(this + 1);
+    }
+
+    void release() {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->~slab();
+            ::operator delete(this);
+        }
+    }
+
+    // The deleter of retained documents.
+    static void release_document(std::uint8_t* document) {
+        slab* owner;
+        std::memcpy(&owner, document - k_slab_header, sizeof(owner));
+        owner->release();
+    }
+};
+
+bsoncxx::document::value cursor::impl::retain() {
+    const std::size_t needed = align_to_pointer(k_slab_header + doc.length());
+
+    if (!_slab || _slab->capacity - _slab->used < needed) {
+        release_slab();
+
+        const std::size_t capacity = std::max(k_slab_capacity, needed);
+        _slab = new (::operator new(sizeof(slab) + capacity)) slab;
+        _slab->references.store(1, std::memory_order_relaxed);
+        _slab->capacity = capacity;
+        _slab->used = 0;
+    }
+
+    std::uint8_t* header = _slab->data() + _slab->used;
+    std::memcpy(header, &_slab, sizeof(_slab));
+    std::uint8_t* document = header + k_slab_header;
+    std::memcpy(document, doc.data(), doc.length());
+
+    _slab->used += needed;
+    _slab->references.fetch_add(1, std::memory_order_relaxed);
+
+    return bsoncxx::document::value{document, doc.length(), &slab::release_document};
+}
+
+void cursor::impl::release_slab() {
+    if (_slab) {
+        _slab->release();
+        _slab = nullptr;
+    }
+}
+
 cursor::iterator::iterator(cursor* cursor) : _cursor(cursor) {
     if (_cursor == nullptr || _cursor->_impl->has_started()) {
         return;
@@ -103,6 +501,10 @@ const bsoncxx::document::view* cursor::iterator::operator->() const {
     return &_cursor->_impl->doc;
 }
 
+bsoncxx::document::value cursor::iterator::retain() const {
+    return _cursor->_impl->retain();
+}
+
 //
 // Iterators are equal if they point to the same underlying _cursor or if they
 // both are "at the end".  We check for exhaustion first because the most
@@ -14,10 +14,15 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/operation_stats.hpp>
 
 #include <mongocxx/config/prelude.hpp>
 
@@ -26,6 +31,9 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 class collection;
 
+template <typename T>
+class typed_cursor;
+
 ///
 /// Class representing a pointer to the result set of a query on a MongoDB server.
 ///
@@ -39,6 +47,8 @@ class MONGOCXX_API cursor {
 
     class MONGOCXX_API iterator;
 
+    class MONGOCXX_API batch;
+
     ///
     /// Move constructs a cursor.
     ///
@@ -78,11 +88,54 @@ class MONGOCXX_API cursor {
     ///
     iterator end();
 
+    ///
+    /// Consumes up to `max_documents` of the remaining documents of the cursor and returns them as
+    /// a single batch.
+    ///
+    /// The documents are copied into one buffer owned by the returned batch, so they stay valid
+    /// after the cursor advances and the batch can be handed to another thread. Passing the
+    /// batch_size the query was issued with returns the documents server reply by server reply.
+    ///
+    /// Documents returned in a batch are consumed just as if they had been iterated over, so
+    /// cursor.begin() afterwards points to the first document that was not returned.
+    ///
+    /// @param max_documents
+    ///   The maximum number of documents to return.
+    ///
+    /// @return
+    ///   The next documents of the cursor. The batch is empty if no documents are available.
+    ///
+    /// @throws mongocxx::query_exception if the query failed
+    ///
+    batch next_batch(std::size_t max_documents);
+
+    ///
+    /// Iterates over the remaining documents of the cursor decoded into structs with a mapping
+    /// defined by BSONCXX_DEFINE_STRUCT, with the default settings of mongocxx::typed_cursor.
+    ///
+    /// @note Defined in <mongocxx/typed_cursor.hpp>, which must be included to call it.
+    ///
+    /// @return An adapter that reads from this cursor, which must outlive it.
+    ///
+    template <typename T>
+    typed_cursor<T> as();
+
+    ///
+    /// Gets the network traffic of the commands the cursor has run so far, such as its find or
+    /// aggregate and its getMores, if the client was created with
+    /// options::apm::record_operation_stats().
+    ///
+    /// @return The bytes sent and received, round-trips and command durations of the cursor.
+    ///
+    operation_stats stats() const;
+
    private:
     friend class collection;
     friend class client;
     friend class database;
     friend class index_view;
+    friend class sorted_merge_cursor;
+    friend class tailer;
     friend class cursor::iterator;
 
     MONGOCXX_PRIVATE cursor(void* cursor_ptr,
@@ -123,6 +176,22 @@ class MONGOCXX_API cursor::iterator
     ///
     const bsoncxx::document::view* operator->() const;
 
+    ///
+    /// Copies the document currently being pointed to into a value that remains valid after the
+    /// iterator is incremented.
+    ///
+    /// Constructing a bsoncxx::document::value from the view allocates a buffer per document.
+    /// Retained documents are instead packed into large buffers shared with the other documents
+    /// retained from the same cursor, so keeping many documents costs one allocation per buffer
+    /// rather than one per document. A shared buffer is freed once the cursor has moved on to a
+    /// new one and every value in it has been destroyed; values may be destroyed on any thread.
+    ///
+    /// @note Holding on to a single retained document keeps its whole shared buffer alive.
+    ///
+    /// @return An owning copy of the current document.
+    ///
+    bsoncxx::document::value retain() const;
+
     ///
     /// Pre-increments the iterator to move to the next document.
     ///
@@ -162,6 +231,70 @@ class MONGOCXX_API cursor::iterator
     cursor* _cursor;
 };
 
+///
+/// Class representing a batch of documents taken from a mongocxx::cursor by cursor::next_batch().
+///
+/// A batch owns its documents, which stay valid for the lifetime of the batch regardless of what
+/// happens to the cursor it came from.
+///
+class MONGOCXX_API cursor::batch {
+   public:
+    using const_iterator = std::vector<bsoncxx::document::view>::const_iterator;
+
+    ///
+    /// Constructs an empty batch.
+    ///
+    batch() noexcept;
+
+    batch(batch&&) noexcept;
+    batch& operator=(batch&&) noexcept;
+
+    batch(const batch&) = delete;
+    batch& operator=(const batch&) = delete;
+
+    ~batch();
+
+    ///
+    /// @return The number of documents in the batch.
+    ///
+    std::size_t size() const noexcept;
+
+    ///
+    /// @return Whether the batch holds no documents.
+    ///
+    bool empty() const noexcept;
+
+    ///
+    /// Accesses a document of the batch.
+    ///
+    /// @param i
+    ///   The position of the document, which must be less than size().
+    ///
+    /// @return A view of the i-th document of the batch.
+    ///
+    const bsoncxx::document::view& operator[](std::size_t i) const;
+
+    ///
+    /// @return An iterator to the first document of the batch.
+    ///
+    const_iterator begin() const noexcept;
+
+    ///
+    /// @return An iterator past the last document of the batch.
+    ///
+    const_iterator end() const noexcept;
+
+   private:
+    friend class cursor;
+    friend class cursor::impl;
+
+    MONGOCXX_PRIVATE void _append(const bsoncxx::document::view& document);
+    MONGOCXX_PRIVATE void _seal();
+
+    std::vector<std::uint8_t> _data;
+    std::vector<bsoncxx::document::view> _documents;
+};
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
 
@@ -26,12 +26,16 @@
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/exception/operation_exception.hpp>
 #include <mongocxx/exception/private/mongoc_error.hh>
+#include <mongocxx/private/change_stream.hh>
 #include <mongocxx/private/client.hh>
 #include <mongocxx/private/client_session.hh>
+#include <mongocxx/private/cursor.hh>
 #include <mongocxx/private/database.hh>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/operation_timer.hh>
 #include <mongocxx/private/pipeline.hh>
+#include <mongocxx/private/profiler_markers.hh>
 #include <mongocxx/private/read_concern.hh>
 #include <mongocxx/private/read_preference.hh>
 
@@ -77,11 +81,14 @@ database& database::operator=(database&&) noexcept = default;
 
 database::~database() = default;
 
-database::database(const class client& client, bsoncxx::string::view_or_value name)
-    : _impl(stdx::make_unique<impl>(
-          libmongoc::client_get_database(client._get_impl().client_t, name.terminated().data()),
-          &client._get_impl(),
-          name.terminated().data())) {}
+database::database(const class client& client, bsoncxx::string::view_or_value name) {
+    // terminated() copies a view into a new string, so it is only called once.
+    const auto terminated = name.terminated();
+    _impl = stdx::make_unique<impl>(
+        libmongoc::client_get_database(client._get_impl().client_t, terminated.data()),
+        &client._get_impl(),
+        terminated.data());
+}
 
 database::database(const database& d) {
     if (d) {
@@ -126,8 +133,17 @@ cursor database::_aggregate(const client_session* session,
         rp_ptr = options.read_preference()->_impl->read_preference_t;
     }
 
-    return cursor(libmongoc::database_aggregate(
-        _get_impl().database_t, stages.bson(), options_bson.bson(), rp_ptr));
+    cursor aggregate_cursor{libmongoc::database_aggregate(
+        _get_impl().database_t, stages.bson(), options_bson.bson(), rp_ptr)};
+
+    if (options.prefetch_batches()) {
+        aggregate_cursor._impl->start_prefetch(*options.prefetch_batches(),
+                                               options.batch_size(),
+                                               options.max_prefetched_bytes(),
+                                               _get_impl().client_impl->replies);
+    }
+
+    return aggregate_cursor;
 }
 
 cursor database::aggregate(const pipeline& pipeline, const options::aggregate& options) {
@@ -157,12 +173,12 @@ cursor database::_list_collections(const client_session* session,
 }
 
 cursor database::list_collections(bsoncxx::document::view_or_value filter) {
-    return _list_collections(nullptr, filter);
+    return _list_collections(nullptr, std::move(filter));
 }
 
 cursor database::list_collections(const client_session& session,
                                   bsoncxx::document::view_or_value filter) {
-    return _list_collections(&session, filter);
+    return _list_collections(&session, std::move(filter));
 }
 
 std::vector<std::string> database::_list_collection_names(const client_session* session,
@@ -194,12 +210,44 @@ std::vector<std::string> database::_list_collection_names(const client_session*
 }
 
 std::vector<std::string> database::list_collection_names(bsoncxx::document::view_or_value filter) {
-    return _list_collection_names(nullptr, filter);
+    return _list_collection_names(nullptr, std::move(filter));
 }
 
 std::vector<std::string> database::list_collection_names(const client_session& session,
                                                          bsoncxx::document::view_or_value filter) {
-    return _list_collection_names(&session, filter);
+    return _list_collection_names(&session, std::move(filter));
+}
+
+name_cursor database::_list_collection_names_cursor(const client_session* session,
+                                                   bsoncxx::document::view_or_value filter,
+                                                   bool authorized_only) {
+    bsoncxx::builder::basic::document options_builder;
+    options_builder.append(kvp("filter", filter));
+    options_builder.append(kvp("nameOnly", true));
+    if (authorized_only) {
+        options_builder.append(kvp("authorizedCollections", true));
+    }
+
+    if (session) {
+        options_builder.append(
+            bsoncxx::builder::concatenate_doc{session->_get_impl().to_document()});
+    }
+
+    scoped_bson_t options_bson(options_builder.extract());
+
+    return name_cursor{cursor{libmongoc::database_find_collections_with_opts(
+        _get_impl().database_t, options_bson.bson())}};
+}
+
+name_cursor database::list_collection_names_cursor(bsoncxx::document::view_or_value filter,
+                                                   bool authorized_only) {
+    return _list_collection_names_cursor(nullptr, std::move(filter), authorized_only);
+}
+
+name_cursor database::list_collection_names_cursor(const client_session& session,
+                                                   bsoncxx::document::view_or_value filter,
+                                                   bool authorized_only) {
+    return _list_collection_names_cursor(&session, std::move(filter), authorized_only);
 }
 
 stdx::string_view database::name() const {
@@ -208,43 +256,50 @@ stdx::string_view database::name() const {
 
 bsoncxx::document::value database::_run_command(const client_session* session,
                                                 bsoncxx::document::view_or_value command) {
-    libbson::scoped_bson_t command_bson{command};
+    operation_timer timer;
+    libbson::scoped_bson_t command_bson{std::move(command)};
     libbson::scoped_bson_t reply_bson;
     bson_error_t error;
 
-    bsoncxx::builder::basic::document options_builder;
+    // Only a session contributes options, so skip building an empty options document without one.
+    libbson::scoped_bson_t options_bson;
     if (session) {
-        options_builder.append(
-            bsoncxx::builder::concatenate_doc{session->_get_impl().to_document()});
+        options_bson.init_from_static(session->_get_impl().to_document());
     }
 
-    scoped_bson_t options_bson(options_builder.extract());
-    auto result = libmongoc::database_command_with_opts(_get_impl().database_t,
-                                                        command_bson.bson(),
-                                                        NULL,
-                                                        options_bson.bson(),
-                                                        reply_bson.bson_for_init(),
-                                                        &error);
+    bool result;
+    {
+        MONGOCXX_PROFILER_PHASE("mongocxx::round_trip");
+        operation_timer::libmongoc_call call;
+        result = libmongoc::database_command_with_opts(_get_impl().database_t,
+                                                       command_bson.bson(),
+                                                       NULL,
+                                                       options_bson.bson(),
+                                                       reply_bson.bson_for_init(),
+                                                       &error);
+    }
 
     if (!result) {
         throw_exception<operation_exception>(reply_bson.steal(), error);
     }
 
+    MONGOCXX_PROFILER_PHASE("mongocxx::deserialize");
+    operation_timer::scoped_phase construct{operation_timer::phase::k_result};
     return reply_bson.steal();
 }
 
 bsoncxx::document::value database::run_command(bsoncxx::document::view_or_value command) {
-    return _run_command(nullptr, command);
+    return _run_command(nullptr, std::move(command));
 }
 
 bsoncxx::document::value database::run_command(const client_session& session,
                                                bsoncxx::document::view_or_value command) {
-    return _run_command(&session, command);
+    return _run_command(&session, std::move(command));
 }
 
 bsoncxx::document::value database::run_command(bsoncxx::document::view_or_value command,
                                                uint32_t server_id) {
-    libbson::scoped_bson_t command_bson{command};
+    libbson::scoped_bson_t command_bson{std::move(command)};
     libbson::scoped_bson_t reply_bson;
     bson_error_t error;
 
@@ -271,7 +326,7 @@ collection database::_create_collection(const client_session* session,
     bsoncxx::builder::basic::document options_builder;
     bson_error_t error;
 
-    options_builder.append(bsoncxx::builder::concatenate_doc{collection_options});
+    options_builder.append(bsoncxx::builder::concatenate_doc{collection_options.view()});
 
     if (write_concern) {
         options_builder.append(kvp("writeConcern", write_concern->to_document()));
@@ -371,7 +426,7 @@ class collection database::create_collection(
     stdx::string_view name,
     bsoncxx::document::view_or_value collection_options,
     const stdx::optional<class write_concern>& write_concern) {
-    return _create_collection(nullptr, name, collection_options, write_concern);
+    return _create_collection(nullptr, name, std::move(collection_options), write_concern);
 }
 
 class collection database::create_collection(
@@ -379,7 +434,7 @@ class collection database::create_collection(
     stdx::string_view name,
     bsoncxx::document::view_or_value collection_options,
     const stdx::optional<class write_concern>& write_concern) {
-    return _create_collection(&session, name, collection_options, write_concern);
+    return _create_collection(&session, name, std::move(collection_options), write_concern);
 }
 
 class collection database::create_collection_deprecated(
@@ -427,6 +482,7 @@ void database::drop(const client_session& session,
 }
 
 void database::read_concern(class read_concern rc) {
+    _get_impl().detach();
     libmongoc::database_set_read_concern(_get_impl().database_t, rc._impl->read_concern_t);
 }
 
@@ -436,6 +492,7 @@ class read_concern database::read_concern() const {
 }
 
 void database::read_preference(class read_preference rp) {
+    _get_impl().detach();
     libmongoc::database_set_read_prefs(_get_impl().database_t, rp._impl->read_preference_t);
 }
 
@@ -457,6 +514,7 @@ class read_preference database::read_preference() const {
 }
 
 void database::write_concern(class write_concern wc) {
+    _get_impl().detach();
     libmongoc::database_set_write_concern(_get_impl().database_t, wc._impl->write_concern_t);
 }
 
@@ -509,8 +567,16 @@ class change_stream database::_watch(const client_session* session,
 
     scoped_bson_t options_bson{options_builder.extract()};
 
-    return change_stream{libmongoc::database_watch(
+    class change_stream stream{libmongoc::database_watch(
         _get_impl().database_t, pipeline_bson.bson(), options_bson.bson())};
+    if (options.prefetch_batches()) {
+        stream._impl->start_prefetch(*options.prefetch_batches(),
+                                     options.batch_size(),
+                                     options.max_prefetched_bytes(),
+                                     _get_impl().client_impl->replies);
+    }
+
+    return stream;
 }
 
 const database::impl& database::_get_impl() const {
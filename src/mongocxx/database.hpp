@@ -22,6 +22,7 @@
 #include <mongocxx/client_session.hpp>
 #include <mongocxx/collection.hpp>
 #include <mongocxx/gridfs/bucket.hpp>
+#include <mongocxx/name_cursor.hpp>
 #include <mongocxx/options/create_collection.hpp>
 #include <mongocxx/options/gridfs/bucket.hpp>
 #include <mongocxx/read_preference.hpp>
@@ -177,6 +178,7 @@ class MONGOCXX_API database {
     ///
     bsoncxx::document::value run_command(bsoncxx::document::view_or_value command,
                                          uint32_t server_id);
+
     ///
     /// @}
     ///
@@ -414,6 +416,46 @@ class MONGOCXX_API database {
     std::vector<std::string> list_collection_names(const client_session& session,
                                                    bsoncxx::document::view_or_value filter = {});
 
+    ///
+    /// Streams the collection names in this database.
+    ///
+    /// The listCollections command is run with `nameOnly`, so that the server neither takes
+    /// collection locks nor returns collection options, and the names are read lazily from its
+    /// reply batches instead of being copied into a std::vector.
+    ///
+    /// @param filter
+    ///   An optional query expression to filter the returned collection names. With `nameOnly`,
+    ///   only the name and type fields may be filtered on.
+    /// @param authorized_only
+    ///   Whether to only list the collections the user has privileges on, with
+    ///   `authorizedCollections`. This lets users without the listCollections privilege list the
+    ///   collections they can access.
+    ///
+    /// @return mongocxx::name_cursor yielding the collection names.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/listCollections/
+    ///
+    name_cursor list_collection_names_cursor(bsoncxx::document::view_or_value filter = {},
+                                             bool authorized_only = false);
+
+    ///
+    /// Streams the collection names in this database.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to list the collections.
+    /// @param filter
+    ///   An optional query expression to filter the returned collection names.
+    /// @param authorized_only
+    ///   Whether to only list the collections the user has privileges on.
+    ///
+    /// @return mongocxx::name_cursor yielding the collection names.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/command/listCollections/
+    ///
+    name_cursor list_collection_names_cursor(const client_session& session,
+                                             bsoncxx::document::view_or_value filter = {},
+                                             bool authorized_only = false);
+
     ///
     /// @}
     ///
@@ -596,6 +638,7 @@ class MONGOCXX_API database {
    private:
     friend class client;
     friend class collection;
+    friend class gridfs::bucket;
 
     MONGOCXX_PRIVATE database(const class client& client, bsoncxx::string::view_or_value name);
 
@@ -621,6 +664,11 @@ class MONGOCXX_API database {
     MONGOCXX_PRIVATE cursor _list_collections(const client_session* session,
                                               bsoncxx::document::view_or_value filter);
 
+    MONGOCXX_PRIVATE name_cursor _list_collection_names_cursor(
+        const client_session* session,
+        bsoncxx::document::view_or_value filter,
+        bool authorized_only);
+
     MONGOCXX_PRIVATE std::vector<std::string> _list_collection_names(
         const client_session* session, bsoncxx::document::view_or_value filter);
 
@@ -0,0 +1,101 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/database_pool.hpp>
+
+#include <utility>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/private/database_pool.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+database_pool::entry::entry(pool::entry client, class database database)
+    : _client(std::move(client)), _database(std::move(database)) {}
+
+database* database_pool::entry::operator->() & noexcept {
+    return &_database;
+}
+
+database& database_pool::entry::operator*() & noexcept {
+    return _database;
+}
+
+client& database_pool::entry::client() noexcept {
+    return *_client;
+}
+
+database_pool::database_pool(class pool& pool, bsoncxx::string::view_or_value database)
+    : _impl(stdx::make_unique<impl>(&pool, database.view().to_string())) {}
+
+database_pool::database_pool(database_pool&&) noexcept = default;
+database_pool& database_pool::operator=(database_pool&&) noexcept = default;
+
+database_pool::~database_pool() = default;
+
+database_pool::entry database_pool::_make_entry(pool::entry client) const {
+    auto db = (*client)[_impl->name];
+    if (_impl->read_concern) {
+        db.read_concern(*_impl->read_concern);
+    }
+    if (_impl->read_preference) {
+        db.read_preference(*_impl->read_preference);
+    }
+    if (_impl->write_concern) {
+        db.write_concern(*_impl->write_concern);
+    }
+    return entry{std::move(client), std::move(db)};
+}
+
+database_pool::entry database_pool::acquire() {
+    return _make_entry(_impl->pool->acquire());
+}
+
+database_pool::entry database_pool::acquire(std::chrono::milliseconds timeout) {
+    return _make_entry(_impl->pool->acquire(timeout));
+}
+
+stdx::optional<database_pool::entry> database_pool::try_acquire() {
+    auto client = _impl->pool->try_acquire();
+    if (!client) {
+        return stdx::nullopt;
+    }
+    return _make_entry(std::move(*client));
+}
+
+database_pool& database_pool::read_concern(class read_concern rc) {
+    _impl->read_concern = std::move(rc);
+    return *this;
+}
+
+database_pool& database_pool::read_preference(class read_preference rp) {
+    _impl->read_preference = std::move(rp);
+    return *this;
+}
+
+database_pool& database_pool::write_concern(class write_concern wc) {
+    _impl->write_concern = std::move(wc);
+    return *this;
+}
+
+stdx::string_view database_pool::name() const {
+    return _impl->name;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,176 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/read_concern.hpp>
+#include <mongocxx/read_preference.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/write_concern.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// One database of a deployment, served by the clients of a pool shared with other databases.
+///
+/// A pool monitors its deployment with its own threads and keeps its own sockets to every server.
+/// Creating a pool per database of a multi-tenant deployment multiplies those. Instead, create
+/// one pool for the deployment and one database_pool per tenant database over it: each has its own
+/// default read concern, read preference and write concern, and hands out handles on its database
+/// backed by clients of the shared pool.
+///
+/// Connections authenticate once, with the credentials of the pool's URI, so every database_pool
+/// of a pool acts with the same user. That user needs roles on all the tenant databases; tenants
+/// that need distinct credentials need distinct pools.
+///
+/// A database_pool may be used by several threads at once, but its settings must not be changed
+/// while it is in use.
+///
+/// @warning
+///   The pool must outlive the database_pool and every entry acquired from it.
+///
+class MONGOCXX_API database_pool {
+   public:
+    ///
+    /// Creates a database_pool.
+    ///
+    /// @param pool
+    ///   The pool whose clients serve the database.
+    /// @param database
+    ///   The name of the database.
+    ///
+    database_pool(pool& pool, bsoncxx::string::view_or_value database);
+
+    database_pool(database_pool&&) noexcept;
+    database_pool& operator=(database_pool&&) noexcept;
+
+    ~database_pool();
+
+    ///
+    /// A handle on the database, backed by a client acquired from the pool. The client returns to
+    /// the pool when the entry is destroyed, so an entry should be held no longer than a request.
+    ///
+    class MONGOCXX_API entry {
+       public:
+        /// Access a member of the database.
+        class database* operator->() & noexcept;
+        class database* operator->() && = delete;
+
+        /// Retrieve a reference to the database.
+        class database& operator*() & noexcept;
+        class database& operator*() && = delete;
+
+        /// Retrieve the client the database belongs to.
+        class client& client() noexcept;
+
+       private:
+        friend class database_pool;
+
+        MONGOCXX_PRIVATE entry(pool::entry client, class database database);
+
+        // Declared first so that the database is destroyed before its client is released.
+        pool::entry _client;
+        class database _database;
+    };
+
+    ///
+    /// Acquires a client from the pool, blocking like pool::acquire(), and returns a handle on the
+    /// database with the settings of this database_pool.
+    ///
+    /// @throws mongocxx::exception if no client could be acquired from the pool.
+    ///
+    entry acquire();
+
+    ///
+    /// Acquires a client from the pool, blocking for at most the given timeout, like
+    /// pool::acquire(std::chrono::milliseconds).
+    ///
+    /// @throws mongocxx::exception with error_code::k_pool_wait_queue_timeout if no client becomes
+    ///   available before the timeout elapses.
+    ///
+    entry acquire(std::chrono::milliseconds timeout);
+
+    ///
+    /// Acquires a client from the pool if one is available, like pool::try_acquire().
+    ///
+    /// @return A handle on the database, or a disengaged optional if no client is available.
+    ///
+    stdx::optional<entry> try_acquire();
+
+    ///
+    /// Sets the read concern of the handles acquired from now on. By default, that of the pool's
+    /// clients is used.
+    ///
+    /// @param rc
+    ///   The read concern.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    database_pool& read_concern(class read_concern rc);
+
+    ///
+    /// Sets the read preference of the handles acquired from now on. By default, that of the
+    /// pool's clients is used.
+    ///
+    /// @param rp
+    ///   The read preference.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    database_pool& read_preference(class read_preference rp);
+
+    ///
+    /// Sets the write concern of the handles acquired from now on. By default, that of the pool's
+    /// clients is used.
+    ///
+    /// @param wc
+    ///   The write concern.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    database_pool& write_concern(class write_concern wc);
+
+    ///
+    /// @return The name of the database.
+    ///
+    stdx::string_view name() const;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    MONGOCXX_PRIVATE entry _make_entry(pool::entry client) const;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
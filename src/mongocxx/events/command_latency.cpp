@@ -0,0 +1,63 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/events/command_latency.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <mongocxx/private/command_latency_recorder.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace events {
+
+constexpr std::size_t command_latency::k_histogram_buckets;
+
+std::chrono::microseconds command_latency::percentile(double percentile) const {
+    if (count == 0) {
+        return std::chrono::microseconds{0};
+    }
+
+    // The rank of the percentile among the recorded durations, counting from one.
+    auto rank = static_cast<std::uint64_t>(
+        std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100.0 * static_cast<double>(count)));
+    rank = std::max<std::uint64_t>(rank, 1);
+
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(bucket), max_duration);
+        }
+    }
+
+    return max_duration;
+}
+
+std::chrono::microseconds command_latency::bucket_upper_bound(std::size_t bucket) {
+    if (bucket < 32) {
+        return std::chrono::microseconds{static_cast<std::int64_t>(bucket)};
+    }
+
+    auto msb = 5 + (bucket - 32) / 16;
+    auto top = std::uint64_t{16 + (bucket - 32) % 16};
+    return std::chrono::microseconds{static_cast<std::int64_t>(((top + 1) << (msb - 4)) - 1)};
+}
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,86 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+///
+/// A snapshot of the latencies of one command against one server, recorded from command
+/// monitoring when options::apm::record_command_latencies() is set, and returned by
+/// client::command_latencies() and pool::command_latencies().
+///
+/// Durations are those reported by command succeeded events. They are counted in a log-linear
+/// histogram, in the manner of HdrHistogram: durations under 32us each have their own bucket, and
+/// every longer power of two of microseconds is split into 16 buckets of equal width, so that a
+/// bucket's bounds are within about 6% of each other. Durations of 2^40us or more are counted in
+/// the last bucket.
+///
+struct MONGOCXX_API command_latency {
+    static constexpr std::size_t k_histogram_buckets = 592;
+
+    /// The name of the command.
+    std::string command_name;
+
+    /// The host name of the server that ran the command.
+    std::string host;
+
+    /// The port of the server that ran the command.
+    std::uint16_t port;
+
+    /// The number of commands that succeeded.
+    std::uint64_t count;
+
+    /// The sum and the maximum of the durations of the commands.
+    std::chrono::microseconds total_duration;
+    std::chrono::microseconds max_duration;
+
+    /// The number of commands whose duration fell in each bucket, k_histogram_buckets in all.
+    std::vector<std::uint64_t> histogram;
+
+    ///
+    /// Estimates a percentile of the durations, such as 50, 99 or 99.9, as the upper bound of the
+    /// bucket holding it, so that the estimate is never below the actual value by more than the
+    /// bucket's width. It never exceeds max_duration.
+    ///
+    /// @param percentile
+    ///   The percentile, from 0 to 100.
+    ///
+    /// @return The estimated percentile, or zero if no command was recorded.
+    ///
+    std::chrono::microseconds percentile(double percentile) const;
+
+    ///
+    /// Gets the largest duration counted in a bucket of the histogram, for exporting the
+    /// histogram as such, e.g. as the "le" labels of a Prometheus histogram.
+    ///
+    static std::chrono::microseconds bucket_upper_bound(std::size_t bucket);
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
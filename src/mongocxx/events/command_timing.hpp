@@ -0,0 +1,61 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+///
+/// The timing of a completed MongoDB command, passed to the callback set with
+/// options::apm::on_command_timing().
+///
+/// Unlike command_succeeded_event and command_failed_event, it holds no command or reply
+/// document, and its fields are read from the driver's event once, before the callback is called.
+///
+/// The string views are only valid for the duration of the callback.
+///
+struct command_timing {
+    /// The request id of the command.
+    std::int64_t request_id;
+
+    /// The name of the command.
+    bsoncxx::stdx::string_view command_name;
+
+    /// The duration of the command in microseconds.
+    std::int64_t duration;
+
+    /// The host name of the server that ran the command.
+    bsoncxx::stdx::string_view host;
+
+    /// The port of the server that ran the command.
+    std::uint16_t port;
+
+    /// Whether the command succeeded.
+    bool succeeded;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,40 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/events/connection_check_out_failed_event.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace events {
+
+connection_check_out_failed_event::connection_check_out_failed_event(
+    failure_reason reason, std::chrono::nanoseconds duration)
+    : _reason(reason), _duration(duration) {}
+
+connection_check_out_failed_event::~connection_check_out_failed_event() = default;
+
+connection_check_out_failed_event::failure_reason connection_check_out_failed_event::reason()
+    const {
+    return _reason;
+}
+
+std::chrono::nanoseconds connection_check_out_failed_event::duration() const {
+    return _duration;
+}
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
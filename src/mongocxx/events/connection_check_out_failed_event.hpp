@@ -0,0 +1,64 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+/// An event notification sent when a mongocxx::pool fails to hand out a client.
+/// @see "ConnectionCheckOutFailedEvent" in
+/// https://github.com/mongodb/specifications/blob/master/source/connection-monitoring-and-pooling/connection-monitoring-and-pooling.rst
+class MONGOCXX_API connection_check_out_failed_event {
+   public:
+    /// Why a checkout failed.
+    enum class failure_reason {
+        /// pool::acquire() waited longer than its timeout, or the waitQueueTimeoutMS of the URI,
+        /// for a client to be released.
+        k_timeout,
+
+        /// pool::try_acquire() found every client in use.
+        k_pool_exhausted,
+    };
+
+    MONGOCXX_PRIVATE connection_check_out_failed_event(failure_reason reason,
+                                                       std::chrono::nanoseconds duration);
+
+    /// Destroys a connection_check_out_failed_event.
+    ~connection_check_out_failed_event();
+
+    /// Returns why the checkout failed.
+    /// @return The reason.
+    failure_reason reason() const;
+
+    /// Returns how long the checkout took before failing.
+    /// @return The duration of the checkout.
+    std::chrono::nanoseconds duration() const;
+
+   private:
+    failure_reason _reason;
+    std::chrono::nanoseconds _duration;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
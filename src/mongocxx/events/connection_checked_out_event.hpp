@@ -0,0 +1,49 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+/// An event notification sent when a mongocxx::pool hands out a client, with pool::acquire() or
+/// pool::try_acquire().
+/// @see "ConnectionCheckedOutEvent" in
+/// https://github.com/mongodb/specifications/blob/master/source/connection-monitoring-and-pooling/connection-monitoring-and-pooling.rst
+class MONGOCXX_API connection_checked_out_event {
+   public:
+    MONGOCXX_PRIVATE explicit connection_checked_out_event(std::chrono::nanoseconds duration);
+
+    /// Destroys a connection_checked_out_event.
+    ~connection_checked_out_event();
+
+    /// Returns how long the checkout took, including any wait for a client to be released.
+    /// @return The duration of the checkout.
+    std::chrono::nanoseconds duration() const;
+
+   private:
+    std::chrono::nanoseconds _duration;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
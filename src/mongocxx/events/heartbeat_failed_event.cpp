@@ -49,6 +49,11 @@ std::uint16_t heartbeat_failed_event::port() const {
         ->port;
 }
 
+bool heartbeat_failed_event::awaited() const {
+    return libmongoc::apm_server_heartbeat_failed_get_awaited(
+        static_cast<const mongoc_apm_server_heartbeat_failed_t*>(_failed_event));
+}
+
 }  // namespace events
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
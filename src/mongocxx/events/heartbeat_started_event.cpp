@@ -37,6 +37,11 @@ std::uint16_t heartbeat_started_event::port() const {
         ->port;
 }
 
+bool heartbeat_started_event::awaited() const {
+    return libmongoc::apm_server_heartbeat_started_get_awaited(
+        static_cast<const mongoc_apm_server_heartbeat_started_t*>(_started_event));
+}
+
 }  // namespace events
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
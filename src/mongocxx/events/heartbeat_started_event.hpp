@@ -27,6 +27,14 @@ namespace events {
 /// An event notification sent when the driver begins executing an "isMaster" command to check the
 /// status of a server.
 ///
+/// Server monitoring already adapts to the state of the deployment. A pool whose servers support
+/// streaming monitoring keeps one awaited heartbeat open per server. The server answers it at once
+/// when its state changes, and at most every heartbeatFrequencyMS when it is stable. After a failed
+/// heartbeat, or while server selection finds no suitable server, servers are checked again
+/// immediately and then every minHeartbeatFrequencyMS until one is found. A large
+/// heartbeatFrequencyMS therefore lowers the load of stable deployments without slowing the
+/// detection of failovers much. awaited() tells the two kinds of heartbeat apart.
+///
 /// @see "ServerHeartbeatStartedEvent" in
 /// https://github.com/mongodb/specifications/blob/master/source/server-discovery-and-monitoring/server-discovery-and-monitoring-monitoring.rst
 ///
@@ -53,6 +61,16 @@ class MONGOCXX_API heartbeat_started_event {
     ///
     std::uint16_t port() const;
 
+    ///
+    /// Returns whether the heartbeat was awaited. A server that supports streaming monitoring
+    /// holds an awaited heartbeat open and replies as soon as its state changes, or after
+    /// heartbeatFrequencyMS otherwise. Non-awaited heartbeats are the polling checks made before
+    /// streaming starts, after a failure, or against older servers.
+    ///
+    /// @return Whether the heartbeat was awaited.
+    ///
+    bool awaited() const;
+
    private:
     const void* _started_event;
 };
@@ -48,6 +48,11 @@ std::uint16_t heartbeat_succeeded_event::port() const {
         ->port;
 }
 
+bool heartbeat_succeeded_event::awaited() const {
+    return libmongoc::apm_server_heartbeat_succeeded_get_awaited(
+        static_cast<const mongoc_apm_server_heartbeat_succeeded_t*>(_succeeded_event));
+}
+
 }  // namespace events
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -68,6 +68,16 @@ class MONGOCXX_API heartbeat_succeeded_event {
     ///
     std::uint16_t port() const;
 
+    ///
+    /// Returns whether the heartbeat was awaited. A server that supports streaming monitoring
+    /// holds an awaited heartbeat open and replies as soon as its state changes, or after
+    /// heartbeatFrequencyMS otherwise. Non-awaited heartbeats are the polling checks made before
+    /// streaming starts, after a failure, or against older servers.
+    ///
+    /// @return Whether the heartbeat was awaited.
+    ///
+    bool awaited() const;
+
    private:
     const void* _succeeded_event;
 };
@@ -0,0 +1,72 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+///
+/// The counts of the commands run against one collection, recorded from command monitoring when
+/// options::apm::record_namespace_stats() is set, and returned by client::namespace_stats() and
+/// pool::namespace_stats().
+///
+/// Counts only grow, so rates such as operations per second are the differences between two
+/// snapshots divided by the time between them.
+///
+struct MONGOCXX_API namespace_stats {
+    /// The database of the collection.
+    std::string database;
+
+    /// The collection, or empty for the commands that name none.
+    std::string collection;
+
+    /// The number of commands started, by command.
+    std::uint64_t finds;
+    std::uint64_t get_mores;
+    std::uint64_t aggregates;
+    std::uint64_t inserts;
+    std::uint64_t updates;
+    std::uint64_t deletes;
+    std::uint64_t find_and_modifies;
+    std::uint64_t other_commands;
+
+    /// The number of commands that failed.
+    std::uint64_t failures;
+
+    /// The documents in the batches of the cursors of find, aggregate and getMore, and those
+    /// returned by findAndModify.
+    std::uint64_t documents_returned;
+
+    /// The documents inserted, modified, upserted or deleted, as reported by the server.
+    std::uint64_t documents_written;
+
+    /// The bytes of the BSON documents of the commands and of their replies, before any wire
+    /// compression.
+    std::uint64_t command_bytes;
+    std::uint64_t reply_bytes;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,62 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+/// An event notification sent when the driver marks a server Unknown after a network error or a
+/// failed heartbeat, which is when the connections to that server are closed rather than reused,
+/// as the connection pool of a driver following the CMAP specification would be cleared. During a
+/// failover, operations that follow it have to open new connections.
+/// @see "PoolClearedEvent" in
+/// https://github.com/mongodb/specifications/blob/master/source/connection-monitoring-and-pooling/connection-monitoring-and-pooling.rst
+class MONGOCXX_API pool_cleared_event {
+   public:
+    MONGOCXX_PRIVATE explicit pool_cleared_event(const void* event);
+
+    /// Destroys a pool_cleared_event.
+    ~pool_cleared_event();
+
+    /// Returns the server host name.
+    /// @return The host name.
+    bsoncxx::stdx::string_view host() const;
+
+    /// Returns the server port.
+    /// @return The port.
+    std::uint16_t port() const;
+
+    /// An opaque id, unique to this topology for this mongocxx::client or mongocxx::pool.
+    /// @return The id.
+    const bsoncxx::oid topology_id() const;
+
+   private:
+    const void* _event;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,54 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <bsoncxx/document/value.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+///
+/// A filter shape run against a collection, with how often it ran, as returned by
+/// client::query_shapes() and pool::query_shapes().
+///
+struct MONGOCXX_API query_shape {
+    /// The database the commands ran against.
+    std::string database;
+
+    /// The collection the commands named.
+    std::string collection;
+
+    ///
+    /// The shape of the filter, as in events::slow_command: its field names and query operators,
+    /// with every value replaced by the string "?".
+    ///
+    bsoncxx::document::value filter_shape;
+
+    /// The number of commands with this filter shape.
+    std::int64_t count;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
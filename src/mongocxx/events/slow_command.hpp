@@ -0,0 +1,69 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <bsoncxx/document/value.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+///
+/// A command that took at least the threshold of options::apm::record_slow_commands(), as
+/// returned by client::slow_commands() and pool::slow_commands().
+///
+struct MONGOCXX_API slow_command {
+    /// The database the command ran against.
+    std::string database;
+
+    /// The collection named by the command, or empty if it names none.
+    std::string collection;
+
+    /// The name of the command.
+    std::string command_name;
+
+    ///
+    /// The shape of the command's filter: its field names and query operators, with every value
+    /// replaced by the string "?", so that it carries no application data. For aggregate, this is
+    /// the first $match stage; for update and delete, the filter of the first statement. Empty if
+    /// the command has no filter.
+    ///
+    bsoncxx::document::value filter_shape;
+
+    /// The duration reported by the command's succeeded or failed event.
+    std::chrono::microseconds duration;
+
+    /// The host name of the server that ran the command.
+    std::string host;
+
+    /// The port of the server that ran the command.
+    std::uint16_t port;
+
+    /// Whether the command succeeded.
+    bool succeeded;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
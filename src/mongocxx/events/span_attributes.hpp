@@ -0,0 +1,70 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace events {
+
+///
+/// The attributes of the span a mongocxx::tracer starts for a MongoDB command.
+///
+/// The string views are only valid for the duration of the call to tracer::start_span().
+///
+struct span_attributes {
+    /// The database the command runs against.
+    bsoncxx::stdx::string_view database;
+
+    /// The collection the command runs against, if it has one, such as for find, insert,
+    /// aggregate or getMore.
+    bsoncxx::stdx::string_view collection;
+
+    /// The name of the command.
+    bsoncxx::stdx::string_view command_name;
+
+    /// The request id of the command.
+    std::int64_t request_id;
+
+    /// The operation id of the command, which is shared by the commands of one bulk write.
+    std::int64_t operation_id;
+
+    /// The batch size requested by a find, aggregate or getMore, or the number of documents,
+    /// updates or deletes sent by an insert, update or delete.
+    bsoncxx::stdx::optional<std::int64_t> batch_size;
+
+    /// The size in bytes of the command document.
+    std::size_t bytes;
+
+    /// The host name of the server the command is sent to.
+    bsoncxx::stdx::string_view host;
+
+    /// The port of the server the command is sent to.
+    std::uint16_t port;
+};
+
+}  // namespace events
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
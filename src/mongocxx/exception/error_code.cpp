@@ -84,6 +84,12 @@ class error_category final : public std::error_category {
                 return "an invalid client session was provided";
             case error_code::k_invalid_transaction_options_object:
                 return "an invalid transactions options object was provided";
+            case error_code::k_pool_wait_queue_timeout:
+                return "timed out waiting for a client from the pool";
+            case error_code::k_transaction_retry_budget_exhausted:
+                return "the transaction was retried as many times as allowed";
+            case error_code::k_compression_not_supported:
+                return "the driver was built without the compression library that was requested";
             default:
                 return "unknown mongocxx error";
         }
@@ -90,6 +90,15 @@ enum class error_code : std::int32_t {
     /// A moved-from mongocxx::options::transaction object has been used.
     k_invalid_transaction_options_object,
 
+    /// A mongocxx::pool timed out waiting for a client to become available.
+    k_pool_wait_queue_timeout,
+
+    /// mongocxx::client_session::with_transaction spent its retry budget.
+    k_transaction_retry_budget_exhausted,
+
+    /// The driver was built without the compression library a GridFS file needs.
+    k_compression_not_supported,
+
     // Add new constant string message to error_code.cpp as well!
 };
 
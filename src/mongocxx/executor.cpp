@@ -0,0 +1,148 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <mongocxx/private/executor.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+executor::executor() = default;
+executor::~executor() = default;
+
+namespace {
+
+// Shared with the submitted tasks, which may outlive the call to run_parallel().
+struct parallel_run {
+    std::atomic<std::size_t> next{0};
+    std::size_t count;
+
+    std::mutex mutex;
+    std::condition_variable done;
+
+    // Guarded by mutex. Only dereferenced by tasks counted in `active`.
+    const std::function<void(std::size_t)>* task;
+    std::size_t active = 0;
+
+    void drain() {
+        for (auto i = next++; i < count; i = next++) {
+            (*task)(i);
+        }
+    }
+};
+
+}  // namespace
+
+void run_parallel(executor& executor,
+                  std::size_t count,
+                  std::size_t parallelism,
+                  const std::function<void(std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    auto run = std::make_shared<parallel_run>();
+    run->count = count;
+    run->task = &task;
+
+    const auto helpers =
+        std::min({count, std::max<std::size_t>(parallelism, 1), executor.concurrency() + 1}) - 1;
+    for (std::size_t i = 0; i < helpers; i++) {
+        try {
+            executor.submit([run] {
+                {
+                    std::lock_guard<std::mutex> lock{run->mutex};
+                    if (run->next.load() >= run->count) {
+                        return;
+                    }
+                    run->active++;
+                }
+
+                run->drain();
+
+                {
+                    std::lock_guard<std::mutex> lock{run->mutex};
+                    run->active--;
+                }
+                run->done.notify_all();
+            });
+        } catch (...) {
+            // The calling thread runs the calls this task would have.
+            break;
+        }
+    }
+
+    run->drain();
+
+    std::unique_lock<std::mutex> lock{run->mutex};
+    run->done.wait(lock, [&] { return run->active == 0; });
+}
+
+submitted_task::submitted_task(std::function<void()> function) : _function{std::move(function)} {}
+
+std::shared_ptr<submitted_task> submitted_task::submit(executor& executor,
+                                                       std::function<void()> function) {
+    std::shared_ptr<submitted_task> task{new submitted_task{std::move(function)}};
+    try {
+        executor.submit([task] { task->try_run(); });
+    } catch (...) {
+        task->try_run();
+    }
+    return task;
+}
+
+bool submitted_task::try_run() {
+    if (_claimed.exchange(true)) {
+        return false;
+    }
+
+    std::exception_ptr error;
+    try {
+        _function();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    _function = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _done = true;
+        _error = error;
+    }
+    _finished.notify_all();
+    return true;
+}
+
+void submitted_task::wait() {
+    try_run();
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    _finished.wait(lock, [this] { return _done; });
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,68 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// The interface of the executors that run the background work of the driver.
+///
+/// Features that work in the background, such as mongocxx::async_collection, parallel bulk writes
+/// and the parallel GridFS transfers, submit their tasks to an executor instead of starting
+/// threads of their own, so that the number of threads the driver uses stays bounded. By default
+/// they use the executor of the mongocxx::instance, which is a mongocxx::work_stealing_executor;
+/// applications may supply their own implementation to share threads with the rest of the program.
+///
+/// Callers that wait for the tasks they submit also run any of them that have not started, so an
+/// executor may run tasks late, or even after the caller has stopped waiting for them; it must
+/// run every task it accepts, though, before it is destroyed.
+///
+class MONGOCXX_API executor {
+   public:
+    virtual ~executor();
+
+    ///
+    /// Queues a task to run on a thread of the executor. It must not run the task on the calling
+    /// thread, since the caller may hold locks the task needs.
+    ///
+    /// @param task
+    ///   The task to run. It does not throw.
+    ///
+    virtual void submit(std::function<void()> task) = 0;
+
+    ///
+    /// Returns the number of tasks the executor can run at once. Callers do not submit more tasks
+    /// than this for work they can spread over any number of threads.
+    ///
+    virtual std::size_t concurrency() const = 0;
+
+   protected:
+    ///
+    /// Default constructor
+    ///
+    executor();
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
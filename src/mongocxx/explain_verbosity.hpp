@@ -0,0 +1,41 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Enum representing how much an explain command reports about the plan of an operation.
+///
+/// @see https://docs.mongodb.com/manual/reference/command/explain/
+///
+enum class explain_verbosity {
+    /// Report the plans considered and the winning plan, without running it.
+    k_query_planner,
+
+    /// Also run the winning plan and report its execution statistics.
+    k_execution_stats,
+
+    /// Also report partial execution statistics for the rejected plans.
+    k_all_plans_execution,
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
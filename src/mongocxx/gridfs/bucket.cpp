@@ -14,29 +14,175 @@
 
 #include <mongocxx/gridfs/bucket.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <ios>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/concatenate.hpp>
 #include <bsoncxx/oid.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/cursor.hpp>
 #include <mongocxx/database.hpp>
 #include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/gridfs_exception.hpp>
 #include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/executor.hpp>
 #include <mongocxx/gridfs/private/bucket.hh>
+#include <mongocxx/gridfs/private/index_cache.hh>
 #include <mongocxx/options/delete.hpp>
 #include <mongocxx/options/index.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/client.hh>
+#include <mongocxx/private/client_session.hh>
+#include <mongocxx/private/database.hh>
+#include <mongocxx/private/executor.hh>
+#include <mongocxx/private/zstd_codec.hh>
 #include <mongocxx/stdx.hpp>
 
 #include <mongocxx/config/private/prelude.hh>
 
+namespace {
+// Servers that do not report maxMessageSizeBytes accept messages of this size.
+constexpr std::int32_t k_default_max_message_size_bytes = 48 * 1000 * 1000;
+
+// How much of a message is left to the other fields of the insert command by the default size of a
+// batch of chunks.
+constexpr std::int32_t k_batch_headroom_bytes = 1000 * 1000;
+}  // namespace
+
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 namespace gridfs {
 
+namespace {
+
+// Gets the options of the chunks query of a download, sorting the chunks by number.
+options::find chunks_find_options(const options::gridfs::download& download_options) {
+    options::find chunks_options;
+
+    if (auto batch_size = download_options.batch_size()) {
+        if (*batch_size <= 0) {
+            throw logic_error{
+                error_code::k_invalid_parameter,
+                "positive value required for options::gridfs::download::batch_size()"};
+        }
+
+        chunks_options.batch_size(*batch_size);
+    }
+
+    if (auto prefetch_batches = download_options.prefetch_batches()) {
+        if (*prefetch_batches <= 0) {
+            throw logic_error{
+                error_code::k_invalid_parameter,
+                "positive value required for options::gridfs::download::prefetch_batches()"};
+        }
+
+        chunks_options.prefetch_batches(*prefetch_batches);
+    }
+
+    bsoncxx::builder::basic::document chunks_sort;
+    chunks_sort.append(bsoncxx::builder::basic::kvp("n", 1));
+    chunks_options.sort(chunks_sort.extract());
+
+    return chunks_options;
+}
+
+// Gets the files document of the file with the given id.
+bsoncxx::document::value find_files_document(collection* files,
+                                             const client_session* session,
+                                             bsoncxx::types::value id) {
+    using namespace bsoncxx;
+
+    builder::basic::document files_filter;
+    files_filter.append(builder::basic::kvp("_id", id));
+
+    auto files_doc = session ? files->find_one(*session, files_filter.extract())
+                             : files->find_one(files_filter.extract());
+
+    if (!files_doc) {
+        throw gridfs_exception{error_code::k_gridfs_file_not_found};
+    }
+
+    auto files_doc_view = files_doc->view();
+
+    if (!files_doc_view["length"] || (files_doc_view["length"].type() != type::k_int64 &&
+                                      files_doc_view["length"].type() != type::k_int32)) {
+        throw gridfs_exception{error_code::k_gridfs_file_corrupted,
+                               "expected files document to contain field \"length\" with type "
+                               "k_int32 or k_int64"};
+    }
+
+    return std::move(*files_doc);
+}
+
+// Makes the query with which a downloader reads the chunks of a file.
+std::function<cursor(std::int32_t, std::int32_t)> chunks_query(collection chunks,
+                                                               const client_session* session,
+                                                               bsoncxx::types::value id,
+                                                               options::find chunks_options) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    // The id is owned by the query, as it may outlive the value passed in.
+    auto files_id = make_document(kvp("files_id", id));
+
+    return [chunks, session, files_id, chunks_options](std::int32_t first,
+                                                        std::int32_t last) mutable {
+        bsoncxx::builder::basic::document chunks_filter;
+        chunks_filter.append(bsoncxx::builder::concatenate_doc{files_id.view()});
+        chunks_filter.append(kvp("n", make_document(kvp("$gte", first), kvp("$lt", last))));
+
+        return session ? chunks.find(*session, chunks_filter.extract(), chunks_options)
+                       : chunks.find(chunks_filter.extract(), chunks_options);
+    };
+}
+
+// Makes the query with which a downloader reads the shared chunks of a deduplicated file.
+std::function<cursor(bsoncxx::document::view)> shared_chunks_query(collection chunks,
+                                                                   const client_session* session,
+                                                                   options::find chunks_options) {
+    return [chunks, session, chunks_options](bsoncxx::document::view filter) mutable {
+        return session ? chunks.find(*session, filter, chunks_options)
+                       : chunks.find(filter, chunks_options);
+    };
+}
+
+// Closes the file it holds when destroyed.
+using file_handle = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+}  // namespace
+
+std::int32_t bucket::impl::default_max_batch_bytes() {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    if (!max_message_size_bytes) {
+        max_message_size_bytes = k_default_max_message_size_bytes;
+
+        auto reply = db.run_command(make_document(kvp("isMaster", 1)));
+        auto reported = reply.view()["maxMessageSizeBytes"];
+        if (reported && reported.type() == bsoncxx::type::k_int32) {
+            max_message_size_bytes = reported.get_int32().value;
+        }
+    }
+
+    return std::max(*max_message_size_bytes - k_batch_headroom_bytes, k_batch_headroom_bytes);
+}
+
 bucket::bucket(const database& db, const options::gridfs::bucket& options) {
     std::string bucket_name = "fs";
     if (auto name = options.bucket_name()) {
@@ -60,8 +206,13 @@ bucket::bucket(const database& db, const options::gridfs::bucket& options) {
     collection chunks = db[bucket_name + ".chunks"];
     collection files = db[bucket_name + ".files"];
 
-    _impl = stdx::make_unique<impl>(
-        std::move(bucket_name), default_chunk_size_bytes, std::move(chunks), std::move(files));
+    _impl = stdx::make_unique<impl>(db,
+                                    bsoncxx::string::to_string(db.name()),
+                                    std::move(bucket_name),
+                                    default_chunk_size_bytes,
+                                    std::move(chunks),
+                                    std::move(files),
+                                    db._get_impl().client_impl->gridfs_indexes);
 
     if (auto read_concern = options.read_concern()) {
         _get_impl().files.read_concern(*read_concern);
@@ -134,6 +285,37 @@ uploader bucket::_open_upload_stream_with_id(const client_session* session,
         chunk_size_bytes = *chunk_size;
     }
 
+    std::int32_t max_batch_bytes;
+    if (auto batch_bytes = options.max_batch_bytes()) {
+        if (*batch_bytes <= 0) {
+            throw logic_error{
+                error_code::k_invalid_parameter,
+                "positive value required for options::gridfs::upload::max_batch_bytes()"};
+        }
+
+        max_batch_bytes = *batch_bytes;
+    } else {
+        max_batch_bytes = _get_impl().default_max_batch_bytes();
+    }
+
+    std::uint32_t parallelism = options.parallelism().value_or(1);
+    if (parallelism > 1 && session) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "options::gridfs::upload::parallelism() cannot be used in a session"};
+    }
+
+    if (options.compression() == options::gridfs::upload::compression_algorithm::k_zstd) {
+        if (!zstd_codec::supported()) {
+            throw logic_error{error_code::k_compression_not_supported,
+                              "options::gridfs::upload::compression() requires zstd"};
+        }
+
+        if (!zstd_codec::valid_level(options.compression_level())) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "options::gridfs::upload::compression() level is out of range"};
+        }
+    }
+
     create_indexes_if_nonexistent(session);
 
     return uploader{session,
@@ -142,7 +324,15 @@ uploader bucket::_open_upload_stream_with_id(const client_session* session,
                     _get_impl().files,
                     _get_impl().chunks,
                     chunk_size_bytes,
-                    std::move(options.metadata())};
+                    std::move(options.metadata()),
+                    max_batch_bytes,
+                    parallelism > 1 ? options.parallelism_pool() : nullptr,
+                    _get_impl().database_name,
+                    parallelism,
+                    options.checksum(),
+                    options.compression(),
+                    options.compression_level(),
+                    options.deduplicate_chunks().value_or(false)};
 }
 
 uploader bucket::open_upload_stream_with_id(bsoncxx::types::value id,
@@ -216,85 +406,351 @@ void bucket::upload_from_stream_with_id(const client_session& session,
     return _upload_from_stream_with_id(&session, id, filename, source, options);
 }
 
-downloader bucket::_open_download_stream(const client_session* session, bsoncxx::types::value id) {
-    using namespace bsoncxx;
+downloader bucket::_open_download_stream(const client_session* session,
+                                         bsoncxx::types::value id,
+                                         std::int64_t start_offset,
+                                         stdx::optional<std::int64_t> end_offset,
+                                         const options::gridfs::download& options) {
+    auto chunks_options = chunks_find_options(options);
+    auto files_doc = find_files_document(&_get_impl().files, session, id);
+
+    return downloader{chunks_query(_get_impl().chunks, session, id, chunks_options),
+                      std::move(files_doc),
+                      start_offset,
+                      end_offset,
+                      shared_chunks_query(_get_impl().chunks, session, chunks_options)};
+}
 
-    builder::basic::document files_filter;
-    files_filter.append(builder::basic::kvp("_id", id));
+downloader bucket::open_download_stream(bsoncxx::types::value id,
+                                        const options::gridfs::download& options) {
+    return _open_download_stream(nullptr, id, 0, stdx::nullopt, options);
+}
 
-    auto files_doc = session ? _get_impl().files.find_one(*session, files_filter.extract())
-                             : _get_impl().files.find_one(files_filter.extract());
+downloader bucket::open_download_stream(const client_session& session,
+                                        bsoncxx::types::value id,
+                                        const options::gridfs::download& options) {
+    return _open_download_stream(&session, id, 0, stdx::nullopt, options);
+}
 
-    if (!files_doc) {
-        throw gridfs_exception{error_code::k_gridfs_file_not_found};
+downloader bucket::open_download_stream(bsoncxx::types::value id,
+                                        std::int64_t start_offset,
+                                        std::int64_t end_offset,
+                                        const options::gridfs::download& options) {
+    return _open_download_stream(nullptr, id, start_offset, end_offset, options);
+}
+
+downloader bucket::open_download_stream(const client_session& session,
+                                        bsoncxx::types::value id,
+                                        std::int64_t start_offset,
+                                        std::int64_t end_offset,
+                                        const options::gridfs::download& options) {
+    return _open_download_stream(&session, id, start_offset, end_offset, options);
+}
+
+void bucket::_download_to_stream(const client_session* session,
+                                 bsoncxx::types::value id,
+                                 std::ostream* destination,
+                                 const options::gridfs::download& options) {
+    downloader download_stream = _open_download_stream(session, id, 0, stdx::nullopt, options);
+
+    // Chunks are written straight from the documents received from the server.
+    for (auto chunk = download_stream.next_chunk(); chunk.size != 0;
+         chunk = download_stream.next_chunk()) {
+        destination->write(reinterpret_cast<const char*>(chunk.bytes),
+                           static_cast<std::streamsize>(chunk.size));
     }
 
-    auto files_doc_view = files_doc->view();
+    download_stream.close();
+}
 
-    if (!files_doc_view["length"] || (files_doc_view["length"].type() != type::k_int64 &&
-                                      files_doc_view["length"].type() != type::k_int32)) {
-        throw gridfs_exception{error_code::k_gridfs_file_corrupted,
-                               "expected files document to contain field \"length\" with type "
-                               "k_int32 or k_int64"};
+void bucket::download_to_stream(bsoncxx::types::value id,
+                                std::ostream* destination,
+                                const options::gridfs::download& options) {
+    _download_to_stream(nullptr, id, destination, options);
+}
+
+void bucket::download_to_stream(const client_session& session,
+                                bsoncxx::types::value id,
+                                std::ostream* destination,
+                                const options::gridfs::download& options) {
+    _download_to_stream(&session, id, destination, options);
+}
+
+result::gridfs::upload bucket::_upload_from_file(const client_session* session,
+                                                 stdx::string_view filename,
+                                                 const std::string& path,
+                                                 const options::gridfs::upload& options) {
+    file_handle source{std::fopen(path.c_str(), "rb"), &std::fclose};
+    if (!source) {
+        throw std::ios_base::failure{"could not open " + path + " for reading"};
     }
+    std::setvbuf(source.get(), nullptr, _IONBF, 0);
 
-    auto length = files_doc_view["length"];
+    auto id = bsoncxx::types::value{bsoncxx::types::b_oid{}};
+    uploader upload_stream = _open_upload_stream_with_id(session, id, filename, options);
+
+    // Read straight into the chunk documents, a chunk's worth at a time.
+    std::size_t space;
+    std::size_t bytes_read;
+    do {
+        auto buffer = upload_stream.chunk_space(&space);
+        bytes_read = std::fread(buffer, 1, space, source.get());
+        upload_stream.commit_chunk_space(bytes_read);
+    } while (bytes_read == space);
 
-    if ((length.type() == type::k_int64 && !length.get_int64().value) ||
-        (length.type() == type::k_int32 && !length.get_int32().value)) {
-        return downloader{stdx::nullopt, *files_doc};
+    if (std::ferror(source.get())) {
+        upload_stream.abort();
+        throw std::ios_base::failure{"could not read " + path};
     }
 
-    builder::basic::document chunks_filter;
-    chunks_filter.append(builder::basic::kvp("files_id", id));
+    upload_stream.close();
+    return id;
+}
 
-    builder::basic::document chunks_sort;
-    chunks_sort.append(builder::basic::kvp("n", 1));
+result::gridfs::upload bucket::upload_from_file(stdx::string_view filename,
+                                                const std::string& path,
+                                                const options::gridfs::upload& options) {
+    return _upload_from_file(nullptr, filename, path, options);
+}
 
-    options::find chunks_options;
-    chunks_options.sort(chunks_sort.extract());
+result::gridfs::upload bucket::upload_from_file(const client_session& session,
+                                                stdx::string_view filename,
+                                                const std::string& path,
+                                                const options::gridfs::upload& options) {
+    return _upload_from_file(&session, filename, path, options);
+}
 
-    auto cursor = session
-                      ? _get_impl().chunks.find(*session, chunks_filter.extract(), chunks_options)
-                      : _get_impl().chunks.find(chunks_filter.extract(), chunks_options);
+void bucket::_download_to_file(const client_session* session,
+                               bsoncxx::types::value id,
+                               const std::string& path,
+                               const options::gridfs::download& options) {
+    downloader download_stream = _open_download_stream(session, id, 0, stdx::nullopt, options);
+
+    file_handle destination{std::fopen(path.c_str(), "wb"), &std::fclose};
+    if (!destination) {
+        throw std::ios_base::failure{"could not open " + path + " for writing"};
+    }
+    std::setvbuf(destination.get(), nullptr, _IONBF, 0);
 
-    return downloader{std::move(cursor), *files_doc};
+    for (auto chunk = download_stream.next_chunk(); chunk.size != 0;
+         chunk = download_stream.next_chunk()) {
+        if (std::fwrite(chunk.bytes, 1, chunk.size, destination.get()) != chunk.size) {
+            throw std::ios_base::failure{"could not write " + path};
+        }
+    }
+
+    download_stream.close();
+
+    if (std::fclose(destination.release()) != 0) {
+        throw std::ios_base::failure{"could not write " + path};
+    }
 }
 
-downloader bucket::open_download_stream(bsoncxx::types::value id) {
-    return _open_download_stream(nullptr, id);
+void bucket::download_to_file(bsoncxx::types::value id,
+                              const std::string& path,
+                              const options::gridfs::download& options) {
+    _download_to_file(nullptr, id, path, options);
 }
 
-downloader bucket::open_download_stream(const client_session& session, bsoncxx::types::value id) {
-    return _open_download_stream(&session, id);
+void bucket::download_to_file(const client_session& session,
+                              bsoncxx::types::value id,
+                              const std::string& path,
+                              const options::gridfs::download& options) {
+    _download_to_file(&session, id, path, options);
 }
 
-void bucket::_download_to_stream(const client_session* session,
-                                 bsoncxx::types::value id,
-                                 std::ostream* destination) {
-    downloader download_stream = _open_download_stream(session, id);
-    std::int32_t chunk_size = download_stream.chunk_size();
-    std::unique_ptr<std::uint8_t[]> buffer =
-        stdx::make_unique<std::uint8_t[]>(static_cast<std::size_t>(chunk_size));
-    std::size_t bytes_read;
+std::int64_t bucket::download_to_buffer_parallel(bsoncxx::types::value id,
+                                                 std::uint8_t* destination,
+                                                 std::size_t length,
+                                                 std::uint32_t connections,
+                                                 class pool& pool,
+                                                 const options::gridfs::download& options) {
+    if (connections == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "positive number of connections required for a parallel download"};
+    }
 
-    while ((bytes_read =
-                download_stream.read(buffer.get(), static_cast<std::size_t>(chunk_size))) != 0) {
-        destination->write(reinterpret_cast<char*>(buffer.get()),
-                           static_cast<std::streamsize>(bytes_read));
+    auto chunks_options = chunks_find_options(options);
+    auto files_doc = find_files_document(&_get_impl().files, nullptr, id);
+
+    // The downloader validates the files document without querying any chunk.
+    downloader file{chunks_query(_get_impl().chunks, nullptr, id, chunks_options), files_doc};
+    std::int64_t file_length = file.file_length();
+    std::int64_t chunk_size = file.chunk_size();
+
+    if (static_cast<std::uint64_t>(file_length) > length) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "destination is too small for the GridFS file"};
     }
 
-    download_stream.close();
+    std::int64_t chunk_count = (file_length + chunk_size - 1) / chunk_size;
+    std::int64_t ranges = std::min<std::int64_t>(connections, chunk_count);
+
+    auto database_name = _get_impl().database_name;
+    auto chunks_name = bsoncxx::string::to_string(_get_impl().chunks.name());
+    auto read_concern = _get_impl().chunks.read_concern();
+    auto read_preference = _get_impl().chunks.read_preference();
+
+    std::vector<std::exception_ptr> errors(static_cast<std::size_t>(ranges));
+    auto download_range = [&](std::int64_t range) {
+        try {
+            std::int64_t start = chunk_count * range / ranges * chunk_size;
+            std::int64_t end =
+                std::min(chunk_count * (range + 1) / ranges * chunk_size, file_length);
+
+            auto client = pool.acquire();
+            auto chunks = (*client)[database_name][chunks_name];
+            chunks.read_concern(read_concern);
+            chunks.read_preference(read_preference);
+
+            downloader range_stream{chunks_query(chunks, nullptr, id, chunks_options),
+                                    files_doc,
+                                    start,
+                                    end,
+                                    shared_chunks_query(chunks, nullptr, chunks_options)};
+
+            auto out = destination + start;
+            for (auto chunk = range_stream.next_chunk(); chunk.size != 0;
+                 chunk = range_stream.next_chunk()) {
+                std::memcpy(out, chunk.bytes, chunk.size);
+                out += chunk.size;
+            }
+        } catch (...) {
+            errors[static_cast<std::size_t>(range)] = std::current_exception();
+        }
+    };
+
+    run_parallel(*pool.executor(),
+                 static_cast<std::size_t>(ranges),
+                 static_cast<std::size_t>(ranges),
+                 [&](std::size_t range) { download_range(static_cast<std::int64_t>(range)); });
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return file_length;
 }
 
-void bucket::download_to_stream(bsoncxx::types::value id, std::ostream* destination) {
-    _download_to_stream(nullptr, id, destination);
+namespace {
+
+std::size_t delete_batch_count(std::size_t ids, std::size_t batch_size) {
+    if (batch_size == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "positive batch size required to delete GridFS files"};
+    }
+    return (ids + batch_size - 1) / batch_size;
 }
 
-void bucket::download_to_stream(const client_session& session,
-                                bsoncxx::types::value id,
-                                std::ostream* destination) {
-    _download_to_stream(&session, id, destination);
+// Deletes the files whose ids are in the given batch with one delete on each collection, and adds
+// the number of documents removed to the counts.
+void delete_files_batch(collection& files,
+                        collection& chunks,
+                        const std::vector<bsoncxx::types::value>& ids,
+                        std::size_t batch,
+                        std::size_t batch_size,
+                        std::int64_t* files_deleted,
+                        std::int64_t* chunks_deleted) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    bsoncxx::builder::basic::array batch_ids;
+    auto end = std::min(ids.size(), (batch + 1) * batch_size);
+    for (auto i = batch * batch_size; i < end; ++i) {
+        batch_ids.append(ids[i]);
+    }
+    auto in = make_document(kvp("$in", batch_ids.extract()));
+
+    if (auto result = files.delete_many(make_document(kvp("_id", in.view())))) {
+        *files_deleted += result->deleted_count();
+    }
+    if (auto result = chunks.delete_many(make_document(kvp("files_id", in.view())))) {
+        *chunks_deleted += result->deleted_count();
+    }
+}
+
+}  // namespace
+
+result::gridfs::delete_files bucket::delete_files(const std::vector<bsoncxx::types::value>& ids,
+                                                  std::size_t batch_size) {
+    auto batches = delete_batch_count(ids.size(), batch_size);
+
+    std::int64_t files_deleted = 0;
+    std::int64_t chunks_deleted = 0;
+    for (std::size_t batch = 0; batch < batches; ++batch) {
+        delete_files_batch(_get_impl().files,
+                           _get_impl().chunks,
+                           ids,
+                           batch,
+                           batch_size,
+                           &files_deleted,
+                           &chunks_deleted);
+    }
+
+    return result::gridfs::delete_files{files_deleted, chunks_deleted};
+}
+
+result::gridfs::delete_files bucket::delete_files(const std::vector<bsoncxx::types::value>& ids,
+                                                  std::uint32_t connections,
+                                                  class pool& pool,
+                                                  std::size_t batch_size) {
+    if (connections == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "positive number of connections required for a parallel delete"};
+    }
+
+    auto batches = delete_batch_count(ids.size(), batch_size);
+    auto workers = std::min<std::size_t>(connections, batches);
+
+    auto database_name = _get_impl().database_name;
+    auto files_name = bsoncxx::string::to_string(_get_impl().files.name());
+    auto chunks_name = bsoncxx::string::to_string(_get_impl().chunks.name());
+    auto files_write_concern = _get_impl().files.write_concern();
+    auto chunks_write_concern = _get_impl().chunks.write_concern();
+
+    std::atomic<std::size_t> next_batch{0};
+    std::atomic<std::int64_t> files_deleted{0};
+    std::atomic<std::int64_t> chunks_deleted{0};
+    std::vector<std::exception_ptr> errors(workers);
+    auto delete_batches = [&](std::size_t worker) {
+        std::int64_t worker_files_deleted = 0;
+        std::int64_t worker_chunks_deleted = 0;
+        try {
+            auto client = pool.acquire();
+            auto files = (*client)[database_name][files_name];
+            auto chunks = (*client)[database_name][chunks_name];
+            files.write_concern(files_write_concern);
+            chunks.write_concern(chunks_write_concern);
+
+            for (auto batch = next_batch++; batch < batches; batch = next_batch++) {
+                delete_files_batch(files,
+                                   chunks,
+                                   ids,
+                                   batch,
+                                   batch_size,
+                                   &worker_files_deleted,
+                                   &worker_chunks_deleted);
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            // Leave no batch for the other workers to take.
+            next_batch = batches;
+        }
+        files_deleted += worker_files_deleted;
+        chunks_deleted += worker_chunks_deleted;
+    };
+
+    run_parallel(*pool.executor(), workers, workers, delete_batches);
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return result::gridfs::delete_files{files_deleted.load(), chunks_deleted.load()};
 }
 
 void bucket::_delete_file(const client_session* session, bsoncxx::types::value id) {
@@ -331,13 +787,13 @@ void bucket::delete_file(const client_session& session, bsoncxx::types::value id
 }
 
 cursor bucket::find(bsoncxx::document::view_or_value filter, const options::find& options) {
-    return _get_impl().files.find(filter, options);
+    return _get_impl().files.find(std::move(filter), options);
 }
 
 cursor bucket::find(const client_session& session,
                     bsoncxx::document::view_or_value filter,
                     const options::find& options) {
-    return _get_impl().files.find(session, filter, options);
+    return _get_impl().files.find(session, std::move(filter), options);
 }
 
 stdx::string_view bucket::bucket_name() const {
@@ -349,17 +805,24 @@ void bucket::create_indexes_if_nonexistent(const client_session* session) {
         return;
     }
 
+    const auto bucket_namespace = _get_impl().database_name + "." + _get_impl().bucket_name;
+    if (_get_impl().verified_indexes->contains(bucket_namespace)) {
+        _get_impl().indexes_created = true;
+        return;
+    }
+
     bsoncxx::builder::basic::document filter;
     filter.append(bsoncxx::builder::basic::kvp("_id", 1));
 
     auto find_options =
         options::find{}.projection(filter.view()).read_preference(read_preference{});
 
-    if (session) {
-        if (_get_impl().files.find_one(*session, {}, find_options)) {
-            return;
-        }
-    } else if (_get_impl().files.find_one({}, find_options)) {
+    // A bucket holding files already has its indexes.
+    auto has_files = session ? _get_impl().files.find_one(*session, {}, find_options)
+                             : _get_impl().files.find_one({}, find_options);
+    if (has_files) {
+        _get_impl().indexes_created = true;
+        _get_impl().verified_indexes->insert(bucket_namespace);
         return;
     }
 
@@ -387,6 +850,7 @@ void bucket::create_indexes_if_nonexistent(const client_session* session) {
     }
 
     _get_impl().indexes_created = true;
+    _get_impl().verified_indexes->insert(bucket_namespace);
 }
 
 const bucket::impl& bucket::_get_impl() const {
@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <istream>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include <bsoncxx/document/view_or_value.hpp>
 #include <bsoncxx/stdx/string_view.hpp>
@@ -26,7 +30,9 @@
 #include <mongocxx/gridfs/uploader.hpp>
 #include <mongocxx/options/find.hpp>
 #include <mongocxx/options/gridfs/bucket.hpp>
+#include <mongocxx/options/gridfs/download.hpp>
 #include <mongocxx/options/gridfs/upload.hpp>
+#include <mongocxx/result/gridfs/delete_files.hpp>
 #include <mongocxx/result/gridfs/upload.hpp>
 #include <mongocxx/stdx.hpp>
 
@@ -36,6 +42,7 @@ namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 class database;
+class pool;
 
 namespace gridfs {
 
@@ -432,6 +439,103 @@ class MONGOCXX_API bucket {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Uploads the contents of a file on the local filesystem to the bucket.
+    ///
+    /// Unlike upload_from_stream(), the file is read without any stream or stdio buffering,
+    /// straight into the chunk documents sent to the server.
+    ///
+    /// @param filename
+    ///   The name of the file to be uploaded. A bucket can contain multiple files with the same
+    ///   name.
+    ///
+    /// @param path
+    ///   The path of the file to read from.
+    ///
+    /// @param options
+    ///   Optional arguments; see options::gridfs::upload.
+    ///
+    /// @return
+    ///   The id of the uploaded file.
+    ///
+    /// @note
+    ///   If this GridFS bucket does not already exist in the database, it will be implicitly
+    ///   created and initialized with GridFS indexes.
+    ///
+    /// @throws mongocxx::logic_error if `options` are invalid.
+    ///
+    /// @throws mongocxx::bulk_write_exception
+    ///   if an error occurs when writing chunk data or file metadata to the database.
+    ///
+    /// @throws std::ios_base::failure
+    ///   if the file cannot be opened or read. The chunks already uploaded are deleted.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the uploader requires more than 2^31-1 chunks to store the file at the requested chunk
+    ///   size.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files collection for this bucket.
+    ///
+    /// @throws mongocxx::operation_exception if an error occurs when building GridFS indexes.
+    ///
+    result::gridfs::upload upload_from_file(stdx::string_view filename,
+                                            const std::string& path,
+                                            const options::gridfs::upload& options = {});
+
+    ///
+    /// Uploads the contents of a file on the local filesystem to the bucket.
+    ///
+    /// Unlike upload_from_stream(), the file is read without any stream or stdio buffering,
+    /// straight into the chunk documents sent to the server.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the upload.
+    ///
+    /// @param filename
+    ///   The name of the file to be uploaded. A bucket can contain multiple files with the same
+    ///   name.
+    ///
+    /// @param path
+    ///   The path of the file to read from.
+    ///
+    /// @param options
+    ///   Optional arguments; see options::gridfs::upload.
+    ///
+    /// @return
+    ///   The id of the uploaded file.
+    ///
+    /// @note
+    ///   If this GridFS bucket does not already exist in the database, it will be implicitly
+    ///   created and initialized with GridFS indexes.
+    ///
+    /// @throws mongocxx::logic_error if `options` are invalid.
+    ///
+    /// @throws mongocxx::bulk_write_exception
+    ///   if an error occurs when writing chunk data or file metadata to the database.
+    ///
+    /// @throws std::ios_base::failure
+    ///   if the file cannot be opened or read. The chunks already uploaded are deleted.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the uploader requires more than 2^31-1 chunks to store the file at the requested chunk
+    ///   size.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files collection for this bucket.
+    ///
+    /// @throws mongocxx::operation_exception if an error occurs when building GridFS indexes.
+    ///
+    result::gridfs::upload upload_from_file(const client_session& session,
+                                            stdx::string_view filename,
+                                            const std::string& path,
+                                            const options::gridfs::upload& options = {});
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
@@ -440,16 +544,23 @@ class MONGOCXX_API bucket {
     /// @param id
     ///   The id of the file to read.
     ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
     /// @return
     ///   The gridfs::downloader from which the GridFS file should be read.
     ///
     /// @throws mongocxx::gridfs_exception
     ///   if the requested file does not exist, or if the requested file has been corrupted.
     ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid.
+    ///
     /// @throws mongocxx::query_exception
     ///   if an error occurs when reading from the files collection for this bucket.
     ///
-    downloader open_download_stream(bsoncxx::types::value id);
+    downloader open_download_stream(bsoncxx::types::value id,
+                                    const options::gridfs::download& options = {});
 
     ///
     /// Opens a gridfs::downloader to read a GridFS file.
@@ -461,16 +572,99 @@ class MONGOCXX_API bucket {
     /// @param id
     ///   The id of the file to read.
     ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
     /// @return
     ///   The gridfs::downloader from which the GridFS file should be read.
     ///
     /// @throws mongocxx::gridfs_exception
     ///   if the requested file does not exist, or if the requested file has been corrupted.
     ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid.
+    ///
     /// @throws mongocxx::query_exception
     ///   if an error occurs when reading from the files collection for this bucket.
     ///
-    downloader open_download_stream(const client_session& session, bsoncxx::types::value id);
+    downloader open_download_stream(const client_session& session,
+                                    bsoncxx::types::value id,
+                                    const options::gridfs::download& options = {});
+
+    ///
+    /// Opens a gridfs::downloader to read a range of bytes of a GridFS file.
+    ///
+    /// Only the chunks holding bytes of the range are read from the server, which suits serving
+    /// HTTP range requests, for instance.
+    ///
+    /// @param id
+    ///   The id of the file to read.
+    ///
+    /// @param start_offset
+    ///   The offset of the first byte to read.
+    ///
+    /// @param end_offset
+    ///   The offset one past the last byte to read.
+    ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
+    /// @return
+    ///   The gridfs::downloader from which the range should be read.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the requested file does not exist, or if the requested file has been corrupted.
+    ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid, or if the offsets are not a range within the file.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files collection for this bucket.
+    ///
+    downloader open_download_stream(bsoncxx::types::value id,
+                                    std::int64_t start_offset,
+                                    std::int64_t end_offset,
+                                    const options::gridfs::download& options = {});
+
+    ///
+    /// Opens a gridfs::downloader to read a range of bytes of a GridFS file.
+    ///
+    /// Only the chunks holding bytes of the range are read from the server, which suits serving
+    /// HTTP range requests, for instance.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the download. The client session must
+    ///   remain valid for the lifetime of the downloader.
+    ///
+    /// @param id
+    ///   The id of the file to read.
+    ///
+    /// @param start_offset
+    ///   The offset of the first byte to read.
+    ///
+    /// @param end_offset
+    ///   The offset one past the last byte to read.
+    ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
+    /// @return
+    ///   The gridfs::downloader from which the range should be read.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the requested file does not exist, or if the requested file has been corrupted.
+    ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid, or if the offsets are not a range within the file.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files collection for this bucket.
+    ///
+    downloader open_download_stream(const client_session& session,
+                                    bsoncxx::types::value id,
+                                    std::int64_t start_offset,
+                                    std::int64_t end_offset,
+                                    const options::gridfs::download& options = {});
     ///
     /// @}
     ///
@@ -486,9 +680,15 @@ class MONGOCXX_API bucket {
     /// @param destination
     ///   The non-null stream to which the GridFS file should be written.
     ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
     /// @throws mongocxx::gridfs_exception
     ///   if the requested file does not exist, or if the requested file has been corrupted.
     ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid.
+    ///
     /// @throws mongocxx::query_exception
     ///   if an error occurs when reading from the files or chunks collections for this bucket.
     ///
@@ -497,7 +697,9 @@ class MONGOCXX_API bucket {
     ///   `badbit`, any exception thrown during execution of `destination::write()` will be
     ///   re-thrown.
     ///
-    void download_to_stream(bsoncxx::types::value id, std::ostream* destination);
+    void download_to_stream(bsoncxx::types::value id,
+                            std::ostream* destination,
+                            const options::gridfs::download& options = {});
 
     ///
     /// Downloads the contents of a stored GridFS file from the bucket and writes it to a stream.
@@ -511,9 +713,15 @@ class MONGOCXX_API bucket {
     /// @param destination
     ///   The non-null stream to which the GridFS file should be written.
     ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
     /// @throws mongocxx::gridfs_exception
     ///   if the requested file does not exist, or if the requested file has been corrupted.
     ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid.
+    ///
     /// @throws mongocxx::query_exception
     ///   if an error occurs when reading from the files or chunks collections for this bucket.
     ///
@@ -524,11 +732,133 @@ class MONGOCXX_API bucket {
     ///
     void download_to_stream(const client_session& session,
                             bsoncxx::types::value id,
-                            std::ostream* destination);
+                            std::ostream* destination,
+                            const options::gridfs::download& options = {});
+    ///
+    /// @}
+    ///
+
+    ///
+    /// @{
+    ///
+    /// Downloads the contents of a stored GridFS file from the bucket into a file on the local
+    /// filesystem, replacing it if it exists.
+    ///
+    /// Unlike download_to_stream(), each chunk is written straight from the document received
+    /// from the server, without any stream or stdio buffering.
+    ///
+    /// @param id
+    ///   The id of the file to read.
+    ///
+    /// @param path
+    ///   The path of the file to write to.
+    ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the requested file does not exist, or if the requested file has been corrupted.
+    ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files or chunks collections for this bucket.
+    ///
+    /// @throws std::ios_base::failure
+    ///   if the file cannot be opened or written.
+    ///
+    void download_to_file(bsoncxx::types::value id,
+                          const std::string& path,
+                          const options::gridfs::download& options = {});
+
+    ///
+    /// Downloads the contents of a stored GridFS file from the bucket into a file on the local
+    /// filesystem, replacing it if it exists.
+    ///
+    /// Unlike download_to_stream(), each chunk is written straight from the document received
+    /// from the server, without any stream or stdio buffering.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the download.
+    ///
+    /// @param id
+    ///   The id of the file to read.
+    ///
+    /// @param path
+    ///   The path of the file to write to.
+    ///
+    /// @param options
+    ///   Optional arguments for this operation.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the requested file does not exist, or if the requested file has been corrupted.
+    ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files or chunks collections for this bucket.
+    ///
+    /// @throws std::ios_base::failure
+    ///   if the file cannot be opened or written.
+    ///
+    void download_to_file(const client_session& session,
+                          bsoncxx::types::value id,
+                          const std::string& path,
+                          const options::gridfs::download& options = {});
     ///
     /// @}
     ///
 
+    ///
+    /// Downloads the contents of a stored GridFS file into a buffer over several connections at
+    /// once.
+    ///
+    /// The chunks of the file are split into `connections` contiguous ranges. Each range is read
+    /// by its own cursor, on a client acquired from `pool`, and written straight to its place in
+    /// `destination`. This lets a single large file be downloaded at the combined throughput of
+    /// several connections. `destination` may be any writable memory, such as a memory-mapped
+    /// file.
+    ///
+    /// @param id
+    ///   The id of the file to read.
+    ///
+    /// @param destination
+    ///   The buffer to which the contents of the file should be written.
+    ///
+    /// @param length
+    ///   The size of `destination` in bytes. It must be at least the length of the file.
+    ///
+    /// @param connections
+    ///   The number of ranges to read concurrently.
+    ///
+    /// @param pool
+    ///   The pool from which the clients reading the ranges are acquired. It must be connected to
+    ///   the same deployment as the bucket.
+    ///
+    /// @param options
+    ///   Optional arguments applying to the cursor of each range.
+    ///
+    /// @return
+    ///   The length of the file, which is the number of bytes written to `destination`.
+    ///
+    /// @throws mongocxx::gridfs_exception
+    ///   if the requested file does not exist, or if the requested file has been corrupted.
+    ///
+    /// @throws mongocxx::logic_error
+    ///   if the options are invalid, if `connections` is zero, or if `destination` is too small.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading from the files or chunks collections for this bucket.
+    ///
+    std::int64_t download_to_buffer_parallel(bsoncxx::types::value id,
+                                             std::uint8_t* destination,
+                                             std::size_t length,
+                                             std::uint32_t connections,
+                                             class pool& pool,
+                                             const options::gridfs::download& options = {});
+
     ///
     /// @{
     ///
@@ -563,6 +893,70 @@ class MONGOCXX_API bucket {
     /// @}
     ///
 
+    ///
+    /// @{
+    ///
+    /// Deletes many GridFS files from the bucket.
+    ///
+    /// The ids are split into batches of at most `batch_size`, and each batch is removed with one
+    /// `$in` delete on the files collection followed by one on the chunks collection, rather than
+    /// with two deletes per file. Ids which do not name a stored file are ignored.
+    ///
+    /// @param ids
+    ///   The ids of the files to be deleted.
+    ///
+    /// @param batch_size
+    ///   The largest number of ids sent in a single delete.
+    ///
+    /// @return
+    ///   The number of files documents and chunks documents that were deleted. These are zero
+    ///   when the write concern of the bucket is unacknowledged.
+    ///
+    /// @throws mongocxx::logic_error if `batch_size` is zero.
+    ///
+    /// @throws mongocxx::bulk_write_exception
+    ///   if an error occurs when removing file data or chunk data from the database. The batches
+    ///   that preceded the error remain deleted, but their counts are not reported.
+    ///
+    result::gridfs::delete_files delete_files(const std::vector<bsoncxx::types::value>& ids,
+                                              std::size_t batch_size = 1000);
+
+    ///
+    /// Deletes many GridFS files from the bucket over several connections at once.
+    ///
+    /// The ids are split into batches as by the sequential overload, and the batches are shared
+    /// out among `connections` workers, each deleting on its own client acquired from `pool`.
+    ///
+    /// @param ids
+    ///   The ids of the files to be deleted.
+    ///
+    /// @param connections
+    ///   The largest number of batches deleted concurrently.
+    ///
+    /// @param pool
+    ///   The pool from which the clients of the workers are acquired. It must be connected to the
+    ///   same deployment as the bucket.
+    ///
+    /// @param batch_size
+    ///   The largest number of ids sent in a single delete.
+    ///
+    /// @return
+    ///   The number of files documents and chunks documents that were deleted.
+    ///
+    /// @throws mongocxx::logic_error if `connections` or `batch_size` is zero.
+    ///
+    /// @throws mongocxx::bulk_write_exception
+    ///   if an error occurs when removing file data or chunk data from the database. The workers
+    ///   stop taking new batches after the first error, which is the one thrown.
+    ///
+    result::gridfs::delete_files delete_files(const std::vector<bsoncxx::types::value>& ids,
+                                              std::uint32_t connections,
+                                              class pool& pool,
+                                              std::size_t batch_size = 1000);
+    ///
+    /// @}
+    ///
+
     ///
     /// @{
     ///
@@ -642,11 +1036,26 @@ class MONGOCXX_API bucket {
                                                       const options::gridfs::upload& options);
 
     MONGOCXX_PRIVATE downloader _open_download_stream(const client_session* session,
-                                                      bsoncxx::types::value id);
+                                                      bsoncxx::types::value id,
+                                                      std::int64_t start_offset,
+                                                      stdx::optional<std::int64_t> end_offset,
+                                                      const options::gridfs::download& options);
 
     MONGOCXX_PRIVATE void _download_to_stream(const client_session* session,
                                               bsoncxx::types::value id,
-                                              std::ostream* destination);
+                                              std::ostream* destination,
+                                              const options::gridfs::download& options);
+
+    MONGOCXX_PRIVATE result::gridfs::upload _upload_from_file(
+        const client_session* session,
+        stdx::string_view filename,
+        const std::string& path,
+        const options::gridfs::upload& options);
+
+    MONGOCXX_PRIVATE void _download_to_file(const client_session* session,
+                                            bsoncxx::types::value id,
+                                            const std::string& path,
+                                            const options::gridfs::download& options);
 
     MONGOCXX_PRIVATE void _delete_file(const client_session* session, bsoncxx::types::value id);
 
@@ -30,8 +30,16 @@ namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 namespace gridfs {
 
-downloader::downloader(stdx::optional<cursor> chunks, bsoncxx::document::value files_doc)
-    : _impl{stdx::make_unique<impl>(std::move(chunks), std::move(files_doc))} {}
+downloader::downloader(chunks_query query,
+                       bsoncxx::document::value files_doc,
+                       std::int64_t start_offset,
+                       stdx::optional<std::int64_t> end_offset,
+                       shared_chunks_query shared_query)
+    : _impl{stdx::make_unique<impl>(std::move(query),
+                                    std::move(files_doc),
+                                    start_offset,
+                                    std::move(end_offset),
+                                    std::move(shared_query))} {}
 
 downloader::downloader() noexcept = default;
 downloader::downloader(downloader&&) noexcept = default;
@@ -54,7 +62,7 @@ std::size_t downloader::read(std::uint8_t* buffer, std::size_t length_requested)
     std::size_t bytes_read = 0;
 
     while (length_requested > 0 &&
-           (_get_impl().chunks_seen != _get_impl().file_chunk_count ||
+           (_get_impl().chunks_seen != _get_impl().range_chunk_end ||
             _get_impl().chunk_buffer_offset < _get_impl().chunk_buffer_len)) {
         if (_get_impl().chunk_buffer_offset == _get_impl().chunk_buffer_len) {
             fetch_chunk();
@@ -72,6 +80,44 @@ std::size_t downloader::read(std::uint8_t* buffer, std::size_t length_requested)
     return bytes_read;
 }
 
+downloader::chunk_view downloader::next_chunk() {
+    if (_get_impl().closed) {
+        throw logic_error{error_code::k_gridfs_stream_not_open};
+    }
+
+    if (_get_impl().chunk_buffer_offset == _get_impl().chunk_buffer_len) {
+        if (_get_impl().file_len == 0 ||
+            _get_impl().chunks_seen == _get_impl().range_chunk_end) {
+            return {nullptr, 0};
+        }
+
+        fetch_chunk();
+    }
+
+    chunk_view view{&_get_impl().chunk_buffer_ptr[_get_impl().chunk_buffer_offset],
+                    _get_impl().chunk_buffer_len - _get_impl().chunk_buffer_offset};
+    _get_impl().chunk_buffer_offset = _get_impl().chunk_buffer_len;
+
+    return view;
+}
+
+void downloader::seek(std::int64_t offset) {
+    if (_get_impl().closed) {
+        throw logic_error{error_code::k_gridfs_stream_not_open};
+    }
+
+    // Stay on the current chunk, and its cursor, when the offset falls within it.
+    auto chunk_start = static_cast<std::int64_t>(_get_impl().chunks_seen - 1) *
+                       static_cast<std::int64_t>(_get_impl().chunk_size);
+    if (_get_impl().chunk_buffer_ptr && offset >= chunk_start &&
+        offset <= chunk_start + static_cast<std::int64_t>(_get_impl().chunk_buffer_len)) {
+        _get_impl().chunk_buffer_offset = static_cast<std::size_t>(offset - chunk_start);
+        return;
+    }
+
+    _get_impl().start_at(offset);
+}
+
 void downloader::close() {
     if (_get_impl().closed) {
         throw logic_error{error_code::k_gridfs_stream_not_open};
@@ -94,27 +140,38 @@ bsoncxx::document::view downloader::files_document() const {
 }
 
 void downloader::fetch_chunk() {
-    if (_get_impl().chunks_curr == _get_impl().chunks_end) {
-        std::ostringstream err;
-        err << "expected file to have " << _get_impl().file_chunk_count
-            << " chunk(s), but query to chunks collection only returned " << _get_impl().chunks_seen
-            << " chunk(s)";
-        throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
-    }
+    bsoncxx::document::view chunk_doc;
 
-    if (_get_impl().chunks_seen) {
-        ++(*_get_impl().chunks_curr);
-    }
+    if (_get_impl().manifest) {
+        chunk_doc = _get_impl().shared_chunk(_get_impl().chunks_seen);
+    } else {
+        if (!_get_impl().chunks) {
+            _get_impl().chunks =
+                _get_impl().query(_get_impl().chunks_seen, _get_impl().range_chunk_end);
+            _get_impl().chunks_curr = _get_impl().chunks->begin();
+            _get_impl().chunks_end = _get_impl().chunks->end();
+        } else {
+            ++(*_get_impl().chunks_curr);
+        }
 
-    bsoncxx::document::view chunk_doc = **_get_impl().chunks_curr;
+        if (_get_impl().chunks_curr == _get_impl().chunks_end) {
+            std::ostringstream err;
+            err << "expected file to have " << _get_impl().file_chunk_count
+                << " chunk(s), but query to chunks collection returned no chunk #"
+                << _get_impl().chunks_seen;
+            throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
+        }
 
-    auto chunk_n_ele = chunk_doc["n"];
-    if (!chunk_n_ele || chunk_n_ele.type() != bsoncxx::type::k_int32 ||
-        chunk_n_ele.get_int32().value != _get_impl().chunks_seen) {
-        std::ostringstream err;
-        err << "chunk #" << _get_impl().chunks_seen
-            << ": expected to find field \"n\" with k_int32 type";
-        throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
+        chunk_doc = **_get_impl().chunks_curr;
+
+        auto chunk_n_ele = chunk_doc["n"];
+        if (!chunk_n_ele || chunk_n_ele.type() != bsoncxx::type::k_int32 ||
+            chunk_n_ele.get_int32().value != _get_impl().chunks_seen) {
+            std::ostringstream err;
+            err << "chunk #" << _get_impl().chunks_seen
+                << ": expected to find field \"n\" with k_int32 type";
+            throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
+        }
     }
 
     if (_get_impl().chunks_seen == std::numeric_limits<std::int32_t>::max()) {
@@ -131,36 +188,50 @@ void downloader::fetch_chunk() {
 
     auto binary_data = chunk_data_ele.get_binary();
 
-    if (_get_impl().chunks_seen != _get_impl().file_chunk_count - 1) {
-        if (binary_data.size != static_cast<std::uint32_t>(_get_impl().chunk_size)) {
-            std::ostringstream err;
-            err << "chunk #" << _get_impl().chunks_seen << ": expected size of chunk to be "
-                << _get_impl().chunk_size << " bytes, but actual size of chunk is "
-                << binary_data.size << " bytes";
-            throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
-        }
-    } else {
-        auto expected_size =
-            _get_impl().file_len % static_cast<std::int64_t>(_get_impl().chunk_size);
+    auto expected_size = static_cast<std::int64_t>(_get_impl().chunk_size);
+    if (_get_impl().chunks_seen == _get_impl().file_chunk_count - 1) {
+        expected_size = _get_impl().file_len % static_cast<std::int64_t>(_get_impl().chunk_size);
 
         if (expected_size == 0) {
             expected_size = static_cast<std::int64_t>(_get_impl().chunk_size);
         }
+    }
 
-        if (binary_data.size != static_cast<std::uint32_t>(expected_size)) {
-            std::ostringstream err;
-            err << "chunk #" << _get_impl().chunks_seen << ": expected size of chunk to be "
-                << expected_size << " bytes, but actual size of chunk is " << binary_data.size
-                << " bytes";
-            throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
-        }
+    const std::uint8_t* chunk_bytes = binary_data.bytes;
+    std::size_t chunk_length = binary_data.size;
+
+    // The chunk is decompressed before its size is checked, so a frame that decompresses to too
+    // many bytes is caught by the codec and one that decompresses to too few by the check below.
+    if (_get_impl().compressed) {
+        auto& decompressed = _get_impl().decompressed;
+        decompressed.resize(static_cast<std::size_t>(_get_impl().chunk_size));
+        chunk_length = _get_impl().codec.decompress(
+            binary_data.bytes, binary_data.size, decompressed.data(), decompressed.size());
+        chunk_bytes = decompressed.data();
+    }
+
+    if (chunk_length != static_cast<std::size_t>(expected_size)) {
+        std::ostringstream err;
+        err << "chunk #" << _get_impl().chunks_seen << ": expected size of chunk to be "
+            << expected_size << " bytes, but actual size of chunk is " << chunk_length
+            << " bytes";
+        throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
     }
 
     ++_get_impl().chunks_seen;
 
-    _get_impl().chunk_buffer_ptr = binary_data.bytes;
-    _get_impl().chunk_buffer_len = binary_data.size;
-    _get_impl().chunk_buffer_offset = 0;
+    _get_impl().chunk_buffer_ptr = chunk_bytes;
+    _get_impl().chunk_buffer_len = chunk_length;
+    _get_impl().chunk_buffer_offset = _get_impl().first_chunk_offset;
+    _get_impl().first_chunk_offset = 0;
+
+    // Leave out the bytes of the last chunk of the range that are past its end.
+    if (_get_impl().chunks_seen == _get_impl().range_chunk_end) {
+        auto chunk_start = static_cast<std::int64_t>(_get_impl().chunks_seen - 1) *
+                           static_cast<std::int64_t>(_get_impl().chunk_size);
+        _get_impl().chunk_buffer_len =
+            static_cast<std::size_t>(_get_impl().range_end - chunk_start);
+    }
 }
 
 const downloader::impl& downloader::_get_impl() const {
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include <bsoncxx/document/value.hpp>
@@ -36,6 +37,17 @@ namespace gridfs {
 ///
 class MONGOCXX_API downloader {
    public:
+    ///
+    /// A view of bytes of the file being downloaded, as returned by next_chunk().
+    ///
+    struct chunk_view {
+        // The first byte of the view.
+        const std::uint8_t* bytes;
+
+        // The number of bytes in the view.
+        std::size_t size;
+    };
+
     ///
     /// Default constructs a downloader object. The downloader is equivalent to the state of a moved
     /// from downloader. The only valid actions to take with a default constructed downloader are to
@@ -90,6 +102,45 @@ class MONGOCXX_API downloader {
     ///
     std::size_t read(std::uint8_t* buffer, std::size_t length);
 
+    ///
+    /// Reads the rest of the current chunk of the GridFS file being downloaded without copying it.
+    ///
+    /// The returned view points directly into the data of the chunk as received from the server,
+    /// so the file can be forwarded, for instance to a socket, without an intermediate buffer.
+    /// If read() stopped partway through a chunk, the view holds the bytes of that chunk which it
+    /// has not read. Otherwise the next chunk is fetched and the view holds all of it. Calls to
+    /// read() and next_chunk() can be mixed freely.
+    ///
+    /// @return
+    ///   A view of the bytes read, which remains valid until the next call to read(), next_chunk(),
+    ///   seek() or close(), or the destruction of the downloader. It is empty once the downloader
+    ///   has reached the end of the file.
+    ///
+    /// @throws mongocxx::logic_error if the download stream was already closed.
+    ///
+    /// @throws mongocxx::gridfs_exception if the requested file has been corrupted.
+    ///
+    /// @throws mongocxx::query_exception
+    ///   if an error occurs when reading chunk data from the database for the requested file.
+    ///
+    chunk_view next_chunk();
+
+    ///
+    /// Moves the downloader to a byte offset of the file.
+    ///
+    /// Only the chunks from the one containing `offset` onwards are then read from the server. A
+    /// seek within the chunk currently being read needs no round trip.
+    ///
+    /// @param offset
+    ///   The offset of the next byte to read, at most the end of the range being downloaded: the
+    ///   end offset given to bucket::open_download_stream, or the length of the file.
+    ///
+    /// @throws mongocxx::logic_error
+    ///   if the download stream was already closed, or if `offset` is negative or past the end of
+    ///   the range being downloaded.
+    ///
+    void seek(std::int64_t offset);
+
     ///
     /// Closes the downloader stream.
     ///
@@ -124,17 +175,44 @@ class MONGOCXX_API downloader {
    private:
     friend class bucket;
 
+    //
+    // Runs the query for the chunks of the file numbered from `first` up to but excluding `last`,
+    // in order.
+    //
+    using chunks_query = std::function<cursor(std::int32_t first, std::int32_t last)>;
+
+    //
+    // Runs a query for the shared chunks of a deduplicated file, which match `filter`, in any
+    // order.
+    //
+    using shared_chunks_query = std::function<cursor(bsoncxx::document::view filter)>;
+
     //
     // Constructs a new downloader stream.
     //
-    // @param chunks
-    //   The cursor to read the chunks of the file from. It must have a value if the length of the
-    //   file is non-zero.
+    // @param query
+    //   The query used to read the chunks of the file, starting from the first chunk needed.
     //
     // @param files_doc
     //   The files collection document of the file being downloaded.
     //
-    MONGOCXX_PRIVATE downloader(stdx::optional<cursor> chunks, bsoncxx::document::value files_doc);
+    // @param start_offset
+    //   The offset of the first byte to read.
+    //
+    // @param end_offset
+    //   The offset one past the last byte to read, or the file length if not set.
+    //
+    // @param shared_query
+    //   The query used to read the shared chunks of a file whose files document has a chunk
+    //   manifest.
+    //
+    // @throws mongocxx::logic_error if the offsets are not a range within the file.
+    //
+    MONGOCXX_PRIVATE downloader(chunks_query query,
+                                bsoncxx::document::value files_doc,
+                                std::int64_t start_offset = 0,
+                                stdx::optional<std::int64_t> end_offset = {},
+                                shared_chunks_query shared_query = {});
 
     MONGOCXX_PRIVATE void fetch_chunk();
 
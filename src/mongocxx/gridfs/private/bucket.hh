@@ -15,10 +15,15 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+#include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
 #include <mongocxx/gridfs/bucket.hpp>
+#include <mongocxx/gridfs/private/index_cache.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -28,15 +33,31 @@ namespace gridfs {
 
 class bucket::impl {
    public:
-    impl(std::string bucket_name,
+    impl(database db,
+         std::string database_name,
+         std::string bucket_name,
          std::int32_t default_chunk_size_bytes,
          collection chunks,
-         collection files)
-        : bucket_name{std::move(bucket_name)},
+         collection files,
+         std::shared_ptr<index_cache> verified_indexes)
+        : db{std::move(db)},
+          database_name{std::move(database_name)},
+          bucket_name{std::move(bucket_name)},
           default_chunk_size_bytes{default_chunk_size_bytes},
           chunks{std::move(chunks)},
           files{std::move(files)},
-          indexes_created{false} {}
+          indexes_created{false},
+          verified_indexes{std::move(verified_indexes)} {}
+
+    // Gets the size of a batch of chunks to use when options::gridfs::upload::max_batch_bytes()
+    // is not set, asking the server for its maxMessageSizeBytes the first time.
+    std::int32_t default_max_batch_bytes();
+
+    // The database containing the bucket.
+    database db;
+
+    // The name of the database containing the bucket.
+    std::string database_name;
 
     // The name of the bucket.
     std::string bucket_name;
@@ -52,6 +73,12 @@ class bucket::impl {
 
     // Whether the required indexes have been created.
     bool indexes_created;
+
+    // The buckets whose indexes have been verified through the client of `db`.
+    std::shared_ptr<index_cache> verified_indexes;
+
+    // The maxMessageSizeBytes reported by the server, once it has been asked for.
+    stdx::optional<std::int32_t> max_message_size_bytes;
 };
 
 }  // namespace gridfs
@@ -14,10 +14,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include <bsoncxx/string/to_string.hpp>
+
+#include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/gridfs_exception.hpp>
+#include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/gridfs/downloader.hpp>
+#include <mongocxx/gridfs/private/shared_chunks.hh>
+#include <mongocxx/private/zstd_codec.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -79,24 +90,93 @@ std::int32_t read_chunk_size_from_files_document(bsoncxx::document::view files_d
 
     return static_cast<std::int32_t>(chunk_size);
 }
+
+// Whether the chunks of the file are compressed with zstd, per the "compression" subdocument of its
+// files document.
+bool read_compression_from_files_document(bsoncxx::document::view files_doc) {
+    auto compression_ele = files_doc["compression"];
+    if (!compression_ele) {
+        return false;
+    }
+
+    if (compression_ele.type() != bsoncxx::type::k_document ||
+        compression_ele["codec"].type() != bsoncxx::type::k_utf8) {
+        throw gridfs_exception{error_code::k_gridfs_file_corrupted,
+                               "expected files document field \"compression\" to be a document "
+                               "with field \"codec\" of type k_utf8"};
+    }
+
+    auto codec = compression_ele["codec"].get_utf8().value;
+    if (codec != stdx::string_view{"zstd"}) {
+        std::ostringstream err;
+        err << "files document names unknown compression codec: " << codec;
+        throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
+    }
+
+    if (!zstd_codec::supported()) {
+        throw gridfs_exception{error_code::k_compression_not_supported,
+                               "the file's chunks are compressed with zstd"};
+    }
+
+    return true;
+}
+
+// The digests of the shared chunks of a deduplicated file, in order, if its files document has a
+// "chunkManifest" array.
+stdx::optional<std::vector<std::string>> read_manifest_from_files_document(
+    bsoncxx::document::view files_doc, std::int32_t file_chunk_count) {
+    auto manifest_ele = files_doc["chunkManifest"];
+    if (!manifest_ele) {
+        return stdx::nullopt;
+    }
+
+    if (manifest_ele.type() != bsoncxx::type::k_array) {
+        throw gridfs_exception{error_code::k_gridfs_file_corrupted,
+                               "expected files document field \"chunkManifest\" to be an array"};
+    }
+
+    std::vector<std::string> manifest;
+    for (auto&& digest : manifest_ele.get_array().value) {
+        if (digest.type() != bsoncxx::type::k_utf8) {
+            throw gridfs_exception{error_code::k_gridfs_file_corrupted,
+                                   "expected \"chunkManifest\" to contain k_utf8 digests"};
+        }
+        manifest.push_back(bsoncxx::string::to_string(digest.get_utf8().value));
+    }
+
+    if (manifest.size() != static_cast<std::size_t>(file_chunk_count)) {
+        std::ostringstream err;
+        err << "expected \"chunkManifest\" to list " << file_chunk_count
+            << " chunk(s), but it lists " << manifest.size();
+        throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
+    }
+
+    return manifest;
+}
 }  // namespace
 
 class downloader::impl {
    public:
-    impl(stdx::optional<cursor> chunks_param, bsoncxx::document::value files_doc_param)
+    impl(chunks_query query_param,
+         bsoncxx::document::value files_doc_param,
+         std::int64_t start_offset,
+         stdx::optional<std::int64_t> end_offset,
+         shared_chunks_query shared_query_param)
         : files_doc{std::move(files_doc_param)},
           chunk_buffer_len{0},
           chunk_buffer_offset{0},
           chunk_buffer_ptr{nullptr},
-          chunks{chunks_param ? std::move(chunks_param) : stdx::nullopt},
-          chunks_curr{chunks ? stdx::make_optional<cursor::iterator>(chunks->begin())
-                             : stdx::nullopt},
-          chunks_end{chunks ? stdx::make_optional<cursor::iterator>(chunks->end()) : stdx::nullopt},
+          query{std::move(query_param)},
+          shared_query{std::move(shared_query_param)},
           chunks_seen{0},
           chunk_size{read_chunk_size_from_files_document(files_doc.view())},
           closed{false},
           file_chunk_count{0},
-          file_len{read_length_from_files_document(files_doc.view())} {
+          file_len{read_length_from_files_document(files_doc.view())},
+          compressed{read_compression_from_files_document(files_doc.view())},
+          range_end{end_offset.value_or(file_len)},
+          range_chunk_end{0},
+          first_chunk_offset{0} {
         if (chunk_size) {
             std::lldiv_t num_chunks_div = std::lldiv(file_len, chunk_size);
             if (num_chunks_div.rem) {
@@ -113,12 +193,90 @@ class downloader::impl {
 
             file_chunk_count = static_cast<std::int32_t>(num_chunks_div.quot);
         }
+
+        manifest = read_manifest_from_files_document(files_doc.view(), file_chunk_count);
+
+        if (range_end < 0 || range_end > file_len) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "end offset of GridFS download range is outside of the file"};
+        }
+
+        start_at(start_offset);
+    }
+
+    // Gets the shared chunk that is chunk number `n` of a deduplicated file. When it is not among
+    // the shared chunks last read, the distinct shared chunks of the next 16 MiB of the range
+    // are read with a single query.
+    bsoncxx::document::view shared_chunk(std::int32_t n) {
+        const auto& digest = (*manifest)[static_cast<std::size_t>(n)];
+
+        auto found = shared_chunks.find(digest);
+        if (found == shared_chunks.end()) {
+            constexpr std::int32_t k_window_bytes = 16 * 1024 * 1024;
+            auto window_end =
+                std::min(range_chunk_end, n + std::max(k_window_bytes / chunk_size, 1));
+
+            std::unordered_set<std::string> digests{manifest->begin() + n,
+                                                    manifest->begin() + window_end};
+
+            // Only the shared chunks encoded the way this file's chunks are can be read for it.
+            auto filter =
+                shared_chunks::filter(digests.begin(), digests.end(), compressed ? "zstd" : "");
+
+            shared_chunks.clear();
+            for (auto&& chunk : shared_query(filter.view())) {
+                auto files_id = chunk["files_id"];
+                if (files_id.type() != bsoncxx::type::k_document ||
+                    files_id["sha256"].type() != bsoncxx::type::k_utf8) {
+                    continue;
+                }
+                shared_chunks.emplace(
+                    bsoncxx::string::to_string(files_id["sha256"].get_utf8().value),
+                    bsoncxx::document::value{chunk});
+            }
+
+            found = shared_chunks.find(digest);
+            if (found == shared_chunks.end()) {
+                std::ostringstream err;
+                err << "chunk #" << n << ": query to chunks collection returned no shared chunk "
+                    << digest;
+                throw gridfs_exception{error_code::k_gridfs_file_corrupted, err.str()};
+            }
+        }
+
+        return found->second.view();
+    }
+
+    // Positions the downloader so that the next byte read is at `offset`, dropping the chunks
+    // cursor so that the next chunk is read by a new query starting from the chunk needed.
+    void start_at(std::int64_t offset) {
+        if (offset < 0 || offset > range_end) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "offset is outside of the GridFS download range"};
+        }
+
+        chunks_curr = stdx::nullopt;
+        chunks_end = stdx::nullopt;
+        chunks = stdx::nullopt;
+
+        chunk_buffer_len = 0;
+        chunk_buffer_offset = 0;
+        chunk_buffer_ptr = nullptr;
+
+        chunks_seen = static_cast<std::int32_t>(offset / chunk_size);
+        first_chunk_offset = static_cast<std::size_t>(offset % chunk_size);
+
+        // The chunks past the one holding the end of the range are never needed.
+        range_chunk_end = chunks_seen;
+        if (offset < range_end) {
+            range_chunk_end = static_cast<std::int32_t>((range_end + chunk_size - 1) / chunk_size);
+        }
     }
 
     // The files document for the file being downloaded.
     bsoncxx::document::value files_doc;
 
-    // The number of bytes in the current chunk.
+    // The number of bytes in the current chunk that are part of the range being downloaded.
     std::size_t chunk_buffer_len;
 
     // The offset from `chunk_buffer_ptr` to the next byte to be read.
@@ -127,19 +285,29 @@ class downloader::impl {
     // A pointer to the current chunk being read.
     const uint8_t* chunk_buffer_ptr;
 
-    // A cursor iterating over the chunks documents being read. In the case of a zero-length file,
-    // this member does not have a value.
+    // Runs the query for the chunks of the file.
+    chunks_query query;
+
+    // Runs the query for the shared chunks of a deduplicated file.
+    shared_chunks_query shared_query;
+
+    // The digests of the shared chunks of a deduplicated file, if it is one, in order.
+    stdx::optional<std::vector<std::string>> manifest;
+
+    // The shared chunks last read, by digest.
+    std::unordered_map<std::string, bsoncxx::document::value> shared_chunks;
+
+    // A cursor iterating over the chunks documents being read. It does not have a value until the
+    // first chunk after the downloader is positioned is needed.
     stdx::optional<cursor> chunks;
 
-    // An iterator to the current chunk document. In the case of a zero-length file, this member
-    // does not have a value.
+    // An iterator to the current chunk document. It has a value whenever `chunks` has one.
     stdx::optional<cursor::iterator> chunks_curr;
 
-    // An iterator to the end of `chunks`. In the case of a zero-length file, this member does not
-    // have a value.
+    // An iterator to the end of `chunks`. It has a value whenever `chunks` has one.
     stdx::optional<cursor::iterator> chunks_end;
 
-    // The number of chunks already downloaded from the server.
+    // The number of the next chunk to download from the server.
     std::int32_t chunks_seen;
 
     // The size of a chunk in bytes.
@@ -153,6 +321,24 @@ class downloader::impl {
 
     // The total length of the file in bytes.
     std::int64_t file_len;
+
+    // Whether the data of each chunk is compressed with zstd.
+    bool compressed;
+
+    // Decompresses the chunks of a compressed file.
+    zstd_codec codec;
+
+    // The decompressed bytes of the current chunk of a compressed file.
+    std::vector<std::uint8_t> decompressed;
+
+    // The offset one past the last byte of the range being downloaded.
+    std::int64_t range_end;
+
+    // The number one past the last chunk holding bytes of the range from the current position.
+    std::int32_t range_chunk_end;
+
+    // The offset of the next byte to read within the next chunk fetched.
+    std::size_t first_chunk_offset;
 };
 
 }  // namespace gridfs
@@ -0,0 +1,54 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace gridfs {
+
+//
+// The namespaces of the buckets whose indexes are known to exist, shared by the buckets of a
+// client, or of every client of a pool, so that a bucket created per request does not check the
+// indexes again before its first upload. A bucket whose collections are dropped after its indexes
+// were verified is not checked again until the client or pool is destroyed.
+//
+class index_cache {
+   public:
+    bool contains(const std::string& bucket_namespace) const {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _verified.count(bucket_namespace) != 0;
+    }
+
+    void insert(std::string bucket_namespace) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _verified.insert(std::move(bucket_namespace));
+    }
+
+   private:
+    mutable std::mutex _mutex;
+    std::unordered_set<std::string> _verified;
+};
+
+}  // namespace gridfs
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,76 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace gridfs {
+namespace shared_chunks {
+
+//
+// The chunks of a deduplicated upload are stored once per bucket, in the chunks collection, as
+// chunk number 0 of a files_id naming the SHA-256 digest of their bytes. The unique index on
+// files_id and n therefore also keeps concurrent uploads from storing a chunk twice.
+//
+// The digest is that of the uncompressed bytes, so a chunk stored compressed also names its codec
+// in the files_id: uploads with and without compression each share their own copy, and a reader
+// only ever finds chunks encoded the way its files document says.
+//
+
+// The files_id of the shared chunk with the given hexadecimal SHA-256 digest, stored with `codec`,
+// or uncompressed if `codec` is empty.
+inline bsoncxx::document::value files_id(const std::string& digest, stdx::string_view codec) {
+    using bsoncxx::builder::basic::kvp;
+
+    bsoncxx::builder::basic::document id;
+    id.append(kvp("sha256", digest));
+    if (!codec.empty()) {
+        id.append(kvp("codec", codec));
+    }
+    return id.extract();
+}
+
+// A filter matching the shared chunks stored with `codec` with the digests from `first` to `last`.
+template <typename digest_iterator>
+bsoncxx::document::value filter(digest_iterator first,
+                                digest_iterator last,
+                                stdx::string_view codec) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    bsoncxx::builder::basic::array ids;
+    for (; first != last; ++first) {
+        ids.append(files_id(*first, codec));
+    }
+    return make_document(kvp("files_id", make_document(kvp("$in", ids.extract()))));
+}
+
+}  // namespace shared_chunks
+}  // namespace gridfs
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
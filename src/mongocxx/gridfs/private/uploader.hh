@@ -14,12 +14,23 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/document/value.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/stdx/optional.hpp>
 #include <bsoncxx/string/to_string.hpp>
 #include <mongocxx/gridfs/uploader.hpp>
+#include <mongocxx/private/checksum.hh>
+#include <mongocxx/private/executor.hh>
+#include <mongocxx/private/zstd_codec.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -35,9 +46,13 @@ class uploader::impl {
          collection files,
          collection chunks,
          std::int32_t chunk_size,
-         stdx::optional<bsoncxx::document::value> metadata)
+         stdx::optional<bsoncxx::document::value> metadata,
+         std::size_t max_batch_length,
+         class pool* pool,
+         std::string database_name,
+         std::uint32_t parallelism)
         : session{session},
-          buffer{stdx::make_unique<std::uint8_t[]>(static_cast<size_t>(chunk_size))},
+          buffer{nullptr, &delete_chunk},
           buffer_off{0},
           chunks{std::move(chunks)},
           chunk_size{chunk_size},
@@ -46,17 +61,58 @@ class uploader::impl {
           filename{bsoncxx::string::to_string(filename)},
           files{std::move(files)},
           metadata{std::move(metadata)},
-          result{std::move(result)} {}
+          result{std::move(result)},
+          max_batch_length{max_batch_length},
+          pool{pool},
+          database_name{std::move(database_name)},
+          parallelism{parallelism} {}
+
+    // Waits for the chunk batches still in flight, which use the pool and the chunks collection.
+    ~impl() {
+        for (auto&& batch : chunks_in_flight) {
+            try {
+                batch->wait();
+            } catch (...) {
+            }
+        }
+    }
 
     // Client session to use for upload operations.
     const client_session* session;
 
-    // Bytes that have been written for the current chunk.
-    std::unique_ptr<std::uint8_t[]> buffer;
+    // Gets the data field of the chunk document being written, allocating the document and
+    // writing its other fields first if it has not been started.
+    std::uint8_t* chunk_data();
 
-    // The offset from `buffer` to the next byte to be written.
+    // Completes the chunk document being written as chunk number `n` and takes ownership of it.
+    bsoncxx::document::value take_chunk(std::int32_t n);
+
+    // Appends chunk number `n` and the bytes of the chunk being written, compressed if requested,
+    // to a chunk document that already has its files_id, leaving the buffer in place for the next
+    // chunk.
+    bsoncxx::document::value build_chunk(bsoncxx::builder::basic::document* chunk,
+                                         std::int32_t n);
+
+    // The codec named in the files_id of the shared chunks this upload stores, or empty if they
+    // are stored uncompressed.
+    stdx::string_view shared_chunks_codec() const {
+        return compress ? "zstd" : "";
+    }
+
+    static void delete_chunk(std::uint8_t* chunk) {
+        delete[] chunk;
+    }
+
+    // The chunk document being written, allocated with room for a full chunk. Written bytes are
+    // copied straight into its data field so that no further copy is needed to finish the chunk.
+    bsoncxx::document::value::unique_ptr_type buffer;
+
+    // The number of bytes that have been written for the current chunk.
     std::size_t buffer_off;
 
+    // The encoded files_id element, which starts every chunk document.
+    std::vector<std::uint8_t> files_id_element;
+
     // The collection to which the chunks will be written.
     collection chunks;
 
@@ -83,6 +139,44 @@ class uploader::impl {
 
     // Contains the id of the file being written.
     result::gridfs::upload result;
+
+    // The most chunks sent to the server in a single insert.
+    std::size_t max_batch_length;
+
+    // The pool used to insert chunk batches in the background, if any.
+    class pool* pool;
+
+    // The name of the database containing the chunks collection.
+    std::string database_name;
+
+    // The most chunk batches inserted in the background at once.
+    std::uint32_t parallelism;
+
+    // The chunk batches being inserted in the background, oldest first.
+    std::deque<std::shared_ptr<submitted_task>> chunks_in_flight;
+
+    // The checksums being computed over the bytes written so far, if requested.
+    stdx::optional<checksum::sha256> sha256;
+    stdx::optional<checksum::crc32c> crc32c;
+
+    // Whether chunks are compressed with zstd before they are stored, and at which level.
+    bool compress = false;
+    std::int32_t compression_level = 0;
+    zstd_codec codec;
+
+    // The compressed data of the chunk being finished, reused from one chunk to the next.
+    std::vector<std::uint8_t> compressed;
+
+    // The total length of the compressed data of the chunks written so far.
+    std::int64_t compressed_length = 0;
+
+    // Whether chunks are stored as shared chunks, and the digests of the chunks written so far,
+    // which become the manifest of the file.
+    bool deduplicate = false;
+    std::vector<std::string> manifest;
+
+    // The digests of the shared chunks this upload has already queued, which are not queued again.
+    std::unordered_set<std::string> shared_chunks_queued;
 };
 
 }  // namespace gridfs
@@ -17,26 +17,121 @@
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <exception>
+#include <functional>
 #include <iomanip>
 #include <ios>
 #include <limits>
 #include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/string/to_string.hpp>
 #include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/bulk_write_exception.hpp>
 #include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/gridfs_exception.hpp>
 #include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/executor.hpp>
+#include <mongocxx/gridfs/private/shared_chunks.hh>
 #include <mongocxx/gridfs/private/uploader.hh>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/options/insert.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/libbson.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
 namespace {
-std::size_t chunks_collection_documents_max_length(std::size_t chunk_size) {
-    // 16 * 1000 * 1000 is used instead of 16 * 1024 * 1024 to ensure that the command document sent
-    // to the server has space for the other fields.
-    return 16 * 1000 * 1000 / chunk_size;
+// The sizes of the "n" element, and of the "data" element up to its bytes, of a chunk document.
+constexpr std::size_t k_n_element_length = 1 + sizeof("n") + sizeof(std::int32_t);
+constexpr std::size_t k_data_header_length = 1 + sizeof("data") + sizeof(std::int32_t) + 1;
+
+void write_int32(std::uint8_t* dest, std::int32_t value) {
+    std::uint32_t le = BSON_UINT32_TO_LE(static_cast<std::uint32_t>(value));
+    std::memcpy(dest, &le, sizeof(le));
+}
+
+// Whether every write error of a failed insert is a duplicate key error.
+bool only_duplicate_keys(const mongocxx::bulk_write_exception& e) {
+    if (!e.raw_server_error()) {
+        return false;
+    }
+
+    auto reply = e.raw_server_error()->view();
+    auto write_errors = reply["writeErrors"];
+    if (!write_errors || write_errors.type() != bsoncxx::type::k_array ||
+        reply["writeConcernError"]) {
+        return false;
+    }
+
+    for (auto&& error : write_errors.get_array().value) {
+        auto code = error.get_document().value["code"];
+        if (!code || code.type() != bsoncxx::type::k_int32 || code.get_int32().value != 11000) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Inserts the shared chunks that the chunks collection does not hold yet, as found by a single
+// query for their digests. A chunk inserted concurrently by another upload between the query and
+// the insert fails with a duplicate key, which is ignored as the chunk is stored either way.
+void insert_shared_chunks(mongocxx::collection* chunks,
+                          const mongocxx::client_session* session,
+                          mongocxx::stdx::string_view codec,
+                          const std::vector<bsoncxx::document::value>& docs) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+    using namespace mongocxx;
+
+    std::vector<std::string> digests;
+    for (auto&& doc : docs) {
+        digests.push_back(
+            bsoncxx::string::to_string(doc.view()["files_id"]["sha256"].get_utf8().value));
+    }
+
+    auto filter = gridfs::shared_chunks::filter(digests.begin(), digests.end(), codec);
+    options::find find_options;
+    find_options.projection(make_document(kvp("_id", 0), kvp("files_id", 1)));
+
+    std::unordered_set<std::string> stored;
+    auto found = session ? chunks->find(*session, filter.view(), find_options)
+                         : chunks->find(filter.view(), find_options);
+    for (auto&& doc : found) {
+        stored.insert(bsoncxx::string::to_string(doc["files_id"]["sha256"].get_utf8().value));
+    }
+
+    std::vector<bsoncxx::document::view> missing;
+    for (std::size_t i = 0; i < docs.size(); i++) {
+        if (!stored.count(digests[i])) {
+            missing.push_back(docs[i].view());
+        }
+    }
+
+    if (missing.empty()) {
+        return;
+    }
+
+    options::insert insert_options;
+    insert_options.ordered(false);
+    try {
+        if (session) {
+            chunks->insert_many(*session, missing, insert_options);
+        } else {
+            chunks->insert_many(missing, insert_options);
+        }
+    } catch (const bulk_write_exception& e) {
+        if (!only_duplicate_keys(e)) {
+            throw;
+        }
+    }
 }
 }  // namespace
 
@@ -50,7 +145,15 @@ uploader::uploader(const client_session* session,
                    collection files,
                    collection chunks,
                    std::int32_t chunk_size,
-                   stdx::optional<bsoncxx::document::view_or_value> metadata)
+                   stdx::optional<bsoncxx::document::view_or_value> metadata,
+                   std::int32_t max_batch_bytes,
+                   class pool* pool,
+                   std::string database_name,
+                   std::uint32_t parallelism,
+                   stdx::optional<options::gridfs::upload::checksum_algorithm> checksum,
+                   stdx::optional<options::gridfs::upload::compression_algorithm> compression,
+                   std::int32_t compression_level,
+                   bool deduplicate_chunks)
     : _impl{stdx::make_unique<impl>(session,
                                     id,
                                     filename,
@@ -59,7 +162,34 @@ uploader::uploader(const client_session* session,
                                     chunk_size,
                                     metadata ? stdx::make_optional<bsoncxx::document::value>(
                                                    bsoncxx::document::value{metadata->view()})
-                                             : stdx::nullopt)} {}
+                                             : stdx::nullopt,
+                                    std::max<std::size_t>(
+                                        static_cast<std::size_t>(max_batch_bytes / chunk_size), 1),
+                                    pool,
+                                    std::move(database_name),
+                                    parallelism)} {
+    using bsoncxx::builder::basic::kvp;
+
+    // Every chunk document starts with the same files_id element, so encode it once up front.
+    bsoncxx::builder::basic::document files_id;
+    files_id.append(kvp("files_id", _impl->result.id()));
+    auto view = files_id.view();
+    _impl->files_id_element.assign(view.data() + sizeof(std::int32_t),
+                                   view.data() + view.length() - 1);
+
+    if (checksum == options::gridfs::upload::checksum_algorithm::k_sha256) {
+        _impl->sha256.emplace();
+    } else if (checksum == options::gridfs::upload::checksum_algorithm::k_crc32c) {
+        _impl->crc32c.emplace();
+    }
+
+    if (compression == options::gridfs::upload::compression_algorithm::k_zstd) {
+        _impl->compress = true;
+        _impl->compression_level = compression_level;
+    }
+
+    _impl->deduplicate = deduplicate_chunks;
+}
 
 uploader::uploader() noexcept = default;
 uploader::uploader(uploader&&) noexcept = default;
@@ -75,19 +205,19 @@ void uploader::write(const std::uint8_t* bytes, std::size_t length) {
         throw logic_error{error_code::k_gridfs_stream_not_open};
     }
 
+    // Bytes are copied once, straight into the data field of the chunk document being written, and
+    // a chunk is finished as soon as it is full. A write of whole chunks starting at a chunk
+    // boundary is therefore turned into chunk documents without ever being buffered.
     while (length > 0) {
-        std::size_t buffer_free_space =
-            static_cast<std::size_t>(_get_impl().chunk_size) - _get_impl().buffer_off;
-
-        if (buffer_free_space == 0) {
-            finish_chunk();
-        }
+        std::size_t buffer_free_space;
+        auto buffer = chunk_space(&buffer_free_space);
 
         std::size_t length_written = std::min(length, buffer_free_space);
-        std::memcpy(&_get_impl().buffer.get()[_get_impl().buffer_off], bytes, length_written);
+        std::memcpy(buffer, bytes, length_written);
         bytes = &bytes[length_written];
-        _get_impl().buffer_off += length_written;
         length -= length_written;
+
+        commit_chunk_space(length_written);
     }
 }
 
@@ -108,6 +238,7 @@ result::gridfs::upload uploader::close() {
 
     finish_chunk();
     flush_chunks();
+    wait_for_chunks(0);
 
     file.append(kvp("_id", _get_impl().result.id()));
     file.append(kvp("length", bytes_uploaded + leftover));
@@ -119,6 +250,30 @@ result::gridfs::upload uploader::close() {
         file.append(kvp("metadata", *_get_impl().metadata));
     }
 
+    if (_get_impl().sha256) {
+        file.append(kvp("sha256", _get_impl().sha256->hex_digest()));
+    }
+
+    if (_get_impl().crc32c) {
+        file.append(kvp("crc32c", _get_impl().crc32c->hex_digest()));
+    }
+
+    if (_get_impl().deduplicate) {
+        file.append(kvp("chunkManifest", [&](bsoncxx::builder::basic::sub_array manifest) {
+            for (auto&& digest : _get_impl().manifest) {
+                manifest.append(digest);
+            }
+        }));
+    }
+
+    if (_get_impl().compress) {
+        file.append(kvp("compression", [&](bsoncxx::builder::basic::sub_document compression) {
+            compression.append(kvp("codec", "zstd"),
+                               kvp("level", _get_impl().compression_level),
+                               kvp("compressedLength", _get_impl().compressed_length));
+        }));
+    }
+
     if (_get_impl().session) {
         _get_impl().files.insert_one(*_get_impl().session, file.extract());
     } else {
@@ -135,6 +290,13 @@ void uploader::abort() {
 
     _get_impl().closed = true;
 
+    // Let the background inserts finish so that none of their chunks outlive the deletion; their
+    // errors no longer matter.
+    try {
+        wait_for_chunks(0);
+    } catch (const mongocxx::exception&) {
+    }
+
     bsoncxx::builder::basic::document filter;
     filter.append(bsoncxx::builder::basic::kvp("files_id", _get_impl().result.id()));
 
@@ -149,6 +311,33 @@ std::int32_t uploader::chunk_size() const {
     return _get_impl().chunk_size;
 }
 
+std::uint8_t* uploader::chunk_space(std::size_t* length) {
+    if (_get_impl().closed) {
+        throw logic_error{error_code::k_gridfs_stream_not_open};
+    }
+
+    *length = static_cast<std::size_t>(_get_impl().chunk_size) - _get_impl().buffer_off;
+    return _get_impl().chunk_data() + _get_impl().buffer_off;
+}
+
+void uploader::commit_chunk_space(std::size_t length) {
+    // The committed bytes are hashed where they already lie in the chunk document, while they are
+    // still likely to be in cache.
+    auto committed = _get_impl().chunk_data() + _get_impl().buffer_off;
+    if (_get_impl().sha256) {
+        _get_impl().sha256->update(committed, length);
+    }
+    if (_get_impl().crc32c) {
+        _get_impl().crc32c->update(committed, length);
+    }
+
+    _get_impl().buffer_off += length;
+
+    if (_get_impl().buffer_off == static_cast<std::size_t>(_get_impl().chunk_size)) {
+        finish_chunk();
+    }
+}
+
 void uploader::finish_chunk() {
     using bsoncxx::builder::basic::kvp;
 
@@ -156,34 +345,40 @@ void uploader::finish_chunk() {
         return;
     }
 
-    bsoncxx::builder::basic::document chunk;
-
-    std::size_t bytes_in_chunk = _get_impl().buffer_off;
-
-    chunk.append(kvp("files_id", _get_impl().result.id()));
-    chunk.append(kvp("n", _get_impl().chunks_written));
-
     if (_get_impl().chunks_written == std::numeric_limits<std::int32_t>::max()) {
         throw gridfs_exception{error_code::k_gridfs_upload_requires_too_many_chunks};
     }
 
+    if (_get_impl().deduplicate) {
+        checksum::sha256 digest;
+        digest.update(_get_impl().chunk_data(), _get_impl().buffer_off);
+        _get_impl().manifest.push_back(digest.hex_digest());
+
+        const auto& hash = _get_impl().manifest.back();
+        if (_get_impl().shared_chunks_queued.insert(hash).second) {
+            bsoncxx::builder::basic::document chunk;
+            chunk.append(
+                kvp("files_id", shared_chunks::files_id(hash, _get_impl().shared_chunks_codec())));
+            _get_impl().chunks_collection_documents.push_back(
+                _get_impl().build_chunk(&chunk, 0));
+        }
+    } else if (_get_impl().compress) {
+        bsoncxx::builder::basic::document chunk;
+        chunk.append(kvp("files_id", _get_impl().result.id()));
+        _get_impl().chunks_collection_documents.push_back(
+            _get_impl().build_chunk(&chunk, _get_impl().chunks_written));
+    } else {
+        _get_impl().chunks_collection_documents.push_back(
+            _get_impl().take_chunk(_get_impl().chunks_written));
+    }
     ++_get_impl().chunks_written;
-
-    bsoncxx::types::b_binary data{bsoncxx::binary_sub_type::k_binary,
-                                  static_cast<std::uint32_t>(bytes_in_chunk),
-                                  _get_impl().buffer.get()};
-
-    chunk.append(kvp("data", data));
-    _get_impl().chunks_collection_documents.push_back(chunk.extract());
+    _get_impl().buffer_off = 0;
 
     // To reduce the number of calls to the server, chunks are sent in batches rather than each one
     // being sent immediately upon being written.
-    if (_get_impl().chunks_collection_documents.size() >=
-        chunks_collection_documents_max_length(static_cast<std::size_t>(_get_impl().chunk_size))) {
+    if (_get_impl().chunks_collection_documents.size() >= _get_impl().max_batch_length) {
         flush_chunks();
     }
-
-    _get_impl().buffer_off = 0;
 }
 
 void uploader::flush_chunks() {
@@ -191,7 +386,48 @@ void uploader::flush_chunks() {
         return;
     }
 
-    if (_get_impl().session) {
+    if (auto pool = _get_impl().pool) {
+        // Make room for this batch before starting it, so no more than `parallelism` batches,
+        // and their clients, are in flight at once.
+        wait_for_chunks(_get_impl().parallelism - 1);
+
+        std::vector<bsoncxx::document::value> documents;
+        documents.swap(_get_impl().chunks_collection_documents);
+
+        auto chunks_name = bsoncxx::string::to_string(_get_impl().chunks.name());
+        auto write_concern = _get_impl().chunks.write_concern();
+
+        auto deduplicate = _get_impl().deduplicate;
+        auto codec = _get_impl().shared_chunks_codec();
+        auto insert = [pool, write_concern, deduplicate, codec](
+                          const std::string& database_name,
+                          const std::string& chunks_name,
+                          const std::vector<bsoncxx::document::value>& docs) {
+            auto client = pool->acquire();
+            auto chunks = (*client)[database_name][chunks_name];
+            chunks.write_concern(write_concern);
+            if (deduplicate) {
+                insert_shared_chunks(&chunks, nullptr, codec, docs);
+            } else {
+                chunks.insert_many(docs);
+            }
+        };
+
+        _get_impl().chunks_in_flight.push_back(
+            submitted_task::submit(*pool->executor(),
+                                   std::bind(std::move(insert),
+                                             _get_impl().database_name,
+                                             std::move(chunks_name),
+                                             std::move(documents))));
+        return;
+    }
+
+    if (_get_impl().deduplicate) {
+        insert_shared_chunks(&_get_impl().chunks,
+                             _get_impl().session,
+                             _get_impl().shared_chunks_codec(),
+                             _get_impl().chunks_collection_documents);
+    } else if (_get_impl().session) {
         _get_impl().chunks.insert_many(*_get_impl().session,
                                        _get_impl().chunks_collection_documents);
     } else {
@@ -201,6 +437,87 @@ void uploader::flush_chunks() {
     _get_impl().chunks_collection_documents.clear();
 }
 
+void uploader::wait_for_chunks(std::size_t max_in_flight) {
+    auto& in_flight = _get_impl().chunks_in_flight;
+
+    std::exception_ptr error;
+    while (in_flight.size() > max_in_flight) {
+        try {
+            in_flight.front()->wait();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        in_flight.pop_front();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+std::uint8_t* uploader::impl::chunk_data() {
+    std::size_t data_off = sizeof(std::int32_t) + files_id_element.size() + k_n_element_length +
+                           k_data_header_length;
+
+    if (!buffer) {
+        buffer.reset(new std::uint8_t[data_off + static_cast<std::size_t>(chunk_size) + 1]);
+
+        // The lengths and the chunk number are filled in by take_chunk().
+        auto cursor = buffer.get() + sizeof(std::int32_t);
+        std::memcpy(cursor, files_id_element.data(), files_id_element.size());
+        cursor += files_id_element.size();
+
+        *cursor = static_cast<std::uint8_t>(BSON_TYPE_INT32);
+        std::memcpy(cursor + 1, "n", sizeof("n"));
+        cursor += k_n_element_length;
+
+        *cursor = static_cast<std::uint8_t>(BSON_TYPE_BINARY);
+        std::memcpy(cursor + 1, "data", sizeof("data"));
+        cursor[k_data_header_length - 1] = static_cast<std::uint8_t>(BSON_SUBTYPE_BINARY);
+    }
+
+    return buffer.get() + data_off;
+}
+
+bsoncxx::document::value uploader::impl::take_chunk(std::int32_t n) {
+    auto data = chunk_data();
+    auto n_element = buffer.get() + sizeof(std::int32_t) + files_id_element.size();
+    auto length = static_cast<std::size_t>(data - buffer.get()) + buffer_off + 1;
+
+    write_int32(buffer.get(), static_cast<std::int32_t>(length));
+    write_int32(n_element + 1 + sizeof("n"), n);
+    write_int32(n_element + k_n_element_length + 1 + sizeof("data"),
+                static_cast<std::int32_t>(buffer_off));
+    data[buffer_off] = 0;
+
+    return bsoncxx::document::value{buffer.release(), length, &delete_chunk};
+}
+
+bsoncxx::document::value uploader::impl::build_chunk(bsoncxx::builder::basic::document* chunk,
+                                                     std::int32_t n) {
+    using bsoncxx::builder::basic::kvp;
+
+    const std::uint8_t* data = chunk_data();
+    std::size_t length = buffer_off;
+
+    // The uncompressed bytes stay in the buffer, which is reused for the next chunk.
+    if (compress) {
+        codec.compress(data, length, compression_level, &compressed);
+        compressed_length += static_cast<std::int64_t>(compressed.size());
+        data = compressed.data();
+        length = compressed.size();
+    }
+
+    chunk->append(
+        kvp("n", n),
+        kvp("data",
+            bsoncxx::types::b_binary{
+                bsoncxx::binary_sub_type::k_binary, static_cast<std::uint32_t>(length), data}));
+    return chunk->extract();
+}
+
 const uploader::impl& uploader::_get_impl() const {
     if (!_impl) {
         throw logic_error{error_code::k_invalid_gridfs_uploader_object};
@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 
 #include <bsoncxx/document/value.hpp>
 #include <bsoncxx/stdx/optional.hpp>
@@ -25,6 +26,7 @@
 #include <bsoncxx/view_or_value.hpp>
 #include <mongocxx/client_session.hpp>
 #include <mongocxx/collection.hpp>
+#include <mongocxx/options/gridfs/upload.hpp>
 #include <mongocxx/result/gridfs/upload.hpp>
 #include <mongocxx/stdx.hpp>
 
@@ -32,6 +34,9 @@
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
 namespace gridfs {
 
 ///
@@ -146,17 +151,64 @@ class MONGOCXX_API uploader {
     // @param metadata
     //   Optional metadata field of the files collection document.
     //
+    // @param max_batch_bytes
+    //   The most chunk bytes to send to the server in a single insert.
+    //
+    // @param pool
+    //   The pool to insert chunks concurrently with, or nullptr to insert them on the calling
+    //   thread through `chunks`.
+    //
+    // @param database_name
+    //   The name of the database containing `chunks`, used with `pool`.
+    //
+    // @param parallelism
+    //   The most chunk batches to insert concurrently with `pool`.
+    //
+    // @param checksum
+    //   The checksum to compute over the file contents and store in the files collection
+    //   document, if any.
+    //
+    // @param compression
+    //   The codec to compress the data of each chunk with, if any.
+    //
+    // @param compression_level
+    //   The level of the compression codec.
+    //
+    // @param deduplicate_chunks
+    //   Whether to store the chunks as shared chunks keyed by their digest, listed in a manifest.
+    //
     MONGOCXX_PRIVATE uploader(const client_session* session,
                               bsoncxx::types::value id,
                               stdx::string_view filename,
                               collection files,
                               collection chunks,
                               std::int32_t chunk_size,
-                              stdx::optional<bsoncxx::document::view_or_value> metadata = {});
+                              stdx::optional<bsoncxx::document::view_or_value> metadata = {},
+                              std::int32_t max_batch_bytes = 16 * 1000 * 1000,
+                              class pool* pool = nullptr,
+                              std::string database_name = {},
+                              std::uint32_t parallelism = 1,
+                              stdx::optional<options::gridfs::upload::checksum_algorithm>
+                                  checksum = {},
+                              stdx::optional<options::gridfs::upload::compression_algorithm>
+                                  compression = {},
+                              std::int32_t compression_level = 0,
+                              bool deduplicate_chunks = false);
+
+    // Gets the space left in the chunk being written, so that it can be filled in place. `length`
+    // is set to its size, which is never zero.
+    MONGOCXX_PRIVATE std::uint8_t* chunk_space(std::size_t* length);
+
+    // Marks `length` bytes of the space returned by chunk_space() as written.
+    MONGOCXX_PRIVATE void commit_chunk_space(std::size_t length);
 
     MONGOCXX_PRIVATE void finish_chunk();
     MONGOCXX_PRIVATE void flush_chunks();
 
+    // Waits for chunk batches being inserted in the background until at most `max_in_flight`
+    // remain, rethrowing the first error of those waited for.
+    MONGOCXX_PRIVATE void wait_for_chunks(std::size_t max_in_flight);
+
     class MONGOCXX_PRIVATE impl;
 
     MONGOCXX_PRIVATE impl& _get_impl();
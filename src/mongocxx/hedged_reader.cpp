@@ -0,0 +1,226 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/hedged_reader.hpp>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/operation_exception.hpp>
+#include <mongocxx/exception/private/mongoc_error.hh>
+#include <mongocxx/private/client.hh>
+#include <mongocxx/private/client_session.hh>
+#include <mongocxx/private/collection.hh>
+#include <mongocxx/private/hedged_reader.hh>
+#include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/read_preference.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// How many times server selection is asked for a server other than the first one before giving up
+// on hedging. Selection picks at random among the servers within the latency window.
+constexpr int k_hedge_selection_attempts = 8;
+
+// Selects a server to read from with the given preference, returning 0 if none is selectable.
+std::uint32_t select_server(mongoc_client_t* client,
+                            const mongoc_read_prefs_t* read_prefs,
+                            bson_error_t* error) {
+    auto sd = libmongoc::client_select_server(client, false, read_prefs, error);
+    if (!sd) {
+        return 0;
+    }
+    auto id = libmongoc::server_description_id(sd);
+    libmongoc::server_description_destroy(sd);
+    return id;
+}
+
+}  // namespace
+
+std::uint32_t hedged_reader::impl::select(const class collection& coll,
+                                          const options::find& options,
+                                          bson_error_t* error) {
+    const mongoc_read_prefs_t* read_prefs;
+    if (options.read_preference()) {
+        read_prefs = options.read_preference()->_impl->read_preference_t;
+    } else {
+        read_prefs = libmongoc::collection_get_read_prefs(coll._get_impl().collection_t);
+    }
+    return select_server(coll._get_impl().client_impl->client_t, read_prefs, error);
+}
+
+std::shared_ptr<submitted_task> hedged_reader::impl::send(const std::shared_ptr<race>& r,
+                                                          pool::entry client,
+                                                          std::uint32_t server_id,
+                                                          bool hedge) {
+    {
+        std::lock_guard<std::mutex> lock(r->mutex);
+        r->sent++;
+        r->running++;
+    }
+
+    // A std::function must be copyable, which a pool entry is not.
+    auto entry = std::make_shared<pool::entry>(std::move(client));
+    auto task = submitted_task::submit(*pool->executor(), [this, r, entry, server_id, hedge] {
+        read(r, std::move(*entry), server_id, hedge);
+    });
+
+    std::lock_guard<std::mutex> lock(reads_mutex);
+    reads.emplace_back(r, task);
+    return task;
+}
+
+void hedged_reader::impl::read(std::shared_ptr<race> r,
+                               pool::entry client,
+                               std::uint32_t server_id,
+                               bool hedge) {
+    stdx::optional<bsoncxx::document::value> found;
+    std::exception_ptr error;
+    try {
+        auto coll = (*client)[database][collection];
+        found = coll._find_one_on_server(server_id, r->filter.view(), r->options);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    client = nullptr;
+
+    std::lock_guard<std::mutex> lock(r->mutex);
+    if (error) {
+        r->failed++;
+        r->error = error;
+    } else if (!r->answered) {
+        r->answered = true;
+        r->result = std::move(found);
+        if (hedge) {
+            hedge_wins++;
+        }
+    }
+    r->running--;
+    r->changed.notify_all();
+}
+
+void hedged_reader::impl::reap(bool all) {
+    std::lock_guard<std::mutex> lock(reads_mutex);
+    for (auto it = reads.begin(); it != reads.end();) {
+        bool done = all;
+        if (all) {
+            // Runs the read here if no thread of the executor has started it. read() does not
+            // throw.
+            it->second->wait();
+        } else {
+            std::lock_guard<std::mutex> race_lock(it->first->mutex);
+            done = it->first->running == 0;
+        }
+        if (done) {
+            it = reads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+hedged_reader::hedged_reader(class pool& pool,
+                             bsoncxx::string::view_or_value database,
+                             bsoncxx::string::view_or_value collection,
+                             std::chrono::milliseconds delay) {
+    if (delay.count() < 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "the hedging delay must not be negative"};
+    }
+
+    _impl = stdx::make_unique<impl>(&pool,
+                                    database.view().to_string(),
+                                    collection.view().to_string(),
+                                    delay);
+}
+
+hedged_reader::hedged_reader(hedged_reader&&) noexcept = default;
+hedged_reader& hedged_reader::operator=(hedged_reader&&) noexcept = default;
+
+hedged_reader::~hedged_reader() = default;
+
+stdx::optional<bsoncxx::document::value> hedged_reader::find_one(
+    bsoncxx::document::view_or_value filter, const options::find& options) {
+    _impl->reap(false);
+
+    auto r = std::make_shared<impl::race>(bsoncxx::document::value{filter.view()}, options);
+
+    std::uint32_t first_id;
+    std::shared_ptr<submitted_task> first;
+    {
+        auto client = _impl->pool->acquire();
+        bson_error_t error;
+        {
+            auto coll = (*client)[_impl->database][_impl->collection];
+            first_id = impl::select(coll, options, &error);
+        }
+        if (!first_id) {
+            throw_exception<operation_exception>(error);
+        }
+        first = _impl->send(r, std::move(client), first_id, false);
+    }
+
+    std::unique_lock<std::mutex> lock(r->mutex);
+    if (!r->changed.wait_for(lock, _impl->delay, [&] { return r->settled(); })) {
+        lock.unlock();
+
+        // If no thread of the executor has started the first read, a hedge would queue behind the
+        // same busy threads, so the first read runs here instead. Otherwise hedging is best
+        // effort: without a spare client or a second server, keep waiting for the first read.
+        auto client = first->try_run() ? stdx::nullopt : _impl->pool->try_acquire();
+        if (client) {
+            std::uint32_t hedge_id = 0;
+            {
+                auto coll = (**client)[_impl->database][_impl->collection];
+                for (int i = 0; i < k_hedge_selection_attempts && !hedge_id; i++) {
+                    bson_error_t error;
+                    auto id = impl::select(coll, options, &error);
+                    if (id != first_id) {
+                        hedge_id = id;
+                    }
+                }
+            }
+            if (hedge_id) {
+                _impl->hedges++;
+                _impl->send(r, std::move(*client), hedge_id, true);
+            }
+        }
+
+        lock.lock();
+    }
+    r->changed.wait(lock, [&] { return r->settled(); });
+
+    if (!r->answered) {
+        std::rethrow_exception(r->error);
+    }
+    return std::move(r->result);
+}
+
+std::int64_t hedged_reader::hedges() const noexcept {
+    return _impl->hedges;
+}
+
+std::int64_t hedged_reader::hedge_wins() const noexcept {
+    return _impl->hedge_wins;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,123 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// Hedges point reads against a slow server on the client side.
+///
+/// Each find_one() is first sent to the server selected for its read preference. If no response
+/// has arrived after the hedging delay, the same read is sent to a second server eligible for the
+/// read preference, and whichever response arrives first is returned. This bounds the latency of
+/// reads from a replica set whose members occasionally stall, much as the hedge option of
+/// read_preference does for a sharded cluster.
+///
+/// The second server is picked by server selection as well, so it lies within the latency window
+/// of the client. When selection only ever yields the first server, as for the primary mode or
+/// when a single server lies within the window, no duplicate is sent.
+///
+/// The reads run as tasks of pool::executor(). If no thread of the executor has started the first
+/// read by the end of the hedging delay, find_one() runs it on the calling thread and sends no
+/// duplicate, since that would wait behind the same busy threads.
+///
+/// The losing read is not interrupted; it runs to completion in the background. A hedged_reader
+/// may be used by several threads at once.
+///
+/// @warning
+///   The pool must outlive the hedged_reader.
+///
+class MONGOCXX_API hedged_reader {
+   public:
+    ///
+    /// Creates a hedged_reader for a collection.
+    ///
+    /// @param pool
+    ///   The pool to check clients out of. Every read uses one client, and a hedged read a second.
+    /// @param database
+    ///   The name of the database of the collection.
+    /// @param collection
+    ///   The name of the collection to read from.
+    /// @param delay
+    ///   How long to wait for the first server before hedging. Choose a value around the p95
+    ///   latency of the reads, so that only the slowest reads are duplicated.
+    ///
+    /// @throws mongocxx::logic_error if the delay is negative.
+    ///
+    hedged_reader(pool& pool,
+                  bsoncxx::string::view_or_value database,
+                  bsoncxx::string::view_or_value collection,
+                  std::chrono::milliseconds delay);
+
+    hedged_reader(hedged_reader&&) noexcept;
+    hedged_reader& operator=(hedged_reader&&) noexcept;
+
+    ///
+    /// Waits for the reads still running in the background.
+    ///
+    ~hedged_reader();
+
+    ///
+    /// Finds a single document in the collection, as collection::find_one() does, hedging the
+    /// read if the first server is slow to respond.
+    ///
+    /// The read preference of the options is used if set, and that of the collection otherwise.
+    ///
+    /// @return The first document matched by the filter, if any.
+    ///
+    /// @throws mongocxx::query_exception if both reads failed, or the first failed before the
+    ///   read was hedged.
+    /// @throws mongocxx::operation_exception if no server is selectable for the read preference.
+    /// @throws mongocxx::exception if no client could be acquired from the pool.
+    ///
+    stdx::optional<bsoncxx::document::value> find_one(bsoncxx::document::view_or_value filter,
+                                                      const options::find& options = {});
+
+    ///
+    /// @return The number of reads for which a duplicate was sent.
+    ///
+    std::int64_t hedges() const noexcept;
+
+    ///
+    /// @return The number of hedged reads answered by the duplicate first.
+    ///
+    std::int64_t hedge_wins() const noexcept;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,177 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/index_advisor.hpp>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/index_view.hpp>
+#include <mongocxx/private/index_advisor.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// Shapes nest $and and $or only a few levels deep; deeper operators are not looked into.
+constexpr int k_max_depth = 32;
+
+bool is_operator(stdx::string_view key) {
+    return !key.empty() && key[0] == '$';
+}
+
+// Collects the fields a shape matches at its top level or through $and, and the $or operators
+// whose branches may each be supported instead.
+void collect(bsoncxx::document::view shape,
+             std::vector<stdx::string_view>& fields,
+             std::vector<bsoncxx::array::view>& alternatives,
+             int depth) {
+    if (depth == k_max_depth) {
+        return;
+    }
+
+    for (auto&& element : shape) {
+        auto key = element.key();
+        if (!is_operator(key)) {
+            fields.push_back(key);
+            continue;
+        }
+        if (element.type() != bsoncxx::type::k_array) {
+            continue;
+        }
+        if (key == stdx::string_view{"$and"}) {
+            for (auto&& branch : element.get_array().value) {
+                if (branch.type() == bsoncxx::type::k_document) {
+                    collect(branch.get_document().value, fields, alternatives, depth + 1);
+                }
+            }
+        } else if (key == stdx::string_view{"$or"}) {
+            alternatives.push_back(element.get_array().value);
+        }
+    }
+}
+
+stdx::string_view first_key(bsoncxx::document::view index_key) {
+    auto first = index_key.begin();
+    if (first == index_key.end()) {
+        return {};
+    }
+    return first->key();
+}
+
+bool supported(bsoncxx::document::view shape,
+               const std::vector<bsoncxx::document::view>& index_keys,
+               bool& names_field,
+               int depth) {
+    std::vector<stdx::string_view> fields;
+    std::vector<bsoncxx::array::view> alternatives;
+    collect(shape, fields, alternatives, depth);
+
+    if (!fields.empty()) {
+        names_field = true;
+    }
+
+    for (auto&& index_key : index_keys) {
+        auto leading = first_key(index_key);
+        for (auto&& field : fields) {
+            if (field == leading) {
+                return true;
+            }
+        }
+    }
+
+    for (auto&& alternative : alternatives) {
+        bool all_supported = true;
+        bool any_branch = false;
+        for (auto&& branch : alternative) {
+            if (branch.type() != bsoncxx::type::k_document) {
+                continue;
+            }
+            any_branch = true;
+            bool branch_names_field = false;
+            if (!supported(
+                    branch.get_document().value, index_keys, branch_names_field, depth + 1)) {
+                all_supported = false;
+            }
+            // A branch that names no field, such as a lone $expr, scans the collection.
+            if (!branch_names_field) {
+                all_supported = false;
+            }
+            names_field = names_field || branch_names_field;
+        }
+        if (any_branch && all_supported) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+bool shape_has_index(bsoncxx::document::view shape,
+                     const std::vector<bsoncxx::document::view>& index_keys) {
+    bool names_field = false;
+    return supported(shape, index_keys, names_field, 0) || !names_field;
+}
+
+std::vector<events::query_shape> MONGOCXX_CALL
+unindexed_query_shapes(client& client, const std::vector<events::query_shape>& shapes) {
+    // The key patterns of the indexes of each collection, listed when first needed.
+    std::map<std::tuple<std::string, std::string>, std::vector<bsoncxx::document::value>> indexes;
+
+    std::vector<events::query_shape> unindexed;
+    for (auto&& shape : shapes) {
+        auto name = std::make_tuple(shape.database, shape.collection);
+        auto it = indexes.find(name);
+        if (it == indexes.end()) {
+            std::vector<bsoncxx::document::value> keys;
+            auto listed = client[shape.database][shape.collection].indexes().list();
+            for (auto&& index : listed) {
+                auto key = index["key"];
+                if (key && key.type() == bsoncxx::type::k_document) {
+                    keys.emplace_back(key.get_document().value);
+                }
+            }
+            it = indexes.emplace(std::move(name), std::move(keys)).first;
+        }
+
+        std::vector<bsoncxx::document::view> key_views;
+        key_views.reserve(it->second.size());
+        for (auto&& key : it->second) {
+            key_views.push_back(key.view());
+        }
+
+        if (!shape_has_index(shape.filter_shape.view(), key_views)) {
+            unindexed.push_back(shape);
+        }
+    }
+
+    std::stable_sort(unindexed.begin(),
+                     unindexed.end(),
+                     [](const events::query_shape& a, const events::query_shape& b) {
+                         return a.count > b.count;
+                     });
+    return unindexed;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,52 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include <mongocxx/client.hpp>
+#include <mongocxx/events/query_shape.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Returns the filter shapes that likely have no supporting index, most frequent first, to catch
+/// queries that scan whole collections before they reach production.
+///
+/// The indexes of each collection are listed once, with index_view::list(). A shape is supported
+/// if an index begins with a field the filter matches at its top level or through $and, or if
+/// every branch of one of its $or operators is supported. Filters that name no field, such as a
+/// lone $expr, are not reported. The check does not consider sorts, partial filter expressions or
+/// collations, so a reported shape is a candidate to confirm with collection::explain_find().
+///
+/// @param client
+///   The client with which to list the indexes.
+/// @param shapes
+///   The shapes to check, as returned by client::query_shapes() or pool::query_shapes().
+///
+/// @return The shapes that no index appears to support.
+///
+/// @throws mongocxx::operation_exception if the indexes of a collection cannot be listed.
+///
+MONGOCXX_API std::vector<events::query_shape> MONGOCXX_CALL
+unindexed_query_shapes(client& client, const std::vector<events::query_shape>& shapes);
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -26,8 +26,8 @@
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
-index_view::index_view(void* coll)
-    : _impl{stdx::make_unique<impl>(static_cast<mongoc_collection_t*>(coll))} {}
+index_view::index_view(std::shared_ptr<void> coll)
+    : _impl{stdx::make_unique<impl>(std::static_pointer_cast<mongoc_collection_t>(coll))} {}
 
 index_view::index_view(index_view&&) noexcept = default;
 index_view& index_view::operator=(index_view&&) noexcept = default;
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -421,7 +422,7 @@ class MONGOCXX_API index_view {
     friend class collection;
     class MONGOCXX_PRIVATE impl;
 
-    MONGOCXX_PRIVATE index_view(void* coll);
+    MONGOCXX_PRIVATE explicit index_view(std::shared_ptr<void> coll);
 
     MONGOCXX_PRIVATE impl& _get_impl();
 
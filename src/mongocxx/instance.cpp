@@ -14,7 +14,13 @@
 
 #include <mongocxx/instance.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -23,6 +29,8 @@
 #include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/logger.hpp>
+#include <mongocxx/work_stealing_executor.hpp>
+#include <mongocxx/private/instance.hh>
 #include <mongocxx/private/libmongoc.hh>
 
 #include <mongocxx/config/private/prelude.hh>
@@ -68,6 +76,112 @@ void user_log_handler(::mongoc_log_level_t mongoc_log_level,
                                        stdx::string_view{message});
 }
 
+// Whether libmongoc is initialized, and, while an instance created with initialization::k_lazy
+// waits for the first client or pool, the logger to install once it is. Guarded by
+// libmongoc_mutex, except that libmongoc_initialized is also read without it.
+std::mutex libmongoc_mutex;
+std::atomic<bool> libmongoc_initialized{false};
+bool libmongoc_pending = false;
+logger* pending_logger = nullptr;
+
+void initialize_libmongoc(logger* user_logger) {
+    libmongoc::init();
+    if (user_logger) {
+        libmongoc::log_set_handler(user_log_handler, user_logger);
+        // The libmongoc namespace mocking system doesn't play well with varargs
+        // functions, so we use a bare mongoc_log call here.
+        mongoc_log(MONGOC_LOG_LEVEL_INFO, "mongocxx", "libmongoc logging callback enabled");
+    } else {
+        libmongoc::log_set_handler(null_log_handler, nullptr);
+    }
+    libmongoc::handshake_data_append("mongocxx", MONGOCXX_VERSION_STRING, NULL);
+
+    libmongoc_pending = false;
+    pending_logger = nullptr;
+    libmongoc_initialized.store(true, std::memory_order_release);
+}
+
+// The allocator of the instance, and the counts behind instance::memory_stats(). libbson's memory
+// hooks take no context, so these are global, as is the hook itself.
+bsoncxx::allocator* driver_allocator = nullptr;
+std::atomic<std::uint64_t> allocated_blocks{0};
+std::atomic<std::uint64_t> allocated_bytes{0};
+std::atomic<std::uint64_t> peak_allocated_bytes{0};
+std::atomic<std::uint64_t> total_allocations{0};
+
+// Each block starts with the size the driver asked for, which free() and realloc() do not pass.
+// The header is padded so the payload keeps the alignment the allocator gave the block.
+constexpr std::size_t k_header_size =
+    2 * sizeof(long double) > sizeof(std::size_t) ? 2 * sizeof(long double) : sizeof(std::size_t);
+
+std::size_t block_size(void* mem) {
+    std::size_t size;
+    std::memcpy(&size, static_cast<char*>(mem) - k_header_size, sizeof(size));
+    return size;
+}
+
+void* driver_malloc(std::size_t num_bytes) {
+    void* block;
+    try {
+        block = driver_allocator->allocate(num_bytes + k_header_size);
+    } catch (...) {
+        block = nullptr;
+    }
+
+    // libbson aborts when malloc fails, and so do its hooks.
+    if (!block) {
+        std::abort();
+    }
+
+    std::memcpy(block, &num_bytes, sizeof(num_bytes));
+
+    allocated_blocks.fetch_add(1, std::memory_order_relaxed);
+    total_allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto now = allocated_bytes.fetch_add(num_bytes, std::memory_order_relaxed) + num_bytes;
+    auto peak = peak_allocated_bytes.load(std::memory_order_relaxed);
+    while (now > peak && !peak_allocated_bytes.compare_exchange_weak(
+                             peak, now, std::memory_order_relaxed, std::memory_order_relaxed)) {
+    }
+
+    return static_cast<char*>(block) + k_header_size;
+}
+
+void driver_free(void* mem) {
+    if (!mem) {
+        return;
+    }
+
+    const auto num_bytes = block_size(mem);
+    allocated_blocks.fetch_sub(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_sub(num_bytes, std::memory_order_relaxed);
+    driver_allocator->deallocate(static_cast<char*>(mem) - k_header_size,
+                                 num_bytes + k_header_size);
+}
+
+void* driver_calloc(std::size_t num_members, std::size_t num_bytes) {
+    if (num_bytes && num_members > SIZE_MAX / num_bytes) {
+        std::abort();
+    }
+
+    void* mem = driver_malloc(num_members * num_bytes);
+    std::memset(mem, 0, num_members * num_bytes);
+    return mem;
+}
+
+void* driver_realloc(void* mem, std::size_t num_bytes) {
+    if (!num_bytes) {
+        driver_free(mem);
+        return nullptr;
+    }
+
+    void* resized = driver_malloc(num_bytes);
+    if (mem) {
+        std::memcpy(resized, mem, std::min(block_size(mem), num_bytes));
+        driver_free(mem);
+    }
+    return resized;
+}
+
 // A region of memory that acts as a sentintel value indicating that an instance object is being
 // destroyed. We only care about the address of this object, never its contents.
 typename std::aligned_storage<sizeof(instance), alignof(instance)>::type sentinel;
@@ -86,20 +200,57 @@ static_assert(std::is_trivially_destructible<decltype(current_instance)>::value,
 
 class instance::impl {
    public:
-    impl(std::unique_ptr<logger> logger) : _user_logger(std::move(logger)) {
-        libmongoc::init();
-        if (_user_logger) {
-            libmongoc::log_set_handler(user_log_handler, _user_logger.get());
-            // The libmongoc namespace mocking system doesn't play well with varargs
-            // functions, so we use a bare mongoc_log call here.
-            mongoc_log(MONGOC_LOG_LEVEL_INFO, "mongocxx", "libmongoc logging callback enabled");
-        } else {
-            libmongoc::log_set_handler(null_log_handler, nullptr);
+    impl(std::unique_ptr<logger> logger,
+         std::unique_ptr<bsoncxx::allocator> allocator,
+         initialization init)
+        : _user_logger(std::move(logger)), _allocator(std::move(allocator)) {
+        // libbson requires its memory hooks to be set before it allocates anything.
+        if (_allocator) {
+            driver_allocator = _allocator.get();
+
+            bson_mem_vtable_t vtable{};
+            vtable.malloc = driver_malloc;
+            vtable.calloc = driver_calloc;
+            vtable.realloc = driver_realloc;
+            vtable.free = driver_free;
+            bson_mem_set_vtable(&vtable);
+        }
+
+        std::lock_guard<std::mutex> lock{libmongoc_mutex};
+        if (init == initialization::k_lazy) {
+            libmongoc_pending = true;
+            pending_logger = _user_logger.get();
+            return;
         }
-        libmongoc::handshake_data_append("mongocxx", MONGOCXX_VERSION_STRING, NULL);
+        initialize_libmongoc(_user_logger.get());
     }
 
     ~impl() {
+        // Run the work left on the default executor while libmongoc is still initialized.
+        _executor.reset();
+
+        std::unique_lock<std::mutex> lock{libmongoc_mutex};
+        libmongoc_pending = false;
+        pending_logger = nullptr;
+        if (libmongoc_initialized.load()) {
+            libmongoc_initialized.store(false);
+            lock.unlock();
+            shut_down_libmongoc();
+        }
+
+        // Blocks still allocated, such as a document::value outliving the instance, must be
+        // freed through the hooks that allocated them, so the allocator is then kept for good.
+        if (_allocator) {
+            if (allocated_blocks.load() == 0) {
+                bson_mem_restore_vtable();
+                driver_allocator = nullptr;
+            } else {
+                _allocator.release();
+            }
+        }
+    }
+
+    void shut_down_libmongoc() {
         // If we had a user logger, remove it so that it can't be used by the driver after it goes
         // out of scope
         if (_user_logger) {
@@ -117,18 +268,29 @@ class instance::impl {
     }
 
     const std::unique_ptr<logger> _user_logger;
+    std::unique_ptr<bsoncxx::allocator> _allocator;
+
+    std::mutex _executor_mutex;
+    std::shared_ptr<class executor> _executor;
 };
 
 instance::instance() : instance(nullptr) {}
 
-instance::instance(std::unique_ptr<logger> logger) {
+instance::instance(std::unique_ptr<logger> logger) : instance(std::move(logger), nullptr) {}
+
+instance::instance(std::unique_ptr<logger> logger, std::unique_ptr<bsoncxx::allocator> allocator)
+    : instance(std::move(logger), std::move(allocator), initialization::k_eager) {}
+
+instance::instance(std::unique_ptr<logger> logger,
+                   std::unique_ptr<bsoncxx::allocator> allocator,
+                   initialization init) {
     instance* expected = nullptr;
 
     if (!current_instance.compare_exchange_strong(expected, this)) {
         throw logic_error{error_code::k_cannot_recreate_instance};
     }
 
-    _impl = stdx::make_unique<impl>(std::move(logger));
+    _impl = stdx::make_unique<impl>(std::move(logger), std::move(allocator), init);
 }
 
 instance::instance(instance&&) noexcept = default;
@@ -153,5 +315,38 @@ instance& instance::current() {
     return *curr;
 }
 
+void ensure_libmongoc_initialized() {
+    if (libmongoc_initialized.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{libmongoc_mutex};
+    if (libmongoc_pending) {
+        initialize_libmongoc(pending_logger);
+    }
+}
+
+instance::memory_statistics instance::memory_stats() const {
+    memory_statistics stats;
+    stats.blocks = allocated_blocks.load(std::memory_order_relaxed);
+    stats.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+    stats.peak_allocated_bytes = peak_allocated_bytes.load(std::memory_order_relaxed);
+    stats.total_allocations = total_allocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::shared_ptr<executor> instance::executor() {
+    std::lock_guard<std::mutex> lock{_impl->_executor_mutex};
+    if (!_impl->_executor) {
+        _impl->_executor = std::make_shared<work_stealing_executor>();
+    }
+    return _impl->_executor;
+}
+
+void instance::executor(std::shared_ptr<class executor> executor) {
+    std::lock_guard<std::mutex> lock{_impl->_executor_mutex};
+    _impl->_executor = std::move(executor);
+}
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -14,13 +14,17 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
+#include <bsoncxx/allocator.hpp>
+
 #include <mongocxx/config/prelude.hpp>
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
+class executor;
 class logger;
 
 ///
@@ -85,12 +89,72 @@ class MONGOCXX_API instance {
 
     ///
     /// Creates an instance of the driver with a user provided log handler.
+    ///
+    /// The driver calls the logger synchronously; wrap it in a mongocxx::async_logger if it may be
+    /// slow.
+    ///
     ///  @param logger The logger that the driver will direct log messages to.
     ///
     /// @throws mongocxx::logic_error if an instance already exists.
     ///
     instance(std::unique_ptr<logger> logger);
 
+    ///
+    /// Creates an instance of the driver with a user provided log handler and memory allocator.
+    ///
+    /// All memory that libbson and libmongoc allocate is taken from the allocator. That includes
+    /// the buffers of documents built by bsoncxx builders that were not given an allocator of their
+    /// own. Other C++ objects of the driver, such as strings, still use the global heap. libbson
+    /// has a single allocator per process, so this cannot be narrowed to one client or pool.
+    ///
+    /// The instance must be created before anything else uses bsoncxx or mongocxx, since memory
+    /// allocated before would later be freed through the allocator. If driver memory is still
+    /// allocated when the instance is destroyed, for instance a document::value that outlives it,
+    /// the allocator is kept, and never destroyed, so that this memory can still be freed.
+    ///
+    /// @param logger
+    ///   The logger that the driver will direct log messages to, or null for none.
+    /// @param allocator
+    ///   The allocator that the driver will take its memory from, or null for the default heap.
+    ///
+    /// @throws mongocxx::logic_error if an instance already exists.
+    ///
+    instance(std::unique_ptr<logger> logger, std::unique_ptr<bsoncxx::allocator> allocator);
+
+    ///
+    /// When an instance initializes libmongoc.
+    ///
+    enum class initialization {
+        /// libmongoc is initialized by the instance constructor.
+        k_eager,
+
+        /// libmongoc is initialized when the first client or pool is created.
+        ///
+        /// Initializing libmongoc also initializes its TLS library, its SASL library and its
+        /// cryptographic primitives, which can take a large part of the startup time of a short
+        /// process. Processes that may exit before connecting anywhere, such as command line tools
+        /// answering --help or serverless functions served from a cache, skip that cost entirely.
+        /// bsoncxx and mongocxx::uri can be used before any client is created.
+        k_lazy,
+    };
+
+    ///
+    /// Creates an instance of the driver with a user provided log handler and memory allocator,
+    /// choosing when libmongoc is initialized.
+    ///
+    /// @param logger
+    ///   The logger that the driver will direct log messages to, or null for none.
+    /// @param allocator
+    ///   The allocator that the driver will take its memory from, or null for the default heap.
+    /// @param init
+    ///   When to initialize libmongoc.
+    ///
+    /// @throws mongocxx::logic_error if an instance already exists.
+    ///
+    instance(std::unique_ptr<logger> logger,
+             std::unique_ptr<bsoncxx::allocator> allocator,
+             initialization init);
+
     ///
     /// Move constructs an instance of the driver.
     ///
@@ -123,6 +187,53 @@ class MONGOCXX_API instance {
     ///
     static instance& current();
 
+    ///
+    /// Counts of the memory the driver has taken from the allocator of the instance.
+    ///
+    struct memory_statistics {
+        /// The number of blocks currently allocated.
+        std::uint64_t blocks;
+
+        /// The bytes currently allocated, as requested by the driver.
+        std::uint64_t allocated_bytes;
+
+        /// The most bytes allocated at once since the instance was created.
+        std::uint64_t peak_allocated_bytes;
+
+        /// The number of allocations made since the instance was created, counting each
+        /// reallocation once.
+        std::uint64_t total_allocations;
+    };
+
+    ///
+    /// Returns the memory the driver has taken from the allocator, or all zeros if the instance
+    /// was created without one.
+    ///
+    /// libbson and libmongoc allocate through the same hook and are counted together.
+    ///
+    memory_statistics memory_stats() const;
+
+    ///
+    /// Returns the executor that runs the background work of the driver, such as the operations of
+    /// a mongocxx::async_collection and the sub-batches of a parallel bulk write. Pools given an
+    /// executor of their own in options::pool::executor() use theirs instead.
+    ///
+    /// Unless another executor was set, a mongocxx::work_stealing_executor with a thread per core
+    /// is started on first use.
+    ///
+    std::shared_ptr<class executor> executor();
+
+    ///
+    /// Sets the executor that runs the background work of the driver.
+    ///
+    /// Work already submitted to the previous executor completes on it, and features holding it,
+    /// such as an async_collection, keep using it until they are destroyed.
+    ///
+    /// @param executor
+    ///   The executor to use, or null to start the default one on next use.
+    ///
+    void executor(std::shared_ptr<class executor> executor);
+
    private:
     class MONGOCXX_PRIVATE impl;
     std::unique_ptr<impl> _impl;
@@ -0,0 +1,224 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/merged_cursor.hpp>
+
+#include <system_error>
+#include <utility>
+
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/merged_cursor.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// The number of documents handed over per batch when no batch_size was set. It matches the size
+// of the server's default first batch.
+constexpr std::size_t k_default_batch_size = 101;
+
+}  // namespace
+
+merged_cursor::impl::impl(class pool* pool,
+                          std::string database,
+                          std::string collection,
+                          class read_concern concern,
+                          class read_preference preference,
+                          options::find options,
+                          std::vector<bsoncxx::document::value> filters)
+    : pool(pool),
+      database(std::move(database)),
+      collection(std::move(collection)),
+      concern(std::move(concern)),
+      preference(std::move(preference)),
+      options(std::move(options)),
+      batch_size(this->options.batch_size() && *this->options.batch_size() > 0
+                     ? static_cast<std::size_t>(*this->options.batch_size())
+                     : k_default_batch_size),
+      filters(std::move(filters)) {}
+
+merged_cursor::impl::~impl() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    changed.notify_all();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+}
+
+void merged_cursor::impl::start(std::size_t connections) {
+    // Two batches per thread let every thread read ahead while the consumer is busy.
+    max_ready = 2 * connections;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    for (std::size_t i = 0; i < connections; i++) {
+        try {
+            threads.emplace_back([this] { run(); });
+        } catch (const std::system_error&) {
+            // Run the queries on the threads that could be started.
+            if (threads.empty()) {
+                throw;
+            }
+            break;
+        }
+        running++;
+    }
+}
+
+void merged_cursor::impl::run() {
+    try {
+        read();
+    } catch (...) {
+        // Stop the other threads too; the consumer rethrows the error once it has taken the
+        // batches that were already read.
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!error) {
+            error = std::current_exception();
+        }
+        stopping = true;
+    }
+
+    std::lock_guard<std::mutex> lock{mutex};
+    running--;
+    changed.notify_all();
+}
+
+void merged_cursor::impl::read() {
+    auto client = pool->acquire();
+    auto coll = (*client)[database][collection];
+    coll.read_concern(concern);
+    coll.read_preference(preference);
+
+    for (auto index = next_filter.fetch_add(1); index < filters.size();
+         index = next_filter.fetch_add(1)) {
+        auto results = coll.find(filters[index].view(), options);
+        for (auto next = results.next_batch(batch_size); !next.empty();
+             next = results.next_batch(batch_size)) {
+            if (!hand_over(std::move(next))) {
+                return;
+            }
+        }
+    }
+}
+
+bool merged_cursor::impl::hand_over(cursor::batch next) {
+    std::unique_lock<std::mutex> lock{mutex};
+    changed.wait(lock, [this] { return stopping || ready.size() < max_ready; });
+    if (stopping) {
+        return false;
+    }
+
+    ready.push_back(std::move(next));
+    changed.notify_all();
+    return true;
+}
+
+void merged_cursor::impl::advance() {
+    if (++position < batch.size()) {
+        doc = batch[position];
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{mutex};
+    changed.wait(lock, [this] { return !ready.empty() || error || running == 0; });
+    if (!ready.empty()) {
+        batch = std::move(ready.front());
+        ready.pop_front();
+        changed.notify_all();
+
+        position = 0;
+        doc = batch[0];
+        return;
+    }
+
+    exhausted = true;
+    if (error) {
+        auto failure = std::move(error);
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+merged_cursor::merged_cursor(std::unique_ptr<impl> impl) : _impl(std::move(impl)) {}
+
+merged_cursor::merged_cursor(merged_cursor&&) noexcept = default;
+merged_cursor& merged_cursor::operator=(merged_cursor&&) noexcept = default;
+
+merged_cursor::~merged_cursor() = default;
+
+merged_cursor::iterator merged_cursor::begin() {
+    if (_impl->exhausted) {
+        return end();
+    }
+    return iterator(this);
+}
+
+merged_cursor::iterator merged_cursor::end() {
+    return iterator(nullptr);
+}
+
+merged_cursor::iterator::iterator(merged_cursor* cursor) : _cursor(cursor) {
+    if (_cursor == nullptr || _cursor->_impl->started) {
+        return;
+    }
+
+    _cursor->_impl->started = true;
+    operator++();
+}
+
+merged_cursor::iterator& merged_cursor::iterator::operator++() {
+    _cursor->_impl->advance();
+    return *this;
+}
+
+void merged_cursor::iterator::operator++(int) {
+    operator++();
+}
+
+const bsoncxx::document::view& merged_cursor::iterator::operator*() const {
+    return _cursor->_impl->doc;
+}
+
+const bsoncxx::document::view* merged_cursor::iterator::operator->() const {
+    return &_cursor->_impl->doc;
+}
+
+//
+// An iterator is exhausted if it is the end-iterator (_cursor == nullptr)
+// or if the underlying _cursor is marked exhausted.
+//
+bool merged_cursor::iterator::is_exhausted() const {
+    return !_cursor || _cursor->_impl->exhausted;
+}
+
+bool MONGOCXX_CALL operator==(const merged_cursor::iterator& lhs,
+                              const merged_cursor::iterator& rhs) {
+    return ((rhs.is_exhausted() && lhs.is_exhausted()) || (lhs._cursor == rhs._cursor));
+}
+
+bool MONGOCXX_CALL operator!=(const merged_cursor::iterator& lhs,
+                              const merged_cursor::iterator& rhs) {
+    return !(lhs == rhs);
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
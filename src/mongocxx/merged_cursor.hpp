@@ -0,0 +1,155 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+
+#include <bsoncxx/document/view.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class collection;
+
+///
+/// Class representing the combined results of several queries run concurrently over pooled
+/// clients, such as those of collection::find_by_ids().
+///
+/// The queries start running as soon as the merged_cursor is created. Each background thread
+/// checks a client out of the pool and reads the results of one query after another, handing them
+/// to the merged_cursor a batch at a time. Only a bounded number of batches are buffered, so the
+/// threads wait for the consumer rather than reading the whole result set into memory.
+///
+/// Documents are returned as they arrive, so those of different queries are interleaved in no
+/// particular order.
+///
+/// @warning
+///   The pool the queries run on must outlive the merged_cursor.
+///
+class MONGOCXX_API merged_cursor {
+   public:
+    class MONGOCXX_API iterator;
+
+    ///
+    /// Move constructs a merged_cursor.
+    ///
+    merged_cursor(merged_cursor&&) noexcept;
+
+    ///
+    /// Move assigns a merged_cursor.
+    ///
+    merged_cursor& operator=(merged_cursor&&) noexcept;
+
+    ///
+    /// Destroys a merged_cursor, waiting for the background threads to finish the batches they
+    /// are reading.
+    ///
+    ~merged_cursor();
+
+    ///
+    /// A merged_cursor::iterator that points to the next remaining result, waiting for one to
+    /// arrive if none is buffered. As with mongocxx::cursor, calling begin() more than once does
+    /// not restart the results.
+    ///
+    /// @return the merged_cursor::iterator
+    ///
+    /// @throws mongocxx::query_exception if one of the queries failed
+    ///
+    iterator begin();
+
+    ///
+    /// A merged_cursor::iterator indicating that every query has returned all of its results.
+    ///
+    /// @return the merged_cursor::iterator
+    ///
+    iterator end();
+
+   private:
+    friend class collection;
+    friend class merged_cursor::iterator;
+
+    class MONGOCXX_PRIVATE impl;
+
+    MONGOCXX_PRIVATE explicit merged_cursor(std::unique_ptr<impl> impl);
+
+    std::unique_ptr<impl> _impl;
+};
+
+///
+/// Class representing an input iterator of documents in a mongocxx::merged_cursor.
+///
+/// As with cursor::iterator, all non-end iterators of the same merged_cursor move in lock-step, and
+/// an exhausted iterator must not be dereferenced or incremented.
+///
+class MONGOCXX_API merged_cursor::iterator
+    : public std::iterator<std::input_iterator_tag, bsoncxx::document::view> {
+   public:
+    ///
+    /// Dereferences the view for the document currently being pointed to. The view remains valid
+    /// until the iterator is incremented.
+    ///
+    const bsoncxx::document::view& operator*() const;
+
+    ///
+    /// Accesses a member of the dereferenced document currently being pointed to.
+    ///
+    const bsoncxx::document::view* operator->() const;
+
+    ///
+    /// Pre-increments the iterator to move to the next document.
+    ///
+    /// @throws mongocxx::query_exception if one of the queries failed
+    ///
+    iterator& operator++();
+
+    ///
+    /// Post-increments the iterator to move to the next document.
+    ///
+    /// @throws mongocxx::query_exception if one of the queries failed
+    ///
+    void operator++(int);
+
+   private:
+    friend class merged_cursor;
+
+    ///
+    /// @{
+    ///
+    /// Compare two iterators for (in)-equality. Iterators compare equal if they point to the same
+    /// underlying merged_cursor or if both are exhausted.
+    ///
+    /// @relates iterator
+    ///
+    friend MONGOCXX_API bool MONGOCXX_CALL operator==(const iterator&, const iterator&);
+    friend MONGOCXX_API bool MONGOCXX_CALL operator!=(const iterator&, const iterator&);
+    ///
+    /// @}
+    ///
+
+    MONGOCXX_PRIVATE bool is_exhausted() const;
+
+    MONGOCXX_PRIVATE explicit iterator(merged_cursor* cursor);
+
+    // If this pointer is null, the iterator is considered "past-the-end".
+    merged_cursor* _cursor;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,65 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/name_cursor.hpp>
+
+#include <utility>
+
+#include <bsoncxx/types.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+name_cursor::name_cursor(cursor&& cursor) : _cursor(std::move(cursor)) {}
+
+name_cursor::name_cursor(name_cursor&&) noexcept = default;
+name_cursor& name_cursor::operator=(name_cursor&&) noexcept = default;
+
+name_cursor::~name_cursor() = default;
+
+name_cursor::iterator name_cursor::begin() {
+    return iterator{_cursor.begin()};
+}
+
+name_cursor::iterator name_cursor::end() {
+    return iterator{_cursor.end()};
+}
+
+name_cursor::iterator::iterator(cursor::iterator documents) : _documents(std::move(documents)) {}
+
+stdx::string_view name_cursor::iterator::operator*() const {
+    return (*_documents)["name"].get_utf8().value;
+}
+
+name_cursor::iterator& name_cursor::iterator::operator++() {
+    ++_documents;
+    return *this;
+}
+
+void name_cursor::iterator::operator++(int) {
+    operator++();
+}
+
+bool MONGOCXX_CALL operator==(const name_cursor::iterator& lhs, const name_cursor::iterator& rhs) {
+    return lhs._documents == rhs._documents;
+}
+
+bool MONGOCXX_CALL operator!=(const name_cursor::iterator& lhs, const name_cursor::iterator& rhs) {
+    return !(lhs == rhs);
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,126 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <iterator>
+
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class client;
+class database;
+
+///
+/// Class representing the names of the collections of a database or of the databases of a
+/// deployment, as listed by a `nameOnly` listCollections or listDatabases command.
+///
+/// Unlike database::list_collection_names() and client::list_database_names(), which copy every
+/// name into a std::vector before returning, a name_cursor fetches the names batch by batch as it
+/// is iterated, and each name it yields is a view into the server reply holding it. Listing a
+/// deployment with many namespaces therefore costs no more memory than one reply batch.
+///
+/// The names are not copied: a name yielded by an iterator is only valid until that iterator is
+/// incremented. Copy it into a std::string to keep it longer.
+///
+class MONGOCXX_API name_cursor {
+   public:
+    class MONGOCXX_API iterator;
+
+    name_cursor(name_cursor&&) noexcept;
+    name_cursor& operator=(name_cursor&&) noexcept;
+
+    ~name_cursor();
+
+    ///
+    /// A name_cursor::iterator that points to the first remaining name. As for a mongocxx::cursor,
+    /// calling begin() again does not restart the listing.
+    ///
+    /// @throws mongocxx::query_exception if the listing failed
+    ///
+    iterator begin();
+
+    ///
+    /// A name_cursor::iterator indicating that every name has been listed.
+    ///
+    iterator end();
+
+   private:
+    friend class client;
+    friend class database;
+
+    MONGOCXX_PRIVATE explicit name_cursor(cursor&& cursor);
+
+    cursor _cursor;
+};
+
+///
+/// Class representing an input iterator of the names of a mongocxx::name_cursor.
+///
+/// The iterators of a name_cursor move in lock-step, just like those of a mongocxx::cursor.
+///
+class MONGOCXX_API name_cursor::iterator
+    : public std::iterator<std::input_iterator_tag, stdx::string_view> {
+   public:
+    ///
+    /// Accesses the name currently being pointed to. The view is invalidated by incrementing the
+    /// iterator.
+    ///
+    stdx::string_view operator*() const;
+
+    ///
+    /// Pre-increments the iterator to move to the next name.
+    ///
+    /// @throws mongocxx::query_exception if the listing failed
+    ///
+    iterator& operator++();
+
+    ///
+    /// Post-increments the iterator to move to the next name.
+    ///
+    /// @throws mongocxx::query_exception if the listing failed
+    ///
+    void operator++(int);
+
+   private:
+    friend class name_cursor;
+
+    ///
+    /// @{
+    ///
+    /// Compare two iterators for (in)-equality. Iterators compare equal if they point to the same
+    /// underlying cursor or if both are exhausted.
+    ///
+    /// @relates iterator
+    ///
+    friend MONGOCXX_API bool MONGOCXX_CALL operator==(const iterator&, const iterator&);
+    friend MONGOCXX_API bool MONGOCXX_CALL operator!=(const iterator&, const iterator&);
+    ///
+    /// @}
+    ///
+
+    MONGOCXX_PRIVATE explicit iterator(cursor::iterator documents);
+
+    cursor::iterator _documents;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
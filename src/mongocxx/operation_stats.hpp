@@ -0,0 +1,53 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// The network traffic of an operation: the commands the driver sent for it and the replies it
+/// received, as reported by result::bulk_write::stats(), result::insert_many::stats() and
+/// cursor::stats().
+///
+/// The statistics are only collected for clients and pools created with
+/// options::apm::record_operation_stats(); otherwise they are all zero.
+///
+/// Sizes are the BSON sizes of the command and reply documents, without the few bytes of the
+/// wire protocol message headers.
+///
+struct operation_stats {
+    /// The total size in bytes of the commands sent.
+    std::uint64_t bytes_sent = 0;
+
+    /// The total size in bytes of the replies received.
+    std::uint64_t bytes_received = 0;
+
+    /// The number of commands sent to the server, each a round-trip.
+    std::uint64_t round_trips = 0;
+
+    /// The total time from sending each command to receiving its reply.
+    std::chrono::microseconds duration{0};
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
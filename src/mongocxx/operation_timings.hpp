@@ -0,0 +1,80 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Where the time of an operation went, to tell whether client-side CPU or the network and the
+/// server limit a call site.
+///
+/// The timings are only collected while a client or pool created with
+/// options::apm::record_operation_timings() exists; otherwise last_operation_timings() returns all
+/// zeros. They are collected for collection::insert_one(), find_one(), find(), aggregate(),
+/// bulk_write::execute(), database::run_command() and each advance of a cursor.
+///
+/// libmongoc selects a server, checks out a connection, encodes, sends and parses commands
+/// internally, so its share of an operation is split at the command events it reports:
+/// dispatch, round_trip and reply_parse.
+///
+struct operation_timings {
+    /// The time spent building commands, options and documents in C++ before handing them to
+    /// libmongoc.
+    std::chrono::nanoseconds serialize{0};
+
+    /// The time in libmongoc before each call's first command is sent: server selection,
+    /// connection checkout (including connecting and authenticating, if needed) and encoding the
+    /// command.
+    std::chrono::nanoseconds dispatch{0};
+
+    /// The time from sending each command to receiving its reply: the network write, the
+    /// server's execution and the network read.
+    std::chrono::nanoseconds round_trip{0};
+
+    /// The rest of the time in libmongoc: parsing replies, preparing any further commands, and
+    /// returning documents from a batch that was already received.
+    std::chrono::nanoseconds reply_parse{0};
+
+    /// The time spent building the C++ result from the reply.
+    std::chrono::nanoseconds result{0};
+
+    /// The time of the whole operation, including wrapper code that is in none of the phases.
+    std::chrono::nanoseconds total{0};
+
+    /// The number of commands the operation sent.
+    std::uint32_t commands = 0;
+};
+
+///
+/// Returns the timings of the last operation that completed on the calling thread.
+///
+/// Operations that run others, such as insert_one() running a bulk write, are timed as one
+/// operation. Operations run by other threads on this thread's behalf, such as parallel bulk
+/// writes or cursor prefetching, only contribute their wall clock time in libmongoc.
+///
+/// @return The timings, or all zeros if no operation has been timed on this thread.
+///
+MONGOCXX_API operation_timings MONGOCXX_CALL last_operation_timings();
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -100,6 +100,16 @@ aggregate& aggregate::write_concern(class write_concern write_concern) {
     return *this;
 }
 
+aggregate& aggregate::prefetch_batches(std::int32_t prefetch_batches) {
+    _prefetch_batches = prefetch_batches;
+    return *this;
+}
+
+aggregate& aggregate::max_prefetched_bytes(std::int64_t max_prefetched_bytes) {
+    _max_prefetched_bytes = max_prefetched_bytes;
+    return *this;
+}
+
 const stdx::optional<bool>& aggregate::allow_disk_use() const {
     return _allow_disk_use;
 }
@@ -136,6 +146,14 @@ const stdx::optional<class write_concern>& aggregate::write_concern() const {
     return _write_concern;
 }
 
+const stdx::optional<std::int32_t>& aggregate::prefetch_batches() const {
+    return _prefetch_batches;
+}
+
+const stdx::optional<std::int64_t>& aggregate::max_prefetched_bytes() const {
+    return _max_prefetched_bytes;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -252,6 +252,62 @@ class MONGOCXX_API aggregate {
     ///
     const stdx::optional<class read_concern>& read_concern() const;
 
+    ///
+    /// Sets the number of batches the cursor reads ahead in the background.
+    ///
+    /// When set, the cursor returned by this operation fetches documents on a background thread,
+    /// issuing the next getMore while the application is still consuming earlier documents, and
+    /// keeps up to this many batches of batch_size documents (101 if batch_size is not set)
+    /// waiting to be consumed. Tailable cursors cannot prefetch.
+    ///
+    /// @warning
+    ///   The background thread uses the client the operation was run on for as long as the cursor
+    ///   exists, so the application must not use that client, or any database, collection or
+    ///   other object obtained from it, until the cursor is destroyed. Acquiring a dedicated client
+    ///   from a mongocxx::pool for the scan is the usual way to satisfy this.
+    ///
+    /// @param prefetch_batches
+    ///   The number of batches to keep ready, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    aggregate& prefetch_batches(std::int32_t prefetch_batches);
+
+    ///
+    /// Gets the current number of batches the cursor reads ahead.
+    ///
+    /// @return The current prefetch_batches setting.
+    ///
+    const stdx::optional<std::int32_t>& prefetch_batches() const;
+
+    ///
+    /// Sets the most bytes of prefetched batches waiting to be consumed.
+    ///
+    /// With prefetch_batches(), the background thread stops reading ahead once the batches it has
+    /// ready hold this many bytes, in addition to the limit on their number, and waits for the
+    /// application to consume one before it issues the next getMore. A batch is always kept ready
+    /// when none is, however large. The batches also count against the budget of the client; see
+    /// options::client::max_buffered_reply_bytes(). By default only prefetch_batches() limits the
+    /// read-ahead.
+    ///
+    /// @param max_prefetched_bytes
+    ///   The most bytes of documents to keep ready, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    aggregate& max_prefetched_bytes(std::int64_t max_prefetched_bytes);
+
+    ///
+    /// Gets the most bytes of prefetched batches waiting to be consumed.
+    ///
+    /// @return The current max_prefetched_bytes setting.
+    ///
+    const stdx::optional<std::int64_t>& max_prefetched_bytes() const;
+
    private:
     friend class ::mongocxx::database;
     friend class ::mongocxx::collection;
@@ -267,6 +323,8 @@ class MONGOCXX_API aggregate {
     stdx::optional<class hint> _hint;
     stdx::optional<class write_concern> _write_concern;
     stdx::optional<class read_concern> _read_concern;
+    stdx::optional<std::int32_t> _prefetch_batches;
+    stdx::optional<std::int64_t> _max_prefetched_bytes;
 };
 
 }  // namespace options
@@ -14,6 +14,11 @@
 
 #include <mongocxx/options/apm.hpp>
 
+#include <utility>
+
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
 #include <mongocxx/config/private/prelude.hh>
 
 namespace mongocxx {
@@ -152,6 +157,175 @@ apm::heartbeat_succeeded() const {
     return _heartbeat_succeeded;
 }
 
+apm& apm::on_command_timing(command_timing_fn command_timing, void* context) {
+    _command_timing = command_timing;
+    _command_timing_context = context;
+    return *this;
+}
+
+apm::command_timing_fn apm::command_timing() const {
+    return _command_timing;
+}
+
+void* apm::command_timing_context() const {
+    return _command_timing_context;
+}
+
+apm& apm::command_sample_rate(std::uint32_t rate) {
+    if (rate == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "options::apm::command_sample_rate() must be positive"};
+    }
+
+    _command_sample_rate = rate;
+    return *this;
+}
+
+std::uint32_t apm::command_sample_rate() const {
+    return _command_sample_rate;
+}
+
+apm& apm::on_pool_cleared(
+    std::function<void(const mongocxx::events::pool_cleared_event&)> pool_cleared) {
+    _pool_cleared = pool_cleared;
+    return *this;
+}
+
+const std::function<void(const mongocxx::events::pool_cleared_event&)>& apm::pool_cleared() const {
+    return _pool_cleared;
+}
+
+apm& apm::on_connection_checked_out(
+    std::function<void(const mongocxx::events::connection_checked_out_event&)>
+        connection_checked_out) {
+    _connection_checked_out = connection_checked_out;
+    return *this;
+}
+
+const std::function<void(const mongocxx::events::connection_checked_out_event&)>&
+apm::connection_checked_out() const {
+    return _connection_checked_out;
+}
+
+apm& apm::on_connection_check_out_failed(
+    std::function<void(const mongocxx::events::connection_check_out_failed_event&)>
+        connection_check_out_failed) {
+    _connection_check_out_failed = connection_check_out_failed;
+    return *this;
+}
+
+const std::function<void(const mongocxx::events::connection_check_out_failed_event&)>&
+apm::connection_check_out_failed() const {
+    return _connection_check_out_failed;
+}
+
+apm& apm::tracer(std::shared_ptr<mongocxx::tracer> span_tracer) {
+    _tracer = std::move(span_tracer);
+    return *this;
+}
+
+const std::shared_ptr<mongocxx::tracer>& apm::tracer() const {
+    return _tracer;
+}
+
+apm& apm::record_command_latencies(bool record) {
+    _record_command_latencies = record;
+    return *this;
+}
+
+bool apm::record_command_latencies() const {
+    return _record_command_latencies;
+}
+
+apm& apm::record_command_bytes(bool record) {
+    _record_command_bytes = record;
+    return *this;
+}
+
+bool apm::record_command_bytes() const {
+    return _record_command_bytes;
+}
+
+apm& apm::record_namespace_stats(bool record) {
+    _record_namespace_stats = record;
+    return *this;
+}
+
+bool apm::record_namespace_stats() const {
+    return _record_namespace_stats;
+}
+
+apm& apm::record_operation_stats(bool record) {
+    _record_operation_stats = record;
+    return *this;
+}
+
+bool apm::record_operation_stats() const {
+    return _record_operation_stats;
+}
+
+apm& apm::record_operation_timings(bool record) {
+    _record_operation_timings = record;
+    return *this;
+}
+
+bool apm::record_operation_timings() const {
+    return _record_operation_timings;
+}
+
+apm& apm::async_delivery(std::size_t queue_capacity) {
+    if (queue_capacity == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "options::apm::async_delivery() must be given a positive capacity"};
+    }
+
+    _async_delivery = queue_capacity;
+    return *this;
+}
+
+const stdx::optional<std::size_t>& apm::async_delivery() const {
+    return _async_delivery;
+}
+
+apm& apm::record_slow_commands(std::chrono::milliseconds threshold, std::size_t capacity) {
+    if (threshold.count() < 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "options::apm::record_slow_commands() must be given a threshold of zero "
+                          "or more"};
+    }
+
+    if (capacity == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "options::apm::record_slow_commands() must be given a positive capacity"};
+    }
+
+    _slow_command_threshold = threshold;
+    _slow_command_capacity = capacity;
+    return *this;
+}
+
+const stdx::optional<std::chrono::milliseconds>& apm::slow_command_threshold() const {
+    return _slow_command_threshold;
+}
+
+std::size_t apm::slow_command_capacity() const {
+    return _slow_command_capacity;
+}
+
+apm& apm::record_query_shapes(std::size_t capacity) {
+    if (capacity == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "options::apm::record_query_shapes() must be given a positive capacity"};
+    }
+
+    _query_shape_capacity = capacity;
+    return *this;
+}
+
+const stdx::optional<std::size_t>& apm::query_shape_capacity() const {
+    return _query_shape_capacity;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -14,20 +14,32 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+
+#include <bsoncxx/stdx/optional.hpp>
 
 #include <mongocxx/events/command_failed_event.hpp>
 #include <mongocxx/events/command_started_event.hpp>
 #include <mongocxx/events/command_succeeded_event.hpp>
+#include <mongocxx/events/command_timing.hpp>
+#include <mongocxx/events/connection_check_out_failed_event.hpp>
+#include <mongocxx/events/connection_checked_out_event.hpp>
 #include <mongocxx/events/heartbeat_failed_event.hpp>
 #include <mongocxx/events/heartbeat_started_event.hpp>
 #include <mongocxx/events/heartbeat_succeeded_event.hpp>
+#include <mongocxx/events/pool_cleared_event.hpp>
 #include <mongocxx/events/server_changed_event.hpp>
 #include <mongocxx/events/server_closed_event.hpp>
 #include <mongocxx/events/server_opening_event.hpp>
 #include <mongocxx/events/topology_changed_event.hpp>
 #include <mongocxx/events/topology_closed_event.hpp>
 #include <mongocxx/events/topology_opening_event.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/tracer.hpp>
 
 #include <mongocxx/config/prelude.hpp>
 
@@ -305,6 +317,367 @@ class MONGOCXX_API apm {
     const std::function<void(const mongocxx::events::heartbeat_succeeded_event&)>&
     heartbeat_succeeded() const;
 
+    ///
+    /// The type of the command timing callback.
+    ///
+    using command_timing_fn = void (*)(const mongocxx::events::command_timing& timing,
+                                       void* context);
+
+    ///
+    /// Set a lightweight callback for the timing of completed commands. It is called for every
+    /// monitored command that succeeds or fails, in addition to the command succeeded and command
+    /// failed callbacks, if any.
+    ///
+    /// The callback is a plain function pointer called directly from the driver's event, and it
+    /// receives only the request id, command name, duration and server of the command. No event
+    /// object or std::function is involved, and no command or reply document is exposed, which
+    /// keeps the cost of monitoring low enough for latency metrics on every operation.
+    ///
+    /// @param command_timing
+    ///   The command timing callback, or nullptr to unset it.
+    ///
+    /// @param context
+    ///   An opaque pointer passed to every call of the callback.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& on_command_timing(command_timing_fn command_timing, void* context = nullptr);
+
+    ///
+    /// Retrieves the command timing callback.
+    ///
+    /// @return The command timing callback, or nullptr if none has been set.
+    ///
+    command_timing_fn command_timing() const;
+
+    ///
+    /// Retrieves the context passed to the command timing callback.
+    ///
+    /// @return The command timing context.
+    ///
+    void* command_timing_context() const;
+
+    ///
+    /// Monitor only one in every `rate` commands. The command started, command succeeded, command
+    /// failed and command timing callbacks are only called for commands whose request id is a
+    /// multiple of `rate`, so that all the events of a sampled command are delivered and those of
+    /// the others are skipped before any event object is made. Server, topology and heartbeat
+    /// events are not sampled. Defaults to 1, which monitors every command.
+    ///
+    /// @param rate
+    ///   The sampling rate. Must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `rate` is zero.
+    ///
+    apm& command_sample_rate(std::uint32_t rate);
+
+    ///
+    /// Retrieves the command sampling rate.
+    ///
+    /// @return The command sampling rate.
+    ///
+    std::uint32_t command_sample_rate() const;
+
+    ///
+    /// Set the pool cleared monitoring callback. The callback takes a reference to a
+    /// pool_cleared_event which will only contain valid data for the duration of the callback.
+    ///
+    /// The event is sent when a server that was known becomes Unknown, which is when the driver
+    /// stops reusing its connections to that server.
+    ///
+    /// @param pool_cleared
+    ///   The pool cleared monitoring callback.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& on_pool_cleared(
+        std::function<void(const mongocxx::events::pool_cleared_event&)> pool_cleared);
+
+    ///
+    /// Retrieves the pool cleared monitoring callback.
+    ///
+    /// @return The pool cleared monitoring callback.
+    ///
+    const std::function<void(const mongocxx::events::pool_cleared_event&)>& pool_cleared() const;
+
+    ///
+    /// Set the connection checked out monitoring callback, called when a mongocxx::pool hands out
+    /// a client. Only applies when these options are used to construct a pool.
+    ///
+    /// @param connection_checked_out
+    ///   The connection checked out monitoring callback.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& on_connection_checked_out(
+        std::function<void(const mongocxx::events::connection_checked_out_event&)>
+            connection_checked_out);
+
+    ///
+    /// Retrieves the connection checked out monitoring callback.
+    ///
+    /// @return The connection checked out monitoring callback.
+    ///
+    const std::function<void(const mongocxx::events::connection_checked_out_event&)>&
+    connection_checked_out() const;
+
+    ///
+    /// Set the connection check out failed monitoring callback, called when a mongocxx::pool
+    /// cannot hand out a client. Only applies when these options are used to construct a pool.
+    ///
+    /// @param connection_check_out_failed
+    ///   The connection check out failed monitoring callback.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& on_connection_check_out_failed(
+        std::function<void(const mongocxx::events::connection_check_out_failed_event&)>
+            connection_check_out_failed);
+
+    ///
+    /// Retrieves the connection check out failed monitoring callback.
+    ///
+    /// @return The connection check out failed monitoring callback.
+    ///
+    const std::function<void(const mongocxx::events::connection_check_out_failed_event&)>&
+    connection_check_out_failed() const;
+
+    ///
+    /// Set a tracer, which is given a span for each sampled command, started with its started
+    /// event and ended with its succeeded or failed event. When no tracer is set, commands are not
+    /// traced at all.
+    ///
+    /// @param span_tracer
+    ///   The tracer.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& tracer(std::shared_ptr<mongocxx::tracer> span_tracer);
+
+    ///
+    /// Retrieves the tracer.
+    ///
+    /// @return The tracer, or a null pointer if none is set.
+    ///
+    const std::shared_ptr<mongocxx::tracer>& tracer() const;
+
+    ///
+    /// Record the durations of succeeded commands in built-in latency histograms, kept per command
+    /// name and server, which can be read with client::command_latencies() or
+    /// pool::command_latencies(). Recording is lock-free and does not make an event object.
+    /// Only sampled commands are recorded; see command_sample_rate().
+    ///
+    /// @param record
+    ///   Whether to record command latencies.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& record_command_latencies(bool record);
+
+    ///
+    /// Retrieves whether command latencies are recorded.
+    ///
+    /// @return Whether command latencies are recorded.
+    ///
+    bool record_command_latencies() const;
+
+    ///
+    /// Count the commands run and the bytes of their documents and replies, which can be read with
+    /// client::compression_statistics() or pool::compression_statistics(). Counting is two relaxed
+    /// atomic additions per command.
+    ///
+    /// @param record
+    ///   Whether to count command bytes.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& record_command_bytes(bool record);
+
+    ///
+    /// Retrieves whether command bytes are counted.
+    ///
+    /// @return Whether command bytes are counted.
+    ///
+    bool record_command_bytes() const;
+
+    ///
+    /// Count the commands run against each collection, by command, with the documents they
+    /// returned or wrote and the bytes of their documents and replies. The counts can be read with
+    /// client::namespace_stats() or pool::namespace_stats(). Every command is counted, regardless
+    /// of command_sample_rate(). Counting is lock-free and does not make an event object.
+    ///
+    /// @param record
+    ///   Whether to count commands per namespace.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& record_namespace_stats(bool record);
+
+    ///
+    /// Retrieves whether commands are counted per namespace.
+    ///
+    /// @return Whether commands are counted per namespace.
+    ///
+    bool record_namespace_stats() const;
+
+    ///
+    /// Collect the bytes sent and received, the round-trips and the command durations of each
+    /// operation, available from result::bulk_write::stats(), result::insert_many::stats() and
+    /// cursor::stats(). Every command is counted, regardless of command_sample_rate().
+    ///
+    /// @param record
+    ///   Whether to collect operation statistics.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& record_operation_stats(bool record);
+
+    ///
+    /// Retrieves whether operation statistics are collected.
+    ///
+    /// @return Whether operation statistics are collected.
+    ///
+    bool record_operation_stats() const;
+
+    ///
+    /// Time the phases of each operation run on the calling thread, available from
+    /// last_operation_timings(), to tell whether client-side CPU or the network limits a call
+    /// site. Operations on every thread are timed while a client or pool with this option
+    /// exists, at the cost of a few clock reads per operation.
+    ///
+    /// @param record
+    ///   Whether to time operations.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    apm& record_operation_timings(bool record);
+
+    ///
+    /// Retrieves whether operations are timed.
+    ///
+    /// @return Whether operations are timed.
+    ///
+    bool record_operation_timings() const;
+
+    ///
+    /// Deliver command timings on a dedicated thread rather than on the thread running the
+    /// command, so that a slow command timing callback does not add to the latency of operations.
+    ///
+    /// Each timing is copied into a bounded lock-free queue, which is drained by a thread started
+    /// with the client or pool and stopped, after delivering what is left, when it is destroyed.
+    /// A timing that finds the queue full is dropped and counted; see
+    /// client::dropped_apm_events() and pool::dropped_apm_events(). Command names longer than 64
+    /// characters are truncated.
+    ///
+    /// This only applies to the callback set with on_command_timing(). The other callbacks are
+    /// still called inline, since their events refer to data that only lives as long as the
+    /// callback.
+    ///
+    /// @param queue_capacity
+    ///   The most timings waiting for delivery at once. It is rounded up to a power of two.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `queue_capacity` is zero.
+    ///
+    apm& async_delivery(std::size_t queue_capacity);
+
+    ///
+    /// Retrieves the capacity of the asynchronous delivery queue.
+    ///
+    /// @return The queue capacity, if asynchronous delivery is enabled.
+    ///
+    const stdx::optional<std::size_t>& async_delivery() const;
+
+    ///
+    /// Keep the most recent commands that took at least `threshold`, with their namespace, the
+    /// shape of their filter, their duration and their server, which can be read with
+    /// client::slow_commands() or pool::slow_commands(). Every command is considered, regardless of
+    /// command_sample_rate().
+    ///
+    /// The filter of every command is copied when it starts, since its duration is only known
+    /// once it completes; commands that turn out faster than the threshold are then forgotten.
+    ///
+    /// @param threshold
+    ///   The shortest duration of a command that is kept.
+    /// @param capacity
+    ///   The most commands kept. Once it is reached, each slow command replaces the oldest.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `threshold` is negative or `capacity` is zero.
+    ///
+    apm& record_slow_commands(std::chrono::milliseconds threshold, std::size_t capacity = 256);
+
+    ///
+    /// Retrieves the threshold of slow commands.
+    ///
+    /// @return The threshold, if slow commands are recorded.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& slow_command_threshold() const;
+
+    ///
+    /// Retrieves the most slow commands kept.
+    ///
+    /// @return The capacity of the slow command log.
+    ///
+    std::size_t slow_command_capacity() const;
+
+    ///
+    /// Count the filter shapes run against each collection, which can be read with
+    /// client::query_shapes() or pool::query_shapes() and checked against the collections' indexes
+    /// with mongocxx::unindexed_query_shapes(). Every command with a filter is counted, regardless
+    /// of command_sample_rate().
+    ///
+    /// The filter of every command is shaped when it starts, so this is meant for staging and
+    /// test deployments rather than for production.
+    ///
+    /// @param capacity
+    ///   The most distinct shapes kept. Once it is reached, new shapes are not counted.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `capacity` is zero.
+    ///
+    apm& record_query_shapes(std::size_t capacity = 1024);
+
+    ///
+    /// Retrieves the most distinct filter shapes counted.
+    ///
+    /// @return The capacity, if filter shapes are counted.
+    ///
+    const stdx::optional<std::size_t>& query_shape_capacity() const;
+
    private:
     std::function<void(const mongocxx::events::command_started_event&)> _command_started;
     std::function<void(const mongocxx::events::command_failed_event&)> _command_failed;
@@ -318,6 +691,24 @@ class MONGOCXX_API apm {
     std::function<void(const mongocxx::events::heartbeat_started_event&)> _heartbeat_started;
     std::function<void(const mongocxx::events::heartbeat_failed_event&)> _heartbeat_failed;
     std::function<void(const mongocxx::events::heartbeat_succeeded_event&)> _heartbeat_succeeded;
+    std::function<void(const mongocxx::events::pool_cleared_event&)> _pool_cleared;
+    std::function<void(const mongocxx::events::connection_checked_out_event&)>
+        _connection_checked_out;
+    std::function<void(const mongocxx::events::connection_check_out_failed_event&)>
+        _connection_check_out_failed;
+    command_timing_fn _command_timing = nullptr;
+    void* _command_timing_context = nullptr;
+    std::uint32_t _command_sample_rate = 1;
+    bool _record_command_latencies = false;
+    bool _record_command_bytes = false;
+    bool _record_namespace_stats = false;
+    bool _record_operation_stats = false;
+    bool _record_operation_timings = false;
+    stdx::optional<std::size_t> _async_delivery;
+    stdx::optional<std::chrono::milliseconds> _slow_command_threshold;
+    std::size_t _slow_command_capacity = 256;
+    stdx::optional<std::size_t> _query_shape_capacity;
+    std::shared_ptr<mongocxx::tracer> _tracer;
 };
 
 }  // namespace options
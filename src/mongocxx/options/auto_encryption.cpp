@@ -15,10 +15,14 @@
 #include <mongocxx/options/auto_encryption.hpp>
 
 #include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
 #include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/exception.hpp>
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/pool.hpp>
 #include <mongocxx/private/client.hh>
+#include <mongocxx/private/client_session.hh>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
 #include <mongocxx/private/pool.hh>
@@ -94,6 +98,27 @@ const stdx::optional<bsoncxx::document::view_or_value>& auto_encryption::extra_o
     return _extra_options;
 }
 
+auto_encryption& auto_encryption::warm_up_query(ns_pair ns,
+                                                bsoncxx::document::view_or_value filter) {
+    _warm_up_queries.emplace_back(std::move(ns), std::move(filter));
+    return *this;
+}
+
+const std::vector<std::pair<auto_encryption::ns_pair, bsoncxx::document::view_or_value>>&
+auto_encryption::warm_up_queries() const {
+    return _warm_up_queries;
+}
+
+void auto_encryption::warm_up(mongocxx::client& client) const noexcept {
+    for (const auto& query : _warm_up_queries) {
+        try {
+            client[query.first.first][query.first.second].find_one(query.second.view());
+        } catch (const std::exception&) {
+            // The first encrypted operation on the namespace does the same work instead.
+        }
+    }
+}
+
 void* auto_encryption::convert() const {
     using libbson::scoped_bson_t;
 
@@ -124,13 +149,13 @@ void* auto_encryption::convert() const {
     }
 
     if (_kms_providers) {
-        scoped_bson_t kms_providers{*_kms_providers};
+        scoped_bson_t kms_providers{_kms_providers->view()};
         libmongoc::auto_encryption_opts_set_kms_providers(mongoc_auto_encrypt_opts,
                                                           kms_providers.bson());
     }
 
     if (_schema_map) {
-        scoped_bson_t schema_map{*_schema_map};
+        scoped_bson_t schema_map{_schema_map->view()};
         libmongoc::auto_encryption_opts_set_schema_map(mongoc_auto_encrypt_opts, schema_map.bson());
     }
 
@@ -139,7 +164,7 @@ void* auto_encryption::convert() const {
     }
 
     if (_extra_options) {
-        scoped_bson_t extra{*_extra_options};
+        scoped_bson_t extra{_extra_options->view()};
         libmongoc::auto_encryption_opts_set_extra(mongoc_auto_encrypt_opts, extra.bson());
     }
 
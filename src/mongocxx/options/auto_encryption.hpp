@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <bsoncxx/document/view_or_value.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/stdx.hpp>
@@ -242,12 +246,38 @@ class MONGOCXX_API auto_encryption {
     ///
     const stdx::optional<bsoncxx::document::view_or_value>& extra_options() const;
 
+    /// Adds a query to run through automatic encryption when a client or pool is created with
+    /// these options, before the client or pool is handed to the application.
+    /// The first encrypted operation otherwise pays for connecting to mongocryptd, fetching the
+    /// data keys it needs from the key vault, and decrypting them with the KMS provider.
+    /// libmongocrypt caches decrypted data keys for a minute, and neither it nor libmongoc lets
+    /// the size or lifetime of that cache be configured; a warm-up query whose filter compares
+    /// deterministically encrypted fields with sample values loads their keys into the cache
+    /// ahead of the first real operation. The documents found are discarded, and a failed
+    /// warm-up query is ignored, leaving the work to the first operation.
+    /// @param ns
+    ///   A std::pair of strings naming the database and collection to query.
+    /// @param filter
+    ///   The filter of the query. Any view must outlive the creation of the client or pool.
+    /// @return
+    ///   A reference to this object to facilitate method chaining.
+    auto_encryption& warm_up_query(ns_pair ns, bsoncxx::document::view_or_value filter);
+
+    /// Gets the warm-up queries.
+    /// @return
+    ///   The namespaces and filters of the queries, in the order in which they were added.
+    const std::vector<std::pair<ns_pair, bsoncxx::document::view_or_value>>& warm_up_queries()
+        const;
+
    private:
     friend class mongocxx::client;
     friend class mongocxx::pool;
 
     MONGOCXX_PRIVATE void* convert() const;
 
+    // Runs the warm-up queries on a client with automatic encryption enabled.
+    MONGOCXX_PRIVATE void warm_up(mongocxx::client& client) const noexcept;
+
     bool _bypass;
     stdx::optional<mongocxx::client*> _key_vault_client;
     stdx::optional<mongocxx::pool*> _key_vault_pool;
@@ -255,6 +285,7 @@ class MONGOCXX_API auto_encryption {
     stdx::optional<bsoncxx::document::view_or_value> _kms_providers;
     stdx::optional<bsoncxx::document::view_or_value> _schema_map;
     stdx::optional<bsoncxx::document::view_or_value> _extra_options;
+    std::vector<std::pair<ns_pair, bsoncxx::document::view_or_value>> _warm_up_queries;
 };
 
 }  // namespace options
@@ -20,7 +20,8 @@ namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 namespace options {
 
-bulk_write::bulk_write() : _ordered(true) {}
+bulk_write::bulk_write()
+    : _ordered(true), _parallelism_pool(nullptr), _shard_partitioning_pool(nullptr) {}
 
 bulk_write& bulk_write::ordered(bool ordered) {
     _ordered = ordered;
@@ -49,6 +50,29 @@ const stdx::optional<bool> bulk_write::bypass_document_validation() const {
     return _bypass_document_validation;
 }
 
+bulk_write& bulk_write::parallelism(std::uint32_t connections, class pool& pool) {
+    _parallelism = connections;
+    _parallelism_pool = &pool;
+    return *this;
+}
+
+const stdx::optional<std::uint32_t>& bulk_write::parallelism() const {
+    return _parallelism;
+}
+
+class pool* bulk_write::parallelism_pool() const {
+    return _parallelism_pool;
+}
+
+bulk_write& bulk_write::shard_partitioning(class pool& pool) {
+    _shard_partitioning_pool = &pool;
+    return *this;
+}
+
+class pool* bulk_write::shard_partitioning_pool() const {
+    return _shard_partitioning_pool;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/write_concern.hpp>
 
@@ -21,6 +23,9 @@
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
 namespace options {
 
 ///
@@ -103,10 +108,96 @@ class MONGOCXX_API bulk_write {
     ///
     const stdx::optional<bool> bypass_document_validation() const;
 
+    ///
+    /// Spreads an unordered bulk write across several connections.
+    ///
+    /// Appended operations are distributed round-robin between the collection the bulk write was
+    /// created from and `connections - 1` further clients acquired from `pool`. On execute() the
+    /// resulting sub-batches are sent concurrently, one per client, and their results are merged
+    /// into a single result::bulk_write. Indexes in the merged result (e.g. of upserted ids and
+    /// write errors) refer to the order in which operations were appended, as without this option.
+    ///
+    /// @note
+    ///   Only unordered bulk writes outside of a session can be parallelized; creating an ordered
+    ///   or session-bound bulk write with this option set throws a logic_error. The pooled clients
+    ///   are held for the lifetime of the bulk write, so `pool` must outlive it and should allow
+    ///   enough connections.
+    ///
+    /// @param connections
+    ///   The number of concurrent connections to use. A value of 1 disables parallelism.
+    /// @param pool
+    ///   The pool from which the additional clients are acquired.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_write& parallelism(std::uint32_t connections, class pool& pool);
+
+    ///
+    /// The current number of connections an unordered bulk write is spread across.
+    ///
+    /// @return
+    ///   The current parallelism setting.
+    ///
+    const stdx::optional<std::uint32_t>& parallelism() const;
+
+    ///
+    /// The pool from which the additional clients for a parallel bulk write are acquired.
+    ///
+    /// @return
+    ///   The pool set with parallelism(), or nullptr if none has been set.
+    ///
+    class pool* parallelism_pool() const;
+
+    ///
+    /// Groups the operations of an unordered bulk write on a sharded collection by the shard that
+    /// owns them, and sends each shard's operations concurrently as its own sub-batch.
+    ///
+    /// The collection's shard key and chunk ranges are read from config.collections and
+    /// config.chunks when the bulk write is created, and cached per deployment and namespace. An
+    /// insert is routed by its document, and an update, replace or delete by its filter if the
+    /// filter compares every shard key field for equality. The writes of each shard go through
+    /// mongos over a client acquired from `pool`, so that mongos forwards them to one shard
+    /// instead of splitting one large batch; writes whose shard is unknown go through the
+    /// collection the bulk write was created from. Indexes in the merged result refer to the
+    /// order in which operations were appended.
+    ///
+    /// A cached routing table can go stale as chunks migrate. Mongos still delivers every write
+    /// correctly in that case, and the cache entry is dropped when the server reports stale
+    /// routing information, so that the next bulk write reads the chunks again. Collections that
+    /// are not sharded or have a hashed shard key are written as without this option.
+    ///
+    /// @note
+    ///   As with parallelism(), only unordered bulk writes outside of a session can be
+    ///   partitioned, and the two options cannot be combined; creating a bulk write otherwise
+    ///   throws a logic_error. The pooled clients are held for the lifetime of the bulk write.
+    ///
+    /// @param pool
+    ///   The pool connected to the cluster's mongos routers from which the clients of the
+    ///   sub-batches are acquired.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    bulk_write& shard_partitioning(class pool& pool);
+
+    ///
+    /// The pool from which the clients of a shard-partitioned bulk write are acquired.
+    ///
+    /// @return
+    ///   The pool set with shard_partitioning(), or nullptr if none has been set.
+    ///
+    class pool* shard_partitioning_pool() const;
+
    private:
     bool _ordered;
     stdx::optional<class write_concern> _write_concern;
     stdx::optional<bool> _bypass_document_validation;
+    stdx::optional<std::uint32_t> _parallelism;
+    class pool* _parallelism_pool;
+    class pool* _shard_partitioning_pool;
 };
 
 }  // namespace options
@@ -83,6 +83,24 @@ const stdx::optional<std::chrono::milliseconds>& change_stream::max_await_time()
     return _max_await_time;
 }
 
+change_stream& change_stream::prefetch_batches(std::int32_t prefetch_batches) {
+    _prefetch_batches = prefetch_batches;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& change_stream::prefetch_batches() const {
+    return _prefetch_batches;
+}
+
+change_stream& change_stream::max_prefetched_bytes(std::int64_t max_prefetched_bytes) {
+    _max_prefetched_bytes = max_prefetched_bytes;
+    return *this;
+}
+
+const stdx::optional<std::int64_t>& change_stream::max_prefetched_bytes() const {
+    return _max_prefetched_bytes;
+}
+
 change_stream& change_stream::start_at_operation_time(bsoncxx::types::b_timestamp timestamp) {
     _start_at_operation_time = timestamp;
     _start_at_operation_time_set = true;
@@ -177,6 +177,61 @@ class MONGOCXX_API change_stream {
     ///
     const stdx::optional<std::chrono::milliseconds>& max_await_time() const;
 
+    ///
+    /// When set, the change stream reads events on a background thread, issuing the next getMore
+    /// while the application is still processing earlier events, and keeps up to this many
+    /// batches of batch_size events (101 if batch_size is not set) waiting to be consumed. The
+    /// resume token reported by the stream still follows the last event the application consumed.
+    ///
+    /// @warning
+    ///   The background thread uses the client the stream was opened on for as long as the stream
+    ///   exists, so the application must not use that client, or any database, collection or
+    ///   other object obtained from it, until the stream is destroyed. Acquiring a dedicated client
+    ///   from a mongocxx::pool for the stream is the usual way to satisfy this. Destroying the
+    ///   stream waits for an outstanding getMore, i.e. for up to max_await_time.
+    ///
+    /// @param prefetch_batches
+    ///   The number of batches to keep ready, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    change_stream& prefetch_batches(std::int32_t prefetch_batches);
+
+    ///
+    /// Gets the current number of batches the stream reads ahead.
+    ///
+    /// @return The current prefetch_batches setting.
+    ///
+    const stdx::optional<std::int32_t>& prefetch_batches() const;
+
+    ///
+    /// Sets the most bytes of prefetched batches waiting to be consumed.
+    ///
+    /// With prefetch_batches(), the background thread stops reading ahead once the batches it has
+    /// ready hold this many bytes, in addition to the limit on their number, and waits for the
+    /// application to consume one before it issues the next getMore. A batch is always kept ready
+    /// when none is, however large. The batches also count against the budget of the client; see
+    /// options::client::max_buffered_reply_bytes(). By default only prefetch_batches() limits the
+    /// read-ahead.
+    ///
+    /// @param max_prefetched_bytes
+    ///   The most bytes of events to keep ready, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    change_stream& max_prefetched_bytes(std::int64_t max_prefetched_bytes);
+
+    ///
+    /// Gets the most bytes of prefetched batches waiting to be consumed.
+    ///
+    /// @return The current max_prefetched_bytes setting.
+    ///
+    const stdx::optional<std::int64_t>& max_prefetched_bytes() const;
+
     ///
     /// Specifies the logical starting point for the new change stream. Changes are returned at or
     /// after the specified operation time.
@@ -205,6 +260,8 @@ class MONGOCXX_API change_stream {
     stdx::optional<bsoncxx::document::view_or_value> _resume_after;
     stdx::optional<bsoncxx::document::view_or_value> _start_after;
     stdx::optional<std::chrono::milliseconds> _max_await_time;
+    stdx::optional<std::int32_t> _prefetch_batches;
+    stdx::optional<std::int64_t> _max_prefetched_bytes;
     // _start_at_operation_time is not wrapped in a stdx::optional because of a longstanding bug in
     // the MNMLSTC polyfill that has been fixed on master, but not in the latest release:
     // https://github.com/mnmlstc/core/pull/23
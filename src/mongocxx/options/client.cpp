@@ -14,6 +14,9 @@
 
 #include <mongocxx/options/client.hpp>
 
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
 #include <mongocxx/config/private/prelude.hh>
 
 namespace mongocxx {
@@ -55,6 +58,72 @@ const stdx::optional<auto_encryption>& client::auto_encryption_opts() const {
     return _auto_encrypt_opts;
 }
 
+client& client::local_threshold(std::chrono::milliseconds local_threshold) {
+    if (local_threshold < std::chrono::milliseconds::zero()) {
+        throw logic_error{error_code::k_invalid_parameter, "local_threshold must not be negative"};
+    }
+    _local_threshold = local_threshold;
+    return *this;
+}
+
+const stdx::optional<std::chrono::milliseconds>& client::local_threshold() const {
+    return _local_threshold;
+}
+
+client& client::compressors(std::vector<std::string> compressors) {
+    for (auto&& name : compressors) {
+        if (name != "snappy" && name != "zlib" && name != "zstd") {
+            throw logic_error{error_code::k_invalid_parameter, "unknown compressor: " + name};
+        }
+    }
+    _compressors = std::move(compressors);
+    return *this;
+}
+
+const stdx::optional<std::vector<std::string>>& client::compressors() const {
+    return _compressors;
+}
+
+client& client::zlib_compression_level(std::int32_t level) {
+    if (level < -1 || level > 9) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "zlib_compression_level must be between -1 and 9"};
+    }
+    _zlib_compression_level = level;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& client::zlib_compression_level() const {
+    return _zlib_compression_level;
+}
+
+client& client::socket_opts(socket socket_opts) {
+    _socket_opts = std::move(socket_opts);
+    return *this;
+}
+
+const stdx::optional<socket>& client::socket_opts() const {
+    return _socket_opts;
+}
+
+client& client::stream_initiator(stream_initiator_type stream_initiator) {
+    _stream_initiator = std::move(stream_initiator);
+    return *this;
+}
+
+const client::stream_initiator_type& client::stream_initiator() const {
+    return _stream_initiator;
+}
+
+client& client::max_buffered_reply_bytes(std::int64_t max_buffered_reply_bytes) {
+    _max_buffered_reply_bytes = max_buffered_reply_bytes;
+    return *this;
+}
+
+const stdx::optional<std::int64_t>& client::max_buffered_reply_bytes() const {
+    return _max_buffered_reply_bytes;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -14,11 +14,17 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
 #include <mongocxx/options/apm.hpp>
 #include <mongocxx/options/auto_encryption.hpp>
+#include <mongocxx/options/socket.hpp>
 #include <mongocxx/options/tls.hpp>
 
 #include <mongocxx/config/prelude.hpp>
@@ -116,10 +122,180 @@ class MONGOCXX_API client {
     ///
     const stdx::optional<apm>& apm_opts() const;
 
+    ///
+    /// Sets the width of the latency window of server selection, overriding localThresholdMS in
+    /// the URI.
+    ///
+    /// Reads are spread at random over the eligible servers whose round trip time is within this
+    /// window of the fastest one, so narrowing it steers more reads to the fastest secondaries,
+    /// while widening it spreads reads more evenly. The window applies to every read preference of
+    /// the client or pool: server selection has a single latency window per deployment.
+    ///
+    /// @param local_threshold
+    ///   The width of the latency window, which must not be negative.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `local_threshold` is negative.
+    ///
+    /// @see https://docs.mongodb.com/manual/reference/connection-string/#urioption.localThresholdMS
+    ///
+    client& local_threshold(std::chrono::milliseconds local_threshold);
+
+    ///
+    /// The current width of the latency window of server selection.
+    ///
+    /// @return The width of the latency window.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& local_threshold() const;
+
+    ///
+    /// Sets the compressors offered to servers for wire protocol compression, in order of
+    /// preference, overriding compressors in the URI. Each server uses the first one it supports,
+    /// and an empty list disables compression.
+    ///
+    /// Compression trades CPU time for bandwidth, which mostly pays off across data centers.
+    /// compression_statistics() of the client or pool reports which compressor each server uses.
+    ///
+    /// @param compressors
+    ///   The names of the compressors, among "snappy", "zlib" and "zstd". A compressor that the
+    ///   driver was built without is ignored with a warning.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if a name is not that of a known compressor.
+    ///
+    /// @see https://docs.mongodb.com/manual/reference/connection-string/#compression-options
+    ///
+    client& compressors(std::vector<std::string> compressors);
+
+    ///
+    /// The current compressors offered to servers.
+    ///
+    /// @return The names of the compressors.
+    ///
+    const stdx::optional<std::vector<std::string>>& compressors() const;
+
+    ///
+    /// Sets the compression level of zlib, overriding zlibCompressionLevel in the URI. Snappy and
+    /// zstd have no configurable level.
+    ///
+    /// @param level
+    ///   From 1, the fastest, to 9, the most compact, or 0 for no compression and -1 for the
+    ///   default level of zlib.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `level` is not between -1 and 9.
+    ///
+    /// @see https://docs.mongodb.com/manual/reference/connection-string/#compression-options
+    ///
+    client& zlib_compression_level(std::int32_t level);
+
+    ///
+    /// The current compression level of zlib.
+    ///
+    /// @return The compression level.
+    ///
+    const stdx::optional<std::int32_t>& zlib_compression_level() const;
+
+    ///
+    /// Sets the socket options applied to every connection the client opens to a server.
+    ///
+    /// @param socket_opts
+    ///   The socket options.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    client& socket_opts(socket socket_opts);
+
+    ///
+    /// The current socket options.
+    ///
+    /// @return The socket options.
+    ///
+    const stdx::optional<socket>& socket_opts() const;
+
+    ///
+    /// A function opening the connections of a client to a server, in place of libmongoc's TCP,
+    /// Unix domain socket and TLS streams, for instance over a kernel-bypass network stack.
+    ///
+    /// It is called with the host and port of the server, and must return a connected
+    /// mongoc_stream_t*, which the driver then owns, or throw a std::exception to fail the
+    /// connection with its message. The function is called by the threads running operations,
+    /// possibly concurrently. It is not called for the connections which monitor the servers of
+    /// a pool, which libmongoc always opens itself. TLS is not applied to custom streams.
+    ///
+    /// @see http://mongoc.org/libmongoc/current/mongoc_client_set_stream_initiator.html
+    ///
+    using stream_initiator_type = std::function<void*(stdx::string_view host, std::uint16_t port)>;
+
+    ///
+    /// Sets the stream initiator opening the connections of the client.
+    ///
+    /// @param stream_initiator
+    ///   The stream initiator.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    client& stream_initiator(stream_initiator_type stream_initiator);
+
+    ///
+    /// The current stream initiator.
+    ///
+    /// @return The stream initiator, or an empty function if libmongoc opens the connections.
+    ///
+    const stream_initiator_type& stream_initiator() const;
+
+    ///
+    /// Sets the most bytes of replies the driver keeps buffered for the client, or for every client
+    /// of a pool, ahead of the application.
+    ///
+    /// The budget covers the batches read ahead by cursors and change streams with
+    /// prefetch_batches(), including those of GridFS downloads. Once it is used up, a cursor
+    /// waits to issue its next getMore until the application consumes enough of what is buffered.
+    /// A cursor with no batch ready is always allowed one, so the usage may exceed the budget by
+    /// up to a batch per cursor. The replies libmongoc holds for cursors without prefetching are
+    /// not counted. By default, the bytes are counted but not limited.
+    ///
+    /// @param max_buffered_reply_bytes
+    ///   The most bytes to keep buffered, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @see mongocxx::client::buffered_reply_bytes
+    ///
+    client& max_buffered_reply_bytes(std::int64_t max_buffered_reply_bytes);
+
+    ///
+    /// The current max_buffered_reply_bytes setting.
+    ///
+    /// @return The most bytes of replies to keep buffered.
+    ///
+    const stdx::optional<std::int64_t>& max_buffered_reply_bytes() const;
+
    private:
     stdx::optional<tls> _tls_opts;
     stdx::optional<apm> _apm_opts;
     stdx::optional<auto_encryption> _auto_encrypt_opts;
+    stdx::optional<std::chrono::milliseconds> _local_threshold;
+    stdx::optional<std::vector<std::string>> _compressors;
+    stdx::optional<std::int32_t> _zlib_compression_level;
+    stdx::optional<socket> _socket_opts;
+    stream_initiator_type _stream_initiator;
+    stdx::optional<std::int64_t> _max_buffered_reply_bytes;
 };
 
 }  // namespace options
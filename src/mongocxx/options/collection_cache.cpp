@@ -0,0 +1,85 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/options/collection_cache.hpp>
+
+#include <utility>
+
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+collection_cache& collection_cache::max_documents(std::size_t max_documents) {
+    if (max_documents == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "max_documents must be positive"};
+    }
+    _max_documents = max_documents;
+    return *this;
+}
+
+collection_cache& collection_cache::shards(std::size_t shards) {
+    if (shards == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "shards must be positive"};
+    }
+    _shards = shards;
+    return *this;
+}
+
+collection_cache& collection_cache::ttl(std::chrono::milliseconds ttl) {
+    if (ttl <= std::chrono::milliseconds::zero()) {
+        throw logic_error{error_code::k_invalid_parameter, "ttl must be positive"};
+    }
+    _ttl = ttl;
+    return *this;
+}
+
+collection_cache& collection_cache::watch(bool watch) {
+    _watch = watch;
+    return *this;
+}
+
+collection_cache& collection_cache::clock(
+    std::function<std::chrono::steady_clock::time_point()> clock) {
+    _clock = std::move(clock);
+    return *this;
+}
+
+const stdx::optional<std::size_t>& collection_cache::max_documents() const {
+    return _max_documents;
+}
+
+const stdx::optional<std::size_t>& collection_cache::shards() const {
+    return _shards;
+}
+
+const stdx::optional<std::chrono::milliseconds>& collection_cache::ttl() const {
+    return _ttl;
+}
+
+const stdx::optional<bool>& collection_cache::watch() const {
+    return _watch;
+}
+
+const std::function<std::chrono::steady_clock::time_point()>& collection_cache::clock() const {
+    return _clock;
+}
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,158 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+///
+/// Class representing the optional arguments to a mongocxx::cached_collection.
+///
+class MONGOCXX_API collection_cache {
+   public:
+    ///
+    /// Sets the most documents the cache holds. Once it is full, looking up a new _id evicts the
+    /// least recently used entry. Defaults to 10000.
+    ///
+    /// @param max_documents
+    ///   The capacity of the cache, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `max_documents` is zero.
+    ///
+    collection_cache& max_documents(std::size_t max_documents);
+
+    ///
+    /// Gets the current capacity of the cache.
+    ///
+    /// @return The most documents the cache holds.
+    ///
+    const stdx::optional<std::size_t>& max_documents() const;
+
+    ///
+    /// Sets the number of shards the cache is split into. Each shard has its own lock and its own
+    /// least recently used order over an equal part of max_documents, so more shards let more
+    /// threads look documents up at once. Defaults to 16.
+    ///
+    /// @param shards
+    ///   The number of shards, which must be positive. It is capped at max_documents.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `shards` is zero.
+    ///
+    collection_cache& shards(std::size_t shards);
+
+    ///
+    /// Gets the current number of shards.
+    ///
+    /// @return The number of shards the cache is split into.
+    ///
+    const stdx::optional<std::size_t>& shards() const;
+
+    ///
+    /// Sets how long a document stays cached after it was read from the server. By default,
+    /// documents stay cached until they are evicted or invalidated.
+    ///
+    /// @param ttl
+    ///   The time to live of an entry, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `ttl` is not positive.
+    ///
+    collection_cache& ttl(std::chrono::milliseconds ttl);
+
+    ///
+    /// Gets the current time to live of an entry.
+    ///
+    /// @return The time to live of an entry.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& ttl() const;
+
+    ///
+    /// Sets whether the cache watches a change stream on the collection to invalidate the entries
+    /// of documents that change. Defaults to true.
+    ///
+    /// Change streams need a replica set or sharded cluster. Without one, entries are only dropped
+    /// when they expire, are evicted or are invalidated explicitly, so a ttl should be set.
+    ///
+    /// @param watch
+    ///   Whether to watch a change stream.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    collection_cache& watch(bool watch);
+
+    ///
+    /// Gets whether the cache watches a change stream.
+    ///
+    /// @return Whether the cache watches a change stream.
+    ///
+    const stdx::optional<bool>& watch() const;
+
+    ///
+    /// Sets the clock the cache reads to decide whether an entry has expired. Defaults to
+    /// std::chrono::steady_clock::now. Mostly useful to tests, which can advance time without
+    /// sleeping.
+    ///
+    /// @param clock
+    ///   The function returning the current time.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    collection_cache& clock(std::function<std::chrono::steady_clock::time_point()> clock);
+
+    ///
+    /// Gets the current clock.
+    ///
+    /// @return The function returning the current time, or an empty function if none was set.
+    ///
+    const std::function<std::chrono::steady_clock::time_point()>& clock() const;
+
+   private:
+    stdx::optional<std::size_t> _max_documents;
+    stdx::optional<std::size_t> _shards;
+    stdx::optional<std::chrono::milliseconds> _ttl;
+    stdx::optional<bool> _watch;
+    std::function<std::chrono::steady_clock::time_point()> _clock;
+};
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -14,6 +14,8 @@
 
 #include <mongocxx/options/count.hpp>
 
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/private/read_preference.hh>
 
 #include <mongocxx/config/private/prelude.hh>
@@ -52,6 +54,19 @@ count& count::read_preference(class read_preference rp) {
     return *this;
 }
 
+count& count::allow_estimate(bool allow_estimate) {
+    _allow_estimate = allow_estimate;
+    return *this;
+}
+
+count& count::cache_ttl(std::chrono::milliseconds cache_ttl) {
+    if (cache_ttl.count() <= 0) {
+        throw logic_error{error_code::k_invalid_parameter, "the count cache TTL must be positive"};
+    }
+    _cache_ttl = cache_ttl;
+    return *this;
+}
+
 const stdx::optional<bsoncxx::document::view_or_value>& count::collation() const {
     return _collation;
 }
@@ -76,6 +91,14 @@ const stdx::optional<read_preference>& count::read_preference() const {
     return _read_preference;
 }
 
+const stdx::optional<bool>& count::allow_estimate() const {
+    return _allow_estimate;
+}
+
+const stdx::optional<std::chrono::milliseconds>& count::cache_ttl() const {
+    return _cache_ttl;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -174,6 +174,57 @@ class MONGOCXX_API count {
     ///
     const stdx::optional<class read_preference>& read_preference() const;
 
+    ///
+    /// Sets whether a count of every document in the collection may be answered from the
+    /// collection's metadata, as by collection::estimated_document_count, instead of by scanning.
+    ///
+    /// The estimate is used only for an empty filter without a session, skip, limit, hint or
+    /// collation; other counts are always exact. The metadata count can be wrong after an unclean
+    /// shutdown or, on a sharded cluster, while orphaned documents or chunk migrations exist.
+    ///
+    /// @param allow_estimate
+    ///   Whether the count may be estimated. Defaults to false.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @see https://docs.mongodb.com/master/reference/method/db.collection.estimatedDocumentCount/
+    ///
+    count& allow_estimate(bool allow_estimate);
+
+    ///
+    /// Gets whether the count may be estimated from the collection's metadata.
+    ///
+    /// @return Whether the count may be estimated.
+    ///
+    const stdx::optional<bool>& allow_estimate() const;
+
+    ///
+    /// Sets how long the result of this count may be reused by later counts of the same
+    /// namespace, filter and options. Counts with a cache TTL are cached by the client, or by
+    /// every client of a pool, so that dashboards polling the same counts do not run a command for
+    /// each poll. A reused count may be up to the TTL out of date. Counts in a session are never
+    /// cached.
+    ///
+    /// @param cache_ttl
+    ///   How long the count may be reused. Must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if cache_ttl is not positive.
+    ///
+    count& cache_ttl(std::chrono::milliseconds cache_ttl);
+
+    ///
+    /// Gets how long the result of this count may be reused.
+    ///
+    /// @return The cache TTL, if one is set.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& cache_ttl() const;
+
    private:
     stdx::optional<bsoncxx::document::view_or_value> _collation;
     stdx::optional<class hint> _hint;
@@ -181,6 +232,8 @@ class MONGOCXX_API count {
     stdx::optional<std::chrono::milliseconds> _max_time;
     stdx::optional<std::int64_t> _skip;
     stdx::optional<class read_preference> _read_preference;
+    stdx::optional<bool> _allow_estimate;
+    stdx::optional<std::chrono::milliseconds> _cache_ttl;
 };
 
 }  // namespace options
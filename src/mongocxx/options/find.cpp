@@ -24,96 +24,151 @@ namespace options {
 
 find& find::allow_disk_use(bool allow_disk_use) {
     _allow_disk_use = allow_disk_use;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::allow_partial_results(bool allow_partial) {
     _allow_partial_results = allow_partial;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::batch_size(std::int32_t batch_size) {
     _batch_size = batch_size;
+    _cached_document.reset();
+    return *this;
+}
+
+find& find::max_batch_bytes(std::int32_t max_batch_bytes) {
+    _max_batch_bytes = max_batch_bytes;
+    _cached_document.reset();
+    return *this;
+}
+
+find& find::adaptive_batch_size(bool adaptive_batch_size) {
+    _adaptive_batch_size = adaptive_batch_size;
+    _cached_document.reset();
+    return *this;
+}
+
+find& find::cache_options_document(bool cache_options_document) {
+    _cache_options_document = cache_options_document;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::collation(bsoncxx::document::view_or_value collation) {
     _collation = std::move(collation);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::comment(bsoncxx::string::view_or_value comment) {
     _comment = std::move(comment);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::cursor_type(cursor::type cursor_type) {
     _cursor_type = cursor_type;
+    _cached_document.reset();
+    return *this;
+}
+
+find& find::exhaust(bool exhaust) {
+    _exhaust = exhaust;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::hint(class hint index_hint) {
     _hint = std::move(index_hint);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::limit(std::int64_t limit) {
     _limit = limit;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::max(bsoncxx::document::view_or_value max) {
     _max = std::move(max);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::max_await_time(std::chrono::milliseconds max_await_time) {
     _max_await_time = std::move(max_await_time);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::max_time(std::chrono::milliseconds max_time) {
     _max_time = std::move(max_time);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::min(bsoncxx::document::view_or_value min) {
     _min = std::move(min);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::no_cursor_timeout(bool no_cursor_timeout) {
     _no_cursor_timeout = no_cursor_timeout;
+    _cached_document.reset();
+    return *this;
+}
+
+find& find::prefetch_batches(std::int32_t prefetch_batches) {
+    _prefetch_batches = prefetch_batches;
+    _cached_document.reset();
+    return *this;
+}
+
+find& find::max_prefetched_bytes(std::int64_t max_prefetched_bytes) {
+    _max_prefetched_bytes = max_prefetched_bytes;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::projection(bsoncxx::document::view_or_value projection) {
     _projection = std::move(projection);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::read_preference(class read_preference rp) {
     _read_preference = std::move(rp);
+    _cached_document.reset();
     return *this;
 }
 
 find& find::return_key(bool return_key) {
     _return_key = return_key;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::show_record_id(bool show_record_id) {
     _show_record_id = show_record_id;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::skip(std::int64_t skip) {
     _skip = skip;
+    _cached_document.reset();
     return *this;
 }
 
 find& find::sort(bsoncxx::document::view_or_value ordering) {
     _ordering = std::move(ordering);
+    _cached_document.reset();
     return *this;
 }
 
@@ -129,6 +184,18 @@ const stdx::optional<std::int32_t>& find::batch_size() const {
     return _batch_size;
 }
 
+const stdx::optional<std::int32_t>& find::max_batch_bytes() const {
+    return _max_batch_bytes;
+}
+
+const stdx::optional<bool>& find::adaptive_batch_size() const {
+    return _adaptive_batch_size;
+}
+
+const stdx::optional<bool>& find::cache_options_document() const {
+    return _cache_options_document;
+}
+
 const stdx::optional<bsoncxx::document::view_or_value>& find::collation() const {
     return _collation;
 }
@@ -141,6 +208,10 @@ const stdx::optional<cursor::type>& find::cursor_type() const {
     return _cursor_type;
 }
 
+const stdx::optional<bool>& find::exhaust() const {
+    return _exhaust;
+}
+
 const stdx::optional<class hint>& find::hint() const {
     return _hint;
 }
@@ -169,6 +240,14 @@ const stdx::optional<bool>& find::no_cursor_timeout() const {
     return _no_cursor_timeout;
 }
 
+const stdx::optional<std::int32_t>& find::prefetch_batches() const {
+    return _prefetch_batches;
+}
+
+const stdx::optional<std::int64_t>& find::max_prefetched_bytes() const {
+    return _max_prefetched_bytes;
+}
+
 const stdx::optional<bsoncxx::document::view_or_value>& find::projection() const {
     return _projection;
 }
@@ -16,7 +16,9 @@
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 
+#include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view_or_value.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <bsoncxx/string/view_or_value.hpp>
@@ -28,6 +30,9 @@
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class collection;
+
 namespace options {
 
 ///
@@ -106,6 +111,84 @@ class MONGOCXX_API find {
     ///
     const stdx::optional<std::int32_t>& batch_size() const;
 
+    ///
+    /// Sets a budget in bytes for each batch the cursor requests after the first.
+    ///
+    /// The cursor measures the mean length of the documents it returns and, after every batch
+    /// worth of documents, sets the batch size of its next getMore to the number of such
+    /// documents that fit in the budget, so that small documents take fewer round trips and large
+    /// documents do not pull huge replies into memory. batch_size, if set, is the size of the
+    /// first batch, which is otherwise the server's default of 101 documents.
+    ///
+    /// @param max_batch_bytes
+    ///   The number of bytes a batch should not exceed, which must be positive. Batches hold at
+    ///   least one document, however large.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    find& max_batch_bytes(std::int32_t max_batch_bytes);
+
+    ///
+    /// The current batch byte budget.
+    ///
+    /// @return The current max_batch_bytes setting.
+    ///
+    const stdx::optional<std::int32_t>& max_batch_bytes() const;
+
+    ///
+    /// Sets whether the cursor adapts its batch size to how fast the application consumes
+    /// documents.
+    ///
+    /// After every batch worth of documents, an adaptive cursor doubles the batch size of its next
+    /// getMore while waiting on the server takes a third or more of the time, and halves it, down
+    /// to 16 documents, while waiting takes under a sixteenth of the time the application spends
+    /// between documents. Batches never exceed max_batch_bytes, or 16 MiB if it is not set. For
+    /// a prefetching cursor, the time the background thread waits for the application to make
+    /// room counts as the application's time.
+    ///
+    /// @param adaptive_batch_size
+    ///   Whether to adapt the batch size.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    find& adaptive_batch_size(bool adaptive_batch_size);
+
+    ///
+    /// The current adaptive_batch_size setting.
+    ///
+    /// @return Whether the cursor adapts its batch size.
+    ///
+    const stdx::optional<bool>& adaptive_batch_size() const;
+
+    ///
+    /// Sets whether the options document sent with each find is built once and reused.
+    ///
+    /// Without this, every call to collection::find converts these options into a new BSON
+    /// document. With it, the document is built by the first find and reused by later ones until
+    /// a setter is called, which drops it. Copies of the options share the document. Views passed
+    /// to the setters are copied into the document when it is built, so the data they refer to
+    /// must not change while the cached document is in use.
+    ///
+    /// @param cache_options_document
+    ///   Whether to reuse the options document between calls to find.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    find& cache_options_document(bool cache_options_document);
+
+    ///
+    /// Gets whether the options document sent with each find is built once and reused.
+    ///
+    /// @return Whether the options document is reused.
+    ///
+    const stdx::optional<bool>& cache_options_document() const;
+
     ///
     /// Sets the collation for this operation.
     ///
@@ -177,6 +260,30 @@ class MONGOCXX_API find {
     ///
     const stdx::optional<cursor::type>& cursor_type() const;
 
+    ///
+    /// Sets whether the cursor is an exhaust cursor. The server streams the replies of an exhaust
+    /// cursor back to back without waiting for a getMore, which speeds up reading a large result
+    /// set in full.
+    ///
+    /// @note An exhaust cursor occupies its connection until it is exhausted or destroyed, and
+    ///   cannot be combined with a limit or used in a session. It is not supported by mongos.
+    ///
+    /// @param exhaust
+    ///   Whether to use an exhaust cursor.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    find& exhaust(bool exhaust);
+
+    ///
+    /// Gets the current exhaust setting.
+    ///
+    /// @return The current exhaust setting.
+    ///
+    const stdx::optional<bool>& exhaust() const;
+
     ///
     /// Sets the index to use for this operation.
     ///
@@ -347,6 +454,62 @@ class MONGOCXX_API find {
     ///
     const stdx::optional<bool>& no_cursor_timeout() const;
 
+    ///
+    /// Sets the number of batches the cursor reads ahead in the background.
+    ///
+    /// When set, the cursor returned by this operation fetches documents on a background thread,
+    /// issuing the next getMore while the application is still consuming earlier documents, and
+    /// keeps up to this many batches of batch_size documents (101 if batch_size is not set)
+    /// waiting to be consumed. Tailable cursors cannot prefetch.
+    ///
+    /// @warning
+    ///   The background thread uses the client the operation was run on for as long as the cursor
+    ///   exists, so the application must not use that client, or any database, collection or
+    ///   other object obtained from it, until the cursor is destroyed. Acquiring a dedicated client
+    ///   from a mongocxx::pool for the scan is the usual way to satisfy this.
+    ///
+    /// @param prefetch_batches
+    ///   The number of batches to keep ready, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    find& prefetch_batches(std::int32_t prefetch_batches);
+
+    ///
+    /// Gets the current number of batches the cursor reads ahead.
+    ///
+    /// @return The current prefetch_batches setting.
+    ///
+    const stdx::optional<std::int32_t>& prefetch_batches() const;
+
+    ///
+    /// Sets the most bytes of prefetched batches waiting to be consumed.
+    ///
+    /// With prefetch_batches(), the background thread stops reading ahead once the batches it has
+    /// ready hold this many bytes, in addition to the limit on their number, and waits for the
+    /// application to consume one before it issues the next getMore. A batch is always kept ready
+    /// when none is, however large. The batches also count against the budget of the client; see
+    /// options::client::max_buffered_reply_bytes(). By default only prefetch_batches() limits the
+    /// read-ahead.
+    ///
+    /// @param max_prefetched_bytes
+    ///   The most bytes of documents to keep ready, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    find& max_prefetched_bytes(std::int64_t max_prefetched_bytes);
+
+    ///
+    /// Gets the most bytes of prefetched batches waiting to be consumed.
+    ///
+    /// @return The current max_prefetched_bytes setting.
+    ///
+    const stdx::optional<std::int64_t>& max_prefetched_bytes() const;
+
     ///
     /// Sets a projection which limits the returned fields for all matching documents.
     ///
@@ -495,12 +658,39 @@ class MONGOCXX_API find {
     const stdx::optional<bsoncxx::document::view_or_value>& sort() const;
 
    private:
+    friend class ::mongocxx::collection;
+
+    //
+    // The options document built by collection::find when cache_options_document is set. It is
+    // read and replaced atomically, since a const find may be shared by many threads at once.
+    //
+    struct cached_document {
+        cached_document() = default;
+
+        cached_document(const cached_document& other) : value{std::atomic_load(&other.value)} {}
+
+        cached_document& operator=(const cached_document& other) {
+            std::atomic_store(&value, std::atomic_load(&other.value));
+            return *this;
+        }
+
+        void reset() {
+            std::atomic_store(&value, std::shared_ptr<const bsoncxx::document::value>{});
+        }
+
+        std::shared_ptr<const bsoncxx::document::value> value;
+    };
+
     stdx::optional<bool> _allow_disk_use;
     stdx::optional<bool> _allow_partial_results;
     stdx::optional<std::int32_t> _batch_size;
+    stdx::optional<std::int32_t> _max_batch_bytes;
+    stdx::optional<bool> _adaptive_batch_size;
+    stdx::optional<bool> _cache_options_document;
     stdx::optional<bsoncxx::document::view_or_value> _collation;
     stdx::optional<bsoncxx::string::view_or_value> _comment;
     stdx::optional<cursor::type> _cursor_type;
+    stdx::optional<bool> _exhaust;
     stdx::optional<class hint> _hint;
     stdx::optional<std::int64_t> _limit;
     stdx::optional<bsoncxx::document::view_or_value> _max;
@@ -508,12 +698,15 @@ class MONGOCXX_API find {
     stdx::optional<std::chrono::milliseconds> _max_time;
     stdx::optional<bsoncxx::document::view_or_value> _min;
     stdx::optional<bool> _no_cursor_timeout;
+    stdx::optional<std::int32_t> _prefetch_batches;
+    stdx::optional<std::int64_t> _max_prefetched_bytes;
     stdx::optional<bsoncxx::document::view_or_value> _projection;
     stdx::optional<class read_preference> _read_preference;
     stdx::optional<bool> _return_key;
     stdx::optional<bool> _show_record_id;
     stdx::optional<std::int64_t> _skip;
     stdx::optional<bsoncxx::document::view_or_value> _ordering;
+    mutable cached_document _cached_document;
 };
 
 }  // namespace options
@@ -0,0 +1,45 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/options/gridfs/download.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+namespace gridfs {
+
+download& download::batch_size(std::int32_t batch_size) {
+    _batch_size = batch_size;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& download::batch_size() const {
+    return _batch_size;
+}
+
+download& download::prefetch_batches(std::int32_t prefetch_batches) {
+    _prefetch_batches = prefetch_batches;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& download::prefetch_batches() const {
+    return _prefetch_batches;
+}
+
+}  // namespace gridfs
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
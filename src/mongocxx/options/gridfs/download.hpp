@@ -0,0 +1,96 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+namespace gridfs {
+
+///
+/// Class representing the optional arguments to a MongoDB GridFS download operation.
+///
+class MONGOCXX_API download {
+   public:
+    ///
+    /// Sets the number of chunks the server returns per batch of the chunks query. Larger batches
+    /// need fewer getMore round trips to read a file. Defaults to the server's batch size.
+    ///
+    /// @param batch_size
+    ///   The number of chunks per batch.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    download& batch_size(std::int32_t batch_size);
+
+    ///
+    /// Gets the number of chunks the server returns per batch of the chunks query.
+    ///
+    /// @return
+    ///   The number of chunks per batch.
+    ///
+    const stdx::optional<std::int32_t>& batch_size() const;
+
+    ///
+    /// Sets the number of batches of chunks read ahead in the background.
+    ///
+    /// When set, the chunks are read on a background thread that keeps up to this many batches of
+    /// batch_size chunks (101 if batch_size is not set) waiting to be read, so that the next
+    /// getMore overlaps with the application consuming earlier chunks. The read-ahead window is
+    /// therefore prefetch_batches * batch_size chunks, or that many times the file's chunk size in
+    /// bytes.
+    ///
+    /// @warning
+    ///   As with options::find::prefetch_batches(), the background thread uses the client of the
+    ///   bucket, and the session of the download if any, until the downloader is closed or
+    ///   destroyed. Neither may be used by the application until then.
+    ///
+    /// @param prefetch_batches
+    ///   The number of batches to keep ready.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    download& prefetch_batches(std::int32_t prefetch_batches);
+
+    ///
+    /// Gets the number of batches of chunks read ahead in the background.
+    ///
+    /// @return
+    ///   The current prefetch_batches setting.
+    ///
+    const stdx::optional<std::int32_t>& prefetch_batches() const;
+
+   private:
+    stdx::optional<std::int32_t> _batch_size;
+    stdx::optional<std::int32_t> _prefetch_batches;
+};
+
+}  // namespace gridfs
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
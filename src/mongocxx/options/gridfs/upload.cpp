@@ -42,6 +42,61 @@ const stdx::optional<bsoncxx::document::view_or_value>& upload::metadata() const
     return _metadata;
 }
 
+upload& upload::max_batch_bytes(std::int32_t max_batch_bytes) {
+    _max_batch_bytes = max_batch_bytes;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& upload::max_batch_bytes() const {
+    return _max_batch_bytes;
+}
+
+upload& upload::parallelism(std::uint32_t connections, class pool& pool) {
+    _parallelism = connections;
+    _parallelism_pool = &pool;
+    return *this;
+}
+
+const stdx::optional<std::uint32_t>& upload::parallelism() const {
+    return _parallelism;
+}
+
+class pool* upload::parallelism_pool() const {
+    return _parallelism_pool;
+}
+
+upload& upload::checksum(checksum_algorithm algorithm) {
+    _checksum = algorithm;
+    return *this;
+}
+
+const stdx::optional<upload::checksum_algorithm>& upload::checksum() const {
+    return _checksum;
+}
+
+upload& upload::compression(compression_algorithm algorithm, std::int32_t level) {
+    _compression = algorithm;
+    _compression_level = level;
+    return *this;
+}
+
+const stdx::optional<upload::compression_algorithm>& upload::compression() const {
+    return _compression;
+}
+
+std::int32_t upload::compression_level() const {
+    return _compression_level;
+}
+
+upload& upload::deduplicate_chunks(bool deduplicate_chunks) {
+    _deduplicate_chunks = deduplicate_chunks;
+    return *this;
+}
+
+const stdx::optional<bool>& upload::deduplicate_chunks() const {
+    return _deduplicate_chunks;
+}
+
 }  // namespace gridfs
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
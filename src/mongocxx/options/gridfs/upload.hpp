@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <bsoncxx/document/view_or_value.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/stdx.hpp>
@@ -22,6 +24,9 @@
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
 namespace options {
 namespace gridfs {
 
@@ -30,6 +35,25 @@ namespace gridfs {
 ///
 class MONGOCXX_API upload {
    public:
+    ///
+    /// The checksums that can be computed over the contents of an uploaded file.
+    ///
+    enum class checksum_algorithm {
+        /// SHA-256, stored as 64 hexadecimal digits in the "sha256" field of the files document.
+        k_sha256,
+
+        /// CRC-32C, stored as 8 hexadecimal digits in the "crc32c" field of the files document.
+        k_crc32c,
+    };
+
+    ///
+    /// The codecs that can compress the chunks of an uploaded file.
+    ///
+    enum class compression_algorithm {
+        /// Zstandard. Requires a driver built with zstd; see MONGOCXX_ENABLE_ZSTD.
+        k_zstd,
+    };
+
     ///
     /// Sets the chunk size of the GridFS file being uploaded. Defaults to the chunk size specified
     /// in options::gridfs::bucket.
@@ -72,9 +96,186 @@ class MONGOCXX_API upload {
     ///
     const stdx::optional<bsoncxx::document::view_or_value>& metadata() const;
 
+    ///
+    /// Sets the most chunk bytes sent to the server in a single insert. Chunks are buffered in
+    /// memory until this many bytes have been written, and then sent together.
+    ///
+    /// Larger batches need fewer round trips, which helps on high-latency links, while smaller
+    /// batches bound the memory held by the uploader. A batch always holds at least one chunk.
+    /// Defaults to just under the maxMessageSizeBytes reported by the server.
+    ///
+    /// @param max_batch_bytes
+    ///   The size of a batch of chunks in bytes.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    upload& max_batch_bytes(std::int32_t max_batch_bytes);
+
+    ///
+    /// Gets the most chunk bytes sent to the server in a single insert.
+    ///
+    /// @return
+    ///   The size of a batch of chunks in bytes.
+    ///
+    const stdx::optional<std::int32_t>& max_batch_bytes() const;
+
+    ///
+    /// Writes the chunks of the file concurrently over several pooled connections.
+    ///
+    /// Chunks are sent to the server in batches as they are written. With this option, the
+    /// uploader hands each full batch to the executor of `pool`, which inserts it using a client
+    /// acquired from `pool`, and keeps accepting writes into the next batch meanwhile. At most
+    /// `connections` batches are in flight at once; a write that fills a batch beyond that waits
+    /// for the oldest to complete. Errors from background inserts are thrown by a later write()
+    /// or by close().
+    ///
+    /// @note
+    ///   Uploads within a session cannot be parallelized; opening an upload stream with a session
+    ///   and this option set throws a logic_error. `pool` must outlive the upload.
+    ///
+    /// @param connections
+    ///   The number of batches to insert concurrently. A value of 1 disables parallelism.
+    /// @param pool
+    ///   The pool from which the clients inserting the chunks are acquired.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    upload& parallelism(std::uint32_t connections, class pool& pool);
+
+    ///
+    /// Gets the number of chunk batches inserted concurrently.
+    ///
+    /// @return
+    ///   The current parallelism setting.
+    ///
+    const stdx::optional<std::uint32_t>& parallelism() const;
+
+    ///
+    /// Gets the pool from which the clients inserting the chunks are acquired.
+    ///
+    /// @return
+    ///   The pool set with parallelism(), or nullptr if none has been set.
+    ///
+    class pool* parallelism_pool() const;
+
+    ///
+    /// Computes a checksum of the file contents while they are uploaded, and stores it in the
+    /// files collection document when the upload is closed.
+    ///
+    /// The checksum is updated incrementally over each chunk as it is filled, so the file contents
+    /// are not read a second time. SHA-256 and CRC-32C use the SHA and CRC32 instructions of the
+    /// CPU when it has them. By default, no checksum is computed.
+    ///
+    /// @param algorithm
+    ///   The checksum to compute.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    upload& checksum(checksum_algorithm algorithm);
+
+    ///
+    /// Gets the checksum computed over the contents of the file being uploaded.
+    ///
+    /// @return
+    ///   The checksum algorithm, if one has been set.
+    ///
+    const stdx::optional<checksum_algorithm>& checksum() const;
+
+    ///
+    /// Compresses the data of each chunk of the file before it is stored.
+    ///
+    /// A chunk still covers chunk_size_bytes() bytes of the file, but its "data" field holds them
+    /// compressed. The files collection document records the codec in a "compression" subdocument
+    /// along with the level and the total compressed length, while its "length" field remains the
+    /// length of the file itself. This driver's downloaders decompress the chunks of such files
+    /// transparently, seeks and ranges included; other GridFS implementations see the compressed
+    /// bytes. Checksums are computed over the uncompressed contents. By default, chunks are not
+    /// compressed.
+    ///
+    /// @note
+    ///   Opening an upload stream with compression throws a logic_error if the driver was built
+    ///   without the codec's library or the level is outside the range of the codec.
+    ///
+    /// @param algorithm
+    ///   The codec to compress the chunks with.
+    /// @param level
+    ///   The compression level of the codec. For zstd, higher levels compress better but more
+    ///   slowly, and 3 is the library's default.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    upload& compression(compression_algorithm algorithm, std::int32_t level = 3);
+
+    ///
+    /// Gets the codec the chunks of the file are compressed with.
+    ///
+    /// @return
+    ///   The compression algorithm, if one has been set.
+    ///
+    const stdx::optional<compression_algorithm>& compression() const;
+
+    ///
+    /// Gets the compression level set with compression().
+    ///
+    /// @return
+    ///   The compression level, which is 0 if no compression has been set.
+    ///
+    std::int32_t compression_level() const;
+
+    ///
+    /// Stores each chunk of the file once per bucket, keyed by the SHA-256 digest of its bytes,
+    /// so that uploads sharing content, such as successive versions of an artifact, share the
+    /// chunks they have in common.
+    ///
+    /// Each filled chunk is hashed, and when the batch of chunks is sent, a single query finds
+    /// which of their digests the chunks collection already holds; only the others are inserted.
+    /// Such shared chunks have a files_id of the form { sha256: "<hex digest>" } and an "n" of 0.
+    /// The files collection document lists the digests of the file's chunks, in order, in a
+    /// "chunkManifest" array, which this driver's downloaders resolve transparently. Other GridFS
+    /// implementations do not understand such files.
+    ///
+    /// Shared chunks are not reference counted: deleting a file leaves its shared chunks in place
+    /// for the other files that may use them. The manifest makes the files document grow by
+    /// about 75 bytes per chunk, which limits a deduplicated file to about 200,000 chunks. With
+    /// compression(), the chunks are hashed before they are compressed, and the compressed length
+    /// counts only the chunks that the upload compressed. By default, chunks are not
+    /// deduplicated.
+    ///
+    /// @param deduplicate_chunks
+    ///   Whether to share identical chunks with the files already in the bucket.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called. This facilitates
+    ///   method chaining.
+    ///
+    upload& deduplicate_chunks(bool deduplicate_chunks);
+
+    ///
+    /// Gets whether identical chunks are shared with the files already in the bucket.
+    ///
+    /// @return
+    ///   Whether chunks are deduplicated, if set.
+    ///
+    const stdx::optional<bool>& deduplicate_chunks() const;
+
    private:
     stdx::optional<std::int32_t> _chunk_size_bytes;
     stdx::optional<bsoncxx::document::view_or_value> _metadata;
+    stdx::optional<std::int32_t> _max_batch_bytes;
+    stdx::optional<std::uint32_t> _parallelism;
+    class pool* _parallelism_pool = nullptr;
+    stdx::optional<checksum_algorithm> _checksum;
+    stdx::optional<compression_algorithm> _compression;
+    std::int32_t _compression_level = 0;
+    stdx::optional<bool> _deduplicate_chunks;
 };
 
 }  // namespace gridfs
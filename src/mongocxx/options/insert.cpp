@@ -35,6 +35,21 @@ insert& insert::ordered(bool ordered) {
     return *this;
 }
 
+insert& insert::skip_inserted_ids(bool skip_inserted_ids) {
+    _skip_inserted_ids = skip_inserted_ids;
+    return *this;
+}
+
+insert& insert::dedupe_by(std::vector<std::string> fields) {
+    _dedupe_by = std::move(fields);
+    return *this;
+}
+
+insert& insert::shard_partitioning(class pool& pool) {
+    _shard_partitioning_pool = &pool;
+    return *this;
+}
+
 const stdx::optional<bool>& insert::bypass_document_validation() const {
     return _bypass_document_validation;
 }
@@ -47,6 +62,27 @@ const stdx::optional<bool>& insert::ordered() const {
     return _ordered;
 }
 
+const stdx::optional<bool>& insert::skip_inserted_ids() const {
+    return _skip_inserted_ids;
+}
+
+const stdx::optional<std::vector<std::string>>& insert::dedupe_by() const {
+    return _dedupe_by;
+}
+
+class pool* insert::shard_partitioning_pool() const {
+    return _shard_partitioning_pool;
+}
+
+insert& insert::group_commit(bool group_commit) {
+    _group_commit = group_commit;
+    return *this;
+}
+
+const stdx::optional<bool>& insert::group_commit() const {
+    return _group_commit;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
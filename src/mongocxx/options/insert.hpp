@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/stdx.hpp>
@@ -23,6 +26,9 @@
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
 namespace options {
 
 ///
@@ -105,10 +111,123 @@ class MONGOCXX_API insert {
     ///
     const stdx::optional<bool>& ordered() const;
 
+    ///
+    /// @note: This applies only to insert_many and is ignored for insert_one.
+    ///
+    /// If true, insert_many does not record the _ids of the inserted documents, and the
+    /// result::insert_many it returns has no inserted ids. Documents without an _id are passed to
+    /// the server as-is and the driver generates their _id while encoding the command, which saves
+    /// per-document bookkeeping for bulk loads that never read the ids back. Defaults to false.
+    ///
+    /// @param skip_inserted_ids
+    ///   Whether or not to skip recording the inserted _ids.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    insert& skip_inserted_ids(bool skip_inserted_ids);
+
+    ///
+    /// The current skip_inserted_ids value for this operation.
+    ///
+    /// @return The current skip_inserted_ids value.
+    ///
+    const stdx::optional<bool>& skip_inserted_ids() const;
+
+    ///
+    /// @note: This applies only to insert_many and insert_stream and is ignored for insert_one.
+    ///
+    /// Drops documents that repeat the values of the given fields of an earlier document of the
+    /// same call, before they are sent, so that duplicates in the input do not abort an ordered
+    /// insert with a duplicate key error. Documents are duplicates if each of the fields has a
+    /// value of the same type with the same bytes, so 1 and 1.0 differ. A field may be a dotted
+    /// path through subdocuments, such as "address.zip". Documents missing one of the fields are
+    /// always inserted, which keeps documents without an _id when deduplicating by "_id".
+    ///
+    /// The values of every distinct document are kept in memory until the call returns. The
+    /// results count only the documents that were sent, but the indexes of inserted_ids() and of
+    /// write errors are still positions in the input, counting the dropped duplicates.
+    ///
+    /// @param fields
+    ///   The fields that identify a document. The insert throws mongocxx::logic_error if the list
+    ///   or one of the fields is empty.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    insert& dedupe_by(std::vector<std::string> fields);
+
+    ///
+    /// The fields by which insert_many drops duplicate documents.
+    ///
+    /// @return The fields, if set.
+    ///
+    const stdx::optional<std::vector<std::string>>& dedupe_by() const;
+
+    ///
+    /// @note: This applies only to unordered insert_many and insert_stream calls and is ignored for
+    /// insert_one.
+    ///
+    /// Groups the documents of each bulk write by the shard that owns them and sends each shard's
+    /// documents concurrently; see options::bulk_write::shard_partitioning().
+    ///
+    /// @param pool
+    ///   The pool from which the clients of the sub-batches are acquired.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    insert& shard_partitioning(class pool& pool);
+
+    ///
+    /// The pool from which the clients of a shard-partitioned insert are acquired.
+    ///
+    /// @return The pool set with shard_partitioning(), or nullptr if none has been set.
+    ///
+    class pool* shard_partitioning_pool() const;
+
+    ///
+    /// @note: This applies only to insert_one without a session and is ignored otherwise.
+    ///
+    /// If true, an acknowledged insert_one is sent together with the inserts that other threads
+    /// make at the same time through clients of the same pool, into the same collection and with
+    /// the same write concern and bypass_document_validation. The first thread of a group sends
+    /// the documents queued so far as one unordered bulk write, and the threads that arrive while
+    /// it waits for the reply form the next group. With a write concern of "majority", each group
+    /// then waits once for replication instead of once per insert, with the same durability.
+    ///
+    /// Each insert still returns its own result and throws its own write error, such as a
+    /// duplicate key, without affecting the others of its group. An error of the whole bulk
+    /// write, such as a network or write concern error, is thrown by every insert of the group.
+    /// Defaults to false.
+    ///
+    /// @param group_commit
+    ///   Whether or not to group concurrent inserts.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    insert& group_commit(bool group_commit);
+
+    ///
+    /// The current group_commit value for this operation.
+    ///
+    /// @return The current group_commit value.
+    ///
+    const stdx::optional<bool>& group_commit() const;
+
    private:
     stdx::optional<class write_concern> _write_concern;
     stdx::optional<bool> _ordered;
     stdx::optional<bool> _bypass_document_validation;
+    stdx::optional<bool> _skip_inserted_ids;
+    stdx::optional<std::vector<std::string>> _dedupe_by;
+    class pool* _shard_partitioning_pool = nullptr;
+    stdx::optional<bool> _group_commit;
 };
 
 }  // namespace options
@@ -14,6 +14,8 @@
 
 #include <mongocxx/options/pool.hpp>
 
+#include <utility>
+
 #include <mongocxx/config/private/prelude.hh>
 
 namespace mongocxx {
@@ -28,6 +30,51 @@ const client& pool::client_opts() const {
     return _client_opts;
 }
 
+pool& pool::thread_affinity(bool thread_affinity) {
+    _thread_affinity = thread_affinity;
+    return *this;
+}
+
+const stdx::optional<bool>& pool::thread_affinity() const {
+    return _thread_affinity;
+}
+
+pool& pool::numa_partitions(bool numa_partitions) {
+    _numa_partitions = numa_partitions;
+    return *this;
+}
+
+const stdx::optional<bool>& pool::numa_partitions() const {
+    return _numa_partitions;
+}
+
+pool& pool::checkout_observer(checkout_observer_type observer) {
+    _checkout_observer = std::move(observer);
+    return *this;
+}
+
+const pool::checkout_observer_type& pool::checkout_observer() const {
+    return _checkout_observer;
+}
+
+pool& pool::warmup(std::int32_t min_connections) {
+    _warmup = min_connections;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& pool::warmup() const {
+    return _warmup;
+}
+
+pool& pool::executor(std::shared_ptr<class executor> executor) {
+    _executor = std::move(executor);
+    return *this;
+}
+
+const std::shared_ptr<executor>& pool::executor() const {
+    return _executor;
+}
+
 }  // namespace options
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
@@ -14,12 +14,22 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/options/client.hpp>
+#include <mongocxx/stdx.hpp>
 
 #include <mongocxx/config/prelude.hpp>
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class executor;
+
 namespace options {
 
 ///
@@ -44,8 +54,153 @@ class MONGOCXX_API pool {
     ///
     const client& client_opts() const;
 
+    ///
+    /// Sets whether clients released by a thread stay with that thread.
+    ///
+    /// With thread affinity, a client released back to the pool is parked in a slot of the
+    /// releasing thread instead of the pool's shared queue, and the next acquire on that thread
+    /// takes it back without touching the shared queue's lock. Parked clients are still handed to
+    /// other threads when the shared queue runs dry, and are returned to the shared queue when
+    /// their thread exits.
+    ///
+    /// @param thread_affinity
+    ///   Whether to enable thread affinity.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    pool& thread_affinity(bool thread_affinity);
+
+    ///
+    /// Gets the current thread affinity setting.
+    ///
+    /// @return Whether thread affinity is enabled.
+    ///
+    const stdx::optional<bool>& thread_affinity() const;
+
+    ///
+    /// Sets whether the pool keeps a partition of idle clients per NUMA node.
+    ///
+    /// On hosts with several NUMA nodes, a client released back to the pool is kept in the
+    /// partition of the releasing thread's node, and an acquire takes a client from the partition
+    /// of its thread's node first. It then tries the shared queue, which creates a new client on
+    /// the acquiring thread if the pool has room, and only takes a client from another node's
+    /// partition when both are empty. New clients allocate their connections and buffers on the
+    /// thread that first uses them, so under the usual first-touch memory policy they stay on the
+    /// node whose threads use them.
+    ///
+    /// On hosts with a single node, or where the platform does not report the node of a thread,
+    /// the option has no effect. It cannot be combined with thread_affinity().
+    ///
+    /// @param numa_partitions
+    ///   Whether to partition the idle clients by NUMA node.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    pool& numa_partitions(bool numa_partitions);
+
+    ///
+    /// Gets the current NUMA partitioning setting.
+    ///
+    /// @return Whether the idle clients are partitioned by NUMA node.
+    ///
+    const stdx::optional<bool>& numa_partitions() const;
+
+    ///
+    /// The type of a function called each time a client acquired from the pool is released.
+    ///
+    /// It receives the time spent waiting to acquire the client and the time the client was held.
+    ///
+    using checkout_observer_type =
+        std::function<void(std::chrono::nanoseconds wait_time, std::chrono::nanoseconds hold_time)>;
+
+    ///
+    /// Sets a function to call each time a client acquired from the pool is released, for
+    /// instance to feed the wait and hold times into the application's own metrics.
+    ///
+    /// The function is called on the releasing thread, outside of any lock of the pool. It must
+    /// not throw, and must not acquire a client from the same pool.
+    ///
+    /// @param observer
+    ///   The function to call.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @see mongocxx::pool::stats
+    ///
+    pool& checkout_observer(checkout_observer_type observer);
+
+    ///
+    /// Gets the current checkout observer.
+    ///
+    /// @return The function called when a client is released, if any.
+    ///
+    const checkout_observer_type& checkout_observer() const;
+
+    ///
+    /// Sets the number of connections to establish while the pool is constructed.
+    ///
+    /// By default a pool connects lazily, so the first operations on each new client pay for the
+    /// connection handshake and authentication. With warmup, the pool constructor checks out up
+    /// to this many clients, connects and authenticates them in parallel by running a ping
+    /// command on each, and returns them to the pool before returning. Typically this is set to
+    /// the minPoolSize of the URI.
+    ///
+    /// Warmup is best effort: connections that cannot be established are left to be retried on
+    /// first use, and no more than maxPoolSize clients are created.
+    ///
+    /// @param min_connections
+    ///   The number of connections to establish.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    pool& warmup(std::int32_t min_connections);
+
+    ///
+    /// Gets the current number of connections to establish during construction.
+    ///
+    /// @return The number of connections to establish.
+    ///
+    const stdx::optional<std::int32_t>& warmup() const;
+
+    ///
+    /// Sets the executor that runs the background work of features using the pool, such as
+    /// mongocxx::async_collection, mongocxx::batch and the parallel GridFS transfers, instead of
+    /// the executor of the mongocxx::instance. This keeps the work of one pool from queueing behind
+    /// that of others.
+    ///
+    /// @param executor
+    ///   The executor to use.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @see mongocxx::instance::executor
+    ///
+    pool& executor(std::shared_ptr<class executor> executor);
+
+    ///
+    /// Gets the current executor.
+    ///
+    /// @return The executor of the pool, or null to use the executor of the instance.
+    ///
+    const std::shared_ptr<class executor>& executor() const;
+
    private:
     client _client_opts;
+    stdx::optional<bool> _thread_affinity;
+    stdx::optional<bool> _numa_partitions;
+    checkout_observer_type _checkout_observer;
+    stdx::optional<std::int32_t> _warmup;
+    std::shared_ptr<class executor> _executor;
 };
 
 }  // namespace options
@@ -15,7 +15,12 @@
 #pragma once
 
 #include <mongocxx/options/apm.hpp>
+#include <mongocxx/options/private/apm_context.hh>
+#include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/operation_accounting.hh>
+#include <mongocxx/private/operation_timer.hh>
+#include <mongocxx/private/tracer.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -26,90 +31,338 @@ namespace options {
 using apm_unique_callbacks =
     std::unique_ptr<mongoc_apm_callbacks_t, decltype(libmongoc::apm_callbacks_destroy)>;
 
+// Sampling by request id, rather than by counting, needs no shared state and picks the same
+// commands for their started and completed events.
+static bool command_sampled(const apm_context* context, std::int64_t request_id) {
+    auto rate = context->listeners.command_sample_rate();
+    return rate == 1 || request_id % static_cast<std::int64_t>(rate) == 0;
+}
+
+static void deliver_timing(apm_context* context,
+                           apm::command_timing_fn callback,
+                           const mongocxx::events::command_timing& timing) {
+    if (context->delivery) {
+        context->delivery->push(timing);
+    } else {
+        callback(timing, context->listeners.command_timing_context());
+    }
+}
+
 static void command_started(const mongoc_apm_command_started_t* event) {
-    mongocxx::events::command_started_event started_event(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_command_started_get_context(event));
-    context->command_started()(started_event);
+    auto context = static_cast<apm_context*>(libmongoc::apm_command_started_get_context(event));
+    if (context->listeners.record_operation_stats()) {
+        operation_accounting::command_started(
+            libmongoc::apm_command_started_get_command(event)->len);
+    }
+
+    if (context->timings) {
+        operation_timer::command_started();
+    }
+
+    if (context->listeners.record_command_bytes()) {
+        context->commands.fetch_add(1, std::memory_order_relaxed);
+        context->command_bytes.fetch_add(libmongoc::apm_command_started_get_command(event)->len,
+                                         std::memory_order_relaxed);
+    }
+
+    if (context->namespaces) {
+        auto command = libmongoc::apm_command_started_get_command(event);
+        context->namespaces->started(
+            libmongoc::apm_command_started_get_request_id(event),
+            libmongoc::apm_command_started_get_database_name(event),
+            libmongoc::apm_command_started_get_command_name(event),
+            bsoncxx::document::view{bson_get_data(command), command->len});
+    }
+
+    if (context->slow_commands) {
+        auto command = libmongoc::apm_command_started_get_command(event);
+        context->slow_commands->started(
+            libmongoc::apm_command_started_get_request_id(event),
+            libmongoc::apm_command_started_get_database_name(event),
+            libmongoc::apm_command_started_get_command_name(event),
+            bsoncxx::document::view{bson_get_data(command), command->len});
+    }
+
+    if (context->query_shapes) {
+        auto command = libmongoc::apm_command_started_get_command(event);
+        context->query_shapes->started(
+            libmongoc::apm_command_started_get_database_name(event),
+            libmongoc::apm_command_started_get_command_name(event),
+            bsoncxx::document::view{bson_get_data(command), command->len});
+    }
+
+    if (!command_sampled(context, libmongoc::apm_command_started_get_request_id(event))) {
+        return;
+    }
+
+    if (auto& span_tracer = context->listeners.tracer()) {
+        auto command = libmongoc::apm_command_started_get_command(event);
+        auto host = libmongoc::apm_command_started_get_host(event);
+        mongocxx::events::span_attributes attributes{};
+        attributes.database = libmongoc::apm_command_started_get_database_name(event);
+        attributes.command_name = libmongoc::apm_command_started_get_command_name(event);
+        attributes.request_id = libmongoc::apm_command_started_get_request_id(event);
+        attributes.operation_id = libmongoc::apm_command_started_get_operation_id(event);
+        attributes.bytes = command->len;
+        attributes.host = host->host;
+        attributes.port = host->port;
+        tracing::read_command_attributes(
+            bsoncxx::document::view{bson_get_data(command), command->len}, &attributes);
+
+        auto span = span_tracer->start_span(attributes, mongocxx::tracer::current_parent());
+        tracing::push_span(attributes.request_id, span);
+    }
+
+    if (context->listeners.command_started()) {
+        mongocxx::events::command_started_event started_event(static_cast<const void*>(event));
+        context->listeners.command_started()(started_event);
+    }
+}
+
+static void end_span(const apm_context* context,
+                     std::int64_t request_id,
+                     std::int64_t duration,
+                     bool succeeded,
+                     const bson_t* reply) {
+    auto span = tracing::pop_span(request_id);
+    if (span) {
+        context->listeners.tracer()->end_span(
+            span, std::chrono::microseconds{duration}, succeeded, reply ? reply->len : 0);
+    }
 }
 
 static void command_failed(const mongoc_apm_command_failed_t* event) {
-    mongocxx::events::command_failed_event failed_event(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_command_failed_get_context(event));
-    context->command_failed()(failed_event);
+    auto context = static_cast<apm_context*>(libmongoc::apm_command_failed_get_context(event));
+    auto request_id = libmongoc::apm_command_failed_get_request_id(event);
+    if (context->listeners.record_operation_stats()) {
+        auto reply = libmongoc::apm_command_failed_get_reply(event);
+        auto duration = libmongoc::apm_command_failed_get_duration(event);
+        operation_accounting::command_completed(reply ? reply->len : 0, duration);
+    }
+
+    if (context->timings) {
+        operation_timer::command_completed();
+    }
+
+    if (context->listeners.record_command_bytes()) {
+        auto reply = libmongoc::apm_command_failed_get_reply(event);
+        context->reply_bytes.fetch_add(reply ? reply->len : 0, std::memory_order_relaxed);
+    }
+
+    if (context->namespaces) {
+        auto reply = libmongoc::apm_command_failed_get_reply(event);
+        context->namespaces->completed(
+            request_id,
+            libmongoc::apm_command_failed_get_command_name(event),
+            reply ? bsoncxx::document::view{bson_get_data(reply), reply->len}
+                  : bsoncxx::document::view{},
+            false);
+    }
+
+    if (context->slow_commands) {
+        auto host = libmongoc::apm_command_failed_get_host(event);
+        context->slow_commands->completed(request_id,
+                                          libmongoc::apm_command_failed_get_duration(event),
+                                          host->host,
+                                          host->port,
+                                          false);
+    }
+
+    if (!command_sampled(context, request_id)) {
+        return;
+    }
+
+    if (context->listeners.tracer()) {
+        end_span(context,
+                 request_id,
+                 libmongoc::apm_command_failed_get_duration(event),
+                 false,
+                 libmongoc::apm_command_failed_get_reply(event));
+    }
+
+    if (auto timing_callback = context->listeners.command_timing()) {
+        auto host = libmongoc::apm_command_failed_get_host(event);
+        mongocxx::events::command_timing timing{
+            request_id,
+            libmongoc::apm_command_failed_get_command_name(event),
+            libmongoc::apm_command_failed_get_duration(event),
+            host->host,
+            host->port,
+            false};
+        deliver_timing(context, timing_callback, timing);
+    }
+
+    if (context->listeners.command_failed()) {
+        mongocxx::events::command_failed_event failed_event(static_cast<const void*>(event));
+        context->listeners.command_failed()(failed_event);
+    }
 }
 
 static void command_succeeded(const mongoc_apm_command_succeeded_t* event) {
-    mongocxx::events::command_succeeded_event succeeded_event(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_command_succeeded_get_context(event));
-    context->command_succeeded()(succeeded_event);
+    auto context = static_cast<apm_context*>(libmongoc::apm_command_succeeded_get_context(event));
+    auto request_id = libmongoc::apm_command_succeeded_get_request_id(event);
+    if (context->listeners.record_operation_stats()) {
+        auto reply = libmongoc::apm_command_succeeded_get_reply(event);
+        auto duration = libmongoc::apm_command_succeeded_get_duration(event);
+        operation_accounting::command_completed(reply ? reply->len : 0, duration);
+    }
+
+    if (context->timings) {
+        operation_timer::command_completed();
+    }
+
+    if (context->listeners.record_command_bytes()) {
+        auto reply = libmongoc::apm_command_succeeded_get_reply(event);
+        context->reply_bytes.fetch_add(reply ? reply->len : 0, std::memory_order_relaxed);
+    }
+
+    if (context->namespaces) {
+        auto reply = libmongoc::apm_command_succeeded_get_reply(event);
+        context->namespaces->completed(
+            request_id,
+            libmongoc::apm_command_succeeded_get_command_name(event),
+            reply ? bsoncxx::document::view{bson_get_data(reply), reply->len}
+                  : bsoncxx::document::view{},
+            true);
+    }
+
+    if (context->slow_commands) {
+        auto host = libmongoc::apm_command_succeeded_get_host(event);
+        context->slow_commands->completed(request_id,
+                                          libmongoc::apm_command_succeeded_get_duration(event),
+                                          host->host,
+                                          host->port,
+                                          true);
+    }
+
+    if (!command_sampled(context, request_id)) {
+        return;
+    }
+
+    if (context->listeners.tracer()) {
+        end_span(context,
+                 request_id,
+                 libmongoc::apm_command_succeeded_get_duration(event),
+                 true,
+                 libmongoc::apm_command_succeeded_get_reply(event));
+    }
+
+    if (context->latencies) {
+        auto host = libmongoc::apm_command_succeeded_get_host(event);
+        context->latencies->record(libmongoc::apm_command_succeeded_get_command_name(event),
+                                   host->host,
+                                   host->port,
+                                   libmongoc::apm_command_succeeded_get_duration(event));
+    }
+
+    if (auto timing_callback = context->listeners.command_timing()) {
+        auto host = libmongoc::apm_command_succeeded_get_host(event);
+        mongocxx::events::command_timing timing{
+            request_id,
+            libmongoc::apm_command_succeeded_get_command_name(event),
+            libmongoc::apm_command_succeeded_get_duration(event),
+            host->host,
+            host->port,
+            true};
+        deliver_timing(context, timing_callback, timing);
+    }
+
+    if (context->listeners.command_succeeded()) {
+        mongocxx::events::command_succeeded_event succeeded_event(static_cast<const void*>(event));
+        context->listeners.command_succeeded()(succeeded_event);
+    }
 }
 
 static void server_closed(const mongoc_apm_server_closed_t* event) {
     mongocxx::events::server_closed_event e(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_server_closed_get_context(event));
-    context->server_closed()(e);
+    auto context = static_cast<apm_context*>(libmongoc::apm_server_closed_get_context(event));
+    context->listeners.server_closed()(e);
 }
 
 static void server_changed(const mongoc_apm_server_changed_t* event) {
     mongocxx::events::server_changed_event e(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_server_changed_get_context(event));
-    context->server_changed()(e);
+    auto context = static_cast<apm_context*>(libmongoc::apm_server_changed_get_context(event));
+    if (context->listeners.server_changed()) {
+        context->listeners.server_changed()(e);
+    }
+
+    // libmongoc closes the connections to a server when it marks it Unknown, which is what
+    // clearing its pool means for a driver with CMAP connection pools.
+    if (context->listeners.pool_cleared() &&
+        e.new_description().type() == stdx::string_view{"Unknown"} &&
+        e.previous_description().type() != stdx::string_view{"Unknown"}) {
+        mongocxx::events::pool_cleared_event cleared(static_cast<const void*>(event));
+        context->listeners.pool_cleared()(cleared);
+    }
 }
 
 static void server_opening(const mongoc_apm_server_opening_t* event) {
     mongocxx::events::server_opening_event e(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_server_opening_get_context(event));
-    context->server_opening()(e);
+    auto context = static_cast<apm_context*>(libmongoc::apm_server_opening_get_context(event));
+    context->listeners.server_opening()(e);
 }
 
 static void topology_closed(const mongoc_apm_topology_closed_t* event) {
     mongocxx::events::topology_closed_event e(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_topology_closed_get_context(event));
-    context->topology_closed()(e);
+    auto context = static_cast<apm_context*>(libmongoc::apm_topology_closed_get_context(event));
+    context->listeners.topology_closed()(e);
 }
 
 static void topology_changed(const mongoc_apm_topology_changed_t* event) {
     mongocxx::events::topology_changed_event e(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_topology_changed_get_context(event));
-    context->topology_changed()(e);
+    auto context = static_cast<apm_context*>(libmongoc::apm_topology_changed_get_context(event));
+    context->listeners.topology_changed()(e);
 }
 
 static void topology_opening(const mongoc_apm_topology_opening_t* event) {
     mongocxx::events::topology_opening_event e(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_topology_opening_get_context(event));
-    context->topology_opening()(e);
+    auto context = static_cast<apm_context*>(libmongoc::apm_topology_opening_get_context(event));
+    context->listeners.topology_opening()(e);
 }
 
 static void heartbeat_started(const mongoc_apm_server_heartbeat_started_t* event) {
     mongocxx::events::heartbeat_started_event started_event(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_server_heartbeat_started_get_context(event));
-    context->heartbeat_started()(started_event);
+    auto context =
+        static_cast<apm_context*>(libmongoc::apm_server_heartbeat_started_get_context(event));
+    context->listeners.heartbeat_started()(started_event);
 }
 
 static void heartbeat_failed(const mongoc_apm_server_heartbeat_failed_t* event) {
     mongocxx::events::heartbeat_failed_event failed_event(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_server_heartbeat_failed_get_context(event));
-    context->heartbeat_failed()(failed_event);
+    auto context =
+        static_cast<apm_context*>(libmongoc::apm_server_heartbeat_failed_get_context(event));
+    context->listeners.heartbeat_failed()(failed_event);
 }
 
 static void heartbeat_succeeded(const mongoc_apm_server_heartbeat_succeeded_t* event) {
     mongocxx::events::heartbeat_succeeded_event succeeded_event(static_cast<const void*>(event));
-    auto context = static_cast<apm*>(libmongoc::apm_server_heartbeat_succeeded_get_context(event));
-    context->heartbeat_succeeded()(succeeded_event);
+    auto context =
+        static_cast<apm_context*>(libmongoc::apm_server_heartbeat_succeeded_get_context(event));
+    context->listeners.heartbeat_succeeded()(succeeded_event);
 }
 
 static apm_unique_callbacks make_apm_callbacks(const apm& apm_opts) {
     mongoc_apm_callbacks_t* callbacks = libmongoc::apm_callbacks_new();
 
-    if (apm_opts.command_started()) {
+    if (apm_opts.command_started() || apm_opts.tracer() || apm_opts.record_operation_stats() ||
+        apm_opts.record_command_bytes() || apm_opts.slow_command_threshold() ||
+        apm_opts.record_namespace_stats() || apm_opts.query_shape_capacity() ||
+        apm_opts.record_operation_timings()) {
         libmongoc::apm_set_command_started_cb(callbacks, command_started);
     }
 
-    if (apm_opts.command_failed()) {
+    if (apm_opts.command_failed() || apm_opts.command_timing() || apm_opts.tracer() ||
+        apm_opts.record_operation_stats() || apm_opts.record_command_bytes() ||
+        apm_opts.slow_command_threshold() || apm_opts.record_namespace_stats() ||
+        apm_opts.record_operation_timings()) {
         libmongoc::apm_set_command_failed_cb(callbacks, command_failed);
     }
 
-    if (apm_opts.command_succeeded()) {
+    if (apm_opts.command_succeeded() || apm_opts.command_timing() ||
+        apm_opts.record_command_latencies() || apm_opts.tracer() ||
+        apm_opts.record_operation_stats() || apm_opts.record_command_bytes() ||
+        apm_opts.slow_command_threshold() || apm_opts.record_namespace_stats() ||
+        apm_opts.record_operation_timings()) {
         libmongoc::apm_set_command_succeeded_cb(callbacks, command_succeeded);
     }
 
@@ -117,7 +370,7 @@ static apm_unique_callbacks make_apm_callbacks(const apm& apm_opts) {
         libmongoc::apm_set_server_closed_cb(callbacks, server_closed);
     }
 
-    if (apm_opts.server_changed()) {
+    if (apm_opts.server_changed() || apm_opts.pool_cleared()) {
         libmongoc::apm_set_server_changed_cb(callbacks, server_changed);
     }
 
@@ -0,0 +1,97 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/options/apm.hpp>
+#include <mongocxx/private/apm_delivery_queue.hh>
+#include <mongocxx/private/command_latency_recorder.hh>
+#include <mongocxx/private/namespace_stats_recorder.hh>
+#include <mongocxx/private/operation_timer.hh>
+#include <mongocxx/private/query_shape_recorder.hh>
+#include <mongocxx/private/slow_command_log.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+// The context libmongoc passes back to the APM callbacks of a client or a pool.
+struct apm_context {
+    // Takes the user's options and creates what they ask for.
+    void init(const apm& options) {
+        listeners = options;
+        if (listeners.record_command_latencies()) {
+            latencies = stdx::make_unique<command_latency_recorder>();
+        }
+        if (listeners.record_namespace_stats()) {
+            namespaces = stdx::make_unique<namespace_stats_recorder>();
+        }
+        if (listeners.slow_command_threshold()) {
+            slow_commands = stdx::make_unique<slow_command_log>(*listeners.slow_command_threshold(),
+                                                                listeners.slow_command_capacity());
+        }
+        if (listeners.record_operation_timings()) {
+            timings = stdx::make_unique<operation_timer::registration>();
+        }
+        if (listeners.query_shape_capacity()) {
+            query_shapes =
+                stdx::make_unique<query_shape_recorder>(*listeners.query_shape_capacity());
+        }
+        if (listeners.async_delivery() && listeners.command_timing()) {
+            delivery = stdx::make_unique<apm_delivery_queue>(*listeners.async_delivery(),
+                                                             listeners.command_timing(),
+                                                             listeners.command_timing_context());
+        }
+    }
+
+    // The callbacks set by the user.
+    apm listeners;
+
+    // The built-in latency histograms, if options::apm::record_command_latencies() is set.
+    std::unique_ptr<command_latency_recorder> latencies;
+
+    // The counts of options::apm::record_command_bytes(): bytes are those of the BSON documents,
+    // before any wire compression.
+    std::atomic<std::uint64_t> commands{0};
+    std::atomic<std::uint64_t> command_bytes{0};
+    std::atomic<std::uint64_t> reply_bytes{0};
+
+    // The per-namespace counts, if options::apm::record_namespace_stats() is set.
+    std::unique_ptr<namespace_stats_recorder> namespaces;
+
+    // The slow commands, if options::apm::record_slow_commands() is set.
+    std::unique_ptr<slow_command_log> slow_commands;
+
+    // The filter shapes, if options::apm::record_query_shapes() is set.
+    std::unique_ptr<query_shape_recorder> query_shapes;
+
+    // Enables last_operation_timings(), if options::apm::record_operation_timings() is set.
+    std::unique_ptr<operation_timer::registration> timings;
+
+    // The queue of command timings, if options::apm::async_delivery() is set.
+    std::unique_ptr<apm_delivery_queue> delivery;
+};
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include <mongocxx/private/read_concern.hh>
@@ -40,12 +41,18 @@ class transaction::impl {
     impl(const impl& other)
         : _transaction_opt_t(unique_transaction_opt{
               libmongoc::transaction_opts_clone(other._transaction_opt_t.get()),
-              &mongoc_transaction_opts_destroy}) {}
+              &mongoc_transaction_opts_destroy}),
+          _retry_backoff_initial(other._retry_backoff_initial),
+          _retry_backoff_max(other._retry_backoff_max),
+          _max_retries(other._max_retries) {}
 
     impl& operator=(const impl& other) {
         _transaction_opt_t = unique_transaction_opt{
             libmongoc::transaction_opts_clone(other._transaction_opt_t.get()),
             &mongoc_transaction_opts_destroy};
+        _retry_backoff_initial = other._retry_backoff_initial;
+        _retry_backoff_max = other._retry_backoff_max;
+        _max_retries = other._max_retries;
         return *this;
     }
 
@@ -109,6 +116,29 @@ class transaction::impl {
         return {std::chrono::milliseconds{ms}};
     }
 
+    // The retry settings are applied by client_session::with_transaction, since libmongoc's
+    // transaction options have no equivalent.
+    void retry_backoff(std::chrono::milliseconds initial, std::chrono::milliseconds max) {
+        _retry_backoff_initial = initial;
+        _retry_backoff_max = max;
+    }
+
+    const stdx::optional<std::chrono::milliseconds>& retry_backoff_initial() const {
+        return _retry_backoff_initial;
+    }
+
+    const stdx::optional<std::chrono::milliseconds>& retry_backoff_max() const {
+        return _retry_backoff_max;
+    }
+
+    void max_retries(std::uint32_t retries) {
+        _max_retries = retries;
+    }
+
+    const stdx::optional<std::uint32_t>& max_retries() const {
+        return _max_retries;
+    }
+
     mongoc_transaction_opt_t* get_transaction_opt_t() const noexcept {
         return _transaction_opt_t.get();
     }
@@ -118,6 +148,9 @@ class transaction::impl {
         std::unique_ptr<mongoc_transaction_opt_t, decltype(&mongoc_transaction_opts_destroy)>;
 
     unique_transaction_opt _transaction_opt_t;
+    stdx::optional<std::chrono::milliseconds> _retry_backoff_initial;
+    stdx::optional<std::chrono::milliseconds> _retry_backoff_max;
+    stdx::optional<std::uint32_t> _max_retries;
 };
 
 }  // namespace options
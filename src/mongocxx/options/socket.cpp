@@ -0,0 +1,82 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/options/socket.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+socket& socket::receive_buffer_size(std::int32_t bytes) {
+    _receive_buffer_size = bytes;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& socket::receive_buffer_size() const {
+    return _receive_buffer_size;
+}
+
+socket& socket::send_buffer_size(std::int32_t bytes) {
+    _send_buffer_size = bytes;
+    return *this;
+}
+
+const stdx::optional<std::int32_t>& socket::send_buffer_size() const {
+    return _send_buffer_size;
+}
+
+socket& socket::no_delay(bool no_delay) {
+    _no_delay = no_delay;
+    return *this;
+}
+
+const stdx::optional<bool>& socket::no_delay() const {
+    return _no_delay;
+}
+
+socket& socket::keepalive(std::chrono::seconds idle,
+                          std::chrono::seconds interval,
+                          std::int32_t count) {
+    _keepalive_idle = idle;
+    _keepalive_interval = interval;
+    _keepalive_count = count;
+    return *this;
+}
+
+const stdx::optional<std::chrono::seconds>& socket::keepalive_idle() const {
+    return _keepalive_idle;
+}
+
+const stdx::optional<std::chrono::seconds>& socket::keepalive_interval() const {
+    return _keepalive_interval;
+}
+
+const stdx::optional<std::int32_t>& socket::keepalive_count() const {
+    return _keepalive_count;
+}
+
+socket& socket::busy_poll(std::chrono::microseconds busy_poll) {
+    _busy_poll = busy_poll;
+    return *this;
+}
+
+const stdx::optional<std::chrono::microseconds>& socket::busy_poll() const {
+    return _busy_poll;
+}
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
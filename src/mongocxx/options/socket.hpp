@@ -0,0 +1,176 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+///
+/// Class representing the socket options applied to every connection a client or pool opens to
+/// a server, including connections opened by a custom stream initiator when the stream it
+/// returns is backed by a socket.
+///
+/// The options are set once the connection is established. Options which are not set keep the
+/// values chosen by libmongoc and the operating system: libmongoc already enables TCP_NODELAY
+/// and TCP keepalive on every connection. A connection fails if an option cannot be set, for
+/// instance because the platform does not support it or the process lacks the privilege.
+///
+class MONGOCXX_API socket {
+   public:
+    ///
+    /// Sets the size of the kernel receive buffer of each connection (SO_RCVBUF).
+    ///
+    /// Since the buffer is resized after the connection is established, the window scaling
+    /// negotiated when connecting may limit how much of a larger buffer is used.
+    ///
+    /// @param bytes
+    ///   The size of the buffer in bytes.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    socket& receive_buffer_size(std::int32_t bytes);
+
+    ///
+    /// The current size of the kernel receive buffer.
+    ///
+    /// @return The size of the buffer in bytes.
+    ///
+    const stdx::optional<std::int32_t>& receive_buffer_size() const;
+
+    ///
+    /// Sets the size of the kernel send buffer of each connection (SO_SNDBUF).
+    ///
+    /// @param bytes
+    ///   The size of the buffer in bytes.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    socket& send_buffer_size(std::int32_t bytes);
+
+    ///
+    /// The current size of the kernel send buffer.
+    ///
+    /// @return The size of the buffer in bytes.
+    ///
+    const stdx::optional<std::int32_t>& send_buffer_size() const;
+
+    ///
+    /// Sets whether Nagle's algorithm is disabled on each connection (TCP_NODELAY). libmongoc
+    /// disables it already; setting this to true confirms it on the socket itself.
+    ///
+    /// @param no_delay
+    ///   Whether small writes are sent without delay.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    socket& no_delay(bool no_delay);
+
+    ///
+    /// Whether Nagle's algorithm is disabled.
+    ///
+    /// @return Whether small writes are sent without delay.
+    ///
+    const stdx::optional<bool>& no_delay() const;
+
+    ///
+    /// Sets the TCP keepalive of each connection: how long a connection stays idle before the
+    /// first probe (TCP_KEEPIDLE), the time between probes (TCP_KEEPINTVL), and how many
+    /// unanswered probes close the connection (TCP_KEEPCNT).
+    ///
+    /// @param idle
+    ///   The idle time before the first probe.
+    /// @param interval
+    ///   The time between probes.
+    /// @param count
+    ///   The number of probes.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    socket& keepalive(std::chrono::seconds idle, std::chrono::seconds interval, std::int32_t count);
+
+    ///
+    /// The current idle time before the first keepalive probe.
+    ///
+    /// @return The idle time.
+    ///
+    const stdx::optional<std::chrono::seconds>& keepalive_idle() const;
+
+    ///
+    /// The current time between keepalive probes.
+    ///
+    /// @return The time between probes.
+    ///
+    const stdx::optional<std::chrono::seconds>& keepalive_interval() const;
+
+    ///
+    /// The current number of unanswered keepalive probes which close a connection.
+    ///
+    /// @return The number of probes.
+    ///
+    const stdx::optional<std::int32_t>& keepalive_count() const;
+
+    ///
+    /// Sets how long a read busy-polls the device queue for new packets before sleeping
+    /// (SO_BUSY_POLL), trading CPU time for lower latency. Only Linux supports it, and values
+    /// above the net.core.busy_read sysctl require CAP_NET_ADMIN.
+    ///
+    /// @param busy_poll
+    ///   The time to busy-poll.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    socket& busy_poll(std::chrono::microseconds busy_poll);
+
+    ///
+    /// The current busy-poll time.
+    ///
+    /// @return The time to busy-poll.
+    ///
+    const stdx::optional<std::chrono::microseconds>& busy_poll() const;
+
+   private:
+    stdx::optional<std::int32_t> _receive_buffer_size;
+    stdx::optional<std::int32_t> _send_buffer_size;
+    stdx::optional<bool> _no_delay;
+    stdx::optional<std::chrono::seconds> _keepalive_idle;
+    stdx::optional<std::chrono::seconds> _keepalive_interval;
+    stdx::optional<std::int32_t> _keepalive_count;
+    stdx::optional<std::chrono::microseconds> _busy_poll;
+};
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,78 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/options/tailer.hpp>
+
+#include <utility>
+
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+tailer& tailer::max_await_time(std::chrono::milliseconds max_await_time) {
+    if (max_await_time <= std::chrono::milliseconds::zero()) {
+        throw logic_error{error_code::k_invalid_parameter, "max_await_time must be positive"};
+    }
+    _max_await_time = max_await_time;
+    return *this;
+}
+
+tailer& tailer::batch_size(std::int32_t batch_size) {
+    if (batch_size <= 0) {
+        throw logic_error{error_code::k_invalid_parameter, "batch_size must be positive"};
+    }
+    _batch_size = batch_size;
+    return *this;
+}
+
+tailer& tailer::resume_field(std::string resume_field) {
+    if (resume_field.empty()) {
+        throw logic_error{error_code::k_invalid_parameter, "resume_field must not be empty"};
+    }
+    _resume_field = std::move(resume_field);
+    return *this;
+}
+
+tailer& tailer::reopen_interval(std::chrono::milliseconds reopen_interval) {
+    if (reopen_interval < std::chrono::milliseconds::zero()) {
+        throw logic_error{error_code::k_invalid_parameter, "reopen_interval must not be negative"};
+    }
+    _reopen_interval = reopen_interval;
+    return *this;
+}
+
+const stdx::optional<std::chrono::milliseconds>& tailer::max_await_time() const {
+    return _max_await_time;
+}
+
+const stdx::optional<std::int32_t>& tailer::batch_size() const {
+    return _batch_size;
+}
+
+const stdx::optional<std::string>& tailer::resume_field() const {
+    return _resume_field;
+}
+
+const stdx::optional<std::chrono::milliseconds>& tailer::reopen_interval() const {
+    return _reopen_interval;
+}
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
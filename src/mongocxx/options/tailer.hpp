@@ -0,0 +1,139 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace options {
+
+///
+/// Class representing the optional arguments to a mongocxx::tailer.
+///
+class MONGOCXX_API tailer {
+   public:
+    ///
+    /// Sets how long each getMore waits on the server for new documents before returning an
+    /// empty batch. Defaults to one second.
+    ///
+    /// Documents are delivered as soon as they are inserted whatever this is set to; it only
+    /// bounds how long stopping the tailer may take.
+    ///
+    /// @param max_await_time
+    ///   The maxAwaitTimeMS of the getMores, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `max_await_time` is not positive.
+    ///
+    tailer& max_await_time(std::chrono::milliseconds max_await_time);
+
+    ///
+    /// Gets the current wait of each getMore.
+    ///
+    /// @return The maxAwaitTimeMS of the getMores.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& max_await_time() const;
+
+    ///
+    /// Sets the number of documents to return per batch.
+    ///
+    /// @param batch_size
+    ///   The batch size, which must be positive.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `batch_size` is not positive.
+    ///
+    tailer& batch_size(std::int32_t batch_size);
+
+    ///
+    /// Gets the current batch size.
+    ///
+    /// @return The number of documents to return per batch.
+    ///
+    const stdx::optional<std::int32_t>& batch_size() const;
+
+    ///
+    /// Sets a top-level field whose values increase in insertion order, such as "ts" in an oplog
+    /// or an ObjectId _id. When the server closes the cursor, it is reopened on the documents
+    /// whose value of this field is greater than that of the last document delivered, so that no
+    /// document is delivered twice. Without one, a reopened cursor starts from the beginning of
+    /// the collection again.
+    ///
+    /// @param resume_field
+    ///   The name of the field, which must not be empty.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `resume_field` is empty.
+    ///
+    tailer& resume_field(std::string resume_field);
+
+    ///
+    /// Gets the current resume field.
+    ///
+    /// @return The field whose last value a reopened cursor resumes after.
+    ///
+    const stdx::optional<std::string>& resume_field() const;
+
+    ///
+    /// Sets how long to wait before reopening a cursor that the server closed, e.g. because the
+    /// collection was empty. Defaults to 100 milliseconds.
+    ///
+    /// @param reopen_interval
+    ///   The delay before reopening, which must not be negative.
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    /// @throws mongocxx::logic_error if `reopen_interval` is negative.
+    ///
+    tailer& reopen_interval(std::chrono::milliseconds reopen_interval);
+
+    ///
+    /// Gets the current delay before reopening a closed cursor.
+    ///
+    /// @return The delay before reopening.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& reopen_interval() const;
+
+   private:
+    stdx::optional<std::chrono::milliseconds> _max_await_time;
+    stdx::optional<std::int32_t> _batch_size;
+    stdx::optional<std::string> _resume_field;
+    stdx::optional<std::chrono::milliseconds> _reopen_interval;
+};
+
+}  // namespace options
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -29,6 +29,10 @@ namespace options {
 ///
 /// Class representing the optional arguments to a MongoDB driver client (TLS)
 ///
+/// A mongocxx::pool builds one TLS context from these options and shares it among all of its
+/// connections, so certificates and keys are loaded once per pool rather than once per
+/// connection. TLS sessions are not resumed: every new connection performs a full handshake.
+///
 class MONGOCXX_API tls {
    public:
     ///
@@ -30,10 +30,10 @@ transaction::transaction(transaction&&) noexcept = default;
 transaction& transaction::operator=(transaction&&) noexcept = default;
 
 transaction::transaction(const transaction& other)
-    : _impl{stdx::make_unique<impl>(other._get_impl().get_transaction_opt_t())} {}
+    : _impl{stdx::make_unique<impl>(other._get_impl())} {}
 
 transaction& transaction::operator=(const transaction& other) {
-    _impl = stdx::make_unique<impl>(other._get_impl().get_transaction_opt_t());
+    _impl = stdx::make_unique<impl>(other._get_impl());
     return *this;
 }
 
@@ -75,6 +75,33 @@ stdx::optional<std::chrono::milliseconds> transaction::max_commit_time_ms() cons
     return _impl->max_commit_time_ms();
 }
 
+transaction& transaction::retry_backoff(std::chrono::milliseconds initial,
+                                        std::chrono::milliseconds max) {
+    if (initial.count() <= 0 || max < initial) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "retry backoff requires 0 < initial <= max"};
+    }
+    _impl->retry_backoff(initial, max);
+    return *this;
+}
+
+stdx::optional<std::chrono::milliseconds> transaction::retry_backoff_initial() const {
+    return _impl->retry_backoff_initial();
+}
+
+stdx::optional<std::chrono::milliseconds> transaction::retry_backoff_max() const {
+    return _impl->retry_backoff_max();
+}
+
+transaction& transaction::max_retries(std::uint32_t retries) {
+    _impl->max_retries(retries);
+    return *this;
+}
+
+stdx::optional<std::uint32_t> transaction::max_retries() const {
+    return _impl->max_retries();
+}
+
 const transaction::impl& transaction::_get_impl() const {
     if (!_impl) {
         throw logic_error{error_code::k_invalid_transaction_options_object};
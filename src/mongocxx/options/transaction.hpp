@@ -15,6 +15,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include <bsoncxx/stdx/optional.hpp>
@@ -146,6 +147,49 @@ class MONGOCXX_API transaction {
     ///
     stdx::optional<std::chrono::milliseconds> max_commit_time_ms() const;
 
+    /// Sets the backoff between the attempts of client_session::with_transaction.
+    ///
+    /// Before each retry of the callback, with_transaction sleeps for a random duration between
+    /// zero and `initial` doubled once per earlier retry, capped at `max`. The randomness keeps
+    /// clients which conflicted on the same documents from retrying in lockstep. Without a
+    /// backoff, the callback is retried as soon as libmongoc decides to retry.
+    /// @param initial
+    ///   The largest sleep before the first retry.
+    /// @param max
+    ///   The largest sleep before any retry.
+    /// @return
+    ///   A reference to the object on which this function is being called.
+    /// @throws mongocxx::logic_error if `initial` is not positive or `max` is less than `initial`.
+    transaction& retry_backoff(std::chrono::milliseconds initial, std::chrono::milliseconds max);
+
+    /// Gets the largest sleep before the first retry of client_session::with_transaction.
+    /// @return
+    ///   An optional containing the initial backoff. If no backoff has been set, a disengaged
+    ///   optional is returned.
+    stdx::optional<std::chrono::milliseconds> retry_backoff_initial() const;
+
+    /// Gets the largest sleep before any retry of client_session::with_transaction.
+    /// @return
+    ///   An optional containing the maximum backoff. If no backoff has been set, a disengaged
+    ///   optional is returned.
+    stdx::optional<std::chrono::milliseconds> retry_backoff_max() const;
+
+    /// Sets the retry budget of client_session::with_transaction: the number of times the
+    /// callback may be rerun after its first attempt. Once the budget is spent, with_transaction
+    /// aborts the transaction and throws instead of retrying, even within libmongoc's retry time
+    /// limit. Without a budget, only that time limit applies.
+    /// @param retries
+    ///   The largest number of retries.
+    /// @return
+    ///   A reference to the object on which this function is being called.
+    transaction& max_retries(std::uint32_t retries);
+
+    /// Gets the retry budget of client_session::with_transaction.
+    /// @return
+    ///   An optional containing the largest number of retries. If no budget has been set, a
+    ///   disengaged optional is returned.
+    stdx::optional<std::uint32_t> max_retries() const;
+
    private:
     friend class ::mongocxx::client_session;
 
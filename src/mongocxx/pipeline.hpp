@@ -31,6 +31,7 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 class client;
 class collection;
 class database;
+class pipeline_template;
 
 ///
 /// Class representing a MongoDB aggregation pipeline.
@@ -547,6 +548,7 @@ class MONGOCXX_API pipeline {
     friend class client;
     friend class collection;
     friend class database;
+    friend class pipeline_template;
 
     class MONGOCXX_PRIVATE impl;
     std::unique_ptr<impl> _impl;
@@ -0,0 +1,59 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/pipeline_template.hpp>
+
+#include <bsoncxx/array/value.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/private/pipeline.hh>
+#include <mongocxx/private/pipeline_template.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+bsoncxx::document::value pipeline_template::parameter(stdx::string_view name) {
+    return document_template::placeholder(name);
+}
+
+pipeline_template::pipeline_template(const pipeline& stages)
+    : _impl(stdx::make_unique<impl>(bsoncxx::document::view{stages.view_array()})) {}
+
+pipeline_template::pipeline_template(pipeline_template&&) noexcept = default;
+pipeline_template& pipeline_template::operator=(pipeline_template&&) noexcept = default;
+pipeline_template::~pipeline_template() = default;
+
+std::size_t pipeline_template::parameter_count() const noexcept {
+    return _impl->names.size();
+}
+
+std::size_t pipeline_template::parameter_index(stdx::string_view name) const {
+    return document_template::parameter_index(_impl->names, name);
+}
+
+pipeline pipeline_template::bind(const std::vector<bsoncxx::types::value>& values) const {
+    document_template::check_values(_impl->names, values);
+
+    auto bound = _impl->stages.bind(values);
+    const auto length = bound.view().length();
+
+    pipeline result;
+    result._impl =
+        stdx::make_unique<pipeline::impl>(bsoncxx::array::value{bound.release(), length});
+    return result;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,110 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// An aggregation pipeline whose structure is serialized once, with named parameters that are
+/// filled in for each run.
+///
+/// The template is built from a pipeline in which every parameter is written as the document
+/// returned by parameter(). The stages are scanned once, recording where each parameter sits and
+/// which enclosing documents it lengthens, so that bind() produces the stages of a run by copying
+/// the frozen bytes around the encoded values and patching a few lengths, without building the
+/// pipeline again.
+///
+/// @code
+///   pipeline stages;
+///   stages.match(make_document(kvp("status", pipeline_template::parameter("status"))))
+///       .limit(10);
+///   pipeline_template by_status{stages};
+///
+///   auto run = by_status.bind({bsoncxx::types::value{bsoncxx::types::b_utf8{"active"}}});
+///   auto cursor = coll.aggregate(run);
+/// @endcode
+///
+/// A template is immutable once constructed, so several threads may bind it at once.
+///
+class MONGOCXX_API pipeline_template {
+   public:
+    ///
+    /// Returns the placeholder for the parameter `name`, i.e. the document { "$parameter": name }.
+    /// It may be used wherever a value is allowed in the stages of the template, and the same
+    /// name may be used more than once.
+    ///
+    static bsoncxx::document::value parameter(stdx::string_view name);
+
+    ///
+    /// Freezes the stages of a pipeline. Later changes to the pipeline do not affect the template.
+    ///
+    explicit pipeline_template(const pipeline& stages);
+
+    pipeline_template(pipeline_template&&) noexcept;
+    pipeline_template& operator=(pipeline_template&&) noexcept;
+
+    ~pipeline_template();
+
+    ///
+    /// @return The number of distinct parameters of the template.
+    ///
+    std::size_t parameter_count() const noexcept;
+
+    ///
+    /// Returns the position of a parameter's value in the argument of bind(). Parameters are
+    /// numbered in the order of their first occurrence in the stages.
+    ///
+    /// @throws mongocxx::logic_error if the template has no parameter named `name`.
+    ///
+    std::size_t parameter_index(stdx::string_view name) const;
+
+    ///
+    /// Produces the stages of one run of the template.
+    ///
+    /// @param values
+    ///   The value of each parameter, in the order given by parameter_index(). Values that are
+    ///   views, e.g. strings and documents, are copied, so they need only live until bind()
+    ///   returns.
+    ///
+    /// @return
+    ///   A pipeline that may be passed to any aggregate() or watch() overload. More stages may be
+    ///   appended to it, at the cost of copying the bound ones once.
+    ///
+    /// @throws mongocxx::logic_error if the number of values is not parameter_count().
+    ///
+    pipeline bind(const std::vector<bsoncxx::types::value>& values) const;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
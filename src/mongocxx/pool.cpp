@@ -14,18 +14,40 @@
 
 #include <mongocxx/pool.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/types.hpp>
 #include <mongocxx/client.hpp>
+#include <mongocxx/database.hpp>
 #include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/exception.hpp>
 #include <mongocxx/exception/operation_exception.hpp>
 #include <mongocxx/exception/private/mongoc_error.hh>
+#include <mongocxx/instance.hpp>
 #include <mongocxx/options/private/apm.hh>
 #include <mongocxx/options/private/ssl.hh>
 #include <mongocxx/private/client.hh>
+#include <mongocxx/private/compression_statistics.hh>
+#include <mongocxx/private/instance.hh>
+#include <mongocxx/private/numa.hh>
 #include <mongocxx/private/pool.hh>
+#include <mongocxx/private/topology_snapshot.hh>
 #include <mongocxx/private/uri.hh>
 
 #include <mongocxx/config/private/prelude.hh>
@@ -33,17 +55,616 @@
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+namespace {
+
+std::atomic<std::uint64_t> next_pool_id{0};
+
+mongoc_client_pool_t* new_client_pool(const mongoc_uri_t* uri_t, const options::client& options) {
+    ensure_libmongoc_initialized();
+
+    unique_uri overridden{nullptr, libmongoc::uri_destroy};
+    return libmongoc::client_pool_new(uri_with_overrides(uri_t, options, &overridden));
+}
+
+}  // namespace
+
+pool::impl::impl(mongoc_client_pool_t* pool) : client_pool_t(pool), _id(next_pool_id++) {}
+
+pool::impl::~impl() {
+    if (_reaper.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{_reaper_mutex};
+            _reaper_stopping = true;
+        }
+        _reaper_stop.notify_one();
+        _reaper.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_slots_mutex};
+        for (auto&& slot : _slots) {
+            slot->close();
+        }
+    }
+
+    for (auto&& partition : partitions) {
+        while (auto parked = partition->take()) {
+            libmongoc::client_pool_push(client_pool_t, parked);
+        }
+    }
+
+    libmongoc::client_pool_destroy(client_pool_t);
+}
+
+void pool::impl::affinity_slot::close() {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (pool_t) {
+        if (auto parked = client.exchange(nullptr)) {
+            libmongoc::client_pool_push(pool_t, parked);
+        }
+        pool_t = nullptr;
+    }
+}
+
+bool pool::impl::affinity_slot::closed() {
+    std::lock_guard<std::mutex> lock{mutex};
+    return pool_t == nullptr;
+}
+
+pool::impl::affinity_slot& pool::impl::local_slot() {
+    // The slots of the calling thread, by pool. When the thread exits, the clients parked in them
+    // go back to the shared queues of the pools that still exist.
+    struct thread_slots {
+        ~thread_slots() {
+            for (auto&& slot : by_pool) {
+                slot.second->close();
+            }
+        }
+
+        std::unordered_map<std::uint64_t, std::shared_ptr<affinity_slot>> by_pool;
+    };
+    thread_local thread_slots slots;
+
+    auto found = slots.by_pool.find(_id);
+    if (found != slots.by_pool.end()) {
+        return *found->second;
+    }
+
+    // A slot is only added once per thread and pool, so that is when the slots of the pools
+    // destroyed since are swept; otherwise a long-lived thread would keep one for every pool it
+    // ever used.
+    for (auto it = slots.by_pool.begin(); it != slots.by_pool.end();) {
+        if (it->second->closed()) {
+            it = slots.by_pool.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto slot = std::make_shared<affinity_slot>();
+    slot->pool_t = client_pool_t;
+    slots.by_pool.emplace(_id, slot);
+
+    // Likewise, the pool forgets the slots of the threads that have exited.
+    std::lock_guard<std::mutex> lock{_slots_mutex};
+    _slots.erase(std::remove_if(_slots.begin(),
+                                _slots.end(),
+                                [](const std::shared_ptr<affinity_slot>& stale) {
+                                    return stale->closed();
+                                }),
+                 _slots.end());
+    _slots.push_back(slot);
+
+    return *slot;
+}
+
+mongoc_client_t* pool::impl::numa_partition::take() {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (clients.empty()) {
+        return nullptr;
+    }
+    auto client = clients.back();
+    clients.pop_back();
+    return client;
+}
+
+bool pool::impl::parks_clients() const {
+    return thread_affinity || !partitions.empty();
+}
+
+mongoc_client_t* pool::impl::steal_parked() {
+    {
+        std::lock_guard<std::mutex> lock{_slots_mutex};
+        for (auto&& slot : _slots) {
+            if (auto parked = slot->client.exchange(nullptr)) {
+                return parked;
+            }
+        }
+    }
+
+    // Prefer the partitions of the nodes after the caller's, so that stealing threads of different
+    // nodes spread out rather than all draining the first partition.
+    if (!partitions.empty()) {
+        const auto local = numa::current_node();
+        for (std::size_t i = 1; i <= partitions.size(); i++) {
+            if (auto parked = partitions[(local + i) % partitions.size()]->take()) {
+                return parked;
+            }
+        }
+    }
+    return nullptr;
+}
+
+mongoc_client_t* pool::impl::pop(bool blocking) {
+    if (thread_affinity) {
+        if (auto parked = local_slot().client.exchange(nullptr)) {
+            return parked;
+        }
+    }
+
+    if (!partitions.empty()) {
+        if (auto parked = partitions[numa::current_node()]->take()) {
+            return parked;
+        }
+    }
+
+    if (auto client = libmongoc::client_pool_try_pop(client_pool_t)) {
+        popped_shared();
+        return client;
+    }
+
+    if (parks_clients()) {
+        if (auto parked = steal_parked()) {
+            return parked;
+        }
+    }
+
+    if (!blocking) {
+        return nullptr;
+    }
+
+    // Every client is in use, so the caller has to wait for one to be released.
+    stats.saturation_events.fetch_add(1, std::memory_order_relaxed);
+
+    if (!parks_clients()) {
+        auto client = libmongoc::client_pool_pop(client_pool_t);
+        popped_shared();
+        return client;
+    }
+
+    // Announce the wait before checking the slots one last time: a thread parking a client either
+    // finds _waiters positive and pushes it to the shared queue, or parks it early enough for the
+    // check below to find it.
+    _waiters++;
+    auto client = steal_parked();
+    if (!client) {
+        client = libmongoc::client_pool_pop(client_pool_t);
+        popped_shared();
+    }
+    _waiters--;
+
+    return client;
+}
+
+mongoc_client_t* pool::impl::pop_until(std::chrono::steady_clock::time_point deadline) {
+    if (auto client = pop(false)) {
+        return client;
+    }
+
+    stats.saturation_events.fetch_add(1, std::memory_order_relaxed);
+
+    // While _timed_waiters is positive, every release goes to the shared queue and bumps
+    // _releases, so a release missed by pop(false) below is caught by the wait that follows it.
+    _timed_waiters++;
+    _waiters++;
+
+    mongoc_client_t* client = nullptr;
+    while (true) {
+        std::uint64_t releases;
+        {
+            std::lock_guard<std::mutex> lock{_release_mutex};
+            releases = _releases;
+        }
+
+        client = pop(false);
+        if (client) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock{_release_mutex};
+        if (!_released.wait_until(lock, deadline, [&] { return _releases != releases; })) {
+            break;
+        }
+    }
+
+    _waiters--;
+    _timed_waiters--;
+
+    return client;
+}
+
+void pool::impl::push(mongoc_client_t* client) {
+    if (thread_affinity) {
+        auto& slot = local_slot();
+        mongoc_client_t* empty = nullptr;
+        if (slot.client.compare_exchange_strong(empty, client)) {
+            if (_waiters.load() == 0) {
+                return;
+            }
+
+            // Another thread is blocked on the shared queue; hand it the client unless it has
+            // already taken it from the slot.
+            client = slot.client.exchange(nullptr);
+            if (!client) {
+                return;
+            }
+        }
+    } else if (!partitions.empty()) {
+        auto& partition = *partitions[numa::current_node()];
+        {
+            std::lock_guard<std::mutex> lock{partition.mutex};
+            partition.clients.push_back(client);
+        }
+        if (_waiters.load() == 0) {
+            return;
+        }
+
+        // As with a slot, hand a client to the blocked thread unless it has taken one already.
+        client = partition.take();
+        if (!client) {
+            return;
+        }
+    }
+
+    push_shared(client);
+}
+
+void pool::impl::push_shared(mongoc_client_t* client) {
+    libmongoc::client_pool_push(client_pool_t, client);
+    add_shared_idle(1, min_pool_size);
+    signal_release(false);
+}
+
+void pool::impl::popped_shared() {
+    auto idle = _shared_idle.load(std::memory_order_relaxed);
+    while (idle > 0 &&
+           !_shared_idle.compare_exchange_weak(idle, idle - 1, std::memory_order_relaxed)) {
+    }
+}
+
+void pool::impl::add_shared_idle(std::size_t count, std::uint32_t min_size) {
+    // With a minimum size, libmongoc destroys the oldest idle client of each push that would leave
+    // more than that many idle, so the queue never holds more.
+    auto idle = _shared_idle.load(std::memory_order_relaxed);
+    std::size_t added;
+    do {
+        added = idle + count;
+        if (min_size > 0) {
+            added = std::min<std::size_t>(added, std::max<std::size_t>(idle, min_size));
+        }
+    } while (!_shared_idle.compare_exchange_weak(idle, added, std::memory_order_relaxed));
+}
+
+void pool::impl::signal_release(bool all) {
+    if (_timed_waiters.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock{_release_mutex};
+            _releases++;
+        }
+        if (all) {
+            _released.notify_all();
+        } else {
+            _released.notify_one();
+        }
+    }
+}
+
+void pool::impl::shrink_to(std::size_t idle) {
+    std::lock_guard<std::mutex> lock{_shrink_mutex};
+
+    // Take every idle client. Only as many are taken from libmongoc's queue as the driver has
+    // pushed there, since try_pop() creates a client rather than fail while the pool is below its
+    // maximum size.
+    std::vector<mongoc_client_t*> drained;
+    while (auto parked = steal_parked()) {
+        drained.push_back(parked);
+    }
+    for (auto shared = _shared_idle.load(std::memory_order_relaxed); shared > 0; shared--) {
+        auto client = libmongoc::client_pool_try_pop(client_pool_t);
+        if (!client) {
+            break;
+        }
+        popped_shared();
+        drained.push_back(client);
+    }
+
+    if (!drained.empty()) {
+        // libmongoc documents that, with a minimum pool size, a push destroys the oldest idle
+        // client while more than that many are idle. The clients go back least recently used
+        // first, so the most recently used ones are kept.
+        const auto keep = static_cast<std::uint32_t>(std::max<std::size_t>(
+            std::min<std::size_t>(idle, std::numeric_limits<std::uint32_t>::max()), 1));
+        libmongoc::client_pool_min_size(client_pool_t, keep);
+        for (auto client = drained.rbegin(); client != drained.rend(); ++client) {
+            libmongoc::client_pool_push(client_pool_t, *client);
+        }
+        add_shared_idle(drained.size(), keep);
+        libmongoc::client_pool_min_size(client_pool_t, min_pool_size);
+
+        // The threads blocked in libmongoc were woken by the pushes; those in pop_until() wait on
+        // the driver instead.
+        signal_release(true);
+    }
+
+    std::lock_guard<std::mutex> idle_lock{idle_clients_mutex};
+    if (idle_clients.size() > idle) {
+        idle_clients.resize(idle);
+    }
+}
+
+void pool::impl::start_reaper(std::chrono::milliseconds max_idle_time) {
+    _reaper = std::thread{[this, max_idle_time] {
+        std::unique_lock<std::mutex> lock{_reaper_mutex};
+        while (!_reaper_stop.wait_for(lock, max_idle_time, [&] { return _reaper_stopping; })) {
+            lock.unlock();
+
+            // The clients idle throughout the interval are those beyond the most in use at once.
+            const auto in_use = stats.in_use.load(std::memory_order_relaxed);
+            const auto peak = peak_in_use.exchange(in_use, std::memory_order_relaxed);
+            shrink_to(static_cast<std::size_t>(peak > in_use ? peak - in_use : 0));
+
+            lock.lock();
+        }
+    }};
+}
+
+namespace {
+
+template <typename histogram_type>
+void record_duration(std::chrono::nanoseconds duration,
+                     std::atomic<std::uint64_t>& total,
+                     std::atomic<std::uint64_t>& max,
+                     histogram_type& histogram) {
+    const auto nanoseconds =
+        static_cast<std::uint64_t>(std::max(duration, std::chrono::nanoseconds{0}).count());
+
+    total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    auto current_max = max.load(std::memory_order_relaxed);
+    while (nanoseconds > current_max &&
+           !max.compare_exchange_weak(current_max, nanoseconds, std::memory_order_relaxed)) {
+    }
+
+    // Bucket i > 0 holds durations of [2^(i-1), 2^i) microseconds.
+    std::size_t bucket = 0;
+    for (auto microseconds = nanoseconds / 1000; microseconds > 0; microseconds >>= 1) {
+        bucket++;
+    }
+    bucket = std::min(bucket, histogram.size() - 1);
+    histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename histogram_type>
+void snapshot(const histogram_type& from, pool::statistics::histogram& to) {
+    for (std::size_t i = 0; i < from.size(); i++) {
+        to[i] = from[i].load(std::memory_order_relaxed);
+    }
+}
+
+}  // namespace
+
 void pool::_release(client* client) {
-    libmongoc::client_pool_push(_impl->client_pool_t, client->_get_impl().client_t);
+    auto& client_impl = client->_get_impl();
+    const auto hold_time = std::chrono::steady_clock::now() - client_impl.checked_out_at;
+    const auto wait_time = client_impl.checkout_wait_time;
+
+    // The cached handles belong to this mongoc_client_t, which the wrapper may not get back.
+    client_impl.clear_handles();
+    _impl->push(client_impl.client_t);
     // prevent client destructor from destroying the underlying mongoc_client_t
-    client->_get_impl().client_t = nullptr;
-    delete client;
+    client_impl.client_t = nullptr;
+
+    auto& stats = _impl->stats;
+    stats.in_use.fetch_sub(1, std::memory_order_relaxed);
+    record_duration(
+        hold_time, stats.total_hold_time, stats.max_hold_time, stats.hold_time_histogram);
+
+    std::unique_ptr<class client> idle{client};
+    try {
+        std::lock_guard<std::mutex> lock{_impl->idle_clients_mutex};
+        _impl->idle_clients.push_back(std::move(idle));
+    } catch (...) {
+        // The client could not be kept for reuse and is destroyed instead.
+    }
+
+    if (_impl->checkout_observer) {
+        _impl->checkout_observer(wait_time, hold_time);
+    }
+}
+
+pool::entry pool::_checkout(void* client_t, std::chrono::steady_clock::time_point start) {
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds wait_time = now - start;
+
+    auto& stats = _impl->stats;
+    stats.acquires.fetch_add(1, std::memory_order_relaxed);
+    const auto in_use = stats.in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+    record_duration(
+        wait_time, stats.total_wait_time, stats.max_wait_time, stats.wait_time_histogram);
+
+    auto peak = _impl->peak_in_use.load(std::memory_order_relaxed);
+    while (in_use > peak && !_impl->peak_in_use.compare_exchange_weak(
+                                peak, in_use, std::memory_order_relaxed)) {
+    }
+
+    entry::unique_client client{_wrap(client_t),
+                                [this](class client* client) { _release(client); }};
+    client->_get_impl().checked_out_at = now;
+    client->_get_impl().checkout_wait_time = wait_time;
+
+    if (_impl->apm.listeners.connection_checked_out()) {
+        _impl->apm.listeners.connection_checked_out()(
+            events::connection_checked_out_event{wait_time});
+    }
+
+    return entry(std::move(client));
+}
+
+constexpr std::size_t pool::statistics::k_histogram_buckets;
+
+void pool::shrink_to(std::size_t idle) {
+    _impl->shrink_to(idle);
+}
+
+pool::statistics pool::stats() const {
+    const auto& counters = _impl->stats;
+
+    statistics result;
+    result.acquires = counters.acquires.load(std::memory_order_relaxed);
+    result.in_use = counters.in_use.load(std::memory_order_relaxed);
+    result.try_acquire_failures = counters.try_acquire_failures.load(std::memory_order_relaxed);
+    result.saturation_events = counters.saturation_events.load(std::memory_order_relaxed);
+    result.total_wait_time =
+        std::chrono::nanoseconds{counters.total_wait_time.load(std::memory_order_relaxed)};
+    result.max_wait_time =
+        std::chrono::nanoseconds{counters.max_wait_time.load(std::memory_order_relaxed)};
+    snapshot(counters.wait_time_histogram, result.wait_time_histogram);
+    result.total_hold_time =
+        std::chrono::nanoseconds{counters.total_hold_time.load(std::memory_order_relaxed)};
+    result.max_hold_time =
+        std::chrono::nanoseconds{counters.max_hold_time.load(std::memory_order_relaxed)};
+    snapshot(counters.hold_time_histogram, result.hold_time_histogram);
+
+    return result;
+}
+
+std::vector<events::command_latency> pool::command_latencies() const {
+    if (!_impl->apm.latencies) {
+        return {};
+    }
+
+    return _impl->apm.latencies->snapshot();
+}
+
+std::vector<events::slow_command> pool::slow_commands() const {
+    if (!_impl->apm.slow_commands) {
+        return {};
+    }
+
+    return _impl->apm.slow_commands->snapshot();
+}
+
+std::vector<events::namespace_stats> pool::namespace_stats() const {
+    if (!_impl->apm.namespaces) {
+        return {};
+    }
+
+    return _impl->apm.namespaces->snapshot();
+}
+
+std::vector<events::query_shape> pool::query_shapes() const {
+    if (!_impl->apm.query_shapes) {
+        return {};
+    }
+
+    return _impl->apm.query_shapes->snapshot();
+}
+
+class topology_snapshot pool::topology_snapshot() {
+    auto client = acquire();
+    return make_topology_snapshot(client->_get_impl().client_t, _impl->apm.latencies.get());
+}
+
+class compression_statistics pool::compression_statistics() {
+    auto client = acquire();
+    return make_compression_statistics(client->_get_impl().client_t, _impl->apm);
+}
+
+std::uint64_t pool::dropped_apm_events() const {
+    if (!_impl->apm.delivery) {
+        return 0;
+    }
+
+    return _impl->apm.delivery->dropped();
+}
+
+std::int64_t pool::buffered_reply_bytes() const {
+    return static_cast<std::int64_t>(_impl->replies->used());
+}
+
+std::shared_ptr<executor> pool::executor() const {
+    if (_impl->executor) {
+        return _impl->executor;
+    }
+    return instance::current().executor();
+}
+
+client* pool::_wrap(void* client_t) {
+    std::unique_ptr<client> wrapper;
+    {
+        std::lock_guard<std::mutex> lock{_impl->idle_clients_mutex};
+        if (!_impl->idle_clients.empty()) {
+            wrapper = std::move(_impl->idle_clients.back());
+            _impl->idle_clients.pop_back();
+        }
+    }
+
+    if (_impl->streams) {
+        _impl->streams->attach(static_cast<mongoc_client_t*>(client_t));
+    }
+
+    if (wrapper) {
+        wrapper->_get_impl().client_t = static_cast<mongoc_client_t*>(client_t);
+    } else {
+        wrapper.reset(new client(client_t));
+        wrapper->_get_impl().gridfs_indexes = _impl->gridfs_indexes;
+        wrapper->_get_impl().counts = _impl->counts;
+        wrapper->_get_impl().group_commits = _impl->group_commits;
+        wrapper->_get_impl().replies = _impl->replies;
+    }
+
+    return wrapper.release();
 }
 
 pool::~pool() = default;
 
 pool::pool(const uri& uri, const options::pool& options)
-    : _impl{stdx::make_unique<impl>(libmongoc::client_pool_new(uri._impl->uri_t))} {
+    : _impl{stdx::make_unique<impl>(new_client_pool(uri._impl->uri_t, options.client_opts()))} {
+    _impl->thread_affinity = options.thread_affinity().value_or(false);
+    if (options.numa_partitions().value_or(false)) {
+        if (_impl->thread_affinity) {
+            throw exception{error_code::k_invalid_parameter,
+                            "cannot combine thread_affinity and numa_partitions"};
+        }
+
+        const auto nodes = numa::node_count();
+        for (std::size_t node = 0; nodes > 1 && node < nodes; node++) {
+            _impl->partitions.push_back(stdx::make_unique<impl::numa_partition>());
+        }
+    }
+    if (stream_initiator::needed(options.client_opts())) {
+        _impl->streams = stdx::make_unique<stream_initiator>(options.client_opts());
+    }
+    _impl->replies = reply_budget::make(options.client_opts().max_buffered_reply_bytes());
+    _impl->checkout_observer = options.checkout_observer();
+    _impl->executor = options.executor();
+
+    auto uri_options = uri.options();
+    auto min_pool_size = uri_options["minpoolsize"];
+    if (min_pool_size && min_pool_size.type() == bsoncxx::type::k_int32 &&
+        min_pool_size.get_int32().value > 0) {
+        _impl->min_pool_size = static_cast<std::uint32_t>(min_pool_size.get_int32().value);
+    }
+
+    auto wait_queue_timeout = uri_options["waitqueuetimeoutms"];
+    if (wait_queue_timeout && wait_queue_timeout.type() == bsoncxx::type::k_int32) {
+        _impl->wait_queue_timeout =
+            std::chrono::milliseconds{wait_queue_timeout.get_int32().value};
+    }
+
 #if defined(MONGOCXX_ENABLE_SSL) && defined(MONGOC_ENABLE_SSL)
     if (options.client_opts().tls_opts()) {
         if (!uri.tls())
@@ -76,13 +697,88 @@ pool::pool(const uri& uri, const options::pool& options)
     }
 
     if (options.client_opts().apm_opts()) {
-        _impl->listeners = *options.client_opts().apm_opts();
-        auto callbacks = options::make_apm_callbacks(_impl->listeners);
-        // We cast the APM class to a void* so we can pass it into libmongoc's context.
-        // It will be cast back to an APM class in the event handlers.
-        auto context = static_cast<void*>(&(_impl->listeners));
+        _impl->apm.init(*options.client_opts().apm_opts());
+        auto callbacks = options::make_apm_callbacks(_impl->apm.listeners);
+        // We cast the APM context to a void* so we can pass it into libmongoc's context.
+        // It will be cast back to an APM context in the event handlers.
+        auto context = static_cast<void*>(&(_impl->apm));
         libmongoc::client_pool_set_apm_callbacks(_impl->client_pool_t, callbacks.get(), context);
     }
+
+    if (options.warmup() && *options.warmup() > 0) {
+        _warmup(*options.warmup());
+    }
+
+    auto max_idle_time = uri_options["maxidletimems"];
+    if (max_idle_time && max_idle_time.type() == bsoncxx::type::k_int32 &&
+        max_idle_time.get_int32().value > 0) {
+        _impl->start_reaper(std::chrono::milliseconds{max_idle_time.get_int32().value});
+    }
+
+    if (options.client_opts().auto_encryption_opts()) {
+        // The clients of a pool share libmongoc's encryption state, so one client warms it for
+        // all of them.
+        if (auto warming = try_acquire()) {
+            options.client_opts().auto_encryption_opts()->warm_up(**warming);
+        }
+    }
+}
+
+void pool::_warmup(std::int32_t min_connections) {
+    // Connecting is dominated by network round trips, so a handful of threads is enough to
+    // overlap the handshakes without a thread per connection.
+    const auto thread_count = std::min<std::int32_t>(min_connections, 8);
+
+    std::atomic<std::int32_t> remaining{min_connections};
+    std::mutex warmed_mutex;
+    std::vector<mongoc_client_t*> warmed;
+
+    auto warm = [&] {
+        while (remaining.fetch_sub(1) > 0) {
+            // Every warmed client stays checked out until all threads are done, so that each
+            // ping is made on a new client, and thus a new connection.
+            auto client_t = libmongoc::client_pool_try_pop(_impl->client_pool_t);
+            if (!client_t) {
+                return;
+            }
+
+            if (_impl->streams) {
+                _impl->streams->attach(client_t);
+            }
+
+            client warming{client_t};
+            try {
+                warming["admin"].run_command(make_document(kvp("ping", 1)));
+            } catch (const mongocxx::exception&) {
+                // The client connects again on first use.
+            }
+            // prevent client destructor from destroying the underlying mongoc_client_t
+            warming._get_impl().client_t = nullptr;
+
+            std::lock_guard<std::mutex> lock{warmed_mutex};
+            warmed.push_back(client_t);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::int32_t i = 1; i < thread_count; i++) {
+        try {
+            threads.emplace_back(warm);
+        } catch (const std::system_error&) {
+            // Warm up with the threads that could be started.
+            break;
+        }
+    }
+    warm();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // Return the clients to the shared queue directly, rather than to a thread affinity slot of
+    // the constructing thread.
+    for (auto client_t : warmed) {
+        _impl->push_shared(client_t);
+    }
 }
 
 client* pool::entry::operator->() const& noexcept {
@@ -102,21 +798,52 @@ pool::entry::operator bool() const noexcept {
     return static_cast<bool>(_client);
 }
 
+void pool::_check_out_failed(
+    events::connection_check_out_failed_event::failure_reason reason,
+    std::chrono::steady_clock::time_point start) {
+    if (_impl->apm.listeners.connection_check_out_failed()) {
+        const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - start;
+        _impl->apm.listeners.connection_check_out_failed()(
+            events::connection_check_out_failed_event{reason, duration});
+    }
+}
+
 // construct a pool entry from a pointer to a client
 pool::entry::entry(pool::entry::unique_client p) : _client(std::move(p)) {}
 
 pool::entry pool::acquire() {
-    return entry(entry::unique_client(new client(libmongoc::client_pool_pop(_impl->client_pool_t)),
-                                      [this](client* client) { _release(client); }));
+    if (_impl->wait_queue_timeout.count() > 0) {
+        return acquire(_impl->wait_queue_timeout);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    return _checkout(_impl->pop(true), start);
+}
+
+pool::entry pool::acquire(std::chrono::milliseconds timeout) {
+    const auto start = std::chrono::steady_clock::now();
+    auto cli = _impl->pop_until(start + timeout);
+    if (!cli) {
+        _check_out_failed(events::connection_check_out_failed_event::failure_reason::k_timeout,
+                          start);
+        throw exception{error_code::k_pool_wait_queue_timeout,
+                        "timed out waiting for a client to be released to the pool"};
+    }
+
+    return _checkout(cli, start);
 }
 
 stdx::optional<pool::entry> pool::try_acquire() {
-    auto cli = libmongoc::client_pool_try_pop(_impl->client_pool_t);
-    if (!cli)
+    const auto start = std::chrono::steady_clock::now();
+    auto cli = _impl->pop(false);
+    if (!cli) {
+        _impl->stats.try_acquire_failures.fetch_add(1, std::memory_order_relaxed);
+        _check_out_failed(
+            events::connection_check_out_failed_event::failure_reason::k_pool_exhausted, start);
         return stdx::nullopt;
+    }
 
-    return entry(
-        entry::unique_client(new client(cli), [this](client* client) { _release(client); }));
+    return _checkout(cli, start);
 }
 
 MONGOCXX_INLINE_NAMESPACE_END
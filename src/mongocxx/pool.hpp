@@ -14,12 +14,24 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/compression_statistics.hpp>
+#include <mongocxx/events/command_latency.hpp>
+#include <mongocxx/events/namespace_stats.hpp>
+#include <mongocxx/events/query_shape.hpp>
+#include <mongocxx/events/slow_command.hpp>
+#include <mongocxx/events/connection_check_out_failed_event.hpp>
 #include <mongocxx/options/pool.hpp>
 #include <mongocxx/stdx.hpp>
+#include <mongocxx/topology_snapshot.hpp>
 #include <mongocxx/uri.hpp>
 
 #include <mongocxx/config/prelude.hpp>
@@ -28,6 +40,7 @@ namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 class client;
+class executor;
 
 ///
 /// A pool of @c client objects associated with a MongoDB deployment.
@@ -35,6 +48,10 @@ class client;
 /// For interoperability with other MongoDB drivers, the minimum and maximum number of connections
 /// in the pool is configured using the 'minPoolSize' and 'maxPoolSize' connection string options.
 ///
+/// A pool keeps the clients created during a burst of load. With the 'maxIdleTimeMS' connection
+/// string option, a background thread of the pool destroys the clients that stay idle for that
+/// long, and so closes their connections; see shrink_to().
+///
 /// @see https://docs.mongodb.com/master/reference/connection-string/#connection-string-options
 ///
 /// @remark When connecting to a replica set, it is @b much more efficient to use a pool as opposed
@@ -101,19 +118,212 @@ class MONGOCXX_API pool {
     /// Acquires a client from the pool. The calling thread will block until a connection is
     /// available.
     ///
+    /// If the pool's URI sets waitQueueTimeoutMS, this is equivalent to calling acquire() with
+    /// that timeout.
+    ///
+    /// @throws mongocxx::exception if waitQueueTimeoutMS elapses before a client is available.
+    ///
     entry acquire();
 
+    ///
+    /// Acquires a client from the pool, blocking for at most the given timeout until a connection
+    /// is available.
+    ///
+    /// @param timeout
+    ///   The longest time to wait for a client to be released to the pool.
+    ///
+    /// @throws mongocxx::exception with error_code::k_pool_wait_queue_timeout if no client becomes
+    ///   available before the timeout elapses.
+    ///
+    entry acquire(std::chrono::milliseconds timeout);
+
     ///
     /// Acquires a client from the pool. This method will return immediately, but may return a
     /// disengaged optional if a client is not available.
     ///
     stdx::optional<entry> try_acquire();
 
+    ///
+    /// Destroys idle clients, and with them their connections, until at most `idle` clients are
+    /// left idle in the pool. Clients in use are unaffected, and the pool creates clients again
+    /// as load requires, up to maxPoolSize.
+    ///
+    /// The clients are destroyed by libmongoc, which documents that a pool with a minimum size
+    /// destroys the excess idle clients as clients are pushed back; shrink_to() takes the idle
+    /// clients and pushes them back with the minimum size set to `idle`, then restores the
+    /// 'minPoolSize' of the URI. libmongoc keeps at least one idle client, so an `idle` of zero
+    /// leaves one. maxPoolSize is never changed: while the idle clients are taken, a thread
+    /// acquiring a client creates a new one, or at maxPoolSize waits until they are pushed back.
+    ///
+    /// A pool created with 'maxIdleTimeMS' calls this on its own every maxIdleTimeMS, keeping
+    /// only as many idle clients as were in use at the busiest moment of the interval. A client
+    /// is thus destroyed after between one and two maxIdleTimeMS of idleness.
+    ///
+    /// @param idle
+    ///   The most idle clients to keep.
+    ///
+    void shrink_to(std::size_t idle);
+
+    ///
+    /// A snapshot of the usage of a pool, as returned by pool::stats().
+    ///
+    /// Durations are measured with std::chrono::steady_clock. Each histogram counts durations by
+    /// powers of two of microseconds: bucket 0 counts durations under 1us, bucket i counts
+    /// durations from 2^(i-1)us up to 2^i us, and the last bucket also counts every longer
+    /// duration.
+    ///
+    struct statistics {
+        static constexpr std::size_t k_histogram_buckets = 24;
+
+        using histogram = std::array<std::uint64_t, k_histogram_buckets>;
+
+        /// The number of clients acquired with acquire() or try_acquire().
+        std::uint64_t acquires;
+
+        /// The number of clients currently checked out.
+        std::uint64_t in_use;
+
+        /// The number of try_acquire() calls that returned no client.
+        std::uint64_t try_acquire_failures;
+
+        /// The number of acquire() calls that found every client in use and had to wait, which
+        /// happens once maxPoolSize clients are checked out.
+        std::uint64_t saturation_events;
+
+        /// The time spent in acquire() and try_acquire() waiting for a client.
+        std::chrono::nanoseconds total_wait_time;
+        std::chrono::nanoseconds max_wait_time;
+        histogram wait_time_histogram;
+
+        /// The time from acquiring a client to releasing it, over released clients.
+        std::chrono::nanoseconds total_hold_time;
+        std::chrono::nanoseconds max_hold_time;
+        histogram hold_time_histogram;
+    };
+
+    ///
+    /// Takes a snapshot of the usage of the pool. Counters are read one by one while other
+    /// threads may be using the pool, so a snapshot need not be exactly consistent.
+    ///
+    /// @return The counters of the pool since it was created.
+    ///
+    statistics stats() const;
+
+    ///
+    /// Takes a snapshot of the latency histograms recorded for the commands run by the clients of
+    /// the pool, one per command name and server.
+    ///
+    /// Latencies are only recorded if the pool was created with
+    /// options::apm::record_command_latencies() set in its client options. The histograms of all
+    /// the threads using the pool are merged, so a snapshot is cheap enough to take on every
+    /// scrape of a metrics endpoint.
+    ///
+    /// @return The latencies recorded since the pool was created, or none if they are not recorded.
+    ///
+    std::vector<events::command_latency> command_latencies() const;
+
+    ///
+    /// Returns the most recent slow commands run by the clients of the pool, oldest first.
+    ///
+    /// Slow commands are only kept if the pool was created with
+    /// options::apm::record_slow_commands() set in its client options.
+    ///
+    /// @return The slow commands kept, or none if they are not recorded.
+    ///
+    std::vector<events::slow_command> slow_commands() const;
+
+    ///
+    /// Takes a snapshot of the counts of the commands run by the clients of the pool against
+    /// each collection.
+    ///
+    /// Commands are only counted if the pool was created with
+    /// options::apm::record_namespace_stats() set in its client options. The counts of all the
+    /// threads using the pool are merged, so a snapshot is cheap enough to take on every scrape of
+    /// a metrics endpoint.
+    ///
+    /// @return The counts since the pool was created, sorted by namespace, or none if they are not
+    ///   recorded.
+    ///
+    std::vector<events::namespace_stats> namespace_stats() const;
+
+    ///
+    /// Returns the filter shapes run by the clients of the pool against each collection, most
+    /// frequent first.
+    ///
+    /// Shapes are only counted if the pool was created with options::apm::record_query_shapes()
+    /// set in its client options.
+    ///
+    /// @return The shapes counted, or none if they are not recorded.
+    ///
+    /// @see mongocxx::unindexed_query_shapes()
+    ///
+    std::vector<events::query_shape> query_shapes() const;
+
+    ///
+    /// Takes a snapshot of what server selection knows about the deployment: the servers, their
+    /// round trip times, and the width of the latency window.
+    ///
+    /// Each server also reports how many commands the clients of the pool ran on it successfully,
+    /// if the pool was created with options::apm::record_command_latencies() set in its client
+    /// options.
+    ///
+    /// The clients of a pool share one topology, which is read through a client acquired for the
+    /// duration of the call, so this blocks like acquire() while the pool is exhausted.
+    ///
+    /// @return The current state of the topology of this pool.
+    ///
+    class topology_snapshot topology_snapshot();
+
+    ///
+    /// Gets the wire compression settings of this pool, the compressor each server agreed to, and
+    /// the bytes of the commands and replies that its clients subjected to compression, if the
+    /// pool was created with options::apm::record_command_bytes() set in its client options.
+    ///
+    /// Like topology_snapshot(), this reads the topology through a client acquired for the
+    /// duration of the call.
+    ///
+    /// @return The current compression statistics of this pool.
+    ///
+    class compression_statistics compression_statistics();
+
+    ///
+    /// Gets the number of command timings dropped because the queue of
+    /// options::apm::async_delivery() was full.
+    ///
+    /// @return The number of dropped command timings since the pool was created.
+    ///
+    std::uint64_t dropped_apm_events() const;
+
+    ///
+    /// Gets the bytes of replies buffered ahead of the application by the prefetching cursors and
+    /// change streams of every client of the pool.
+    ///
+    /// @return The bytes counted against options::client::max_buffered_reply_bytes().
+    ///
+    std::int64_t buffered_reply_bytes() const;
+
+    ///
+    /// Gets the executor that runs the background work of features using this pool.
+    ///
+    /// @return The executor set in options::pool::executor(), or else the executor of the
+    ///   instance.
+    ///
+    std::shared_ptr<class executor> executor() const;
+
    private:
     friend class options::auto_encryption;
 
     MONGOCXX_PRIVATE void _release(client* client);
 
+    MONGOCXX_PRIVATE entry _checkout(void* client_t, std::chrono::steady_clock::time_point start);
+    MONGOCXX_PRIVATE void _check_out_failed(
+        events::connection_check_out_failed_event::failure_reason reason,
+        std::chrono::steady_clock::time_point start);
+
+    MONGOCXX_PRIVATE void _warmup(std::int32_t min_connections);
+
+    MONGOCXX_PRIVATE client* _wrap(void* client_t);
+
     class MONGOCXX_PRIVATE impl;
     const std::unique_ptr<impl> _impl;
 };
@@ -0,0 +1,58 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/prepared_find.hpp>
+
+#include <utility>
+
+#include <mongocxx/collection.hpp>
+#include <mongocxx/private/prepared_find.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+prepared_find::prepared_find(std::unique_ptr<impl> implementation)
+    : _impl(std::move(implementation)) {}
+
+prepared_find::prepared_find(prepared_find&&) noexcept = default;
+prepared_find& prepared_find::operator=(prepared_find&&) noexcept = default;
+prepared_find::~prepared_find() = default;
+
+std::size_t prepared_find::parameter_count() const noexcept {
+    return _impl->names.size();
+}
+
+std::size_t prepared_find::parameter_index(stdx::string_view name) const {
+    return document_template::parameter_index(_impl->names, name);
+}
+
+cursor prepared_find::execute(const std::vector<bsoncxx::types::value>& values) {
+    document_template::check_values(_impl->names, values);
+    auto filter = _impl->filter.bind(values);
+    return _impl->collection._find_prepared(
+        nullptr, filter.view(), _impl->options_document.view(), _impl->options);
+}
+
+cursor prepared_find::execute(const client_session& session,
+                              const std::vector<bsoncxx::types::value>& values) {
+    document_template::check_values(_impl->names, values);
+    auto filter = _impl->filter.bind(values);
+    return _impl->collection._find_prepared(
+        &session, filter.view(), _impl->options_document.view(), _impl->options);
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
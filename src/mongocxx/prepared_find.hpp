@@ -0,0 +1,104 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class client_session;
+class collection;
+
+///
+/// A find whose filter and options are serialized once, created by collection::prepare_find().
+///
+/// Parameters are written in the filter as the placeholders returned by
+/// pipeline_template::parameter(). Each execution only binds their values into the frozen filter,
+/// as pipeline_template::bind() does, and reuses the options document, so neither is built again.
+///
+/// A prepared find uses a copy of the collection it was created from and, like a collection, must
+/// not be used by several threads at once.
+///
+class MONGOCXX_API prepared_find {
+   public:
+    prepared_find(prepared_find&&) noexcept;
+    prepared_find& operator=(prepared_find&&) noexcept;
+
+    ~prepared_find();
+
+    ///
+    /// @return The number of distinct parameters of the filter.
+    ///
+    std::size_t parameter_count() const noexcept;
+
+    ///
+    /// Returns the position of a parameter's value in the argument of execute(). Parameters are
+    /// numbered in the order of their first occurrence in the filter.
+    ///
+    /// @throws mongocxx::logic_error if the filter has no parameter named `name`.
+    ///
+    std::size_t parameter_index(stdx::string_view name) const;
+
+    ///
+    /// Runs the find with the given parameter values.
+    ///
+    /// @param values
+    ///   The value of each parameter, in the order given by parameter_index().
+    ///
+    /// @return A mongocxx::cursor with the results, as returned by collection::find().
+    ///
+    /// @throws mongocxx::logic_error if the number of values is not parameter_count().
+    ///
+    cursor execute(const std::vector<bsoncxx::types::value>& values);
+
+    ///
+    /// Runs the find with the given parameter values as part of a session.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the query.
+    /// @param values
+    ///   The value of each parameter, in the order given by parameter_index().
+    ///
+    /// @return A mongocxx::cursor with the results, as returned by collection::find().
+    ///
+    /// @throws mongocxx::logic_error if the number of values is not parameter_count().
+    ///
+    cursor execute(const client_session& session,
+                   const std::vector<bsoncxx::types::value>& values);
+
+   private:
+    friend class collection;
+
+    class MONGOCXX_PRIVATE impl;
+
+    MONGOCXX_PRIVATE explicit prepared_find(std::unique_ptr<impl> implementation);
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
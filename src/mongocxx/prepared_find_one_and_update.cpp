@@ -0,0 +1,131 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/prepared_find_one_and_update.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <mongocxx/collection.hpp>
+#include <mongocxx/private/libbson.hh>
+#include <mongocxx/private/prepared_find_one_and_update.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+void destroy_fam_opts(mongoc_find_and_modify_opts_t* opts) {
+    libmongoc::find_and_modify_opts_destroy(opts);
+}
+
+}  // namespace
+
+prepared_find_one_and_update::prepared_find_one_and_update(std::unique_ptr<impl> implementation)
+    : _impl(std::move(implementation)) {}
+
+prepared_find_one_and_update::prepared_find_one_and_update(
+    prepared_find_one_and_update&&) noexcept = default;
+prepared_find_one_and_update& prepared_find_one_and_update::operator=(
+    prepared_find_one_and_update&&) noexcept = default;
+prepared_find_one_and_update::~prepared_find_one_and_update() = default;
+
+std::size_t prepared_find_one_and_update::parameter_count() const noexcept {
+    return _impl->names.size();
+}
+
+std::size_t prepared_find_one_and_update::parameter_index(stdx::string_view name) const {
+    return document_template::parameter_index(_impl->names, name);
+}
+
+stdx::optional<bsoncxx::document::value> prepared_find_one_and_update::execute(
+    const std::vector<bsoncxx::types::value>& values) {
+    document_template::check_values(_impl->names, values);
+    auto filter = _impl->filter.bind(values);
+    auto update = _impl->update.bind(values);
+    return _impl->collection._find_one_and_update_prepared(
+        nullptr, _impl.get(), filter.view(), update.view());
+}
+
+stdx::optional<bsoncxx::document::value> prepared_find_one_and_update::execute(
+    const client_session& session, const std::vector<bsoncxx::types::value>& values) {
+    document_template::check_values(_impl->names, values);
+    auto filter = _impl->filter.bind(values);
+    auto update = _impl->update.bind(values);
+    return _impl->collection._find_one_and_update_prepared(
+        &session, _impl.get(), filter.view(), update.view());
+}
+
+mongoc_find_and_modify_opts_t* prepared_find_one_and_update::impl::opts_for(
+    stdx::optional<bsoncxx::document::view> session_document) {
+    if (!session_document) {
+        if (!_opts) {
+            _opts = make_opts(stdx::nullopt);
+        }
+        return _opts.get();
+    }
+
+    const auto same_session =
+        _session_opts && _session_document.view().length() == session_document->length() &&
+        std::memcmp(_session_document.view().data(),
+                    session_document->data(),
+                    session_document->length()) == 0;
+    if (!same_session) {
+        _session_opts = make_opts(session_document);
+        _session_document = bsoncxx::document::value{*session_document};
+    }
+    return _session_opts.get();
+}
+
+prepared_find_one_and_update::impl::unique_opts prepared_find_one_and_update::impl::make_opts(
+    stdx::optional<bsoncxx::document::view> session_document) const {
+    unique_opts opts{libmongoc::find_and_modify_opts_new(), destroy_fam_opts};
+
+    libbson::scoped_bson_t extra_bson{_options.extra.view()};
+    libmongoc::find_and_modify_opts_append(opts.get(), extra_bson.bson());
+
+    if (session_document) {
+        libbson::scoped_bson_t session_bson{*session_document};
+        libmongoc::find_and_modify_opts_append(opts.get(), session_bson.bson());
+    }
+
+    if (_options.bypass_document_validation) {
+        libmongoc::find_and_modify_opts_set_bypass_document_validation(opts.get(), true);
+    }
+
+    if (_options.sort) {
+        libbson::scoped_bson_t sort_bson{_options.sort->view()};
+        libmongoc::find_and_modify_opts_set_sort(opts.get(), sort_bson.bson());
+    }
+
+    if (_options.projection) {
+        libbson::scoped_bson_t projection_bson{_options.projection->view()};
+        libmongoc::find_and_modify_opts_set_fields(opts.get(), projection_bson.bson());
+    }
+
+    if (_options.max_time) {
+        libmongoc::find_and_modify_opts_set_max_time_ms(
+            opts.get(), static_cast<std::uint32_t>(_options.max_time->count()));
+    }
+
+    libmongoc::find_and_modify_opts_set_flags(opts.get(), _options.flags);
+
+    return opts;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,117 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class client_session;
+class collection;
+
+///
+/// A find_one_and_update whose filter, update and options are serialized once, created by
+/// collection::prepare_find_one_and_update().
+///
+/// Parameters are written in the filter and the update as the placeholders returned by
+/// pipeline_template::parameter(), and are bound as for a prepared_update_one. The libmongoc
+/// options of the findAndModify command, which hold its sort, projection, write concern and other
+/// fields, are built once and reused by every execution, which suits a find_one_and_update run at
+/// a high rate, such as the dequeue of a job queue.
+///
+/// A prepared find_one_and_update uses a copy of the collection it was created from and, like a
+/// collection, must not be used by several threads at once.
+///
+class MONGOCXX_API prepared_find_one_and_update {
+   public:
+    prepared_find_one_and_update(prepared_find_one_and_update&&) noexcept;
+    prepared_find_one_and_update& operator=(prepared_find_one_and_update&&) noexcept;
+
+    ~prepared_find_one_and_update();
+
+    ///
+    /// @return The number of distinct parameters of the filter and the update.
+    ///
+    std::size_t parameter_count() const noexcept;
+
+    ///
+    /// Returns the position of a parameter's value in the argument of execute(). Parameters are
+    /// numbered in the order of their first occurrence in the filter, then in the update.
+    ///
+    /// @throws mongocxx::logic_error if there is no parameter named `name`.
+    ///
+    std::size_t parameter_index(stdx::string_view name) const;
+
+    ///
+    /// Runs the find_one_and_update with the given parameter values.
+    ///
+    /// @param values
+    ///   The value of each parameter, in the order given by parameter_index().
+    ///
+    /// @return The original or updated document, as returned by
+    ///   collection::find_one_and_update().
+    ///
+    /// @throws
+    ///   mongocxx::logic_error if the number of values is not parameter_count().
+    ///   mongocxx::write_exception if the operation fails.
+    ///
+    stdx::optional<bsoncxx::document::value> execute(
+        const std::vector<bsoncxx::types::value>& values);
+
+    ///
+    /// Runs the find_one_and_update with the given parameter values as part of a session.
+    ///
+    /// The options are rebuilt when the session differs from that of the previous execution.
+    ///
+    /// @param session
+    ///   The mongocxx::client_session with which to perform the operation.
+    /// @param values
+    ///   The value of each parameter, in the order given by parameter_index().
+    ///
+    /// @return The original or updated document, as returned by
+    ///   collection::find_one_and_update().
+    ///
+    /// @throws
+    ///   mongocxx::logic_error if the number of values is not parameter_count().
+    ///   mongocxx::write_exception if the operation fails.
+    ///
+    stdx::optional<bsoncxx::document::value> execute(
+        const client_session& session, const std::vector<bsoncxx::types::value>& values);
+
+   private:
+    friend class collection;
+
+    class MONGOCXX_PRIVATE impl;
+
+    MONGOCXX_PRIVATE explicit prepared_find_one_and_update(std::unique_ptr<impl> implementation);
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
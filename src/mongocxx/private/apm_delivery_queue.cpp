@@ -0,0 +1,137 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/apm_delivery_queue.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+constexpr std::size_t apm_delivery_queue::k_max_command_name_length;
+constexpr std::size_t apm_delivery_queue::k_max_host_length;
+
+apm_delivery_queue::apm_delivery_queue(std::size_t capacity,
+                                       options::apm::command_timing_fn callback,
+                                       void* callback_context)
+    : _callback{callback}, _callback_context{callback_context}, _ring{capacity} {
+    try {
+        _thread = std::thread{[this] { run(); }};
+    } catch (const std::system_error&) {
+        // Without a delivery thread, push() delivers timings inline.
+    }
+}
+
+apm_delivery_queue::~apm_delivery_queue() {
+    if (!_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping.store(true, std::memory_order_release);
+    }
+    _wakeup.notify_one();
+    _thread.join();
+}
+
+void apm_delivery_queue::push(const events::command_timing& timing) {
+    if (!_thread.joinable()) {
+        _callback(timing, _callback_context);
+        return;
+    }
+
+    std::size_t position;
+    auto target = _ring.try_claim(&position);
+    if (!target) {
+        // The delivery thread has not yet consumed the cell a full lap ago.
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    target->request_id = timing.request_id;
+    target->duration = timing.duration;
+    target->port = timing.port;
+    target->succeeded = timing.succeeded;
+    target->command_name_length = std::min(timing.command_name.size(), k_max_command_name_length);
+    std::memcpy(target->command_name, timing.command_name.data(), target->command_name_length);
+    target->host_length = std::min(timing.host.size(), k_max_host_length);
+    std::memcpy(target->host, timing.host.data(), target->host_length);
+    _ring.publish(position);
+
+    if (_waiting.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _wakeup.notify_one();
+    }
+}
+
+std::uint64_t apm_delivery_queue::dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+bool apm_delivery_queue::pop() {
+    auto source = _ring.front();
+    if (!source) {
+        return false;
+    }
+
+    events::command_timing timing{
+        source->request_id,
+        stdx::string_view{source->command_name, source->command_name_length},
+        source->duration,
+        stdx::string_view{source->host, source->host_length},
+        source->port,
+        source->succeeded};
+
+    try {
+        _callback(timing, _callback_context);
+    } catch (...) {
+        // There is no operation to report the error to; keep delivering the others.
+    }
+
+    _ring.pop_front();
+    return true;
+}
+
+void apm_delivery_queue::run() {
+    for (;;) {
+        while (pop()) {
+        }
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        if (_stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        // A push racing with this check may not see _waiting set, so the wait is bounded rather
+        // than relying on its notification.
+        _waiting.store(true, std::memory_order_seq_cst);
+        if (!_ring.front()) {
+            _wakeup.wait_for(lock, std::chrono::milliseconds{10});
+        }
+        _waiting.store(false, std::memory_order_relaxed);
+    }
+
+    // Deliver what was pushed before the queue was stopped.
+    while (pop()) {
+    }
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
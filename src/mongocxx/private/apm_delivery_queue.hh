@@ -0,0 +1,98 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <mongocxx/events/command_timing.hpp>
+#include <mongocxx/options/apm.hpp>
+#include <mongocxx/private/mpsc_ring.hh>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Delivers command timings to the callback of options::apm::on_command_timing() on a dedicated
+// thread, for options::apm::async_delivery().
+//
+// The operation threads copy each timing into a cell of an mpsc_ring, so that pushing never
+// blocks. A timing that finds the buffer full is counted as dropped. The delivery thread drains
+// the buffer and sleeps when it is empty.
+//
+class MONGOCXX_TEST_API apm_delivery_queue {
+   public:
+    // Longer command names and host names are truncated.
+    static constexpr std::size_t k_max_command_name_length = 64;
+    static constexpr std::size_t k_max_host_length = 255;
+
+    // `capacity` is rounded up to a power of two. If the delivery thread cannot be started,
+    // timings are delivered inline by push().
+    apm_delivery_queue(std::size_t capacity,
+                       options::apm::command_timing_fn callback,
+                       void* callback_context);
+
+    apm_delivery_queue(const apm_delivery_queue&) = delete;
+    apm_delivery_queue& operator=(const apm_delivery_queue&) = delete;
+
+    // Delivers the timings left in the buffer, then stops the delivery thread.
+    ~apm_delivery_queue();
+
+    void push(const events::command_timing& timing);
+
+    // The number of timings dropped because the buffer was full.
+    std::uint64_t dropped() const;
+
+   private:
+    struct cell {
+        std::int64_t request_id;
+        std::int64_t duration;
+        std::uint16_t port;
+        bool succeeded;
+        std::size_t command_name_length;
+        std::size_t host_length;
+        char command_name[k_max_command_name_length];
+        char host[k_max_host_length];
+    };
+
+    bool pop();
+
+    void run();
+
+    const options::apm::command_timing_fn _callback;
+    void* const _callback_context;
+
+    mpsc_ring<cell> _ring;
+    std::atomic<std::uint64_t> _dropped{0};
+
+    std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::atomic<bool> _waiting{false};
+    std::atomic<bool> _stopping{false};
+    std::thread _thread;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,70 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <mongocxx/async_collection.hpp>
+#include <mongocxx/pool.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class async_collection::impl {
+   public:
+    impl(class pool* pool, std::string database, std::string collection, std::size_t workers);
+
+    // Runs the tasks left in the queue on the calling thread and waits for the running drains.
+    ~impl();
+
+    void enqueue(task task);
+
+   private:
+    // The queue, shared with the drains submitted to the executor, which may only start once the
+    // async_collection is destroyed and then find the queue empty.
+    struct queue {
+        class pool* pool;
+        std::string database;
+        std::string collection;
+
+        std::mutex mutex;
+        std::condition_variable idle;
+        std::deque<task> tasks;
+
+        // The drains submitted and not yet returned, and those of them that have started.
+        std::size_t scheduled = 0;
+        std::size_t running = 0;
+    };
+
+    // Runs the queued tasks with a client of the pool until the queue is empty. `lock` holds the
+    // queue's mutex on entry and on return.
+    static void drain(queue& queue, std::unique_lock<std::mutex>& lock);
+
+    const std::shared_ptr<queue> _queue;
+    const std::shared_ptr<class executor> _executor;
+    std::size_t _max_drains;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,84 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <mongocxx/async_logger.hpp>
+#include <mongocxx/private/mpsc_ring.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// The logging threads copy each message into a cell of an mpsc_ring, so that logging never waits
+// for the sink.
+//
+class async_logger::impl {
+   public:
+    static constexpr std::size_t k_max_domain_length = 64;
+    static constexpr std::size_t k_max_message_length = 1024;
+
+    impl(std::unique_ptr<logger> sink, log_level max_level, std::size_t capacity);
+
+    ~impl();
+
+    void push(log_level level, stdx::string_view domain, stdx::string_view message) noexcept;
+
+    void flush();
+
+    const std::unique_ptr<logger> sink;
+    const log_level max_level;
+    std::atomic<std::uint64_t> dropped{0};
+
+   private:
+    struct cell {
+        log_level level;
+        std::size_t domain_length;
+        std::size_t message_length;
+        char domain[k_max_domain_length];
+        char message[k_max_message_length];
+    };
+
+    bool pop();
+    void report_dropped();
+    void run();
+
+    mpsc_ring<cell> _ring;
+    std::uint64_t _reported_dropped = 0;
+
+    // Serializes calls to the sink when there is no background thread.
+    std::mutex _inline_mutex;
+
+    std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::condition_variable _drained;
+    std::atomic<bool> _waiting{false};
+    std::atomic<bool> _stopping{false};
+    std::thread _thread;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,104 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/batch.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/index_model.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/options/index_view.hpp>
+#include <mongocxx/options/insert.hpp>
+#include <mongocxx/result/insert_one.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class batch::impl {
+   public:
+    enum class kind { k_find_one, k_insert_one, k_create_indexes };
+
+    struct operation {
+        operation(kind type,
+                  std::string database,
+                  std::string collection,
+                  bsoncxx::document::value document)
+            : type(type),
+              database(std::move(database)),
+              collection(std::move(collection)),
+              document(std::move(document)) {}
+
+        kind type;
+        std::string database;
+        std::string collection;
+
+        // The filter of a find_one, or the document of an insert_one.
+        bsoncxx::document::value document;
+        options::find find_options;
+        options::insert insert_options;
+        std::vector<index_model> indexes;
+        options::index_view index_options;
+
+        bool executed = false;
+        std::exception_ptr error;
+        stdx::optional<bsoncxx::document::value> found;
+        stdx::optional<result::insert_one> inserted;
+        stdx::optional<bsoncxx::document::value> created;
+
+        void run(class collection& coll);
+    };
+
+    impl(class pool* pool, std::size_t max_connections)
+        : pool(pool), max_connections(max_connections) {}
+
+    // Runs pending operations, claiming them one at a time through `next`, on one client checked
+    // out for as long as any remain. Returns the error of acquiring that client, if any.
+    std::exception_ptr drain(const std::vector<operation*>& pending,
+                             std::atomic<std::size_t>* next);
+
+    const operation& executed(std::size_t index, kind type) const;
+
+    // Reports the progress of the index builds of the pending operations every progress_interval,
+    // until `finished` is set.
+    void poll_index_progress(const std::vector<operation*>& pending,
+                             std::mutex* mutex,
+                             std::condition_variable* changed,
+                             const bool* finished);
+
+    class pool* pool;
+    std::size_t max_connections;
+    std::vector<operation> operations;
+
+    index_progress_fn progress_callback;
+    std::chrono::milliseconds progress_interval{0};
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
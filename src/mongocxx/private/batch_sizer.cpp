@@ -0,0 +1,90 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/batch_sizer.hh>
+
+#include <algorithm>
+#include <limits>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// An adaptive cursor caps its batches at the largest reply the server sends when no byte budget
+// is set, and never shrinks them below this many documents.
+constexpr std::uint64_t k_max_reply_bytes = 16 * 1024 * 1024;
+constexpr std::int64_t k_min_adaptive_batch_size = 16;
+
+}  // namespace
+
+batch_sizer::batch_sizer(std::int32_t initial, std::int32_t max_bytes, bool adaptive)
+    : _batch_size(std::max(initial, std::int32_t{1})), _max_bytes(max_bytes), _adaptive(adaptive) {}
+
+std::int32_t batch_sizer::batch_size() const {
+    return _batch_size;
+}
+
+void batch_sizer::consumed(std::chrono::nanoseconds duration) {
+    _consuming += duration;
+}
+
+bool batch_sizer::record(std::size_t length, std::chrono::nanoseconds fetch) {
+    ++_documents;
+    _bytes += length;
+    _fetching += fetch;
+    if (_documents < _batch_size) {
+        return false;
+    }
+
+    std::int64_t size = _batch_size;
+    if (_adaptive) {
+        // While the application waits on round trips for a third of the time or more, fewer and
+        // larger batches pay off. Once they are a small fraction of its time, smaller batches hold
+        // less memory at little cost.
+        if (_fetching * 2 > _consuming) {
+            size *= 2;
+        } else if (_fetching * 16 < _consuming) {
+            size /= 2;
+        }
+        size = std::max(size, k_min_adaptive_batch_size);
+    }
+
+    const std::uint64_t budget = _max_bytes > 0 ? static_cast<std::uint64_t>(_max_bytes)
+                                                : (_adaptive ? k_max_reply_bytes : 0);
+    if (budget > 0) {
+        const std::uint64_t mean =
+            std::max(_bytes / static_cast<std::uint64_t>(_documents), std::uint64_t{1});
+        const auto by_bytes =
+            static_cast<std::int64_t>(std::max(budget / mean, std::uint64_t{1}));
+        size = _adaptive ? std::min(size, by_bytes) : by_bytes;
+    }
+    size = std::min(size, static_cast<std::int64_t>(std::numeric_limits<std::int32_t>::max()));
+
+    _documents = 0;
+    _bytes = 0;
+    _fetching = std::chrono::nanoseconds{0};
+    _consuming = std::chrono::nanoseconds{0};
+
+    if (size == _batch_size) {
+        return false;
+    }
+    _batch_size = static_cast<std::int32_t>(size);
+    return true;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,70 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Picks the batch size of a cursor's getMore commands from the documents it has returned; see
+// options::find::max_batch_bytes() and options::find::adaptive_batch_size(). Every batch_size()
+// documents, it re-estimates the size from the mean document length and, if adaptive, from how
+// the time since the last estimate divided between fetching and consuming documents.
+//
+class MONGOCXX_TEST_API batch_sizer {
+   public:
+    //
+    // Starts at `initial` documents per batch. A positive `max_bytes` caps batches at about that
+    // many bytes, and is otherwise ignored.
+    //
+    batch_sizer(std::int32_t initial, std::int32_t max_bytes, bool adaptive);
+
+    std::int32_t batch_size() const;
+
+    //
+    // Adds time the application spent between taking a document and asking for the next one.
+    //
+    void consumed(std::chrono::nanoseconds duration);
+
+    //
+    // Records a document of `length` bytes that took `fetch` to get from the cursor. Returns true
+    // if this completes an estimate and changes batch_size().
+    //
+    bool record(std::size_t length, std::chrono::nanoseconds fetch);
+
+   private:
+    std::int32_t _batch_size;
+    const std::int32_t _max_bytes;
+    const bool _adaptive;
+
+    // Since the last estimate.
+    std::int32_t _documents = 0;
+    std::uint64_t _bytes = 0;
+    std::chrono::nanoseconds _fetching{0};
+    std::chrono::nanoseconds _consuming{0};
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,114 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/buffered_writer.hpp>
+#include <mongocxx/model/write.hpp>
+#include <mongocxx/private/mpsc_ring.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class buffered_writer::impl {
+   public:
+    // A queued write, together with the promise that reports its outcome. Only the promise
+    // matching the type of the write is set; a posted insert has neither, so that queueing it
+    // allocates no shared state.
+    struct request {
+        explicit request(model::write write) : write(std::move(write)) {}
+
+        bool posted() const {
+            return !inserted && !updated;
+        }
+
+        model::write write;
+        // For an insert, a document holding the _id of the inserted document.
+        bsoncxx::document::value id{bsoncxx::document::view{}};
+        std::unique_ptr<std::promise<stdx::optional<result::insert_one>>> inserted;
+        std::unique_ptr<std::promise<void>> updated;
+    };
+
+    impl(class pool* pool,
+         std::string database,
+         std::string collection,
+         std::size_t max_batch_size,
+         std::chrono::milliseconds max_delay,
+         std::size_t capacity);
+
+    ~impl();
+
+    void push(std::unique_ptr<request> queued);
+
+    void flush();
+
+   private:
+    struct cell {
+        std::unique_ptr<request> queued;
+    };
+
+    std::unique_ptr<request> pop();
+    void run();
+
+    // Takes the posted inserts out of `batch` and sends them as one unordered, unacknowledged bulk
+    // write, ignoring any error.
+    void write_posted(std::vector<std::unique_ptr<request>>* batch);
+
+    // Sends `batch` as one ordered bulk write and resolves the futures of the writes that were
+    // attempted. The writes that follow a failed write are left in `batch` to be sent again.
+    void write(std::vector<std::unique_ptr<request>>* batch);
+
+    void succeed(request* sent, bool acknowledged);
+    void fail(request* sent, std::exception_ptr error);
+
+    class pool* const _pool;
+    const std::string _database;
+    const std::string _collection;
+    const std::size_t _max_batch_size;
+    const std::chrono::milliseconds _max_delay;
+
+    mpsc_ring<cell> _ring;
+
+    // The number of writes whose futures are ready, and the number that flush() waits for.
+    std::atomic<std::size_t> _completed{0};
+    std::atomic<std::size_t> _flush_target{0};
+
+    std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::condition_variable _space;
+    std::condition_variable _drained;
+    std::atomic<bool> _waiting{false};
+    std::atomic<bool> _stopping{false};
+    std::thread _thread;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
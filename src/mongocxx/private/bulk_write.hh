@@ -14,8 +14,18 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
 #include <mongocxx/bulk_write.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/pool.hpp>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/shard_router.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -28,9 +38,88 @@ class bulk_write::impl {
 
     ~impl() {
         libmongoc::bulk_operation_destroy(operation_t);
+        for (auto&& shard : shards) {
+            libmongoc::bulk_operation_destroy(shard.operation_t);
+        }
+    }
+
+    // A sub-batch of a parallel bulk write, bound to its own pooled client.
+    struct shard {
+        pool::entry client;
+        class collection collection;
+        mongoc_bulk_operation_t* operation_t;
+    };
+
+    // The number of sub-batches appended writes are distributed across.
+    std::size_t num_operations() const {
+        return shards.size() + 1;
+    }
+
+    bool is_partitioned() const {
+        return static_cast<bool>(router);
+    }
+
+    // The sub-batch that receives the next write. `target` is the document of an insert, or the
+    // filter of another write if `is_filter`. Writes of a parallel bulk write are dealt out
+    // round-robin, so the i-th write of sub-batch k was appended at position
+    // i * num_operations() + k. A shard-partitioned bulk write sends each write to the sub-batch of
+    // its shard, created on first use, or to sub-batch 0 if its shard is unknown.
+    std::size_t sub_batch_for(bsoncxx::document::view target, bool is_filter) {
+        if (!router) {
+            return appended % num_operations();
+        }
+
+        const auto shard =
+            is_filter ? router->shard_for_filter(target) : router->shard_for_document(target);
+        if (shard == shard_router::k_unknown) {
+            return 0;
+        }
+        if (shard_sub_batches[shard] == 0) {
+            shards.push_back(create_sub_batch());
+            positions.emplace_back();
+            shard_sub_batches[shard] = shards.size();
+        }
+        return shard_sub_batches[shard];
+    }
+
+    mongoc_bulk_operation_t* operation(std::size_t k) const {
+        return k == 0 ? operation_t : shards[k - 1].operation_t;
+    }
+
+    // Records that a write was appended to sub-batch k.
+    void appended_to(std::size_t k) {
+        if (router) {
+            positions[k].push_back(static_cast<std::int32_t>(appended));
+        }
+        appended++;
     }
 
+    // Sub-batch 0, created on the collection the bulk write was created from.
     mongoc_bulk_operation_t* operation_t;
+
+    // The remaining sub-batches of a parallel bulk write; empty otherwise.
+    std::vector<shard> shards;
+
+    // The executor of the pool of the sub-batches, which runs them alongside the calling thread.
+    std::shared_ptr<class executor> executor;
+
+    // Acquires a client from the pool of the sub-batches and creates a sub-batch on it.
+    std::function<shard()> create_sub_batch;
+
+    // The routing table of a shard-partitioned bulk write; null otherwise.
+    std::shared_ptr<const shard_router> router;
+
+    // For a shard-partitioned bulk write: the sub-batch of each shard of the router, or 0 while
+    // it has none, and the positions at which the writes of each sub-batch were appended.
+    std::vector<std::size_t> shard_sub_batches;
+    std::vector<std::vector<std::int32_t>> positions;
+
+    // The number of writes appended so far.
+    std::size_t appended = 0;
+
+    // Reused by append() to build the options of each write, so that its buffer is allocated once
+    // per bulk write rather than once per operation.
+    bsoncxx::builder::basic::document options_scratch;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
@@ -0,0 +1,124 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/cached_collection.hpp>
+#include <mongocxx/change_stream.hpp>
+#include <mongocxx/options/collection_cache.hpp>
+#include <mongocxx/pool.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class cached_collection::impl {
+   public:
+    using clock = std::chrono::steady_clock;
+
+    struct entry {
+        std::string key;
+        // Empty if the collection had no document with this _id.
+        stdx::optional<bsoncxx::document::value> document;
+        clock::time_point expires;
+    };
+
+    struct shard {
+        std::mutex mutex;
+        // Most recently used first.
+        std::list<entry> entries;
+        std::unordered_map<std::string, std::list<entry>::iterator> index;
+        // Bumped by every invalidation, so that a lookup that raced with one does not cache the
+        // document it read before the change.
+        std::uint64_t generation = 0;
+    };
+
+    impl(class pool* pool,
+         std::string database,
+         std::string collection,
+         const options::collection_cache& options);
+
+    // Stops the change stream thread, if any, and waits for it to exit.
+    ~impl();
+
+    // The cache key of an _id: the bytes of the document {"": id}, with integral numbers encoded
+    // as int64 so that an int32, int64 or double _id the server considers equal has the same key.
+    static std::string key_for(const bsoncxx::types::value& id);
+
+    // Whether key_for() gives every _id equal to `id` the same key. Decimal128 _ids can equal
+    // numbers of other types and are not normalized, so lookups by them are not cached.
+    static bool has_canonical_key(const bsoncxx::types::value& id);
+
+    shard& shard_for(const std::string& key);
+
+    stdx::optional<bsoncxx::document::value> find_one_by_id(const bsoncxx::types::value& id);
+
+    void invalidate(const std::string& key);
+    void clear();
+
+    // Checks out a client and opens the change stream on it.
+    void open_stream();
+
+    // The body of the change stream thread: applies events until the cache is destroyed,
+    // reopening the stream whenever it fails.
+    void watch();
+
+    // Invalidates the entries an event affects. Returns false if the stream was invalidated and
+    // must be reopened.
+    bool apply(const bsoncxx::document::view& event);
+
+    class pool* pool;
+    std::string database;
+    std::string collection;
+    std::size_t max_per_shard;
+    stdx::optional<clock::duration> ttl;
+    std::function<clock::time_point()> now;
+    std::vector<std::unique_ptr<shard>> shards;
+
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+
+    // Only touched by the change stream thread once it has started.
+    stdx::optional<pool::entry> stream_client;
+    stdx::optional<change_stream> stream;
+
+    std::mutex stop_mutex;
+    std::condition_variable stop_changed;
+    bool stopping = false;
+    std::thread watcher;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
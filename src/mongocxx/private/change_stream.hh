@@ -14,11 +14,25 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/change_stream.hpp>
+#include <mongocxx/exception/private/mongoc_error.hh>
+#include <mongocxx/exception/query_exception.hpp>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/reply_budget.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -43,6 +57,7 @@ class change_stream::impl {
     void operator=(impl&&) = delete;
 
     ~impl() {
+        stop_prefetch();
         libmongoc::change_stream_destroy(this->change_stream_);
     }
 
@@ -54,6 +69,10 @@ class change_stream::impl {
         return status_ == state::k_dead;
     }
 
+    bool is_prefetching() const {
+        return static_cast<bool>(prefetch_);
+    }
+
     bool is_exhausted() const {
         return exhausted_;
     }
@@ -74,34 +93,62 @@ class change_stream::impl {
         exhausted_ = false;
     }
 
-    void advance_iterator() {
+    // Throws query_exception if the stream failed, such as when its aggregate was rejected,
+    // without waiting for events.
+    void throw_if_failed() {
         const bson_t* out;
-
-        // Happy-case.
-        if (libmongoc::change_stream_next(this->change_stream_, &out)) {
-            this->doc_ = bsoncxx::document::view{bson_get_data(out), out->len};
-            return;
-        }
-
-        // Check for errors or just nothing left.
         bson_error_t error;
         if (libmongoc::change_stream_error_document(this->change_stream_, &error, &out)) {
-            this->mark_dead();
-            this->doc_ = bsoncxx::document::view{};
             mongocxx::libbson::scoped_bson_t scoped_error_reply{};
             bson_copy_to(out, scoped_error_reply.bson_for_init());
             throw_exception<query_exception>(scoped_error_reply.steal(), error);
         }
+    }
+
+    void advance_iterator() {
+        if (!this->next_event(&this->doc_)) {
+            this->mark_nothing_left();
+        }
+    }
+
+    // Reads the next event into out, returning false if there is none. The event is only valid
+    // until the stream is advanced again.
+    bool next_event(bsoncxx::document::view* out_event) {
+        if (this->is_prefetching()) {
+            return this->next_prefetched(out_event);
+        }
 
-        // Just nothing left.
-        this->mark_nothing_left();
+        try {
+            return this->read_event(out_event);
+        } catch (...) {
+            this->mark_dead();
+            throw;
+        }
     }
 
+    // Starts a background thread that keeps up to `max_batches` batches of the next events ready,
+    // read at most `batch_size` events at a time; see options::change_stream::prefetch_batches.
+    // The batches waiting to be consumed hold at most `max_bytes`, see
+    // options::change_stream::max_prefetched_bytes, and are counted against `budget`, if any.
+    // From then on the stream must only be read with next_event().
+    //
+    // Throws logic_error if `max_batches` or `max_bytes` is not positive.
+    void start_prefetch(std::int32_t max_batches,
+                        stdx::optional<std::int32_t> batch_size,
+                        stdx::optional<std::int64_t> max_bytes = {},
+                        std::shared_ptr<reply_budget> budget = {});
+
+    // Stops the background thread, if any, and waits for it to exit.
+    void stop_prefetch();
     bsoncxx::document::view& doc() {
         return this->doc_;
     }
 
     stdx::optional<bsoncxx::document::view> get_resume_token() {
+        if (this->is_prefetching()) {
+            return this->prefetch_->token;
+        }
+
         auto token = libmongoc::change_stream_get_resume_token(this->change_stream_);
         if (!token) {
             return {};
@@ -111,10 +158,81 @@ class change_stream::impl {
     }
 
    private:
+    // Reads the next event from change_stream_ without touching the state of the stream, so that
+    // the prefetching thread can use it. Throws query_exception if the stream failed.
+    bool read_event(bsoncxx::document::view* out_event) {
+        const bson_t* out;
+
+        // Happy-case.
+        if (libmongoc::change_stream_next(this->change_stream_, &out)) {
+            *out_event = bsoncxx::document::view{bson_get_data(out), out->len};
+            return true;
+        }
+
+        // Check for errors or just nothing left.
+        throw_if_failed();
+        return false;
+    }
+
+    // The events read by one pass of the prefetching thread, each followed by the resume token
+    // that was current after it. The documents are copied back to back into data.
+    struct prefetched_batch {
+        static constexpr std::size_t k_no_token = static_cast<std::size_t>(-1);
+
+        std::vector<std::uint8_t> data;
+        std::vector<std::size_t> events;
+        std::vector<std::size_t> tokens;
+
+        // Whether the pass ended because the stream had no event left, which the consumer has to
+        // see as well, and the resume token at that point.
+        bool ends_round = false;
+        std::size_t end_token = k_no_token;
+
+        std::size_t append(bsoncxx::document::view document);
+        bsoncxx::document::view at(std::size_t offset) const;
+    };
+
+    // The state shared between a prefetching stream and its background thread.
+    struct prefetch_state {
+        std::size_t max_batches;
+        std::size_t batch_size;
+
+        // The most bytes of batches waiting in `ready`, or 0 for no limit.
+        std::size_t max_ready_bytes = 0;
+
+        // The budget the batches in `ready` and `current` are counted against, if any.
+        std::shared_ptr<reply_budget> budget;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+
+        // Guarded by mutex.
+        std::deque<prefetched_batch> ready;
+        std::size_t ready_bytes = 0;
+        bool finished = false;
+        bool stopping = false;
+        std::exception_ptr error;
+
+        // Only used by the consuming thread: the batch the current event and token point into,
+        // and the resume token of the stream before the first batch.
+        prefetched_batch current;
+        std::size_t position = 0;
+        bool round_reported = false;
+        stdx::optional<bsoncxx::document::value> initial_token;
+        stdx::optional<bsoncxx::document::view> token;
+
+        std::thread thread;
+    };
+
+    void prefetch_loop();
+
+    bool next_prefetched(bsoncxx::document::view* out_event);
+
     mongoc_change_stream_t* const change_stream_;
     bsoncxx::document::view doc_;
     state status_;
     bool exhausted_;
+    std::unique_ptr<prefetch_state> prefetch_;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
@@ -0,0 +1,343 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/checksum.hh>
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MONGOCXX_CHECKSUM_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define MONGOCXX_CHECKSUM_ARM_CRC32
+#include <arm_acle.h>
+#endif
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace checksum {
+
+namespace {
+
+const char k_hex_digits[] = "0123456789abcdef";
+
+void append_hex(std::uint32_t word, std::string* out) {
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        out->push_back(k_hex_digits[(word >> shift) & 0xF]);
+    }
+}
+
+const std::uint32_t k_sha256_round_constants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+inline std::uint32_t rotate_right(std::uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline std::uint32_t load_big_endian(const std::uint8_t* p) {
+    return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) |
+           (std::uint32_t{p[2]} << 8) | std::uint32_t{p[3]};
+}
+
+void sha256_blocks_scalar(std::uint32_t* state, const std::uint8_t* blocks, std::size_t count) {
+    for (; count > 0; --count, blocks += 64) {
+        std::uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = load_big_endian(blocks + 4 * i);
+        }
+        for (int i = 16; i < 64; ++i) {
+            auto s0 = rotate_right(w[i - 15], 7) ^ rotate_right(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            auto s1 = rotate_right(w[i - 2], 17) ^ rotate_right(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+        auto e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            auto s1 = rotate_right(e, 6) ^ rotate_right(e, 11) ^ rotate_right(e, 25);
+            auto choose = (e & f) ^ (~e & g);
+            auto t1 = h + s1 + choose + k_sha256_round_constants[i] + w[i];
+            auto s0 = rotate_right(a, 2) ^ rotate_right(a, 13) ^ rotate_right(a, 22);
+            auto majority = (a & b) ^ (a & c) ^ (b & c);
+            auto t2 = s0 + majority;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if defined(MONGOCXX_CHECKSUM_X86)
+__attribute__((target("sha,sse4.1"))) void sha256_blocks_shani(std::uint32_t* state,
+                                                               const std::uint8_t* blocks,
+                                                               std::size_t count) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA instructions keep the state as the word pairs ABEF and CDGH.
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i*>(state)), 0xB1);
+    __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i*>(state + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+    for (; count > 0; --count, blocks += 64) {
+        const __m128i abef_saved = abef;
+        const __m128i cdgh_saved = cdgh;
+
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i) {
+            w[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * i)), byte_swap);
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            if (i >= 4) {
+                // Extend the message schedule by four words, reusing the oldest slot.
+                auto& next = w[i % 4];
+                next = _mm_sha256msg1_epu32(next, w[(i + 1) % 4]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) % 4], w[(i + 2) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, w[(i + 3) % 4]);
+            }
+
+            auto constants = reinterpret_cast<const __m128i*>(k_sha256_round_constants + 4 * i);
+            __m128i message = _mm_add_epi32(w[i % 4], _mm_loadu_si128(constants));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+        }
+
+        abef = _mm_add_epi32(abef, abef_saved);
+        cdgh = _mm_add_epi32(cdgh, cdgh_saved);
+    }
+
+    tmp = _mm_shuffle_epi32(abef, 0x1B);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+    abef = _mm_blend_epi16(tmp, cdgh, 0xF0);
+    cdgh = _mm_alignr_epi8(cdgh, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), abef);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), cdgh);
+}
+
+bool cpu_has_sha() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1)) {
+        return false;
+    }
+    if (__get_cpuid_max(0, nullptr) < 7) {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 29)) != 0;
+}
+#endif
+
+using sha256_blocks_fn = void (*)(std::uint32_t*, const std::uint8_t*, std::size_t);
+
+sha256_blocks_fn select_sha256_blocks() {
+#if defined(MONGOCXX_CHECKSUM_X86)
+    if (cpu_has_sha()) {
+        return sha256_blocks_shani;
+    }
+#endif
+    return sha256_blocks_scalar;
+}
+
+void sha256_blocks(std::uint32_t* state, const std::uint8_t* blocks, std::size_t count) {
+    static const sha256_blocks_fn compress = select_sha256_blocks();
+    compress(state, blocks, count);
+}
+
+struct crc32c_table {
+    crc32c_table() {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            auto crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+            }
+            entries[i] = crc;
+        }
+    }
+
+    std::uint32_t entries[256];
+};
+
+std::uint32_t crc32c_scalar(std::uint32_t crc, const std::uint8_t* p, std::size_t length) {
+    static const crc32c_table table;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc = table.entries[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(MONGOCXX_CHECKSUM_X86)
+__attribute__((target("sse4.2"))) std::uint32_t crc32c_sse42(std::uint32_t crc,
+                                                               const std::uint8_t* p,
+                                                               std::size_t length) {
+    std::size_t i = 0;
+#if defined(__x86_64__)
+    std::uint64_t crc64 = crc;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<std::uint32_t>(crc64);
+#endif
+    for (; i + 4 <= length; i += 4) {
+        std::uint32_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+    }
+    for (; i < length; ++i) {
+        crc = _mm_crc32_u8(crc, p[i]);
+    }
+    return crc;
+}
+#elif defined(MONGOCXX_CHECKSUM_ARM_CRC32)
+std::uint32_t crc32c_arm(std::uint32_t crc, const std::uint8_t* p, std::size_t length) {
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        crc = __crc32cd(crc, word);
+    }
+    for (; i < length; ++i) {
+        crc = __crc32cb(crc, p[i]);
+    }
+    return crc;
+}
+#endif
+
+using crc32c_fn = std::uint32_t (*)(std::uint32_t, const std::uint8_t*, std::size_t);
+
+crc32c_fn select_crc32c() {
+#if defined(MONGOCXX_CHECKSUM_X86)
+    if (__builtin_cpu_supports("sse4.2")) {
+        return crc32c_sse42;
+    }
+#elif defined(MONGOCXX_CHECKSUM_ARM_CRC32)
+    return crc32c_arm;
+#endif
+    return crc32c_scalar;
+}
+
+}  // namespace
+
+sha256::sha256()
+    : _state{0x6a09e667,
+             0xbb67ae85,
+             0x3c6ef372,
+             0xa54ff53a,
+             0x510e527f,
+             0x9b05688c,
+             0x1f83d9ab,
+             0x5be0cd19},
+      _block_length{0},
+      _length{0} {}
+
+void sha256::update(const std::uint8_t* bytes, std::size_t length) {
+    _length += length;
+
+    if (_block_length > 0) {
+        auto n = std::min(length, sizeof(_block) - _block_length);
+        std::memcpy(_block + _block_length, bytes, n);
+        _block_length += n;
+        bytes += n;
+        length -= n;
+        if (_block_length < sizeof(_block)) {
+            return;
+        }
+        sha256_blocks(_state, _block, 1);
+        _block_length = 0;
+    }
+
+    // Whole blocks are compressed straight from the caller's buffer.
+    auto blocks = length / 64;
+    if (blocks > 0) {
+        sha256_blocks(_state, bytes, blocks);
+        bytes += blocks * 64;
+        length -= blocks * 64;
+    }
+
+    std::memcpy(_block, bytes, length);
+    _block_length = length;
+}
+
+std::string sha256::hex_digest() {
+    const auto bit_length = _length * 8;
+
+    _block[_block_length++] = 0x80;
+    if (_block_length > 56) {
+        std::memset(_block + _block_length, 0, sizeof(_block) - _block_length);
+        sha256_blocks(_state, _block, 1);
+        _block_length = 0;
+    }
+    std::memset(_block + _block_length, 0, 56 - _block_length);
+    for (int i = 0; i < 8; ++i) {
+        _block[56 + i] = static_cast<std::uint8_t>(bit_length >> (56 - 8 * i));
+    }
+    sha256_blocks(_state, _block, 1);
+    _block_length = 0;
+
+    std::string digest;
+    digest.reserve(64);
+    for (auto word : _state) {
+        append_hex(word, &digest);
+    }
+    return digest;
+}
+
+void crc32c::update(const std::uint8_t* bytes, std::size_t length) {
+    static const crc32c_fn update_crc = select_crc32c();
+    _crc = update_crc(_crc, bytes, length);
+}
+
+std::uint32_t crc32c::value() const {
+    return ~_crc;
+}
+
+std::string crc32c::hex_digest() const {
+    std::string digest;
+    digest.reserve(8);
+    append_hex(value(), &digest);
+    return digest;
+}
+
+}  // namespace checksum
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
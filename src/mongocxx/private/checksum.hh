@@ -0,0 +1,74 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace checksum {
+
+//
+// Computes a SHA-256 digest incrementally. Blocks are compressed with the SHA extensions when the
+// CPU has them, and with portable code otherwise.
+//
+class MONGOCXX_TEST_API sha256 {
+   public:
+    sha256();
+
+    void update(const std::uint8_t* bytes, std::size_t length);
+
+    //
+    // Finishes the digest and returns it as lowercase hexadecimal. No more bytes may be added.
+    //
+    std::string hex_digest();
+
+   private:
+    std::uint32_t _state[8];
+    std::uint8_t _block[64];
+    std::size_t _block_length;
+    std::uint64_t _length;
+};
+
+//
+// Computes a CRC-32C (Castagnoli) checksum incrementally, with the CRC32 instructions of SSE 4.2
+// or ARMv8 when available, and with a lookup table otherwise.
+//
+class MONGOCXX_TEST_API crc32c {
+   public:
+    void update(const std::uint8_t* bytes, std::size_t length);
+
+    std::uint32_t value() const;
+
+    //
+    // Returns the checksum as eight lowercase hexadecimal digits.
+    //
+    std::string hex_digest() const;
+
+   private:
+    std::uint32_t _crc = 0xFFFFFFFF;
+};
+
+}  // namespace checksum
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -14,10 +14,22 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <mongocxx/client.hpp>
+#include <mongocxx/gridfs/private/index_cache.hh>
+#include <mongocxx/options/private/apm_context.hh>
+#include <mongocxx/private/count_cache.hh>
+#include <mongocxx/private/group_commit.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/reply_budget.hh>
+#include <mongocxx/private/stream_initiator.hh>
 #include <mongocxx/private/write_concern.hh>
 
 #include <mongocxx/config/private/prelude.hh>
@@ -29,13 +41,54 @@ class client::impl {
    public:
     impl(mongoc_client_t* client) : client_t(client) {}
 
-    ~impl() {
-        libmongoc::client_destroy(client_t);
-    }
+    ~impl();
 
     mongoc_client_t* client_t;
     std::list<bsoncxx::string::view_or_value> tls_options;
-    options::apm listeners;
+    options::apm_context apm;
+
+    // For a client not from a pool, applies its socket options and stream initiator.
+    std::unique_ptr<stream_initiator> streams;
+
+    // For a client acquired from a pool, when it was acquired and how long acquiring it took.
+    std::chrono::steady_clock::time_point checked_out_at;
+    std::chrono::nanoseconds checkout_wait_time{0};
+
+    // The most ended sessions kept in idle_sessions.
+    static constexpr std::size_t k_max_idle_sessions = 8;
+
+    // The objects behind ended client_sessions, reused by the next start_session calls so that a
+    // session per operation does not allocate one each time. They hold no libmongoc session while
+    // idle; libmongoc pools the server sessions themselves.
+    mutable std::vector<std::unique_ptr<client_session::impl>> idle_sessions;
+
+    // The handles returned by client::database_handle() and client::collection_handle(), keyed by
+    // database name and by namespace. Lookups build their key in handle_key, whose buffer is
+    // reused, so that a lookup of a cached handle does not allocate.
+    mutable std::unordered_map<std::string, std::unique_ptr<class database>> database_handles;
+    mutable std::unordered_map<std::string, std::unique_ptr<class collection>> collection_handles;
+    mutable std::string handle_key;
+
+    // The GridFS buckets whose indexes have been verified. A client acquired from a pool shares
+    // the cache of the pool.
+    std::shared_ptr<gridfs::index_cache> gridfs_indexes = std::make_shared<gridfs::index_cache>();
+
+    // The counts run with a cache TTL. A client acquired from a pool shares the cache of the pool.
+    std::shared_ptr<count_cache> counts = std::make_shared<count_cache>();
+
+    // The inserts grouped by options::insert::group_commit. A client acquired from a pool shares
+    // the groups of the pool, so that inserts through any of its clients are grouped together.
+    std::shared_ptr<group_commit> group_commits = std::make_shared<group_commit>();
+
+    // The replies buffered by the prefetching cursors of the client. A client acquired from a pool
+    // shares the budget of the pool.
+    std::shared_ptr<reply_budget> replies = std::make_shared<reply_budget>();
+
+    // Destroys the cached handles, which hold libmongoc handles on client_t.
+    void clear_handles() {
+        collection_handles.clear();
+        database_handles.clear();
+    }
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
@@ -14,10 +14,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <exception>
+#include <random>
+#include <thread>
 
 #include <bsoncxx/private/helpers.hh>
 #include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/client_session.hpp>
 #include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/logic_error.hpp>
@@ -38,8 +44,39 @@ struct with_transaction_ctx {
     client_session* parent;
     client_session::with_transaction_cb cb;
     std::exception_ptr eptr;
+
+    // The retry settings of the transaction.
+    stdx::optional<std::chrono::milliseconds> backoff_initial;
+    stdx::optional<std::chrono::milliseconds> backoff_max;
+    stdx::optional<std::uint32_t> max_retries;
+
+    std::uint32_t attempts;
+    stdx::optional<bsoncxx::document::value> last_server_error;
+    client_session::with_transaction_statistics* stats;
 };
 
+// Sleeps before a retry of the callback for a random duration of up to the initial backoff doubled
+// once per earlier retry, capped at the maximum backoff ("full jitter").
+void with_transaction_backoff(with_transaction_ctx* ctx, std::uint32_t retry) {
+    if (!ctx->backoff_initial) {
+        return;
+    }
+
+    auto ceiling = ctx->backoff_max->count();
+    auto bound = ctx->backoff_initial->count();
+    for (std::uint32_t i = 1; i < retry && bound < ceiling; ++i) {
+        bound *= 2;
+    }
+    bound = std::min(bound, ceiling);
+
+    static thread_local std::minstd_rand generator{std::random_device{}()};
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution{0, bound};
+    std::chrono::milliseconds sleep{distribution(generator)};
+
+    std::this_thread::sleep_for(sleep);
+    ctx->stats->backoff_time += sleep;
+}
+
 // The callback we pass into libmongoc is a wrapped version of the
 // user callback. Before giving control back to libmongoc, we convert
 // any exception the user callback emits into an error_t and reply object;
@@ -50,11 +87,43 @@ bool with_transaction_cpp_cb(mongoc_client_session_t*,
                              bson_error_t* error) noexcept {
     with_transaction_ctx* cb_ctx = static_cast<with_transaction_ctx*>(ctx);
 
+    // libmongoc calls back once per attempt, so every call after the first is a retry.
+    if (cb_ctx->attempts > 0) {
+        std::uint32_t retry = cb_ctx->attempts;
+        if (cb_ctx->max_retries && retry > *cb_ctx->max_retries) {
+            // Failing without a TransientTransactionError label makes libmongoc abort the
+            // transaction and give up.
+            cb_ctx->stats->budget_exhausted++;
+            try {
+                auto server_error = std::move(cb_ctx->last_server_error);
+                cb_ctx->eptr = std::make_exception_ptr(
+                    server_error ? operation_exception{
+                                       error_code::k_transaction_retry_budget_exhausted,
+                                       std::move(*server_error)}
+                                 : operation_exception{
+                                       error_code::k_transaction_retry_budget_exhausted});
+            } catch (...) {
+                cb_ctx->eptr = std::current_exception();
+            }
+            make_generic_bson_error(error);
+            return false;
+        }
+
+        try {
+            with_transaction_backoff(cb_ctx, retry);
+        } catch (...) {
+            // A failed sleep only shortens the backoff.
+        }
+        cb_ctx->stats->retries++;
+    }
+    cb_ctx->attempts++;
+
     try {
         cb_ctx->cb(cb_ctx->parent);
         return true;
     } catch (const operation_exception& e) {
         make_bson_error(error, e);
+        cb_ctx->last_server_error = e.raw_server_error();
         if (e.raw_server_error()) {
             libbson::scoped_bson_t raw{e.raw_server_error()->view()};
             *reply = bson_copy(raw.bson());
@@ -73,27 +142,22 @@ class client_session::impl {
    public:
     impl(const class client* client, const options::client_session& session_options)
         : _client(client), _options(session_options), _session_t(nullptr, nullptr) {
-        // Create a mongoc_session_opts_t from session_options.
-        std::unique_ptr<mongoc_session_opt_t, decltype(libmongoc::session_opts_destroy)> opt_t{
-            libmongoc::session_opts_new(), libmongoc::session_opts_destroy};
-
-        libmongoc::session_opts_set_causal_consistency(opt_t.get(), _options.causal_consistency());
-
-        if (session_options.default_transaction_opts()) {
-            libmongoc::session_opts_set_default_transaction_opts(
-                opt_t.get(),
-                (session_options.default_transaction_opts())->_get_impl().get_transaction_opt_t());
-        }
+        start();
+    }
 
-        bson_error_t error;
-        auto s =
-            libmongoc::client_start_session(_client->_get_impl().client_t, opt_t.get(), &error);
-        if (!s) {
-            throw mongocxx::exception{error_code::k_cannot_create_session, error.message};
-        }
+    // Starts a new libmongoc session with new options, reusing this object for a client_session
+    // started after the one it belonged to ended. The client is rebound, since the one this object
+    // was parked on may have been moved from since.
+    void restart(const class client* client, const options::client_session& session_options) {
+        _client = client;
+        _options = session_options;
+        start();
+    }
 
-        _session_t = unique_session{
-            s, [](mongoc_client_session_t* cs) { libmongoc::client_session_destroy(cs); }};
+    // Ends the libmongoc session, returning its server session to libmongoc's pool.
+    void end() noexcept {
+        _session_document = stdx::nullopt;
+        _session_t.reset();
     }
 
     const class client& client() const noexcept {
@@ -177,7 +241,29 @@ class client_session::impl {
         auto session_t = _session_t.get();
         auto opts_t = opts._get_impl().get_transaction_opt_t();
 
-        with_transaction_ctx ctx{parent, std::move(cb), nullptr};
+        with_transaction_ctx ctx{parent,
+                                 std::move(cb),
+                                 nullptr,
+                                 opts._get_impl().retry_backoff_initial(),
+                                 opts._get_impl().retry_backoff_max(),
+                                 opts._get_impl().max_retries(),
+                                 0,
+                                 stdx::nullopt,
+                                 &_with_transaction_stats};
+
+        // Retry settings which the transaction leaves unset come from the session's defaults,
+        // as libmongoc does for the other transaction options.
+        if (const auto& defaults = _options.default_transaction_opts()) {
+            if (!ctx.backoff_initial) {
+                ctx.backoff_initial = defaults->_get_impl().retry_backoff_initial();
+                ctx.backoff_max = defaults->_get_impl().retry_backoff_max();
+            }
+            if (!ctx.max_retries) {
+                ctx.max_retries = defaults->_get_impl().max_retries();
+            }
+        }
+
+        _with_transaction_stats.transactions++;
 
         libbson::scoped_bson_t reply;
         bson_error_t error;
@@ -194,22 +280,60 @@ class client_session::impl {
         }
     }
 
-    bsoncxx::document::value to_document() const {
-        bson_error_t error;
-        bson_t bson = BSON_INITIALIZER;
-        if (!libmongoc::client_session_append(_session_t.get(), &bson, &error)) {
-            throw mongocxx::logic_error{error_code::k_invalid_session, error.message};
+    // The options document identifying this session to the operations run in it. It is built once
+    // per libmongoc session, since it does not change for the session's lifetime.
+    bsoncxx::document::view to_document() const {
+        if (!_session_document) {
+            bson_error_t error;
+            bson_t bson = BSON_INITIALIZER;
+            if (!libmongoc::client_session_append(_session_t.get(), &bson, &error)) {
+                bson_destroy(&bson);
+                throw mongocxx::logic_error{error_code::k_invalid_session, error.message};
+            }
+
+            // document::value takes ownership of the bson buffer.
+            _session_document = bsoncxx::helpers::value_from_bson_t(&bson);
         }
 
-        // document::value takes ownership of the bson buffer.
-        return bsoncxx::helpers::value_from_bson_t(&bson);
+        return _session_document->view();
     }
 
     mongoc_client_session_t* get_session_t() const noexcept {
         return _session_t.get();
     }
 
+    client_session::with_transaction_statistics with_transaction_stats() const noexcept {
+        return _with_transaction_stats;
+    }
+
    private:
+    void start() {
+        _session_document = stdx::nullopt;
+        _with_transaction_stats = {};
+
+        // Create a mongoc_session_opts_t from the session options.
+        std::unique_ptr<mongoc_session_opt_t, decltype(libmongoc::session_opts_destroy)> opt_t{
+            libmongoc::session_opts_new(), libmongoc::session_opts_destroy};
+
+        libmongoc::session_opts_set_causal_consistency(opt_t.get(), _options.causal_consistency());
+
+        if (_options.default_transaction_opts()) {
+            libmongoc::session_opts_set_default_transaction_opts(
+                opt_t.get(),
+                (_options.default_transaction_opts())->_get_impl().get_transaction_opt_t());
+        }
+
+        bson_error_t error;
+        auto s =
+            libmongoc::client_start_session(_client->_get_impl().client_t, opt_t.get(), &error);
+        if (!s) {
+            throw mongocxx::exception{error_code::k_cannot_create_session, error.message};
+        }
+
+        _session_t = unique_session{
+            s, [](mongoc_client_session_t* cs) { libmongoc::client_session_destroy(cs); }};
+    }
+
     const class client* _client;
     options::client_session _options;
 
@@ -220,6 +344,10 @@ class client_session::impl {
     unique_session _session_t;
 
     bson_t _empty_cluster_time = BSON_INITIALIZER;
+
+    mutable stdx::optional<bsoncxx::document::value> _session_document;
+
+    client_session::with_transaction_statistics _with_transaction_stats{};
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
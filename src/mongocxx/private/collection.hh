@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include <bsoncxx/document/value.hpp>
 #include <bsoncxx/private/helpers.hh>
 #include <bsoncxx/stdx/string_view.hpp>
@@ -34,32 +37,44 @@ class collection::impl {
     impl(mongoc_collection_t* collection,
          stdx::string_view database_name,
          const class client::impl* client)
-        : collection_t(collection), database_name(std::move(database_name)), client_impl(client) {}
+        : collection_t(collection),
+          database_name(std::move(database_name)),
+          client_impl(client),
+          _shared(collection, destroy) {}
 
-    impl(const impl& i)
-        : collection_t{libmongoc::collection_copy(i.collection_t)},
-          database_name{i.database_name},
-          client_impl{i.client_impl} {}
+    // Copies share the mongoc_collection_t, so that copying a collection, as when it is captured
+    // by value in a lambda, is an atomic increment rather than a copy of its concerns and
+    // preferences. A handle that is about to change it calls detach() first.
+    impl(const impl& i) = default;
+    impl& operator=(const impl& i) = default;
 
-    impl& operator=(const impl& i) {
-        if (this != &i) {
-            libmongoc::collection_destroy(collection_t);
-            collection_t = libmongoc::collection_copy(i.collection_t);
+    ~impl() = default;
 
-            database_name = i.database_name;
-            client_impl = i.client_impl;
+    // Gives this handle a mongoc_collection_t of its own, copying the shared one if any other
+    // handle uses it.
+    void detach() {
+        if (_shared.use_count() > 1) {
+            _shared.reset(libmongoc::collection_copy(collection_t), destroy);
+            collection_t = _shared.get();
         }
-
-        return *this;
     }
 
-    ~impl() {
-        libmongoc::collection_destroy(collection_t);
+    // Shares ownership of the mongoc_collection_t, for objects such as an index_view that must
+    // keep using it after this handle detaches from it.
+    const std::shared_ptr<mongoc_collection_t>& shared() const {
+        return _shared;
     }
 
     mongoc_collection_t* collection_t;
     std::string database_name;
     const class client::impl* client_impl;
+
+   private:
+    static void destroy(mongoc_collection_t* collection) {
+        libmongoc::collection_destroy(collection);
+    }
+
+    std::shared_ptr<mongoc_collection_t> _shared;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
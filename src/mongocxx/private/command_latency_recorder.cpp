@@ -0,0 +1,169 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/command_latency_recorder.hh>
+
+#include <map>
+#include <tuple>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+std::uint64_t fnv1a(std::uint64_t hash, stdx::string_view bytes) {
+    for (auto c : bytes) {
+        hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::uint64_t key_hash(stdx::string_view command_name, stdx::string_view host, std::uint16_t port) {
+    auto hash = fnv1a(0xcbf29ce484222325ULL, command_name);
+    hash = fnv1a(hash, host);
+    return (hash ^ port) * 0x100000001b3ULL;
+}
+
+std::atomic<std::size_t> next_shard{0};
+
+}  // namespace
+
+constexpr std::size_t command_latency_recorder::k_shards;
+constexpr std::size_t command_latency_recorder::k_slots;
+
+command_latency_recorder::histogram::histogram(std::uint64_t hash,
+                                               stdx::string_view command_name,
+                                               stdx::string_view host,
+                                               std::uint16_t port)
+    : hash{hash},
+      command_name{command_name.data(), command_name.size()},
+      host{host.data(), host.size()},
+      port{port},
+      total_duration{0},
+      max_duration{0} {
+    for (auto&& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool command_latency_recorder::histogram::matches(std::uint64_t hash,
+                                                  stdx::string_view command_name,
+                                                  stdx::string_view host,
+                                                  std::uint16_t port) const {
+    return this->hash == hash && this->port == port && this->command_name == command_name &&
+           this->host == host;
+}
+
+command_latency_recorder::command_latency_recorder() : _shards{new shard[k_shards]} {
+    for (std::size_t i = 0; i < k_shards; ++i) {
+        for (auto&& slot : _shards[i].slots) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+command_latency_recorder::~command_latency_recorder() {
+    for (std::size_t i = 0; i < k_shards; ++i) {
+        for (auto&& slot : _shards[i].slots) {
+            delete slot.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void command_latency_recorder::record(stdx::string_view command_name,
+                                      stdx::string_view host,
+                                      std::uint16_t port,
+                                      std::int64_t duration) {
+    // Threads are spread over the shards in the order they first record a command.
+    static thread_local const std::size_t thread_shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % k_shards;
+
+    auto hash = key_hash(command_name, host, port);
+    auto& slots = _shards[thread_shard].slots;
+
+    std::unique_ptr<histogram> fresh;
+    for (std::size_t probe = 0; probe < k_slots; ++probe) {
+        auto& slot = slots[(hash + probe) % k_slots];
+        auto entry = slot.load(std::memory_order_acquire);
+        if (!entry) {
+            if (!fresh) {
+                fresh.reset(new histogram{hash, command_name, host, port});
+            }
+            if (slot.compare_exchange_strong(entry, fresh.get(), std::memory_order_acq_rel)) {
+                entry = fresh.release();
+            }
+        }
+
+        if (!entry->matches(hash, command_name, host, port)) {
+            continue;
+        }
+
+        auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(duration, 0));
+        entry->buckets[command_latency_bucket(micros)].fetch_add(1, std::memory_order_relaxed);
+        entry->total_duration.fetch_add(micros, std::memory_order_relaxed);
+        auto max = entry->max_duration.load(std::memory_order_relaxed);
+        while (micros > max &&
+               !entry->max_duration.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+        }
+        return;
+    }
+}
+
+std::vector<events::command_latency> command_latency_recorder::snapshot() const {
+    std::map<std::tuple<std::string, std::string, std::uint16_t>, events::command_latency> merged;
+
+    for (std::size_t i = 0; i < k_shards; ++i) {
+        for (auto&& slot : _shards[i].slots) {
+            auto entry = slot.load(std::memory_order_acquire);
+            if (!entry) {
+                continue;
+            }
+
+            auto& latency = merged[std::make_tuple(entry->command_name, entry->host, entry->port)];
+            if (latency.histogram.empty()) {
+                latency.command_name = entry->command_name;
+                latency.host = entry->host;
+                latency.port = entry->port;
+                latency.count = 0;
+                latency.total_duration = std::chrono::microseconds{0};
+                latency.max_duration = std::chrono::microseconds{0};
+                latency.histogram.assign(events::command_latency::k_histogram_buckets, 0);
+            }
+
+            for (std::size_t b = 0; b < events::command_latency::k_histogram_buckets; ++b) {
+                auto count = entry->buckets[b].load(std::memory_order_relaxed);
+                latency.histogram[b] += count;
+                latency.count += count;
+            }
+            latency.total_duration += std::chrono::microseconds{
+                static_cast<std::int64_t>(entry->total_duration.load(std::memory_order_relaxed))};
+            latency.max_duration = std::max(
+                latency.max_duration,
+                std::chrono::microseconds{static_cast<std::int64_t>(
+                    entry->max_duration.load(std::memory_order_relaxed))});
+        }
+    }
+
+    std::vector<events::command_latency> latencies;
+    latencies.reserve(merged.size());
+    for (auto&& pair : merged) {
+        latencies.push_back(std::move(pair.second));
+    }
+    return latencies;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
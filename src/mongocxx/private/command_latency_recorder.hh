@@ -0,0 +1,114 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/events/command_latency.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+// Gets the bucket of events::command_latency::histogram counting a duration in microseconds.
+inline std::size_t command_latency_bucket(std::uint64_t duration) {
+    if (duration < 32) {
+        return static_cast<std::size_t>(duration);
+    }
+
+    duration = std::min<std::uint64_t>(duration, (std::uint64_t{1} << 40) - 1);
+    std::size_t msb = 5;
+    while (duration >> (msb + 1)) {
+        ++msb;
+    }
+    auto top = static_cast<std::size_t>(duration >> (msb - 4));
+    return 32 + (msb - 5) * 16 + (top - 16);
+}
+
+//
+// Records the durations of succeeded commands into per command name and server histograms.
+//
+// Recording is lock-free: every thread is assigned one of a fixed number of shards, each holding
+// its own histograms in an open-addressed table whose slots are claimed with a compare-and-swap
+// the first time a command name and server are recorded. Counting a duration is then a handful of
+// relaxed atomic increments on memory that other threads rarely touch. snapshot() merges the
+// shards.
+//
+class MONGOCXX_TEST_API command_latency_recorder {
+   public:
+    command_latency_recorder();
+
+    command_latency_recorder(const command_latency_recorder&) = delete;
+    command_latency_recorder& operator=(const command_latency_recorder&) = delete;
+
+    ~command_latency_recorder();
+
+    void record(stdx::string_view command_name,
+                stdx::string_view host,
+                std::uint16_t port,
+                std::int64_t duration);
+
+    // Returns the merged histograms, sorted by command name, host and port. Counters are read one
+    // by one while other threads may be recording, so a snapshot need not be exactly consistent.
+    std::vector<events::command_latency> snapshot() const;
+
+   private:
+    static constexpr std::size_t k_shards = 8;
+
+    // The most distinct command name and server pairs recorded by a shard. Later pairs are dropped.
+    static constexpr std::size_t k_slots = 256;
+
+    struct histogram {
+        histogram(std::uint64_t hash,
+                  stdx::string_view command_name,
+                  stdx::string_view host,
+                  std::uint16_t port);
+
+        bool matches(std::uint64_t hash,
+                     stdx::string_view command_name,
+                     stdx::string_view host,
+                     std::uint16_t port) const;
+
+        const std::uint64_t hash;
+        const std::string command_name;
+        const std::string host;
+        const std::uint16_t port;
+
+        std::atomic<std::uint64_t> total_duration;
+        std::atomic<std::uint64_t> max_duration;
+        std::atomic<std::uint64_t> buckets[events::command_latency::k_histogram_buckets];
+    };
+
+    struct shard {
+        std::atomic<histogram*> slots[k_slots];
+    };
+
+    std::unique_ptr<shard[]> _shards;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,78 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/compression_statistics.hh>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/events/server_description.hpp>
+#include <mongocxx/private/libbson.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+compression_statistics make_compression_statistics(mongoc_client_t* client,
+                                                   const options::apm_context& apm) {
+    compression_statistics statistics;
+
+    const auto uri = libmongoc::client_get_uri(client);
+    if (const auto compressors = libmongoc::uri_get_compressors(uri)) {
+        // The compressors are the keys of the document, in the order of the URI.
+        const bsoncxx::document::view compressors_view{bson_get_data(compressors),
+                                                       compressors->len};
+        for (auto&& element : compressors_view) {
+            statistics.compressors.push_back(std::string{element.key()});
+        }
+    }
+    statistics.zlib_compression_level =
+        libmongoc::uri_get_option_as_int32(uri, MONGOC_URI_ZLIBCOMPRESSIONLEVEL, -1);
+
+    std::size_t count;
+    auto sds = libmongoc::client_get_server_descriptions(client, &count);
+    for (std::size_t i = 0; i < count; i++) {
+        events::server_description sd{sds[i]};
+
+        compression_statistics::server server;
+        server.host = std::string{sd.host()};
+        server.port = sd.port();
+
+        // The server lists those of the offered compressors it supports, and the driver uses the
+        // first of them.
+        const auto agreed = sd.is_master()["compression"];
+        if (agreed && agreed.type() == bsoncxx::type::k_array) {
+            const auto agreed_view = agreed.get_array().value;
+            auto first = agreed_view.begin();
+            if (first != agreed_view.end() && first->type() == bsoncxx::type::k_utf8) {
+                server.compressor = std::string{first->get_utf8().value};
+            }
+        }
+        statistics.servers.push_back(std::move(server));
+    }
+    libmongoc::server_descriptions_destroy_all(sds, count);
+
+    statistics.commands = apm.commands.load(std::memory_order_relaxed);
+    statistics.command_bytes = apm.command_bytes.load(std::memory_order_relaxed);
+    statistics.reply_bytes = apm.reply_bytes.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,88 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// The results of counts run with options::count::cache_ttl, shared by the collections of a
+// client, or of every client of a pool. Keys encode the namespace, the filter and every option
+// that changes the result. Once the cache is full, expired entries are dropped before a new one is
+// added, and if none have expired the cache is emptied. Expiry is judged by the clock given at
+// construction, so tests can advance time without sleeping.
+//
+class count_cache {
+   public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t k_max_entries = 1024;
+
+    explicit count_cache(std::function<clock::time_point()> now = &clock::now)
+        : _now{std::move(now)} {}
+
+    stdx::optional<std::int64_t> find(const std::string& key) const {
+        auto now = _now();
+        std::lock_guard<std::mutex> lock{_mutex};
+        auto it = _entries.find(key);
+        if (it == _entries.end() || it->second.expires_at <= now) {
+            return stdx::nullopt;
+        }
+        return it->second.count;
+    }
+
+    void insert(std::string key, std::int64_t count, std::chrono::milliseconds ttl) {
+        auto now = _now();
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (_entries.size() >= k_max_entries && _entries.find(key) == _entries.end()) {
+            for (auto it = _entries.begin(); it != _entries.end();) {
+                it = it->second.expires_at <= now ? _entries.erase(it) : std::next(it);
+            }
+            if (_entries.size() >= k_max_entries) {
+                _entries.clear();
+            }
+        }
+        _entries[std::move(key)] = entry{count, now + ttl};
+    }
+
+   private:
+    struct entry {
+        std::int64_t count;
+        clock::time_point expires_at;
+    };
+
+    std::function<clock::time_point()> _now;
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, entry> _entries;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -14,10 +14,23 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/cursor.hpp>
+#include <mongocxx/private/batch_sizer.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/operation_accounting.hh>
+#include <mongocxx/private/reply_budget.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -39,6 +52,8 @@ class cursor::impl {
                                              *cursor_type == cursor::type::k_tailable_await)} {}
 
     ~impl() {
+        stop_prefetch();
+        release_slab();
         libmongoc::cursor_destroy(cursor_t);
     }
 
@@ -58,6 +73,14 @@ class cursor::impl {
         return tailable;
     }
 
+    bool is_prefetching() const {
+        return static_cast<bool>(_prefetch);
+    }
+
+    bool is_sizing_batches() const {
+        return static_cast<bool>(_sizer);
+    }
+
     void mark_dead() {
         mark_nothing_left();
         status = state::k_dead;
@@ -74,11 +97,101 @@ class cursor::impl {
         exhausted = false;
     }
 
+    // Starts a background thread that keeps up to `max_batches` batches of the next documents
+    // ready, read `batch_size` documents at a time; see options::find::prefetch_batches. The
+    // batches waiting to be consumed hold at most `max_bytes`, see
+    // options::find::max_prefetched_bytes, and are counted against `budget`, if any. From then on
+    // documents must only be taken with next_prefetched().
+    //
+    // Throws logic_error if `max_batches` or `max_bytes` is not positive or the cursor is tailable.
+    void start_prefetch(std::int32_t max_batches,
+                        bsoncxx::stdx::optional<std::int32_t> batch_size,
+                        bsoncxx::stdx::optional<std::int64_t> max_bytes = {},
+                        std::shared_ptr<reply_budget> budget = {});
+
+    // Moves doc to the next prefetched document, waiting for the background thread if none is
+    // ready yet. Returns false once the cursor has no documents left, and rethrows the error that
+    // stopped the background thread, if any.
+    bool next_prefetched();
+
+    // Stops the background thread, if any, and waits for it to exit.
+    void stop_prefetch();
+
+    // Sets the batch size of later getMores from the documents returned, starting from `initial`;
+    // see options::find::max_batch_bytes() and options::find::adaptive_batch_size(). Must be
+    // called before start_prefetch().
+    void start_batch_sizing(std::int32_t initial, std::int32_t max_bytes, bool adaptive);
+
+    // While sizing batches, called before and after each cursor_next that returns a document,
+    // from whichever thread reads the cursor, so that the time spent fetching and between
+    // documents is recorded.
+    std::chrono::steady_clock::time_point begin_fetch();
+    void end_fetch(std::chrono::steady_clock::time_point started, std::size_t length);
+
+    // Copies doc into the current slab, starting a new one if it does not fit. See
+    // cursor::iterator::retain().
+    bsoncxx::document::value retain();
+
+    // Drops the cursor's reference to its current slab.
+    void release_slab();
+
+    // A reference-counted buffer that retained documents are packed into.
+    struct slab;
+
     mongoc_cursor_t* cursor_t;
     bsoncxx::document::view doc;
     state status;
     bool exhausted;
     bool tailable;
+
+    // Whether next_batch() has returned doc without advancing past it, so that filling a batch
+    // does not read a document the caller has not asked for. The next begin() advances instead.
+    bool returned_doc = false;
+
+    // Keeps whatever cursor_t depends on alive, e.g. the pooled client of a partition returned by
+    // collection::parallel_scan. Released only after cursor_t is destroyed.
+    std::shared_ptr<void> owner;
+
+    // The traffic of the commands run by cursor_next; see cursor::stats().
+    operation_counters stats;
+
+   private:
+    // The state shared between a prefetching cursor and its background thread.
+    struct prefetch_state {
+        std::size_t max_batches;
+        std::size_t batch_size;
+
+        // The most bytes of batches waiting in `ready`, or 0 for no limit.
+        std::size_t max_ready_bytes = 0;
+
+        // The budget the batches in `ready` and `current` are counted against, if any.
+        std::shared_ptr<reply_budget> budget;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+
+        // Guarded by mutex.
+        std::deque<cursor::batch> ready;
+        std::size_t ready_bytes = 0;
+        bool finished = false;
+        bool stopping = false;
+        std::exception_ptr error;
+
+        // Only used by the consuming thread: the batch doc points into.
+        cursor::batch current;
+        std::size_t position = 0;
+
+        std::thread thread;
+    };
+
+    void prefetch_loop();
+
+    std::unique_ptr<prefetch_state> _prefetch;
+
+    std::unique_ptr<batch_sizer> _sizer;
+    std::chrono::steady_clock::time_point _last_fetch;
+
+    slab* _slab = nullptr;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
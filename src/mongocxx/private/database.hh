@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include <mongocxx/client.hpp>
 #include <mongocxx/database.hpp>
 #include <mongocxx/private/client.hh>
@@ -28,31 +31,34 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 class database::impl {
    public:
     impl(mongoc_database_t* db, const class client::impl* client, std::string name)
-        : database_t(db), client_impl(client), name(std::move(name)) {}
-
-    impl(const impl& i)
-        : database_t{libmongoc::database_copy(i.database_t)},
-          client_impl{i.client_impl},
-          name{i.name} {}
-
-    impl& operator=(const impl& i) {
-        if (this != &i) {
-            libmongoc::database_destroy(database_t);
-            database_t = libmongoc::database_copy(i.database_t);
-            client_impl = i.client_impl;
-            name = i.name;
-        }
+        : database_t(db), client_impl(client), name(std::move(name)), _shared(db, destroy) {}
 
-        return *this;
-    }
+    // Copies share the mongoc_database_t, as those of a collection::impl share their
+    // mongoc_collection_t. A handle that is about to change it calls detach() first.
+    impl(const impl& i) = default;
+    impl& operator=(const impl& i) = default;
+
+    ~impl() = default;
 
-    ~impl() {
-        libmongoc::database_destroy(database_t);
+    // Gives this handle a mongoc_database_t of its own, copying the shared one if any other
+    // handle uses it.
+    void detach() {
+        if (_shared.use_count() > 1) {
+            _shared.reset(libmongoc::database_copy(database_t), destroy);
+            database_t = _shared.get();
+        }
     }
 
     mongoc_database_t* database_t;
     const class client::impl* client_impl;
     std::string name;
+
+   private:
+    static void destroy(mongoc_database_t* db) {
+        libmongoc::database_destroy(db);
+    }
+
+    std::shared_ptr<mongoc_database_t> _shared;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
@@ -0,0 +1,48 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/database_pool.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/read_concern.hpp>
+#include <mongocxx/read_preference.hpp>
+#include <mongocxx/write_concern.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class database_pool::impl {
+   public:
+    impl(class pool* pool, std::string name) : pool(pool), name(std::move(name)) {}
+
+    class pool* pool;
+    std::string name;
+
+    // The settings applied to every database handle; unset ones are those of the pool's clients.
+    stdx::optional<class read_concern> read_concern;
+    stdx::optional<class read_preference> read_preference;
+    stdx::optional<class write_concern> write_concern;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,138 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/document_deduplicator.hh>
+
+#include <algorithm>
+#include <cstring>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/hash.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using bsoncxx::stdx::string_view;
+
+// The table starts with this many slots and doubles whenever it is half full.
+constexpr std::size_t k_initial_slots = 1024;
+
+}  // namespace
+
+document_deduplicator::document_deduplicator(const std::vector<std::string>& fields) {
+    if (fields.empty()) {
+        throw logic_error{error_code::k_invalid_parameter, "the dedupe_by field list is empty"};
+    }
+
+    for (auto&& field : fields) {
+        const string_view path{field};
+        std::vector<std::string> keys;
+        std::size_t begin = 0;
+        while (true) {
+            const auto dot = path.find('.', begin);
+            keys.push_back(
+                path.substr(begin, dot == string_view::npos ? string_view::npos : dot - begin)
+                    .to_string());
+            if (keys.back().empty()) {
+                throw logic_error{error_code::k_invalid_parameter,
+                                  "dedupe_by fields must not be empty"};
+            }
+            if (dot == string_view::npos) {
+                break;
+            }
+            begin = dot + 1;
+        }
+
+        _heads.push_back(std::move(keys.front()));
+        keys.erase(keys.begin());
+        _tails.push_back(std::move(keys));
+    }
+
+    // _heads no longer changes, so the views stay valid.
+    for (auto&& head : _heads) {
+        _head_views.emplace_back(head);
+    }
+    _elements.resize(_heads.size());
+}
+
+bool document_deduplicator::keep(bsoncxx::document::view document) {
+    document.extract(_head_views.data(), _head_views.size(), _elements.data());
+
+    _scratch.clear();
+    for (std::size_t i = 0; i < _heads.size(); i++) {
+        auto element = _elements[i];
+        for (auto&& key : _tails[i]) {
+            if (!element || element.type() != bsoncxx::type::k_document) {
+                return true;
+            }
+            element = element.get_document().value[key];
+        }
+        if (!element) {
+            return true;
+        }
+        _scratch.append_raw(element);
+    }
+
+    const auto key = _scratch.view_array();
+    const auto length = static_cast<std::uint32_t>(key.length());
+    const auto hash = bsoncxx::hash(bsoncxx::document::view{key.data(), key.length()});
+
+    if ((_size + 1) * 2 > _slots.size()) {
+        _grow();
+    }
+
+    const std::size_t mask = _slots.size() - 1;
+    for (std::size_t i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask) {
+        auto& candidate = _slots[i];
+        if (candidate.length == 0) {
+            candidate = {hash, _keys.size(), length};
+            _keys.insert(_keys.end(), key.data(), key.data() + length);
+            ++_size;
+            return true;
+        }
+        if (candidate.hash == hash && candidate.length == length &&
+            std::memcmp(_keys.data() + candidate.offset, key.data(), length) == 0) {
+            return false;
+        }
+    }
+}
+
+std::size_t document_deduplicator::size() const {
+    return _size;
+}
+
+void document_deduplicator::_grow() {
+    std::vector<slot> slots(std::max(k_initial_slots, _slots.size() * 2), slot{0, 0, 0});
+    const std::size_t mask = slots.size() - 1;
+    for (auto&& recorded : _slots) {
+        if (recorded.length == 0) {
+            continue;
+        }
+        std::size_t i = static_cast<std::size_t>(recorded.hash) & mask;
+        while (slots[i].length != 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = recorded;
+    }
+    _slots = std::move(slots);
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,91 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/core.hpp>
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Finds documents that repeat the values of a list of fields seen earlier, in one pass. The values
+// of each recorded document are copied into one buffer, and an open-addressing table of their
+// hashes indexes it, so that a lookup costs a hash and usually one comparison. A deduplicator is
+// not thread-safe.
+//
+class MONGOCXX_TEST_API document_deduplicator {
+   public:
+    //
+    // Takes the fields that identify a document, which may be dotted paths such as "a.b". Throws
+    // logic_error if the list or one of the fields is empty.
+    //
+    explicit document_deduplicator(const std::vector<std::string>& fields);
+
+    document_deduplicator(const document_deduplicator&) = delete;
+    document_deduplicator& operator=(const document_deduplicator&) = delete;
+
+    //
+    // Returns false if an earlier document had the same values for all of the fields, that is,
+    // values of the same type with the same bytes. Otherwise records the values of `document`
+    // and returns true. A document missing one of the fields is always kept and never recorded.
+    //
+    bool keep(bsoncxx::document::view document);
+
+    //
+    // The number of distinct sets of values recorded.
+    //
+    std::size_t size() const;
+
+   private:
+    // A recorded key: its hash and where its bytes are in _keys. A length of zero marks an empty
+    // slot, since every key is a BSON array of at least five bytes.
+    struct slot {
+        std::uint64_t hash;
+        std::size_t offset;
+        std::uint32_t length;
+    };
+
+    void _grow();
+
+    // The first key of each path, views of them to pass to view::extract(), and the remaining
+    // keys of each path.
+    std::vector<std::string> _heads;
+    std::vector<bsoncxx::stdx::string_view> _head_views;
+    std::vector<std::vector<std::string>> _tails;
+    std::vector<bsoncxx::document::element> _elements;
+
+    // The values of the current document, as an array.
+    bsoncxx::builder::core _scratch{true};
+
+    std::vector<std::uint8_t> _keys;
+    std::vector<slot> _slots;
+    std::size_t _size = 0;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,307 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/document_template.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr char k_parameter_key[] = "$parameter";
+
+std::uint32_t read_length(const std::uint8_t* data) {
+    return static_cast<std::uint32_t>(data[0]) | static_cast<std::uint32_t>(data[1]) << 8 |
+           static_cast<std::uint32_t>(data[2]) << 16 | static_cast<std::uint32_t>(data[3]) << 24;
+}
+
+void write_le(std::uint64_t value, std::size_t size, std::uint8_t* out) {
+    for (std::size_t i = 0; i < size; i++) {
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+void append_le(std::uint64_t value, std::size_t size, std::vector<std::uint8_t>* out) {
+    out->resize(out->size() + size);
+    write_le(value, size, out->data() + out->size() - size);
+}
+
+void append_bytes(const void* bytes, std::size_t size, std::vector<std::uint8_t>* out) {
+    auto first = static_cast<const std::uint8_t*>(bytes);
+    out->insert(out->end(), first, first + size);
+}
+
+template <typename Names>
+auto find_name(Names& names, stdx::string_view name) -> decltype(names.begin()) {
+    return std::find_if(names.begin(), names.end(), [name](const std::string& candidate) {
+        return stdx::string_view{candidate} == name;
+    });
+}
+
+// Returns the name of the parameter if `document` is a placeholder made by parameter().
+stdx::optional<stdx::string_view> placeholder_name(bsoncxx::document::view document) {
+    auto first = document.begin();
+    if (first == document.end() || first->type() != bsoncxx::type::k_utf8 ||
+        first->key() != stdx::string_view{k_parameter_key} || std::next(first) != document.end()) {
+        return {};
+    }
+    return first->get_utf8().value;
+}
+
+// Appends the BSON encoding of a value, without type byte or key, and returns its type. The
+// common types are encoded directly; the rest go through a builder so that libbson's rules for
+// them, e.g. the order of regex options, still apply.
+bsoncxx::type encode(const bsoncxx::types::value& value, std::vector<std::uint8_t>* out) {
+    using bsoncxx::type;
+
+    switch (value.type()) {
+        case type::k_double: {
+            const double number = value.get_double().value;
+            std::uint64_t bits;
+            std::memcpy(&bits, &number, sizeof(bits));
+            append_le(bits, 8, out);
+            return type::k_double;
+        }
+        case type::k_utf8: {
+            const auto string = value.get_utf8().value;
+            append_le(string.size() + 1, 4, out);
+            append_bytes(string.data(), string.size(), out);
+            out->push_back(0);
+            return type::k_utf8;
+        }
+        case type::k_document: {
+            const auto document = value.get_document().value;
+            append_bytes(document.data(), document.length(), out);
+            return type::k_document;
+        }
+        case type::k_array: {
+            const auto array = value.get_array().value;
+            append_bytes(array.data(), array.length(), out);
+            return type::k_array;
+        }
+        case type::k_binary: {
+            const auto binary = value.get_binary();
+            if (binary.sub_type == bsoncxx::binary_sub_type::k_binary_deprecated) {
+                break;
+            }
+            append_le(binary.size, 4, out);
+            out->push_back(static_cast<std::uint8_t>(binary.sub_type));
+            append_bytes(binary.bytes, binary.size, out);
+            return type::k_binary;
+        }
+        case type::k_oid:
+            append_bytes(value.get_oid().value.bytes(), 12, out);
+            return type::k_oid;
+        case type::k_bool:
+            out->push_back(value.get_bool().value ? 1 : 0);
+            return type::k_bool;
+        case type::k_date:
+            append_le(static_cast<std::uint64_t>(value.get_date().to_int64()), 8, out);
+            return type::k_date;
+        case type::k_int32:
+            append_le(static_cast<std::uint32_t>(value.get_int32().value), 4, out);
+            return type::k_int32;
+        case type::k_timestamp:
+            append_le(value.get_timestamp().increment, 4, out);
+            append_le(value.get_timestamp().timestamp, 4, out);
+            return type::k_timestamp;
+        case type::k_int64:
+            append_le(static_cast<std::uint64_t>(value.get_int64().value), 8, out);
+            return type::k_int64;
+        case type::k_decimal128:
+            append_le(value.get_decimal128().value.low(), 8, out);
+            append_le(value.get_decimal128().value.high(), 8, out);
+            return type::k_decimal128;
+        case type::k_undefined:
+        case type::k_null:
+        case type::k_minkey:
+        case type::k_maxkey:
+            return value.type();
+        default:
+            break;
+    }
+
+    // The value of the only element of { "": value } follows its type byte and empty key.
+    bsoncxx::builder::basic::document wrapper;
+    wrapper.append(bsoncxx::builder::basic::kvp("", value));
+    const auto document = wrapper.view();
+    append_bytes(document.data() + 6, document.length() - 7, out);
+    return value.type();
+}
+
+}  // namespace
+
+document_template::document_template(bsoncxx::document::view document,
+                                     std::vector<std::string>* names)
+    : _bytes(document.data(), document.data() + document.length()) {
+    std::vector<std::size_t> enclosing;
+    scan(0, names, &enclosing);
+}
+
+bool document_template::scan(std::size_t offset,
+                             std::vector<std::string>* names,
+                             std::vector<std::size_t>* enclosing) {
+    const std::uint8_t* base = _bytes.data();
+    const std::uint32_t length = read_length(base + offset);
+
+    _containers.push_back(container{offset, length, _slots.size()});
+    enclosing->push_back(_containers.size() - 1);
+
+    bool found = false;
+    for (auto&& element : bsoncxx::document::view{base + offset, length}) {
+        const auto element_type = element.type();
+        if (element_type != bsoncxx::type::k_document && element_type != bsoncxx::type::k_array) {
+            continue;
+        }
+
+        const std::uint8_t* value = element_type == bsoncxx::type::k_document
+                                        ? element.get_document().value.data()
+                                        : element.get_array().value.data();
+        const auto value_offset = static_cast<std::size_t>(value - base);
+
+        if (element_type == bsoncxx::type::k_document) {
+            if (auto name = placeholder_name(element.get_document().value)) {
+                auto existing = find_name(*names, *name);
+                if (existing == names->end()) {
+                    existing = names->emplace(names->end(), name->data(), name->size());
+                }
+
+                const auto type_offset =
+                    static_cast<std::size_t>(element.raw() + element.offset() - base);
+                _slots.push_back(slot{static_cast<std::size_t>(existing - names->begin()),
+                                      type_offset,
+                                      value_offset,
+                                      value_offset + read_length(value),
+                                      *enclosing});
+                found = true;
+                continue;
+            }
+        }
+
+        found = scan(value_offset, names, enclosing) || found;
+    }
+
+    enclosing->pop_back();
+    if (!found) {
+        // Nothing inside the container changes size, so it needs no fixing up.
+        _containers.pop_back();
+    }
+    return found;
+}
+
+bsoncxx::document::value document_template::bind(
+    const std::vector<bsoncxx::types::value>& values) const {
+    // Encode each parameter the first time it occurs, however many times it does.
+    constexpr std::size_t k_not_encoded = static_cast<std::size_t>(-1);
+    std::vector<std::uint8_t> encoded;
+    std::vector<std::size_t> encoded_begin(values.size(), k_not_encoded);
+    std::vector<std::size_t> encoded_end(values.size(), 0);
+    std::vector<bsoncxx::type> types(values.size(), bsoncxx::type::k_null);
+
+    // How much each slot grows the document, and how far everything after it moves.
+    std::vector<std::int64_t> shift(_slots.size() + 1, 0);
+    std::vector<std::int64_t> growth(_containers.size(), 0);
+    for (std::size_t i = 0; i < _slots.size(); i++) {
+        const auto& slot = _slots[i];
+        if (encoded_begin[slot.parameter] == k_not_encoded) {
+            encoded_begin[slot.parameter] = encoded.size();
+            types[slot.parameter] = encode(values[slot.parameter], &encoded);
+            encoded_end[slot.parameter] = encoded.size();
+        }
+
+        const auto delta =
+            static_cast<std::int64_t>(encoded_end[slot.parameter] - encoded_begin[slot.parameter]) -
+            static_cast<std::int64_t>(slot.end - slot.begin);
+        shift[i + 1] = shift[i] + delta;
+        for (auto container : slot.enclosing) {
+            growth[container] += delta;
+        }
+    }
+
+    const auto size = static_cast<std::int64_t>(_bytes.size()) + shift.back();
+    if (size > std::numeric_limits<std::int32_t>::max()) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "the bound document exceeds the maximum BSON size"};
+    }
+
+    std::unique_ptr<std::uint8_t[]> out{new std::uint8_t[static_cast<std::size_t>(size)]};
+    std::uint8_t* position = out.get();
+    std::size_t copied = 0;
+    for (std::size_t i = 0; i < _slots.size(); i++) {
+        const auto& slot = _slots[i];
+        std::memcpy(position, _bytes.data() + copied, slot.begin - copied);
+        position += slot.begin - copied;
+        out[static_cast<std::size_t>(static_cast<std::int64_t>(slot.type_offset) + shift[i])] =
+            static_cast<std::uint8_t>(types[slot.parameter]);
+
+        const auto length = encoded_end[slot.parameter] - encoded_begin[slot.parameter];
+        if (length) {
+            std::memcpy(position, encoded.data() + encoded_begin[slot.parameter], length);
+        }
+        position += length;
+        copied = slot.end;
+    }
+    std::memcpy(position, _bytes.data() + copied, _bytes.size() - copied);
+
+    for (std::size_t i = 0; i < _containers.size(); i++) {
+        const auto& container = _containers[i];
+        write_le(static_cast<std::uint64_t>(container.length + growth[i]),
+                 4,
+                 out.get() + static_cast<std::int64_t>(container.offset) +
+                     shift[container.slots_before]);
+    }
+
+    return bsoncxx::document::value{
+        out.release(), static_cast<std::size_t>(size), [](std::uint8_t* data) { delete[] data; }};
+}
+
+bsoncxx::document::value document_template::placeholder(stdx::string_view name) {
+    bsoncxx::builder::basic::document placeholder;
+    placeholder.append(bsoncxx::builder::basic::kvp(k_parameter_key, name));
+    return placeholder.extract();
+}
+
+std::size_t document_template::parameter_index(const std::vector<std::string>& names,
+                                               stdx::string_view name) {
+    auto found = find_name(names, name);
+    if (found == names.end()) {
+        throw logic_error{error_code::k_invalid_parameter, "no such template parameter"};
+    }
+    return static_cast<std::size_t>(found - names.begin());
+}
+
+void document_template::check_values(const std::vector<std::string>& names,
+                                     const std::vector<bsoncxx::types::value>& values) {
+    if (values.size() != names.size()) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "a value must be bound to every template parameter"};
+    }
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
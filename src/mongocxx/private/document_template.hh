@@ -0,0 +1,106 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// A document serialized once, with placeholders for parameters whose values are bound later; see
+// pipeline_template. Construction records where each placeholder sits and which enclosing
+// documents and arrays it lengthens, so that bind() only copies the frozen bytes around the
+// encoded values and patches those lengths.
+//
+class document_template {
+   public:
+    //
+    // Returns the placeholder for the parameter `name`, i.e. { "$parameter": name }.
+    //
+    static bsoncxx::document::value placeholder(stdx::string_view name);
+
+    //
+    // Returns the position of `name` in `names`. Throws logic_error if it is not there.
+    //
+    static std::size_t parameter_index(const std::vector<std::string>& names,
+                                       stdx::string_view name);
+
+    //
+    // Throws logic_error unless there is exactly one value per name.
+    //
+    static void check_values(const std::vector<std::string>& names,
+                             const std::vector<bsoncxx::types::value>& values);
+
+    //
+    // Copies `document` and records its placeholders. The names of parameters not yet in `names`
+    // are appended to it, so that several templates can share one numbering of parameters.
+    //
+    document_template(bsoncxx::document::view document, std::vector<std::string>* names);
+
+    //
+    // Returns the document with values[i] in place of every placeholder of parameter i.
+    //
+    bsoncxx::document::value bind(const std::vector<bsoncxx::types::value>& values) const;
+
+   private:
+    // An occurrence of a parameter. Offsets are into _bytes.
+    struct slot {
+        std::size_t parameter;
+
+        // The type byte of the element whose value is the placeholder, and the placeholder
+        // document itself, which bind() replaces with the encoded value.
+        std::size_t type_offset;
+        std::size_t begin;
+        std::size_t end;
+
+        // The documents and arrays enclosing the placeholder, as indexes into _containers.
+        std::vector<std::size_t> enclosing;
+    };
+
+    // A document or array containing at least one slot, whose length bind() has to adjust.
+    struct container {
+        std::size_t offset;
+        std::uint32_t length;
+
+        // The number of slots that precede the container, and so move its length field.
+        std::size_t slots_before;
+    };
+
+    // Records the placeholders in the document or array at `offset`, whose enclosing containers are
+    // those in `enclosing`. Returns whether any were found.
+    bool scan(std::size_t offset,
+              std::vector<std::string>* names,
+              std::vector<std::size_t>* enclosing);
+
+    std::vector<std::uint8_t> _bytes;
+    std::vector<slot> _slots;
+    std::vector<container> _containers;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
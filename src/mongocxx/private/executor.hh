@@ -0,0 +1,81 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <mongocxx/executor.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Runs task(0) to task(count - 1) on the calling thread and on up to `parallelism` - 1 tasks of
+// `executor`, and returns once every call has returned. `task` must not throw.
+//
+// The calling thread takes part, and runs the calls no task of the executor has started, so the
+// calls complete even when every thread of the executor is busy, including with callers of
+// run_parallel() themselves. Tasks of the executor that start after the calls are all taken
+// return without touching `task`.
+//
+MONGOCXX_TEST_API void run_parallel(executor& executor,
+                                    std::size_t count,
+                                    std::size_t parallelism,
+                                    const std::function<void(std::size_t)>& task);
+
+//
+// A function submitted to an executor, which the thread waiting for it runs itself if no thread
+// of the executor has started it yet. Like run_parallel(), this keeps a caller from waiting for a
+// task queued behind busy threads of the executor, which may themselves be waiting.
+//
+class MONGOCXX_TEST_API submitted_task {
+   public:
+    // Submits `function`, or runs it right away if the executor does not accept it.
+    static std::shared_ptr<submitted_task> submit(executor& executor,
+                                                  std::function<void()> function);
+
+    // Runs the function if it has not started, and waits for it to return. Rethrows the
+    // exception it threw, if any.
+    void wait();
+
+    // Runs the function on the calling thread unless another thread has claimed it, and returns
+    // whether it did. The exception it threw, if any, is left for wait().
+    bool try_run();
+
+   private:
+    explicit submitted_task(std::function<void()> function);
+
+    std::function<void()> _function;
+    std::atomic<bool> _claimed{false};
+
+    std::mutex _mutex;
+    std::condition_variable _finished;
+    bool _done = false;
+    std::exception_ptr _error;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
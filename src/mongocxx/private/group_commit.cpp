@@ -0,0 +1,175 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/group_commit.hh>
+
+#include <utility>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <bsoncxx/types.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/exception/server_error_code.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+bool is_non_empty_array(bsoncxx::document::element element) {
+    return element && element.type() == bsoncxx::type::k_array &&
+           !element.get_array().value.empty();
+}
+
+// The reply of a bulk write of one insert, as libmongoc reports it.
+bsoncxx::document::value insert_reply(std::int32_t inserted) {
+    return make_document(kvp("nInserted", inserted),
+                         kvp("nMatched", 0),
+                         kvp("nModified", 0),
+                         kvp("nRemoved", 0),
+                         kvp("nUpserted", 0));
+}
+
+}  // namespace
+
+write_outcome<result::bulk_write> group_commit::insert(const std::string& key,
+                                                       bsoncxx::document::view document,
+                                                       const flush_fn& flush) {
+    request mine;
+    mine.document = document;
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    auto& group = _groups[key];
+    group.members++;
+    group.queued.push_back(&mine);
+
+    while (!mine.done) {
+        if (group.flushing) {
+            group.flushed.wait(lock);
+            continue;
+        }
+
+        // Send every request queued so far, including this thread's own.
+        std::vector<request*> sent;
+        sent.swap(group.queued);
+        group.flushing = true;
+        _flushes++;
+        lock.unlock();
+
+        std::vector<bsoncxx::document::view> documents;
+        documents.reserve(sent.size());
+        for (auto&& queued : sent) {
+            documents.push_back(queued->document);
+        }
+
+        std::vector<write_outcome<result::bulk_write>> outcomes;
+        std::exception_ptr error;
+        try {
+            const auto outcome = flush(documents);
+            outcomes.reserve(sent.size());
+            for (std::size_t i = 0; i < sent.size(); i++) {
+                outcomes.push_back(outcome_of(outcome, i));
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        for (std::size_t i = 0; i < sent.size(); i++) {
+            if (error) {
+                sent[i]->error = error;
+            } else {
+                sent[i]->outcome = std::move(outcomes[i]);
+            }
+            sent[i]->done = true;
+        }
+        group.flushing = false;
+        group.flushed.notify_all();
+    }
+
+    if (--group.members == 0) {
+        _groups.erase(key);
+    }
+    lock.unlock();
+
+    if (mine.error) {
+        std::rethrow_exception(mine.error);
+    }
+    return std::move(*mine.outcome);
+}
+
+write_outcome<result::bulk_write> group_commit::outcome_of(
+    const write_outcome<result::bulk_write>& group, std::size_t i) {
+    if (!group.has_error()) {
+        if (!group.value()) {
+            return stdx::optional<result::bulk_write>{};
+        }
+        return stdx::optional<result::bulk_write>{result::bulk_write{insert_reply(1)}};
+    }
+
+    // Without write errors, or with a write concern error, the bulk write failed as a whole.
+    const auto reply = group.raw_server_error();
+    if (!is_non_empty_array(reply["writeErrors"]) ||
+        is_non_empty_array(reply["writeConcernErrors"])) {
+        return group;
+    }
+
+    for (auto&& entry : reply["writeErrors"].get_array().value) {
+        const auto error = entry.get_document().value;
+        if (error["index"].get_int32().value != static_cast<std::int32_t>(i)) {
+            continue;
+        }
+
+        // Report the error at index 0, as an insert on its own would have.
+        bsoncxx::builder::basic::document own_error;
+        for (auto&& field : error) {
+            if (field.key() == bsoncxx::stdx::string_view{"index"}) {
+                own_error.append(kvp("index", 0));
+            } else {
+                own_error.append(kvp(field.key(), field.get_value()));
+            }
+        }
+
+        std::string message;
+        if (error["errmsg"] && error["errmsg"].type() == bsoncxx::type::k_utf8) {
+            message = bsoncxx::string::to_string(error["errmsg"].get_utf8().value);
+        }
+
+        bsoncxx::builder::basic::document own_reply;
+        own_reply.append(bsoncxx::builder::concatenate(insert_reply(0).view()),
+                         kvp("writeErrors", make_array(own_error.extract())));
+        return write_outcome<result::bulk_write>{
+            std::error_code{error["code"].get_int32().value, server_error_category()},
+            own_reply.extract(),
+            std::move(message)};
+    }
+
+    return stdx::optional<result::bulk_write>{result::bulk_write{insert_reply(1)}};
+}
+
+std::uint64_t group_commit::flushes() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _flushes;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
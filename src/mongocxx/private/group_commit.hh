@@ -0,0 +1,97 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/result/bulk_write.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+#include <mongocxx/write_outcome.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Groups the inserts made concurrently with options::insert::group_commit, shared by the
+// collections of a client, or of every client of a pool. Inserts with the same key, which encodes
+// the namespace and the options of the bulk write, join one group. The first thread to find no
+// bulk write of its key in flight sends the whole group as one; the threads arriving meanwhile
+// queue their documents for the next group, and one of them sends it once the reply came.
+//
+class MONGOCXX_TEST_API group_commit {
+   public:
+    // Sends the documents of a group as one unordered bulk write.
+    using flush_fn = std::function<write_outcome<result::bulk_write>(
+        const std::vector<bsoncxx::document::view>& documents)>;
+
+    //
+    // Inserts `document`, which must have an _id, with the group of `key`, sending the group with
+    // `flush` if this thread is the one to send it. Blocks until the group was sent and returns
+    // the outcome an insert of the document on its own would have had; see outcome_of(). An
+    // exception thrown by `flush` is rethrown by every insert of the group.
+    //
+    write_outcome<result::bulk_write> insert(const std::string& key,
+                                             bsoncxx::document::view document,
+                                             const flush_fn& flush);
+
+    //
+    // The outcome of the i-th insert of a group whose bulk write had `group` as its outcome: a
+    // reply counting the one document if it was inserted, a reply with its write error alone if
+    // it failed, and the outcome of the group if the whole bulk write failed.
+    //
+    static write_outcome<result::bulk_write> outcome_of(
+        const write_outcome<result::bulk_write>& group, std::size_t i);
+
+    // The number of bulk writes sent so far.
+    std::uint64_t flushes() const;
+
+   private:
+    struct request {
+        bsoncxx::document::view document;
+        bool done = false;
+        stdx::optional<write_outcome<result::bulk_write>> outcome;
+        std::exception_ptr error;
+    };
+
+    struct group {
+        std::vector<request*> queued;
+        bool flushing = false;
+        // The threads with a request in the group, which is dropped once none is left.
+        std::size_t members = 0;
+        std::condition_variable flushed;
+    };
+
+    mutable std::mutex _mutex;
+    std::map<std::string, group> _groups;
+    std::uint64_t _flushes = 0;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,115 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/hedged_reader.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/executor.hh>
+#include <mongocxx/private/libmongoc.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class hedged_reader::impl {
+   public:
+    // The state of one find_one, shared by the tasks sending its reads. The first read to
+    // succeed answers it; the find_one fails once every read sent has failed.
+    struct race {
+        race(bsoncxx::document::value filter, const options::find& options)
+            : filter(std::move(filter)), options(options) {}
+
+        const bsoncxx::document::value filter;
+        const options::find options;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::size_t sent = 0;
+        std::size_t failed = 0;
+        std::size_t running = 0;
+        bool answered = false;
+        stdx::optional<bsoncxx::document::value> result;
+        std::exception_ptr error;
+
+        bool settled() const {
+            return answered || failed == sent;
+        }
+    };
+
+    impl(class pool* pool,
+         std::string database,
+         std::string collection,
+         std::chrono::milliseconds delay)
+        : pool(pool),
+          database(std::move(database)),
+          collection(std::move(collection)),
+          delay(delay) {}
+
+    ~impl() {
+        reap(true);
+    }
+
+    // Selects a server for a read from the collection with the options, returning 0 and setting
+    // the error if none is selectable.
+    static std::uint32_t select(const class collection& coll,
+                                const options::find& options,
+                                bson_error_t* error);
+
+    // Sends a read of the race to the server with the given id, as a task of the pool's executor,
+    // and returns the task.
+    std::shared_ptr<submitted_task> send(const std::shared_ptr<race>& r,
+                                         pool::entry client,
+                                         std::uint32_t server_id,
+                                         bool hedge);
+
+    // Runs as the task submitted by send().
+    void read(std::shared_ptr<race> r, pool::entry client, std::uint32_t server_id, bool hedge);
+
+    // Forgets the reads whose races have no read running any more, or waits for every read.
+    void reap(bool all);
+
+    class pool* pool;
+    std::string database;
+    std::string collection;
+    std::chrono::milliseconds delay;
+
+    std::atomic<std::int64_t> hedges{0};
+    std::atomic<std::int64_t> hedge_wins{0};
+
+    std::mutex reads_mutex;
+    std::list<std::pair<std::shared_ptr<race>, std::shared_ptr<submitted_task>>> reads;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
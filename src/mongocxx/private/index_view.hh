@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <bsoncxx/builder/basic/array.hpp>
@@ -39,7 +41,10 @@ using bsoncxx::builder::basic::kvp;
 
 class index_view::impl {
    public:
-    impl(mongoc_collection_t* collection) : _coll{collection} {}
+    // The index_view shares ownership of the mongoc_collection_t, which outlives the collection
+    // handle it came from if that handle detaches from it.
+    impl(std::shared_ptr<mongoc_collection_t> collection)
+        : _owner{std::move(collection)}, _coll{_owner.get()} {}
 
     impl(const impl& i) = default;
 
@@ -218,6 +223,7 @@ class index_view::impl {
         }
     }
 
+    std::shared_ptr<mongoc_collection_t> _owner;
     mongoc_collection_t* _coll;
 };
 MONGOCXX_INLINE_NAMESPACE_END
@@ -49,12 +49,15 @@ MONGOCXX_LIBMONGOC_SYMBOL(apm_server_changed_get_topology_id)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_closed_get_context)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_closed_get_host)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_closed_get_topology_id)
+MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_failed_get_awaited)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_failed_get_context)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_failed_get_duration)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_failed_get_error)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_failed_get_host)
+MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_started_get_awaited)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_started_get_context)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_started_get_host)
+MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_succeeded_get_awaited)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_succeeded_get_context)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_succeeded_get_duration)
 MONGOCXX_LIBMONGOC_SYMBOL(apm_server_heartbeat_succeeded_get_host)
@@ -113,6 +116,7 @@ MONGOCXX_LIBMONGOC_SYMBOL(change_stream_get_resume_token)
 MONGOCXX_LIBMONGOC_SYMBOL(change_stream_next)
 MONGOCXX_LIBMONGOC_SYMBOL(cleanup)
 MONGOCXX_LIBMONGOC_SYMBOL(client_command_simple_with_server_id)
+MONGOCXX_LIBMONGOC_SYMBOL(client_default_stream_initiator)
 MONGOCXX_LIBMONGOC_SYMBOL(client_destroy)
 MONGOCXX_LIBMONGOC_SYMBOL(client_enable_auto_encryption)
 MONGOCXX_LIBMONGOC_SYMBOL(client_find_databases_with_opts)
@@ -121,17 +125,20 @@ MONGOCXX_LIBMONGOC_SYMBOL(client_get_database)
 MONGOCXX_LIBMONGOC_SYMBOL(client_get_database_names_with_opts)
 MONGOCXX_LIBMONGOC_SYMBOL(client_get_read_concern)
 MONGOCXX_LIBMONGOC_SYMBOL(client_get_read_prefs)
+MONGOCXX_LIBMONGOC_SYMBOL(client_get_server_descriptions)
 MONGOCXX_LIBMONGOC_SYMBOL(client_get_uri)
 MONGOCXX_LIBMONGOC_SYMBOL(client_get_write_concern)
 MONGOCXX_LIBMONGOC_SYMBOL(client_new_from_uri)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_enable_auto_encryption)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_destroy)
+MONGOCXX_LIBMONGOC_SYMBOL(client_pool_min_size)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_new)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_pop)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_push)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_set_apm_callbacks)
 MONGOCXX_LIBMONGOC_SYMBOL(client_pool_try_pop)
 MONGOCXX_LIBMONGOC_SYMBOL(client_reset)
+MONGOCXX_LIBMONGOC_SYMBOL(client_select_server)
 MONGOCXX_LIBMONGOC_SYMBOL(client_session_abort_transaction)
 MONGOCXX_LIBMONGOC_SYMBOL(client_session_advance_cluster_time)
 MONGOCXX_LIBMONGOC_SYMBOL(client_session_advance_operation_time)
@@ -149,6 +156,7 @@ MONGOCXX_LIBMONGOC_SYMBOL(client_session_with_transaction)
 MONGOCXX_LIBMONGOC_SYMBOL(client_set_apm_callbacks)
 MONGOCXX_LIBMONGOC_SYMBOL(client_set_read_concern)
 MONGOCXX_LIBMONGOC_SYMBOL(client_set_read_prefs)
+MONGOCXX_LIBMONGOC_SYMBOL(client_set_stream_initiator)
 MONGOCXX_LIBMONGOC_SYMBOL(client_set_write_concern)
 MONGOCXX_LIBMONGOC_SYMBOL(client_start_session)
 MONGOCXX_LIBMONGOC_SYMBOL(client_watch)
@@ -185,8 +193,10 @@ MONGOCXX_LIBMONGOC_SYMBOL(collection_write_command_with_opts)
 MONGOCXX_LIBMONGOC_SYMBOL(cursor_destroy)
 MONGOCXX_LIBMONGOC_SYMBOL(cursor_error)
 MONGOCXX_LIBMONGOC_SYMBOL(cursor_error_document)
+MONGOCXX_LIBMONGOC_SYMBOL(cursor_more)
 MONGOCXX_LIBMONGOC_SYMBOL(cursor_new_from_command_reply_with_opts)
 MONGOCXX_LIBMONGOC_SYMBOL(cursor_next)
+MONGOCXX_LIBMONGOC_SYMBOL(cursor_set_batch_size)
 MONGOCXX_LIBMONGOC_SYMBOL(cursor_set_max_await_time_ms)
 MONGOCXX_LIBMONGOC_SYMBOL(database_aggregate)
 MONGOCXX_LIBMONGOC_SYMBOL(database_command_with_opts)
@@ -229,13 +239,16 @@ MONGOCXX_LIBMONGOC_SYMBOL(read_concern_new)
 MONGOCXX_LIBMONGOC_SYMBOL(read_concern_set_level)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_copy)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_destroy)
+MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_get_hedge)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_get_max_staleness_seconds)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_get_mode)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_get_tags)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_new)
+MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_set_hedge)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_set_max_staleness_seconds)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_set_mode)
 MONGOCXX_LIBMONGOC_SYMBOL(read_prefs_set_tags)
+MONGOCXX_LIBMONGOC_SYMBOL(server_description_destroy)
 MONGOCXX_LIBMONGOC_SYMBOL(server_description_host)
 MONGOCXX_LIBMONGOC_SYMBOL(server_description_id)
 MONGOCXX_LIBMONGOC_SYMBOL(server_description_ismaster)
@@ -247,6 +260,11 @@ MONGOCXX_LIBMONGOC_SYMBOL(session_opts_get_causal_consistency)
 MONGOCXX_LIBMONGOC_SYMBOL(session_opts_new)
 MONGOCXX_LIBMONGOC_SYMBOL(session_opts_set_causal_consistency)
 MONGOCXX_LIBMONGOC_SYMBOL(session_opts_set_default_transaction_opts)
+MONGOCXX_LIBMONGOC_SYMBOL(socket_errno)
+MONGOCXX_LIBMONGOC_SYMBOL(socket_setsockopt)
+MONGOCXX_LIBMONGOC_SYMBOL(stream_destroy)
+MONGOCXX_LIBMONGOC_SYMBOL(stream_get_base_stream)
+MONGOCXX_LIBMONGOC_SYMBOL(stream_socket_get_socket)
 MONGOCXX_LIBMONGOC_SYMBOL(topology_description_get_servers)
 MONGOCXX_LIBMONGOC_SYMBOL(topology_description_has_readable_server)
 MONGOCXX_LIBMONGOC_SYMBOL(topology_description_has_writable_server)
@@ -266,8 +284,10 @@ MONGOCXX_LIBMONGOC_SYMBOL(uri_copy)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_destroy)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_auth_mechanism)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_auth_source)
+MONGOCXX_LIBMONGOC_SYMBOL(uri_get_compressors)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_database)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_hosts)
+MONGOCXX_LIBMONGOC_SYMBOL(uri_get_option_as_int32)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_options)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_password)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_read_concern)
@@ -281,6 +301,8 @@ MONGOCXX_LIBMONGOC_SYMBOL(uri_get_string)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_username)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_get_write_concern)
 MONGOCXX_LIBMONGOC_SYMBOL(uri_new)
+MONGOCXX_LIBMONGOC_SYMBOL(uri_set_compressors)
+MONGOCXX_LIBMONGOC_SYMBOL(uri_set_option_as_int32)
 MONGOCXX_LIBMONGOC_SYMBOL(write_concern_copy)
 MONGOCXX_LIBMONGOC_SYMBOL(write_concern_destroy)
 MONGOCXX_LIBMONGOC_SYMBOL(write_concern_get_journal)
@@ -0,0 +1,101 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/merged_cursor.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/read_concern.hpp>
+#include <mongocxx/read_preference.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class merged_cursor::impl {
+   public:
+    impl(class pool* pool,
+         std::string database,
+         std::string collection,
+         class read_concern concern,
+         class read_preference preference,
+         options::find options,
+         std::vector<bsoncxx::document::value> filters);
+
+    // Stops the background threads and waits for them to exit.
+    ~impl();
+
+    // Starts up to `connections` background threads, each of which checks out its own client.
+    // Throws if not even one thread could be started.
+    void start(std::size_t connections);
+
+    // Makes `current` hold the next document, waiting for a batch if none is buffered. Marks the
+    // cursor exhausted once every query has finished, and rethrows the first query error once the
+    // batches read before it have been consumed.
+    void advance();
+
+    // The body of a background thread: runs read() and records the error it throws, if any.
+    void run();
+
+    // Runs queries on one pooled client until none are left or the cursor stops.
+    void read();
+
+    // Waits for room in `ready` and queues a batch there. Returns false if the cursor stopped.
+    bool hand_over(cursor::batch next);
+
+    class pool* pool;
+    std::string database;
+    std::string collection;
+    class read_concern concern;
+    class read_preference preference;
+    options::find options;
+    std::size_t batch_size;
+    std::vector<bsoncxx::document::value> filters;
+    std::atomic<std::size_t> next_filter{0};
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<cursor::batch> ready;
+    std::size_t max_ready = 0;
+    std::size_t running = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+    std::vector<std::thread> threads;
+
+    // Only touched by the consuming thread.
+    cursor::batch batch;
+    std::size_t position = 0;
+    bsoncxx::document::view doc;
+    bool started = false;
+    bool exhausted = false;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
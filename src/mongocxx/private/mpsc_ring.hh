@@ -0,0 +1,129 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// A bounded ring buffer of `Cell`s that any number of producers fill and a single consumer drains,
+// as in Dmitry Vyukov's bounded queue. A producer claims a cell with a compare-and-swap on the
+// enqueue position, fills it in place and publishes it; the consumer reads the cell in place and
+// then frees it for the producer a lap later. Neither side takes a lock.
+//
+// The cells are default-constructed once, and are reused rather than destroyed as they are freed.
+//
+template <typename Cell>
+class mpsc_ring {
+   public:
+    // `capacity` is rounded up to a power of two, and to at least 2.
+    explicit mpsc_ring(std::size_t capacity)
+        : _slots{new slot[round_up_to_power_of_two(std::max<std::size_t>(capacity, 2))]},
+          _mask{round_up_to_power_of_two(std::max<std::size_t>(capacity, 2)) - 1} {
+        for (std::size_t i = 0; i <= _mask; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpsc_ring(const mpsc_ring&) = delete;
+    mpsc_ring& operator=(const mpsc_ring&) = delete;
+
+    // Claims the next cell for the calling producer and sets `position` for publish(). Returns
+    // nullptr if the consumer has not yet freed the cell a full lap ago.
+    Cell* try_claim(std::size_t* position) {
+        auto claimed = _enqueue_position.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& target = _slots[claimed & _mask];
+            auto sequence = target.sequence.load(std::memory_order_acquire);
+            auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(claimed);
+            if (difference == 0) {
+                if (_enqueue_position.compare_exchange_weak(
+                        claimed, claimed + 1, std::memory_order_relaxed)) {
+                    *position = claimed;
+                    return &target.value;
+                }
+            } else if (difference < 0) {
+                return nullptr;
+            } else {
+                claimed = _enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Hands the cell claimed at `position` to the consumer.
+    void publish(std::size_t position) {
+        _slots[position & _mask].sequence.store(position + 1, std::memory_order_release);
+    }
+
+    // The next published cell, or nullptr if there is none. Only the consumer may call this.
+    Cell* front() {
+        auto position = _dequeue_position.load(std::memory_order_relaxed);
+        auto& source = _slots[position & _mask];
+        if (source.sequence.load(std::memory_order_acquire) != position + 1) {
+            return nullptr;
+        }
+        return &source.value;
+    }
+
+    // Frees the cell returned by front(). Only the consumer may call this.
+    void pop_front() {
+        auto position = _dequeue_position.load(std::memory_order_relaxed);
+        _slots[position & _mask].sequence.store(position + _mask + 1, std::memory_order_release);
+        _dequeue_position.store(position + 1, std::memory_order_release);
+    }
+
+    // The number of cells claimed and freed so far, which producers may compare to wait for the
+    // consumer to catch up.
+    std::size_t claimed() const {
+        return _enqueue_position.load(std::memory_order_acquire);
+    }
+
+    std::size_t freed() const {
+        return _dequeue_position.load(std::memory_order_acquire);
+    }
+
+   private:
+    struct slot {
+        std::atomic<std::size_t> sequence;
+        Cell value;
+    };
+
+    static std::size_t round_up_to_power_of_two(std::size_t n) {
+        std::size_t power = 1;
+        while (power < n) {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    std::unique_ptr<slot[]> _slots;
+    const std::size_t _mask;
+
+    std::atomic<std::size_t> _enqueue_position{0};
+    std::atomic<std::size_t> _dequeue_position{0};
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
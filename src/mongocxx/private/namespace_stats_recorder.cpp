@@ -0,0 +1,294 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/namespace_stats_recorder.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+
+#include <bsoncxx/types.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using command_kind = namespace_stats_recorder::command_kind;
+
+std::uint64_t fnv1a(std::uint64_t hash, stdx::string_view bytes) {
+    for (auto c : bytes) {
+        hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::uint64_t key_hash(stdx::string_view database, stdx::string_view collection) {
+    // Hash a separator between the names, so that "a.bc" and "ab.c" differ.
+    return fnv1a(fnv1a(fnv1a(0xcbf29ce484222325ULL, database), "."), collection);
+}
+
+std::atomic<std::size_t> next_shard{0};
+
+struct pending_command {
+    const namespace_stats_recorder* recorder;
+    std::int64_t request_id;
+    namespace_stats_recorder::counters* counters;
+};
+
+// A thread has at most one command in flight per client, so this rarely holds more than one entry.
+thread_local std::vector<pending_command> pending_commands;
+
+command_kind kind_of(stdx::string_view command_name) {
+    static const std::pair<const char*, command_kind> kinds[] = {
+        {"find", command_kind::k_find},
+        {"getMore", command_kind::k_get_more},
+        {"aggregate", command_kind::k_aggregate},
+        {"insert", command_kind::k_insert},
+        {"update", command_kind::k_update},
+        {"delete", command_kind::k_delete},
+        {"findAndModify", command_kind::k_find_and_modify},
+    };
+
+    for (auto&& kind : kinds) {
+        if (command_name == stdx::string_view{kind.first}) {
+            return kind.second;
+        }
+    }
+    return command_kind::k_other;
+}
+
+std::uint64_t array_length(bsoncxx::document::element element) {
+    if (element.type() != bsoncxx::type::k_array) {
+        return 0;
+    }
+
+    std::uint64_t length = 0;
+    for (auto it = element.get_array().value.begin(); it != element.get_array().value.end(); ++it) {
+        length++;
+    }
+    return length;
+}
+
+std::uint64_t count_field(bsoncxx::document::view reply, stdx::string_view key) {
+    auto element = reply[key];
+    if (element.type() == bsoncxx::type::k_int32) {
+        return static_cast<std::uint64_t>(std::max(element.get_int32().value, 0));
+    }
+    if (element.type() == bsoncxx::type::k_int64) {
+        return static_cast<std::uint64_t>(std::max<std::int64_t>(element.get_int64().value, 0));
+    }
+    return 0;
+}
+
+std::uint64_t documents_returned(command_kind kind, bsoncxx::document::view reply) {
+    if (kind == command_kind::k_find_and_modify) {
+        auto value = reply["value"];
+        return value && value.type() == bsoncxx::type::k_document ? 1 : 0;
+    }
+
+    auto cursor = reply["cursor"];
+    if (cursor.type() != bsoncxx::type::k_document) {
+        return 0;
+    }
+    auto batch = cursor.get_document().value[kind == command_kind::k_get_more ? "nextBatch"
+                                                                               : "firstBatch"];
+    return array_length(batch);
+}
+
+std::uint64_t documents_written(command_kind kind, bsoncxx::document::view reply) {
+    switch (kind) {
+        case command_kind::k_insert:
+        case command_kind::k_delete:
+            return count_field(reply, "n");
+        case command_kind::k_update:
+            return count_field(reply, "nModified") + array_length(reply["upserted"]);
+        case command_kind::k_find_and_modify: {
+            auto last_error = reply["lastErrorObject"];
+            if (last_error.type() != bsoncxx::type::k_document) {
+                return 0;
+            }
+            return count_field(last_error.get_document().value, "n");
+        }
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+constexpr std::size_t namespace_stats_recorder::k_shards;
+constexpr std::size_t namespace_stats_recorder::k_slots;
+
+namespace_stats_recorder::counters::counters(std::uint64_t hash,
+                                             stdx::string_view database,
+                                             stdx::string_view collection)
+    : hash{hash},
+      database{database.data(), database.size()},
+      collection{collection.data(), collection.size()} {
+    for (auto&& count : commands) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+namespace_stats_recorder::namespace_stats_recorder() : _shards{new shard[k_shards]} {
+    for (std::size_t i = 0; i < k_shards; ++i) {
+        for (auto&& slot : _shards[i].slots) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+namespace_stats_recorder::~namespace_stats_recorder() {
+    for (std::size_t i = 0; i < k_shards; ++i) {
+        for (auto&& slot : _shards[i].slots) {
+            delete slot.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+namespace_stats_recorder::counters* namespace_stats_recorder::find_or_claim(
+    stdx::string_view database, stdx::string_view collection) {
+    // Threads are spread over the shards in the order they first record a command.
+    static thread_local const std::size_t thread_shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % k_shards;
+
+    auto hash = key_hash(database, collection);
+    auto& slots = _shards[thread_shard].slots;
+
+    std::unique_ptr<counters> fresh;
+    for (std::size_t probe = 0; probe < k_slots; ++probe) {
+        auto& slot = slots[(hash + probe) % k_slots];
+        auto entry = slot.load(std::memory_order_acquire);
+        if (!entry) {
+            if (!fresh) {
+                fresh.reset(new counters{hash, database, collection});
+            }
+            if (slot.compare_exchange_strong(entry, fresh.get(), std::memory_order_acq_rel)) {
+                entry = fresh.release();
+            }
+        }
+
+        if (entry->hash == hash && entry->database == database &&
+            entry->collection == collection) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void namespace_stats_recorder::started(std::int64_t request_id,
+                                       stdx::string_view database,
+                                       stdx::string_view command_name,
+                                       bsoncxx::document::view command) {
+    // The value of the command name is the collection for the commands that have one; getMore
+    // names its collection separately.
+    auto name = command[command_name];
+    if (command_name == stdx::string_view{"getMore"}) {
+        name = command["collection"];
+    }
+    stdx::string_view collection;
+    if (name.type() == bsoncxx::type::k_utf8) {
+        collection = name.get_utf8().value;
+    }
+
+    auto entry = find_or_claim(database, collection);
+    if (!entry) {
+        return;
+    }
+
+    entry->commands[kind_of(command_name)].fetch_add(1, std::memory_order_relaxed);
+    entry->command_bytes.fetch_add(command.length(), std::memory_order_relaxed);
+    pending_commands.push_back({this, request_id, entry});
+}
+
+void namespace_stats_recorder::completed(std::int64_t request_id,
+                                         stdx::string_view command_name,
+                                         bsoncxx::document::view reply,
+                                         bool succeeded) {
+    for (auto it = pending_commands.rbegin(); it != pending_commands.rend(); ++it) {
+        if (it->recorder != this || it->request_id != request_id) {
+            continue;
+        }
+
+        auto entry = it->counters;
+        pending_commands.erase(std::next(it).base());
+
+        entry->reply_bytes.fetch_add(reply.length(), std::memory_order_relaxed);
+        if (!succeeded) {
+            entry->failures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto kind = kind_of(command_name);
+        entry->documents_returned.fetch_add(documents_returned(kind, reply),
+                                            std::memory_order_relaxed);
+        entry->documents_written.fetch_add(documents_written(kind, reply),
+                                           std::memory_order_relaxed);
+        return;
+    }
+}
+
+std::vector<events::namespace_stats> namespace_stats_recorder::snapshot() const {
+    std::map<std::pair<std::string, std::string>, events::namespace_stats> merged;
+
+    for (std::size_t i = 0; i < k_shards; ++i) {
+        for (auto&& slot : _shards[i].slots) {
+            auto entry = slot.load(std::memory_order_acquire);
+            if (!entry) {
+                continue;
+            }
+
+            auto key = std::make_pair(entry->database, entry->collection);
+            auto found = merged.find(key);
+            if (found == merged.end()) {
+                events::namespace_stats stats{};
+                stats.database = entry->database;
+                stats.collection = entry->collection;
+                found = merged.emplace(std::move(key), std::move(stats)).first;
+            }
+
+            auto& stats = found->second;
+            auto load = [](const std::atomic<std::uint64_t>& count) {
+                return count.load(std::memory_order_relaxed);
+            };
+            stats.finds += load(entry->commands[k_find]);
+            stats.get_mores += load(entry->commands[k_get_more]);
+            stats.aggregates += load(entry->commands[k_aggregate]);
+            stats.inserts += load(entry->commands[k_insert]);
+            stats.updates += load(entry->commands[k_update]);
+            stats.deletes += load(entry->commands[k_delete]);
+            stats.find_and_modifies += load(entry->commands[k_find_and_modify]);
+            stats.other_commands += load(entry->commands[k_other]);
+            stats.failures += load(entry->failures);
+            stats.documents_returned += load(entry->documents_returned);
+            stats.documents_written += load(entry->documents_written);
+            stats.command_bytes += load(entry->command_bytes);
+            stats.reply_bytes += load(entry->reply_bytes);
+        }
+    }
+
+    std::vector<events::namespace_stats> stats;
+    stats.reserve(merged.size());
+    for (auto&& pair : merged) {
+        stats.push_back(std::move(pair.second));
+    }
+    return stats;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
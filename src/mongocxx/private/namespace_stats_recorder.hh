@@ -0,0 +1,113 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/events/namespace_stats.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Counts the commands run against each collection, for options::apm::record_namespace_stats().
+//
+// As in command_latency_recorder, every thread is assigned one of a fixed number of shards, each
+// an open-addressed table of counters whose slots are claimed with a compare-and-swap the first
+// time a namespace is seen, and snapshot() merges the shards. started() remembers the counters of
+// the command in a thread-local list, since only the started event names the collection, and
+// libmongoc reports the completion of a command on the thread that started it.
+//
+class MONGOCXX_TEST_API namespace_stats_recorder {
+   public:
+    namespace_stats_recorder();
+
+    namespace_stats_recorder(const namespace_stats_recorder&) = delete;
+    namespace_stats_recorder& operator=(const namespace_stats_recorder&) = delete;
+
+    ~namespace_stats_recorder();
+
+    void started(std::int64_t request_id,
+                 stdx::string_view database,
+                 stdx::string_view command_name,
+                 bsoncxx::document::view command);
+
+    // The reply may be empty, as for a command that failed without reaching the server.
+    void completed(std::int64_t request_id,
+                   stdx::string_view command_name,
+                   bsoncxx::document::view reply,
+                   bool succeeded);
+
+    // Returns the merged counts, sorted by database and collection. Counters are read one by one
+    // while other threads may be recording, so a snapshot need not be exactly consistent.
+    std::vector<events::namespace_stats> snapshot() const;
+
+    enum command_kind : std::size_t {
+        k_find,
+        k_get_more,
+        k_aggregate,
+        k_insert,
+        k_update,
+        k_delete,
+        k_find_and_modify,
+        k_other,
+        k_command_kinds,
+    };
+
+    struct counters {
+        counters(std::uint64_t hash, stdx::string_view database, stdx::string_view collection);
+
+        const std::uint64_t hash;
+        const std::string database;
+        const std::string collection;
+
+        std::atomic<std::uint64_t> commands[k_command_kinds];
+        std::atomic<std::uint64_t> failures{0};
+        std::atomic<std::uint64_t> documents_returned{0};
+        std::atomic<std::uint64_t> documents_written{0};
+        std::atomic<std::uint64_t> command_bytes{0};
+        std::atomic<std::uint64_t> reply_bytes{0};
+    };
+
+   private:
+    static constexpr std::size_t k_shards = 8;
+
+    // The most distinct namespaces recorded by a shard. Later namespaces are dropped.
+    static constexpr std::size_t k_slots = 512;
+
+    counters* find_or_claim(stdx::string_view database, stdx::string_view collection);
+
+    struct shard {
+        std::atomic<counters*> slots[k_slots];
+    };
+
+    std::unique_ptr<shard[]> _shards;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,86 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/numa.hh>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace numa {
+
+std::size_t count_from_node_list(const std::string& list) {
+    std::size_t highest = 0;
+    bool any = false;
+    std::size_t value = 0;
+    bool in_number = false;
+
+    for (auto c : list) {
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            value = value * 10 + static_cast<std::size_t>(c - '0');
+            in_number = true;
+        } else if (c == '-' || c == ',' || std::isspace(static_cast<unsigned char>(c))) {
+            if (in_number) {
+                highest = std::max(highest, value);
+                any = true;
+            }
+            value = 0;
+            in_number = false;
+        } else {
+            return 1;
+        }
+    }
+    if (in_number) {
+        highest = std::max(highest, value);
+        any = true;
+    }
+
+    return any ? highest + 1 : 1;
+}
+
+std::size_t node_count() {
+    static const std::size_t count = [] {
+        std::ifstream online{"/sys/devices/system/node/online"};
+        std::string list;
+        if (!std::getline(online, list)) {
+            return std::size_t{1};
+        }
+        return count_from_node_list(list);
+    }();
+    return count;
+}
+
+std::size_t current_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < node_count()) {
+        return node;
+    }
+#endif
+    return 0;
+}
+
+}  // namespace numa
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,48 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace numa {
+
+//
+// Returns the number of NUMA nodes of the host, or 1 where the platform does not report them.
+//
+std::size_t node_count();
+
+//
+// Returns the NUMA node of the CPU running the calling thread, below node_count().
+//
+std::size_t current_node();
+
+//
+// Parses a node list of the form of /sys/devices/system/node/online, e.g. "0-1,3", and returns
+// one more than the highest node it names, or 1 if it cannot be parsed.
+//
+MONGOCXX_TEST_API std::size_t count_from_node_list(const std::string& list);
+
+}  // namespace numa
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,63 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/operation_accounting.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+thread_local operation_accounting* current_accounting = nullptr;
+
+}  // namespace
+
+operation_accounting::operation_accounting(operation_counters* counters)
+    : _counters{counters}, _enclosing{current_accounting} {
+    current_accounting = this;
+}
+
+operation_accounting::~operation_accounting() {
+    current_accounting = _enclosing;
+
+    if (_counters) {
+        _counters->add(_stats);
+    } else if (_enclosing) {
+        add_operation_stats(&_enclosing->_stats, _stats);
+    }
+}
+
+const operation_stats& operation_accounting::stats() const {
+    return _stats;
+}
+
+void operation_accounting::command_started(std::size_t command_bytes) {
+    if (current_accounting) {
+        current_accounting->_stats.bytes_sent += command_bytes;
+        current_accounting->_stats.round_trips++;
+    }
+}
+
+void operation_accounting::command_completed(std::size_t reply_bytes,
+                                             std::int64_t duration_microseconds) {
+    if (current_accounting) {
+        current_accounting->_stats.bytes_received += reply_bytes;
+        current_accounting->_stats.duration += std::chrono::microseconds{duration_microseconds};
+    }
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,97 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <mongocxx/operation_stats.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Statistics that a background thread adds to while another thread reads them, such as those of
+// a prefetching cursor.
+//
+struct operation_counters {
+    operation_stats load() const {
+        operation_stats stats;
+        stats.bytes_sent = bytes_sent.load(std::memory_order_relaxed);
+        stats.bytes_received = bytes_received.load(std::memory_order_relaxed);
+        stats.round_trips = round_trips.load(std::memory_order_relaxed);
+        stats.duration = std::chrono::microseconds{
+            static_cast<std::int64_t>(duration.load(std::memory_order_relaxed))};
+        return stats;
+    }
+
+    void add(const operation_stats& stats) {
+        bytes_sent.fetch_add(stats.bytes_sent, std::memory_order_relaxed);
+        bytes_received.fetch_add(stats.bytes_received, std::memory_order_relaxed);
+        round_trips.fetch_add(stats.round_trips, std::memory_order_relaxed);
+        duration.fetch_add(static_cast<std::uint64_t>(stats.duration.count()),
+                           std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> bytes_sent{0};
+    std::atomic<std::uint64_t> bytes_received{0};
+    std::atomic<std::uint64_t> round_trips{0};
+    std::atomic<std::uint64_t> duration{0};
+};
+
+inline void add_operation_stats(operation_stats* total, const operation_stats& stats) {
+    total->bytes_sent += stats.bytes_sent;
+    total->bytes_received += stats.bytes_received;
+    total->round_trips += stats.round_trips;
+    total->duration += stats.duration;
+}
+
+//
+// Counts the commands run on the calling thread while it is alive. libmongoc sends the APM events
+// of a command on the thread that runs it, so the callbacks of options::apm::record_operation_stats
+// add to the innermost accounting of that thread.
+//
+// When an accounting ends, its statistics are added to `counters`, if given, or else to the
+// enclosing accounting of the thread, if any.
+//
+class MONGOCXX_TEST_API operation_accounting {
+   public:
+    explicit operation_accounting(operation_counters* counters = nullptr);
+
+    ~operation_accounting();
+
+    operation_accounting(const operation_accounting&) = delete;
+    operation_accounting& operator=(const operation_accounting&) = delete;
+
+    const operation_stats& stats() const;
+
+    // Called by the APM callbacks with the size of a command and of its reply.
+    static void command_started(std::size_t command_bytes);
+    static void command_completed(std::size_t reply_bytes, std::int64_t duration_microseconds);
+
+   private:
+    operation_stats _stats;
+    operation_counters* const _counters;
+    operation_accounting* const _enclosing;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,136 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/operation_timer.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+std::atomic<std::size_t> registrations{0};
+
+struct thread_timings {
+    // The operation being timed, if `timing`.
+    bool timing = false;
+    operation_timer::clock::time_point start;
+    operation_timings current;
+
+    // The libmongoc call in progress, if `in_call`: whether it has sent a command yet, and when
+    // its last event happened.
+    bool in_call = false;
+    bool sent = false;
+    operation_timer::clock::time_point mark;
+
+    operation_timings last;
+};
+
+thread_local thread_timings timings;
+
+std::chrono::nanoseconds between(operation_timer::clock::time_point start,
+                                 operation_timer::clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+}
+
+}  // namespace
+
+operation_timer::operation_timer()
+    : _active{!timings.timing && registrations.load(std::memory_order_relaxed) > 0} {
+    if (_active) {
+        timings.timing = true;
+        timings.current = operation_timings{};
+        timings.start = clock::now();
+    }
+}
+
+operation_timer::~operation_timer() {
+    if (_active) {
+        timings.current.total = between(timings.start, clock::now());
+        timings.last = timings.current;
+        timings.timing = false;
+    }
+}
+
+operation_timer::scoped_phase::scoped_phase(phase phase)
+    : _phase{phase},
+      _active{timings.timing},
+      _start{_active ? clock::now() : clock::time_point{}} {}
+
+operation_timer::scoped_phase::~scoped_phase() {
+    if (!_active) {
+        return;
+    }
+    auto elapsed = between(_start, clock::now());
+    if (_phase == phase::k_serialize) {
+        timings.current.serialize += elapsed;
+    } else {
+        timings.current.result += elapsed;
+    }
+}
+
+operation_timer::libmongoc_call::libmongoc_call() : _active{timings.timing && !timings.in_call} {
+    if (_active) {
+        timings.in_call = true;
+        timings.sent = false;
+        timings.mark = clock::now();
+    }
+}
+
+operation_timer::libmongoc_call::~libmongoc_call() {
+    if (_active) {
+        timings.current.reply_parse += between(timings.mark, clock::now());
+        timings.in_call = false;
+    }
+}
+
+void operation_timer::command_started() {
+    if (!timings.in_call) {
+        return;
+    }
+    auto now = clock::now();
+    if (timings.sent) {
+        timings.current.reply_parse += between(timings.mark, now);
+    } else {
+        timings.current.dispatch += between(timings.mark, now);
+        timings.sent = true;
+    }
+    timings.current.commands++;
+    timings.mark = now;
+}
+
+void operation_timer::command_completed() {
+    if (!timings.in_call) {
+        return;
+    }
+    auto now = clock::now();
+    timings.current.round_trip += between(timings.mark, now);
+    timings.mark = now;
+}
+
+operation_timer::registration::registration() {
+    registrations.fetch_add(1, std::memory_order_relaxed);
+}
+
+operation_timer::registration::~registration() {
+    registrations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+const operation_timings& operation_timer::last() {
+    return timings.last;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,112 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include <mongocxx/operation_timings.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Times the phases of the operation running on the calling thread for last_operation_timings().
+//
+// An operation is only timed while a registration exists, and an operation started while another
+// is being timed on the same thread is part of the enclosing one. libmongoc sends the APM events
+// of a command on the thread that runs it, so command_started() and command_completed() split the
+// time of the enclosing libmongoc_call.
+//
+class MONGOCXX_TEST_API operation_timer {
+   public:
+    using clock = std::chrono::steady_clock;
+
+    operation_timer();
+
+    ~operation_timer();
+
+    operation_timer(const operation_timer&) = delete;
+    operation_timer& operator=(const operation_timer&) = delete;
+
+    enum class phase { k_serialize, k_result };
+
+    //
+    // Adds the time until its destruction to a phase of the operation being timed, if any.
+    //
+    class MONGOCXX_TEST_API scoped_phase {
+       public:
+        explicit scoped_phase(phase phase);
+
+        ~scoped_phase();
+
+        scoped_phase(const scoped_phase&) = delete;
+        scoped_phase& operator=(const scoped_phase&) = delete;
+
+       private:
+        phase _phase;
+        bool _active;
+        clock::time_point _start;
+    };
+
+    //
+    // Splits the time until its destruction into dispatch, round_trip and reply_parse.
+    //
+    class MONGOCXX_TEST_API libmongoc_call {
+       public:
+        libmongoc_call();
+
+        ~libmongoc_call();
+
+        libmongoc_call(const libmongoc_call&) = delete;
+        libmongoc_call& operator=(const libmongoc_call&) = delete;
+
+       private:
+        bool _active;
+    };
+
+    // Called by the APM callbacks when a command is sent and when its reply arrives.
+    static void command_started();
+    static void command_completed();
+
+    //
+    // Enables the timing of operations on every thread while it exists. Held by the clients and
+    // pools created with options::apm::record_operation_timings().
+    //
+    class MONGOCXX_TEST_API registration {
+       public:
+        registration();
+
+        ~registration();
+
+        registration(const registration&) = delete;
+        registration& operator=(const registration&) = delete;
+    };
+
+    // The timings of the last operation timed on the calling thread.
+    static const operation_timings& last();
+
+   private:
+    bool _active;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -14,8 +14,13 @@
 
 #pragma once
 
+#include <utility>
+
+#include <bsoncxx/array/value.hpp>
 #include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/stdx/optional.hpp>
 #include <mongocxx/pipeline.hpp>
+#include <mongocxx/stdx.hpp>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -24,23 +29,36 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 class pipeline::impl {
    public:
+    impl() = default;
+
+    // Adopts stages that were serialized elsewhere, e.g. by pipeline_template::bind(). They are
+    // only copied into the builder if more stages are appended.
+    explicit impl(bsoncxx::array::value stages) : _stages(std::move(stages)) {}
+
     bsoncxx::builder::basic::array& sink() {
+        if (_stages) {
+            for (auto&& stage : _stages->view()) {
+                _builder.append(stage.get_document().value);
+            }
+            _stages = stdx::nullopt;
+        }
         return _builder;
     }
 
     bsoncxx::array::view view_array() {
-        return _builder.view();
+        return _stages ? _stages->view() : _builder.view();
     }
 
     ///
     /// view() is deprecated. Use view_array() instead.
     ///
     bsoncxx::document::view view() {
-        return _builder.view();
+        return view_array();
     }
 
    private:
     bsoncxx::builder::basic::array _builder;
+    stdx::optional<bsoncxx::array::value> _stages;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
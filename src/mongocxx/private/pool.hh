@@ -14,11 +14,27 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include <mongocxx/client.hpp>
 #include <mongocxx/pool.hpp>
+#include <mongocxx/options/private/apm_context.hh>
+#include <mongocxx/private/count_cache.hh>
+#include <mongocxx/private/group_commit.hh>
 #include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/reply_budget.hh>
+#include <mongocxx/private/stream_initiator.hh>
 
 #include <mongocxx/config/private/prelude.hh>
 
@@ -27,15 +43,167 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 
 class pool::impl {
    public:
-    impl(mongoc_client_pool_t* pool) : client_pool_t(pool) {}
+    impl(mongoc_client_pool_t* pool);
 
-    ~impl() {
-        libmongoc::client_pool_destroy(client_pool_t);
-    }
+    ~impl();
+
+    // Takes a client from the calling thread's slot or NUMA partition or the shared queue, blocking
+    // until one is available if `blocking`. Returns null if `blocking` is false and no client is
+    // available.
+    mongoc_client_t* pop(bool blocking);
+
+    // Like pop(true), but gives up and returns null once `deadline` has passed.
+    mongoc_client_t* pop_until(std::chrono::steady_clock::time_point deadline);
+
+    // Returns a client to the calling thread's slot or NUMA partition or the shared queue.
+    void push(mongoc_client_t* client);
+
+    // Destroys idle clients until at most `idle` remain; see pool::shrink_to.
+    void shrink_to(std::size_t idle);
+
+    // Returns a client to libmongoc's queue and wakes a thread waiting in pop_until().
+    void push_shared(mongoc_client_t* client);
+
+    // Starts the thread which shrinks the pool every `max_idle_time` to the number of clients
+    // idle after being in use at the peak of the interval.
+    void start_reaper(std::chrono::milliseconds max_idle_time);
+
+    // The client parked by one thread of a pool with options::pool::thread_affinity.
+    struct affinity_slot {
+        std::atomic<mongoc_client_t*> client{nullptr};
+
+        // Guards pool_t, which is reset once the pool or the thread owning the slot is gone.
+        std::mutex mutex;
+        mongoc_client_pool_t* pool_t;
+
+        // Returns the parked client, if any, to the shared queue and detaches the slot.
+        void close();
+
+        // Whether close() was called, by the pool or by the thread.
+        bool closed();
+    };
+
+    // The idle clients released by the threads of one NUMA node of a pool with
+    // options::pool::numa_partitions.
+    struct numa_partition {
+        std::mutex mutex;
+        std::vector<mongoc_client_t*> clients;
+
+        // Takes the most recently released client, or returns null if there is none.
+        mongoc_client_t* take();
+    };
 
     mongoc_client_pool_t* client_pool_t;
     std::list<bsoncxx::string::view_or_value> tls_options;
-    options::apm listeners;
+    options::apm_context apm;
+
+    // Applies the socket options and stream initiator of the pool to each client it hands out.
+    std::unique_ptr<stream_initiator> streams;
+
+    // Client objects released back to the pool, kept so that acquiring a client rewraps a pooled
+    // mongoc_client_t rather than allocating a new client. Their client_t is null while idle.
+    std::mutex idle_clients_mutex;
+    std::vector<std::unique_ptr<client>> idle_clients;
+
+    bool thread_affinity = false;
+
+    // A partition per NUMA node, or none if the pool is not partitioned.
+    std::vector<std::unique_ptr<numa_partition>> partitions;
+
+    // The GridFS index cache shared by every client of the pool.
+    std::shared_ptr<gridfs::index_cache> gridfs_indexes = std::make_shared<gridfs::index_cache>();
+
+    // The count cache shared by every client of the pool.
+    std::shared_ptr<count_cache> counts = std::make_shared<count_cache>();
+
+    // The insert groups shared by every client of the pool.
+    std::shared_ptr<group_commit> group_commits = std::make_shared<group_commit>();
+
+    // The reply budget shared by every client of the pool.
+    std::shared_ptr<reply_budget> replies = std::make_shared<reply_budget>();
+
+    // The waitQueueTimeoutMS of the pool's URI, or zero to wait without limit.
+    std::chrono::milliseconds wait_queue_timeout{0};
+
+    // The minPoolSize of the pool's URI, which shrink_to() restores after trimming the idle
+    // clients.
+    std::uint32_t min_pool_size = 0;
+
+    options::pool::checkout_observer_type checkout_observer;
+
+    // The executor of options::pool::executor(), if any.
+    std::shared_ptr<class executor> executor;
+
+    // The counters behind pool::stats(). Durations are in nanoseconds.
+    struct counters {
+        using histogram = std::array<std::atomic<std::uint64_t>, statistics::k_histogram_buckets>;
+
+        std::atomic<std::uint64_t> acquires{0};
+        std::atomic<std::uint64_t> in_use{0};
+        std::atomic<std::uint64_t> try_acquire_failures{0};
+        std::atomic<std::uint64_t> saturation_events{0};
+        std::atomic<std::uint64_t> total_wait_time{0};
+        std::atomic<std::uint64_t> max_wait_time{0};
+        histogram wait_time_histogram{};
+        std::atomic<std::uint64_t> total_hold_time{0};
+        std::atomic<std::uint64_t> max_hold_time{0};
+        histogram hold_time_histogram{};
+    };
+
+    counters stats;
+
+    // The most clients in use at once since the reaper last shrank the pool.
+    std::atomic<std::uint64_t> peak_in_use{0};
+
+   private:
+    affinity_slot& local_slot();
+
+    // Whether released clients are parked in slots or partitions rather than the shared queue.
+    bool parks_clients() const;
+
+    // Takes a client parked by any thread, or returns null if none is parked.
+    mongoc_client_t* steal_parked();
+
+    // Accounts for a client taken from libmongoc's queue.
+    void popped_shared();
+
+    // Accounts for `count` clients pushed to libmongoc's queue while its minimum size, if not zero,
+    // was `min_size`.
+    void add_shared_idle(std::size_t count, std::uint32_t min_size);
+
+    // Wakes one, or `all`, of the threads waiting in pop_until().
+    void signal_release(bool all);
+
+    // Identifies this pool in the thread-local tables of slots; unlike the address of the pool, it
+    // is never reused.
+    const std::uint64_t _id;
+
+    // The number of threads blocked waiting for the shared queue. Releases do not park clients
+    // while it is positive, so that a parked client can never starve a waiting thread.
+    std::atomic<std::size_t> _waiters{0};
+
+    // Threads in pop_until() wait on _released rather than in libmongoc, which offers no timed
+    // wait for a single call. _releases counts the pushes made while any such thread is waiting.
+    std::atomic<std::size_t> _timed_waiters{0};
+    std::mutex _release_mutex;
+    std::condition_variable _released;
+    std::uint64_t _releases = 0;
+
+    std::mutex _slots_mutex;
+    std::vector<std::shared_ptr<affinity_slot>> _slots;
+
+    // The clients pushed to libmongoc's queue and not taken back, less those libmongoc destroyed
+    // to keep to its minimum size. shrink_to() takes no more than this many from the queue, so
+    // that it never makes libmongoc create a client.
+    std::atomic<std::size_t> _shared_idle{0};
+
+    // Serializes shrink_to(), which changes the minimum size of the libmongoc pool while it runs.
+    std::mutex _shrink_mutex;
+
+    std::thread _reaper;
+    std::mutex _reaper_mutex;
+    std::condition_variable _reaper_stop;
+    bool _reaper_stopping = false;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
@@ -0,0 +1,57 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/prepared_find.hpp>
+#include <mongocxx/private/document_template.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class prepared_find::impl {
+   public:
+    impl(const class collection& collection,
+         bsoncxx::document::view filter,
+         bsoncxx::document::value options_document,
+         const options::find& options)
+        : collection(collection),
+          filter(filter, &names),
+          options_document(std::move(options_document)),
+          options(options) {}
+
+    std::vector<std::string> names;
+    class collection collection;
+    document_template filter;
+
+    // The options as passed to libmongoc; options itself is kept for those that are applied to
+    // the cursor instead.
+    bsoncxx::document::value options_document;
+    options::find options;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,86 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/prepared_find_one_and_update.hpp>
+#include <mongocxx/private/document_template.hh>
+#include <mongocxx/private/libmongoc.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class prepared_find_one_and_update::impl {
+   public:
+    // The fields of the findAndModify command other than its query and update. `extra` holds
+    // those libmongoc takes as a document, such as the write concern and the collation.
+    struct command_options {
+        bsoncxx::document::value extra{bsoncxx::document::view{}};
+        stdx::optional<bsoncxx::document::value> sort;
+        stdx::optional<bsoncxx::document::value> projection;
+        stdx::optional<std::chrono::milliseconds> max_time;
+        mongoc_find_and_modify_flags_t flags = MONGOC_FIND_AND_MODIFY_NONE;
+        bool bypass_document_validation = false;
+    };
+
+    impl(const class collection& collection,
+         bsoncxx::document::view filter,
+         bsoncxx::document::view update,
+         command_options options)
+        : collection(collection),
+          filter(filter, &names),
+          update(update, &names),
+          _options(std::move(options)) {}
+
+    // Returns the libmongoc options for an execution as part of the session whose lsid document is
+    // `session_document`, or of no session. They are built on first use and kept until an
+    // execution uses another session. The update is set by the caller for every execution.
+    mongoc_find_and_modify_opts_t* opts_for(
+        stdx::optional<bsoncxx::document::view> session_document);
+
+    std::vector<std::string> names;
+    class collection collection;
+    document_template filter;
+    document_template update;
+
+   private:
+    using unique_opts = std::unique_ptr<mongoc_find_and_modify_opts_t,
+                                        void (*)(mongoc_find_and_modify_opts_t*)>;
+
+    unique_opts make_opts(stdx::optional<bsoncxx::document::view> session_document) const;
+
+    const command_options _options;
+
+    unique_opts _opts{nullptr, nullptr};
+
+    // The options for the session whose lsid document is `_session_document`.
+    unique_opts _session_opts{nullptr, nullptr};
+    bsoncxx::document::value _session_document{bsoncxx::document::view{}};
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,71 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/profiler_markers.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace profiler_markers {
+
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+
+namespace {
+
+__itt_domain* domain() {
+    static __itt_domain* const mongocxx_domain = __itt_domain_create("mongocxx");
+    return mongocxx_domain;
+}
+
+}  // namespace
+
+phase::phase(const char* name) : name{name}, handle{__itt_string_handle_create(name)} {}
+
+scoped_phase::scoped_phase(const phase& phase) {
+    __itt_task_begin(domain(), __itt_null, __itt_null, phase.handle);
+}
+
+scoped_phase::~scoped_phase() {
+    __itt_task_end(domain());
+}
+
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+
+phase::phase(const char* name) : name{name}, location{name, name, __FILE__, __LINE__, 0} {}
+
+scoped_phase::scoped_phase(const phase& phase)
+    : _zone{___tracy_emit_zone_begin(&phase.location, 1)} {}
+
+scoped_phase::~scoped_phase() {
+    ___tracy_emit_zone_end(_zone);
+}
+
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+
+phase::phase(const char* name) : name{name} {}
+
+scoped_phase::scoped_phase(const phase& phase) : _name{phase.name} {
+    DTRACE_PROBE1(mongocxx, phase_begin, _name);
+}
+
+scoped_phase::~scoped_phase() {
+    DTRACE_PROBE1(mongocxx, phase_end, _name);
+}
+
+#endif
+
+}  // namespace profiler_markers
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,92 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mongocxx/config/private/prelude.hh>
+
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+#include <ittnotify.h>
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+#include <TracyC.h>
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+#include <sys/sdt.h>
+#endif
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace profiler_markers {
+
+//
+// Markers for the phases of an operation, emitted for the profiler selected by the
+// MONGOCXX_PROFILER_MARKERS build option: ITT tasks for VTune, Tracy zones, or SDT probes for
+// perf (sdt_mongocxx:phase_begin and sdt_mongocxx:phase_end, whose argument is the phase name).
+// Without the option, MONGOCXX_PROFILER_PHASE expands to nothing.
+//
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT) || defined(MONGOCXX_PROFILER_MARKERS_TRACY) || \
+    defined(MONGOCXX_PROFILER_MARKERS_SDT)
+
+//
+// A named phase. Each call site of MONGOCXX_PROFILER_PHASE creates its phase once, since the
+// profilers expect their handles to live for the rest of the program.
+//
+struct phase {
+    explicit phase(const char* name);
+
+    const char* name;
+#if defined(MONGOCXX_PROFILER_MARKERS_ITT)
+    __itt_string_handle* handle;
+#elif defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+    ___tracy_source_location_data location;
+#endif
+};
+
+//
+// Marks a phase on the calling thread from its construction to its destruction.
+//
+class scoped_phase {
+   public:
+    explicit scoped_phase(const phase& phase);
+
+    ~scoped_phase();
+
+    scoped_phase(const scoped_phase&) = delete;
+    scoped_phase& operator=(const scoped_phase&) = delete;
+
+   private:
+#if defined(MONGOCXX_PROFILER_MARKERS_TRACY)
+    TracyCZoneCtx _zone;
+#elif defined(MONGOCXX_PROFILER_MARKERS_SDT)
+    const char* _name;
+#endif
+};
+
+// Marks the rest of the enclosing scope as the phase `name`, which must be a string literal.
+#define MONGOCXX_PROFILER_PHASE(name)                                                  \
+    static const ::mongocxx::profiler_markers::phase mongocxx_profiler_phase_site{name}; \
+    const ::mongocxx::profiler_markers::scoped_phase mongocxx_profiler_phase {           \
+        mongocxx_profiler_phase_site                                                     \
+    }
+
+#else
+
+#define MONGOCXX_PROFILER_PHASE(name) static_cast<void>(0)
+
+#endif
+
+}  // namespace profiler_markers
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,86 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/query_shape_recorder.hh>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include <mongocxx/private/slow_command_log.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+query_shape_recorder::query_shape_recorder(std::size_t capacity) : _capacity(capacity) {}
+
+void query_shape_recorder::started(stdx::string_view database,
+                                   stdx::string_view command_name,
+                                   bsoncxx::document::view command) {
+    auto filter = command_filter(command_name, command);
+    auto collection = command_collection(command_name, command);
+    if (filter.empty() || collection.empty()) {
+        return;
+    }
+
+    auto shape = filter_shape(filter);
+
+    std::string key;
+    key.reserve(database.size() + collection.size() + shape.view().length() + 2);
+    key.append(database.data(), database.size());
+    key.push_back('\0');
+    key.append(collection.data(), collection.size());
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(shape.view().data()), shape.view().length());
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _shapes.find(key);
+    if (it != _shapes.end()) {
+        it->second.count++;
+        return;
+    }
+    if (_shapes.size() == _capacity) {
+        return;
+    }
+    _shapes.emplace(std::move(key),
+                    events::query_shape{
+                        std::string{database}, std::string{collection}, std::move(shape), 1});
+}
+
+std::vector<events::query_shape> query_shape_recorder::snapshot() const {
+    std::vector<events::query_shape> shapes;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        shapes.reserve(_shapes.size());
+        for (auto&& entry : _shapes) {
+            shapes.push_back(entry.second);
+        }
+    }
+
+    std::stable_sort(shapes.begin(),
+                     shapes.end(),
+                     [](const events::query_shape& a, const events::query_shape& b) {
+                         if (a.count != b.count) {
+                             return a.count > b.count;
+                         }
+                         return std::tie(a.database, a.collection) <
+                                std::tie(b.database, b.collection);
+                     });
+    return shapes;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,65 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/events/query_shape.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Counts the filter shapes run against each collection, for options::apm::record_query_shapes().
+// Only the started event is needed. Commands without a filter, such as getMore and insert, are
+// not counted, and once `capacity` distinct shapes are kept, new shapes are dropped.
+//
+class MONGOCXX_TEST_API query_shape_recorder {
+   public:
+    explicit query_shape_recorder(std::size_t capacity);
+
+    query_shape_recorder(const query_shape_recorder&) = delete;
+    query_shape_recorder& operator=(const query_shape_recorder&) = delete;
+
+    void started(stdx::string_view database,
+                 stdx::string_view command_name,
+                 bsoncxx::document::view command);
+
+    // Returns the shapes kept, most frequent first.
+    std::vector<events::query_shape> snapshot() const;
+
+   private:
+    const std::size_t _capacity;
+
+    mutable std::mutex _mutex;
+
+    // Keyed by the database, the collection and the bytes of the shape, separated by NULs.
+    std::unordered_map<std::string, events::query_shape> _shapes;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
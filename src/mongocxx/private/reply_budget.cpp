@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/reply_budget.hh>
+
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+reply_budget::reply_budget(std::size_t max_bytes) : _max_bytes{max_bytes} {}
+
+std::shared_ptr<reply_budget> reply_budget::make(const stdx::optional<std::int64_t>& max_bytes) {
+    if (!max_bytes) {
+        return std::make_shared<reply_budget>();
+    }
+    if (*max_bytes <= 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "positive value required for max_buffered_reply_bytes"};
+    }
+    return std::make_shared<reply_budget>(static_cast<std::size_t>(*max_bytes));
+}
+
+void reply_budget::acquire(std::size_t bytes, const std::function<bool()>& stop_waiting) {
+    std::unique_lock<std::mutex> lock{_mutex};
+    if (_max_bytes != 0) {
+        _released.wait(lock, [&] {
+            return _used == 0 || _used + bytes <= _max_bytes || stop_waiting();
+        });
+    }
+    _used += bytes;
+}
+
+void reply_budget::release(std::size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _used -= bytes;
+    }
+    _released.notify_all();
+}
+
+void reply_budget::wake() {
+    // Taking the lock orders this call after any check of `stop_waiting` already under way, so
+    // that a waiter cannot miss the change that led to the call.
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+    }
+    _released.notify_all();
+}
+
+std::size_t reply_budget::used() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _used;
+}
+
+std::size_t reply_budget::max_bytes() const {
+    return _max_bytes;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
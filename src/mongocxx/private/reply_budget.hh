@@ -0,0 +1,80 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Counts the bytes of the replies buffered by the prefetching cursors and change streams of a
+// client, or of every client of a pool; see options::client::max_buffered_reply_bytes. A
+// prefetching thread counts each batch it read before handing it over, and waits while the batches
+// of the others hold too much of the budget, which delays its next getMore. The consumer releases
+// a batch once it moved past it.
+//
+// A batch is admitted whenever nothing else is buffered, so a batch larger than the whole budget
+// does not stall. The caller decides when waiting must end regardless: a cursor whose consumer has
+// nothing left to read always gets its next batch, so that no cursor waits for another that the
+// application is not reading.
+//
+class MONGOCXX_TEST_API reply_budget {
+   public:
+    // A budget of `max_bytes`, or one that only counts if `max_bytes` is 0.
+    explicit reply_budget(std::size_t max_bytes = 0);
+
+    // The budget of options::client::max_buffered_reply_bytes, which must be positive if set.
+    static std::shared_ptr<reply_budget> make(const stdx::optional<std::int64_t>& max_bytes);
+
+    //
+    // Counts `bytes` against the budget, first waiting until they fit. Waiting ends early once
+    // `stop_waiting` returns true; it is called with the budget locked, whenever bytes are
+    // released or wake() is called. The bytes are counted either way.
+    //
+    void acquire(std::size_t bytes, const std::function<bool()>& stop_waiting);
+
+    void release(std::size_t bytes);
+
+    // Makes the threads waiting in acquire() call their `stop_waiting` again.
+    void wake();
+
+    std::size_t used() const;
+
+    std::size_t max_bytes() const;
+
+   private:
+    const std::size_t _max_bytes;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _released;
+    std::size_t _used = 0;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
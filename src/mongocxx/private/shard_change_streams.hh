@@ -0,0 +1,101 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <mongocxx/options/change_stream.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/shard_change_streams.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class shard_change_streams::impl {
+   public:
+    struct event {
+        bsoncxx::document::value document;
+
+        // The event's clusterTime as (seconds << 32 | increment), which orders like the timestamp.
+        std::uint64_t cluster_time;
+    };
+
+    struct shard {
+        std::string name;
+        std::string uri;
+        std::deque<event> events;
+
+        // Every event of the shard up to this cluster time has been queued.
+        std::uint64_t high_water = 0;
+
+        bool opened = false;
+        bool finished = false;
+        std::exception_ptr error;
+    };
+
+    impl(std::string database, std::string collection, std::size_t queue_capacity)
+        : database(std::move(database)),
+          collection(std::move(collection)),
+          queue_capacity(queue_capacity) {}
+
+    // The body of a shard's thread. The pipeline and options are only used until the shard's
+    // stream is open, which the constructor waits for.
+    void watch(std::size_t index, const pipeline* pipe, const options::change_stream* options);
+
+    // Queues an event, waiting for room. Returns false if the streams were stopped instead.
+    bool push(std::size_t index, const bsoncxx::document::view& document);
+
+    void advance_high_water(std::size_t index, std::uint64_t cluster_time);
+
+    void finish(std::size_t index, std::exception_ptr error);
+
+    // Whether the oldest queued event of a shard can be returned by pop_merged.
+    bool releasable(std::size_t index) const;
+
+    void stop();
+
+    const std::string database;
+    const std::string collection;
+    const std::size_t queue_capacity;
+
+    std::mutex mutex;
+
+    // Signalled when events or high-water marks change, and when a shard opens or finishes.
+    std::condition_variable changed;
+
+    // Signalled when a queue has room again or the streams are stopped.
+    std::condition_variable room;
+
+    std::vector<shard> shards;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
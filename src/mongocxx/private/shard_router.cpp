@@ -0,0 +1,289 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/shard_router.hh>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/sort.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/uri.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+constexpr std::size_t shard_router::k_unknown;
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+using bsoncxx::types::value_view;
+
+bool is_hashed(bsoncxx::document::view key_pattern) {
+    for (auto&& field : key_pattern) {
+        if (field.type() == bsoncxx::type::k_utf8) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Compares two keys of `size` values in the order of their fields.
+int compare_keys(const value_view* lhs, const value_view* rhs, std::size_t size) {
+    for (std::size_t i = 0; i < size; i++) {
+        if (const int result = bsoncxx::compare(lhs[i], rhs[i])) {
+            return result;
+        }
+    }
+    return 0;
+}
+
+// The routers loaded so far, by deployment and namespace.
+struct router_cache {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const shard_router>> routers;
+};
+
+router_cache& cache() {
+    static router_cache instance;
+    return instance;
+}
+
+std::string cache_key(const client& client,
+                      const std::string& database,
+                      const std::string& collection) {
+    std::string key = client.uri().to_string();
+    key += '\0';
+    key += database;
+    key += '.';
+    key += collection;
+    return key;
+}
+
+}  // namespace
+
+shard_router::shard_router(bsoncxx::document::view key_pattern,
+                           const std::vector<bsoncxx::document::view>& chunks) {
+    if (is_hashed(key_pattern)) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "hashed shard keys cannot be routed by the driver"};
+    }
+
+    for (auto&& field : key_pattern) {
+        const bsoncxx::stdx::string_view path = field.key();
+        std::vector<std::string> keys;
+        std::size_t begin = 0;
+        while (true) {
+            const auto dot = path.find('.', begin);
+            keys.push_back(
+                path.substr(begin, dot == path.npos ? path.npos : dot - begin).to_string());
+            if (dot == path.npos) {
+                break;
+            }
+            begin = dot + 1;
+        }
+        _fields.push_back(path.to_string());
+        _paths.push_back(std::move(keys));
+    }
+
+    _documents.reserve(chunks.size());
+    for (auto&& document : chunks) {
+        auto min = document["min"];
+        auto shard = document["shard"];
+        if (!min || min.type() != bsoncxx::type::k_document || !shard ||
+            shard.type() != bsoncxx::type::k_utf8) {
+            throw logic_error{error_code::k_invalid_parameter, "malformed config.chunks entry"};
+        }
+
+        const auto name = bsoncxx::string::to_string(shard.get_utf8().value);
+        auto known = std::find(_shards.begin(), _shards.end(), name);
+        if (known == _shards.end()) {
+            known = _shards.insert(_shards.end(), name);
+        }
+
+        _documents.emplace_back(document);
+        chunk entry;
+        entry.shard = static_cast<std::size_t>(known - _shards.begin());
+        auto bounds = _documents.back().view()["min"].get_document().value;
+        for (auto&& field : _fields) {
+            auto value = bounds[field];
+            if (!value) {
+                throw logic_error{error_code::k_invalid_parameter,
+                                  "malformed config.chunks entry"};
+            }
+            entry.min.push_back(value.get_value_view());
+        }
+        _chunks.push_back(std::move(entry));
+    }
+
+    const auto size = _fields.size();
+    std::sort(_chunks.begin(), _chunks.end(), [size](const chunk& lhs, const chunk& rhs) {
+        return compare_keys(lhs.min.data(), rhs.min.data(), size) < 0;
+    });
+}
+
+std::size_t shard_router::shard_count() const {
+    return _shards.size();
+}
+
+const std::string& shard_router::shard_name(std::size_t shard) const {
+    return _shards.at(shard);
+}
+
+std::size_t shard_router::shard_for_document(bsoncxx::document::view document) const {
+    std::vector<value_view> key;
+    key.reserve(_paths.size());
+    for (auto&& path : _paths) {
+        value_view value;
+        bsoncxx::document::view level = document;
+        for (std::size_t i = 0; i < path.size(); i++) {
+            auto element = level[path[i]];
+            if (!element) {
+                break;
+            }
+            if (i + 1 == path.size()) {
+                value = element.get_value_view();
+            } else if (element.type() == bsoncxx::type::k_document) {
+                level = element.get_document().value;
+            } else {
+                break;
+            }
+        }
+        key.push_back(value);
+    }
+    return _shard_for_key(key.data());
+}
+
+std::size_t shard_router::shard_for_filter(bsoncxx::document::view filter) const {
+    std::vector<value_view> key;
+    key.reserve(_fields.size());
+    for (auto&& field : _fields) {
+        auto condition = filter[field];
+        if (!condition) {
+            return k_unknown;
+        }
+
+        auto value = condition.get_value_view();
+        if (value.type() == bsoncxx::type::k_document) {
+            auto operators = value.get_document().value;
+            auto first = operators.begin();
+            if (first != operators.end() && !first->key().empty() && first->key()[0] == '$') {
+                // Only {$eq: value} selects a single shard key value.
+                if (first->key() != bsoncxx::stdx::string_view{"$eq"} ||
+                    std::next(first) != operators.end()) {
+                    return k_unknown;
+                }
+                value = first->get_value_view();
+            }
+        }
+        if (value.type() == bsoncxx::type::k_regex || value.type() == bsoncxx::type::k_array) {
+            return k_unknown;
+        }
+        key.push_back(value);
+    }
+    return _shard_for_key(key.data());
+}
+
+std::size_t shard_router::_shard_for_key(const value_view* key) const {
+    const auto size = _fields.size();
+    auto after = std::upper_bound(
+        _chunks.begin(), _chunks.end(), key, [size](const value_view* lhs, const chunk& rhs) {
+            return compare_keys(lhs, rhs.min.data(), size) < 0;
+        });
+    if (after == _chunks.begin()) {
+        return k_unknown;
+    }
+    return std::prev(after)->shard;
+}
+
+std::shared_ptr<const shard_router> shard_router::load(class client& client,
+                                                       const std::string& database,
+                                                       const std::string& collection) {
+    const auto key = cache_key(client, database, collection);
+    {
+        std::lock_guard<std::mutex> lock{cache().mutex};
+        auto found = cache().routers.find(key);
+        if (found != cache().routers.end()) {
+            return found->second;
+        }
+    }
+
+    const std::string ns = database + "." + collection;
+    auto config = client["config"];
+    auto entry = config["collections"].find_one(make_document(kvp("_id", ns)));
+    if (!entry) {
+        return nullptr;
+    }
+
+    auto view = entry->view();
+    auto key_pattern = view["key"];
+    auto dropped = view["dropped"];
+    if (!key_pattern || key_pattern.type() != bsoncxx::type::k_document ||
+        (dropped && dropped.type() == bsoncxx::type::k_bool && dropped.get_bool().value) ||
+        is_hashed(key_pattern.get_document().value)) {
+        return nullptr;
+    }
+
+    // Since MongoDB 5.0, chunks are recorded by the collection's UUID instead of its namespace.
+    bsoncxx::builder::basic::document filter;
+    if (auto uuid = view["uuid"]) {
+        filter.append(kvp("$or",
+                          make_array(make_document(kvp("ns", ns)),
+                                     make_document(kvp("uuid", uuid.get_value())))));
+    } else {
+        filter.append(kvp("ns", ns));
+    }
+
+    std::vector<bsoncxx::document::value> chunks;
+    for (auto&& chunk : config["chunks"].find(filter.view())) {
+        chunks.emplace_back(chunk);
+    }
+    if (chunks.empty()) {
+        return nullptr;
+    }
+
+    const std::vector<bsoncxx::document::view> views(chunks.begin(), chunks.end());
+    auto router = std::make_shared<shard_router>(key_pattern.get_document().value, views);
+    router->_cache_key = key;
+
+    std::lock_guard<std::mutex> lock{cache().mutex};
+    cache().routers[key] = router;
+    return router;
+}
+
+void shard_router::invalidate() const {
+    std::lock_guard<std::mutex> lock{cache().mutex};
+    auto found = cache().routers.find(_cache_key);
+
+    // Another bulk write may already have loaded a fresh router.
+    if (found != cache().routers.end() && found->second.get() == this) {
+        cache().routers.erase(found);
+    }
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
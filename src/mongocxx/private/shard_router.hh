@@ -0,0 +1,112 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types/value_view.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// The chunk ranges of a sharded collection, which tell the shard a write is sent to; see
+// options::bulk_write::shard_partitioning(). A router is immutable once built, so threads can
+// share it.
+//
+class MONGOCXX_TEST_API shard_router {
+   public:
+    // Returned when the shard of a write cannot be told from its document.
+    static constexpr std::size_t k_unknown = static_cast<std::size_t>(-1);
+
+    //
+    // Builds the table from the key pattern of the collection's shard key and its entries in
+    // config.chunks, each with a min, a max and a shard. Throws logic_error if the key is hashed
+    // or a chunk is malformed.
+    //
+    shard_router(bsoncxx::document::view key_pattern,
+                 const std::vector<bsoncxx::document::view>& chunks);
+
+    shard_router(const shard_router&) = delete;
+    shard_router& operator=(const shard_router&) = delete;
+
+    std::size_t shard_count() const;
+
+    const std::string& shard_name(std::size_t shard) const;
+
+    //
+    // The shard that owns the document an insert would store. A missing shard key field counts
+    // as null, as on the server.
+    //
+    std::size_t shard_for_document(bsoncxx::document::view document) const;
+
+    //
+    // The shard that owns the documents matched by the filter of an update, replace or delete,
+    // or k_unknown unless the filter compares every field of the shard key for equality, with a
+    // top-level condition such as {"user.id": 5}.
+    //
+    std::size_t shard_for_filter(bsoncxx::document::view filter) const;
+
+    //
+    // Returns the router of the collection `database`.`collection`, read from the config
+    // database through `client` the first time, or null if the collection is not sharded or has
+    // a hashed shard key. Routers are cached per deployment and namespace until invalidated.
+    //
+    static std::shared_ptr<const shard_router> load(class client& client,
+                                                    const std::string& database,
+                                                    const std::string& collection);
+
+    //
+    // Drops this router from the cache of load(), e.g. after the server reported that its routing
+    // information was stale, so that the next load() reads the chunks again.
+    //
+    void invalidate() const;
+
+   private:
+    struct chunk {
+        std::vector<bsoncxx::types::value_view> min;
+        std::size_t shard;
+    };
+
+    // The shard owning the chunk whose range contains `key`.
+    std::size_t _shard_for_key(const bsoncxx::types::value_view* key) const;
+
+    std::vector<std::string> _fields;
+    // The keys of each field's dotted path.
+    std::vector<std::vector<std::string>> _paths;
+
+    // Copies of the chunk documents, which the min values of _chunks point into.
+    std::vector<bsoncxx::document::value> _documents;
+    // Sorted by min.
+    std::vector<chunk> _chunks;
+    std::vector<std::string> _shards;
+
+    // The key of the router in the cache of load().
+    std::string _cache_key;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,211 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/slow_command_log.hh>
+
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/basic/sub_array.hpp>
+#include <bsoncxx/builder/basic/sub_document.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::sub_array;
+using bsoncxx::builder::basic::sub_document;
+
+struct pending_command {
+    const slow_command_log* log;
+    std::int64_t request_id;
+    std::string database;
+    std::string collection;
+    std::string command_name;
+    bsoncxx::document::value filter;
+};
+
+// A thread has at most one command in flight per client, so this rarely holds more than one entry.
+thread_local std::vector<pending_command> pending_commands;
+
+bool all_documents(bsoncxx::array::view values) {
+    bool any = false;
+    for (auto&& value : values) {
+        if (value.type() != bsoncxx::type::k_document) {
+            return false;
+        }
+        any = true;
+    }
+    return any;
+}
+
+void append_shape(sub_document out, bsoncxx::document::view filter) {
+    for (auto&& element : filter) {
+        if (element.type() == bsoncxx::type::k_document) {
+            auto nested = element.get_document().value;
+            out.append(
+                kvp(element.key(), [nested](sub_document sub) { append_shape(sub, nested); }));
+        } else if (element.type() == bsoncxx::type::k_array &&
+                   all_documents(element.get_array().value)) {
+            auto values = element.get_array().value;
+            out.append(kvp(element.key(), [values](sub_array sub) {
+                for (auto&& value : values) {
+                    auto nested = value.get_document().value;
+                    sub.append([nested](sub_document doc) { append_shape(doc, nested); });
+                }
+            }));
+        } else {
+            out.append(kvp(element.key(), "?"));
+        }
+    }
+}
+
+bsoncxx::document::view first_document(bsoncxx::document::element array) {
+    if (array.type() != bsoncxx::type::k_array) {
+        return {};
+    }
+
+    auto values = array.get_array().value;
+    auto first = values.begin();
+    if (first == values.end() || first->type() != bsoncxx::type::k_document) {
+        return {};
+    }
+    return first->get_document().value;
+}
+
+bsoncxx::document::view document_field(bsoncxx::document::view doc, stdx::string_view key) {
+    auto element = doc[key];
+    if (element.type() != bsoncxx::type::k_document) {
+        return {};
+    }
+    return element.get_document().value;
+}
+
+}  // namespace
+
+bsoncxx::document::value filter_shape(bsoncxx::document::view filter) {
+    bsoncxx::builder::basic::document shape;
+    append_shape(shape, filter);
+    return shape.extract();
+}
+
+bsoncxx::document::view command_filter(stdx::string_view command_name,
+                                       bsoncxx::document::view command) {
+    if (command_name == stdx::string_view{"find"}) {
+        return document_field(command, "filter");
+    }
+    if (command_name == stdx::string_view{"update"}) {
+        return document_field(first_document(command["updates"]), "q");
+    }
+    if (command_name == stdx::string_view{"delete"}) {
+        return document_field(first_document(command["deletes"]), "q");
+    }
+    if (command_name == stdx::string_view{"aggregate"}) {
+        auto pipeline = command["pipeline"];
+        if (pipeline.type() == bsoncxx::type::k_array) {
+            for (auto&& stage : pipeline.get_array().value) {
+                if (stage.type() == bsoncxx::type::k_document) {
+                    auto match = document_field(stage.get_document().value, "$match");
+                    if (!match.empty()) {
+                        return match;
+                    }
+                }
+            }
+        }
+        return {};
+    }
+    return document_field(command, "query");
+}
+
+stdx::string_view command_collection(stdx::string_view command_name,
+                                     bsoncxx::document::view command) {
+    // The value of the command name is the collection for the commands that have one; getMore
+    // names its collection separately.
+    auto name = command[command_name];
+    if (command_name == stdx::string_view{"getMore"}) {
+        name = command["collection"];
+    }
+    if (name.type() != bsoncxx::type::k_utf8) {
+        return {};
+    }
+    return name.get_utf8().value;
+}
+
+slow_command_log::slow_command_log(std::chrono::milliseconds threshold, std::size_t capacity)
+    : _threshold(std::chrono::duration_cast<std::chrono::microseconds>(threshold).count()),
+      _capacity(capacity) {}
+
+void slow_command_log::started(std::int64_t request_id,
+                               stdx::string_view database,
+                               stdx::string_view command_name,
+                               bsoncxx::document::view command) {
+    pending_command pending{this,
+                            request_id,
+                            std::string{database},
+                            std::string{command_collection(command_name, command)},
+                            std::string{command_name},
+                            bsoncxx::document::value{command_filter(command_name, command)}};
+    pending_commands.push_back(std::move(pending));
+}
+
+void slow_command_log::completed(std::int64_t request_id,
+                                 std::int64_t duration,
+                                 stdx::string_view host,
+                                 std::uint16_t port,
+                                 bool succeeded) {
+    for (auto it = pending_commands.rbegin(); it != pending_commands.rend(); ++it) {
+        if (it->log != this || it->request_id != request_id) {
+            continue;
+        }
+
+        auto pending = std::move(*it);
+        pending_commands.erase(std::next(it).base());
+
+        if (duration < _threshold) {
+            return;
+        }
+
+        events::slow_command command{std::move(pending.database),
+                                     std::move(pending.collection),
+                                     std::move(pending.command_name),
+                                     filter_shape(pending.filter.view()),
+                                     std::chrono::microseconds{duration},
+                                     std::string{host},
+                                     port,
+                                     succeeded};
+
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (_commands.size() == _capacity) {
+            _commands.pop_front();
+        }
+        _commands.push_back(std::move(command));
+        return;
+    }
+}
+
+std::vector<events::slow_command> slow_command_log::snapshot() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return {_commands.begin(), _commands.end()};
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,96 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <mongocxx/events/slow_command.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Replaces every value of a filter with "?", keeping field names and query operators. The
+// documents of arrays, as in $and or $or, are shaped in turn; other arrays become a single "?".
+//
+MONGOCXX_TEST_API bsoncxx::document::value filter_shape(bsoncxx::document::view filter);
+
+//
+// Returns the filter of a command: find's filter, the filter of the first statement of update and
+// delete, aggregate's first $match stage, or the query of other commands. Empty if it has none.
+//
+bsoncxx::document::view command_filter(stdx::string_view command_name,
+                                       bsoncxx::document::view command);
+
+//
+// Returns the collection a command names, or an empty view if it names none.
+//
+stdx::string_view command_collection(stdx::string_view command_name,
+                                     bsoncxx::document::view command);
+
+//
+// Keeps the most recent commands that took at least a threshold, for options::apm's
+// record_slow_commands().
+//
+// The duration of a command is only known once it completes, when the command document is gone.
+// started() therefore keeps a copy of the filter of each command in a thread-local list, since
+// libmongoc reports the completion of a command on the thread that started it. completed() shapes
+// the filter of the commands that turn out slow, and forgets the others.
+//
+class MONGOCXX_TEST_API slow_command_log {
+   public:
+    slow_command_log(std::chrono::milliseconds threshold, std::size_t capacity);
+
+    slow_command_log(const slow_command_log&) = delete;
+    slow_command_log& operator=(const slow_command_log&) = delete;
+
+    void started(std::int64_t request_id,
+                 stdx::string_view database,
+                 stdx::string_view command_name,
+                 bsoncxx::document::view command);
+
+    void completed(std::int64_t request_id,
+                   std::int64_t duration,
+                   stdx::string_view host,
+                   std::uint16_t port,
+                   bool succeeded);
+
+    // Returns the slow commands kept, oldest first.
+    std::vector<events::slow_command> snapshot() const;
+
+   private:
+    const std::int64_t _threshold;
+    const std::size_t _capacity;
+
+    mutable std::mutex _mutex;
+    std::deque<events::slow_command> _commands;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,142 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/sort_key.hh>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/sort.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace sort_key {
+
+namespace {
+
+using bsoncxx::stdx::string_view;
+using bsoncxx::types::value_view;
+
+// The value an array sorts by: its smallest element in ascending order and its largest in
+// descending order. An empty array sorts like a missing field.
+value_view array_sort_value(const value_view& array, int direction) {
+    value_view chosen;
+    bool found = false;
+    for (auto&& element : array.get_array().value) {
+        const auto candidate = element.get_value_view();
+        if (!found || bsoncxx::compare(candidate, chosen) * direction < 0) {
+            chosen = candidate;
+            found = true;
+        }
+    }
+    return found ? chosen : value_view{};
+}
+
+}  // namespace
+
+extractor::extractor(bsoncxx::document::view sort) {
+    for (auto&& field : sort) {
+        int direction = 0;
+        switch (field.type()) {
+            case bsoncxx::type::k_int32:
+                direction = field.get_int32().value;
+                break;
+            case bsoncxx::type::k_int64:
+                direction = static_cast<int>(field.get_int64().value);
+                break;
+            case bsoncxx::type::k_double:
+                direction = static_cast<int>(field.get_double().value);
+                break;
+            default:
+                break;
+        }
+        if (direction != 1 && direction != -1) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "sort directions must be 1 or -1"};
+        }
+
+        const string_view path = field.key();
+        std::vector<std::string> keys;
+        std::size_t begin = 0;
+        while (true) {
+            const auto dot = path.find('.', begin);
+            keys.push_back(
+                path.substr(begin, dot == string_view::npos ? string_view::npos : dot - begin)
+                    .to_string());
+            if (dot == string_view::npos) {
+                break;
+            }
+            begin = dot + 1;
+        }
+
+        _heads.push_back(std::move(keys.front()));
+        keys.erase(keys.begin());
+        _tails.push_back(std::move(keys));
+        _directions.push_back(direction);
+    }
+
+    if (_heads.empty()) {
+        throw logic_error{error_code::k_invalid_parameter, "the sort specification is empty"};
+    }
+
+    // _heads no longer changes, so the views stay valid.
+    for (auto&& head : _heads) {
+        _head_views.emplace_back(head);
+    }
+    _elements.resize(_heads.size());
+}
+
+std::size_t extractor::size() const {
+    return _heads.size();
+}
+
+void extractor::extract(bsoncxx::document::view document, value_view* out) const {
+    document.extract(_head_views.data(), _head_views.size(), _elements.data());
+
+    for (std::size_t i = 0; i < _heads.size(); i++) {
+        value_view value;
+        if (_elements[i]) {
+            value = _elements[i].get_value_view();
+        }
+
+        for (auto&& key : _tails[i]) {
+            if (!value || value.type() != bsoncxx::type::k_document) {
+                value = value_view{};
+                break;
+            }
+            auto next = value.get_document().value[key];
+            value = next ? next.get_value_view() : value_view{};
+        }
+
+        if (value && value.type() == bsoncxx::type::k_array) {
+            value = array_sort_value(value, _directions[i]);
+        }
+        out[i] = value;
+    }
+}
+
+int extractor::compare(const value_view* lhs, const value_view* rhs) const {
+    for (std::size_t i = 0; i < _directions.size(); i++) {
+        if (const int result = bsoncxx::compare(lhs[i], rhs[i])) {
+            return result * _directions[i];
+        }
+    }
+    return 0;
+}
+
+}  // namespace sort_key
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
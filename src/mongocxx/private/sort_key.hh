@@ -0,0 +1,80 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/string_view.hpp>
+#include <bsoncxx/types/value_view.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace sort_key {
+
+//
+// Extracts the values of the fields of a sort specification from documents, and orders
+// documents by them. An extractor is not thread-safe, as extract() reuses a scratch buffer.
+//
+class MONGOCXX_TEST_API extractor {
+   public:
+    //
+    // Parses a sort specification such as {a: 1, "b.c": -1}. Throws logic_error if it is empty
+    // or if a direction is not 1 or -1.
+    //
+    explicit extractor(bsoncxx::document::view sort);
+
+    extractor(const extractor&) = delete;
+    extractor& operator=(const extractor&) = delete;
+
+    std::size_t size() const;
+
+    //
+    // Sets out[i] to the value of the i-th sort field of `document`. Top-level fields are all
+    // found in one pass over the document. For an array, this is its smallest element when
+    // sorting in ascending order and its largest when sorting in descending order, as in the
+    // server. A path through a value other than a document selects nothing. The values point into
+    // `document`.
+    //
+    void extract(bsoncxx::document::view document, bsoncxx::types::value_view* out) const;
+
+    //
+    // Compares two sets of values returned by extract() with bsoncxx::compare(), honoring the
+    // directions of the fields.
+    //
+    int compare(const bsoncxx::types::value_view* lhs, const bsoncxx::types::value_view* rhs) const;
+
+   private:
+    // The first key of each path, and views of them to pass to view::extract().
+    std::vector<std::string> _heads;
+    std::vector<bsoncxx::stdx::string_view> _head_views;
+    // The remaining keys of each path, or none.
+    std::vector<std::vector<std::string>> _tails;
+    std::vector<int> _directions;
+
+    mutable std::vector<bsoncxx::document::element> _elements;
+};
+
+}  // namespace sort_key
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
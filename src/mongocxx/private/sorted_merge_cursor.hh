@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types/value_view.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/private/sort_key.hh>
+#include <mongocxx/sorted_merge_cursor.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class sorted_merge_cursor::impl {
+   public:
+    impl(std::vector<cursor> cursors, bsoncxx::document::value sort);
+
+    // Makes `doc` the next document in sort order: advances the cursor the current document came
+    // from, or on the first call reads the first document of every cursor, and then takes the
+    // cursor whose document sorts first off the heap. Marks the merge exhausted once every cursor
+    // is.
+    void advance();
+
+    // Extracts the sort values of the current document of cursors[index] and pushes the cursor
+    // onto the heap, unless it is exhausted.
+    void push(std::size_t index);
+
+    // Whether cursors[lhs] should come after cursors[rhs]. Ties go to the cursor given first, so
+    // that the merge is stable.
+    bool later(std::size_t lhs, std::size_t rhs) const;
+
+    std::vector<cursor> cursors;
+    bsoncxx::document::value sort;
+    sort_key::extractor keys;
+
+    // The sort values of the current document of each cursor, keys.size() per cursor.
+    std::vector<bsoncxx::types::value_view> values;
+
+    // The indexes of the cursors that have a document, as a heap whose front sorts first.
+    std::vector<std::size_t> heap;
+
+    // The cursor `doc` comes from, while it is not on the heap.
+    std::size_t current;
+    bool has_current = false;
+
+    // Whether the first document of every cursor has been read.
+    bool primed = false;
+
+    bsoncxx::document::view doc;
+    bool started = false;
+    bool exhausted = false;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,227 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/stream_initiator.hh>
+
+#include <exception>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// The socket option constants of the platform, or -1 for those it does not have.
+#if defined(TCP_KEEPIDLE)
+constexpr int k_keepalive_idle = TCP_KEEPIDLE;
+#elif defined(TCP_KEEPALIVE)
+constexpr int k_keepalive_idle = TCP_KEEPALIVE;
+#else
+constexpr int k_keepalive_idle = -1;
+#endif
+
+#if defined(TCP_KEEPINTVL)
+constexpr int k_keepalive_interval = TCP_KEEPINTVL;
+#else
+constexpr int k_keepalive_interval = -1;
+#endif
+
+#if defined(TCP_KEEPCNT)
+constexpr int k_keepalive_count = TCP_KEEPCNT;
+#else
+constexpr int k_keepalive_count = -1;
+#endif
+
+#if defined(SO_BUSY_POLL)
+constexpr int k_busy_poll = SO_BUSY_POLL;
+#else
+constexpr int k_busy_poll = -1;
+#endif
+
+// Finds the socket beneath the TLS and buffering layers of a stream, if it has one.
+mongoc_socket_t* find_socket(mongoc_stream_t* stream) {
+    while (stream->type != MONGOC_STREAM_SOCKET) {
+        auto base = libmongoc::stream_get_base_stream(stream);
+        if (!base || base == stream) {
+            return nullptr;
+        }
+        stream = base;
+    }
+    return libmongoc::stream_socket_get_socket(reinterpret_cast<mongoc_stream_socket_t*>(stream));
+}
+
+bool set_option(mongoc_socket_t* socket,
+                int level,
+                int name,
+                int value,
+                const char* option_name,
+                bson_error_t* error) {
+    if (name == -1) {
+        bson_set_error(error,
+                       MONGOC_ERROR_STREAM,
+                       MONGOC_ERROR_STREAM_SOCKET,
+                       "socket option %s is not supported on this platform",
+                       option_name);
+        return false;
+    }
+
+    if (libmongoc::socket_setsockopt(socket, level, name, &value, sizeof value) != 0) {
+        bson_set_error(error,
+                       MONGOC_ERROR_STREAM,
+                       MONGOC_ERROR_STREAM_SOCKET,
+                       "failed to set socket option %s: errno %d",
+                       option_name,
+                       libmongoc::socket_errno(socket));
+        return false;
+    }
+
+    return true;
+}
+
+bool apply_socket_opts(const options::socket& opts, mongoc_socket_t* socket, bson_error_t* error) {
+    if (opts.receive_buffer_size() &&
+        !set_option(
+            socket, SOL_SOCKET, SO_RCVBUF, *opts.receive_buffer_size(), "SO_RCVBUF", error)) {
+        return false;
+    }
+
+    if (opts.send_buffer_size() &&
+        !set_option(socket, SOL_SOCKET, SO_SNDBUF, *opts.send_buffer_size(), "SO_SNDBUF", error)) {
+        return false;
+    }
+
+    if (opts.no_delay() &&
+        !set_option(socket, IPPROTO_TCP, TCP_NODELAY, *opts.no_delay(), "TCP_NODELAY", error)) {
+        return false;
+    }
+
+    if (opts.keepalive_idle()) {
+        if (!set_option(socket, SOL_SOCKET, SO_KEEPALIVE, 1, "SO_KEEPALIVE", error) ||
+            !set_option(socket,
+                        IPPROTO_TCP,
+                        k_keepalive_idle,
+                        static_cast<int>(opts.keepalive_idle()->count()),
+                        "TCP_KEEPIDLE",
+                        error) ||
+            !set_option(socket,
+                        IPPROTO_TCP,
+                        k_keepalive_interval,
+                        static_cast<int>(opts.keepalive_interval()->count()),
+                        "TCP_KEEPINTVL",
+                        error) ||
+            !set_option(socket,
+                        IPPROTO_TCP,
+                        k_keepalive_count,
+                        *opts.keepalive_count(),
+                        "TCP_KEEPCNT",
+                        error)) {
+            return false;
+        }
+    }
+
+    if (opts.busy_poll() && !set_option(socket,
+                                        SOL_SOCKET,
+                                        k_busy_poll,
+                                        static_cast<int>(opts.busy_poll()->count()),
+                                        "SO_BUSY_POLL",
+                                        error)) {
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace
+
+stream_initiator::stream_initiator(const options::client& options)
+    : _socket_opts(options.socket_opts()), _initiator(options.stream_initiator()) {}
+
+bool stream_initiator::needed(const options::client& options) {
+    return options.socket_opts() || options.stream_initiator();
+}
+
+void stream_initiator::attach(mongoc_client_t* client_t) {
+    context* ctx;
+    {
+        std::lock_guard<std::mutex> lock{_contexts_mutex};
+        auto& slot = _contexts[client_t];
+        if (slot) {
+            return;
+        }
+        slot = stdx::make_unique<context>(context{this, client_t});
+        ctx = slot.get();
+    }
+
+    libmongoc::client_set_stream_initiator(client_t, &stream_initiator::initiate, ctx);
+}
+
+mongoc_stream_t* stream_initiator::initiate(const mongoc_uri_t* uri,
+                                            const mongoc_host_list_t* host,
+                                            void* user_data,
+                                            bson_error_t* error) {
+    auto ctx = static_cast<context*>(user_data);
+    return ctx->owner->open(uri, host, ctx->client_t, error);
+}
+
+mongoc_stream_t* stream_initiator::open(const mongoc_uri_t* uri,
+                                        const mongoc_host_list_t* host,
+                                        mongoc_client_t* client_t,
+                                        bson_error_t* error) noexcept {
+    mongoc_stream_t* stream = nullptr;
+    if (_initiator) {
+        try {
+            stream = static_cast<mongoc_stream_t*>(
+                _initiator(stdx::string_view{host->host}, host->port));
+        } catch (const std::exception& e) {
+            bson_set_error(
+                error, MONGOC_ERROR_STREAM, MONGOC_ERROR_STREAM_CONNECT, "%s", e.what());
+            return nullptr;
+        } catch (...) {
+            bson_set_error(error,
+                           MONGOC_ERROR_STREAM,
+                           MONGOC_ERROR_STREAM_CONNECT,
+                           "the stream initiator threw an unknown exception");
+            return nullptr;
+        }
+
+        if (!stream) {
+            bson_set_error(error,
+                           MONGOC_ERROR_STREAM,
+                           MONGOC_ERROR_STREAM_CONNECT,
+                           "the stream initiator returned no stream");
+            return nullptr;
+        }
+    } else {
+        stream = libmongoc::client_default_stream_initiator(uri, host, client_t, error);
+        if (!stream) {
+            return nullptr;
+        }
+    }
+
+    if (_socket_opts) {
+        auto socket = find_socket(stream);
+        if (socket && !apply_socket_opts(*_socket_opts, socket, error)) {
+            libmongoc::stream_destroy(stream);
+            return nullptr;
+        }
+    }
+
+    return stream;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
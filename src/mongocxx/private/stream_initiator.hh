@@ -0,0 +1,78 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/options/client.hpp>
+#include <mongocxx/options/socket.hpp>
+#include <mongocxx/private/libmongoc.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// The socket options and custom stream initiator of a client or pool, installed as the libmongoc
+// stream initiator of each of its mongoc_client_t.
+//
+class stream_initiator {
+   public:
+    stream_initiator(const options::client& options);
+
+    //
+    // Whether the options set anything for this class to apply.
+    //
+    static bool needed(const options::client& options);
+
+    //
+    // Makes `client_t` open its connections through this object, if it does not already.
+    //
+    void attach(mongoc_client_t* client_t);
+
+   private:
+    // libmongoc's default initiator needs the client opening the stream, so each client has its
+    // own context. A client destroyed by the pool leaves its context behind, to be reused by any
+    // later client allocated at the same address.
+    struct context {
+        stream_initiator* owner;
+        mongoc_client_t* client_t;
+    };
+
+    static mongoc_stream_t* initiate(const mongoc_uri_t* uri,
+                                     const mongoc_host_list_t* host,
+                                     void* user_data,
+                                     bson_error_t* error);
+
+    mongoc_stream_t* open(const mongoc_uri_t* uri,
+                          const mongoc_host_list_t* host,
+                          mongoc_client_t* client_t,
+                          bson_error_t* error) noexcept;
+
+    stdx::optional<options::socket> _socket_opts;
+    options::client::stream_initiator_type _initiator;
+
+    std::mutex _contexts_mutex;
+    std::unordered_map<mongoc_client_t*, std::unique_ptr<context>> _contexts;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
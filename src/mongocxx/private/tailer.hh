@@ -0,0 +1,85 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/tailer.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class tailer::impl {
+   public:
+    impl(class pool* pool,
+         std::string database,
+         std::string collection,
+         document_fn on_document,
+         bsoncxx::document::value filter,
+         const options::tailer& options);
+
+    // Stops the background thread and waits for it to exit.
+    ~impl();
+
+    // The body of the background thread: runs tail() and records the error it throws, if any.
+    void run();
+
+    // Opens cursors and delivers their documents until stopped.
+    void tail();
+
+    // The filter of the next cursor: `filter`, and past the last resume value if there is one.
+    bsoncxx::document::value next_filter() const;
+
+    // Waits for `interval`, returning early and false if the tailer is stopped.
+    bool sleep_for(std::chrono::milliseconds interval);
+
+    bool is_stopping();
+
+    class pool* pool;
+    std::string database;
+    std::string collection;
+    document_fn on_document;
+    bsoncxx::document::value filter;
+    options::find find_options;
+    stdx::optional<std::string> resume_field;
+    std::chrono::milliseconds reopen_interval;
+
+    // Only touched by the background thread: {resume_field: {$gt: <last value>}}.
+    stdx::optional<bsoncxx::document::value> resume_after;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool stopping = false;
+    bool finished = false;
+    std::exception_ptr error;
+    std::thread thread;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
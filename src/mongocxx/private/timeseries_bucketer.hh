@@ -0,0 +1,98 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/basic/sub_document.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/result/bulk_write.hpp>
+#include <mongocxx/timeseries_bucketer.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class timeseries_bucketer::impl {
+   public:
+    struct column {
+        std::string name;
+        std::vector<double> values;
+    };
+
+    // The measurements of one meta document not yet encoded.
+    struct bucket {
+        explicit bucket(bsoncxx::document::view meta) : meta(meta) {}
+
+        bsoncxx::document::value meta;
+        // In milliseconds since the epoch.
+        std::vector<std::int64_t> times;
+        // In the order their fields were first seen; each holds one value per time.
+        std::vector<column> columns;
+    };
+
+    impl(class collection collection,
+         std::size_t max_measurements,
+         std::chrono::milliseconds max_span,
+         std::size_t max_buckets_per_write)
+        : collection(std::move(collection)),
+          max_measurements(max_measurements),
+          max_span(max_span.count()),
+          max_buckets_per_write(max_buckets_per_write) {}
+
+    // Encodes a bucket as a document of the layout described in timeseries_bucketer.hpp.
+    static bsoncxx::document::value encode(const bucket& bucket);
+
+    // Appends the smallest or largest value of each column, skipping NaN, and skipping columns
+    // of NaN alone.
+    static void append_bounds(bsoncxx::builder::basic::sub_document bounds,
+                              const std::vector<column>& columns,
+                              bool largest);
+
+    // Encodes an open bucket into `closed` and removes it from `open`.
+    void close(std::unordered_map<std::string, bucket>::iterator open_bucket);
+
+    // Writes the closed buckets as one unordered bulk write, or does nothing if there are none.
+    stdx::optional<result::bulk_write> write_closed();
+
+    class collection collection;
+    const std::size_t max_measurements;
+    const std::int64_t max_span;
+    const std::size_t max_buckets_per_write;
+
+    // The open buckets, by the bytes of their meta document.
+    std::unordered_map<std::string, bucket> open;
+
+    // The encoded buckets waiting to be written, and the number of measurements in them.
+    std::vector<bsoncxx::document::value> closed;
+    std::size_t closed_measurements = 0;
+
+    // The measurements in the open and closed buckets.
+    std::size_t pending = 0;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
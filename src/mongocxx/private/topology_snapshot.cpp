@@ -0,0 +1,84 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/topology_snapshot.hh>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <bsoncxx/types.hpp>
+#include <mongocxx/events/server_description.hpp>
+#include <mongocxx/private/libbson.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// The default of localThresholdMS, from the server selection specification.
+constexpr std::int32_t k_default_local_threshold_ms = 15;
+
+}  // namespace
+
+topology_snapshot make_topology_snapshot(mongoc_client_t* client,
+                                         const command_latency_recorder* latencies) {
+    topology_snapshot snapshot;
+
+    std::size_t count;
+    auto sds = libmongoc::client_get_server_descriptions(client, &count);
+    for (std::size_t i = 0; i < count; i++) {
+        events::server_description sd{sds[i]};
+
+        topology_snapshot::server server;
+        server.id = sd.id();
+        server.host = std::string{sd.host()};
+        server.port = sd.port();
+        server.type = std::string{sd.type()};
+        // libmongoc reports -1 until a heartbeat has succeeded.
+        if (sd.round_trip_time() >= 0) {
+            server.round_trip_time = std::chrono::milliseconds{sd.round_trip_time()};
+        }
+        server.command_count = 0;
+        snapshot.servers.push_back(std::move(server));
+    }
+    libmongoc::server_descriptions_destroy_all(sds, count);
+
+    if (latencies) {
+        for (auto&& latency : latencies->snapshot()) {
+            for (auto&& server : snapshot.servers) {
+                if (server.port == latency.port && server.host == latency.host) {
+                    server.command_count += latency.count;
+                }
+            }
+        }
+    }
+
+    // The URI of the client holds the localThresholdMS of the user's URI, or its override.
+    const auto uri_options = libmongoc::uri_get_options(libmongoc::client_get_uri(client));
+    const bsoncxx::document::view options_view{bson_get_data(uri_options), uri_options->len};
+    const auto local_threshold = options_view[MONGOC_URI_LOCALTHRESHOLDMS];
+    snapshot.local_threshold = std::chrono::milliseconds{k_default_local_threshold_ms};
+    if (local_threshold && local_threshold.type() == bsoncxx::type::k_int32) {
+        snapshot.local_threshold = std::chrono::milliseconds{local_threshold.get_int32().value};
+    }
+
+    return snapshot;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,53 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <bsoncxx/document/view.hpp>
+#include <mongocxx/events/span_attributes.hpp>
+#include <mongocxx/test_util/export_for_testing.hh>
+#include <mongocxx/tracer.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace tracing {
+
+//
+// Remembers the span of a command between its started and completed events. libmongoc sends both
+// on the thread that runs the command, so the spans are kept per thread.
+//
+MONGOCXX_TEST_API void push_span(std::int64_t request_id, void* span);
+
+//
+// Returns and forgets the span of a command, or returns nullptr if none was started for it on
+// this thread.
+//
+MONGOCXX_TEST_API void* pop_span(std::int64_t request_id);
+
+//
+// Fills in the collection and batch size of a span from the command document. The other
+// attributes come from the started event.
+//
+MONGOCXX_TEST_API void read_command_attributes(bsoncxx::document::view command,
+                                               events::span_attributes* attributes);
+
+}  // namespace tracing
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -14,6 +14,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <mongocxx/options/client.hpp>
 #include <mongocxx/private/libmongoc.hh>
 #include <mongocxx/uri.hpp>
 
@@ -22,15 +32,71 @@
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
 
+// The parsed URI is never modified once created, so copies of a uri share it and the values
+// derived from it.
 class uri::impl {
    public:
     impl(mongoc_uri_t* uri) : uri_t(uri) {}
     ~impl() {
         libmongoc::uri_destroy(uri_t);
     }
+
+    // Converts the host list on first use.
+    const std::vector<host>& hosts() const {
+        std::call_once(_hosts_once, [this] {
+            for (auto host_list = libmongoc::uri_get_hosts(uri_t); host_list;
+                 host_list = host_list->next) {
+                _hosts.push_back(host{host_list->host, host_list->port, host_list->family});
+            }
+        });
+        return _hosts;
+    }
+
     mongoc_uri_t* uri_t;
+
+   private:
+    mutable std::once_flag _hosts_once;
+    mutable std::vector<host> _hosts;
 };
 
+using unique_uri = std::unique_ptr<mongoc_uri_t, decltype(libmongoc::uri_destroy)>;
+
+inline bool has_uri_overrides(const options::client& options) {
+    return options.local_threshold() || options.compressors() || options.zlib_compression_level();
+}
+
+// Gets the libmongoc URI to create a client or pool from: uri_t itself, or a copy of it, owned by
+// `copy`, to which the client options that override URI options are applied.
+inline const mongoc_uri_t* uri_with_overrides(const mongoc_uri_t* uri_t,
+                                              const options::client& options,
+                                              unique_uri* copy) {
+    if (!has_uri_overrides(options)) {
+        return uri_t;
+    }
+
+    copy->reset(libmongoc::uri_copy(uri_t));
+    if (options.local_threshold()) {
+        const auto max = std::chrono::milliseconds{std::numeric_limits<std::int32_t>::max()};
+        const auto threshold = std::min(*options.local_threshold(), max);
+        libmongoc::uri_set_option_as_int32(copy->get(),
+                                           MONGOC_URI_LOCALTHRESHOLDMS,
+                                           static_cast<std::int32_t>(threshold.count()));
+    }
+    if (options.compressors()) {
+        std::string names;
+        for (auto&& name : *options.compressors()) {
+            names += names.empty() ? name : "," + name;
+        }
+        // A null list clears the compressors of the URI.
+        libmongoc::uri_set_compressors(copy->get(), names.empty() ? nullptr : names.c_str());
+    }
+    if (options.zlib_compression_level()) {
+        libmongoc::uri_set_option_as_int32(
+            copy->get(), MONGOC_URI_ZLIBCOMPRESSIONLEVEL, *options.zlib_compression_level());
+    }
+    return copy->get();
+}
+
 MONGOCXX_INLINE_NAMESPACE_END
 }  // namespace mongocxx
 
@@ -0,0 +1,72 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mongocxx/work_stealing_executor.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class work_stealing_executor::impl {
+   public:
+    explicit impl(std::size_t threads);
+
+    // Runs the tasks left in the queues and joins the threads.
+    ~impl();
+
+    void submit(std::function<void()> task);
+
+    std::size_t concurrency() const;
+
+   private:
+    struct queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Takes a task from the back of queue `index`, or from the front of another queue.
+    bool take(std::size_t index, std::function<void()>* task);
+
+    void work(std::size_t index);
+
+    void stop();
+
+    std::vector<std::unique_ptr<queue>> _queues;
+    std::size_t _next_queue = 0;
+
+    // Guards _pending, _next_queue and _stopping, and is held to sleep on _wakeup.
+    std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::size_t _pending = 0;
+    bool _stopping = false;
+
+    std::vector<std::thread> _threads;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -0,0 +1,115 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/private/zstd_codec.hh>
+
+#include <string>
+
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/gridfs_exception.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+#if defined(MONGOCXX_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+#if defined(MONGOCXX_HAVE_ZSTD)
+
+namespace {
+
+void throw_if_error(std::size_t result, error_code code) {
+    if (ZSTD_isError(result)) {
+        throw gridfs_exception{code, std::string{"zstd: "} + ZSTD_getErrorName(result)};
+    }
+}
+
+}  // namespace
+
+bool zstd_codec::supported() {
+    return true;
+}
+
+bool zstd_codec::valid_level(std::int32_t level) {
+    return level >= ZSTD_minCLevel() && level <= ZSTD_maxCLevel();
+}
+
+zstd_codec::~zstd_codec() {
+    ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(_compressor));
+    ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(_decompressor));
+}
+
+void zstd_codec::compress(const std::uint8_t* bytes,
+                          std::size_t length,
+                          std::int32_t level,
+                          std::vector<std::uint8_t>* out) {
+    if (!_compressor) {
+        _compressor = ZSTD_createCCtx();
+    }
+
+    out->resize(ZSTD_compressBound(length));
+    const auto compressed = ZSTD_compressCCtx(
+        static_cast<ZSTD_CCtx*>(_compressor), out->data(), out->size(), bytes, length, level);
+    throw_if_error(compressed, error_code::k_invalid_parameter);
+    out->resize(compressed);
+}
+
+std::size_t zstd_codec::decompress(const std::uint8_t* bytes,
+                                   std::size_t length,
+                                   std::uint8_t* out,
+                                   std::size_t capacity) {
+    if (!_decompressor) {
+        _decompressor = ZSTD_createDCtx();
+    }
+
+    // A frame that would not fit fails with dstSize_tooSmall rather than writing past `capacity`.
+    const auto decompressed = ZSTD_decompressDCtx(
+        static_cast<ZSTD_DCtx*>(_decompressor), out, capacity, bytes, length);
+    throw_if_error(decompressed, error_code::k_gridfs_file_corrupted);
+    return decompressed;
+}
+
+#else
+
+bool zstd_codec::supported() {
+    return false;
+}
+
+bool zstd_codec::valid_level(std::int32_t) {
+    return false;
+}
+
+zstd_codec::~zstd_codec() = default;
+
+void zstd_codec::compress(const std::uint8_t*,
+                          std::size_t,
+                          std::int32_t,
+                          std::vector<std::uint8_t>*) {
+    throw gridfs_exception{error_code::k_compression_not_supported};
+}
+
+std::size_t zstd_codec::decompress(const std::uint8_t*,
+                                   std::size_t,
+                                   std::uint8_t*,
+                                   std::size_t) {
+    throw gridfs_exception{error_code::k_compression_not_supported};
+}
+
+#endif
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <mongocxx/test_util/export_for_testing.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+//
+// Compresses and decompresses buffers with zstd, reusing its contexts from one call to the next.
+// In a driver built without zstd, compress() and decompress() throw a gridfs_exception with
+// error_code::k_compression_not_supported.
+//
+class MONGOCXX_TEST_API zstd_codec {
+   public:
+    // Whether the driver was built with zstd.
+    static bool supported();
+
+    // Whether zstd accepts the compression level. Always false without zstd.
+    static bool valid_level(std::int32_t level);
+
+    zstd_codec() = default;
+    ~zstd_codec();
+
+    zstd_codec(const zstd_codec&) = delete;
+    zstd_codec& operator=(const zstd_codec&) = delete;
+
+    //
+    // Compresses `length` bytes into `out` as a single frame, resizing `out` to the compressed
+    // length.
+    //
+    void compress(const std::uint8_t* bytes,
+                  std::size_t length,
+                  std::int32_t level,
+                  std::vector<std::uint8_t>* out);
+
+    //
+    // Decompresses a frame into `out` and returns its decompressed length. Throws a
+    // gridfs_exception with error_code::k_gridfs_file_corrupted if the frame is malformed or
+    // decompresses to more than `capacity` bytes.
+    //
+    std::size_t decompress(const std::uint8_t* bytes,
+                           std::size_t length,
+                           std::uint8_t* out,
+                           std::size_t capacity);
+
+   private:
+    // A ZSTD_CCtx and a ZSTD_DCtx, created on first use.
+    void* _compressor = nullptr;
+    void* _decompressor = nullptr;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/private/postlude.hh>
@@ -114,9 +114,25 @@ stdx::optional<std::chrono::seconds> read_preference::max_staleness() const {
     return std::chrono::seconds{staleness};
 }
 
+read_preference& read_preference::hedge(bsoncxx::document::view_or_value hedge) {
+    libbson::scoped_bson_t scoped_bson_hedge(std::move(hedge));
+    libmongoc::read_prefs_set_hedge(_impl->read_preference_t, scoped_bson_hedge.bson());
+
+    return *this;
+}
+
+stdx::optional<bsoncxx::document::view> read_preference::hedge() const {
+    const bson_t* bson_hedge = libmongoc::read_prefs_get_hedge(_impl->read_preference_t);
+
+    if (bson_count_keys(bson_hedge))
+        return bsoncxx::document::view(bson_get_data(bson_hedge), bson_hedge->len);
+
+    return stdx::optional<bsoncxx::document::view>{};
+}
+
 bool MONGOCXX_CALL operator==(const read_preference& lhs, const read_preference& rhs) {
     return (lhs.mode() == rhs.mode()) && (lhs.tags() == rhs.tags()) &&
-           (lhs.max_staleness() == rhs.max_staleness());
+           (lhs.max_staleness() == rhs.max_staleness()) && (lhs.hedge() == rhs.hedge());
 }
 
 bool MONGOCXX_CALL operator!=(const read_preference& lhs, const read_preference& rhs) {
@@ -32,6 +32,7 @@ MONGOCXX_INLINE_NAMESPACE_BEGIN
 class client;
 class collection;
 class database;
+class hedged_reader;
 class uri;
 
 namespace events {
@@ -238,6 +239,33 @@ class MONGOCXX_API read_preference {
     ///
     stdx::optional<std::chrono::seconds> max_staleness() const;
 
+    ///
+    /// Sets the hedge document for this read_preference. A sharded cluster of MongoDB 4.4 or later
+    /// hedges reads that use this read preference when the document is `{enabled: true}`: mongos
+    /// sends each read to two eligible members of the shard and returns the first response.
+    ///
+    /// Hedging is enabled by default for the nearest mode, and may be enabled for any mode but
+    /// primary. Servers other than mongos ignore the hedge document; see mongocxx::hedged_reader
+    /// for hedging reads from a replica set on the client side.
+    ///
+    /// @param hedge
+    ///   The hedge document, e.g. `{enabled: true}`. An empty document unsets it.
+    ///
+    /// @see https://docs.mongodb.com/master/core/read-preference-hedge-option/
+    ///
+    /// @return
+    ///   A reference to the object on which this member function is being called.  This facilitates
+    ///   method chaining.
+    ///
+    read_preference& hedge(bsoncxx::document::view_or_value hedge);
+
+    ///
+    /// Returns the current hedge document for this read_preference.
+    ///
+    /// @return The optionally set current hedge document.
+    ///
+    stdx::optional<bsoncxx::document::view> hedge() const;
+
    private:
     friend client;
     friend collection;
@@ -245,6 +273,7 @@ class MONGOCXX_API read_preference {
     friend options::transaction;
     friend events::topology_description;
     friend uri;
+    friend hedged_reader;
 
     ///
     /// @{
@@ -23,6 +23,9 @@ namespace result {
 bulk_write::bulk_write(bsoncxx::document::value raw_response)
     : _response(std::move(raw_response)) {}
 
+bulk_write::bulk_write(bsoncxx::document::value raw_response, operation_stats stats)
+    : _response(std::move(raw_response)), _stats(stats) {}
+
 std::int32_t bulk_write::inserted_count() const {
     return view()["nInserted"].get_int32();
 }
@@ -56,6 +59,10 @@ bulk_write::id_map bulk_write::upserted_ids() const {
     return upserted_ids;
 }
 
+const operation_stats& bulk_write::stats() const {
+    return _stats;
+}
+
 bsoncxx::document::view bulk_write::view() const {
     return _response.view();
 }
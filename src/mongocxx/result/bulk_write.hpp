@@ -21,11 +21,16 @@
 #include <bsoncxx/document/value.hpp>
 #include <bsoncxx/document/view.hpp>
 #include <bsoncxx/types.hpp>
+#include <mongocxx/operation_stats.hpp>
 
 #include <mongocxx/config/prelude.hpp>
 
 namespace mongocxx {
 MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class bulk_write;
+class collection;
+
 namespace result {
 
 ///
@@ -83,10 +88,24 @@ class MONGOCXX_API bulk_write {
     ///
     id_map upserted_ids() const;
 
+    ///
+    /// Gets the network traffic of this operation, if the client was created with
+    /// options::apm::record_operation_stats().
+    ///
+    /// @return The bytes sent and received, round-trips and command durations of the operation.
+    ///
+    const operation_stats& stats() const;
+
    private:
+    friend class mongocxx::bulk_write;
+    friend class mongocxx::collection;
+
+    MONGOCXX_PRIVATE bulk_write(bsoncxx::document::value raw_response, operation_stats stats);
+
     MONGOCXX_PRIVATE bsoncxx::document::view view() const;
 
     bsoncxx::document::value _response;
+    operation_stats _stats;
 
     friend MONGOCXX_API bool MONGOCXX_CALL operator==(const bulk_write&, const bulk_write&);
     friend MONGOCXX_API bool MONGOCXX_CALL operator!=(const bulk_write&, const bulk_write&);
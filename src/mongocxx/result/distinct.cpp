@@ -0,0 +1,43 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/result/distinct.hpp>
+
+#include <utility>
+
+#include <bsoncxx/types.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace result {
+
+distinct::distinct(bsoncxx::document::value reply) : _reply(std::move(reply)) {}
+
+bsoncxx::document::view distinct::reply() const {
+    return _reply.view();
+}
+
+bsoncxx::array::view distinct::values() const {
+    auto values = _reply.view()["values"];
+    if (!values || values.type() != bsoncxx::type::k_array) {
+        return bsoncxx::array::view{};
+    }
+    return values.get_array().value;
+}
+
+}  // namespace result
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,63 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace result {
+
+///
+/// Class representing the result of a MongoDB distinct command, as returned by
+/// collection::distinct_values().
+///
+/// The result owns the server's reply, and values() views the array of distinct values inside it
+/// without copying.
+///
+class MONGOCXX_API distinct {
+   public:
+    // This constructor is public for testing purposes only
+    explicit distinct(bsoncxx::document::value reply);
+
+    ///
+    /// Returns the reply of the distinct command.
+    ///
+    /// @return The raw server reply.
+    ///
+    bsoncxx::document::view reply() const;
+
+    ///
+    /// Gets the distinct values.
+    ///
+    /// @return
+    ///   A view of the "values" array of the reply, which is valid for the lifetime of this
+    ///   result. It is empty if the reply has no such array.
+    ///
+    bsoncxx::array::view values() const;
+
+   private:
+    bsoncxx::document::value _reply;
+};
+
+}  // namespace result
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,196 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/result/explain.hpp>
+
+#include <utility>
+
+#include <bsoncxx/array/view.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace result {
+
+namespace {
+
+using bsoncxx::document::view;
+
+// Plans nest their stages, and sharded plans their shards, only a few levels deep; a reply nested
+// deeper than this is not walked further.
+constexpr int k_max_plan_depth = 64;
+
+view sub_document(view doc, stdx::string_view key) {
+    auto element = doc[key];
+    if (!element || element.type() != bsoncxx::type::k_document) {
+        return view{};
+    }
+    return element.get_document().value;
+}
+
+stdx::optional<std::int64_t> integer(view doc, stdx::string_view key) {
+    auto element = doc[key];
+    if (!element) {
+        return stdx::nullopt;
+    }
+    switch (element.type()) {
+        case bsoncxx::type::k_int32:
+            return element.get_int32().value;
+        case bsoncxx::type::k_int64:
+            return element.get_int64().value;
+        case bsoncxx::type::k_double:
+            return static_cast<std::int64_t>(element.get_double().value);
+        default:
+            return stdx::nullopt;
+    }
+}
+
+// The document that holds the queryPlanner and executionStats of the reply: the reply itself, the
+// $cursor stage that begins an aggregation, or the reply of the first shard of an aggregation
+// on a sharded cluster.
+view planner_root(view reply, int depth = 0) {
+    if (reply["queryPlanner"] || depth == k_max_plan_depth) {
+        return reply;
+    }
+
+    auto stages = reply["stages"];
+    if (stages && stages.type() == bsoncxx::type::k_array) {
+        for (auto&& stage : stages.get_array().value) {
+            if (stage.type() == bsoncxx::type::k_document) {
+                auto cursor = sub_document(stage.get_document().value, "$cursor");
+                if (!cursor.empty()) {
+                    return planner_root(cursor, depth + 1);
+                }
+            }
+            break;
+        }
+    }
+
+    for (auto&& shard : sub_document(reply, "shards")) {
+        if (shard.type() == bsoncxx::type::k_document) {
+            return planner_root(shard.get_document().value, depth + 1);
+        }
+    }
+    return reply;
+}
+
+// The winning plan of a queryPlanner, which servers that run it in the slot-based engine nest in
+// a queryPlan document.
+view winning_plan(view query_planner) {
+    auto plan = sub_document(query_planner, "winningPlan");
+    auto query_plan = sub_document(plan, "queryPlan");
+    return query_plan.empty() ? plan : query_plan;
+}
+
+// Appends the indexes a plan scans, and notes whether it scans the collection.
+void walk_plan(view plan, std::vector<std::string>& indexes, bool& collection_scan, int depth) {
+    if (depth == k_max_plan_depth) {
+        return;
+    }
+
+    auto stage = plan["stage"];
+    if (stage && stage.type() == bsoncxx::type::k_utf8 &&
+        stage.get_utf8().value == stdx::string_view{"COLLSCAN"}) {
+        collection_scan = true;
+    }
+
+    auto index_name = plan["indexName"];
+    if (index_name && index_name.type() == bsoncxx::type::k_utf8) {
+        indexes.push_back(bsoncxx::string::to_string(index_name.get_utf8().value));
+    }
+
+    for (auto key : {"inputStage", "outerStage", "innerStage"}) {
+        auto input = sub_document(plan, key);
+        if (!input.empty()) {
+            walk_plan(input, indexes, collection_scan, depth + 1);
+        }
+    }
+
+    for (auto key : {"inputStages", "shards"}) {
+        auto children = plan[key];
+        if (!children || children.type() != bsoncxx::type::k_array) {
+            continue;
+        }
+        for (auto&& child : children.get_array().value) {
+            if (child.type() != bsoncxx::type::k_document) {
+                continue;
+            }
+            auto child_plan = child.get_document().value;
+            if (child_plan["winningPlan"]) {
+                child_plan = winning_plan(child_plan);
+            }
+            walk_plan(child_plan, indexes, collection_scan, depth + 1);
+        }
+    }
+}
+
+}  // namespace
+
+explain::explain(bsoncxx::document::value reply) : _reply(std::move(reply)) {
+    auto root = planner_root(_reply.view());
+
+    auto plan = winning_plan(sub_document(root, "queryPlanner"));
+    auto stage = plan["stage"];
+    if (stage && stage.type() == bsoncxx::type::k_utf8) {
+        _winning_stage = bsoncxx::string::to_string(stage.get_utf8().value);
+    }
+    walk_plan(plan, _indexes, _collection_scan, 0);
+
+    auto stats = sub_document(root, "executionStats");
+    _returned = integer(stats, "nReturned");
+    _docs_examined = integer(stats, "totalDocsExamined");
+    _keys_examined = integer(stats, "totalKeysExamined");
+    if (auto millis = integer(stats, "executionTimeMillis")) {
+        _execution_time = std::chrono::milliseconds{*millis};
+    }
+}
+
+bsoncxx::document::view explain::reply() const {
+    return _reply.view();
+}
+
+const std::string& explain::winning_stage() const {
+    return _winning_stage;
+}
+
+const std::vector<std::string>& explain::indexes() const {
+    return _indexes;
+}
+
+bool explain::collection_scan() const {
+    return _collection_scan;
+}
+
+const stdx::optional<std::int64_t>& explain::returned() const {
+    return _returned;
+}
+
+const stdx::optional<std::int64_t>& explain::docs_examined() const {
+    return _docs_examined;
+}
+
+const stdx::optional<std::int64_t>& explain::keys_examined() const {
+    return _keys_examined;
+}
+
+const stdx::optional<std::chrono::milliseconds>& explain::execution_time() const {
+    return _execution_time;
+}
+
+}  // namespace result
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
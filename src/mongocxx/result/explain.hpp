@@ -0,0 +1,118 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace result {
+
+///
+/// Class representing the reply of an explain command, as returned by collection::explain_find(),
+/// collection::explain_aggregate() and collection::explain_update().
+///
+/// The summary is read from the plan of the first stage of an aggregation, and from the first
+/// shard of a sharded cluster, for which the execution statistics are totals over every shard.
+/// The execution statistics are only reported with explain_verbosity::k_execution_stats or
+/// explain_verbosity::k_all_plans_execution.
+///
+class MONGOCXX_API explain {
+   public:
+    // This constructor is public for testing purposes only
+    explicit explain(bsoncxx::document::value reply);
+
+    ///
+    /// Returns the reply of the explain command.
+    ///
+    /// @return The raw server reply.
+    ///
+    bsoncxx::document::view reply() const;
+
+    ///
+    /// Gets the root stage of the winning plan, such as "FETCH", "COLLSCAN" or "SHARD_MERGE".
+    ///
+    /// @return The name of the stage, or an empty string if the reply has no winning plan.
+    ///
+    const std::string& winning_stage() const;
+
+    ///
+    /// Gets the indexes scanned by the winning plan.
+    ///
+    /// @return The names of the indexes, in the order the plan lists them.
+    ///
+    const std::vector<std::string>& indexes() const;
+
+    ///
+    /// Gets whether the winning plan scans the whole collection.
+    ///
+    /// @return Whether any stage of the winning plan is a COLLSCAN.
+    ///
+    bool collection_scan() const;
+
+    ///
+    /// Gets the number of documents the plan returned.
+    ///
+    /// @return The nReturned of the execution statistics, if reported.
+    ///
+    const stdx::optional<std::int64_t>& returned() const;
+
+    ///
+    /// Gets the number of documents the plan examined.
+    ///
+    /// @return The totalDocsExamined of the execution statistics, if reported.
+    ///
+    const stdx::optional<std::int64_t>& docs_examined() const;
+
+    ///
+    /// Gets the number of index keys the plan examined.
+    ///
+    /// @return The totalKeysExamined of the execution statistics, if reported.
+    ///
+    const stdx::optional<std::int64_t>& keys_examined() const;
+
+    ///
+    /// Gets how long the plan took to run.
+    ///
+    /// @return The executionTimeMillis of the execution statistics, if reported.
+    ///
+    const stdx::optional<std::chrono::milliseconds>& execution_time() const;
+
+   private:
+    bsoncxx::document::value _reply;
+    std::string _winning_stage;
+    std::vector<std::string> _indexes;
+    bool _collection_scan = false;
+    stdx::optional<std::int64_t> _returned;
+    stdx::optional<std::int64_t> _docs_examined;
+    stdx::optional<std::int64_t> _keys_examined;
+    stdx::optional<std::chrono::milliseconds> _execution_time;
+};
+
+}  // namespace result
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,46 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/result/gridfs/delete_files.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace result {
+namespace gridfs {
+
+delete_files::delete_files(std::int64_t files_deleted, std::int64_t chunks_deleted)
+    : _files_deleted(files_deleted), _chunks_deleted(chunks_deleted) {}
+
+std::int64_t delete_files::files_deleted() const {
+    return _files_deleted;
+}
+
+std::int64_t delete_files::chunks_deleted() const {
+    return _chunks_deleted;
+}
+
+bool MONGOCXX_CALL operator==(const delete_files& lhs, const delete_files& rhs) {
+    return lhs.files_deleted() == rhs.files_deleted() &&
+           lhs.chunks_deleted() == rhs.chunks_deleted();
+}
+bool MONGOCXX_CALL operator!=(const delete_files& lhs, const delete_files& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace gridfs
+}  // namespace result
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
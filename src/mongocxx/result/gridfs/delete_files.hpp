@@ -0,0 +1,58 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+namespace result {
+namespace gridfs {
+
+/// Class representing the result of a GridFS delete_files operation.
+class MONGOCXX_API delete_files {
+   public:
+    delete_files(std::int64_t files_deleted, std::int64_t chunks_deleted);
+
+    ///
+    /// Gets the number of files documents that were deleted. Ids without a file are not counted.
+    ///
+    /// @return The number of deleted files.
+    ///
+    std::int64_t files_deleted() const;
+
+    ///
+    /// Gets the number of chunks that were deleted.
+    ///
+    /// @return The number of deleted chunks.
+    ///
+    std::int64_t chunks_deleted() const;
+
+   private:
+    std::int64_t _files_deleted;
+    std::int64_t _chunks_deleted;
+
+    friend MONGOCXX_API bool MONGOCXX_CALL operator==(const delete_files&, const delete_files&);
+    friend MONGOCXX_API bool MONGOCXX_CALL operator!=(const delete_files&, const delete_files&);
+};
+
+}  // namespace gridfs
+}  // namespace result
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -40,9 +40,8 @@ insert_many& insert_many::operator=(const insert_many& src) {
 
 void insert_many::_buildInsertedIds() {
     _inserted_ids.clear();
-    std::size_t index = 0;
     for (auto&& ele : _inserted_ids_owned.view()) {
-        _inserted_ids.emplace(index++, ele.get_document().value["_id"]);
+        _inserted_ids.push_back(ele.get_document().value["_id"]);
     }
 }
 
@@ -55,19 +54,35 @@ std::int32_t insert_many::inserted_count() const {
 }
 
 insert_many::id_map insert_many::inserted_ids() const {
+    id_map ids;
+    std::size_t index = 0;
+    for (auto&& ele : _inserted_ids_owned.view()) {
+        // An insert that dropped duplicates records the input position of each document it sent.
+        auto id_doc = ele.get_document().value;
+        if (auto position = id_doc["index"]) {
+            index = static_cast<std::size_t>(position.get_int64().value);
+        }
+        ids.emplace_hint(ids.end(), index++, id_doc["_id"]);
+    }
+    return ids;
+}
+
+const insert_many::id_vector& insert_many::inserted_id_vector() const {
     return _inserted_ids;
 }
 
+const operation_stats& insert_many::stats() const {
+    return _result.stats();
+}
+
 bool MONGOCXX_CALL operator==(const insert_many& lhs, const insert_many& rhs) {
     if (lhs.result() != rhs.result()) {
         return false;
-    } else if (lhs.inserted_ids().size() != rhs.inserted_ids().size()) {
+    } else if (lhs._inserted_ids.size() != rhs._inserted_ids.size()) {
         return false;
     }
-    insert_many::id_map::const_iterator litr = lhs._inserted_ids.begin();
-    insert_many::id_map::const_iterator ritr = rhs._inserted_ids.begin();
-    for (; litr != lhs._inserted_ids.end(); litr++, ritr++) {
-        if (litr->first != ritr->first || litr->second.get_oid() != ritr->second.get_oid()) {
+    for (std::size_t i = 0; i < lhs._inserted_ids.size(); i++) {
+        if (lhs._inserted_ids[i].get_oid() != rhs._inserted_ids[i].get_oid()) {
             return false;
         }
     }
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <map>
+#include <vector>
 
 #include <bsoncxx/array/value.hpp>
 #include <bsoncxx/types.hpp>
@@ -37,6 +38,7 @@ namespace result {
 class MONGOCXX_API insert_many {
    public:
     using id_map = std::map<std::size_t, bsoncxx::document::element>;
+    using id_vector = std::vector<bsoncxx::document::element>;
 
     insert_many(result::bulk_write result, bsoncxx::array::value inserted_ids);
 
@@ -65,10 +67,35 @@ class MONGOCXX_API insert_many {
     ///
     /// @note The returned id_map must not be accessed after the result::insert_many object is
     /// destroyed.
-    /// @return Map of the index of the operation to the _id of the inserted document.
+    /// @note The map is built on each call; inserted_id_vector() provides the same ids without
+    /// allocating.
+    /// @return Map of the index of the operation to the _id of the inserted document. The index is
+    /// the position of the document in the input, even when options::insert::dedupe_by() dropped
+    /// earlier documents.
     ///
     id_map inserted_ids() const;
 
+    ///
+    /// Gets the _ids of the inserted documents, indexed by the position of the document in the
+    /// insert_many call.
+    ///
+    /// @note The returned elements must not be accessed after the result::insert_many object is
+    /// destroyed.
+    /// @return The _ids of the inserted documents, or an empty vector if the operation was run
+    /// with options::insert::skip_inserted_ids. With options::insert::dedupe_by(), the dropped
+    /// duplicates have no entry, so the positions count only the documents sent; inserted_ids()
+    /// maps them back to the input.
+    ///
+    const id_vector& inserted_id_vector() const;
+
+    ///
+    /// Gets the network traffic of this operation, if the client was created with
+    /// options::apm::record_operation_stats().
+    ///
+    /// @return The bytes sent and received, round-trips and command durations of the operation.
+    ///
+    const operation_stats& stats() const;
+
    private:
     friend collection;
 
@@ -82,7 +109,7 @@ class MONGOCXX_API insert_many {
     bsoncxx::array::value _inserted_ids_owned;
 
     // Points into _inserted_ids_owned.
-    id_map _inserted_ids;
+    id_vector _inserted_ids;
 
     friend MONGOCXX_API bool MONGOCXX_CALL operator==(const insert_many&, const insert_many&);
     friend MONGOCXX_API bool MONGOCXX_CALL operator!=(const insert_many&, const insert_many&);
@@ -0,0 +1,370 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/shard_change_streams.hpp>
+
+#include <algorithm>
+#include <system_error>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/change_stream.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/shard_change_streams.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+std::uint64_t cluster_time_of(const bsoncxx::document::view& event) {
+    auto cluster_time = event["clusterTime"].try_get<bsoncxx::types::b_timestamp>();
+    if (!cluster_time) {
+        return 0;
+    }
+    return std::uint64_t{cluster_time->timestamp} << 32 | cluster_time->increment;
+}
+
+// Resume tokens of MongoDB 4.2 and later hold a hex-encoded key string in _data, which starts
+// with a type byte of 0x82 followed by the big-endian seconds and increment of the cluster time.
+// Returns zero for tokens in any other form.
+std::uint64_t cluster_time_of_token(const bsoncxx::document::view& token) {
+    auto data = token["_data"].try_get<bsoncxx::types::b_utf8>();
+    if (!data || data->value.size() < 18 || data->value[0] != '8' || data->value[1] != '2') {
+        return 0;
+    }
+
+    std::uint64_t cluster_time = 0;
+    for (std::size_t i = 2; i < 18; ++i) {
+        const char c = data->value[i];
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return 0;
+        }
+        cluster_time = cluster_time << 4 | static_cast<std::uint64_t>(digit);
+    }
+    return cluster_time;
+}
+
+// Points the cluster's URI at a shard, given the host field of its config.shards entry, which
+// has the form "replicaSet/host1,host2". Credentials and options are kept.
+std::string shard_uri(const std::string& cluster, const std::string& shard_hosts) {
+    const std::string srv_scheme = "mongodb+srv://";
+    const std::string scheme = "mongodb://";
+
+    const bool srv = cluster.compare(0, srv_scheme.size(), srv_scheme) == 0;
+    auto rest = cluster.substr(srv ? srv_scheme.size() : scheme.size());
+
+    auto authority_end = std::min(rest.find('/'), rest.find('?'));
+    auto authority = rest.substr(0, authority_end);
+    auto path = authority_end == std::string::npos ? std::string{} : rest.substr(authority_end);
+
+    auto at = authority.rfind('@');
+    auto userinfo = at == std::string::npos ? std::string{} : authority.substr(0, at + 1);
+
+    auto slash = shard_hosts.find('/');
+    auto hosts = slash == std::string::npos ? shard_hosts : shard_hosts.substr(slash + 1);
+
+    std::string extra;
+    if (slash != std::string::npos) {
+        extra = "replicaSet=" + shard_hosts.substr(0, slash);
+    }
+
+    // An SRV record resolves to the mongos hosts, so the shard is connected to directly instead,
+    // which loses the TLS default that the SRV scheme implies.
+    if (srv && path.find("tls=") == std::string::npos && path.find("ssl=") == std::string::npos) {
+        extra += extra.empty() ? "tls=true" : "&tls=true";
+    }
+
+    if (!extra.empty()) {
+        auto query = path.find('?');
+        if (query == std::string::npos) {
+            path += path.empty() ? "/?" : "?";
+        } else if (query + 1 != path.size() && path.back() != '&') {
+            path += "&";
+        }
+        path += extra;
+    }
+
+    return scheme + userinfo + hosts + path;
+}
+
+}  // namespace
+
+void shard_change_streams::impl::watch(std::size_t index,
+                                       const pipeline* pipe,
+                                       const options::change_stream* options) {
+    try {
+        mongocxx::pool pool{mongocxx::uri{shards[index].uri}};
+        auto client = pool.acquire();
+
+        auto stream = database.empty()
+                          ? client->watch(*pipe, *options)
+                          : collection.empty()
+                                ? (*client)[database].watch(*pipe, *options)
+                                : (*client)[database][collection].watch(*pipe, *options);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            shards[index].opened = true;
+        }
+        changed.notify_all();
+
+        for (;;) {
+            for (auto&& event : stream) {
+                if (!push(index, event)) {
+                    finish(index, nullptr);
+                    return;
+                }
+            }
+
+            // Without further events, the resume token is the post-batch resume token, which
+            // tells how far the shard has been read.
+            if (auto token = stream.get_resume_token()) {
+                advance_high_water(index, cluster_time_of_token(*token));
+            }
+
+            std::lock_guard<std::mutex> lock{mutex};
+            if (stopping) {
+                break;
+            }
+        }
+        finish(index, nullptr);
+    } catch (...) {
+        finish(index, std::current_exception());
+    }
+}
+
+bool shard_change_streams::impl::push(std::size_t index, const bsoncxx::document::view& document) {
+    const auto cluster_time = cluster_time_of(document);
+
+    std::unique_lock<std::mutex> lock{mutex};
+    auto& queue = shards[index].events;
+    room.wait(lock, [&] { return stopping || queue.size() < queue_capacity; });
+    if (stopping) {
+        return false;
+    }
+
+    queue.push_back(event{bsoncxx::document::value{document}, cluster_time});
+    shards[index].high_water = std::max(shards[index].high_water, cluster_time);
+    lock.unlock();
+
+    changed.notify_all();
+    return true;
+}
+
+void shard_change_streams::impl::advance_high_water(std::size_t index,
+                                                    std::uint64_t cluster_time) {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (cluster_time <= shards[index].high_water) {
+            return;
+        }
+        shards[index].high_water = cluster_time;
+    }
+    changed.notify_all();
+}
+
+void shard_change_streams::impl::finish(std::size_t index, std::exception_ptr error) {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        shards[index].opened = true;
+        shards[index].finished = true;
+        shards[index].error = error;
+    }
+    changed.notify_all();
+}
+
+bool shard_change_streams::impl::releasable(std::size_t index) const {
+    const auto cluster_time = shards[index].events.front().cluster_time;
+    for (const auto& other : shards) {
+        if (other.events.empty() && other.high_water < cluster_time) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void shard_change_streams::impl::stop() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    room.notify_all();
+    changed.notify_all();
+
+    for (auto&& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+shard_change_streams::shard_change_streams(const uri& cluster_uri,
+                                           bsoncxx::string::view_or_value database,
+                                           bsoncxx::string::view_or_value collection,
+                                           const pipeline& pipe,
+                                           const options::change_stream& options,
+                                           std::size_t queue_capacity)
+    : _impl(stdx::make_unique<impl>(bsoncxx::string::to_string(database.view()),
+                                    bsoncxx::string::to_string(collection.view()),
+                                    std::max<std::size_t>(queue_capacity, 1))) {
+    const auto cluster = cluster_uri.to_string();
+    {
+        client mongos{cluster_uri};
+        for (auto&& entry : mongos["config"]["shards"].find(bsoncxx::document::view{})) {
+            impl::shard shard;
+            shard.name = bsoncxx::string::to_string(entry["_id"].get_utf8().value);
+            shard.uri =
+                shard_uri(cluster, bsoncxx::string::to_string(entry["host"].get_utf8().value));
+            _impl->shards.push_back(std::move(shard));
+        }
+    }
+    if (_impl->shards.empty()) {
+        throw logic_error{error_code::k_invalid_parameter, "the deployment has no shards"};
+    }
+
+    options::change_stream shard_options = options;
+    if (!shard_options.max_await_time()) {
+        shard_options.max_await_time(std::chrono::seconds{1});
+    }
+
+    try {
+        for (std::size_t i = 0; i < _impl->shards.size(); ++i) {
+            auto impl = _impl.get();
+            auto stages = &pipe;
+            auto opts = &shard_options;
+            _impl->threads.emplace_back([=] { impl->watch(i, stages, opts); });
+        }
+    } catch (const std::system_error&) {
+        _impl->stop();
+        throw;
+    }
+
+    // Wait for every stream to open, so that the pipeline and options outlive their use.
+    std::unique_lock<std::mutex> lock{_impl->mutex};
+    _impl->changed.wait(lock, [&] {
+        return std::all_of(_impl->shards.begin(),
+                           _impl->shards.end(),
+                           [](const impl::shard& shard) { return shard.opened; });
+    });
+}
+
+shard_change_streams::shard_change_streams(shard_change_streams&&) noexcept = default;
+shard_change_streams& shard_change_streams::operator=(shard_change_streams&&) noexcept = default;
+
+shard_change_streams::~shard_change_streams() {
+    if (_impl) {
+        _impl->stop();
+    }
+}
+
+std::size_t shard_change_streams::shard_count() const noexcept {
+    return _impl->shards.size();
+}
+
+const std::string& shard_change_streams::shard_name(std::size_t shard) const {
+    if (shard >= _impl->shards.size()) {
+        throw logic_error{error_code::k_invalid_parameter, "no such shard"};
+    }
+    return _impl->shards[shard].name;
+}
+
+stdx::optional<bsoncxx::document::value> shard_change_streams::pop(
+    std::size_t shard, std::chrono::milliseconds timeout) {
+    if (shard >= _impl->shards.size()) {
+        throw logic_error{error_code::k_invalid_parameter, "no such shard"};
+    }
+
+    std::unique_lock<std::mutex> lock{_impl->mutex};
+    auto& state = _impl->shards[shard];
+    _impl->changed.wait_for(lock, timeout, [&] {
+        return !state.events.empty() || state.finished || _impl->stopping;
+    });
+
+    if (!state.events.empty()) {
+        auto document = std::move(state.events.front().document);
+        state.events.pop_front();
+        lock.unlock();
+
+        _impl->room.notify_all();
+        return {std::move(document)};
+    }
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    return {};
+}
+
+stdx::optional<bsoncxx::document::value> shard_change_streams::pop_merged(
+    std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock{_impl->mutex};
+    for (;;) {
+        if (_impl->stopping) {
+            return {};
+        }
+
+        std::size_t oldest = _impl->shards.size();
+        for (std::size_t i = 0; i < _impl->shards.size(); ++i) {
+            const auto& state = _impl->shards[i];
+            if (state.error) {
+                std::rethrow_exception(state.error);
+            }
+            if (!state.events.empty() &&
+                (oldest == _impl->shards.size() ||
+                 state.events.front().cluster_time <
+                     _impl->shards[oldest].events.front().cluster_time)) {
+                oldest = i;
+            }
+        }
+
+        if (oldest != _impl->shards.size() && _impl->releasable(oldest)) {
+            auto& queue = _impl->shards[oldest].events;
+            auto document = std::move(queue.front().document);
+            queue.pop_front();
+            lock.unlock();
+
+            _impl->room.notify_all();
+            return {std::move(document)};
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return {};
+        }
+        _impl->changed.wait_until(lock, deadline);
+    }
+}
+
+void shard_change_streams::stop() {
+    _impl->stop();
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
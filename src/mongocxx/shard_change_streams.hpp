@@ -0,0 +1,146 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/options/change_stream.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/uri.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Change streams opened directly on each shard of a sharded cluster, so that shards deliver
+/// their events in parallel instead of through one stream merged by mongos.
+///
+/// The shards are read from the cluster's config.shards collection when the object is
+/// constructed. Each shard is then watched by its own thread over its own connection pool, and
+/// its events are copied into a bounded queue for that shard. A full queue stops its shard's
+/// thread from reading further events until the consumer catches up.
+///
+/// Events can be consumed per shard with pop(), for consumers that only need the order within a
+/// shard, or across shards with pop_merged(), which returns them in clusterTime order.
+///
+/// @warning
+///   Watching shards directly bypasses mongos, so events caused by chunk migrations on the
+///   shards are delivered as well. Only use this for workloads that tolerate them.
+///
+class MONGOCXX_API shard_change_streams {
+   public:
+    ///
+    /// Reads the shard list and starts watching every shard.
+    ///
+    /// @param cluster_uri
+    ///   The URI of the sharded cluster. Each shard is connected to with the same credentials
+    ///   and options, pointed at the shard's replica set.
+    /// @param database
+    ///   The database to watch, or an empty string to watch the whole deployment.
+    /// @param collection
+    ///   The collection to watch, or an empty string to watch the whole database.
+    /// @param pipe
+    ///   An aggregation pipeline applied to every shard's stream.
+    /// @param options
+    ///   The options of every shard's stream. If max_await_time is not set, one second is used so
+    ///   that the shard threads notice when they are stopped.
+    /// @param queue_capacity
+    ///   The largest number of events buffered per shard.
+    ///
+    /// @throws mongocxx::logic_error if the deployment has no shards.
+    /// @throws mongocxx::query_exception if the shard list could not be read.
+    ///
+    shard_change_streams(const uri& cluster_uri,
+                         bsoncxx::string::view_or_value database,
+                         bsoncxx::string::view_or_value collection,
+                         const pipeline& pipe = pipeline{},
+                         const options::change_stream& options = {},
+                         std::size_t queue_capacity = 1024);
+
+    shard_change_streams(shard_change_streams&&) noexcept;
+    shard_change_streams& operator=(shard_change_streams&&) noexcept;
+
+    ///
+    /// Stops watching and waits for the shard threads to finish.
+    ///
+    ~shard_change_streams();
+
+    ///
+    /// @return The number of shards being watched.
+    ///
+    std::size_t shard_count() const noexcept;
+
+    ///
+    /// @return The name of a shard, as recorded in config.shards.
+    ///
+    const std::string& shard_name(std::size_t shard) const;
+
+    ///
+    /// Takes the oldest queued event of one shard.
+    ///
+    /// @param shard
+    ///   The index of the shard, less than shard_count().
+    /// @param timeout
+    ///   How long to wait for an event if none is queued.
+    ///
+    /// @return The event, or no value if none arrived in time or the streams were stopped.
+    ///
+    /// @throws mongocxx::logic_error if the index is out of range.
+    /// @throws the error that ended the shard's stream, once its queued events are consumed.
+    ///
+    stdx::optional<bsoncxx::document::value> pop(std::size_t shard,
+                                                 std::chrono::milliseconds timeout);
+
+    ///
+    /// Takes the event with the lowest clusterTime across all shards.
+    ///
+    /// An event is only returned once every other shard has either queued a later event or
+    /// reported, through its post-batch resume token, that it has no earlier one. A slow shard
+    /// therefore holds back the merged view, just as it holds back a stream opened through mongos.
+    ///
+    /// @param timeout
+    ///   How long to wait for an event to become available.
+    ///
+    /// @return The event, or no value if none became available in time or the streams were
+    ///   stopped.
+    ///
+    /// @throws the error that ended any shard's stream, since the order can then not be kept.
+    ///
+    stdx::optional<bsoncxx::document::value> pop_merged(std::chrono::milliseconds timeout);
+
+    ///
+    /// Stops watching. Queued events can still be consumed with pop().
+    ///
+    void stop();
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
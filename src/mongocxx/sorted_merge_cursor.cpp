@@ -0,0 +1,177 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/sorted_merge_cursor.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/private/cursor.hh>
+#include <mongocxx/private/sorted_merge_cursor.hh>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+sorted_merge_cursor::impl::impl(std::vector<cursor> cursors, bsoncxx::document::value sort)
+    : cursors(std::move(cursors)),
+      sort(std::move(sort)),
+      keys(this->sort.view()),
+      values(this->cursors.size() * keys.size()) {
+    heap.reserve(this->cursors.size());
+}
+
+void sorted_merge_cursor::impl::advance() {
+    if (has_current) {
+        has_current = false;
+        auto iter = cursors[current].begin();
+        ++iter;
+        push(current);
+    } else if (!primed) {
+        primed = true;
+        for (std::size_t i = 0; i < cursors.size(); i++) {
+            push(i);
+        }
+    }
+
+    if (heap.empty()) {
+        doc = bsoncxx::document::view{};
+        exhausted = true;
+        return;
+    }
+
+    const auto later_than = [this](std::size_t lhs, std::size_t rhs) { return later(lhs, rhs); };
+    std::pop_heap(heap.begin(), heap.end(), later_than);
+    current = heap.back();
+    heap.pop_back();
+    has_current = true;
+    doc = *cursors[current].begin();
+}
+
+void sorted_merge_cursor::impl::push(std::size_t index) {
+    auto iter = cursors[index].begin();
+    if (iter == cursors[index].end()) {
+        return;
+    }
+
+    keys.extract(*iter, &values[index * keys.size()]);
+    heap.push_back(index);
+    std::push_heap(heap.begin(), heap.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return later(lhs, rhs);
+    });
+}
+
+bool sorted_merge_cursor::impl::later(std::size_t lhs, std::size_t rhs) const {
+    const int result = keys.compare(&values[lhs * keys.size()], &values[rhs * keys.size()]);
+    return result > 0 || (result == 0 && lhs > rhs);
+}
+
+sorted_merge_cursor::sorted_merge_cursor(std::vector<cursor> cursors,
+                                         bsoncxx::document::view_or_value sort,
+                                         std::int32_t prefetch_batches) {
+    if (prefetch_batches < 0) {
+        throw logic_error{error_code::k_invalid_parameter, "prefetch_batches must not be negative"};
+    }
+
+    for (auto&& input : cursors) {
+        if (input._impl->is_tailable()) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "tailable cursors cannot be merged in sort order"};
+        }
+    }
+
+    _impl = stdx::make_unique<impl>(std::move(cursors), bsoncxx::document::value{sort.view()});
+
+    if (prefetch_batches > 0) {
+        for (auto&& input : _impl->cursors) {
+            if (!input._impl->has_started() && !input._impl->is_prefetching()) {
+                input._impl->start_prefetch(prefetch_batches, stdx::nullopt);
+            }
+        }
+    }
+}
+
+sorted_merge_cursor::sorted_merge_cursor(sorted_merge_cursor&&) noexcept = default;
+sorted_merge_cursor& sorted_merge_cursor::operator=(sorted_merge_cursor&&) noexcept = default;
+
+sorted_merge_cursor::~sorted_merge_cursor() = default;
+
+sorted_merge_cursor::iterator sorted_merge_cursor::begin() {
+    if (_impl->exhausted) {
+        return end();
+    }
+    return iterator(this);
+}
+
+sorted_merge_cursor::iterator sorted_merge_cursor::end() {
+    return iterator(nullptr);
+}
+
+sorted_merge_cursor::iterator::iterator(sorted_merge_cursor* cursor) : _cursor(cursor) {
+    if (_cursor == nullptr || _cursor->_impl->started) {
+        return;
+    }
+
+    _cursor->_impl->started = true;
+    operator++();
+}
+
+sorted_merge_cursor::iterator& sorted_merge_cursor::iterator::operator++() {
+    _cursor->_impl->advance();
+    return *this;
+}
+
+void sorted_merge_cursor::iterator::operator++(int) {
+    operator++();
+}
+
+const bsoncxx::document::view& sorted_merge_cursor::iterator::operator*() const {
+    return _cursor->_impl->doc;
+}
+
+const bsoncxx::document::view* sorted_merge_cursor::iterator::operator->() const {
+    return &_cursor->_impl->doc;
+}
+
+//
+// An iterator is exhausted if it is the end-iterator (_cursor == nullptr)
+// or if the underlying _cursor is marked exhausted.
+//
+bool sorted_merge_cursor::iterator::is_exhausted() const {
+    return !_cursor || _cursor->_impl->exhausted;
+}
+
+bool MONGOCXX_CALL operator==(const sorted_merge_cursor::iterator& lhs,
+                              const sorted_merge_cursor::iterator& rhs) {
+    return ((rhs.is_exhausted() && lhs.is_exhausted()) || (lhs._cursor == rhs._cursor));
+}
+
+bool MONGOCXX_CALL operator!=(const sorted_merge_cursor::iterator& lhs,
+                              const sorted_merge_cursor::iterator& rhs) {
+    return !(lhs == rhs);
+}
+
+sorted_merge_cursor MONGOCXX_CALL merge_cursors(std::vector<cursor> cursors,
+                                                bsoncxx::document::view_or_value sort,
+                                                std::int32_t prefetch_batches) {
+    return sorted_merge_cursor{std::move(cursors), std::move(sort), prefetch_batches};
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
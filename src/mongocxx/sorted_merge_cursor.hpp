@@ -0,0 +1,180 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
+#include <mongocxx/cursor.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Class representing the results of several cursors that are each sorted the same way, merged
+/// into a single sorted sequence, such as the results of one query scattered over several
+/// collections or clusters.
+///
+/// The documents are merged with a binary heap holding the next document of each cursor, so
+/// each one costs O(log n) comparisons for n cursors. Only the values of the sort fields are
+/// compared: they are extracted once per document, the top-level ones in a single pass over it.
+/// Values compare in the server's sort order without a collation, see bsoncxx::compare().
+///
+/// Every cursor that has not been iterated yet reads its next batches ahead on a background
+/// thread, as with options::find::prefetch_batches(), so that their getMores overlap.
+///
+/// @warning
+///   The merge is only sorted if every cursor returns its documents sorted by the same
+///   specification, e.g. queries run with that options::find::sort().
+///
+class MONGOCXX_API sorted_merge_cursor {
+   public:
+    class MONGOCXX_API iterator;
+
+    ///
+    /// Creates a sorted_merge_cursor.
+    ///
+    /// @param cursors
+    ///   The cursors to merge, each sorted by `sort`. They are owned by the sorted_merge_cursor.
+    /// @param sort
+    ///   The sort specification of the cursors, such as {a: 1, "b.c": -1}.
+    /// @param prefetch_batches
+    ///   How many batches each cursor may read ahead, or 0 not to read ahead.
+    ///
+    /// @throws mongocxx::logic_error if the sort specification is empty or a direction is not 1
+    /// or -1, if `prefetch_batches` is negative, or if a cursor is tailable.
+    ///
+    sorted_merge_cursor(std::vector<cursor> cursors,
+                        bsoncxx::document::view_or_value sort,
+                        std::int32_t prefetch_batches = 1);
+
+    ///
+    /// Move constructs a sorted_merge_cursor.
+    ///
+    sorted_merge_cursor(sorted_merge_cursor&&) noexcept;
+
+    ///
+    /// Move assigns a sorted_merge_cursor.
+    ///
+    sorted_merge_cursor& operator=(sorted_merge_cursor&&) noexcept;
+
+    ///
+    /// Destroys a sorted_merge_cursor and the cursors it merges.
+    ///
+    ~sorted_merge_cursor();
+
+    ///
+    /// A sorted_merge_cursor::iterator that points to the next document in sort order. As with
+    /// mongocxx::cursor, calling begin() more than once does not restart the results.
+    ///
+    /// @return the sorted_merge_cursor::iterator
+    ///
+    /// @throws mongocxx::query_exception if one of the cursors failed
+    ///
+    iterator begin();
+
+    ///
+    /// A sorted_merge_cursor::iterator indicating that every cursor is exhausted.
+    ///
+    /// @return the sorted_merge_cursor::iterator
+    ///
+    iterator end();
+
+   private:
+    friend class sorted_merge_cursor::iterator;
+
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+///
+/// Class representing an input iterator of documents in a mongocxx::sorted_merge_cursor.
+///
+/// As with cursor::iterator, all non-end iterators of the same sorted_merge_cursor move in
+/// lock-step, and an exhausted iterator must not be dereferenced or incremented.
+///
+class MONGOCXX_API sorted_merge_cursor::iterator
+    : public std::iterator<std::input_iterator_tag, bsoncxx::document::view> {
+   public:
+    ///
+    /// Dereferences the view for the document currently being pointed to. The view remains valid
+    /// until the iterator is incremented.
+    ///
+    const bsoncxx::document::view& operator*() const;
+
+    ///
+    /// Accesses a member of the dereferenced document currently being pointed to.
+    ///
+    const bsoncxx::document::view* operator->() const;
+
+    ///
+    /// Pre-increments the iterator to move to the next document.
+    ///
+    /// @throws mongocxx::query_exception if one of the cursors failed
+    ///
+    iterator& operator++();
+
+    ///
+    /// Post-increments the iterator to move to the next document.
+    ///
+    /// @throws mongocxx::query_exception if one of the cursors failed
+    ///
+    void operator++(int);
+
+   private:
+    friend class sorted_merge_cursor;
+
+    ///
+    /// @{
+    ///
+    /// Compare two iterators for (in)-equality. Iterators compare equal if they point to the same
+    /// underlying sorted_merge_cursor or if both are exhausted.
+    ///
+    /// @relates iterator
+    ///
+    friend MONGOCXX_API bool MONGOCXX_CALL operator==(const iterator&, const iterator&);
+    friend MONGOCXX_API bool MONGOCXX_CALL operator!=(const iterator&, const iterator&);
+    ///
+    /// @}
+    ///
+
+    MONGOCXX_PRIVATE bool is_exhausted() const;
+
+    MONGOCXX_PRIVATE explicit iterator(sorted_merge_cursor* cursor);
+
+    // If this pointer is null, the iterator is considered "past-the-end".
+    sorted_merge_cursor* _cursor;
+};
+
+///
+/// Merges cursors that are each sorted by `sort` into one sorted sequence.
+///
+/// @see sorted_merge_cursor
+///
+MONGOCXX_API sorted_merge_cursor MONGOCXX_CALL merge_cursors(std::vector<cursor> cursors,
+                                                             bsoncxx::document::view_or_value sort,
+                                                             std::int32_t prefetch_batches = 1);
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
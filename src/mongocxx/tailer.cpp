@@ -0,0 +1,210 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/tailer.hpp>
+
+#include <utility>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/private/mongoc_error.hh>
+#include <mongocxx/exception/query_exception.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/cursor.hh>
+#include <mongocxx/private/libbson.hh>
+#include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/private/tailer.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+namespace {
+
+constexpr std::chrono::milliseconds k_default_max_await_time{1000};
+constexpr std::chrono::milliseconds k_default_reopen_interval{100};
+
+}  // namespace
+
+tailer::impl::impl(class pool* pool,
+                   std::string database,
+                   std::string collection,
+                   document_fn on_document,
+                   bsoncxx::document::value filter,
+                   const options::tailer& options)
+    : pool(pool),
+      database(std::move(database)),
+      collection(std::move(collection)),
+      on_document(std::move(on_document)),
+      filter(std::move(filter)),
+      resume_field(options.resume_field()),
+      reopen_interval(options.reopen_interval().value_or(k_default_reopen_interval)) {
+    find_options.cursor_type(cursor::type::k_tailable_await);
+    find_options.max_await_time(options.max_await_time().value_or(k_default_max_await_time));
+    if (options.batch_size()) {
+        find_options.batch_size(*options.batch_size());
+    }
+}
+
+tailer::impl::~impl() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    changed.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void tailer::impl::run() {
+    std::exception_ptr failure;
+    try {
+        tail();
+    } catch (...) {
+        failure = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        error = failure;
+        finished = true;
+    }
+    changed.notify_all();
+}
+
+void tailer::impl::tail() {
+    auto client = pool->acquire();
+    auto coll = (*client)[database][collection];
+
+    while (!is_stopping()) {
+        auto tailable = coll.find(next_filter(), find_options);
+        auto cursor_t = tailable._impl->cursor_t;
+
+        const bson_t* out;
+        while (!is_stopping()) {
+            if (libmongoc::cursor_next(cursor_t, &out)) {
+                const bsoncxx::document::view doc{bson_get_data(out), out->len};
+                if (resume_field) {
+                    const auto value = doc[*resume_field];
+                    if (value) {
+                        resume_after = make_document(
+                            kvp(*resume_field, make_document(kvp("$gt", value.get_value()))));
+                    }
+                }
+                on_document(doc);
+                continue;
+            }
+
+            bson_error_t error;
+            const bson_t* error_document;
+            if (libmongoc::cursor_error_document(cursor_t, &error, &error_document)) {
+                if (error_document) {
+                    const bsoncxx::document::view error_view{bson_get_data(error_document),
+                                                             error_document->len};
+                    throw_exception<query_exception>(bsoncxx::document::value{error_view}, error);
+                }
+                throw_exception<query_exception>(error);
+            }
+
+            // The server closed the cursor; reopen it below.
+            if (!libmongoc::cursor_more(cursor_t)) {
+                break;
+            }
+
+            // An empty awaitData batch: the next cursor_next sends the next getMore right away.
+        }
+
+        if (!sleep_for(reopen_interval)) {
+            return;
+        }
+    }
+}
+
+bsoncxx::document::value tailer::impl::next_filter() const {
+    if (!resume_after) {
+        return filter;
+    }
+    return make_document(kvp("$and", make_array(filter.view(), resume_after->view())));
+}
+
+bool tailer::impl::sleep_for(std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lock{mutex};
+    return !changed.wait_for(lock, interval, [this] { return stopping; });
+}
+
+bool tailer::impl::is_stopping() {
+    std::lock_guard<std::mutex> lock{mutex};
+    return stopping;
+}
+
+tailer::tailer(class pool& pool,
+               bsoncxx::string::view_or_value database,
+               bsoncxx::string::view_or_value collection,
+               document_fn on_document,
+               bsoncxx::document::view_or_value filter,
+               const options::tailer& options) {
+    if (!on_document) {
+        throw logic_error{error_code::k_invalid_parameter, "on_document must not be empty"};
+    }
+
+    _impl = stdx::make_unique<impl>(&pool,
+                                    std::string{database.view()},
+                                    std::string{collection.view()},
+                                    std::move(on_document),
+                                    bsoncxx::document::value{filter.view()},
+                                    options);
+
+    auto impl = _impl.get();
+    _impl->thread = std::thread{[impl] { impl->run(); }};
+}
+
+tailer::tailer(tailer&&) noexcept = default;
+tailer& tailer::operator=(tailer&&) noexcept = default;
+
+tailer::~tailer() = default;
+
+void tailer::stop() {
+    std::unique_lock<std::mutex> lock{_impl->mutex};
+    _impl->stopping = true;
+    _impl->changed.notify_all();
+
+    if (std::this_thread::get_id() != _impl->thread.get_id()) {
+        _impl->changed.wait(lock, [this] { return _impl->finished; });
+    }
+}
+
+void tailer::wait() {
+    std::unique_lock<std::mutex> lock{_impl->mutex};
+    _impl->changed.wait(lock, [this] { return _impl->finished; });
+    if (_impl->error) {
+        std::rethrow_exception(_impl->error);
+    }
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,113 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/document/view_or_value.hpp>
+#include <bsoncxx/string/view_or_value.hpp>
+#include <mongocxx/options/tailer.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+class pool;
+
+///
+/// Tails a capped collection on a background thread, handing every new document to a callback
+/// as soon as it arrives.
+///
+/// Iterating a cursor::type::k_tailable_await cursor returns to the caller after every empty
+/// batch, and the next getMore is only sent once the caller iterates the cursor again. A tailer
+/// instead keeps an awaitData getMore outstanding at all times: as soon as one returns, empty or
+/// not, the next is sent, so a document inserted at any moment is delivered within a round trip.
+///
+/// When the server closes the cursor, for example because the collection was empty, a new one is
+/// opened after options::tailer::reopen_interval(). Any other error ends the tailing; it is
+/// rethrown by wait().
+///
+/// @warning
+///   The pool must outlive the tailer. While tailing, the tailer keeps one of its clients
+///   checked out.
+///
+class MONGOCXX_API tailer {
+   public:
+    ///
+    /// The callback documents are delivered to, on the tailer's thread. The view is only valid
+    /// until the callback returns. Exceptions thrown by the callback end the tailing.
+    ///
+    using document_fn = std::function<void(bsoncxx::document::view)>;
+
+    ///
+    /// Starts tailing a collection.
+    ///
+    /// @param pool
+    ///   The pool to check a client out of.
+    /// @param database
+    ///   The name of the database of the collection.
+    /// @param collection
+    ///   The name of the capped collection to tail.
+    /// @param on_document
+    ///   The callback to deliver documents to.
+    /// @param filter
+    ///   The documents to deliver.
+    /// @param options
+    ///   Optional arguments, see options::tailer.
+    ///
+    /// @throws mongocxx::logic_error if `on_document` is empty.
+    ///
+    tailer(pool& pool,
+           bsoncxx::string::view_or_value database,
+           bsoncxx::string::view_or_value collection,
+           document_fn on_document,
+           bsoncxx::document::view_or_value filter = {},
+           const options::tailer& options = {});
+
+    tailer(tailer&&) noexcept;
+    tailer& operator=(tailer&&) noexcept;
+
+    ///
+    /// Stops tailing and waits for the background thread to exit.
+    ///
+    ~tailer();
+
+    ///
+    /// Stops tailing. Unless called from the callback, waits for the background thread to exit,
+    /// which may take until the outstanding getMore returns, i.e. up to
+    /// options::tailer::max_await_time().
+    ///
+    void stop();
+
+    ///
+    /// Waits until tailing ends, because stop() was called or because of an error. Must not be
+    /// called from the callback.
+    ///
+    /// @throws the error that ended the tailing, if any.
+    ///
+    void wait();
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,229 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Upper bounds on the heap allocations of operations on hot paths, so that a change adding
+// allocations to one of them fails here rather than only showing in a benchmark. Both the global
+// operator new, which this executable replaces, and the allocator of the instance, which libbson
+// and libmongoc allocate from, are counted. libmongoc is mocked, so only the allocations of the
+// C++ driver and of the libbson calls it makes are measured.
+
+#include "helpers.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <bsoncxx/allocator.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/private/libbson.hh>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/uri.hpp>
+
+namespace {
+
+// Only the allocations of the thread running the measured operation are counted.
+thread_local bool counting = false;
+std::size_t allocations = 0;
+
+void* counted_allocation(std::size_t size) {
+    if (counting) {
+        allocations++;
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (auto ptr = counted_allocation(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocation(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+
+class counting_allocator : public bsoncxx::allocator {
+   public:
+    void* allocate(std::size_t size) final {
+        return counted_allocation(size);
+    }
+
+    void deallocate(void* ptr, std::size_t) noexcept final {
+        std::free(ptr);
+    }
+};
+
+// The instance must be created before anything else allocates through libbson.
+void use_counting_instance() {
+    static instance driver{nullptr, bsoncxx::stdx::make_unique<counting_allocator>()};
+}
+
+template <typename Operation>
+std::size_t allocations_of(Operation&& operation) {
+    const auto before = allocations;
+    counting = true;
+    operation();
+    counting = false;
+    return allocations - before;
+}
+
+bsoncxx::document::value ten_fields() {
+    bsoncxx::builder::basic::document builder;
+    builder.append(kvp("f0", 0), kvp("f1", 1), kvp("f2", 2), kvp("f3", 3), kvp("f4", 4));
+    builder.append(kvp("f5", 5), kvp("f6", 6), kvp("f7", 7), kvp("f8", 8), kvp("f9", 9));
+    return builder.extract();
+}
+
+TEST_CASE("building and reading documents stays within its allocations", "[allocations]") {
+    use_counting_instance();
+
+    SECTION("a ten-field document takes the builder's state and the extracted buffer") {
+        REQUIRE(allocations_of([] { ten_fields(); }) <= 2);
+    }
+
+    SECTION("finding a field does not allocate") {
+        auto doc = ten_fields();
+        auto view = doc.view();
+
+        std::int32_t sum = 0;
+        auto found = allocations_of([&] {
+            sum += view.find("f9")->get_int32().value;
+            sum += view["f0"].get_int32().value;
+            if (view.find("missing") != view.end()) {
+                sum = -1;
+            }
+        });
+
+        REQUIRE(found == 0);
+        REQUIRE(sum == 9);
+    }
+}
+
+TEST_CASE("iterating a cursor does not allocate per document", "[allocations]") {
+    use_counting_instance();
+
+    MOCK_CLIENT
+    MOCK_DATABASE
+    MOCK_COLLECTION
+    MOCK_CURSOR
+
+    cursor_destroy->interpose([](mongoc_cursor_t*) {}).forever();
+    collection_destroy->interpose([](mongoc_collection_t*) {}).forever();
+
+    auto document = ten_fields();
+    bson_t document_bson;
+    bson_init_static(&document_bson, document.view().data(), document.view().length());
+
+    collection_find_with_opts
+        ->interpose([](mongoc_collection_t*,
+                       const bson_t*,
+                       const bson_t*,
+                       const mongoc_read_prefs_t*) -> mongoc_cursor_t* { return nullptr; })
+        .forever();
+
+    int documents_left = 0;
+    auto cursor_next = libmongoc::cursor_next.create_instance();
+    cursor_next
+        ->interpose([&](mongoc_cursor_t*, const bson_t** out) {
+            if (documents_left == 0) {
+                return false;
+            }
+            documents_left--;
+            *out = &document_bson;
+            return true;
+        })
+        .forever();
+    auto cursor_error_document = libmongoc::cursor_error_document.create_instance();
+    cursor_error_document
+        ->interpose([](mongoc_cursor_t*, bson_error_t*, const bson_t**) { return false; })
+        .forever();
+
+    client mongo_client{uri{}};
+    collection coll = mongo_client["allocations"]["coll"];
+
+    std::int64_t seen = 0;
+    auto iterate = [&](int documents) {
+        documents_left = documents;
+        for (auto&& doc : coll.find({})) {
+            seen += doc["f9"].get_int32().value;
+        }
+    };
+
+    // The first find may fill caches of the client.
+    iterate(1);
+
+    const auto few = allocations_of([&] { iterate(10); });
+    const auto many = allocations_of([&] { iterate(100); });
+
+    REQUIRE(many == few);
+    REQUIRE(seen == 9 * 111);
+}
+
+TEST_CASE("acquiring and releasing a pooled client does not allocate", "[allocations]") {
+    use_counting_instance();
+
+    MOCK_POOL
+
+    int fake_client_storage = 0;
+    auto fake_client = reinterpret_cast<::mongoc_client_t*>(&fake_client_storage);
+
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) { return fake_client; })
+        .forever();
+    client_pool_pop->interpose([&](::mongoc_client_pool_t*) { return fake_client; }).forever();
+    client_pool_push->interpose([](::mongoc_client_pool_t*, ::mongoc_client_t*) {}).forever();
+
+    pool p{uri{}};
+
+    // The first checkout creates the client wrapper that the later ones reuse.
+    {
+        auto entry = p.acquire();
+    }
+
+    auto cycles = allocations_of([&] {
+        for (int i = 0; i < 100; i++) {
+            auto entry = p.acquire();
+        }
+    });
+
+    REQUIRE(cycles == 0);
+}
+
+}  // namespace
@@ -0,0 +1,95 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/async_collection.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/exception/operation_exception.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("async_collection runs operations on its workers", "[async_collection]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        (*client)["async_collection"]["basic"].drop();
+    }
+
+    async_collection coll{p, "async_collection", "basic", 4};
+
+    std::vector<std::future<stdx::optional<result::insert_one>>> inserts;
+    for (std::int32_t i = 0; i < 100; i++) {
+        inserts.push_back(coll.insert_one(make_document(kvp("x", i))));
+    }
+    for (auto&& insert : inserts) {
+        REQUIRE(insert.get());
+    }
+
+    REQUIRE(coll.count_documents({}).get() == 100);
+
+    auto found = coll.find_one(make_document(kvp("x", 42))).get();
+    REQUIRE(found);
+    REQUIRE(found->view()["x"].get_int32() == 42);
+
+    auto updated =
+        coll.update_many(make_document(kvp("x", make_document(kvp("$lt", 10)))),
+                         make_document(kvp("$set", make_document(kvp("small", true)))))
+            .get();
+    REQUIRE(updated);
+    REQUIRE(updated->modified_count() == 10);
+    REQUIRE(coll.find(make_document(kvp("small", true))).get().size() == 10);
+
+    auto deleted = coll.delete_many(make_document(kvp("small", true))).get();
+    REQUIRE(deleted);
+    REQUIRE(deleted->deleted_count() == 10);
+
+    SECTION("submit runs arbitrary functions") {
+        auto name = coll.submit([](collection& c) { return std::string{c.name()}; });
+        REQUIRE(name.get() == "basic");
+
+        auto nothing = coll.submit([](collection&) {});
+        nothing.get();
+    }
+
+    SECTION("submit can report completion to a callback") {
+        std::promise<std::int64_t> counted;
+        coll.submit([](collection& c) { return c.count_documents({}); },
+                    [&](std::future<std::int64_t> outcome) { counted.set_value(outcome.get()); });
+        REQUIRE(counted.get_future().get() == 90);
+    }
+
+    SECTION("errors are reported through the future") {
+        auto failing = coll.update_one(make_document(), make_document(kvp("$bogus", 1)));
+        REQUIRE_THROWS_AS(failing.get(), operation_exception);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,145 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/batch.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/operation_exception.hpp>
+#include <mongocxx/index_model.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("batch runs independent operations over pooled connections", "[batch]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        (*client)["batch"]["points"].drop();
+    }
+
+    batch inserts{p, 4};
+    for (std::int32_t i = 0; i < 20; i++) {
+        inserts.insert_one("batch", "points", make_document(kvp("_id", i), kvp("x", i * 10)));
+    }
+    REQUIRE(inserts.size() == 20);
+    inserts.execute();
+    for (std::size_t i = 0; i < inserts.size(); i++) {
+        REQUIRE(inserts.insert_one_result(i));
+    }
+
+    batch reads{p, 4};
+    std::vector<std::size_t> indexes;
+    for (std::int32_t i = 0; i < 20; i++) {
+        indexes.push_back(reads.find_one("batch", "points", make_document(kvp("_id", i))));
+    }
+    auto missing = reads.find_one("batch", "points", make_document(kvp("_id", 100)));
+
+    SECTION("results are kept by index") {
+        reads.execute();
+        for (std::int32_t i = 0; i < 20; i++) {
+            const auto& found = reads.find_one_result(indexes[static_cast<std::size_t>(i)]);
+            REQUIRE(found);
+            REQUIRE(found->view()["x"].get_int32() == i * 10);
+        }
+        REQUIRE(!reads.find_one_result(missing));
+    }
+
+    SECTION("results cannot be read before execution or with the wrong kind") {
+        REQUIRE_THROWS_AS(reads.find_one_result(missing), logic_error);
+        reads.execute();
+        REQUIRE_THROWS_AS(reads.insert_one_result(missing), logic_error);
+        REQUIRE_THROWS_AS(reads.find_one_result(reads.size()), logic_error);
+    }
+
+    SECTION("a failed operation does not affect the others") {
+        batch duplicates{p};
+        auto duplicate = duplicates.insert_one("batch", "points", make_document(kvp("_id", 0)));
+        auto fresh = duplicates.insert_one("batch", "points", make_document(kvp("_id", 20)));
+        duplicates.execute();
+
+        REQUIRE_THROWS_AS(duplicates.insert_one_result(duplicate), operation_exception);
+        REQUIRE(duplicates.insert_one_result(fresh));
+    }
+}
+
+TEST_CASE("batch builds indexes on many collections", "[batch]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        auto db = (*client)["batch_indexes"];
+        db.drop();
+        for (std::int32_t i = 0; i < 4; i++) {
+            db["coll" + std::to_string(i)].insert_one(make_document(kvp("a", i), kvp("b", i)));
+        }
+    }
+
+    std::mutex progress_mutex;
+    std::size_t polls = 0;
+
+    batch builds{p, 2};
+    builds.on_index_progress(
+        [&](const std::vector<batch::index_progress>&) {
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            polls++;
+        },
+        std::chrono::milliseconds{1});
+
+    std::vector<std::size_t> indexes;
+    for (std::int32_t i = 0; i < 4; i++) {
+        std::vector<index_model> models;
+        models.emplace_back(make_document(kvp("a", 1)));
+        models.emplace_back(make_document(kvp("b", -1)));
+        indexes.push_back(
+            builds.create_indexes("batch_indexes", "coll" + std::to_string(i), std::move(models)));
+    }
+    builds.execute();
+
+    auto client = p.acquire();
+    for (std::int32_t i = 0; i < 4; i++) {
+        auto reply = builds.create_indexes_result(indexes[static_cast<std::size_t>(i)]);
+        REQUIRE(reply.view()["ok"]);
+
+        auto listed = (*client)["batch_indexes"]["coll" + std::to_string(i)].list_indexes();
+        REQUIRE(std::distance(listed.begin(), listed.end()) == 3);
+    }
+
+    REQUIRE_THROWS_AS(builds.create_indexes_result(builds.size()), logic_error);
+    REQUIRE_THROWS_AS(builds.on_index_progress({}, std::chrono::milliseconds{0}), logic_error);
+
+    (*client)["batch_indexes"].drop();
+}
+
+}  // namespace
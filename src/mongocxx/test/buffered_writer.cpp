@@ -0,0 +1,144 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/buffered_writer.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/write_exception.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("buffered_writer coalesces single writes", "[buffered_writer]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        (*client)["buffered_writer"]["events"].drop();
+    }
+
+    SECTION("writes from many threads are all inserted") {
+        std::vector<std::future<stdx::optional<result::insert_one>>> inserted;
+        {
+            buffered_writer writer{p, "buffered_writer", "events", 64};
+
+            std::vector<std::vector<std::future<stdx::optional<result::insert_one>>>> per_thread(4);
+            std::vector<std::thread> threads;
+            for (std::int32_t t = 0; t < 4; t++) {
+                threads.emplace_back([&writer, &per_thread, t] {
+                    for (std::int32_t i = 0; i < 250; i++) {
+                        per_thread[static_cast<std::size_t>(t)].push_back(
+                            writer.insert_one(make_document(kvp("t", t), kvp("i", i))));
+                    }
+                });
+            }
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+            writer.flush();
+
+            for (auto&& futures : per_thread) {
+                for (auto&& future : futures) {
+                    inserted.push_back(std::move(future));
+                }
+            }
+        }
+
+        for (auto&& future : inserted) {
+            auto result = future.get();
+            REQUIRE(result);
+            REQUIRE(result->result().inserted_count() == 1);
+            REQUIRE(result->inserted_id().type() == bsoncxx::type::k_oid);
+        }
+
+        auto client = p.acquire();
+        REQUIRE((*client)["buffered_writer"]["events"].count_documents({}) == 1000);
+    }
+
+    SECTION("a failed write does not fail the writes around it") {
+        buffered_writer writer{p, "buffered_writer", "events", 10, std::chrono::seconds{1}};
+
+        auto first = writer.insert_one(make_document(kvp("_id", 1)));
+        auto duplicate = writer.insert_one(make_document(kvp("_id", 1)));
+        auto second = writer.insert_one(make_document(kvp("_id", 2)));
+        auto update = writer.update_one(
+            model::update_one{make_document(kvp("_id", 2)),
+                              make_document(kvp("$set", make_document(kvp("x", 1))))});
+        auto invalid = writer.update_one(
+            model::update_one{make_document(kvp("_id", 2)), make_document(kvp("x", 1))});
+        writer.flush();
+
+        REQUIRE(first.get()->inserted_id().get_int32() == 1);
+        REQUIRE_THROWS_AS(duplicate.get(), write_exception);
+        REQUIRE(second.get());
+        REQUIRE_NOTHROW(update.get());
+        REQUIRE_THROWS_AS(invalid.get(), logic_error);
+
+        auto client = p.acquire();
+        auto found = (*client)["buffered_writer"]["events"].find_one(make_document(kvp("_id", 2)));
+        REQUIRE(found);
+        REQUIRE(found->view()["x"].get_int32() == 1);
+    }
+
+    SECTION("posted inserts are sent without futures") {
+        {
+            buffered_writer writer{p, "buffered_writer", "events", 16};
+            for (std::int32_t i = 0; i < 100; i++) {
+                writer.post_insert_one(make_document(kvp("metric", i)));
+            }
+            auto kept = writer.insert_one(make_document(kvp("_id", "kept")));
+            writer.flush();
+            REQUIRE(kept.get());
+        }
+
+        // The posted inserts are unacknowledged, so give the server time to apply them.
+        auto client = p.acquire();
+        auto posted = make_document(kvp("metric", make_document(kvp("$exists", true))));
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        auto count = (*client)["buffered_writer"]["events"].count_documents(posted.view());
+        while (count < 100 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            count = (*client)["buffered_writer"]["events"].count_documents(posted.view());
+        }
+        REQUIRE(count == 100);
+    }
+
+    SECTION("the batch size and delay are validated") {
+        REQUIRE_THROWS_AS((buffered_writer{p, "buffered_writer", "events", 0}), logic_error);
+        REQUIRE_THROWS_AS(
+            (buffered_writer{p, "buffered_writer", "events", 1, std::chrono::milliseconds{-1}}),
+            logic_error);
+    }
+
+    auto client = p.acquire();
+    (*client)["buffered_writer"]["events"].drop();
+}
+
+}  // namespace
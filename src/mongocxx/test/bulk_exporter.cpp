@@ -0,0 +1,106 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/bson_file.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/json.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/bulk_exporter.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("bulk_exporter writes every document once", "[bulk_exporter]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        auto coll = (*client)["bulk_exporter"]["source"];
+        coll.drop();
+        std::vector<bsoncxx::document::value> docs;
+        for (std::int32_t i = 0; i < 1000; i++) {
+            docs.push_back(make_document(kvp("_id", i), kvp("x", i % 10)));
+        }
+        coll.insert_many(docs);
+    }
+
+    bulk_exporter exporter{p, "bulk_exporter", "source"};
+    exporter.partitions(4);
+
+    SECTION("as BSON") {
+        auto files = exporter.export_to("bulk_exporter_out");
+        REQUIRE(!files.empty());
+
+        std::vector<bool> seen(1000, false);
+        std::uint64_t total = 0;
+        for (auto&& file : files) {
+            REQUIRE(file.path.find(".bson") != std::string::npos);
+            bsoncxx::bson_file_reader reader{file.path};
+            REQUIRE(reader.size() == file.bytes);
+            for (auto&& doc : reader) {
+                auto id = static_cast<std::size_t>(doc["_id"].get_int32().value);
+                REQUIRE(!seen[id]);
+                seen[id] = true;
+                total++;
+            }
+            std::remove(file.path.c_str());
+        }
+        REQUIRE(total == 1000);
+    }
+
+    SECTION("as line-delimited JSON, filtered") {
+        exporter.format(bulk_exporter::file_format::k_ldjson)
+            .filter(make_document(kvp("x", 3)));
+        auto files = exporter.export_to("bulk_exporter_out");
+
+        std::uint64_t lines = 0;
+        for (auto&& file : files) {
+            std::ifstream in{file.path};
+            std::string line;
+            std::uint64_t file_lines = 0;
+            while (std::getline(in, line)) {
+                REQUIRE(bsoncxx::from_json(line).view()["x"].get_int32() == 3);
+                file_lines++;
+            }
+            REQUIRE(file_lines == file.documents);
+            lines += file_lines;
+            in.close();
+            std::remove(file.path.c_str());
+        }
+        REQUIRE(lines == 100);
+    }
+
+    REQUIRE_THROWS_AS(exporter.partitions(0), logic_error);
+
+    auto client = p.acquire();
+    (*client)["bulk_exporter"].drop();
+}
+
+}  // namespace
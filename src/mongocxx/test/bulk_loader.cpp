@@ -0,0 +1,107 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include <bsoncxx/bson_file.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/bulk_loader.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/operation_exception.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+void write_dump(const std::string& path, std::int32_t first, std::int32_t count) {
+    bsoncxx::bson_file_writer writer{path};
+    for (std::int32_t i = first; i < first + count; i++) {
+        writer.write(make_document(kvp("_id", i), kvp("padding", std::string(100, 'x'))).view());
+    }
+    writer.close();
+}
+
+TEST_CASE("bulk_loader inserts every document of its files", "[bulk_loader]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        (*client)["bulk_loader"]["restored"].drop();
+    }
+
+    write_dump("bulk_loader_a.bson", 0, 1000);
+    write_dump("bulk_loader_b.bson", 1000, 500);
+
+    std::mutex progress_mutex;
+    std::uint64_t reported = 0;
+    bool monotonic = true;
+
+    bulk_loader loader{p, "bulk_loader", "restored"};
+    loader.threads(4).batch_bytes(4096).max_pending_batches(2).on_progress(
+        [&](const bulk_loader::progress& progress) {
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            monotonic = monotonic && progress.documents >= reported;
+            reported = progress.documents;
+        },
+        std::chrono::milliseconds{0});
+
+    SECTION("all files are loaded") {
+        auto done = loader.load_files({"bulk_loader_a.bson", "bulk_loader_b.bson"});
+        REQUIRE(done.documents == 1500);
+        REQUIRE(reported == 1500);
+        REQUIRE(monotonic);
+        REQUIRE(done.documents_per_second() >= 0);
+
+        auto client = p.acquire();
+        REQUIRE((*client)["bulk_loader"]["restored"].count_documents({}) == 1500);
+    }
+
+    SECTION("insert failures are rethrown") {
+        loader.load_file("bulk_loader_a.bson");
+        REQUIRE_THROWS_AS(loader.load_file("bulk_loader_a.bson"), operation_exception);
+    }
+
+    SECTION("unreadable files are reported") {
+        REQUIRE_THROWS_AS(loader.load_files({"bulk_loader_b.bson", "no/such/file.bson"}),
+                          bsoncxx::exception);
+
+        // The files read before the bad one are still loaded.
+        auto client = p.acquire();
+        REQUIRE((*client)["bulk_loader"]["restored"].count_documents({}) == 500);
+    }
+
+    REQUIRE_THROWS_AS(loader.threads(0), logic_error);
+    REQUIRE_THROWS_AS(loader.batch_bytes(0), logic_error);
+    REQUIRE_THROWS_AS(loader.max_pending_batches(0), logic_error);
+
+    std::remove("bulk_loader_a.bson");
+    std::remove("bulk_loader_b.bson");
+    auto client = p.acquire();
+    (*client)["bulk_loader"].drop();
+}
+
+}  // namespace
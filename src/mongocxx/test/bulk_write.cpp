@@ -14,11 +14,14 @@
 
 #include "helpers.hpp"
 
+#include <vector>
+
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/test_util/catch.hh>
 #include <bsoncxx/types.hpp>
 #include <mongocxx/bulk_write.hpp>
 #include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/private/libmongoc.hh>
 #include <mongocxx/write_concern.hpp>
@@ -109,6 +112,12 @@ class update_functor {
         REQUIRE(bson_get_data(filter) == _filter.data());
         REQUIRE(bson_get_data(update) == _update.data());
 
+        if (!_expected_collation && !_expected_upsert) {
+            // Writes without options are passed NULL opts rather than an empty document.
+            REQUIRE(options == nullptr);
+            return;
+        }
+
         bsoncxx::document::view options_view{bson_get_data(options), options->len};
 
         bsoncxx::document::element collation = options_view["collation"];
@@ -158,6 +167,12 @@ class delete_functor {
         *_called = true;
         REQUIRE(bson_get_data(filter) == _filter.data());
 
+        if (!_expected_collation) {
+            // Writes without options are passed NULL opts rather than an empty document.
+            REQUIRE(options == nullptr);
+            return;
+        }
+
         bsoncxx::document::view options_view{bson_get_data(options), options->len};
 
         bsoncxx::document::element collation = options_view["collation"];
@@ -244,6 +259,25 @@ TEST_CASE("passing write operations to append calls corresponding C function", "
         REQUIRE(called);
     }
 
+    SECTION("options of an earlier write are not passed to a later write") {
+        auto bulk_update = libmongoc::bulk_operation_update_one_with_opts.create_instance();
+
+        model::update_one uo(filter, update_doc);
+        uo.collation(collation);
+        uo.upsert(true);
+        update_func.collation(collation);
+        update_func.upsert(true);
+        bulk_update->visit(update_func);
+        bw.append(uo);
+        REQUIRE(called);
+
+        called = false;
+        update_functor plain_func(&called, filter, update_doc);
+        bulk_update->visit(plain_func);
+        bw.append(model::update_one(filter, update_doc));
+        REQUIRE(called);
+    }
+
     SECTION("update_many invokes mongoc_bulk_operation_update_many_with_opts") {
         auto bulk_update = libmongoc::bulk_operation_update_many_with_opts.create_instance();
         bulk_update->visit(update_func);
@@ -353,5 +387,59 @@ TEST_CASE("passing write operations to append calls corresponding C function", "
         bw.append(ro);
         REQUIRE(called);
     }
+
+    SECTION("append consumes the documents of a moved write") {
+        bsoncxx::document::value owned{doc};
+        insert_functor owned_insert_func(&called, owned.view());
+        auto bulk_insert = libmongoc::bulk_operation_insert_with_opts.create_instance();
+        bulk_insert->visit(owned_insert_func);
+
+        model::write insert{model::insert_one{std::move(owned)}};
+        bw.append(std::move(insert));
+        REQUIRE(called);
+        REQUIRE(insert.get_insert_one().document().view().empty());
+    }
+
+    SECTION("append_insert passes the document to mongoc_bulk_operation_insert_with_opts") {
+        bsoncxx::document::value owned{doc};
+        insert_functor owned_insert_func(&called, owned.view());
+        auto bulk_insert = libmongoc::bulk_operation_insert_with_opts.create_instance();
+        bulk_insert->visit(owned_insert_func);
+
+        bw.append_insert(std::move(owned));
+        REQUIRE(called);
+    }
+
+    SECTION("append_insert_raw passes the buffer to mongoc_bulk_operation_insert_with_opts") {
+        auto bulk_insert = libmongoc::bulk_operation_insert_with_opts.create_instance();
+        bulk_insert->visit(insert_func);
+
+        bw.append_insert_raw(doc.data(), doc.length());
+        REQUIRE(called);
+    }
+
+    SECTION("append_insert_raw rejects a buffer that is not a BSON document") {
+        auto bulk_insert = libmongoc::bulk_operation_insert_with_opts.create_instance();
+        bulk_insert->visit(insert_func);
+
+        REQUIRE_THROWS_AS(bw.append_insert_raw(doc.data(), doc.length() - 1), logic_error);
+        REQUIRE(!called);
+    }
+
+    SECTION("append_many invokes mongoc_bulk_operation_insert_with_opts for each document") {
+        std::vector<bsoncxx::document::view> docs{doc, filter, update_doc};
+        std::size_t index = 0;
+
+        auto bulk_insert = libmongoc::bulk_operation_insert_with_opts.create_instance();
+        bulk_insert->visit(
+            [&](mongoc_bulk_operation_t*, const bson_t* document, const bson_t*, bson_error_t*) {
+                REQUIRE(index < docs.size());
+                REQUIRE(bson_get_data(document) == docs[index].data());
+                index++;
+            });
+
+        bw.append_many(docs.begin(), docs.end());
+        REQUIRE(index == docs.size());
+    }
 }
 }  // namespace
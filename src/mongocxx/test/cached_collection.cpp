@@ -0,0 +1,163 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/cached_collection.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/test_util/client_helpers.hh>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+bsoncxx::types::value id(std::int32_t n) {
+    return bsoncxx::types::value{bsoncxx::types::b_int32{n}};
+}
+
+TEST_CASE("cached_collection caches lookups by _id", "[cached_collection]") {
+    instance::current();
+
+    pool p{};
+    auto client = p.acquire();
+    auto coll = (*client)["cached_collection"]["profiles"];
+    coll.drop();
+    for (std::int32_t i = 0; i < 10; i++) {
+        coll.insert_one(make_document(kvp("_id", i), kvp("x", i)));
+    }
+
+    auto unwatched = options::collection_cache{}.watch(false);
+
+    SECTION("hits are answered from the cache") {
+        cached_collection cache{p, "cached_collection", "profiles", unwatched};
+
+        REQUIRE(cache.find_one_by_id(id(1))->view()["x"].get_int32() == 1);
+        REQUIRE(cache.misses() == 1);
+
+        coll.update_one(make_document(kvp("_id", 1)),
+                        make_document(kvp("$set", make_document(kvp("x", 100)))));
+        REQUIRE(cache.find_one_by_id(id(1))->view()["x"].get_int32() == 1);
+        REQUIRE(cache.hits() == 1);
+
+        cache.invalidate(id(1));
+        REQUIRE(cache.find_one_by_id(id(1))->view()["x"].get_int32() == 100);
+        REQUIRE(cache.misses() == 2);
+    }
+
+    SECTION("missing documents are cached too") {
+        cached_collection cache{p, "cached_collection", "profiles", unwatched};
+
+        REQUIRE(!cache.find_one_by_id(id(20)));
+        REQUIRE(!cache.find_one_by_id(id(20)));
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(cache.size() == 1);
+
+        cache.clear();
+        REQUIRE(cache.size() == 0);
+    }
+
+    SECTION("numeric _ids that compare equal share an entry") {
+        cached_collection cache{p, "cached_collection", "profiles", unwatched};
+
+        REQUIRE(cache.find_one_by_id(bsoncxx::types::value{bsoncxx::types::b_double{1.0}}));
+        REQUIRE(cache.find_one_by_id(bsoncxx::types::value{bsoncxx::types::b_int64{1}}));
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(cache.size() == 1);
+
+        // Invalidating by the _id a change event reports drops the entry.
+        cache.invalidate(id(1));
+        REQUIRE(cache.size() == 0);
+
+        REQUIRE(!cache.find_one_by_id(bsoncxx::types::value{bsoncxx::types::b_double{20.0}}));
+        cache.invalidate(id(20));
+        REQUIRE(cache.size() == 0);
+    }
+
+    SECTION("the least recently used entries are evicted") {
+        cached_collection cache{
+            p, "cached_collection", "profiles", unwatched.max_documents(3).shards(1)};
+
+        for (std::int32_t i = 0; i < 3; i++) {
+            cache.find_one_by_id(id(i));
+        }
+        cache.find_one_by_id(id(0));
+        cache.find_one_by_id(id(3));
+        REQUIRE(cache.size() == 3);
+
+        // 1 was evicted, while 0 was used recently enough to stay.
+        cache.find_one_by_id(id(0));
+        REQUIRE(cache.hits() == 2);
+        cache.find_one_by_id(id(1));
+        REQUIRE(cache.misses() == 5);
+    }
+
+    SECTION("entries expire") {
+        auto now = std::chrono::steady_clock::time_point{};
+        cached_collection cache{p,
+                                "cached_collection",
+                                "profiles",
+                                unwatched.ttl(std::chrono::milliseconds{50}).clock([&now] {
+                                    return now;
+                                })};
+
+        cache.find_one_by_id(id(1));
+        now += std::chrono::milliseconds{49};
+        cache.find_one_by_id(id(1));
+        REQUIRE(cache.hits() == 1);
+
+        now += std::chrono::milliseconds{1};
+        cache.find_one_by_id(id(1));
+        REQUIRE(cache.misses() == 2);
+    }
+
+    SECTION("changes invalidate entries") {
+        if (!test_util::is_replica_set(*client)) {
+            WARN("skip: change streams require replica set");
+            return;
+        }
+
+        cached_collection cache{p, "cached_collection", "profiles"};
+        REQUIRE(cache.find_one_by_id(id(2))->view()["x"].get_int32() == 2);
+
+        coll.update_one(make_document(kvp("_id", 2)),
+                        make_document(kvp("$set", make_document(kvp("x", 200)))));
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (cache.find_one_by_id(id(2))->view()["x"].get_int32() != 200) {
+            REQUIRE(std::chrono::steady_clock::now() < deadline);
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+
+    SECTION("invalid options are rejected") {
+        REQUIRE_THROWS_AS(options::collection_cache{}.max_documents(0), logic_error);
+        REQUIRE_THROWS_AS(options::collection_cache{}.shards(0), logic_error);
+        REQUIRE_THROWS_AS(options::collection_cache{}.ttl(std::chrono::milliseconds{0}),
+                          logic_error);
+    }
+}
+
+}  // namespace
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
 #include <iostream>
 
 #include <bsoncxx/builder/basic/document.hpp>
@@ -20,9 +21,11 @@
 #include <bsoncxx/test_util/catch.hh>
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
+#include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/options/insert.hpp>
 #include <mongocxx/pipeline.hpp>
+#include <mongocxx/pool.hpp>
 #include <mongocxx/private/libbson.hh>
 #include <mongocxx/test_util/client_helpers.hh>
 #include <mongocxx/write_concern.hpp>
@@ -213,6 +216,49 @@ TEST_CASE("Mock streams and error-handling") {
         REQUIRE(it4 == it1);
     }
 
+    SECTION("Batches of events") {
+        auto change_stream_get_resume_token =
+            libmongoc::change_stream_get_resume_token.create_instance();
+
+        libbson::scoped_bson_t token{make_document(kvp("token", 1))};
+        change_stream_get_resume_token
+            ->interpose([&](mongoc_change_stream_t*) -> const bson_t* { return token.bson(); })
+            .forever();
+
+        libbson::scoped_bson_t event0{doc("n", 0)};
+        libbson::scoped_bson_t event1{doc("n", 1)};
+        libbson::scoped_bson_t event2{doc("n", 2)};
+        const bson_t* events_bson[] = {event0.bson(), event1.bson(), event2.bson()};
+        std::size_t next_event = 0;
+        change_stream_next
+            ->interpose([&](mongoc_change_stream_t*, const bson_t** bson) -> bool {
+                if (next_event == 3) {
+                    return false;
+                }
+                *bson = events_bson[next_event++];
+                return true;
+            })
+            .forever();
+        change_stream_error_document->interpose(gen_error(false)).forever();
+
+        auto first = stream.next_batch(2, std::chrono::seconds{10});
+        REQUIRE(first.size() == 2);
+        REQUIRE(first[0] == doc("n", 0).view());
+        REQUIRE(first[1] == doc("n", 1).view());
+        REQUIRE(first.resume_token());
+        REQUIRE(first.resume_token()->view() == make_document(kvp("token", 1)).view());
+
+        // The remaining event is returned once the stream has nothing more to offer.
+        auto second = stream.next_batch(10, std::chrono::seconds{10});
+        REQUIRE(std::distance(second.begin(), second.end()) == 1);
+        REQUIRE(*second.begin() == doc("n", 2).view());
+
+        // The events are copies, so they outlive further iteration.
+        REQUIRE(stream.next_batch(10, std::chrono::seconds{10}).empty());
+        REQUIRE(first[1] == doc("n", 1).view());
+        REQUIRE(stream.begin() == stream.end());
+    }
+
     SECTION("One event") {
         change_stream_next->interpose(gen_next(true));
         auto it = stream.begin();
@@ -485,6 +531,64 @@ TEST_CASE("Documentation Examples", "[min36]") {
     }
 }
 
+TEST_CASE("Prefetching change streams", "[min36]") {
+    instance::current();
+    pool p{uri{}};
+    auto watcher = p.acquire();
+    if (!test_util::is_replica_set(*watcher)) {
+        WARN("skip: change streams require replica set");
+        return;
+    }
+
+    auto writer = p.acquire();
+    collection events = (*writer)["streams"]["prefetched"];
+    events.drop();
+    events.insert_one(doc("dummy", "doc"));
+
+    options::change_stream opts;
+    opts.batch_size(3).max_await_time(std::chrono::milliseconds{100});
+
+    SECTION("prefetch_batches must be positive") {
+        opts.prefetch_batches(0);
+        REQUIRE_THROWS_AS((*watcher)["streams"]["prefetched"].watch(opts), logic_error);
+    }
+
+    SECTION("events arrive in order and resume tokens follow the consumer") {
+        opts.prefetch_batches(2);
+        change_stream stream = (*watcher)["streams"]["prefetched"].watch(opts);
+        for (std::int32_t i = 0; i < 10; i++) {
+            events.insert_one(doc("n", i));
+        }
+
+        std::int32_t next = 0;
+        stdx::optional<bsoncxx::document::value> token;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+        while (next < 10 && std::chrono::steady_clock::now() < deadline) {
+            for (auto&& event : stream) {
+                REQUIRE(event["fullDocument"]["n"].get_int32() == next++);
+                if (next == 4) {
+                    token = bsoncxx::document::value{stream.get_resume_token().value()};
+                }
+                if (next == 10) {
+                    break;
+                }
+            }
+        }
+        REQUIRE(next == 10);
+
+        // The background thread has read further, but the token is the one after the fourth event.
+        REQUIRE(token);
+        options::change_stream resume;
+        resume.resume_after(token->view());
+        change_stream resumed = events.watch(resume);
+        auto it = resumed.begin();
+        REQUIRE(it != resumed.end());
+        REQUIRE((*it)["fullDocument"]["n"].get_int32() == 4);
+    }
+
+    events.drop();
+}
+
 TEST_CASE("Watch 2 collections", "[min36]") {
     instance::current();
     client mongodb_client{uri{}};
@@ -14,13 +14,23 @@
 
 #include "helpers.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <mongocxx/config/private/prelude.hh>
 
 #include <bsoncxx/string/to_string.hpp>
 #include <bsoncxx/test_util/catch.hh>
 #include <mongocxx/client.hpp>
 #include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/index_advisor.hpp>
 #include <mongocxx/instance.hpp>
+#include <mongocxx/options/client.hpp>
+#include <mongocxx/options/find.hpp>
 #include <mongocxx/pool.hpp>
 #include <mongocxx/private/conversions.hh>
 #include <mongocxx/private/libmongoc.hh>
@@ -73,6 +83,51 @@ TEST_CASE("A client lists its databases with a filter applied", "[client]") {
     REQUIRE(client_list_databases_called);
 }
 
+TEST_CASE("A client streams its database names with nameOnly", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    MOCK_CLIENT
+    instance::current();
+
+    auto client_list_databases_called = false;
+    auto expected = make_document(kvp("filter", make_document(kvp("name", "admin"))),
+                                  kvp("nameOnly", true),
+                                  kvp("authorizedDatabases", true));
+
+    auto client_list_databases = libmongoc::client_find_databases_with_opts.create_instance();
+    client_list_databases
+        ->interpose([&](mongoc_client_t*, const bson_t* opts) {
+            REQUIRE(opts);
+            bsoncxx::document::view opts_view{bson_get_data(opts), opts->len};
+            REQUIRE(expected.view() == opts_view);
+            client_list_databases_called = true;
+            return nullptr;
+        })
+        .forever();
+
+    client mongo_client{uri{}};
+    mongo_client.list_database_names_cursor(make_document(kvp("name", "admin")), true);
+    REQUIRE(client_list_databases_called);
+}
+
+TEST_CASE("A client caches database and collection handles", "[client]") {
+    instance::current();
+
+    client mongo_client{uri{}};
+
+    auto& db = mongo_client.database_handle("handles");
+    REQUIRE(&db == &mongo_client.database_handle("handles"));
+    REQUIRE(&db != &mongo_client.database_handle("handles_other"));
+    REQUIRE(db.name() == stdx::string_view{"handles"});
+
+    auto& coll = mongo_client.collection_handle("handles", "coll");
+    REQUIRE(&coll == &mongo_client.collection_handle("handles", "coll"));
+    REQUIRE(&coll != &mongo_client.collection_handle("handles", "coll2"));
+    REQUIRE(&coll != &mongo_client.collection_handle("handles_other", "coll"));
+    REQUIRE(coll.name() == stdx::string_view{"coll"});
+}
+
 TEST_CASE("A client constructed with a URI is truthy", "[client]") {
     MOCK_CLIENT
 
@@ -126,6 +181,67 @@ TEST_CASE("A client cleans up its underlying mongoc client on destruction", "[cl
     REQUIRE(destroy_called);
 }
 
+TEST_CASE("A client opens its connections through a custom stream initiator", "[client]") {
+    MOCK_CLIENT
+
+    instance::current();
+
+    mongoc_stream_initiator_t installed = nullptr;
+    void* installed_data = nullptr;
+    auto client_set_stream_initiator = libmongoc::client_set_stream_initiator.create_instance();
+    client_set_stream_initiator->interpose(
+        [&](mongoc_client_t*, mongoc_stream_initiator_t initiator, void* user_data) {
+            installed = initiator;
+            installed_data = user_data;
+        });
+
+    int fake_stream_storage = 0;
+    auto fake_stream = reinterpret_cast<mongoc_stream_t*>(&fake_stream_storage);
+    std::string initiated_host;
+    std::uint16_t initiated_port = 0;
+    bool fail = false;
+
+    options::client client_opts;
+    client_opts.stream_initiator([&](stdx::string_view host, std::uint16_t port) -> void* {
+        if (fail) {
+            throw std::runtime_error{"no route to host"};
+        }
+        initiated_host = std::string{host};
+        initiated_port = port;
+        return fake_stream;
+    });
+
+    client a{uri{}, client_opts};
+    REQUIRE(installed);
+
+    mongoc_host_list_t host{};
+    std::strcpy(host.host, "db.example.com");
+    host.port = 27018;
+    bson_error_t error;
+
+    REQUIRE(installed(nullptr, &host, installed_data, &error) == fake_stream);
+    REQUIRE(initiated_host == "db.example.com");
+    REQUIRE(initiated_port == 27018);
+
+    fail = true;
+    REQUIRE(installed(nullptr, &host, installed_data, &error) == nullptr);
+    REQUIRE(std::string{error.message} == "no route to host");
+}
+
+TEST_CASE("A client without socket options keeps libmongoc's stream initiator", "[client]") {
+    MOCK_CLIENT
+
+    instance::current();
+
+    bool installed = false;
+    auto client_set_stream_initiator = libmongoc::client_set_stream_initiator.create_instance();
+    client_set_stream_initiator->interpose(
+        [&](mongoc_client_t*, mongoc_stream_initiator_t, void*) { installed = true; });
+
+    client a{uri{}};
+    REQUIRE(!installed);
+}
+
 TEST_CASE("A client supports move operations", "[client]") {
     MOCK_CLIENT
 
@@ -250,6 +366,232 @@ TEST_CASE("A client can delete apm options and the callbacks will still work pro
     REQUIRE(triggered);
 }
 
+TEST_CASE("A client reports command timings and samples commands", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    instance::current();
+
+    struct recorded {
+        std::int32_t started = 0;
+        std::vector<std::int64_t> request_ids;
+        std::vector<std::string> command_names;
+        bool well_formed = true;
+    } record;
+
+    auto on_timing = [](const events::command_timing& timing, void* context) {
+        auto record = static_cast<recorded*>(context);
+        record->request_ids.push_back(timing.request_id);
+        record->command_names.push_back(std::string{timing.command_name});
+        record->well_formed = record->well_formed && timing.duration >= 0 && timing.succeeded &&
+                              !timing.host.empty() && timing.port > 0;
+    };
+
+    options::apm apm_opts;
+    apm_opts.on_command_timing(on_timing, &record);
+    apm_opts.on_command_started([&](const events::command_started_event&) { ++record.started; });
+
+    SECTION("every command is timed by default") {
+        REQUIRE(apm_opts.command_sample_rate() == 1);
+
+        client mongo_client(uri{}, options::client{}.apm_opts(apm_opts));
+        mongo_client["test"]["test_apm_timing"].insert_one(make_document(kvp("x", 1)));
+
+        REQUIRE(record.command_names.size() == 1);
+        REQUIRE(record.command_names[0] == "insert");
+        REQUIRE(record.started == 1);
+        REQUIRE(record.well_formed);
+    }
+
+    SECTION("only sampled commands are monitored") {
+        apm_opts.command_sample_rate(3);
+
+        client mongo_client(uri{}, options::client{}.apm_opts(apm_opts));
+        for (std::int32_t i = 0; i < 9; ++i) {
+            mongo_client["test"]["test_apm_timing"].insert_one(make_document(kvp("x", i)));
+        }
+
+        REQUIRE(!record.request_ids.empty());
+        REQUIRE(record.request_ids.size() < 9);
+        REQUIRE(record.started == static_cast<std::int32_t>(record.request_ids.size()));
+        for (auto request_id : record.request_ids) {
+            REQUIRE(request_id % 3 == 0);
+        }
+    }
+
+    SECTION("the sampling rate must be positive") {
+        REQUIRE_THROWS_AS(apm_opts.command_sample_rate(0), logic_error);
+    }
+
+    SECTION("timings can be delivered on a dedicated thread") {
+        REQUIRE_THROWS_AS(apm_opts.async_delivery(0), logic_error);
+        apm_opts.async_delivery(64);
+
+        {
+            client mongo_client(uri{}, options::client{}.apm_opts(apm_opts));
+            mongo_client["test"]["test_apm_timing"].insert_one(make_document(kvp("x", 1)));
+            REQUIRE(mongo_client.dropped_apm_events() == 0);
+        }  // Destroying the client delivers the queued timings.
+
+        REQUIRE(record.command_names.size() == 1);
+        REQUIRE(record.command_names[0] == "insert");
+    }
+}
+
+TEST_CASE("A client records command latencies", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    instance::current();
+
+    SECTION("nothing is recorded by default") {
+        client mongo_client{uri{}};
+        mongo_client["test"]["test_apm_latencies"].insert_one(make_document(kvp("x", 1)));
+        REQUIRE(mongo_client.command_latencies().empty());
+    }
+
+    SECTION("succeeded commands are recorded per command name") {
+        options::apm apm_opts;
+        apm_opts.record_command_latencies(true);
+        client mongo_client{uri{}, options::client{}.apm_opts(apm_opts)};
+        auto coll = mongo_client["test"]["test_apm_latencies"];
+        for (std::int32_t i = 0; i < 5; ++i) {
+            coll.insert_one(make_document(kvp("x", i)));
+        }
+        coll.find_one({});
+
+        auto latencies = mongo_client.command_latencies();
+        REQUIRE(latencies.size() == 2);
+        REQUIRE(latencies[0].command_name == "find");
+        REQUIRE(latencies[0].count == 1);
+        REQUIRE(latencies[1].command_name == "insert");
+        REQUIRE(latencies[1].count == 5);
+        REQUIRE(latencies[1].percentile(50) <= latencies[1].max_duration);
+        REQUIRE(!latencies[1].host.empty());
+    }
+}
+
+TEST_CASE("A client takes snapshots of its topology", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    instance::current();
+
+    SECTION("servers are described along with the commands they ran") {
+        options::apm apm_opts;
+        apm_opts.record_command_latencies(true);
+        client mongo_client{uri{}, options::client{}.apm_opts(apm_opts)};
+        mongo_client["admin"].run_command(make_document(kvp("ping", 1)));
+
+        auto snapshot = mongo_client.topology_snapshot();
+        REQUIRE(snapshot.local_threshold == std::chrono::milliseconds{15});
+        REQUIRE(!snapshot.servers.empty());
+
+        std::uint64_t commands = 0;
+        for (auto&& server : snapshot.servers) {
+            REQUIRE(!server.host.empty());
+            REQUIRE(!server.type.empty());
+            commands += server.command_count;
+        }
+        REQUIRE(commands >= 1);
+    }
+
+    SECTION("the latency window can be overridden") {
+        client mongo_client{uri{"mongodb://localhost/?localThresholdMS=100"},
+                            options::client{}.local_threshold(std::chrono::milliseconds{5})};
+        REQUIRE(mongo_client.topology_snapshot().local_threshold == std::chrono::milliseconds{5});
+
+        client uri_client{uri{"mongodb://localhost/?localThresholdMS=100"}};
+        REQUIRE(uri_client.topology_snapshot().local_threshold == std::chrono::milliseconds{100});
+    }
+
+    SECTION("the latency window must not be negative") {
+        REQUIRE_THROWS_AS(options::client{}.local_threshold(std::chrono::milliseconds{-1}),
+                          logic_error);
+    }
+}
+
+TEST_CASE("A client reports compression statistics", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    instance::current();
+
+    SECTION("compressors and their level override the URI") {
+        options::apm apm_opts;
+        apm_opts.record_command_bytes(true);
+        client mongo_client{uri{"mongodb://localhost/?compressors=snappy"},
+                            options::client{}
+                                .apm_opts(apm_opts)
+                                .compressors({"zlib"})
+                                .zlib_compression_level(6)};
+        mongo_client["admin"].run_command(make_document(kvp("ping", 1)));
+
+        auto statistics = mongo_client.compression_statistics();
+        REQUIRE(statistics.compressors == std::vector<std::string>{"zlib"});
+        REQUIRE(statistics.zlib_compression_level == 6);
+        REQUIRE(!statistics.servers.empty());
+        REQUIRE(statistics.commands >= 1);
+        REQUIRE(statistics.command_bytes > 0);
+        REQUIRE(statistics.reply_bytes > 0);
+    }
+
+    SECTION("bytes are not counted by default") {
+        client mongo_client{uri{}};
+        mongo_client["admin"].run_command(make_document(kvp("ping", 1)));
+
+        auto statistics = mongo_client.compression_statistics();
+        REQUIRE(statistics.compressors.empty());
+        REQUIRE(statistics.zlib_compression_level == -1);
+        REQUIRE(statistics.command_bytes == 0);
+    }
+
+    SECTION("compression options are validated") {
+        REQUIRE_THROWS_AS(options::client{}.compressors({"zlib", "lz4"}), logic_error);
+        REQUIRE_THROWS_AS(options::client{}.zlib_compression_level(10), logic_error);
+        REQUIRE_THROWS_AS(options::client{}.zlib_compression_level(-2), logic_error);
+    }
+}
+
+TEST_CASE("A client collects operation statistics", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    instance::current();
+
+    options::apm apm_opts;
+    apm_opts.record_operation_stats(true);
+    client mongo_client{uri{}, options::client{}.apm_opts(apm_opts)};
+    auto coll = mongo_client["test"]["test_operation_stats"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (std::int32_t i = 0; i < 10; ++i) {
+        docs.push_back(make_document(kvp("x", i)));
+    }
+    auto inserted = coll.insert_many(docs);
+    REQUIRE(inserted);
+    REQUIRE(inserted->stats().round_trips == 1);
+    REQUIRE(inserted->stats().bytes_sent > 10 * docs[0].view().length());
+    REQUIRE(inserted->stats().bytes_received > 0);
+    REQUIRE(inserted->stats().duration.count() >= 0);
+
+    options::find find_opts;
+    find_opts.batch_size(4);
+    auto cursor = coll.find({}, find_opts);
+    REQUIRE(cursor.stats().round_trips == 0);
+    std::int32_t count = 0;
+    for (auto&& doc : cursor) {
+        (void)doc;
+        count++;
+    }
+    REQUIRE(count == 10);
+
+    // A find and two getMores, for batches of 4, 4 and 2 documents.
+    REQUIRE(cursor.stats().round_trips == 3);
+    REQUIRE(cursor.stats().bytes_received > cursor.stats().bytes_sent);
+}
+
 TEST_CASE("A client's write concern may be set and obtained", "[client]") {
     MOCK_CLIENT
 
@@ -437,4 +779,36 @@ TEST_CASE("A client can be constructed with SSL options", "[client]") {
 }
 #endif
 
+TEST_CASE("A client reports the query shapes that lack an index", "[client]") {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
+
+    instance::current();
+
+    options::apm apm_opts;
+    apm_opts.record_query_shapes();
+    client mongo_client(uri{}, options::client{}.apm_opts(apm_opts));
+
+    auto coll = mongo_client["test"]["test_query_shapes"];
+    coll.drop();
+    coll.insert_one(make_document(kvp("a", 1), kvp("b", 1)));
+    coll.create_index(make_document(kvp("a", 1)));
+
+    for (std::int32_t i = 0; i < 3; ++i) {
+        coll.find_one(make_document(kvp("b", i)));
+    }
+    coll.find_one(make_document(kvp("a", 1)));
+
+    auto shapes = mongo_client.query_shapes();
+    auto unindexed = unindexed_query_shapes(mongo_client, shapes);
+
+    REQUIRE(unindexed.size() == 1);
+    REQUIRE(unindexed[0].collection == "test_query_shapes");
+    REQUIRE(unindexed[0].filter_shape.view() == make_document(kvp("b", "?")));
+    REQUIRE(unindexed[0].count == 3);
+
+    REQUIRE(client{uri{}}.query_shapes().empty());
+    REQUIRE_THROWS_AS(options::apm{}.record_query_shapes(0), logic_error);
+}
+
 }  // namespace
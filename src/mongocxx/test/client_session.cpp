@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <cstdint>
 #include <sstream>
+#include <utility>
 
 #include <helpers.hpp>
 
@@ -61,6 +64,33 @@ TEST_CASE("session options", "[session]") {
         auto s = c.start_session(opts);
         REQUIRE(!s.options().causal_consistency());
     }
+
+    SECTION("ended sessions are reused with new options") {
+        {
+            auto s = c.start_session();
+            s.advance_operation_time(b_timestamp{0, 1});
+        }
+
+        options::client_session opts;
+        opts.causal_consistency(false);
+
+        auto s = c.start_session(opts);
+        REQUIRE(!s.options().causal_consistency());
+        REQUIRE(!s.id().empty());
+        REQUIRE(s.cluster_time().empty());
+        REQUIRE(s.operation_time() == b_timestamp{0, 0});
+    }
+
+    SECTION("a reused session belongs to the client it was started from") {
+        {
+            auto s = c.start_session();
+        }
+
+        client moved{std::move(c)};
+        auto s = moved.start_session();
+        REQUIRE(&s.client() == &moved);
+        REQUIRE(!s.id().empty());
+    }
 }
 
 TEST_CASE("start_session failure", "[session]") {
@@ -797,6 +827,40 @@ TEST_CASE("with_transaction", "[session]") {
             // performing long sleeps.
         }
     }  // End prose tests.
+
+    SECTION("retries are bounded by the retry budget") {
+        std::uint32_t attempts = 0;
+        auto transient = [&](client_session*) {
+            attempts++;
+            throw operation_exception{
+                make_error_code(error_code::k_invalid_parameter),
+                from_json(R"({"errorLabels": ["TransientTransactionError"]})"),
+                "write conflict"};
+        };
+
+        options::transaction opts;
+        opts.retry_backoff(std::chrono::milliseconds{1}, std::chrono::milliseconds{4});
+        opts.max_retries(3);
+
+        try {
+            session.with_transaction(transient, opts);
+            FAIL("expected the retry budget to run out");
+        } catch (const operation_exception& e) {
+            REQUIRE(e.code() == error_code::k_transaction_retry_budget_exhausted);
+            REQUIRE(e.has_error_label("TransientTransactionError"));
+        }
+
+        REQUIRE(attempts == 4);
+        auto stats = session.with_transaction_stats();
+        REQUIRE(stats.transactions == 1);
+        REQUIRE(stats.retries == 3);
+        REQUIRE(stats.budget_exhausted == 1);
+        REQUIRE(stats.backoff_time <= std::chrono::milliseconds{1 + 2 + 4});
+
+        REQUIRE_THROWS_AS(
+            opts.retry_backoff(std::chrono::milliseconds{2}, std::chrono::milliseconds{1}),
+            logic_error);
+    }
 }
 
 TEST_CASE("unacknowledged write in session", "[session]") {
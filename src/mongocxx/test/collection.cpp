@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <iterator>
+#include <thread>
 #include <vector>
 
 #include <bsoncxx/builder/basic/document.hpp>
@@ -25,13 +29,18 @@
 #include <bsoncxx/types.hpp>
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
+#include <mongocxx/events/command_started_event.hpp>
 #include <mongocxx/exception/bulk_write_exception.hpp>
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/exception/operation_exception.hpp>
 #include <mongocxx/exception/query_exception.hpp>
 #include <mongocxx/exception/write_exception.hpp>
 #include <mongocxx/instance.hpp>
+#include <mongocxx/options/apm.hpp>
+#include <mongocxx/options/client.hpp>
 #include <mongocxx/pipeline.hpp>
+#include <mongocxx/pipeline_template.hpp>
+#include <mongocxx/pool.hpp>
 #include <mongocxx/read_concern.hpp>
 #include <mongocxx/test_util/client_helpers.hh>
 #include <mongocxx/write_concern.hpp>
@@ -228,6 +237,25 @@ TEST_CASE("CRUD functionality", "[driver::collection]") {
             REQUIRE(count == 1);
         }
 
+        SECTION("unacknowledged collection write concern leaves _id generation to libmongoc",
+                "[collection]") {
+            collection coll = db["insert_one_unack_collection"];
+            coll.drop();
+            coll.write_concern(noack);
+
+            REQUIRE(!coll.insert_one(make_document(kvp("x", 1))));
+            REQUIRE(!coll.insert_many(std::vector<bsoncxx::document::value>{
+                make_document(kvp("x", 2)), make_document(kvp("x", 3))}));
+
+            db.run_command(make_document(kvp("getLastError", 1)));
+
+            coll.write_concern(default_wc);
+            REQUIRE(coll.count_documents({}) == 3);
+            for (auto&& found : coll.find({})) {
+                REQUIRE(found["_id"].type() == bsoncxx::type::k_oid);
+            }
+        }
+
         SECTION("bypass_document_validation ignores validation_criteria", "[collection]") {
             std::string collname = "insert_one_bypass_document_validation";
             db[collname].drop();
@@ -300,6 +328,96 @@ TEST_CASE("CRUD functionality", "[driver::collection]") {
         }
     }
 
+    SECTION("insert_stream inserts a range in bounded batches", "[collection]") {
+        collection coll = db["insert_stream"];
+        coll.drop();
+
+        std::vector<bsoncxx::document::value> docs;
+        for (std::int32_t i = 0; i < 1000; ++i) {
+            docs.push_back(make_document(kvp("x", i), kvp("padding", std::string(100, 'p'))));
+        }
+
+        SECTION("every batch is inserted and totalled") {
+            auto result = coll.insert_stream(docs, options::insert{}, 4096);
+            REQUIRE(result);
+            REQUIRE(result->inserted_count() == 1000);
+            REQUIRE(result->inserted_ids().size() == 1000);
+            REQUIRE(coll.count_documents({}) == 1000);
+        }
+
+        SECTION("a failed batch stops the stream") {
+            docs[500] = make_document(kvp("_id", 1));
+            docs[501] = make_document(kvp("_id", 1));
+
+            REQUIRE_THROWS_AS(coll.insert_stream(docs, options::insert{}, 4096),
+                              bulk_write_exception);
+            auto inserted = coll.count_documents({});
+            REQUIRE(inserted >= 501);
+            REQUIRE(inserted < 1000);
+        }
+
+        SECTION("a failed batch is reported as part of the whole insert") {
+            docs[500] = make_document(kvp("_id", 1));
+            docs[501] = make_document(kvp("_id", 1));
+
+            try {
+                coll.insert_stream(docs, options::insert{}, 4096);
+                FAIL("expected a bulk_write_exception");
+            } catch (const bulk_write_exception& e) {
+                REQUIRE(e.raw_server_error());
+                auto reply = e.raw_server_error()->view();
+                REQUIRE(reply["nInserted"].get_int32() == 501);
+                REQUIRE(reply["writeErrors"][0]["index"].get_int32() == 501);
+            }
+        }
+
+        SECTION("the batch size must be positive") {
+            REQUIRE_THROWS_AS(coll.insert_stream(docs, options::insert{}, 0), logic_error);
+        }
+
+        SECTION("every batch is sent on the calling thread") {
+            // Catch assertions are not thread-safe, so the callback only counts.
+            std::atomic<int> inserts{0};
+            std::atomic<int> elsewhere{0};
+            const auto caller = std::this_thread::get_id();
+
+            options::apm apm_opts;
+            apm_opts.on_command_started([&](const events::command_started_event& event) {
+                if (event.command_name() != stdx::string_view{"insert"}) {
+                    return;
+                }
+                ++inserts;
+                if (std::this_thread::get_id() != caller) {
+                    ++elsewhere;
+                }
+            });
+            options::client client_opts;
+            client_opts.apm_opts(apm_opts);
+            client monitored{uri{}, client_opts};
+
+            auto monitored_coll = monitored[db.name()]["insert_stream"];
+            REQUIRE(monitored_coll.insert_stream(docs, options::insert{}, 4096));
+            REQUIRE(inserts > 1);
+            REQUIRE(elsewhere == 0);
+        }
+    }
+
+    SECTION("ordered insert_many sends message-sized batches", "[collection]") {
+        collection coll = db["insert_many_batches"];
+        coll.drop();
+
+        // More than collection::k_insert_many_batch_bytes in total, without _ids.
+        auto big = make_document(kvp("padding", std::string(1000 * 1000, 'p')));
+        std::vector<bsoncxx::document::view> docs(50, big.view());
+
+        auto result = coll.insert_many(docs);
+        REQUIRE(result);
+        REQUIRE(result->inserted_count() == 50);
+        REQUIRE(result->inserted_ids().size() == 50);
+        REQUIRE(coll.count_documents({}) == 50);
+        coll.drop();
+    }
+
     SECTION("insert_many returns correct result object", "[collection]") {
         bsoncxx::builder::basic::document b1;
         bsoncxx::builder::basic::document b2;
@@ -2248,6 +2366,26 @@ TEST_CASE("CRUD functionality", "[driver::collection]") {
         assert_contains_one("quux");
     }
 
+    SECTION("distinct_values views the values of the reply", "[collection]") {
+        collection coll = db["distinct_values"];
+        coll.drop();
+        coll.insert_many(std::vector<bsoncxx::document::value>{
+            make_document(kvp("foo", "baz"), kvp("garply", 1)),
+            make_document(kvp("foo", "bar"), kvp("garply", 2)),
+            make_document(kvp("foo", "baz"), kvp("garply", 2)),
+            make_document(kvp("foo", "quux"), kvp("garply", 9))});
+
+        auto result = coll.distinct_values("foo", make_document(kvp("garply", 2)));
+        REQUIRE(result.reply()["ok"]);
+
+        std::vector<stdx::string_view> distinct_values;
+        for (auto&& value : result.values()) {
+            distinct_values.push_back(value.get_utf8().value);
+        }
+        std::sort(distinct_values.begin(), distinct_values.end());
+        REQUIRE(distinct_values == (std::vector<stdx::string_view>{"bar", "baz"}));
+    }
+
     SECTION("distinct with collation", "[collection]") {
         collection coll = db["distinct_with_collation"];
         coll.drop();
@@ -2640,6 +2778,675 @@ TEST_CASE("Cursor iteration", "[collection][cursor]") {
     }
 }
 
+TEST_CASE("Cursor batches", "[collection][cursor]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_cursor_batches"]["coll"];
+    coll.drop();
+
+    for (int32_t n = 0; n != 10; ++n) {
+        coll.insert_one(make_document(kvp("x", n)));
+    }
+
+    options::find opts;
+    opts.sort(make_document(kvp("x", 1)));
+    opts.batch_size(4);
+    auto cursor = coll.find({}, opts);
+
+    auto first = cursor.next_batch(4);
+    REQUIRE(first.size() == 4);
+    auto second = cursor.next_batch(4);
+    REQUIRE(second.size() == 4);
+
+    // Documents of an earlier batch stay valid once the cursor has moved on.
+    int32_t expected = 0;
+    for (auto&& doc : first) {
+        REQUIRE(doc["x"].get_int32() == expected++);
+    }
+    for (auto&& doc : second) {
+        REQUIRE(doc["x"].get_int32() == expected++);
+    }
+
+    // The remaining documents are still available to iteration.
+    REQUIRE((*cursor.begin())["x"].get_int32() == 8);
+
+    auto last = cursor.next_batch(4);
+    REQUIRE(last.size() == 2);
+    REQUIRE(last[1]["x"].get_int32() == 9);
+
+    REQUIRE(cursor.next_batch(4).empty());
+    REQUIRE(cursor.begin() == cursor.end());
+}
+
+TEST_CASE("Cursor retained documents", "[collection][cursor]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_cursor_retain"]["coll"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (int32_t n = 0; n != 50; ++n) {
+        docs.push_back(make_document(kvp("x", n), kvp("padding", std::string(10000, 'a'))));
+    }
+    coll.insert_many(docs);
+
+    std::vector<bsoncxx::document::value> retained;
+    {
+        options::find opts;
+        opts.sort(make_document(kvp("x", 1)));
+        opts.batch_size(5);
+        auto cursor = coll.find({}, opts);
+
+        for (auto iter = cursor.begin(); iter != cursor.end(); ++iter) {
+            retained.push_back(iter.retain());
+        }
+    }
+
+    // The documents outlive both the batches they were read from and the cursor.
+    REQUIRE(retained.size() == 50);
+    for (int32_t n = 0; n != 50; ++n) {
+        auto doc = retained[static_cast<std::size_t>(n)].view();
+        REQUIRE(doc["x"].get_int32() == n);
+        REQUIRE(doc["padding"].get_utf8().value.size() == 10000);
+    }
+}
+
+TEST_CASE("Cursor prefetching", "[collection][cursor]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_cursor_prefetching"]["coll"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (int32_t n = 0; n != 25; ++n) {
+        docs.push_back(make_document(kvp("x", n)));
+    }
+    coll.insert_many(docs);
+
+    SECTION("find returns every document in order") {
+        options::find opts;
+        opts.sort(make_document(kvp("x", 1)));
+        opts.batch_size(4);
+        opts.prefetch_batches(2);
+
+        int32_t expected = 0;
+        for (auto&& doc : coll.find({}, opts)) {
+            REQUIRE(doc["x"].get_int32() == expected++);
+        }
+        REQUIRE(expected == 25);
+    }
+
+    SECTION("aggregate returns every document") {
+        options::aggregate opts;
+        opts.batch_size(4);
+        opts.prefetch_batches(1);
+
+        pipeline p;
+        p.sort(make_document(kvp("x", 1)));
+
+        int32_t expected = 0;
+        for (auto&& doc : coll.aggregate(p, opts)) {
+            REQUIRE(doc["x"].get_int32() == expected++);
+        }
+        REQUIRE(expected == 25);
+    }
+
+    SECTION("a cursor can be destroyed before it is exhausted") {
+        options::find opts;
+        opts.batch_size(2);
+        opts.prefetch_batches(3);
+
+        auto cursor = coll.find({}, opts);
+        REQUIRE(cursor.begin() != cursor.end());
+    }
+
+    SECTION("query errors are reported by iteration") {
+        options::find opts;
+        opts.prefetch_batches(1);
+
+        auto cursor = coll.find(make_document(kvp("x", make_document(kvp("$invalid", 1)))), opts);
+        REQUIRE_THROWS_AS(cursor.begin(), query_exception);
+    }
+
+    SECTION("tailable cursors cannot prefetch") {
+        options::find opts;
+        opts.cursor_type(cursor::type::k_tailable);
+        opts.prefetch_batches(1);
+
+        REQUIRE_THROWS_AS(coll.find({}, opts), logic_error);
+    }
+
+    SECTION("batches can be sized by bytes and adapted to the consumer") {
+        options::find opts;
+        opts.sort(make_document(kvp("x", 1)));
+        opts.batch_size(2);
+        opts.max_batch_bytes(64);
+
+        SECTION("...synchronously") {}
+        SECTION("...adaptively") {
+            opts.adaptive_batch_size(true);
+        }
+        SECTION("...while prefetching") {
+            opts.adaptive_batch_size(true);
+            opts.prefetch_batches(2);
+        }
+
+        int32_t expected = 0;
+        for (auto&& doc : coll.find({}, opts)) {
+            REQUIRE(doc["x"].get_int32() == expected++);
+        }
+        REQUIRE(expected == 25);
+    }
+
+    SECTION("the batch byte budget must be positive") {
+        options::find opts;
+        opts.max_batch_bytes(0);
+
+        REQUIRE_THROWS_AS(coll.find({}, opts), logic_error);
+    }
+
+    SECTION("prefetched batches are capped by bytes") {
+        options::find opts;
+        opts.sort(make_document(kvp("x", 1)));
+        opts.batch_size(2);
+        opts.prefetch_batches(4);
+
+        auto read_all = [&](collection& source) {
+            int32_t expected = 0;
+            for (auto&& doc : source.find({}, opts)) {
+                REQUIRE(doc["x"].get_int32() == expected++);
+            }
+            REQUIRE(expected == 25);
+        };
+
+        SECTION("...per cursor") {
+            opts.max_prefetched_bytes(64);
+            read_all(coll);
+            REQUIRE(mongodb_client.buffered_reply_bytes() == 0);
+        }
+
+        SECTION("...per client") {
+            options::client client_opts;
+            client_opts.max_buffered_reply_bytes(64);
+            client capped{uri{}, client_opts};
+            auto capped_coll = capped["collection_cursor_prefetching"]["coll"];
+
+            read_all(capped_coll);
+            REQUIRE(capped.buffered_reply_bytes() == 0);
+        }
+    }
+
+    SECTION("the prefetched byte caps must be positive") {
+        options::find opts;
+        opts.prefetch_batches(1);
+        opts.max_prefetched_bytes(0);
+        REQUIRE_THROWS_AS(coll.find({}, opts), logic_error);
+
+        options::client client_opts;
+        client_opts.max_buffered_reply_bytes(0);
+        REQUIRE_THROWS_AS((client{uri{}, client_opts}), logic_error);
+    }
+}
+
+TEST_CASE("Prepared operations", "[collection]") {
+    using bsoncxx::types::b_int32;
+    using bsoncxx::types::b_utf8;
+    using bsoncxx::types::value;
+
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_prepared_operations"]["coll"];
+    coll.drop();
+
+    for (int32_t n = 0; n != 10; ++n) {
+        coll.insert_one(make_document(kvp("x", n), kvp("parity", n % 2 ? "odd" : "even")));
+    }
+
+    const auto parity = pipeline_template::parameter("parity");
+    const auto min = pipeline_template::parameter("min");
+
+    SECTION("find binds the filter and keeps the options") {
+        options::find opts;
+        opts.sort(make_document(kvp("x", -1))).limit(2);
+        auto find = coll.prepare_find(
+            make_document(kvp("parity", parity), kvp("x", make_document(kvp("$gte", min)))), opts);
+        REQUIRE(find.parameter_count() == 2);
+        REQUIRE(find.parameter_index("min") == 1);
+
+        std::vector<int32_t> found;
+        for (auto&& doc : find.execute({value{b_utf8{"odd"}}, value{b_int32{0}}})) {
+            found.push_back(doc["x"].get_int32());
+        }
+        REQUIRE(found == (std::vector<int32_t>{9, 7}));
+
+        found.clear();
+        for (auto&& doc : find.execute({value{b_utf8{"even"}}, value{b_int32{7}}})) {
+            found.push_back(doc["x"].get_int32());
+        }
+        REQUIRE(found == (std::vector<int32_t>{8}));
+
+        REQUIRE_THROWS_AS(find.execute({value{b_utf8{"odd"}}}), logic_error);
+    }
+
+    SECTION("update_one shares parameters between the filter and the update") {
+        auto update = coll.prepare_update_one(
+            make_document(kvp("x", min)),
+            make_document(kvp("$set", make_document(kvp("parity", parity), kvp("seen", min)))));
+        REQUIRE(update.parameter_count() == 2);
+
+        auto result = update.execute({value{b_int32{4}}, value{b_utf8{"four"}}});
+        REQUIRE(result);
+        REQUIRE(result->modified_count() == 1);
+
+        auto doc = coll.find_one(make_document(kvp("x", 4)));
+        REQUIRE(doc);
+        REQUIRE(doc->view()["parity"].get_utf8().value == stdx::string_view{"four"});
+        REQUIRE(doc->view()["seen"].get_int32() == 4);
+    }
+
+    SECTION("update_one keeps its options") {
+        const auto set_y = make_document(kvp("$set", make_document(kvp("y", 1))));
+        options::update opts;
+        opts.upsert(true);
+        auto upsert = coll.prepare_update_one(make_document(kvp("x", min)), set_y.view(), opts);
+
+        auto result = upsert.execute({value{b_int32{100}}});
+        REQUIRE(result);
+        REQUIRE(result->upserted_id());
+        REQUIRE(coll.count_documents(make_document(kvp("x", 100))) == 1);
+    }
+
+    SECTION("find_one_and_update reuses its options between executions") {
+        options::find_one_and_update opts;
+        opts.sort(make_document(kvp("x", 1)))
+            .projection(make_document(kvp("_id", 0), kvp("x", 1), kvp("taken", 1)))
+            .return_document(options::return_document::k_after);
+        auto ready = make_document(kvp("parity", parity),
+                                   kvp("taken", make_document(kvp("$exists", false))));
+        auto dequeue = coll.prepare_find_one_and_update(
+            ready.view(), make_document(kvp("$set", make_document(kvp("taken", true)))), opts);
+        REQUIRE(dequeue.parameter_count() == 1);
+
+        std::vector<int32_t> taken;
+        while (auto doc = dequeue.execute({value{b_utf8{"odd"}}})) {
+            REQUIRE(doc->view()["taken"].get_bool());
+            REQUIRE(!doc->view()["_id"]);
+            taken.push_back(doc->view()["x"].get_int32());
+        }
+        REQUIRE(taken == (std::vector<int32_t>{1, 3, 5, 7, 9}));
+
+        auto session = mongodb_client.start_session();
+        auto even = dequeue.execute(session, {value{b_utf8{"even"}}});
+        REQUIRE(even);
+        REQUIRE(even->view()["x"].get_int32() == 0);
+        REQUIRE(dequeue.execute(session, {value{b_utf8{"even"}}})->view()["x"].get_int32() == 2);
+
+        REQUIRE_THROWS_AS(dequeue.execute({}), logic_error);
+    }
+}
+
+TEST_CASE("claim_many", "[collection]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_claim_many"]["jobs"];
+    coll.drop();
+
+    for (int32_t n = 0; n != 10; ++n) {
+        coll.insert_one(make_document(kvp("_id", n), kvp("state", "ready")));
+    }
+
+    const auto ready = make_document(kvp("state", "ready"));
+    const auto take = make_document(kvp("$set", make_document(kvp("state", "taken"))));
+
+    SECTION("claims documents in sort order, each only once") {
+        options::find_one_and_update opts;
+        opts.sort(make_document(kvp("_id", 1)));
+
+        std::vector<int32_t> claimed;
+        for (auto&& doc : coll.claim_many(ready.view(), take.view(), 4, opts)) {
+            REQUIRE(doc.view()["state"].get_utf8().value == stdx::string_view{"ready"});
+            claimed.push_back(doc.view()["_id"].get_int32());
+        }
+        REQUIRE(claimed == (std::vector<int32_t>{0, 1, 2, 3}));
+
+        opts.return_document(options::return_document::k_after);
+        auto rest = coll.claim_many(ready.view(), take.view(), 100, opts);
+        REQUIRE(rest.size() == 6);
+        REQUIRE(rest.front().view()["_id"].get_int32() == 4);
+        REQUIRE(rest.front().view()["state"].get_utf8().value == stdx::string_view{"taken"});
+        REQUIRE(rest.front().view()["_claim"].type() == bsoncxx::type::k_oid);
+
+        REQUIRE(coll.claim_many(ready.view(), take.view(), 4).empty());
+        REQUIRE(coll.count_documents(make_document(kvp("state", "taken"))) == 10);
+    }
+
+    SECTION("upserts and unacknowledged writes are rejected") {
+        options::find_one_and_update upsert;
+        upsert.upsert(true);
+        REQUIRE_THROWS_AS(coll.claim_many(ready.view(), take.view(), 1, upsert), logic_error);
+
+        write_concern noack;
+        noack.acknowledge_level(write_concern::level::k_unacknowledged);
+        options::find_one_and_update unacknowledged;
+        unacknowledged.write_concern(noack);
+        REQUIRE_THROWS_AS(coll.claim_many(ready.view(), take.view(), 1, unacknowledged),
+                          logic_error);
+    }
+
+    coll.drop();
+}
+
+TEST_CASE("Non-throwing writes", "[collection]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_non_throwing_writes"]["coll"];
+    coll.drop();
+    coll.create_index(make_document(kvp("key", 1)), make_document(kvp("unique", true)));
+
+    SECTION("try_insert_one reports a duplicate key") {
+        auto inserted = coll.try_insert_one(make_document(kvp("_id", 1), kvp("key", "a")));
+        REQUIRE(inserted);
+        REQUIRE(inserted.value());
+        REQUIRE(inserted.value()->inserted_id().get_int32() == 1);
+
+        auto duplicate = coll.try_insert_one(make_document(kvp("_id", 1)));
+        REQUIRE(duplicate.has_error());
+        REQUIRE(duplicate.error_code().value() == 11000);
+        REQUIRE(duplicate.write_error()["code"].get_int32() == 11000);
+        REQUIRE_THROWS_AS(duplicate.throw_if_error(), bulk_write_exception);
+    }
+
+    SECTION("try_update_one reports a duplicate key") {
+        coll.insert_one(make_document(kvp("_id", 1), kvp("key", "a")));
+        coll.insert_one(make_document(kvp("_id", 2), kvp("key", "b")));
+
+        auto updated = coll.try_update_one(make_document(kvp("_id", 2)),
+                                           make_document(kvp("$set", make_document(kvp("x", 1)))));
+        REQUIRE(updated);
+        REQUIRE(updated.value()->modified_count() == 1);
+
+        auto conflict = coll.try_update_one(
+            make_document(kvp("_id", 2)),
+            make_document(kvp("$set", make_document(kvp("key", "a")))));
+        REQUIRE(conflict.has_error());
+        REQUIRE(conflict.error_code().value() == 11000);
+    }
+
+    SECTION("try_bulk_write reports the first write error") {
+        std::vector<model::write> writes;
+        writes.emplace_back(model::insert_one{make_document(kvp("_id", 1))});
+        writes.emplace_back(model::insert_one{make_document(kvp("_id", 1))});
+
+        auto outcome = coll.try_bulk_write(writes);
+        REQUIRE(outcome.has_error());
+        REQUIRE(outcome.write_error()["index"].get_int32() == 1);
+        REQUIRE(outcome.raw_server_error()["nInserted"].get_int32() == 1);
+    }
+
+    coll.drop();
+}
+
+TEST_CASE("parallel_scan", "[collection][cursor]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    mongocxx::pool pool{uri{}};
+    collection coll = mongodb_client["collection_parallel_scan"]["coll"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (int32_t n = 0; n != 100; ++n) {
+        docs.push_back(make_document(kvp("_id", n), kvp("even", n % 2 == 0)));
+    }
+    coll.insert_many(docs);
+
+    SECTION("partitions cover every matching document exactly once, in _id order") {
+        options::find opts;
+        opts.sort(make_document(kvp("_id", 1)));
+
+        auto cursors = coll.parallel_scan(pool, 4, make_document(kvp("even", true)), opts);
+        REQUIRE(cursors.size() == 4);
+
+        std::vector<std::thread> threads;
+        std::vector<std::vector<int32_t>> ids(cursors.size());
+        for (std::size_t i = 0; i != cursors.size(); ++i) {
+            threads.emplace_back([&cursors, &ids, i] {
+                for (auto&& doc : cursors[i]) {
+                    ids[i].push_back(doc["_id"].get_int32());
+                }
+            });
+        }
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<int32_t> all;
+        for (auto&& partition : ids) {
+            REQUIRE(!partition.empty());
+            all.insert(all.end(), partition.begin(), partition.end());
+        }
+        REQUIRE(all.size() == 50);
+        for (std::size_t i = 0; i != all.size(); ++i) {
+            REQUIRE(all[i] == static_cast<int32_t>(2 * i));
+        }
+    }
+
+    SECTION("an empty result yields a single empty cursor") {
+        auto cursors = coll.parallel_scan(pool, 4, make_document(kvp("missing", 1)));
+        REQUIRE(cursors.size() == 1);
+        REQUIRE(cursors[0].begin() == cursors[0].end());
+    }
+
+    SECTION("the number of partitions must be positive") {
+        REQUIRE_THROWS_AS(coll.parallel_scan(pool, 0), logic_error);
+    }
+}
+
+TEST_CASE("parallel_scan_at", "[collection][cursor]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    mongocxx::pool pool{uri{}};
+
+    if (test_util::get_topology(mongodb_client) == "single" ||
+        test_util::compare_versions(test_util::get_server_version(mongodb_client), "5.0") < 0) {
+        // Snapshot reads at a cluster time need a replica set or sharded cluster on 5.0+.
+        return;
+    }
+
+    collection coll = mongodb_client["collection_parallel_scan_at"]["coll"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (int32_t n = 0; n != 100; ++n) {
+        docs.push_back(make_document(kvp("_id", n)));
+    }
+    write_concern wc_majority;
+    wc_majority.majority(std::chrono::milliseconds(0));
+    coll.insert_many(docs, options::insert{}.write_concern(wc_majority));
+
+    const auto at = mongodb_client.cluster_time();
+    REQUIRE(at.timestamp != 0);
+
+    // Written after the cluster time, so not seen by any partition.
+    coll.insert_one(make_document(kvp("_id", 100)));
+    coll.delete_one(make_document(kvp("_id", 0)));
+
+    auto cursors = coll.parallel_scan_at(pool, at, 4);
+    REQUIRE(cursors.size() == 4);
+
+    std::vector<int32_t> all;
+    for (auto&& partition : cursors) {
+        for (auto&& doc : partition) {
+            all.push_back(doc["_id"].get_int32());
+        }
+    }
+    std::sort(all.begin(), all.end());
+    REQUIRE(all.size() == 100);
+    REQUIRE(all.front() == 0);
+    REQUIRE(all.back() == 99);
+
+    options::find tailable;
+    tailable.cursor_type(cursor::type::k_tailable);
+    REQUIRE_THROWS_AS(coll.parallel_scan_at(pool, at, 4, {}, tailable), logic_error);
+}
+
+TEST_CASE("find_by_ids", "[collection][cursor]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    mongocxx::pool pool{uri{}};
+    collection coll = mongodb_client["collection_find_by_ids"]["coll"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (int32_t n = 0; n != 1000; ++n) {
+        docs.push_back(make_document(kvp("_id", n), kvp("x", n * 2)));
+    }
+    coll.insert_many(docs);
+
+    // Every third id, plus some that match nothing.
+    std::vector<bsoncxx::types::value> ids;
+    for (int32_t n = 0; n != 1200; n += 3) {
+        ids.push_back(bsoncxx::types::value{bsoncxx::types::b_int32{n}});
+    }
+
+    SECTION("chunks are merged into one cursor") {
+        options::find opts;
+        opts.batch_size(7);
+
+        auto results = coll.find_by_ids(pool, ids, opts, 50, 3);
+
+        std::vector<int32_t> found;
+        for (auto&& doc : results) {
+            REQUIRE(doc["x"].get_int32() == doc["_id"].get_int32() * 2);
+            found.push_back(doc["_id"].get_int32());
+        }
+        REQUIRE(results.begin() == results.end());
+
+        std::sort(found.begin(), found.end());
+        REQUIRE(found.size() == 334);
+        for (std::size_t i = 0; i != found.size(); ++i) {
+            REQUIRE(found[i] == static_cast<int32_t>(3 * i));
+        }
+    }
+
+    SECTION("no ids yield an empty cursor") {
+        auto results = coll.find_by_ids(pool, {});
+        REQUIRE(results.begin() == results.end());
+    }
+
+    SECTION("a cursor can be destroyed before it is exhausted") {
+        auto results = coll.find_by_ids(pool, ids, options::find{}.batch_size(1), 10, 4);
+        REQUIRE(results.begin() != results.end());
+    }
+
+    SECTION("a failed query is rethrown") {
+        options::find opts;
+        opts.projection(make_document(kvp("$bad", 1)));
+
+        auto results = coll.find_by_ids(pool, ids, opts);
+        REQUIRE_THROWS_AS(results.begin(), query_exception);
+    }
+
+    SECTION("invalid arguments are rejected") {
+        REQUIRE_THROWS_AS(coll.find_by_ids(pool, ids, {}, 0), logic_error);
+        REQUIRE_THROWS_AS(coll.find_by_ids(pool, ids, options::find{}.limit(1)), logic_error);
+        REQUIRE_THROWS_AS(coll.find_by_ids(pool, ids, options::find{}.skip(1)), logic_error);
+    }
+}
+
+TEST_CASE("count_documents fast paths", "[collection]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_count_fast_paths"]["coll"];
+    coll.drop();
+
+    for (int32_t n = 0; n != 10; ++n) {
+        coll.insert_one(make_document(kvp("x", n)));
+    }
+
+    SECTION("an empty filter may be estimated") {
+        options::count opts;
+        opts.allow_estimate(true);
+
+        REQUIRE(coll.count_documents({}, opts) == 10);
+        REQUIRE(coll.count_documents(make_document(kvp("x", make_document(kvp("$lt", 4)))),
+                                     opts) == 4);
+        REQUIRE(coll.count_documents({}, opts.limit(3)) == 3);
+    }
+
+    SECTION("cached counts are reused") {
+        // Expiry is covered by the count_cache tests, which control the clock. The TTL here
+        // only needs to outlast the test.
+        options::count opts;
+        opts.cache_ttl(std::chrono::hours{1});
+
+        REQUIRE(coll.count_documents({}, opts) == 10);
+        coll.insert_one(make_document(kvp("x", 10)));
+        REQUIRE(coll.count_documents({}, opts) == 10);
+        REQUIRE(coll.count_documents({}) == 11);
+
+        // Another filter or other options are counted separately.
+        REQUIRE(coll.count_documents(make_document(kvp("x", 10)), opts) == 1);
+        REQUIRE(coll.count_documents({}, options::count{opts}.skip(1)) == 10);
+    }
+
+    SECTION("the cache TTL must be positive") {
+        REQUIRE_THROWS_AS(options::count{}.cache_ttl(std::chrono::milliseconds{0}), logic_error);
+    }
+}
+
+TEST_CASE("explain", "[collection]") {
+    instance::current();
+    client mongodb_client{uri{}};
+    collection coll = mongodb_client["collection_explain"]["coll"];
+    coll.drop();
+
+    for (int32_t n = 0; n != 20; ++n) {
+        coll.insert_one(make_document(kvp("a", n), kvp("b", n % 2)));
+    }
+    coll.create_index(make_document(kvp("a", 1)));
+
+    auto filter = make_document(kvp("a", make_document(kvp("$lt", 5))));
+
+    SECTION("a find reports its index and statistics") {
+        auto explained =
+            coll.explain_find(filter.view(), {}, explain_verbosity::k_execution_stats);
+
+        REQUIRE(explained.indexes() == std::vector<std::string>{"a_1"});
+        REQUIRE(!explained.collection_scan());
+        REQUIRE(*explained.returned() == 5);
+        REQUIRE(*explained.keys_examined() == 5);
+        REQUIRE(explained.execution_time());
+    }
+
+    SECTION("a find without a usable index scans the collection") {
+        auto explained = coll.explain_find(make_document(kvp("b", 1)));
+
+        REQUIRE(explained.collection_scan());
+        REQUIRE(explained.indexes().empty());
+        REQUIRE(!explained.docs_examined());
+    }
+
+    SECTION("an aggregation reports the plan of its first stage") {
+        pipeline p;
+        p.match(filter.view());
+        p.group(make_document(kvp("_id", "$b")));
+
+        auto explained = coll.explain_aggregate(p);
+
+        REQUIRE(explained.indexes() == std::vector<std::string>{"a_1"});
+    }
+
+    SECTION("an explained update modifies nothing") {
+        auto explained = coll.explain_update(filter.view(),
+                                             make_document(kvp("$set", make_document(kvp("b", 7)))),
+                                             {},
+                                             explain_verbosity::k_execution_stats);
+
+        REQUIRE(explained.indexes() == std::vector<std::string>{"a_1"});
+        REQUIRE(coll.count_documents(make_document(kvp("b", 7))) == 0);
+    }
+}
+
 TEST_CASE("regressions", "CXX-986") {
     instance::current();
     mongocxx::uri mongo_uri{"mongodb://non-existent-host.invalid/"};
@@ -2665,4 +3472,161 @@ TEST_CASE("bulk_write with container", "[collection]") {
     REQUIRE(result->inserted_count() == 10);
     REQUIRE(collection.count_documents({}) == 10);
 }
+
+TEST_CASE("parallel bulk_write", "[collection]") {
+    instance::current();
+    mongocxx::client client{uri{}};
+    mongocxx::pool pool{uri{}};
+
+    auto collection = client["parallel_bulk_write"]["collection"];
+    collection.drop();
+
+    options::bulk_write bulk_opts;
+    bulk_opts.ordered(false);
+    bulk_opts.parallelism(3, pool);
+
+    SECTION("results are merged in append order") {
+        auto bulk = collection.create_bulk_write(bulk_opts);
+        for (int32_t i = 0; i != 10; ++i) {
+            bulk.append(model::insert_one{make_document(kvp("_id", i))});
+        }
+        model::update_one upsert{make_document(kvp("_id", 100)),
+                                 make_document(kvp("$set", make_document(kvp("x", 1))))};
+        upsert.upsert(true);
+        bulk.append(upsert);
+
+        auto result = bulk.execute();
+        REQUIRE(result);
+        REQUIRE(result->inserted_count() == 10);
+        REQUIRE(result->upserted_count() == 1);
+        auto upserted = result->upserted_ids();
+        REQUIRE(upserted.size() == 1);
+        REQUIRE(upserted.count(10) == 1);
+        REQUIRE(upserted[10].get_int32() == 100);
+        REQUIRE(collection.count_documents({}) == 11);
+    }
+
+    SECTION("write errors report their position in the whole bulk write") {
+        collection.insert_one(make_document(kvp("_id", 4)));
+
+        auto bulk = collection.create_bulk_write(bulk_opts);
+        for (int32_t i = 0; i != 10; ++i) {
+            bulk.append(model::insert_one{make_document(kvp("_id", i))});
+        }
+
+        bool thrown = false;
+        try {
+            bulk.execute();
+        } catch (const bulk_write_exception& e) {
+            thrown = true;
+            auto raw = e.raw_server_error();
+            REQUIRE(raw);
+            REQUIRE(raw->view()["nInserted"].get_int32() == 9);
+            auto errors = raw->view()["writeErrors"].get_array().value;
+            REQUIRE(std::distance(errors.begin(), errors.end()) == 1);
+            REQUIRE(errors[0]["index"].get_int32() == 4);
+        }
+        REQUIRE(thrown);
+        REQUIRE(collection.count_documents({}) == 10);
+    }
+
+    SECTION("ordered bulk writes cannot be parallel") {
+        bulk_opts.ordered(true);
+        REQUIRE_THROWS_AS(collection.create_bulk_write(bulk_opts), logic_error);
+    }
+}
+
+TEST_CASE("shard-partitioned bulk_write", "[collection]") {
+    instance::current();
+    mongocxx::client client{uri{}};
+    mongocxx::pool pool{uri{}};
+
+    auto collection = client["shard_partitioned_bulk_write"]["collection"];
+    collection.drop();
+
+    options::bulk_write bulk_opts;
+    bulk_opts.ordered(false);
+    bulk_opts.shard_partitioning(pool);
+
+    SECTION("writes to an unsharded collection are not partitioned") {
+        auto bulk = collection.create_bulk_write(bulk_opts);
+        for (int32_t i = 0; i != 10; ++i) {
+            bulk.append(model::insert_one{make_document(kvp("_id", i))});
+        }
+        bulk.append(model::delete_one{make_document(kvp("_id", 3))});
+
+        auto result = bulk.execute();
+        REQUIRE(result);
+        REQUIRE(result->inserted_count() == 10);
+        REQUIRE(result->deleted_count() == 1);
+        REQUIRE(collection.count_documents({}) == 9);
+    }
+
+    SECTION("insert_many accepts shard partitioning when unordered") {
+        std::vector<bsoncxx::document::value> docs;
+        for (int32_t i = 0; i != 10; ++i) {
+            docs.push_back(make_document(kvp("_id", i)));
+        }
+        auto result = collection.insert_many(
+            docs, options::insert{}.ordered(false).shard_partitioning(pool));
+        REQUIRE(result);
+        REQUIRE(result->inserted_count() == 10);
+    }
+
+    SECTION("shard-partitioned bulk writes must be unordered and not parallel") {
+        bulk_opts.ordered(true);
+        REQUIRE_THROWS_AS(collection.create_bulk_write(bulk_opts), logic_error);
+
+        bulk_opts.ordered(false);
+        bulk_opts.parallelism(2, pool);
+        REQUIRE_THROWS_AS(collection.create_bulk_write(bulk_opts), logic_error);
+    }
+}
+
+TEST_CASE("insert_one with group_commit", "[collection]") {
+    instance::current();
+    mongocxx::pool pool{uri{}};
+    {
+        auto client = pool.acquire();
+        (*client)["group_commit"]["collection"].drop();
+    }
+
+    write_concern majority;
+    majority.majority(std::chrono::milliseconds{0});
+    const auto opts = options::insert{}.group_commit(true).write_concern(majority);
+
+    // Catch assertions are not thread-safe, so the threads only count their outcomes.
+    std::vector<std::thread> threads;
+    std::atomic<int> inserted{0};
+    std::atomic<int> duplicates{0};
+    for (int32_t t = 0; t != 4; ++t) {
+        threads.emplace_back([&, t] {
+            auto client = pool.acquire();
+            auto coll = (*client)["group_commit"]["collection"];
+            for (int32_t i = 0; i != 25; ++i) {
+                // Every thread inserts _id 0, which only one of them can.
+                auto id = i == 0 ? 0 : t * 100 + i;
+                try {
+                    auto result = coll.insert_one(make_document(kvp("_id", id)), opts);
+                    if (result && result->inserted_id().get_int32() == id &&
+                        result->result().inserted_count() == 1) {
+                        inserted++;
+                    }
+                } catch (const bulk_write_exception& e) {
+                    if (e.code().value() == 11000) {
+                        duplicates++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(inserted.load() == 97);
+    REQUIRE(duplicates.load() == 3);
+    auto client = pool.acquire();
+    REQUIRE((*client)["group_commit"]["collection"].count_documents({}) == 97);
+}
 }  // namespace
@@ -15,6 +15,7 @@
 #include "helpers.hpp"
 
 #include <chrono>
+#include <iterator>
 #include <string>
 
 #include <bsoncxx/builder/basic/document.hpp>
@@ -25,9 +26,11 @@
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <bsoncxx/stdx/optional.hpp>
 #include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types/value.hpp>
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
 #include <mongocxx/database.hpp>
+#include <mongocxx/exception/bulk_write_exception.hpp>
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/exception/operation_exception.hpp>
 #include <mongocxx/instance.hpp>
@@ -91,6 +94,28 @@ TEST_CASE("Collection", "[collection]") {
         REQUIRE(collection_set_rc_called);
     }
 
+    SECTION("copies share the mongoc collection until one of them changes it") {
+        int copies = 0;
+        auto collection_copy = libmongoc::collection_copy.create_instance();
+        collection_copy
+            ->interpose([&](mongoc_collection_t*) -> mongoc_collection_t* {
+                ++copies;
+                return nullptr;
+            })
+            .forever();
+
+        collection copy_a{mongo_coll};
+        collection copy_b = copy_a;
+        REQUIRE(copies == 0);
+
+        copy_b.write_concern(concern);
+        REQUIRE(copies == 1);
+
+        // copy_b now owns its mongoc collection alone, so it is changed in place.
+        copy_b.write_concern(concern);
+        REQUIRE(copies == 1);
+    }
+
     auto filter_doc = make_document(kvp("_id", "wow"), kvp("foo", "bar"));
 
     SECTION("Aggregate", "[Collection::aggregate]") {
@@ -329,6 +354,7 @@ TEST_CASE("Collection", "[collection]") {
         mongocxx::stdx::optional<bool> expected_allow_partial_results;
         mongocxx::stdx::optional<bsoncxx::stdx::string_view> expected_comment{};
         mongocxx::stdx::optional<mongocxx::cursor::type> expected_cursor_type{};
+        mongocxx::stdx::optional<bool> expected_exhaust;
         mongocxx::stdx::optional<bsoncxx::types::value> expected_hint{};
         mongocxx::stdx::optional<bool> expected_no_cursor_timeout;
         mongocxx::stdx::optional<bsoncxx::document::view> expected_sort{};
@@ -370,6 +396,9 @@ TEST_CASE("Collection", "[collection]") {
                         break;
                 }
             }
+            if (expected_exhaust) {
+                REQUIRE(opts_view["exhaust"].get_bool().value == *expected_exhaust);
+            }
             if (expected_hint) {
                 REQUIRE(opts_view["hint"].get_utf8() == expected_hint->get_utf8());
             }
@@ -416,6 +445,25 @@ TEST_CASE("Collection", "[collection]") {
             REQUIRE(collection_find_called);
         }
 
+        SECTION("Succeeds with a cached options document") {
+            options::find opts;
+            opts.cache_options_document(true);
+            expected_comment.emplace("first");
+            opts.comment(*expected_comment);
+
+            REQUIRE_NOTHROW(mongo_coll.find(doc, opts));
+            REQUIRE_NOTHROW(mongo_coll.find(doc, opts));
+            REQUIRE(collection_find_called);
+
+            // A setter drops the cached document, so the next find sends the new comment.
+            expected_comment.emplace("second");
+            opts.comment(*expected_comment);
+            REQUIRE_NOTHROW(mongo_coll.find(doc, opts));
+
+            const options::find copy{opts};
+            REQUIRE_NOTHROW(mongo_coll.find(doc, copy));
+        }
+
         SECTION("Succeeds with cursor type") {
             options::find opts;
             expected_cursor_type = mongocxx::cursor::type::k_tailable;
@@ -425,6 +473,15 @@ TEST_CASE("Collection", "[collection]") {
             REQUIRE(collection_find_called);
         }
 
+        SECTION("Succeeds with exhaust") {
+            options::find opts;
+            expected_exhaust = true;
+            opts.exhaust(*expected_exhaust);
+
+            REQUIRE_NOTHROW(mongo_coll.find(doc, opts));
+            REQUIRE(collection_find_called);
+        }
+
         SECTION("Succeeds with hint") {
             options::find opts;
             hint index_hint("a_1");
@@ -571,6 +628,151 @@ TEST_CASE("Collection", "[collection]") {
             perform_checks();
         }
 
+        SECTION("Insert Many Generates Missing _id", "[collection::insert_many]") {
+            expected_order_setting = true;
+
+            auto no_id_doc = make_document(kvp("foo", "bar"), kvp("baz", 1));
+
+            std::vector<bsoncxx::document::value> inserted;
+            bulk_operation_insert_with_opts->interpose(
+                [&](mongoc_bulk_operation_t*, const bson_t* doc, const bson_t*, bson_error_t*) {
+                    bulk_operation_op_called = true;
+                    inserted.emplace_back(bsoncxx::document::view{bson_get_data(doc), doc->len});
+                    return true;
+                });
+
+            std::vector<bsoncxx::document::view> docs{};
+            docs.push_back(no_id_doc.view());
+            docs.push_back(filter_doc.view());
+            docs.push_back(no_id_doc.view());
+            auto result = mongo_coll.insert_many(docs);
+            perform_checks();
+
+            REQUIRE(result);
+            REQUIRE(inserted.size() == 3);
+
+            auto ids = result->inserted_ids();
+            REQUIRE(ids.size() == 3);
+
+            for (std::size_t i : {0u, 2u}) {
+                auto view = inserted[i].view();
+                auto first = view.begin();
+                REQUIRE(first->key() == stdx::string_view{"_id"});
+                REQUIRE(first->type() == bsoncxx::type::k_oid);
+                REQUIRE(std::next(first)->key() == stdx::string_view{"foo"});
+                REQUIRE(view.length() == no_id_doc.view().length() + 17);
+                REQUIRE(ids[i].get_value() == first->get_value());
+            }
+
+            REQUIRE(inserted[0].view()["_id"].get_oid().value !=
+                    inserted[2].view()["_id"].get_oid().value);
+            REQUIRE(inserted[1].view() == filter_doc.view());
+            REQUIRE(ids[1].get_value() == filter_doc.view()["_id"].get_value());
+
+            const auto& id_vector = result->inserted_id_vector();
+            REQUIRE(id_vector.size() == 3);
+            for (std::size_t i = 0; i < id_vector.size(); i++) {
+                REQUIRE(id_vector[i].get_value() == ids[i].get_value());
+            }
+        }
+
+        SECTION("Insert Many Skipping inserted_ids", "[collection::insert_many]") {
+            expected_order_setting = true;
+
+            auto no_id_doc = make_document(kvp("foo", "bar"));
+
+            bulk_operation_insert_with_opts->interpose(
+                [&](mongoc_bulk_operation_t*, const bson_t* doc, const bson_t*, bson_error_t*) {
+                    bulk_operation_op_called = true;
+                    // The document is handed to libmongoc untouched; it adds the _id itself.
+                    REQUIRE(bson_get_data(doc) == no_id_doc.view().data());
+                    return true;
+                });
+
+            options::insert opts{};
+            opts.skip_inserted_ids(true);
+            std::vector<bsoncxx::document::view> docs{};
+            docs.push_back(no_id_doc.view());
+            docs.push_back(no_id_doc.view());
+            auto result = mongo_coll.insert_many(docs, opts);
+            perform_checks();
+
+            REQUIRE(result);
+            REQUIRE(result->inserted_ids().empty());
+            REQUIRE(result->inserted_id_vector().empty());
+        }
+
+        SECTION("Insert Many Dropping Duplicates", "[collection::insert_many]") {
+            std::vector<std::int32_t> sent;
+            bulk_operation_insert_with_opts->interpose(
+                [&](mongoc_bulk_operation_t*, const bson_t* doc, const bson_t*, bson_error_t*) {
+                    bulk_operation_op_called = true;
+                    bsoncxx::document::view view{bson_get_data(doc), doc->len};
+                    sent.push_back(view["n"].get_int32().value);
+                    return true;
+                });
+
+            SECTION("...ordered") {
+                expected_order_setting = true;
+            }
+            SECTION("...unordered") {
+                expected_order_setting = false;
+            }
+
+            auto first = make_document(kvp("_id", 1), kvp("n", 0));
+            auto other = make_document(kvp("_id", 2), kvp("n", 1));
+            auto duplicate = make_document(kvp("_id", 1), kvp("n", 2));
+            auto no_id = make_document(kvp("n", 3));
+
+            options::insert opts{};
+            opts.ordered(expected_order_setting);
+            opts.dedupe_by({"_id"});
+            std::vector<bsoncxx::document::view> docs{
+                first.view(), other.view(), duplicate.view(), no_id.view(), no_id.view()};
+            auto result = mongo_coll.insert_many(docs, opts);
+            perform_checks();
+
+            // Documents without the field are never dropped; the driver generates their _ids.
+            REQUIRE(sent == (std::vector<std::int32_t>{0, 1, 3, 3}));
+            REQUIRE(result);
+            REQUIRE(result->inserted_id_vector().size() == 4);
+
+            // The _ids are keyed by the position of their document in the input.
+            auto ids = result->inserted_ids();
+            REQUIRE(ids.size() == 4);
+            REQUIRE(ids.at(0).get_int32().value == 1);
+            REQUIRE(ids.at(1).get_int32().value == 2);
+            REQUIRE(ids.count(2) == 0);
+            REQUIRE(ids.at(3).type() == bsoncxx::type::k_oid);
+            REQUIRE(ids.at(4).type() == bsoncxx::type::k_oid);
+
+            // So are write errors: the third document sent is the fourth of the input.
+            const auto reply_doc = bsoncxx::from_json(R"({
+                "nInserted": 2,
+                "writeErrors": [{"index": 2, "code": 11000, "errmsg": "dup"}]
+            })");
+            libbson::scoped_bson_t reply_bson{reply_doc.view()};
+            bulk_operation_execute->interpose(
+                [&](mongoc_bulk_operation_t*, bson_t* reply, bson_error_t* err) {
+                    ::bson_copy_to(reply_bson.bson(), reply);
+                    bson_set_error(err, MONGOC_ERROR_COMMAND, 11000, "dup");
+                    return false;
+                });
+
+            sent.clear();
+            try {
+                mongo_coll.insert_many(docs, opts);
+                FAIL("insert_many did not throw");
+            } catch (const bulk_write_exception& e) {
+                REQUIRE(e.raw_server_error());
+                auto errors = e.raw_server_error()->view()["writeErrors"].get_array().value;
+                REQUIRE(errors[0]["index"].get_int32().value == 3);
+            }
+
+            opts.dedupe_by({});
+            REQUIRE_THROWS_AS(mongo_coll.insert_many(docs, opts), logic_error);
+        }
+
         SECTION("Update One", "[collection::update_one]") {
             bool upsert_option = false;
             expected_order_setting = true;
@@ -649,6 +851,38 @@ TEST_CASE("Collection", "[collection]") {
             perform_checks();
         }
 
+        SECTION("Try Insert One Duplicate Key", "[collection::try_insert_one]") {
+            expected_order_setting = true;
+            bulk_operation_insert_with_opts->interpose(
+                [&](mongoc_bulk_operation_t*, const bson_t*, const bson_t*, bson_error_t*) {
+                    bulk_operation_op_called = true;
+                    return true;
+                });
+
+            const auto reply_doc = bsoncxx::from_json(
+                R"({"writeErrors": [{"index": 0, "code": 11000, "errmsg": "dup"}]})");
+            libbson::scoped_bson_t reply_bson{reply_doc.view()};
+            bulk_operation_execute->interpose(
+                [&](mongoc_bulk_operation_t*, bson_t* reply, bson_error_t* err) {
+                    bulk_operation_execute_called = true;
+                    ::bson_copy_to(reply_bson.bson(), reply);
+                    bson_set_error(err, MONGOC_ERROR_COMMAND, 11000, "dup");
+                    return false;
+                });
+
+            auto outcome = mongo_coll.try_insert_one(filter_doc.view());
+            REQUIRE(outcome.has_error());
+            REQUIRE(!outcome);
+            REQUIRE(outcome.error_code().value() == 11000);
+            REQUIRE(outcome.error_message() == "dup");
+            REQUIRE(outcome.raw_server_error() == reply_doc.view());
+            REQUIRE(outcome.write_error()["code"].get_int32().value == 11000);
+            REQUIRE_THROWS_AS(outcome.value(), mongocxx::bulk_write_exception);
+            REQUIRE_THROWS_AS(mongo_coll.insert_one(filter_doc.view()),
+                              mongocxx::bulk_write_exception);
+            perform_checks();
+        }
+
         SECTION("Insert Many Error", "[collection::insert_many]") {
             expected_order_setting = true;
             bulk_operation_insert_with_opts->interpose(
@@ -883,4 +1117,50 @@ TEST_CASE("Collection", "[collection]") {
         }
     }
 }
+
+TEST_CASE("cursor::next_batch does not read past a full batch", "[collection][cursor]") {
+    instance::current();
+
+    MOCK_CLIENT
+    MOCK_DATABASE
+    MOCK_COLLECTION
+    MOCK_CURSOR
+
+    // Any pointer other than null will do, since every cursor function it reaches is mocked.
+    int placeholder;
+    auto cursor_t = reinterpret_cast<mongoc_cursor_t*>(&placeholder);
+    collection_find_with_opts
+        ->interpose([&](mongoc_collection_t*,
+                        const bson_t*,
+                        const bson_t*,
+                        const mongoc_read_prefs_t*) { return cursor_t; })
+        .forever();
+
+    auto doc = make_document(kvp("x", 1));
+    bson_t doc_bson;
+    bson_init_static(&doc_bson, doc.view().data(), doc.view().length());
+
+    int reads = 0;
+    auto cursor_next = libmongoc::cursor_next.create_instance();
+    cursor_next
+        ->interpose([&](mongoc_cursor_t*, const bson_t** out) {
+            ++reads;
+            *out = &doc_bson;
+            return true;
+        })
+        .forever();
+
+    client mongo_client{uri{}};
+    auto cursor = mongo_client["mocked_collection"]["dummy_collection"].find({});
+
+    REQUIRE(cursor.next_batch(3).size() == 3);
+    REQUIRE(reads == 3);
+
+    // The last document of the first batch is not read again.
+    REQUIRE(cursor.next_batch(2).size() == 2);
+    REQUIRE(reads == 5);
+
+    REQUIRE(cursor.begin() != cursor.end());
+    REQUIRE(reads == 6);
+}
 }  // namespace
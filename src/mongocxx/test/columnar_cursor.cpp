@@ -0,0 +1,174 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/columnar_cursor.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+using type = columnar_batch::column_type;
+
+TEST_CASE("columnar_batch decodes fields into columns", "[columnar_cursor]") {
+    columnar_batch batch{{{"n", type::k_int64},
+                          {"x", type::k_double},
+                          {"name", type::k_utf8},
+                          {"meta.ok", type::k_bool},
+                          {"meta.at", type::k_date}}};
+
+    batch.append(make_document(kvp("n", 1),
+                               kvp("x", 1.5),
+                               kvp("name", "one"),
+                               kvp("meta",
+                                   make_document(kvp("ok", true),
+                                                 kvp("at",
+                                                     bsoncxx::types::b_date{
+                                                         std::chrono::milliseconds{42}})))));
+    batch.append(make_document(kvp("n", std::int64_t{2}), kvp("x", 2), kvp("ignored", 0)));
+    batch.append(make_document(kvp("name", "three"), kvp("n", "not a number"), kvp("meta", 3)));
+
+    REQUIRE(batch.rows() == 3);
+    REQUIRE(batch.columns() == 5);
+
+    const auto& n = batch.get("n");
+    REQUIRE(n.int64s() == std::vector<std::int64_t>{1, 2, 0});
+    REQUIRE(n.null_count() == 1);
+    REQUIRE(n.validity() == std::vector<std::uint8_t>{0x3});
+
+    const auto& x = batch[1];
+    REQUIRE(x.doubles() == std::vector<double>{1.5, 2.0, 0.0});
+    REQUIRE(!x.is_valid(2));
+
+    const auto& name = batch.get("name");
+    REQUIRE(name.string_offsets() == std::vector<std::int64_t>{0, 3, 3, 8});
+    REQUIRE(name.string(0) == "one");
+    REQUIRE(!name.is_valid(1));
+    REQUIRE(name.string(2) == "three");
+
+    REQUIRE(batch.get("meta.ok").bools() == std::vector<std::uint8_t>{1, 0, 0});
+    REQUIRE(batch.get("meta.at").int64s()[0] == 42);
+    REQUIRE(batch.get("meta.at").null_count() == 2);
+
+    REQUIRE_THROWS_AS(batch.get("missing"), logic_error);
+
+    batch.clear();
+    REQUIRE(batch.rows() == 0);
+    REQUIRE(batch.get("name").string_offsets() == std::vector<std::int64_t>{0});
+
+    REQUIRE_THROWS_AS((columnar_batch{{{"a..b", type::k_bool}}}), logic_error);
+    REQUIRE_THROWS_AS((columnar_batch{{{"a", type::k_bool}, {"a", type::k_int64}}}), logic_error);
+}
+
+TEST_CASE("columnar_cursor reads a query in batches", "[columnar_cursor]") {
+    instance::current();
+
+    client mongodb_client{uri{}};
+    auto coll = mongodb_client["columnar_cursor"]["values"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (std::int32_t i = 0; i < 250; i++) {
+        docs.push_back(make_document(kvp("_id", i), kvp("value", i * 2)));
+    }
+    coll.insert_many(docs);
+
+    options::find opts;
+    opts.sort(make_document(kvp("_id", 1)));
+    columnar_cursor results{coll.find({}, opts), {{"value", type::k_int64}}, 100};
+
+    std::vector<std::size_t> sizes;
+    std::int64_t expected = 0;
+    while (results.next()) {
+        const auto& values = results.batch()[0].int64s();
+        sizes.push_back(values.size());
+        for (auto value : values) {
+            REQUIRE(value == expected);
+            expected += 2;
+        }
+    }
+    REQUIRE(sizes == std::vector<std::size_t>{100, 100, 50});
+    REQUIRE(results.batch().rows() == 0);
+
+    REQUIRE_THROWS_AS(columnar_cursor(coll.find({}), {{"value", type::k_int64}}, 0), logic_error);
+
+    coll.drop();
+}
+
+TEST_CASE("columnar_batch infers fields and decodes batches concurrently", "[columnar_cursor]") {
+    instance::current();
+
+    client mongodb_client{uri{}};
+    auto coll = mongodb_client["columnar_cursor"]["mixed"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (std::int32_t i = 0; i < 40; i++) {
+        if (i % 2 == 0) {
+            docs.push_back(make_document(kvp("_id", i),
+                                         kvp("n", i),
+                                         kvp("tag", "even"),
+                                         kvp("sub", make_document(kvp("flag", true)))));
+        } else {
+            docs.push_back(make_document(kvp("_id", i), kvp("n", 0.5), kvp("tag", i)));
+        }
+    }
+    coll.insert_many(docs);
+
+    options::find opts;
+    opts.sort(make_document(kvp("_id", 1)));
+    auto results = coll.find({}, opts);
+
+    auto sample = results.next_batch(10);
+    auto fields = columnar_batch::infer_fields(sample);
+    REQUIRE(fields.size() == 3);
+    REQUIRE(fields[0].path == "_id");
+    REQUIRE(fields[0].type == type::k_int64);
+    REQUIRE(fields[1].path == "n");
+    REQUIRE(fields[1].type == type::k_double);
+    REQUIRE(fields[2].path == "sub.flag");
+
+    std::vector<cursor::batch> batches;
+    batches.push_back(std::move(sample));
+    for (auto batch = results.next_batch(10); !batch.empty(); batch = results.next_batch(10)) {
+        batches.push_back(std::move(batch));
+    }
+
+    auto decoded = columnar_batch::decode(batches, fields, 3);
+    REQUIRE(decoded.size() == 4);
+    for (std::size_t i = 0; i < decoded.size(); i++) {
+        REQUIRE(decoded[i].rows() == 10);
+        REQUIRE(decoded[i].get("_id").int64s()[0] == static_cast<std::int64_t>(i * 10));
+        REQUIRE(decoded[i].get("sub.flag").null_count() == 5);
+    }
+
+    coll.drop();
+}
+
+}  // namespace
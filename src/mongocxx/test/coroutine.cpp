@@ -0,0 +1,293 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/async_collection.hpp>
+#include <mongocxx/coroutine.hpp>
+#include <mongocxx/exception/bulk_write_exception.hpp>
+#include <mongocxx/exception/query_exception.hpp>
+#include <mongocxx/executor.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/model/insert_one.hpp>
+#include <mongocxx/options/pool.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/libbson.hh>
+#include <mongocxx/private/libmongoc.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+// Queues the tasks submitted to it until run() is called, so that they run on the test's thread,
+// where the libmongoc mocks are active, and only once the test lets them.
+class manual_executor : public executor {
+   public:
+    void submit(std::function<void()> task) override {
+        _tasks.push_back(std::move(task));
+    }
+
+    std::size_t concurrency() const override {
+        return 1;
+    }
+
+    // Runs the queued tasks, including any queued while they run.
+    void run() {
+        while (!_tasks.empty()) {
+            auto task = std::move(_tasks.front());
+            _tasks.pop_front();
+            task();
+        }
+    }
+
+   private:
+    std::deque<std::function<void()>> _tasks;
+};
+
+// The result or exception of an awaited operation, and whether the awaiting coroutine finished.
+template <typename result_type>
+struct outcome {
+    bsoncxx::stdx::optional<result_type> result;
+    std::exception_ptr error;
+    bool done = false;
+};
+
+// A coroutine which starts as soon as it is called and cleans up after itself once it finishes.
+struct detached {
+    struct promise_type {
+        detached get_return_object() noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+template <typename function_type>
+detached await_into(awaitable<function_type> operation,
+                    outcome<typename awaitable<function_type>::result_type>& out) {
+    try {
+        out.result = co_await operation;
+    } catch (...) {
+        out.error = std::current_exception();
+    }
+    out.done = true;
+}
+
+template <typename exception_type>
+bool holds(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const exception_type&) {
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+TEST_CASE("coroutines await the operations of an async_collection", "[coroutine]") {
+    instance::current();
+
+    MOCK_POOL
+    MOCK_CLIENT
+    MOCK_DATABASE
+    MOCK_COLLECTION
+    MOCK_CURSOR
+    MOCK_BULK
+
+    int fake_client_storage = 0;
+    auto fake_client = reinterpret_cast<::mongoc_client_t*>(&fake_client_storage);
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) { return fake_client; })
+        .forever();
+    client_pool_pop->interpose([&](::mongoc_client_pool_t*) { return fake_client; }).forever();
+    cursor_destroy->interpose([](mongoc_cursor_t*) {}).forever();
+    collection_destroy->interpose([](mongoc_collection_t*) {}).forever();
+
+    auto executor = std::make_shared<manual_executor>();
+    options::pool pool_opts;
+    pool_opts.executor(executor);
+    pool p{uri{}, pool_opts};
+
+    async_collection coll{p, "coroutine", "coll"};
+
+    SECTION("co_find_one") {
+        // Any pointer other than null will do, since every cursor function it reaches is mocked.
+        int placeholder;
+        auto cursor_t = reinterpret_cast<mongoc_cursor_t*>(&placeholder);
+        collection_find_with_opts
+            ->interpose([&](mongoc_collection_t*,
+                            const bson_t*,
+                            const bson_t*,
+                            const mongoc_read_prefs_t*) { return cursor_t; })
+            .forever();
+
+        auto found = make_document(kvp("x", 1));
+        bson_t found_bson;
+        bson_init_static(&found_bson, found.view().data(), found.view().length());
+
+        bool fail = false;
+        auto cursor_next = libmongoc::cursor_next.create_instance();
+        cursor_next
+            ->interpose([&](mongoc_cursor_t*, const bson_t** out) {
+                if (fail) {
+                    return false;
+                }
+                *out = &found_bson;
+                return true;
+            })
+            .forever();
+        auto cursor_error_document = libmongoc::cursor_error_document.create_instance();
+        cursor_error_document
+            ->interpose([&](mongoc_cursor_t*, bson_error_t* error, const bson_t** doc) {
+                if (!fail) {
+                    return false;
+                }
+                bson_set_error(error, MONGOC_ERROR_SERVER, 2, "bad query");
+                *doc = nullptr;
+                return true;
+            })
+            .forever();
+
+        outcome<bsoncxx::stdx::optional<bsoncxx::document::value>> out;
+
+        SECTION("yields the document found") {
+            await_into(co_find_one(coll, make_document(kvp("x", 1))), out);
+
+            // The coroutine is suspended until a worker has run the operation.
+            REQUIRE(!out.done);
+            executor->run();
+
+            REQUIRE(out.done);
+            REQUIRE(!out.error);
+            REQUIRE(*out.result);
+            REQUIRE((*out.result)->view()["x"].get_int32() == 1);
+        }
+
+        SECTION("rethrows the error of the query") {
+            fail = true;
+            await_into(co_find_one(coll, make_document(kvp("x", 1))), out);
+            executor->run();
+
+            REQUIRE(out.done);
+            REQUIRE(!out.result);
+            REQUIRE(holds<query_exception>(out.error));
+        }
+    }
+
+    SECTION("co_insert_one and co_bulk_write") {
+        bulk_operation_insert_with_opts
+            ->interpose([](mongoc_bulk_operation_t*, const bson_t*, const bson_t*, bson_error_t*) {
+                return true;
+            })
+            .forever();
+        bulk_operation_destroy->interpose([](mongoc_bulk_operation_t*) {}).forever();
+        collection_create_bulk_operation_with_opts
+            ->interpose([](mongoc_collection_t*, const bson_t*) -> mongoc_bulk_operation_t* {
+                return nullptr;
+            })
+            .forever();
+
+        bool fail = false;
+        auto reply = make_document(kvp("nInserted", 1));
+        libbson::scoped_bson_t reply_bson{reply.view()};
+        bulk_operation_execute
+            ->interpose([&](mongoc_bulk_operation_t*, bson_t* out, bson_error_t* error) {
+                if (fail) {
+                    bson_init(out);
+                    bson_set_error(error, MONGOC_ERROR_COMMAND, 2, "bad write");
+                    return 0;
+                }
+                bson_copy_to(reply_bson.bson(), out);
+                return 1;
+            })
+            .forever();
+
+        SECTION("co_insert_one yields the result of the insert") {
+            outcome<bsoncxx::stdx::optional<result::insert_one>> out;
+            await_into(co_insert_one(coll, make_document(kvp("_id", 1))), out);
+
+            REQUIRE(!out.done);
+            executor->run();
+
+            REQUIRE(out.done);
+            REQUIRE(!out.error);
+            REQUIRE(*out.result);
+            REQUIRE((*out.result)->result().inserted_count() == 1);
+            REQUIRE((*out.result)->inserted_id().get_int32() == 1);
+        }
+
+        SECTION("co_insert_one rethrows the error of the insert") {
+            fail = true;
+            outcome<bsoncxx::stdx::optional<result::insert_one>> out;
+            await_into(co_insert_one(coll, make_document(kvp("_id", 1))), out);
+            executor->run();
+
+            REQUIRE(out.done);
+            REQUIRE(holds<bulk_write_exception>(out.error));
+        }
+
+        std::vector<model::write> writes;
+        writes.emplace_back(model::insert_one{make_document(kvp("_id", 2))});
+
+        SECTION("co_bulk_write yields the result of the writes") {
+            outcome<bsoncxx::stdx::optional<result::bulk_write>> out;
+            await_into(co_bulk_write(coll, std::move(writes)), out);
+
+            REQUIRE(!out.done);
+            executor->run();
+
+            REQUIRE(out.done);
+            REQUIRE(!out.error);
+            REQUIRE(*out.result);
+            REQUIRE((*out.result)->inserted_count() == 1);
+        }
+
+        SECTION("co_bulk_write rethrows the error of the writes") {
+            fail = true;
+            outcome<bsoncxx::stdx::optional<result::bulk_write>> out;
+            await_into(co_bulk_write(coll, std::move(writes)), out);
+            executor->run();
+
+            REQUIRE(out.done);
+            REQUIRE(holds<bulk_write_exception>(out.error));
+        }
+    }
+}
+}  // namespace
@@ -318,6 +318,25 @@ TEST_CASE("A database", "[database]") {
         REQUIRE(called);
         REQUIRE(response.view()["foo"].get_int32() == 5);
     }
+
+    SECTION("run_command passes no options without a session") {
+        bool opts_passed = true;
+
+        database_command_with_opts->interpose([&](mongoc_database_t*,
+                                                  const bson_t*,
+                                                  const mongoc_read_prefs_t*,
+                                                  const bson_t* opts,
+                                                  bson_t* reply,
+                                                  bson_error_t*) {
+            opts_passed = opts != nullptr;
+            ::bson_init(reply);
+            return true;
+        });
+
+        database database = mongo_client[database_name];
+        database.run_command(make_document(kvp("ping", 1)));
+        REQUIRE(!opts_passed);
+    }
 }
 
 TEST_CASE("Database integration tests", "[database]") {
@@ -494,6 +513,31 @@ TEST_CASE("Database integration tests", "[database]") {
 
         REQUIRE(expected_colls.size() == 0);
     }
+
+    SECTION("list_collection_names_cursor streams the collection names") {
+        class database db = mongo_client["list_collection_names_cursor"];
+        db.drop();
+
+        std::set<std::string> expected_colls;
+        for (std::size_t i = 0; i < 10; ++i) {
+            std::string coll_str = "list_collection_names_cursor_coll" + std::to_string(i);
+            db.create_collection(coll_str);
+            expected_colls.insert(coll_str);
+        }
+
+        auto names = db.list_collection_names_cursor();
+        for (auto name : names) {
+            REQUIRE(expected_colls.erase(name.to_string()) == 1);
+        }
+        REQUIRE(expected_colls.size() == 0);
+
+        auto filtered = db.list_collection_names_cursor(
+            make_document(kvp("name", "list_collection_names_cursor_coll3")), true);
+        auto it = filtered.begin();
+        REQUIRE(it != filtered.end());
+        REQUIRE(*it == stdx::string_view{"list_collection_names_cursor_coll3"});
+        REQUIRE(++it == filtered.end());
+    }
 }
 
 }  // namespace
@@ -0,0 +1,80 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/string/to_string.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/database_pool.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/read_preference.hpp>
+#include <mongocxx/uri.hpp>
+#include <mongocxx/write_concern.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("database_pool shares the clients of a pool", "[database_pool]") {
+    instance::current();
+
+    pool p{uri{"mongodb://localhost/?maxPoolSize=2"}};
+    database_pool tenant_a{p, "database_pool_a"};
+    database_pool tenant_b{p, "database_pool_b"};
+
+    SECTION("entries are handles on their own database") {
+        REQUIRE(tenant_a.name() == stdx::string_view{"database_pool_a"});
+
+        auto a = tenant_a.acquire();
+        auto b = tenant_b.acquire();
+        REQUIRE(a->name() == stdx::string_view{"database_pool_a"});
+        REQUIRE(b->name() == stdx::string_view{"database_pool_b"});
+
+        a->drop();
+        (*a)["tenant"].insert_one(make_document(kvp("x", 1)));
+        REQUIRE((*a)["tenant"].count_documents({}) == 1);
+        REQUIRE(a.client()["database_pool_a"]["tenant"].count_documents({}) == 1);
+        a->drop();
+    }
+
+    SECTION("entries hold clients of the shared pool") {
+        auto a = tenant_a.acquire();
+        auto b = tenant_b.acquire();
+        REQUIRE(!tenant_a.try_acquire());
+        REQUIRE(!p.try_acquire());
+    }
+
+    SECTION("settings apply to the database handles") {
+        write_concern wc;
+        wc.acknowledge_level(write_concern::level::k_majority);
+        tenant_a.read_preference(read_preference{}.mode(read_preference::read_mode::k_nearest))
+            .write_concern(wc);
+
+        auto a = tenant_a.acquire(std::chrono::milliseconds{1000});
+        REQUIRE(a->read_preference().mode() == read_preference::read_mode::k_nearest);
+        REQUIRE(a->write_concern().acknowledge_level() == write_concern::level::k_majority);
+
+        auto b = tenant_b.acquire();
+        REQUIRE(b->read_preference().mode() == read_preference::read_mode::k_primary);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,148 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/executor.hpp>
+#include <mongocxx/private/executor.hh>
+#include <mongocxx/work_stealing_executor.hpp>
+
+namespace {
+using namespace mongocxx;
+
+// An executor that queues tasks until run() is called, to control when they start.
+class manual_executor : public executor {
+   public:
+    void submit(std::function<void()> task) override {
+        tasks.push_back(std::move(task));
+    }
+
+    std::size_t concurrency() const override {
+        return 4;
+    }
+
+    void run() {
+        for (auto&& task : tasks) {
+            task();
+        }
+        tasks.clear();
+    }
+
+    std::vector<std::function<void()>> tasks;
+};
+
+TEST_CASE("work_stealing_executor runs every task, including those submitted by tasks",
+          "[executor]") {
+    std::atomic<int> runs{0};
+    {
+        work_stealing_executor executor{3};
+        REQUIRE(executor.concurrency() == 3);
+
+        for (int i = 0; i < 100; i++) {
+            executor.submit([&] {
+                runs++;
+                executor.submit([&] { runs++; });
+            });
+        }
+    }
+    REQUIRE(runs.load() == 200);
+}
+
+TEST_CASE("run_parallel runs each call once", "[executor]") {
+    work_stealing_executor executor{2};
+
+    std::vector<std::atomic<int>> calls(50);
+    for (auto&& count : calls) {
+        count.store(0);
+    }
+    run_parallel(executor, calls.size(), 8, [&](std::size_t i) { calls[i]++; });
+    for (auto&& count : calls) {
+        REQUIRE(count.load() == 1);
+    }
+}
+
+TEST_CASE("run_parallel completes on the calling thread if no task of the executor starts",
+          "[executor]") {
+    manual_executor executor;
+
+    std::size_t calls = 0;
+    run_parallel(executor, 10, 4, [&](std::size_t) { calls++; });
+    REQUIRE(calls == 10);
+
+    // Tasks starting late find nothing left to do.
+    REQUIRE(executor.tasks.size() == 3);
+    executor.run();
+    REQUIRE(calls == 10);
+}
+
+TEST_CASE("run_parallel nested within the tasks of a busy executor does not deadlock",
+          "[executor]") {
+    work_stealing_executor executor{2};
+
+    std::atomic<int> calls{0};
+    run_parallel(executor, 4, 4, [&](std::size_t) {
+        run_parallel(executor, 4, 4, [&](std::size_t) { calls++; });
+    });
+    REQUIRE(calls.load() == 16);
+}
+
+TEST_CASE("submitted_task is run by its waiter if the executor has not started it",
+          "[executor]") {
+    manual_executor executor;
+
+    bool ran = false;
+    auto task = submitted_task::submit(executor, [&] { ran = true; });
+    REQUIRE(!ran);
+    task->wait();
+    REQUIRE(ran);
+
+    // The executor's copy does not run it again.
+    ran = false;
+    executor.run();
+    REQUIRE(!ran);
+
+    auto failing = submitted_task::submit(executor, [] { throw std::runtime_error{"failed"}; });
+    REQUIRE_THROWS_AS(failing->wait(), std::runtime_error);
+}
+
+TEST_CASE("submitted_task::try_run runs a task only if no thread has started it", "[executor]") {
+    manual_executor executor;
+
+    int runs = 0;
+    auto task = submitted_task::submit(executor, [&] { runs++; });
+    REQUIRE(task->try_run());
+    REQUIRE(runs == 1);
+    REQUIRE(!task->try_run());
+    executor.run();
+    REQUIRE(runs == 1);
+
+    auto started = submitted_task::submit(executor, [&] { runs++; });
+    executor.run();
+    REQUIRE(!started->try_run());
+    REQUIRE(runs == 2);
+
+    // The exception is left for wait().
+    auto failing = submitted_task::submit(executor, [] { throw std::runtime_error{"failed"}; });
+    REQUIRE(failing->try_run());
+    REQUIRE_THROWS_AS(failing->wait(), std::runtime_error);
+}
+
+}  // namespace
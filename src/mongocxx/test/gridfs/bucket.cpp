@@ -13,12 +13,16 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <ios>
+#include <iterator>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include <bsoncxx/builder/basic/document.hpp>
@@ -34,9 +38,16 @@
 #include <mongocxx/exception/logic_error.hpp>
 #include <mongocxx/gridfs/bucket.hpp>
 #include <mongocxx/instance.hpp>
+#include <mongocxx/options/apm.hpp>
+#include <mongocxx/options/client.hpp>
 #include <mongocxx/options/find.hpp>
+#include <mongocxx/options/gridfs/download.hpp>
 #include <mongocxx/options/gridfs/upload.hpp>
 #include <mongocxx/options/index.hpp>
+#include <mongocxx/options/pool.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/zstd_codec.hh>
+#include <mongocxx/result/gridfs/delete_files.hpp>
 #include <mongocxx/stdx.hpp>
 #include <mongocxx/uri.hpp>
 
@@ -339,6 +350,78 @@ TEST_CASE("uploading throws error when options are invalid", "[gridfs::bucket]")
         upload_options.chunk_size_bytes(-1);
         run_test();
     }
+
+    SECTION("zero max batch bytes") {
+        upload_options.max_batch_bytes(0);
+        run_test();
+    }
+
+    SECTION("negative max batch bytes") {
+        upload_options.max_batch_bytes(-1);
+        run_test();
+    }
+}
+
+TEST_CASE("gridfs upload with batches smaller than a chunk", "[gridfs::bucket]") {
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_upload_small_batches"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    std::vector<std::uint8_t> bytes(100);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i);
+    }
+
+    // Each chunk is sent on its own, since a batch always holds at least one chunk.
+    auto uploader = bucket.open_upload_stream(
+        "small_batches", options::gridfs::upload{}.chunk_size_bytes(10).max_batch_bytes(1));
+    uploader.write(bytes.data(), bytes.size());
+    auto result = uploader.close();
+
+    validate_gridfs_file(db, "fs", result.id(), "small_batches", bytes, 10);
+}
+
+TEST_CASE("gridfs buckets of a pool check their indexes once", "[gridfs::bucket]") {
+    instance::current();
+
+    std::atomic<int> index_checks{0};
+    options::apm apm_opts;
+    apm_opts.on_command_started([&](const events::command_started_event& event) {
+        auto command = event.command();
+        if (event.command_name() == stdx::string_view{"find"} &&
+            command["find"].get_utf8().value == stdx::string_view{"fs.files"} &&
+            command["limit"]) {
+            index_checks++;
+        }
+    });
+    pool p{uri{}, options::pool{options::client{}.apm_opts(apm_opts)}};
+
+    {
+        auto client = p.acquire();
+        (*client)["gridfs_index_cache"].drop();
+    }
+
+    std::uint8_t bytes[] = {1, 2, 3};
+    for (int i = 0; i < 3; ++i) {
+        // As a service handling a request would, make a bucket for every upload.
+        auto client = p.acquire();
+        auto bucket = (*client)["gridfs_index_cache"].gridfs_bucket();
+        auto uploader = bucket.open_upload_stream("file");
+        uploader.write(bytes, sizeof(bytes));
+        uploader.close();
+    }
+
+    REQUIRE(index_checks.load() == 1);
+
+    auto client = p.acquire();
+    auto indexes = (*client)["gridfs_index_cache"]["fs.chunks"].list_indexes();
+    REQUIRE(std::distance(indexes.begin(), indexes.end()) == 2);
+    (*client)["gridfs_index_cache"].drop();
 }
 
 TEST_CASE("downloading throws error when files document is corrupt", "[gridfs::bucket]") {
@@ -529,6 +612,7 @@ TEST_CASE("mongocxx::gridfs::downloader::read with arbitrary sizes", "[gridfs::d
     std::int64_t file_length = 100;
     std::int32_t chunk_size = 9;
     std::int32_t read_size = 0;
+    options::gridfs::download download_options;
 
     auto run_test = [&]() {
         REQUIRE(read_size != 0);
@@ -542,7 +626,8 @@ TEST_CASE("mongocxx::gridfs::downloader::read with arbitrary sizes", "[gridfs::d
         buffer.reserve(static_cast<std::size_t>(read_size));
 
         std::size_t total_bytes_read = 0;
-        auto downloader = bucket.open_download_stream(bsoncxx::types::value{id});
+        auto downloader =
+            bucket.open_download_stream(bsoncxx::types::value{id}, download_options);
 
         while (std::size_t bytes_read =
                    downloader.read(buffer.data(), static_cast<std::size_t>(read_size))) {
@@ -593,6 +678,205 @@ TEST_CASE("mongocxx::gridfs::downloader::read with arbitrary sizes", "[gridfs::d
         read_size = static_cast<std::int32_t>(file_length + 1);
         run_test();
     }
+
+    SECTION("chunks read ahead in small batches") {
+        download_options.batch_size(2).prefetch_batches(3);
+        read_size = chunk_size + 1;
+        run_test();
+    }
+}
+
+TEST_CASE("mongocxx::gridfs::downloader::next_chunk returns views of the chunks",
+          "[gridfs::downloader]") {
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_download_next_chunk_test"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].delete_many({});
+    db["fs.chunks"].delete_many({});
+
+    std::int64_t file_length = 100;
+    std::int32_t chunk_size = 9;
+
+    bsoncxx::types::value id{bsoncxx::types::b_oid{bsoncxx::oid{}}};
+    std::vector<std::uint8_t> expected = manual_gridfs_initialize(db, file_length, chunk_size, id);
+
+    auto downloader = bucket.open_download_stream(id);
+    std::vector<std::uint8_t> actual;
+
+    SECTION("whole chunks") {
+        for (auto chunk = downloader.next_chunk(); chunk.size; chunk = downloader.next_chunk()) {
+            REQUIRE(chunk.size == std::min(static_cast<std::size_t>(chunk_size),
+                                           expected.size() - actual.size()));
+            actual.insert(actual.end(), chunk.bytes, chunk.bytes + chunk.size);
+        }
+    }
+
+    SECTION("mixed with read") {
+        std::uint8_t buffer[4];
+        REQUIRE(downloader.read(buffer, sizeof(buffer)) == sizeof(buffer));
+        actual.insert(actual.end(), buffer, buffer + sizeof(buffer));
+
+        auto rest = downloader.next_chunk();
+        REQUIRE(rest.size == static_cast<std::size_t>(chunk_size) - sizeof(buffer));
+        actual.insert(actual.end(), rest.bytes, rest.bytes + rest.size);
+
+        while (std::size_t bytes_read = downloader.read(buffer, sizeof(buffer))) {
+            actual.insert(actual.end(), buffer, buffer + bytes_read);
+        }
+    }
+
+    REQUIRE(actual == expected);
+    REQUIRE(downloader.next_chunk().size == 0);
+
+    downloader.close();
+    REQUIRE_THROWS_AS(downloader.next_chunk(), logic_error);
+}
+
+TEST_CASE("gridfs ranged downloads and seeking", "[gridfs::bucket] [gridfs::downloader]") {
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_download_range_test"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].delete_many({});
+    db["fs.chunks"].delete_many({});
+
+    std::int64_t file_length = 100;
+    std::int32_t chunk_size = 9;
+
+    bsoncxx::types::value id{bsoncxx::types::b_oid{bsoncxx::oid{}}};
+    std::vector<std::uint8_t> expected = manual_gridfs_initialize(db, file_length, chunk_size, id);
+
+    auto read_all = [](gridfs::downloader& downloader) {
+        std::vector<std::uint8_t> bytes;
+        std::uint8_t buffer[7];
+        while (std::size_t bytes_read = downloader.read(buffer, sizeof(buffer))) {
+            bytes.insert(bytes.end(), buffer, buffer + bytes_read);
+        }
+        return bytes;
+    };
+
+    auto range = [&](std::size_t start, std::size_t end) {
+        return std::vector<std::uint8_t>{expected.begin() + static_cast<std::ptrdiff_t>(start),
+                                         expected.begin() + static_cast<std::ptrdiff_t>(end)};
+    };
+
+    SECTION("a range spanning several chunks") {
+        auto downloader = bucket.open_download_stream(id, 13, 58);
+        REQUIRE(read_all(downloader) == range(13, 58));
+    }
+
+    SECTION("a range within a single chunk") {
+        auto downloader = bucket.open_download_stream(id, 20, 25);
+        REQUIRE(read_all(downloader) == range(20, 25));
+    }
+
+    SECTION("a range ending with the file") {
+        auto downloader = bucket.open_download_stream(id, 95, 100);
+        REQUIRE(read_all(downloader) == range(95, 100));
+    }
+
+    SECTION("an empty range") {
+        auto downloader = bucket.open_download_stream(id, 40, 40);
+        REQUIRE(read_all(downloader).empty());
+    }
+
+    SECTION("seeking forwards and backwards") {
+        auto downloader = bucket.open_download_stream(id);
+
+        std::uint8_t buffer[3];
+        REQUIRE(downloader.read(buffer, sizeof(buffer)) == sizeof(buffer));
+
+        // Within the current chunk.
+        downloader.seek(7);
+        REQUIRE(downloader.read(buffer, sizeof(buffer)) == sizeof(buffer));
+        REQUIRE(std::vector<std::uint8_t>(buffer, buffer + sizeof(buffer)) == range(7, 10));
+
+        downloader.seek(60);
+        REQUIRE(read_all(downloader) == range(60, 100));
+
+        downloader.seek(0);
+        REQUIRE(read_all(downloader) == expected);
+    }
+
+    SECTION("offsets outside of the file are rejected") {
+        REQUIRE_THROWS_AS(bucket.open_download_stream(id, -1, 10), logic_error);
+        REQUIRE_THROWS_AS(bucket.open_download_stream(id, 10, 101), logic_error);
+        REQUIRE_THROWS_AS(bucket.open_download_stream(id, 20, 10), logic_error);
+
+        auto downloader = bucket.open_download_stream(id, 0, 50);
+        REQUIRE_THROWS_AS(downloader.seek(51), logic_error);
+        REQUIRE_THROWS_AS(downloader.seek(-1), logic_error);
+    }
+}
+
+TEST_CASE("gridfs::bucket::download_to_buffer_parallel works", "[gridfs::bucket]") {
+    instance::current();
+
+    pool pool{uri{}};
+    auto client = pool.acquire();
+    database db = (*client)["gridfs_download_to_buffer_parallel"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].delete_many({});
+    db["fs.chunks"].delete_many({});
+
+    std::int64_t file_length = 1000;
+    std::int32_t chunk_size = 9;
+
+    bsoncxx::types::value id{bsoncxx::types::b_oid{bsoncxx::oid{}}};
+    std::vector<std::uint8_t> expected = manual_gridfs_initialize(db, file_length, chunk_size, id);
+
+    std::vector<std::uint8_t> buffer(static_cast<std::size_t>(file_length));
+
+    SECTION("over several connections") {
+        REQUIRE(bucket.download_to_buffer_parallel(id, buffer.data(), buffer.size(), 4, pool) ==
+                file_length);
+        REQUIRE(buffer == expected);
+    }
+
+    SECTION("over more connections than chunks") {
+        REQUIRE(bucket.download_to_buffer_parallel(id, buffer.data(), buffer.size(), 500, pool) ==
+                file_length);
+        REQUIRE(buffer == expected);
+    }
+
+    SECTION("with invalid arguments") {
+        REQUIRE_THROWS_AS(
+            bucket.download_to_buffer_parallel(id, buffer.data(), buffer.size() - 1, 4, pool),
+            logic_error);
+        REQUIRE_THROWS_AS(
+            bucket.download_to_buffer_parallel(id, buffer.data(), buffer.size(), 0, pool),
+            logic_error);
+    }
+}
+
+TEST_CASE("downloading throws error when options are invalid", "[gridfs::bucket]") {
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_download_error_invalid_options"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    bsoncxx::types::value id{bsoncxx::types::b_oid{bsoncxx::oid{}}};
+    options::gridfs::download download_options;
+
+    SECTION("zero batch size") {
+        download_options.batch_size(0);
+    }
+
+    SECTION("negative prefetch batches") {
+        download_options.prefetch_batches(-1);
+    }
+
+    REQUIRE_THROWS_AS(bucket.open_download_stream(id, download_options), logic_error);
+
+    std::ostringstream os;
+    REQUIRE_THROWS_AS(bucket.download_to_stream(id, &os, download_options), logic_error);
 }
 
 TEST_CASE("mongocxx::gridfs::uploader::abort works", "[gridfs::uploader]") {
@@ -868,6 +1152,49 @@ TEST_CASE("gridfs::bucket::download_to_stream works", "[gridfs::bucket]") {
     REQUIRE(expected_bytes == actual_bytes);
 }
 
+TEST_CASE("gridfs::bucket::upload_from_file and download_to_file work", "[gridfs::bucket]") {
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_file_round_trip"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    const std::string source_path = "gridfs_upload_from_file.bin";
+    const std::string destination_path = "gridfs_download_to_file.bin";
+
+    std::vector<std::uint8_t> bytes(1000);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i % 251);
+    }
+
+    {
+        std::ofstream out{source_path, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+    }
+
+    auto result = bucket.upload_from_file(
+        "file_round_trip", source_path, options::gridfs::upload{}.chunk_size_bytes(100));
+    validate_gridfs_file(db, "fs", result.id(), "file_round_trip", bytes, 100);
+
+    bucket.download_to_file(result.id(), destination_path);
+
+    std::ifstream in{destination_path, std::ios::binary};
+    std::vector<std::uint8_t> downloaded{std::istreambuf_iterator<char>{in},
+                                         std::istreambuf_iterator<char>{}};
+    REQUIRE(downloaded == bytes);
+
+    REQUIRE_THROWS_AS(bucket.upload_from_file("missing", "file_that_does_not_exist.bin"),
+                      std::ios_base::failure);
+
+    in.close();
+    std::remove(source_path.c_str());
+    std::remove(destination_path.c_str());
+}
+
 TEST_CASE("gridfs::bucket::delete_file works", "[gridfs::bucket]") {
     instance::current();
 
@@ -889,6 +1216,43 @@ TEST_CASE("gridfs::bucket::delete_file works", "[gridfs::bucket]") {
     REQUIRE(!db["fs.chunks"].find_one({}));
 }
 
+TEST_CASE("gridfs::bucket::delete_files works", "[gridfs::bucket]") {
+    instance::current();
+
+    pool pool{uri{}};
+    auto client = pool.acquire();
+    database db = (*client)["gridfs_delete_files_works"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    // Each file of 10 bytes in chunks of 4 bytes has 3 chunks.
+    std::vector<bsoncxx::types::value> ids;
+    for (int i = 0; i < 7; ++i) {
+        ids.emplace_back(bsoncxx::types::b_oid{bsoncxx::oid{}});
+        manual_gridfs_initialize(db, 10, 4, ids.back());
+    }
+    // Ids which do not name a file are ignored.
+    ids.emplace_back(bsoncxx::types::b_oid{bsoncxx::oid{}});
+
+    SECTION("sequentially") {
+        REQUIRE(bucket.delete_files(ids, 3) == result::gridfs::delete_files{7, 21});
+    }
+
+    SECTION("in parallel") {
+        REQUIRE(bucket.delete_files(ids, 2, pool, 2) == result::gridfs::delete_files{7, 21});
+    }
+
+    REQUIRE(!db["fs.files"].find_one({}));
+    REQUIRE(!db["fs.chunks"].find_one({}));
+
+    REQUIRE(bucket.delete_files(ids) == result::gridfs::delete_files{0, 0});
+    REQUIRE(bucket.delete_files({}, 4, pool) == result::gridfs::delete_files{0, 0});
+    REQUIRE_THROWS_AS(bucket.delete_files(ids, 0), logic_error);
+    REQUIRE_THROWS_AS(bucket.delete_files(ids, 0, pool), logic_error);
+}
+
 TEST_CASE("gridfs::bucket::find works", "[gridfs::bucket]") {
     instance::current();
 
@@ -986,6 +1350,272 @@ TEST_CASE("gridfs upload large file", "[gridfs::bucket]") {
         length);
 }
 
+TEST_CASE("gridfs upload with parallel chunk inserts", "[gridfs::bucket]") {
+    instance::current();
+
+    pool pool{uri{}};
+    auto client = pool.acquire();
+    database db = (*client)["gridfs_upload_parallel"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    // Chunks are flushed in batches of three, so this file is inserted as three batches.
+    constexpr std::int32_t chunk_size = 5 * 1000 * 1000;
+    constexpr std::int64_t length = 8 * static_cast<std::int64_t>(chunk_size) + 1;
+
+    auto uploader = bucket.open_upload_stream(
+        "parallel_file",
+        options::gridfs::upload{}.chunk_size_bytes(chunk_size).parallelism(2, pool));
+
+    std::vector<std::uint8_t> bytes;
+    for (std::int64_t i = 0; i * chunk_size < length; ++i) {
+        auto current_chunk_size = static_cast<std::size_t>(
+            std::min(static_cast<std::int64_t>(chunk_size), length - i * chunk_size));
+        bytes.assign(current_chunk_size, static_cast<std::uint8_t>(i));
+
+        uploader.write(bytes.data(), current_chunk_size);
+    }
+
+    auto result = uploader.close();
+
+    validate_gridfs_file(
+        db,
+        "fs",
+        result.id(),
+        "parallel_file",
+        [&](const bsoncxx::types::b_binary& data, std::size_t i) {
+            INFO("chunk_number: " << i);
+            REQUIRE(std::all_of(data.bytes, data.bytes + data.size, [i](std::uint8_t byte) {
+                return byte == static_cast<std::uint8_t>(i);
+            }));
+        },
+        chunk_size,
+        length);
+}
+
+TEST_CASE("gridfs parallel uploads cannot use a session", "[gridfs::bucket]") {
+    instance::current();
+
+    pool pool{uri{}};
+    auto client = pool.acquire();
+    gridfs::bucket bucket = (*client)["gridfs_upload_parallel"].gridfs_bucket();
+    auto session = client->start_session();
+
+    REQUIRE_THROWS_AS(
+        bucket.open_upload_stream(session, "file", options::gridfs::upload{}.parallelism(2, pool)),
+        logic_error);
+}
+
+TEST_CASE("gridfs upload with a checksum", "[gridfs::bucket]") {
+    using checksum_algorithm = options::gridfs::upload::checksum_algorithm;
+
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_upload_checksum"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    // Written in pieces that straddle the chunk boundaries, to check that the checksum follows the
+    // bytes rather than the chunks.
+    auto upload = [&](checksum_algorithm algorithm) -> bsoncxx::document::value {
+        const std::string contents = "123456789";
+        auto uploader = bucket.open_upload_stream(
+            "checksum_file", options::gridfs::upload{}.chunk_size_bytes(4).checksum(algorithm));
+        auto bytes = reinterpret_cast<const std::uint8_t*>(contents.data());
+        uploader.write(bytes, 3);
+        uploader.write(bytes + 3, 6);
+
+        auto files_doc = db["fs.files"].find_one(make_document(kvp("_id", uploader.close().id())));
+        REQUIRE(files_doc);
+        return *files_doc;
+    };
+
+    SECTION("sha256") {
+        auto files_doc = upload(checksum_algorithm::k_sha256);
+        REQUIRE(files_doc.view()["sha256"].get_utf8().value ==
+                stdx::string_view{
+                    "15e2b0d3c33891ebb0f1ef609ec419420c20e320ce94c65fbc8c3312448eb225"});
+        REQUIRE(!files_doc.view()["crc32c"]);
+    }
+
+    SECTION("crc32c") {
+        auto files_doc = upload(checksum_algorithm::k_crc32c);
+        REQUIRE(files_doc.view()["crc32c"].get_utf8().value == stdx::string_view{"e3069283"});
+        REQUIRE(!files_doc.view()["sha256"]);
+    }
+}
+
+TEST_CASE("gridfs upload with compression", "[gridfs::bucket]") {
+    using compression_algorithm = options::gridfs::upload::compression_algorithm;
+
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_upload_compression"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    if (!zstd_codec::supported()) {
+        REQUIRE_THROWS_AS(bucket.open_upload_stream(
+                              "compressed_file",
+                              options::gridfs::upload{}.compression(compression_algorithm::k_zstd)),
+                          logic_error);
+        return;
+    }
+
+    REQUIRE_THROWS_AS(
+        bucket.open_upload_stream(
+            "compressed_file",
+            options::gridfs::upload{}.compression(compression_algorithm::k_zstd, 1000)),
+        logic_error);
+
+    // Repetitive contents over three and a half chunks, so that every chunk compresses well and
+    // the last one is short.
+    std::vector<std::uint8_t> contents(3 * 1024 + 512);
+    for (std::size_t i = 0; i < contents.size(); i++) {
+        contents[i] = static_cast<std::uint8_t>('a' + i % 7);
+    }
+
+    options::gridfs::upload upload_options;
+    upload_options.chunk_size_bytes(1024).compression(compression_algorithm::k_zstd);
+    auto uploader = bucket.open_upload_stream("compressed_file", upload_options);
+    uploader.write(contents.data(), contents.size());
+    auto id = uploader.close().id();
+
+    auto files_doc = db["fs.files"].find_one(make_document(kvp("_id", id)));
+    REQUIRE(files_doc);
+    REQUIRE(files_doc->view()["length"].get_int64().value ==
+            static_cast<std::int64_t>(contents.size()));
+    auto compression = files_doc->view()["compression"];
+    REQUIRE(compression["codec"].get_utf8().value == stdx::string_view{"zstd"});
+    REQUIRE(compression["level"].get_int32().value == 3);
+
+    std::int64_t stored = 0;
+    for (auto&& chunk : db["fs.chunks"].find(make_document(kvp("files_id", id)))) {
+        auto size = chunk["data"].get_binary().size;
+        REQUIRE(size < 1024 / 4);
+        stored += size;
+    }
+    REQUIRE(compression["compressedLength"].get_int64().value == stored);
+
+    SECTION("the whole file is decompressed") {
+        std::vector<std::uint8_t> downloaded(contents.size());
+        auto downloader = bucket.open_download_stream(id);
+        std::size_t offset = 0;
+        while (auto length_read =
+                   downloader.read(downloaded.data() + offset, downloaded.size() - offset)) {
+            offset += length_read;
+        }
+        REQUIRE(offset == contents.size());
+        REQUIRE(downloaded == contents);
+    }
+
+    SECTION("a range is decompressed") {
+        std::vector<std::uint8_t> downloaded(1500);
+        auto downloader = bucket.open_download_stream(id, 1000, 2500);
+        std::size_t offset = 0;
+        while (auto length_read =
+                   downloader.read(downloaded.data() + offset, downloaded.size() - offset)) {
+            offset += length_read;
+        }
+        REQUIRE(offset == downloaded.size());
+        REQUIRE(std::equal(downloaded.begin(), downloaded.end(), contents.begin() + 1000));
+    }
+
+    SECTION("an unknown codec is reported as corruption") {
+        db["fs.files"].update_one(
+            make_document(kvp("_id", id)),
+            make_document(kvp("$set", make_document(kvp("compression.codec", "lz4")))));
+        REQUIRE_THROWS_AS(bucket.open_download_stream(id), gridfs_exception);
+    }
+}
+
+TEST_CASE("gridfs upload with deduplicated chunks", "[gridfs::bucket]") {
+    instance::current();
+
+    client client{uri{}};
+    database db = client["gridfs_upload_deduplicated"];
+    gridfs::bucket bucket = db.gridfs_bucket();
+
+    db["fs.files"].drop();
+    db["fs.chunks"].drop();
+
+    auto upload = [&](const std::string& contents, bool compressed = false) {
+        options::gridfs::upload upload_options;
+        upload_options.chunk_size_bytes(4).deduplicate_chunks(true);
+        if (compressed) {
+            upload_options.compression(options::gridfs::upload::compression_algorithm::k_zstd);
+        }
+        auto uploader = bucket.open_upload_stream("versioned_file", upload_options);
+        uploader.write(reinterpret_cast<const std::uint8_t*>(contents.data()), contents.size());
+        return uploader.close().id();
+    };
+
+    auto download = [&](bsoncxx::types::value id, std::int64_t start, std::int64_t end) {
+        auto downloader = bucket.open_download_stream(id, start, end);
+        std::string contents(static_cast<std::size_t>(end - start), '\0');
+        std::size_t offset = 0;
+        while (auto length_read = downloader.read(
+                   reinterpret_cast<std::uint8_t*>(&contents[offset]), contents.size() - offset)) {
+            offset += length_read;
+        }
+        REQUIRE(offset == contents.size());
+        return contents;
+    };
+
+    // The second version repeats the first two chunks of the first, which itself repeats one.
+    auto first = upload("aaaabbbbaaaacc");
+    auto second = upload("aaaabbbbdddd");
+
+    // Only the four distinct chunks are stored, none of them under the id of a file.
+    REQUIRE(db["fs.chunks"].count_documents({}) == 4);
+    REQUIRE(db["fs.chunks"].count_documents(make_document(kvp("files_id", first))) == 0);
+
+    auto files_doc = db["fs.files"].find_one(make_document(kvp("_id", first)));
+    REQUIRE(files_doc);
+    auto manifest = files_doc->view()["chunkManifest"].get_array().value;
+    REQUIRE(std::distance(manifest.begin(), manifest.end()) == 4);
+    REQUIRE(manifest[0].get_utf8().value == manifest[2].get_utf8().value);
+
+    REQUIRE(download(first, 0, 14) == "aaaabbbbaaaacc");
+    REQUIRE(download(second, 0, 12) == "aaaabbbbdddd");
+    REQUIRE(download(first, 6, 13) == "bbaaaac");
+
+    SECTION("a missing shared chunk is reported as corruption") {
+        db["fs.chunks"].delete_one(
+            make_document(kvp("files_id.sha256", manifest[3].get_utf8().value)));
+
+        auto downloader = bucket.open_download_stream(first);
+        std::uint8_t buffer[14];
+        REQUIRE_THROWS_AS(downloader.read(buffer, sizeof(buffer)), gridfs_exception);
+        REQUIRE(download(second, 0, 12) == "aaaabbbbdddd");
+    }
+
+    SECTION("compressed and uncompressed uploads do not share chunks") {
+        if (!zstd_codec::supported()) {
+            return;
+        }
+
+        auto compressed = upload("aaaabbbbeeee", true);
+        auto uncompressed = upload("eeeeaaaa");
+
+        // The compressed upload stores its own copy of each chunk, and the uncompressed one shares
+        // the chunks of the first two files.
+        REQUIRE(db["fs.chunks"].count_documents({}) == 4 + 3 + 1);
+
+        REQUIRE(download(compressed, 0, 12) == "aaaabbbbeeee");
+        REQUIRE(download(uncompressed, 0, 8) == "eeeeaaaa");
+        REQUIRE(download(first, 0, 14) == "aaaabbbbaaaacc");
+    }
+}
+
 TEST_CASE("gridfs download large file", "[gridfs::bucket]") {
     instance::current();
 
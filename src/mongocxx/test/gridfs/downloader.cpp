@@ -28,5 +28,6 @@ TEST_CASE("mongocxx::gridfs::downloader default constructor makes invalid downlo
     REQUIRE(!downloader);
     std::uint8_t c;
     REQUIRE_THROWS_AS(downloader.read(&c, 1), logic_error);
+    REQUIRE_THROWS_AS(downloader.seek(0), logic_error);
 }
 }  // namespace
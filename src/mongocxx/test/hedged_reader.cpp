@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/hedged_reader.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/read_preference.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("hedged_reader finds documents", "[hedged_reader]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        auto coll = (*client)["hedged_reader"]["points"];
+        coll.drop();
+        for (std::int32_t i = 0; i < 10; i++) {
+            coll.insert_one(make_document(kvp("_id", i), kvp("x", i * 10)));
+        }
+    }
+
+    SECTION("reads are answered by whichever server responds first") {
+        hedged_reader reader{p, "hedged_reader", "points", std::chrono::milliseconds{0}};
+        options::find opts;
+        opts.read_preference(read_preference{}.mode(read_preference::read_mode::k_nearest));
+
+        for (std::int32_t i = 0; i < 10; i++) {
+            auto found = reader.find_one(make_document(kvp("_id", i)), opts);
+            REQUIRE(found);
+            REQUIRE(found->view()["x"].get_int32() == i * 10);
+        }
+        REQUIRE(!reader.find_one(make_document(kvp("_id", 100)), opts));
+        REQUIRE(reader.hedge_wins() <= reader.hedges());
+    }
+
+    SECTION("primary reads are never hedged") {
+        hedged_reader reader{p, "hedged_reader", "points", std::chrono::milliseconds{0}};
+        REQUIRE(reader.find_one(make_document(kvp("_id", 1))));
+        REQUIRE(reader.hedges() == 0);
+    }
+
+    SECTION("the delay must not be negative") {
+        REQUIRE_THROWS_AS(
+            hedged_reader(p, "hedged_reader", "points", std::chrono::milliseconds{-1}),
+            logic_error);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <bsoncxx/allocator.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/logger.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+class counting_allocator : public bsoncxx::allocator {
+   public:
+    counting_allocator(std::size_t* outstanding) : _outstanding(outstanding) {}
+
+    void* allocate(std::size_t size) final {
+        (*_outstanding)++;
+        return std::malloc(size);
+    }
+
+    void deallocate(void* ptr, std::size_t) noexcept final {
+        (*_outstanding)--;
+        std::free(ptr);
+    }
+
+   private:
+    std::size_t* _outstanding;
+};
+
+TEST_CASE("an instance routes driver allocations to its allocator", "[instance]") {
+    std::size_t outstanding = 0;
+    {
+        instance driver{nullptr, bsoncxx::stdx::make_unique<counting_allocator>(&outstanding)};
+
+        const auto before = driver.memory_stats();
+
+        {
+            auto doc = make_document(kvp("x", 1));
+            uri parsed{"mongodb://localhost:27017/?appname=allocator"};
+
+            const auto during = driver.memory_stats();
+            REQUIRE(during.blocks > before.blocks);
+            REQUIRE(during.allocated_bytes > before.allocated_bytes);
+            REQUIRE(during.total_allocations > before.total_allocations);
+            REQUIRE(outstanding == during.blocks);
+        }
+
+        const auto after = driver.memory_stats();
+        REQUIRE(after.blocks == before.blocks);
+        REQUIRE(after.allocated_bytes == before.allocated_bytes);
+        REQUIRE(after.peak_allocated_bytes >= after.allocated_bytes);
+    }
+}
+}  // namespace
@@ -0,0 +1,49 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/logger.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/private/libmongoc.hh>
+#include <mongocxx/uri.hpp>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("a lazy instance initializes libmongoc once, with the first client", "[instance]") {
+    auto init = libmongoc::init.create_instance();
+    int inits = 0;
+    init->visit([&]() { inits++; });
+
+    {
+        instance driver{nullptr, nullptr, instance::initialization::k_lazy};
+        REQUIRE(inits == 0);
+
+        // Parsing a URI does not need libmongoc to be initialized.
+        uri parsed{"mongodb://localhost:27017/?appname=lazy"};
+        REQUIRE(inits == 0);
+
+        {
+            client first{parsed};
+            REQUIRE(inits == 1);
+
+            pool second{parsed};
+            client third{parsed};
+            REQUIRE(inits == 1);
+        }
+    }
+}
+}  // namespace
@@ -14,10 +14,13 @@
 
 #include "helpers.hpp"
 
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/async_logger.hpp>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/logger.hpp>
 #include <mongocxx/private/libmongoc.hh>
@@ -43,6 +46,22 @@ class test_log_handler : public logger {
     std::vector<event>* _events;
 };
 
+class recording_logger : public logger {
+   public:
+    using event = std::tuple<log_level, std::string, std::string>;
+
+    recording_logger(std::vector<event>* events) : _events(events) {}
+
+    void operator()(log_level level,
+                    stdx::string_view domain,
+                    stdx::string_view message) noexcept final {
+        _events->emplace_back(level, std::string(domain), std::string(message));
+    }
+
+   private:
+    std::vector<event>* _events;
+};
+
 class reset_log_handler_when_done {
    public:
     ~reset_log_handler_when_done() {
@@ -66,4 +85,57 @@ TEST_CASE("a user-provided log handler will be used for logging output", "[insta
     REQUIRE(events[0] == std::make_tuple(log_level::k_error, "foo", "bar"));
 }
 
+TEST_CASE("an async_logger hands messages at or below its level to its sink", "[async_logger]") {
+    std::vector<recording_logger::event> events;
+    {
+        async_logger logger{stdx::make_unique<recording_logger>(&events), log_level::k_info};
+
+        logger(log_level::k_error, "client", "first");
+        logger(log_level::k_debug, "client", "filtered");
+        logger(log_level::k_info, "cluster", "second");
+
+        logger.flush();
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0] == std::make_tuple(log_level::k_error, "client", "first"));
+        REQUIRE(events[1] == std::make_tuple(log_level::k_info, "cluster", "second"));
+
+        logger(log_level::k_warning, "client", std::string(2000, 'x'));
+    }
+
+    // Destroying the logger hands over what is left, truncated to the maximum length.
+    REQUIRE(events.size() == 3);
+    REQUIRE(std::get<2>(events[2]).size() == 1024);
+}
+
+TEST_CASE("an async_logger drops and reports messages when its buffer is full",
+          "[async_logger]") {
+    std::vector<recording_logger::event> events;
+    std::uint64_t dropped;
+    {
+        async_logger logger{
+            stdx::make_unique<recording_logger>(&events), log_level::k_trace, 2};
+
+        for (int i = 0; i < 10000; i++) {
+            logger(log_level::k_debug, "client", "message");
+        }
+        dropped = logger.dropped();
+    }
+
+    // The sink sees every message that was not dropped, and a warning with the drop count.
+    REQUIRE(dropped > 0);
+    std::uint64_t delivered = 0;
+    std::uint64_t reported = 0;
+    for (auto&& event : events) {
+        if (std::get<0>(event) == log_level::k_warning) {
+            auto message = std::get<2>(event);
+            auto count = message.substr(std::string{"dropped "}.size());
+            reported += std::stoull(count.substr(0, count.find(' ')));
+        } else {
+            delivered++;
+        }
+    }
+    REQUIRE(reported == dropped);
+    REQUIRE(delivered + dropped == 10000);
+}
+
 }  // namespace
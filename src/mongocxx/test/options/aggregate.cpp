@@ -15,6 +15,7 @@
 #include "helpers.hpp"
 
 #include <chrono>
+#include <cstdint>
 
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
@@ -45,5 +46,7 @@ TEST_CASE("aggregate", "[aggregate][option]") {
     CHECK_OPTIONAL_ARGUMENT(agg, max_time, std::chrono::milliseconds{1000});
     CHECK_OPTIONAL_ARGUMENT(agg, read_preference, read_preference{});
     CHECK_OPTIONAL_ARGUMENT(agg, hint, hint);
+    CHECK_OPTIONAL_ARGUMENT(agg, prefetch_batches, 2);
+    CHECK_OPTIONAL_ARGUMENT(agg, max_prefetched_bytes, std::int64_t{1024});
 }
 }  // namespace
@@ -27,5 +27,8 @@ TEST_CASE("bulk_write opts", "[bulk_write][options]") {
     REQUIRE(bulk_write_opts.ordered());
     CHECK_OPTIONAL_ARGUMENT(bulk_write_opts, write_concern, write_concern{});
     CHECK_OPTIONAL_ARGUMENT(bulk_write_opts, bypass_document_validation, true);
+    REQUIRE(!bulk_write_opts.parallelism());
+    REQUIRE(bulk_write_opts.parallelism_pool() == nullptr);
+    REQUIRE(bulk_write_opts.shard_partitioning_pool() == nullptr);
 }
 }  // namespace
@@ -39,6 +39,8 @@ TEST_CASE("count", "[count][option]") {
     CHECK_OPTIONAL_ARGUMENT(cnt, max_time, std::chrono::milliseconds{1000});
     CHECK_OPTIONAL_ARGUMENT(cnt, read_preference, read_preference{});
     CHECK_OPTIONAL_ARGUMENT(cnt, skip, 3);
+    CHECK_OPTIONAL_ARGUMENT(cnt, allow_estimate, true);
+    CHECK_OPTIONAL_ARGUMENT(cnt, cache_ttl, std::chrono::milliseconds{500});
 }
 
 }  // namespace
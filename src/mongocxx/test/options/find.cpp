@@ -15,6 +15,7 @@
 #include "helpers.hpp"
 
 #include <chrono>
+#include <cstdint>
 
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/document/view.hpp>
@@ -39,18 +40,24 @@ TEST_CASE("find", "[find][option]") {
     auto projection = make_document(kvp("_id", false));
     auto sort = make_document(kvp("x", -1));
 
+    CHECK_OPTIONAL_ARGUMENT(find_opts, adaptive_batch_size, true);
     CHECK_OPTIONAL_ARGUMENT(find_opts, allow_partial_results, true);
     CHECK_OPTIONAL_ARGUMENT(find_opts, batch_size, 3);
+    CHECK_OPTIONAL_ARGUMENT(find_opts, cache_options_document, true);
     CHECK_OPTIONAL_ARGUMENT(find_opts, collation, collation.view());
     CHECK_OPTIONAL_ARGUMENT(find_opts, comment, "comment");
     CHECK_OPTIONAL_ARGUMENT(find_opts, cursor_type, cursor::type::k_non_tailable);
+    CHECK_OPTIONAL_ARGUMENT(find_opts, exhaust, true);
     CHECK_OPTIONAL_ARGUMENT(find_opts, hint, hint);
     CHECK_OPTIONAL_ARGUMENT(find_opts, limit, 3);
     CHECK_OPTIONAL_ARGUMENT(find_opts, max, max.view());
+    CHECK_OPTIONAL_ARGUMENT(find_opts, max_batch_bytes, 1024);
     CHECK_OPTIONAL_ARGUMENT(find_opts, max_await_time, std::chrono::milliseconds{300});
     CHECK_OPTIONAL_ARGUMENT(find_opts, max_time, std::chrono::milliseconds{300});
     CHECK_OPTIONAL_ARGUMENT(find_opts, min, min.view());
     CHECK_OPTIONAL_ARGUMENT(find_opts, no_cursor_timeout, true);
+    CHECK_OPTIONAL_ARGUMENT(find_opts, prefetch_batches, 2);
+    CHECK_OPTIONAL_ARGUMENT(find_opts, max_prefetched_bytes, std::int64_t{1024});
     CHECK_OPTIONAL_ARGUMENT(find_opts, projection, projection.view());
     CHECK_OPTIONAL_ARGUMENT(find_opts, read_preference, read_preference{});
     CHECK_OPTIONAL_ARGUMENT(find_opts, return_key, true);
@@ -0,0 +1,32 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/gridfs/download.hpp>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("options::gridfs::download accessors/mutators", "[options::gridfs::download]") {
+    instance::current();
+
+    options::gridfs::download download_options;
+
+    CHECK_OPTIONAL_ARGUMENT(download_options, batch_size, 50);
+    CHECK_OPTIONAL_ARGUMENT(download_options, prefetch_batches, 2);
+}
+}  // namespace
@@ -38,5 +38,18 @@ TEST_CASE("options::gridfs::upload accessors/mutators", "[options::gridfs::uploa
 
     CHECK_OPTIONAL_ARGUMENT(upload_options, chunk_size_bytes, 100);
     CHECK_OPTIONAL_ARGUMENT(upload_options, metadata, document.view());
+    CHECK_OPTIONAL_ARGUMENT(upload_options, max_batch_bytes, 1000);
+    CHECK_OPTIONAL_ARGUMENT(
+        upload_options, checksum, options::gridfs::upload::checksum_algorithm::k_crc32c);
+    CHECK_OPTIONAL_ARGUMENT(upload_options, deduplicate_chunks, true);
+    REQUIRE(!upload_options.parallelism());
+    REQUIRE(upload_options.parallelism_pool() == nullptr);
+    REQUIRE(!upload_options.compression());
+    REQUIRE(upload_options.compression_level() == 0);
+
+    upload_options.compression(options::gridfs::upload::compression_algorithm::k_zstd, 9);
+    REQUIRE(upload_options.compression() ==
+            options::gridfs::upload::compression_algorithm::k_zstd);
+    REQUIRE(upload_options.compression_level() == 9);
 }
 }  // namespace
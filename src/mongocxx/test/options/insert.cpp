@@ -14,6 +14,9 @@
 
 #include "helpers.hpp"
 
+#include <string>
+#include <vector>
+
 #include <bsoncxx/test_util/catch.hh>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/options/insert.hpp>
@@ -28,5 +31,10 @@ TEST_CASE("insert opts", "[insert][option]") {
 
     CHECK_OPTIONAL_ARGUMENT(ins, bypass_document_validation, true);
     CHECK_OPTIONAL_ARGUMENT(ins, write_concern, write_concern{});
+    CHECK_OPTIONAL_ARGUMENT(ins, ordered, false);
+    CHECK_OPTIONAL_ARGUMENT(ins, skip_inserted_ids, true);
+    CHECK_OPTIONAL_ARGUMENT(ins, dedupe_by, std::vector<std::string>(1, "_id"));
+    CHECK_OPTIONAL_ARGUMENT(ins, group_commit, true);
+    REQUIRE(ins.shard_partitioning_pool() == nullptr);
 }
 }  // namespace
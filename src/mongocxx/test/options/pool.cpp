@@ -14,6 +14,8 @@
 
 #include "helpers.hpp"
 
+#include <chrono>
+
 #include <bsoncxx/test_util/catch.hh>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/options/pool.hpp>
@@ -33,5 +35,28 @@ TEST_CASE("pool", "[pool][option]") {
         options::pool pool_opts{options::client().tls_opts(options::tls())};
         REQUIRE(pool_opts.client_opts().tls_opts());
     }
+
+    {
+        options::pool pool_opts{};
+        CHECK_OPTIONAL_ARGUMENT(pool_opts, thread_affinity, true);
+    }
+
+    {
+        options::pool pool_opts{};
+        CHECK_OPTIONAL_ARGUMENT(pool_opts, numa_partitions, true);
+    }
+
+    {
+        options::pool pool_opts{};
+        REQUIRE(!pool_opts.checkout_observer());
+
+        pool_opts.checkout_observer([](std::chrono::nanoseconds, std::chrono::nanoseconds) {});
+        REQUIRE(!!pool_opts.checkout_observer());
+    }
+
+    {
+        options::pool pool_opts{};
+        CHECK_OPTIONAL_ARGUMENT(pool_opts, warmup, 4);
+    }
 }
 }  // namespace
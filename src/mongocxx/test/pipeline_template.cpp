@@ -0,0 +1,110 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+#include <bsoncxx/types/value.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/pipeline.hpp>
+#include <mongocxx/pipeline_template.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("pipeline_template binds parameters into frozen stages", "[pipeline_template]") {
+    instance::current();
+
+    const auto status_parameter = pipeline_template::parameter("status");
+    const auto min_parameter = pipeline_template::parameter("min");
+
+    pipeline stages;
+    stages
+        .match(make_document(kvp("status", status_parameter),
+                             kvp("qty", make_document(kvp("$gte", min_parameter)))))
+        .group(
+            make_document(kvp("_id", "$sku"), kvp("tags", make_array("fixed", status_parameter))))
+        .limit(10);
+
+    pipeline_template by_status{stages};
+    REQUIRE(by_status.parameter_count() == 2);
+    REQUIRE(by_status.parameter_index("status") == 0);
+    REQUIRE(by_status.parameter_index("min") == 1);
+    REQUIRE_THROWS_AS(by_status.parameter_index("max"), logic_error);
+
+    auto expected = [](std::string status, std::int64_t min) {
+        pipeline p;
+        p.match(make_document(kvp("status", status), kvp("qty", make_document(kvp("$gte", min)))))
+            .group(make_document(kvp("_id", "$sku"), kvp("tags", make_array("fixed", status))))
+            .limit(10);
+        return bsoncxx::array::value{p.view_array()};
+    };
+
+    SECTION("values of any size replace the placeholders") {
+        using bsoncxx::types::value;
+
+        for (const std::string status : {"", "a", "a much longer status than the placeholder"}) {
+            auto bound = by_status.bind({value{bsoncxx::types::b_utf8{status}},
+                                         value{bsoncxx::types::b_int64{42}}});
+            REQUIRE(bound.view_array() == expected(status, 42).view());
+        }
+    }
+
+    SECTION("the template is unaffected by later changes") {
+        stages.skip(1);
+        auto bound = by_status.bind({bsoncxx::types::value{bsoncxx::types::b_utf8{"x"}},
+                                     bsoncxx::types::value{bsoncxx::types::b_int64{1}}});
+        REQUIRE(bound.view_array() == expected("x", 1).view());
+    }
+
+    SECTION("stages can be appended to a bound pipeline") {
+        auto bound = by_status.bind({bsoncxx::types::value{bsoncxx::types::b_utf8{"x"}},
+                                     bsoncxx::types::value{bsoncxx::types::b_int64{1}}});
+        bound.skip(5);
+
+        pipeline p;
+        p.append_stages(expected("x", 1).view()).skip(5);
+        REQUIRE(bound.view_array() == p.view_array());
+    }
+
+    SECTION("every parameter must be bound") {
+        REQUIRE_THROWS_AS(by_status.bind({bsoncxx::types::value{bsoncxx::types::b_null{}}}),
+                          logic_error);
+    }
+}
+
+TEST_CASE("pipeline_template without parameters", "[pipeline_template]") {
+    instance::current();
+
+    pipeline stages;
+    stages.match(make_document(kvp("a", 1)));
+
+    pipeline_template fixed{stages};
+    REQUIRE(fixed.parameter_count() == 0);
+    REQUIRE(fixed.bind({}).view_array() == stages.view_array());
+}
+
+}  // namespace
@@ -14,14 +14,24 @@
 
 #include "helpers.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <vector>
 
 #include <mongocxx/config/private/prelude.hh>
 
 #include <bsoncxx/test_util/catch.hh>
 #include <mongocxx/client.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/exception.hpp>
 #include <mongocxx/instance.hpp>
+#include <mongocxx/options/apm.hpp>
+#include <mongocxx/options/client.hpp>
+#include <mongocxx/options/pool.hpp>
 #include <mongocxx/options/tls.hpp>
 #include <mongocxx/pool.hpp>
 #include <mongocxx/private/libmongoc.hh>
@@ -143,6 +153,334 @@ TEST_CASE("calling acquire on a pool returns an entry that manages its client",
         client = nullptr;
         REQUIRE(push_called);
     }
+
+    SECTION("a released client object is reused by the next acquire") {
+        pool p{};
+        auto entry = p.acquire();
+        const mongocxx::client* first = &*entry;
+
+        entry = nullptr;
+        entry = p.acquire();
+        REQUIRE(&*entry == first);
+    }
+}
+
+TEST_CASE("a pool with thread affinity parks released clients with their thread", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    int fake_client_storage = 0;
+    auto fake_client = reinterpret_cast<::mongoc_client_t*>(&fake_client_storage);
+
+    int pop_calls = 0;
+    client_pool_pop->interpose([&](::mongoc_client_pool_t*) {
+        pop_calls++;
+        return fake_client;
+    });
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) {
+        pop_calls++;
+        return static_cast<::mongoc_client_t*>(nullptr);
+    });
+
+    std::vector<::mongoc_client_t*> pushed;
+    client_pool_push->interpose(
+        [&](::mongoc_client_pool_t*, ::mongoc_client_t* client) { pushed.push_back(client); });
+
+    {
+        options::pool pool_opts;
+        pool_opts.thread_affinity(true);
+        pool p{uri{}, pool_opts};
+
+        auto entry = p.acquire();
+        const int initial_pop_calls = pop_calls;
+
+        entry = nullptr;
+        REQUIRE(pushed.empty());
+
+        // The parked client is taken back without going to the shared queue.
+        entry = p.acquire();
+        REQUIRE(pop_calls == initial_pop_calls);
+        REQUIRE(pushed.empty());
+
+        entry = nullptr;
+    }
+
+    // Destroying the pool returns the parked client to the shared queue.
+    REQUIRE(pushed.size() == 1);
+    REQUIRE(pushed[0] == fake_client);
+}
+
+TEST_CASE("a pool cannot combine thread affinity with NUMA partitions", "[pool]") {
+    instance::current();
+
+    options::pool pool_opts;
+    pool_opts.thread_affinity(true).numa_partitions(true);
+    REQUIRE_THROWS_AS((pool{uri{}, pool_opts}), mongocxx::exception);
+}
+
+TEST_CASE("a pool records statistics about its checkouts", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    int fake_client_storage = 0;
+    auto fake_client = reinterpret_cast<::mongoc_client_t*>(&fake_client_storage);
+
+    bool client_available = true;
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) {
+        return client_available ? fake_client : static_cast<::mongoc_client_t*>(nullptr);
+    });
+    client_pool_pop->interpose([&](::mongoc_client_pool_t*) { return fake_client; });
+    client_pool_push->interpose([](::mongoc_client_pool_t*, ::mongoc_client_t*) {});
+
+    int observed = 0;
+    options::pool pool_opts;
+    pool_opts.checkout_observer([&](std::chrono::nanoseconds wait_time,
+                                    std::chrono::nanoseconds hold_time) {
+        REQUIRE(wait_time.count() >= 0);
+        REQUIRE(hold_time.count() >= 0);
+        observed++;
+    });
+
+    pool p{uri{}, pool_opts};
+    REQUIRE(p.stats().acquires == 0);
+
+    {
+        auto entry = p.acquire();
+        auto stats = p.stats();
+        REQUIRE(stats.acquires == 1);
+        REQUIRE(stats.in_use == 1);
+        REQUIRE(stats.saturation_events == 0);
+        REQUIRE(observed == 0);
+    }
+
+    REQUIRE(observed == 1);
+    REQUIRE(p.stats().in_use == 0);
+
+    client_available = false;
+    REQUIRE(!p.try_acquire());
+    REQUIRE(p.stats().try_acquire_failures == 1);
+
+    // With no client immediately available, acquire has to wait on the pool.
+    p.acquire();
+    auto stats = p.stats();
+    REQUIRE(stats.acquires == 2);
+    REQUIRE(stats.saturation_events == 1);
+    REQUIRE(stats.in_use == 0);
+    REQUIRE(observed == 2);
+
+    std::uint64_t histogram_total = 0;
+    for (auto count : stats.wait_time_histogram) {
+        histogram_total += count;
+    }
+    REQUIRE(histogram_total == 2);
+    REQUIRE(stats.max_wait_time <= stats.total_wait_time);
+}
+
+TEST_CASE("a pool sends connection checkout events", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    auto client_pool_set_apm_callbacks = libmongoc::client_pool_set_apm_callbacks.create_instance();
+    client_pool_set_apm_callbacks->interpose(
+        [](::mongoc_client_pool_t*, ::mongoc_apm_callbacks_t*, void*) { return true; });
+
+    int fake_client_storage = 0;
+    auto fake_client = reinterpret_cast<::mongoc_client_t*>(&fake_client_storage);
+
+    bool client_available = true;
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) {
+        return client_available ? fake_client : static_cast<::mongoc_client_t*>(nullptr);
+    });
+
+    using failure_reason = events::connection_check_out_failed_event::failure_reason;
+
+    int checked_out = 0;
+    std::vector<failure_reason> failures;
+    options::apm apm_opts;
+    apm_opts.on_connection_checked_out([&](const events::connection_checked_out_event& event) {
+        if (event.duration().count() >= 0) {
+            checked_out++;
+        }
+    });
+    apm_opts.on_connection_check_out_failed(
+        [&](const events::connection_check_out_failed_event& event) {
+            failures.push_back(event.reason());
+        });
+
+    pool p{uri{}, options::pool{options::client{}.apm_opts(apm_opts)}};
+
+    p.acquire();
+    REQUIRE(checked_out == 1);
+    REQUIRE(failures.empty());
+
+    client_available = false;
+    REQUIRE(!p.try_acquire());
+    REQUIRE_THROWS_AS(p.acquire(std::chrono::milliseconds{10}), mongocxx::exception);
+
+    REQUIRE(checked_out == 1);
+    REQUIRE(failures.size() == 2);
+    REQUIRE(failures[0] == failure_reason::k_pool_exhausted);
+    REQUIRE(failures[1] == failure_reason::k_timeout);
+}
+
+TEST_CASE("acquire with a timeout throws if no client becomes available", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    bool popped_blocking = false;
+    client_pool_pop->interpose([&](::mongoc_client_pool_t*) {
+        popped_blocking = true;
+        return static_cast<::mongoc_client_t*>(nullptr);
+    });
+    client_pool_try_pop->interpose(
+        [](::mongoc_client_pool_t*) { return static_cast<::mongoc_client_t*>(nullptr); });
+
+    pool p{};
+
+    REQUIRE_THROWS_AS(p.acquire(std::chrono::milliseconds{10}), mongocxx::exception);
+    REQUIRE(!popped_blocking);
+    REQUIRE(p.stats().acquires == 0);
+    REQUIRE(p.stats().saturation_events == 1);
+}
+
+TEST_CASE("acquire honors waitQueueTimeoutMS from the URI", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    bool popped_blocking = false;
+    client_pool_pop->interpose([&](::mongoc_client_pool_t*) {
+        popped_blocking = true;
+        return static_cast<::mongoc_client_t*>(nullptr);
+    });
+    client_pool_try_pop->interpose(
+        [](::mongoc_client_pool_t*) { return static_cast<::mongoc_client_t*>(nullptr); });
+
+    pool p{uri{"mongodb://localhost/?waitQueueTimeoutMS=10"}};
+
+    try {
+        p.acquire();
+        FAIL("expected acquire to time out");
+    } catch (const mongocxx::exception& e) {
+        REQUIRE(e.code() == error_code::k_pool_wait_queue_timeout);
+    }
+    REQUIRE(!popped_blocking);
+}
+
+TEST_CASE("a pool with warmup stops once no more clients can be created", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    int try_pop_calls = 0;
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) {
+        try_pop_calls++;
+        return static_cast<::mongoc_client_t*>(nullptr);
+    });
+
+    bool pushed = false;
+    client_pool_push->interpose(
+        [&](::mongoc_client_pool_t*, ::mongoc_client_t*) { pushed = true; });
+
+    options::pool pool_opts;
+    pool_opts.warmup(1);
+    pool p{uri{}, pool_opts};
+
+    REQUIRE(try_pop_calls == 1);
+    REQUIRE(!pushed);
+}
+
+TEST_CASE("shrink_to destroys idle clients beyond the requested number", "[pool]") {
+    MOCK_POOL
+
+    instance::current();
+
+    int fake_client_storage[4] = {};
+    std::size_t created = 0;
+
+    // A model of libmongoc's pool: a LIFO queue of idle clients, which creates a client when it is
+    // empty, and whose pushes destroy the oldest idle client while more than the minimum size are
+    // idle.
+    std::deque<::mongoc_client_t*> queue;
+    std::uint32_t min_size = 0;
+    std::vector<::mongoc_client_t*> destroyed;
+
+    client_pool_try_pop->interpose([&](::mongoc_client_pool_t*) {
+        if (queue.empty()) {
+            REQUIRE(created < 4);
+            return reinterpret_cast<::mongoc_client_t*>(&fake_client_storage[created++]);
+        }
+        auto client = queue.front();
+        queue.pop_front();
+        return client;
+    });
+    client_pool_push->interpose([&](::mongoc_client_pool_t*, ::mongoc_client_t* client) {
+        queue.push_front(client);
+        if (min_size > 0 && queue.size() > min_size) {
+            destroyed.push_back(queue.back());
+            queue.pop_back();
+        }
+    });
+
+    auto client_pool_min_size = libmongoc::client_pool_min_size.create_instance();
+    client_pool_min_size->interpose([&](::mongoc_client_pool_t*, std::uint32_t size) {
+        min_size = size;
+    });
+
+    pool p{uri{"mongodb://localhost/?maxPoolSize=10"}};
+
+    // Use three clients at once, and release them in the order they were created.
+    {
+        std::vector<pool::entry> entries;
+        for (int i = 0; i < 3; i++) {
+            entries.push_back(p.acquire());
+        }
+        for (auto&& entry : entries) {
+            entry = nullptr;
+        }
+    }
+    REQUIRE(queue.size() == 3);
+    REQUIRE(created == 3);
+
+    SECTION("the most recently used clients are kept") {
+        p.shrink_to(1);
+
+        REQUIRE(queue.size() == 1);
+        REQUIRE(queue.front() == reinterpret_cast<::mongoc_client_t*>(&fake_client_storage[2]));
+        REQUIRE(destroyed.size() == 2);
+        REQUIRE(min_size == 0);
+
+        // No client was created to find that the queue was empty.
+        REQUIRE(created == 3);
+    }
+
+    SECTION("one idle client is kept when shrinking to zero") {
+        p.shrink_to(0);
+
+        REQUIRE(queue.size() == 1);
+        REQUIRE(destroyed.size() == 2);
+    }
+
+    SECTION("no client is destroyed when fewer are idle") {
+        p.shrink_to(5);
+
+        REQUIRE(queue.size() == 3);
+        REQUIRE(destroyed.empty());
+        REQUIRE(created == 3);
+    }
+
+    SECTION("shrinking again takes only the clients left") {
+        p.shrink_to(1);
+        p.shrink_to(1);
+
+        REQUIRE(queue.size() == 1);
+        REQUIRE(destroyed.size() == 2);
+        REQUIRE(created == 3);
+    }
 }
 
 TEST_CASE("try_acquire returns an engaged stdx::optional<entry>", "[pool]") {
@@ -0,0 +1,90 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/apm_delivery_queue.hh>
+
+namespace {
+using namespace mongocxx;
+
+struct delivered {
+    std::atomic<bool> release{false};
+    std::thread::id thread;
+    std::vector<std::int64_t> request_ids;
+    std::vector<std::string> command_names;
+};
+
+void record(const events::command_timing& timing, void* context) {
+    auto sink = static_cast<delivered*>(context);
+    while (!sink->release.load()) {
+        std::this_thread::yield();
+    }
+    sink->thread = std::this_thread::get_id();
+    sink->request_ids.push_back(timing.request_id);
+    sink->command_names.push_back(std::string{timing.command_name});
+}
+
+events::command_timing make_timing(std::int64_t request_id, stdx::string_view command_name) {
+    return {request_id, command_name, 100, "localhost", 27017, true};
+}
+
+TEST_CASE("apm_delivery_queue delivers timings on its own thread", "[apm_delivery_queue]") {
+    delivered sink;
+    sink.release = true;
+    {
+        apm_delivery_queue queue{16, record, &sink};
+        for (std::int64_t i = 0; i < 10; ++i) {
+            queue.push(make_timing(i, "find"));
+        }
+    }  // Destroying the queue delivers the timings left in it.
+
+    REQUIRE(sink.request_ids == std::vector<std::int64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    REQUIRE(sink.thread != std::this_thread::get_id());
+}
+
+TEST_CASE("apm_delivery_queue drops timings when full", "[apm_delivery_queue]") {
+    delivered sink;
+    {
+        // The callback holds on to the first timing, so only the queue's capacity is accepted.
+        apm_delivery_queue queue{4, record, &sink};
+        for (std::int64_t i = 0; i < 10; ++i) {
+            queue.push(make_timing(i, "insert"));
+        }
+        REQUIRE(queue.dropped() == 6);
+        sink.release = true;
+    }
+
+    REQUIRE(sink.request_ids == std::vector<std::int64_t>{0, 1, 2, 3});
+}
+
+TEST_CASE("apm_delivery_queue truncates long command names", "[apm_delivery_queue]") {
+    delivered sink;
+    sink.release = true;
+    const std::string long_name(100, 'x');
+    {
+        apm_delivery_queue queue{2, record, &sink};
+        queue.push(make_timing(1, long_name));
+    }
+
+    REQUIRE(sink.command_names.size() == 1);
+    REQUIRE(sink.command_names[0] ==
+            long_name.substr(0, apm_delivery_queue::k_max_command_name_length));
+}
+}  // namespace
@@ -0,0 +1,98 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/batch_sizer.hh>
+
+namespace {
+using namespace mongocxx;
+
+using std::chrono::microseconds;
+
+// Records a batch worth of documents of `length` bytes, each fetched in `fetch` after the
+// application spent `consume` on the previous one, and returns whether the size changed.
+bool record_batch(batch_sizer& sizer,
+                  std::size_t length,
+                  microseconds fetch,
+                  microseconds consume) {
+    const std::int32_t documents = sizer.batch_size();
+    bool changed = false;
+    for (std::int32_t i = 0; i < documents; i++) {
+        sizer.consumed(consume);
+        changed = sizer.record(length, fetch);
+    }
+    return changed;
+}
+
+TEST_CASE("batch_sizer fits batches to a byte budget", "[batch_sizer]") {
+    batch_sizer sizer{101, 1000 * 1000, false};
+    REQUIRE(sizer.batch_size() == 101);
+
+    // Nothing changes until a batch worth of documents has been recorded.
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(!sizer.record(100, microseconds{0}));
+    }
+    REQUIRE(sizer.record(100, microseconds{0}));
+    REQUIRE(sizer.batch_size() == 10000);
+
+    REQUIRE(record_batch(sizer, 100 * 1000, microseconds{0}, microseconds{0}));
+    REQUIRE(sizer.batch_size() == 10);
+
+    SECTION("a batch holds at least one document") {
+        REQUIRE(record_batch(sizer, 4 * 1000 * 1000, microseconds{0}, microseconds{0}));
+        REQUIRE(sizer.batch_size() == 1);
+    }
+
+    SECTION("the consumer's speed is ignored unless adaptive") {
+        REQUIRE(!record_batch(sizer, 100 * 1000, microseconds{1000}, microseconds{0}));
+        REQUIRE(sizer.batch_size() == 10);
+    }
+}
+
+TEST_CASE("batch_sizer adapts to the consumer", "[batch_sizer]") {
+    batch_sizer sizer{100, 0, true};
+
+    // Round trips dominate a fast consumer, so batches grow.
+    REQUIRE(record_batch(sizer, 100, microseconds{10}, microseconds{1}));
+    REQUIRE(sizer.batch_size() == 200);
+    REQUIRE(record_batch(sizer, 100, microseconds{10}, microseconds{1}));
+    REQUIRE(sizer.batch_size() == 400);
+
+    // In between, the size holds.
+    REQUIRE(!record_batch(sizer, 100, microseconds{1}, microseconds{4}));
+    REQUIRE(sizer.batch_size() == 400);
+
+    // A slow consumer hides round trips, so batches shrink, but not below 16 documents.
+    for (int i = 0; i < 10; i++) {
+        record_batch(sizer, 100, microseconds{1}, microseconds{100});
+    }
+    REQUIRE(sizer.batch_size() == 16);
+
+    SECTION("batches stay under 16 MiB without a budget") {
+        batch_sizer large{100, 0, true};
+        REQUIRE(record_batch(large, 1024 * 1024, microseconds{10}, microseconds{1}));
+        REQUIRE(large.batch_size() == 16);
+    }
+
+    SECTION("batches stay within the budget") {
+        batch_sizer budgeted{100, 50 * 1000, true};
+        REQUIRE(record_batch(budgeted, 1000, microseconds{10}, microseconds{1}));
+        REQUIRE(budgeted.batch_size() == 50);
+    }
+}
+
+}  // namespace
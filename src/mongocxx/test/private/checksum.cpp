@@ -0,0 +1,77 @@
+// Copyright 2014 MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/checksum.hh>
+
+namespace {
+using namespace mongocxx;
+
+const std::uint8_t* as_bytes(const std::string& s) {
+    return reinterpret_cast<const std::uint8_t*>(s.data());
+}
+
+TEST_CASE("checksum::sha256 matches known digests", "[checksum]") {
+    SECTION("empty input") {
+        checksum::sha256 sha256;
+        REQUIRE(sha256.hex_digest() ==
+                "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    }
+
+    SECTION("input spanning several blocks, in uneven pieces") {
+        const std::string input = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+        std::vector<std::uint8_t> repeated;
+        for (int i = 0; i < 10; ++i) {
+            repeated.insert(repeated.end(), as_bytes(input), as_bytes(input) + input.size());
+        }
+
+        checksum::sha256 sha256;
+        std::size_t offset = 0;
+        for (std::size_t piece = 1; offset < repeated.size(); piece += 13) {
+            auto length = std::min(piece, repeated.size() - offset);
+            sha256.update(repeated.data() + offset, length);
+            offset += length;
+        }
+
+        checksum::sha256 whole;
+        whole.update(repeated.data(), repeated.size());
+        REQUIRE(sha256.hex_digest() == whole.hex_digest());
+    }
+
+    SECTION("two-block message") {
+        const std::string input = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+        checksum::sha256 sha256;
+        sha256.update(as_bytes(input), input.size());
+        REQUIRE(sha256.hex_digest() ==
+                "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    }
+}
+
+TEST_CASE("checksum::crc32c matches known checksums", "[checksum]") {
+    checksum::crc32c crc32c;
+    REQUIRE(crc32c.value() == 0);
+
+    const std::string input = "123456789";
+    crc32c.update(as_bytes(input), 4);
+    crc32c.update(as_bytes(input) + 4, input.size() - 4);
+    REQUIRE(crc32c.value() == 0xE3069283);
+    REQUIRE(crc32c.hex_digest() == "e3069283");
+}
+}  // namespace
@@ -0,0 +1,92 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/events/command_latency.hpp>
+#include <mongocxx/private/command_latency_recorder.hh>
+
+namespace {
+using namespace mongocxx;
+
+using std::chrono::microseconds;
+
+TEST_CASE("command latency buckets cover every duration", "[command_latency]") {
+    for (std::uint64_t duration : {0, 1, 31, 32, 33, 100, 1000, 123456, 1 << 30}) {
+        auto bucket = command_latency_bucket(duration);
+        INFO("duration: " << duration);
+        REQUIRE(bucket < events::command_latency::k_histogram_buckets);
+        REQUIRE(events::command_latency::bucket_upper_bound(bucket).count() >=
+                static_cast<std::int64_t>(duration));
+        if (bucket > 0) {
+            REQUIRE(events::command_latency::bucket_upper_bound(bucket - 1).count() <
+                    static_cast<std::int64_t>(duration));
+        }
+    }
+
+    REQUIRE(command_latency_bucket(std::uint64_t{1} << 50) ==
+            events::command_latency::k_histogram_buckets - 1);
+}
+
+TEST_CASE("command_latency_recorder merges histograms per command and server",
+          "[command_latency]") {
+    command_latency_recorder recorder;
+    REQUIRE(recorder.snapshot().empty());
+
+    // Record from several threads, so that the histograms are spread over several shards.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&recorder] {
+            for (std::int64_t i = 1; i <= 1000; ++i) {
+                recorder.record("find", "localhost", 27017, i);
+            }
+            recorder.record("insert", "localhost", 27018, 5000);
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    auto latencies = recorder.snapshot();
+    REQUIRE(latencies.size() == 2);
+
+    const auto& find = latencies[0];
+    REQUIRE(find.command_name == "find");
+    REQUIRE(find.host == "localhost");
+    REQUIRE(find.port == 27017);
+    REQUIRE(find.count == 4000);
+    REQUIRE(find.total_duration == microseconds{4 * 500500});
+    REQUIRE(find.max_duration == microseconds{1000});
+
+    // Percentiles are bucket upper bounds, within the bucket's width of the actual value.
+    auto p50 = find.percentile(50).count();
+    REQUIRE(p50 >= 500);
+    REQUIRE(p50 <= 500 * 17 / 16);
+    auto p99 = find.percentile(99).count();
+    REQUIRE(p99 >= 990);
+    REQUIRE(p99 <= 1000);
+    REQUIRE(find.percentile(100) == microseconds{1000});
+    REQUIRE(find.percentile(0) == microseconds{1});
+
+    const auto& insert = latencies[1];
+    REQUIRE(insert.command_name == "insert");
+    REQUIRE(insert.port == 27018);
+    REQUIRE(insert.count == 4);
+    REQUIRE(insert.percentile(99.9) == microseconds{5000});
+}
+}  // namespace
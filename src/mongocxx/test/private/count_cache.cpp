@@ -0,0 +1,82 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/count_cache.hh>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("count_cache entries expire by the injected clock", "[count_cache]") {
+    auto now = count_cache::clock::time_point{};
+    count_cache cache{[&now] { return now; }};
+
+    REQUIRE(!cache.find("a"));
+
+    cache.insert("a", 10, std::chrono::milliseconds{50});
+    REQUIRE(cache.find("a") == std::int64_t{10});
+    REQUIRE(!cache.find("b"));
+
+    now += std::chrono::milliseconds{49};
+    REQUIRE(cache.find("a") == std::int64_t{10});
+
+    now += std::chrono::milliseconds{1};
+    REQUIRE(!cache.find("a"));
+
+    // Inserting again replaces the count and restarts the TTL.
+    cache.insert("a", 11, std::chrono::milliseconds{50});
+    REQUIRE(cache.find("a") == std::int64_t{11});
+    now += std::chrono::milliseconds{50};
+    REQUIRE(!cache.find("a"));
+}
+
+TEST_CASE("count_cache drops expired entries once full", "[count_cache]") {
+    auto now = count_cache::clock::time_point{};
+    count_cache cache{[&now] { return now; }};
+
+    cache.insert("short", 1, std::chrono::milliseconds{10});
+    for (std::size_t i = 1; i != count_cache::k_max_entries; ++i) {
+        cache.insert(std::to_string(i), 2, std::chrono::hours{1});
+    }
+
+    SECTION("expired entries go first") {
+        now += std::chrono::milliseconds{10};
+        cache.insert("new", 3, std::chrono::hours{1});
+
+        REQUIRE(cache.find("new") == std::int64_t{3});
+        REQUIRE(cache.find("1") == std::int64_t{2});
+    }
+
+    SECTION("the cache is emptied if none have expired") {
+        cache.insert("new", 3, std::chrono::hours{1});
+
+        REQUIRE(cache.find("new") == std::int64_t{3});
+        REQUIRE(!cache.find("short"));
+        REQUIRE(!cache.find("1"));
+    }
+
+    SECTION("replacing an entry never evicts") {
+        cache.insert("1", 4, std::chrono::hours{1});
+
+        REQUIRE(cache.find("1") == std::int64_t{4});
+        REQUIRE(cache.find("short") == std::int64_t{1});
+    }
+}
+
+}  // namespace
@@ -0,0 +1,74 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/private/document_deduplicator.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("document_deduplicator drops documents repeating the values of its fields",
+          "[document_deduplicator]") {
+    document_deduplicator dedupe{std::vector<std::string>{"a", "b.c"}};
+
+    auto first = make_document(kvp("a", 1), kvp("b", make_document(kvp("c", "x"))));
+    auto reordered =
+        make_document(kvp("b", make_document(kvp("c", "x"))), kvp("z", 0), kvp("a", 1));
+    auto other = make_document(kvp("a", 1), kvp("b", make_document(kvp("c", "y"))));
+    auto other_type = make_document(kvp("a", 1.0), kvp("b", make_document(kvp("c", "x"))));
+    auto missing = make_document(kvp("a", 1), kvp("b", 2));
+
+    REQUIRE(dedupe.keep(first.view()));
+    REQUIRE(!dedupe.keep(first.view()));
+    REQUIRE(!dedupe.keep(reordered.view()));
+    REQUIRE(dedupe.keep(other.view()));
+    REQUIRE(dedupe.keep(other_type.view()));
+
+    // A document missing a field is always kept and never recorded.
+    REQUIRE(dedupe.keep(missing.view()));
+    REQUIRE(dedupe.keep(missing.view()));
+    REQUIRE(dedupe.size() == 3);
+}
+
+TEST_CASE("document_deduplicator grows past its initial table", "[document_deduplicator]") {
+    document_deduplicator dedupe{std::vector<std::string>{"_id"}};
+
+    for (std::int32_t i = 0; i < 5000; i++) {
+        REQUIRE(dedupe.keep(make_document(kvp("_id", i)).view()));
+    }
+    for (std::int32_t i = 0; i < 5000; i += 7) {
+        REQUIRE(!dedupe.keep(make_document(kvp("_id", i)).view()));
+    }
+    REQUIRE(dedupe.size() == 5000);
+}
+
+TEST_CASE("document_deduplicator rejects empty fields", "[document_deduplicator]") {
+    auto make = [](std::vector<std::string> fields) { document_deduplicator{fields}; };
+
+    REQUIRE_THROWS_AS(make({}), logic_error);
+    REQUIRE_THROWS_AS(make({"a", ""}), logic_error);
+    REQUIRE_THROWS_AS(make({"a..b"}), logic_error);
+}
+
+}  // namespace
@@ -0,0 +1,142 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/exception/server_error_code.hpp>
+#include <mongocxx/private/group_commit.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+write_outcome<result::bulk_write> failed(bsoncxx::document::value reply) {
+    return write_outcome<result::bulk_write>{
+        std::error_code{11000, server_error_category()}, std::move(reply), "E11000"};
+}
+
+TEST_CASE("group_commit gives each insert of a group its own outcome", "[group_commit]") {
+    SECTION("every insert of a successful group counts its own document") {
+        auto reply = make_document(kvp("nInserted", 3));
+        write_outcome<result::bulk_write> group{
+            stdx::optional<result::bulk_write>{result::bulk_write{std::move(reply)}}};
+
+        auto own = group_commit::outcome_of(group, 2);
+        REQUIRE(own);
+        REQUIRE(own.value()->inserted_count() == 1);
+    }
+
+    SECTION("a write error fails only its own insert, at index 0") {
+        auto group = failed(make_document(
+            kvp("nInserted", 2),
+            kvp("writeErrors",
+                make_array(make_document(
+                    kvp("index", 1), kvp("code", 11000), kvp("errmsg", "E11000 duplicate")))),
+            kvp("writeConcernErrors", make_array())));
+
+        auto first = group_commit::outcome_of(group, 0);
+        REQUIRE(first);
+        REQUIRE(first.value()->inserted_count() == 1);
+
+        auto second = group_commit::outcome_of(group, 1);
+        REQUIRE(second.has_error());
+        REQUIRE(second.error_code().value() == 11000);
+        REQUIRE(second.error_message() == "E11000 duplicate");
+        REQUIRE(second.write_error()["index"].get_int32() == 0);
+        REQUIRE(second.raw_server_error()["nInserted"].get_int32() == 0);
+    }
+
+    SECTION("an error of the whole bulk write fails every insert") {
+        auto group = failed(make_document(
+            kvp("nInserted", 2),
+            kvp("writeErrors",
+                make_array(make_document(kvp("index", 1), kvp("code", 11000)))),
+            kvp("writeConcernErrors",
+                make_array(make_document(kvp("code", 64), kvp("errmsg", "timed out"))))));
+
+        REQUIRE(group_commit::outcome_of(group, 0).has_error());
+        REQUIRE(group_commit::outcome_of(group, 1).has_error());
+
+        write_outcome<result::bulk_write> network{
+            std::error_code{6, server_error_category()}, make_document(), "connection closed"};
+        REQUIRE(group_commit::outcome_of(network, 0).error_message() == "connection closed");
+    }
+}
+
+TEST_CASE("group_commit sends concurrent inserts together", "[group_commit]") {
+    group_commit groups;
+    constexpr std::size_t k_threads = 8;
+
+    std::atomic<std::size_t> entered{0};
+    std::atomic<std::size_t> sent{0};
+    const group_commit::flush_fn flush =
+        [&](const std::vector<bsoncxx::document::view>& documents) {
+            // Hold the first group until the other threads are queued behind it.
+            while (entered.load() != k_threads) {
+                std::this_thread::yield();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+            sent += documents.size();
+            return write_outcome<result::bulk_write>{stdx::optional<result::bulk_write>{
+                result::bulk_write{make_document(kvp("nInserted", 0))}}};
+        };
+
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> succeeded{0};
+    for (std::size_t i = 0; i < k_threads; i++) {
+        threads.emplace_back([&, i] {
+            auto document = make_document(kvp("_id", static_cast<std::int64_t>(i)));
+            entered++;
+            if (groups.insert("db.coll", document.view(), flush)) {
+                succeeded++;
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(succeeded.load() == k_threads);
+    REQUIRE(sent.load() == k_threads);
+    REQUIRE(groups.flushes() < k_threads);
+
+    SECTION("an exception of the flush is rethrown by every insert of the group") {
+        auto document = make_document(kvp("_id", 1));
+        REQUIRE_THROWS_AS(
+            groups.insert("db.coll",
+                          document.view(),
+                          [](const std::vector<bsoncxx::document::view>&)
+                              -> write_outcome<result::bulk_write> {
+                              throw std::runtime_error{"no client"};
+                          }),
+            std::runtime_error);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,102 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/events/namespace_stats.hpp>
+#include <mongocxx/private/namespace_stats_recorder.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("namespace_stats_recorder merges the counts of every thread per namespace",
+          "[namespace_stats]") {
+    namespace_stats_recorder recorder;
+    REQUIRE(recorder.snapshot().empty());
+
+    auto find = make_document(kvp("find", "users"), kvp("filter", make_document()));
+    auto find_reply = make_document(
+        kvp("cursor", make_document(kvp("firstBatch", make_array(make_document(), make_document())),
+                                    kvp("id", std::int64_t{0}))),
+        kvp("ok", 1));
+    auto insert = make_document(kvp("insert", "orders"), kvp("documents", make_array()));
+    auto insert_reply = make_document(kvp("n", 3), kvp("ok", 1));
+
+    // Record from several threads, so that the counts are spread over several shards.
+    std::vector<std::thread> threads;
+    for (std::int64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::int64_t i = 0; i < 100; ++i) {
+                auto request_id = t * 1000 + 2 * i;
+                recorder.started(request_id, "shop", "find", find.view());
+                recorder.completed(request_id, "find", find_reply.view(), true);
+
+                recorder.started(request_id + 1, "shop", "insert", insert.view());
+                recorder.completed(request_id + 1, "insert", insert_reply.view(), i % 2 == 0);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = recorder.snapshot();
+    REQUIRE(stats.size() == 2);
+
+    const auto& orders = stats[0];
+    REQUIRE(orders.database == "shop");
+    REQUIRE(orders.collection == "orders");
+    REQUIRE(orders.inserts == 400);
+    REQUIRE(orders.finds == 0);
+    REQUIRE(orders.failures == 200);
+    REQUIRE(orders.documents_written == 200 * 3);
+    REQUIRE(orders.command_bytes == 400 * insert.view().length());
+
+    const auto& users = stats[1];
+    REQUIRE(users.collection == "users");
+    REQUIRE(users.finds == 400);
+    REQUIRE(users.failures == 0);
+    REQUIRE(users.documents_returned == 400 * 2);
+    REQUIRE(users.documents_written == 0);
+    REQUIRE(users.reply_bytes == 400 * find_reply.view().length());
+}
+
+TEST_CASE("namespace_stats_recorder attributes getMore to its collection", "[namespace_stats]") {
+    namespace_stats_recorder recorder;
+
+    auto get_more = make_document(kvp("getMore", std::int64_t{42}), kvp("collection", "users"));
+    auto reply = make_document(
+        kvp("cursor", make_document(kvp("nextBatch", make_array(make_document())))),
+        kvp("ok", 1));
+
+    recorder.started(1, "shop", "getMore", get_more.view());
+    recorder.completed(1, "getMore", reply.view(), true);
+
+    auto stats = recorder.snapshot();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].collection == "users");
+    REQUIRE(stats[0].get_mores == 1);
+    REQUIRE(stats[0].documents_returned == 1);
+}
+}  // namespace
@@ -0,0 +1,34 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/numa.hh>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("numa::count_from_node_list parses sysfs node lists", "[numa]") {
+    REQUIRE(numa::count_from_node_list("0") == 1);
+    REQUIRE(numa::count_from_node_list("0-1\n") == 2);
+    REQUIRE(numa::count_from_node_list("0-1,3") == 4);
+    REQUIRE(numa::count_from_node_list("") == 1);
+    REQUIRE(numa::count_from_node_list("node0") == 1);
+}
+
+TEST_CASE("numa::current_node is one of the host's nodes", "[numa]") {
+    REQUIRE(numa::node_count() >= 1);
+    REQUIRE(numa::current_node() < numa::node_count());
+}
+
+}  // namespace
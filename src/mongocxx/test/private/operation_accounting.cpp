@@ -0,0 +1,72 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/operation_accounting.hh>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("operation_accounting counts the commands of its thread", "[operation_accounting]") {
+    // Without an accounting, commands are not counted anywhere.
+    operation_accounting::command_started(100);
+    operation_accounting::command_completed(50, 10);
+
+    operation_accounting outer;
+    operation_accounting::command_started(100);
+    operation_accounting::command_completed(200, 30);
+
+    SECTION("an enclosed accounting adds to the enclosing one") {
+        {
+            operation_accounting inner;
+            operation_accounting::command_started(10);
+            operation_accounting::command_completed(20, 5);
+            REQUIRE(inner.stats().bytes_sent == 10);
+            REQUIRE(outer.stats().bytes_sent == 100);
+        }
+
+        REQUIRE(outer.stats().bytes_sent == 110);
+        REQUIRE(outer.stats().bytes_received == 220);
+        REQUIRE(outer.stats().round_trips == 2);
+        REQUIRE(outer.stats().duration == std::chrono::microseconds{35});
+    }
+
+    SECTION("an accounting with counters adds to them instead") {
+        operation_counters counters;
+        {
+            operation_accounting inner{&counters};
+            operation_accounting::command_started(10);
+            operation_accounting::command_completed(20, 5);
+        }
+
+        REQUIRE(counters.load().bytes_sent == 10);
+        REQUIRE(counters.load().round_trips == 1);
+        REQUIRE(outer.stats().bytes_sent == 100);
+    }
+
+    SECTION("commands of other threads are not counted") {
+        std::thread other{[] {
+            operation_accounting::command_started(1000);
+            operation_accounting::command_completed(1000, 1000);
+        }};
+        other.join();
+
+        REQUIRE(outer.stats().bytes_sent == 100);
+        REQUIRE(outer.stats().round_trips == 1);
+    }
+}
+}  // namespace
@@ -0,0 +1,115 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/operation_timings.hpp>
+#include <mongocxx/private/operation_timer.hh>
+
+namespace {
+using namespace mongocxx;
+
+void wait_a_little() {
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+}
+
+TEST_CASE("operation_timer splits an operation into phases", "[operation_timer]") {
+    SECTION("operations are not timed without a registration") {
+        {
+            operation_timer timer;
+            operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
+            wait_a_little();
+        }
+        REQUIRE(last_operation_timings().serialize == std::chrono::nanoseconds{0});
+    }
+
+    operation_timer::registration registration;
+
+    SECTION("each phase is timed") {
+        {
+            operation_timer timer;
+            {
+                operation_timer::scoped_phase serialize{operation_timer::phase::k_serialize};
+                wait_a_little();
+            }
+            {
+                operation_timer::libmongoc_call call;
+                wait_a_little();
+                operation_timer::command_started();
+                wait_a_little();
+                operation_timer::command_completed();
+                wait_a_little();
+                operation_timer::command_started();
+                operation_timer::command_completed();
+            }
+            {
+                operation_timer::scoped_phase construct{operation_timer::phase::k_result};
+                wait_a_little();
+            }
+        }
+
+        auto timings = last_operation_timings();
+        REQUIRE(timings.commands == 2);
+        REQUIRE(timings.serialize >= std::chrono::milliseconds{2});
+        REQUIRE(timings.dispatch >= std::chrono::milliseconds{2});
+        REQUIRE(timings.round_trip >= std::chrono::milliseconds{2});
+        REQUIRE(timings.reply_parse >= std::chrono::milliseconds{2});
+        REQUIRE(timings.result >= std::chrono::milliseconds{2});
+        REQUIRE(timings.total >= timings.serialize + timings.dispatch + timings.round_trip +
+                                     timings.reply_parse + timings.result);
+    }
+
+    SECTION("an enclosed operation is part of the enclosing one") {
+        {
+            operation_timer outer;
+            {
+                operation_timer inner;
+                operation_timer::libmongoc_call call;
+                operation_timer::command_started();
+                operation_timer::command_completed();
+            }
+            operation_timer::libmongoc_call call;
+            operation_timer::command_started();
+            operation_timer::command_completed();
+        }
+        REQUIRE(last_operation_timings().commands == 2);
+    }
+
+    SECTION("commands outside a libmongoc call are not counted") {
+        {
+            operation_timer timer;
+            operation_timer::command_started();
+            operation_timer::command_completed();
+        }
+        REQUIRE(last_operation_timings().commands == 0);
+    }
+
+    SECTION("the timings are those of the calling thread") {
+        {
+            operation_timer timer;
+            operation_timer::libmongoc_call call;
+            operation_timer::command_started();
+            operation_timer::command_completed();
+        }
+
+        operation_timings other;
+        std::thread{[&] { other = last_operation_timings(); }}.join();
+        REQUIRE(other.commands == 0);
+        REQUIRE(last_operation_timings().commands == 1);
+    }
+}
+
+}  // namespace
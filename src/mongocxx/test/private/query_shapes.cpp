@@ -0,0 +1,98 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/events/query_shape.hpp>
+#include <mongocxx/private/index_advisor.hh>
+#include <mongocxx/private/query_shape_recorder.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("query_shape_recorder counts the shapes of each collection", "[query_shapes]") {
+    query_shape_recorder recorder{2};
+
+    auto find = [](const char* collection, bsoncxx::document::view filter) {
+        return make_document(kvp("find", collection), kvp("filter", filter));
+    };
+    auto match = make_document(kvp("$match", make_document(kvp("y", 1))));
+
+    recorder.started("db", "find", find("a", make_document(kvp("x", 1))));
+    recorder.started("db", "find", find("a", make_document(kvp("x", 2))));
+    recorder.started(
+        "db",
+        "aggregate",
+        make_document(kvp("aggregate", "b"), kvp("pipeline", make_array(match.view()))));
+
+    // Commands without a filter are not counted, and a third shape exceeds the capacity.
+    recorder.started("db", "insert", make_document(kvp("insert", "a")));
+    recorder.started("db", "find", find("a", make_document(kvp("z", 1))));
+
+    auto shapes = recorder.snapshot();
+    REQUIRE(shapes.size() == 2);
+
+    REQUIRE(shapes[0].database == "db");
+    REQUIRE(shapes[0].collection == "a");
+    REQUIRE(shapes[0].filter_shape.view() == make_document(kvp("x", "?")));
+    REQUIRE(shapes[0].count == 2);
+
+    REQUIRE(shapes[1].collection == "b");
+    REQUIRE(shapes[1].filter_shape.view() == make_document(kvp("y", "?")));
+    REQUIRE(shapes[1].count == 1);
+}
+
+TEST_CASE("shape_has_index checks the leading field of each index", "[query_shapes]") {
+    auto id = make_document(kvp("_id", 1));
+    auto a_b = make_document(kvp("a", 1), kvp("b", -1));
+    std::vector<bsoncxx::document::view> keys{id.view(), a_b.view()};
+
+    SECTION("a filter on the leading field is supported") {
+        REQUIRE(shape_has_index(make_document(kvp("a", "?")), keys));
+        REQUIRE(shape_has_index(
+            make_document(kvp("c", "?"), kvp("a", make_document(kvp("$gt", "?")))), keys));
+        REQUIRE(shape_has_index(
+            make_document(kvp("$and", make_array(make_document(kvp("a", "?"))))), keys));
+    }
+
+    SECTION("a filter on other fields is not") {
+        REQUIRE(!shape_has_index(make_document(kvp("b", "?")), keys));
+        REQUIRE(!shape_has_index(make_document(kvp("c", "?")), {}));
+    }
+
+    SECTION("every branch of an $or must be supported") {
+        auto both = make_document(
+            kvp("$or", make_array(make_document(kvp("a", "?")), make_document(kvp("_id", "?")))));
+        auto one = make_document(
+            kvp("$or", make_array(make_document(kvp("a", "?")), make_document(kvp("c", "?")))));
+
+        REQUIRE(shape_has_index(both, keys));
+        REQUIRE(!shape_has_index(one, keys));
+    }
+
+    SECTION("a filter that names no field is not reported") {
+        REQUIRE(shape_has_index(make_document(kvp("$expr", "?")), {}));
+        REQUIRE(shape_has_index(make_document(), {}));
+    }
+}
+
+}  // namespace
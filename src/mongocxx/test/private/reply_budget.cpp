@@ -0,0 +1,88 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/private/reply_budget.hh>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("reply_budget counts the buffered bytes", "[reply_budget]") {
+    SECTION("a budget without a limit only counts") {
+        reply_budget budget;
+        budget.acquire(1000, [] { return false; });
+        budget.acquire(5000, [] { return false; });
+        REQUIRE(budget.used() == 6000);
+
+        budget.release(1000);
+        REQUIRE(budget.used() == 5000);
+        REQUIRE(budget.max_bytes() == 0);
+    }
+
+    SECTION("a batch is admitted when nothing is buffered, however large") {
+        reply_budget budget{100};
+        budget.acquire(1000, [] { return false; });
+        REQUIRE(budget.used() == 1000);
+    }
+
+    SECTION("make validates the option") {
+        REQUIRE(reply_budget::make(stdx::nullopt)->max_bytes() == 0);
+        REQUIRE(reply_budget::make(std::int64_t{4096})->max_bytes() == 4096);
+        REQUIRE_THROWS_AS(reply_budget::make(std::int64_t{0}), logic_error);
+        REQUIRE_THROWS_AS(reply_budget::make(std::int64_t{-1}), logic_error);
+    }
+}
+
+TEST_CASE("reply_budget holds a batch until enough is released", "[reply_budget]") {
+    reply_budget budget{100};
+    budget.acquire(80, [] { return false; });
+
+    SECTION("the waiting batch is admitted once bytes are released") {
+        std::atomic<bool> admitted{false};
+        std::thread producer{[&] {
+            budget.acquire(50, [] { return false; });
+            admitted = true;
+        }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        bool admitted_early = admitted;
+
+        budget.release(80);
+        producer.join();
+
+        REQUIRE(!admitted_early);
+        REQUIRE(admitted);
+        REQUIRE(budget.used() == 50);
+    }
+
+    SECTION("waiting ends once stop_waiting returns true after a wake") {
+        std::atomic<bool> stop{false};
+        std::thread producer{[&] { budget.acquire(50, [&] { return stop.load(); }); }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        stop = true;
+        budget.wake();
+        producer.join();
+
+        REQUIRE(budget.used() == 130);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,80 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/private/shard_router.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("shard_router routes writes by their shard key", "[shard_router]") {
+    // Chunks of {a: 1}: [MinKey, 0) and [10, MaxKey) on s0, [0, 10) on s1.
+    auto low = make_document(kvp("min", make_document(kvp("a", bsoncxx::types::b_minkey{}))),
+                             kvp("max", make_document(kvp("a", 0))),
+                             kvp("shard", "s0"));
+    auto middle = make_document(kvp("min", make_document(kvp("a", 0))),
+                                kvp("max", make_document(kvp("a", 10))),
+                                kvp("shard", "s1"));
+    auto high = make_document(kvp("min", make_document(kvp("a", 10))),
+                              kvp("max", make_document(kvp("a", bsoncxx::types::b_maxkey{}))),
+                              kvp("shard", "s0"));
+
+    shard_router router{make_document(kvp("a", 1)).view(),
+                        {high.view(), low.view(), middle.view()}};
+    REQUIRE(router.shard_count() == 2);
+
+    const auto s0 = router.shard_for_document(make_document(kvp("a", -5)).view());
+    const auto s1 = router.shard_for_document(make_document(kvp("a", 5)).view());
+    REQUIRE(s0 != s1);
+    REQUIRE(router.shard_name(s0) == "s0");
+    REQUIRE(router.shard_name(s1) == "s1");
+
+    REQUIRE(router.shard_for_document(make_document(kvp("a", 0)).view()) == s1);
+    REQUIRE(router.shard_for_document(make_document(kvp("a", 10)).view()) == s0);
+
+    // A missing field counts as null, which sorts before numbers.
+    REQUIRE(router.shard_for_document(make_document(kvp("b", 5)).view()) == s0);
+
+    SECTION("filters are routed only when they match the shard key for equality") {
+        REQUIRE(router.shard_for_filter(make_document(kvp("a", 5)).view()) == s1);
+        REQUIRE(router.shard_for_filter(make_document(kvp("a", make_document(kvp("$eq", 5))))
+                                            .view()) == s1);
+        REQUIRE(router.shard_for_filter(make_document(kvp("a", make_document(kvp("$gt", 5))))
+                                            .view()) == shard_router::k_unknown);
+        REQUIRE(router.shard_for_filter(make_document(kvp("b", 5)).view()) ==
+                shard_router::k_unknown);
+    }
+}
+
+TEST_CASE("shard_router rejects hashed keys and malformed chunks", "[shard_router]") {
+    auto chunk = make_document(kvp("min", make_document(kvp("a", bsoncxx::types::b_minkey{}))),
+                               kvp("max", make_document(kvp("a", bsoncxx::types::b_maxkey{}))),
+                               kvp("shard", "s0"));
+    REQUIRE_NOTHROW(shard_router(make_document(kvp("a", 1)).view(), {chunk.view()}));
+    REQUIRE_THROWS_AS(shard_router(make_document(kvp("a", "hashed")).view(), {chunk.view()}),
+                      logic_error);
+
+    auto no_shard = make_document(kvp("min", make_document(kvp("a", 0))));
+    REQUIRE_THROWS_AS(shard_router(make_document(kvp("a", 1)).view(), {no_shard.view()}),
+                      logic_error);
+}
+
+}  // namespace
@@ -0,0 +1,102 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/events/slow_command.hpp>
+#include <mongocxx/private/slow_command_log.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("filter_shape keeps field names and operators but no values", "[slow_command]") {
+    auto filter = make_document(
+        kvp("name", "secret"),
+        kvp("age", make_document(kvp("$gt", 21), kvp("$lt", 65))),
+        kvp("$or", make_array(make_document(kvp("a", 1)), make_document(kvp("b", "x")))),
+        kvp("tags", make_array("red", "blue")));
+
+    auto expected = make_document(
+        kvp("name", "?"),
+        kvp("age", make_document(kvp("$gt", "?"), kvp("$lt", "?"))),
+        kvp("$or", make_array(make_document(kvp("a", "?")), make_document(kvp("b", "?")))),
+        kvp("tags", "?"));
+
+    REQUIRE(filter_shape(filter.view()) == expected.view());
+}
+
+TEST_CASE("slow_command_log keeps the most recent commands over its threshold",
+          "[slow_command]") {
+    slow_command_log log{std::chrono::milliseconds{10}, 2};
+
+    auto find = [](std::int32_t id) {
+        return make_document(kvp("find", "coll"), kvp("filter", make_document(kvp("_id", id))));
+    };
+
+    log.started(1, "db", "find", find(1).view());
+    log.completed(1, 9999, "localhost", 27017, true);
+    REQUIRE(log.snapshot().empty());
+
+    for (std::int64_t request_id = 2; request_id <= 4; request_id++) {
+        log.started(request_id, "db", "find", find(2).view());
+        log.completed(request_id, 10000 * request_id, "localhost", 27017, request_id != 4);
+    }
+
+    auto commands = log.snapshot();
+    REQUIRE(commands.size() == 2);
+    REQUIRE(commands[0].duration == std::chrono::microseconds{30000});
+
+    const auto& last = commands[1];
+    REQUIRE(last.database == "db");
+    REQUIRE(last.collection == "coll");
+    REQUIRE(last.command_name == "find");
+    REQUIRE(last.filter_shape.view() == make_document(kvp("_id", "?")).view());
+    REQUIRE(last.host == "localhost");
+    REQUIRE(last.port == 27017);
+    REQUIRE(!last.succeeded);
+}
+
+TEST_CASE("slow_command_log finds the filters of writes and aggregations", "[slow_command]") {
+    slow_command_log log{std::chrono::milliseconds{0}, 8};
+
+    auto update = make_document(
+        kvp("update", "coll"),
+        kvp("updates", make_array(make_document(kvp("q", make_document(kvp("x", 1))),
+                                                kvp("u", make_document(kvp("y", 2)))))));
+    auto aggregate = make_document(
+        kvp("aggregate", "coll"),
+        kvp("pipeline",
+            make_array(make_document(kvp("$match", make_document(kvp("z", 3)))),
+                       make_document(kvp("$limit", 1)))));
+
+    log.started(1, "db", "update", update.view());
+    log.completed(1, 0, "localhost", 27017, true);
+    log.started(2, "db", "aggregate", aggregate.view());
+    log.completed(2, 0, "localhost", 27017, true);
+
+    auto commands = log.snapshot();
+    REQUIRE(commands.size() == 2);
+    REQUIRE(commands[0].filter_shape.view() == make_document(kvp("x", "?")).view());
+    REQUIRE(commands[1].filter_shape.view() == make_document(kvp("z", "?")).view());
+}
+}  // namespace
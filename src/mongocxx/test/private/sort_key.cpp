@@ -0,0 +1,74 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types/value_view.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/private/sort_key.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+using bsoncxx::types::value_view;
+
+TEST_CASE("sort_key::extractor orders documents by their sort fields", "[sort_key]") {
+    sort_key::extractor keys{make_document(kvp("a", 1), kvp("b.c", -1)).view()};
+    REQUIRE(keys.size() == 2);
+
+    auto lhs = make_document(kvp("b", make_document(kvp("c", 5))), kvp("a", 1));
+    auto rhs = make_document(kvp("a", 1), kvp("b", make_document(kvp("c", 3))));
+    auto later = make_document(kvp("a", 2));
+
+    value_view lhs_values[2];
+    value_view rhs_values[2];
+    value_view later_values[2];
+    keys.extract(lhs.view(), lhs_values);
+    keys.extract(rhs.view(), rhs_values);
+    keys.extract(later.view(), later_values);
+
+    REQUIRE(lhs_values[1].get_int32().value == 5);
+    REQUIRE(!later_values[1]);
+
+    // "b.c" is descending, so 5 comes before 3.
+    REQUIRE(keys.compare(lhs_values, rhs_values) < 0);
+    REQUIRE(keys.compare(rhs_values, later_values) < 0);
+    REQUIRE(keys.compare(lhs_values, lhs_values) == 0);
+
+    SECTION("arrays sort by their smallest element ascending and largest descending") {
+        sort_key::extractor ascending{make_document(kvp("x", 1)).view()};
+        sort_key::extractor descending{make_document(kvp("x", -1)).view()};
+        auto doc = make_document(kvp("x", make_array(3, 1, 2)));
+
+        value_view value;
+        ascending.extract(doc.view(), &value);
+        REQUIRE(value.get_int32().value == 1);
+        descending.extract(doc.view(), &value);
+        REQUIRE(value.get_int32().value == 3);
+    }
+
+    SECTION("invalid specifications are rejected") {
+        REQUIRE_THROWS_AS(sort_key::extractor{make_document().view()}, logic_error);
+        REQUIRE_THROWS_AS(sort_key::extractor{make_document(kvp("a", 2)).view()}, logic_error);
+        REQUIRE_THROWS_AS(sort_key::extractor{make_document(kvp("a", "text")).view()},
+                          logic_error);
+    }
+}
+
+}  // namespace
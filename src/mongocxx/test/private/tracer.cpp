@@ -0,0 +1,108 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/private/tracer.hh>
+#include <mongocxx/stdx.hpp>
+#include <mongocxx/tracer.hpp>
+
+namespace {
+using namespace mongocxx;
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("span attributes are read from the command document", "[tracer]") {
+    events::span_attributes attributes{};
+
+    SECTION("find") {
+        attributes.command_name = "find";
+        auto command = make_document(kvp("find", "coll"), kvp("batchSize", 20));
+        tracing::read_command_attributes(command.view(), &attributes);
+        REQUIRE(attributes.collection == stdx::string_view{"coll"});
+        REQUIRE(attributes.batch_size == std::int64_t{20});
+    }
+
+    SECTION("getMore") {
+        attributes.command_name = "getMore";
+        auto command = make_document(
+            kvp("getMore", std::int64_t{42}), kvp("collection", "coll"), kvp("batchSize", 5));
+        tracing::read_command_attributes(command.view(), &attributes);
+        REQUIRE(attributes.collection == stdx::string_view{"coll"});
+        REQUIRE(attributes.batch_size == std::int64_t{5});
+    }
+
+    SECTION("insert") {
+        attributes.command_name = "insert";
+        auto command = make_document(
+            kvp("insert", "coll"),
+            kvp("documents", make_array(make_document(kvp("a", 1)), make_document(kvp("a", 2)))));
+        tracing::read_command_attributes(command.view(), &attributes);
+        REQUIRE(attributes.collection == stdx::string_view{"coll"});
+        REQUIRE(attributes.batch_size == std::int64_t{2});
+    }
+
+    SECTION("aggregate") {
+        attributes.command_name = "aggregate";
+        auto command = make_document(kvp("aggregate", "coll"),
+                                     kvp("pipeline", make_array()),
+                                     kvp("cursor", make_document(kvp("batchSize", 0))));
+        tracing::read_command_attributes(command.view(), &attributes);
+        REQUIRE(attributes.batch_size == std::int64_t{0});
+    }
+
+    SECTION("a command without a collection") {
+        attributes.command_name = "ping";
+        auto command = make_document(kvp("ping", 1));
+        tracing::read_command_attributes(command.view(), &attributes);
+        REQUIRE(attributes.collection.empty());
+        REQUIRE(!attributes.batch_size);
+    }
+}
+
+TEST_CASE("parent scopes nest", "[tracer]") {
+    int outer = 0;
+    int inner = 0;
+
+    REQUIRE(tracer::current_parent() == nullptr);
+    {
+        tracer::parent_scope outer_scope{&outer};
+        REQUIRE(tracer::current_parent() == &outer);
+        {
+            tracer::parent_scope inner_scope{&inner};
+            REQUIRE(tracer::current_parent() == &inner);
+        }
+        REQUIRE(tracer::current_parent() == &outer);
+    }
+    REQUIRE(tracer::current_parent() == nullptr);
+}
+
+TEST_CASE("open spans are found by request id", "[tracer]") {
+    int first = 0;
+    int second = 0;
+
+    tracing::push_span(1, &first);
+    tracing::push_span(2, &second);
+
+    REQUIRE(tracing::pop_span(3) == nullptr);
+    REQUIRE(tracing::pop_span(1) == &first);
+    REQUIRE(tracing::pop_span(1) == nullptr);
+    REQUIRE(tracing::pop_span(2) == &second);
+}
+}  // namespace
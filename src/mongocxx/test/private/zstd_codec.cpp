@@ -0,0 +1,74 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/gridfs_exception.hpp>
+#include <mongocxx/private/zstd_codec.hh>
+
+namespace {
+using namespace mongocxx;
+
+TEST_CASE("zstd_codec round-trips buffers", "[zstd_codec]") {
+    zstd_codec codec;
+    std::vector<std::uint8_t> input(64 * 1024);
+    for (std::size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<std::uint8_t>("log line "[i % 9]);
+    }
+    std::vector<std::uint8_t> compressed;
+
+    if (!zstd_codec::supported()) {
+        REQUIRE(!zstd_codec::valid_level(3));
+        try {
+            codec.compress(input.data(), input.size(), 3, &compressed);
+            FAIL("expected a gridfs_exception");
+        } catch (const gridfs_exception& e) {
+            REQUIRE(e.code() == error_code::k_compression_not_supported);
+        }
+        return;
+    }
+
+    REQUIRE(zstd_codec::valid_level(3));
+    REQUIRE(!zstd_codec::valid_level(1000));
+
+    codec.compress(input.data(), input.size(), 3, &compressed);
+    REQUIRE(compressed.size() < input.size() / 8);
+
+    std::vector<std::uint8_t> output(input.size());
+    REQUIRE(codec.decompress(compressed.data(), compressed.size(), output.data(), output.size()) ==
+            input.size());
+    REQUIRE(output == input);
+
+    SECTION("frames larger than the output or malformed are rejected") {
+        REQUIRE_THROWS_AS(
+            codec.decompress(compressed.data(), compressed.size(), output.data(), 100),
+            gridfs_exception);
+
+        compressed[compressed.size() / 2] ^= 0xFF;
+        compressed.resize(compressed.size() / 2);
+        REQUIRE_THROWS_AS(
+            codec.decompress(compressed.data(), compressed.size(), output.data(), output.size()),
+            gridfs_exception);
+    }
+
+    SECTION("empty buffers round-trip") {
+        codec.compress(input.data(), 0, 3, &compressed);
+        REQUIRE(codec.decompress(compressed.data(), compressed.size(), output.data(), 0) == 0);
+    }
+}
+
+}  // namespace
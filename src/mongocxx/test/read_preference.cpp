@@ -34,10 +34,11 @@ TEST_CASE("Read preference", "[read_preference]") {
 
     read_preference rp;
 
-    SECTION("Defaults to mode primary, empty tags, and no max staleness") {
+    SECTION("Defaults to mode primary, empty tags, no max staleness, and no hedge") {
         REQUIRE(rp.mode() == read_preference::read_mode::k_primary);
         REQUIRE_FALSE(rp.tags());
         REQUIRE_FALSE(rp.max_staleness());
+        REQUIRE_FALSE(rp.hedge());
     }
 
     SECTION("Can have mode changed") {
@@ -63,6 +64,15 @@ TEST_CASE("Read preference", "[read_preference]") {
         REQUIRE(!rp.max_staleness());
     }
 
+    SECTION("Can have hedge changed") {
+        auto hedge = make_document(kvp("enabled", true));
+        rp.hedge(hedge.view());
+        REQUIRE(rp.hedge().value() == hedge);
+
+        rp.hedge(make_document());
+        REQUIRE_FALSE(rp.hedge());
+    }
+
     SECTION("Rejects invalid max_staleness") {
         REQUIRE_THROWS_AS(rp.max_staleness(std::chrono::seconds{0}), logic_error);
         REQUIRE_THROWS_AS(rp.max_staleness(std::chrono::seconds{-2}), logic_error);
@@ -119,6 +129,14 @@ TEST_CASE("Read preference equality operator works", "[read_preference]") {
         rp_b.max_staleness(max_staleness);
         REQUIRE(rp_a == rp_b);
     }
+
+    SECTION("hedge is compared") {
+        auto hedge = make_document(kvp("enabled", true));
+        rp_a.hedge(hedge.view());
+        REQUIRE_FALSE(rp_a == rp_b);
+        rp_b.hedge(hedge.view());
+        REQUIRE(rp_a == rp_b);
+    }
 }
 
 TEST_CASE("Read preference inequality operator works", "[read_preference]") {
@@ -169,5 +187,15 @@ TEST_CASE("Read preference methods call underlying mongoc methods", "[read_prefe
         rp.max_staleness(expected_max_staleness_sec);
         REQUIRE(called);
     }
+
+    SECTION("hedge() calls mongoc_read_prefs_set_hedge()") {
+        auto expected_hedge = make_document(kvp("enabled", true));
+        read_prefs_set_hedge->interpose([&](mongoc_read_prefs_t*, const bson_t* hedge) {
+            called = true;
+            REQUIRE(bson_get_data(hedge) == expected_hedge.view().data());
+        });
+        rp.hedge(expected_hedge.view());
+        REQUIRE(called);
+    }
 }
 }  // namespace
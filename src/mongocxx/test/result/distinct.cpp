@@ -0,0 +1,51 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/result/distinct.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("distinct", "[distinct][result]") {
+    mongocxx::instance::current();
+
+    SECTION("views the values of the reply") {
+        auto reply = make_document(kvp("values", make_array(1, 2, 3)), kvp("ok", 1.0));
+        const auto data = reply.view().data();
+
+        mongocxx::result::distinct distinct_result{std::move(reply)};
+
+        REQUIRE(distinct_result.reply().data() == data);
+        REQUIRE(distinct_result.values() == make_array(1, 2, 3).view());
+        REQUIRE(distinct_result.values().data() > data);
+        REQUIRE(distinct_result.values().data() < data + distinct_result.reply().length());
+    }
+
+    SECTION("has no values without a values array") {
+        mongocxx::result::distinct distinct_result{make_document(kvp("ok", 1.0))};
+
+        REQUIRE(distinct_result.values().empty());
+    }
+}
+
+}  // namespace
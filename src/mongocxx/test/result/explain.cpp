@@ -0,0 +1,101 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "helpers.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/result/explain.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_array;
+using bsoncxx::builder::basic::make_document;
+
+TEST_CASE("explain", "[explain][result]") {
+    mongocxx::instance::current();
+
+    auto index_scan = make_document(kvp("stage", "IXSCAN"), kvp("indexName", "a_1"));
+    auto fetch = make_document(kvp("stage", "FETCH"), kvp("inputStage", index_scan.view()));
+    auto stats = make_document(kvp("nReturned", 4),
+                               kvp("executionTimeMillis", 2),
+                               kvp("totalKeysExamined", 4),
+                               kvp("totalDocsExamined", std::int64_t{4}));
+
+    SECTION("summarizes the winning plan of a find") {
+        mongocxx::result::explain explained{
+            make_document(kvp("queryPlanner", make_document(kvp("winningPlan", fetch.view()))),
+                          kvp("executionStats", stats.view()),
+                          kvp("ok", 1.0))};
+
+        REQUIRE(explained.winning_stage() == "FETCH");
+        REQUIRE(explained.indexes() == std::vector<std::string>{"a_1"});
+        REQUIRE(!explained.collection_scan());
+        REQUIRE(*explained.returned() == 4);
+        REQUIRE(*explained.docs_examined() == 4);
+        REQUIRE(*explained.keys_examined() == 4);
+        REQUIRE(*explained.execution_time() == std::chrono::milliseconds{2});
+    }
+
+    SECTION("reads the plan of the first stage of an aggregation") {
+        auto cursor_stage = make_document(
+            kvp("$cursor",
+                make_document(kvp("queryPlanner",
+                                  make_document(kvp("winningPlan",
+                                                    make_document(kvp("stage", "COLLSCAN"))))))));
+        mongocxx::result::explain explained{
+            make_document(kvp("stages", make_array(cursor_stage.view())), kvp("ok", 1.0))};
+
+        REQUIRE(explained.winning_stage() == "COLLSCAN");
+        REQUIRE(explained.indexes().empty());
+        REQUIRE(explained.collection_scan());
+        REQUIRE(!explained.docs_examined());
+        REQUIRE(!explained.execution_time());
+    }
+
+    SECTION("walks the plans of every shard") {
+        auto shard = make_document(kvp("shardName", "s0"), kvp("winningPlan", fetch.view()));
+        auto other = make_document(
+            kvp("shardName", "s1"),
+            kvp("winningPlan",
+                make_document(kvp("queryPlan", make_document(kvp("stage", "COLLSCAN"))))));
+        auto plan = make_document(kvp("stage", "SHARD_MERGE"),
+                                  kvp("shards", make_array(shard.view(), other.view())));
+        mongocxx::result::explain explained{
+            make_document(kvp("queryPlanner", make_document(kvp("winningPlan", plan.view()))),
+                          kvp("ok", 1.0))};
+
+        REQUIRE(explained.winning_stage() == "SHARD_MERGE");
+        REQUIRE(explained.indexes() == std::vector<std::string>{"a_1"});
+        REQUIRE(explained.collection_scan());
+    }
+
+    SECTION("has an empty summary without a plan") {
+        mongocxx::result::explain explained{make_document(kvp("ok", 1.0))};
+
+        REQUIRE(explained.winning_stage().empty());
+        REQUIRE(explained.indexes().empty());
+        REQUIRE(!explained.returned());
+    }
+}
+
+}  // namespace
@@ -222,6 +222,8 @@ TEST_CASE("SDAM Monitoring", "[sdam_monitoring]") {
             heartbeat_started_events++;
             REQUIRE_FALSE(event.host().empty());
             REQUIRE(event.port() != 0);
+            // A single-threaded client checks its servers by polling, never with awaited checks.
+            REQUIRE_FALSE(event.awaited());
         });
 
         // ServerHeartbeatSucceededEvent
@@ -230,6 +232,7 @@ TEST_CASE("SDAM Monitoring", "[sdam_monitoring]") {
             REQUIRE_FALSE(event.host().empty());
             REQUIRE(event.port() != 0);
             REQUIRE_FALSE(event.reply().empty());
+            REQUIRE_FALSE(event.awaited());
         });
 
         // Don't expect a ServerHeartbeatFailedEvent here, see the test below.
@@ -257,6 +260,7 @@ TEST_CASE("Heartbeat failed event", "[sdam_monitoring]") {
         REQUIRE_FALSE(event.host().empty());
         REQUIRE_FALSE(event.message().empty());
         REQUIRE(event.port() != 0);
+        REQUIRE_FALSE(event.awaited());
     });
 
     REQUIRE_THROWS_AS(
@@ -0,0 +1,79 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/shard_change_streams.hpp>
+#include <mongocxx/test_util/client_helpers.hh>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("shard change streams deliver events per shard and merged", "[shard_change_streams]") {
+    instance::current();
+    client mongos{uri{}};
+
+    if (test_util::get_topology(mongos) != "sharded") {
+        WARN("skip: per-shard change streams require a sharded cluster");
+        return;
+    }
+
+    auto coll = mongos["shard_streams"]["events"];
+    coll.drop();
+    coll.insert_one(make_document(kvp("x", -1)));
+
+    shard_change_streams streams{uri{}, "shard_streams", "events"};
+    REQUIRE(streams.shard_count() > 0);
+    REQUIRE(!streams.shard_name(0).empty());
+    REQUIRE_THROWS_AS(streams.shard_name(streams.shard_count()), logic_error);
+
+    for (std::int32_t i = 0; i < 10; i++) {
+        coll.insert_one(make_document(kvp("x", i)));
+    }
+
+    SECTION("merged events come in clusterTime order") {
+        std::int32_t expected = 0;
+        while (expected < 10) {
+            auto event = streams.pop_merged(std::chrono::seconds{10});
+            REQUIRE(event);
+            REQUIRE(event->view()["fullDocument"]["x"].get_int32() == expected++);
+        }
+    }
+
+    SECTION("every event is queued by some shard") {
+        std::int32_t seen = 0;
+        for (std::size_t shard = 0; shard < streams.shard_count(); shard++) {
+            while (streams.pop(shard, std::chrono::seconds{1})) {
+                seen++;
+            }
+        }
+        REQUIRE(seen == 10);
+    }
+
+    streams.stop();
+    REQUIRE(!streams.pop_merged(std::chrono::milliseconds{1}));
+}
+
+}  // namespace
@@ -0,0 +1,96 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/sorted_merge_cursor.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("merge_cursors merges sorted cursors in sort order", "[sorted_merge_cursor]") {
+    instance::current();
+
+    client mongodb_client{uri{}};
+    auto db = mongodb_client["sorted_merge_cursor"];
+    db.drop();
+
+    // Three collections holding interleaved values of x, with an unsorted insertion order.
+    for (std::int32_t i = 0; i < 3; i++) {
+        auto coll = db["coll" + std::to_string(i)];
+        for (std::int32_t x = 29 - i; x >= 0; x -= 3) {
+            coll.insert_one(make_document(kvp("x", x), kvp("source", i)));
+        }
+    }
+
+    auto sort = make_document(kvp("x", -1));
+    options::find opts;
+    opts.sort(sort.view());
+    opts.batch_size(4);
+
+    auto open_cursors = [&] {
+        std::vector<cursor> cursors;
+        for (std::int32_t i = 0; i < 3; i++) {
+            cursors.push_back(db["coll" + std::to_string(i)].find({}, opts));
+        }
+        return cursors;
+    };
+
+    SECTION("documents come out in sort order across cursors") {
+        auto merged = merge_cursors(open_cursors(), sort.view());
+
+        std::vector<std::int32_t> values;
+        for (auto&& doc : merged) {
+            values.push_back(doc["x"].get_int32());
+        }
+
+        REQUIRE(values.size() == 30);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            REQUIRE(values[i] == 29 - static_cast<std::int32_t>(i));
+        }
+        REQUIRE(merged.begin() == merged.end());
+    }
+
+    SECTION("cursors can be merged without reading ahead") {
+        sorted_merge_cursor merged{open_cursors(), sort.view(), 0};
+        std::size_t count = 0;
+        for (auto&& doc : merged) {
+            REQUIRE(doc["x"].get_int32() == 29 - static_cast<std::int32_t>(count));
+            count++;
+        }
+        REQUIRE(count == 30);
+    }
+
+    SECTION("invalid arguments are rejected") {
+        REQUIRE_THROWS_AS(merge_cursors(open_cursors(), make_document()), logic_error);
+        REQUIRE_THROWS_AS(merge_cursors(open_cursors(), sort.view(), -1), logic_error);
+    }
+
+    db.drop();
+}
+
+}  // namespace
@@ -0,0 +1,139 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/exception/query_exception.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/tailer.hpp>
+#include <mongocxx/pool.hpp>
+#include <mongocxx/tailer.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+// Collects the values of "n" delivered by a tailer.
+struct collected {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::int32_t> values;
+
+    tailer::document_fn callback() {
+        return [this](bsoncxx::document::view doc) {
+            std::lock_guard<std::mutex> lock{mutex};
+            values.push_back(doc["n"].get_int32());
+            changed.notify_all();
+        };
+    }
+
+    bool wait_for(std::size_t count) {
+        std::unique_lock<std::mutex> lock{mutex};
+        return changed.wait_for(
+            lock, std::chrono::seconds{10}, [&] { return values.size() >= count; });
+    }
+};
+
+TEST_CASE("tailer delivers documents inserted into a capped collection", "[tailer]") {
+    instance::current();
+
+    pool p{};
+    auto client = p.acquire();
+    auto db = (*client)["tailer"];
+    db["capped"].drop();
+    db.create_collection("capped", make_document(kvp("capped", true), kvp("size", 1024 * 1024)));
+    auto coll = db["capped"];
+
+    options::tailer opts;
+    opts.max_await_time(std::chrono::milliseconds{200});
+    opts.reopen_interval(std::chrono::milliseconds{10});
+    opts.resume_field("n");
+
+    SECTION("documents arrive in insertion order, including after the cursor is reopened") {
+        // The collection starts empty, so the first cursor is closed at once and reopened.
+        collected received;
+        tailer tail{p, "tailer", "capped", received.callback(), {}, opts};
+
+        for (std::int32_t n = 0; n < 10; n++) {
+            coll.insert_one(make_document(kvp("n", n)));
+        }
+        REQUIRE(received.wait_for(10));
+
+        tail.stop();
+        tail.wait();
+
+        std::lock_guard<std::mutex> lock{received.mutex};
+        REQUIRE(received.values.size() == 10);
+        for (std::int32_t n = 0; n < 10; n++) {
+            REQUIRE(received.values[static_cast<std::size_t>(n)] == n);
+        }
+    }
+
+    SECTION("the filter selects the documents delivered") {
+        collected received;
+        tailer tail{p, "tailer", "capped", received.callback(), make_document(kvp("even", true))};
+
+        for (std::int32_t n = 0; n < 6; n++) {
+            coll.insert_one(make_document(kvp("n", n), kvp("even", n % 2 == 0)));
+        }
+        REQUIRE(received.wait_for(3));
+        tail.stop();
+
+        std::lock_guard<std::mutex> lock{received.mutex};
+        REQUIRE(received.values == std::vector<std::int32_t>{0, 2, 4});
+    }
+}
+
+TEST_CASE("tailer reports the error that ended the tailing", "[tailer]") {
+    instance::current();
+
+    pool p{};
+    {
+        auto client = p.acquire();
+        auto coll = (*client)["tailer"]["not_capped"];
+        coll.drop();
+        coll.insert_one(make_document(kvp("n", 0)));
+    }
+
+    collected received;
+    tailer tail{p, "tailer", "not_capped", received.callback()};
+    REQUIRE_THROWS_AS(tail.wait(), query_exception);
+}
+
+TEST_CASE("tailer rejects invalid arguments", "[tailer]") {
+    instance::current();
+
+    pool p{};
+    REQUIRE_THROWS_AS(tailer(p, "tailer", "capped", tailer::document_fn{}), logic_error);
+
+    options::tailer opts;
+    REQUIRE_THROWS_AS(opts.max_await_time(std::chrono::milliseconds{0}), logic_error);
+    REQUIRE_THROWS_AS(opts.batch_size(0), logic_error);
+    REQUIRE_THROWS_AS(opts.resume_field(""), logic_error);
+    REQUIRE_THROWS_AS(opts.reopen_interval(std::chrono::milliseconds{-1}), logic_error);
+}
+
+}  // namespace
@@ -0,0 +1,126 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/timeseries_bucketer.hpp>
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+
+TEST_CASE("timeseries_bucketer writes measurements as bucket documents", "[timeseries_bucketer]") {
+    instance::current();
+
+    client mongodb_client{uri{}};
+    auto coll = mongodb_client["timeseries_bucketer"]["buckets"];
+    coll.drop();
+
+    const std::chrono::system_clock::time_point start{std::chrono::seconds{1600000000}};
+    auto sensor = [](std::int32_t id) { return make_document(kvp("sensor", id)); };
+
+    SECTION("buckets are split by meta document, count and span") {
+        timeseries_bucketer bucketer{coll, 10, std::chrono::minutes{1}};
+
+        for (std::int32_t i = 0; i < 25; i++) {
+            bucketer.append(sensor(1).view(),
+                            start + std::chrono::seconds{i},
+                            make_document(kvp("temperature", 20.0 + i)).view());
+        }
+        bucketer.append(sensor(2).view(), start, make_document(kvp("temperature", 5)).view());
+        // Over a minute after the first measurement of the open bucket of sensor 2.
+        bucketer.append(sensor(2).view(),
+                        start + std::chrono::minutes{2},
+                        make_document(kvp("temperature", 6)).view());
+        REQUIRE(bucketer.pending_measurements() == 27);
+
+        auto result = bucketer.flush();
+        REQUIRE(result);
+        REQUIRE(result->inserted_count() == 5);
+        REQUIRE(bucketer.pending_measurements() == 0);
+        REQUIRE(!bucketer.flush());
+
+        REQUIRE(coll.count_documents(make_document(kvp("meta.sensor", 1))) == 3);
+        REQUIRE(coll.count_documents(make_document(kvp("meta.sensor", 2))) == 2);
+
+        auto first = coll.find_one(make_document(kvp("meta.sensor", 1), kvp("control.count", 10)),
+                                   options::find{}.sort(make_document(kvp("control.min.time", 1))));
+        REQUIRE(first);
+        auto control = first->view()["control"];
+        REQUIRE(control["min"]["temperature"].get_double() == 20.0);
+        REQUIRE(control["max"]["temperature"].get_double() == 29.0);
+        REQUIRE(control["min"]["time"].get_date().value == start.time_since_epoch());
+
+        auto temperatures = first->view()["data"]["temperature"].get_array().value;
+        REQUIRE(temperatures[9].get_double() == 29.0);
+        REQUIRE(first->view()["data"]["time"].get_array().value[9].get_date() ==
+                bsoncxx::types::b_date{start + std::chrono::seconds{9}});
+    }
+
+    SECTION("fields missing from a measurement are NaN in their column") {
+        timeseries_bucketer bucketer{coll};
+        bucketer.append(sensor(1).view(), start, make_document(kvp("a", 1)).view());
+        bucketer.append(sensor(1).view(),
+                        start + std::chrono::seconds{1},
+                        make_document(kvp("b", std::int64_t{2})).view());
+        bucketer.flush();
+
+        auto bucket = coll.find_one({});
+        REQUIRE(bucket);
+        auto data = bucket->view()["data"];
+        REQUIRE(data["a"].get_array().value[0].get_double() == 1.0);
+        REQUIRE(std::isnan(data["a"].get_array().value[1].get_double().value));
+        REQUIRE(std::isnan(data["b"].get_array().value[0].get_double().value));
+        REQUIRE(bucket->view()["control"]["min"]["b"].get_double() == 2.0);
+    }
+
+    SECTION("closed buckets are written once enough are waiting") {
+        timeseries_bucketer bucketer{coll, 1, std::chrono::hours{1}, 3};
+        REQUIRE(!bucketer.append(sensor(1).view(), start, make_document(kvp("x", 1)).view()));
+        REQUIRE(!bucketer.append(sensor(2).view(), start, make_document(kvp("x", 1)).view()));
+
+        auto written = bucketer.append(sensor(3).view(), start, make_document(kvp("x", 1)).view());
+        REQUIRE(written);
+        REQUIRE(written->inserted_count() == 3);
+    }
+
+    SECTION("invalid measurements and limits are rejected") {
+        timeseries_bucketer bucketer{coll};
+        REQUIRE_THROWS_AS(
+            bucketer.append(sensor(1).view(), start, make_document(kvp("x", "hot")).view()),
+            logic_error);
+        REQUIRE_THROWS_AS(
+            bucketer.append(sensor(1).view(), start, make_document(kvp("time", 1)).view()),
+            logic_error);
+        REQUIRE(bucketer.pending_measurements() == 0);
+
+        REQUIRE_THROWS_AS(timeseries_bucketer(coll, 0), logic_error);
+        REQUIRE_THROWS_AS(timeseries_bucketer(coll, 10, std::chrono::milliseconds{0}),
+                          logic_error);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,103 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/mapping.hpp>
+#include <bsoncxx/test_util/catch.hh>
+#include <mongocxx/client.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/typed_cursor.hpp>
+#include <mongocxx/uri.hpp>
+
+namespace typed_cursor_test {
+
+struct reading {
+    std::int32_t _id;
+    std::string sensor;
+    double value;
+};
+BSONCXX_DEFINE_STRUCT(reading, _id, sensor, value)
+
+}  // namespace typed_cursor_test
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+using namespace mongocxx;
+using typed_cursor_test::reading;
+
+TEST_CASE("typed_cursor decodes documents in cursor order", "[typed_cursor]") {
+    instance::current();
+
+    client mongodb_client{uri{}};
+    auto coll = mongodb_client["typed_cursor"]["readings"];
+    coll.drop();
+
+    std::vector<bsoncxx::document::value> docs;
+    for (std::int32_t i = 0; i < 2500; i++) {
+        docs.push_back(make_document(
+            kvp("_id", i), kvp("sensor", "s" + std::to_string(i % 7)), kvp("value", i * 0.5)));
+    }
+    coll.insert_many(docs);
+
+    options::find opts;
+    opts.sort(make_document(kvp("_id", 1)));
+
+    SECTION("in parallel batches") {
+        auto results = coll.find({}, opts);
+        typed_cursor<reading> typed{results, 600, 4};
+
+        std::int32_t expected = 0;
+        for (auto&& r : typed) {
+            REQUIRE(r._id == expected);
+            REQUIRE(r.sensor == "s" + std::to_string(expected % 7));
+            REQUIRE(r.value == expected * 0.5);
+            expected++;
+        }
+        REQUIRE(expected == 2500);
+    }
+
+    SECTION("with cursor::as") {
+        auto results = coll.find(make_document(kvp("_id", make_document(kvp("$lt", 10)))), opts);
+        std::vector<std::int32_t> ids;
+        for (auto&& r : results.as<reading>()) {
+            ids.push_back(r._id);
+        }
+        REQUIRE(ids == std::vector<std::int32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    }
+
+    SECTION("decoding errors are reported") {
+        coll.insert_one(make_document(kvp("_id", 5000), kvp("value", "not a number")));
+        auto results = coll.find(make_document(kvp("_id", 5000)));
+        auto typed = results.as<reading>();
+        REQUIRE_THROWS_AS(typed.begin(), bsoncxx::exception);
+    }
+
+    auto results = coll.find({});
+    REQUIRE_THROWS_AS(typed_cursor<reading>(results, 0), logic_error);
+
+    coll.drop();
+}
+
+}  // namespace
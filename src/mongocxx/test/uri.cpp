@@ -56,6 +56,25 @@ TEST_CASE("URI", "[uri]") {
         REQUIRE(u.write_concern().acknowledge_level() == mongocxx::write_concern::level::k_default);
     }
 
+    SECTION("Copies share the parsed URI") {
+        mongocxx::uri copy{};
+        {
+            mongocxx::uri original{"mongodb://a.example.com:27018,b.example.com/db?replicaSet=rs"};
+            copy = original;
+            mongocxx::uri constructed{original};
+            REQUIRE(constructed.to_string() == original.to_string());
+        }
+
+        REQUIRE(copy.to_string() == "mongodb://a.example.com:27018,b.example.com/db?replicaSet=rs");
+        REQUIRE(copy.database() == "db");
+        REQUIRE(copy.replica_set() == "rs");
+        REQUIRE(copy.hosts().size() == 2);
+        REQUIRE(copy.hosts()[0].name == "a.example.com");
+        REQUIRE(copy.hosts()[0].port == 27018);
+        REQUIRE(copy.hosts()[1].name == "b.example.com");
+        REQUIRE(copy.hosts()[1].port == 27017);
+    }
+
     SECTION("Valid URI") {
         REQUIRE_NOTHROW(mongocxx::uri{"mongodb://example.com"});
     }
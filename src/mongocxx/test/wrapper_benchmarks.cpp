@@ -0,0 +1,221 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the overhead of the C++ wrapper alone: every libmongoc call that would reach a server
+// is mocked, so the times are those of building documents and options, converting them for
+// libmongoc, and wrapping the results. Each mocked call also pays for the mock's own dispatch,
+// which the MockedCall benchmark measures so that it can be subtracted.
+//
+// Usage: wrapper_benchmarks [NAME_FILTER...]
+
+#include "helpers.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/private/libbson.hh>
+#include <mongocxx/bulk_write.hpp>
+#include <mongocxx/client.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/model/insert_one.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/private/libmongoc.hh>
+
+namespace {
+using namespace mongocxx;
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+struct wrapper_benchmark {
+    std::string name;
+    std::function<void()> operation;
+};
+
+// Runs `operation` until a second has passed, after a short warmup, and returns its mean time.
+double nanoseconds_per_operation(const std::function<void()>& operation) {
+    using clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < 1000; i++) {
+        operation();
+    }
+
+    std::int64_t operations = 0;
+    const auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while (elapsed < std::chrono::seconds{1}) {
+        for (int i = 0; i < 1000; i++) {
+            operation();
+        }
+        operations += 1000;
+        elapsed = clock::now() - start;
+    }
+
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+    return static_cast<double>(nanoseconds.count()) / static_cast<double>(operations);
+}
+
+bool selected(const std::string& name, const std::vector<std::string>& filters) {
+    if (filters.empty()) {
+        return true;
+    }
+    for (auto&& filter : filters) {
+        if (name.find(filter) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    instance::current();
+
+    std::vector<std::string> filters{argv + 1, argv + argc};
+
+    MOCK_CLIENT
+    MOCK_DATABASE
+    MOCK_COLLECTION
+    MOCK_BULK
+    MOCK_CURSOR
+
+    client mongo_client{uri{}};
+    collection coll = mongo_client["wrapper_benchmarks"]["coll"];
+
+    auto document = make_document(kvp("_id", 1),
+                                  kvp("name", "wrapper"),
+                                  kvp("tags", make_document(kvp("a", 1), kvp("b", 2))));
+    bson_t document_bson;
+    bson_init_static(&document_bson, document.view().data(), document.view().length());
+
+    collection_create_bulk_operation_with_opts
+        ->interpose([](mongoc_collection_t*, const bson_t*) -> mongoc_bulk_operation_t* {
+            return nullptr;
+        })
+        .forever();
+    bulk_operation_insert_with_opts
+        ->interpose([](mongoc_bulk_operation_t*, const bson_t*, const bson_t*, bson_error_t*) {
+            return true;
+        })
+        .forever();
+    bulk_operation_execute
+        ->interpose([](mongoc_bulk_operation_t*, bson_t* reply, bson_error_t*) {
+            bson_init(reply);
+            return 1;
+        })
+        .forever();
+    bulk_operation_destroy->interpose([](mongoc_bulk_operation_t*) {}).forever();
+    collection_find_with_opts
+        ->interpose([](mongoc_collection_t*,
+                       const bson_t*,
+                       const bson_t*,
+                       const mongoc_read_prefs_t*) -> mongoc_cursor_t* { return nullptr; })
+        .forever();
+    cursor_destroy->interpose([](mongoc_cursor_t*) {}).forever();
+    collection_destroy->interpose([](mongoc_collection_t*) {}).forever();
+    collection_get_name->interpose([](mongoc_collection_t*) { return "coll"; }).forever();
+
+    // Every cursor returns the same document this many times.
+    const int cursor_documents = 100;
+    int documents_left = 0;
+    auto cursor_next = libmongoc::cursor_next.create_instance();
+    cursor_next
+        ->interpose([&](mongoc_cursor_t*, const bson_t** out) {
+            if (documents_left == 0) {
+                return false;
+            }
+            documents_left--;
+            *out = &document_bson;
+            return true;
+        })
+        .forever();
+    auto cursor_error_document = libmongoc::cursor_error_document.create_instance();
+    cursor_error_document
+        ->interpose([](mongoc_cursor_t*, bson_error_t*, const bson_t**) { return false; })
+        .forever();
+
+    auto filter = make_document(kvp("name", "wrapper"));
+
+    std::vector<wrapper_benchmark> benchmarks = {
+        {"MockedCall", [] { libmongoc::collection_get_name(nullptr); }},
+        {"InsertOne", [&] { coll.insert_one(document.view()); }},
+        {"InsertOneWithoutId",
+         [&] { coll.insert_one(make_document(kvp("name", "wrapper")).view()); }},
+        {"Find",
+         [&] {
+             documents_left = 0;
+             coll.find(filter.view());
+         }},
+        {"FindWithOptions",
+         [&] {
+             documents_left = 0;
+             options::find opts;
+             opts.batch_size(100)
+                 .comment("wrapper")
+                 .limit(1000)
+                 .max_time(std::chrono::milliseconds{500})
+                 .projection(make_document(kvp("name", 1), kvp("tags", 1)))
+                 .sort(make_document(kvp("_id", -1)));
+             coll.find(filter.view(), opts);
+         }},
+        {"CursorIteration100",
+         [&] {
+             documents_left = cursor_documents;
+             auto cursor = coll.find(filter.view());
+             std::int64_t ids = 0;
+             for (auto&& doc : cursor) {
+                 ids += doc["_id"].get_int32().value;
+             }
+             if (ids != cursor_documents) {
+                 std::abort();
+             }
+         }},
+        {"BulkWriteAppend100",
+         [&] {
+             auto bulk = coll.create_bulk_write();
+             for (int i = 0; i < 100; i++) {
+                 bulk.append(model::insert_one{document.view()});
+             }
+         }},
+        {"FindOptionsBuilding",
+         [&] {
+             options::find opts;
+             opts.batch_size(100)
+                 .comment("wrapper")
+                 .limit(1000)
+                 .max_time(std::chrono::milliseconds{500})
+                 .projection(make_document(kvp("name", 1), kvp("tags", 1)))
+                 .sort(make_document(kvp("_id", -1)));
+         }},
+    };
+
+    for (auto&& benchmark : benchmarks) {
+        if (selected(benchmark.name, filters)) {
+            std::cout << std::left << std::setw(24) << benchmark.name << std::fixed
+                      << std::setprecision(1) << nanoseconds_per_operation(benchmark.operation)
+                      << " ns/op" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,258 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/timeseries_bucketer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/builder/basic/sub_array.hpp>
+#include <bsoncxx/builder/basic/sub_document.hpp>
+#include <bsoncxx/oid.hpp>
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/bulk_write.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+#include <mongocxx/model/insert_one.hpp>
+#include <mongocxx/options/bulk_write.hpp>
+#include <mongocxx/private/timeseries_bucketer.hh>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::sub_array;
+using bsoncxx::builder::basic::sub_document;
+
+double number_of(const bsoncxx::document::element& element) {
+    switch (element.type()) {
+        case bsoncxx::type::k_double:
+            return element.get_double().value;
+        case bsoncxx::type::k_int32:
+            return element.get_int32().value;
+        case bsoncxx::type::k_int64:
+            return static_cast<double>(element.get_int64().value);
+        default:
+            throw logic_error{error_code::k_invalid_parameter,
+                              "the fields of a time-series measurement must be numbers"};
+    }
+}
+
+bsoncxx::types::b_date date_of(std::int64_t milliseconds) {
+    return bsoncxx::types::b_date{std::chrono::milliseconds{milliseconds}};
+}
+
+}  // namespace
+
+void timeseries_bucketer::impl::append_bounds(sub_document bounds,
+                                              const std::vector<column>& columns,
+                                              bool largest) {
+    for (auto&& column : columns) {
+        bool found = false;
+        double bound = 0;
+        for (auto value : column.values) {
+            if (std::isnan(value)) {
+                continue;
+            }
+            if (!found || (largest ? value > bound : value < bound)) {
+                bound = value;
+                found = true;
+            }
+        }
+        if (found) {
+            bounds.append(kvp(column.name, bound));
+        }
+    }
+}
+
+bsoncxx::document::value timeseries_bucketer::impl::encode(const bucket& bucket) {
+    const auto times = std::minmax_element(bucket.times.begin(), bucket.times.end());
+
+    bsoncxx::builder::basic::document document;
+    document.append(kvp("_id", bsoncxx::oid{}), kvp("meta", bucket.meta.view()));
+    document.append(kvp("control", [&](sub_document control) {
+        control.append(kvp("count", static_cast<std::int64_t>(bucket.times.size())));
+        control.append(kvp("min", [&](sub_document min) {
+            min.append(kvp("time", date_of(*times.first)));
+            append_bounds(min, bucket.columns, false);
+        }));
+        control.append(kvp("max", [&](sub_document max) {
+            max.append(kvp("time", date_of(*times.second)));
+            append_bounds(max, bucket.columns, true);
+        }));
+    }));
+    document.append(kvp("data", [&](sub_document data) {
+        data.append(kvp("time", [&](sub_array column) {
+            for (auto time : bucket.times) {
+                column.append(date_of(time));
+            }
+        }));
+        for (auto&& column : bucket.columns) {
+            data.append(kvp(column.name, [&](sub_array values) {
+                values.append_range(column.values.data(), column.values.size());
+            }));
+        }
+    }));
+    return document.extract();
+}
+
+void timeseries_bucketer::impl::close(
+    std::unordered_map<std::string, bucket>::iterator open_bucket) {
+    closed.push_back(encode(open_bucket->second));
+    closed_measurements += open_bucket->second.times.size();
+    open.erase(open_bucket);
+}
+
+stdx::optional<result::bulk_write> timeseries_bucketer::impl::write_closed() {
+    if (closed.empty()) {
+        return stdx::nullopt;
+    }
+
+    // The buckets are dropped whether or not the write succeeds.
+    auto buckets = std::move(closed);
+    closed.clear();
+    pending -= closed_measurements;
+    closed_measurements = 0;
+
+    options::bulk_write options;
+    options.ordered(false);
+    auto writes = collection.create_bulk_write(options);
+    for (auto&& bucket : buckets) {
+        writes.append(model::insert_one{bucket.view()});
+    }
+    return writes.execute();
+}
+
+timeseries_bucketer::timeseries_bucketer(class collection collection,
+                                         std::size_t max_measurements,
+                                         std::chrono::milliseconds max_span,
+                                         std::size_t max_buckets_per_write) {
+    if (max_measurements == 0) {
+        throw logic_error{error_code::k_invalid_parameter, "max_measurements must be positive"};
+    }
+    if (max_span.count() <= 0) {
+        throw logic_error{error_code::k_invalid_parameter, "max_span must be positive"};
+    }
+    if (max_buckets_per_write == 0) {
+        throw logic_error{error_code::k_invalid_parameter,
+                          "max_buckets_per_write must be positive"};
+    }
+
+    _impl = stdx::make_unique<impl>(
+        std::move(collection), max_measurements, max_span, max_buckets_per_write);
+}
+
+timeseries_bucketer::timeseries_bucketer(timeseries_bucketer&&) noexcept = default;
+timeseries_bucketer& timeseries_bucketer::operator=(timeseries_bucketer&&) noexcept = default;
+timeseries_bucketer::~timeseries_bucketer() = default;
+
+stdx::optional<result::bulk_write> timeseries_bucketer::append(
+    bsoncxx::document::view meta,
+    std::chrono::system_clock::time_point time,
+    bsoncxx::document::view measurement) {
+    // Check the measurement before any bucket changes.
+    for (auto&& field : measurement) {
+        if (field.key() == bsoncxx::stdx::string_view{"time"}) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "a time-series measurement cannot have a field named \"time\""};
+        }
+        number_of(field);
+    }
+
+    const auto milliseconds =
+        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    std::string key{reinterpret_cast<const char*>(meta.data()), meta.length()};
+
+    auto open_bucket = _impl->open.find(key);
+    if (open_bucket != _impl->open.end()) {
+        const auto first = open_bucket->second.times.front();
+        if (milliseconds < first || milliseconds - first >= _impl->max_span) {
+            _impl->close(open_bucket);
+            open_bucket = _impl->open.end();
+        }
+    }
+    if (open_bucket == _impl->open.end()) {
+        open_bucket = _impl->open.emplace(std::move(key), impl::bucket{meta}).first;
+    }
+
+    auto& bucket = open_bucket->second;
+    bucket.times.push_back(milliseconds);
+    const auto count = bucket.times.size();
+
+    std::size_t position = 0;
+    for (auto&& field : measurement) {
+        const bsoncxx::stdx::string_view name = field.key();
+
+        // Measurements of a series usually list their fields in the same order, so the column at
+        // the same position is tried first.
+        auto column = bucket.columns.end();
+        if (position < bucket.columns.size() && bucket.columns[position].name == name) {
+            column = bucket.columns.begin() + static_cast<std::ptrdiff_t>(position);
+        } else {
+            column = std::find_if(
+                bucket.columns.begin(), bucket.columns.end(), [&](const impl::column& existing) {
+                    return existing.name == name;
+                });
+        }
+        if (column == bucket.columns.end()) {
+            impl::column added;
+            added.name = std::string{name.data(), name.size()};
+            added.values.assign(count - 1, std::numeric_limits<double>::quiet_NaN());
+            bucket.columns.push_back(std::move(added));
+            column = bucket.columns.end() - 1;
+        }
+        if (column->values.size() < count) {
+            column->values.push_back(number_of(field));
+        }
+        position++;
+    }
+    for (auto&& column : bucket.columns) {
+        if (column.values.size() < count) {
+            column.values.push_back(std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    _impl->pending++;
+
+    if (count >= _impl->max_measurements) {
+        _impl->close(open_bucket);
+    }
+    if (_impl->closed.size() >= _impl->max_buckets_per_write) {
+        return _impl->write_closed();
+    }
+    return stdx::nullopt;
+}
+
+stdx::optional<result::bulk_write> timeseries_bucketer::flush() {
+    while (!_impl->open.empty()) {
+        _impl->close(_impl->open.begin());
+    }
+    return _impl->write_closed();
+}
+
+std::size_t timeseries_bucketer::pending_measurements() const noexcept {
+    return _impl->pending;
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,144 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/collection.hpp>
+#include <mongocxx/result/bulk_write.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Gathers time-series measurements into bucket documents before they are inserted.
+///
+/// Inserting one document per measurement of a sensor stream costs a document, an index entry
+/// and a write for every measurement. A timeseries_bucketer instead keeps the measurements sharing
+/// a meta document together in memory and writes each bucket of them as a single document:
+///
+///     {
+///         "_id": ObjectId(...),
+///         "meta": <meta>,
+///         "control": {"count": <n>,
+///                     "min": {"time": <earliest>, <field>: <min>, ...},
+///                     "max": {"time": <latest>, <field>: <max>, ...}},
+///         "data": {"time": [<date>, ...], <field>: [<double>, ...], ...}
+///     }
+///
+/// The columns of "data" hold one entry per measurement, in the order the measurements were
+/// appended: the i-th entry of every column belongs to the i-th time. The control fields let
+/// queries and indexes skip buckets by range without reading their columns. The numeric columns
+/// are encoded in one pass each with builder::core::append_range.
+///
+/// A bucket is closed once it holds max_measurements measurements, or when a measurement is older
+/// than its first one or at least max_span later. Closed buckets are written together as one
+/// unordered bulk write once max_buckets_per_write of them are waiting, and flush() writes the
+/// rest, including the buckets still open.
+///
+/// A timeseries_bucketer must not be used by several threads at once.
+///
+class MONGOCXX_API timeseries_bucketer {
+   public:
+    ///
+    /// Creates a timeseries_bucketer writing to a collection.
+    ///
+    /// @param collection
+    ///   The collection to insert the buckets into.
+    /// @param max_measurements
+    ///   The most measurements in a bucket. Must be positive.
+    /// @param max_span
+    ///   The longest time between the first and the last measurement of a bucket. Must be
+    ///   positive.
+    /// @param max_buckets_per_write
+    ///   The number of closed buckets at which append() writes them. Must be positive.
+    ///
+    /// @throws mongocxx::logic_error if one of the limits is not positive.
+    ///
+    explicit timeseries_bucketer(collection collection,
+                                 std::size_t max_measurements = 1000,
+                                 std::chrono::milliseconds max_span = std::chrono::hours{1},
+                                 std::size_t max_buckets_per_write = 100);
+
+    timeseries_bucketer(timeseries_bucketer&&) noexcept;
+    timeseries_bucketer& operator=(timeseries_bucketer&&) noexcept;
+
+    ///
+    /// Discards the measurements that were not written. Call flush() first to keep them.
+    ///
+    ~timeseries_bucketer();
+
+    ///
+    /// Adds a measurement to the open bucket of its meta document.
+    ///
+    /// The fields of the measurement must be numbers, which are stored as doubles. A bucket has a
+    /// column for every field of any of its measurements, and a measurement lacking one of them
+    /// has NaN in that column; NaN is left out of the control fields.
+    ///
+    /// @param meta
+    ///   The document identifying the series, such as {"sensor": 12}. Buckets are kept per meta
+    ///   document, compared byte by byte, so the order of its fields matters.
+    /// @param time
+    ///   The time of the measurement.
+    /// @param measurement
+    ///   The values measured, such as {"temperature": 21.5, "humidity": 40}.
+    ///
+    /// @return
+    ///   The result of the bulk write of the closed buckets if this call wrote them, and nothing
+    ///   otherwise.
+    ///
+    /// @throws mongocxx::logic_error if a field of the measurement is not a number or is named
+    ///   "time".
+    /// @throws mongocxx::bulk_write_exception if the closed buckets could not be written. They are
+    ///   dropped.
+    ///
+    stdx::optional<result::bulk_write> append(bsoncxx::document::view meta,
+                                              std::chrono::system_clock::time_point time,
+                                              bsoncxx::document::view measurement);
+
+    ///
+    /// Closes every open bucket and writes all of the buckets not yet written.
+    ///
+    /// @return
+    ///   The result of the bulk write, or nothing if there was nothing to write or the write
+    ///   concern of the collection is unacknowledged.
+    ///
+    /// @throws mongocxx::bulk_write_exception if the buckets could not be written. They are
+    ///   dropped.
+    ///
+    stdx::optional<result::bulk_write> flush();
+
+    ///
+    /// The number of measurements appended and not yet written.
+    ///
+    std::size_t pending_measurements() const noexcept;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,74 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/stdx/optional.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// What server selection knows about a deployment at one moment, as returned by
+/// client::topology_snapshot() and pool::topology_snapshot().
+///
+/// A read is sent to a server chosen at random among the eligible servers whose round trip time is
+/// within local_threshold of the fastest one. Comparing round trip times with the number of
+/// commands each server ran shows how that window spreads reads across a replica set.
+///
+struct MONGOCXX_API topology_snapshot {
+    struct MONGOCXX_API server {
+        /// An opaque id, unique to this server for this mongocxx::client or mongocxx::pool.
+        std::uint32_t id;
+
+        /// The host name of the server.
+        std::string host;
+
+        /// The port of the server.
+        std::uint16_t port;
+
+        /// The server type: "Unknown", "Standalone", "Mongos", "PossiblePrimary", "RSPrimary",
+        /// "RSSecondary", "RSArbiter", "RSOther", or "RSGhost".
+        std::string type;
+
+        /// The exponentially weighted moving average of the round trip times of the heartbeats
+        /// to the server, which is what server selection compares. Empty until a heartbeat has
+        /// succeeded.
+        stdx::optional<std::chrono::milliseconds> round_trip_time;
+
+        /// The number of commands that succeeded on the server, if the client or pool was created
+        /// with options::apm::record_command_latencies(), and zero otherwise.
+        std::uint64_t command_count;
+    };
+
+    /// The servers of the deployment.
+    std::vector<server> servers;
+
+    /// The width of the latency window of server selection: localThresholdMS from the URI, or
+    /// options::client::local_threshold() if set.
+    std::chrono::milliseconds local_threshold;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
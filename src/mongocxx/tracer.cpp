@@ -0,0 +1,131 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/tracer.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/types.hpp>
+#include <mongocxx/private/tracer.hh>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+thread_local void* current_parent_context = nullptr;
+
+// A thread has at most one command in flight, unless a tracer runs commands of its own while
+// starting a span, so this rarely holds more than one entry.
+thread_local std::vector<std::pair<std::int64_t, void*>> open_spans;
+
+stdx::optional<std::int64_t> integer_field(bsoncxx::document::view command,
+                                           stdx::string_view key) {
+    auto element = command[key];
+    if (element.type() == bsoncxx::type::k_int32) {
+        return element.get_int32().value;
+    }
+    if (element.type() == bsoncxx::type::k_int64) {
+        return element.get_int64().value;
+    }
+    if (element.type() == bsoncxx::type::k_double) {
+        return static_cast<std::int64_t>(element.get_double().value);
+    }
+    return stdx::nullopt;
+}
+
+stdx::optional<std::int64_t> array_length(bsoncxx::document::view command,
+                                          stdx::string_view key) {
+    auto element = command[key];
+    if (element.type() != bsoncxx::type::k_array) {
+        return stdx::nullopt;
+    }
+
+    std::int64_t length = 0;
+    for (auto it = element.get_array().value.begin(); it != element.get_array().value.end(); ++it) {
+        length++;
+    }
+    return length;
+}
+
+}  // namespace
+
+tracer::tracer() = default;
+tracer::~tracer() = default;
+
+tracer::parent_scope::parent_scope(void* context) noexcept : _previous(current_parent_context) {
+    current_parent_context = context;
+}
+
+tracer::parent_scope::~parent_scope() {
+    current_parent_context = _previous;
+}
+
+void* tracer::current_parent() noexcept {
+    return current_parent_context;
+}
+
+namespace tracing {
+
+void push_span(std::int64_t request_id, void* span) {
+    open_spans.emplace_back(request_id, span);
+}
+
+void* pop_span(std::int64_t request_id) {
+    for (auto it = open_spans.rbegin(); it != open_spans.rend(); ++it) {
+        if (it->first == request_id) {
+            auto span = it->second;
+            open_spans.erase(std::next(it).base());
+            return span;
+        }
+    }
+    return nullptr;
+}
+
+void read_command_attributes(bsoncxx::document::view command,
+                             events::span_attributes* attributes) {
+    // The value of the command name is the collection for the commands that have one; getMore
+    // names its collection separately.
+    auto name = command[attributes->command_name];
+    if (attributes->command_name == stdx::string_view{"getMore"}) {
+        name = command["collection"];
+    }
+    if (name.type() == bsoncxx::type::k_utf8) {
+        attributes->collection = name.get_utf8().value;
+    }
+
+    if (attributes->command_name == stdx::string_view{"insert"}) {
+        attributes->batch_size = array_length(command, "documents");
+    } else if (attributes->command_name == stdx::string_view{"update"}) {
+        attributes->batch_size = array_length(command, "updates");
+    } else if (attributes->command_name == stdx::string_view{"delete"}) {
+        attributes->batch_size = array_length(command, "deletes");
+    } else if (attributes->command_name == stdx::string_view{"aggregate"}) {
+        auto cursor = command["cursor"];
+        if (cursor.type() == bsoncxx::type::k_document) {
+            attributes->batch_size = integer_field(cursor.get_document().value, "batchSize");
+        }
+    } else {
+        attributes->batch_size = integer_field(command, "batchSize");
+    }
+}
+
+}  // namespace tracing
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
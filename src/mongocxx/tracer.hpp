@@ -0,0 +1,113 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <mongocxx/events/span_attributes.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// The interface that user-defined tracers must implement to receive a span for each MongoDB
+/// command, such as to forward them to OpenTelemetry. A tracer is set with
+/// options::apm::tracer().
+///
+/// Spans are started and ended on the thread that runs the command. A span is parented to the
+/// context set on that thread with a tracer::parent_scope, so that a cursor's getMore commands can
+/// be traced back to the request that iterates it.
+///
+class MONGOCXX_API tracer {
+   public:
+    virtual ~tracer();
+
+    ///
+    /// Starts a span for a command that is about to be sent.
+    ///
+    /// @param attributes
+    ///   The namespace, size and destination of the command.
+    /// @param parent
+    ///   The context of the innermost parent_scope on the calling thread, or nullptr if there is
+    ///   none.
+    ///
+    /// @return An opaque handle to the span, which is passed back to end_span().
+    ///
+    virtual void* start_span(const events::span_attributes& attributes, void* parent) noexcept = 0;
+
+    ///
+    /// Ends a span returned by start_span().
+    ///
+    /// @param span
+    ///   The handle returned by start_span().
+    /// @param duration
+    ///   The duration of the command.
+    /// @param succeeded
+    ///   Whether the command succeeded.
+    /// @param reply_bytes
+    ///   The size in bytes of the reply document.
+    ///
+    virtual void end_span(void* span,
+                          std::chrono::microseconds duration,
+                          bool succeeded,
+                          std::size_t reply_bytes) noexcept = 0;
+
+    ///
+    /// Sets the parent context of the spans started on the calling thread for the lifetime of the
+    /// scope. Scopes nest, and the previous context is restored when one is destroyed.
+    ///
+    class MONGOCXX_API parent_scope {
+       public:
+        ///
+        /// Makes `context` the parent of the spans started on this thread.
+        ///
+        /// @param context
+        ///   A context of the caller's tracing library, such as a pointer to its current span.
+        ///
+        explicit parent_scope(void* context) noexcept;
+
+        ///
+        /// Restores the parent context that was set before this scope.
+        ///
+        ~parent_scope();
+
+        parent_scope(const parent_scope&) = delete;
+        parent_scope& operator=(const parent_scope&) = delete;
+
+       private:
+        void* _previous;
+    };
+
+    ///
+    /// Returns the parent context of the spans started on the calling thread.
+    ///
+    /// @return The context of the innermost parent_scope, or nullptr if there is none.
+    ///
+    static void* current_parent() noexcept;
+
+   protected:
+    ///
+    /// Default constructor
+    ///
+    tracer();
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -0,0 +1,300 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bsoncxx/mapping.hpp>
+#include <mongocxx/cursor.hpp>
+#include <mongocxx/exception/error_code.hpp>
+#include <mongocxx/exception/logic_error.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// Reads the documents of a cursor decoded into a struct with a mapping defined by
+/// BSONCXX_DEFINE_STRUCT, in the order of the cursor.
+///
+/// Documents are taken from the cursor batch by batch with cursor::next_batch(). While one batch
+/// is being decoded, a helper thread already fetches the next one, so the decoding overlaps the
+/// getMore round trip. Batches of at least k_parallel_threshold documents are also split into
+/// contiguous ranges decoded on up to max_threads threads.
+///
+/// Because of the prefetch, the cursor may be one batch ahead of the iteration.
+///
+/// @tparam T
+///   The decoded type, which must be default-constructible.
+///
+template <typename T>
+class typed_cursor {
+   public:
+    ///
+    /// The default number of documents taken from the cursor at a time.
+    ///
+    static constexpr std::size_t k_default_batch_documents = 1000;
+
+    ///
+    /// The fewest documents in a batch for its decoding to be spread over several threads.
+    ///
+    static constexpr std::size_t k_parallel_threshold = 256;
+
+    class iterator;
+
+    ///
+    /// Adapts a cursor.
+    ///
+    /// @param cursor
+    ///   The cursor to read, which must outlive the adapter.
+    /// @param batch_documents
+    ///   The number of documents taken from the cursor at a time.
+    /// @param max_threads
+    ///   The most threads decoding a batch, including the calling thread. Zero means
+    ///   std::thread::hardware_concurrency().
+    ///
+    /// @throws mongocxx::logic_error if batch_documents is zero.
+    ///
+    explicit typed_cursor(cursor& cursor,
+                          std::size_t batch_documents = k_default_batch_documents,
+                          std::size_t max_threads = 0)
+        : _cursor(&cursor),
+          _batch_documents(batch_documents),
+          _max_threads(max_threads ? max_threads
+                                   : std::max<std::size_t>(std::thread::hardware_concurrency(), 1)),
+          _position(0),
+          _started(false) {
+        if (batch_documents == 0) {
+            throw logic_error{error_code::k_invalid_parameter,
+                              "a typed cursor must take at least one document at a time"};
+        }
+    }
+
+    ///
+    /// @return An iterator to the current decoded document, decoding the first batch if none
+    ///   was yet.
+    ///
+    /// @throws mongocxx::query_exception if the query failed.
+    /// @throws bsoncxx::exception if a document cannot be decoded into T.
+    ///
+    iterator begin() {
+        if (!_started) {
+            _started = true;
+            _next = _cursor->next_batch(_batch_documents);
+            fill();
+        }
+        return iterator{_position < _decoded.size() ? this : nullptr};
+    }
+
+    ///
+    /// @return The past-the-end iterator.
+    ///
+    iterator end() {
+        return iterator{nullptr};
+    }
+
+   private:
+    // Decodes the prefetched batch into _decoded while the next one is fetched. A failure to
+    // fetch is only reported once the documents fetched before it were iterated over.
+    void fill() {
+        if (_fetch_error) {
+            _decoded.clear();
+            _position = 0;
+            auto error = _fetch_error;
+            _fetch_error = nullptr;
+            std::rethrow_exception(error);
+        }
+
+        auto current = std::move(_next);
+        _next = cursor::batch{};
+        _position = 0;
+        _decoded.clear();
+        _decoded.resize(current.size());
+        if (current.empty()) {
+            return;
+        }
+
+        std::thread fetcher;
+        try {
+            fetcher = std::thread{[&] {
+                try {
+                    _next = _cursor->next_batch(_batch_documents);
+                } catch (...) {
+                    _fetch_error = std::current_exception();
+                }
+            }};
+        } catch (const std::system_error&) {
+            // Fetch after decoding instead.
+        }
+
+        std::exception_ptr decode_error;
+        try {
+            decode(current);
+        } catch (...) {
+            decode_error = std::current_exception();
+        }
+
+        if (fetcher.joinable()) {
+            fetcher.join();
+        } else if (!decode_error) {
+            try {
+                _next = _cursor->next_batch(_batch_documents);
+            } catch (...) {
+                _fetch_error = std::current_exception();
+            }
+        }
+
+        if (decode_error) {
+            std::rethrow_exception(decode_error);
+        }
+    }
+
+    void decode(const cursor::batch& current) {
+        const auto decode_range = [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                bsoncxx::mapping::from_document(current[i], _decoded[i]);
+            }
+        };
+
+        const auto size = current.size();
+        const auto threads = size < k_parallel_threshold ? 1 : std::min(_max_threads, size);
+        const auto per_thread = (size + threads - 1) / threads;
+
+        std::vector<std::exception_ptr> errors(threads);
+        std::vector<std::thread> helpers;
+        std::size_t first_unstarted = threads;
+        for (std::size_t t = 1; t < threads; t++) {
+            try {
+                helpers.emplace_back([&, t] {
+                    try {
+                        decode_range(t * per_thread, std::min(size, (t + 1) * per_thread));
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            } catch (const std::system_error&) {
+                first_unstarted = t;
+                break;
+            }
+        }
+
+        // The calling thread decodes the first range, and the ranges of the helpers that could
+        // not be started.
+        try {
+            decode_range(0, std::min(size, per_thread));
+            decode_range(std::min(size, first_unstarted * per_thread), size);
+        } catch (...) {
+            errors[0] = std::current_exception();
+        }
+        for (auto&& helper : helpers) {
+            helper.join();
+        }
+
+        for (auto&& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    void advance() {
+        if (++_position >= _decoded.size()) {
+            fill();
+        }
+    }
+
+    cursor* _cursor;
+    std::size_t _batch_documents;
+    std::size_t _max_threads;
+    std::vector<T> _decoded;
+    std::size_t _position;
+    cursor::batch _next;
+    std::exception_ptr _fetch_error;
+    bool _started;
+};
+
+template <typename T>
+constexpr std::size_t typed_cursor<T>::k_default_batch_documents;
+
+template <typename T>
+constexpr std::size_t typed_cursor<T>::k_parallel_threshold;
+
+///
+/// An input iterator over the decoded documents of a typed_cursor. Incrementing it past the end of
+/// a batch decodes the next one, and may throw like typed_cursor::begin().
+///
+template <typename T>
+class typed_cursor<T>::iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    reference operator*() const {
+        return _cursor->_decoded[_cursor->_position];
+    }
+
+    pointer operator->() const {
+        return &**this;
+    }
+
+    iterator& operator++() {
+        _cursor->advance();
+        if (_cursor->_position >= _cursor->_decoded.size()) {
+            _cursor = nullptr;
+        }
+        return *this;
+    }
+
+    void operator++(int) {
+        operator++();
+    }
+
+    friend bool operator==(const iterator& lhs, const iterator& rhs) {
+        return lhs._cursor == rhs._cursor;
+    }
+
+    friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+        return !(lhs == rhs);
+    }
+
+   private:
+    friend class typed_cursor;
+
+    explicit iterator(typed_cursor* cursor) : _cursor(cursor) {}
+
+    // Null once the documents are exhausted.
+    typed_cursor* _cursor;
+};
+
+template <typename T>
+typed_cursor<T> cursor::as() {
+    return typed_cursor<T>{*this};
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
@@ -14,6 +14,9 @@
 
 #include <mongocxx/uri.hpp>
 
+#include <memory>
+#include <utility>
+
 #include <bsoncxx/stdx/make_unique.hpp>
 #include <mongocxx/exception/error_code.hpp>
 #include <mongocxx/exception/logic_error.hpp>
@@ -43,17 +46,18 @@ std::string to_string_null_safe(const char* str) {
 
 const std::string uri::k_default_uri = "mongodb://localhost:27017";
 
-uri::uri(std::unique_ptr<impl>&& implementation) {
-    _impl.reset(implementation.release());
-}
+uri::uri(std::unique_ptr<impl>&& implementation) : _impl(std::move(implementation)) {}
 
 uri::uri(bsoncxx::string::view_or_value uri_string)
-    : _impl(stdx::make_unique<impl>(libmongoc::uri_new(uri_string.terminated().data()))) {
+    : _impl(std::make_shared<impl>(libmongoc::uri_new(uri_string.terminated().data()))) {
     if (_impl->uri_t == nullptr) {
         throw logic_error{error_code::k_invalid_uri};
     }
 }
 
+uri::uri(const uri&) noexcept = default;
+uri& uri::operator=(const uri&) noexcept = default;
+
 uri::uri(uri&&) noexcept = default;
 uri& uri::operator=(uri&&) noexcept = default;
 
@@ -72,14 +76,7 @@ std::string uri::database() const {
 }
 
 std::vector<uri::host> uri::hosts() const {
-    std::vector<host> result;
-
-    for (auto host_list = libmongoc::uri_get_hosts(_impl->uri_t); host_list;
-         host_list = host_list->next) {
-        result.push_back(host{host_list->host, host_list->port, host_list->family});
-    }
-
-    return result;
+    return _impl->hosts();
 }
 
 bsoncxx::document::view uri::options() const {
@@ -51,11 +51,30 @@ class MONGOCXX_API uri {
     /// Constructs a uri from an optional MongoDB uri string. If no uri string is specified,
     /// uses the default uri string, 'mongodb://localhost:27017'.
     ///
+    /// Parsing does no network I/O. For a 'mongodb+srv://' uri, the SRV and TXT records are looked
+    /// up when a client or pool is constructed from it, once per client or pool. Processes that
+    /// need many connections to one deployment should share a mongocxx::pool rather than construct
+    /// many clients. The pool also re-polls the SRV records in the background.
+    ///
     /// @param uri_string
     ///   String representing a MongoDB connection string uri, defaults to k_default_uri.
     ///
     uri(bsoncxx::string::view_or_value uri_string = k_default_uri);
 
+    ///
+    /// Copy constructs a uri.
+    ///
+    /// A uri never changes once parsed, so copies share the parsed connection string, and the
+    /// values derived from it, instead of parsing it again. This makes it cheap to keep one uri per
+    /// deployment and pass copies of it to every client or pool created for it.
+    ///
+    uri(const uri&) noexcept;
+
+    ///
+    /// Copy assigns a uri, sharing the parsed connection string of `other`.
+    ///
+    uri& operator=(const uri& other) noexcept;
+
     ///
     /// Move constructs a uri.
     ///
@@ -179,7 +198,7 @@ class MONGOCXX_API uri {
 
     MONGOCXX_PRIVATE uri(std::unique_ptr<impl>&& implementation);
 
-    std::unique_ptr<impl> _impl;
+    std::shared_ptr<const impl> _impl;
 };
 
 MONGOCXX_INLINE_NAMESPACE_END
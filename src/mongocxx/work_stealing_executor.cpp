@@ -0,0 +1,165 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mongocxx/work_stealing_executor.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <bsoncxx/stdx/make_unique.hpp>
+#include <mongocxx/private/work_stealing_executor.hh>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/private/prelude.hh>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+namespace {
+
+// The executor whose thread is running, and the index of the thread's queue, so that tasks
+// submitted by a task go to the queue of the thread running it.
+thread_local const void* current_executor = nullptr;
+thread_local std::size_t current_queue = 0;
+
+}  // namespace
+
+work_stealing_executor::impl::impl(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (std::size_t i = 0; i < threads; i++) {
+        _queues.push_back(stdx::make_unique<queue>());
+    }
+
+    try {
+        for (std::size_t i = 0; i < threads; i++) {
+            _threads.emplace_back([this, i] { work(i); });
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+work_stealing_executor::impl::~impl() {
+    stop();
+}
+
+void work_stealing_executor::impl::stop() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _wakeup.notify_all();
+
+    for (auto&& thread : _threads) {
+        thread.join();
+    }
+}
+
+void work_stealing_executor::impl::submit(std::function<void()> task) {
+    // The task is counted before it is queued, so that a thread cannot take and uncount it first.
+    std::size_t index = current_queue;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (current_executor != this) {
+            index = _next_queue++ % _queues.size();
+        }
+        _pending++;
+    }
+
+    {
+        auto& target = *_queues[index];
+        std::lock_guard<std::mutex> lock{target.mutex};
+        target.tasks.push_back(std::move(task));
+    }
+    _wakeup.notify_one();
+}
+
+std::size_t work_stealing_executor::impl::concurrency() const {
+    return _queues.size();
+}
+
+bool work_stealing_executor::impl::take(std::size_t index, std::function<void()>* task) {
+    {
+        auto& own = *_queues[index];
+        std::lock_guard<std::mutex> lock{own.mutex};
+        if (!own.tasks.empty()) {
+            *task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (std::size_t i = 1; i < _queues.size(); i++) {
+        auto& victim = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            *task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void work_stealing_executor::impl::work(std::size_t index) {
+    current_executor = this;
+    current_queue = index;
+
+    std::function<void()> task;
+    while (true) {
+        if (take(index, &task)) {
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _pending--;
+            }
+
+            try {
+                task();
+            } catch (...) {
+                // Tasks must not throw; there is nobody to report the error to.
+            }
+            task = nullptr;
+            continue;
+        }
+
+        // A task counted in _pending but not found above is either about to be queued or being
+        // taken by another thread, so the wait below only spins briefly.
+        std::unique_lock<std::mutex> lock{_mutex};
+        _wakeup.wait(lock, [this] { return _stopping || _pending > 0; });
+        if (_stopping && _pending == 0) {
+            return;
+        }
+    }
+}
+
+work_stealing_executor::work_stealing_executor(std::size_t threads)
+    : _impl{stdx::make_unique<impl>(threads)} {}
+
+work_stealing_executor::~work_stealing_executor() = default;
+
+void work_stealing_executor::submit(std::function<void()> task) {
+    _impl->submit(std::move(task));
+}
+
+std::size_t work_stealing_executor::concurrency() const {
+    return _impl->concurrency();
+}
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
@@ -0,0 +1,69 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include <mongocxx/executor.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// An executor running tasks on a fixed set of threads.
+///
+/// Each thread has a queue of its own. A task submitted by one of the threads goes to the back of
+/// that thread's queue, and the thread runs its own queue from the back, so that a task runs
+/// while the data its submitter touched is still in cache. Tasks submitted by other threads are
+/// spread over the queues in turn. A thread whose queue is empty steals from the front of the
+/// others' queues, and sleeps when every queue is empty.
+///
+class MONGOCXX_API work_stealing_executor : public executor {
+   public:
+    ///
+    /// Starts the threads of the executor.
+    ///
+    /// @param threads
+    ///   The number of threads. Zero uses std::thread::hardware_concurrency().
+    ///
+    /// @throws std::system_error if the threads cannot be started.
+    ///
+    explicit work_stealing_executor(std::size_t threads = 0);
+
+    ///
+    /// Runs the tasks that are left, including those they submit, then stops the threads.
+    ///
+    ~work_stealing_executor() override;
+
+    work_stealing_executor(const work_stealing_executor&) = delete;
+    work_stealing_executor& operator=(const work_stealing_executor&) = delete;
+
+    void submit(std::function<void()> task) override;
+
+    std::size_t concurrency() const override;
+
+   private:
+    class MONGOCXX_PRIVATE impl;
+    std::unique_ptr<impl> _impl;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>
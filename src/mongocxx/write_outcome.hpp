@@ -0,0 +1,193 @@
+// Copyright 2020-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/stdx/optional.hpp>
+#include <bsoncxx/types.hpp>
+#include <mongocxx/exception/bulk_write_exception.hpp>
+#include <mongocxx/stdx.hpp>
+
+#include <mongocxx/config/prelude.hpp>
+
+namespace mongocxx {
+MONGOCXX_INLINE_NAMESPACE_BEGIN
+
+///
+/// The outcome of a write operation that reports errors by returning them instead of throwing,
+/// such as collection::try_insert_one. It holds either the optional result the throwing variant
+/// would have returned, or the error it would have thrown as a mongocxx::bulk_write_exception.
+///
+/// Failing this way skips the cost of throwing and unwinding, which dominates when errors such as
+/// duplicate keys are a normal outcome. The server's reply is kept as received; the write error
+/// within it is only looked up when write_error() is called.
+///
+template <typename result_type>
+class write_outcome {
+   public:
+    ///
+    /// Constructs a successful outcome.
+    ///
+    /// @param result
+    ///   The result of the write, which is disengaged if the write was unacknowledged.
+    ///
+    write_outcome(stdx::optional<result_type> result)
+        : _result{std::move(result)}, _has_error{false} {}
+
+    ///
+    /// Constructs a failed outcome.
+    ///
+    /// @param ec
+    ///   The error code of the failure.
+    /// @param raw_server_error
+    ///   The reply of the server, which may be empty if the write never reached it.
+    /// @param message
+    ///   A description of the failure.
+    ///
+    write_outcome(std::error_code ec,
+                  bsoncxx::document::value raw_server_error,
+                  std::string message)
+        : _error_code{ec},
+          _raw_server_error{std::move(raw_server_error)},
+          _error_message{std::move(message)},
+          _has_error{true} {}
+
+    ///
+    /// Constructs a failed outcome with the error of another failed outcome, such as that of the
+    /// bulk write an operation was sent as. The error is moved, not copied.
+    ///
+    /// @param failed
+    ///   The outcome to take the error of. It must have an error.
+    ///
+    template <typename other_result_type>
+    explicit write_outcome(write_outcome<other_result_type>&& failed)
+        : _error_code{failed._error_code},
+          _raw_server_error{std::move(failed._raw_server_error)},
+          _error_message{std::move(failed._error_message)},
+          _has_error{true} {}
+
+    ///
+    /// Returns true if the write failed.
+    ///
+    bool has_error() const noexcept {
+        return _has_error;
+    }
+
+    ///
+    /// Returns true if the write succeeded.
+    ///
+    explicit operator bool() const noexcept {
+        return !_has_error;
+    }
+
+    ///
+    /// @{
+    ///
+    /// Returns the result of a successful write.
+    ///
+    /// @throws mongocxx::bulk_write_exception with the error details if the write failed, exactly
+    ///   as the throwing variant of the operation would have.
+    ///
+    const stdx::optional<result_type>& value() const& {
+        throw_if_error();
+        return _result;
+    }
+
+    stdx::optional<result_type> value() && {
+        if (_has_error && _raw_server_error) {
+            throw bulk_write_exception{_error_code, std::move(*_raw_server_error), _error_message};
+        }
+        throw_if_error();
+        return std::move(_result);
+    }
+    ///
+    /// @}
+    ///
+
+    ///
+    /// Throws the error of a failed write as a mongocxx::bulk_write_exception, and does nothing if
+    /// the write succeeded.
+    ///
+    void throw_if_error() const {
+        if (!_has_error) {
+            return;
+        }
+        if (_raw_server_error) {
+            throw bulk_write_exception{
+                _error_code, bsoncxx::document::value{_raw_server_error->view()}, _error_message};
+        }
+        throw bulk_write_exception{_error_code, _error_message};
+    }
+
+    ///
+    /// Returns the error code of a failed write, or a zero error code if it succeeded. For a write
+    /// error, such as a duplicate key, this is the server's error code.
+    ///
+    std::error_code error_code() const noexcept {
+        return _error_code;
+    }
+
+    ///
+    /// Returns the description of a failed write, or an empty string if it succeeded.
+    ///
+    const std::string& error_message() const noexcept {
+        return _error_message;
+    }
+
+    ///
+    /// Returns the reply of the server to a failed write. It is empty if the write succeeded, or
+    /// failed without a reply.
+    ///
+    bsoncxx::document::view raw_server_error() const noexcept {
+        return _raw_server_error ? _raw_server_error->view() : bsoncxx::document::view{};
+    }
+
+    ///
+    /// Returns the first write error of the reply of the server to a failed write, with its
+    /// "index", "code" and "errmsg" fields, or an empty document if there is none.
+    ///
+    bsoncxx::document::view write_error() const {
+        const auto errors = raw_server_error()["writeErrors"];
+        if (!errors || errors.type() != bsoncxx::type::k_array) {
+            return {};
+        }
+        const auto first = errors.get_array().value[0];
+        if (!first || first.type() != bsoncxx::type::k_document) {
+            return {};
+        }
+        return first.get_document().value;
+    }
+
+   private:
+    stdx::optional<result_type> _result;
+    std::error_code _error_code;
+    stdx::optional<bsoncxx::document::value> _raw_server_error;
+    std::string _error_message;
+    bool _has_error;
+
+    template <typename>
+    friend class write_outcome;
+};
+
+MONGOCXX_INLINE_NAMESPACE_END
+}  // namespace mongocxx
+
+#include <mongocxx/config/postlude.hpp>